@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import <RCTTest/RCTTestRunner.h>
+
+#define RCT_BENCHMARK(name)             \
+- (void)test##name                      \
+{                                       \
+  [_runner runTest:_cmd module:@#name]; \
+}
+
+/**
+ * Performance scenes, driven from JS. Unlike the integration tests they are
+ * meant to be run on device too: each writes its frame timings, bridge
+ * traffic, input latency and mount stats as JSON to the runner's benchmark
+ * directory, and logs them as a single "RCTBenchmark" line.
+ */
+@interface UIExplorerBenchmarkTests : XCTestCase
+
+@end
+
+@implementation UIExplorerBenchmarkTests
+{
+  RCTTestRunner *_runner;
+}
+
+- (void)setUp
+{
+  _runner = RCTInitRunnerForApp(@"Examples/UIExplorer/UIExplorerIntegrationTests/js/IntegrationTestsApp", nil);
+}
+
+RCT_BENCHMARK(ListScrollBenchmark)
+RCT_BENCHMARK(DeepTreeMountBenchmark)
+RCT_BENCHMARK(TextFeedBenchmark)
+RCT_BENCHMARK(ImageGridBenchmark)
+RCT_BENCHMARK(ARTChartBenchmark)
+
+@end
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var Benchmark = require('./Benchmark');
+var React = require('react-native');
+var ReactART = require('ReactNativeART');
+var {
+  StyleSheet,
+  View,
+} = React;
+var {
+  Group,
+  Path,
+  Shape,
+  Surface,
+} = ReactART;
+
+var WIDTH = 320;
+var HEIGHT = 200;
+var POINTS = 100;
+var SERIES = 3;
+var FRAMES = 180;
+var COLORS = ['#3b5998', '#f7931e', '#4cbb17'];
+
+function makeLine(series: number, frame: number): Path {
+  var path = new Path();
+  for (var i = 0; i < POINTS; i++) {
+    var x = i * WIDTH / (POINTS - 1);
+    var phase = (i + frame * (series + 1)) / 10;
+    var y = HEIGHT / 2 + Math.sin(phase) * HEIGHT / (3 + series);
+    if (i === 0) {
+      path.moveTo(x, y);
+    } else {
+      path.lineTo(x, y);
+    }
+  }
+  return path;
+}
+
+/**
+ * An ART line chart whose series are redrawn with new data every frame, as
+ * an animated chart would be.
+ */
+var ARTChartBenchmark = React.createClass({
+  getInitialState() {
+    return {frame: 0};
+  },
+
+  componentDidMount() {
+    Benchmark.start();
+    Benchmark.runFrames(
+      FRAMES,
+      (frame) => this.setState({frame}),
+      () => Benchmark.finish('ARTChart', {
+        series: SERIES,
+        points: POINTS,
+        frames: FRAMES,
+      })
+    );
+  },
+
+  render() {
+    var lines = [];
+    for (var i = 0; i < SERIES; i++) {
+      lines.push(
+        <Shape
+          key={i}
+          d={makeLine(i, this.state.frame)}
+          stroke={COLORS[i % COLORS.length]}
+          strokeWidth={2}
+        />
+      );
+    }
+    return (
+      <View style={styles.container}>
+        <Surface width={WIDTH} height={HEIGHT}>
+          <Group>
+            {lines}
+          </Group>
+        </Surface>
+      </View>
+    );
+  },
+});
+
+var styles = StyleSheet.create({
+  container: {
+    width: WIDTH,
+    height: HEIGHT,
+  },
+});
+
+ARTChartBenchmark.displayName = 'ARTChartBenchmark';
+
+module.exports = ARTChartBenchmark;
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var NativeModules = require('NativeModules');
+
+var RCTTestModule = NativeModules.TestModule;
+
+// The modules that record stats while a scene runs, by the key their stats
+// are reported under. Modules that aren't available are skipped.
+var RECORDERS = {
+  frameTiming: NativeModules.FrameTiming,
+  bridgeTraffic: NativeModules.BridgeTraffic,
+  inputLatency: NativeModules.InputLatency,
+};
+
+function forEachRecorder(fn: (recorder: Object, key: string) => void) {
+  Object.keys(RECORDERS).forEach((key) => {
+    if (RECORDERS[key]) {
+      fn(RECORDERS[key], key);
+    }
+  });
+}
+
+/**
+ * Drives a benchmark scene. A scene calls start() once it has mounted, runs
+ * its workload, typically with runFrames(), and then calls finish() with any
+ * results of its own. The frame timings, bridge traffic and input latency
+ * recorded in between are reported along with those results, and the UI
+ * manager's batch stats, through RCTTestModule, which hands them to the test
+ * runner to be written out as JSON.
+ */
+var Benchmark = {
+  _startTime: 0,
+
+  start(): void {
+    forEachRecorder((recorder) => {
+      recorder.resetStats();
+      recorder.startRecording();
+    });
+    RCTTestModule.startBenchmark();
+    Benchmark._startTime = Date.now();
+  },
+
+  /**
+   * Calls step once per frame with the frame number, then done.
+   */
+  runFrames(
+    frames: number,
+    step: (frame: number) => void,
+    done: () => void
+  ): void {
+    var frame = 0;
+    var nextFrame = () => {
+      if (frame >= frames) {
+        done();
+        return;
+      }
+      step(frame++);
+      requestAnimationFrame(nextFrame);
+    };
+    requestAnimationFrame(nextFrame);
+  },
+
+  finish(scene: string, results?: Object): void {
+    var duration = Date.now() - Benchmark._startTime;
+    var report = Object.assign({scene, duration}, results);
+    var pending = [];
+    forEachRecorder((recorder, key) => {
+      pending.push(new Promise((resolve) => {
+        recorder.getStats((stats) => {
+          report[key] = stats;
+          recorder.stopRecording();
+          resolve();
+        });
+      }));
+    });
+    Promise.all(pending).then(() => {
+      RCTTestModule.markBenchmarkCompleted(report);
+    });
+  },
+};
+
+module.exports = Benchmark;
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var Benchmark = require('./Benchmark');
+var React = require('react-native');
+var {
+  StyleSheet,
+  Text,
+  View,
+} = React;
+
+var DEPTH = 40;
+var BREADTH = 3;
+var ITERATIONS = 10;
+
+/**
+ * A chain of DEPTH levels, each with BREADTH labelled leaves next to the next
+ * level, so that layout has to recurse all the way down.
+ */
+var DeepTree = React.createClass({
+  render() {
+    var depth = this.props.depth;
+    var leaves = [];
+    for (var i = 0; i < BREADTH; i++) {
+      leaves.push(
+        <View key={i} style={styles.leaf}>
+          <Text style={styles.label}>{depth + '.' + i}</Text>
+        </View>
+      );
+    }
+    return (
+      <View style={depth % 2 ? styles.row : styles.column}>
+        {leaves}
+        {depth > 1 ? <DeepTree depth={depth - 1} /> : null}
+      </View>
+    );
+  },
+});
+
+/**
+ * Mounts and unmounts a deep tree ITERATIONS times, one frame apart, and
+ * reports how long each mount took to reach the next frame.
+ */
+var DeepTreeMountBenchmark = React.createClass({
+  getInitialState() {
+    return {mounted: false};
+  },
+
+  componentDidMount() {
+    this._mountTimes = [];
+    Benchmark.start();
+    this._mount();
+  },
+
+  _mount() {
+    var start = Date.now();
+    this.setState({mounted: true}, () => {
+      requestAnimationFrame(() => {
+        this._mountTimes.push(Date.now() - start);
+        this.setState({mounted: false}, () => requestAnimationFrame(this._next));
+      });
+    });
+  },
+
+  _next() {
+    if (this._mountTimes.length < ITERATIONS) {
+      this._mount();
+      return;
+    }
+    Benchmark.finish('DeepTreeMount', {
+      depth: DEPTH,
+      breadth: BREADTH,
+      mountTimes: this._mountTimes,
+    });
+  },
+
+  render() {
+    return (
+      <View style={styles.container}>
+        {this.state.mounted ? <DeepTree depth={DEPTH} /> : null}
+      </View>
+    );
+  },
+});
+
+var styles = StyleSheet.create({
+  container: {
+    height: 600,
+  },
+  row: {
+    flexDirection: 'row',
+    padding: 1,
+  },
+  column: {
+    flexDirection: 'column',
+    padding: 1,
+  },
+  leaf: {
+    padding: 1,
+    borderWidth: 1,
+    borderColor: '#cccccc',
+  },
+  label: {
+    fontSize: 6,
+  },
+});
+
+DeepTreeMountBenchmark.displayName = 'DeepTreeMountBenchmark';
+
+module.exports = DeepTreeMountBenchmark;
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var Benchmark = require('./Benchmark');
+var React = require('react-native');
+var {
+  Image,
+  ListView,
+  StyleSheet,
+} = React;
+
+var IMAGE_COUNT = 600;
+var FRAMES = 240;
+var SCROLL_PER_FRAME = 40;
+
+var IMAGES = [
+  require('image!uie_thumb_normal'),
+  require('image!uie_thumb_selected'),
+  require('image!uie_thumb_big'),
+  require('image!uie_comment_normal'),
+];
+
+/**
+ * A grid of bundled images, scrolled one step per frame. The images come from
+ * the app's asset catalog, so the scene doesn't depend on the network.
+ */
+var ImageGridBenchmark = React.createClass({
+  getInitialState() {
+    var dataSource = new ListView.DataSource({
+      rowHasChanged: (r1, r2) => r1 !== r2,
+    });
+    var images = [];
+    for (var i = 0; i < IMAGE_COUNT; i++) {
+      images.push(IMAGES[i % IMAGES.length]);
+    }
+    return {dataSource: dataSource.cloneWithRows(images)};
+  },
+
+  componentDidMount() {
+    Benchmark.start();
+    Benchmark.runFrames(
+      FRAMES,
+      (frame) => {
+        this.refs.grid.getScrollResponder().scrollWithoutAnimationTo(
+          (frame + 1) * SCROLL_PER_FRAME
+        );
+      },
+      () => Benchmark.finish('ImageGrid', {
+        images: IMAGE_COUNT,
+        frames: FRAMES,
+      })
+    );
+  },
+
+  _renderImage(source: Object) {
+    return <Image source={source} style={styles.image} />;
+  },
+
+  render() {
+    return (
+      <ListView
+        ref="grid"
+        style={styles.grid}
+        contentContainerStyle={styles.gridContent}
+        dataSource={this.state.dataSource}
+        renderRow={this._renderImage}
+        initialListSize={40}
+        pageSize={4}
+      />
+    );
+  },
+});
+
+var styles = StyleSheet.create({
+  grid: {
+    height: 600,
+  },
+  gridContent: {
+    flexDirection: 'row',
+    flexWrap: 'wrap',
+  },
+  image: {
+    width: 76,
+    height: 76,
+    margin: 2,
+  },
+});
+
+ImageGridBenchmark.displayName = 'ImageGridBenchmark';
+
+module.exports = ImageGridBenchmark;
@@ -31,6 +31,11 @@ var TESTS = [
   require('./AppEventsTest'),
   require('./SimpleSnapshotTest'),
   require('./PromiseTest'),
+  require('./ListScrollBenchmark'),
+  require('./DeepTreeMountBenchmark'),
+  require('./TextFeedBenchmark'),
+  require('./ImageGridBenchmark'),
+  require('./ARTChartBenchmark'),
 ];
 
 TESTS.forEach(
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var Benchmark = require('./Benchmark');
+var React = require('react-native');
+var {
+  ListView,
+  StyleSheet,
+  Text,
+  View,
+} = React;
+
+var ROW_COUNT = 1000;
+var FRAMES = 240;
+var SCROLL_PER_FRAME = 40;
+
+/**
+ * Scrolls a long ListView one step per frame, so that rows keep being
+ * rendered as they come into view.
+ */
+var ListScrollBenchmark = React.createClass({
+  getInitialState() {
+    var dataSource = new ListView.DataSource({
+      rowHasChanged: (r1, r2) => r1 !== r2,
+    });
+    var rows = [];
+    for (var i = 0; i < ROW_COUNT; i++) {
+      rows.push({id: i, title: 'Row ' + i, subtitle: 'Subtitle of row ' + i});
+    }
+    return {dataSource: dataSource.cloneWithRows(rows)};
+  },
+
+  componentDidMount() {
+    Benchmark.start();
+    Benchmark.runFrames(
+      FRAMES,
+      (frame) => {
+        this.refs.list.getScrollResponder().scrollWithoutAnimationTo(
+          (frame + 1) * SCROLL_PER_FRAME
+        );
+      },
+      () => Benchmark.finish('ListScroll', {
+        rows: ROW_COUNT,
+        frames: FRAMES,
+      })
+    );
+  },
+
+  _renderRow(row: Object) {
+    return (
+      <View style={styles.row}>
+        <View style={styles.thumbnail} />
+        <View style={styles.rowText}>
+          <Text style={styles.title}>{row.title}</Text>
+          <Text style={styles.subtitle}>{row.subtitle}</Text>
+        </View>
+      </View>
+    );
+  },
+
+  render() {
+    return (
+      <ListView
+        ref="list"
+        style={styles.list}
+        dataSource={this.state.dataSource}
+        renderRow={this._renderRow}
+        initialListSize={20}
+        pageSize={5}
+      />
+    );
+  },
+});
+
+var styles = StyleSheet.create({
+  list: {
+    height: 600,
+  },
+  row: {
+    flexDirection: 'row',
+    padding: 10,
+    borderBottomWidth: 1,
+    borderBottomColor: '#dddddd',
+  },
+  thumbnail: {
+    width: 40,
+    height: 40,
+    marginRight: 10,
+    backgroundColor: '#336699',
+  },
+  rowText: {
+    flex: 1,
+  },
+  title: {
+    fontWeight: '500',
+  },
+  subtitle: {
+    color: '#888888',
+  },
+});
+
+ListScrollBenchmark.displayName = 'ListScrollBenchmark';
+
+module.exports = ListScrollBenchmark;
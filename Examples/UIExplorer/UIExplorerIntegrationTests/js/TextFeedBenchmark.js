@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+'use strict';
+
+var Benchmark = require('./Benchmark');
+var React = require('react-native');
+var {
+  ScrollView,
+  StyleSheet,
+  Text,
+  View,
+} = React;
+
+var STORY_COUNT = 100;
+var FRAMES = 240;
+var SCROLL_PER_FRAME = 60;
+
+var WORDS = [
+  'lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur', 'adipiscing',
+  'elit', 'sed', 'do', 'eiusmod', 'tempor', 'incididunt', 'ut', 'labore',
+  'et', 'dolore', 'magna', 'aliqua',
+];
+
+function makeParagraph(seed: number, words: number): string {
+  var text = [];
+  for (var i = 0; i < words; i++) {
+    text.push(WORDS[(seed * 7 + i * 3) % WORDS.length]);
+  }
+  return text.join(' ') + '.';
+}
+
+/**
+ * A feed of stories made of nested, differently styled text, scrolled one
+ * step per frame. Every story is mounted up front, so the scene measures text
+ * layout and drawing rather than incremental rendering.
+ */
+var TextFeedBenchmark = React.createClass({
+  componentDidMount() {
+    Benchmark.start();
+    Benchmark.runFrames(
+      FRAMES,
+      (frame) => {
+        this.refs.feed.scrollWithoutAnimationTo((frame + 1) * SCROLL_PER_FRAME);
+      },
+      () => Benchmark.finish('TextFeed', {
+        stories: STORY_COUNT,
+        frames: FRAMES,
+      })
+    );
+  },
+
+  render() {
+    var stories = [];
+    for (var i = 0; i < STORY_COUNT; i++) {
+      stories.push(
+        <View key={i} style={styles.story}>
+          <Text style={styles.author}>
+            Author {i}
+            <Text style={styles.timestamp}> · {i + 1}h</Text>
+          </Text>
+          <Text style={styles.body}>
+            {makeParagraph(i, 40)}
+            <Text style={styles.link}> {makeParagraph(i + 1, 3)} </Text>
+            {makeParagraph(i + 2, 25)}
+          </Text>
+          <Text style={styles.footer} numberOfLines={1}>
+            {makeParagraph(i + 3, 20)}
+          </Text>
+        </View>
+      );
+    }
+    return (
+      <ScrollView ref="feed" style={styles.feed}>
+        {stories}
+      </ScrollView>
+    );
+  },
+});
+
+var styles = StyleSheet.create({
+  feed: {
+    height: 600,
+  },
+  story: {
+    padding: 10,
+    borderBottomWidth: 1,
+    borderBottomColor: '#dddddd',
+  },
+  author: {
+    fontWeight: 'bold',
+  },
+  timestamp: {
+    fontWeight: 'normal',
+    color: '#888888',
+  },
+  body: {
+    marginTop: 4,
+    fontSize: 14,
+    lineHeight: 20,
+  },
+  link: {
+    color: '#3b5998',
+    fontStyle: 'italic',
+  },
+  footer: {
+    marginTop: 4,
+    fontSize: 12,
+    color: '#888888',
+  },
+});
+
+TextFeedBenchmark.displayName = 'TextFeedBenchmark';
+
+module.exports = TextFeedBenchmark;
@@ -17,7 +17,10 @@
 
 #import "RCTBridge.h"
 #import "RCTBridgeModule.h"
+#import "RCTBridgeRecorder.h"
 #import "RCTJavaScriptExecutor.h"
+#import "RCTMethodCallBatch.h"
+#import "RCTModuleData.h"
 #import "RCTUtils.h"
 
 @interface RCTBridge (Testing)
@@ -32,6 +35,7 @@
 @interface TestExecutor : NSObject <RCTJavaScriptExecutor>
 
 @property (nonatomic, readonly, copy) NSMutableDictionary *injectedStuff;
+@property (nonatomic, readonly, copy) NSMutableArray *JSCalls;
 
 @end
 
@@ -45,6 +49,7 @@ RCT_EXPORT_MODULE()
 {
   if (self = [super init]) {
     _injectedStuff = [NSMutableDictionary dictionary];
+    _JSCalls = [NSMutableArray array];
   }
   return self;
 }
@@ -54,11 +59,14 @@ RCT_EXPORT_MODULE()
   return YES;
 }
 
-- (void)executeJSCall:(__unused NSString *)name
-               method:(__unused NSString *)method
-            arguments:(__unused NSArray *)arguments
+- (void)executeJSCall:(NSString *)name
+               method:(NSString *)method
+            arguments:(NSArray *)arguments
              callback:(RCTJavaScriptCallback)onComplete
 {
+  @synchronized(_JSCalls) {
+    [_JSCalls addObject:@[name, method, arguments]];
+  }
   onComplete(nil, nil);
 }
 
@@ -86,10 +94,52 @@ RCT_EXPORT_MODULE()
 
 @end
 
+@interface RCTLazyTestModule : NSObject <RCTBridgeModule>
+
+@property (nonatomic, assign) BOOL methodCalled;
+
+@end
+
+@implementation RCTLazyTestModule
+
+@synthesize methodQueue = _methodQueue;
+
+RCT_EXPORT_LAZY_MODULE()
+
+RCT_EXPORT_METHOD(doSomething)
+{
+  _methodCalled = YES;
+}
+
+@end
+
+@interface RCTSharedTestModule : NSObject <RCTBridgeModule, RCTInvalidating>
+
+@property (nonatomic, assign) BOOL invalidated;
+
+@end
+
+@implementation RCTSharedTestModule
+
+RCT_EXPORT_MODULE()
+
++ (BOOL)isSharedAcrossBridges
+{
+  return YES;
+}
+
+- (void)invalidate
+{
+  _invalidated = YES;
+}
+
+@end
+
 @interface RCTBridgeTests : XCTestCase <RCTBridgeModule>
 {
   RCTBridge *_bridge;
   BOOL _testMethodCalled;
+  NSMutableArray *_recordedValues;
 }
 @end
 
@@ -177,6 +227,234 @@ _Pragma("clang diagnostic pop")
   });
 }
 
+- (void)testCallsOnSameQueueKeepBatchOrder
+{
+  TestExecutor *executor =  [_bridge.batchedBridge valueForKey:@"_javaScriptExecutor"];
+
+  NSString *injectedStuff;
+  RUN_RUNLOOP_WHILE(!(injectedStuff = executor.injectedStuff[@"__fbBatchedBridgeConfig"]));
+
+  NSDictionary *moduleConfig = RCTJSONParse(injectedStuff, NULL);
+  NSDictionary *testModuleConfig = moduleConfig[@"remoteModuleConfig"][@"TestModule"];
+  NSNumber *testModuleID = testModuleConfig[@"moduleID"];
+  NSNumber *recordMethodID = testModuleConfig[@"methods"][@"recordValue"][@"methodID"];
+
+  _recordedValues = [NSMutableArray new];
+  NSMutableArray *moduleIDs = [NSMutableArray new];
+  NSMutableArray *methodIDs = [NSMutableArray new];
+  NSMutableArray *paramss = [NSMutableArray new];
+  for (NSInteger i = 0; i < 20; i++) {
+    [moduleIDs addObject:testModuleID];
+    [methodIDs addObject:recordMethodID];
+    [paramss addObject:@[@(i)]];
+  }
+
+  [_bridge.batchedBridge _handleBuffer:@[moduleIDs, methodIDs, paramss, @[], @1234567]];
+
+  dispatch_sync(_methodQueue, ^{
+    NSMutableArray *expected = [NSMutableArray new];
+    for (NSInteger i = 0; i < 20; i++) {
+      [expected addObject:@(i)];
+    }
+    XCTAssertEqualObjects(_recordedValues, expected);
+  });
+}
+
+- (void)testCallbacksAreFlushedWithoutWaitingForFrame
+{
+  TestExecutor *executor =  [_bridge.batchedBridge valueForKey:@"_javaScriptExecutor"];
+
+  NSString *injectedStuff;
+  RUN_RUNLOOP_WHILE(!(injectedStuff = executor.injectedStuff[@"__fbBatchedBridgeConfig"]));
+
+  NSDictionary *moduleConfig = RCTJSONParse(injectedStuff, NULL);
+  NSDictionary *testModuleConfig = moduleConfig[@"remoteModuleConfig"][@"TestModule"];
+  NSNumber *testModuleID = testModuleConfig[@"moduleID"];
+  NSNumber *callbackMethodID = testModuleConfig[@"methods"][@"callBack"][@"methodID"];
+
+  NSArray *buffer = @[@[testModuleID], @[callbackMethodID], @[@[@7]], @[], @1234567];
+  [_bridge.batchedBridge _handleBuffer:buffer];
+
+  dispatch_sync(_methodQueue, ^{
+    // clear the queue
+  });
+
+  NSDictionary *callbackCall = @{
+    @"module": @"BatchedBridge",
+    @"method": @"invokeCallbackAndReturnFlushedQueue",
+    @"args": @[@7, @[@"result"]],
+  };
+  BOOL flushed = NO;
+  @synchronized(executor.JSCalls) {
+    for (NSArray *call in executor.JSCalls) {
+      if ([call[1] isEqualToString:@"processBatch"] && [call[2][0] containsObject:callbackCall]) {
+        flushed = YES;
+      }
+    }
+  }
+  XCTAssertTrue(flushed);
+}
+
+- (void)testScheduledCallsKeepTheirOrderAcrossPriorities
+{
+  TestExecutor *executor =  [_bridge.batchedBridge valueForKey:@"_javaScriptExecutor"];
+  RUN_RUNLOOP_WHILE(!executor.injectedStuff[@"__fbBatchedBridgeConfig"]);
+
+  [_bridge enqueueJSCall:@"JSTimersExecution.callTimers" args:@[@[@1]]];
+  [_bridge enqueueJSCall:@"RCTEventEmitter.receiveEvent" args:@[@1, @"topTap", @{}]];
+  [_bridge enqueueJSCall:@"AppRegistry.runApplication" args:@[@"App", @{}]];
+  [_bridge enqueueJSCall:@"RCTDeviceEventEmitter.emit" args:@[@"change"]];
+
+  NSArray *expectedCalls = @[
+    @{
+      @"module": @"BatchedBridge",
+      @"method": @"callFunctionReturnFlushedQueue",
+      @"args": @[@"JSTimersExecution", @"callTimers", @[@[@1]]],
+    },
+    @{
+      @"module": @"BatchedBridge",
+      @"method": @"callFunctionReturnFlushedQueue",
+      @"args": @[@"RCTEventEmitter", @"receiveEvent", @[@1, @"topTap", @{}]],
+    },
+    @{
+      @"module": @"BatchedBridge",
+      @"method": @"callFunctionReturnFlushedQueue",
+      @"args": @[@"AppRegistry", @"runApplication", @[@"App", @{}]],
+    },
+    @{
+      @"module": @"BatchedBridge",
+      @"method": @"callFunctionReturnFlushedQueue",
+      @"args": @[@"RCTDeviceEventEmitter", @"emit", @[@"change"]],
+    },
+  ];
+
+  __block NSMutableArray *sentCalls;
+  RUN_RUNLOOP_WHILE(({
+    sentCalls = [NSMutableArray new];
+    @synchronized(executor.JSCalls) {
+      for (NSArray *call in executor.JSCalls) {
+        if ([call[1] isEqualToString:@"processBatch"]) {
+          [sentCalls addObjectsFromArray:call[2][0]];
+        }
+      }
+    }
+    ![sentCalls containsObject:expectedCalls.lastObject];
+  }));
+
+  [sentCalls filterUsingPredicate:[NSPredicate predicateWithFormat:@"SELF IN %@", expectedCalls]];
+  XCTAssertEqualObjects(sentCalls, expectedCalls);
+}
+
+- (void)testRecordedSessionReplaysThroughHandleBuffer
+{
+  TestExecutor *executor =  [_bridge.batchedBridge valueForKey:@"_javaScriptExecutor"];
+
+  NSString *injectedStuff;
+  RUN_RUNLOOP_WHILE(!(injectedStuff = executor.injectedStuff[@"__fbBatchedBridgeConfig"]));
+
+  NSDictionary *moduleConfig = RCTJSONParse(injectedStuff, NULL);
+  NSDictionary *testModuleConfig = moduleConfig[@"remoteModuleConfig"][@"TestModule"];
+  NSNumber *testModuleID = testModuleConfig[@"moduleID"];
+  NSNumber *recordMethodID = testModuleConfig[@"methods"][@"recordValue"][@"methodID"];
+
+  // Calls into JS are recorded by the bridge
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"RCTBridgeTests.jsonl"];
+  [_bridge startRecordingToPath:path];
+  [_bridge enqueueJSCall:@"RCTEventEmitter.receiveEvent" args:@[@1, @"topTap", @{}]];
+  RUN_RUNLOOP_WHILE(({
+    BOOL sent = NO;
+    @synchronized(executor.JSCalls) {
+      for (NSArray *call in executor.JSCalls) {
+        sent |= [call[1] isEqualToString:@"processBatch"];
+      }
+    }
+    !sent;
+  }));
+  [_bridge stopRecording];
+
+  NSArray *events = [RCTBridgeRecorder eventsWithContentsOfFile:path error:NULL];
+  NSUInteger batchIndex = [events indexOfObjectPassingTest:^BOOL(NSArray *event, __unused NSUInteger idx, __unused BOOL *stop) {
+    return [event[1] isEqualToString:@"call"] && [event[3] isEqualToString:@"processBatch"];
+  }];
+  XCTAssertLessThan(batchIndex + 1, events.count);
+  XCTAssertEqualObjects(events[batchIndex + 1][1], @"flush");
+
+  // A flush written by the recorder replays through _handleBuffer:
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithJSONBuffer:@[
+    @[testModuleID, testModuleID], @[recordMethodID, recordMethodID], @[@[@1], @[@2]],
+  ] error:NULL];
+  RCTBridgeRecorder *recorder = [[RCTBridgeRecorder alloc] initWithPath:path];
+  [recorder recordFlush:batch duration:0.002];
+  [recorder close];
+
+  _recordedValues = [NSMutableArray new];
+  for (NSArray *event in [RCTBridgeRecorder eventsWithContentsOfFile:path error:NULL]) {
+    if ([event[1] isEqualToString:@"flush"]) {
+      XCTAssertEqualObjects(event[2], @2000);
+      [_bridge.batchedBridge _handleBuffer:event[3]];
+    }
+  }
+  dispatch_sync(_methodQueue, ^{
+    XCTAssertEqualObjects(_recordedValues, (@[@1, @2]));
+  });
+}
+
+- (void)testLazyModuleIsCreatedOnFirstCall
+{
+  TestExecutor *executor =  [_bridge.batchedBridge valueForKey:@"_javaScriptExecutor"];
+
+  NSString *injectedStuff;
+  RUN_RUNLOOP_WHILE(!(injectedStuff = executor.injectedStuff[@"__fbBatchedBridgeConfig"]));
+
+  NSDictionary *moduleConfig = RCTJSONParse(injectedStuff, NULL);
+  NSDictionary *lazyModuleConfig = moduleConfig[@"remoteModuleConfig"][@"RCTLazyTestModule"];
+  NSNumber *lazyModuleID = lazyModuleConfig[@"moduleID"];
+  NSNumber *methodID = lazyModuleConfig[@"methods"][@"doSomething"][@"methodID"];
+  XCTAssertNotNil(lazyModuleID);
+  XCTAssertNotNil(methodID);
+
+  RCTModuleData *moduleData = [_bridge.batchedBridge valueForKey:@"_moduleDataByID"][lazyModuleID.integerValue];
+  XCTAssertFalse(moduleData.hasInstance);
+
+  [_bridge.batchedBridge _handleBuffer:@[@[lazyModuleID], @[methodID], @[@[]], @[], @1234567]];
+
+  XCTAssertTrue(moduleData.hasInstance);
+  RCTLazyTestModule *module = (RCTLazyTestModule *)moduleData.instance;
+  XCTAssertEqual(module, _bridge.modules[@"RCTLazyTestModule"]);
+  dispatch_sync(module.methodQueue, ^{
+    XCTAssertTrue(module.methodCalled);
+  });
+}
+
+- (void)testSharedModuleIsSharedAcrossBridges
+{
+  RCTBridge *otherBridge = [[RCTBridge alloc] initWithBundleURL:nil
+                                                 moduleProvider:nil
+                                                  launchOptions:nil];
+  otherBridge.executorClass = [TestExecutor class];
+  [otherBridge invalidate];
+  [otherBridge setUp];
+
+  RCTSharedTestModule *module = _bridge.modules[@"RCTSharedTestModule"];
+  XCTAssertNotNil(module);
+  XCTAssertEqual(module, otherBridge.modules[@"RCTSharedTestModule"]);
+
+  RCTModuleData *moduleData = [_bridge.batchedBridge valueForKey:@"_moduleDataByName"][@"RCTSharedTestModule"];
+  dispatch_queue_t queue = moduleData.queue;
+  RCTModuleData *otherModuleData = [otherBridge.batchedBridge valueForKey:@"_moduleDataByName"][@"RCTSharedTestModule"];
+  XCTAssertEqual(queue, otherModuleData.queue);
+
+  [otherBridge invalidate];
+  dispatch_sync(queue, ^{
+    XCTAssertFalse(module.invalidated);
+  });
+
+  [_bridge invalidate];
+  dispatch_sync(queue, ^{
+    XCTAssertTrue(module.invalidated);
+  });
+}
+
 - (void)DISABLED_testBadArgumentsCount
 {
   //NSArray *bufferWithMissingArgument = @[@[@1], @[@0], @[@[@1234, @5678, @"stringy", @{@"a": @1}/*, @42*/]], @[], @1234567];
@@ -204,4 +482,14 @@ RCT_EXPORT_METHOD(testMethod:(NSInteger)integer
   return @{@"eleventyMillion": @42};
 }
 
+RCT_EXPORT_METHOD(callBack:(RCTResponseSenderBlock)callback)
+{
+  callback(@[@"result"]);
+}
+
+RCT_EXPORT_METHOD(recordValue:(NSInteger)value)
+{
+  [_recordedValues addObject:@(value)];
+}
+
 @end
@@ -0,0 +1,86 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTBridgeTraffic.h"
+#import "RCTUtils.h"
+
+@interface RCTBridgeTrafficTests : XCTestCase
+
+@end
+
+@implementation RCTBridgeTrafficTests
+{
+  RCTBridgeTraffic *_bridgeTraffic;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _bridgeTraffic = [RCTBridgeTraffic new];
+  _bridgeTraffic.recording = YES;
+}
+
+- (void)tearDown
+{
+  _bridgeTraffic.recording = NO;
+  _bridgeTraffic = nil;
+
+  [super tearDown];
+}
+
+- (void)testRecordingFlag
+{
+  XCTAssertTrue(RCTBridgeTrafficIsRecording());
+  _bridgeTraffic.recording = NO;
+  XCTAssertFalse(RCTBridgeTrafficIsRecording());
+}
+
+- (void)testCallsAreCountedPerMethod
+{
+  [_bridgeTraffic recordCallToModule:@"UIManager" method:@"createView" argumentBytes:40 duration:0.002];
+  [_bridgeTraffic recordCallToModule:@"UIManager" method:@"createView" argumentBytes:60 duration:0.003];
+  [_bridgeTraffic recordCallToModule:@"UIManager" method:@"manageChildren" argumentBytes:10 duration:0.001];
+
+  NSDictionary *createView = [_bridgeTraffic stats][@"calls"][@"UIManager"][@"createView"];
+  XCTAssertEqualObjects(createView[@"count"], @2);
+  XCTAssertEqualObjects(createView[@"argumentBytes"], @100);
+  XCTAssertEqualWithAccuracy([createView[@"time"] doubleValue], 5, 0.01);
+  XCTAssertEqualObjects([_bridgeTraffic stats][@"calls"][@"UIManager"][@"manageChildren"][@"count"], @1);
+
+  [_bridgeTraffic reset];
+  XCTAssertEqualObjects([_bridgeTraffic stats][@"calls"], @{});
+}
+
+- (void)testEventsAreCountedPerName
+{
+  [_bridgeTraffic recordEventWithName:@"topScroll"];
+  [_bridgeTraffic recordEventWithName:@"topScroll"];
+  [_bridgeTraffic recordEventWithName:@"appStateDidChange"];
+
+  NSDictionary *events = [_bridgeTraffic stats][@"events"];
+  XCTAssertEqualObjects(events, (@{@"topScroll": @2, @"appStateDidChange": @1}));
+}
+
+- (void)testArgumentBytesMatchJSON
+{
+  NSArray *arguments = @[@12, @"RCTView", @{@"opacity": @0.5, @"testID": [NSNull null]}, @[]];
+  NSString *JSON = RCTJSONStringify(arguments, NULL);
+  XCTAssertEqual(RCTBridgeTrafficArgumentBytes(arguments), [JSON lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
+}
+
+@end
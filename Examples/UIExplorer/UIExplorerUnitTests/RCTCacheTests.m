@@ -21,9 +21,6 @@
 @interface RCTCache (Private)
 
 - (void)cleanUpAllObjects;
-- (void)resequence;
-- (NSDictionary *)cache;
-- (void)setSequenceNumber:(NSInteger)number;
 
 @end
 
@@ -113,50 +110,95 @@
   XCTAssertEqual([self.cache totalCost], 0);
 }
 
-- (void)testResequence
+- (void)testAccessRefreshesEvictionOrder
 {
   [self.cache setObject:@1 forKey:@"foo"];
   [self.cache setObject:@2 forKey:@"bar"];
   [self.cache setObject:@3 forKey:@"baz"];
 
-  [self.cache resequence];
+  //foo is now the most recently used, so bar should be evicted first
+  [self.cache objectForKey:@"foo"];
+  [self.cache setObject:@4 forKey:@"bam"];
+
+  XCTAssertNil([self.cache objectForKey:@"bar"]);
+  XCTAssertEqualObjects([self.cache objectForKey:@"foo"], @1);
+
+  //replacing an object also counts as using it
+  [self.cache setObject:@5 forKey:@"baz"];
+  [self.cache setObject:@6 forKey:@"boo"];
+
+  XCTAssertNil([self.cache objectForKey:@"bam"]);
+  XCTAssertEqualObjects([self.cache objectForKey:@"baz"], @5);
+}
 
-  NSDictionary *innerCache = [self.cache cache];
-  XCTAssertEqualObjects([innerCache[@"foo"] valueForKey:@"sequenceNumber"], @0);
-  XCTAssertEqualObjects([innerCache[@"bar"] valueForKey:@"sequenceNumber"], @1);
-  XCTAssertEqualObjects([innerCache[@"baz"] valueForKey:@"sequenceNumber"], @2);
+- (void)testReplacementUpdatesCost
+{
+  [self.cache setObject:@1 forKey:@"foo" cost:10];
+  [self.cache setObject:@2 forKey:@"foo" cost:20];
+
+  XCTAssertEqual([self.cache count], 1);
+  XCTAssertEqual([self.cache totalCost], 20);
 
   [self.cache removeObjectForKey:@"foo"];
-  [self.cache resequence];
 
-  XCTAssertEqualObjects([innerCache[@"bar"] valueForKey:@"sequenceNumber"], @0);
-  XCTAssertEqualObjects([innerCache[@"baz"] valueForKey:@"sequenceNumber"], @1);
+  XCTAssertEqual([self.cache totalCost], 0);
 }
 
-- (void)testResequenceTrigger
+- (void)testCounters
 {
   [self.cache setObject:@1 forKey:@"foo"];
   [self.cache setObject:@2 forKey:@"bar"];
+  [self.cache setObject:@3 forKey:@"baz"];
+  [self.cache setObject:@4 forKey:@"bam"];
 
-  //first object should now be bar with sequence number of 1
-  [self.cache removeObjectForKey:@"foo"];
+  [self.cache objectForKey:@"foo"];
+  [self.cache objectForKey:@"bar"];
+  [self.cache objectForKey:@"bam"];
 
-  //should trigger resequence
-  [self.cache setSequenceNumber:NSIntegerMax];
-  [self.cache setObject:@3 forKey:@"baz"];
+  XCTAssertEqual([self.cache hitCount], 2);
+  XCTAssertEqual([self.cache missCount], 1);
+  XCTAssertEqual([self.cache evictionCount], 1);
+}
 
-  NSDictionary *innerCache = [self.cache cache];
-  XCTAssertEqualObjects([innerCache[@"bar"] valueForKey:@"sequenceNumber"], @0);
-  XCTAssertEqualObjects([innerCache[@"baz"] valueForKey:@"sequenceNumber"], @1);
+- (void)testShardedCache
+{
+  RCTCache *cache = [[RCTCache alloc] initWithShardCount:4];
+  cache.totalCostLimit = 400;
+
+  for (NSInteger i = 0; i < 100; i++) {
+    [cache setObject:@(i) forKey:@(i) cost:10];
+  }
+
+  XCTAssertLessThanOrEqual([cache totalCost], 400);
+  XCTAssertEqual([cache totalCost], [cache count] * 10);
+  XCTAssertEqual([cache evictionCount], 100 - [cache count]);
+
+  NSUInteger enumerated = 0;
+  for (id key in cache) {
+    XCTAssertEqualObjects([cache objectForKey:key], key);
+    enumerated++;
+  }
+  XCTAssertEqual(enumerated, [cache count]);
+
+  [cache removeAllObjects];
+  XCTAssertEqual([cache count], 0);
+}
 
-  //first object should now be baz with sequence number of 1
-  [self.cache removeObjectForKey:@"bar"];
+- (void)testTrimToCost
+{
+  [self.cache setObject:@1 forKey:@"foo" cost:10];
+  [self.cache setObject:@2 forKey:@"bar" cost:20];
+  [self.cache setObject:@3 forKey:@"baz" cost:30];
+
+  [self.cache trimToCost:50];
+
+  XCTAssertEqual([self.cache count], 2);
+  XCTAssertEqual([self.cache totalCost], 50);
+  XCTAssertNil([self.cache objectForKey:@"foo"]);
 
-  //should also trigger resequence
-  [self.cache setSequenceNumber:NSIntegerMax];
-  [self.cache objectForKey:@"baz"];
+  [self.cache trimToCost:0];
 
-  XCTAssertEqualObjects([innerCache[@"baz"] valueForKey:@"sequenceNumber"], @0);
+  XCTAssertEqual([self.cache count], 0);
 }
 
 - (void)testName
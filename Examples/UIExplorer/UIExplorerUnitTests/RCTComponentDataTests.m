@@ -0,0 +1,202 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTComponentData.h"
+#import "RCTViewManager.h"
+#import "UIView+React.h"
+
+@interface RCTRecyclingTestViewManager : RCTViewManager
+
+@end
+
+@implementation RCTRecyclingTestViewManager
+
+RCT_EXPORT_VIEW_PROPERTY(alpha, CGFloat)
+RCT_EXPORT_VIEW_PROPERTY(backgroundColor, UIColor)
+RCT_REMAP_VIEW_PROPERTY(shadowOffset, layer.shadowOffset, CGSize)
+
+- (UIView *)view
+{
+  return [UIView new];
+}
+
+- (NSUInteger)recycledViewPoolSize
+{
+  return 1;
+}
+
+@end
+
+@interface RCTControlledSwitchTestViewManager : RCTViewManager
+
+@end
+
+@implementation RCTControlledSwitchTestViewManager
+
+RCT_REMAP_VIEW_PROPERTY(value, on, BOOL)
+
+- (UIView *)view
+{
+  return [UISwitch new];
+}
+
+@end
+
+@interface RCTControlledTextFieldTestViewManager : RCTViewManager
+
+@end
+
+@implementation RCTControlledTextFieldTestViewManager
+
+RCT_EXPORT_VIEW_PROPERTY(text, NSString)
+
+- (UIView *)view
+{
+  return [UITextField new];
+}
+
+@end
+
+@interface RCTComponentDataTests : XCTestCase
+
+@end
+
+@implementation RCTComponentDataTests
+{
+  RCTComponentData *_componentData;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _componentData = [[RCTComponentData alloc] initWithManager:[RCTRecyclingTestViewManager new]];
+}
+
+- (void)testRecycledViewIsReusedWithDefaultProps
+{
+  XCTAssertTrue(_componentData.recyclesViews);
+
+  UIView *view = (UIView *)[_componentData createViewWithTag:@2 props:@{}];
+  [_componentData setProps:@{@"alpha": @0.5} forView:view];
+  XCTAssertEqualWithAccuracy(view.alpha, 0.5, 0.001);
+
+  XCTAssertTrue([_componentData recycleView:view]);
+  XCTAssertNil(view.reactTag);
+  XCTAssertEqualWithAccuracy(view.alpha, 1, 0.001);
+
+  UIView *reusedView = (UIView *)[_componentData createViewWithTag:@3 props:@{}];
+  XCTAssertEqual(reusedView, view);
+  XCTAssertEqualObjects(reusedView.reactTag, @3);
+}
+
+- (void)testRecycledViewPoolIsBounded
+{
+  UIView *firstView = (UIView *)[_componentData createViewWithTag:@2 props:@{}];
+  UIView *secondView = (UIView *)[_componentData createViewWithTag:@3 props:@{}];
+
+  XCTAssertTrue([_componentData recycleView:firstView]);
+  XCTAssertFalse([_componentData recycleView:secondView]);
+  XCTAssertEqualObjects(secondView.reactTag, @3);
+
+  // Views that weren't created by this component are never recycled
+  XCTAssertFalse([_componentData recycleView:(id<RCTComponent>)[UIView new]]);
+}
+
+- (void)testStructPropsAreSetThroughKeyPathAndReset
+{
+  UIView *view = (UIView *)[_componentData createViewWithTag:@2 props:@{}];
+  CGSize defaultOffset = view.layer.shadowOffset;
+
+  [_componentData setProps:@{@"shadowOffset": @{@"width": @2, @"height": @3}} forView:view];
+  XCTAssertTrue(CGSizeEqualToSize(view.layer.shadowOffset, CGSizeMake(2, 3)));
+
+  [_componentData setProps:@{@"shadowOffset": (id)kCFNull} forView:view];
+  XCTAssertTrue(CGSizeEqualToSize(view.layer.shadowOffset, defaultOffset));
+}
+
+- (void)testPreparedPropsOnlyContainChangedProps
+{
+  NSDictionary *props = [_componentData preparedProps:@{@"alpha": @0.5, @"backgroundColor": @0xff0000ff}
+                                       forViewWithTag:@2];
+  XCTAssertEqual(props.count, 2);
+
+  props = [_componentData preparedProps:@{@"alpha": @0.5, @"backgroundColor": @0xff0000ff}
+                         forViewWithTag:@2];
+  XCTAssertNil(props);
+
+  props = [_componentData preparedProps:@{@"alpha": @1, @"backgroundColor": @0xff0000ff}
+                         forViewWithTag:@2];
+  XCTAssertEqualObjects(props.allKeys, @[@"alpha"]);
+
+  [_componentData forgetPreparedPropsForViewWithTag:@2];
+  props = [_componentData preparedProps:@{@"alpha": @1} forViewWithTag:@2];
+  XCTAssertEqualObjects(props.allKeys, @[@"alpha"]);
+}
+
+- (void)testPreparedPropsAreConvertedBeforeBeingSet
+{
+  NSDictionary *props = [_componentData preparedProps:@{@"backgroundColor": @0xff0000ff}
+                                       forViewWithTag:@2];
+  XCTAssertNotEqualObjects(props[@"backgroundColor"], @0xff0000ff);
+
+  UIView *view = (UIView *)[_componentData createViewWithTag:@2 props:@{}];
+  [_componentData setProps:props forView:view];
+  XCTAssertEqualObjects(view.backgroundColor, [RCTConvert UIColor:@0xff0000ff]);
+}
+
+- (void)testSetNativePropsResetsToggledControlledSwitch
+{
+  RCTComponentData *componentData =
+    [[RCTComponentData alloc] initWithManager:[RCTControlledSwitchTestViewManager new]];
+  UISwitch *view = (UISwitch *)[componentData createViewWithTag:@2 props:@{}];
+  [componentData setProps:[componentData preparedProps:@{@"value": @NO} forViewWithTag:@2]
+                  forView:view];
+  XCTAssertFalse(view.on);
+
+  // The user toggles the switch, and SwitchIOS sends its unchanged value back
+  view.on = YES;
+  XCTAssertNil([componentData preparedProps:@{@"value": @NO} forViewWithTag:@2]);
+  NSDictionary *props = [componentData preparedProps:@{@"value": @NO}
+                                      forViewWithTag:@2
+                             resendingUnchangedProps:YES];
+  XCTAssertEqualObjects(props.allKeys, @[@"value"]);
+  [componentData setProps:props forView:view];
+  XCTAssertFalse(view.on);
+}
+
+- (void)testSetNativePropsClearsEditedTextField
+{
+  RCTComponentData *componentData =
+    [[RCTComponentData alloc] initWithManager:[RCTControlledTextFieldTestViewManager new]];
+  UITextField *view = (UITextField *)[componentData createViewWithTag:@2 props:@{}];
+  [componentData setProps:[componentData preparedProps:@{@"text": @""} forViewWithTag:@2]
+                  forView:view];
+
+  // The user types, then TextInput.clear() sends the empty text it sent before
+  view.text = @"typed";
+  NSDictionary *props = [componentData preparedProps:@{@"text": @""}
+                                      forViewWithTag:@2
+                             resendingUnchangedProps:YES];
+  [componentData setProps:props forView:view];
+  XCTAssertEqualObjects(view.text, @"");
+
+  // The resent props are still remembered for later updates
+  XCTAssertNil([componentData preparedProps:@{@"text": @""} forViewWithTag:@2]);
+}
+
+@end
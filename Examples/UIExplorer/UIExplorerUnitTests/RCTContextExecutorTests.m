@@ -49,6 +49,78 @@
   [_executor invalidate];
 }
 
+- (id)callModule:(NSString *)module method:(NSString *)method arguments:(NSArray *)arguments
+{
+  __block id result;
+  dispatch_semaphore_t doneSem = dispatch_semaphore_create(0);
+  [_executor executeJSCall:module
+                    method:method
+                 arguments:arguments
+                  callback:^(id json, __unused NSError *error) {
+                    result = json;
+                    dispatch_semaphore_signal(doneSem);
+                  }];
+  dispatch_semaphore_wait(doneSem, DISPATCH_TIME_FOREVER);
+  return result;
+}
+
+- (void)executeScript:(NSString *)script
+{
+  dispatch_semaphore_t doneSem = dispatch_semaphore_create(0);
+  [_executor executeApplicationScript:script
+                           sourceURL:[NSURL URLWithString:@"file://"]
+                          onComplete:^(__unused id error){
+                            dispatch_semaphore_signal(doneSem);
+                          }];
+  dispatch_semaphore_wait(doneSem, DISPATCH_TIME_FOREVER);
+}
+
+- (void)testCachedModuleFunctions
+{
+  [self executeScript:@"var modules = {m: {"
+                      "  none: function() { return 'none'; },"
+                      "  one: function(a) { return a; },"
+                      "  two: function(a, b) { return a + b; }"
+                      "}}; function require(name) { return modules[name]; }"];
+
+  for (int i = 0; i < 2; i++) {
+    XCTAssertEqualObjects([self callModule:@"m" method:@"none" arguments:@[]], @"none");
+    XCTAssertEqualObjects([self callModule:@"m" method:@"one" arguments:@[@3]], @3);
+    XCTAssertEqualObjects([self callModule:@"m" method:@"two" arguments:@[@3, @4]], @7);
+  }
+
+  // A new script can replace the modules resolved so far
+  [self executeScript:@"modules = {m: {none: function() { return 'replaced'; }}};"];
+  XCTAssertEqualObjects([self callModule:@"m" method:@"none" arguments:@[]], @"replaced");
+
+  [_executor invalidate];
+}
+
+- (void)testDirectConversionMatchesJSON
+{
+  JSGlobalContextRef context = JSGlobalContextCreate(NULL);
+  id message = @[@[@1, @2, @3], @[@{@"a": @1.5, @"b": @"str", @"c": @YES}, @[]], (id)kCFNull, @-7];
+
+  JSValueRef value = RCTJSValueFromJSONObject(context, message, RCTJSDirectConversionMaxValues);
+  XCTAssertTrue(value != NULL);
+  BOOL fallback = NO;
+  id roundTripped = RCTJSONObjectFromJSValue(context, value, RCTJSDirectConversionMaxValues, &fallback);
+  XCTAssertFalse(fallback);
+  XCTAssertEqualObjects(roundTripped, message);
+
+  // Values JSON.stringify treats specially are left to it
+  JSStringRef script = JSStringCreateWithUTF8CString("[new Date(0)]");
+  JSValueRef date = JSEvaluateScript(context, script, NULL, NULL, 0, NULL);
+  JSStringRelease(script);
+  XCTAssertNil(RCTJSONObjectFromJSValue(context, date, RCTJSDirectConversionMaxValues, &fallback));
+  XCTAssertTrue(fallback);
+
+  // As are payloads over the limit
+  XCTAssertTrue(RCTJSValueFromJSONObject(context, @[@1, @2, @3], 3) == NULL);
+
+  JSGlobalContextRelease(context);
+}
+
 #if RUN_PERF_TESTS
 
 static uint64_t _get_time_nanoseconds(void)
@@ -94,6 +166,45 @@ static uint64_t _get_time_nanoseconds(void)
   JSContextGroupRelease(group);
 }
 
+- (void)testConversionPerf
+{
+  // Compares the direct conversion executeJSCall uses for small payloads with
+  // the JSON round trip, for a flushed queue of a few UIManager calls
+
+  JSGlobalContextRef context = JSGlobalContextCreate(NULL);
+  id message = @[@[@9, @9, @9], @[@4, @2, @4], @[@[@3, @"RCTView", @1, @{@"top": @10, @"opacity": @0.5}], @[@1, @[@3]], @[@4, @"RCTText", @1, @{@"text": @"hello"}]], @12];
+  JSValueRef value = RCTJSValueFromJSONObject(context, message, RCTJSDirectConversionMaxValues);
+  int const runs = 10000;
+
+  id obj;
+  uint64_t start = _get_time_nanoseconds();
+  for (int i = 0; i < runs; i++) {
+    @autoreleasepool {
+      NSString *json = RCTJSONStringify(message, NULL);
+      JSStringRef jsonJSString = JSStringCreateWithCFString((__bridge CFStringRef)json);
+      JSValueMakeFromJSONString(context, jsonJSString);
+      JSStringRelease(jsonJSString);
+
+      jsonJSString = JSValueCreateJSONString(context, value, 0, nil);
+      NSString *jsonString = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, jsonJSString);
+      JSStringRelease(jsonJSString);
+      obj = RCTJSONParse(jsonString, NULL);
+    }
+  }
+  NSLog(@"JSON round trip time: %.2fms", (_get_time_nanoseconds() - start) / 1000000.0);
+
+  start = _get_time_nanoseconds();
+  for (int i = 0; i < runs; i++) {
+    @autoreleasepool {
+      RCTJSValueFromJSONObject(context, message, RCTJSDirectConversionMaxValues);
+      obj = RCTJSONObjectFromJSValue(context, value, RCTJSDirectConversionMaxValues, NULL);
+    }
+  }
+  NSLog(@"Direct conversion time: %.2fms", (_get_time_nanoseconds() - start) / 1000000.0);
+
+  JSGlobalContextRelease(context);
+}
+
 - (void)testJavaScriptCallSpeed
 {
 /**
@@ -178,6 +178,17 @@
   }
 }
 
+- (void)testCachedFontIsShared
+{
+  UIFont *font = [RCTConvert UIFont:@{@"fontFamily": @"Helvetica Neue", @"fontSize": @16, @"fontWeight": @"bold"}];
+  UIFont *sameFont = [RCTConvert UIFont:@{@"fontFamily": @"Helvetica Neue", @"fontSize": @16, @"fontWeight": @"bold"}];
+  XCTAssertEqual(font, sameFont);
+
+  UIFont *otherFont = [RCTConvert UIFont:@{@"fontFamily": @"Helvetica Neue", @"fontSize": @16, @"fontWeight": @"normal"}];
+  XCTAssertNotEqual(font, otherFont);
+  XCTAssertEqual([RCTConvert UIFont:font withSize:@20], [RCTConvert UIFont:font withSize:@20]);
+}
+
 - (void)testInvalidFont
 {
   {
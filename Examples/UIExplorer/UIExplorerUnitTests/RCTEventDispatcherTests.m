@@ -144,4 +144,75 @@
   [_bridge verify];
 }
 
+- (void)testLatestWinsPolicyReplacesQueuedInputEvents
+{
+  [_eventDispatcher setCoalescingPolicy:RCTEventCoalescingPolicyLatestWins forEventName:_eventName];
+
+  [_eventDispatcher sendInputEventWithName:_eventName body:@{@"target": @1, @"value": @1}];
+  [_eventDispatcher sendInputEventWithName:_eventName body:@{@"target": @1, @"value": @2}];
+
+  NSDictionary *body = @{@"target": @1, @"value": @2};
+  [[_bridge expect] enqueueJSCall:@"RCTEventEmitter.receiveEvent"
+                             args:@[@1, _eventName, body]];
+
+  [(id<RCTFrameUpdateObserver>)_eventDispatcher didUpdateFrame:nil];
+
+  [_bridge verify];
+}
+
+- (void)testNonCoalescingEventsAreDispatchedAfterQueuedEvents
+{
+  [_bridge setExpectationOrderMatters:YES];
+
+  RCTTestEvent *nonCoalescingEvent = [[RCTTestEvent alloc] initWithViewTag:nil
+                                                                 eventName:RCTNormalizeInputEventName(@"otherEvent")
+                                                                      body:_body];
+  nonCoalescingEvent.canCoalesce = NO;
+
+  [[_bridge expect] enqueueJSCall:_JSMethod
+                             args:@[_eventName, _body]];
+  [[_bridge expect] enqueueJSCall:_JSMethod
+                             args:@[nonCoalescingEvent.eventName, _body]];
+
+  [_eventDispatcher sendEvent:_testEvent];
+  [_eventDispatcher sendEvent:nonCoalescingEvent];
+
+  [_bridge verify];
+}
+
+- (void)testPauseCallbackIsCalledWhenQueuedEventsChange
+{
+  id<RCTFrameUpdateObserver> observer = (id<RCTFrameUpdateObserver>)_eventDispatcher;
+  __block NSUInteger pauseCallbackCount = 0;
+  observer.pauseCallback = ^{
+    pauseCallbackCount++;
+  };
+  XCTAssertTrue(observer.paused);
+
+  [_eventDispatcher sendEvent:_testEvent];
+  XCTAssertFalse(observer.paused);
+  XCTAssertEqual(pauseCallbackCount, 1);
+
+  [[_bridge expect] enqueueJSCall:_JSMethod
+                             args:@[_eventName, _body]];
+
+  [observer didUpdateFrame:nil];
+  XCTAssertTrue(observer.paused);
+  XCTAssertEqual(pauseCallbackCount, 2);
+
+  [_bridge verify];
+}
+
+- (void)testOldestEventsAreDroppedWhenQueueIsFull
+{
+  for (NSInteger i = 1; i <= 300; i++) {
+    RCTTestEvent *event = [[RCTTestEvent alloc] initWithViewTag:@(i)
+                                                      eventName:_eventName
+                                                           body:_body];
+    [_eventDispatcher sendEvent:event];
+  }
+
+  XCTAssertEqual(_eventDispatcher.droppedEventCount, 44);
+}
+
 @end
@@ -0,0 +1,93 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTFrameTiming.h"
+
+static const CFTimeInterval RCTTestFrameDuration = 1.0 / 60;
+
+@interface RCTFrameTimingTests : XCTestCase
+
+@end
+
+@implementation RCTFrameTimingTests
+{
+  RCTFrameTiming *_frameTiming;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _frameTiming = [RCTFrameTiming new];
+  _frameTiming.recording = YES;
+}
+
+- (void)tearDown
+{
+  _frameTiming.recording = NO;
+  _frameTiming = nil;
+
+  [super tearDown];
+}
+
+- (void)recordFrameAt:(CFTimeInterval)timestamp
+{
+  [_frameTiming recordFrameOnThread:RCTFrameTimingThreadJS
+                          timestamp:timestamp
+                           duration:RCTTestFrameDuration];
+}
+
+- (void)testHistogram
+{
+  [self recordFrameAt:1];
+  [self recordFrameAt:1 + RCTTestFrameDuration];
+  [self recordFrameAt:1 + 2 * RCTTestFrameDuration];
+  [self recordFrameAt:1 + 6 * RCTTestFrameDuration];
+
+  NSDictionary *stats = [_frameTiming stats][@"js"];
+  XCTAssertEqualObjects(stats[@"frames"], @3);
+  XCTAssertEqualObjects(stats[@"jankyFrames"], @1);
+  XCTAssertEqualObjects(stats[@"droppedFrames"], @3);
+  XCTAssertEqualObjects(stats[@"histogram"], (@[@2, @0, @0, @1, @0, @0]));
+}
+
+- (void)testJankAttribution
+{
+  [self recordFrameAt:1];
+  RCTFrameTimingAddWork(RCTFrameWorkJSCalls, 0.04);
+  RCTFrameTimingAddWork(RCTFrameWorkJSCalls, 0.01);
+  [self recordFrameAt:1 + 3 * RCTTestFrameDuration];
+
+  NSArray *jank = [_frameTiming stats][@"js"][@"jank"];
+  XCTAssertEqual(jank.count, 1u);
+  XCTAssertEqualObjects(jank[0][@"droppedFrames"], @2);
+  XCTAssertEqualObjects(jank[0][@"jsCalls"][@"count"], @2);
+  XCTAssertEqualWithAccuracy([jank[0][@"jsCalls"][@"time"] doubleValue], 50, 0.01);
+}
+
+- (void)testReset
+{
+  [self recordFrameAt:1];
+  [self recordFrameAt:1 + 4 * RCTTestFrameDuration];
+  [_frameTiming reset];
+
+  NSDictionary *stats = [_frameTiming stats][@"js"];
+  XCTAssertEqualObjects(stats[@"frames"], @0);
+  XCTAssertEqual([stats[@"jank"] count], 0u);
+}
+
+@end
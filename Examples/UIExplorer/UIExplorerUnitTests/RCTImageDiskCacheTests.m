@@ -0,0 +1,87 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTImageDiskCache.h"
+
+@interface RCTImageDiskCacheTests : XCTestCase
+
+@end
+
+@implementation RCTImageDiskCacheTests
+{
+  NSString *_directory;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown
+{
+  [[NSFileManager defaultManager] removeItemAtPath:_directory error:NULL];
+
+  [super tearDown];
+}
+
+- (NSData *)dataOfLength:(NSUInteger)length
+{
+  return [NSMutableData dataWithLength:length];
+}
+
+- (void)testStoresData
+{
+  RCTImageDiskCache *cache = [[RCTImageDiskCache alloc] initWithDirectory:_directory sizeLimit:1000];
+  NSData *data = [self dataOfLength:100];
+  [cache setData:data forKey:@"http://example.com/a.png"];
+
+  XCTAssertEqualObjects([cache dataForKey:@"http://example.com/a.png"], data);
+  XCTAssertNil([cache dataForKey:@"http://example.com/b.png"]);
+  XCTAssertEqual(cache.totalSize, 100);
+
+  [cache removeDataForKey:@"http://example.com/a.png"];
+  XCTAssertNil([cache dataForKey:@"http://example.com/a.png"]);
+  XCTAssertEqual(cache.totalSize, 0);
+}
+
+- (void)testEvictsLeastRecentlyUsedData
+{
+  RCTImageDiskCache *cache = [[RCTImageDiskCache alloc] initWithDirectory:_directory sizeLimit:250];
+  [cache setData:[self dataOfLength:100] forKey:@"a"];
+  [cache setData:[self dataOfLength:100] forKey:@"b"];
+
+  // Makes "b" the least recently used
+  XCTAssertNotNil([cache dataForKey:@"a"]);
+
+  [cache setData:[self dataOfLength:100] forKey:@"c"];
+  XCTAssertNotNil([cache dataForKey:@"a"]);
+  XCTAssertNil([cache dataForKey:@"b"]);
+  XCTAssertNotNil([cache dataForKey:@"c"]);
+  XCTAssertEqual(cache.totalSize, 200);
+}
+
+- (void)testIgnoresDataLargerThanTheLimit
+{
+  RCTImageDiskCache *cache = [[RCTImageDiskCache alloc] initWithDirectory:_directory sizeLimit:50];
+  [cache setData:[self dataOfLength:100] forKey:@"a"];
+
+  XCTAssertNil([cache dataForKey:@"a"]);
+}
+
+@end
@@ -90,6 +90,38 @@ RCTDefineImageDecoder(RCTImageLoaderTestsDecoder2)
   }];
 }
 
+- (void)testImageLoaderReusesDecodedImagesOfTheSameSize
+{
+  UIImage *image = [UIImage new];
+  __block NSUInteger loadCount = 0;
+
+  id<RCTImageURLLoader> loader = [[RCTImageLoaderTestsURLLoader1 alloc] initWithPriority:1.0 canLoadImageURLHandler:^BOOL(__unused NSURL *requestURL) {
+    return YES;
+  } loadImageURLHandler:^RCTImageLoaderCancellationBlock(__unused NSURL *imageURL, __unused CGSize size, __unused CGFloat scale, __unused UIViewContentMode resizeMode, __unused RCTImageLoaderProgressBlock progressHandler, RCTImageLoaderCompletionBlock completionHandler) {
+    loadCount++;
+    completionHandler(nil, image);
+    return nil;
+  }];
+
+  RCTImageLoader *imageLoader = [RCTImageLoader new];
+  NS_VALID_UNTIL_END_OF_SCOPE RCTBridge *bridge = [[RCTBridge alloc] initWithBundleURL:nil moduleProvider:^{ return @[loader, imageLoader]; } launchOptions:nil];
+
+  NSString *imageTag = @"http://facebook.github.io/react/img/logo_og.png";
+  for (NSUInteger i = 0; i < 2; i++) {
+    [imageLoader loadImageWithTag:imageTag size:CGSizeMake(100, 100) scale:1.0 resizeMode:UIViewContentModeScaleAspectFit progressBlock:nil completionBlock:^(NSError *loadError, id loadedImage) {
+      XCTAssertEqualObjects(loadedImage, image);
+      XCTAssertNil(loadError);
+    }];
+  }
+  XCTAssertEqual(loadCount, 1);
+
+  [imageLoader loadImageWithTag:imageTag size:CGSizeMake(50, 50) scale:1.0 resizeMode:UIViewContentModeScaleAspectFit progressBlock:nil completionBlock:^(NSError *loadError, id loadedImage) {
+    XCTAssertEqualObjects(loadedImage, image);
+    XCTAssertNil(loadError);
+  }];
+  XCTAssertEqual(loadCount, 2);
+}
+
 - (void)testImageDecoding
 {
   NSData *data = [NSData dataWithBytesNoCopy:blackGIF length:sizeof(blackGIF) freeWhenDone:NO];
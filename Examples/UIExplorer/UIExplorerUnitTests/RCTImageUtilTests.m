@@ -133,4 +133,24 @@ RCTAssertEqualSizes(a.size, b.size); \
   RCTAssertEqualRects(expected, result);
 }
 
+- (void)testDecodeImageWithDataDownsamples
+{
+  UIGraphicsBeginImageContextWithOptions(CGSizeMake(400, 200), YES, 1);
+  UIImage *source = UIGraphicsGetImageFromCurrentImageContext();
+  UIGraphicsEndImageContext();
+  NSData *data = UIImagePNGRepresentation(source);
+
+  UIImage *full = RCTDecodeImageWithData(data, CGSizeZero, 1, UIViewContentModeScaleAspectFit);
+  RCTAssertEqualSizes(full.size, CGSizeMake(400, 200));
+
+  UIImage *contained = RCTDecodeImageWithData(data, CGSizeMake(100, 100), 2, UIViewContentModeScaleAspectFit);
+  XCTAssertEqual(contained.scale, 2);
+  RCTAssertEqualSizes(contained.size, CGSizeMake(100, 50));
+
+  UIImage *covered = RCTDecodeImageWithData(data, CGSizeMake(100, 100), 1, UIViewContentModeScaleAspectFill);
+  RCTAssertEqualSizes(covered.size, CGSizeMake(200, 100));
+
+  XCTAssertNil(RCTDecodeImageWithData([NSData data], CGSizeMake(100, 100), 1, UIViewContentModeScaleAspectFit));
+}
+
 @end
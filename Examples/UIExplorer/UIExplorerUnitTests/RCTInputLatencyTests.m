@@ -0,0 +1,95 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTInputLatency.h"
+
+@interface RCTInputLatencyTests : XCTestCase
+
+@end
+
+@implementation RCTInputLatencyTests
+{
+  RCTInputLatency *_inputLatency;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _inputLatency = [RCTInputLatency new];
+  _inputLatency.recording = YES;
+}
+
+- (void)tearDown
+{
+  _inputLatency.recording = NO;
+  _inputLatency = nil;
+
+  [super tearDown];
+}
+
+- (void)testNoFlowsWhileNotRecording
+{
+  _inputLatency.recording = NO;
+  XCTAssertNil(RCTInputFlowBegin(@"topTouchStart", 0));
+}
+
+- (void)testHistogram
+{
+  CFTimeInterval now = CACurrentMediaTime();
+  RCTInputFlow *fastFlow = RCTInputFlowBegin(@"topTouchStart", now);
+  RCTInputFlow *slowFlow = RCTInputFlowBegin(@"topTouchStart", now - 0.3);
+  [_inputLatency endFlows:@[fastFlow, slowFlow]];
+
+  NSDictionary *stats = [_inputLatency stats][@"events"][@"topTouchStart"];
+  XCTAssertEqualObjects(stats[@"count"], @2);
+  XCTAssertEqualObjects(stats[@"histogram"], (@[@1, @0, @0, @0, @1, @0]));
+  XCTAssertGreaterThanOrEqual([stats[@"maxLatency"] doubleValue], 300);
+}
+
+- (void)testFlowsAreRecordedOnce
+{
+  RCTInputFlow *flow = RCTInputFlowBegin(@"topTouchEnd", 0);
+  [_inputLatency endFlows:@[flow]];
+  [_inputLatency endFlows:@[flow]];
+
+  XCTAssertEqualObjects([_inputLatency stats][@"events"][@"topTouchEnd"][@"count"], @1);
+}
+
+- (void)testCurrentFlows
+{
+  RCTInputFlow *flow = RCTInputFlowBegin(@"topTouchMove", 0);
+  XCTAssertNil(RCTCurrentInputFlows());
+  RCTPerformWithInputFlows(@[flow], ^{
+    XCTAssertEqualObjects(RCTCurrentInputFlows(), @[flow]);
+    RCTPerformWithInputFlows(nil, ^{
+      XCTAssertNil(RCTCurrentInputFlows());
+    });
+    XCTAssertEqualObjects(RCTCurrentInputFlows(), @[flow]);
+  });
+  XCTAssertNil(RCTCurrentInputFlows());
+}
+
+- (void)testReset
+{
+  [_inputLatency endFlows:@[RCTInputFlowBegin(@"topTouchStart", 0)]];
+  [_inputLatency reset];
+
+  XCTAssertEqual([[_inputLatency stats][@"events"] count], 0u);
+}
+
+@end
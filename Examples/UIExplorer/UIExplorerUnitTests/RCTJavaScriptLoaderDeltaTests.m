@@ -0,0 +1,159 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <CommonCrypto/CommonDigest.h>
+#import <XCTest/XCTest.h>
+
+#import "RCTJavaScriptLoader.h"
+
+@interface RCTJavaScriptLoaderDeltaTests : XCTestCase
+
+@end
+
+@implementation RCTJavaScriptLoaderDeltaTests
+{
+  NSURL *_baseURL;
+  NSURL *_deltaURL;
+  NSURL *_outputURL;
+  NSData *_base;
+}
+
+static NSData *RCTTestDigest(NSData *data)
+{
+  uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+  CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+  return [NSData dataWithBytes:digest length:sizeof(digest)];
+}
+
+static void RCTTestAppendUInt32(NSMutableData *data, uint32_t value)
+{
+  uint8_t bytes[4] = {value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24};
+  [data appendBytes:bytes length:sizeof(bytes)];
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  NSURL *directory = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+  NSString *name = [NSUUID UUID].UUIDString;
+  _baseURL = [directory URLByAppendingPathComponent:[name stringByAppendingString:@".base.js"]];
+  _deltaURL = [directory URLByAppendingPathComponent:[name stringByAppendingString:@".delta"]];
+  _outputURL = [directory URLByAppendingPathComponent:[name stringByAppendingString:@".js"]];
+
+  _base = [@"__d('a',function(){});\n__d('b',function(){});\n__d('c',function(){});\n"
+           dataUsingEncoding:NSUTF8StringEncoding];
+  [_base writeToURL:_baseURL atomically:YES];
+}
+
+- (void)tearDown
+{
+  for (NSURL *URL in @[_baseURL, _deltaURL, _outputURL]) {
+    [[NSFileManager defaultManager] removeItemAtURL:URL error:NULL];
+  }
+
+  [super tearDown];
+}
+
+/**
+ * A delta that keeps the first and last module of the base and replaces the
+ * one in the middle.
+ */
+- (NSData *)writeDeltaWithBaseDigest:(NSData *)baseDigest bundleDigest:(NSData *)bundleDigest
+{
+  NSData *body = [@"__d('b',function(){return 2;});\n" dataUsingEncoding:NSUTF8StringEncoding];
+  NSMutableData *bundle = [[_base subdataWithRange:NSMakeRange(0, 23)] mutableCopy];
+  [bundle appendData:body];
+  [bundle appendData:[_base subdataWithRange:NSMakeRange(46, _base.length - 46)]];
+
+  NSMutableData *delta = [[@"RNDELTA1" dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+  [delta appendData:baseDigest ?: RCTTestDigest(_base)];
+  [delta appendData:bundleDigest ?: RCTTestDigest(bundle)];
+  RCTTestAppendUInt32(delta, 3);
+  RCTTestAppendUInt32(delta, 0);
+  RCTTestAppendUInt32(delta, 23);
+  RCTTestAppendUInt32(delta, 0xFFFFFFFF);
+  RCTTestAppendUInt32(delta, (uint32_t)body.length);
+  [delta appendData:body];
+  RCTTestAppendUInt32(delta, 46);
+  RCTTestAppendUInt32(delta, (uint32_t)_base.length - 46);
+  [delta writeToURL:_deltaURL atomically:YES];
+  return bundle;
+}
+
+- (void)testApplyDelta
+{
+  NSData *bundle = [self writeDeltaWithBaseDigest:nil bundleDigest:nil];
+
+  NSError *error;
+  XCTAssertTrue([RCTJavaScriptLoader applyDeltaAtURL:_deltaURL
+                                       toBundleAtURL:_baseURL
+                                           outputURL:_outputURL
+                                               error:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects([NSData dataWithContentsOfURL:_outputURL], bundle);
+}
+
+- (void)testApplyDeltaOverBase
+{
+  NSData *bundle = [self writeDeltaWithBaseDigest:nil bundleDigest:nil];
+
+  XCTAssertTrue([RCTJavaScriptLoader applyDeltaAtURL:_deltaURL
+                                       toBundleAtURL:_baseURL
+                                           outputURL:_baseURL
+                                               error:NULL]);
+  XCTAssertEqualObjects([NSData dataWithContentsOfURL:_baseURL], bundle);
+}
+
+- (void)testDeltaForAnotherBundleIsRejected
+{
+  NSData *otherDigest = RCTTestDigest([@"other" dataUsingEncoding:NSUTF8StringEncoding]);
+  [self writeDeltaWithBaseDigest:otherDigest bundleDigest:nil];
+
+  NSError *error;
+  XCTAssertFalse([RCTJavaScriptLoader applyDeltaAtURL:_deltaURL
+                                        toBundleAtURL:_baseURL
+                                            outputURL:_outputURL
+                                                error:&error]);
+  XCTAssertNotNil(error);
+  XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:_outputURL.path]);
+}
+
+- (void)testBundleNotMatchingItsHashIsRejected
+{
+  NSData *otherDigest = RCTTestDigest([@"other" dataUsingEncoding:NSUTF8StringEncoding]);
+  [self writeDeltaWithBaseDigest:nil bundleDigest:otherDigest];
+
+  NSError *error;
+  XCTAssertFalse([RCTJavaScriptLoader applyDeltaAtURL:_deltaURL
+                                        toBundleAtURL:_baseURL
+                                            outputURL:_baseURL
+                                                error:&error]);
+  XCTAssertNotNil(error);
+  XCTAssertEqualObjects([NSData dataWithContentsOfURL:_baseURL], _base);
+}
+
+- (void)testTruncatedDeltaIsRejected
+{
+  [self writeDeltaWithBaseDigest:nil bundleDigest:nil];
+  NSData *delta = [NSData dataWithContentsOfURL:_deltaURL];
+  [[delta subdataWithRange:NSMakeRange(0, delta.length - 2)] writeToURL:_deltaURL atomically:YES];
+
+  XCTAssertFalse([RCTJavaScriptLoader applyDeltaAtURL:_deltaURL
+                                        toBundleAtURL:_baseURL
+                                            outputURL:_outputURL
+                                                error:NULL]);
+}
+
+@end
@@ -0,0 +1,95 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <XCTest/XCTest.h>
+#import <zlib.h>
+
+#import "RCTJavaScriptLoader.h"
+
+@interface RCTJavaScriptLoaderTests : XCTestCase
+
+@end
+
+@implementation RCTJavaScriptLoaderTests
+{
+  NSURL *_scriptURL;
+}
+
+static NSData *RCTTestGzip(NSData *data)
+{
+  z_stream stream = {
+    .next_in = (Bytef *)data.bytes,
+    .avail_in = (uInt)data.length,
+  };
+  deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  NSMutableData *compressed = [NSMutableData dataWithLength:deflateBound(&stream, data.length)];
+  stream.next_out = compressed.mutableBytes;
+  stream.avail_out = (uInt)compressed.length;
+  deflate(&stream, Z_FINISH);
+  compressed.length = stream.total_out;
+  deflateEnd(&stream);
+  return compressed;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  NSString *name = [[NSUUID UUID].UUIDString stringByAppendingString:@".js.gz"];
+  _scriptURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+}
+
+- (void)tearDown
+{
+  [[NSFileManager defaultManager] removeItemAtURL:_scriptURL error:NULL];
+
+  [super tearDown];
+}
+
+- (void)loadScript:(void (^)(NSError *error, NSString *source))check
+{
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Script loaded"];
+  [RCTJavaScriptLoader loadBundleAtURL:_scriptURL onComplete:^(NSError *error, NSString *source) {
+    check(error, source);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (void)testLoadGzippedBundle
+{
+  NSMutableString *script = [NSMutableString new];
+  for (NSUInteger i = 0; i < 10000; i++) {
+    [script appendFormat:@"__d('module%lu',function(){return %lu;});\n", (unsigned long)i, (unsigned long)i];
+  }
+  [RCTTestGzip([script dataUsingEncoding:NSUTF8StringEncoding]) writeToURL:_scriptURL atomically:YES];
+
+  [self loadScript:^(NSError *error, NSString *source) {
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(source, script);
+  }];
+}
+
+- (void)testTruncatedGzippedBundleFails
+{
+  NSData *compressed = RCTTestGzip([@"__d('a',function(){});" dataUsingEncoding:NSUTF8StringEncoding]);
+  [[compressed subdataWithRange:NSMakeRange(0, compressed.length / 2)] writeToURL:_scriptURL atomically:YES];
+
+  [self loadScript:^(NSError *error, NSString *source) {
+    XCTAssertNotNil(error);
+    XCTAssertNil(source);
+  }];
+}
+
+@end
@@ -0,0 +1,151 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTJavaScriptQueue.h"
+
+@interface RCTJavaScriptQueueTests : XCTestCase
+
+@end
+
+@implementation RCTJavaScriptQueueTests
+{
+  NSThread *_thread;
+  RCTJavaScriptQueue *_queue;
+}
+
++ (void)runRunLoop
+{
+  @autoreleasepool {
+    CFRunLoopSourceContext noSpinCtx = {0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    CFRunLoopSourceRef noSpinSource = CFRunLoopSourceCreate(NULL, 0, &noSpinCtx);
+    CFRunLoopAddSource(CFRunLoopGetCurrent(), noSpinSource, kCFRunLoopDefaultMode);
+    CFRelease(noSpinSource);
+    CFRunLoopRun();
+  }
+}
+
++ (void)stopRunLoop
+{
+  CFRunLoopStop(CFRunLoopGetCurrent());
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _thread = [[NSThread alloc] initWithTarget:[self class] selector:@selector(runRunLoop) object:nil];
+  [_thread start];
+  _queue = [[RCTJavaScriptQueue alloc] initWithThread:_thread];
+}
+
+- (void)tearDown
+{
+  [_queue invalidate];
+  [[self class] performSelector:@selector(stopRunLoop)
+                       onThread:_thread
+                     withObject:nil
+                  waitUntilDone:NO];
+  _queue = nil;
+  _thread = nil;
+
+  [super tearDown];
+}
+
+- (void)testBlocksRunInOrderOnTheThread
+{
+  NSMutableArray<NSNumber *> *order = [NSMutableArray new];
+  dispatch_semaphore_t done = dispatch_semaphore_create(0);
+  NSThread *thread = _thread;
+
+  for (NSUInteger i = 0; i < 100; i++) {
+    [_queue addBlock:^{
+      XCTAssertEqual([NSThread currentThread], thread);
+      [order addObject:@(i)];
+      if (i == 99) {
+        dispatch_semaphore_signal(done);
+      }
+    } priority:RCTJavaScriptQueuePriorityDefault];
+  }
+
+  XCTAssertEqual(dispatch_semaphore_wait(done, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+  XCTAssertEqual(order.count, 100u);
+  for (NSUInteger i = 0; i < order.count; i++) {
+    XCTAssertEqualObjects(order[i], @(i));
+  }
+}
+
+- (void)testHigherBandsRunFirst
+{
+  NSMutableArray<NSString *> *order = [NSMutableArray new];
+  dispatch_semaphore_t started = dispatch_semaphore_create(0);
+  dispatch_semaphore_t resume = dispatch_semaphore_create(0);
+  dispatch_semaphore_t done = dispatch_semaphore_create(0);
+
+  // Keeps the thread busy while the other blocks are added
+  [_queue addBlock:^{
+    dispatch_semaphore_signal(started);
+    dispatch_semaphore_wait(resume, DISPATCH_TIME_FOREVER);
+  } priority:RCTJavaScriptQueuePriorityDefault];
+  dispatch_semaphore_wait(started, DISPATCH_TIME_FOREVER);
+
+  [_queue addBlock:^{
+    [order addObject:@"default"];
+    dispatch_semaphore_signal(done);
+  } priority:RCTJavaScriptQueuePriorityDefault];
+  [_queue addBlock:^{
+    [order addObject:@"timer"];
+  } priority:RCTJavaScriptQueuePriorityTimers];
+  [_queue addBlock:^{
+    [order addObject:@"event1"];
+  } priority:RCTJavaScriptQueuePriorityEvents];
+  [_queue addBlock:^{
+    [order addObject:@"event2"];
+  } priority:RCTJavaScriptQueuePriorityEvents];
+  dispatch_semaphore_signal(resume);
+
+  XCTAssertEqual(dispatch_semaphore_wait(done, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+  XCTAssertEqualObjects(order, (@[@"event1", @"event2", @"timer", @"default"]));
+}
+
+- (void)testBlocksAddedAfterInvalidationAreDropped
+{
+  __block BOOL ran = NO;
+  dispatch_semaphore_t done = dispatch_semaphore_create(0);
+
+  [_queue addBlock:^{
+    dispatch_semaphore_signal(done);
+  } priority:RCTJavaScriptQueuePriorityDefault];
+  [_queue invalidate];
+
+  __weak NSObject *weakObject;
+  @autoreleasepool {
+    NSObject *object = [NSObject new];
+    weakObject = object;
+    [_queue addBlock:^{
+      (void)object;
+      ran = YES;
+    } priority:RCTJavaScriptQueuePriorityEvents];
+  }
+  XCTAssertNil(weakObject);
+
+  // The block added before still runs, and the one added after never does
+  XCTAssertEqual(dispatch_semaphore_wait(done, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0);
+  [NSThread sleepForTimeInterval:0.1];
+  XCTAssertFalse(ran);
+}
+
+@end
@@ -0,0 +1,84 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#import <XCTest/XCTest.h>
+
+#import "RCTLog.h"
+
+@interface RCTLogTests : XCTestCase
+
+@end
+
+@implementation RCTLogTests
+{
+  RCTLogLevel _threshold;
+}
+
+- (void)setUp
+{
+  [super setUp];
+  _threshold = RCTGetLogThreshold();
+}
+
+- (void)tearDown
+{
+  RCTSetLogThreshold(_threshold);
+  [super tearDown];
+}
+
+- (void)testLogsBelowThresholdAreNotFormatted
+{
+  __block NSUInteger evaluations = 0;
+  NSString *(^argument)(void) = ^{
+    evaluations++;
+    return @"argument";
+  };
+  __block NSMutableArray *messages = [NSMutableArray new];
+  RCTLogFunction logFunction = ^(__unused RCTLogLevel level, __unused NSString *fileName, __unused NSNumber *lineNumber, NSString *message) {
+    [messages addObject:message];
+  };
+
+  RCTSetLogThreshold(RCTLogLevelWarning);
+  RCTPerformBlockWithLogFunction(^{
+    RCTLogInfo(@"%@", argument());
+    RCTLogWarn(@"%@", argument());
+  }, logFunction);
+
+  XCTAssertEqual(evaluations, 1u);
+  XCTAssertEqualObjects(messages, @[@"argument"]);
+}
+
+- (void)testAsyncLogFunctionKeepsOrder
+{
+  NSMutableArray *messages = [NSMutableArray new];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"logged"];
+  RCTLogFunction logFunction = RCTAsyncLogFunction(^(__unused RCTLogLevel level, __unused NSString *fileName, __unused NSNumber *lineNumber, NSString *message) {
+    XCTAssertFalse([NSThread isMainThread]);
+    [messages addObject:message];
+    if (messages.count == 3) {
+      [expectation fulfill];
+    }
+  });
+
+  for (NSString *message in @[@"a", @"b", @"c"]) {
+    logFunction(RCTLogLevelInfo, nil, nil, message);
+  }
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+  XCTAssertEqualObjects(messages, (@[@"a", @"b", @"c"]));
+}
+
+@end
@@ -0,0 +1,122 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+#import "RCTCache.h"
+#import "RCTMemoryBudget.h"
+
+@interface RCTTestMemoryConsumer : NSObject <RCTMemoryConsumer>
+
+@property (nonatomic, assign) NSUInteger memoryFootprint;
+
+@end
+
+@implementation RCTTestMemoryConsumer
+
+- (void)trimMemoryToFootprint:(NSUInteger)footprint
+{
+  _memoryFootprint = MIN(_memoryFootprint, footprint);
+}
+
+@end
+
+@interface RCTMemoryBudgetTests : XCTestCase
+
+@end
+
+@implementation RCTMemoryBudgetTests
+{
+  RCTMemoryBudget *_budget;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _budget = [RCTMemoryBudget new];
+}
+
+- (RCTTestMemoryConsumer *)consumerWithFootprint:(NSUInteger)footprint priority:(RCTMemoryPriority)priority
+{
+  RCTTestMemoryConsumer *consumer = [RCTTestMemoryConsumer new];
+  consumer.memoryFootprint = footprint;
+  [_budget registerConsumer:consumer priority:priority];
+  return consumer;
+}
+
+- (void)testFootprint
+{
+  RCTTestMemoryConsumer *first = [self consumerWithFootprint:100 priority:RCTMemoryPriorityLow];
+  RCTTestMemoryConsumer *second = [self consumerWithFootprint:50 priority:RCTMemoryPriorityHigh];
+
+  XCTAssertEqual(_budget.footprint, 150u);
+
+  [_budget unregisterConsumer:first];
+  XCTAssertEqual(_budget.footprint, second.memoryFootprint);
+}
+
+- (void)testTrimsLowestPriorityFirst
+{
+  RCTTestMemoryConsumer *high = [self consumerWithFootprint:100 priority:RCTMemoryPriorityHigh];
+  RCTTestMemoryConsumer *low = [self consumerWithFootprint:100 priority:RCTMemoryPriorityLow];
+  RCTTestMemoryConsumer *normal = [self consumerWithFootprint:100 priority:RCTMemoryPriorityDefault];
+
+  [_budget trimToFootprint:150];
+
+  XCTAssertEqual(low.memoryFootprint, 0u);
+  XCTAssertEqual(normal.memoryFootprint, 50u);
+  XCTAssertEqual(high.memoryFootprint, 100u);
+}
+
+- (void)testMemoryWarningTrimsEverything
+{
+  RCTTestMemoryConsumer *high = [self consumerWithFootprint:100 priority:RCTMemoryPriorityHigh];
+  RCTTestMemoryConsumer *low = [self consumerWithFootprint:100 priority:RCTMemoryPriorityLow];
+
+  [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification
+                                                      object:nil];
+
+  XCTAssertEqual(low.memoryFootprint, 0u);
+  XCTAssertEqual(high.memoryFootprint, 0u);
+}
+
+- (void)testDeallocatedConsumersAreDropped
+{
+  @autoreleasepool {
+    [self consumerWithFootprint:100 priority:RCTMemoryPriorityLow];
+  }
+
+  XCTAssertEqual(_budget.footprint, 0u);
+}
+
+- (void)testCacheConsumer
+{
+  RCTCache *cache = [RCTCache new];
+  [cache setObject:@1 forKey:@"foo" cost:100];
+  [cache setObject:@2 forKey:@"bar" cost:100];
+  [_budget registerCache:cache priority:RCTMemoryPriorityDefault];
+
+  XCTAssertEqual(_budget.footprint, 200u);
+
+  [_budget trimToFootprint:150];
+
+  XCTAssertEqual(cache.totalCost, 100u);
+  XCTAssertNil([cache objectForKey:@"foo"]);
+  XCTAssertEqualObjects([cache objectForKey:@"bar"], @2);
+}
+
+@end
@@ -0,0 +1,149 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "RCTMethodCallBatch.h"
+
+@interface RCTMethodCallBatchTests : XCTestCase
+
+@end
+
+@implementation RCTMethodCallBatchTests
+
+- (void)testBinarySingleCall
+{
+  // [[7],[3],[[true, null, -5, "hi", [1], {"a": false}]]]
+  const uint8_t bytes[] = {
+    0x01, 0x01, 0x07, 0x03,
+    0x06, 0x06,
+    0x02,
+    0x00,
+    0x03, 0x09,
+    0x05, 0x02, 'h', 'i',
+    0x06, 0x01, 0x03, 0x02,
+    0x07, 0x01, 0x01, 'a', 0x01,
+  };
+  NSError *error;
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(batch.count, 1);
+  XCTAssertEqual(batch.calls[0].moduleID, 7);
+  XCTAssertEqual(batch.calls[0].methodID, 3);
+  NSArray *params = @[@YES, [NSNull null], @-5, @"hi", @[@1], @{@"a": @NO}];
+  XCTAssertEqualObjects(batch.params, @[params]);
+}
+
+- (void)testBinaryDouble
+{
+  NSMutableData *data = [NSMutableData dataWithBytes:(const uint8_t[]){0x01, 0x01, 0x00, 0x00, 0x06, 0x01, 0x04} length:7];
+  double value = 42.16;
+  [data appendBytes:&value length:sizeof(value)];
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:data.bytes length:data.length error:NULL];
+  XCTAssertEqualObjects(batch.params, @[@[@42.16]]);
+}
+
+- (void)testBinaryPackedArrays
+{
+  NSMutableData *data = [NSMutableData dataWithBytes:(const uint8_t[]){0x01, 0x01, 0x00, 0x00, 0x06, 0x03, 0x08, 0x01} length:8];
+  double number = 0.5;
+  [data appendBytes:&number length:sizeof(number)];
+  [data appendBytes:(const uint8_t[]){0x09, 0x01} length:2];
+  int32_t integer = -70000;
+  [data appendBytes:&integer length:sizeof(integer)];
+  [data appendBytes:(const uint8_t[]){0x0a, 0x02, 0x07, 0xff} length:4];
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:data.bytes length:data.length error:NULL];
+  XCTAssertEqualObjects(batch.params, (@[@[@[@0.5], @[@-70000], @[@7, @255]]]));
+}
+
+- (void)testBinaryTwoCalls
+{
+  const uint8_t bytes[] = {0x01, 0x02, 0x00, 0x01, 0x06, 0x00, 0x04, 0x05, 0x06, 0x00};
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:NULL];
+  XCTAssertEqual(batch.count, 2);
+  XCTAssertEqual(batch.calls[1].moduleID, 4);
+  XCTAssertEqual(batch.calls[1].methodID, 5);
+  XCTAssertEqualObjects(batch.params, (@[@[], @[]]));
+}
+
+- (void)testBinaryStringTable
+{
+  // [[1],[2],[["View", {"a": "View"}, {"a": 1}]]]
+  const uint8_t bytes[] = {
+    0x02, 0x01, 0x01, 0x02,
+    0x06, 0x03,
+    0x0b, 0x04, 'V', 'i', 'e', 'w',
+    0x07, 0x01, 0x02, 'a', 0x0c, 0x00,
+    0x07, 0x01, 0x03, 0x03, 0x02,
+  };
+  NSError *error;
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error];
+  XCTAssertNil(error);
+  NSArray *params = batch.params[0];
+  XCTAssertEqualObjects(params, (@[@"View", @{@"a": @"View"}, @{@"a": @1}]));
+  XCTAssertEqual(params[0], params[1][@"a"]);
+  XCTAssertEqual([params[1] allKeys][0], [params[2] allKeys][0]);
+}
+
+- (void)testBinaryStringRefOutOfRange
+{
+  const uint8_t bytes[] = {0x02, 0x01, 0x00, 0x00, 0x06, 0x01, 0x0c, 0x05};
+  NSError *error;
+  XCTAssertNil([RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testBinaryTruncated
+{
+  const uint8_t bytes[] = {0x01, 0x01, 0x07, 0x03, 0x06, 0x01, 0x05, 0x04, 'a'};
+  NSError *error;
+  XCTAssertNil([RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testBinaryArgumentsMustBeArrays
+{
+  // [[7],[3],[1]]
+  const uint8_t bytes[] = {0x01, 0x01, 0x07, 0x03, 0x03, 0x02};
+  NSError *error;
+  XCTAssertNil([RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testBinaryUnknownTag
+{
+  const uint8_t bytes[] = {0x01, 0x01, 0x07, 0x03, 0x06, 0x01, 0x2a};
+  NSError *error;
+  XCTAssertNil([RCTMethodCallBatch batchWithBinaryData:bytes length:sizeof(bytes) error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testJSONBuffer
+{
+  NSArray *buffer = @[@[@7, @8], @[@3, @4], @[@[@"a"], @[]]];
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithJSONBuffer:buffer error:NULL];
+  XCTAssertEqual(batch.count, 2);
+  XCTAssertEqual(batch.calls[0].moduleID, 7);
+  XCTAssertEqual(batch.calls[1].methodID, 4);
+  XCTAssertEqualObjects(batch.params, buffer[2]);
+}
+
+- (void)testJSONBufferWithMismatchedFields
+{
+  NSError *error;
+  XCTAssertNil([RCTMethodCallBatch batchWithJSONBuffer:@[@[@7], @[], @[@[]]] error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
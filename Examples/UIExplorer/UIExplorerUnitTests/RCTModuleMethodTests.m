@@ -38,6 +38,7 @@ static BOOL RCTLogsError(void (^block)(void))
 @implementation RCTModuleMethodTests
 {
   CGRect _s;
+  NSArray *_values;
 }
 
 + (NSString *)moduleName { return nil; }
@@ -121,4 +122,74 @@ static BOOL RCTLogsError(void (^block)(void))
   XCTAssertTrue(CGRectEqualToRect(r, _s));
 }
 
+- (void)doFooWithInteger:(NSInteger)i intValue:(int)s string:(NSString *)string flag:(BOOL)flag
+{
+  _values = @[@(i), @(s), string ?: [NSNull null], @(flag)];
+}
+
+- (void)doFooWithDouble:(double)a otherDouble:(double)b
+{
+  _values = @[@(a), @(b)];
+}
+
+- (void)doFooWithDouble:(double)d integer:(NSInteger)i
+{
+  _values = @[@(d), @(i)];
+}
+
+- (void)testWordArguments
+{
+  NSString *methodName = @"doFooWithInteger:(NSInteger)i intValue:(int)s string:(NSString *)string flag:(BOOL)flag";
+  RCTModuleMethod *method = [[RCTModuleMethod alloc] initWithObjCMethodName:methodName
+                                                               JSMethodName:nil
+                                                                moduleClass:[self class]];
+
+  [method invokeWithBridge:nil module:self arguments:@[@(-1234567), @(-3), @"foo", @YES]];
+  XCTAssertEqualObjects(_values, (@[@(-1234567), @(-3), @"foo", @YES]));
+
+  [method invokeWithBridge:nil module:self arguments:@[@42, @7, [NSNull null], @NO]];
+  XCTAssertEqualObjects(_values, (@[@42, @7, [NSNull null], @NO]));
+}
+
+- (void)testDoubleArguments
+{
+  NSString *methodName = @"doFooWithDouble:(double)a otherDouble:(double)b";
+  RCTModuleMethod *method = [[RCTModuleMethod alloc] initWithObjCMethodName:methodName
+                                                               JSMethodName:nil
+                                                                moduleClass:[self class]];
+
+  [method invokeWithBridge:nil module:self arguments:@[@1.5, @(-2.25)]];
+  XCTAssertEqualObjects(_values, (@[@1.5, @(-2.25)]));
+}
+
+- (void)testMixedArguments
+{
+  NSString *methodName = @"doFooWithDouble:(double)d integer:(NSInteger)i";
+  RCTModuleMethod *method = [[RCTModuleMethod alloc] initWithObjCMethodName:methodName
+                                                               JSMethodName:nil
+                                                                moduleClass:[self class]];
+
+  [method invokeWithBridge:nil module:self arguments:@[@0.5, @99]];
+  XCTAssertEqualObjects(_values, (@[@0.5, @99]));
+}
+
+- (id)valueForIndex:(NSInteger)index { return @[@"a", @"b"][index]; }
+
+- (void)testSyncMethodReturnsResult
+{
+  NSString *methodName = @"valueForIndex:(NSInteger)index";
+  RCTModuleMethod *method = [[RCTModuleMethod alloc] initWithObjCMethodName:methodName
+                                                               JSMethodName:nil
+                                                                       sync:YES
+                                                                moduleClass:[self class]];
+  XCTAssertEqual(method.functionType, RCTFunctionTypeSync);
+  XCTAssertEqualObjects([method invokeSyncWithBridge:nil module:self arguments:@[@1]], @"b");
+
+  __block id result = @"unset";
+  XCTAssertTrue(RCTLogsError(^{
+    result = [method invokeSyncWithBridge:nil module:self arguments:@[]];
+  }));
+  XCTAssertNil(result);
+}
+
 @end
@@ -15,6 +15,7 @@
 #import <XCTest/XCTest.h>
 
 #import "RCTShadowView.h"
+#import "RCTUtils.h"
 
 @interface RCTShadowViewTests : XCTestCase
 
@@ -42,8 +43,8 @@
 
   RCTShadowView *centerView = [self _shadowViewWithStyle:^(css_style_t *style) {
     style->flex = 2;
-    style->margin[0] = 10;
-    style->margin[2] = 10;
+    css_style_set(style, CSS_STYLE_MARGIN + CSS_LEFT, 10);
+    css_style_set(style, CSS_STYLE_MARGIN + CSS_RIGHT, 10);
   }];
 
   RCTShadowView *rightView = [self _shadowViewWithStyle:^(css_style_t *style) {
@@ -53,8 +54,8 @@
   RCTShadowView *mainView = [self _shadowViewWithStyle:^(css_style_t *style) {
     style->flex_direction = CSS_FLEX_DIRECTION_ROW;
     style->flex = 2;
-    style->margin[1] = 10;
-    style->margin[3] = 10;
+    css_style_set(style, CSS_STYLE_MARGIN + CSS_TOP, 10);
+    css_style_set(style, CSS_STYLE_MARGIN + CSS_BOTTOM, 10);
   }];
 
   [mainView insertReactSubview:leftView atIndex:0];
@@ -71,12 +72,12 @@
 
   RCTShadowView *parentView = [self _shadowViewWithStyle:^(css_style_t *style) {
     style->flex_direction = CSS_FLEX_DIRECTION_COLUMN;
-    style->padding[0] = 10;
-    style->padding[1] = 10;
-    style->padding[2] = 10;
-    style->padding[3] = 10;
-    style->dimensions[0] = 440;
-    style->dimensions[1] = 440;
+    css_style_set(style, CSS_STYLE_PADDING + CSS_LEFT, 10);
+    css_style_set(style, CSS_STYLE_PADDING + CSS_TOP, 10);
+    css_style_set(style, CSS_STYLE_PADDING + CSS_RIGHT, 10);
+    css_style_set(style, CSS_STYLE_PADDING + CSS_BOTTOM, 10);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 440);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 440);
   }];
 
   [parentView insertReactSubview:headerView atIndex:0];
@@ -97,6 +98,88 @@
   XCTAssertTrue(CGRectEqualToRect([rightView measureLayoutRelativeToAncestor:parentView], CGRectMake(330, 120, 100, 200)));
 }
 
+// Three columns of 106.667pt each, which each hold a view filling them. The
+// columns and their subviews should all land on the pixel grid, with each
+// subview exactly as large as its column.
+- (void)testSnappingLayoutToPixelGrid
+{
+  RCTShadowView *parentView = [self _shadowViewWithStyle:^(css_style_t *style) {
+    style->flex_direction = CSS_FLEX_DIRECTION_ROW;
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 320);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 100);
+  }];
+
+  NSMutableArray *columns = [NSMutableArray new];
+  for (NSInteger i = 0; i < 3; i++) {
+    RCTShadowView *column = [self _shadowViewWithStyle:^(css_style_t *style) {
+      style->flex = 1;
+    }];
+    RCTShadowView *content = [self _shadowViewWithStyle:^(css_style_t *style) {
+      style->flex = 1;
+    }];
+    [column insertReactSubview:content atIndex:0];
+    [parentView insertReactSubview:column atIndex:i];
+    [columns addObject:column];
+  }
+
+  [parentView collectRootUpdatedFrames:nil parentConstraint:CGSizeZero];
+
+  CGFloat scale = RCTScreenScale();
+  CGFloat right = 0;
+  for (RCTShadowView *column in columns) {
+    CGRect frame = column.frame;
+    XCTAssertEqualWithAccuracy(CGRectGetMinX(frame), right, 0.001);
+    XCTAssertEqualWithAccuracy(CGRectGetMinX(frame) * scale, round(CGRectGetMinX(frame) * scale), 0.001);
+    XCTAssertEqualWithAccuracy(CGRectGetWidth(frame) * scale, round(CGRectGetWidth(frame) * scale), 0.001);
+
+    CGRect contentFrame = [column.reactSubviews[0] frame];
+    XCTAssertTrue(CGPointEqualToPoint(contentFrame.origin, CGPointZero));
+    XCTAssertEqualWithAccuracy(CGRectGetWidth(contentFrame), CGRectGetWidth(frame), 0.001);
+    right = CGRectGetMaxX(frame);
+  }
+  XCTAssertEqualWithAccuracy(right, 320, 0.001);
+}
+
+// A box whose own layout doesn't change but which moves by a fraction of a
+// point. Its subview has to be snapped again against the box's new absolute
+// position even though css-layout didn't lay the box out again.
+- (void)testSnappingSubviewsOfMovedViewWithUnchangedLayout
+{
+  RCTShadowView *spacer = [self _shadowViewWithStyle:^(css_style_t *style) {
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 10);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 10);
+  }];
+
+  RCTShadowView *content = [self _shadowViewWithStyle:^(css_style_t *style) {
+    css_style_set(style, CSS_STYLE_MARGIN + CSS_LEFT, 0.3);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 20);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 20);
+  }];
+
+  RCTShadowView *box = [self _shadowViewWithStyle:^(css_style_t *style) {
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 50);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 50);
+  }];
+  [box insertReactSubview:content atIndex:0];
+
+  RCTShadowView *parentView = [self _shadowViewWithStyle:^(css_style_t *style) {
+    style->flex_direction = CSS_FLEX_DIRECTION_ROW;
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, 320);
+    css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, 100);
+  }];
+  [parentView insertReactSubview:spacer atIndex:0];
+  [parentView insertReactSubview:box atIndex:1];
+
+  [parentView collectRootUpdatedFrames:nil parentConstraint:CGSizeZero];
+
+  spacer.width = 10.25;
+  [parentView collectRootUpdatedFrames:nil parentConstraint:CGSizeZero];
+
+  XCTAssertEqualWithAccuracy(CGRectGetMinX(box.frame), RCTRoundPixelValue(10.25), 0.001);
+  XCTAssertEqualWithAccuracy(CGRectGetMinX(content.frame),
+                             RCTRoundPixelValue(10.55) - RCTRoundPixelValue(10.25), 0.001);
+}
+
 - (RCTShadowView *)_shadowViewWithStyle:(void(^)(css_style_t *style))styleBlock
 {
   RCTShadowView *shadowView = [RCTShadowView new];
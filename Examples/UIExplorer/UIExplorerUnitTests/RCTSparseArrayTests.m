@@ -52,4 +52,56 @@
   XCTAssertNil(registry[@5], @"how did you have a view when none are registered?");
 }
 
+- (void)testIndexesAcrossPages
+{
+  RCTSparseArray *registry = [RCTSparseArray new];
+  NSArray *indexes = @[@1, @255, @256, @1001, @(RCTSparseArrayMaxDirectIndex + 7)];
+  for (NSNumber *index in indexes) {
+    registry[index] = index.description;
+  }
+
+  XCTAssertEqual(registry.count, indexes.count);
+  XCTAssertEqualObjects(registry.allIndexes, indexes);
+  for (NSNumber *index in indexes) {
+    XCTAssertEqualObjects(registry[index], index.description);
+    XCTAssertEqualObjects(RCTSparseArrayGet(registry, index.unsignedIntegerValue), index.description);
+  }
+  XCTAssertNil(registry[@2]);
+  XCTAssertNil(RCTSparseArrayGet(registry, 100000));
+
+  registry[@256] = nil;
+  XCTAssertNil(registry[@256]);
+  XCTAssertEqual(registry.count, indexes.count - 1);
+
+  RCTSparseArray *copy = [registry copy];
+  [registry removeAllObjects];
+  XCTAssertEqual(registry.count, 0);
+  XCTAssertEqualObjects(copy[@1001], @"1001");
+  XCTAssertEqual(copy.count, indexes.count - 1);
+}
+
+- (void)testRemovingWhileEnumerating
+{
+  RCTSparseArray *registry = [RCTSparseArray new];
+  for (NSUInteger i = 0; i < 600; i++) {
+    registry[i] = @(i);
+  }
+
+  __block NSUInteger visited = 0;
+  [registry enumerateObjectsUsingBlock:^(NSNumber *obj, NSNumber *idx, __unused BOOL *stop) {
+    XCTAssertEqualObjects(obj, idx);
+    registry[idx.unsignedIntegerValue + 1] = nil;
+    visited++;
+  }];
+  XCTAssertEqual(visited, 300);
+  XCTAssertEqual(registry.count, 300);
+
+  NSMutableArray *reversed = [NSMutableArray new];
+  [registry enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(NSNumber *obj, __unused NSNumber *idx, __unused BOOL *stop) {
+    [reversed addObject:obj];
+  }];
+  XCTAssertEqualObjects(reversed.firstObject, @598);
+  XCTAssertEqualObjects(reversed.lastObject, @0);
+}
+
 @end
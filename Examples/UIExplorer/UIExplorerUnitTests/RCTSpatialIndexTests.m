@@ -0,0 +1,82 @@
+/**
+ * The examples provided by Facebook are for non-commercial testing and
+ * evaluation purposes only.
+ *
+ * Facebook reserves all rights not expressly granted.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL
+ * FACEBOOK BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+ * AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "RCTSpatialIndex.h"
+
+@interface RCTSpatialIndexTests : XCTestCase
+
+@end
+
+@implementation RCTSpatialIndexTests
+{
+  RCTSpatialIndex *_index;
+}
+
+- (void)setUp
+{
+  [super setUp];
+
+  _index = [[RCTSpatialIndex alloc] initWithCellSize:10];
+}
+
+- (void)testObjectsAtPointAreTopmostFirst
+{
+  id bottom = [NSObject new];
+  id top = [NSObject new];
+  id elsewhere = [NSObject new];
+  [_index addObject:bottom rect:CGRectMake(0, 0, 50, 50) order:0];
+  [_index addObject:top rect:CGRectMake(20, 20, 50, 50) order:1];
+  [_index addObject:elsewhere rect:CGRectMake(100, 100, 5, 5) order:2];
+
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(30, 30)], (@[top, bottom]));
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(5, 5)], @[bottom]);
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(80, 80)], @[]);
+  XCTAssertEqual(_index.count, 3u);
+}
+
+- (void)testUnboundedObjectsAreReturnedForEveryPoint
+{
+  id overflowing = [NSObject new];
+  id large = [NSObject new];
+  [_index addObject:overflowing rect:CGRectInfinite order:0];
+  [_index addObject:large rect:CGRectMake(-1000, -1000, 5000, 5000) order:1];
+
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(-500, 2000)], (@[large, overflowing]));
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(1e6, 1e6)], @[overflowing]);
+}
+
+- (void)testUpdatingAndRemovingObjects
+{
+  id object = [NSObject new];
+  [_index addObject:object rect:CGRectMake(0, 0, 10, 10) order:0];
+  [_index updateRect:CGRectMake(200, 200, 10, 10) forObject:object];
+
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(5, 5)], @[]);
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(205, 205)], @[object]);
+
+  [_index updateRect:CGRectInfinite forObject:object];
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(5, 5)], @[object]);
+
+  [_index removeObject:object];
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(5, 5)], @[]);
+  XCTAssertEqual(_index.count, 0u);
+
+  // Objects that weren't added aren't updated into the index
+  [_index updateRect:CGRectMake(0, 0, 10, 10) forObject:object];
+  XCTAssertEqualObjects([_index objectsAtPoint:CGPointMake(5, 5)], @[]);
+}
+
+@end
@@ -14,6 +14,7 @@
 
 #import <XCTest/XCTest.h>
 
+#import "RCTShadowView.h"
 #import "RCTSparseArray.h"
 #import "RCTUIManager.h"
 #import "UIView+React.h"
@@ -29,6 +30,7 @@
                registry:(RCTSparseArray *)registry;
 
 @property (nonatomic, readonly) RCTSparseArray *viewRegistry;
+@property (nonatomic, readonly) RCTSparseArray *shadowViewRegistry;
 
 @end
 
@@ -188,4 +190,38 @@
   }
 }
 
+// Same as above, but for shadow views, which get all their children at once
+- (void)testManagingShadowChildrenToAddRemoveAndMove
+{
+  for (NSInteger i = 1; i <= 20; i++) {
+    RCTShadowView *shadowView = [RCTShadowView new];
+    shadowView.reactTag = @(i);
+    _uiManager.shadowViewRegistry[i] = shadowView;
+  }
+  RCTShadowView *containerView = _uiManager.shadowViewRegistry[20];
+  for (NSInteger i = 1; i < 11; i++) {
+    [containerView insertReactSubview:_uiManager.shadowViewRegistry[i] atIndex:i - 1];
+  }
+  RCTShadowView *removedView = _uiManager.shadowViewRegistry[3];
+
+  [_uiManager _manageChildren:@20
+              moveFromIndices:@[@4, @9]
+                moveToIndices:@[@1, @7]
+            addChildReactTags:@[@11, @12]
+                 addAtIndices:@[@0, @6]
+              removeAtIndices:@[@2, @3, @5, @8]
+                     registry:_uiManager.shadowViewRegistry];
+
+  NSArray *expectedReactTags = @[@11, @5, @1, @2, @7, @8, @12, @10];
+  XCTAssertEqualObjects([containerView.reactSubviews valueForKey:@"reactTag"], expectedReactTags);
+  XCTAssertEqual(containerView.cssNode->children_count, 8);
+  for (NSUInteger i = 0; i < expectedReactTags.count; i++) {
+    RCTShadowView *child = containerView.reactSubviews[i];
+    XCTAssertEqual(containerView.cssNode->children[i], child.cssNode);
+    XCTAssertEqual(child.superview, containerView);
+  }
+  XCTAssertNil(removedView.superview);
+  XCTAssertNil(_uiManager.shadowViewRegistry[3]);
+}
+
 @end
@@ -326,18 +326,20 @@ def _parse_smap(file):
 
       yield SmapState(dst_line, dst_col, src, src_line, src_col, name)
 
+class lookup(object):
+  """Entries sorted by generated position, with their positions as tuples so
+  that searching doesn't go through entry.__cmp__."""
+  def __init__(self, entries):
+    self.entries = sorted(entries, key=lambda e: (e.dst_line, e.dst_col))
+    self.keys = [(e.dst_line, e.dst_col) for e in self.entries]
+
 def find(entries, line, col):
-  test = entry(line, col, '', 0, 0)
-  index = bisect.bisect_right(entries, test)
+  """Lines and columns are zero-based, as in the source map itself."""
+  index = bisect.bisect_right(entries.keys, (line, col))
   if index == 0:
     return None
-  return entries[index - 1]
+  return entries.entries[index - 1]
 
 def parse(file):
-  # Simple demo that shows files that most contribute to total size.
-  lookup = []
-  for state in _parse_smap(file):
-    lookup.append(entry(state.dst_line, state.dst_col, state.src, state.src_line, state.src_col))
-
-  sorted_lookup = list(sorted(lookup))
-  return sorted_lookup
+  return lookup(entry(state.dst_line, state.dst_col, state.src, state.src_line, state.src_col)
+                for state in _parse_smap(file))
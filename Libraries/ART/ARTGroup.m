@@ -20,4 +20,53 @@
   }
 }
 
+- (ARTRenderBlock)layerSnapshot
+{
+  NSMutableArray *snapshots = [NSMutableArray arrayWithCapacity:self.subviews.count];
+  for (ARTNode *node in self.subviews) {
+    ARTRenderBlock snapshot = [node renderSnapshot];
+    if (snapshot) {
+      [snapshots addObject:snapshot];
+    }
+  }
+  if (!snapshots.count) {
+    return nil;
+  }
+  return ^(CGContextRef context) {
+    for (ARTRenderBlock snapshot in snapshots) {
+      snapshot(context);
+    }
+  };
+}
+
+- (void)updateLayerContents
+{
+  // Layer-backed children are sublayers, so there is nothing for the group itself to display
+}
+
+- (BOOL)shouldCacheRenderedContent
+{
+  return YES;
+}
+
+- (CGRect)contentBounds
+{
+  CGRect bounds = CGRectNull;
+  for (ARTNode *node in self.subviews) {
+    if (node.opacity <= 0) {
+      continue;
+    }
+    CGRect nodeBounds = [node contentBounds];
+    if (CGRectIsNull(nodeBounds)) {
+      // One child of unknown size makes the whole group unknown
+      return CGRectNull;
+    }
+    if (CGRectIsEmpty(nodeBounds)) {
+      continue;
+    }
+    bounds = CGRectUnion(bounds, CGRectApplyAffineTransform(nodeBounds, node.transform));
+  }
+  return bounds;
+}
+
 @end
@@ -10,6 +10,8 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+typedef void (^ARTRenderBlock)(CGContextRef context);
+
 /**
  * ART nodes are implemented as empty UIViews but this is just an implementation detail to fit
  * into the existing view management. They should also be shadow views and painted on a background
@@ -20,9 +22,44 @@
 
 @property (nonatomic, assign) CGFloat opacity;
 
+/**
+ * When set, the node is displayed through its own CALayer instead of being painted by the
+ * surface's drawRect. This is inherited from the surface and by inserted subviews.
+ */
+@property (nonatomic, assign) BOOL layerBacked;
+
+/**
+ * Marks the content of this node as changed. This discards any cached rendering of this node and
+ * invalidates its container. Changes to opacity and transform only invalidate the container since
+ * they don't affect what the node itself paints.
+ */
 - (void)invalidate;
 - (void)renderTo:(CGContextRef)context;
 
+/**
+ * Nodes that return YES are rendered into a device-resolution bitmap once their content has stayed
+ * unchanged for a frame, and that bitmap is composited on subsequent renders until the node is
+ * invalidated. Defaults to NO.
+ */
+- (BOOL)shouldCacheRenderedContent;
+
+/**
+ * The area painted by renderLayerTo, in the node's own coordinate space. Returns CGRectNull if
+ * the area is unknown, in which case the node and its ancestors are never cached.
+ */
+- (CGRect)contentBounds;
+
+/**
+ * Called during layout for layer-backed nodes after they've been invalidated. The default
+ * implementation rasterizes renderLayerTo into a sublayer covering contentBounds.
+ */
+- (void)updateLayerContents;
+
+/**
+ * Removes anything updateLayerContents added to the layer, once the node is no longer layer-backed.
+ */
+- (void)clearLayerContents;
+
 /**
  * renderTo will take opacity into account and draw renderLayerTo off-screen if there is opacity
  * specified, then composite that onto the context. renderLayerTo always draws at opacity=1.
@@ -30,4 +67,23 @@
  */
 - (void)renderLayerTo:(CGContextRef)context;
 
+/**
+ * Captures what renderTo would paint in a block that holds on to immutable copies of the node's
+ * state, so it can be run off the main thread while the node keeps changing. Returns nil when
+ * there is nothing to paint.
+ */
+- (ARTRenderBlock)renderSnapshot;
+
+/**
+ * The snapshot equivalent of renderLayerTo. Returns nil by default.
+ * @abstract
+ */
+- (ARTRenderBlock)layerSnapshot;
+
+/**
+ * Whether painting at partial opacity needs an off-screen transparency layer. Nodes that only
+ * paint once can be composited directly. Defaults to YES.
+ */
+- (BOOL)needsTransparencyLayer;
+
 @end
@@ -11,33 +11,91 @@
 
 #import "ARTContainer.h"
 
+// Caches above this many device pixels are not worth the memory they take up
+static const CGFloat ARTMaxCachedPixelCount = 2048 * 2048;
+
 @implementation ARTNode
+{
+  CGImageRef _cachedImage;
+  CGRect _cachedDeviceRect;
+  CGAffineTransform _cachedCTM;
+  BOOL _contentChanged;
+  CALayer *_contentLayer;
+}
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+  if ((self = [super initWithFrame:frame])) {
+    _contentChanged = YES;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  CGImageRelease(_cachedImage);
+}
 
 - (void)insertSubview:(UIView *)subview atIndex:(NSInteger)index
 {
   [self invalidate];
+  ((ARTNode *)subview).layerBacked = _layerBacked;
   [super insertSubview:subview atIndex:index];
 }
 
 - (void)removeFromSuperview
 {
-  [self invalidate];
+  [self invalidateContainer];
   [super removeFromSuperview];
 }
 
 - (void)setOpacity:(CGFloat)opacity
 {
-  [self invalidate];
+  [self invalidateContainer];
   _opacity = opacity;
+  if (_layerBacked) {
+    self.layer.opacity = opacity;
+  }
+}
+
+- (void)setLayerBacked:(BOOL)layerBacked
+{
+  if (_layerBacked == layerBacked) {
+    return;
+  }
+  _layerBacked = layerBacked;
+  for (ARTNode *node in self.subviews) {
+    node.layerBacked = layerBacked;
+  }
+
+  // The transform is always applied to the layer through UIView, so only opacity needs syncing
+  self.layer.opacity = layerBacked ? _opacity : 1;
+  if (layerBacked) {
+    [self setNeedsLayout];
+  } else {
+    [self clearLayerContents];
+  }
 }
 
 - (void)setTransform:(CGAffineTransform)transform
 {
-  [self invalidate];
+  [self invalidateContainer];
   super.transform = transform;
 }
 
 - (void)invalidate
+{
+  _contentChanged = YES;
+  CGImageRelease(_cachedImage);
+  _cachedImage = NULL;
+  if (_layerBacked) {
+    // Setters invalidate before storing the new value, so defer the update until layout
+    [self setNeedsLayout];
+  }
+  [self invalidateContainer];
+}
+
+- (void)invalidateContainer
 {
   id<ARTContainer> container = (id<ARTContainer>)self.superview;
   [container invalidate];
@@ -49,6 +107,15 @@
     // Nothing to paint
     return;
   }
+  if ([self shouldCacheRenderedContent]) {
+    CGContextSaveGState(context);
+    CGContextConcatCTM(context, self.transform);
+    BOOL drewCache = [self renderCachedContentTo:context];
+    CGContextRestoreGState(context);
+    if (drewCache) {
+      return;
+    }
+  }
   if (self.opacity >= 1) {
     // Just paint at full opacity
     CGContextSaveGState(context);
@@ -73,4 +140,165 @@
   // abstract
 }
 
+- (void)layoutSubviews
+{
+  [super layoutSubviews];
+  if (_layerBacked) {
+    [self updateLayerContents];
+  }
+}
+
+- (void)updateLayerContents
+{
+  CGRect bounds = [self contentBounds];
+  if (CGRectIsNull(bounds) || CGRectIsEmpty(bounds)) {
+    [self clearLayerContents];
+    return;
+  }
+
+  CGFloat scale = self.window.screen.scale ?: [UIScreen mainScreen].scale;
+  UIGraphicsBeginImageContextWithOptions(bounds.size, NO, scale);
+  CGContextRef context = UIGraphicsGetCurrentContext();
+  CGContextTranslateCTM(context, -bounds.origin.x, -bounds.origin.y);
+  [self renderLayerTo:context];
+  UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+  UIGraphicsEndImageContext();
+
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  if (!_contentLayer) {
+    _contentLayer = [CALayer layer];
+    [self.layer insertSublayer:_contentLayer atIndex:0];
+  }
+  _contentLayer.frame = bounds;
+  _contentLayer.contentsScale = scale;
+  _contentLayer.contents = (__bridge id)image.CGImage;
+  [CATransaction commit];
+}
+
+- (void)clearLayerContents
+{
+  [_contentLayer removeFromSuperlayer];
+  _contentLayer = nil;
+}
+
+- (ARTRenderBlock)renderSnapshot
+{
+  CGFloat opacity = self.opacity;
+  if (opacity <= 0) {
+    return nil;
+  }
+  ARTRenderBlock layerSnapshot = [self layerSnapshot];
+  if (!layerSnapshot) {
+    return nil;
+  }
+  CGAffineTransform transform = self.transform;
+  BOOL transparencyLayer = opacity < 1 && [self needsTransparencyLayer];
+  return ^(CGContextRef context) {
+    CGContextSaveGState(context);
+    CGContextConcatCTM(context, transform);
+    CGContextSetAlpha(context, MIN(opacity, 1));
+    if (transparencyLayer) {
+      CGContextBeginTransparencyLayer(context, NULL);
+      layerSnapshot(context);
+      CGContextEndTransparencyLayer(context);
+    } else {
+      layerSnapshot(context);
+    }
+    CGContextRestoreGState(context);
+  };
+}
+
+- (ARTRenderBlock)layerSnapshot
+{
+  return nil;
+}
+
+- (BOOL)needsTransparencyLayer
+{
+  return YES;
+}
+
+- (BOOL)shouldCacheRenderedContent
+{
+  return NO;
+}
+
+- (CGRect)contentBounds
+{
+  return CGRectNull;
+}
+
+static BOOL ARTIsFractionEqual(CGFloat a, CGFloat b)
+{
+  return fabs((a - floor(a)) - (b - floor(b))) < 0.001;
+}
+
+/**
+ * Composites the cached bitmap of this node, building it first if necessary. The cache can be
+ * reused whenever the scale and rotation of the CTM match and the translation only differs by
+ * whole device pixels, so moving a static group around doesn't re-render it. Returns NO if the
+ * node has to be painted directly instead.
+ */
+- (BOOL)renderCachedContentTo:(CGContextRef)context
+{
+  if (_contentChanged) {
+    // Content that changed since the last render is likely to be animating, so wait for a frame
+    // where it stays the same before spending time on a cache.
+    _contentChanged = NO;
+    return NO;
+  }
+
+  CGAffineTransform ctm = CGContextGetCTM(context);
+  if (_cachedImage && !(ctm.a == _cachedCTM.a && ctm.b == _cachedCTM.b &&
+                        ctm.c == _cachedCTM.c && ctm.d == _cachedCTM.d &&
+                        ARTIsFractionEqual(ctm.tx, _cachedCTM.tx) &&
+                        ARTIsFractionEqual(ctm.ty, _cachedCTM.ty))) {
+    CGImageRelease(_cachedImage);
+    _cachedImage = NULL;
+  }
+
+  if (!_cachedImage) {
+    CGRect bounds = [self contentBounds];
+    if (CGRectIsNull(bounds) || CGRectIsEmpty(bounds)) {
+      return NO;
+    }
+    CGRect deviceRect = CGRectIntegral(CGRectApplyAffineTransform(bounds, ctm));
+    if (CGRectGetWidth(deviceRect) * CGRectGetHeight(deviceRect) > ARTMaxCachedPixelCount) {
+      return NO;
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef bitmap = CGBitmapContextCreate(NULL,
+                                                CGRectGetWidth(deviceRect),
+                                                CGRectGetHeight(deviceRect),
+                                                8, 0, colorSpace,
+                                                kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+    CGColorSpaceRelease(colorSpace);
+    if (!bitmap) {
+      return NO;
+    }
+    CGContextTranslateCTM(bitmap, -deviceRect.origin.x, -deviceRect.origin.y);
+    CGContextConcatCTM(bitmap, ctm);
+    [self renderLayerTo:bitmap];
+    _cachedImage = CGBitmapContextCreateImage(bitmap);
+    CGContextRelease(bitmap);
+    if (!_cachedImage) {
+      return NO;
+    }
+    _cachedDeviceRect = deviceRect;
+    _cachedCTM = ctm;
+  }
+
+  // Draw the bitmap in device space, shifted by however many pixels the node has moved since the
+  // cache was built.
+  CGRect deviceRect = CGRectOffset(_cachedDeviceRect,
+                                   floor(ctm.tx) - floor(_cachedCTM.tx),
+                                   floor(ctm.ty) - floor(_cachedCTM.ty));
+  CGContextConcatCTM(context, CGAffineTransformInvert(ctm));
+  CGContextSetAlpha(context, self.opacity);
+  CGContextDrawImage(context, deviceRect, _cachedImage);
+  return YES;
+}
+
 @end
@@ -22,4 +22,10 @@
 @property (nonatomic, assign) CGLineJoin strokeJoin;
 @property (nonatomic, assign) ARTCGFloatArray strokeDash;
 
+/**
+ * A block that applies the current stroke color, width, cap, join and dash to a context, or nil
+ * if there is no stroke. The block doesn't depend on the renderable's later state.
+ */
+- (ARTRenderBlock)strokeSnapshot;
+
 @end
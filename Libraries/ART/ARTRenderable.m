@@ -81,6 +81,34 @@
   CGContextRestoreGState(context);
 }
 
+- (BOOL)needsTransparencyLayer
+{
+  // Only a combined fill and stroke needs to be composited off-screen
+  return self.fill && self.stroke;
+}
+
+- (ARTRenderBlock)strokeSnapshot
+{
+  if (!self.stroke) {
+    return nil;
+  }
+  id stroke = (__bridge id)self.stroke;
+  CGFloat strokeWidth = self.strokeWidth;
+  CGLineCap strokeCap = self.strokeCap;
+  CGLineJoin strokeJoin = self.strokeJoin;
+  NSData *dash = self.strokeDash.count ?
+    [NSData dataWithBytes:self.strokeDash.array length:self.strokeDash.count * sizeof(CGFloat)] : nil;
+  return ^(CGContextRef context) {
+    CGContextSetStrokeColorWithColor(context, (__bridge CGColorRef)stroke);
+    CGContextSetLineWidth(context, strokeWidth);
+    CGContextSetLineCap(context, strokeCap);
+    CGContextSetLineJoin(context, strokeJoin);
+    if (dash) {
+      CGContextSetLineDash(context, 0, dash.bytes, dash.length / sizeof(CGFloat));
+    }
+  };
+}
+
 - (void)renderLayerTo:(CGContextRef)context
 {
   // abstract
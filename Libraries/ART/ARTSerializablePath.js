@@ -68,7 +68,9 @@ var SerializablePath = Class(Path, {
   },
 
   toJSON: function() {
-    return this.path;
+    // A single string crosses the bridge much more cheaply than an array of
+    // numbers, which native would otherwise have to unbox one by one.
+    return this.path.join(' ');
   }
 
 });
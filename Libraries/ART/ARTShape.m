@@ -9,8 +9,15 @@
 
 #import "ARTShape.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 @implementation ARTShape
 
++ (Class)layerClass
+{
+  return [CAShapeLayer class];
+}
+
 - (void)setD:(CGPathRef)d
 {
   if (d == _d) {
@@ -27,42 +34,125 @@
 }
 
 - (void)renderLayerTo:(CGContextRef)context
+{
+  ARTRenderBlock snapshot = [self layerSnapshot];
+  if (snapshot) {
+    snapshot(context);
+  }
+}
+
+- (ARTRenderBlock)layerSnapshot
 {
   if ((!self.fill && !self.stroke) || !self.d) {
-    return;
+    return nil;
   }
 
-  CGPathDrawingMode mode = kCGPathStroke;
-  if (self.fill) {
-    if ([self.fill applyFillColor:context]) {
-      mode = kCGPathFill;
-    } else {
-      CGContextSaveGState(context);
-      CGContextAddPath(context, self.d);
-      CGContextClip(context);
-      [self.fill paint:context];
-      CGContextRestoreGState(context);
-      if (!self.stroke) {
-        return;
+  id d = (__bridge id)self.d;
+  ARTBrush *fill = self.fill;
+  ARTRenderBlock applyStroke = [self strokeSnapshot];
+  return ^(CGContextRef context) {
+    CGPathRef path = (__bridge CGPathRef)d;
+    CGPathDrawingMode mode = kCGPathStroke;
+    if (fill) {
+      if ([fill applyFillColor:context]) {
+        mode = kCGPathFill;
+      } else {
+        CGContextSaveGState(context);
+        CGContextAddPath(context, path);
+        CGContextClip(context);
+        [fill paint:context];
+        CGContextRestoreGState(context);
+        if (!applyStroke) {
+          return;
+        }
       }
     }
-  }
-  if (self.stroke) {
-    CGContextSetStrokeColorWithColor(context, self.stroke);
-    CGContextSetLineWidth(context, self.strokeWidth);
-    CGContextSetLineCap(context, self.strokeCap);
-    CGContextSetLineJoin(context, self.strokeJoin);
-    ARTCGFloatArray dash = self.strokeDash;
-    if (dash.count) {
-      CGContextSetLineDash(context, 0, dash.array, dash.count);
+    if (applyStroke) {
+      applyStroke(context);
+      if (mode == kCGPathFill) {
+        mode = kCGPathFillStroke;
+      }
     }
-    if (mode == kCGPathFill) {
-      mode = kCGPathFillStroke;
+
+    CGContextAddPath(context, path);
+    CGContextDrawPath(context, mode);
+  };
+}
+
+- (void)updateLayerContents
+{
+  CAShapeLayer *layer = (CAShapeLayer *)self.layer;
+  CGColorRef fillColor = [self.fill solidColor];
+  if (self.fill && !fillColor) {
+    // Gradients and patterns can't be filled by Core Animation, so rasterize the shape instead
+    layer.path = NULL;
+    [super updateLayerContents];
+    return;
+  }
+  [super clearLayerContents];
+
+  layer.path = self.d;
+  layer.fillColor = fillColor;
+  layer.strokeColor = self.stroke;
+  layer.lineWidth = self.strokeWidth;
+  switch (self.strokeCap) {
+    case kCGLineCapRound:
+      layer.lineCap = kCALineCapRound;
+      break;
+    case kCGLineCapSquare:
+      layer.lineCap = kCALineCapSquare;
+      break;
+    default:
+      layer.lineCap = kCALineCapButt;
+      break;
+  }
+  switch (self.strokeJoin) {
+    case kCGLineJoinRound:
+      layer.lineJoin = kCALineJoinRound;
+      break;
+    case kCGLineJoinBevel:
+      layer.lineJoin = kCALineJoinBevel;
+      break;
+    default:
+      layer.lineJoin = kCALineJoinMiter;
+      break;
+  }
+  ARTCGFloatArray dash = self.strokeDash;
+  if (dash.count) {
+    NSMutableArray *pattern = [NSMutableArray arrayWithCapacity:dash.count];
+    for (NSUInteger i = 0; i < dash.count; i++) {
+      [pattern addObject:@(dash.array[i])];
     }
+    layer.lineDashPattern = pattern;
+  } else {
+    layer.lineDashPattern = nil;
   }
+}
 
-  CGContextAddPath(context, self.d);
-  CGContextDrawPath(context, mode);
+- (void)clearLayerContents
+{
+  CAShapeLayer *layer = (CAShapeLayer *)self.layer;
+  layer.path = NULL;
+  layer.fillColor = NULL;
+  layer.strokeColor = NULL;
+  [super clearLayerContents];
+}
+
+- (CGRect)contentBounds
+{
+  if ((!self.fill && !self.stroke) || !self.d) {
+    return CGRectZero;
+  }
+  CGRect bounds = CGPathGetPathBoundingBox(self.d);
+  if (self.stroke) {
+    // Stroke the path to account for caps and miter joins extending past the outline
+    CGPathRef strokedPath = CGPathCreateCopyByStrokingPath(self.d, NULL, self.strokeWidth,
+                                                           self.strokeCap, self.strokeJoin, 10);
+    bounds = CGRectUnion(bounds, CGPathGetPathBoundingBox(strokedPath));
+    CGPathRelease(strokedPath);
+  }
+  // Leave room for antialiasing at the edges
+  return CGRectInset(bounds, -1, -1);
 }
 
 @end
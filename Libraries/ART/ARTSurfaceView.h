@@ -13,4 +13,18 @@
 
 @interface ARTSurfaceView : UIView <ARTContainer>
 
+/**
+ * Displays each node through its own layer, mapping shapes to CAShapeLayers and groups to
+ * plain layers, so transform and opacity changes are composited by Core Animation instead of
+ * repainting the surface on the main thread.
+ */
+@property (nonatomic, assign) BOOL layerBacked;
+
+/**
+ * Renders a snapshot of the node tree into a bitmap on a background queue instead of drawing on
+ * the main thread. At most one render is in flight per surface; changes made while it runs are
+ * picked up by the next one, and the previous bitmap stays on screen until then.
+ */
+@property (nonatomic, assign) BOOL asyncRendering;
+
 @end
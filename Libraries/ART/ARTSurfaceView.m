@@ -12,15 +12,141 @@
 #import "ARTNode.h"
 #import "RCTLog.h"
 
+static dispatch_queue_t ARTRenderQueue(void)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.ARTRenderQueue", DISPATCH_QUEUE_SERIAL);
+  });
+  return queue;
+}
+
 @implementation ARTSurfaceView
+{
+  CALayer *_asyncLayer;
+  BOOL _needsAsyncRender;
+  BOOL _asyncRenderInFlight;
+}
 
-- (void)invalidate
+- (void)insertSubview:(UIView *)subview atIndex:(NSInteger)index
 {
+  ((ARTNode *)subview).layerBacked = _layerBacked;
+  [super insertSubview:subview atIndex:index];
+  [self invalidate];
+}
+
+- (void)setLayerBacked:(BOOL)layerBacked
+{
+  _layerBacked = layerBacked;
+  for (ARTNode *node in self.subviews) {
+    node.layerBacked = layerBacked;
+  }
   [self setNeedsDisplay];
 }
 
+- (void)setAsyncRendering:(BOOL)asyncRendering
+{
+  if (_asyncRendering == asyncRendering) {
+    return;
+  }
+  _asyncRendering = asyncRendering;
+  if (asyncRendering) {
+    _asyncLayer = [CALayer layer];
+    [self.layer insertSublayer:_asyncLayer atIndex:0];
+    _needsAsyncRender = YES;
+    [self setNeedsLayout];
+  } else {
+    [_asyncLayer removeFromSuperlayer];
+    _asyncLayer = nil;
+  }
+  [self setNeedsDisplay];
+}
+
+- (void)invalidate
+{
+  if (_asyncRendering) {
+    // Coalesce changes until the next layout pass
+    _needsAsyncRender = YES;
+    [self setNeedsLayout];
+  } else if (!_layerBacked) {
+    [self setNeedsDisplay];
+  }
+}
+
+- (void)layoutSubviews
+{
+  [super layoutSubviews];
+  if (!_asyncRendering) {
+    return;
+  }
+  if (!CGSizeEqualToSize(_asyncLayer.bounds.size, self.bounds.size)) {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _asyncLayer.frame = self.bounds;
+    [CATransaction commit];
+    _needsAsyncRender = YES;
+  }
+  if (_needsAsyncRender && !_asyncRenderInFlight) {
+    [self renderAsync];
+  }
+}
+
+- (void)renderAsync
+{
+  CGSize size = self.bounds.size;
+  if (size.width <= 0 || size.height <= 0) {
+    return;
+  }
+
+  NSMutableArray *snapshots = [NSMutableArray arrayWithCapacity:self.subviews.count];
+  for (ARTNode *node in self.subviews) {
+    ARTRenderBlock snapshot = [node renderSnapshot];
+    if (snapshot) {
+      [snapshots addObject:snapshot];
+    }
+  }
+  CGFloat scale = self.window.screen.scale ?: [UIScreen mainScreen].scale;
+
+  _needsAsyncRender = NO;
+  _asyncRenderInFlight = YES;
+  __weak ARTSurfaceView *weakSelf = self;
+  dispatch_async(ARTRenderQueue(), ^{
+    UIGraphicsBeginImageContextWithOptions(size, NO, scale);
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    for (ARTRenderBlock snapshot in snapshots) {
+      snapshot(context);
+    }
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+      ARTSurfaceView *strongSelf = weakSelf;
+      if (!strongSelf) {
+        return;
+      }
+      strongSelf->_asyncRenderInFlight = NO;
+      if (!strongSelf->_asyncRendering) {
+        return;
+      }
+      [CATransaction begin];
+      [CATransaction setDisableActions:YES];
+      strongSelf->_asyncLayer.contentsScale = scale;
+      strongSelf->_asyncLayer.contents = (__bridge id)image.CGImage;
+      [CATransaction commit];
+      if (strongSelf->_needsAsyncRender) {
+        [strongSelf setNeedsLayout];
+      }
+    });
+  });
+}
+
 - (void)drawRect:(CGRect)rect
 {
+  if (_layerBacked || _asyncRendering) {
+    // Nodes display themselves, or are rendered in the background
+    return;
+  }
   CGContextRef context = UIGraphicsGetCurrentContext();
   for (ARTNode *node in self.subviews) {
     [node renderTo:context];
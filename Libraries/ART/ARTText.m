@@ -46,82 +46,112 @@ static void ARTFreeTextFrame(ARTTextFrame frame)
 }
 
 - (void)renderLayerTo:(CGContextRef)context
+{
+  ARTRenderBlock snapshot = [self layerSnapshot];
+  if (snapshot) {
+    snapshot(context);
+  }
+}
+
+- (ARTRenderBlock)layerSnapshot
 {
   ARTTextFrame frame = self.textFrame;
 
   if ((!self.fill && !self.stroke) || !frame.count) {
-    return;
+    return nil;
   }
 
   // to-do: draw along a path
 
-  CGTextDrawingMode mode = kCGTextStroke;
-  if (self.fill) {
-    if ([self.fill applyFillColor:context]) {
-      mode = kCGTextFill;
-    } else {
-
-      for (int i = 0; i < frame.count; i++) {
-        CGContextSaveGState(context);
-        // Inverse the coordinate space since CoreText assumes a bottom-up coordinate space
-        CGContextScaleCTM(context, 1.0, -1.0);
-        CGContextSetTextDrawingMode(context, kCGTextClip);
-        [self renderLineTo:context atIndex:i];
-        // Inverse the coordinate space back to the original before filling
-        CGContextScaleCTM(context, 1.0, -1.0);
-        [self.fill paint:context];
-        // Restore the state so that the next line can be clipped separately
-        CGContextRestoreGState(context);
-      }
+  // Copy the lines and their positions since the frame is freed when a new one is set
+  NSMutableArray *lines = [NSMutableArray arrayWithCapacity:frame.count];
+  NSMutableData *positionData = [NSMutableData dataWithLength:frame.count * sizeof(CGPoint)];
+  CGPoint *positions = positionData.mutableBytes;
+  for (int i = 0; i < frame.count; i++) {
+    [lines addObject:(__bridge id)frame.lines[i]];
+    // We should consider snapping this shift to device pixels to improve rendering quality
+    // when a line has subpixel width.
+    positions[i] = CGPointMake(-[self shiftForLineAtIndex:i], -frame.baseLine - frame.lineHeight * i);
+  }
 
-      if (!self.stroke) {
-        return;
+  ARTBrush *fill = self.fill;
+  ARTRenderBlock applyStroke = [self strokeSnapshot];
+  return ^(CGContextRef context) {
+    const CGPoint *linePositions = positionData.bytes;
+    CGTextDrawingMode mode = kCGTextStroke;
+    if (fill) {
+      if ([fill applyFillColor:context]) {
+        mode = kCGTextFill;
+      } else {
+
+        for (NSUInteger i = 0; i < lines.count; i++) {
+          CGContextSaveGState(context);
+          // Inverse the coordinate space since CoreText assumes a bottom-up coordinate space
+          CGContextScaleCTM(context, 1.0, -1.0);
+          CGContextSetTextDrawingMode(context, kCGTextClip);
+          CGContextSetTextPosition(context, linePositions[i].x, linePositions[i].y);
+          CTLineDraw((__bridge CTLineRef)lines[i], context);
+          // Inverse the coordinate space back to the original before filling
+          CGContextScaleCTM(context, 1.0, -1.0);
+          [fill paint:context];
+          // Restore the state so that the next line can be clipped separately
+          CGContextRestoreGState(context);
+        }
+
+        if (!applyStroke) {
+          return;
+        }
       }
     }
-  }
-  if (self.stroke) {
-    CGContextSetStrokeColorWithColor(context, self.stroke);
-    CGContextSetLineWidth(context, self.strokeWidth);
-    CGContextSetLineCap(context, self.strokeCap);
-    CGContextSetLineJoin(context, self.strokeJoin);
-    ARTCGFloatArray dash = self.strokeDash;
-    if (dash.count) {
-      CGContextSetLineDash(context, 0, dash.array, dash.count);
-    }
-    if (mode == kCGTextFill) {
-      mode = kCGTextFillStroke;
+    if (applyStroke) {
+      applyStroke(context);
+      if (mode == kCGTextFill) {
+        mode = kCGTextFillStroke;
+      }
     }
-  }
 
-  CGContextSetTextDrawingMode(context, mode);
+    CGContextSetTextDrawingMode(context, mode);
+
+    // Inverse the coordinate space since CoreText assumes a bottom-up coordinate space
+    CGContextScaleCTM(context, 1.0, -1.0);
+    for (NSUInteger i = 0; i < lines.count; i++) {
+      CGContextSetTextPosition(context, linePositions[i].x, linePositions[i].y);
+      CTLineDraw((__bridge CTLineRef)lines[i], context);
+    }
+  };
+}
 
-  // Inverse the coordinate space since CoreText assumes a bottom-up coordinate space
-  CGContextScaleCTM(context, 1.0, -1.0);
+- (CGRect)contentBounds
+{
+  ARTTextFrame frame = self.textFrame;
+  if ((!self.fill && !self.stroke) || !frame.count) {
+    return CGRectZero;
+  }
+  CGRect bounds = CGRectNull;
   for (int i = 0; i < frame.count; i++) {
-    [self renderLineTo:context atIndex:i];
+    // Glyph bounds are bottom-up relative to the text position of the line
+    CGRect glyphBounds = CTLineGetBoundsWithOptions(frame.lines[i], kCTLineBoundsUseGlyphPathBounds);
+    CGRect lineBounds = CGRectMake(glyphBounds.origin.x - [self shiftForLineAtIndex:i],
+                                   frame.baseLine + frame.lineHeight * i - CGRectGetMaxY(glyphBounds),
+                                   glyphBounds.size.width,
+                                   glyphBounds.size.height);
+    bounds = CGRectUnion(bounds, lineBounds);
   }
+  CGFloat outset = 1 + (self.stroke ? self.strokeWidth : 0);
+  return CGRectInset(bounds, -outset, -outset);
 }
 
-- (void)renderLineTo:(CGContextRef)context atIndex:(int)index
+- (CGFloat)shiftForLineAtIndex:(int)index
 {
   ARTTextFrame frame = self.textFrame;
-  CGFloat shift;
   switch (self.alignment) {
     case kCTTextAlignmentRight:
-      shift = frame.widths[index];
-      break;
+      return frame.widths[index];
     case kCTTextAlignmentCenter:
-      shift = (frame.widths[index] / 2);
-      break;
+      return frame.widths[index] / 2;
     default:
-      shift = 0;
-      break;
+      return 0;
   }
-  // We should consider snapping this shift to device pixels to improve rendering quality
-  // when a line has subpixel width.
-  CGContextSetTextPosition(context, -shift, -frame.baseLine - frame.lineHeight * index);
-  CTLineRef line = frame.lines[index];
-  CTLineDraw(line, context);
 }
 
 @end
@@ -25,6 +25,12 @@
  */
 - (BOOL)applyFillColor:(CGContextRef)context;
 
+/**
+ * Brushes that paint a single color return it here, so that layer-backed shapes can be
+ * filled by Core Animation. Returns NULL for brushes that need to paint.
+ */
+- (CGColorRef)solidColor;
+
 /**
  * paint fills the context with a brush. The context is assumed to
  * be clipped.
@@ -21,6 +21,11 @@
   return NO;
 }
 
+- (CGColorRef)solidColor
+{
+  return NULL;
+}
+
 - (void)paint:(CGContextRef)context
 {
   // abstract
@@ -36,4 +36,9 @@
   return YES;
 }
 
+- (CGColorRef)solidColor
+{
+  return _color;
+}
+
 @end
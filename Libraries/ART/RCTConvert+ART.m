@@ -17,8 +17,102 @@
 
 @implementation RCTConvert (ART)
 
+static BOOL ARTReadPathValues(const char **cursor, CGFloat *values, NSUInteger count)
+{
+  for (NSUInteger i = 0; i < count; i++) {
+    char *end;
+    values[i] = strtod(*cursor, &end);
+    if (end == *cursor) {
+      return NO;
+    }
+    *cursor = end;
+  }
+  return YES;
+}
+
+// Parses the space separated encoding produced by ARTSerializablePath straight from the
+// UTF8 buffer, using the same command codes as the array format.
+static CGPathRef ARTCreatePathFromString(NSString *string)
+{
+  const char *cursor = string.UTF8String;
+  CGMutablePathRef path = CGPathCreateMutable();
+  CGPathMoveToPoint(path, NULL, 0, 0);
+
+  CGFloat v[6];
+  BOOL valid = YES;
+  while (valid) {
+    char *end;
+    long type = strtol(cursor, &end, 10);
+    if (end == cursor) {
+      // Only whitespace may follow the last command
+      while (isspace(*cursor)) {
+        cursor++;
+      }
+      valid = (*cursor == '\0');
+      break;
+    }
+    cursor = end;
+    switch (type) {
+      case 0:
+        if ((valid = ARTReadPathValues(&cursor, v, 2))) {
+          CGPathMoveToPoint(path, NULL, v[0], v[1]);
+        }
+        break;
+      case 1:
+        CGPathCloseSubpath(path);
+        break;
+      case 2:
+        if ((valid = ARTReadPathValues(&cursor, v, 2))) {
+          CGPathAddLineToPoint(path, NULL, v[0], v[1]);
+        }
+        break;
+      case 3:
+        if ((valid = ARTReadPathValues(&cursor, v, 6))) {
+          CGPathAddCurveToPoint(path, NULL, v[0], v[1], v[2], v[3], v[4], v[5]);
+        }
+        break;
+      case 4:
+        if ((valid = ARTReadPathValues(&cursor, v, 6))) {
+          CGPathAddArc(path, NULL, v[0], v[1], v[2], v[3], v[4], v[5] == 0);
+        }
+        break;
+      default:
+        valid = NO;
+        break;
+    }
+  }
+
+  if (!valid) {
+    RCTLogError(@"Invalid CGPath format: %@", string);
+    CGPathRelease(path);
+    return NULL;
+  }
+  return path;
+}
+
 + (CGPathRef)CGPath:(id)json
 {
+  if ([json isKindOfClass:[NSString class]]) {
+    // Icons tend to repeat the same path data across many shapes, so parsed paths are shared
+    static NSCache *pathCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      pathCache = [NSCache new];
+      pathCache.countLimit = 256;
+    });
+
+    id cachedPath = [pathCache objectForKey:json];
+    if (!cachedPath) {
+      CGPathRef path = ARTCreatePathFromString(json);
+      if (!path) {
+        return NULL;
+      }
+      cachedPath = (__bridge_transfer id)path;
+      [pathCache setObject:cachedPath forKey:json];
+    }
+    return (CGPathRef)CFAutorelease(CGPathRetain((__bridge CGPathRef)cachedPath));
+  }
+
   NSArray *arr = [self NSNumberArray:json];
 
   NSUInteger count = [arr count];
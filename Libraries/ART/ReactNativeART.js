@@ -67,6 +67,8 @@ var SurfaceViewAttributes = merge(ReactNativeViewAttributes.UIView, {
   // This should contain pixel information such as width, height and
   // resolution to know what kind of buffer needs to be allocated.
   // Currently we rely on UIViews and style to figure that out.
+  layerBacked: true,
+  asyncRendering: true,
 });
 
 var NodeAttributes = {
@@ -75,7 +77,7 @@ var NodeAttributes = {
 };
 
 var GroupAttributes = merge(NodeAttributes, {
-  clipping: { diff: arrayDiffer }
+  clipping: true,
 });
 
 var RenderableAttributes = merge(NodeAttributes, {
@@ -88,13 +90,13 @@ var RenderableAttributes = merge(NodeAttributes, {
 });
 
 var ShapeAttributes = merge(RenderableAttributes, {
-  d: { diff: arrayDiffer },
+  d: true,
 });
 
 var TextAttributes = merge(RenderableAttributes, {
   alignment: true,
   frame: { diff: fontAndLinesDiffer },
-  path: { diff: arrayDiffer }
+  path: true,
 });
 
 // Native Components
@@ -143,7 +145,10 @@ var Surface = React.createClass({
     var w = extractNumber(props.width, 0);
     var h = extractNumber(props.height, 0);
     return (
-      <NativeSurfaceView style={[props.style, { width: w, height: h }]}>
+      <NativeSurfaceView
+        style={[props.style, { width: w, height: h }]}
+        layerBacked={props.layerBacked}
+        asyncRendering={props.asyncRendering}>
         {this.props.children}
       </NativeSurfaceView>
     );
@@ -20,4 +20,7 @@ RCT_EXPORT_MODULE()
   return [[ARTSurfaceView alloc] init];
 }
 
+RCT_EXPORT_VIEW_PROPERTY(layerBacked, BOOL)
+RCT_EXPORT_VIEW_PROPERTY(asyncRendering, BOOL)
+
 @end
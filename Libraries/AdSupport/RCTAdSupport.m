@@ -16,6 +16,11 @@
 
 RCT_EXPORT_MODULE()
 
++ (RCTMethodQueuePriority)methodQueuePriority
+{
+  return RCTMethodQueuePriorityBackground;
+}
+
 RCT_EXPORT_METHOD(getAdvertisingId:(RCTResponseSenderBlock)callback
                   withErrorCallback:(RCTResponseErrorBlock)errorCallback)
 {
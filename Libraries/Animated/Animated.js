@@ -15,6 +15,7 @@ var Easing = require('Easing');
 var Image = require('Image');
 var InteractionManager = require('InteractionManager');
 var Interpolation = require('Interpolation');
+var NativeAnimationManager = require('NativeModules').NativeAnimationManager;
 var React = require('React');
 var Set = require('Set');
 var SpringConfig = require('SpringConfig');
@@ -55,6 +56,11 @@ class Animation {
     previousAnimation: ?Animation,
   ): void {}
   stop(): void {}
+  // Returns the description of the animation for the native driver, or null
+  // if it has to run in JS.
+  __getNativeConfig(fromValue: number): ?Object {
+    return null;
+  }
   // Helper function for subclasses to make sure onEnd is only called once.
   __debouncedOnEnd(result: EndResult) {
     var onEnd = this.__onEnd;
@@ -135,6 +141,7 @@ type TimingAnimationConfig = {
   easing?: (value: number) => number;
   duration?: number;
   delay?: number;
+  useNativeDriver?: bool;
 };
 
 type TimingAnimationConfigSingle = {
@@ -142,6 +149,7 @@ type TimingAnimationConfigSingle = {
   easing?: (value: number) => number;
   duration?: number;
   delay?: number;
+  useNativeDriver?: bool;
 };
 
 var easeInOut = Easing.inOut(Easing.ease);
@@ -156,6 +164,7 @@ class TimingAnimation extends Animation {
   _onUpdate: (value: number) => void;
   _animationFrame: any;
   _timeout: any;
+  _useNativeDriver: bool;
 
   constructor(
     config: TimingAnimationConfigSingle,
@@ -165,6 +174,30 @@ class TimingAnimation extends Animation {
     this._easing = config.easing || easeInOut;
     this._duration = config.duration !== undefined ? config.duration : 500;
     this._delay = config.delay || 0;
+    this._useNativeDriver = !!config.useNativeDriver;
+  }
+
+  __getNativeConfig(fromValue: number): ?Object {
+    if (!this._useNativeDriver || this._duration === 0) {
+      return null;
+    }
+    // The easing can't be sent over, so sample it at 60fps instead. The delay
+    // is sent as leading frames that hold the start value.
+    var frameDuration = 1000 / 60;
+    var frames = [];
+    for (var time = 0; time < this._delay; time += frameDuration) {
+      frames.push(0);
+    }
+    for (time = 0; time < this._duration; time += frameDuration) {
+      frames.push(this._easing(time / this._duration));
+    }
+    frames.push(this._easing(1));
+    return {
+      type: 'frames',
+      fromValue,
+      toValue: this._toValue,
+      frames,
+    };
   }
 
   start(
@@ -228,11 +261,13 @@ class TimingAnimation extends Animation {
 type DecayAnimationConfig = {
   velocity: number | {x: number, y: number};
   deceleration?: number;
+  useNativeDriver?: bool;
 };
 
 type DecayAnimationConfigSingle = {
   velocity: number;
   deceleration?: number;
+  useNativeDriver?: bool;
 };
 
 class DecayAnimation extends Animation {
@@ -243,6 +278,7 @@ class DecayAnimation extends Animation {
   _velocity: number;
   _onUpdate: (value: number) => void;
   _animationFrame: any;
+  _useNativeDriver: bool;
 
   constructor(
     config: DecayAnimationConfigSingle,
@@ -250,6 +286,19 @@ class DecayAnimation extends Animation {
     super();
     this._deceleration = config.deceleration || 0.998;
     this._velocity = config.velocity;
+    this._useNativeDriver = !!config.useNativeDriver;
+  }
+
+  __getNativeConfig(fromValue: number): ?Object {
+    if (!this._useNativeDriver) {
+      return null;
+    }
+    return {
+      type: 'decay',
+      fromValue,
+      velocity: this._velocity,
+      deceleration: this._deceleration,
+    };
   }
 
   start(
@@ -303,6 +352,7 @@ type SpringAnimationConfig = {
   speed?: number;
   tension?: number;
   friction?: number;
+  useNativeDriver?: bool;
 };
 
 type SpringAnimationConfigSingle = {
@@ -315,6 +365,7 @@ type SpringAnimationConfigSingle = {
   speed?: number;
   tension?: number;
   friction?: number;
+  useNativeDriver?: bool;
 };
 
 function withDefault<T>(value: ?T, defaultValue: T): T {
@@ -339,11 +390,13 @@ class SpringAnimation extends Animation {
   _lastTime: number;
   _onUpdate: (value: number) => void;
   _animationFrame: any;
+  _useNativeDriver: bool;
 
   constructor(
     config: SpringAnimationConfigSingle,
   ) {
     super();
+    this._useNativeDriver = !!config.useNativeDriver;
 
     this._overshootClamping = withDefault(config.overshootClamping, false);
     this._restDisplacementThreshold = withDefault(config.restDisplacementThreshold, 0.001);
@@ -399,6 +452,23 @@ class SpringAnimation extends Animation {
     this.onUpdate();
   }
 
+  __getNativeConfig(fromValue: number): ?Object {
+    if (!this._useNativeDriver) {
+      return null;
+    }
+    return {
+      type: 'spring',
+      fromValue,
+      toValue: this._toValue,
+      tension: this._tension,
+      friction: this._friction,
+      velocity: withDefault(this._initialVelocity, this._lastVelocity),
+      overshootClamping: this._overshootClamping,
+      restDisplacementThreshold: this._restDisplacementThreshold,
+      restSpeedThreshold: this._restSpeedThreshold,
+    };
+  }
+
   getInternalState(): Object {
     return {
       lastPosition: this._lastPosition,
@@ -506,6 +576,163 @@ class SpringAnimation extends Animation {
   }
 }
 
+var _nativeAnimationId = 1;
+
+/**
+ * Runs an animation described by `__getNativeConfig` on the main thread, so
+ * frames don't depend on the JS thread being free. The value in JS stays put
+ * while it runs and is only updated with where the views ended up once the
+ * animation finishes or is stopped.
+ */
+class NativeDrivenAnimation extends Animation {
+  _id: number;
+  _config: Object;
+  _bindings: Array<Object>;
+  _canApplyStoppedValue: () => bool;
+
+  constructor(
+    config: Object,
+    bindings: Array<Object>,
+    canApplyStoppedValue: () => bool,
+  ) {
+    super();
+    this._config = config;
+    this._bindings = bindings;
+    this._canApplyStoppedValue = canApplyStoppedValue;
+  }
+
+  start(
+    fromValue: number,
+    onUpdate: (value: number) => void,
+    onEnd: ?EndCallback,
+  ): void {
+    this.__active = true;
+    this.__onEnd = onEnd;
+    this._id = _nativeAnimationId++;
+    NativeAnimationManager.startAnimation(
+      this._id,
+      this._config,
+      this._bindings,
+      (result) => {
+        if (this.__active || this._canApplyStoppedValue()) {
+          onUpdate(result.value);
+        }
+        this.__active = false;
+        this.__debouncedOnEnd({finished: result.finished});
+      },
+    );
+  }
+
+  stop(): void {
+    if (this.__active) {
+      this.__active = false;
+      NativeAnimationManager.stopAnimation(this._id);
+    }
+    this.__debouncedOnEnd({finished: false});
+  }
+}
+
+/**
+ * Collects what the native driver needs to apply `value` to the views bound
+ * to it, or returns null if any of them uses the value in a way it doesn't
+ * support. Only opacity and transforms are supported, through any number of
+ * interpolations without easing.
+ */
+function _getNativeBindings(value: AnimatedValue): ?Array<Object> {
+  var bindings = [];
+
+  function getTags(style: AnimatedStyle): ?Array<number> {
+    var tags = [];
+    var children = style.__getChildren();
+    for (var i = 0; i < children.length; i++) {
+      var props = children[i];
+      var tag = props instanceof AnimatedProps &&
+        props.__getNativeTag && props.__getNativeTag();
+      if (!tag) {
+        return null;
+      }
+      tags.push(tag);
+    }
+    return tags;
+  }
+
+  function collect(node: Animated, parent: Animated, interpolations: Array<Object>): bool {
+    if (node instanceof AnimatedInterpolation) {
+      var config = node.__getNativeConfig();
+      if (!config) {
+        return false;
+      }
+      interpolations = interpolations.concat([config]);
+      return node.__getChildren().every(
+        child => collect(child, node, interpolations)
+      );
+    }
+    if (node instanceof AnimatedStyle && node._style.opacity === parent) {
+      var tags = getTags(node);
+      if (!tags) {
+        return false;
+      }
+      tags.forEach(tag => bindings.push({tag, property: 'opacity', interpolations}));
+      return true;
+    }
+    if (node instanceof AnimatedTransform) {
+      var transform = [];
+      var isDriven = false;
+      for (var i = 0; i < node._transforms.length; i++) {
+        for (var key in node._transforms[i]) {
+          var operation = node._transforms[i][key];
+          if (operation === parent && !isDriven) {
+            isDriven = true;
+            transform.push({key, interpolations});
+          } else if (operation instanceof Animated) {
+            // Other values driving the same transform would be overwritten
+            return false;
+          } else {
+            var number = _toNativeNumber(operation);
+            if (number === null) {
+              return false;
+            }
+            transform.push({key, value: number});
+          }
+        }
+      }
+      return node.__getChildren().every(style => {
+        var tags = style instanceof AnimatedStyle && getTags(style);
+        if (!tags) {
+          return false;
+        }
+        tags.forEach(tag => bindings.push({tag, property: 'transform', transform}));
+        return true;
+      });
+    }
+    return false;
+  }
+
+  var children = value.__getChildren();
+  if (!children.length) {
+    return null;
+  }
+  for (var i = 0; i < children.length; i++) {
+    if (!collect(children[i], value, [])) {
+      return null;
+    }
+  }
+  return bindings;
+}
+
+// Converts numbers and angles, e.g. '45deg', to what native expects
+function _toNativeNumber(value: any): ?number {
+  if (typeof value === 'number') {
+    return value;
+  }
+  var match = typeof value === 'string' && value.match(/^(-?[\d.]+)(deg|rad)$/);
+  if (!match) {
+    return null;
+  }
+  var number = parseFloat(match[1]);
+  return match[2] === 'deg' ? number * Math.PI / 180 : number;
+}
+
 type ValueListenerCallback = (state: {value: number}) => void;
 
 var _uniqueId = 1;
@@ -605,7 +832,7 @@ class AnimatedValue extends AnimatedWithChildren {
    * 0-10.
    */
   interpolate(config: InterpolationConfigType): AnimatedInterpolation {
-    return new AnimatedInterpolation(this, Interpolation.create(config));
+    return new AnimatedInterpolation(this, Interpolation.create(config), config);
   }
 
   /**
@@ -616,6 +843,20 @@ class AnimatedValue extends AnimatedWithChildren {
     var handle = InteractionManager.createInteractionHandle();
     var previousAnimation = this._animation;
     this._animation && this._animation.stop();
+
+    var nativeConfig = NativeAnimationManager &&
+      animation.__getNativeConfig(this._value);
+    var nativeBindings = nativeConfig && _getNativeBindings(this);
+    if (nativeBindings) {
+      var fromValue = this._value;
+      animation = new NativeDrivenAnimation(
+        nativeConfig,
+        nativeBindings,
+        // Only catch up with a stopped animation if nothing has driven the
+        // value since
+        () => !this._animation && this._value === fromValue,
+      );
+    }
     this._animation = animation;
     animation.start(
       this._value,
@@ -800,11 +1041,34 @@ class AnimatedValueXY extends AnimatedWithChildren {
 class AnimatedInterpolation extends AnimatedWithChildren {
   _parent: Animated;
   _interpolation: (input: number) => number | string;
+  _config: ?InterpolationConfigType;
 
-  constructor(parent: Animated, interpolation: (input: number) => number | string) {
+  constructor(
+    parent: Animated,
+    interpolation: (input: number) => number | string,
+    config?: InterpolationConfigType,
+  ) {
     super();
     this._parent = parent;
     this._interpolation = interpolation;
+    this._config = config;
+  }
+
+  __getNativeConfig(): ?Object {
+    var config = this._config;
+    if (!config || config.easing) {
+      return null;
+    }
+    var outputRange = config.outputRange.map(_toNativeNumber);
+    if (outputRange.indexOf(null) !== -1) {
+      return null;
+    }
+    return {
+      inputRange: config.inputRange,
+      outputRange,
+      extrapolateLeft: config.extrapolateLeft || config.extrapolate,
+      extrapolateRight: config.extrapolateRight || config.extrapolate,
+    };
   }
 
   __getValue(): number | string {
@@ -817,7 +1081,7 @@ class AnimatedInterpolation extends AnimatedWithChildren {
   }
 
   interpolate(config: InterpolationConfigType): AnimatedInterpolation {
-    return new AnimatedInterpolation(this, Interpolation.create(config));
+    return new AnimatedInterpolation(this, Interpolation.create(config), config);
   }
 
   __attach(): void {
@@ -952,6 +1216,7 @@ class AnimatedStyle extends AnimatedWithChildren {
 class AnimatedProps extends Animated {
   _props: Object;
   _callback: () => void;
+  __getNativeTag: ?() => ?number;
 
   constructor(
     props: Object,
@@ -1056,6 +1321,8 @@ function createAnimatedComponent(Component: any): any {
         nextProps,
         callback,
       );
+      // Lets animations find the view to drive natively
+      this._propsAnimated.__getNativeTag = () => React.findNodeHandle(this.refs[refName]);
 
       // When you call detach, it removes the element from the parent list
       // of children. If it goes to 0, then the parent also detaches itself
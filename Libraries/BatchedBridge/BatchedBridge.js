@@ -12,8 +12,10 @@
 
 let MessageQueue = require('MessageQueue');
 
+// Executors that can build module configs on demand install nativeModuleProxy
+// and leave remoteModuleConfig empty
 let BatchedBridge = new MessageQueue(
-  __fbBatchedBridgeConfig.remoteModuleConfig,
+  global.nativeModuleProxy || __fbBatchedBridgeConfig.remoteModuleConfig,
   __fbBatchedBridgeConfig.localModulesConfig,
 );
 
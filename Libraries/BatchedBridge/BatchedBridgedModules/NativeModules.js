@@ -17,4 +17,49 @@ var nativeModulePrefixNormalizer = require('nativeModulePrefixNormalizer');
 
 nativeModulePrefixNormalizer(NativeModules);
 
+/**
+ * When the executor can call native synchronously, the UIManager only lists
+ * the names of its view managers, and each view config is fetched the first
+ * time it's read.
+ */
+function defineLazyViewConfigs(UIManager: Object): void {
+  var viewManagerNames = UIManager.ViewManagerNames;
+  if (!viewManagerNames) {
+    return;
+  }
+  viewManagerNames.forEach((viewName) => {
+    Object.defineProperty(UIManager, viewName, {
+      configurable: true,
+      enumerable: true,
+      get: () => {
+        var viewConfig = UIManager.lazilyLoadView(viewName);
+        Object.defineProperty(UIManager, viewName, {
+          configurable: true,
+          enumerable: true,
+          writable: true,
+          value: viewConfig,
+        });
+        return viewConfig;
+      },
+    });
+  });
+}
+
+var uiManagerDescriptor = Object.getOwnPropertyDescriptor(NativeModules, 'UIManager');
+if (uiManagerDescriptor && uiManagerDescriptor.get) {
+  var getUIManager = uiManagerDescriptor.get;
+  var UIManager = null;
+  Object.defineProperty(NativeModules, 'UIManager', {
+    configurable: true,
+    enumerable: true,
+    get: () => {
+      if (!UIManager) {
+        UIManager = getUIManager();
+        defineLazyViewConfigs(UIManager);
+      }
+      return UIManager;
+    },
+  });
+}
+
 module.exports = NativeModules;
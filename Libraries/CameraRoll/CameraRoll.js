@@ -76,6 +76,15 @@ var getPhotosParamChecker = createStrictShapeTypeChecker({
    * Filter by mimetype (e.g. image/jpeg).
    */
   mimeTypes: ReactPropTypes.arrayOf(ReactPropTypes.string),
+
+  /**
+   * The size the photos will be displayed at. When given, their thumbnails,
+   * and those of the next page, are loaded into the image cache ahead of time.
+   */
+  thumbnailSize: ReactPropTypes.shape({
+    width: ReactPropTypes.number.isRequired,
+    height: ReactPropTypes.number.isRequired,
+  }),
 });
 
 /**
@@ -21,6 +21,7 @@
 
 static dispatch_queue_t RCTAssetsLibraryImageLoaderQueue(void);
 static UIImage *RCTScaledImageForAsset(ALAssetRepresentation *representation, CGSize size, CGFloat scale, UIViewContentMode resizeMode, NSError **error);
+static UIImage *RCTThumbnailForAsset(ALAsset *asset, CGSize size, CGFloat scale, UIViewContentMode resizeMode);
 
 @implementation RCTAssetsLibraryImageLoader
 {
@@ -66,7 +67,8 @@ RCT_EXPORT_MODULE()
                                         scale:scale
                                   orientation:(UIImageOrientation)representation.orientation];
           } else {
-            image = RCTScaledImageForAsset(representation, size, scale, resizeMode, &error);
+            image = RCTThumbnailForAsset(asset, size, scale, resizeMode) ?:
+              RCTScaledImageForAsset(representation, size, scale, resizeMode, &error);
           }
 
           completionHandler(error, image);
@@ -153,3 +155,29 @@ static UIImage *RCTScaledImageForAsset(ALAssetRepresentation *representation, CG
 
   return nil;
 }
+
+// The assets library keeps thumbnails of every asset, which are far cheaper to
+// get than scaling down the full image, so use them when they are big enough.
+
+static UIImage *RCTThumbnailForAsset(ALAsset *asset, CGSize size, CGFloat scale, UIViewContentMode resizeMode)
+{
+  ALAssetRepresentation *representation = [asset defaultRepresentation];
+  CGSize targetSize = RCTTargetSize(representation.dimensions, representation.scale,
+                                    size, scale, resizeMode, NO);
+  CGFloat targetPixels = MAX(targetSize.width, targetSize.height) * scale;
+
+  // The square thumbnail is cropped to fill, like a square image view would
+  if (resizeMode == UIViewContentModeScaleAspectFill && size.width == size.height) {
+    CGImageRef thumbnail = asset.thumbnail;
+    if (thumbnail && CGImageGetWidth(thumbnail) >= size.width * scale) {
+      return [UIImage imageWithCGImage:thumbnail scale:scale orientation:UIImageOrientationUp];
+    }
+  }
+
+  CGImageRef thumbnail = asset.aspectRatioThumbnail;
+  if (thumbnail && MAX(CGImageGetWidth(thumbnail), CGImageGetHeight(thumbnail)) >= targetPixels) {
+    return [UIImage imageWithCGImage:thumbnail scale:scale orientation:UIImageOrientationUp];
+  }
+
+  return nil;
+}
@@ -16,16 +16,89 @@
 
 #import "RCTAssetsLibraryImageLoader.h"
 #import "RCTBridge.h"
+#import "RCTConvert.h"
 #import "RCTImageLoader.h"
 #import "RCTLog.h"
 #import "RCTUtils.h"
 
+typedef void (^RCTCameraRollPageBlock)(NSError *error, NSDictionary *page);
+
+// Where the end cursors of the pages sent so far are, to resume from them
+static const NSUInteger RCTCameraRollCursorPositionLimit = 64;
+
+static ALAssetsGroupType RCTAssetsGroupTypes(NSString *groupTypes)
+{
+  if ([groupTypes isEqualToString:@"Album"]) {
+    return ALAssetsGroupAlbum;
+  } else if ([groupTypes isEqualToString:@"All"]) {
+    return ALAssetsGroupAll;
+  } else if ([groupTypes isEqualToString:@"Event"]) {
+    return ALAssetsGroupEvent;
+  } else if ([groupTypes isEqualToString:@"Faces"]) {
+    return ALAssetsGroupFaces;
+  } else if ([groupTypes isEqualToString:@"Library"]) {
+    return ALAssetsGroupLibrary;
+  } else if ([groupTypes isEqualToString:@"PhotoStream"]) {
+    return ALAssetsGroupPhotoStream;
+  } else {
+    return ALAssetsGroupSavedPhotos;
+  }
+}
+
+static NSDictionary *RCTCameraRollPage(NSArray *assets, BOOL hasNextPage)
+{
+  if (!assets.count) {
+    return @{
+      @"edges": assets,
+      @"page_info": @{
+        @"has_next_page": @NO,
+      }
+    };
+  }
+  return @{
+    @"edges": assets,
+    @"page_info": @{
+      @"start_cursor": assets[0][@"node"][@"image"][@"uri"],
+      @"end_cursor": assets[assets.count - 1][@"node"][@"image"][@"uri"],
+      @"has_next_page": @(hasNextPage),
+    }
+  };
+}
+
+static NSString *RCTCameraRollPageKey(NSDictionary *params, NSString *afterCursor)
+{
+  return [NSString stringWithFormat:@"%@|%@|%@|%@|%@", params[@"first"], params[@"groupTypes"],
+          params[@"groupName"], params[@"assetType"], afterCursor];
+}
+
 @implementation RCTCameraRollManager
+{
+  NSMutableDictionary *_cursorPositions;
+
+  // The page after the last one that was sent, fetched ahead of time
+  NSString *_prefetchedPageKey;
+  NSDictionary *_prefetchedPage;
+  NSMutableArray *_prefetchedPageCallbacks;
+}
 
 RCT_EXPORT_MODULE()
 
 @synthesize bridge = _bridge;
 
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _cursorPositions = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (dispatch_queue_t)methodQueue
+{
+  // The assets library calls back on the main thread, keep the paging state there too
+  return dispatch_get_main_queue();
+}
+
 RCT_EXPORT_METHOD(saveImageWithTag:(NSString *)imageTag
                   successCallback:(RCTResponseSenderBlock)successCallback
                   errorCallback:(RCTResponseErrorBlock)errorCallback)
@@ -46,56 +119,115 @@ RCT_EXPORT_METHOD(saveImageWithTag:(NSString *)imageTag
   }];
 }
 
-- (void)callCallback:(RCTResponseSenderBlock)callback withAssets:(NSArray *)assets hasNextPage:(BOOL)hasNextPage
+RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
+                  callback:(RCTResponseSenderBlock)callback
+                  errorCallback:(RCTResponseErrorBlock)errorCallback)
 {
-  if (!assets.count) {
-    callback(@[@{
-                 @"edges": assets,
-                 @"page_info": @{
-                     @"has_next_page": @NO}
-                 }]);
+  NSString *afterCursor = params[@"after"];
+  NSString *pageKey = RCTCameraRollPageKey(params, afterCursor);
+  CGSize thumbnailSize = params[@"thumbnailSize"] ? [RCTConvert CGSize:params[@"thumbnailSize"]] : CGSizeZero;
+
+  RCTCameraRollPageBlock pageBlock = ^(NSError *error, NSDictionary *page) {
+    if (error) {
+      errorCallback(error);
+      return;
+    }
+    callback(@[page]);
+    [self prefetchThumbnailsForPage:page size:thumbnailSize];
+
+    // Fetch the next page while the JS side is busy with this one
+    if ([page[@"page_info"][@"has_next_page"] boolValue]) {
+      NSString *endCursor = page[@"page_info"][@"end_cursor"];
+      [self prefetchPageWithParams:params after:endCursor thumbnailSize:thumbnailSize];
+    }
+  };
+
+  if ([pageKey isEqualToString:_prefetchedPageKey]) {
+    if (_prefetchedPage) {
+      NSDictionary *page = _prefetchedPage;
+      [self clearPrefetchedPage];
+      pageBlock(nil, page);
+    } else {
+      [_prefetchedPageCallbacks addObject:pageBlock];
+    }
+    return;
+  }
+
+  [self clearPrefetchedPage];
+  [self fetchPageWithParams:params after:afterCursor callback:pageBlock];
+}
+
+#pragma mark - Paging
+
+- (void)clearPrefetchedPage
+{
+  _prefetchedPageKey = nil;
+  _prefetchedPage = nil;
+  _prefetchedPageCallbacks = nil;
+}
+
+- (void)prefetchPageWithParams:(NSDictionary *)params
+                         after:(NSString *)afterCursor
+                 thumbnailSize:(CGSize)thumbnailSize
+{
+  NSString *pageKey = RCTCameraRollPageKey(params, afterCursor);
+  _prefetchedPageKey = pageKey;
+  _prefetchedPage = nil;
+  _prefetchedPageCallbacks = [NSMutableArray new];
+
+  [self fetchPageWithParams:params after:afterCursor callback:^(NSError *error, NSDictionary *page) {
+    if (![_prefetchedPageKey isEqualToString:pageKey]) {
+      return; // A different page was asked for in the meantime
+    }
+    NSArray *callbacks = _prefetchedPageCallbacks;
+    if (callbacks.count) {
+      [self clearPrefetchedPage];
+      for (RCTCameraRollPageBlock pageBlock in callbacks) {
+        pageBlock(error, page);
+      }
+    } else if (error) {
+      // Fetched again, and the error reported, when the page is asked for
+      [self clearPrefetchedPage];
+    } else {
+      _prefetchedPage = page;
+      [self prefetchThumbnailsForPage:page size:thumbnailSize];
+    }
+  }];
+}
+
+- (void)prefetchThumbnailsForPage:(NSDictionary *)page size:(CGSize)size
+{
+  if (size.width <= 0 || size.height <= 0) {
     return;
   }
-  callback(@[@{
-               @"edges": assets,
-               @"page_info": @{
-                   @"start_cursor": assets[0][@"node"][@"image"][@"uri"],
-                   @"end_cursor": assets[assets.count - 1][@"node"][@"image"][@"uri"],
-                   @"has_next_page": @(hasNextPage)}
-               }]);
+  for (NSDictionary *edge in page[@"edges"]) {
+    [_bridge.imageLoader prefetchImageWithTag:edge[@"node"][@"image"][@"uri"]
+                                         size:size
+                              completionBlock:^(__unused NSError *error, __unused UIImage *image) {}];
+  }
 }
 
-RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
-                  callback:(RCTResponseSenderBlock)callback
-                  errorCallback:(RCTResponseErrorBlock)errorCallback)
+/**
+ * Enumerates the assets after the cursor. When the cursor is the end of a page
+ * that was sent before, the enumeration resumes at its index in its group
+ * instead of walking every asset before it.
+ */
+- (void)fetchPageWithParams:(NSDictionary *)params
+                      after:(NSString *)afterCursor
+                   callback:(RCTCameraRollPageBlock)callback
 {
   NSUInteger first = [params[@"first"] integerValue];
-  NSString *afterCursor = params[@"after"];
-  NSString *groupTypesStr = params[@"groupTypes"];
   NSString *groupName = params[@"groupName"];
   NSString *assetType = params[@"assetType"];
-  ALAssetsGroupType groupTypes;
-
-  if ([groupTypesStr isEqualToString:@"Album"]) {
-    groupTypes = ALAssetsGroupAlbum;
-  } else if ([groupTypesStr isEqualToString:@"All"]) {
-    groupTypes = ALAssetsGroupAll;
-  } else if ([groupTypesStr isEqualToString:@"Event"]) {
-    groupTypes = ALAssetsGroupEvent;
-  } else if ([groupTypesStr isEqualToString:@"Faces"]) {
-    groupTypes = ALAssetsGroupFaces;
-  } else if ([groupTypesStr isEqualToString:@"Library"]) {
-    groupTypes = ALAssetsGroupLibrary;
-  } else if ([groupTypesStr isEqualToString:@"PhotoStream"]) {
-    groupTypes = ALAssetsGroupPhotoStream;
-  } else {
-    groupTypes = ALAssetsGroupSavedPhotos;
-  }
+  ALAssetsGroupType groupTypes = RCTAssetsGroupTypes(params[@"groupTypes"]);
+  NSDictionary *cursorPosition = afterCursor ? _cursorPositions[afterCursor] : nil;
 
   BOOL __block foundAfter = NO;
   BOOL __block hasNextPage = NO;
   BOOL __block calledCallback = NO;
   NSMutableArray *assets = [NSMutableArray new];
+  NSURL *__block lastGroupURL = nil;
+  NSUInteger __block lastIndex = 0;
 
   [_bridge.assetsLibrary enumerateGroupsWithTypes:groupTypes usingBlock:^(ALAssetsGroup *group, BOOL *stopGroups) {
     if (group && (groupName == nil || [groupName isEqualToString:[group valueForProperty:ALAssetsGroupPropertyName]])) {
@@ -108,7 +240,26 @@ RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
         [group setAssetsFilter:ALAssetsFilter.allAssets];
       }
 
-      [group enumerateAssetsWithOptions:NSEnumerationReverse usingBlock:^(ALAsset *result, NSUInteger index, BOOL *stopAssets) {
+      NSURL *groupURL = [group valueForProperty:ALAssetsGroupPropertyURL];
+      NSInteger numberOfAssets = group.numberOfAssets;
+      NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfAssets)];
+
+      // Resume after the cursor if it is still where it was
+      if (cursorPosition && !foundAfter && [cursorPosition[@"group"] isEqual:groupURL]) {
+        NSUInteger cursorIndex = [cursorPosition[@"index"] unsignedIntegerValue];
+        if (cursorIndex < (NSUInteger)numberOfAssets) {
+          [group enumerateAssetsAtIndexes:[NSIndexSet indexSetWithIndex:cursorIndex] options:0 usingBlock:^(ALAsset *result, __unused NSUInteger index, __unused BOOL *stop) {
+            if ([((NSURL *)[result valueForProperty:ALAssetPropertyAssetURL]).absoluteString isEqualToString:afterCursor]) {
+              foundAfter = YES;
+            }
+          }];
+        }
+        if (foundAfter) {
+          indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, cursorIndex)];
+        }
+      }
+
+      [group enumerateAssetsAtIndexes:indexes options:NSEnumerationReverse usingBlock:^(ALAsset *result, NSUInteger index, BOOL *stopAssets) {
         if (result) {
           NSString *uri = ((NSURL *)[result valueForProperty:ALAssetPropertyAssetURL]).absoluteString;
           if (afterCursor && !foundAfter) {
@@ -122,7 +273,8 @@ RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
             *stopGroups = YES;
             hasNextPage = YES;
             RCTAssert(calledCallback == NO, @"Called the callback before we finished processing the results.");
-            [self callCallback:callback withAssets:assets hasNextPage:hasNextPage];
+            [self rememberCursor:assets.lastObject inGroup:lastGroupURL atIndex:lastIndex];
+            callback(nil, RCTCameraRollPage(assets, hasNextPage));
             calledCallback = YES;
             return;
           }
@@ -150,13 +302,15 @@ RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
                                     } : @{},
                                   }
                               }];
+          lastGroupURL = groupURL;
+          lastIndex = index;
         }
       }];
-    } else {
+    } else if (!group) {
       // Sometimes the enumeration continues even if we set stop above, so we guard against calling the callback
       // multiple times here.
       if (!calledCallback) {
-        [self callCallback:callback withAssets:assets hasNextPage:hasNextPage];
+        callback(nil, RCTCameraRollPage(assets, hasNextPage));
         calledCallback = YES;
       }
     }
@@ -164,8 +318,20 @@ RCT_EXPORT_METHOD(getPhotos:(NSDictionary *)params
     if (error.code != ALAssetsLibraryAccessUserDeniedError) {
       RCTLogError(@"Failure while iterating through asset groups %@", error);
     }
-    errorCallback(error);
+    callback(error, nil);
   }];
 }
 
+- (void)rememberCursor:(NSDictionary *)asset inGroup:(NSURL *)groupURL atIndex:(NSUInteger)index
+{
+  NSString *cursor = asset[@"node"][@"image"][@"uri"];
+  if (!cursor || !groupURL) {
+    return;
+  }
+  if (_cursorPositions.count >= RCTCameraRollCursorPositionLimit) {
+    [_cursorPositions removeAllObjects];
+  }
+  _cursorPositions[cursor] = @{@"group": groupURL, @"index": @(index)};
+}
+
 @end
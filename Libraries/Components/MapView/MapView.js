@@ -184,6 +184,15 @@ var MapView = React.createClass({
 
     })),
 
+    /**
+     * The size in points of the grid cells that annotations are clustered
+     * into at the current zoom level. Annotations in the same cell are shown
+     * as one cluster with a count, and tapping it zooms in on them. Clustering
+     * is off by default.
+     * @platform ios
+     */
+    annotationClusterSize: React.PropTypes.number,
+
     /**
      * Maximum size of area that can be displayed.
      */
@@ -38,6 +38,14 @@ var PropTypes = React.PropTypes;
 var SCROLLVIEW = 'ScrollView';
 var INNERVIEW = 'InnerScrollView';
 
+// Scroll event fields that native omits while they don't change
+var SCROLL_METRICS = [
+  'contentInset',
+  'contentSize',
+  'layoutMeasurement',
+  'zoomScale',
+];
+
 /**
  * Component that wraps platform ScrollView while providing
  * integration with touch locking "responder" system.
@@ -215,6 +223,14 @@ var ScrollView = React.createClass({
      * @platform ios
      */
     scrollEventThrottle: PropTypes.number,
+    /**
+     * Distance in pixels beyond the visible area that is kept mounted by
+     * components that window their content, such as ListView. When set, a
+     * scroll event is also sent every time the content moves by half this
+     * distance, regardless of `scrollEventThrottle`.
+     * @platform ios
+     */
+    windowOverscan: PropTypes.number,
     /**
      * The amount by which the scroll view indicators are inset from the edges
      * of the scroll view. This should normally be set to the same value as
@@ -314,6 +330,17 @@ var ScrollView = React.createClass({
         dismissKeyboard();
       }
     }
+    // Native only sends the scroll metrics that changed since the previous
+    // scroll event, so fill in the rest from earlier events
+    var nativeEvent = e.nativeEvent;
+    var scrollMetrics = this._scrollMetrics || (this._scrollMetrics = {});
+    SCROLL_METRICS.forEach((key) => {
+      if (nativeEvent[key] === undefined) {
+        nativeEvent[key] = scrollMetrics[key];
+      } else {
+        scrollMetrics[key] = nativeEvent[key];
+      }
+    });
     this.scrollResponderHandleScroll(e);
   },
 
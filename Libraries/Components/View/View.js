@@ -277,6 +277,17 @@ var View = React.createClass({
      */
     shouldRasterizeIOS: PropTypes.bool,
 
+    /**
+     * Whether the background and borders that iOS can't render natively, such
+     * as borders with different radii or colors per side, are drawn on a
+     * background thread. The main thread then only has to display the result,
+     * which can keep rows with rounded borders from dropping frames during
+     * fast scrolls. The previous contents stay visible until the new ones have
+     * been drawn, so avoid it for views that change during an animation.
+     * @platform ios
+     */
+    asyncDisplayIOS: PropTypes.bool,
+
     /**
      * Views that are only used to layout their children or otherwise don't draw
      * anything may be automatically removed from the native hierarchy as an
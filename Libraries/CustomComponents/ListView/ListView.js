@@ -34,6 +34,7 @@ var ScrollView = require('ScrollView');
 var ScrollResponder = require('ScrollResponder');
 var StaticRenderer = require('StaticRenderer');
 var TimerMixin = require('react-timer-mixin');
+var View = require('View');
 
 var isEmpty = require('isEmpty');
 var logError = require('logError');
@@ -202,6 +203,13 @@ var ListView = React.createClass({
      * containers.  Use at your own risk.
      */
     removeClippedSubviews: React.PropTypes.bool,
+    /**
+     * When set, rows that are further than this many pixels outside of the
+     * visible area are unmounted and replaced with empty views of the size
+     * they last laid out at. This releases their native views and shadow
+     * nodes, which keeps memory bounded in very long lists.
+     */
+    windowOverscan: React.PropTypes.number,
   },
 
   /**
@@ -249,6 +257,7 @@ var ListView = React.createClass({
       curRenderedRowsCount: this.props.initialListSize,
       prevRenderedRowsCount: 0,
       highlightedRow: {},
+      renderWindow: null,
     };
   },
 
@@ -341,7 +350,14 @@ var ListView = React.createClass({
         var comboID = sectionID + rowID;
         var shouldUpdateRow = rowCount >= this.state.prevRenderedRowsCount &&
           dataSource.rowShouldUpdate(sectionIdx, rowIdx);
-        var row =
+        var frame = this._childFrames[totalIndex];
+        var row = this._isOutsideRenderWindow(frame) ?
+          <View
+            key={'r_' + comboID}
+            style={this.props.horizontal ?
+              {width: frame.width} :
+              {height: frame.height}}
+          /> :
           <StaticRenderer
             key={'r_' + comboID}
             shouldUpdate={!!shouldUpdateRow}
@@ -489,15 +505,47 @@ var ListView = React.createClass({
       scrollProperties.offset;
   },
 
-  _updateVisibleRows: function(updatedFrames) {
-    if (!this.props.onChangeVisibleRows) {
-      return; // No need to compute visible rows if there is no callback
+  _isOutsideRenderWindow: function(frame) {
+    var renderWindow = this.state.renderWindow;
+    if (!renderWindow || !frame) {
+      return false;
+    }
+    var isVertical = !this.props.horizontal;
+    var min = isVertical ? frame.y : frame.x;
+    var max = min + (isVertical ? frame.height : frame.width);
+    return max < renderWindow.min || min > renderWindow.max;
+  },
+
+  _updateRenderWindow: function() {
+    var overscan = this.props.windowOverscan;
+    if (!overscan || this.scrollProperties.visibleLength === null) {
+      return;
     }
+    var visibleMin = this.scrollProperties.offset;
+    var visibleMax = visibleMin + this.scrollProperties.visibleLength;
+    var renderWindow = this.state.renderWindow;
+    // Only move the window once the viewport gets within half the overscan of
+    // its edges, so that rows aren't remounted on every scroll event
+    if (renderWindow &&
+        visibleMin - renderWindow.min >= overscan / 2 &&
+        renderWindow.max - visibleMax >= overscan / 2) {
+      return;
+    }
+    this.setState({
+      renderWindow: {min: visibleMin - overscan, max: visibleMax + overscan},
+    });
+  },
+
+  _updateVisibleRows: function(updatedFrames) {
+    // Frames are also used to size the placeholders of windowed out rows
     if (updatedFrames) {
       updatedFrames.forEach((newFrame) => {
         this._childFrames[newFrame.index] = merge(newFrame);
       });
     }
+    if (!this.props.onChangeVisibleRows) {
+      return; // No need to compute visible rows if there is no callback
+    }
     var isVertical = !this.props.horizontal;
     var dataSource = this.props.dataSource;
     var visibleMin = this.scrollProperties.offset;
@@ -570,6 +618,7 @@ var ListView = React.createClass({
       isVertical ? 'y' : 'x'
     ];
     this._updateVisibleRows(e.nativeEvent.updatedChildFrames);
+    this._updateRenderWindow();
     var nearEnd = this._getDistanceFromEnd(this.scrollProperties) < this.props.onEndReachedThreshold;
     if (nearEnd &&
         this.props.onEndReached &&
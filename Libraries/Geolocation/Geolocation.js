@@ -26,6 +26,9 @@ type GeoOptions = {
   timeout: number;
   maximumAge: number;
   enableHighAccuracy: bool;
+  distanceFilter: number;
+  accuracyFilter: number;
+  batchInterval: number;
 }
 
 /**
@@ -60,7 +63,14 @@ var Geolocation = {
 
   /*
    * Invokes the success callback whenever the location changes.  Supported
-   * options: timeout (ms), maximumAge (ms), enableHighAccuracy (bool)
+   * options: timeout (ms), maximumAge (ms), enableHighAccuracy (bool),
+   * distanceFilter (m), accuracyFilter (m), batchInterval (ms)
+   *
+   * Locations closer than distanceFilter to the last one, or less accurate
+   * than accuracyFilter, are dropped natively. With a batchInterval, locations
+   * are collected natively and sent over at most once per interval, and the
+   * success callback is invoked for each of them in order. With
+   * enableHighAccuracy too, the GPS may defer updates while the app sleeps.
    */
   watchPosition: function(success: Function, error?: Function, options?: GeoOptions): number {
     if (!updatesEnabled) {
@@ -77,6 +87,10 @@ var Geolocation = {
         'geolocationError',
         error
       ) : null,
+      RCTDeviceEventEmitter.addListener(
+        'geolocationDidChangeBatch',
+        (positions) => positions.forEach((position) => success(position))
+      ),
     ]);
     return watchID;
   },
@@ -92,6 +106,7 @@ var Geolocation = {
     sub[0].remove();
     // array element refinements not yet enabled in Flow
     var sub1 = sub[1]; sub1 && sub1.remove();
+    sub[2].remove();
     subscriptions[watchID] = undefined;
     var noWatchers = true;
     for (var ii = 0; ii < subscriptions.length; ii++) {
@@ -115,6 +130,7 @@ var Geolocation = {
           sub[0].remove();
           // array element refinements not yet enabled in Flow
           var sub1 = sub[1]; sub1 && sub1.remove();
+          sub[2].remove();
         }
       }
       subscriptions = [];
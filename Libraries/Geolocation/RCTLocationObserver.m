@@ -31,6 +31,9 @@ typedef struct {
   double timeout;
   double maximumAge;
   double accuracy;
+  double distanceFilter;
+  double accuracyFilter;
+  double batchInterval;
 } RCTLocationOptions;
 
 @implementation RCTConvert (RCTLocationOptions)
@@ -41,12 +44,32 @@ typedef struct {
   return (RCTLocationOptions){
     .timeout = [RCTConvert NSTimeInterval:options[@"timeout"]] ?: INFINITY,
     .maximumAge = [RCTConvert NSTimeInterval:options[@"maximumAge"]] ?: INFINITY,
-    .accuracy = [RCTConvert BOOL:options[@"enableHighAccuracy"]] ? kCLLocationAccuracyBest : RCT_DEFAULT_LOCATION_ACCURACY
+    .accuracy = [RCTConvert BOOL:options[@"enableHighAccuracy"]] ? kCLLocationAccuracyBest : RCT_DEFAULT_LOCATION_ACCURACY,
+    .distanceFilter = options[@"distanceFilter"] ? [RCTConvert double:options[@"distanceFilter"]] : RCT_DEFAULT_LOCATION_ACCURACY,
+    .accuracyFilter = [RCTConvert double:options[@"accuracyFilter"]],
+    .batchInterval = [RCTConvert NSTimeInterval:options[@"batchInterval"]],
   };
 }
 
 @end
 
+static NSDictionary *RCTPositionForLocation(CLLocation *location)
+{
+  return @{
+    @"coords": @{
+      @"latitude": @(location.coordinate.latitude),
+      @"longitude": @(location.coordinate.longitude),
+      @"altitude": @(location.altitude),
+      @"accuracy": @(location.horizontalAccuracy),
+      @"altitudeAccuracy": @(location.verticalAccuracy),
+      @"heading": @(location.course),
+      @"speed": @(location.speed),
+    },
+    // In ms, deferred locations arrive well after they were recorded
+    @"timestamp": @(location.timestamp.timeIntervalSinceReferenceDate * 1000.0)
+  };
+}
+
 static NSDictionary *RCTPositionError(RCTPositionErrorCode code, NSString *msg /* nil for default */)
 {
   if (!msg) {
@@ -103,6 +126,12 @@ static NSDictionary *RCTPositionError(RCTPositionErrorCode code, NSString *msg /
   NSMutableArray *_pendingRequests;
   BOOL _observingLocation;
   RCTLocationOptions _observerOptions;
+
+  // Native filtering and batching of the observed locations
+  CLLocation *_lastObservedLocation;
+  NSMutableArray *_pendingPositions;
+  NSTimer *_batchTimer;
+  BOOL _deferringUpdates;
 }
 
 RCT_EXPORT_MODULE()
@@ -120,12 +149,14 @@ RCT_EXPORT_MODULE()
     _locationManager.delegate = self;
 
     _pendingRequests = [NSMutableArray new];
+    _pendingPositions = [NSMutableArray new];
   }
   return self;
 }
 
 - (void)dealloc
 {
+  [_batchTimer invalidate];
   [_locationManager stopUpdatingLocation];
   _locationManager.delegate = nil;
 }
@@ -148,6 +179,60 @@ RCT_EXPORT_MODULE()
   [_locationManager startUpdatingLocation];
 }
 
+/**
+ * Deferred updates let the GPS hardware collect locations while the app
+ * sleeps, and are only allowed with the best accuracy and no distance filter.
+ * The distance filter is then applied here instead.
+ */
+- (BOOL)canDeferLocationUpdates
+{
+  return _observerOptions.batchInterval > 0 &&
+    _observerOptions.accuracy == kCLLocationAccuracyBest &&
+    [CLLocationManager respondsToSelector:@selector(deferredLocationUpdatesAvailable)] &&
+    [CLLocationManager deferredLocationUpdatesAvailable];
+}
+
+/**
+ * Drops observed locations that are invalid, less accurate than the
+ * accuracyFilter, or closer than the distanceFilter to the last one reported.
+ */
+- (BOOL)shouldReportObservedLocation:(CLLocation *)location
+{
+  if (location.horizontalAccuracy < 0) {
+    return NO;
+  }
+  if (_observerOptions.accuracyFilter > 0 &&
+      location.horizontalAccuracy > _observerOptions.accuracyFilter) {
+    return NO;
+  }
+  if (_lastObservedLocation && _observerOptions.distanceFilter > 0 &&
+      [location distanceFromLocation:_lastObservedLocation] < _observerOptions.distanceFilter) {
+    return NO;
+  }
+  _lastObservedLocation = location;
+  return YES;
+}
+
+- (void)sendPendingPositions
+{
+  [_batchTimer invalidate];
+  _batchTimer = nil;
+
+  if (_pendingPositions.count) {
+    [_bridge.eventDispatcher sendDeviceEventWithName:@"geolocationDidChangeBatch"
+                                                body:[_pendingPositions copy]];
+    [_pendingPositions removeAllObjects];
+  }
+}
+
+- (void)stopDeferringUpdates
+{
+  if (_deferringUpdates) {
+    [_locationManager disallowDeferredLocationUpdates];
+    _deferringUpdates = NO;
+  }
+}
+
 #pragma mark - Timeout handler
 
 - (void)timeout:(NSTimer *)timer
@@ -176,6 +261,9 @@ RCT_EXPORT_METHOD(startObserving:(RCTLocationOptions)options)
   }
 
   _locationManager.desiredAccuracy = _observerOptions.accuracy;
+  _locationManager.distanceFilter = [self canDeferLocationUpdates] ?
+    kCLDistanceFilterNone : _observerOptions.distanceFilter;
+  _lastObservedLocation = nil;
   [self beginLocationUpdates];
   _observingLocation = YES;
 }
@@ -184,6 +272,10 @@ RCT_EXPORT_METHOD(stopObserving)
 {
   // Stop observing
   _observingLocation = NO;
+  [self sendPendingPositions];
+  [self stopDeferringUpdates];
+  _lastObservedLocation = nil;
+  _locationManager.distanceFilter = RCT_DEFAULT_LOCATION_ACCURACY;
 
   // Stop updating if no pending requests
   if (_pendingRequests.count == 0) {
@@ -253,21 +345,28 @@ RCT_EXPORT_METHOD(getCurrentPosition:(RCTLocationOptions)options
 {
   // Create event
   CLLocation *location = locations.lastObject;
-  _lastLocationEvent = @{
-    @"coords": @{
-      @"latitude": @(location.coordinate.latitude),
-      @"longitude": @(location.coordinate.longitude),
-      @"altitude": @(location.altitude),
-      @"accuracy": @(location.horizontalAccuracy),
-      @"altitudeAccuracy": @(location.verticalAccuracy),
-      @"heading": @(location.course),
-      @"speed": @(location.speed),
-    },
-    @"timestamp": @(CFAbsoluteTimeGetCurrent() * 1000.0) // in ms
-  };
-
-  // Send event
-  if (_observingLocation) {
+  _lastLocationEvent = RCTPositionForLocation(location);
+
+  // Send event, or queue the positions for the next batch
+  if (_observingLocation && _observerOptions.batchInterval > 0) {
+    for (CLLocation *observedLocation in locations) {
+      if ([self shouldReportObservedLocation:observedLocation]) {
+        [_pendingPositions addObject:RCTPositionForLocation(observedLocation)];
+      }
+    }
+    if (_pendingPositions.count && !_batchTimer) {
+      _batchTimer = [NSTimer scheduledTimerWithTimeInterval:_observerOptions.batchInterval
+                                                     target:self
+                                                   selector:@selector(sendPendingPositions)
+                                                   userInfo:nil
+                                                    repeats:NO];
+    }
+    if (!_deferringUpdates && [self canDeferLocationUpdates]) {
+      [manager allowDeferredLocationUpdatesUntilTraveled:CLLocationDistanceMax
+                                                 timeout:_observerOptions.batchInterval];
+      _deferringUpdates = YES;
+    }
+  } else if (_observingLocation && [self shouldReportObservedLocation:location]) {
     [_bridge.eventDispatcher sendDeviceEventWithName:@"geolocationDidChange"
                                                 body:_lastLocationEvent];
   }
@@ -288,6 +387,12 @@ RCT_EXPORT_METHOD(getCurrentPosition:(RCTLocationOptions)options
   _locationManager.desiredAccuracy = RCT_DEFAULT_LOCATION_ACCURACY;
 }
 
+- (void)locationManager:(CLLocationManager *)manager didFinishDeferredUpdatesWithError:(NSError *)error
+{
+  // Deferring is asked for again with the next location
+  _deferringUpdates = NO;
+}
+
 - (void)locationManager:(CLLocationManager *)manager didFailWithError:(NSError *)error
 {
   // Check error type
@@ -28,6 +28,8 @@ var requireNativeComponent = require('requireNativeComponent');
 var resolveAssetSource = require('resolveAssetSource');
 var warning = require('warning');
 
+var ImageLoader = NativeModules.ImageLoader;
+
 /**
  * A React component for displaying different types of images,
  * including network images, static resources, temporary local images, and
@@ -139,6 +141,15 @@ var Image = React.createClass({
 
   statics: {
     resizeMode: ImageResizeMode,
+    /**
+     * Loads the image at `uri` ahead of time, so that it displays straight
+     * away once an `<Image>` with the given size shows it. Returns a promise
+     * resolved once the image has been loaded.
+     * @platform ios
+     */
+    prefetch: function(uri: string, size?: {width: number, height: number}) {
+      return ImageLoader.prefetchImage(uri, size || {width: 0, height: 0});
+    },
   },
 
   mixins: [NativeMethodsMixin],
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <ImageIO/ImageIO.h>
+#import <UIKit/UIKit.h>
+
+/**
+ * The frames of an animated image, decoded on demand. Only a small window of
+ * frames from the one currently shown is kept in memory, the following ones
+ * are decoded in the background ahead of time.
+ */
+@interface RCTAnimatedImage : NSObject
+
+/**
+ * Returns nil if the image source has fewer than two frames.
+ */
+- (instancetype)initWithImageSource:(CGImageSourceRef)imageSource NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger frameCount;
+
+/**
+ * How many times the animation plays, 0 means forever.
+ */
+@property (nonatomic, readonly) NSUInteger loopCount;
+
+- (NSTimeInterval)delayAtIndex:(NSUInteger)index;
+
+/**
+ * Returns the frame if it has been decoded already, or nil if it is still
+ * being decoded. Frames outside the window starting at this index are
+ * dropped and the missing ones in it are decoded in the background.
+ * Can be called from any thread.
+ */
+- (UIImage *)frameAtIndex:(NSUInteger)index;
+
+/**
+ * Drops all decoded frames, e.g. when the image is no longer visible.
+ */
+- (void)purgeFrames;
+
+@end
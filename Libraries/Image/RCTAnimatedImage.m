@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTAnimatedImage.h"
+
+#import "RCTDefines.h"
+
+/**
+ * Number of frames kept decoded, starting at the current one.
+ */
+static const NSUInteger RCTAnimatedImageFrameWindow = 4;
+
+static dispatch_queue_t RCTAnimatedImageDecodingQueue(void)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.AnimatedImageDecodingQueue", DISPATCH_QUEUE_SERIAL);
+  });
+  return queue;
+}
+
+@implementation RCTAnimatedImage
+{
+  CGImageSourceRef _imageSource;
+  NSArray<NSNumber *> *_delays;
+  NSLock *_lock;
+  NSMutableDictionary<NSNumber *, UIImage *> *_frames;
+  NSMutableIndexSet *_framesBeingDecoded;
+}
+
+- (instancetype)initWithImageSource:(CGImageSourceRef)imageSource
+{
+  size_t frameCount = imageSource ? CGImageSourceGetCount(imageSource) : 0;
+  if (frameCount < 2) {
+    return nil;
+  }
+
+  if ((self = [super init])) {
+    _imageSource = (CGImageSourceRef)CFRetain(imageSource);
+    _frameCount = frameCount;
+    _lock = [NSLock new];
+    _frames = [NSMutableDictionary new];
+    _framesBeingDecoded = [NSMutableIndexSet new];
+
+    NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyProperties(imageSource, NULL);
+    _loopCount = [properties[(id)kCGImagePropertyGIFDictionary][(id)kCGImagePropertyGIFLoopCount] unsignedIntegerValue];
+
+    NSMutableArray<NSNumber *> *delays = [NSMutableArray arrayWithCapacity:frameCount];
+    for (size_t i = 0; i < frameCount; i++) {
+
+      NSDictionary *frameProperties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(imageSource, i, NULL);
+      NSDictionary *frameGIFProperties = frameProperties[(id)kCGImagePropertyGIFDictionary];
+
+      const NSTimeInterval kDelayTimeIntervalDefault = 0.1;
+      NSNumber *delayTime = frameGIFProperties[(id)kCGImagePropertyGIFUnclampedDelayTime] ?: frameGIFProperties[(id)kCGImagePropertyGIFDelayTime];
+      if (delayTime == nil) {
+        if (i == 0) {
+          delayTime = @(kDelayTimeIntervalDefault);
+        } else {
+          delayTime = delays[i - 1];
+        }
+      }
+
+      const NSTimeInterval kDelayTimeIntervalMinimum = 0.02;
+      if (delayTime.floatValue < (float)kDelayTimeIntervalMinimum - FLT_EPSILON) {
+        delayTime = @(kDelayTimeIntervalDefault);
+      }
+
+      [delays addObject:delayTime];
+    }
+    _delays = delays;
+
+    // The first frame is needed straight away
+    UIImage *firstFrame = [self decodeFrameAtIndex:0];
+    if (firstFrame) {
+      _frames[@0] = firstFrame;
+    }
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (void)dealloc
+{
+  CFRelease(_imageSource);
+}
+
+- (NSTimeInterval)delayAtIndex:(NSUInteger)index
+{
+  return _delays[index].doubleValue;
+}
+
+- (UIImage *)decodeFrameAtIndex:(NSUInteger)index
+{
+  // Decode now rather than when the frame is first drawn
+  NSDictionary *options = @{(id)kCGImageSourceShouldCacheImmediately: @YES};
+  CGImageRef imageRef = CGImageSourceCreateImageAtIndex(_imageSource, index, (__bridge CFDictionaryRef)options);
+  if (!imageRef) {
+    return nil;
+  }
+  UIImage *image = [UIImage imageWithCGImage:imageRef];
+  CGImageRelease(imageRef);
+  return image;
+}
+
+- (UIImage *)frameAtIndex:(NSUInteger)index
+{
+  NSMutableIndexSet *window = [NSMutableIndexSet new];
+  for (NSUInteger i = 0; i < MIN(RCTAnimatedImageFrameWindow, _frameCount); i++) {
+    [window addIndex:(index + i) % _frameCount];
+  }
+
+  [_lock lock];
+
+  UIImage *frame = _frames[@(index)];
+  for (NSNumber *frameIndex in _frames.allKeys) {
+    if (![window containsIndex:frameIndex.unsignedIntegerValue]) {
+      [_frames removeObjectForKey:frameIndex];
+    }
+  }
+
+  NSMutableIndexSet *framesToDecode = [window mutableCopy];
+  [framesToDecode removeIndexes:_framesBeingDecoded];
+  for (NSNumber *frameIndex in _frames) {
+    [framesToDecode removeIndex:frameIndex.unsignedIntegerValue];
+  }
+  [_framesBeingDecoded addIndexes:framesToDecode];
+
+  [_lock unlock];
+
+  [framesToDecode enumerateIndexesUsingBlock:^(NSUInteger frameIndex, __unused BOOL *stop) {
+    dispatch_async(RCTAnimatedImageDecodingQueue(), ^{
+      UIImage *decodedFrame = [self decodeFrameAtIndex:frameIndex];
+
+      [_lock lock];
+      // Skip frames that were purged while being decoded
+      if ([_framesBeingDecoded containsIndex:frameIndex]) {
+        [_framesBeingDecoded removeIndex:frameIndex];
+        if (decodedFrame) {
+          _frames[@(frameIndex)] = decodedFrame;
+        }
+      }
+      [_lock unlock];
+    });
+  }];
+
+  return frame;
+}
+
+- (void)purgeFrames
+{
+  [_lock lock];
+  [_frames removeAllObjects];
+  [_framesBeingDecoded removeAllIndexes];
+  [_lock unlock];
+}
+
+@end
@@ -9,12 +9,58 @@
 
 #import "RCTAssetBundleImageLoader.h"
 
+#import "RCTCache.h"
+#import "RCTMemoryBudget.h"
 #import "RCTUtils.h"
 
+/**
+ * Maximum number of request paths whose image name is remembered, and the
+ * maximum total size in bytes of the images read from files that UIKit
+ * doesn't cache itself.
+ */
+static const NSUInteger RCTAssetBundleImageNameCacheCountLimit = 512;
+static const NSUInteger RCTAssetBundleImageCacheCostLimit = 4 * 1024 * 1024;
+
+static NSUInteger RCTAssetBundleImageCost(UIImage *image)
+{
+  CGImageRef imageRef = image.CGImage;
+  if (imageRef) {
+    return CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+  }
+  // Assume 4 bytes per pixel
+  return image.size.width * image.size.height * image.scale * image.scale * 4;
+}
+
 @implementation RCTAssetBundleImageLoader
+{
+  // Image names by request path, NSNull for paths that can't be loaded
+  RCTCache *_imageNames;
+  RCTCache *_images;
+}
 
 RCT_EXPORT_MODULE()
 
++ (BOOL)isSharedAcrossBridges
+{
+  // Bundle images are the same for every bridge, so are the caches
+  return YES;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _imageNames = [RCTCache new];
+    _imageNames.name = @"AssetBundleImageNames";
+    _imageNames.countLimit = RCTAssetBundleImageNameCacheCountLimit;
+
+    _images = [RCTCache new];
+    _images.name = @"AssetBundleImages";
+    _images.totalCostLimit = RCTAssetBundleImageCacheCostLimit;
+    [[RCTMemoryBudget sharedBudget] registerCache:_images priority:RCTMemoryPriorityLow];
+  }
+  return self;
+}
+
 - (NSString *)imageNameForRequestURL:(NSURL *)requestURL
 {
   if (!requestURL.fileURL) {
@@ -30,24 +76,41 @@ RCT_EXPORT_MODULE()
   return [requestPath substringFromIndex:resourcesPath.length + 1];
 }
 
-- (BOOL)canLoadImageURL:(NSURL *)requestURL
+/**
+ * The bundle is read-only, so whether an image can be loaded only needs to be
+ * looked up once per path.
+ */
+- (NSString *)loadableImageNameForRequestURL:(NSURL *)requestURL
 {
-  NSString *imageName = [self imageNameForRequestURL:requestURL];
-  if (!imageName.length) {
-    return NO;
+  NSString *requestPath = requestURL.absoluteString;
+  if (!requestPath) {
+    return nil;
   }
 
-  if ([[NSBundle mainBundle] URLForResource:imageName withExtension:nil] ||
-      [[NSBundle mainBundle] URLForResource:imageName withExtension:@"png"]) {
-    return YES;
+  id cachedName = _imageNames[requestPath];
+  if (cachedName) {
+    return cachedName == (id)kCFNull ? nil : cachedName;
   }
 
-  return imageName.pathComponents.count == 1 && !imageName.pathExtension.length;
+  NSString *imageName = [self imageNameForRequestURL:requestURL];
+  BOOL canLoad = NO;
+  if (imageName.length) {
+    canLoad = [[NSBundle mainBundle] URLForResource:imageName withExtension:nil] ||
+      [[NSBundle mainBundle] URLForResource:imageName withExtension:@"png"] ||
+      (imageName.pathComponents.count == 1 && !imageName.pathExtension.length);
+  }
+  _imageNames[requestPath] = canLoad ? imageName : (id)kCFNull;
+  return canLoad ? imageName : nil;
+}
+
+- (BOOL)canLoadImageURL:(NSURL *)requestURL
+{
+  return [self loadableImageNameForRequestURL:requestURL] != nil;
 }
 
  - (RCTImageLoaderCancellationBlock)loadImageForURL:(NSURL *)imageURL size:(CGSize)size scale:(CGFloat)scale resizeMode:(UIViewContentMode)resizeMode progressHandler:(RCTImageLoaderProgressBlock)progressHandler completionHandler:(RCTImageLoaderCompletionBlock)completionHandler
 {
-  NSString *imageName = [self imageNameForRequestURL:imageURL];
+  NSString *imageName = [self loadableImageNameForRequestURL:imageURL] ?: [self imageNameForRequestURL:imageURL];
 
   __block BOOL cancelled = NO;
   dispatch_async(dispatch_get_main_queue(), ^{
@@ -55,7 +118,18 @@ RCT_EXPORT_MODULE()
       return;
     }
 
-    UIImage *image = [UIImage imageNamed:imageName];
+    // UIKit caches the images it finds by name. Files it can't find that way
+    // are read directly, and cached here instead.
+    UIImage *image = imageName ? (_images[imageName] ?: [UIImage imageNamed:imageName]) : nil;
+    if (!image && imageName) {
+      NSString *path = [[NSBundle mainBundle] pathForResource:imageName ofType:nil];
+      image = path ? [UIImage imageWithContentsOfFile:path] : nil;
+      if (image) {
+        [_images setObject:image forKey:imageName cost:RCTAssetBundleImageCost(image)];
+        [[RCTMemoryBudget sharedBudget] setNeedsBudgetCheck];
+      }
+    }
+
     if (image) {
       if (progressHandler) {
         progressHandler(1, 1);
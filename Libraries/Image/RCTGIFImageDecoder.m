@@ -11,8 +11,8 @@
 
 #import <ImageIO/ImageIO.h>
 #import <MobileCoreServices/MobileCoreServices.h>
-#import <QuartzCore/QuartzCore.h>
 
+#import "RCTAnimatedImage.h"
 #import "RCTUtils.h"
 
 @implementation RCTGIFImageDecoder
@@ -34,66 +34,21 @@ RCT_EXPORT_MODULE()
                                  completionHandler:(RCTImageLoaderCompletionBlock)completionHandler
 {
   CGImageSourceRef imageSource = CGImageSourceCreateWithData((CFDataRef)imageData, NULL);
-  NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyProperties(imageSource, NULL);
-  NSUInteger loopCount = [properties[(id)kCGImagePropertyGIFDictionary][(id)kCGImagePropertyGIFLoopCount] unsignedIntegerValue];
 
   UIImage *image = nil;
-  size_t imageCount = CGImageSourceGetCount(imageSource);
-  if (imageCount > 1) {
-
-    NSTimeInterval duration = 0;
-    NSMutableArray *delays = [NSMutableArray arrayWithCapacity:imageCount];
-    NSMutableArray *images = [NSMutableArray arrayWithCapacity:imageCount];
-    for (size_t i = 0; i < imageCount; i++) {
-
-      CGImageRef imageRef = CGImageSourceCreateImageAtIndex(imageSource, i, NULL);
-      if (!image) {
-        image = [UIImage imageWithCGImage:imageRef];
-      }
-
-      NSDictionary *frameProperties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(imageSource, i, NULL);
-      NSDictionary *frameGIFProperties = frameProperties[(id)kCGImagePropertyGIFDictionary];
-
-      const NSTimeInterval kDelayTimeIntervalDefault = 0.1;
-      NSNumber *delayTime = frameGIFProperties[(id)kCGImagePropertyGIFUnclampedDelayTime] ?: frameGIFProperties[(id)kCGImagePropertyGIFDelayTime];
-      if (delayTime == nil) {
-        if (i == 0) {
-          delayTime = @(kDelayTimeIntervalDefault);
-        } else {
-          delayTime = delays[i - 1];
-        }
-      }
-
-      const NSTimeInterval kDelayTimeIntervalMinimum = 0.02;
-      if (delayTime.floatValue < (float)kDelayTimeIntervalMinimum - FLT_EPSILON) {
-        delayTime = @(kDelayTimeIntervalDefault);
-      }
-
-      duration += delayTime.doubleValue;
-      delays[i] = delayTime;
-      images[i] = (__bridge_transfer id)imageRef;
+  RCTAnimatedImage *animatedImage = [[RCTAnimatedImage alloc] initWithImageSource:imageSource];
+  if (animatedImage) {
+
+    // The other frames are decoded on demand while the image is animating.
+    // Wrap the first frame again so that the animated image doesn't end up
+    // retaining the image that retains it.
+    UIImage *firstFrame = [animatedImage frameAtIndex:0];
+    if (firstFrame) {
+      image = [UIImage imageWithCGImage:firstFrame.CGImage];
+      image.reactAnimatedImage = animatedImage;
     }
-    CFRelease(imageSource);
 
-    NSMutableArray *keyTimes = [NSMutableArray arrayWithCapacity:delays.count];
-    NSTimeInterval runningDuration = 0;
-    for (NSNumber *delayNumber in delays) {
-      [keyTimes addObject:@(runningDuration / duration)];
-      runningDuration += delayNumber.doubleValue;
-    }
-
-    [keyTimes addObject:@1.0];
-
-    // Create animation
-    CAKeyframeAnimation *animation = [CAKeyframeAnimation animationWithKeyPath:@"contents"];
-    animation.calculationMode = kCAAnimationDiscrete;
-    animation.repeatCount = loopCount == 0 ? HUGE_VALF : loopCount;
-    animation.keyTimes = keyTimes;
-    animation.values = images;
-    animation.duration = duration;
-    image.reactKeyframeAnimation = animation;
-
-  } else {
+  } else if (imageSource) {
 
     // Don't bother creating an animation
     CGImageRef imageRef = CGImageSourceCreateImageAtIndex(imageSource, 0, NULL);
@@ -101,6 +56,9 @@ RCT_EXPORT_MODULE()
       image = [UIImage imageWithCGImage:imageRef];
       CFRelease(imageRef);
     }
+  }
+
+  if (imageSource) {
     CFRelease(imageSource);
   }
 
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A persistent cache of image data, separate from the networking stack's
+ * NSURLCache. Each entry is a file named after the hash of its key, an index
+ * of all entries with their size and last access time is loaded at startup,
+ * and the least recently used entries are removed once the total size of the
+ * cache goes over its limit. All methods are thread safe.
+ */
+@interface RCTImageDiskCache : NSObject
+
+/**
+ * The cache shared by all bridges, in the app's caches directory.
+ */
++ (instancetype)sharedCache;
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                        sizeLimit:(NSUInteger)sizeLimit NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSUInteger sizeLimit;
+@property (nonatomic, readonly) NSUInteger totalSize;
+
+/**
+ * Returns the data stored for the key, memory mapped when possible, or nil.
+ */
+- (NSData *)dataForKey:(NSString *)key;
+
+/**
+ * Stores the data in the background.
+ */
+- (void)setData:(NSData *)data forKey:(NSString *)key;
+
+- (void)removeDataForKey:(NSString *)key;
+- (void)removeAllData;
+
+@end
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTImageDiskCache.h"
+
+#import "RCTDefines.h"
+#import "RCTLog.h"
+#import "RCTUtils.h"
+
+static NSString *const RCTImageDiskCacheIndexFileName = @"index.plist";
+static NSString *const RCTImageDiskCacheSizeKey = @"size";
+static NSString *const RCTImageDiskCacheAccessTimeKey = @"accessTime";
+
+/**
+ * The index is written at most this long after the cache changed.
+ */
+static const NSTimeInterval RCTImageDiskCacheIndexWriteDelay = 1.0;
+
+@implementation RCTImageDiskCache
+{
+  NSString *_directory;
+  dispatch_queue_t _queue;
+
+  // Only accessed on _queue. Maps file names to their size and access time.
+  NSMutableDictionary<NSString *, NSMutableDictionary *> *_index;
+  BOOL _indexWriteScheduled;
+}
+
++ (instancetype)sharedCache
+{
+  static RCTImageDiskCache *sharedCache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    sharedCache = [[RCTImageDiskCache alloc] initWithDirectory:[cachesDirectory stringByAppendingPathComponent:@"React/RCTImageDiskCache"]
+                                                     sizeLimit:200 * 1024 * 1024];
+  });
+  return sharedCache;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory sizeLimit:(NSUInteger)sizeLimit
+{
+  if ((self = [super init])) {
+    _directory = [directory copy];
+    _sizeLimit = sizeLimit;
+    _queue = dispatch_queue_create("com.facebook.React.ImageDiskCacheQueue", DISPATCH_QUEUE_SERIAL);
+
+    dispatch_async(_queue, ^{
+      [self loadIndex];
+    });
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+#pragma mark - Index
+
+- (NSString *)indexPath
+{
+  return [_directory stringByAppendingPathComponent:RCTImageDiskCacheIndexFileName];
+}
+
+- (NSString *)pathForFileName:(NSString *)fileName
+{
+  return [_directory stringByAppendingPathComponent:fileName];
+}
+
+- (void)loadIndex
+{
+  [[NSFileManager defaultManager] createDirectoryAtPath:_directory
+                            withIntermediateDirectories:YES
+                                             attributes:nil
+                                                  error:NULL];
+
+  NSDictionary *index = [NSDictionary dictionaryWithContentsOfFile:[self indexPath]];
+  _index = [NSMutableDictionary dictionaryWithCapacity:index.count];
+  _totalSize = 0;
+  for (NSString *fileName in index) {
+    NSMutableDictionary *entry = [index[fileName] mutableCopy];
+    _index[fileName] = entry;
+    _totalSize += [entry[RCTImageDiskCacheSizeKey] unsignedIntegerValue];
+  }
+
+  // Remove files that are missing from the index, e.g. after a crash
+  for (NSString *fileName in [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directory error:NULL]) {
+    if (!_index[fileName] && ![fileName isEqualToString:RCTImageDiskCacheIndexFileName]) {
+      [[NSFileManager defaultManager] removeItemAtPath:[self pathForFileName:fileName] error:NULL];
+    }
+  }
+}
+
+- (void)scheduleIndexWrite
+{
+  if (_indexWriteScheduled) {
+    return;
+  }
+
+  _indexWriteScheduled = YES;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(RCTImageDiskCacheIndexWriteDelay * NSEC_PER_SEC)), _queue, ^{
+    _indexWriteScheduled = NO;
+    if (![_index writeToFile:[self indexPath] atomically:YES]) {
+      RCTLogWarn(@"Failed to write the image disk cache index to %@", [self indexPath]);
+    }
+  });
+}
+
+- (void)removeFileName:(NSString *)fileName
+{
+  NSDictionary *entry = _index[fileName];
+  if (entry) {
+    _totalSize -= [entry[RCTImageDiskCacheSizeKey] unsignedIntegerValue];
+    [_index removeObjectForKey:fileName];
+    [[NSFileManager defaultManager] removeItemAtPath:[self pathForFileName:fileName] error:NULL];
+  }
+}
+
+- (void)evictIfNeeded
+{
+  if (_totalSize <= _sizeLimit) {
+    return;
+  }
+
+  // Least recently used first
+  NSArray<NSString *> *fileNames = [_index keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+    return [a[RCTImageDiskCacheAccessTimeKey] compare:b[RCTImageDiskCacheAccessTimeKey]];
+  }];
+  for (NSString *fileName in fileNames) {
+    if (_totalSize <= _sizeLimit) {
+      break;
+    }
+    [self removeFileName:fileName];
+  }
+}
+
+#pragma mark - Public API
+
+- (NSData *)dataForKey:(NSString *)key
+{
+  NSString *fileName = RCTMD5Hash(key);
+  __block NSData *data = nil;
+  dispatch_sync(_queue, ^{
+    NSMutableDictionary *entry = _index[fileName];
+    if (!entry) {
+      return;
+    }
+
+    data = [NSData dataWithContentsOfFile:[self pathForFileName:fileName]
+                                  options:NSDataReadingMappedIfSafe
+                                    error:NULL];
+    if (data) {
+      entry[RCTImageDiskCacheAccessTimeKey] = @(CFAbsoluteTimeGetCurrent());
+    } else {
+      [self removeFileName:fileName];
+    }
+    [self scheduleIndexWrite];
+  });
+  return data;
+}
+
+- (void)setData:(NSData *)data forKey:(NSString *)key
+{
+  if (!data || data.length > _sizeLimit) {
+    return;
+  }
+
+  NSString *fileName = RCTMD5Hash(key);
+  dispatch_async(_queue, ^{
+    [self removeFileName:fileName];
+    if (![data writeToFile:[self pathForFileName:fileName] atomically:YES]) {
+      return;
+    }
+
+    _index[fileName] = [@{
+      RCTImageDiskCacheSizeKey: @(data.length),
+      RCTImageDiskCacheAccessTimeKey: @(CFAbsoluteTimeGetCurrent()),
+    } mutableCopy];
+    _totalSize += data.length;
+    [self evictIfNeeded];
+    [self scheduleIndexWrite];
+  });
+}
+
+- (void)removeDataForKey:(NSString *)key
+{
+  NSString *fileName = RCTMD5Hash(key);
+  dispatch_async(_queue, ^{
+    [self removeFileName:fileName];
+    [self scheduleIndexWrite];
+  });
+}
+
+- (void)removeAllData
+{
+  dispatch_async(_queue, ^{
+    for (NSString *fileName in _index.allKeys) {
+      [self removeFileName:fileName];
+    }
+    [self scheduleIndexWrite];
+  });
+}
+
+@end
@@ -9,16 +9,140 @@
 
 #import "RCTImageDownloader.h"
 
+#import <ImageIO/ImageIO.h>
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTImageDiskCache.h"
 #import "RCTImageLoader.h"
 #import "RCTImageUtils.h"
 #import "RCTLog.h"
 #import "RCTNetworking.h"
 #import "RCTUtils.h"
 
+/**
+ * One caller waiting for a download, see RCTPendingImageDownload.
+ */
+@interface RCTImageDownloadWaiter : NSObject
+
+@property (nonatomic, copy) RCTImageLoaderProgressBlock progressBlock;
+@property (nonatomic, copy) RCTImageLoaderPartialLoadBlock partialLoadBlock;
+@property (nonatomic, copy) void (^completionBlock)(NSError *error, NSData *data);
+
+@end
+
+@implementation RCTImageDownloadWaiter
+
+@end
+
+/**
+ * Partial images are decoded at most this often while downloading, as each
+ * one decodes everything received so far.
+ */
+static const NSTimeInterval RCTPartialImageMinimumInterval = 0.1;
+
+/**
+ * A network task shared by everyone downloading the same URL at the same
+ * time. The task is cancelled once the last of its waiters has cancelled.
+ */
+@interface RCTPendingImageDownload : NSObject
+
+@property (nonatomic, strong) RCTDownloadTask *task;
+@property (nonatomic, readonly) NSMutableArray<RCTImageDownloadWaiter *> *waiters;
+
+/**
+ * Starts decoding the data as it arrives. Has to be called before any data
+ * was received.
+ */
+- (void)enablePartialImages;
+
+/**
+ * Appends the data to the incremental image source, and returns an image of
+ * what could be decoded so far, or nil if there is nothing new to show yet.
+ */
+- (UIImage *)partialImageByAppendingData:(NSData *)data;
+
+@end
+
+@implementation RCTPendingImageDownload
+{
+  CGImageSourceRef _imageSource;
+  NSMutableData *_partialData;
+  CFTimeInterval _lastPartialImageTime;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _waiters = [NSMutableArray new];
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  if (_imageSource) {
+    CFRelease(_imageSource);
+  }
+}
+
+- (void)enablePartialImages
+{
+  if (!_imageSource) {
+    _imageSource = CGImageSourceCreateIncremental(NULL);
+    _partialData = [NSMutableData new];
+  }
+}
+
+- (UIImage *)partialImageByAppendingData:(NSData *)data
+{
+  if (!_imageSource) {
+    return nil;
+  }
+
+  [_partialData appendData:data];
+  CFTimeInterval now = CACurrentMediaTime();
+  if (now - _lastPartialImageTime < RCTPartialImageMinimumInterval) {
+    return nil;
+  }
+
+  CGImageSourceUpdateData(_imageSource, (__bridge CFDataRef)_partialData, false);
+  CGImageSourceStatus status = CGImageSourceGetStatusAtIndex(_imageSource, 0);
+  if (status != kCGImageStatusIncomplete && status != kCGImageStatusComplete) {
+    return nil;
+  }
+
+  CGImageRef imageRef = CGImageSourceCreateImageAtIndex(_imageSource, 0, NULL);
+  if (!imageRef) {
+    return nil;
+  }
+
+  _lastPartialImageTime = now;
+  UIImage *image = [UIImage imageWithCGImage:imageRef];
+  CGImageRelease(imageRef);
+  return image;
+}
+
+@end
+
+/**
+ * Downloaded images at least this large are also stored resized to the size
+ * they were displayed at, which is faster to decode next time.
+ */
+static const NSUInteger RCTResizedImageMinimumSourceLength = 256 * 1024;
+
+static NSString *RCTResizedImageDiskCacheKey(NSURL *imageURL, CGSize size, CGFloat scale, UIViewContentMode resizeMode)
+{
+  return [NSString stringWithFormat:@"%@|%g|%g|%g|%zd",
+          imageURL.absoluteString, size.width, size.height, scale, resizeMode];
+}
+
 @implementation RCTImageDownloader
 {
-  NSURLCache *_cache;
+  RCTImageDiskCache *_diskCache;
   dispatch_queue_t _processingQueue;
+
+  // Only accessed on _processingQueue
+  NSMutableDictionary<NSURL *, RCTPendingImageDownload *> *_pendingDownloads;
 }
 
 @synthesize bridge = _bridge;
@@ -28,8 +152,9 @@ RCT_EXPORT_MODULE()
 - (instancetype)init
 {
   if ((self = [super init])) {
-    _cache = [[NSURLCache alloc] initWithMemoryCapacity:5 * 1024 * 1024 diskCapacity:200 * 1024 * 1024 diskPath:@"React/RCTImageDownloader"];
+    _diskCache = [RCTImageDiskCache sharedCache];
     _processingQueue = dispatch_queue_create("com.facebook.React.DownloadProcessingQueue", DISPATCH_QUEUE_SERIAL);
+    _pendingDownloads = [NSMutableDictionary new];
   }
   return self;
 }
@@ -43,13 +168,33 @@ RCT_EXPORT_MODULE()
     [requestURL.scheme caseInsensitiveCompare:@"data"] == NSOrderedSame;
 }
 
+/**
+ * Turns non-200 HTTP responses into errors.
+ */
+static NSError *RCTImageDownloadError(NSURLResponse *response, NSError *error)
+{
+  if (!error && [response isKindOfClass:[NSHTTPURLResponse class]]) {
+    NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+    if (httpResponse.statusCode != 200) {
+      error = [[NSError alloc] initWithDomain:NSURLErrorDomain
+                                         code:httpResponse.statusCode
+                                     userInfo:nil];
+    }
+  }
+  return error;
+}
+
 /**
  * Downloads a block of raw data and returns it. Note that the callback block
  * will not be executed on the same thread you called the method from, nor on
  * the main thread. Returns a token that can be used to cancel the download.
+ *
+ * Concurrent downloads of the same URL share a single network task, which is
+ * only cancelled once every caller has cancelled.
  */
 - (RCTImageLoaderCancellationBlock)downloadDataForURL:(NSURL *)url
                                       progressHandler:(RCTImageLoaderProgressBlock)progressBlock
+                                   partialLoadHandler:(RCTImageLoaderPartialLoadBlock)partialLoadBlock
                                     completionHandler:(void (^)(NSError *error, NSData *data))completionBlock
 {
   if (![_bridge respondsToSelector:NSSelectorFromString(@"networking")]) {
@@ -57,45 +202,137 @@ RCT_EXPORT_MODULE()
     return ^{};
   }
 
+  NSURLRequest *request = [NSURLRequest requestWithURL:url];
+  RCTImageDownloadWaiter *waiter = [RCTImageDownloadWaiter new];
+  waiter.progressBlock = progressBlock;
+  waiter.partialLoadBlock = partialLoadBlock;
+  waiter.completionBlock = completionBlock;
+
   __weak RCTImageDownloader *weakSelf = self;
-  RCTURLRequestCompletionBlock runBlocks = ^(NSURLResponse *response, NSData *data, NSError *error) {
-
-    if (!error && [response isKindOfClass:[NSHTTPURLResponse class]]) {
-      NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
-      if (httpResponse.statusCode != 200) {
-        data = nil;
-        error = [[NSError alloc] initWithDomain:NSURLErrorDomain
-                                           code:httpResponse.statusCode
-                                       userInfo:nil];
+  dispatch_async(_processingQueue, ^{
+    RCTImageDownloader *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+
+    RCTPendingImageDownload *download = strongSelf->_pendingDownloads[url];
+    if (!download) {
+      NSData *cachedData = [strongSelf->_diskCache dataForKey:url.absoluteString];
+      if (cachedData) {
+        completionBlock(nil, cachedData);
+        return;
       }
+
+      // Only downloads that start out with someone interested in partial
+      // images decode them; those joining later get the remaining ones.
+      download = [strongSelf startDownloadForRequest:request
+                                 decodePartialImages:partialLoadBlock != nil];
+      strongSelf->_pendingDownloads[url] = download;
     }
+    [download.waiters addObject:waiter];
+  });
 
+  return ^{
     dispatch_async(_processingQueue, ^{
-      completionBlock(error, data);
+      RCTImageDownloader *strongSelf = weakSelf;
+      RCTPendingImageDownload *download = strongSelf->_pendingDownloads[url];
+      if (![download.waiters containsObject:waiter]) {
+        return;
+      }
+
+      [download.waiters removeObjectIdenticalTo:waiter];
+      if (download.waiters.count == 0) {
+        [download.task cancel];
+        [strongSelf->_pendingDownloads removeObjectForKey:url];
+      }
     });
   };
+}
 
-  NSURLRequest *request = [NSURLRequest requestWithURL:url];
-  {
-    NSCachedURLResponse *cachedResponse = [_cache cachedResponseForRequest:request];
-    if (cachedResponse) {
-      runBlocks(cachedResponse.response, cachedResponse.data, nil);
-      return ^{};
-    }
+/**
+ * Starts the network task for a new pending download. Its progress, partial
+ * images and completion are forwarded on _processingQueue to whoever is
+ * waiting then.
+ */
+- (RCTPendingImageDownload *)startDownloadForRequest:(NSURLRequest *)request
+                                 decodePartialImages:(BOOL)decodePartialImages
+{
+  RCTPendingImageDownload *download = [RCTPendingImageDownload new];
+  if (decodePartialImages) {
+    [download enablePartialImages];
   }
+  __weak RCTPendingImageDownload *weakDownload = download;
+  __weak RCTImageDownloader *weakSelf = self;
+  dispatch_queue_t processingQueue = _processingQueue;
 
-  RCTDownloadTask *task = [_bridge.networking downloadTaskWithRequest:request completionBlock:^(NSURLResponse *response, NSData *data, NSError *error) {
-    if (response && !error) {
+  download.task = [_bridge.networking downloadTaskWithRequest:request completionBlock:^(NSURLResponse *response, NSData *data, NSError *error) {
+    dispatch_async(processingQueue, ^{
       RCTImageDownloader *strongSelf = weakSelf;
-      NSCachedURLResponse *cachedResponse = [[NSCachedURLResponse alloc] initWithResponse:response data:data userInfo:nil storagePolicy:NSURLCacheStorageAllowed];
-      [strongSelf->_cache storeCachedResponse:cachedResponse forRequest:request];
-    }
-    runBlocks(response, data, error);
+      RCTPendingImageDownload *strongDownload = weakDownload;
+      if (!strongSelf || !strongDownload) {
+        return;
+      }
+
+      if (strongSelf->_pendingDownloads[request.URL] == strongDownload) {
+        [strongSelf->_pendingDownloads removeObjectForKey:request.URL];
+      }
+
+      NSError *downloadError = RCTImageDownloadError(response, error);
+      NSData *downloadData = downloadError ? nil : data;
+      if (downloadData) {
+        [strongSelf->_diskCache setData:downloadData forKey:request.URL.absoluteString];
+      }
+      for (RCTImageDownloadWaiter *waiter in strongDownload.waiters) {
+        waiter.completionBlock(downloadError, downloadData);
+      }
+      [strongDownload.waiters removeAllObjects];
+    });
   }];
-  if (progressBlock) {
-    task.downloadProgressBlock = progressBlock;
+
+  if (decodePartialImages) {
+    download.task.incrementalDataBlock = ^(NSData *data) {
+      dispatch_async(processingQueue, ^{
+        RCTPendingImageDownload *strongDownload = weakDownload;
+        UIImage *partialImage = [strongDownload partialImageByAppendingData:data];
+        if (!partialImage) {
+          return;
+        }
+        for (RCTImageDownloadWaiter *waiter in strongDownload.waiters) {
+          if (waiter.partialLoadBlock) {
+            waiter.partialLoadBlock(partialImage);
+          }
+        }
+      });
+    };
   }
-  return ^{ [task cancel]; };
+
+  download.task.downloadProgressBlock = ^(int64_t progress, int64_t total) {
+    dispatch_async(processingQueue, ^{
+      for (RCTImageDownloadWaiter *waiter in weakDownload.waiters) {
+        if (waiter.progressBlock) {
+          waiter.progressBlock(progress, total);
+        }
+      }
+    });
+  };
+
+  return download;
+}
+
+- (RCTImageLoaderCancellationBlock)loadImageForURL:(NSURL *)imageURL
+                                              size:(CGSize)size
+                                             scale:(CGFloat)scale
+                                        resizeMode:(UIViewContentMode)resizeMode
+                                   progressHandler:(RCTImageLoaderProgressBlock)progressHandler
+                                 completionHandler:(RCTImageLoaderCompletionBlock)completionHandler
+{
+  return [self loadImageForURL:imageURL
+                          size:size
+                         scale:scale
+                    resizeMode:resizeMode
+               progressHandler:progressHandler
+            partialLoadHandler:nil
+             completionHandler:completionHandler];
 }
 
 - (RCTImageLoaderCancellationBlock)loadImageForURL:(NSURL *)imageURL
@@ -103,22 +340,60 @@ RCT_EXPORT_MODULE()
                                              scale:(CGFloat)scale
                                         resizeMode:(UIViewContentMode)resizeMode
                                    progressHandler:(RCTImageLoaderProgressBlock)progressHandler
+                                partialLoadHandler:(RCTImageLoaderPartialLoadBlock)partialLoadHandler
                                  completionHandler:(RCTImageLoaderCompletionBlock)completionHandler
 {
   if ([imageURL.scheme.lowercaseString hasPrefix:@"http"]) {
+    __block BOOL cancelled = NO;
+    __block RCTImageLoaderCancellationBlock downloadCancel = nil;
     __block RCTImageLoaderCancellationBlock decodeCancel = nil;
 
     __weak RCTImageDownloader *weakSelf = self;
-    RCTImageLoaderCancellationBlock downloadCancel = [self downloadDataForURL:imageURL progressHandler:progressHandler completionHandler:^(NSError *error, NSData *imageData) {
-      if (error) {
-        completionHandler(error, nil);
-      } else {
-        decodeCancel = [weakSelf.bridge.imageLoader decodeImageData:imageData size:size scale:scale resizeMode:resizeMode completionBlock:completionHandler];
+    RCTImageDiskCache *diskCache = _diskCache;
+    NSString *resizedKey = CGSizeEqualToSize(size, CGSizeZero) ? nil : RCTResizedImageDiskCacheKey(imageURL, size, scale, resizeMode);
+    dispatch_async(_processingQueue, ^{
+      if (cancelled) {
+        return;
       }
-    }];
+
+      // A copy stored at this size doesn't need to be downloaded or resized
+      NSData *resizedData = resizedKey ? [diskCache dataForKey:resizedKey] : nil;
+      UIImage *resizedImage = resizedData ? RCTDecodeImageWithData(resizedData, size, scale, resizeMode) : nil;
+      if (resizedImage) {
+        completionHandler(nil, resizedImage);
+        return;
+      }
+
+      downloadCancel = [weakSelf downloadDataForURL:imageURL progressHandler:progressHandler partialLoadHandler:partialLoadHandler completionHandler:^(NSError *error, NSData *imageData) {
+        if (error) {
+          completionHandler(error, nil);
+          return;
+        }
+
+        decodeCancel = [weakSelf.bridge.imageLoader decodeImageData:imageData size:size scale:scale resizeMode:resizeMode completionBlock:^(NSError *decodeError, UIImage *image) {
+          if (resizedKey && image && imageData.length >= RCTResizedImageMinimumSourceLength &&
+              !image.reactKeyframeAnimation && !image.reactAnimatedImage) {
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+              NSData *resizedImageData = RCTImageHasAlpha(image.CGImage) ?
+                UIImagePNGRepresentation(image) :
+                UIImageJPEGRepresentation(image, 0.9);
+              if (resizedImageData.length < imageData.length) {
+                [diskCache setData:resizedImageData forKey:resizedKey];
+              }
+            });
+          }
+          completionHandler(decodeError, image);
+        }];
+      }];
+    });
 
     return ^{
-      downloadCancel();
+      dispatch_async(_processingQueue, ^{
+        cancelled = YES;
+        if (downloadCancel) {
+          downloadCancel();
+        }
+      });
 
       if (decodeCancel) {
         decodeCancel();
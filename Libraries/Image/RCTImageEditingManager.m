@@ -9,6 +9,7 @@
 
 #import "RCTImageEditingManager.h"
 
+#import <ImageIO/ImageIO.h>
 #import <UIKit/UIKit.h>
 
 #import "RCTConvert.h"
@@ -18,11 +19,153 @@
 #import "RCTImageStoreManager.h"
 #import "RCTImageLoader.h"
 
+/**
+ * The size the crop is drawn at within the display size, as CSS contain and
+ * cover would, or stretched. Crops are never scaled up.
+ * http://blog.vjeux.com/2013/image/css-container-and-cover.html
+ */
+static CGSize RCTScaledCropSize(CGSize cropSize, CGSize targetSize, NSString *resizeMode)
+{
+  CGFloat imageRatio = cropSize.width / cropSize.height;
+  CGFloat targetRatio = targetSize.width / targetSize.height;
+
+  CGFloat newWidth = targetSize.width;
+  CGFloat newHeight = targetSize.height;
+
+  if ([resizeMode isEqualToString:@"contain"]) {
+    if (imageRatio <= targetRatio) {
+      newWidth = targetSize.height * imageRatio;
+      newHeight = targetSize.height;
+    } else {
+      newWidth = targetSize.width;
+      newHeight = targetSize.width / imageRatio;
+    }
+  } else if ([resizeMode isEqualToString:@"cover"]) {
+    if (imageRatio <= targetRatio) {
+      newWidth = targetSize.width;
+      newHeight = targetSize.width / imageRatio;
+    } else {
+      newWidth = targetSize.height * imageRatio;
+      newHeight = targetSize.height;
+    }
+  } // else assume we're stretching the image
+
+  return (CGSize){MIN(newWidth, cropSize.width), MIN(newHeight, cropSize.height)};
+}
+
+/**
+ * Copies the part of imageRef in cropRect into a new bitmap of canvasSize,
+ * drawn at drawSize from its top left corner. imageRef may be a scaled down
+ * version of an image of imageSize, which cropRect is relative to. All sizes
+ * are in px.
+ */
+static UIImage *RCTCropImage(CGImageRef imageRef, CGSize imageSize, CGRect cropRect,
+                             CGSize canvasSize, CGSize drawSize)
+{
+  CGRect visibleRect = CGRectIntersection(cropRect, (CGRect){CGPointZero, imageSize});
+  if (CGRectIsEmpty(visibleRect) || canvasSize.width < 1 || canvasSize.height < 1) {
+    return nil;
+  }
+
+  // The scaled down image is rounded to whole pixels, so use its actual scale
+  CGFloat imageScaleX = CGImageGetWidth(imageRef) / imageSize.width;
+  CGFloat imageScaleY = CGImageGetHeight(imageRef) / imageSize.height;
+  CGRect scaledRect = CGRectIntegral((CGRect){
+    {visibleRect.origin.x * imageScaleX, visibleRect.origin.y * imageScaleY},
+    {visibleRect.size.width * imageScaleX, visibleRect.size.height * imageScaleY},
+  });
+  CGImageRef croppedRef = CGImageCreateWithImageInRect(imageRef, scaledRect);
+  if (!croppedRef) {
+    return nil;
+  }
+
+  // Parts of the crop outside of the image are left transparent
+  CGFloat drawScaleX = drawSize.width / cropRect.size.width;
+  CGFloat drawScaleY = drawSize.height / cropRect.size.height;
+  CGRect drawRect = {
+    {(visibleRect.origin.x - cropRect.origin.x) * drawScaleX, (visibleRect.origin.y - cropRect.origin.y) * drawScaleY},
+    {visibleRect.size.width * drawScaleX, visibleRect.size.height * drawScaleY},
+  };
+  BOOL opaque = !RCTImageHasAlpha(croppedRef) &&
+    CGRectContainsRect(drawRect, (CGRect){CGPointZero, canvasSize});
+
+  // The crop is copied out, so the bitmap it was cut from can be released
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(NULL, canvasSize.width, canvasSize.height, 8, 0, colorSpace,
+    kCGBitmapByteOrder32Big | (opaque ? kCGImageAlphaNoneSkipLast : kCGImageAlphaPremultipliedLast));
+  CGColorSpaceRelease(colorSpace);
+  if (!context) {
+    CGImageRelease(croppedRef);
+    return nil;
+  }
+  CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+  CGContextDrawImage(context, (CGRect){
+    {drawRect.origin.x, canvasSize.height - drawRect.origin.y - drawRect.size.height},
+    drawRect.size
+  }, croppedRef);
+  CGImageRelease(croppedRef);
+
+  CGImageRef resultRef = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+  UIImage *result = resultRef ? [UIImage imageWithCGImage:resultRef] : nil;
+  CGImageRelease(resultRef);
+  return result;
+}
+
+/**
+ * Crops straight from the encoded data. When the crop is scaled down for
+ * display, ImageIO decodes the image at the reduced size, so no pixels are
+ * decoded at full resolution.
+ */
+static UIImage *RCTCropImageData(NSData *data, CGRect cropRect, CGSize canvasSize, CGSize drawSize)
+{
+  CGImageSourceRef sourceRef = CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL);
+  if (!sourceRef) {
+    return nil;
+  }
+
+  NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(sourceRef, 0, NULL);
+  CGSize imageSize = {
+    [properties[(id)kCGImagePropertyPixelWidth] doubleValue],
+    [properties[(id)kCGImagePropertyPixelHeight] doubleValue]
+  };
+  if ([properties[(id)kCGImagePropertyOrientation] integerValue] >= 5) {
+    // The image is rotated by 90 degrees when displayed
+    imageSize = (CGSize){imageSize.height, imageSize.width};
+  }
+  if (imageSize.width < 1 || imageSize.height < 1) {
+    CFRelease(sourceRef);
+    return nil;
+  }
+
+  CGFloat scale = MIN(1, MAX(drawSize.width / cropRect.size.width, drawSize.height / cropRect.size.height));
+  NSDictionary *options = @{
+    (id)kCGImageSourceCreateThumbnailWithTransform: @YES,
+    (id)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+    (id)kCGImageSourceThumbnailMaxPixelSize: @(ceil(MAX(imageSize.width, imageSize.height) * scale)),
+  };
+  CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(sourceRef, 0, (__bridge CFDictionaryRef)options);
+  CFRelease(sourceRef);
+  if (!imageRef) {
+    return nil;
+  }
+
+  UIImage *result = RCTCropImage(imageRef, imageSize, cropRect, canvasSize, drawSize);
+  CGImageRelease(imageRef);
+  return result;
+}
+
 @implementation RCTImageEditingManager
 
 RCT_EXPORT_MODULE()
 
 @synthesize bridge = _bridge;
+@synthesize methodQueue = _methodQueue;
+
++ (RCTMethodQueuePriority)methodQueuePriority
+{
+  return RCTMethodQueuePriorityUtility;
+}
 
 /**
  * Crops an image and adds the result to the image store.
@@ -33,6 +176,9 @@ RCT_EXPORT_MODULE()
  *        `displaySize` is an optimization - if specified, the image will
  *        be scaled down to `displaySize` rather than `size`.
  *        All units are in px (not points).
+ *
+ * The crop is done on the method queue, from the encoded data for local files
+ * and data URIs, and from the loaded image for everything else.
  */
 RCT_EXPORT_METHOD(cropImage:(NSString *)imageTag
                   cropData:(NSDictionary *)cropData
@@ -51,28 +197,27 @@ RCT_EXPORT_METHOD(cropImage:(NSString *)imageTag
     return;
   }
 
-  [_bridge.imageLoader loadImageWithTag:imageTag callback:^(NSError *error, UIImage *image) {
-    if (error) {
-      errorCallback(error);
-      return;
-    }
-    CGRect rect = (CGRect){
-      [RCTConvert CGPoint:offset],
-      [RCTConvert CGSize:size]
-    };
-
-    // Crop image
-    CGRect rectToDrawIn = {{-rect.origin.x, -rect.origin.y}, image.size};
-    UIGraphicsBeginImageContextWithOptions(rect.size, !RCTImageHasAlpha(image.CGImage), image.scale);
-    [image drawInRect:rectToDrawIn];
-    UIImage *croppedImage = UIGraphicsGetImageFromCurrentImageContext();
-    UIGraphicsEndImageContext();
-
-    if (displaySize && displaySize[@"width"] && displaySize[@"height"]) {
-      CGSize targetSize = [RCTConvert CGSize:displaySize];
-      croppedImage = [self scaleImage:croppedImage targetSize:targetSize resizeMode:resizeMode];
+  CGRect rect = (CGRect){
+    [RCTConvert CGPoint:offset],
+    [RCTConvert CGSize:size]
+  };
+  CGSize canvasSize = rect.size;
+  CGSize drawSize = rect.size;
+  if (displaySize && displaySize[@"width"] && displaySize[@"height"]) {
+    CGSize targetSize = [RCTConvert CGSize:displaySize];
+    if (!CGSizeEqualToSize(rect.size, targetSize)) {
+      canvasSize = targetSize;
+      drawSize = RCTScaledCropSize(rect.size, targetSize, resizeMode);
     }
+  }
 
+  void (^storeImage)(UIImage *) = ^(UIImage *croppedImage) {
+    if (!croppedImage) {
+      NSString *errorMessage = [NSString stringWithFormat:@"Failed to crop image %@", imageTag];
+      RCTLogWarn(@"%@", errorMessage);
+      errorCallback(RCTErrorWithMessage(errorMessage));
+      return;
+    }
     [_bridge.imageStoreManager storeImage:croppedImage withBlock:^(NSString *croppedImageTag) {
       if (!croppedImageTag) {
         NSString *errorMessage = @"Error storing cropped image in RCTImageStoreManager";
@@ -82,52 +227,41 @@ RCT_EXPORT_METHOD(cropImage:(NSString *)imageTag
       }
       successCallback(@[croppedImageTag]);
     }];
-  }];
-}
+  };
 
-- (UIImage *)scaleImage:(UIImage *)image targetSize:(CGSize)targetSize resizeMode:(NSString *)resizeMode
-{
-  if (CGSizeEqualToSize(image.size, targetSize)) {
-    return image;
+  NSURL *imageURL = [RCTConvert NSURL:imageTag];
+  if (imageURL.fileURL || [imageURL.scheme.lowercaseString isEqualToString:@"data"]) {
+    NSData *data = [NSData dataWithContentsOfURL:imageURL options:NSDataReadingMappedIfSafe error:NULL];
+    UIImage *croppedImage = data ? RCTCropImageData(data, rect, canvasSize, drawSize) : nil;
+    if (croppedImage) {
+      storeImage(croppedImage);
+      return;
+    }
+    // Formats ImageIO can't read may still have a decoder in the image loader
   }
 
-  CGFloat imageRatio = image.size.width / image.size.height;
-  CGFloat targetRatio = targetSize.width / targetSize.height;
-
-  CGFloat newWidth = targetSize.width;
-  CGFloat newHeight = targetSize.height;
-
-  // contain vs cover
-  // http://blog.vjeux.com/2013/image/css-container-and-cover.html
-  if ([resizeMode isEqualToString:@"contain"]) {
-    if (imageRatio <= targetRatio) {
-      newWidth = targetSize.height * imageRatio;
-      newHeight = targetSize.height;
-    } else {
-      newWidth = targetSize.width;
-      newHeight = targetSize.width / imageRatio;
-    }
-  } else if ([resizeMode isEqualToString:@"cover"]) {
-    if (imageRatio <= targetRatio) {
-      newWidth = targetSize.width;
-      newHeight = targetSize.width / imageRatio;
-    } else {
-      newWidth = targetSize.height * imageRatio;
-      newHeight = targetSize.height;
+  [_bridge.imageLoader loadImageWithTag:imageTag callback:^(NSError *error, UIImage *image) {
+    if (error) {
+      errorCallback(error);
+      return;
     }
-  } // else assume we're stretching the image
-
-  // prevent upscaling
-  newWidth = MIN(newWidth, image.size.width);
-  newHeight = MIN(newHeight, image.size.height);
+    dispatch_async(_methodQueue, ^{
+      @autoreleasepool {
+        UIImage *uprightImage = image;
+        if (image.imageOrientation != UIImageOrientationUp) {
+          // Draw it upright first, so the crop rect applies to what is displayed
+          UIGraphicsBeginImageContextWithOptions(image.size, !RCTImageHasAlpha(image.CGImage), image.scale);
+          [image drawAtPoint:CGPointZero];
+          uprightImage = UIGraphicsGetImageFromCurrentImageContext();
+          UIGraphicsEndImageContext();
+        }
 
-  // perform the scaling @1x because targetSize is in actual pixel width/height
-  UIGraphicsBeginImageContextWithOptions(targetSize, NO, 1.0f);
-  [image drawInRect:CGRectMake(0.f, 0.f, newWidth, newHeight)];
-  UIImage *scaledImage = UIGraphicsGetImageFromCurrentImageContext();
-  UIGraphicsEndImageContext();
-
-  return scaledImage;
+        CGImageRef imageRef = uprightImage.CGImage;
+        CGSize imageSize = {CGImageGetWidth(imageRef), CGImageGetHeight(imageRef)};
+        storeImage(imageRef ? RCTCropImage(imageRef, imageSize, rect, canvasSize, drawSize) : nil);
+      }
+    });
+  }];
 }
 
 @end
@@ -13,15 +13,33 @@
 #import "RCTURLRequestHandler.h"
 
 @class ALAssetsLibrary;
+@class RCTAnimatedImage;
 
 typedef void (^RCTImageLoaderProgressBlock)(int64_t progress, int64_t total);
+typedef void (^RCTImageLoaderPartialLoadBlock)(UIImage *image);
 typedef void (^RCTImageLoaderCompletionBlock)(NSError *error, UIImage *image);
 typedef void (^RCTImageLoaderCancellationBlock)(void);
 
+/**
+ * When more images are requested than can be loaded at once, those with a
+ * higher priority are loaded first.
+ */
+typedef NS_ENUM(NSInteger, RCTImageLoaderPriority) {
+  RCTImageLoaderPriorityOffscreen = 0,
+  RCTImageLoaderPriorityPrefetch,
+  RCTImageLoaderPriorityVisible,
+};
+
 @interface UIImage (React)
 
 @property (nonatomic, copy) CAKeyframeAnimation *reactKeyframeAnimation;
 
+/**
+ * Set by decoders of animated images whose frames are decoded on demand.
+ * The image itself is the first frame.
+ */
+@property (nonatomic, strong) RCTAnimatedImage *reactAnimatedImage;
+
 @end
 
 @interface RCTImageLoader : NSObject <RCTBridgeModule, RCTURLRequestHandler>
@@ -44,6 +62,32 @@ typedef void (^RCTImageLoaderCancellationBlock)(void);
                                       progressBlock:(RCTImageLoaderProgressBlock)progressBlock
                                     completionBlock:(RCTImageLoaderCompletionBlock)completionBlock;
 
+/**
+ * As above, but also calls partialLoadBlock on the main thread with lower
+ * quality versions of the image while it is still loading, if the URL loader
+ * supports it. The image is loaded with the given priority, the other methods
+ * use RCTImageLoaderPriorityVisible. Cancelling a request that hasn't started
+ * yet removes it from the queue.
+ */
+- (RCTImageLoaderCancellationBlock)loadImageWithTag:(NSString *)imageTag
+                                               size:(CGSize)size
+                                              scale:(CGFloat)scale
+                                         resizeMode:(UIViewContentMode)resizeMode
+                                           priority:(RCTImageLoaderPriority)priority
+                                      progressBlock:(RCTImageLoaderProgressBlock)progressBlock
+                                   partialLoadBlock:(RCTImageLoaderPartialLoadBlock)partialLoadBlock
+                                    completionBlock:(RCTImageLoaderCompletionBlock)completionBlock;
+
+/**
+ * Loads the image ahead of time at RCTImageLoaderPriorityPrefetch, so that it
+ * is already in the cache when an image view needs it at this size. If an
+ * image view asks for the same image while the prefetch is still queued, the
+ * prefetch is moved up to the priority of that request.
+ */
+- (RCTImageLoaderCancellationBlock)prefetchImageWithTag:(NSString *)imageTag
+                                                   size:(CGSize)size
+                                        completionBlock:(RCTImageLoaderCompletionBlock)completionBlock;
+
 /**
  * Finds an appropriate image decoder and passes the target size, scale and
  * resizeMode for optimal image decoding.
@@ -98,6 +142,14 @@ typedef void (^RCTImageLoaderCancellationBlock)(void);
  */
 - (float)imageLoaderPriority;
 
+/**
+ * As -loadImageForURL:size:scale:resizeMode:progressHandler:completionHandler:
+ * but the loader should also call the partialLoadHandler with the parts of the
+ * image decoded so far, while the image is still loading. Only called when a
+ * partialLoadHandler is requested.
+ */
+- (RCTImageLoaderCancellationBlock)loadImageForURL:(NSURL *)imageURL size:(CGSize)size scale:(CGFloat)scale resizeMode:(UIViewContentMode)resizeMode progressHandler:(RCTImageLoaderProgressBlock)progressHandler partialLoadHandler:(RCTImageLoaderPartialLoadBlock)partialLoadHandler completionHandler:(RCTImageLoaderCompletionBlock)completionHandler;
+
 @end
 
 /**
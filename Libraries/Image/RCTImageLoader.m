@@ -11,10 +11,13 @@
 
 #import <UIKit/UIKit.h>
 
+#import "RCTCache.h"
 #import "RCTConvert.h"
 #import "RCTDefines.h"
 #import "RCTImageDownloader.h"
+#import "RCTImageUtils.h"
 #import "RCTLog.h"
+#import "RCTMemoryBudget.h"
 #import "RCTUtils.h"
 
 static void RCTDispatchCallbackOnMainQueue(void (^callback)(NSError *, id), NSError *error, UIImage *image)
@@ -40,14 +43,97 @@ static void RCTDispatchCallbackOnMainQueue(void (^callback)(NSError *, id), NSEr
   objc_setAssociatedObject(self, @selector(reactKeyframeAnimation), reactKeyframeAnimation, OBJC_ASSOCIATION_COPY_NONATOMIC);
 }
 
+- (RCTAnimatedImage *)reactAnimatedImage
+{
+  return objc_getAssociatedObject(self, _cmd);
+}
+
+- (void)setReactAnimatedImage:(RCTAnimatedImage *)reactAnimatedImage
+{
+  objc_setAssociatedObject(self, @selector(reactAnimatedImage), reactAnimatedImage, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+@end
+
+/**
+ * Maximum total size in bytes of the decoded images kept by RCTImageLoader.
+ */
+static const NSUInteger RCTImageLoaderDecodedImageCacheCostLimit = 20 * 1024 * 1024;
+
+static NSString *RCTDecodedImageCacheKey(NSString *imageTag, CGSize size, CGFloat scale, UIViewContentMode resizeMode)
+{
+  return [NSString stringWithFormat:@"%@|%g|%g|%g|%zd",
+          imageTag, size.width, size.height, scale, resizeMode];
+}
+
+static NSUInteger RCTDecodedImageCost(UIImage *image)
+{
+  CGImageRef imageRef = image.CGImage;
+  if (imageRef) {
+    return CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+  }
+  // Assume 4 bytes per pixel
+  return image.size.width * image.size.height * image.scale * image.scale * 4;
+}
+
+/**
+ * Maximum number of images loaded at the same time, the others wait in a
+ * queue ordered by priority.
+ */
+static const NSUInteger RCTImageLoaderMaxConcurrentLoads = 6;
+
+typedef NS_ENUM(NSInteger, RCTImageLoaderTaskState) {
+  RCTImageLoaderTaskStatePending,
+  RCTImageLoaderTaskStateRunning,
+  RCTImageLoaderTaskStateFinished,
+};
+
+@interface RCTImageLoaderTask : NSObject
+
+@property (nonatomic, copy) NSString *imageTag;
+@property (nonatomic, assign) RCTImageLoaderPriority priority;
+@property (nonatomic, assign) NSUInteger sequenceNumber;
+@property (nonatomic, assign) RCTImageLoaderTaskState state;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, copy) RCTImageLoaderCancellationBlock (^startBlock)(void);
+@property (nonatomic, copy) RCTImageLoaderCancellationBlock cancellationBlock;
+
+@end
+
+@implementation RCTImageLoaderTask
+
 @end
 
 @implementation RCTImageLoader
+{
+  RCTCache *_decodedImageCache;
+
+  NSLock *_schedulerLock;
+  NSMutableArray<RCTImageLoaderTask *> *_pendingTasks;
+  NSUInteger _runningTaskCount;
+  NSUInteger _nextSequenceNumber;
+}
 
 @synthesize bridge = _bridge;
 
 RCT_EXPORT_MODULE()
 
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    // Cleared automatically on memory warnings
+    _decodedImageCache = [RCTCache new];
+    _decodedImageCache.name = @"DecodedImages";
+    _decodedImageCache.totalCostLimit = RCTImageLoaderDecodedImageCacheCostLimit;
+    // Decoded images are the cheapest to recreate, so are trimmed first
+    [[RCTMemoryBudget sharedBudget] registerCache:_decodedImageCache priority:RCTMemoryPriorityLow];
+
+    _schedulerLock = [NSLock new];
+    _pendingTasks = [NSMutableArray new];
+  }
+  return self;
+}
+
 - (RCTImageLoaderCancellationBlock)loadImageWithTag:(NSString *)imageTag
                                            callback:(RCTImageLoaderCompletionBlock)callback
 {
@@ -88,6 +174,108 @@ RCT_EXPORT_MODULE()
   return [handlers lastObject];
 }
 
+#pragma mark - Scheduling
+
+- (void)enqueueTask:(RCTImageLoaderTask *)task
+{
+  [_schedulerLock lock];
+  task.sequenceNumber = _nextSequenceNumber++;
+  // Queued requests for the same image, such as prefetches, are moved up so
+  // they don't keep this one waiting on a shared download
+  for (RCTImageLoaderTask *pendingTask in _pendingTasks) {
+    if (pendingTask.priority < task.priority && [pendingTask.imageTag isEqualToString:task.imageTag]) {
+      pendingTask.priority = task.priority;
+    }
+  }
+  [_pendingTasks addObject:task];
+  [_schedulerLock unlock];
+
+  [self startPendingTasks];
+}
+
+- (void)startPendingTasks
+{
+  while (YES) {
+    [_schedulerLock lock];
+    if (_runningTaskCount >= RCTImageLoaderMaxConcurrentLoads || _pendingTasks.count == 0) {
+      [_schedulerLock unlock];
+      return;
+    }
+
+    // Highest priority first, then in the order they were requested
+    RCTImageLoaderTask *nextTask = nil;
+    for (RCTImageLoaderTask *task in _pendingTasks) {
+      if (!nextTask || task.priority > nextTask.priority ||
+          (task.priority == nextTask.priority && task.sequenceNumber < nextTask.sequenceNumber)) {
+        nextTask = task;
+      }
+    }
+    [_pendingTasks removeObjectIdenticalTo:nextTask];
+    nextTask.state = RCTImageLoaderTaskStateRunning;
+    _runningTaskCount++;
+    RCTImageLoaderCancellationBlock (^startBlock)(void) = nextTask.startBlock;
+    nextTask.startBlock = nil;
+    [_schedulerLock unlock];
+
+    RCTImageLoaderCancellationBlock cancellationBlock = startBlock();
+
+    [_schedulerLock lock];
+    BOOL cancelledWhileStarting = nextTask.cancelled;
+    if (!cancelledWhileStarting && nextTask.state == RCTImageLoaderTaskStateRunning) {
+      nextTask.cancellationBlock = cancellationBlock;
+    }
+    [_schedulerLock unlock];
+
+    if (cancelledWhileStarting && cancellationBlock) {
+      cancellationBlock();
+    }
+  }
+}
+
+- (void)finishTask:(RCTImageLoaderTask *)task
+{
+  [_schedulerLock lock];
+  if (task.state != RCTImageLoaderTaskStateRunning) {
+    [_schedulerLock unlock];
+    return;
+  }
+  task.state = RCTImageLoaderTaskStateFinished;
+  task.cancellationBlock = nil;
+  _runningTaskCount--;
+  [_schedulerLock unlock];
+
+  [self startPendingTasks];
+}
+
+- (void)cancelTask:(RCTImageLoaderTask *)task
+{
+  [_schedulerLock lock];
+  if (task.cancelled || task.state == RCTImageLoaderTaskStateFinished) {
+    [_schedulerLock unlock];
+    return;
+  }
+
+  // If the task is still starting, startPendingTasks cancels it afterwards
+  task.cancelled = YES;
+  RCTImageLoaderTaskState state = task.state;
+  RCTImageLoaderCancellationBlock cancellationBlock = task.cancellationBlock;
+  if (state == RCTImageLoaderTaskStatePending) {
+    [_pendingTasks removeObjectIdenticalTo:task];
+    task.state = RCTImageLoaderTaskStateFinished;
+    task.startBlock = nil;
+  }
+  [_schedulerLock unlock];
+
+  if (state == RCTImageLoaderTaskStateRunning) {
+    if (cancellationBlock) {
+      cancellationBlock();
+    }
+    [self finishTask:task];
+  }
+}
+
+#pragma mark - Loading
+
 - (RCTImageLoaderCancellationBlock)loadImageWithTag:(NSString *)imageTag
                                                size:(CGSize)size
                                               scale:(CGFloat)scale
@@ -95,13 +283,46 @@ RCT_EXPORT_MODULE()
                                       progressBlock:(RCTImageLoaderProgressBlock)progressBlock
                                     completionBlock:(RCTImageLoaderCompletionBlock)completionBlock
 {
+  return [self loadImageWithTag:imageTag
+                           size:size
+                          scale:scale
+                     resizeMode:resizeMode
+                       priority:RCTImageLoaderPriorityVisible
+                  progressBlock:progressBlock
+               partialLoadBlock:nil
+                completionBlock:completionBlock];
+}
+
+- (RCTImageLoaderCancellationBlock)loadImageWithTag:(NSString *)imageTag
+                                               size:(CGSize)size
+                                              scale:(CGFloat)scale
+                                         resizeMode:(UIViewContentMode)resizeMode
+                                           priority:(RCTImageLoaderPriority)priority
+                                      progressBlock:(RCTImageLoaderProgressBlock)progressBlock
+                                   partialLoadBlock:(RCTImageLoaderPartialLoadBlock)partialLoadBlock
+                                    completionBlock:(RCTImageLoaderCompletionBlock)completionBlock
+{
+  // Images already decoded at this size are reused instead of being loaded
+  // and decoded again
+  NSString *cacheKey = RCTDecodedImageCacheKey(imageTag, size, scale, resizeMode);
+  UIImage *cachedImage = _decodedImageCache[cacheKey];
+  if (cachedImage) {
+    RCTDispatchCallbackOnMainQueue(completionBlock, nil, cachedImage);
+    return ^{};
+  }
+
   NSURL *requestURL = [RCTConvert NSURL:imageTag];
   id<RCTImageURLLoader> loadHandler = [self imageURLLoaderForRequest:requestURL];
   if (!loadHandler) {
     RCTLogError(@"No suitable image URL loader found for %@", imageTag);
+    return ^{};
   }
 
-  return [loadHandler loadImageForURL:requestURL size:size scale:scale resizeMode:resizeMode progressHandler:^(int64_t progress, int64_t total) {
+  RCTImageLoaderTask *task = [RCTImageLoaderTask new];
+  task.imageTag = imageTag;
+  task.priority = priority;
+
+  RCTImageLoaderProgressBlock progressHandler = ^(int64_t progress, int64_t total) {
     if (!progressBlock) {
       return;
     }
@@ -113,9 +334,67 @@ RCT_EXPORT_MODULE()
         progressBlock(progress, total);
       });
     }
-  } completionHandler:^(NSError *error, UIImage *image) {
+  };
+  // The task only retains this (through its startBlock) until it starts
+  __weak RCTImageLoader *weakSelf = self;
+  RCTImageLoaderCompletionBlock completionHandler = ^(NSError *error, UIImage *image) {
+    [weakSelf finishTask:task];
+    if (image) {
+      [_decodedImageCache setObject:image forKey:cacheKey cost:RCTDecodedImageCost(image)];
+      [[RCTMemoryBudget sharedBudget] setNeedsBudgetCheck];
+    }
     RCTDispatchCallbackOnMainQueue(completionBlock, error, image);
-  }] ?: ^{};
+  };
+
+  task.startBlock = ^RCTImageLoaderCancellationBlock{
+    if (partialLoadBlock && [loadHandler respondsToSelector:@selector(loadImageForURL:size:scale:resizeMode:progressHandler:partialLoadHandler:completionHandler:)]) {
+      return [loadHandler loadImageForURL:requestURL size:size scale:scale resizeMode:resizeMode progressHandler:progressHandler partialLoadHandler:^(UIImage *image) {
+        if ([NSThread isMainThread]) {
+          partialLoadBlock(image);
+        } else {
+          dispatch_async(dispatch_get_main_queue(), ^{
+            partialLoadBlock(image);
+          });
+        }
+      } completionHandler:completionHandler];
+    }
+
+    return [loadHandler loadImageForURL:requestURL size:size scale:scale resizeMode:resizeMode progressHandler:progressHandler completionHandler:completionHandler];
+  };
+  [self enqueueTask:task];
+
+  return ^{
+    [weakSelf cancelTask:task];
+  };
+}
+
+- (RCTImageLoaderCancellationBlock)prefetchImageWithTag:(NSString *)imageTag
+                                                   size:(CGSize)size
+                                        completionBlock:(RCTImageLoaderCompletionBlock)completionBlock
+{
+  // Cover is the default resizeMode of <Image>
+  return [self loadImageWithTag:imageTag
+                           size:size
+                          scale:RCTScreenScale()
+                     resizeMode:UIViewContentModeScaleAspectFill
+                       priority:RCTImageLoaderPriorityPrefetch
+                  progressBlock:nil
+               partialLoadBlock:nil
+                completionBlock:completionBlock];
+}
+
+RCT_EXPORT_METHOD(prefetchImage:(NSString *)imageTag
+                  size:(CGSize)size
+                  resolve:(RCTPromiseResolveBlock)resolve
+                  reject:(RCTPromiseRejectBlock)reject)
+{
+  [self prefetchImageWithTag:imageTag size:size completionBlock:^(NSError *error, UIImage *image) {
+    if (image) {
+      resolve(@YES);
+    } else {
+      reject(error);
+    }
+  }];
 }
 
 - (id<RCTImageDecoder>)imageDecoderForRequest:(NSData *)imageData
@@ -161,7 +440,7 @@ RCT_EXPORT_MODULE()
     }];
   } else {
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-      UIImage *image = [UIImage imageWithData:data];
+      UIImage *image = RCTDecodeImageWithData(data, size, scale, resizeMode);
       if (image) {
         RCTDispatchCallbackOnMainQueue(completionBlock, nil, image);
       } else {
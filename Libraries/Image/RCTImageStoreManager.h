@@ -9,11 +9,18 @@
 @interface RCTImageStoreManager : NSObject <RCTImageURLLoader>
 
 /**
- * Set and get cached images. These must be called from the main thread.
+ * Set and get cached images. It is safe to call these from any thread. The
+ * most recently used images are kept in memory, older ones are written to disk
+ * and decoded again by imageForTag:, which may block while doing so.
  */
 - (NSString *)storeImage:(UIImage *)image;
 - (UIImage *)imageForTag:(NSString *)imageTag;
 
+/**
+ * Forgets the image, once it is no longer needed.
+ */
+- (void)removeImageForTag:(NSString *)imageTag;
+
 /**
  * Set and get cached images asynchronously. It is safe to call these from any
  * thread. The callbacks will be called on the main thread.
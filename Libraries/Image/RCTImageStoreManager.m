@@ -9,12 +9,54 @@
 
 #import "RCTImageStoreManager.h"
 
+#import <libkern/OSAtomic.h>
+
 #import "RCTAssert.h"
+#import "RCTCache.h"
+#import "RCTLog.h"
+#import "RCTMemoryBudget.h"
 #import "RCTUtils.h"
 
+/**
+ * Maximum total size in bytes of the decoded images kept in memory. Images
+ * evicted beyond that are written to disk and decoded again when needed.
+ */
+static const NSUInteger RCTImageStoreCostLimit = 20 * 1024 * 1024;
+
+static NSUInteger RCTImageStoreCost(UIImage *image)
+{
+  CGImageRef imageRef = image.CGImage;
+  if (imageRef) {
+    return CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+  }
+  // Assume 4 bytes per pixel
+  return image.size.width * image.size.height * image.scale * image.scale * 4;
+}
+
+@interface RCTImageStoreEntry : NSObject
+
+@property (nonatomic, copy) NSString *tag;
+@property (nonatomic, strong) UIImage *image;
+
+@end
+
+@implementation RCTImageStoreEntry
+
+@end
+
+@interface RCTImageStoreManager () <RCTCacheDelegate>
+
+@end
+
 @implementation RCTImageStoreManager
 {
-  NSMutableDictionary *_store;
+  RCTCache *_store;
+  int64_t _lastTag;
+
+  // The images on disk and their scale, only accessed on _diskQueue
+  dispatch_queue_t _diskQueue;
+  NSString *_diskPath;
+  NSMutableDictionary<NSString *, NSNumber *> *_diskImageScales;
 }
 
 @synthesize methodQueue = _methodQueue;
@@ -24,42 +66,140 @@ RCT_EXPORT_MODULE()
 - (instancetype)init
 {
   if ((self = [super init])) {
+    _store = [RCTCache new];
+    _store.name = @"ImageStore";
+    _store.totalCostLimit = RCTImageStoreCostLimit;
+    _store.delegate = self;
+    // Evicted images are spilled to disk, rather than lost
+    [[RCTMemoryBudget sharedBudget] registerCache:_store priority:RCTMemoryPriorityDefault];
 
-    // TODO: need a way to clear this store
-    _store = [NSMutableDictionary new];
+    _diskQueue = dispatch_queue_create("com.facebook.React.ImageStoreDiskQueue", DISPATCH_QUEUE_SERIAL);
+    _diskPath = [NSTemporaryDirectory() stringByAppendingPathComponent:
+                 [NSString stringWithFormat:@"RCTImageStore/%@", [NSUUID UUID].UUIDString]];
+    _diskImageScales = [NSMutableDictionary new];
   }
   return self;
 }
 
+- (void)dealloc
+{
+  NSString *diskPath = _diskPath;
+  dispatch_async(_diskQueue, ^{
+    [[NSFileManager defaultManager] removeItemAtPath:diskPath error:NULL];
+  });
+}
+
+- (NSString *)diskPathForTag:(NSString *)imageTag
+{
+  NSString *fileName = [imageTag stringByReplacingOccurrencesOfString:@"rct-image-store://" withString:@""];
+  return [_diskPath stringByAppendingPathComponent:fileName];
+}
+
 - (NSString *)storeImage:(UIImage *)image
 {
-  RCTAssertMainThread();
-  NSString *tag = [NSString stringWithFormat:@"rct-image-store://%tu", _store.count];
-  _store[tag] = image;
+  if (!image) {
+    return nil;
+  }
+
+  NSString *tag = [NSString stringWithFormat:@"rct-image-store://%lld", OSAtomicIncrement64Barrier(&_lastTag)];
+  RCTImageStoreEntry *entry = [RCTImageStoreEntry new];
+  entry.tag = tag;
+  entry.image = image;
+  [_store setObject:entry forKey:tag cost:RCTImageStoreCost(image)];
+  [[RCTMemoryBudget sharedBudget] setNeedsBudgetCheck];
   return tag;
 }
 
 - (UIImage *)imageForTag:(NSString *)imageTag
 {
-  RCTAssertMainThread();
-  return _store[imageTag];
+  if (!imageTag) {
+    return nil;
+  }
+
+  RCTImageStoreEntry *entry = _store[imageTag];
+  if (entry) {
+    return entry.image;
+  }
+
+  // Images evicted from memory are queued to be written before this read
+  __block UIImage *image = nil;
+  dispatch_sync(_diskQueue, ^{
+    NSNumber *scale = _diskImageScales[imageTag];
+    if (scale) {
+      NSData *data = [NSData dataWithContentsOfFile:[self diskPathForTag:imageTag]];
+      image = [UIImage imageWithData:data scale:scale.doubleValue];
+    }
+  });
+
+  if (image) {
+    RCTImageStoreEntry *diskEntry = [RCTImageStoreEntry new];
+    diskEntry.tag = imageTag;
+    diskEntry.image = image;
+    [_store setObject:diskEntry forKey:imageTag cost:RCTImageStoreCost(image)];
+  }
+  return image;
 }
 
-- (void)storeImage:(UIImage *)image withBlock:(void (^)(NSString *imageTag))block
+- (void)removeImageForTag:(NSString *)imageTag
 {
-  dispatch_async(dispatch_get_main_queue(), ^{
-    NSString *imageTag = [self storeImage:image];
-    if (block) {
-      block(imageTag);
+  if (!imageTag) {
+    return;
+  }
+
+  [_store removeObjectForKey:imageTag];
+  dispatch_async(_diskQueue, ^{
+    if (_diskImageScales[imageTag]) {
+      [_diskImageScales removeObjectForKey:imageTag];
+      [[NSFileManager defaultManager] removeItemAtPath:[self diskPathForTag:imageTag] error:NULL];
     }
   });
 }
 
+- (void)storeImage:(UIImage *)image withBlock:(void (^)(NSString *imageTag))block
+{
+  NSString *imageTag = [self storeImage:image];
+  if (block) {
+    dispatch_async(dispatch_get_main_queue(), ^{
+      block(imageTag);
+    });
+  }
+}
+
 - (void)getImageForTag:(NSString *)imageTag withBlock:(void (^)(UIImage *image))block
 {
   RCTAssert(block != nil, @"block must not be nil");
-  dispatch_async(dispatch_get_main_queue(), ^{
-    block([self imageForTag:imageTag]);
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    UIImage *image = [self imageForTag:imageTag];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      block(image);
+    });
+  });
+}
+
+#pragma mark - RCTCacheDelegate
+
+- (void)cache:(__unused RCTCache *)cache willEvictObject:(RCTImageStoreEntry *)entry
+{
+  // Called with the cache locked, so don't encode here
+  dispatch_async(_diskQueue, ^{
+    if (_diskImageScales[entry.tag]) {
+      return;
+    }
+
+    NSData *data = RCTImageHasAlpha(entry.image.CGImage) ?
+      UIImagePNGRepresentation(entry.image) :
+      UIImageJPEGRepresentation(entry.image, 1.0);
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:_diskPath
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:NULL];
+    NSError *error;
+    if ([data writeToFile:[self diskPathForTag:entry.tag] options:NSDataWritingAtomic error:&error]) {
+      _diskImageScales[entry.tag] = @(entry.image.scale);
+    } else {
+      RCTLogWarn(@"Failed to write image %@ evicted from the image store: %@", entry.tag, error);
+    }
   });
 }
 
@@ -68,17 +208,14 @@ RCT_EXPORT_METHOD(getBase64ForTag:(NSString *)imageTag
                   successCallback:(RCTResponseSenderBlock)successCallback
                   errorCallback:(RCTResponseErrorBlock)errorCallback)
 {
-  [self getImageForTag:imageTag withBlock:^(UIImage *image) {
-    if (!image) {
-      errorCallback(RCTErrorWithMessage([NSString stringWithFormat:@"Invalid imageTag: %@", imageTag]));
-      return;
-    }
-    dispatch_async(_methodQueue, ^{
-      NSData *imageData = UIImageJPEGRepresentation(image, 1.0);
-      NSString *base64 = [imageData base64EncodedStringWithOptions:NSDataBase64EncodingEndLineWithLineFeed];
-      successCallback(@[[base64 stringByReplacingOccurrencesOfString:@"\n" withString:@""]]);
-    });
-  }];
+  UIImage *image = [self imageForTag:imageTag];
+  if (!image) {
+    errorCallback(RCTErrorWithMessage([NSString stringWithFormat:@"Invalid imageTag: %@", imageTag]));
+    return;
+  }
+  NSData *imageData = UIImageJPEGRepresentation(image, 1.0);
+  NSString *base64 = [imageData base64EncodedStringWithOptions:NSDataBase64EncodingEndLineWithLineFeed];
+  successCallback(@[[base64 stringByReplacingOccurrencesOfString:@"\n" withString:@""]]);
 }
 
 RCT_EXPORT_METHOD(addImageFromBase64:(NSString *)base64String
@@ -97,6 +234,11 @@ RCT_EXPORT_METHOD(addImageFromBase64:(NSString *)base64String
   }
 }
 
+RCT_EXPORT_METHOD(removeImageForTag:(NSString *)imageTag)
+{
+  [self removeImageForTag:imageTag];
+}
+
 #pragma mark - RCTImageLoader
 
 - (BOOL)canLoadImageURL:(NSURL *)requestURL
@@ -107,7 +249,8 @@ RCT_EXPORT_METHOD(addImageFromBase64:(NSString *)base64String
 - (RCTImageLoaderCancellationBlock)loadImageForURL:(NSURL *)imageURL size:(CGSize)size scale:(CGFloat)scale resizeMode:(UIViewContentMode)resizeMode progressHandler:(RCTImageLoaderProgressBlock)progressHandler completionHandler:(RCTImageLoaderCompletionBlock)completionHandler
 {
   NSString *imageTag = imageURL.absoluteString;
-  [self getImageForTag:imageTag withBlock:^(UIImage *image) {
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    UIImage *image = [self imageForTag:imageTag];
     if (image) {
       completionHandler(nil, image);
     } else {
@@ -115,7 +258,7 @@ RCT_EXPORT_METHOD(addImageFromBase64:(NSString *)base64String
       NSError *error = RCTErrorWithMessage(errorMessage);
       completionHandler(error, nil);
     }
-  }];
+  });
 
   return nil;
 }
@@ -40,3 +40,15 @@ RCT_EXTERN CGSize RCTTargetSize(CGSize sourceSize, CGFloat sourceScale,
 RCT_EXTERN BOOL RCTUpscalingRequired(CGSize sourceSize, CGFloat sourceScale,
                                      CGSize destSize, CGFloat destScale,
                                      UIViewContentMode resizeMode);
+
+/**
+ * This function decodes the image data directly at the smallest size that will
+ * still display correctly at the target size & scale with the specified
+ * content mode, without ever holding the full resolution bitmap. Pass a
+ * destSize of CGSizeZero to decode at full resolution. Returns nil if the data
+ * isn't a valid image.
+ */
+RCT_EXTERN UIImage *RCTDecodeImageWithData(NSData *data,
+                                           CGSize destSize,
+                                           CGFloat destScale,
+                                           UIViewContentMode resizeMode);
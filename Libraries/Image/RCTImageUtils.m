@@ -9,6 +9,8 @@
 
 #import "RCTImageUtils.h"
 
+#import <ImageIO/ImageIO.h>
+
 #import "RCTLog.h"
 
 static CGFloat RCTCeilValue(CGFloat value, CGFloat scale)
@@ -193,3 +195,59 @@ BOOL RCTUpscalingRequired(CGSize sourceSize, CGFloat sourceScale,
       return NO;
   }
 }
+
+UIImage *RCTDecodeImageWithData(NSData *data,
+                                CGSize destSize,
+                                CGFloat destScale,
+                                UIViewContentMode resizeMode)
+{
+  CGImageSourceRef sourceRef = CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL);
+  if (!sourceRef) {
+    return nil;
+  }
+
+  // Get original image size without decoding it
+  NSDictionary<NSString *, id> *properties = (__bridge_transfer NSDictionary *)
+    CGImageSourceCopyPropertiesAtIndex(sourceRef, 0, NULL);
+  CGFloat pixelWidth = [properties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue];
+  CGFloat pixelHeight = [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue];
+  if (pixelWidth <= 0 || pixelHeight <= 0) {
+    CFRelease(sourceRef);
+    return nil;
+  }
+
+  // EXIF orientations 5-8 swap width and height
+  NSInteger orientation = [properties[(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+  CGSize sourceSize = orientation > 4 ? (CGSize){pixelHeight, pixelWidth} : (CGSize){pixelWidth, pixelHeight};
+
+  destScale = destScale > 0 ? destScale : 1;
+  CGFloat maxPixelSize = MAX(pixelWidth, pixelHeight);
+  if (!CGSizeEqualToSize(destSize, CGSizeZero)) {
+    CGSize targetSize = RCTTargetSize(sourceSize, 1, destSize, destScale, resizeMode, NO);
+    CGFloat downscale = MAX(targetSize.width * destScale / sourceSize.width,
+                            targetSize.height * destScale / sourceSize.height);
+    if (downscale < 1) {
+      maxPixelSize = ceil(maxPixelSize * downscale);
+    }
+  }
+
+  // Decode straight to the target size, applying the EXIF orientation
+  NSDictionary<NSString *, id> *options = @{
+    (__bridge NSString *)kCGImageSourceShouldAllowFloat: @YES,
+    (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform: @YES,
+    (__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+    (__bridge NSString *)kCGImageSourceShouldCacheImmediately: @YES,
+    (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize: @(maxPixelSize),
+  };
+  CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(sourceRef, 0, (__bridge CFDictionaryRef)options);
+  CFRelease(sourceRef);
+  if (!imageRef) {
+    return nil;
+  }
+
+  UIImage *image = [UIImage imageWithCGImage:imageRef
+                                       scale:destScale
+                                 orientation:UIImageOrientationUp];
+  CGImageRelease(imageRef);
+  return image;
+}
@@ -9,15 +9,36 @@
 
 #import "RCTImageView.h"
 
+#import "RCTAnimatedImage.h"
 #import "RCTBridge.h"
 #import "RCTConvert.h"
 #import "RCTEventDispatcher.h"
 #import "RCTImageLoader.h"
-#import "RCTImageUtils.h"
 #import "RCTUtils.h"
 
 #import "UIView+React.h"
 
+/**
+ * How much the size of the view can change by, as a fraction of the size the
+ * image was loaded at, before it is loaded again at the new size.
+ */
+static const CGFloat RCTImageViewResizeTolerance = 0.2;
+
+/**
+ * How long the size has to stay put before the image is loaded again, so that
+ * layout animations and rotations only reload at the final size.
+ */
+static const NSTimeInterval RCTImageViewResizeReloadDelay = 0.1;
+
+static BOOL RCTImageSizeWithinTolerance(CGSize loadedSize, CGSize size)
+{
+  if (loadedSize.width <= 0 || loadedSize.height <= 0) {
+    return NO;
+  }
+  return ABS(size.width - loadedSize.width) <= loadedSize.width * RCTImageViewResizeTolerance &&
+    ABS(size.height - loadedSize.height) <= loadedSize.height * RCTImageViewResizeTolerance;
+}
+
 @interface RCTImageView ()
 
 @property (nonatomic, copy) RCTDirectEventBlock onLoadStart;
@@ -32,6 +53,16 @@
 {
   RCTBridge *_bridge;
   CGSize _targetSize;
+  RCTImageLoaderCancellationBlock _reloadImageCancellationBlock;
+  NSTimer *_resizeReloadTimer;
+
+  // Playback of images whose frames are decoded on demand
+  RCTAnimatedImage *_animatedImage;
+  CADisplayLink *_displayLink;
+  NSUInteger _currentFrameIndex;
+  NSUInteger _completedLoopCount;
+  NSTimeInterval _currentFrameTime;
+  CFTimeInterval _lastTimestamp;
 }
 
 - (instancetype)initWithBridge:(RCTBridge *)bridge
@@ -44,6 +75,93 @@
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
+- (void)dealloc
+{
+  [_displayLink invalidate];
+  [_resizeReloadTimer invalidate];
+}
+
+#pragma mark - Animated images
+
+- (void)startAnimatingImage:(RCTAnimatedImage *)animatedImage
+{
+  [self stopAnimatingImage];
+
+  _animatedImage = animatedImage;
+  _currentFrameIndex = 0;
+  _completedLoopCount = 0;
+  _currentFrameTime = 0;
+  _lastTimestamp = 0;
+  if (self.window) {
+    [self resumeAnimatingImage];
+  }
+}
+
+- (void)resumeAnimatingImage
+{
+  if (_animatedImage && !_displayLink) {
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayDidRefresh:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  }
+}
+
+- (void)pauseAnimatingImage
+{
+  [_displayLink invalidate];
+  _displayLink = nil;
+  _lastTimestamp = 0;
+
+  // The frames are decoded again when the image becomes visible
+  [_animatedImage purgeFrames];
+}
+
+- (void)stopAnimatingImage
+{
+  [self pauseAnimatingImage];
+  _animatedImage = nil;
+}
+
+- (void)displayDidRefresh:(CADisplayLink *)displayLink
+{
+  if (_lastTimestamp > 0) {
+    _currentFrameTime += displayLink.timestamp - _lastTimestamp;
+  }
+  _lastTimestamp = displayLink.timestamp;
+
+  NSTimeInterval delay = [_animatedImage delayAtIndex:_currentFrameIndex];
+  if (_currentFrameTime < delay) {
+    return;
+  }
+
+  NSUInteger nextFrameIndex = (_currentFrameIndex + 1) % _animatedImage.frameCount;
+  if (nextFrameIndex == 0 && _animatedImage.loopCount > 0 &&
+      _completedLoopCount + 1 >= _animatedImage.loopCount) {
+    // Keep showing the last frame
+    [self stopAnimatingImage];
+    return;
+  }
+
+  // Stay on the current frame until the next one has been decoded
+  UIImage *frame = [_animatedImage frameAtIndex:nextFrameIndex];
+  if (!frame) {
+    return;
+  }
+
+  if (nextFrameIndex == 0) {
+    _completedLoopCount++;
+  }
+  // Don't try to catch up on frames missed while waiting
+  _currentFrameTime = MIN(_currentFrameTime - delay, [_animatedImage delayAtIndex:nextFrameIndex]);
+  _currentFrameIndex = nextFrameIndex;
+  [self updateImageWithFrame:frame];
+}
+
+- (void)updateImageWithFrame:(UIImage *)frame
+{
+  super.image = frame;
+  [self updateImage];
+}
+
 - (void)updateImage
 {
   UIImage *image = self.image;
@@ -120,10 +238,29 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   }
 }
 
+- (void)cancelImageLoad
+{
+  if (_reloadImageCancellationBlock) {
+    _reloadImageCancellationBlock();
+    _reloadImageCancellationBlock = nil;
+  }
+}
+
 - (void)reloadImage
 {
+  [_resizeReloadTimer invalidate];
+  _resizeReloadTimer = nil;
+  [self stopAnimatingImage];
+
+  // Cancelled once the new request has been made, so that a download they
+  // share isn't cancelled in between
+  RCTImageLoaderCancellationBlock previousCancellationBlock = _reloadImageCancellationBlock;
+  _reloadImageCancellationBlock = nil;
+
+  _targetSize = CGSizeZero;
   if (_src && !CGSizeEqualToSize(self.frame.size, CGSizeZero)) {
 
+    _targetSize = self.bounds.size;
     if (_onLoadStart) {
       _onLoadStart(nil);
     }
@@ -138,18 +275,36 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
       };
     }
 
-    [_bridge.imageLoader loadImageWithTag:_src
-                                     size:self.bounds.size
-                                    scale:RCTScreenScale()
-                               resizeMode:self.contentMode
-                            progressBlock:progressHandler
-                          completionBlock:^(NSError *error, UIImage *image) {
+    // Show what has been downloaded so far until the full image arrives
+    NSString *src = _src;
+    __block BOOL completed = NO;
+    RCTImageLoaderPartialLoadBlock partialLoadHandler = ^(UIImage *image) {
+      if (!completed && [src isEqualToString:_src]) {
+        [self.layer removeAnimationForKey:@"contents"];
+        self.image = image;
+      }
+    };
+
+    // Images that are on screen are loaded before the others
+    RCTImageLoaderPriority priority = self.window ? RCTImageLoaderPriorityVisible : RCTImageLoaderPriorityOffscreen;
+    _reloadImageCancellationBlock = [_bridge.imageLoader loadImageWithTag:_src
+                                                                     size:self.bounds.size
+                                                                    scale:RCTScreenScale()
+                                                               resizeMode:self.contentMode
+                                                                 priority:priority
+                                                            progressBlock:progressHandler
+                                                         partialLoadBlock:partialLoadHandler
+                                                          completionBlock:^(NSError *error, UIImage *image) {
 
+      completed = YES;
       if (image.reactKeyframeAnimation) {
         [self.layer addAnimation:image.reactKeyframeAnimation forKey:@"contents"];
       } else {
         [self.layer removeAnimationForKey:@"contents"];
         self.image = image;
+        if (image.reactAnimatedImage && [src isEqualToString:_src]) {
+          [self startAnimatingImage:image.reactAnimatedImage];
+        }
       }
       if (error) {
         if (_onError) {
@@ -168,26 +323,41 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
     [self.layer removeAnimationForKey:@"contents"];
     self.image = nil;
   }
+
+  if (previousCancellationBlock) {
+    previousCancellationBlock();
+  }
 }
 
 - (void)reactSetFrame:(CGRect)frame
 {
   [super reactSetFrame:frame];
-  if (self.image == nil) {
-    _targetSize = frame.size;
-    [self reloadImage];
-  } else if ([RCTImageView srcNeedsReload:_src]) {
-    CGSize idealSize = RCTTargetSize(self.image.size, self.image.scale, frame.size,
-                                     RCTScreenScale(), self.contentMode, YES);
-    CGFloat widthChangeFraction = ABS(_targetSize.width - idealSize.width) / _targetSize.width;
-    CGFloat heightChangeFraction = ABS(_targetSize.height - idealSize.height) / _targetSize.height;
-
-    // If the combined change is more than 20%, reload the asset in case there is a better size.
-    if (widthChangeFraction + heightChangeFraction > 0.2) {
-      _targetSize = idealSize;
+
+  if (CGSizeEqualToSize(_targetSize, CGSizeZero)) {
+    // Nothing was requested yet, e.g. because the view had no size
+    if (!_resizeReloadTimer) {
       [self reloadImage];
     }
+    return;
   }
+
+  // The image, or the one being loaded, is kept when it is close enough to
+  // the new size. Images that are already there aren't reloaded unless their
+  // source can provide a better size.
+  if (RCTImageSizeWithinTolerance(_targetSize, frame.size) ||
+      (self.image && ![RCTImageView srcNeedsReload:_src])) {
+    [_resizeReloadTimer invalidate];
+    _resizeReloadTimer = nil;
+    return;
+  }
+
+  [_resizeReloadTimer invalidate];
+  _resizeReloadTimer = [NSTimer timerWithTimeInterval:RCTImageViewResizeReloadDelay
+                                               target:self
+                                             selector:@selector(reloadImage)
+                                             userInfo:nil
+                                              repeats:NO];
+  [[NSRunLoop mainRunLoop] addTimer:_resizeReloadTimer forMode:NSRunLoopCommonModes];
 }
 
 - (void)didMoveToWindow
@@ -195,6 +365,11 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   [super didMoveToWindow];
 
   if (!self.window) {
+    // Don't spend bandwidth on images that are no longer visible
+    [_resizeReloadTimer invalidate];
+    _resizeReloadTimer = nil;
+    [self cancelImageLoad];
+    [self stopAnimatingImage];
     [self.layer removeAnimationForKey:@"contents"];
     self.image = nil;
   } else if (self.src) {
@@ -31,6 +31,23 @@ typedef void (^RCTURLRequestResponseBlock)(NSURLResponse *response);
 @property (nonatomic, copy) RCTURLRequestResponseBlock responseBlock;
 @property (nonatomic, copy) RCTURLRequestProgressBlock uploadProgressBlock;
 
+/**
+ * Whether the received data is accumulated and passed to the completion
+ * block. Defaults to YES. Set it to NO when the data is consumed through the
+ * incrementalDataBlock, so that the response isn't held in memory twice.
+ */
+@property (nonatomic, assign) BOOL buffersData;
+
+/**
+ * Limits how often the progress blocks are called: at most once per
+ * progressInterval seconds, and once the progress has advanced by at least
+ * progressGranularity, as a fraction of the total. Both default to 0, which
+ * calls the blocks for every update. Progress that reaches the total, and the
+ * last progress held back before the request completes, are always reported.
+ */
+@property (nonatomic, assign) NSTimeInterval progressInterval;
+@property (nonatomic, assign) double progressGranularity;
+
 - (instancetype)initWithRequest:(NSURLRequest *)request
                         handler:(id<RCTURLRequestHandler>)handler
                 completionBlock:(RCTURLRequestCompletionBlock)completionBlock NS_DESIGNATED_INITIALIZER;
@@ -11,11 +11,22 @@
 
 #import "RCTAssert.h"
 
+typedef struct {
+  CFAbsoluteTime reportedTime;
+  int64_t reportedProgress;
+  BOOL pending;
+  int64_t pendingProgress;
+  int64_t pendingTotal;
+} RCTProgressState;
+
 @implementation RCTDownloadTask
 {
   NSMutableData *_data;
+  int64_t _receivedLength;
   id<RCTURLRequestHandler> _handler;
   RCTDownloadTask *_selfReference;
+  RCTProgressState _uploadProgress;
+  RCTProgressState _downloadProgress;
 }
 
 - (instancetype)initWithRequest:(NSURLRequest *)request
@@ -36,6 +47,7 @@
     _request = request;
     _handler = handler;
     _completionBlock = completionBlock;
+    _buffersData = YES;
     _selfReference = self;
   }
   return self;
@@ -78,11 +90,49 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   return YES;
 }
 
+- (void)reportProgress:(int64_t)progress
+                 total:(int64_t)total
+                 state:(RCTProgressState *)state
+                 block:(RCTURLRequestProgressBlock)block
+{
+  if (!block) {
+    return;
+  }
+
+  CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+  BOOL finished = total > 0 && progress >= total;
+  BOOL due = now - state->reportedTime >= _progressInterval &&
+    (_progressGranularity <= 0 || total <= 0 ||
+     (double)(progress - state->reportedProgress) / total >= _progressGranularity);
+
+  if (finished || due) {
+    state->reportedTime = now;
+    state->reportedProgress = progress;
+    state->pending = NO;
+    block(progress, total);
+  } else {
+    state->pending = YES;
+    state->pendingProgress = progress;
+    state->pendingTotal = total;
+  }
+}
+
+- (void)flushProgressState:(RCTProgressState *)state block:(RCTURLRequestProgressBlock)block
+{
+  if (state->pending && block) {
+    state->pending = NO;
+    block(state->pendingProgress, state->pendingTotal);
+  }
+}
+
 - (void)URLRequest:(id)requestToken didSendDataWithProgress:(int64_t)bytesSent
 {
   if ([self validateRequestToken:requestToken]) {
     if (_uploadProgressBlock) {
-      _uploadProgressBlock(bytesSent, _request.HTTPBody.length);
+      // Bodies that are streamed from a file only have a Content-Length
+      int64_t total = _request.HTTPBody.length ?:
+        [_request valueForHTTPHeaderField:@"Content-Length"].longLongValue;
+      [self reportProgress:bytesSent total:total state:&_uploadProgress block:_uploadProgressBlock];
     }
   }
 }
@@ -100,15 +150,21 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 - (void)URLRequest:(id)requestToken didReceiveData:(NSData *)data
 {
   if ([self validateRequestToken:requestToken]) {
-    if (!_data) {
-      _data = [NSMutableData new];
+    _receivedLength += data.length;
+    if (_buffersData) {
+      if (!_data) {
+        _data = [NSMutableData new];
+      }
+      [_data appendData:data];
     }
-    [_data appendData:data];
     if (_incrementalDataBlock) {
       _incrementalDataBlock(data);
     }
     if (_downloadProgressBlock && _response.expectedContentLength > 0) {
-      _downloadProgressBlock(_data.length, _response.expectedContentLength);
+      [self reportProgress:_receivedLength
+                     total:_response.expectedContentLength
+                     state:&_downloadProgress
+                     block:_downloadProgressBlock];
     }
   }
 }
@@ -116,6 +172,8 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 - (void)URLRequest:(id)requestToken didCompleteWithError:(NSError *)error
 {
   if ([self validateRequestToken:requestToken]) {
+    [self flushProgressState:&_uploadProgress block:_uploadProgressBlock];
+    [self flushProgressState:&_downloadProgress block:_downloadProgressBlock];
     if (_completionBlock) {
       _completionBlock(_response, _data, error);
       [self invalidate];
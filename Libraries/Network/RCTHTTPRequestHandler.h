@@ -8,10 +8,40 @@
  */
 
 #import "RCTURLRequestHandler.h"
+#import "RCTHTTPResponseCache.h"
 #import "RCTInvalidating.h"
 
+/**
+ * Hints how soon a request should be sent, between 0 (lowest) and 1 (highest,
+ * the default is 0.5) like NSURLSessionTask's priority. When too many requests
+ * to the same host are queued, those with the highest priority go first, and
+ * the priority is also passed on to the task.
+ */
+RCT_EXTERN void RCTSetHTTPRequestPriority(NSMutableURLRequest *request, float priority);
+RCT_EXTERN float RCTHTTPRequestPriority(NSURLRequest *request);
+
+/**
+ * Uploads the contents of a file as the body of the request, without loading
+ * it into memory. The body stream of the request is set as well, for handlers
+ * other than RCTHTTPRequestHandler. RCTRemoveHTTPRequestBodyFile() deletes
+ * the file once the request is done with it.
+ */
+RCT_EXTERN void RCTSetHTTPRequestBodyFile(NSMutableURLRequest *request, NSURL *fileURL);
+RCT_EXTERN NSURL *RCTHTTPRequestBodyFile(NSURLRequest *request);
+RCT_EXTERN void RCTRemoveHTTPRequestBodyFile(NSURLRequest *request);
+
+/**
+ * How the request uses RCTHTTPResponseCache. Only GET requests without a
+ * body are cached, and the default, RCTHTTPCachePolicyNone, leaves caching to
+ * NSURLSession.
+ */
+RCT_EXTERN void RCTSetHTTPRequestCachePolicy(NSMutableURLRequest *request, RCTHTTPCachePolicy cachePolicy);
+RCT_EXTERN RCTHTTPCachePolicy RCTHTTPRequestCachePolicy(NSURLRequest *request);
+
 /**
  * This is the default RCTURLRequestHandler implementation for HTTP requests.
+ * All the requests of a bridge, from XHRs as well as image downloads, share
+ * its NSURLSession, so they reuse the same connections.
  */
 @interface RCTHTTPRequestHandler : NSObject <RCTURLRequestHandler, RCTInvalidating>
 
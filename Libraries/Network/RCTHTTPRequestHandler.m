@@ -9,6 +9,185 @@
 
 #import "RCTHTTPRequestHandler.h"
 
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTPerformanceLogger.h"
+
+static NSString *const RCTHTTPRequestPriorityKey = @"RCTHTTPRequestPriority";
+static NSString *const RCTHTTPRequestBodyFileKey = @"RCTHTTPRequestBodyFile";
+static NSString *const RCTHTTPRequestCachePolicyKey = @"RCTHTTPRequestCachePolicy";
+
+// HTTP/2 multiplexes all the requests to a host over one connection, but
+// HTTP/1.1 servers need a connection per request, and sending too many at
+// once just makes them all slower
+static const NSUInteger RCTHTTPMaximumConcurrentRequestsPerHost = 6;
+
+void RCTSetHTTPRequestPriority(NSMutableURLRequest *request, float priority)
+{
+  [NSURLProtocol setProperty:@(MIN(MAX(priority, 0), 1))
+                      forKey:RCTHTTPRequestPriorityKey
+                   inRequest:request];
+}
+
+float RCTHTTPRequestPriority(NSURLRequest *request)
+{
+  NSNumber *priority = [NSURLProtocol propertyForKey:RCTHTTPRequestPriorityKey inRequest:request];
+  return priority ? priority.floatValue : NSURLSessionTaskPriorityDefault;
+}
+
+void RCTSetHTTPRequestBodyFile(NSMutableURLRequest *request, NSURL *fileURL)
+{
+  [NSURLProtocol setProperty:fileURL forKey:RCTHTTPRequestBodyFileKey inRequest:request];
+  request.HTTPBodyStream = [NSInputStream inputStreamWithURL:fileURL];
+}
+
+NSURL *RCTHTTPRequestBodyFile(NSURLRequest *request)
+{
+  return [NSURLProtocol propertyForKey:RCTHTTPRequestBodyFileKey inRequest:request];
+}
+
+void RCTRemoveHTTPRequestBodyFile(NSURLRequest *request)
+{
+  NSURL *fileURL = RCTHTTPRequestBodyFile(request);
+  if (fileURL) {
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL];
+  }
+}
+
+void RCTSetHTTPRequestCachePolicy(NSMutableURLRequest *request, RCTHTTPCachePolicy cachePolicy)
+{
+  [NSURLProtocol setProperty:@(cachePolicy) forKey:RCTHTTPRequestCachePolicyKey inRequest:request];
+}
+
+RCTHTTPCachePolicy RCTHTTPRequestCachePolicy(NSURLRequest *request)
+{
+  return [[NSURLProtocol propertyForKey:RCTHTTPRequestCachePolicyKey inRequest:request] integerValue];
+}
+
+/**
+ * The token of a request that goes through the response cache. It is also
+ * the delegate of the network task, if one is needed, and substitutes the
+ * cached response when the server confirms it is still valid. Requests that
+ * revalidate in the background have no delegate.
+ */
+@interface RCTHTTPCachedRequest : NSObject <RCTURLRequestDelegate>
+
+@property (atomic, strong) NSURLSessionDataTask *task;
+@property (atomic, assign, getter=isCancelled) BOOL cancelled;
+
+@end
+
+@implementation RCTHTTPCachedRequest
+{
+  RCTHTTPResponseCache *_cache;
+  NSURLRequest *_request;
+  RCTHTTPCachedResponse *_cachedResponse;
+  id<RCTURLRequestDelegate> _delegate;
+
+  // Only accessed on the delegate queue of the session
+  NSHTTPURLResponse *_response;
+  NSMutableData *_data;
+  BOOL _notModified;
+}
+
+- (instancetype)initWithCache:(RCTHTTPResponseCache *)cache
+                      request:(NSURLRequest *)request
+               cachedResponse:(RCTHTTPCachedResponse *)cachedResponse
+                     delegate:(id<RCTURLRequestDelegate>)delegate
+{
+  if ((self = [super init])) {
+    _cache = cache;
+    _request = request;
+    _cachedResponse = cachedResponse;
+    _delegate = delegate;
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (void)sendCachedResponse
+{
+  if (self.cancelled) {
+    return;
+  }
+  [_delegate URLRequest:self didReceiveResponse:_cachedResponse.response];
+  if (_cachedResponse.data.length) {
+    [_delegate URLRequest:self didReceiveData:_cachedResponse.data];
+  }
+  [_delegate URLRequest:self didCompleteWithError:nil];
+}
+
+- (void)sendError:(NSError *)error
+{
+  if (!self.cancelled) {
+    [_delegate URLRequest:self didCompleteWithError:error];
+  }
+}
+
+#pragma mark - RCTURLRequestDelegate
+
+- (void)URLRequest:(__unused id)task didSendDataWithProgress:(int64_t)bytesSent
+{
+  if (!self.cancelled) {
+    [_delegate URLRequest:self didSendDataWithProgress:bytesSent];
+  }
+}
+
+- (void)URLRequest:(__unused id)task didReceiveResponse:(NSURLResponse *)response
+{
+  if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+    _response = nil;
+  } else if (_cachedResponse && ((NSHTTPURLResponse *)response).statusCode == 304) {
+    _notModified = YES;
+    _cachedResponse = [_cache updateCachedResponse:_cachedResponse
+                           withNotModifiedResponse:(NSHTTPURLResponse *)response
+                                        forRequest:_request];
+    response = _cachedResponse.response;
+  } else {
+    _response = (NSHTTPURLResponse *)response;
+    _data = response.expectedContentLength <= (long long)RCTHTTPResponseCacheMaximumDataLength ?
+      [NSMutableData new] : nil;
+  }
+
+  if (!self.cancelled) {
+    [_delegate URLRequest:self didReceiveResponse:response];
+  }
+}
+
+- (void)URLRequest:(__unused id)task didReceiveData:(NSData *)data
+{
+  if (_notModified) {
+    return;
+  }
+  [_data appendData:data];
+  if (_data.length > RCTHTTPResponseCacheMaximumDataLength) {
+    _data = nil;
+  }
+
+  if (!self.cancelled) {
+    [_delegate URLRequest:self didReceiveData:data];
+  }
+}
+
+- (void)URLRequest:(__unused id)task didCompleteWithError:(NSError *)error
+{
+  if (_notModified) {
+    if (!error && !self.cancelled && _cachedResponse.data.length) {
+      [_delegate URLRequest:self didReceiveData:_cachedResponse.data];
+    }
+  } else if (!error && _response && _data) {
+    [_cache storeResponse:_response data:_data forRequest:_request];
+  }
+  _data = nil;
+
+  if (!self.cancelled) {
+    [_delegate URLRequest:self didCompleteWithError:error];
+  }
+}
+
+@end
+
 @interface RCTHTTPRequestHandler () <NSURLSessionDataDelegate>
 
 @end
@@ -17,16 +196,34 @@
 {
   NSMapTable *_delegates;
   NSURLSession *_session;
+
+  // Guards everything below, and _delegates
+  NSLock *_lock;
+  NSMutableDictionary *_pendingTasksByHost;
+  NSMutableSet *_activeTasks;
+  NSCountedSet *_activeHosts;
+  NSMapTable *_startTimes;
 }
 
 RCT_EXPORT_MODULE()
 
++ (BOOL)isSharedAcrossBridges
+{
+  // Bridges share the session, its connections and the per host limits
+  return YES;
+}
+
 - (instancetype)init
 {
   if ((self = [super init])) {
     _delegates = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory
                                            valueOptions:NSPointerFunctionsStrongMemory
                                                capacity:0];
+    _lock = [NSLock new];
+    _pendingTasksByHost = [NSMutableDictionary new];
+    _activeTasks = [NSMutableSet new];
+    _activeHosts = [NSCountedSet new];
+    _startTimes = [NSMapTable strongToStrongObjectsMapTable];
   }
   return self;
 }
@@ -35,7 +232,14 @@ RCT_EXPORT_MODULE()
 {
   [_session invalidateAndCancel];
   _session = nil;
+
+  [_lock lock];
   _delegates = nil;
+  [_pendingTasksByHost removeAllObjects];
+  [_activeTasks removeAllObjects];
+  [_activeHosts removeAllObjects];
+  [_startTimes removeAllObjects];
+  [_lock unlock];
 }
 
 - (BOOL)isValid
@@ -43,47 +247,240 @@ RCT_EXPORT_MODULE()
   return _delegates != nil;
 }
 
-#pragma mark - NSURLRequestHandler
-
-- (BOOL)canHandleRequest:(NSURLRequest *)request
-{
-  return [@[@"http", @"https", @"file"] containsObject:request.URL.scheme.lowercaseString];
-}
-
-- (NSURLSessionDataTask *)sendRequest:(NSURLRequest *)request
-                         withDelegate:(id<RCTURLRequestDelegate>)delegate
+- (NSURLSession *)session
 {
   // Lazy setup
   if (!_session && [self isValid]) {
     NSOperationQueue *callbackQueue = [NSOperationQueue new];
     callbackQueue.maxConcurrentOperationCount = 1;
     NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    configuration.HTTPMaximumConnectionsPerHost = RCTHTTPMaximumConcurrentRequestsPerHost;
     _session = [NSURLSession sessionWithConfiguration:configuration
                                              delegate:self
                                         delegateQueue:callbackQueue];
   }
+  return _session;
+}
 
-  NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
-  [_delegates setObject:delegate forKey:task];
+#pragma mark - Scheduling
+
+- (NSString *)hostForTask:(NSURLSessionTask *)task
+{
+  return task.originalRequest.URL.host.lowercaseString;
+}
+
+/**
+ * Must be called with the lock held.
+ */
+- (void)resumeTask:(NSURLSessionTask *)task
+{
+  NSString *host = [self hostForTask:task];
+  if (host) {
+    [_activeHosts addObject:host];
+  }
+  [_activeTasks addObject:task];
+  [_startTimes setObject:@(CACurrentMediaTime()) forKey:task];
   [task resume];
+}
+
+/**
+ * Must be called with the lock held.
+ */
+- (void)resumePendingTasksForHost:(NSString *)host
+{
+  NSMutableArray *pendingTasks = _pendingTasksByHost[host];
+  while (pendingTasks.count && [_activeHosts countForObject:host] < RCTHTTPMaximumConcurrentRequestsPerHost) {
+    NSURLSessionTask *task = pendingTasks[0];
+    [pendingTasks removeObjectAtIndex:0];
+    [self resumeTask:task];
+  }
+  if (pendingTasks.count == 0) {
+    [_pendingTasksByHost removeObjectForKey:host];
+  }
+}
+
+/**
+ * Must be called with the lock held. Returns the delegate of the task.
+ */
+- (id<RCTURLRequestDelegate>)removeTask:(NSURLSessionTask *)task
+{
+  id<RCTURLRequestDelegate> delegate = [_delegates objectForKey:task];
+  [_delegates removeObjectForKey:task];
+  [_startTimes removeObjectForKey:task];
+
+  NSString *host = [self hostForTask:task];
+  if ([_activeTasks containsObject:task]) {
+    [_activeTasks removeObject:task];
+    if (host) {
+      [_activeHosts removeObject:host];
+      [self resumePendingTasksForHost:host];
+    }
+  } else if (host) {
+    [_pendingTasksByHost[host] removeObject:task];
+  }
+  return delegate;
+}
+
+#pragma mark - NSURLRequestHandler
+
+- (BOOL)canHandleRequest:(NSURLRequest *)request
+{
+  return [@[@"http", @"https", @"file"] containsObject:request.URL.scheme.lowercaseString];
+}
+
+- (id)sendRequest:(NSURLRequest *)request withDelegate:(id<RCTURLRequestDelegate>)delegate
+{
+  RCTHTTPCachePolicy cachePolicy = RCTHTTPRequestCachePolicy(request);
+  if (cachePolicy == RCTHTTPCachePolicyNone || ![RCTHTTPResponseCache canCacheRequest:request]) {
+    return [self sendTaskWithRequest:request delegate:delegate];
+  }
+
+  // The response cache replaces NSURLSession's, which would otherwise also
+  // store the response and answer the conditional requests itself
+  NSMutableURLRequest *networkRequest = [request mutableCopy];
+  networkRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+  if (cachePolicy == RCTHTTPCachePolicyNoStore) {
+    return [self sendTaskWithRequest:networkRequest delegate:delegate];
+  }
+
+  RCTHTTPResponseCache *cache = [RCTHTTPResponseCache sharedCache];
+  RCTHTTPCachedResponse *cachedResponse = nil;
+  if (cachePolicy != RCTHTTPCachePolicyReload) {
+    cachedResponse = [cache cachedResponseForRequest:request];
+  }
+
+  BOOL useCachedResponse = cachedResponse && (cachePolicy == RCTHTTPCachePolicyForceCache ||
+                                              cachePolicy == RCTHTTPCachePolicyOnlyIfCached ||
+                                              (cachePolicy == RCTHTTPCachePolicyDefault && cachedResponse.fresh));
+  BOOL revalidateInBackground = !useCachedResponse && cachePolicy == RCTHTTPCachePolicyDefault &&
+    cachedResponse.canUseWhileRevalidating;
+
+  if (useCachedResponse || revalidateInBackground || cachePolicy == RCTHTTPCachePolicyOnlyIfCached) {
+    // The token has to be returned before any delegate method is called
+    RCTHTTPCachedRequest *cachedRequest = [[RCTHTTPCachedRequest alloc] initWithCache:cache
+                                                                              request:request
+                                                                       cachedResponse:cachedResponse
+                                                                             delegate:delegate];
+    [[self session].delegateQueue addOperationWithBlock:^{
+      if (cachedResponse) {
+        [cachedRequest sendCachedResponse];
+      } else {
+        [cachedRequest sendError:[NSError errorWithDomain:NSURLErrorDomain
+                                                     code:NSURLErrorResourceUnavailable
+                                                 userInfo:@{NSLocalizedDescriptionKey: @"The response isn't cached",
+                                                            NSURLErrorFailingURLErrorKey: request.URL}]];
+      }
+    }];
+    if (revalidateInBackground) {
+      [self sendRequest:networkRequest
+         cachedResponse:cachedResponse
+                  cache:cache
+               delegate:nil];
+    }
+    return cachedRequest;
+  }
+
+  return [self sendRequest:networkRequest
+            cachedResponse:cachedResponse
+                     cache:cache
+                  delegate:delegate];
+}
+
+/**
+ * Sends the request to the server, conditionally if there is a cached
+ * response to it, and stores the response.
+ */
+- (RCTHTTPCachedRequest *)sendRequest:(NSURLRequest *)request
+                       cachedResponse:(RCTHTTPCachedResponse *)cachedResponse
+                                cache:(RCTHTTPResponseCache *)cache
+                             delegate:(id<RCTURLRequestDelegate>)delegate
+{
+  NSURLRequest *conditionalRequest = [cachedResponse conditionalRequestForRequest:request];
+  RCTHTTPCachedRequest *cachedRequest = [[RCTHTTPCachedRequest alloc] initWithCache:cache
+                                                                            request:request
+                                                                     cachedResponse:conditionalRequest ? cachedResponse : nil
+                                                                           delegate:delegate];
+  cachedRequest.task = [self sendTaskWithRequest:conditionalRequest ?: request delegate:cachedRequest];
+  return cachedRequest.task ? cachedRequest : nil;
+}
+
+- (NSURLSessionDataTask *)sendTaskWithRequest:(NSURLRequest *)request
+                                    delegate:(id<RCTURLRequestDelegate>)delegate
+{
+  NSURLSessionDataTask *task;
+  NSURL *bodyFile = RCTHTTPRequestBodyFile(request);
+  if (bodyFile) {
+    // Unlike a body stream, the file can be read again if the request has
+    // to be resent, e.g. after a redirect or an authentication challenge
+    task = [[self session] uploadTaskWithRequest:request fromFile:bodyFile];
+  } else {
+    task = [[self session] dataTaskWithRequest:request];
+  }
+  if (!task) {
+    return nil;
+  }
+  task.priority = RCTHTTPRequestPriority(request);
+
+  [_lock lock];
+  [_delegates setObject:delegate forKey:task];
+
+  NSString *host = [self hostForTask:task];
+  if (!host || [_activeHosts countForObject:host] < RCTHTTPMaximumConcurrentRequestsPerHost) {
+    [self resumeTask:task];
+  } else {
+    // Queue behind the pending tasks of the same or higher priority
+    NSMutableArray *pendingTasks = _pendingTasksByHost[host];
+    if (!pendingTasks) {
+      pendingTasks = [NSMutableArray new];
+      _pendingTasksByHost[host] = pendingTasks;
+    }
+    NSUInteger index = pendingTasks.count;
+    while (index > 0 && [pendingTasks[index - 1] priority] < task.priority) {
+      index--;
+    }
+    [pendingTasks insertObject:task atIndex:index];
+  }
+  [_lock unlock];
+
   return task;
 }
 
-- (void)cancelRequest:(NSURLSessionDataTask *)task
+- (void)cancelRequest:(id)requestToken
 {
+  NSURLSessionDataTask *task = requestToken;
+  if ([requestToken isKindOfClass:[RCTHTTPCachedRequest class]]) {
+    RCTHTTPCachedRequest *cachedRequest = requestToken;
+    cachedRequest.cancelled = YES;
+    task = cachedRequest.task;
+  }
+  if (!task) {
+    return;
+  }
+
   [task cancel];
-  [_delegates removeObjectForKey:task];
+
+  [_lock lock];
+  [self removeTask:task];
+  [_lock unlock];
 }
 
 #pragma mark - NSURLSession delegate
 
+- (id<RCTURLRequestDelegate>)delegateForTask:(NSURLSessionTask *)task
+{
+  [_lock lock];
+  id<RCTURLRequestDelegate> delegate = [_delegates objectForKey:task];
+  [_lock unlock];
+  return delegate;
+}
+
 - (void)URLSession:(NSURLSession *)session
               task:(NSURLSessionTask *)task
    didSendBodyData:(int64_t)bytesSent
     totalBytesSent:(int64_t)totalBytesSent
 totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
 {
-  [[_delegates objectForKey:task] URLRequest:task didSendDataWithProgress:totalBytesSent];
+  [[self delegateForTask:task] URLRequest:task didSendDataWithProgress:totalBytesSent];
 }
 
 - (void)URLSession:(NSURLSession *)session
@@ -91,7 +488,15 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
 didReceiveResponse:(NSURLResponse *)response
  completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
 {
-  [[_delegates objectForKey:task] URLRequest:task didReceiveResponse:response];
+  [_lock lock];
+  NSNumber *startTime = [_startTimes objectForKey:task];
+  [_startTimes removeObjectForKey:task];
+  [_lock unlock];
+  if (startTime) {
+    RCTPerformanceLoggerAdd(RCTPLNetworkTTFB, (CACurrentMediaTime() - startTime.doubleValue) * 1000);
+  }
+
+  [[self delegateForTask:task] URLRequest:task didReceiveResponse:response];
   completionHandler(NSURLSessionResponseAllow);
 }
 
@@ -99,13 +504,44 @@ didReceiveResponse:(NSURLResponse *)response
           dataTask:(NSURLSessionDataTask *)task
     didReceiveData:(NSData *)data
 {
-  [[_delegates objectForKey:task] URLRequest:task didReceiveData:data];
+  [[self delegateForTask:task] URLRequest:task didReceiveData:data];
 }
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
 {
-  [[_delegates objectForKey:task] URLRequest:task didCompleteWithError:error];
-  [_delegates removeObjectForKey:task];
+  [_lock lock];
+  id<RCTURLRequestDelegate> delegate = [self removeTask:task];
+  [_lock unlock];
+
+  RCTPerformanceLoggerAdd(RCTPLNetworkRequests, 1);
+  [delegate URLRequest:task didCompleteWithError:error];
+}
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+
+// Only called on iOS 10 and later
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+  for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+    if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+      continue;
+    }
+    if (transaction.reusedConnection) {
+      RCTPerformanceLoggerAdd(RCTPLNetworkReusedConnections, 1);
+    }
+    if (transaction.domainLookupStartDate && transaction.domainLookupEndDate) {
+      NSTimeInterval time = [transaction.domainLookupEndDate timeIntervalSinceDate:transaction.domainLookupStartDate];
+      RCTPerformanceLoggerAdd(RCTPLNetworkDNSTime, time * 1000);
+    }
+    if (transaction.secureConnectionStartDate && transaction.secureConnectionEndDate) {
+      NSTimeInterval time = [transaction.secureConnectionEndDate timeIntervalSinceDate:transaction.secureConnectionStartDate];
+      RCTPerformanceLoggerAdd(RCTPLNetworkTLSTime, time * 1000);
+    }
+  }
 }
 
+#endif
+
 @end
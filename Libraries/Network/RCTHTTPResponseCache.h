@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "RCTConvert.h"
+
+/**
+ * How a GET request uses the response cache, like the `cache` option of fetch.
+ * Requests with RCTHTTPCachePolicyNone aren't cached by React at all, and are
+ * left to NSURLSession's own cache.
+ */
+typedef NS_ENUM(NSInteger, RCTHTTPCachePolicy) {
+  RCTHTTPCachePolicyNone = 0,
+  // Fresh responses are used, stale ones are revalidated first, or while
+  // they are used within their stale-while-revalidate window
+  RCTHTTPCachePolicyDefault,
+  // The cache is neither read nor written
+  RCTHTTPCachePolicyNoStore,
+  // The cache isn't read, but the response is stored
+  RCTHTTPCachePolicyReload,
+  // Cached responses are always revalidated first
+  RCTHTTPCachePolicyNoCache,
+  // Cached responses are used however old they are
+  RCTHTTPCachePolicyForceCache,
+  // As above, and the request fails when nothing is cached
+  RCTHTTPCachePolicyOnlyIfCached,
+};
+
+@interface RCTConvert (RCTHTTPCachePolicy)
+
++ (RCTHTTPCachePolicy)RCTHTTPCachePolicy:(id)json;
+
+@end
+
+/**
+ * Responses with larger bodies aren't stored.
+ */
+RCT_EXTERN const NSUInteger RCTHTTPResponseCacheMaximumDataLength;
+
+@interface RCTHTTPCachedResponse : NSObject
+
+@property (nonatomic, readonly) NSHTTPURLResponse *response;
+@property (nonatomic, readonly) NSData *data;
+
+/**
+ * Whether the response can be used without asking the server, and whether
+ * it can still be used while it is revalidated in the background.
+ */
+@property (nonatomic, readonly, getter=isFresh) BOOL fresh;
+@property (nonatomic, readonly) BOOL canUseWhileRevalidating;
+
+/**
+ * A copy of the request that only asks the server for the body if it changed
+ * since this response, or nil if the response has no ETag or Last-Modified.
+ */
+- (NSURLRequest *)conditionalRequestForRequest:(NSURLRequest *)request;
+
+@end
+
+/**
+ * Caches the responses to GET requests in memory and on disk, keyed by URL
+ * and the request headers their Vary header names. Follows Cache-Control and
+ * Expires for freshness, and never stores responses marked no-store. All
+ * methods are thread safe.
+ */
+@interface RCTHTTPResponseCache : NSObject
+
+/**
+ * The cache shared by all bridges, in the app's caches directory.
+ */
++ (instancetype)sharedCache;
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                  memoryCostLimit:(NSUInteger)memoryCostLimit
+                    diskSizeLimit:(NSUInteger)diskSizeLimit NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Whether the request may be answered from the cache at all.
+ */
++ (BOOL)canCacheRequest:(NSURLRequest *)request;
+
+/**
+ * Returns the cached response that matches the request, or nil. May read
+ * from disk.
+ */
+- (RCTHTTPCachedResponse *)cachedResponseForRequest:(NSURLRequest *)request;
+
+/**
+ * Stores the response if it is cacheable, replacing what was cached for the
+ * request. Writes to disk in the background.
+ */
+- (void)storeResponse:(NSHTTPURLResponse *)response
+                 data:(NSData *)data
+           forRequest:(NSURLRequest *)request;
+
+/**
+ * Stores and returns the cached response with the headers of a 304 response
+ * that confirmed it is still valid merged in.
+ */
+- (RCTHTTPCachedResponse *)updateCachedResponse:(RCTHTTPCachedResponse *)cachedResponse
+                        withNotModifiedResponse:(NSHTTPURLResponse *)response
+                                     forRequest:(NSURLRequest *)request;
+
+- (void)removeAllResponses;
+
+@end
@@ -0,0 +1,500 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTHTTPResponseCache.h"
+
+#import "RCTCache.h"
+#import "RCTDefines.h"
+#import "RCTMemoryBudget.h"
+#import "RCTUtils.h"
+
+static NSString *const RCTHTTPCacheURLKey = @"url";
+static NSString *const RCTHTTPCacheStatusCodeKey = @"statusCode";
+static NSString *const RCTHTTPCacheHeadersKey = @"headers";
+static NSString *const RCTHTTPCacheVaryHeadersKey = @"varyHeaders";
+static NSString *const RCTHTTPCacheResponseTimeKey = @"responseTime";
+static NSString *const RCTHTTPCacheDataKey = @"data";
+
+const NSUInteger RCTHTTPResponseCacheMaximumDataLength = 2 * 1024 * 1024;
+
+@implementation RCTConvert (RCTHTTPCachePolicy)
+
+RCT_ENUM_CONVERTER(RCTHTTPCachePolicy, (@{
+  @"default": @(RCTHTTPCachePolicyDefault),
+  @"no-store": @(RCTHTTPCachePolicyNoStore),
+  @"reload": @(RCTHTTPCachePolicyReload),
+  @"no-cache": @(RCTHTTPCachePolicyNoCache),
+  @"force-cache": @(RCTHTTPCachePolicyForceCache),
+  @"only-if-cached": @(RCTHTTPCachePolicyOnlyIfCached),
+}), RCTHTTPCachePolicyDefault, integerValue)
+
+@end
+
+static NSString *RCTHeaderValue(NSDictionary *headers, NSString *name)
+{
+  NSString *value = headers[name];
+  if (value) {
+    return value;
+  }
+  for (NSString *key in headers) {
+    if ([key caseInsensitiveCompare:name] == NSOrderedSame) {
+      return headers[key];
+    }
+  }
+  return nil;
+}
+
+/**
+ * Maps the lowercased directives of a Cache-Control header to their value,
+ * or to NSNull for directives without one.
+ */
+static NSDictionary *RCTCacheControlDirectives(NSString *header)
+{
+  NSMutableDictionary *directives = [NSMutableDictionary new];
+  NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+  for (NSString *component in [header componentsSeparatedByString:@","]) {
+    NSRange equals = [component rangeOfString:@"="];
+    NSString *name = equals.location == NSNotFound ? component : [component substringToIndex:equals.location];
+    name = [name stringByTrimmingCharactersInSet:whitespace].lowercaseString;
+    if (!name.length) {
+      continue;
+    }
+    id value = (id)kCFNull;
+    if (equals.location != NSNotFound) {
+      value = [[component substringFromIndex:equals.location + 1] stringByTrimmingCharactersInSet:whitespace];
+      value = [value stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"\""]];
+    }
+    directives[name] = value;
+  }
+  return directives;
+}
+
+static NSDate *RCTHTTPDate(NSString *string)
+{
+  if (!string) {
+    return nil;
+  }
+  static NSDateFormatter *formatter;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    formatter = [NSDateFormatter new];
+    formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+    formatter.dateFormat = @"EEE',' dd MMM yyyy HH':'mm':'ss 'GMT'";
+  });
+  @synchronized(formatter) {
+    return [formatter dateFromString:string];
+  }
+}
+
+/**
+ * The values of the request headers named by the Vary header of the response,
+ * or nil if the response varies on something other than request headers.
+ */
+static NSDictionary *RCTVaryHeaders(NSDictionary *responseHeaders, NSURLRequest *request)
+{
+  NSMutableDictionary *varyHeaders = [NSMutableDictionary new];
+  for (NSString *component in [RCTHeaderValue(responseHeaders, @"Vary") componentsSeparatedByString:@","]) {
+    NSString *name = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]].lowercaseString;
+    if ([name isEqualToString:@"*"]) {
+      return nil;
+    }
+    if (name.length) {
+      varyHeaders[name] = [request valueForHTTPHeaderField:name] ?: @"";
+    }
+  }
+  return varyHeaders;
+}
+
+@implementation RCTHTTPCachedResponse
+{
+  NSDictionary *_varyHeaders;
+  CFAbsoluteTime _responseTime;
+  NSDictionary *_cacheControl;
+}
+
+- (instancetype)initWithResponse:(NSHTTPURLResponse *)response
+                            data:(NSData *)data
+                     varyHeaders:(NSDictionary *)varyHeaders
+                    responseTime:(CFAbsoluteTime)responseTime
+{
+  if ((self = [super init])) {
+    _response = response;
+    _data = data ?: [NSData data];
+    _varyHeaders = varyHeaders ?: @{};
+    _responseTime = responseTime;
+    _cacheControl = RCTCacheControlDirectives(RCTHeaderValue(response.allHeaderFields, @"Cache-Control"));
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (instancetype)initWithPropertyList:(NSDictionary *)propertyList
+{
+  NSURL *URL = [NSURL URLWithString:propertyList[RCTHTTPCacheURLKey]];
+  NSHTTPURLResponse *response = URL ? [[NSHTTPURLResponse alloc] initWithURL:URL
+                                                                  statusCode:[propertyList[RCTHTTPCacheStatusCodeKey] integerValue]
+                                                                 HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:propertyList[RCTHTTPCacheHeadersKey]] : nil;
+  NSData *data = propertyList[RCTHTTPCacheDataKey];
+  if (!response || ![data isKindOfClass:[NSData class]]) {
+    return nil;
+  }
+  return [self initWithResponse:response
+                           data:data
+                    varyHeaders:propertyList[RCTHTTPCacheVaryHeadersKey]
+                   responseTime:[propertyList[RCTHTTPCacheResponseTimeKey] doubleValue]];
+}
+
+- (NSDictionary *)propertyList
+{
+  return @{
+    RCTHTTPCacheURLKey: _response.URL.absoluteString,
+    RCTHTTPCacheStatusCodeKey: @(_response.statusCode),
+    RCTHTTPCacheHeadersKey: _response.allHeaderFields ?: @{},
+    RCTHTTPCacheVaryHeadersKey: _varyHeaders,
+    RCTHTTPCacheResponseTimeKey: @(_responseTime),
+    RCTHTTPCacheDataKey: _data,
+  };
+}
+
+- (NSUInteger)cost
+{
+  return _data.length;
+}
+
+- (BOOL)matchesRequest:(NSURLRequest *)request
+{
+  for (NSString *name in _varyHeaders) {
+    if (![_varyHeaders[name] isEqualToString:[request valueForHTTPHeaderField:name] ?: @""]) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+- (NSTimeInterval)age
+{
+  NSTimeInterval age = [RCTHeaderValue(_response.allHeaderFields, @"Age") doubleValue];
+  return MAX(0, CFAbsoluteTimeGetCurrent() - _responseTime) + MAX(0, age);
+}
+
+- (NSTimeInterval)freshnessLifetime
+{
+  NSString *maxAge = _cacheControl[@"max-age"];
+  if ([maxAge isKindOfClass:[NSString class]]) {
+    return maxAge.doubleValue;
+  }
+  NSDictionary *headers = _response.allHeaderFields;
+  NSDate *expires = RCTHTTPDate(RCTHeaderValue(headers, @"Expires"));
+  if (expires) {
+    NSDate *date = RCTHTTPDate(RCTHeaderValue(headers, @"Date")) ?:
+      [NSDate dateWithTimeIntervalSinceReferenceDate:_responseTime];
+    return [expires timeIntervalSinceDate:date];
+  }
+  return 0;
+}
+
+- (BOOL)isFresh
+{
+  return !_cacheControl[@"no-cache"] && self.age < self.freshnessLifetime;
+}
+
+- (BOOL)canUseWhileRevalidating
+{
+  NSString *staleWhileRevalidate = _cacheControl[@"stale-while-revalidate"];
+  if (_cacheControl[@"no-cache"] || _cacheControl[@"must-revalidate"] ||
+      ![staleWhileRevalidate isKindOfClass:[NSString class]]) {
+    return NO;
+  }
+  return self.age < self.freshnessLifetime + staleWhileRevalidate.doubleValue;
+}
+
+- (BOOL)hasValidators
+{
+  NSDictionary *headers = _response.allHeaderFields;
+  return RCTHeaderValue(headers, @"ETag") || RCTHeaderValue(headers, @"Last-Modified");
+}
+
+- (NSURLRequest *)conditionalRequestForRequest:(NSURLRequest *)request
+{
+  NSDictionary *headers = _response.allHeaderFields;
+  NSString *ETag = RCTHeaderValue(headers, @"ETag");
+  NSString *lastModified = RCTHeaderValue(headers, @"Last-Modified");
+  if (!ETag && !lastModified) {
+    return nil;
+  }
+
+  NSMutableURLRequest *conditionalRequest = [request mutableCopy];
+  if (ETag) {
+    [conditionalRequest setValue:ETag forHTTPHeaderField:@"If-None-Match"];
+  }
+  if (lastModified) {
+    [conditionalRequest setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+  }
+  return conditionalRequest;
+}
+
+@end
+
+@implementation RCTHTTPResponseCache
+{
+  RCTCache *_memoryCache;
+
+  // Only accessed on _diskQueue. Maps file names to their size, the oldest
+  // written files are removed first once the total goes over the limit.
+  NSString *_directory;
+  NSUInteger _diskSizeLimit;
+  dispatch_queue_t _diskQueue;
+  NSMutableDictionary<NSString *, NSNumber *> *_fileSizes;
+  NSMutableArray<NSString *> *_fileNamesByAge;
+  NSUInteger _diskSize;
+}
+
++ (instancetype)sharedCache
+{
+  static RCTHTTPResponseCache *sharedCache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    sharedCache = [[RCTHTTPResponseCache alloc] initWithDirectory:[cachesDirectory stringByAppendingPathComponent:@"React/RCTHTTPResponseCache"]
+                                                  memoryCostLimit:4 * 1024 * 1024
+                                                    diskSizeLimit:20 * 1024 * 1024];
+  });
+  return sharedCache;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                  memoryCostLimit:(NSUInteger)memoryCostLimit
+                    diskSizeLimit:(NSUInteger)diskSizeLimit
+{
+  if ((self = [super init])) {
+    _memoryCache = [RCTCache new];
+    _memoryCache.name = @"HTTPResponses";
+    _memoryCache.totalCostLimit = memoryCostLimit;
+    [[RCTMemoryBudget sharedBudget] registerCache:_memoryCache priority:RCTMemoryPriorityLow];
+
+    _directory = [directory copy];
+    _diskSizeLimit = diskSizeLimit;
+    _diskQueue = dispatch_queue_create("com.facebook.React.HTTPResponseCacheQueue", DISPATCH_QUEUE_SERIAL);
+    dispatch_async(_diskQueue, ^{
+      [self loadDirectory];
+    });
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
++ (BOOL)canCacheRequest:(NSURLRequest *)request
+{
+  NSString *scheme = request.URL.scheme.lowercaseString;
+  return [request.HTTPMethod ?: @"GET" isEqualToString:@"GET"] &&
+    !request.HTTPBody.length && !request.HTTPBodyStream &&
+    ([scheme isEqualToString:@"http"] || [scheme isEqualToString:@"https"]) &&
+    !RCTCacheControlDirectives([request valueForHTTPHeaderField:@"Cache-Control"])[@"no-store"];
+}
+
+- (NSString *)keyForRequest:(NSURLRequest *)request
+{
+  return request.URL.absoluteString;
+}
+
+#pragma mark - Disk
+
+- (NSString *)pathForFileName:(NSString *)fileName
+{
+  return [_directory stringByAppendingPathComponent:fileName];
+}
+
+- (void)loadDirectory
+{
+  NSFileManager *fileManager = [NSFileManager defaultManager];
+  [fileManager createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:NULL];
+
+  NSMutableArray *files = [NSMutableArray new];
+  for (NSString *fileName in [fileManager contentsOfDirectoryAtPath:_directory error:NULL]) {
+    NSDictionary *attributes = [fileManager attributesOfItemAtPath:[self pathForFileName:fileName] error:NULL];
+    if (attributes) {
+      [files addObject:@{@"name": fileName, @"size": @(attributes.fileSize), @"date": attributes.fileModificationDate ?: [NSDate distantPast]}];
+    }
+  }
+  [files sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+    return [a[@"date"] compare:b[@"date"]];
+  }];
+
+  _fileSizes = [NSMutableDictionary dictionaryWithCapacity:files.count];
+  _fileNamesByAge = [NSMutableArray arrayWithCapacity:files.count];
+  _diskSize = 0;
+  for (NSDictionary *file in files) {
+    _fileSizes[file[@"name"]] = file[@"size"];
+    [_fileNamesByAge addObject:file[@"name"]];
+    _diskSize += [file[@"size"] unsignedIntegerValue];
+  }
+  [self evictIfNeeded];
+}
+
+- (void)removeFileName:(NSString *)fileName
+{
+  NSNumber *size = _fileSizes[fileName];
+  if (size) {
+    _diskSize -= size.unsignedIntegerValue;
+    [_fileSizes removeObjectForKey:fileName];
+    [_fileNamesByAge removeObject:fileName];
+    [[NSFileManager defaultManager] removeItemAtPath:[self pathForFileName:fileName] error:NULL];
+  }
+}
+
+- (void)evictIfNeeded
+{
+  while (_diskSize > _diskSizeLimit && _fileNamesByAge.count) {
+    [self removeFileName:_fileNamesByAge[0]];
+  }
+}
+
+- (void)writeCachedResponse:(RCTHTTPCachedResponse *)cachedResponse forKey:(NSString *)key
+{
+  NSString *fileName = RCTMD5Hash(key);
+  dispatch_async(_diskQueue, ^{
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:[cachedResponse propertyList]
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:NULL];
+    [self removeFileName:fileName];
+    if (!data || ![data writeToFile:[self pathForFileName:fileName] atomically:YES]) {
+      return;
+    }
+    _fileSizes[fileName] = @(data.length);
+    [_fileNamesByAge addObject:fileName];
+    _diskSize += data.length;
+    [self evictIfNeeded];
+  });
+}
+
+- (RCTHTTPCachedResponse *)readCachedResponseForKey:(NSString *)key
+{
+  NSString *fileName = RCTMD5Hash(key);
+  __block RCTHTTPCachedResponse *cachedResponse = nil;
+  dispatch_sync(_diskQueue, ^{
+    if (!_fileSizes[fileName]) {
+      return;
+    }
+    NSData *data = [NSData dataWithContentsOfFile:[self pathForFileName:fileName]];
+    NSDictionary *propertyList = data ? [NSPropertyListSerialization propertyListWithData:data
+                                                                                  options:NSPropertyListImmutable
+                                                                                   format:NULL
+                                                                                    error:NULL] : nil;
+    if ([propertyList isKindOfClass:[NSDictionary class]]) {
+      cachedResponse = [[RCTHTTPCachedResponse alloc] initWithPropertyList:propertyList];
+    }
+    if (!cachedResponse) {
+      [self removeFileName:fileName];
+    }
+  });
+  return cachedResponse;
+}
+
+#pragma mark - Public API
+
+- (RCTHTTPCachedResponse *)cachedResponseForRequest:(NSURLRequest *)request
+{
+  NSString *key = [self keyForRequest:request];
+  if (!key) {
+    return nil;
+  }
+
+  RCTHTTPCachedResponse *cachedResponse = _memoryCache[key];
+  if (!cachedResponse) {
+    cachedResponse = [self readCachedResponseForKey:key];
+    if (cachedResponse) {
+      [_memoryCache setObject:cachedResponse forKey:key cost:cachedResponse.cost];
+    }
+  }
+  return [cachedResponse matchesRequest:request] ? cachedResponse : nil;
+}
+
+- (void)storeCachedResponse:(RCTHTTPCachedResponse *)cachedResponse forKey:(NSString *)key
+{
+  [_memoryCache setObject:cachedResponse forKey:key cost:cachedResponse.cost];
+  [[RCTMemoryBudget sharedBudget] setNeedsBudgetCheck];
+  [self writeCachedResponse:cachedResponse forKey:key];
+}
+
+- (void)storeResponse:(NSHTTPURLResponse *)response
+                 data:(NSData *)data
+           forRequest:(NSURLRequest *)request
+{
+  NSString *key = [self keyForRequest:request];
+  NSDictionary *headers = response.allHeaderFields;
+  NSDictionary *varyHeaders = RCTVaryHeaders(headers, request);
+  if (!key || response.statusCode != 200 || data.length > RCTHTTPResponseCacheMaximumDataLength || !varyHeaders ||
+      RCTCacheControlDirectives(RCTHeaderValue(headers, @"Cache-Control"))[@"no-store"]) {
+    return;
+  }
+
+  RCTHTTPCachedResponse *cachedResponse = [[RCTHTTPCachedResponse alloc] initWithResponse:response
+                                                                                     data:data
+                                                                              varyHeaders:varyHeaders
+                                                                             responseTime:CFAbsoluteTimeGetCurrent()];
+
+  // Responses that can't be used without asking the server, and that the
+  // server can't confirm, would never be used
+  if (cachedResponse.freshnessLifetime <= 0 && !cachedResponse.hasValidators) {
+    return;
+  }
+  [self storeCachedResponse:cachedResponse forKey:key];
+}
+
+- (RCTHTTPCachedResponse *)updateCachedResponse:(RCTHTTPCachedResponse *)cachedResponse
+                        withNotModifiedResponse:(NSHTTPURLResponse *)response
+                                     forRequest:(NSURLRequest *)request
+{
+  NSMutableDictionary *headers = [cachedResponse.response.allHeaderFields mutableCopy] ?: [NSMutableDictionary new];
+  [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSString *value, __unused BOOL *stop) {
+    // The 304 has no body, so its length doesn't apply to the cached one
+    if ([name caseInsensitiveCompare:@"Content-Length"] == NSOrderedSame) {
+      return;
+    }
+    for (NSString *existingName in headers.allKeys) {
+      if ([existingName caseInsensitiveCompare:name] == NSOrderedSame) {
+        [headers removeObjectForKey:existingName];
+      }
+    }
+    headers[name] = value;
+  }];
+
+  NSHTTPURLResponse *updatedResponse = [[NSHTTPURLResponse alloc] initWithURL:cachedResponse.response.URL
+                                                                   statusCode:cachedResponse.response.statusCode
+                                                                  HTTPVersion:@"HTTP/1.1"
+                                                                 headerFields:headers];
+  RCTHTTPCachedResponse *updatedCachedResponse =
+    [[RCTHTTPCachedResponse alloc] initWithResponse:updatedResponse
+                                               data:cachedResponse.data
+                                        varyHeaders:RCTVaryHeaders(headers, request) ?: @{}
+                                       responseTime:CFAbsoluteTimeGetCurrent()];
+
+  NSString *key = [self keyForRequest:request];
+  if (key) {
+    [self storeCachedResponse:updatedCachedResponse forKey:key];
+  }
+  return updatedCachedResponse;
+}
+
+- (void)removeAllResponses
+{
+  [_memoryCache removeAllObjects];
+  dispatch_async(_diskQueue, ^{
+    for (NSString *fileName in _fileNamesByAge.copy) {
+      [self removeFileName:fileName];
+    }
+  });
+}
+
+@end
@@ -9,6 +9,8 @@
 
 #import "RCTNetworking.h"
 
+#import <MobileCoreServices/MobileCoreServices.h>
+
 #import "RCTAssert.h"
 #import "RCTConvert.h"
 #import "RCTDownloadTask.h"
@@ -20,6 +22,26 @@
 
 typedef RCTURLRequestCancellationBlock (^RCTHTTPQueryResult)(NSError *error, NSDictionary *result);
 
+/**
+ * Upload progress events are sent at most this often unless the request asks
+ * for a different progressInterval, so large uploads don't flood the JS thread.
+ */
+static const NSTimeInterval RCTNetworkingDefaultProgressInterval = 0.05;
+
+typedef NS_ENUM(NSInteger, RCTNetworkResponseType) {
+  RCTNetworkResponseTypeText = 0,
+  RCTNetworkResponseTypeBase64,
+};
+
+@implementation RCTConvert (RCTNetworkResponseType)
+
+RCT_ENUM_CONVERTER(RCTNetworkResponseType, (@{
+  @"text": @(RCTNetworkResponseTypeText),
+  @"base64": @(RCTNetworkResponseTypeBase64),
+}), RCTNetworkResponseTypeText, integerValue)
+
+@end
+
 @interface RCTNetworking ()
 
 - (RCTURLRequestCancellationBlock)processDataForHTTPQuery:(NSDictionary *)data
@@ -27,7 +49,10 @@ typedef RCTURLRequestCancellationBlock (^RCTHTTPQueryResult)(NSError *error, NSD
 @end
 
 /**
- * Helper to convert FormData payloads into multipart/formdata requests.
+ * Helper to convert FormData payloads into multipart/formdata requests. The
+ * body is written to a temporary file one part at a time, and files are copied
+ * into it in small blocks, so the parts are never all in memory at once. The
+ * request then uploads straight from that file.
  */
 @interface RCTHTTPFormDataHelper : NSObject
 
@@ -38,9 +63,10 @@ typedef RCTURLRequestCancellationBlock (^RCTHTTPQueryResult)(NSError *error, NSD
 @implementation RCTHTTPFormDataHelper
 {
   NSMutableArray *parts;
-  NSMutableData *multipartBody;
   RCTHTTPQueryResult _callback;
   NSString *boundary;
+  NSURL *_bodyURL;
+  NSOutputStream *_bodyStream;
 }
 
 static NSString *RCTGenerateFormBoundary()
@@ -56,6 +82,29 @@ static NSString *RCTGenerateFormBoundary()
   return [[NSString alloc] initWithBytesNoCopy:bytes length:boundaryLength encoding:NSUTF8StringEncoding freeWhenDone:YES];
 }
 
+static dispatch_queue_t RCTFormDataQueue(void)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.FormDataQueue", DISPATCH_QUEUE_SERIAL);
+  });
+  return queue;
+}
+
+static NSString *RCTMIMETypeForFileURL(NSURL *fileURL)
+{
+  CFStringRef UTI = UTTypeCreatePreferredIdentifierForTag(kUTTagClassFilenameExtension,
+                                                          (__bridge CFStringRef)fileURL.pathExtension,
+                                                          NULL);
+  if (!UTI) {
+    return nil;
+  }
+  NSString *MIMEType = CFBridgingRelease(UTTypeCopyPreferredTagWithClass(UTI, kUTTagClassMIMEType));
+  CFRelease(UTI);
+  return MIMEType;
+}
+
 - (RCTURLRequestCancellationBlock)process:(NSArray *)formData
                                  callback:(RCTHTTPQueryResult)callback
 {
@@ -65,53 +114,323 @@ static NSString *RCTGenerateFormBoundary()
 
   parts = [formData mutableCopy];
   _callback = callback;
-  multipartBody = [NSMutableData new];
   boundary = RCTGenerateFormBoundary();
 
-  return [_networker processDataForHTTPQuery:parts[0] callback:^(NSError *error, NSDictionary *result) {
-    return [self handleResult:result error:error];
-  }];
+  NSString *fileName = [@"RCTFormData-" stringByAppendingString:[NSUUID UUID].UUIDString];
+  _bodyURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+  _bodyStream = [NSOutputStream outputStreamWithURL:_bodyURL append:NO];
+  [_bodyStream open];
+  if (_bodyStream.streamStatus != NSStreamStatusOpen) {
+    return [self failWithError:_bodyStream.streamError];
+  }
+
+  return [self processPart];
 }
 
-- (RCTURLRequestCancellationBlock)handleResult:(NSDictionary *)result
-                                         error:(NSError *)error
+- (RCTURLRequestCancellationBlock)failWithError:(NSError *)error
 {
-  if (error) {
-    return _callback(error, nil);
+  [_bodyStream close];
+  _bodyStream = nil;
+  [[NSFileManager defaultManager] removeItemAtURL:_bodyURL error:NULL];
+  return _callback(error ?: RCTErrorWithMessage(@"Could not write the request body"), nil);
+}
+
+- (BOOL)writeData:(NSData *)data
+{
+  const uint8_t *bytes = data.bytes;
+  NSUInteger written = 0;
+  while (written < data.length) {
+    NSInteger result = [_bodyStream write:bytes + written maxLength:data.length - written];
+    if (result <= 0) {
+      return NO;
+    }
+    written += result;
   }
+  return YES;
+}
 
+- (BOOL)writeString:(NSString *)string
+{
+  return [self writeData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (BOOL)writeFileAtURL:(NSURL *)fileURL
+{
+  NSInputStream *fileStream = [NSInputStream inputStreamWithURL:fileURL];
+  [fileStream open];
+
+  BOOL success = fileStream.streamStatus == NSStreamStatusOpen;
+  uint8_t buffer[64 * 1024];
+  while (success) {
+    NSInteger length = [fileStream read:buffer maxLength:sizeof(buffer)];
+    if (length == 0) {
+      break;
+    }
+    success = length > 0 && [self writeData:[NSData dataWithBytesNoCopy:buffer
+                                                                  length:length
+                                                            freeWhenDone:NO]];
+  }
+  [fileStream close];
+  return success;
+}
+
+- (BOOL)writePartHeaders:(NSString *)contentType
+{
   // Start with boundary.
-  [multipartBody appendData:[[NSString stringWithFormat:@"--%@\r\n", boundary]
-                             dataUsingEncoding:NSUTF8StringEncoding]];
+  if (![self writeString:[NSString stringWithFormat:@"--%@\r\n", boundary]]) {
+    return NO;
+  }
 
   // Print headers.
   NSMutableDictionary *headers = [parts[0][@"headers"] mutableCopy];
-  NSString *partContentType = result[@"contentType"];
-  if (partContentType != nil) {
-    headers[@"content-type"] = partContentType;
+  if (contentType != nil) {
+    headers[@"content-type"] = contentType;
   }
+  __block BOOL success = YES;
   [headers enumerateKeysAndObjectsUsingBlock:^(NSString *parameterKey, NSString *parameterValue, BOOL *stop) {
-    [multipartBody appendData:[[NSString stringWithFormat:@"%@: %@\r\n", parameterKey, parameterValue]
-                               dataUsingEncoding:NSUTF8StringEncoding]];
+    if (![self writeString:[NSString stringWithFormat:@"%@: %@\r\n", parameterKey, parameterValue]]) {
+      success = NO;
+      *stop = YES;
+    }
   }];
+  return success && [self writeString:@"\r\n"];
+}
 
-  // Add the body.
-  [multipartBody appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-  [multipartBody appendData:result[@"body"]];
-  [multipartBody appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
+- (RCTURLRequestCancellationBlock)processPart
+{
+  // Files are copied into the body as is, rather than loaded into memory
+  NSURL *URL = [RCTConvert NSURL:parts[0][@"uri"]];
+  if (URL.isFileURL) {
+    __block BOOL cancelled = NO;
+    dispatch_async(RCTFormDataQueue(), ^{
+      if (cancelled) {
+        return;
+      }
+      if (![self writePartHeaders:RCTMIMETypeForFileURL(URL)] ||
+          ![self writeFileAtURL:URL] ||
+          ![self writeString:@"\r\n"]) {
+        [self failWithError:_bodyStream.streamError];
+        return;
+      }
+      [self nextPart];
+    });
+    return ^{
+      cancelled = YES;
+    };
+  }
 
+  return [_networker processDataForHTTPQuery:parts[0] callback:^(NSError *error, NSDictionary *result) {
+    return [self handleResult:result error:error];
+  }];
+}
+
+- (RCTURLRequestCancellationBlock)handleResult:(NSDictionary *)result
+                                         error:(NSError *)error
+{
+  if (error) {
+    return [self failWithError:error];
+  }
+
+  __block BOOL cancelled = NO;
+  dispatch_async(RCTFormDataQueue(), ^{
+    if (cancelled) {
+      return;
+    }
+    if (![self writePartHeaders:result[@"contentType"]] ||
+        ![self writeData:result[@"body"]] ||
+        ![self writeString:@"\r\n"]) {
+      [self failWithError:_bodyStream.streamError];
+      return;
+    }
+    [self nextPart];
+  });
+  return ^{
+    cancelled = YES;
+  };
+}
+
+/**
+ * Called on the form data queue once a part has been written.
+ */
+- (void)nextPart
+{
   [parts removeObjectAtIndex:0];
   if (parts.count) {
-    return [_networker processDataForHTTPQuery:parts[0] callback:^(NSError *err, NSDictionary *res) {
-      return [self handleResult:res error:err];
-    }];
+    [self processPart];
+    return;
   }
 
   // We've processed the last item. Finish and return.
-  [multipartBody appendData:[[NSString stringWithFormat:@"--%@--\r\n", boundary]
-                             dataUsingEncoding:NSUTF8StringEncoding]];
+  if (![self writeString:[NSString stringWithFormat:@"--%@--\r\n", boundary]]) {
+    [self failWithError:_bodyStream.streamError];
+    return;
+  }
+  [_bodyStream close];
+  _bodyStream = nil;
+
   NSString *contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=\"%@\"", boundary];
-  return _callback(nil, @{@"body": multipartBody, @"contentType": contentType});
+  _callback(nil, @{@"bodyFile": _bodyURL, @"contentType": contentType});
+}
+
+@end
+
+/**
+ * Splits the data of an incremental response into the chunks that are sent to
+ * JS, or writes it to a file instead. Chunks never end in the middle of a
+ * UTF-8 sequence (for text) or of a 3 byte group (for base64), so that they
+ * can be decoded on their own and simply concatenated in JS.
+ */
+@interface RCTHTTPResponseStream : NSObject
+
+@property (nonatomic, readonly) RCTNetworkResponseType responseType;
+@property (nonatomic, readonly) BOOL writesToFile;
+
+- (instancetype)initWithResponseType:(RCTNetworkResponseType)responseType
+                           chunkSize:(NSUInteger)chunkSize NS_DESIGNATED_INITIALIZER;
+
+- (BOOL)openFileAtPath:(NSString *)path error:(NSError **)error;
+
+/**
+ * Returns the next chunk that is ready to be sent, or nil if the data should
+ * be held back until more has arrived. When writing to a file, the data is
+ * written straight away and nil is returned.
+ */
+- (NSData *)appendData:(NSData *)data error:(NSError **)error;
+
+/**
+ * Returns whatever is still held back, and closes the file if there is one.
+ */
+- (NSData *)finish;
+
+/**
+ * Closes and deletes the file, if there is one.
+ */
+- (void)discard;
+
+@end
+
+@implementation RCTHTTPResponseStream
+{
+  NSUInteger _chunkSize;
+  NSMutableData *_pendingData;
+  NSString *_path;
+  NSOutputStream *_fileStream;
+}
+
+- (instancetype)initWithResponseType:(RCTNetworkResponseType)responseType
+                           chunkSize:(NSUInteger)chunkSize
+{
+  if ((self = [super init])) {
+    _responseType = responseType;
+    _chunkSize = chunkSize;
+    _pendingData = [NSMutableData new];
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (BOOL)writesToFile
+{
+  return _fileStream != nil;
+}
+
+- (BOOL)openFileAtPath:(NSString *)path error:(NSError **)error
+{
+  NSString *directory = path.stringByDeletingLastPathComponent;
+  if (![[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                 withIntermediateDirectories:YES
+                                                  attributes:nil
+                                                       error:error]) {
+    return NO;
+  }
+  NSOutputStream *fileStream = [NSOutputStream outputStreamToFileAtPath:path append:NO];
+  [fileStream open];
+  if (fileStream.streamStatus != NSStreamStatusOpen) {
+    if (error) {
+      *error = fileStream.streamError ?: RCTErrorWithMessage([NSString stringWithFormat:
+        @"Could not open %@ for writing", path]);
+    }
+    return NO;
+  }
+  _path = path;
+  _fileStream = fileStream;
+  return YES;
+}
+
+/**
+ * Returns how many bytes at the start of the data can be decoded without
+ * the bytes that follow them.
+ */
+static NSUInteger RCTCompleteLength(NSData *data, RCTNetworkResponseType responseType)
+{
+  NSUInteger length = data.length;
+  if (responseType == RCTNetworkResponseTypeBase64) {
+    return length - length % 3;
+  }
+
+  // Find the start of the last UTF-8 sequence and check that it is complete
+  const uint8_t *bytes = data.bytes;
+  for (NSUInteger i = length; i > 0 && length - i < 4; i--) {
+    uint8_t byte = bytes[i - 1];
+    if ((byte & 0xC0) != 0x80) {
+      NSUInteger sequenceLength = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+      return (length - (i - 1) < sequenceLength) ? i - 1 : length;
+    }
+  }
+  return length;
+}
+
+- (NSData *)appendData:(NSData *)data error:(NSError **)error
+{
+  if (_fileStream) {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger written = 0;
+    while (written < data.length) {
+      NSInteger result = [_fileStream write:bytes + written maxLength:data.length - written];
+      if (result <= 0) {
+        if (error) {
+          *error = _fileStream.streamError ?: RCTErrorWithMessage([NSString stringWithFormat:
+            @"Could not write to %@", _path]);
+        }
+        return nil;
+      }
+      written += result;
+    }
+    return nil;
+  }
+
+  [_pendingData appendData:data];
+  if (_pendingData.length < MAX(_chunkSize, 1)) {
+    return nil;
+  }
+  NSUInteger length = RCTCompleteLength(_pendingData, _responseType);
+  if (length == 0) {
+    return nil;
+  }
+  NSData *chunk = [_pendingData subdataWithRange:NSMakeRange(0, length)];
+  [_pendingData replaceBytesInRange:NSMakeRange(0, length) withBytes:NULL length:0];
+  return chunk;
+}
+
+- (NSData *)finish
+{
+  [_fileStream close];
+  _fileStream = nil;
+
+  NSData *chunk = _pendingData;
+  _pendingData = [NSMutableData new];
+  return chunk;
+}
+
+- (void)discard
+{
+  if (_fileStream) {
+    [_fileStream close];
+    _fileStream = nil;
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:NULL];
+  }
+  _pendingData = [NSMutableData new];
 }
 
 @end
@@ -144,6 +463,7 @@ RCT_EXPORT_MODULE()
   NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
   request.HTTPMethod = [RCTConvert NSString:RCTNilIfNull(query[@"method"])].uppercaseString ?: @"GET";
   request.allHTTPHeaderFields = [RCTConvert NSDictionary:query[@"headers"]];
+  RCTSetHTTPRequestCachePolicy(request, [RCTConvert RCTHTTPCachePolicy:RCTNilIfNull(query[@"cachePolicy"])]);
 
   NSDictionary *data = [RCTConvert NSDictionary:RCTNilIfNull(query[@"data"])];
   return [self processDataForHTTPQuery:data callback:^(NSError *error, NSDictionary *result) {
@@ -159,7 +479,20 @@ RCT_EXPORT_MODULE()
     }
 
     // Gzip the request body
-    if ([request.allHTTPHeaderFields[@"Content-Encoding"] isEqualToString:@"gzip"]) {
+    BOOL gzip = [request.allHTTPHeaderFields[@"Content-Encoding"] isEqualToString:@"gzip"];
+    NSURL *bodyFile = result[@"bodyFile"];
+    if (bodyFile && gzip) {
+      // Compressing needs the whole body in memory anyway
+      request.HTTPBody = [NSData dataWithContentsOfURL:bodyFile options:NSDataReadingMappedIfSafe error:NULL];
+      [[NSFileManager defaultManager] removeItemAtURL:bodyFile error:NULL];
+    } else if (bodyFile) {
+      RCTSetHTTPRequestBodyFile(request, bodyFile);
+      NSNumber *length = [bodyFile resourceValuesForKeys:@[NSURLFileSizeKey] error:NULL][NSURLFileSizeKey];
+      if (length) {
+        [request setValue:length.description forHTTPHeaderField:@"Content-Length"];
+      }
+    }
+    if (gzip) {
       request.HTTPBody = RCTGzipData(request.HTTPBody, -1 /* default */);
       [request setValue:(@(request.HTTPBody.length)).description forHTTPHeaderField:@"Content-Length"];
     }
@@ -257,12 +590,21 @@ RCT_EXPORT_MODULE()
   return callback(nil, nil);
 }
 
-- (void)sendData:(NSData *)data forTask:(RCTDownloadTask *)task
+- (void)sendData:(NSData *)data
+    responseType:(RCTNetworkResponseType)responseType
+         forTask:(RCTDownloadTask *)task
 {
   if (data.length == 0) {
     return;
   }
 
+  if (responseType == RCTNetworkResponseTypeBase64) {
+    NSArray *responseJSON = @[task.requestID, [data base64EncodedStringWithOptions:0]];
+    [_bridge.eventDispatcher sendDeviceEventWithName:@"didReceiveNetworkData"
+                                                body:responseJSON];
+    return;
+  }
+
   // Get text encoding
   NSURLResponse *response = task.response;
   NSStringEncoding encoding = NSUTF8StringEncoding;
@@ -299,13 +641,36 @@ RCT_EXPORT_MODULE()
                                               body:responseJSON];
 }
 
+- (void)sendCompletionForTask:(RCTDownloadTask *)task error:(NSError *)error
+{
+  RCTRemoveHTTPRequestBodyFile(task.request);
+
+  NSArray *responseJSON = @[task.requestID,
+                            RCTNullIfNil(error.localizedDescription),
+                            ];
+
+  [_bridge.eventDispatcher sendDeviceEventWithName:@"didCompleteNetworkResponse"
+                                              body:responseJSON];
+
+  [_tasksByRequestID removeObjectForKey:task.requestID];
+}
+
 - (void)sendRequest:(NSURLRequest *)request
  incrementalUpdates:(BOOL)incrementalUpdates
+     uploadProgress:(BOOL)uploadProgress
+   progressInterval:(NSTimeInterval)progressInterval
+progressGranularity:(double)progressGranularity
+     responseStream:(RCTHTTPResponseStream *)responseStream
+       downloadPath:(NSString *)downloadPath
      responseSender:(RCTResponseSenderBlock)responseSender
 {
   __block RCTDownloadTask *task;
 
-  RCTURLRequestProgressBlock uploadProgressBlock = ^(int64_t progress, int64_t total) {
+  // Streamed responses are sent to JS (or written to disk) as they arrive,
+  // so there's no need to keep a copy of the whole response here as well
+  BOOL streamsResponse = incrementalUpdates || downloadPath;
+
+  RCTURLRequestProgressBlock uploadProgressBlock = !uploadProgress ? nil : ^(int64_t progress, int64_t total) {
     dispatch_async(_methodQueue, ^{
       NSArray *responseJSON = @[task.requestID, @((double)progress), @((double)total)];
       [_bridge.eventDispatcher sendDeviceEventWithName:@"didSendNetworkData" body:responseJSON];
@@ -329,37 +694,55 @@ RCT_EXPORT_MODULE()
     });
   };
 
-  void (^incrementalDataBlock)(NSData *) = incrementalUpdates ? ^(NSData *data) {
+  void (^incrementalDataBlock)(NSData *) = streamsResponse ? ^(NSData *data) {
     dispatch_async(_methodQueue, ^{
-      [self sendData:data forTask:task];
+      if (!_tasksByRequestID[task.requestID]) {
+        // Cancelled, or the file could not be written
+        return;
+      }
+      NSError *error;
+      NSData *chunk = [responseStream appendData:data error:&error];
+      if (error) {
+        [task cancel];
+        [responseStream discard];
+        [self sendCompletionForTask:task error:error];
+        return;
+      }
+      [self sendData:chunk responseType:responseStream.responseType forTask:task];
     });
   } : nil;
 
   RCTURLRequestCompletionBlock completionBlock =
   ^(NSURLResponse *response, NSData *data, NSError *error) {
     dispatch_async(_methodQueue, ^{
-      if (!incrementalUpdates) {
-        [self sendData:data forTask:task];
+      if (error) {
+        [responseStream discard];
+      } else if (streamsResponse) {
+        [self sendData:[responseStream finish] responseType:responseStream.responseType forTask:task];
+      } else {
+        [self sendData:data responseType:responseStream.responseType forTask:task];
       }
-      NSArray *responseJSON = @[task.requestID,
-                                RCTNullIfNil(error.localizedDescription),
-                                ];
-
-      [_bridge.eventDispatcher sendDeviceEventWithName:@"didCompleteNetworkResponse"
-                                                  body:responseJSON];
-
-      [_tasksByRequestID removeObjectForKey:task.requestID];
+      [self sendCompletionForTask:task error:error];
     });
   };
 
   task = [self downloadTaskWithRequest:request completionBlock:completionBlock];
+  task.buffersData = !streamsResponse;
   task.incrementalDataBlock = incrementalDataBlock;
   task.responseBlock = responseBlock;
   task.uploadProgressBlock = uploadProgressBlock;
+  task.progressInterval = progressInterval;
+  task.progressGranularity = progressGranularity;
 
   if (task.requestID) {
     _tasksByRequestID[task.requestID] = task;
     responseSender(@[task.requestID]);
+
+    NSError *error;
+    if (downloadPath && ![responseStream openFileAtPath:downloadPath error:&error]) {
+      [task cancel];
+      [self sendCompletionForTask:task error:error];
+    }
   }
 }
 
@@ -389,15 +772,32 @@ RCT_EXPORT_METHOD(sendRequest:(NSDictionary *)query
   [self buildRequest:query completionBlock:^(NSURLRequest *request) {
 
     BOOL incrementalUpdates = [RCTConvert BOOL:query[@"incrementalUpdates"]];
+    RCTNetworkResponseType responseType = [RCTConvert RCTNetworkResponseType:query[@"responseType"]];
+    NSUInteger chunkSize = [RCTConvert NSUInteger:query[@"chunkSize"]];
+    NSString *downloadPath = [RCTConvert NSString:RCTNilIfNull(query[@"downloadPath"])];
+    BOOL uploadProgress = query[@"uploadProgress"] ? [RCTConvert BOOL:query[@"uploadProgress"]] : YES;
+    NSTimeInterval progressInterval = RCTNilIfNull(query[@"progressInterval"]) ?
+      [RCTConvert NSTimeInterval:query[@"progressInterval"]] : RCTNetworkingDefaultProgressInterval;
+    double progressGranularity = [RCTConvert double:RCTNilIfNull(query[@"progressGranularity"])];
+    RCTHTTPResponseStream *responseStream =
+      [[RCTHTTPResponseStream alloc] initWithResponseType:responseType
+                                                chunkSize:chunkSize];
     [self sendRequest:request
    incrementalUpdates:incrementalUpdates
+       uploadProgress:uploadProgress
+     progressInterval:progressInterval
+  progressGranularity:progressGranularity
+       responseStream:responseStream
+         downloadPath:downloadPath.stringByExpandingTildeInPath
        responseSender:responseSender];
   }];
 }
 
 RCT_EXPORT_METHOD(cancelRequest:(nonnull NSNumber *)requestID)
 {
-  [_tasksByRequestID[requestID] cancel];
+  RCTDownloadTask *task = _tasksByRequestID[requestID];
+  RCTRemoveHTTPRequestBodyFile(task.request);
+  [task cancel];
   [_tasksByRequestID removeObjectForKey:requestID];
 }
 
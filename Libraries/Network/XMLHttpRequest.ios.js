@@ -25,11 +25,40 @@ class XMLHttpRequest extends XMLHttpRequestBase {
     onprogress?: (event: Object) => void;
   };
 
+  // Non-standard extensions for large responses:
+  //
+  // - responseType: 'base64' delivers the body base64 encoded in responseText,
+  //   which lets binary data through. Defaults to 'text'.
+  // - chunkSize: when set, incremental updates are held back until at least
+  //   this many bytes have arrived, so fewer events cross the bridge.
+  // - downloadPath: writes the body to this file instead of responseText,
+  //   without ever holding the whole response in memory.
+  // - progressInterval: the minimum time in ms between upload progress
+  //   events. Defaults to 50.
+  // - progressGranularity: the minimum progress, as a fraction of the total,
+  //   between upload progress events. The final progress is always reported.
+  // - cachePolicy: how a GET uses the native response cache, like the `cache`
+  //   option of fetch: 'default', 'no-store', 'reload', 'no-cache',
+  //   'force-cache' or 'only-if-cached'. Defaults to 'default', which follows
+  //   the Cache-Control and validators of the response.
+  responseType: ?string;
+  chunkSize: ?number;
+  downloadPath: ?string;
+  progressInterval: ?number;
+  progressGranularity: ?number;
+  cachePolicy: ?string;
+
   constructor() {
     super();
     this._requestId = null;
     this._subscriptions = [];
     this.upload = {};
+    this.responseType = null;
+    this.chunkSize = null;
+    this.downloadPath = null;
+    this.progressInterval = null;
+    this.progressGranularity = null;
+    this.cachePolicy = null;
   }
 
   _didCreateRequest(requestId: number): void {
@@ -114,6 +143,14 @@ class XMLHttpRequest extends XMLHttpRequestBase {
         data,
         headers,
         incrementalUpdates: this.onreadystatechange ? true : false,
+        responseType: this.responseType || 'text',
+        chunkSize: this.chunkSize,
+        downloadPath: this.downloadPath,
+        // Like the spec, only listeners set before send() get upload events
+        uploadProgress: this.upload.onprogress ? true : false,
+        progressInterval: this.progressInterval,
+        progressGranularity: this.progressGranularity,
+        cachePolicy: this.cachePolicy,
       },
       this._didCreateRequest.bind(this)
     );
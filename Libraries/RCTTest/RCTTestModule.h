@@ -42,4 +42,11 @@ typedef NS_ENUM(NSInteger, RCTTestStatus) {
  */
 @property (nonatomic, readonly) RCTTestStatus status;
 
+/**
+ * The results a benchmark scene reported with markBenchmarkCompleted(), with
+ * the UI manager's batch stats since startBenchmark() added as "mount". Nil
+ * for other tests.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *benchmarkResults;
+
 @end
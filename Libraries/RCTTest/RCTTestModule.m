@@ -15,9 +15,34 @@
 #import "RCTLog.h"
 #import "RCTUIManager.h"
 
+/**
+ * Adds the stats of one UI batch to the totals of a benchmark. Times are in ms.
+ */
+static void RCTTestAddBatchStats(NSMutableDictionary *totals, NSDictionary *stats)
+{
+  void (^add)(NSString *, double) = ^(NSString *key, double value) {
+    totals[key] = @([totals[key] doubleValue] + value);
+  };
+
+  add(@"batches", 1);
+  for (NSDictionary *layout in stats[@"layout"]) {
+    add(@"layoutPasses", 1);
+    add(@"layoutTime", [layout[@"duration"] doubleValue] * 1000);
+    add(@"visitedNodes", [layout[@"visitedNodes"] doubleValue]);
+    add(@"relaidOutNodes", [layout[@"relaidOutNodes"] doubleValue]);
+  }
+  for (NSString *key in @[@"createdViews", @"updatedViews", @"removedViews", @"uiBlockCount"]) {
+    add(key, [stats[key] doubleValue]);
+  }
+  double uiBlockTime = [stats[@"uiBlockDuration"] doubleValue] * 1000;
+  add(@"uiBlockTime", uiBlockTime);
+  totals[@"maxUIBlockTime"] = @(MAX([totals[@"maxUIBlockTime"] doubleValue], uiBlockTime));
+}
+
 @implementation RCTTestModule
 {
   NSMutableDictionary *_snapshotCounter;
+  NSMutableDictionary *_mountStats;
 }
 
 @synthesize bridge = _bridge;
@@ -70,6 +95,29 @@ RCT_REMAP_METHOD(shouldReject, shouldReject_resolve:(RCTPromiseResolveBlock)reso
   reject(nil);
 }
 
+RCT_EXPORT_METHOD(startBenchmark)
+{
+  // Only touched on the main thread, where batch stats are delivered
+  NSMutableDictionary *mountStats = [NSMutableDictionary new];
+  _mountStats = mountStats;
+  _bridge.uiManager.batchStatsBlock = ^(NSDictionary *stats) {
+    RCTTestAddBatchStats(mountStats, stats);
+  };
+}
+
+RCT_EXPORT_METHOD(markBenchmarkCompleted:(NSDictionary *)results)
+{
+  NSMutableDictionary *mountStats = _mountStats;
+  _mountStats = nil;
+  [_bridge.uiManager addUIBlock:^(RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
+    uiManager.batchStatsBlock = nil;
+    NSMutableDictionary *benchmarkResults = [results mutableCopy];
+    benchmarkResults[@"mount"] = [mountStats copy] ?: @{};
+    _benchmarkResults = [benchmarkResults copy];
+    _status = RCTTestStatusPassed;
+  }];
+}
+
 RCT_EXPORT_METHOD(markTestCompleted)
 {
   [self markTestPassed:YES];
@@ -26,6 +26,13 @@
 @property (nonatomic, assign) BOOL recordMode;
 @property (nonatomic, strong) NSURL *scriptURL;
 
+/**
+ * Where the results of benchmark scenes are written, as <test name>.json.
+ * Defaults to the RCT_BENCHMARK_DIR environment variable, or to a Benchmarks
+ * directory in the temporary directory.
+ */
+@property (nonatomic, copy) NSString *benchmarkDirectory;
+
 /**
  * Initialize a runner.  It's recommended that you use the RCTInitRunnerForApp
  * macro instead of calling this directly.
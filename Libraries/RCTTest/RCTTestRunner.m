@@ -39,6 +39,8 @@ static const NSTimeInterval kTestTeardownTimeoutSeconds = 30;
     _testController = [[FBSnapshotTestController alloc] initWithTestName:sanitizedAppName];
     _testController.referenceImagesDirectory = referenceDirectory;
     _moduleProvider = [block copy];
+    _benchmarkDirectory = [NSProcessInfo processInfo].environment[@"RCT_BENCHMARK_DIR"] ?:
+      [NSTemporaryDirectory() stringByAppendingPathComponent:@"Benchmarks"];
 
 #if RUNNING_ON_CI
     _scriptURL = [[NSBundle bundleForClass:[RCTBridge class]] URLForResource:@"main" withExtension:@"jsbundle"];
@@ -52,6 +54,25 @@ static const NSTimeInterval kTestTeardownTimeoutSeconds = 30;
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
+- (void)writeBenchmarkResults:(NSDictionary *)results test:(SEL)test
+{
+  NSError *error;
+  NSString *JSON = RCTJSONStringify(results, &error);
+  RCTAssert(JSON != nil, @"Benchmark results aren't valid JSON: %@", error.localizedDescription);
+
+  [[NSFileManager defaultManager] createDirectoryAtPath:_benchmarkDirectory
+                            withIntermediateDirectories:YES
+                                             attributes:nil
+                                                  error:NULL];
+  NSString *path = [[_benchmarkDirectory stringByAppendingPathComponent:NSStringFromSelector(test)]
+                    stringByAppendingPathExtension:@"json"];
+  if (![JSON writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:&error]) {
+    RCTAssert(NO, @"Couldn't write benchmark results to %@: %@", path, error.localizedDescription);
+  }
+  // One line per scene, for collecting the results from device logs
+  NSLog(@"RCTBenchmark %@ %@", NSStringFromSelector(test), JSON);
+}
+
 - (void)setRecordMode:(BOOL)recordMode
 {
   _testController.recordMode = recordMode;
@@ -131,6 +152,9 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
       RCTAssert(testModule.status != RCTTestStatusPending, @"Test didn't finish within %0.f seconds", kTestTimeoutSeconds);
       RCTAssert(testModule.status == RCTTestStatusPassed, @"Test failed");
     }
+    if (testModule.benchmarkResults) {
+      [self writeBenchmarkResults:testModule.benchmarkResults test:test];
+    }
     [bridge invalidate];
   }
 
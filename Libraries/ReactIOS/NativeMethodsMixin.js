@@ -107,7 +107,11 @@ var NativeMethodsMixin = {
       }
     }
 
-    RCTUIManager.updateView(
+    // The native side may skip props that equal the ones it was last sent,
+    // which would keep it from resetting a controlled view that the user
+    // changed, so it is told that these come from setNativeProps
+    var updateView = RCTUIManager.setNativeProps || RCTUIManager.updateView;
+    updateView(
       findNodeHandle(this),
       this.viewConfig.uiViewClassName,
       props
@@ -30,6 +30,9 @@ var topLevelTypes = EventConstants.topLevelTypes;
 // Shared default empty native event - conserve memory.
 var EMPTY_NATIVE_EVENT = {};
 
+// Numbers per touch in the payload of `receiveCompactTouches`
+var TOUCH_FIELD_COUNT = 7;
+
 /**
  * Selects a subsequence of `Touch`es, without destroying `touches`.
  *
@@ -208,6 +211,40 @@ var ReactNativeEventEmitter = merge(ReactEventEmitterMixin, {
         nativeEvent
       );
     }
+  },
+
+  /**
+   * Same as `receiveTouches`, but with the touches packed into a flat array of
+   * numbers, `TOUCH_FIELD_COUNT` per touch: target, identifier, pageX, pageY,
+   * locationX, locationY and timestamp. This is how iOS sends touches, since
+   * it's far smaller to serialize than one object per touch.
+   */
+  receiveCompactTouches: function(
+    eventTopLevelType: string,
+    compactTouches: Array<number>,
+    changedIndices: Array<number>
+  ) {
+    var touches = [];
+    for (var ii = 0; ii < compactTouches.length; ii += TOUCH_FIELD_COUNT) {
+      touches.push({
+        target: compactTouches[ii],
+        identifier: compactTouches[ii + 1],
+        pageX: compactTouches[ii + 2],
+        pageY: compactTouches[ii + 3],
+        locationX: compactTouches[ii + 4],
+        locationY: compactTouches[ii + 5],
+        timestamp: compactTouches[ii + 6],
+        // We hijack the touch object to serve both as an event and as a Touch
+        // object, so these are declared up front to make it JIT friendly.
+        touches: null,
+        changedTouches: null,
+      });
+    }
+    ReactNativeEventEmitter.receiveTouches(
+      eventTopLevelType,
+      touches,
+      changedIndices
+    );
   }
 });
 
@@ -26,6 +26,7 @@ ReactNativeViewAttributes.UIView = {
   testID: true,
   renderToHardwareTextureAndroid: true,
   shouldRasterizeIOS: true,
+  asyncDisplayIOS: true,
   onLayout: true,
   onAccessibilityTap: true,
   onMagicTap: true,
@@ -9,32 +9,8 @@
 
 #import "RCTShadowRawText.h"
 
-#import "RCTUIManager.h"
-
 @implementation RCTShadowRawText
 
-- (instancetype)init
-{
-  if ((self = [super init])) {
-    [[NSNotificationCenter defaultCenter] addObserver:self
-                                             selector:@selector(contentSizeMultiplierDidChange:)
-                                                 name:RCTUIManagerWillUpdateViewsDueToContentSizeMultiplierChangeNotification
-                                               object:nil];
-  }
-  return self;
-}
-
-- (void)dealloc
-{
-  [[NSNotificationCenter defaultCenter] removeObserver:self];
-}
-
-- (void)contentSizeMultiplierDidChange:(NSNotification *)note
-{
-  [self dirtyLayout];
-  [self dirtyText];
-}
-
 - (void)setText:(NSString *)text
 {
   if (_text != text) {
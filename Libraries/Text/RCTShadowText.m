@@ -17,6 +17,7 @@
 #import "RCTShadowRawText.h"
 #import "RCTSparseArray.h"
 #import "RCTText.h"
+#import "RCTTextLayout.h"
 #import "RCTUtils.h"
 
 NSString *const RCTIsHighlightedAttributeName = @"IsHighlightedAttributeName";
@@ -24,26 +25,59 @@ NSString *const RCTReactTagAttributeName = @"ReactTagAttributeName";
 
 @implementation RCTShadowText
 {
-  NSTextStorage *_cachedTextStorage;
-  CGFloat _cachedTextStorageWidth;
+  RCTTextLayout *_cachedTextLayout;
+  CGFloat _cachedTextLayoutWidth;
   NSAttributedString *_cachedAttributedString;
+  NSArray *_cachedInheritedAttributes;
+  BOOL _attributedStringDirty;
+  NSAttributedString *_scaledAttributedString;
+  NSAttributedString *_scaledAttributedStringSource;
+  CGFloat _scaledFontSizeMultiplier;
   CGFloat _effectiveLetterSpacing;
+  BOOL _hasMeasurement;
+  CGFloat _measuredMaxWidth;
+  CGFloat _measuredUsedWidth;
+  css_measure_result_t _measurement;
 }
 
-static css_dim_t RCTMeasure(void *context, float width)
+static css_measure_result_t RCTMeasure(void *context,
+                                       float width,
+                                       css_measure_mode_t widthMode,
+                                       __unused float height,
+                                       __unused css_measure_mode_t heightMode)
 {
   RCTShadowText *shadowText = (__bridge RCTShadowText *)context;
-  NSTextStorage *textStorage = [shadowText buildTextStorageForWidth:width];
-  NSLayoutManager *layoutManager = textStorage.layoutManagers.firstObject;
-  NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
-  CGSize computedSize = [layoutManager usedRectForTextContainer:textContainer].size;
 
-  css_dim_t result;
+  // Text laid out in a width W that needed U <= W of it breaks into the same
+  // lines for any width between U and W, so those reuse the last measurement.
+  // Truncated text is the exception, the ellipsis moves with the width.
+  // Widths are compared as the text container width textLayoutForWidth: uses,
+  // so a padding change is taken into account.
+  UIEdgeInsets padding = shadowText.paddingAsInsets;
+  CGFloat maxWidth = widthMode == CSS_MEASURE_MODE_UNDEFINED || isnan(width) ?
+    CGFLOAT_MAX : width - (padding.left + padding.right);
+  if (shadowText->_hasMeasurement &&
+      shadowText->_numberOfLines == 0 &&
+      maxWidth >= shadowText->_measuredUsedWidth &&
+      maxWidth <= shadowText->_measuredMaxWidth) {
+    return shadowText->_measurement;
+  }
+
+  RCTTextLayout *textLayout = [shadowText textLayoutForWidth:width];
+  CGSize computedSize = textLayout.usedSize;
+
+  css_measure_result_t result;
   result.dimensions[CSS_WIDTH] = RCTCeilPixelValue(computedSize.width);
   if (shadowText->_effectiveLetterSpacing < 0) {
     result.dimensions[CSS_WIDTH] -= shadowText->_effectiveLetterSpacing;
   }
   result.dimensions[CSS_HEIGHT] = RCTCeilPixelValue(computedSize.height);
+  result.baseline = isnan(textLayout.baseline) ? CSS_UNDEFINED : textLayout.baseline;
+
+  shadowText->_hasMeasurement = YES;
+  shadowText->_measuredMaxWidth = maxWidth;
+  shadowText->_measuredUsedWidth = computedSize.width;
+  shadowText->_measurement = result;
   return result;
 }
 
@@ -73,23 +107,29 @@ static css_dim_t RCTMeasure(void *context, float width)
   return [[superDescription substringToIndex:superDescription.length - 1] stringByAppendingFormat:@"; text: %@>", [self attributedString].string];
 }
 
+/**
+ * The fragments of a text tree don't depend on the font size multiplier, only
+ * the scaled copy the outermost text lays out does. So a content size change
+ * only needs the outermost text to be revisited, which then rescales its fonts
+ * rather than rebuilding every fragment below it.
+ */
 - (void)contentSizeMultiplierDidChange:(NSNotification *)note
 {
-  [self dirtyLayout];
-  [self dirtyText];
+  if (![self.superview isKindOfClass:[RCTShadowText class]]) {
+    [self dirtyLayout];
+    [super dirtyText];
+  }
 }
 
-- (NSDictionary *)processUpdatedProperties:(NSMutableSet *)applierBlocks
+- (NSDictionary *)processUpdatedProperties:(RCTViewPropertyUpdates *)updates
                           parentProperties:(NSDictionary *)parentProperties
 {
-  parentProperties = [super processUpdatedProperties:applierBlocks
+  parentProperties = [super processUpdatedProperties:updates
                                     parentProperties:parentProperties];
 
-  NSTextStorage *textStorage = [self buildTextStorageForWidth:self.frame.size.width];
-  [applierBlocks addObject:^(RCTSparseArray *viewRegistry) {
-    RCTText *view = viewRegistry[self.reactTag];
-    view.textStorage = textStorage;
-  }];
+  [updates addUpdateForReactTag:self.reactTag
+                         setter:@selector(setTextLayout:)
+                          value:[self textLayoutForWidth:self.frame.size.width]];
 
   return parentProperties;
 }
@@ -102,39 +142,28 @@ static css_dim_t RCTMeasure(void *context, float width)
   [self dirtyPropagation];
 }
 
-- (NSTextStorage *)buildTextStorageForWidth:(CGFloat)width
+- (RCTTextLayout *)textLayoutForWidth:(CGFloat)width
 {
   UIEdgeInsets padding = self.paddingAsInsets;
   width -= (padding.left + padding.right);
 
-  if (_cachedTextStorage && width == _cachedTextStorageWidth) {
-    return _cachedTextStorage;
+  if (_cachedTextLayout && width == _cachedTextLayoutWidth) {
+    return _cachedTextLayout;
   }
 
-  NSLayoutManager *layoutManager = [NSLayoutManager new];
-
-  NSTextStorage *textStorage = [[NSTextStorage alloc] initWithAttributedString:self.attributedString];
-  [textStorage addLayoutManager:layoutManager];
-
-  NSTextContainer *textContainer = [NSTextContainer new];
-  textContainer.lineFragmentPadding = 0.0;
-  textContainer.lineBreakMode = _numberOfLines > 0 ? NSLineBreakByTruncatingTail : NSLineBreakByClipping;
-  textContainer.maximumNumberOfLines = _numberOfLines;
-  textContainer.size = (CGSize){isnan(width) ? CGFLOAT_MAX : width, CGFLOAT_MAX};
-
-  [layoutManager addTextContainer:textContainer];
-  [layoutManager ensureLayoutForTextContainer:textContainer];
-
-  _cachedTextStorageWidth = width;
-  _cachedTextStorage = textStorage;
-
-  return textStorage;
+  _cachedTextLayoutWidth = width;
+  _cachedTextLayout = [RCTTextLayout layoutWithAttributedString:self.attributedString
+                                                          width:width
+                                                  numberOfLines:_numberOfLines];
+  return _cachedTextLayout;
 }
 
 - (void)dirtyText
 {
   [super dirtyText];
-  _cachedTextStorage = nil;
+  _attributedStringDirty = YES;
+  _cachedTextLayout = nil;
+  _hasMeasurement = NO;
 }
 
 - (void)recomputeText
@@ -144,14 +173,55 @@ static css_dim_t RCTMeasure(void *context, float width)
   [self dirtyPropagation];
 }
 
+/**
+ * Fragments are built at a multiplier of 1. This scales the fonts and line
+ * heights of one the way RCTConvert and the paragraph style would have.
+ */
+static NSAttributedString *RCTScaleAttributedString(NSAttributedString *attributedString,
+                                                    CGFloat fontSizeMultiplier)
+{
+  NSMutableAttributedString *scaledString = [attributedString mutableCopy];
+  NSRange range = NSMakeRange(0, scaledString.length);
+  [scaledString beginEditing];
+  [attributedString enumerateAttribute:NSFontAttributeName inRange:range options:0 usingBlock:^(UIFont *font, NSRange fontRange, BOOL *stop) {
+    if (font) {
+      [scaledString addAttribute:NSFontAttributeName
+                           value:[font fontWithSize:round(font.pointSize * fontSizeMultiplier)]
+                           range:fontRange];
+    }
+  }];
+  [attributedString enumerateAttribute:NSParagraphStyleAttributeName inRange:range options:0 usingBlock:^(NSParagraphStyle *paragraphStyle, NSRange styleRange, BOOL *stop) {
+    if (paragraphStyle.maximumLineHeight > 0) {
+      NSMutableParagraphStyle *scaledStyle = [paragraphStyle mutableCopy];
+      scaledStyle.minimumLineHeight = round(paragraphStyle.minimumLineHeight * fontSizeMultiplier);
+      scaledStyle.maximumLineHeight = round(paragraphStyle.maximumLineHeight * fontSizeMultiplier);
+      [scaledString addAttribute:NSParagraphStyleAttributeName value:scaledStyle range:styleRange];
+    }
+  }];
+  [scaledString endEditing];
+  return [[NSAttributedString alloc] initWithAttributedString:scaledString];
+}
+
 - (NSAttributedString *)attributedString
 {
-  return [self _attributedStringWithFontFamily:nil
-                                      fontSize:nil
-                                    fontWeight:nil
-                                     fontStyle:nil
-                                 letterSpacing:nil
-                            useBackgroundColor:NO];
+  NSAttributedString *attributedString = [self _attributedStringWithFontFamily:nil
+                                                                      fontSize:nil
+                                                                    fontWeight:nil
+                                                                     fontStyle:nil
+                                                                 letterSpacing:nil
+                                                            useBackgroundColor:NO];
+
+  CGFloat fontSizeMultiplier = _allowFontScaling && _fontSizeMultiplier > 0.0 ? _fontSizeMultiplier : 1.0;
+  if (fontSizeMultiplier == 1.0) {
+    return attributedString;
+  }
+  if (_scaledAttributedStringSource != attributedString ||
+      _scaledFontSizeMultiplier != fontSizeMultiplier) {
+    _scaledAttributedString = RCTScaleAttributedString(attributedString, fontSizeMultiplier);
+    _scaledAttributedStringSource = attributedString;
+    _scaledFontSizeMultiplier = fontSizeMultiplier;
+  }
+  return _scaledAttributedString;
 }
 
 - (NSAttributedString *)_attributedStringWithFontFamily:(NSString *)fontFamily
@@ -161,7 +231,19 @@ static css_dim_t RCTMeasure(void *context, float width)
                                           letterSpacing:(NSNumber *)letterSpacing
                                      useBackgroundColor:(BOOL)useBackgroundColor
 {
-  if (![self isTextDirty] && _cachedAttributedString) {
+  // Each text keeps the fragment it built last, and only rebuilds it when it or
+  // one of its descendants was dirtied, or when what it inherits changed. So an
+  // edit to one span only rebuilds the fragments on its way to the outermost text.
+  NSArray *inheritedAttributes = @[
+    fontFamily ?: (id)kCFNull,
+    fontSize ?: (id)kCFNull,
+    fontWeight ?: (id)kCFNull,
+    fontStyle ?: (id)kCFNull,
+    letterSpacing ?: (id)kCFNull,
+    @(useBackgroundColor),
+  ];
+  if (!_attributedStringDirty && _cachedAttributedString &&
+      [_cachedInheritedAttributes isEqualToArray:inheritedAttributes]) {
     return _cachedAttributedString;
   }
 
@@ -210,7 +292,7 @@ static css_dim_t RCTMeasure(void *context, float width)
 
   UIFont *font = [RCTConvert UIFont:nil withFamily:fontFamily
                                size:fontSize weight:fontWeight style:fontStyle
-                    scaleMultiplier:(_allowFontScaling && _fontSizeMultiplier > 0.0 ? _fontSizeMultiplier : 1.0)];
+                    scaleMultiplier:1.0];
   [self _addAttribute:NSFontAttributeName withValue:font toAttributedString:attributedString];
   [self _addAttribute:NSKernAttributeName withValue:letterSpacing toAttributedString:attributedString];
   [self _addAttribute:RCTReactTagAttributeName withValue:self.reactTag toAttributedString:attributedString];
@@ -218,6 +300,8 @@ static css_dim_t RCTMeasure(void *context, float width)
 
   // create a non-mutable attributedString for use by the Text system which avoids copies down the line
   _cachedAttributedString = [[NSAttributedString alloc] initWithAttributedString:attributedString];
+  _cachedInheritedAttributes = inheritedAttributes;
+  _attributedStringDirty = NO;
   [self dirtyLayout];
 
   return _cachedAttributedString;
@@ -252,7 +336,7 @@ static css_dim_t RCTMeasure(void *context, float width)
   [attributedString enumerateAttribute:NSParagraphStyleAttributeName inRange:(NSRange){0, attributedString.length} options:0 usingBlock:^(id value, NSRange range, BOOL *stop) {
     if (value) {
       NSParagraphStyle *paragraphStyle = (NSParagraphStyle *)value;
-      CGFloat maximumLineHeight = round(paragraphStyle.maximumLineHeight / self.fontSizeMultiplier);
+      CGFloat maximumLineHeight = paragraphStyle.maximumLineHeight;
       if (maximumLineHeight > self.lineHeight) {
         self.lineHeight = maximumLineHeight;
       }
@@ -268,9 +352,8 @@ static css_dim_t RCTMeasure(void *context, float width)
     NSMutableParagraphStyle *paragraphStyle = [NSMutableParagraphStyle new];
     paragraphStyle.alignment = _textAlign;
     paragraphStyle.baseWritingDirection = _writingDirection;
-    CGFloat lineHeight = round(_lineHeight * self.fontSizeMultiplier);
-    paragraphStyle.minimumLineHeight = lineHeight;
-    paragraphStyle.maximumLineHeight = lineHeight;
+    paragraphStyle.minimumLineHeight = _lineHeight;
+    paragraphStyle.maximumLineHeight = _lineHeight;
     [attributedString addAttribute:NSParagraphStyleAttributeName
                              value:paragraphStyle
                              range:(NSRange){0, attributedString.length}];
@@ -295,10 +378,31 @@ static css_dim_t RCTMeasure(void *context, float width)
   }
 }
 
+- (uint64_t)layoutContentHash
+{
+  // Built from font names and sizes rather than descriptions, which include
+  // addresses that change with every launch
+  NSAttributedString *attributedString = [self attributedString];
+  NSMutableString *key = [NSMutableString stringWithFormat:@"%zd|%@", _numberOfLines, attributedString.string];
+  [attributedString enumerateAttributesInRange:(NSRange){0, attributedString.length}
+                                       options:0
+                                    usingBlock:^(NSDictionary *attributes, NSRange range, __unused BOOL *stop) {
+    UIFont *font = attributes[NSFontAttributeName];
+    NSParagraphStyle *paragraphStyle = attributes[NSParagraphStyleAttributeName];
+    NSTextAttachment *attachment = attributes[NSAttachmentAttributeName];
+    [key appendFormat:@"|%@ %@ %g %@ %g %g %zd %zd %@",
+     NSStringFromRange(range), font.fontName, font.pointSize, attributes[NSKernAttributeName] ?: @0,
+     paragraphStyle.minimumLineHeight, paragraphStyle.maximumLineHeight,
+     paragraphStyle.alignment, paragraphStyle.baseWritingDirection,
+     attachment ? NSStringFromCGRect(attachment.bounds) : @""];
+  }];
+  return strtoull([RCTMD5Hash(key) substringToIndex:16].UTF8String, NULL, 16) ?: 1;
+}
+
 - (void)fillCSSNode:(css_node_t *)node
 {
   [super fillCSSNode:node];
-  node->measure = RCTMeasure;
+  node->measure_with_mode = RCTMeasure;
   node->children_count = 0;
 }
 
@@ -314,6 +418,12 @@ static css_dim_t RCTMeasure(void *context, float width)
   self.cssNode->children_count = 0;
 }
 
+- (void)reactSetSubviews:(NSArray *)subviews
+{
+  [super reactSetSubviews:subviews];
+  self.cssNode->children_count = 0;
+}
+
 - (void)setBackgroundColor:(UIColor *)backgroundColor
 {
   super.backgroundColor = backgroundColor;
@@ -356,13 +466,20 @@ RCT_TEXT_PROPERTY(WritingDirection, _writingDirection, NSWritingDirection)
 
 - (void)setFontSizeMultiplier:(CGFloat)fontSizeMultiplier
 {
+  if (_fontSizeMultiplier == fontSizeMultiplier) {
+    return;
+  }
   _fontSizeMultiplier = fontSizeMultiplier;
   for (RCTShadowView *child in [self reactSubviews]) {
     if ([child isKindOfClass:[RCTShadowText class]]) {
       ((RCTShadowText *)child).fontSizeMultiplier = fontSizeMultiplier;
     }
   }
-  [self dirtyText];
+
+  // The fragments are unscaled, only the layout of the scaled copy changes
+  _cachedTextLayout = nil;
+  _hasMeasurement = NO;
+  [self dirtyLayout];
 }
 
 @end
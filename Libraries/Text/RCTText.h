@@ -9,9 +9,18 @@
 
 #import <UIKit/UIKit.h>
 
+@class RCTTextLayout;
+
 @interface RCTText : UIView
 
 @property (nonatomic, assign) UIEdgeInsets contentInset;
-@property (nonatomic, strong) NSTextStorage *textStorage;
+@property (nonatomic, strong) RCTTextLayout *textLayout;
+@property (nonatomic, strong, readonly) NSTextStorage *textStorage;
+
+/**
+ * Draw the text on a background queue instead of in -displayLayer:. The
+ * previous text stays on screen until the new one has been drawn.
+ */
+@property (nonatomic, assign) BOOL asyncDisplay;
 
 @end
@@ -9,13 +9,14 @@
 
 #import "RCTText.h"
 
-#import "RCTShadowText.h"
+#import "RCTAsyncDisplay.h"
+#import "RCTTextLayout.h"
 #import "RCTUtils.h"
 #import "UIView+React.h"
 
 @implementation RCTText
 {
-  NSTextStorage *_textStorage;
+  RCTTextLayout *_textLayout;
   NSMutableArray *_reactSubviews;
   CAShapeLayer *_highlightLayer;
 }
@@ -23,7 +24,6 @@
 - (instancetype)initWithFrame:(CGRect)frame
 {
   if ((self = [super initWithFrame:frame])) {
-    _textStorage = [NSTextStorage new];
     _reactSubviews = [NSMutableArray array];
 
     self.isAccessibilityElement = YES;
@@ -67,39 +67,58 @@
   return _reactSubviews;
 }
 
-- (void)setTextStorage:(NSTextStorage *)textStorage
+- (void)setTextLayout:(RCTTextLayout *)textLayout
 {
-  _textStorage = textStorage;
+  _textLayout = textLayout;
   [self setNeedsDisplay];
 }
 
-- (void)drawRect:(CGRect)rect
+- (void)setAsyncDisplay:(BOOL)asyncDisplay
 {
-  NSLayoutManager *layoutManager = _textStorage.layoutManagers.firstObject;
-  NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
-  CGRect textFrame = UIEdgeInsetsInsetRect(self.bounds, _contentInset);
-  NSRange glyphRange = [layoutManager glyphRangeForTextContainer:textContainer];
-
-  [layoutManager drawBackgroundForGlyphRange:glyphRange atPoint:textFrame.origin];
-  [layoutManager drawGlyphsForGlyphRange:glyphRange atPoint:textFrame.origin];
-
-  __block UIBezierPath *highlightPath = nil;
-  NSRange characterRange = [layoutManager characterRangeForGlyphRange:glyphRange actualGlyphRange:NULL];
-  [layoutManager.textStorage enumerateAttribute:RCTIsHighlightedAttributeName inRange:characterRange options:0 usingBlock:^(NSNumber *value, NSRange range, BOOL *_) {
-    if (!value.boolValue) {
-      return;
-    }
+  if (_asyncDisplay == asyncDisplay) {
+    return;
+  }
 
-    [layoutManager enumerateEnclosingRectsForGlyphRange:range withinSelectedGlyphRange:range inTextContainer:textContainer usingBlock:^(CGRect enclosingRect, __unused BOOL *__) {
-      UIBezierPath *path = [UIBezierPath bezierPathWithRoundedRect:CGRectInset(enclosingRect, -2, -2) cornerRadius:2];
-      if (highlightPath) {
-        [highlightPath appendPath:path];
-      } else {
-        highlightPath = path;
-      }
-    }];
-  }];
+  _asyncDisplay = asyncDisplay;
+  [self setNeedsDisplay];
+}
+
+- (NSTextStorage *)textStorage
+{
+  return _textLayout.textStorage;
+}
 
+- (void)displayLayer:(CALayer *)layer
+{
+  RCTCancelAsyncDisplay(layer);
+
+  // Glyphs were laid out on the shadow queue, they only need to be drawn
+  RCTTextLayout *textLayout = _textLayout;
+  const CGSize size = self.bounds.size;
+  const CGPoint origin = UIEdgeInsetsInsetRect(self.bounds, _contentInset).origin;
+  const CGFloat scale = [UIScreen mainScreen].scale;
+  RCTAsyncDisplayBlock displayBlock = ^UIImage *{
+    if (!textLayout.textStorage.length || size.width <= 0 || size.height <= 0) {
+      return nil;
+    }
+    UIGraphicsBeginImageContextWithOptions(size, NO, scale);
+    [textLayout drawAtPoint:origin];
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+  };
+
+  if (_asyncDisplay && !RCTRunningInTestEnvironment()) {
+    RCTDisplayLayerAsynchronously(layer, displayBlock, ^(UIImage *image) {
+      layer.contents = (id)image.CGImage;
+      layer.contentsScale = scale;
+    });
+  } else {
+    layer.contents = (id)displayBlock().CGImage;
+    layer.contentsScale = scale;
+  }
+
+  UIBezierPath *highlightPath = _textLayout.highlightPath;
   if (highlightPath) {
     if (!_highlightLayer) {
       _highlightLayer = [CAShapeLayer layer];
@@ -116,21 +135,7 @@
 
 - (NSNumber *)reactTagAtPoint:(CGPoint)point
 {
-  NSNumber *reactTag = self.reactTag;
-
-  CGFloat fraction;
-  NSLayoutManager *layoutManager = _textStorage.layoutManagers.firstObject;
-  NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
-  NSUInteger characterIndex = [layoutManager characterIndexForPoint:point
-                                                    inTextContainer:textContainer
-                           fractionOfDistanceBetweenInsertionPoints:&fraction];
-
-  // If the point is not before (fraction == 0.0) the first character and not
-  // after (fraction == 1.0) the last character, then the attribute is valid.
-  if (_textStorage.length > 0 && (fraction > 0 || characterIndex > 0) && (fraction < 1 || characterIndex < _textStorage.length - 1)) {
-    reactTag = [_textStorage attribute:RCTReactTagAttributeName atIndex:characterIndex effectiveRange:NULL];
-  }
-  return reactTag;
+  return [_textLayout reactTagAtPoint:point] ?: self.reactTag;
 }
 
 
@@ -139,12 +144,13 @@
   [super didMoveToWindow];
 
   if (!self.window) {
+    RCTCancelAsyncDisplay(self.layer);
     self.layer.contents = nil;
     if (_highlightLayer) {
       [_highlightLayer removeFromSuperlayer];
       _highlightLayer = nil;
     }
-  } else if (_textStorage.length) {
+  } else if (_textLayout.textStorage.length) {
     [self setNeedsDisplay];
   }
 }
@@ -153,7 +159,7 @@
 
 - (NSString *)accessibilityLabel
 {
-  return _textStorage.string;
+  return _textLayout.textStorage.string;
 }
 
 @end
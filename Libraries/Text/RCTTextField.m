@@ -20,6 +20,7 @@
   NSMutableArray *_reactSubviews;
   BOOL _jsRequestingFirstResponder;
   NSInteger _nativeEventCount;
+  NSString *_pendingText;
 }
 
 - (instancetype)initWithEventDispatcher:(RCTEventDispatcher *)eventDispatcher
@@ -42,12 +43,29 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
 - (void)setText:(NSString *)text
 {
   NSInteger eventLag = _nativeEventCount - _mostRecentEventCount;
-  if (eventLag == 0 && ![text isEqualToString:self.text]) {
-    UITextRange *selection = self.selectedTextRange;
-    super.text = text;
-    self.selectedTextRange = selection; // maintain cursor position/selection - this is robust to out of bounds
-  } else if (eventLag > RCTTextUpdateLagWarningThreshold) {
-    RCTLogWarn(@"Native TextInput(%@) is %zd events ahead of JS - try to make your JS faster.", self.text, eventLag);
+  if (eventLag == 0) {
+    // Text that JS echoes back unchanged is left alone
+    _pendingText = nil;
+    if (![text isEqualToString:self.text]) {
+      UITextRange *selection = self.selectedTextRange;
+      super.text = text;
+      self.selectedTextRange = selection; // maintain cursor position/selection - this is robust to out of bounds
+    }
+  } else {
+    // The event count that JS sent along may only be set after the text, so
+    // keep the text around rather than forcing JS to send it again
+    _pendingText = [text copy];
+    if (eventLag > RCTTextUpdateLagWarningThreshold) {
+      RCTLogWarn(@"Native TextInput(%@) is %zd events ahead of JS - try to make your JS faster.", self.text, eventLag);
+    }
+  }
+}
+
+- (void)setMostRecentEventCount:(NSInteger)mostRecentEventCount
+{
+  _mostRecentEventCount = mostRecentEventCount;
+  if (_pendingText && _mostRecentEventCount == _nativeEventCount) {
+    [self setText:_pendingText];
   }
 }
 
@@ -130,6 +148,7 @@ static void RCTUpdatePlaceholder(RCTTextField *self)
 
 - (void)textFieldDidChange
 {
+  _pendingText = nil;
   _nativeEventCount++;
   [_eventDispatcher sendTextEventWithType:RCTTextEventTypeChange
                                  reactTag:self.reactTag
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+/**
+ * Text that has been laid out for a given width, on the shadow queue. Once
+ * created, only its geometry is read on the shadow queue, so the text storage
+ * and its layout manager can be handed over to an RCTText, which only has to
+ * draw the glyphs. Drawing and hit testing are serialized, so the text can be
+ * drawn on a background queue while the main thread handles touches.
+ */
+@interface RCTTextLayout : NSObject
+
+/**
+ * Returns a layout of the attributed string, reusing a recently created one
+ * for an equal string, width and number of lines if there is any.
+ */
++ (instancetype)layoutWithAttributedString:(NSAttributedString *)attributedString
+                                     width:(CGFloat)width
+                             numberOfLines:(NSUInteger)numberOfLines;
+
+- (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
+                                   width:(CGFloat)width
+                           numberOfLines:(NSUInteger)numberOfLines NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Only for reading the text, its layout manager must not be used directly.
+ */
+@property (nonatomic, strong, readonly) NSTextStorage *textStorage;
+
+/**
+ * The size used by the laid out text, and the distance from its top to its
+ * first baseline, or NAN if there are no glyphs.
+ */
+@property (nonatomic, assign, readonly) CGSize usedSize;
+@property (nonatomic, assign, readonly) CGFloat baseline;
+
+/**
+ * The rounded rects around highlighted ranges of text, relative to the text
+ * origin, or nil if nothing is highlighted.
+ */
+@property (nonatomic, strong, readonly) UIBezierPath *highlightPath;
+
+/**
+ * Draws the background and glyphs of the text in the current context.
+ */
+- (void)drawAtPoint:(CGPoint)point;
+
+/**
+ * The tag of the text node under the point, relative to the text origin, or
+ * nil if the point is outside of the text.
+ */
+- (NSNumber *)reactTagAtPoint:(CGPoint)point;
+
+@end
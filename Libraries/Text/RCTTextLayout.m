@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTTextLayout.h"
+
+#import "RCTCache.h"
+#import "RCTDefines.h"
+#import "RCTShadowText.h"
+
+static const NSUInteger RCTTextLayoutCacheCountLimit = 256;
+
+@interface RCTTextLayoutKey : NSObject <NSCopying>
+
+@end
+
+@implementation RCTTextLayoutKey
+{
+  NSAttributedString *_attributedString;
+  CGFloat _width;
+  NSUInteger _numberOfLines;
+}
+
+- (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
+                                   width:(CGFloat)width
+                           numberOfLines:(NSUInteger)numberOfLines
+{
+  if ((self = [super init])) {
+    _attributedString = attributedString;
+    _width = width;
+    _numberOfLines = numberOfLines;
+  }
+  return self;
+}
+
+- (id)copyWithZone:(__unused NSZone *)zone
+{
+  return self;
+}
+
+- (NSUInteger)hash
+{
+  return _attributedString.hash ^ (NSUInteger)_width ^ (_numberOfLines << 16);
+}
+
+- (BOOL)isEqual:(RCTTextLayoutKey *)object
+{
+  if (![object isKindOfClass:[RCTTextLayoutKey class]]) {
+    return NO;
+  }
+  return (_width == object->_width || (isnan(_width) && isnan(object->_width))) &&
+    _numberOfLines == object->_numberOfLines &&
+    [_attributedString isEqualToAttributedString:object->_attributedString];
+}
+
+@end
+
+@implementation RCTTextLayout
+{
+  NSLock *_lock;
+}
+
++ (instancetype)layoutWithAttributedString:(NSAttributedString *)attributedString
+                                     width:(CGFloat)width
+                             numberOfLines:(NSUInteger)numberOfLines
+{
+  static RCTCache *cache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    cache = [RCTCache new];
+    cache.countLimit = RCTTextLayoutCacheCountLimit;
+  });
+
+  RCTTextLayoutKey *key = [[RCTTextLayoutKey alloc] initWithAttributedString:attributedString
+                                                                        width:width
+                                                                numberOfLines:numberOfLines];
+  RCTTextLayout *layout = cache[key];
+  if (!layout) {
+    layout = [[self alloc] initWithAttributedString:attributedString
+                                              width:width
+                                      numberOfLines:numberOfLines];
+    cache[key] = layout;
+  }
+  return layout;
+}
+
+- (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
+                                   width:(CGFloat)width
+                           numberOfLines:(NSUInteger)numberOfLines
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+
+    NSLayoutManager *layoutManager = [NSLayoutManager new];
+
+    _textStorage = [[NSTextStorage alloc] initWithAttributedString:attributedString];
+    [_textStorage addLayoutManager:layoutManager];
+
+    NSTextContainer *textContainer = [NSTextContainer new];
+    textContainer.lineFragmentPadding = 0.0;
+    textContainer.lineBreakMode = numberOfLines > 0 ? NSLineBreakByTruncatingTail : NSLineBreakByClipping;
+    textContainer.maximumNumberOfLines = numberOfLines;
+    textContainer.size = (CGSize){isnan(width) ? CGFLOAT_MAX : width, CGFLOAT_MAX};
+
+    [layoutManager addTextContainer:textContainer];
+    [layoutManager ensureLayoutForTextContainer:textContainer];
+
+    _usedSize = [layoutManager usedRectForTextContainer:textContainer].size;
+    _baseline = NAN;
+    if (layoutManager.numberOfGlyphs > 0) {
+      CGRect firstLine = [layoutManager lineFragmentRectForGlyphAtIndex:0 effectiveRange:NULL];
+      _baseline = firstLine.origin.y + [layoutManager locationForGlyphAtIndex:0].y;
+    }
+
+    NSRange glyphRange = [layoutManager glyphRangeForTextContainer:textContainer];
+    NSRange characterRange = [layoutManager characterRangeForGlyphRange:glyphRange actualGlyphRange:NULL];
+    __block UIBezierPath *highlightPath = nil;
+    [_textStorage enumerateAttribute:RCTIsHighlightedAttributeName inRange:characterRange options:0 usingBlock:^(NSNumber *value, NSRange range, __unused BOOL *_) {
+      if (!value.boolValue) {
+        return;
+      }
+
+      [layoutManager enumerateEnclosingRectsForGlyphRange:range withinSelectedGlyphRange:range inTextContainer:textContainer usingBlock:^(CGRect enclosingRect, __unused BOOL *__) {
+        UIBezierPath *path = [UIBezierPath bezierPathWithRoundedRect:CGRectInset(enclosingRect, -2, -2) cornerRadius:2];
+        if (highlightPath) {
+          [highlightPath appendPath:path];
+        } else {
+          highlightPath = path;
+        }
+      }];
+    }];
+    _highlightPath = highlightPath;
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (void)drawAtPoint:(CGPoint)point
+{
+  [_lock lock];
+  NSLayoutManager *layoutManager = _textStorage.layoutManagers.firstObject;
+  NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
+  NSRange glyphRange = [layoutManager glyphRangeForTextContainer:textContainer];
+
+  [layoutManager drawBackgroundForGlyphRange:glyphRange atPoint:point];
+  [layoutManager drawGlyphsForGlyphRange:glyphRange atPoint:point];
+  [_lock unlock];
+}
+
+- (NSNumber *)reactTagAtPoint:(CGPoint)point
+{
+  NSNumber *reactTag = nil;
+
+  [_lock lock];
+  CGFloat fraction;
+  NSLayoutManager *layoutManager = _textStorage.layoutManagers.firstObject;
+  NSTextContainer *textContainer = layoutManager.textContainers.firstObject;
+  NSUInteger characterIndex = [layoutManager characterIndexForPoint:point
+                                                    inTextContainer:textContainer
+                           fractionOfDistanceBetweenInsertionPoints:&fraction];
+
+  // If the point is not before (fraction == 0.0) the first character and not
+  // after (fraction == 1.0) the last character, then the attribute is valid.
+  if (_textStorage.length > 0 && (fraction > 0 || characterIndex > 0) && (fraction < 1 || characterIndex < _textStorage.length - 1)) {
+    reactTag = [_textStorage attribute:RCTReactTagAttributeName atIndex:characterIndex effectiveRange:NULL];
+  }
+  [_lock unlock];
+
+  return reactTag;
+}
+
+@end
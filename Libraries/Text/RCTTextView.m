@@ -22,6 +22,7 @@
   UITextView *_placeholderView;
   UITextView *_textView;
   NSInteger _nativeEventCount;
+  NSString *_pendingText;
 }
 
 - (instancetype)initWithEventDispatcher:(RCTEventDispatcher *)eventDispatcher
@@ -165,13 +166,30 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
 - (void)setText:(NSString *)text
 {
   NSInteger eventLag = _nativeEventCount - _mostRecentEventCount;
-  if (eventLag == 0 && ![text isEqualToString:_textView.text]) {
-    UITextRange *selection = _textView.selectedTextRange;
-    _textView.text = text;
-    [self _setPlaceholderVisibility];
-    _textView.selectedTextRange = selection; // maintain cursor position/selection - this is robust to out of bounds
-  } else if (eventLag > RCTTextUpdateLagWarningThreshold) {
-    RCTLogWarn(@"Native TextInput(%@) is %zd events ahead of JS - try to make your JS faster.", self.text, eventLag);
+  if (eventLag == 0) {
+    // Text that JS echoes back unchanged is left alone
+    _pendingText = nil;
+    if (![text isEqualToString:_textView.text]) {
+      UITextRange *selection = _textView.selectedTextRange;
+      _textView.text = text;
+      [self _setPlaceholderVisibility];
+      _textView.selectedTextRange = selection; // maintain cursor position/selection - this is robust to out of bounds
+    }
+  } else {
+    // The event count that JS sent along may only be set after the text, so
+    // keep the text around rather than forcing JS to send it again
+    _pendingText = [text copy];
+    if (eventLag > RCTTextUpdateLagWarningThreshold) {
+      RCTLogWarn(@"Native TextInput(%@) is %zd events ahead of JS - try to make your JS faster.", self.text, eventLag);
+    }
+  }
+}
+
+- (void)setMostRecentEventCount:(NSInteger)mostRecentEventCount
+{
+  _mostRecentEventCount = mostRecentEventCount;
+  if (_pendingText && _mostRecentEventCount == _nativeEventCount) {
+    [self setText:_pendingText];
   }
 }
 
@@ -219,6 +237,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
 
 - (void)textViewDidChange:(UITextView *)textView
 {
+  _pendingText = nil;
   [self _setPlaceholderVisibility];
   _nativeEventCount++;
   [_eventDispatcher sendTextEventWithType:RCTTextEventTypeChange
@@ -95,6 +95,13 @@ var Text = React.createClass({
      * @platform ios
      */
     suppressHighlighting: React.PropTypes.bool,
+    /**
+     * When true, the text is drawn on a background thread and the main thread
+     * only displays the result. The previous text stays visible until the new
+     * one has been drawn.
+     * @platform ios
+     */
+    asyncDisplayIOS: React.PropTypes.bool,
     style: stylePropType,
     /**
      * Used to locate this view in end-to-end tests.
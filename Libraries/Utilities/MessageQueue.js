@@ -18,6 +18,7 @@ let ErrorUtils = require('ErrorUtils');
 let JSTimersExecution = require('JSTimersExecution');
 let ReactUpdates = require('ReactUpdates');
 
+let encodeBinaryBatch = require('encodeBinaryBatch');
 let invariant = require('invariant');
 let keyMirror = require('keyMirror');
 let stringifySafe = require('stringifySafe');
@@ -28,10 +29,15 @@ let PARAMS = 2;
 
 let SPY_MODE = false;
 
+// Calls to background modules, like analytics or logging, are held back
+// while there are other calls to flush, but at most this long
+let MAX_BACKGROUND_CALL_DELAY_MS = 500;
+
 let MethodTypes = keyMirror({
   local: null,
   remote: null,
   remoteAsync: null,
+  sync: null,
 });
 
 var guard = (fn) => {
@@ -49,27 +55,32 @@ class MessageQueue {
 
     this._require = customRequire || require;
     this._queue = [[],[],[]];
+    this._backgroundQueue = [[],[],[]];
+    this._backgroundQueueTime = 0;
+    this._backgroundFlushScheduled = false;
+    this._backgroundModules = {};
     this._moduleTable = {};
     this._methodTable = {};
     this._callbacks = [];
     this._callbackID = 0;
+    // Set by native executors that can decode the compact batch format
+    this._useBinaryQueue = !!global.__fbBatchedBridgeBinaryQueue;
 
     [
       'processBatch',
       'invokeCallbackAndReturnFlushedQueue',
       'callFunctionReturnFlushedQueue',
+      'callFunctionsReturnFlushedQueue',
       'flushedQueue',
     ].forEach((fn) => this[fn] = this[fn].bind(this));
 
-    this._genModules(remoteModules);
-    localModules && this._genLookupTables(
-      localModules, this._moduleTable, this._methodTable);
-
     this._debugInfo = {};
     this._remoteModuleTable = {};
     this._remoteMethodTable = {};
-    this._genLookupTables(
-      remoteModules, this._remoteModuleTable, this._remoteMethodTable);
+
+    this._genModules(remoteModules);
+    localModules && this._genLookupTables(
+      localModules, this._moduleTable, this._methodTable);
   }
 
   /**
@@ -95,6 +106,25 @@ class MessageQueue {
     return this.flushedQueue();
   }
 
+  /**
+   * Runs several callFunctionReturnFlushedQueue and
+   * invokeCallbackAndReturnFlushedQueue calls, given as [method, args] pairs,
+   * in one batched update and returns a single flushed queue for all of them.
+   */
+  callFunctionsReturnFlushedQueue(calls) {
+    guard(() => {
+      ReactUpdates.batchedUpdates(() => {
+        for (let i = 0, l = calls.length; i < l; i++) {
+          let method = calls[i][0] === 'callFunctionReturnFlushedQueue' ?
+            '__callFunction' : '__invokeCallback';
+          let args = calls[i][1];
+          guard(() => this[method].apply(this, args));
+        }
+      });
+    });
+    return this.flushedQueue();
+  }
+
   invokeCallbackAndReturnFlushedQueue(cbID, args) {
     guard(() => this.__invokeCallback(cbID, args));
     return this.flushedQueue();
@@ -104,9 +134,24 @@ class MessageQueue {
     BridgeProfiling.profile('JSTimersExecution.callImmediates()');
     guard(() => JSTimersExecution.callImmediates());
     BridgeProfiling.profileEnd();
+    let backgroundQueue = this._backgroundQueue;
+    if (backgroundQueue[MODULE_IDS].length) {
+      if (!this._queue[MODULE_IDS].length ||
+          Date.now() - this._backgroundQueueTime >= MAX_BACKGROUND_CALL_DELAY_MS) {
+        for (let i = 0; i < 3; i++) {
+          this._queue[i] = this._queue[i].concat(backgroundQueue[i]);
+        }
+        this._backgroundQueue = [[],[],[]];
+      } else {
+        this._scheduleBackgroundFlush();
+      }
+    }
     let queue = this._queue;
     this._queue = [[],[],[]];
-    return queue[0].length ? queue : null;
+    if (!queue[0].length) {
+      return null;
+    }
+    return this._useBinaryQueue ? encodeBinaryBatch(queue) : queue;
   }
 
   /**
@@ -124,12 +169,19 @@ class MessageQueue {
       onSucc && params.push(this._callbackID);
       this._callbacks[this._callbackID++] = onSucc;
     }
-    this._queue[MODULE_IDS].push(module);
-    this._queue[METHOD_IDS].push(method);
-    this._queue[PARAMS].push(params);
+    let queue = this._queue;
+    if (this._backgroundModules[module]) {
+      queue = this._backgroundQueue;
+      if (!queue[MODULE_IDS].length) {
+        this._backgroundQueueTime = Date.now();
+      }
+    }
+    queue[MODULE_IDS].push(module);
+    queue[METHOD_IDS].push(method);
+    queue[PARAMS].push(params);
     if (__DEV__ && SPY_MODE && isFinite(module)) {
       console.log('JS->N : ' + this._remoteModuleTable[module] + '.' +
-        this._remoteMethodTable[module][method] + '(' + JSON.stringify(params) + ')');
+        (this._remoteMethodTable[module] || {})[method] + '(' + JSON.stringify(params) + ')');
     }
   }
 
@@ -153,8 +205,10 @@ class MessageQueue {
     let callback = this._callbacks[cbID];
     if (!callback || __DEV__) {
       let debug = this._debugInfo[cbID >> 1];
+      // Only modules JS has accessed are in the lookup tables
       let module = debug && this._remoteModuleTable[debug[0]];
-      let method = debug && this._remoteMethodTable[debug[0]][debug[1]];
+      let methods = debug && this._remoteMethodTable[debug[0]];
+      let method = methods && methods[debug[1]];
       invariant(
         callback,
         `Callback with id ${cbID}: ${module}.${method}() not found`
@@ -169,6 +223,21 @@ class MessageQueue {
     BridgeProfiling.profileEnd();
   }
 
+  /**
+   * Native only calls into JS, and takes the queue, when something happens,
+   * so a timer makes sure held back background calls still go out.
+   */
+  _scheduleBackgroundFlush() {
+    if (this._backgroundFlushScheduled) {
+      return;
+    }
+    this._backgroundFlushScheduled = true;
+    // Required lazily, JSTimers calls native modules through this queue
+    require('JSTimers').setTimeout(() => {
+      this._backgroundFlushScheduled = false;
+    }, MAX_BACKGROUND_CALL_DELAY_MS);
+  }
+
   /**
    * Private helper methods
    */
@@ -190,16 +259,49 @@ class MessageQueue {
     }
   }
 
+  /**
+   * remoteModules is either the injected config or the executor's
+   * nativeModuleProxy, which only builds a module's config when it is read.
+   */
   _genModules(remoteModules) {
     let moduleNames = Object.keys(remoteModules);
     for (var i = 0, l = moduleNames.length; i < l; i++) {
       let moduleName = moduleNames[i];
-      let moduleConfig = remoteModules[moduleName];
-      this.RemoteModules[moduleName] = this._genModule({}, moduleConfig);
+      this._defineLazyModule(moduleName, remoteModules);
     }
   }
 
+  /**
+   * Most apps only use some of the native modules, so each module's config is
+   * only read, and its methods generated, the first time it's accessed.
+   */
+  _defineLazyModule(moduleName, remoteModules) {
+    let module = null;
+    Object.defineProperty(this.RemoteModules, moduleName, {
+      configurable: true,
+      enumerable: true,
+      get: () => {
+        if (!module) {
+          let moduleConfig = remoteModules[moduleName];
+          this._genLookupTables(
+            {[moduleName]: moduleConfig},
+            this._remoteModuleTable,
+            this._remoteMethodTable
+          );
+          module = this._genModule({}, moduleConfig);
+        }
+        return module;
+      },
+      set: (value) => {
+        module = value;
+      },
+    });
+  }
+
   _genModule(module, moduleConfig) {
+    if (moduleConfig.background) {
+      this._backgroundModules[moduleConfig.moduleID] = true;
+    }
     let methodNames = Object.keys(moduleConfig.methods);
     for (var i = 0, l = methodNames.length; i < l; i++) {
       let methodName = methodNames[i];
@@ -218,7 +320,19 @@ class MessageQueue {
 
     let fn = null;
     let self = this;
-    if (type === MethodTypes.remoteAsync) {
+    if (type === MethodTypes.sync) {
+      // Runs the native method right away and returns its result, without
+      // going through the queue. Only executors running in the same process
+      // as the native modules provide the hook.
+      fn = function(...args) {
+        invariant(
+          global.nativeCallSyncHook,
+          'Calling synchronous methods on native modules is not supported ' +
+          'by this JS executor, e.g. when debugging in Chrome.'
+        );
+        return global.nativeCallSyncHook(module, method, args);
+      };
+    } else if (type === MethodTypes.remoteAsync) {
       fn = function(...args) {
         return new Promise((resolve, reject) => {
           self.__nativeCall(module, method, args, resolve, (errorData) => {
@@ -71,6 +71,42 @@ describe('MessageQueue', () => {
     assertQueue(flushedQueue, 0, 0, 0, ['foo']);
   });
 
+  it('should only generate native modules when they are accessed', () => {
+    spyOn(queue, '_genModule').andCallThrough();
+    expect(Object.keys(queue.RemoteModules)).toEqual(['one']);
+    expect(queue._genModule.callCount).toEqual(0);
+    let module = queue.RemoteModules.one;
+    expect(queue.RemoteModules.one).toBe(module);
+    expect(queue._genModule.callCount).toEqual(1);
+  });
+
+  it('should only read module configs from the native proxy when accessed', () => {
+    let configReads = 0;
+    let nativeModuleProxy = {};
+    Object.defineProperty(nativeModuleProxy, 'one', {
+      enumerable: true,
+      get: () => {
+        configReads++;
+        return remoteModulesConfig.one;
+      },
+    });
+    queue = new MessageQueue(nativeModuleProxy, localModulesConfig, customRequire);
+    expect(Object.keys(queue.RemoteModules)).toEqual(['one']);
+    expect(configReads).toEqual(0);
+    queue.RemoteModules.one.remoteMethod1('foo');
+    queue.RemoteModules.one.remoteMethod2('bar');
+    expect(configReads).toEqual(1);
+    assertQueue(queue.flushedQueue(), 1, 0, 1, ['bar']);
+  });
+
+  it('should call sync methods through the native hook', () => {
+    global.nativeCallSyncHook = jasmine.createSpy().andReturn(42);
+    expect(queue.RemoteModules.one.syncMethod1('foo')).toEqual(42);
+    expect(global.nativeCallSyncHook).toHaveBeenCalledWith(0, 2, ['foo']);
+    expect(queue.flushedQueue()).toBe(null);
+    delete global.nativeCallSyncHook;
+  });
+
   it('should store callbacks', () => {
     queue.RemoteModules.one.remoteMethod2('foo', () => {}, () => {});
     let flushedQueue = queue.flushedQueue();
@@ -118,6 +154,49 @@ describe('MessageQueue', () => {
 
   });
 
+  describe('background modules', () => {
+
+    it('should hold back background calls while there are other calls', () => {
+      queue.RemoteModules.background.log('foo');
+      queue.RemoteModules.one.remoteMethod1('bar');
+      let flushedQueue = queue.flushedQueue();
+      expect(flushedQueue[MODULE_IDS].length).toEqual(1);
+      assertQueue(flushedQueue, 0, 0, 0, ['bar']);
+
+      flushedQueue = queue.flushedQueue();
+      assertQueue(flushedQueue, 0, 1, 0, ['foo']);
+    });
+
+    it('should flush background calls that waited too long', () => {
+      queue.RemoteModules.background.log('foo');
+      queue._backgroundQueueTime = Date.now() - 1000;
+      queue.RemoteModules.one.remoteMethod1('bar');
+      let flushedQueue = queue.flushedQueue();
+      assertQueue(flushedQueue, 0, 0, 0, ['bar']);
+      assertQueue(flushedQueue, 1, 1, 0, ['foo']);
+    });
+
+  });
+
+  describe('callFunctionsReturnFlushedQueue', () => {
+
+    it('should dispatch every call and return one flushed queue', () => {
+      queue.__callFunction = jasmine.createSpy();
+      queue.__invokeCallback = jasmine.createSpy();
+      queue.RemoteModules.one.remoteMethod1('foo');
+      let flushedQueue = queue.callFunctionsReturnFlushedQueue([
+        ['callFunctionReturnFlushedQueue', [0, 0, [1]]],
+        ['invokeCallbackAndReturnFlushedQueue', [3, []]],
+        ['callFunctionReturnFlushedQueue', [0, 1, [2]]],
+      ]);
+      expect(queue.__callFunction.callCount).toEqual(2);
+      expect(queue.__callFunction.argsForCall[1]).toEqual([0, 1, [2]]);
+      expect(queue.__invokeCallback.callCount).toEqual(1);
+      assertQueue(flushedQueue, 0, 0, 0, ['foo']);
+    });
+
+  });
+
 });
 
 var remoteModulesConfig = {
@@ -126,6 +205,14 @@ var remoteModulesConfig = {
     'methods': {
       'remoteMethod1':{ 'type': 'remote', 'methodID': 0 },
       'remoteMethod2':{ 'type': 'remote', 'methodID': 1 },
+      'syncMethod1':{ 'type': 'sync', 'methodID': 2 },
+    }
+  },
+  'background': {
+    'moduleID': 1,
+    'background': true,
+    'methods': {
+      'log':{ 'type': 'remote', 'methodID': 0 },
     }
   },
 };
@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ *
+ * @providesModule encodeBinaryBatch
+ */
+'use strict';
+
+/**
+ * Compact encoding of a flushed `[moduleIds, methodIds, params]` queue, used
+ * in place of JSON when the native executor advertises support for it via
+ * `__fbBatchedBridgeBinaryQueue`. The native decoders live in
+ * ReactAndroid/src/main/jni/react/MethodCall.cpp and
+ * React/Base/RCTMethodCallBatch.m and must be kept in sync.
+ *
+ * The result is a string where every character holds one byte:
+ *
+ *   batch  := MAGIC varint(callCount) call*
+ *   call   := varint(moduleID) varint(methodID) value
+ *   value  := NULL | FALSE | TRUE
+ *           | INT zigzag-varint
+ *           | DOUBLE 8 bytes IEEE 754, host byte order
+ *           | STRING varint(byteLength) utf8-bytes
+ *           | ARRAY varint(count) value*
+ *           | OBJECT varint(count) (key value)*
+ *           | FLOAT64_ARRAY varint(count) (8 bytes IEEE 754)*
+ *           | INT32_ARRAY varint(count) (4 bytes two's complement)*
+ *           | UINT8_ARRAY varint(count) byte*
+ *           | TABLE_STRING varint(byteLength) utf8-bytes
+ *           | STRING_REF varint(stringIndex)
+ *   key    := varint(byteLength << 1) utf8-bytes
+ *           | varint(stringIndex << 1 | 1)
+ *
+ * Each batch has a string table, so that the prop keys, view names and event
+ * names repeated all over a batch are only encoded, and decoded natively, once.
+ * Every key spelled out and every TABLE_STRING is appended to the table as it
+ * is read, and STRING_REF or an odd key refers back to an earlier entry. Strings longer than
+ * MAX_TABLE_STRING_LENGTH are rarely repeated and are written as STRING,
+ * outside of the table.
+ *
+ * Batches from before string tables start with 0x01 instead of MAGIC, and
+ * write keys as varint(byteLength) utf8-bytes. The decoders still accept them.
+ *
+ * The packed arrays carry typed arrays without a tag per element, again in
+ * host byte order. Float32Array and Uint32Array are widened to float64, the
+ * other integer kinds to int32 and Uint8ClampedArray is sent as uint8.
+ *
+ * Values are converted with the same rules as JSON.stringify: `undefined`,
+ * functions and non-finite numbers become null in arrays and are skipped in
+ * objects, and `toJSON()` is honoured.
+ */
+
+var MAGIC = 0x02;
+
+var TAG_NULL = 0;
+var TAG_FALSE = 1;
+var TAG_TRUE = 2;
+var TAG_INT = 3;
+var TAG_DOUBLE = 4;
+var TAG_STRING = 5;
+var TAG_ARRAY = 6;
+var TAG_OBJECT = 7;
+var TAG_FLOAT64_ARRAY = 8;
+var TAG_INT32_ARRAY = 9;
+var TAG_UINT8_ARRAY = 10;
+var TAG_TABLE_STRING = 11;
+var TAG_STRING_REF = 12;
+
+var MAX_TABLE_STRING_LENGTH = 64;
+
+// String.fromCharCode.apply has an engine specific limit on argument count
+var CHUNK_SIZE = 4096;
+
+var doubleBuffer = new Float64Array(1);
+var doubleBytes = new Uint8Array(doubleBuffer.buffer);
+
+function writeVarint(bytes, value) {
+  value = value >>> 0;
+  while (value > 0x7f) {
+    bytes.push((value & 0x7f) | 0x80);
+    value = value >>> 7;
+  }
+  bytes.push(value);
+}
+
+function encodeUTF8(string) {
+  var utf8 = [];
+  for (var i = 0, l = string.length; i < l; i++) {
+    var code = string.charCodeAt(i);
+    if (code < 0x80) {
+      utf8.push(code);
+      continue;
+    }
+    if (code >= 0xd800 && code <= 0xdbff && i + 1 < l) {
+      var next = string.charCodeAt(i + 1);
+      if (next >= 0xdc00 && next <= 0xdfff) {
+        code = 0x10000 + ((code - 0xd800) << 10) + (next - 0xdc00);
+        i++;
+      }
+    }
+    if (code >= 0xd800 && code <= 0xdfff) {
+      // Lone surrogate
+      code = 0xfffd;
+    }
+    if (code < 0x800) {
+      utf8.push(0xc0 | (code >> 6), 0x80 | (code & 0x3f));
+    } else if (code < 0x10000) {
+      utf8.push(
+        0xe0 | (code >> 12),
+        0x80 | ((code >> 6) & 0x3f),
+        0x80 | (code & 0x3f)
+      );
+    } else {
+      utf8.push(
+        0xf0 | (code >> 18),
+        0x80 | ((code >> 12) & 0x3f),
+        0x80 | ((code >> 6) & 0x3f),
+        0x80 | (code & 0x3f)
+      );
+    }
+  }
+  return utf8;
+}
+
+function writeUTF8(bytes, utf8) {
+  for (var i = 0, l = utf8.length; i < l; i++) {
+    bytes.push(utf8[i]);
+  }
+}
+
+function writeString(bytes, string) {
+  var utf8 = encodeUTF8(string);
+  writeVarint(bytes, utf8.length);
+  writeUTF8(bytes, utf8);
+}
+
+// The index of each string in the batch's table, and how many there are
+function createStringTable() {
+  return {indices: Object.create(null), count: 0};
+}
+
+function writeStringValue(bytes, strings, string) {
+  var index = strings.indices[string];
+  if (index !== undefined) {
+    bytes.push(TAG_STRING_REF);
+    writeVarint(bytes, index);
+  } else if (string.length <= MAX_TABLE_STRING_LENGTH) {
+    strings.indices[string] = strings.count++;
+    bytes.push(TAG_TABLE_STRING);
+    writeString(bytes, string);
+  } else {
+    bytes.push(TAG_STRING);
+    writeString(bytes, string);
+  }
+}
+
+function writeKey(bytes, strings, key) {
+  var index = strings.indices[key];
+  if (index !== undefined) {
+    writeVarint(bytes, index * 2 + 1);
+    return;
+  }
+  strings.indices[key] = strings.count++;
+  var utf8 = encodeUTF8(key);
+  writeVarint(bytes, utf8.length * 2);
+  writeUTF8(bytes, utf8);
+}
+
+// Returns the packed array tag and element type for typed arrays, null for
+// anything else
+function packedArrayKind(value) {
+  if (value instanceof Float64Array ||
+      value instanceof Float32Array ||
+      value instanceof Uint32Array) {
+    return [TAG_FLOAT64_ARRAY, Float64Array];
+  }
+  if (value instanceof Int32Array ||
+      value instanceof Int16Array ||
+      value instanceof Uint16Array ||
+      value instanceof Int8Array) {
+    return [TAG_INT32_ARRAY, Int32Array];
+  }
+  if (value instanceof Uint8Array || value instanceof Uint8ClampedArray) {
+    return [TAG_UINT8_ARRAY, Uint8Array];
+  }
+  return null;
+}
+
+function writePackedArray(bytes, tag, ElementArray, value) {
+  if (!(value instanceof ElementArray)) {
+    value = new ElementArray(value);
+  }
+  var elementBytes = new Uint8Array(value.buffer, value.byteOffset, value.byteLength);
+  bytes.push(tag);
+  writeVarint(bytes, value.length);
+  for (var i = 0, l = elementBytes.length; i < l; i++) {
+    bytes.push(elementBytes[i]);
+  }
+}
+
+function isSerializable(value) {
+  var type = typeof value;
+  return type !== 'undefined' && type !== 'function';
+}
+
+function writeValue(bytes, strings, value) {
+  if (value && typeof value.toJSON === 'function') {
+    value = value.toJSON();
+  }
+  switch (typeof value) {
+    case 'boolean':
+      bytes.push(value ? TAG_TRUE : TAG_FALSE);
+      return;
+    case 'number':
+      if (!isFinite(value)) {
+        bytes.push(TAG_NULL);
+      } else if ((value | 0) === value) {
+        bytes.push(TAG_INT);
+        writeVarint(bytes, (value << 1) ^ (value >> 31));
+      } else {
+        bytes.push(TAG_DOUBLE);
+        doubleBuffer[0] = value;
+        for (var i = 0; i < 8; i++) {
+          bytes.push(doubleBytes[i]);
+        }
+      }
+      return;
+    case 'string':
+      writeStringValue(bytes, strings, value);
+      return;
+    case 'object':
+      var packedKind = value && packedArrayKind(value);
+      if (value === null) {
+        bytes.push(TAG_NULL);
+      } else if (packedKind) {
+        writePackedArray(bytes, packedKind[0], packedKind[1], value);
+      } else if (Array.isArray(value)) {
+        bytes.push(TAG_ARRAY);
+        writeVarint(bytes, value.length);
+        for (var j = 0, l = value.length; j < l; j++) {
+          var item = value[j];
+          if (isSerializable(item)) {
+            writeValue(bytes, strings, item);
+          } else {
+            bytes.push(TAG_NULL);
+          }
+        }
+      } else {
+        var keys = Object.keys(value).filter((key) => isSerializable(value[key]));
+        bytes.push(TAG_OBJECT);
+        writeVarint(bytes, keys.length);
+        for (var k = 0, m = keys.length; k < m; k++) {
+          writeKey(bytes, strings, keys[k]);
+          writeValue(bytes, strings, value[keys[k]]);
+        }
+      }
+      return;
+    default:
+      bytes.push(TAG_NULL);
+  }
+}
+
+function encodeBinaryBatch(queue: Array<Array<any>>): string {
+  var moduleIDs = queue[0];
+  var methodIDs = queue[1];
+  var params = queue[2];
+
+  var bytes = [MAGIC];
+  var strings = createStringTable();
+  writeVarint(bytes, moduleIDs.length);
+  for (var i = 0, l = moduleIDs.length; i < l; i++) {
+    writeVarint(bytes, moduleIDs[i]);
+    writeVarint(bytes, methodIDs[i]);
+    writeValue(bytes, strings, params[i]);
+  }
+
+  var chunks = [];
+  for (var offset = 0; offset < bytes.length; offset += CHUNK_SIZE) {
+    chunks.push(String.fromCharCode.apply(
+      null,
+      bytes.slice(offset, offset + CHUNK_SIZE)
+    ));
+  }
+  return chunks.join('');
+}
+
+module.exports = encodeBinaryBatch;
@@ -23,7 +23,13 @@ function nativeModulePrefixNormalizer(
       );
     }
     if (strippedName !== moduleName) {
-      modules[strippedName] = modules[moduleName];
+      // Move the property itself, so that lazily generated modules aren't
+      // generated here
+      Object.defineProperty(
+        modules,
+        strippedName,
+        Object.getOwnPropertyDescriptor(modules, moduleName)
+      );
       delete modules[moduleName];
     }
   });
@@ -13,7 +13,7 @@
 
 @implementation RCTVibration
 
-RCT_EXPORT_MODULE()
+RCT_EXPORT_LAZY_MODULE()
 
 RCT_EXPORT_METHOD(vibrate)
 {
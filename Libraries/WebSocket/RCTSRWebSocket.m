@@ -48,7 +48,8 @@ typedef struct {
 
 static NSString *const RCTSRWebSocketAppendToSecKeyString = @"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
-static inline int32_t validate_dispatch_data_partial_string(NSData *data);
+static inline int32_t validate_utf8_partial_string(const uint8_t *bytes, size_t length);
+static inline void mask_bytes(uint8_t *bytes, size_t length, const uint8_t *mask_key, size_t mask_offset);
 static inline void RCTSRFastLog(NSString *format, ...);
 
 @interface NSData (RCTSRWebSocket)
@@ -812,7 +813,14 @@ static inline BOOL closeCodeIsValid(int closeCode)
       break;
     }
     case RCTSROpCodeBinaryFrame:
-      [self _handleMessage:[frameData copy]];
+      if (frameData == _currentFrameData) {
+        // Hand the frame data over instead of copying it, the next frame is
+        // read into a new buffer
+        _currentFrameData = [NSMutableData new];
+        [self _handleMessage:frameData];
+      } else {
+        [self _handleMessage:[frameData copy]];
+      }
       break;
     case RCTSROpCodeConnectionClose:
       [self handleCloseWithData:frameData];
@@ -1146,44 +1154,51 @@ static const char CRLFCRLFBytes[] = {'\r', '\n', '\r', '\n'};
 
   NSData *slice = nil;
   if (consumer.readToCurrentFrame || foundSize) {
-    NSRange sliceRange = NSMakeRange(_readBufferOffset, foundSize);
-    slice = [_readBuffer subdataWithRange:sliceRange];
-
-    _readBufferOffset += foundSize;
-
-    if (_readBufferOffset > 4096 && _readBufferOffset > (_readBuffer.length >> 1)) {
-      _readBuffer = [[NSMutableData alloc] initWithBytes:(char *)_readBuffer.bytes + _readBufferOffset length:_readBuffer.length - _readBufferOffset];            _readBufferOffset = 0;
-    }
-
-    if (consumer.unmaskBytes) {
-      NSMutableData *mutableSlice = [slice mutableCopy];
-
-      NSUInteger len = mutableSlice.length;
-      uint8_t *bytes = mutableSlice.mutableBytes;
+    const uint8_t *sliceBytes = (const uint8_t *)_readBuffer.bytes + _readBufferOffset;
 
-      for (NSUInteger i = 0; i < len; i++) {
-        bytes[i] = bytes[i] ^ _currentReadMaskKey[_currentReadMaskOffset % sizeof(_currentReadMaskKey)];
-        _currentReadMaskOffset += 1;
+    if (consumer.readToCurrentFrame) {
+      // Frame payloads go straight from the read buffer to the frame data,
+      // and are unmasked there
+      size_t frameOffset = _currentFrameData.length;
+      [_currentFrameData appendBytes:sliceBytes length:foundSize];
+      if (consumer.unmaskBytes) {
+        mask_bytes((uint8_t *)_currentFrameData.mutableBytes + frameOffset, foundSize,
+                   _currentReadMaskKey, _currentReadMaskOffset);
+        _currentReadMaskOffset += foundSize;
+      }
+    } else {
+      NSMutableData *mutableSlice = [[NSMutableData alloc] initWithBytes:sliceBytes length:foundSize];
+      if (consumer.unmaskBytes) {
+        mask_bytes(mutableSlice.mutableBytes, foundSize, _currentReadMaskKey, _currentReadMaskOffset);
+        _currentReadMaskOffset += foundSize;
       }
-
       slice = mutableSlice;
     }
 
-    if (consumer.readToCurrentFrame) {
-      [_currentFrameData appendData:slice];
+    // Reuse the read buffer rather than allocating a new one. Once it has
+    // all been read it's simply emptied, which is the common case when many
+    // small messages arrive; otherwise the unread bytes are moved to the front
+    // when the read part gets big enough.
+    _readBufferOffset += foundSize;
+    if (_readBufferOffset == _readBuffer.length) {
+      _readBuffer.length = 0;
+      _readBufferOffset = 0;
+    } else if (_readBufferOffset > 4096 && _readBufferOffset > (_readBuffer.length >> 1)) {
+      [_readBuffer replaceBytesInRange:NSMakeRange(0, _readBufferOffset) withBytes:NULL length:0];
+      _readBufferOffset = 0;
+    }
 
+    if (consumer.readToCurrentFrame) {
       _readOpCount += 1;
 
       if (_currentFrameOpcode == RCTSROpCodeTextFrame) {
         // Validate UTF8 stuff.
         size_t currentDataSize = _currentFrameData.length;
         if (_currentFrameOpcode == RCTSROpCodeTextFrame && currentDataSize > 0) {
-          // TODO: Optimize this.  Don't really have to copy all the data each time
-
+          // Only the bytes after the last complete code point need scanning
           size_t scanSize = currentDataSize - _currentStringScanPosition;
-
-          NSData *scan_data = [_currentFrameData subdataWithRange:NSMakeRange(_currentStringScanPosition, scanSize)];
-          int32_t valid_utf8_size = validate_dispatch_data_partial_string(scan_data);
+          const uint8_t *scanBytes = (const uint8_t *)_currentFrameData.bytes + _currentStringScanPosition;
+          int32_t valid_utf8_size = validate_utf8_partial_string(scanBytes, scanSize);
 
           if (valid_utf8_size == -1) {
             [self closeWithCode:RCTSRStatusCodeInvalidUTF8 reason:@"Text frames must be valid UTF-8"];
@@ -1292,20 +1307,16 @@ static const size_t RCTSRFrameHeaderOverhead = 32;
   }
 
   if (!useMask) {
-    for (size_t i = 0; i < payloadLength; i++) {
-      frame_buffer[frame_buffer_size] = unmasked_payload[i];
-      frame_buffer_size += 1;
-    }
+    memcpy(frame_buffer + frame_buffer_size, unmasked_payload, payloadLength);
+    frame_buffer_size += payloadLength;
   } else {
     uint8_t *mask_key = frame_buffer + frame_buffer_size;
     SecRandomCopyBytes(kSecRandomDefault, sizeof(uint32_t), (uint8_t *)mask_key);
     frame_buffer_size += sizeof(uint32_t);
 
-    // TODO: could probably optimize this with SIMD
-    for (size_t i = 0; i < payloadLength; i++) {
-      frame_buffer[frame_buffer_size] = unmasked_payload[i] ^ mask_key[i % sizeof(uint32_t)];
-      frame_buffer_size += 1;
-    }
+    memcpy(frame_buffer + frame_buffer_size, unmasked_payload, payloadLength);
+    mask_bytes(frame_buffer + frame_buffer_size, payloadLength, mask_key, 0);
+    frame_buffer_size += payloadLength;
   }
 
   assert(frame_buffer_size <= [frame length]);
@@ -1556,18 +1567,86 @@ static inline void RCTSRFastLog(NSString *format, ...)
 }
 
 // This is a hack, and probably not optimal
-static inline int32_t validate_dispatch_data_partial_string(NSData *data)
-{
-  static const int maxCodepointSize = 3;
+// Returns the length of the longest prefix of the bytes that ends on a
+// complete code point, or -1 if they can't be valid UTF-8. An incomplete code
+// point at the end is not an error, the rest of it may still arrive.
+static inline int32_t validate_utf8_partial_string(const uint8_t *bytes, size_t length)
+{
+  size_t i = 0;
+  while (i < length) {
+    // Skip ASCII a word at a time
+    if (i + sizeof(uint64_t) <= length) {
+      uint64_t word;
+      memcpy(&word, bytes + i, sizeof(word));
+      if (!(word & 0x8080808080808080ULL)) {
+        i += sizeof(word);
+        continue;
+      }
+    }
+
+    uint8_t byte = bytes[i];
+    if (byte < 0x80) {
+      i++;
+      continue;
+    }
+
+    size_t sequenceLength;
+    uint32_t codepoint, minimum;
+    if ((byte & 0xE0) == 0xC0) {
+      sequenceLength = 2;
+      codepoint = byte & 0x1F;
+      minimum = 0x80;
+    } else if ((byte & 0xF0) == 0xE0) {
+      sequenceLength = 3;
+      codepoint = byte & 0x0F;
+      minimum = 0x800;
+    } else if ((byte & 0xF8) == 0xF0) {
+      sequenceLength = 4;
+      codepoint = byte & 0x07;
+      minimum = 0x10000;
+    } else {
+      return -1;
+    }
 
-  for (int i = 0; i < maxCodepointSize; i++) {
-    NSString *str = [[NSString alloc] initWithBytesNoCopy:(char *)data.bytes length:data.length - i encoding:NSUTF8StringEncoding freeWhenDone:NO];
-    if (str) {
-      return (int32_t)data.length - i;
+    size_t available = MIN(sequenceLength, length - i);
+    for (size_t j = 1; j < available; j++) {
+      if ((bytes[i + j] & 0xC0) != 0x80) {
+        return -1;
+      }
+      codepoint = (codepoint << 6) | (bytes[i + j] & 0x3F);
+    }
+    if (available < sequenceLength) {
+      break;
     }
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+      return -1;
+    }
+    i += sequenceLength;
   }
+  return (int32_t)i;
+}
 
-  return -1;
+// XORs the bytes with the mask key, starting mask_offset bytes into the key,
+// 8 bytes at a time
+static inline void mask_bytes(uint8_t *bytes, size_t length, const uint8_t *mask_key, size_t mask_offset)
+{
+  uint8_t wide_key[sizeof(uint64_t)];
+  for (size_t i = 0; i < sizeof(wide_key); i++) {
+    wide_key[i] = mask_key[(mask_offset + i) % sizeof(uint32_t)];
+  }
+  uint64_t wide_mask;
+  memcpy(&wide_mask, wide_key, sizeof(wide_mask));
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    word ^= wide_mask;
+    memcpy(bytes + i, &word, sizeof(word));
+  }
+  for (; i < length; i++) {
+    bytes[i] ^= mask_key[(mask_offset + i) % sizeof(uint32_t)];
+  }
 }
 
 static _RCTSRRunLoopThread *networkThread = nil;
@@ -21,6 +21,15 @@
 
 typedef void (^RCTWSMessageCallback)(NSError *error, NSDictionary *reply);
 
+/**
+ * Version 2 of the debugger protocol sends every message queued in one turn of
+ * the socket queue as a single frame holding an array of messages, and the
+ * debugger replies in arrays too, with call results as JSON values rather
+ * than JSON strings. It's only used if the debugger page confirms it in its
+ * reply to prepareJSRuntime, older pages keep getting one message per frame.
+ */
+static const NSInteger RCTWebSocketExecutorProtocolVersion = 2;
+
 @interface RCTWebSocketExecutor () <RCTSRWebSocketDelegate>
 
 @end
@@ -33,6 +42,9 @@ typedef void (^RCTWSMessageCallback)(NSError *error, NSDictionary *reply);
   dispatch_semaphore_t _socketOpenSemaphore;
   NSMutableDictionary *_injectedObjects;
   NSURL *_url;
+  // Only accessed on _jsQueue
+  BOOL _batchesMessages;
+  NSMutableArray<NSDictionary *> *_pendingMessages;
 }
 
 RCT_EXPORT_MODULE()
@@ -98,8 +110,14 @@ RCT_EXPORT_MODULE()
 {
   __block NSError *initError;
   dispatch_semaphore_t s = dispatch_semaphore_create(0);
-  [self sendMessage:@{@"method": @"prepareJSRuntime"} waitForReply:^(NSError *error, NSDictionary *reply) {
+  NSDictionary *message = @{
+    @"method": @"prepareJSRuntime",
+    @"protocol": @(RCTWebSocketExecutorProtocolVersion),
+  };
+  [self sendMessage:message waitForReply:^(NSError *error, NSDictionary *reply) {
     initError = error;
+    // Called on _jsQueue, before any other message is sent
+    _batchesMessages = [reply[@"protocol"] integerValue] >= RCTWebSocketExecutorProtocolVersion;
     dispatch_semaphore_signal(s);
   }];
   long runtimeIsReady = dispatch_semaphore_wait(s, dispatch_time(DISPATCH_TIME_NOW, NSEC_PER_SEC));
@@ -109,11 +127,20 @@ RCT_EXPORT_MODULE()
 - (void)webSocket:(RCTSRWebSocket *)webSocket didReceiveMessage:(id)message
 {
   NSError *error = nil;
-  NSDictionary *reply = RCTJSONParse(message, &error);
-  NSNumber *messageID = reply[@"replyID"];
-  RCTWSMessageCallback callback = _callbacks[messageID];
-  if (callback) {
-    callback(error, reply);
+  id replies = RCTJSONParse(message, &error);
+  if (![replies isKindOfClass:[NSArray class]]) {
+    replies = replies ? @[replies] : @[];
+  }
+  for (NSDictionary *reply in replies) {
+    if (![reply isKindOfClass:[NSDictionary class]]) {
+      continue;
+    }
+    NSNumber *messageID = reply[@"replyID"];
+    RCTWSMessageCallback callback = messageID ? _callbacks[messageID] : nil;
+    if (callback) {
+      _callbacks[messageID] = nil;
+      callback(error, reply);
+    }
   }
 }
 
@@ -144,10 +171,46 @@ RCT_EXPORT_MODULE()
     _callbacks[expectedID] = [callback copy];
     NSMutableDictionary *messageWithID = [message mutableCopy];
     messageWithID[@"id"] = expectedID;
-    [_socket send:RCTJSONStringify(messageWithID, NULL)];
+
+    if (!_batchesMessages) {
+      [_socket send:RCTJSONStringify(messageWithID, NULL)];
+      return;
+    }
+
+    // Any number of calls can be in flight, each reply is matched up to its
+    // callback by ID. Messages sent before the queue gets to the flush below
+    // all go out in the same frame.
+    if (!_pendingMessages) {
+      _pendingMessages = [NSMutableArray new];
+      dispatch_async(_jsQueue, ^{
+        [self flushPendingMessages];
+      });
+    }
+    [_pendingMessages addObject:messageWithID];
   });
 }
 
+- (void)flushPendingMessages
+{
+  NSArray<NSDictionary *> *messages = _pendingMessages;
+  _pendingMessages = nil;
+  if (self.valid) {
+    [_socket send:RCTJSONStringify(messages, NULL)];
+    return;
+  }
+
+  NSError *error = [NSError errorWithDomain:@"WS" code:1 userInfo:@{
+    NSLocalizedDescriptionKey: @"socket closed"
+  }];
+  for (NSDictionary *message in messages) {
+    RCTWSMessageCallback callback = _callbacks[message[@"id"]];
+    _callbacks[message[@"id"]] = nil;
+    if (callback) {
+      callback(error, nil);
+    }
+  }
+}
+
 - (void)executeApplicationScript:(NSString *)script sourceURL:(NSURL *)URL onComplete:(RCTJavaScriptCompleteBlock)onComplete
 {
   NSDictionary *message = @{
@@ -175,9 +238,12 @@ RCT_EXPORT_MODULE()
       return;
     }
 
-    NSString *result = reply[@"result"];
-    id objcValue = RCTJSONParse(result, NULL);
-    onComplete(objcValue, nil);
+    // Version 2 replies hold the result itself, older ones a JSON string
+    id result = RCTNilIfNull(reply[@"result"]);
+    if (!_batchesMessages && [result isKindOfClass:[NSString class]]) {
+      result = RCTJSONParse(result, NULL);
+    }
+    onComplete(result, nil);
   }];
 }
 
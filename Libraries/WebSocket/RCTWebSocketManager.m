@@ -29,6 +29,77 @@
 
 @end
 
+/**
+ * Sends a socket event as a device event, through the event dispatcher so that
+ * it is ordered after the messages that are waiting for the next frame.
+ */
+@interface RCTWebSocketEvent : RCTBaseEvent
+
+@end
+
+@implementation RCTWebSocketEvent
+
+- (BOOL)canCoalesce
+{
+  return NO;
+}
+
++ (NSString *)moduleDotMethod
+{
+  return @"RCTDeviceEventEmitter.emit";
+}
+
+- (NSArray *)arguments
+{
+  return @[self.eventName, self.body];
+}
+
+@end
+
+/**
+ * The messages a socket has received since the last frame, which are sent to
+ * JS together as one event.
+ */
+@interface RCTWebSocketMessagesEvent : RCTWebSocketEvent
+
+- (instancetype)initWithSocketID:(NSNumber *)socketID message:(id)message;
+
+@end
+
+@implementation RCTWebSocketMessagesEvent
+{
+  NSMutableArray *_messages;
+}
+
+- (instancetype)initWithSocketID:(NSNumber *)socketID message:(id)message
+{
+  if ((self = [super initWithViewTag:socketID eventName:@"websocketMessages" body:nil])) {
+    _messages = [NSMutableArray arrayWithObject:message];
+  }
+  return self;
+}
+
+- (BOOL)canCoalesce
+{
+  return YES;
+}
+
+- (id<RCTEvent>)coalesceWithEvent:(id<RCTEvent>)newEvent
+{
+  [_messages addObjectsFromArray:((RCTWebSocketMessagesEvent *)newEvent)->_messages];
+  return self;
+}
+
+- (NSArray *)arguments
+{
+  return @[self.eventName, @{
+    @"data": _messages,
+    @"id": self.viewTag,
+  }];
+}
+
+@end
+
 @interface RCTWebSocketManager () <RCTSRWebSocketDelegate>
 
 @end
@@ -80,24 +151,31 @@ RCT_EXPORT_METHOD(close:(nonnull NSNumber *)socketID)
 
 #pragma mark - RCTSRWebSocketDelegate methods
 
+- (void)sendEventWithName:(NSString *)name socket:(RCTSRWebSocket *)webSocket body:(NSDictionary *)body
+{
+  [_bridge.eventDispatcher sendEvent:[[RCTWebSocketEvent alloc] initWithViewTag:webSocket.reactTag
+                                                                      eventName:name
+                                                                           body:body]];
+}
+
 - (void)webSocket:(RCTSRWebSocket *)webSocket didReceiveMessage:(id)message
 {
-  [_bridge.eventDispatcher sendDeviceEventWithName:@"websocketMessage" body:@{
-    @"data": message,
-    @"id": webSocket.reactTag
-  }];
+  // Messages are held until the next frame, and all the messages a socket
+  // received by then are sent to JS in one event
+  [_bridge.eventDispatcher sendEvent:[[RCTWebSocketMessagesEvent alloc] initWithSocketID:webSocket.reactTag
+                                                                                 message:message]];
 }
 
 - (void)webSocketDidOpen:(RCTSRWebSocket *)webSocket
 {
-  [_bridge.eventDispatcher sendDeviceEventWithName:@"websocketOpen" body:@{
+  [self sendEventWithName:@"websocketOpen" socket:webSocket body:@{
     @"id": webSocket.reactTag
   }];
 }
 
 - (void)webSocket:(RCTSRWebSocket *)webSocket didFailWithError:(NSError *)error
 {
-  [_bridge.eventDispatcher sendDeviceEventWithName:@"websocketFailed" body:@{
+  [self sendEventWithName:@"websocketFailed" socket:webSocket body:@{
     @"message":error.localizedDescription,
     @"id": webSocket.reactTag
   }];
@@ -106,7 +184,7 @@ RCT_EXPORT_METHOD(close:(nonnull NSNumber *)socketID)
 - (void)webSocket:(RCTSRWebSocket *)webSocket didCloseWithCode:(NSInteger)code
            reason:(NSString *)reason wasClean:(BOOL)wasClean
 {
-  [_bridge.eventDispatcher sendDeviceEventWithName:@"websocketClosed" body:@{
+  [self sendEventWithName:@"websocketClosed" socket:webSocket body:@{
     @"code": @(code),
     @"reason": RCTNullIfNil(reason),
     @"clean": @(wasClean),
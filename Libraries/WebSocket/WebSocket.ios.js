@@ -22,6 +22,11 @@ class WebSocket extends WebSocketBase {
   _socketId: number;
   _subs: any;
 
+  // Non-standard: when set, it's called with an array of all the message
+  // events received since the last frame, instead of calling onmessage for
+  // each of them
+  onmessages: ?Function;
+
   connectToSocketImpl(url: string): void {
     this._socketId = WebSocketId++;
     RCTWebSocketManager.connect(url, this._socketId);
@@ -53,14 +58,18 @@ class WebSocket extends WebSocketBase {
   _registerEvents(id: number): void {
     this._subs = [
       RCTDeviceEventEmitter.addListener(
-        'websocketMessage',
+        'websocketMessages',
         function(ev) {
           if (ev.id !== id) {
             return;
           }
-          this.onmessage && this.onmessage({
-            data: ev.data
-          });
+          var events = ev.data.map(data => ({data}));
+          var onmessage = this.onmessage;
+          if (this.onmessages) {
+            this.onmessages(events);
+          } else if (onmessage) {
+            events.forEach(event => onmessage(event));
+          }
         }.bind(this)
       ),
       RCTDeviceEventEmitter.addListener(
@@ -9,13 +9,21 @@
 
 #import <Foundation/Foundation.h>
 
+#import <libkern/OSAtomic.h>
+
+
 #import "RCTAssert.h"
 #import "RCTBridge.h"
+#import "RCTBridgeRecorder.h"
+#import "RCTBridgeTraffic.h"
 #import "RCTConvert.h"
 #import "RCTContextExecutor.h"
+#import "RCTFrameTiming.h"
 #import "RCTFrameUpdate.h"
+#import "RCTInputLatency.h"
 #import "RCTJavaScriptLoader.h"
 #import "RCTLog.h"
+#import "RCTMethodCallBatch.h"
 #import "RCTModuleData.h"
 #import "RCTModuleMap.h"
 #import "RCTBridgeMethod.h"
@@ -36,16 +44,63 @@ NSString *const RCTEnqueueNotification = @"RCTEnqueueNotification";
 NSString *const RCTDequeueNotification = @"RCTDequeueNotification";
 
 /**
- * Must be kept in sync with `MessageQueue.js`.
+ * How urgently a scheduled call has to reach JS. Scheduled calls are always
+ * sent in the order they were made, but a frame that is running out of time
+ * can defer timers and other calls, together with everything after them, to
+ * a later frame. Events are never the first call to be deferred.
  */
-typedef NS_ENUM(NSUInteger, RCTBridgeFields) {
-  RCTBridgeFieldRequestModuleIDs = 0,
-  RCTBridgeFieldMethodIDs,
-  RCTBridgeFieldParamss,
+typedef NS_ENUM(NSUInteger, RCTJSCallPriority) {
+  RCTJSCallPriorityEvent = 0,
+  RCTJSCallPriorityTimer,
+  RCTJSCallPriorityLow,
 };
 
+/**
+ * Deferred calls are sent regardless of the frame budget after this many frames.
+ */
+static const NSUInteger RCTMaxDeferredFrames = 3;
+
 RCT_EXTERN NSArray *RCTGetModuleClasses(void);
 
+static RCTJSCallPriority RCTJSCallPriorityForModule(NSString *module)
+{
+  if ([module isEqualToString:@"RCTEventEmitter"] ||
+      [module isEqualToString:@"RCTDeviceEventEmitter"] ||
+      [module isEqualToString:@"RCTNativeAppEventEmitter"]) {
+    return RCTJSCallPriorityEvent;
+  }
+  if ([module isEqualToString:@"JSTimersExecution"]) {
+    return RCTJSCallPriorityTimer;
+  }
+  return RCTJSCallPriorityLow;
+}
+
+static RCTJavaScriptQueuePriority RCTJavaScriptQueuePriorityForJSCall(RCTJSCallPriority priority)
+{
+  switch (priority) {
+    case RCTJSCallPriorityEvent:
+      return RCTJavaScriptQueuePriorityEvents;
+    case RCTJSCallPriorityTimer:
+      return RCTJavaScriptQueuePriorityTimers;
+    default:
+      return RCTJavaScriptQueuePriorityDefault;
+  }
+}
+
+static BOOL RCTModuleClassIsLazilyLoaded(Class moduleClass)
+{
+  if (![moduleClass respondsToSelector:@selector(isLazilyLoaded)] ||
+      ![moduleClass isLazilyLoaded]) {
+    return NO;
+  }
+
+  // These need the module instance as soon as the bridge starts
+  return !([moduleClass instancesRespondToSelector:@selector(constantsToExport)] ||
+           [moduleClass instancesRespondToSelector:@selector(methodsToExport)] ||
+           [moduleClass instancesRespondToSelector:@selector(batchDidComplete)] ||
+           [moduleClass conformsToProtocol:@protocol(RCTFrameUpdateObserver)]);
+}
+
 @interface RCTBridge ()
 
 + (instancetype)currentBridge;
@@ -65,12 +120,26 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
   BOOL _valid;
   __weak id<RCTJavaScriptExecutor> _javaScriptExecutor;
   NSMutableArray *_moduleDataByID;
+  NSDictionary *_moduleDataByName;
   RCTModuleMap *_modulesByName;
+  NSMutableArray *_queueModules;
+  NSMutableData *_queueSlotByModuleID;
+  NSUInteger _modulesWithoutQueueCount;
+  NSArray *_batchDidCompleteModules;
   CADisplayLink *_mainDisplayLink;
   CADisplayLink *_jsDisplayLink;
   NSMutableSet *_frameUpdateObservers;
+  BOOL _inBackground;
   NSMutableArray *_scheduledCalls;
+  volatile int64_t _lastScheduledCallSequence;
   RCTSparseArray *_scheduledCallbacks;
+  BOOL _callbackFlushScheduled;
+  NSUInteger _deferredFrameCount;
+  NSTimeInterval _averageJSCallDuration;
+  CFTimeInterval _lastJSFrameTimestamp;
+  NSUInteger _droppedJSFrames;
+  NSUInteger _deferredJSFrames;
+  RCTBridgeRecorder *_recorder;
 }
 
 - (instancetype)initWithParentBridge:(RCTBridge *)bridge
@@ -100,6 +169,16 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
       [_mainDisplayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
     }
 
+    _inBackground = [UIApplication sharedApplication].applicationState == UIApplicationStateBackground;
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(_applicationDidEnterBackground)
+                                                 name:UIApplicationDidEnterBackgroundNotification
+                                               object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(_applicationWillEnterForeground)
+                                                 name:UIApplicationWillEnterForegroundNotification
+                                               object:nil];
+
     [RCTBridge setCurrentBridge:self];
 
     [[NSNotificationCenter defaultCenter] postNotificationName:RCTJavaScriptWillStartLoadingNotification
@@ -114,10 +193,23 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
 - (void)start
 {
   dispatch_queue_t bridgeQueue = dispatch_queue_create("com.facebook.react.RCTBridgeQueue", DISPATCH_QUEUE_CONCURRENT);
-
-  dispatch_group_t initModulesAndLoadSource = dispatch_group_create();
-  dispatch_group_enter(initModulesAndLoadSource);
   __weak RCTBatchedBridge *weakSelf = self;
+
+  /**
+   * Startup runs as a set of stages that only wait on what they need:
+   *
+   *   load source ─────────────────────────────────────┐
+   *   create executor ─> set up executor ──┐           ├─> execute source
+   *                  └─> init modules ─> module config ┴─> inject config ┘
+   *
+   * The source is loaded and the native modules are created while the
+   * executor sets up its JS context, and the config is injected as soon as
+   * both the context and the config are ready. Since the executor sets up
+   * while the other modules are still being created, its setUp must not look
+   * any of them up synchronously.
+   */
+  dispatch_group_t sourceLoadedAndConfigInjected = dispatch_group_create();
+  dispatch_group_enter(sourceLoadedAndConfigInjected);
   __block NSString *sourceCode;
   [self loadSource:^(NSError *error, NSString *source) {
     if (error) {
@@ -127,11 +219,19 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
     }
 
     sourceCode = source;
-    dispatch_group_leave(initModulesAndLoadSource);
+    dispatch_group_leave(sourceLoadedAndConfigInjected);
   }];
 
-  // Synchronously initialize all native modules
-  [self initModules];
+  NSMutableDictionary *preregisteredModules = [self preregisteredModules];
+  [self initJavaScriptExecutorWithPreregisteredModules:preregisteredModules];
+
+  dispatch_group_t executorSetUpAndModuleConfig = dispatch_group_create();
+  dispatch_group_async(executorSetUpAndModuleConfig, bridgeQueue, ^{
+    [weakSelf setupExecutor];
+  });
+
+  // Synchronously initialize all other native modules
+  [self initModulesWithPreregisteredModules:preregisteredModules];
 
   if (RCTProfileIsProfiling()) {
     // Depends on moduleDataByID being loaded
@@ -139,36 +239,32 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
   }
 
   __block NSString *config;
-  dispatch_group_enter(initModulesAndLoadSource);
-  dispatch_async(bridgeQueue, ^{
-    dispatch_group_t setupJSExecutorAndModuleConfig = dispatch_group_create();
-    dispatch_group_async(setupJSExecutorAndModuleConfig, bridgeQueue, ^{
-      [weakSelf setupExecutor];
-    });
+  dispatch_group_async(executorSetUpAndModuleConfig, bridgeQueue, ^{
+    RCTPerformanceLoggerStart(RCTPLNativeModulePrepareConfig);
+    if (weakSelf.isValid) {
+      config = [weakSelf moduleConfig];
+    }
+    RCTPerformanceLoggerEnd(RCTPLNativeModulePrepareConfig);
+  });
 
-    dispatch_group_async(setupJSExecutorAndModuleConfig, bridgeQueue, ^{
-      if (weakSelf.isValid) {
-        config = [weakSelf moduleConfig];
+  dispatch_group_enter(sourceLoadedAndConfigInjected);
+  dispatch_group_notify(executorSetUpAndModuleConfig, bridgeQueue, ^{
+    // We're not waiting for this complete to leave the dispatch group, since
+    // injectJSONConfiguration and executeSourceCode will schedule operations on the
+    // same queue anyway.
+    RCTPerformanceLoggerStart(RCTPLNativeModuleInjectConfig);
+    [weakSelf injectJSONConfiguration:config onComplete:^(NSError *error) {
+      RCTPerformanceLoggerEnd(RCTPLNativeModuleInjectConfig);
+      if (error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+          [weakSelf stopLoadingWithError:error];
+        });
       }
-    });
-
-    dispatch_group_notify(setupJSExecutorAndModuleConfig, bridgeQueue, ^{
-      // We're not waiting for this complete to leave the dispatch group, since
-      // injectJSONConfiguration and executeSourceCode will schedule operations on the
-      // same queue anyway.
-      [weakSelf injectJSONConfiguration:config onComplete:^(NSError *error) {
-        RCTPerformanceLoggerEnd(RCTPLNativeModuleInit);
-        if (error) {
-          dispatch_async(dispatch_get_main_queue(), ^{
-            [weakSelf stopLoadingWithError:error];
-          });
-        }
-      }];
-      dispatch_group_leave(initModulesAndLoadSource);
-    });
+    }];
+    dispatch_group_leave(sourceLoadedAndConfigInjected);
   });
 
-  dispatch_group_notify(initModulesAndLoadSource, dispatch_get_main_queue(), ^{
+  dispatch_group_notify(sourceLoadedAndConfigInjected, dispatch_get_main_queue(), ^{
     RCTBatchedBridge *strongSelf = weakSelf;
     if (sourceCode && strongSelf.loading) {
       dispatch_async(bridgeQueue, ^{
@@ -222,10 +318,9 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
   }
 }
 
-- (void)initModules
+- (NSMutableDictionary *)preregisteredModules
 {
   RCTAssertMainThread();
-  RCTPerformanceLoggerStart(RCTPLNativeModuleInit);
 
   // Register passed-in module instances
   NSMutableDictionary *preregisteredModules = [NSMutableDictionary new];
@@ -242,10 +337,42 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
   for (id<RCTBridgeModule> module in extraModules) {
     preregisteredModules[RCTBridgeModuleNameForClass([module class])] = module;
   }
+  return preregisteredModules;
+}
+
+/**
+ * The executor is created before any other module, so that it can set up its
+ * JS context while the rest of the modules are being created. It's registered
+ * along with the passed-in modules so that it isn't created again later.
+ */
+- (void)initJavaScriptExecutorWithPreregisteredModules:(NSMutableDictionary *)preregisteredModules
+{
+  RCTAssertMainThread();
+
+  NSString *executorName = RCTBridgeModuleNameForClass(self.executorClass);
+  id<RCTJavaScriptExecutor> executor = preregisteredModules[executorName];
+  if (!executor) {
+    executor = [self.executorClass new];
+    preregisteredModules[executorName] = executor;
+  }
+
+  // setUp can use the bridge, so it has to be set first
+  if ([executor respondsToSelector:@selector(setBridge:)]) {
+    executor.bridge = self;
+  }
+  _javaScriptExecutor = executor;
+}
+
+- (void)initModulesWithPreregisteredModules:(NSDictionary *)preregisteredModules
+{
+  RCTAssertMainThread();
+  RCTPerformanceLoggerStart(RCTPLNativeModuleInit);
 
   // Instantiate modules
   _moduleDataByID = [NSMutableArray new];
   NSMutableDictionary *modulesByName = [preregisteredModules mutableCopy];
+  NSMutableDictionary *lazyModuleClasses = [NSMutableDictionary new];
+  NSMutableSet *sharedModuleNames = [NSMutableSet new];
   for (Class moduleClass in RCTGetModuleClasses()) {
      NSString *moduleName = RCTBridgeModuleNameForClass(moduleClass);
 
@@ -261,6 +388,18 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
                    "'%@', but name was already registered by class %@", moduleClass,
                    moduleName, [modulesByName[moduleName] class]);
        }
+     } else if (lazyModuleClasses[moduleName]) {
+       RCTAssert([moduleClass new] == nil,
+                 @"Attempted to register RCTBridgeModule class %@ for the name "
+                 "'%@', but name was already registered by class %@", moduleClass,
+                 moduleName, lazyModuleClasses[moduleName]);
+     } else if (RCTModuleClassIsLazilyLoaded(moduleClass)) {
+       // Created the first time it's used
+       lazyModuleClasses[moduleName] = moduleClass;
+     } else if (RCTModuleClassIsShared(moduleClass)) {
+       // Reuse the instance other bridges created
+       module = RCTAcquireSharedModule(moduleClass);
+       [sharedModuleNames addObject:moduleName];
      } else {
        // Module name hasn't been used before, so go ahead and instantiate
        module = [moduleClass new];
@@ -270,20 +409,30 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
      }
   }
 
+  // Lazily loaded modules take the IDs after the other modules
+  NSMutableArray *lazyModuleData = [NSMutableArray new];
+  NSMutableDictionary *lazyModulesByName = [NSMutableDictionary new];
+  for (NSString *moduleName in lazyModuleClasses) {
+    RCTModuleData *moduleData = [[RCTModuleData alloc] initWithExecutor:_javaScriptExecutor
+                                                               moduleID:@(modulesByName.count + lazyModuleData.count)
+                                                            moduleClass:lazyModuleClasses[moduleName]
+                                                                 bridge:self];
+    [lazyModuleData addObject:moduleData];
+    lazyModulesByName[moduleName] = moduleData;
+  }
+
   // Store modules
-  _modulesByName = [[RCTModuleMap alloc] initWithDictionary:modulesByName];
+  _modulesByName = [[RCTModuleMap alloc] initWithDictionary:modulesByName
+                                                lazyModules:lazyModulesByName];
 
-  /**
-   * The executor is a bridge module, wait for it to be created and set it before
-   * any other module has access to the bridge
-   */
-  _javaScriptExecutor = _modulesByName[RCTBridgeModuleNameForClass(self.executorClass)];
+  for (NSString *moduleName in modulesByName) {
+    id<RCTBridgeModule> module = modulesByName[moduleName];
 
-  for (id<RCTBridgeModule> module in _modulesByName.allValues) {
     // Bridge must be set before moduleData is set up, as methodQueue
     // initialization requires it (View Managers get their queue by calling
-    // self.bridge.uiManager.methodQueue)
-    if ([module respondsToSelector:@selector(setBridge:)]) {
+    // self.bridge.uiManager.methodQueue). Shared modules don't belong to
+    // any one bridge.
+    if (![sharedModuleNames containsObject:moduleName] && [module respondsToSelector:@selector(setBridge:)]) {
       module.bridge = self;
     }
 
@@ -292,22 +441,121 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
                                                                instance:module];
     [_moduleDataByID addObject:moduleData];
   }
+  [_moduleDataByID addObjectsFromArray:lazyModuleData];
+
+  NSMutableDictionary *moduleDataByName = [NSMutableDictionary new];
+  for (RCTModuleData *moduleData in _moduleDataByID) {
+    moduleDataByName[moduleData.name] = moduleData;
+  }
+  _moduleDataByName = [moduleDataByName copy];
+
+  [self setUpMethodQueueSlots];
+
+  RCTPerformanceLoggerEnd(RCTPLNativeModuleInit);
+  RCTPerformanceLoggerSetValue(@"NativeModuleCount", _moduleDataByID.count);
 
   [[NSNotificationCenter defaultCenter] postNotificationName:RCTDidCreateNativeModules
                                                       object:self];
 }
 
+/**
+ * Module queues are created along with their RCTModuleData, so the set of
+ * queues that a batch can dispatch to is known up front. Number the distinct
+ * queues once here so that _handleBuffer can group calls by queue with plain
+ * C arrays instead of building a map of ordered sets for every batch.
+ *
+ * Lazily loaded modules only get their queue when they're created, so they
+ * get a slot the first time a batch calls them.
+ */
+- (void)setUpMethodQueueSlots
+{
+  NSMutableArray *batchDidCompleteModules = [NSMutableArray new];
+  _queueModules = [NSMutableArray new];
+  _queueSlotByModuleID = [NSMutableData dataWithLength:_moduleDataByID.count * sizeof(NSUInteger)];
+  _modulesWithoutQueueCount = 0;
+  NSUInteger *queueSlotByModuleID = _queueSlotByModuleID.mutableBytes;
+
+  for (RCTModuleData *moduleData in _moduleDataByID) {
+    NSUInteger moduleID = moduleData.moduleID.unsignedIntegerValue;
+    if (moduleData.hasInstance) {
+      queueSlotByModuleID[moduleID] = [self _queueSlotForModuleData:moduleData];
+    } else {
+      queueSlotByModuleID[moduleID] = NSNotFound;
+      _modulesWithoutQueueCount++;
+    }
+
+    if ([moduleData.moduleClass instancesRespondToSelector:@selector(batchDidComplete)]) {
+      [batchDidCompleteModules addObject:moduleData];
+    }
+  }
+
+  _batchDidCompleteModules = [batchDidCompleteModules copy];
+}
+
+- (NSUInteger)_queueSlotForModuleData:(RCTModuleData *)moduleData
+{
+  dispatch_queue_t queue = moduleData.queue;
+  NSUInteger slot = 0;
+  while (slot < _queueModules.count && [_queueModules[slot] queue] != queue) {
+    slot++;
+  }
+  if (slot == _queueModules.count) {
+    [_queueModules addObject:moduleData];
+  }
+  return slot;
+}
+
+/**
+ * Creates the lazily loaded modules called by a batch, if needed, and gives
+ * their queues a slot.
+ */
+- (void)_setUpQueueSlotsForBatch:(RCTMethodCallBatch *)batch
+{
+  NSUInteger numModules = _moduleDataByID.count;
+  NSUInteger *queueSlotByModuleID = _queueSlotByModuleID.mutableBytes;
+  for (NSUInteger i = 0; i < batch.count; i++) {
+    NSUInteger moduleID = batch.calls[i].moduleID;
+    if (moduleID < numModules && queueSlotByModuleID[moduleID] == NSNotFound) {
+      RCTModuleData *moduleData = _moduleDataByID[moduleID];
+      (void)moduleData.instance;
+      queueSlotByModuleID[moduleID] = [self _queueSlotForModuleData:moduleData];
+      _modulesWithoutQueueCount--;
+    }
+  }
+}
+
 - (void)setupExecutor
 {
+  RCTPerformanceLoggerStart(RCTPLJSCExecutorSetup);
   [_javaScriptExecutor setUp];
+
+  // Executors may finish setting up on their own JS thread
+  [_javaScriptExecutor executeBlockOnJavaScriptQueue:^{
+    RCTPerformanceLoggerEnd(RCTPLJSCExecutorSetup);
+  }];
+}
+
+/**
+ * Executors with a nativeModuleProxy fetch each config when JS first uses it.
+ * They install nativeCallSyncHook too, so modules can also serve parts of their
+ * own config on demand.
+ */
+- (BOOL)usesLazyModuleConfig
+{
+  return [_javaScriptExecutor respondsToSelector:@selector(providesNativeModuleProxy)] &&
+    [_javaScriptExecutor providesNativeModuleProxy];
 }
 
 - (NSString *)moduleConfig
 {
+  BOOL lazyConfig = [self usesLazyModuleConfig];
+
   NSMutableDictionary *config = [NSMutableDictionary new];
   for (RCTModuleData *moduleData in _moduleDataByID) {
-    config[moduleData.name] = moduleData.config;
-    if ([moduleData.instance conformsToProtocol:@protocol(RCTFrameUpdateObserver)]) {
+    if (!lazyConfig) {
+      config[moduleData.name] = moduleData.config;
+    }
+    if ([moduleData.moduleClass conformsToProtocol:@protocol(RCTFrameUpdateObserver)]) {
       [_frameUpdateObservers addObject:moduleData];
     }
   }
@@ -349,7 +597,9 @@ RCT_EXTERN NSArray *RCTGetModuleClasses(void);
 
     // Register the display link to start sending js calls after everything is setup
     NSRunLoop *targetRunLoop = [_javaScriptExecutor isKindOfClass:[RCTContextExecutor class]] ? [NSRunLoop currentRunLoop] : [NSRunLoop mainRunLoop];
+    [self _registerFrameUpdateObserverPauseCallbacks];
     [_jsDisplayLink addToRunLoop:targetRunLoop forMode:NSRunLoopCommonModes];
+    [self _updateJSDisplayLinkState];
 
     // Perform the state update and notification on the main thread, so we can't run into
     // timing issues with RCTRootView
@@ -412,6 +662,36 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
   _parentBridge.executorClass = executorClass;
 }
 
+- (NSTimeInterval)idleGarbageCollectionInterval
+{
+  return _parentBridge.idleGarbageCollectionInterval;
+}
+
+- (void)setIdleGarbageCollectionInterval:(NSTimeInterval)idleGarbageCollectionInterval
+{
+  _parentBridge.idleGarbageCollectionInterval = idleGarbageCollectionInterval;
+}
+
+- (NSUInteger)idleGarbageCollectionMinHeapSize
+{
+  return _parentBridge.idleGarbageCollectionMinHeapSize;
+}
+
+- (void)setIdleGarbageCollectionMinHeapSize:(NSUInteger)idleGarbageCollectionMinHeapSize
+{
+  _parentBridge.idleGarbageCollectionMinHeapSize = idleGarbageCollectionMinHeapSize;
+}
+
+- (NSUInteger)idleGarbageCollectionHeapGrowth
+{
+  return _parentBridge.idleGarbageCollectionHeapGrowth;
+}
+
+- (void)setIdleGarbageCollectionHeapGrowth:(NSUInteger)idleGarbageCollectionHeapGrowth
+{
+  _parentBridge.idleGarbageCollectionHeapGrowth = idleGarbageCollectionHeapGrowth;
+}
+
 - (NSURL *)bundleURL
 {
   return _parentBridge.bundleURL;
@@ -462,13 +742,26 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
     [RCTBridge setCurrentBridge:nil];
   }
 
+  [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                  name:UIApplicationDidEnterBackgroundNotification
+                                                object:nil];
+  [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                  name:UIApplicationWillEnterForegroundNotification
+                                                object:nil];
+
   [_mainDisplayLink invalidate];
   _mainDisplayLink = nil;
 
   // Invalidate modules
   dispatch_group_t group = dispatch_group_create();
   for (RCTModuleData *moduleData in _moduleDataByID) {
-    if (moduleData.instance == _javaScriptExecutor) {
+    if (!moduleData.hasInstance || moduleData.instance == _javaScriptExecutor) {
+      continue;
+    }
+    if (RCTModuleClassIsShared(moduleData.moduleClass) &&
+        !RCTReleaseSharedModule(moduleData.instance)) {
+      // Still used by other bridges
+      moduleData.queue = nil;
       continue;
     }
 
@@ -492,8 +785,14 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
         RCTProfileUnhookModules(self);
       }
       _moduleDataByID = nil;
+      _moduleDataByName = nil;
       _modulesByName = nil;
+      _queueModules = nil;
+      _queueSlotByModuleID = nil;
+      _batchDidCompleteModules = nil;
       _frameUpdateObservers = nil;
+      [_recorder close];
+      _recorder = nil;
 
     }];
   });
@@ -536,11 +835,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
                                 arguments:@[@"JSTimersExecution", @"callTimers", @[@[timer]]]];
   };
 
-  if ([_javaScriptExecutor respondsToSelector:@selector(executeAsyncBlockOnJavaScriptQueue:)]) {
-    [_javaScriptExecutor executeAsyncBlockOnJavaScriptQueue:block];
-  } else {
-    [_javaScriptExecutor executeBlockOnJavaScriptQueue:block];
-  }
+  [self _executeAsyncBlockOnJavaScriptQueue:block priority:RCTJavaScriptQueuePriorityTimers];
 }
 
 - (void)enqueueApplicationScript:(NSString *)script
@@ -591,8 +886,15 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
 
   RCTProfileBeginFlowEvent();
 
+  BOOL isCallback = [method isEqualToString:@"invokeCallbackAndReturnFlushedQueue"];
+  RCTJSCallPriority priority = isCallback ? RCTJSCallPriorityEvent : RCTJSCallPriorityForModule(args[0]);
+  // Events get to the JS thread ahead of other calls, numbering the calls here
+  // lets them still be sent in the order they were made
+  int64_t sequence = OSAtomicIncrement64Barrier(&_lastScheduledCallSequence);
+  NSArray<RCTInputFlow *> *inputFlows = RCTCurrentInputFlows();
+
   __weak RCTBatchedBridge *weakSelf = self;
-  [_javaScriptExecutor executeBlockOnJavaScriptQueue:^{
+  [self _executeBlockOnJavaScriptQueue:^{
     RCTProfileEndFlowEvent();
     RCTProfileBeginEvent(0, @"enqueue_call", nil);
 
@@ -609,16 +911,166 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
         @"method": method,
         @"args": args,
       },
+      @"priority": @(priority),
+      @"sequence": @(sequence),
       RCT_IF_DEV(@"call_id": callID,)
     };
-    if ([method isEqualToString:@"invokeCallbackAndReturnFlushedQueue"]) {
+    if (inputFlows) {
+      NSMutableDictionary *callWithFlows = [call mutableCopy];
+      callWithFlows[@"input_flows"] = inputFlows;
+      call = callWithFlows;
+    }
+    if (isCallback) {
       strongSelf->_scheduledCallbacks[args[0]] = call;
+      [strongSelf _scheduleCallbackFlush];
     } else {
-      [strongSelf->_scheduledCalls addObject:call];
+      NSMutableArray *scheduledCalls = strongSelf->_scheduledCalls;
+      NSUInteger index = scheduledCalls.count;
+      while (index > 0 && [scheduledCalls[index - 1][@"sequence"] longLongValue] > sequence) {
+        index--;
+      }
+      [scheduledCalls insertObject:call atIndex:index];
+      if (strongSelf->_jsDisplayLink.paused) {
+        [strongSelf _updateJSDisplayLinkState];
+      }
     }
 
     RCTProfileEndEvent(0, @"objc_call", call);
-  }];
+  } priority:RCTJavaScriptQueuePriorityForJSCall(priority)];
+}
+
+/**
+ * Executors with a queue of their own run events and timers ahead of the other
+ * blocks that are waiting for the JS thread.
+ */
+- (void)_executeBlockOnJavaScriptQueue:(dispatch_block_t)block
+                              priority:(RCTJavaScriptQueuePriority)priority
+{
+  if ([_javaScriptExecutor respondsToSelector:@selector(executeBlockOnJavaScriptQueue:priority:)]) {
+    [_javaScriptExecutor executeBlockOnJavaScriptQueue:block priority:priority];
+  } else {
+    [_javaScriptExecutor executeBlockOnJavaScriptQueue:block];
+  }
+}
+
+- (void)_executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block
+                                   priority:(RCTJavaScriptQueuePriority)priority
+{
+  if ([_javaScriptExecutor respondsToSelector:@selector(executeAsyncBlockOnJavaScriptQueue:priority:)]) {
+    [_javaScriptExecutor executeAsyncBlockOnJavaScriptQueue:block priority:priority];
+  } else if ([_javaScriptExecutor respondsToSelector:@selector(executeAsyncBlockOnJavaScriptQueue:)]) {
+    [_javaScriptExecutor executeAsyncBlockOnJavaScriptQueue:block];
+  } else {
+    [_javaScriptExecutor executeBlockOnJavaScriptQueue:block];
+  }
+}
+
+/**
+ * Callbacks and promises are how native methods return data to JS, so rather
+ * than leaving them for the next display link tick, flush them as soon as the
+ * JS thread is done with its current work. All the callbacks resolved until
+ * then, including those from JS thread modules that resolve while their batch
+ * is being handled, go to JS together with the scheduled events that aren't
+ * waiting behind an earlier call in a single processBatch. Timers and other
+ * calls, and everything scheduled after them, are left for the next frame.
+ */
+- (void)_scheduleCallbackFlush
+{
+  RCTAssertJSThread();
+
+  if (_callbackFlushScheduled) {
+    return;
+  }
+  _callbackFlushScheduled = YES;
+
+  __weak RCTBatchedBridge *weakSelf = self;
+  dispatch_block_t block = ^{
+    RCTBatchedBridge *strongSelf = weakSelf;
+    if (!strongSelf.isValid) {
+      return;
+    }
+    RCTProfileBeginEvent(0, @"FlushCallbacks", nil);
+    [strongSelf _flushScheduledCallsBeforeDeadline:0];
+    RCTProfileEndEvent(0, @"objc_call", nil);
+  };
+
+  [self _executeAsyncBlockOnJavaScriptQueue:block priority:RCTJavaScriptQueuePriorityEvents];
+}
+
+/**
+ * Sends the scheduled callbacks, then the scheduled calls in the order they
+ * were made, up to the first timer or other call that isn't expected to fit
+ * before the deadline, based on how long calls took in previous frames. The
+ * calls from there on wait for the next frame, events included, so JS never
+ * sees them out of order. A deadline of 0 stops at the first timer or other
+ * call. No call is deferred for more than RCTMaxDeferredFrames frames.
+ */
+- (void)_flushScheduledCallsBeforeDeadline:(CFTimeInterval)deadline
+{
+  RCTAssertJSThread();
+
+  _callbackFlushScheduled = NO;
+
+  NSMutableArray *calls = [_scheduledCallbacks.allObjects mutableCopy];
+  [_scheduledCallbacks removeAllObjects];
+
+  BOOL ignoresBudget = deadline > 0 &&
+    (_averageJSCallDuration <= 0 || _deferredFrameCount >= RCTMaxDeferredFrames);
+  NSTimeInterval budget = deadline - CACurrentMediaTime() - calls.count * _averageJSCallDuration;
+  NSUInteger count = 0;
+  for (NSDictionary *call in _scheduledCalls) {
+    if (!ignoresBudget && [call[@"priority"] unsignedIntegerValue] != RCTJSCallPriorityEvent &&
+        (deadline <= 0 || budget < _averageJSCallDuration)) {
+      break;
+    }
+    budget -= _averageJSCallDuration;
+    count++;
+  }
+
+  NSRange range = NSMakeRange(0, count);
+  [calls addObjectsFromArray:[_scheduledCalls subarrayWithRange:range]];
+  [_scheduledCalls removeObjectsInRange:range];
+  if (deadline > 0) {
+    if (_scheduledCalls.count > 0) {
+      _deferredFrameCount++;
+      _deferredJSFrames++;
+    } else {
+      _deferredFrameCount = 0;
+    }
+  }
+
+  RCT_IF_DEV(
+    for (NSDictionary *call in calls) {
+      _RCTProfileEndFlowEvent(call[@"call_id"]);
+    }
+  )
+
+  NSMutableArray<RCTInputFlow *> *inputFlows;
+  if (RCTInputFlowIsTracing()) {
+    inputFlows = [NSMutableArray new];
+    for (NSDictionary *call in calls) {
+      NSArray<RCTInputFlow *> *callFlows = call[@"input_flows"];
+      if (callFlows) {
+        [inputFlows addObjectsFromArray:callFlows];
+      }
+    }
+    RCTInputFlowsReachStage(inputFlows, RCTInputFlowStageJS);
+  }
+
+  if (calls.count > 0) {
+    CFTimeInterval start = CACurrentMediaTime();
+    RCTPerformWithInputFlows(inputFlows, ^{
+      [self _actuallyInvokeAndProcessModule:@"BatchedBridge"
+                                     method:@"processBatch"
+                                  arguments:@[[calls valueForKey:@"js_args"]]];
+    });
+
+    // Executors that call back synchronously tell how long JS took, keep a
+    // moving average of it per call
+    NSTimeInterval callDuration = (CACurrentMediaTime() - start) / calls.count;
+    _averageJSCallDuration = _averageJSCallDuration > 0 ?
+      0.8 * _averageJSCallDuration + 0.2 * callDuration : callDuration;
+  }
 }
 
 - (void)_actuallyInvokeAndProcessModule:(NSString *)module
@@ -629,6 +1081,13 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
 
   [[NSNotificationCenter defaultCenter] postNotificationName:RCTEnqueueNotification object:nil userInfo:nil];
 
+  RCTBridgeRecorder *recorder = _recorder;
+  [recorder recordJSCall:module method:method arguments:args];
+  CFTimeInterval callStart = recorder ? CACurrentMediaTime() : 0;
+
+  // The batch JS sends back is what the input it was given resulted in
+  NSArray<RCTInputFlow *> *inputFlows = RCTCurrentInputFlows();
+
   RCTJavaScriptCallback processResponse = ^(id json, NSError *error) {
     if (error) {
       [self.redBox showError:error];
@@ -637,14 +1096,38 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
     if (!self.isValid) {
       return;
     }
+    [recorder recordFlush:json duration:CACurrentMediaTime() - callStart];
     [[NSNotificationCenter defaultCenter] postNotificationName:RCTDequeueNotification object:nil userInfo:nil];
-    [self _handleBuffer:json];
+    RCTPerformWithInputFlows(inputFlows, ^{
+      [self _handleBuffer:json];
+    });
   };
 
+  CFTimeInterval start = RCTFrameTimingIsRecording() ? CACurrentMediaTime() : 0;
   [_javaScriptExecutor executeJSCall:module
                               method:method
                            arguments:args
                             callback:processResponse];
+  if (start) {
+    RCTFrameTimingAddWork(RCTFrameWorkJSCalls, CACurrentMediaTime() - start);
+  }
+}
+
+- (void)startRecordingToPath:(NSString *)path
+{
+  [_javaScriptExecutor executeBlockOnJavaScriptQueue:^{
+    // Replacing a recorder closes its file
+    [_recorder close];
+    _recorder = [[RCTBridgeRecorder alloc] initWithPath:path];
+  }];
+}
+
+- (void)stopRecording
+{
+  [_javaScriptExecutor executeBlockOnJavaScriptQueue:^{
+    [_recorder close];
+    _recorder = nil;
+  }];
 }
 
 #pragma mark - Payload Processing
@@ -657,91 +1140,107 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
     return;
   }
 
-  NSArray *requestsArray = [RCTConvert NSArray:buffer];
-
-#if RCT_DEBUG
-
-  if (![buffer isKindOfClass:[NSArray class]]) {
-    RCTLogError(@"Buffer must be an instance of NSArray, got %@", NSStringFromClass([buffer class]));
-    return;
-  }
-
-  for (NSUInteger fieldIndex = RCTBridgeFieldRequestModuleIDs; fieldIndex <= RCTBridgeFieldParamss; fieldIndex++) {
-    id field = requestsArray[fieldIndex];
-    if (![field isKindOfClass:[NSArray class]]) {
-      RCTLogError(@"Field at index %zd in buffer must be an instance of NSArray, got %@", fieldIndex, NSStringFromClass([field class]));
+  RCTMethodCallBatch *batch = buffer;
+  if (![buffer isKindOfClass:[RCTMethodCallBatch class]]) {
+    NSError *error;
+    batch = [RCTMethodCallBatch batchWithJSONBuffer:buffer error:&error];
+    if (!batch) {
+      RCTLogError(@"%@", error.localizedDescription);
       return;
     }
   }
 
-#endif
+  NSUInteger numRequests = batch.count;
+  const RCTMethodCall *requests = batch.calls;
 
-  NSArray *moduleIDs = requestsArray[RCTBridgeFieldRequestModuleIDs];
-  NSArray *methodIDs = requestsArray[RCTBridgeFieldMethodIDs];
-  NSArray *paramsArrays = requestsArray[RCTBridgeFieldParamss];
-
-  NSUInteger numRequests = moduleIDs.count;
-
-  if (RCT_DEBUG && (numRequests != methodIDs.count || numRequests != paramsArrays.count)) {
-    RCTLogError(@"Invalid data message - all must be length: %zd", numRequests);
-    return;
+  // Group the calls by queue with a counting sort, keeping them in order
+  // within each queue. All the groups share one index buffer, which is owned
+  // by the blocks below as they may still be running when the next batch
+  // arrives.
+  if (_modulesWithoutQueueCount > 0) {
+    [self _setUpQueueSlotsForBatch:batch];
   }
 
-  NSMapTable *buckets = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory
-                                                  valueOptions:NSPointerFunctionsStrongMemory
-                                                      capacity:_moduleDataByID.count];
+  NSUInteger numModules = _moduleDataByID.count;
+  NSUInteger numQueues = _queueModules.count;
+  const NSUInteger *queueSlotByModuleID = _queueSlotByModuleID.bytes;
+  NSUInteger queueStarts[numQueues + 1];
+  memset(queueStarts, 0, sizeof(queueStarts));
+
   for (NSUInteger i = 0; i < numRequests; i++) {
-    RCTModuleData *moduleData = _moduleDataByID[[moduleIDs[i] integerValue]];
+    NSUInteger moduleID = requests[i].moduleID;
+    if (moduleID >= numModules) {
+      RCTLogError(@"Unknown moduleID %zd for request #%zd", moduleID, i);
+      continue;
+    }
     if (RCT_DEBUG) {
       // verify that class has been registered
-      (void)_modulesByName[moduleData.name];
+      (void)_modulesByName[[_moduleDataByID[moduleID] name]];
     }
-    id queue = [moduleData queue];
-    NSMutableOrderedSet *set = [buckets objectForKey:queue];
-    if (!set) {
-      set = [NSMutableOrderedSet new];
-      [buckets setObject:set forKey:queue];
+    queueStarts[queueSlotByModuleID[moduleID] + 1]++;
+  }
+  for (NSUInteger slot = 0; slot < numQueues; slot++) {
+    queueStarts[slot + 1] += queueStarts[slot];
+  }
+
+  NSUInteger fillPositions[numQueues + 1];
+  memcpy(fillPositions, queueStarts, sizeof(fillPositions));
+  NSMutableData *indexData = [NSMutableData dataWithLength:queueStarts[numQueues] * sizeof(NSUInteger)];
+  NSUInteger *indices = indexData.mutableBytes;
+  for (NSUInteger i = 0; i < numRequests; i++) {
+    NSUInteger moduleID = requests[i].moduleID;
+    if (moduleID < numModules) {
+      indices[fillPositions[queueSlotByModuleID[moduleID]]++] = i;
     }
-    [set addObject:@(i)];
   }
 
-  for (id queue in buckets) {
+  for (NSUInteger slot = 0; slot < numQueues; slot++) {
+    NSUInteger start = queueStarts[slot];
+    NSUInteger count = queueStarts[slot + 1] - start;
+    dispatch_queue_t queue = [_queueModules[slot] queue];
+    if (count == 0 || !queue) {
+      continue;
+    }
+
     RCTProfileBeginFlowEvent();
 
     dispatch_block_t block = ^{
       RCTProfileEndFlowEvent();
       RCTProfileBeginEvent(0, RCTCurrentThreadName(), nil);
 
-      NSOrderedSet *calls = [buckets objectForKey:queue];
+      const NSUInteger *calls = (const NSUInteger *)indexData.bytes + start;
+      const RCTMethodCall *requests = batch.calls;
+      NSArray *paramsArrays = batch.params;
       @autoreleasepool {
-        for (NSNumber *indexObj in calls) {
-          NSUInteger index = indexObj.unsignedIntegerValue;
+        for (NSUInteger j = 0; j < count; j++) {
+          NSUInteger index = calls[j];
           [self _handleRequestNumber:index
-                            moduleID:[moduleIDs[index] integerValue]
-                            methodID:[methodIDs[index] integerValue]
+                            moduleID:requests[index].moduleID
+                            methodID:requests[index].methodID
                               params:paramsArrays[index]];
         }
       }
 
       RCTProfileEndEvent(0, @"objc_call,dispatch_async", @{
-        @"calls": @(calls.count),
+        @"calls": @(count),
       });
     };
 
     if (queue == RCTJSThread) {
       [_javaScriptExecutor executeBlockOnJavaScriptQueue:block];
-    } else if (queue) {
+    } else {
       dispatch_async(queue, block);
     }
   }
 
   // TODO: batchDidComplete is only used by RCTUIManager - can we eliminate this special case?
-  for (RCTModuleData *moduleData in _moduleDataByID) {
-    if ([moduleData.instance respondsToSelector:@selector(batchDidComplete)]) {
-      [moduleData dispatchBlock:^{
+  NSArray<RCTInputFlow *> *inputFlows = RCTCurrentInputFlows();
+  for (RCTModuleData *moduleData in _batchDidCompleteModules) {
+    [moduleData dispatchBlock:^{
+      RCTPerformWithInputFlows(inputFlows, ^{
         [moduleData.instance batchDidComplete];
-      }];
-    }
+      });
+    }];
   }
 }
 
@@ -773,6 +1272,8 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
     return NO;
   }
 
+  CFTimeInterval start = RCTBridgeTrafficIsRecording() ? CACurrentMediaTime() : 0;
+
   @try {
     [method invokeWithBridge:self module:moduleData.instance arguments:params];
   }
@@ -783,63 +1284,224 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithBundleURL:(__unused NSURL *)bundleUR
     }
   }
 
-  NSMutableDictionary *args = [method.profileArgs mutableCopy];
-  [args setValue:method.JSMethodName forKey:@"method"];
-  [args setValue:RCTJSONStringify(RCTNullIfNil(params), NULL) forKey:@"args"];
+  if (start) {
+    [self.bridgeTraffic recordCallToModule:moduleData.name
+                                    method:method.JSMethodName
+                             argumentBytes:RCTBridgeTrafficArgumentBytes(params)
+                                  duration:CACurrentMediaTime() - start];
+  }
 
-  RCTProfileEndEvent(0, @"objc_call", args);
+  RCTProfileEndEvent(0, @"objc_call", ({
+    NSMutableDictionary *args = [method.profileArgs mutableCopy];
+    [args setValue:method.JSMethodName forKey:@"method"];
+    [args setValue:RCTJSONStringify(RCTNullIfNil(params), NULL) forKey:@"args"];
+    args;
+  }));
 
   return YES;
 }
 
+/**
+ * Used by the executor's nativeModuleProxy on the JS thread.
+ */
+- (NSArray *)configModuleNames
+{
+  return self.isValid ? _moduleDataByName.allKeys : @[];
+}
+
+- (NSDictionary *)configForModuleName:(NSString *)moduleName
+{
+  RCTAssertJSThread();
+
+  if (!self.isValid) {
+    return nil;
+  }
+
+  RCTProfileBeginEvent(0, @"Prepare module config", nil);
+  NSDictionary *config = [_moduleDataByName[moduleName] config];
+  RCTProfileEndEvent(0, @"objc_call", nil);
+  return config;
+}
+
+/**
+ * Called by the executor on the JS thread for methods exported with
+ * RCT_EXPORT_SYNC_METHOD, which skip the batch and return their result.
+ */
+- (id)callSyncNativeModule:(NSUInteger)moduleID
+                    method:(NSUInteger)methodID
+                    params:(NSArray *)params
+{
+  RCTAssertJSThread();
+
+  if (!self.isValid) {
+    return nil;
+  }
+
+  RCTModuleData *moduleData = moduleID < _moduleDataByID.count ? _moduleDataByID[moduleID] : nil;
+  if (!moduleData) {
+    RCTLogError(@"No module found for id '%zd'", moduleID);
+    return nil;
+  }
+
+  id<RCTBridgeMethod> method = methodID < moduleData.methods.count ? moduleData.methods[methodID] : nil;
+  if (method.functionType != RCTFunctionTypeSync ||
+      ![method respondsToSelector:@selector(invokeSyncWithBridge:module:arguments:)]) {
+    RCTLogError(@"Unknown sync methodID: %zd for module: %zd (%@)", methodID, moduleID, moduleData.name);
+    return nil;
+  }
+
+  RCTProfileBeginEvent(0, @"Invoke sync method", nil);
+
+  id result = nil;
+  @try {
+    result = [method invokeSyncWithBridge:self
+                                   module:moduleData.instance
+                                arguments:params];
+  }
+  @catch (NSException *exception) {
+    RCTLogError(@"Exception thrown while invoking %@ on target %@ with params %@: %@", method.JSMethodName, moduleData.name, params, exception);
+  }
+
+  RCTProfileEndEvent(0, @"objc_call", method.profileArgs);
+
+  return result;
+}
+
 - (void)_jsThreadUpdate:(CADisplayLink *)displayLink
 {
   RCTAssertJSThread();
   RCTProfileBeginEvent(0, @"DispatchFrameUpdate", nil);
 
+  if (_lastJSFrameTimestamp > 0 && displayLink.duration > 0) {
+    NSInteger frames = lround((displayLink.timestamp - _lastJSFrameTimestamp) / displayLink.duration);
+    _droppedJSFrames += MAX(0, frames - 1);
+  }
+  _lastJSFrameTimestamp = displayLink.timestamp;
+
+  if (RCTFrameTimingIsRecording()) {
+    [self.frameTiming recordFrameOnThread:RCTFrameTimingThreadJS
+                                timestamp:displayLink.timestamp
+                                 duration:displayLink.duration];
+  }
+
   RCTFrameUpdate *frameUpdate = [[RCTFrameUpdate alloc] initWithDisplayLink:displayLink];
   for (RCTModuleData *moduleData in _frameUpdateObservers) {
     id<RCTFrameUpdateObserver> observer = (id<RCTFrameUpdateObserver>)moduleData.instance;
     if (![observer respondsToSelector:@selector(isPaused)] || !observer.paused) {
-      RCT_IF_DEV(NSString *name = [NSString stringWithFormat:@"[%@ didUpdateFrame:%f]", observer, displayLink.timestamp];)
       RCTProfileBeginFlowEvent();
 
       [moduleData dispatchBlock:^{
         RCTProfileEndFlowEvent();
-        RCTProfileBeginEvent(0, name, nil);
+        RCTProfileBeginEvent(0, [NSString stringWithFormat:@"[%@ didUpdateFrame:%f]", observer, frameUpdate.timestamp], nil);
         [observer didUpdateFrame:frameUpdate];
         RCTProfileEndEvent(0, @"objc_call,fps", nil);
       }];
     }
   }
 
-  NSArray *calls = [_scheduledCallbacks.allObjects arrayByAddingObjectsFromArray:_scheduledCalls];
-
-  RCT_IF_DEV(
-    RCTProfileImmediateEvent(0, @"JS Thread Tick", 'g');
-
-    for (NSDictionary *call in calls) {
-      _RCTProfileEndFlowEvent(call[@"call_id"]);
-    }
-  )
+  RCTProfileImmediateEvent(0, @"JS Thread Tick", 'g');
 
-  if (calls.count > 0) {
-    _scheduledCalls = [NSMutableArray new];
-    _scheduledCallbacks = [RCTSparseArray new];
-    [self _actuallyInvokeAndProcessModule:@"BatchedBridge"
-                                   method:@"processBatch"
-                                arguments:@[[calls valueForKey:@"js_args"]]];
-  }
+  [self _flushScheduledCallsBeforeDeadline:displayLink.timestamp + displayLink.duration];
+  [self _updateJSDisplayLinkState];
 
   RCTProfileEndEvent(0, @"objc_call", nil);
 
   RCT_IF_DEV(
+    NSUInteger droppedJSFrames = _droppedJSFrames;
+    NSUInteger deferredJSFrames = _deferredJSFrames;
     dispatch_async(dispatch_get_main_queue(), ^{
-      [self.perfStats.jsGraph onTick:displayLink.timestamp];
+      RCTPerfStats *perfStats = self.perfStats;
+      [perfStats.jsGraph onTick:displayLink.timestamp];
+      perfStats.droppedJSFrames = droppedJSFrames;
+      perfStats.deferredJSFrames = deferredJSFrames;
     });
   )
 }
 
+/**
+ * Observers that can tell when they are paused get a callback to call when
+ * that changes, so the JS display link can stop while none of them has work.
+ */
+- (void)_registerFrameUpdateObserverPauseCallbacks
+{
+  RCTAssertJSThread();
+
+  __weak RCTBatchedBridge *weakSelf = self;
+  dispatch_block_t pauseCallback = ^{
+    RCTBatchedBridge *strongSelf = weakSelf;
+    [strongSelf _executeBlockOnJavaScriptQueue:^{
+      [weakSelf _updateJSDisplayLinkState];
+    } priority:RCTJavaScriptQueuePriorityEvents];
+  };
+
+  for (RCTModuleData *moduleData in _frameUpdateObservers) {
+    id<RCTFrameUpdateObserver> observer = (id<RCTFrameUpdateObserver>)moduleData.instance;
+    if ([observer respondsToSelector:@selector(setPauseCallback:)]) {
+      observer.pauseCallback = pauseCallback;
+    }
+  }
+}
+
+/**
+ * The JS display link only runs while something needs the next frame: an
+ * observer that isn't paused, or one that can't say when it resumes, or calls
+ * that are waiting for a frame. In the background it doesn't run at all, so an
+ * idle app doesn't wake up the JS thread on every screen refresh. It keeps
+ * running while frame timing is recording, which would count the pauses as
+ * long frames.
+ */
+- (void)_updateJSDisplayLinkState
+{
+  RCTAssertJSThread();
+
+  if (!_jsDisplayLink) {
+    return;
+  }
+
+  BOOL needsFrame = RCTFrameTimingIsRecording() || _scheduledCalls.count > 0;
+  for (RCTModuleData *moduleData in _frameUpdateObservers) {
+    if (needsFrame) {
+      break;
+    }
+    id<RCTFrameUpdateObserver> observer = (id<RCTFrameUpdateObserver>)moduleData.instance;
+    needsFrame = ![observer respondsToSelector:@selector(isPaused)] ||
+      ![observer respondsToSelector:@selector(setPauseCallback:)] ||
+      !observer.paused;
+  }
+
+  BOOL paused = _inBackground || !needsFrame;
+  if (paused && !_jsDisplayLink.paused) {
+    // Frames skipped while paused weren't dropped
+    _lastJSFrameTimestamp = 0;
+    if ([_javaScriptExecutor respondsToSelector:@selector(handleIdle)]) {
+      [_javaScriptExecutor handleIdle];
+    }
+  }
+  _jsDisplayLink.paused = paused;
+}
+
+- (void)_applicationDidEnterBackground
+{
+  RCTAssertMainThread();
+
+  _mainDisplayLink.paused = YES;
+  [self _executeBlockOnJavaScriptQueue:^{
+    _inBackground = YES;
+    [self _updateJSDisplayLinkState];
+  } priority:RCTJavaScriptQueuePriorityEvents];
+}
+
+- (void)_applicationWillEnterForeground
+{
+  RCTAssertMainThread();
+
+  _mainDisplayLink.paused = NO;
+  [self _executeBlockOnJavaScriptQueue:^{
+    _inBackground = NO;
+    [self _updateJSDisplayLinkState];
+  } priority:RCTJavaScriptQueuePriorityEvents];
+}
+
 - (void)_mainThreadUpdate:(CADisplayLink *)displayLink
 {
   RCTAssertMainThread();
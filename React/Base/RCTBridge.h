@@ -114,6 +114,21 @@ RCT_EXTERN NSString *RCTBridgeModuleNameForClass(Class bridgeModuleClass);
  */
 @property (nonatomic, strong) Class executorClass;
 
+/**
+ * While the bridge is idle, i.e. when JS has nothing to do in the coming
+ * frames, its executor may collect garbage. It does so at most once every
+ * idleGarbageCollectionInterval seconds, 0 turns it off, and only once JSC's
+ * heap holds at least
+ * idleGarbageCollectionMinHeapSize bytes and has grown by
+ * idleGarbageCollectionHeapGrowth since the last time. The heap conditions need
+ * JSC to report its heap size, and are skipped where it doesn't. The defaults
+ * depend on the device: those with little memory collect more often, at
+ * smaller heap sizes. Changes apply from the next idle period.
+ */
+@property (nonatomic, assign) NSTimeInterval idleGarbageCollectionInterval;
+@property (nonatomic, assign) NSUInteger idleGarbageCollectionMinHeapSize;
+@property (nonatomic, assign) NSUInteger idleGarbageCollectionHeapGrowth;
+
 /**
  * The delegate provided during the bridge initialization
  */
@@ -160,4 +175,13 @@ RCT_EXTERN NSString *RCTBridgeModuleNameForClass(Class bridgeModuleClass);
  */
 - (void)reload;
 
+/**
+ * Records every call into JS, and the calls JS makes in return, to the file
+ * at path until -stopRecording, so that the session can be replayed as a
+ * benchmark. See RCTBridgeRecorder for the format. Starting again replaces
+ * the current recording. Safe to call from any thread.
+ */
+- (void)startRecordingToPath:(NSString *)path;
+- (void)stopRecording;
+
 @end
@@ -169,6 +169,7 @@ static RCTBridge *RCTCurrentBridgeInstance = nil;
 
     _delegate = delegate;
     _launchOptions = [launchOptions copy];
+    [self setUpIdleGarbageCollectionDefaults];
     [self setUp];
     [self bindKeys];
   }
@@ -187,6 +188,7 @@ static RCTBridge *RCTCurrentBridgeInstance = nil;
     _bundleURL = bundleURL;
     _moduleProvider = block;
     _launchOptions = [launchOptions copy];
+    [self setUpIdleGarbageCollectionDefaults];
     [self setUp];
     [self bindKeys];
   }
@@ -195,6 +197,25 @@ static RCTBridge *RCTCurrentBridgeInstance = nil;
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
+/**
+ * Devices with at most this much memory collect garbage at idle more eagerly,
+ * since a bigger heap could get the app killed in the background.
+ */
+static const unsigned long long RCTLowMemoryDevicePhysicalMemory = 512 * 1024 * 1024;
+
+- (void)setUpIdleGarbageCollectionDefaults
+{
+  if ([NSProcessInfo processInfo].physicalMemory <= RCTLowMemoryDevicePhysicalMemory) {
+    _idleGarbageCollectionInterval = 2;
+    _idleGarbageCollectionMinHeapSize = 4 * 1024 * 1024;
+    _idleGarbageCollectionHeapGrowth = 1024 * 1024;
+  } else {
+    _idleGarbageCollectionInterval = 10;
+    _idleGarbageCollectionMinHeapSize = 16 * 1024 * 1024;
+    _idleGarbageCollectionHeapGrowth = 4 * 1024 * 1024;
+  }
+}
+
 - (void)dealloc
 {
   /**
@@ -293,6 +314,16 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   [self.batchedBridge enqueueJSCall:moduleDotMethod args:args];
 }
 
+- (void)startRecordingToPath:(NSString *)path
+{
+  [self.batchedBridge startRecordingToPath:path];
+}
+
+- (void)stopRecording
+{
+  [self.batchedBridge stopRecording];
+}
+
 RCT_INNER_BRIDGE_ONLY(_invokeAndProcessModule:(__unused NSString *)module
                       method:(__unused NSString *)method
                       arguments:(__unused NSArray *)args);
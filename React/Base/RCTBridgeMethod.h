@@ -14,6 +14,7 @@
 typedef NS_ENUM(NSUInteger, RCTFunctionType) {
   RCTFunctionTypeNormal,
   RCTFunctionTypePromise,
+  RCTFunctionTypeSync,
 };
 
 @protocol RCTBridgeMethod <NSObject>
@@ -26,4 +27,15 @@ typedef NS_ENUM(NSUInteger, RCTFunctionType) {
                   module:(id)module
                arguments:(NSArray *)arguments;
 
+@optional
+
+/**
+ * Required for methods of RCTFunctionTypeSync. Calls the method on the current
+ * thread and returns its result, or nil if the arguments could not be
+ * converted.
+ */
+- (id)invokeSyncWithBridge:(RCTBridge *)bridge
+                    module:(id)module
+                 arguments:(NSArray *)arguments;
+
 @end
@@ -48,6 +48,25 @@ typedef void (^RCTPromiseRejectBlock)(NSError *error);
  */
 extern dispatch_queue_t RCTJSThread;
 
+/**
+ * How urgent the methods of a module are, returned from +methodQueuePriority.
+ * Modules of the same priority share a serial target queue, so a batch of
+ * calls to several of them wakes up one thread rather than one per module.
+ */
+typedef NS_ENUM(NSInteger, RCTMethodQueuePriority) {
+  RCTMethodQueuePriorityDefault = 0,
+  RCTMethodQueuePriorityUserInteractive,
+  RCTMethodQueuePriorityUtility,
+  RCTMethodQueuePriorityBackground,
+};
+
+/**
+ * While a module method called from JS runs, the bridge that called it, nil
+ * otherwise. Modules shared across bridges use this to send their events back
+ * to the bridge that asked for them, callbacks and promises already go there.
+ */
+RCT_EXTERN RCTBridge *RCTCallingBridge(void);
+
 /**
  * Provides the interface needed to register a bridge module.
  */
@@ -67,8 +86,37 @@ RCT_EXTERN void RCTRegisterModule(Class); \
 // Implemented by RCT_EXPORT_MODULE
 + (NSString *)moduleName;
 
+/**
+ * Use this instead of RCT_EXPORT_MODULE for modules that don't need to exist
+ * until they're used. The bridge then only creates the module the first time
+ * JS calls one of its methods, or it's looked up in bridge.modules, which may
+ * happen on any thread.
+ *
+ * Modules that export constants or methodsToExport, implement batchDidComplete
+ * or observe frame updates are still created when the bridge starts. Lazy
+ * modules aren't listed in bridge.modules.allValues until they've been created.
+ */
+#define RCT_EXPORT_LAZY_MODULE(js_name) \
+RCT_EXPORT_MODULE(js_name) \
++ (BOOL)isLazilyLoaded { return YES; }
+
 @optional
 
+// Implemented by RCT_EXPORT_LAZY_MODULE
++ (BOOL)isLazilyLoaded;
+
+/**
+ * Return YES for a module that keeps process-wide state, like a storage file
+ * or a URL session, to have a single instance of it shared by every bridge.
+ * The first bridge that creates the module creates the instance and its queue,
+ * and the instance is invalidated along with the last bridge that used it.
+ *
+ * Shared modules aren't given a bridge, see RCTCallingBridge() for routing
+ * their events. Their methods may be called by several bridges, in turn, on
+ * the module's queue.
+ */
++ (BOOL)isSharedAcrossBridges;
+
 /**
  * A reference to the RCTBridge. Useful for modules that require access
  * to bridge features, such as sending events or making JS calls. This
@@ -100,6 +148,17 @@ RCT_EXTERN void RCTRegisterModule(Class); \
  */
 @property (nonatomic, strong, readonly) dispatch_queue_t methodQueue;
 
+/**
+ * The priority of the queue the bridge creates for the module, when it doesn't
+ * return a methodQueue of its own. Defaults to RCTMethodQueuePriorityDefault.
+ * Only modules that update the UI while the user interacts with it should use
+ * RCTMethodQueuePriorityUserInteractive, and work nobody waits for, like
+ * writing to disk or reporting, belongs in the lower ones. JS may hold back
+ * calls to RCTMethodQueuePriorityBackground modules for up to half a second
+ * while it has calls to other modules to send.
+ */
++ (RCTMethodQueuePriority)methodQueuePriority;
+
 /**
  * Wrap the parameter line of your method implementation with this macro to
  * expose it to JS. By default the exposed method will match the first part of
@@ -155,6 +214,35 @@ RCT_EXTERN void RCTRegisterModule(Class); \
   RCT_EXTERN_REMAP_METHOD(js_name, method) \
   - (void)method
 
+/**
+ * Exports a method that JS calls synchronously, getting back the value it
+ * returns instead of going through the batched bridge. Use it for cheap,
+ * read-only lookups such as cached values, where waiting for the next batch
+ * is the expensive part.
+ *
+ * The method runs on the JavaScript thread, not on the module's methodQueue,
+ * so it must be thread-safe and must not block. It returns a JSON-compatible
+ * object (nil becomes null) and cannot take callbacks or promise blocks:
+ *
+ * RCT_EXPORT_SYNC_METHOD(valueForKey:(NSString *)key)
+ * {
+ *   @synchronized(self) {
+ *     return _cache[key];
+ *   }
+ * }
+ */
+#define RCT_EXPORT_SYNC_METHOD(method) \
+  RCT_REMAP_SYNC_METHOD(, method)
+
+/**
+ * Like RCT_EXPORT_SYNC_METHOD, but lets you set the JS name of the method.
+ */
+#define RCT_REMAP_SYNC_METHOD(js_name, method) \
+  + (NSArray *)RCT_CONCAT(__rct_export__, RCT_CONCAT(js_name, RCT_CONCAT(__LINE__, __COUNTER__))) { \
+    return @[@#js_name, @#method, @YES]; \
+  } \
+  - (id)method
+
 /**
  * Use this macro in a private Objective-C implementation file to automatically
  * register an external module with the bridge when it loads. This allows you to
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Records the traffic of a bridge so that real sessions can be replayed as
+ * benchmarks, in the same format as BridgeRecorder in ReactAndroid. The file
+ * has one JSON array per line, with times in µs since the recording started:
+ *
+ *   [timeUs, "call", module, method, arguments]
+ *     a call from native into JS
+ *   [timeUs, "flush", durationUs, [moduleIDs, methodIDs, params]]
+ *     the calls JS made while handling the previous call, which took
+ *     durationUs, in the flushed queue format `_handleBuffer:` reads
+ *
+ * Only used on the JS thread.
+ */
+@interface RCTBridgeRecorder : NSObject
+
+/**
+ * Returns nil if the file can't be created.
+ */
+- (instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+
+- (void)recordJSCall:(NSString *)module
+              method:(NSString *)method
+           arguments:(NSArray *)arguments;
+
+/**
+ * The buffer is what JS flushed, either as JSON or as an RCTMethodCallBatch.
+ */
+- (void)recordFlush:(id)buffer duration:(NSTimeInterval)duration;
+
+/**
+ * Writes out what is still buffered and closes the file. Recording stops.
+ */
+- (void)close;
+
+/**
+ * The events of a recording, each as the array it was written as.
+ */
++ (NSArray *)eventsWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+@end
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTBridgeRecorder.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTLog.h"
+#import "RCTMethodCallBatch.h"
+#import "RCTUtils.h"
+
+// Output is written in chunks of about this size
+static const NSUInteger RCTBridgeRecorderFlushSize = 64 * 1024;
+
+@implementation RCTBridgeRecorder
+{
+  NSFileHandle *_fileHandle;
+  NSMutableData *_buffer;
+  CFTimeInterval _start;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+{
+  if ((self = [super init])) {
+    if (![[NSFileManager defaultManager] createFileAtPath:path contents:nil attributes:nil] ||
+        !(_fileHandle = [NSFileHandle fileHandleForWritingAtPath:path])) {
+      RCTLogError(@"Unable to create the bridge recording at %@", path);
+      return nil;
+    }
+    _buffer = [NSMutableData new];
+    _start = CACurrentMediaTime();
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (void)dealloc
+{
+  [self close];
+}
+
+- (NSNumber *)elapsedUs
+{
+  return @(llround((CACurrentMediaTime() - _start) * 1e6));
+}
+
+- (void)appendEvent:(NSArray *)event
+{
+  if (!_fileHandle) {
+    return;
+  }
+
+  NSError *error;
+  NSString *JSON = RCTJSONStringify(event, &error);
+  if (!JSON) {
+    RCTLogWarn(@"Dropped a bridge recording event that isn't valid JSON: %@", error.localizedDescription);
+    return;
+  }
+  [_buffer appendData:[JSON dataUsingEncoding:NSUTF8StringEncoding]];
+  [_buffer appendBytes:"\n" length:1];
+  if (_buffer.length >= RCTBridgeRecorderFlushSize) {
+    [self writeBuffer];
+  }
+}
+
+- (void)writeBuffer
+{
+  @try {
+    [_fileHandle writeData:_buffer];
+  }
+  @catch (NSException *exception) {
+    RCTLogError(@"Unable to write the bridge recording: %@", exception.reason);
+    _fileHandle = nil;
+  }
+  _buffer.length = 0;
+}
+
+- (void)recordJSCall:(NSString *)module
+              method:(NSString *)method
+           arguments:(NSArray *)arguments
+{
+  [self appendEvent:@[[self elapsedUs], @"call", module, method, arguments ?: @[]]];
+}
+
+- (void)recordFlush:(id)buffer duration:(NSTimeInterval)duration
+{
+  NSArray *queue = buffer;
+  if ([buffer isKindOfClass:[RCTMethodCallBatch class]]) {
+    RCTMethodCallBatch *batch = buffer;
+    NSMutableArray *moduleIDs = [NSMutableArray arrayWithCapacity:batch.count];
+    NSMutableArray *methodIDs = [NSMutableArray arrayWithCapacity:batch.count];
+    for (NSUInteger i = 0; i < batch.count; i++) {
+      [moduleIDs addObject:@(batch.calls[i].moduleID)];
+      [methodIDs addObject:@(batch.calls[i].methodID)];
+    }
+    queue = @[moduleIDs, methodIDs, batch.params];
+  } else if (![buffer isKindOfClass:[NSArray class]]) {
+    queue = @[@[], @[], @[]];
+  }
+  [self appendEvent:@[[self elapsedUs], @"flush", @(llround(duration * 1e6)), queue]];
+}
+
+- (void)close
+{
+  if (_fileHandle) {
+    [self writeBuffer];
+    [_fileHandle closeFile];
+    _fileHandle = nil;
+  }
+}
+
++ (NSArray *)eventsWithContentsOfFile:(NSString *)path error:(NSError **)error
+{
+  NSString *contents = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:error];
+  if (!contents) {
+    return nil;
+  }
+
+  NSMutableArray *events = [NSMutableArray new];
+  for (NSString *line in [contents componentsSeparatedByString:@"\n"]) {
+    if (line.length == 0) {
+      continue;
+    }
+    id event = RCTJSONParse(line, error);
+    if (![event isKindOfClass:[NSArray class]] || [event count] < 4) {
+      if (error && !*error) {
+        *error = RCTErrorWithMessage([@"Malformed bridge recording event: " stringByAppendingString:line]);
+      }
+      return nil;
+    }
+    [events addObject:event];
+  }
+  return events;
+}
+
+@end
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTBridge.h"
+#import "RCTBridgeModule.h"
+
+/**
+ * Whether bridge traffic is being recorded. Checked by the bridge and the
+ * event dispatcher before they time or measure anything.
+ */
+RCT_EXTERN BOOL RCTBridgeTrafficIsRecording(void);
+
+/**
+ * An estimate of the size of the arguments as JSON, which is close to what
+ * they took up in the batch from JS.
+ */
+RCT_EXTERN NSUInteger RCTBridgeTrafficArgumentBytes(id arguments);
+
+/**
+ * Counts the native calls made from JS, with the size of their arguments and
+ * the time spent running them, per module and method, and the events sent to
+ * JS per event name. Exported to JS as `BridgeTraffic`, so that the stats can
+ * be sent as telemetry, and shown as an overlay from the dev menu. Recording
+ * is off until started.
+ */
+@interface RCTBridgeTraffic : NSObject <RCTBridgeModule>
+
+@property (nonatomic, assign, getter=isRecording) BOOL recording;
+
+/**
+ * Can be called from any thread.
+ */
+- (void)recordCallToModule:(NSString *)moduleName
+                    method:(NSString *)methodName
+             argumentBytes:(NSUInteger)argumentBytes
+                  duration:(CFTimeInterval)duration;
+
+- (void)recordEventWithName:(NSString *)eventName;
+
+/**
+ * The stats recorded since the last reset. "calls" maps module names to
+ * method names to a "count", "argumentBytes" and "time" in ms, and "events"
+ * maps event names to counts.
+ */
+- (NSDictionary *)stats;
+
+- (void)reset;
+
+/**
+ * Shows the most expensive methods over the root view, and records while
+ * shown.
+ */
+- (void)show;
+- (void)hide;
+
+@end
+
+@interface RCTBridge (RCTBridgeTraffic)
+
+@property (nonatomic, readonly) RCTBridgeTraffic *bridgeTraffic;
+
+@end
@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTBridgeTraffic.h"
+
+#import <UIKit/UIKit.h>
+
+#import "RCTAssert.h"
+#import "RCTInvalidating.h"
+
+// The number of methods shown in the overlay
+static const NSUInteger RCTBridgeTrafficOverlayMethods = 5;
+
+static volatile BOOL RCTBridgeTrafficRecording = NO;
+
+BOOL RCTBridgeTrafficIsRecording(void)
+{
+  return RCTBridgeTrafficRecording;
+}
+
+NSUInteger RCTBridgeTrafficArgumentBytes(id arguments)
+{
+  if ([arguments isKindOfClass:[NSString class]]) {
+    return [arguments lengthOfBytesUsingEncoding:NSUTF8StringEncoding] + 2;
+  } else if ([arguments isKindOfClass:[NSNumber class]]) {
+    return [arguments stringValue].length;
+  } else if ([arguments isKindOfClass:[NSArray class]]) {
+    NSUInteger count = [arguments count];
+    NSUInteger bytes = 2 + (count ? count - 1 : 0);
+    for (id value in arguments) {
+      bytes += RCTBridgeTrafficArgumentBytes(value);
+    }
+    return bytes;
+  } else if ([arguments isKindOfClass:[NSDictionary class]]) {
+    NSUInteger count = [arguments count];
+    __block NSUInteger bytes = 2 + (count ? count - 1 : 0);
+    [arguments enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+      bytes += RCTBridgeTrafficArgumentBytes(key) + 1 + RCTBridgeTrafficArgumentBytes(value);
+    }];
+    return bytes;
+  }
+  return 4; // null
+}
+
+@interface RCTBridgeTrafficCall : NSObject
+{
+@public
+  NSString *_moduleName;
+  NSString *_methodName;
+  NSUInteger _count;
+  NSUInteger _argumentBytes;
+  CFTimeInterval _time;
+}
+
+@end
+
+@implementation RCTBridgeTrafficCall
+
+@end
+
+@interface RCTBridgeTraffic () <RCTInvalidating>
+
+@end
+
+@implementation RCTBridgeTraffic
+{
+  NSLock *_lock;
+  NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, RCTBridgeTrafficCall *> *> *_calls;
+  NSMutableDictionary<NSString *, NSNumber *> *_events;
+  UILabel *_overlay;
+  NSTimer *_overlayTimer;
+}
+
+RCT_EXPORT_MODULE(BridgeTraffic)
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+    _calls = [NSMutableDictionary new];
+    _events = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (void)invalidate
+{
+  [self hide];
+  self.recording = NO;
+}
+
+- (dispatch_queue_t)methodQueue
+{
+  return dispatch_get_main_queue();
+}
+
+- (void)setRecording:(BOOL)recording
+{
+  _recording = recording;
+  RCTBridgeTrafficRecording = recording;
+}
+
+- (void)recordCallToModule:(NSString *)moduleName
+                    method:(NSString *)methodName
+             argumentBytes:(NSUInteger)argumentBytes
+                  duration:(CFTimeInterval)duration
+{
+  [_lock lock];
+  NSMutableDictionary<NSString *, RCTBridgeTrafficCall *> *methods = _calls[moduleName];
+  if (!methods) {
+    methods = [NSMutableDictionary new];
+    _calls[moduleName] = methods;
+  }
+  RCTBridgeTrafficCall *call = methods[methodName];
+  if (!call) {
+    call = [RCTBridgeTrafficCall new];
+    call->_moduleName = moduleName;
+    call->_methodName = methodName;
+    methods[methodName] = call;
+  }
+  call->_count++;
+  call->_argumentBytes += argumentBytes;
+  call->_time += duration;
+  [_lock unlock];
+}
+
+- (void)recordEventWithName:(NSString *)eventName
+{
+  [_lock lock];
+  _events[eventName] = @(_events[eventName].unsignedIntegerValue + 1);
+  [_lock unlock];
+}
+
+- (NSDictionary *)stats
+{
+  [_lock lock];
+  NSMutableDictionary *calls = [NSMutableDictionary new];
+  [_calls enumerateKeysAndObjectsUsingBlock:^(NSString *moduleName, NSDictionary *methods, __unused BOOL *stop) {
+    NSMutableDictionary *methodStats = [NSMutableDictionary new];
+    [methods enumerateKeysAndObjectsUsingBlock:^(NSString *methodName, RCTBridgeTrafficCall *call, __unused BOOL *innerStop) {
+      methodStats[methodName] = @{
+        @"count": @(call->_count),
+        @"argumentBytes": @(call->_argumentBytes),
+        @"time": @(call->_time * 1000),
+      };
+    }];
+    calls[moduleName] = methodStats;
+  }];
+  NSDictionary *stats = @{
+    @"calls": calls,
+    @"events": [_events copy],
+  };
+  [_lock unlock];
+  return stats;
+}
+
+- (void)reset
+{
+  [_lock lock];
+  [_calls removeAllObjects];
+  [_events removeAllObjects];
+  [_lock unlock];
+}
+
+#pragma mark - Overlay
+
+- (void)show
+{
+  RCTAssertMainThread();
+
+  if (_overlay) {
+    return;
+  }
+
+  self.recording = YES;
+
+  UIView *targetView = [UIApplication sharedApplication].delegate.window.rootViewController.view;
+  _overlay = [[UILabel alloc] initWithFrame:CGRectInset(targetView.bounds, 0, 20)];
+  _overlay.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+  _overlay.backgroundColor = [UIColor colorWithRed:0 green:0 blue:34/255.0 alpha:0.8];
+  _overlay.textColor = [UIColor whiteColor];
+  _overlay.font = [UIFont fontWithName:@"Menlo" size:10];
+  _overlay.numberOfLines = 0;
+  _overlay.userInteractionEnabled = NO;
+  [targetView addSubview:_overlay];
+
+  _overlayTimer = [NSTimer scheduledTimerWithTimeInterval:1
+                                                   target:self
+                                                 selector:@selector(_updateOverlay)
+                                                 userInfo:nil
+                                                  repeats:YES];
+  [self _updateOverlay];
+}
+
+- (void)hide
+{
+  RCTAssertMainThread();
+
+  if (!_overlay) {
+    return;
+  }
+
+  [_overlayTimer invalidate];
+  _overlayTimer = nil;
+  [_overlay removeFromSuperview];
+  _overlay = nil;
+
+  self.recording = NO;
+}
+
+- (void)_updateOverlay
+{
+  [_lock lock];
+  NSMutableArray<RCTBridgeTrafficCall *> *calls = [NSMutableArray new];
+  for (NSDictionary *methods in _calls.allValues) {
+    [calls addObjectsFromArray:methods.allValues];
+  }
+  [calls sortUsingComparator:^NSComparisonResult(RCTBridgeTrafficCall *a, RCTBridgeTrafficCall *b) {
+    return a->_time < b->_time ? NSOrderedDescending :
+      (a->_time > b->_time ? NSOrderedAscending : NSOrderedSame);
+  }];
+
+  NSMutableArray<NSString *> *lines = [NSMutableArray new];
+  for (RCTBridgeTrafficCall *call in calls) {
+    if (lines.count >= RCTBridgeTrafficOverlayMethods) {
+      break;
+    }
+    [lines addObject:[NSString stringWithFormat:@"%@.%@: %zd calls, %.1fKB, %.1fms",
+                      call->_moduleName, call->_methodName, call->_count,
+                      call->_argumentBytes / 1024.0, call->_time * 1000]];
+  }
+  NSUInteger events = 0;
+  for (NSNumber *count in _events.allValues) {
+    events += count.unsignedIntegerValue;
+  }
+  [lines addObject:[NSString stringWithFormat:@"Events: %zd", events]];
+  [_lock unlock];
+
+  _overlay.text = [lines componentsJoinedByString:@"\n"];
+  [_overlay sizeToFit];
+}
+
+#pragma mark - JS API
+
+RCT_EXPORT_METHOD(startRecording)
+{
+  self.recording = YES;
+}
+
+RCT_EXPORT_METHOD(stopRecording)
+{
+  self.recording = NO;
+}
+
+RCT_EXPORT_METHOD(getStats:(RCTResponseSenderBlock)callback)
+{
+  callback(@[[self stats]]);
+}
+
+RCT_EXPORT_METHOD(resetStats)
+{
+  [self reset];
+}
+
+@end
+
+@implementation RCTBridge (RCTBridgeTraffic)
+
+- (RCTBridgeTraffic *)bridgeTraffic
+{
+  return self.modules[RCTBridgeModuleNameForClass([RCTBridgeTraffic class])];
+}
+
+@end
@@ -14,9 +14,20 @@
  * but with known, deterministic behavior. The cache will always remove items
  * outside of the specified cost/count limits, and will be automatically
  * cleared in the event of a memory warning.
+ *
+ * Lookups, insertions and evictions all take constant time. A cache that is
+ * used from many threads at once can be split into shards, each with its own
+ * lock and an equal part of the limits; eviction order is then only least
+ * recently used within each shard.
  */
 @interface RCTCache : NSCache <NSFastEnumeration>
 
+/**
+ * Creates a cache split into the given number of shards. -init creates a
+ * cache with a single shard.
+ */
+- (instancetype)initWithShardCount:(NSUInteger)shardCount;
+
 /**
  * The total number of objects currently resident in the cache.
  */
@@ -27,6 +38,21 @@
  */
 @property (nonatomic, readonly) NSUInteger totalCost;
 
+/**
+ * The number of lookups that found an object, the number that did not, and
+ * the number of objects removed to stay within the limits or because of a
+ * memory warning, since the cache was created.
+ */
+@property (nonatomic, readonly) NSUInteger hitCount;
+@property (nonatomic, readonly) NSUInteger missCount;
+@property (nonatomic, readonly) NSUInteger evictionCount;
+
+/**
+ * Evicts the least recently used objects until the total cost is at most
+ * `cost`. For a sharded cache, each shard is trimmed to its part of `cost`.
+ */
+- (void)trimToCost:(NSUInteger)cost;
+
 /**
  * Subscripting support
  */
@@ -11,6 +11,8 @@
 
 #import "RCTCache.h"
 
+#import <libkern/OSAtomic.h>
+
 #import "RCTAssert.h"
 
 #import <TargetConditionals.h>
@@ -20,9 +22,13 @@
 
 @interface RCTCacheEntry : NSObject
 
+@property (nonatomic, strong) id key;
 @property (nonatomic, strong) NSObject *object;
 @property (nonatomic, assign) NSUInteger cost;
-@property (nonatomic, assign) NSInteger sequenceNumber;
+
+// Neighbours in the shard's LRU list, which are kept alive by its dictionary
+@property (nonatomic, unsafe_unretained) RCTCacheEntry *previous;
+@property (nonatomic, unsafe_unretained) RCTCacheEntry *next;
 
 @end
 
@@ -30,6 +36,89 @@
 
 @end
 
+/**
+ * A part of the cache with its own lock. Entries are kept in a dictionary for
+ * lookups and in a doubly linked list for their order of use, least recently
+ * used first, so every operation takes constant time.
+ */
+@interface RCTCacheShard : NSObject
+
+@property (nonatomic, readonly) NSLock *lock;
+@property (nonatomic, readonly) NSMutableDictionary *entries;
+@property (nonatomic, unsafe_unretained) RCTCacheEntry *oldestEntry;
+@property (nonatomic, unsafe_unretained) RCTCacheEntry *newestEntry;
+@property (nonatomic, assign) NSUInteger totalCost;
+@property (nonatomic, assign) NSUInteger countLimit;
+@property (nonatomic, assign) NSUInteger totalCostLimit;
+
+// The thread calling the delegate while it cleans up, if any
+@property (nonatomic, strong) NSThread *cleaningThread;
+
+@end
+
+@implementation RCTCacheShard
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+    _entries = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (void)unlinkEntry:(RCTCacheEntry *)entry
+{
+  if (entry.previous) {
+    entry.previous.next = entry.next;
+  } else {
+    _oldestEntry = entry.next;
+  }
+  if (entry.next) {
+    entry.next.previous = entry.previous;
+  } else {
+    _newestEntry = entry.previous;
+  }
+  entry.previous = nil;
+  entry.next = nil;
+}
+
+- (void)appendEntry:(RCTCacheEntry *)entry
+{
+  entry.previous = _newestEntry;
+  entry.next = nil;
+  _newestEntry.next = entry;
+  _newestEntry = entry;
+  if (!_oldestEntry) {
+    _oldestEntry = entry;
+  }
+}
+
+- (void)touchEntry:(RCTCacheEntry *)entry
+{
+  if (entry != _newestEntry) {
+    [self unlinkEntry:entry];
+    [self appendEntry:entry];
+  }
+}
+
+- (void)removeEntry:(RCTCacheEntry *)entry
+{
+  _totalCost -= entry.cost;
+  [self unlinkEntry:entry];
+  [_entries removeObjectForKey:entry.key];
+}
+
+- (void)removeAllEntries
+{
+  _totalCost = 0;
+  _oldestEntry = nil;
+  _newestEntry = nil;
+  [_entries removeAllObjects];
+}
+
+@end
+
 @interface RCTCache_Private : NSObject
 
 @property (nonatomic, unsafe_unretained) id<RCTCacheDelegate> delegate;
@@ -37,30 +126,35 @@
 @property (nonatomic, assign) NSUInteger totalCostLimit;
 @property (nonatomic, copy) NSString *name;
 
-@property (nonatomic, strong) NSMutableDictionary *cache;
-@property (nonatomic, assign) NSUInteger totalCost;
-@property (nonatomic, assign) NSInteger sequenceNumber;
-
 @end
 
 @implementation RCTCache_Private
 {
   BOOL _delegateRespondsToWillEvictObject;
   BOOL _delegateRespondsToShouldEvictObject;
-  BOOL _currentlyCleaning;
-  NSMutableArray *_entryPool;
-  NSLock *_lock;
+  NSArray *_shards;
+  NSArray *_enumerationSnapshot;
+  volatile int64_t _hitCount;
+  volatile int64_t _missCount;
+  volatile int64_t _evictionCount;
 }
 
 - (instancetype)init
+{
+  return [self initWithShardCount:1];
+}
+
+- (instancetype)initWithShardCount:(NSUInteger)shardCount
 {
   if ((self = [super init]))
   {
     //create storage
-    _cache = [NSMutableDictionary new];
-    _entryPool = [NSMutableArray new];
-    _lock = [NSLock new];
-    _totalCost = 0;
+    NSMutableArray *shards = [NSMutableArray new];
+    for (NSUInteger i = 0; i < MAX(shardCount, 1); i++)
+    {
+      [shards addObject:[RCTCacheShard new]];
+    }
+    _shards = shards;
 
 #if TARGET_OS_IPHONE
 
@@ -78,6 +172,16 @@
   [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
+- (RCTCacheShard *)shardForKey:(id)key
+{
+  return _shards.count == 1 ? _shards[0] : _shards[[key hash] % _shards.count];
+}
+
+- (void)assertNotCleaning:(RCTCacheShard *)shard
+{
+  RCTAssert(shard.cleaningThread != [NSThread currentThread], @"It is not possible to modify cache from within the implementation of this delegate method.");
+}
+
 - (void)setDelegate:(id<RCTCacheDelegate>)delegate
 {
   _delegate = delegate;
@@ -85,146 +189,167 @@
   _delegateRespondsToWillEvictObject = [delegate respondsToSelector:@selector(cache:willEvictObject:)];
 }
 
+// Each shard gets an equal part of the limits, rounded up
+static NSUInteger RCTShardLimit(NSUInteger limit, NSUInteger shardCount)
+{
+  return limit ? (limit + shardCount - 1) / shardCount : 0;
+}
+
 - (void)setCountLimit:(NSUInteger)countLimit
 {
-  [_lock lock];
   _countLimit = countLimit;
-  [_lock unlock];
-  [self cleanUp:NO];
+  for (RCTCacheShard *shard in _shards)
+  {
+    [shard.lock lock];
+    shard.countLimit = RCTShardLimit(countLimit, _shards.count);
+    [self cleanUpShard:shard];
+    [shard.lock unlock];
+  }
 }
 
 - (void)setTotalCostLimit:(NSUInteger)totalCostLimit
 {
-  [_lock lock];
   _totalCostLimit = totalCostLimit;
-  [_lock unlock];
-  [self cleanUp:NO];
+  for (RCTCacheShard *shard in _shards)
+  {
+    [shard.lock lock];
+    shard.totalCostLimit = RCTShardLimit(totalCostLimit, _shards.count);
+    [self cleanUpShard:shard];
+    [shard.lock unlock];
+  }
 }
 
 - (NSUInteger)count
 {
-  return _cache.count;
+  NSUInteger count = 0;
+  for (RCTCacheShard *shard in _shards)
+  {
+    [shard.lock lock];
+    count += shard.entries.count;
+    [shard.lock unlock];
+  }
+  return count;
 }
 
-- (void)cleanUp:(BOOL)keepEntries
+- (NSUInteger)totalCost
 {
-  [_lock lock];
-  NSUInteger maxCount = _countLimit ?: INT_MAX;
-  NSUInteger maxCost = _totalCostLimit ?: INT_MAX;
-  NSUInteger totalCount = _cache.count;
-  NSMutableArray *keys = [_cache.allKeys mutableCopy];
-  while (totalCount > maxCount || _totalCost > maxCost)
+  NSUInteger totalCost = 0;
+  for (RCTCacheShard *shard in _shards)
   {
-    NSInteger lowestSequenceNumber = INT_MAX;
-    RCTCacheEntry *lowestEntry = nil;
-    id lowestKey = nil;
+    [shard.lock lock];
+    totalCost += shard.totalCost;
+    [shard.lock unlock];
+  }
+  return totalCost;
+}
 
-    //remove oldest items until within limit
-    for (id key in keys)
-    {
-      RCTCacheEntry *entry = _cache[key];
-      if (entry.sequenceNumber < lowestSequenceNumber)
-      {
-        lowestSequenceNumber = entry.sequenceNumber;
-        lowestEntry = entry;
-        lowestKey = key;
-      }
-    }
+- (NSUInteger)hitCount
+{
+  return (NSUInteger)OSAtomicAdd64Barrier(0, &_hitCount);
+}
 
-    if (lowestKey)
-    {
-      [keys removeObject:lowestKey];
-      if (!_delegateRespondsToShouldEvictObject ||
-          [_delegate cache:(RCTCache *)self shouldEvictObject:lowestEntry.object])
-      {
-        if (_delegateRespondsToWillEvictObject)
-        {
-          _currentlyCleaning = YES;
-          [self.delegate cache:(RCTCache *)self willEvictObject:lowestEntry.object];
-          _currentlyCleaning = NO;
-        }
-        [_cache removeObjectForKey:lowestKey];
-        _totalCost -= lowestEntry.cost;
-        totalCount --;
-        if (keepEntries)
-        {
-          [_entryPool addObject:lowestEntry];
-          lowestEntry.object = nil;
-        }
-      }
-    }
+- (NSUInteger)missCount
+{
+  return (NSUInteger)OSAtomicAdd64Barrier(0, &_missCount);
+}
+
+- (NSUInteger)evictionCount
+{
+  return (NSUInteger)OSAtomicAdd64Barrier(0, &_evictionCount);
+}
+
+/**
+ * Asks the delegate whether the entry can be evicted and, if so, evicts it.
+ * Must be called with the shard's lock held.
+ */
+- (BOOL)evictEntry:(RCTCacheEntry *)entry fromShard:(RCTCacheShard *)shard
+{
+  if (_delegateRespondsToShouldEvictObject &&
+      ![_delegate cache:(RCTCache *)self shouldEvictObject:entry.object])
+  {
+    return NO;
   }
-  [_lock unlock];
+  if (_delegateRespondsToWillEvictObject)
+  {
+    shard.cleaningThread = [NSThread currentThread];
+    [_delegate cache:(RCTCache *)self willEvictObject:entry.object];
+    shard.cleaningThread = nil;
+  }
+  [shard removeEntry:entry];
+  OSAtomicIncrement64Barrier(&_evictionCount);
+  return YES;
 }
 
-- (void)cleanUpAllObjects
+/**
+ * Removes the least recently used entries until the shard is within its
+ * limits. Must be called with the shard's lock held.
+ */
+- (void)cleanUpShard:(RCTCacheShard *)shard
 {
-  [_lock lock];
-  if (_delegateRespondsToShouldEvictObject || _delegateRespondsToWillEvictObject)
+  NSUInteger maxCount = shard.countLimit ?: NSUIntegerMax;
+  NSUInteger maxCost = shard.totalCostLimit ?: NSUIntegerMax;
+  RCTCacheEntry *entry = shard.oldestEntry;
+  while (entry && (shard.entries.count > maxCount || shard.totalCost > maxCost))
   {
-    NSArray *keys = _cache.allKeys;
-    if (_delegateRespondsToShouldEvictObject)
-    {
-      //sort, oldest first (in case we want to use that information in our eviction test)
-      keys = [keys sortedArrayUsingComparator:^NSComparisonResult(id key1, id key2) {
-        RCTCacheEntry *entry1 = self->_cache[key1];
-        RCTCacheEntry *entry2 = self->_cache[key2];
-        return (NSComparisonResult)MIN(1, MAX(-1, entry1.sequenceNumber - entry2.sequenceNumber));
-      }];
-    }
+    RCTCacheEntry *next = entry.next;
+    [self evictEntry:entry fromShard:shard];
+    entry = next;
+  }
+}
 
-    //remove all items individually
-    for (id key in keys)
+- (void)trimToCost:(NSUInteger)cost
+{
+  NSUInteger shardCost = RCTShardLimit(cost, _shards.count);
+  for (RCTCacheShard *shard in _shards)
+  {
+    [shard.lock lock];
+    RCTCacheEntry *entry = shard.oldestEntry;
+    while (entry && shard.totalCost > shardCost)
     {
-      RCTCacheEntry *entry = _cache[key];
-      if (!_delegateRespondsToShouldEvictObject || [_delegate cache:(RCTCache *)self shouldEvictObject:entry.object])
-      {
-        if (_delegateRespondsToWillEvictObject)
-        {
-          _currentlyCleaning = YES;
-          [_delegate cache:(RCTCache *)self willEvictObject:entry.object];
-          _currentlyCleaning = NO;
-        }
-        [_cache removeObjectForKey:key];
-        _totalCost -= entry.cost;
-      }
+      RCTCacheEntry *next = entry.next;
+      [self evictEntry:entry fromShard:shard];
+      entry = next;
     }
+    [shard.lock unlock];
   }
-  else
-  {
-    _totalCost = 0;
-    [_cache removeAllObjects];
-    _sequenceNumber = 0;
-  }
-  [_lock unlock];
 }
 
-- (void)resequence
+- (void)cleanUpAllObjects
 {
-  //sort, oldest first
-  NSArray *entries = [_cache.allValues sortedArrayUsingComparator:^NSComparisonResult(RCTCacheEntry *entry1, RCTCacheEntry *entry2) {
-    return (NSComparisonResult)MIN(1, MAX(-1, entry1.sequenceNumber - entry2.sequenceNumber));
-  }];
-
-  //renumber items
-  NSInteger index = 0;
-  for (RCTCacheEntry *entry in entries)
+  for (RCTCacheShard *shard in _shards)
   {
-    entry.sequenceNumber = index++;
+    [shard.lock lock];
+    if (_delegateRespondsToShouldEvictObject || _delegateRespondsToWillEvictObject)
+    {
+      //remove all items individually, oldest first (in case we want to use that information in our eviction test)
+      RCTCacheEntry *entry = shard.oldestEntry;
+      while (entry)
+      {
+        RCTCacheEntry *next = entry.next;
+        [self evictEntry:entry fromShard:shard];
+        entry = next;
+      }
+    }
+    else
+    {
+      [shard removeAllEntries];
+    }
+    [shard.lock unlock];
   }
 }
 
 - (id)objectForKey:(id)key
 {
-  [_lock lock];
-  RCTCacheEntry *entry = _cache[key];
-  entry.sequenceNumber = _sequenceNumber++;
-  if (_sequenceNumber < 0)
+  RCTCacheShard *shard = [self shardForKey:key];
+  [shard.lock lock];
+  RCTCacheEntry *entry = shard.entries[key];
+  if (entry)
   {
-    [self resequence];
+    [shard touchEntry:entry];
   }
   id object = entry.object;
-  [_lock unlock];
+  [shard.lock unlock];
+  OSAtomicIncrement64Barrier(object ? &_hitCount : &_missCount);
   return object;
 }
 
@@ -250,70 +375,87 @@
     [self removeObjectForKey:key];
     return;
   }
-  RCTAssert(!_currentlyCleaning, @"It is not possible to modify cache from within the implementation of this delegate method.");
-  [_lock lock];
-  _totalCost -= [_cache[key] cost];
-  _totalCost += g;
-  RCTCacheEntry *entry = _cache[key];
-  if (!entry) {
+  RCTCacheShard *shard = [self shardForKey:key];
+  [self assertNotCleaning:shard];
+  [shard.lock lock];
+  RCTCacheEntry *entry = shard.entries[key];
+  if (entry)
+  {
+    shard.totalCost -= entry.cost;
+    [shard touchEntry:entry];
+  }
+  else
+  {
     entry = [RCTCacheEntry new];
-    _cache[key] = entry;
+    entry.key = key;
+    shard.entries[key] = entry;
+    [shard appendEntry:entry];
   }
   entry.object = obj;
   entry.cost = g;
-  entry.sequenceNumber = _sequenceNumber++;
-  if (_sequenceNumber < 0)
-  {
-    [self resequence];
-  }
-  [_lock unlock];
-  [self cleanUp:YES];
+  shard.totalCost += g;
+  [self cleanUpShard:shard];
+  [shard.lock unlock];
 }
 
 - (void)removeObjectForKey:(id)key
 {
-  RCTAssert(!_currentlyCleaning, @"It is not possible to modify cache from within the implementation of this delegate method.");
-  [_lock lock];
-  RCTCacheEntry *entry = _cache[key];
+  RCTCacheShard *shard = [self shardForKey:key];
+  [self assertNotCleaning:shard];
+  [shard.lock lock];
+  RCTCacheEntry *entry = shard.entries[key];
   if (entry) {
-    _totalCost -= entry.cost;
-    entry.object = nil;
-    [_entryPool addObject:entry];
-    [_cache removeObjectForKey:key];
+    [shard removeEntry:entry];
   }
-  [_lock unlock];
+  [shard.lock unlock];
 }
 
 - (void)removeAllObjects
 {
-  RCTAssert(!_currentlyCleaning, @"It is not possible to modify cache from within the implementation of this delegate method.");
-  [_lock lock];
-  _totalCost = 0;
-  _sequenceNumber = 0;
-  for (RCTCacheEntry *entry in _cache.allValues)
+  for (RCTCacheShard *shard in _shards)
   {
-    entry.object = nil;
-    [_entryPool addObject:entry];
+    [self assertNotCleaning:shard];
+    [shard.lock lock];
+    [shard removeAllEntries];
+    [shard.lock unlock];
   }
-  [_cache removeAllObjects];
-  [_lock unlock];
 }
 
 - (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
                                   objects:(id __unsafe_unretained [])buffer
                                     count:(NSUInteger)len
 {
-  [_lock lock];
-  NSUInteger count = [_cache countByEnumeratingWithState:state objects:buffer count:len];
-  [_lock unlock];
-  return count;
+  // Enumerates a snapshot of the keys, since they are spread over the shards
+  if (state->state == 0)
+  {
+    NSMutableArray *keys = [NSMutableArray new];
+    for (RCTCacheShard *shard in _shards)
+    {
+      [shard.lock lock];
+      [keys addObjectsFromArray:shard.entries.allKeys];
+      [shard.lock unlock];
+    }
+    _enumerationSnapshot = keys;
+  }
+  return [_enumerationSnapshot countByEnumeratingWithState:state objects:buffer count:len];
 }
 
 - (void)enumerateKeysAndObjectsUsingBlock:(void (^)(id key, id obj, BOOL *stop))block
 {
-  [_lock lock];
-  [_cache enumerateKeysAndObjectsUsingBlock:block];
-  [_lock unlock];
+  __block BOOL stop = NO;
+  for (RCTCacheShard *shard in _shards)
+  {
+    [shard.lock lock];
+    [shard.entries enumerateKeysAndObjectsUsingBlock:^(id key, RCTCacheEntry *entry, BOOL *innerStop) {
+      block(key, entry.object, &stop);
+      *innerStop = stop;
+    }];
+    [shard.lock unlock];
+    if (stop)
+    {
+      break;
+    }
+  }
 }
 
 //handle unimplemented methods
@@ -360,6 +502,8 @@
 
 - (id)objectForKeyedSubscript:(__unused id<NSCopying>)key { return nil; }
 - (void)setObject:(__unused id)obj forKeyedSubscript:(__unused id<NSCopying>)key {}
+- (instancetype)initWithShardCount:(__unused NSUInteger)shardCount { return nil; }
+- (void)trimToCost:(__unused NSUInteger)cost {}
 - (void)enumerateKeysAndObjectsUsingBlock:(__unused void (^)(id, id, BOOL *))block { }
 - (NSUInteger)countByEnumeratingWithState:(__unused NSFastEnumerationState *)state
                                   objects:(__unused __unsafe_unretained id [])buffer
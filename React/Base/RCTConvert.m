@@ -14,6 +14,83 @@
 #import "RCTCache.h"
 #import "RCTDefines.h"
 
+static BOOL RCTFontKeyValuesEqual(id a, id b)
+{
+  return a == b || [a isEqual:b];
+}
+
+/**
+ * The arguments of a font conversion. Finding the font can take a lookup of
+ * every font in its family, so the result is kept for each combination.
+ */
+@interface RCTFontKey : NSObject <NSCopying>
+
+- (instancetype)initWithFont:(UIFont *)font
+                      family:(id)family
+                        size:(id)size
+                      weight:(id)weight
+                       style:(id)style
+             scaleMultiplier:(CGFloat)scaleMultiplier;
+
+@end
+
+@implementation RCTFontKey
+{
+  NSString *_fontName;
+  CGFloat _pointSize;
+  id _family;
+  id _size;
+  id _weight;
+  id _style;
+  CGFloat _scaleMultiplier;
+  NSUInteger _hash;
+}
+
+- (instancetype)initWithFont:(UIFont *)font
+                      family:(id)family
+                        size:(id)size
+                      weight:(id)weight
+                       style:(id)style
+             scaleMultiplier:(CGFloat)scaleMultiplier
+{
+  if ((self = [super init])) {
+    _fontName = font.fontName;
+    _pointSize = font.pointSize;
+    _family = family;
+    _size = size;
+    _weight = weight;
+    _style = style;
+    _scaleMultiplier = scaleMultiplier;
+    _hash = _fontName.hash ^ [_family hash] ^ ([_size hash] << 1) ^ ([_weight hash] << 2) ^
+      ([_style hash] << 3) ^ (NSUInteger)(_pointSize * 31) ^ (NSUInteger)(_scaleMultiplier * 1000);
+  }
+  return self;
+}
+
+- (id)copyWithZone:(__unused NSZone *)zone
+{
+  return self;
+}
+
+- (NSUInteger)hash
+{
+  return _hash;
+}
+
+- (BOOL)isEqual:(RCTFontKey *)key
+{
+  return [key isKindOfClass:[RCTFontKey class]] &&
+    _pointSize == key->_pointSize &&
+    _scaleMultiplier == key->_scaleMultiplier &&
+    RCTFontKeyValuesEqual(_fontName, key->_fontName) &&
+    RCTFontKeyValuesEqual(_family, key->_family) &&
+    RCTFontKeyValuesEqual(_size, key->_size) &&
+    RCTFontKeyValuesEqual(_weight, key->_weight) &&
+    RCTFontKeyValuesEqual(_style, key->_style);
+}
+
+@end
+
 @implementation RCTConvert
 
 RCT_CONVERTER(id, id, self)
@@ -377,9 +454,34 @@ RCT_CGSTRUCT_CONVERTER(CGAffineTransform, (@[
   @"a", @"b", @"c", @"d", @"tx", @"ty"
 ]), nil)
 
+/**
+ * Colors are mostly passed as processed numbers, and the same few of them are
+ * set again and again, so the UIColors for those are shared.
+ */
+static const NSUInteger RCTColorCacheCountLimit = 512;
+
 + (UIColor *)UIColor:(id)json
 {
-  if ([json isKindOfClass:[NSArray class]]) {
+  if ([json isKindOfClass:[NSNumber class]]) {
+    static RCTCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      cache = [RCTCache new];
+      cache.countLimit = RCTColorCacheCountLimit;
+    });
+
+    UIColor *color = cache[json];
+    if (!color) {
+      NSUInteger argb = [self NSUInteger:json];
+      CGFloat a = ((argb >> 24) & 0xFF) / 255.0;
+      CGFloat r = ((argb >> 16) & 0xFF) / 255.0;
+      CGFloat g = ((argb >> 8) & 0xFF) / 255.0;
+      CGFloat b = (argb & 0xFF) / 255.0;
+      color = [UIColor colorWithRed:r green:g blue:b alpha:a];
+      cache[json] = color;
+    }
+    return color;
+  } else if ([json isKindOfClass:[NSArray class]]) {
     NSArray *components = [self NSNumberArray:json];
     CGFloat alpha = components.count > 3 ? [self CGFloat:components[3]] : 1.0;
     return [UIColor colorWithRed:[self CGFloat:components[0]]
@@ -567,9 +669,39 @@ static BOOL RCTFontIsCondensed(UIFont *font)
   return [self UIFont:font withFamily:json size:nil weight:nil style:nil scaleMultiplier:1.0];
 }
 
+static const NSUInteger RCTFontCacheCountLimit = 256;
+
 + (UIFont *)UIFont:(UIFont *)font withFamily:(id)family
               size:(id)size weight:(id)weight style:(id)style
    scaleMultiplier:(CGFloat)scaleMultiplier
+{
+  static RCTCache *cache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    cache = [RCTCache new];
+    cache.countLimit = RCTFontCacheCountLimit;
+  });
+
+  RCTFontKey *key = [[RCTFontKey alloc] initWithFont:font
+                                              family:family
+                                                size:size
+                                              weight:weight
+                                               style:style
+                                     scaleMultiplier:scaleMultiplier];
+  UIFont *result = cache[key];
+  if (!result) {
+    result = [self _UIFont:font withFamily:family size:size weight:weight style:style
+           scaleMultiplier:scaleMultiplier];
+    if (result) {
+      cache[key] = result;
+    }
+  }
+  return result;
+}
+
++ (UIFont *)_UIFont:(UIFont *)font withFamily:(id)family
+               size:(id)size weight:(id)weight style:(id)style
+    scaleMultiplier:(CGFloat)scaleMultiplier
 {
   // Defaults
   NSString *const RCTDefaultFontFamily = @"System";
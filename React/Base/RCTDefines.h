@@ -60,6 +60,20 @@
 #endif
 #endif
 
+/**
+ * RCTLog calls below this level are compiled out, arguments and all. The
+ * values are those of RCTLogLevel, from 1 for info to 4 for must-fix. By
+ * default nothing is stripped in debug builds, and only errors and above are
+ * kept otherwise, which matches the default log threshold.
+ */
+#ifndef RCT_LOG_COMPILE_LEVEL
+#if RCT_DEBUG
+#define RCT_LOG_COMPILE_LEVEL 1
+#else
+#define RCT_LOG_COMPILE_LEVEL 3
+#endif
+#endif
+
 /**
  * Concat two literals. Supports macro expansions,
  * e.g. RCT_CONCAT(foo, __FILE__).
@@ -28,6 +28,26 @@ typedef NS_ENUM(NSInteger, RCTScrollEventType) {
   RCTScrollEventTypeEndAnimation,
 };
 
+/**
+ * How an event that is sent while an earlier one for the same view, name and
+ * coalescing key is still waiting for the next frame is handled.
+ */
+typedef NS_ENUM(NSInteger, RCTEventCoalescingPolicy) {
+  /**
+   * The event isn't queued, it's sent to JS right away, after any event that
+   * is already queued.
+   */
+  RCTEventCoalescingPolicyNever,
+  /**
+   * The queued event is replaced by the new one.
+   */
+  RCTEventCoalescingPolicyLatestWins,
+  /**
+   * The queued event is merged with the new one by -coalesceWithEvent:.
+   */
+  RCTEventCoalescingPolicyAccumulate,
+};
+
 /**
  * The threshold at which text inputs will start warning that the JS thread
  * has fallen behind (resulting in poor input performance, missed keys, etc.)
@@ -55,6 +75,14 @@ RCT_EXTERN NSString *RCTNormalizeInputEventName(NSString *eventName);
 
 + (NSString *)moduleDotMethod;
 
+@optional
+
+/**
+ * The arguments passed to moduleDotMethod, if they aren't the view tag, the
+ * event name and the body.
+ */
+- (NSArray *)arguments;
+
 @end
 
 @interface RCTBaseEvent : NSObject <RCTEvent>
@@ -71,6 +99,21 @@ RCT_EXTERN NSString *RCTNormalizeInputEventName(NSString *eventName);
  */
 @interface RCTEventDispatcher : NSObject <RCTBridgeModule>
 
+/**
+ * The number of queued events that were dropped because the JS thread fell
+ * too far behind to take them.
+ */
+@property (nonatomic, assign, readonly) NSUInteger droppedEventCount;
+
+/**
+ * Overrides how events with the given name are coalesced. Events with no
+ * policy set are accumulated if their -canCoalesce returns YES, and never
+ * coalesced otherwise. Input events sent with -sendInputEventWithName:body:
+ * are only coalesced if a policy is set for them; text changes default to
+ * RCTEventCoalescingPolicyLatestWins.
+ */
+- (void)setCoalescingPolicy:(RCTEventCoalescingPolicy)policy forEventName:(NSString *)eventName;
+
 /**
  * Send an application-specific event that does not relate to a specific
  * view, e.g. a navigation or data update notification.
@@ -102,4 +145,10 @@ RCT_EXTERN NSString *RCTNormalizeInputEventName(NSString *eventName);
  */
 - (void)sendEvent:(id<RCTEvent>)event;
 
+/**
+ * Sends an event caused by input that happened at the given time, in the
+ * CACurrentMediaTime() timebase, so that its latency is measured from then.
+ */
+- (void)sendEvent:(id<RCTEvent>)event originatingTime:(CFTimeInterval)originatingTime;
+
 @end
@@ -11,10 +11,15 @@
 
 #import "RCTAssert.h"
 #import "RCTBridge.h"
+#import "RCTBridgeTraffic.h"
+#import "RCTInputLatency.h"
 #import "RCTUtils.h"
 
 const NSInteger RCTTextUpdateLagWarningThreshold = 3;
 
+// Past this many queued events, the oldest ones are dropped
+static const NSUInteger RCTEventQueueCapacity = 256;
+
 NSString *RCTNormalizeInputEventName(NSString *eventName)
 {
   if ([eventName hasPrefix:@"on"]) {
@@ -81,6 +86,28 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
 @end
 
+/**
+ * An event sent with -sendInputEventWithName:body:, which is only coalesced
+ * if a policy has been set for its name.
+ */
+@interface RCTInputEvent : RCTBaseEvent
+
+@end
+
+@implementation RCTInputEvent
+
+- (BOOL)canCoalesce
+{
+  return NO;
+}
+
++ (NSString *)moduleDotMethod
+{
+  return @"RCTEventEmitter.receiveEvent";
+}
+
+@end
+
 @interface RCTEventDispatcher() <RCTFrameUpdateObserver>
 
 @end
@@ -88,11 +115,16 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 @implementation RCTEventDispatcher
 {
   NSMutableDictionary *_eventQueue;
+  NSMutableArray *_eventQueueOrder;
+  NSMutableDictionary *_eventQueueFlows;
+  NSMutableDictionary *_coalescingPolicies;
+  NSUInteger _droppedEventCount;
   NSLock *_eventQueueLock;
 }
 
 @synthesize bridge = _bridge;
 @synthesize paused = _paused;
+@synthesize pauseCallback = _pauseCallback;
 
 RCT_EXPORT_MODULE()
 
@@ -100,19 +132,31 @@ RCT_EXPORT_MODULE()
 {
   if ((self = [super init])) {
     _eventQueue = [NSMutableDictionary new];
+    _eventQueueOrder = [NSMutableArray new];
+    _eventQueueFlows = [NSMutableDictionary new];
+    _coalescingPolicies = [@{
+      RCTNormalizeInputEventName(@"change"): @(RCTEventCoalescingPolicyLatestWins),
+    } mutableCopy];
     _eventQueueLock = [NSLock new];
+    _paused = YES;
   }
   return self;
 }
 
 - (void)sendAppEventWithName:(NSString *)name body:(id)body
 {
+  if (RCTBridgeTrafficIsRecording()) {
+    [_bridge.bridgeTraffic recordEventWithName:name];
+  }
   [_bridge enqueueJSCall:@"RCTNativeAppEventEmitter.emit"
                     args:body ? @[name, body] : @[name]];
 }
 
 - (void)sendDeviceEventWithName:(NSString *)name body:(id)body
 {
+  if (RCTBridgeTrafficIsRecording()) {
+    [_bridge.bridgeTraffic recordEventWithName:name];
+  }
   [_bridge enqueueJSCall:@"RCTDeviceEventEmitter.emit"
                     args:body ? @[name, body] : @[name]];
 }
@@ -125,8 +169,9 @@ RCT_EXPORT_MODULE()
   }
 
   name = RCTNormalizeInputEventName(name);
-  [_bridge enqueueJSCall:@"RCTEventEmitter.receiveEvent"
-                    args:body ? @[body[@"target"], name, body] : @[body[@"target"], name]];
+  [self sendEvent:[[RCTInputEvent alloc] initWithViewTag:body[@"target"]
+                                               eventName:name
+                                                    body:body]];
 }
 
 - (void)sendTextEventWithType:(RCTTextEventType)type
@@ -152,30 +197,121 @@ RCT_EXPORT_MODULE()
   }];
 }
 
+- (void)setCoalescingPolicy:(RCTEventCoalescingPolicy)policy forEventName:(NSString *)eventName
+{
+  [_eventQueueLock lock];
+  _coalescingPolicies[RCTNormalizeInputEventName(eventName)] = @(policy);
+  [_eventQueueLock unlock];
+}
+
+- (NSUInteger)droppedEventCount
+{
+  [_eventQueueLock lock];
+  NSUInteger droppedEventCount = _droppedEventCount;
+  [_eventQueueLock unlock];
+  return droppedEventCount;
+}
+
 - (void)sendEvent:(id<RCTEvent>)event
 {
-  if (!event.canCoalesce) {
-    [self dispatchEvent:event];
-    return;
-  }
+  [self sendEvent:event originatingTime:0];
+}
+
+- (void)sendEvent:(id<RCTEvent>)event originatingTime:(CFTimeInterval)originatingTime
+{
+  RCTInputFlow *flow = RCTInputFlowBegin(RCTNormalizeInputEventName(event.eventName), originatingTime);
 
   [_eventQueueLock lock];
 
+  NSNumber *policy = _coalescingPolicies[RCTNormalizeInputEventName(event.eventName)];
+  RCTEventCoalescingPolicy coalescingPolicy = policy ? policy.integerValue :
+    (event.canCoalesce ? RCTEventCoalescingPolicyAccumulate : RCTEventCoalescingPolicyNever);
+
+  if (coalescingPolicy == RCTEventCoalescingPolicyNever) {
+    // Events queued before this one must not reach JS after it
+    [self flushEventQueue];
+    [self dispatchEvent:event inputFlow:flow];
+    [_eventQueueLock unlock];
+    return;
+  }
+
   NSNumber *eventID = RCTGetEventID(event);
   id<RCTEvent> previousEvent = _eventQueue[eventID];
 
   if (previousEvent) {
-    event = [previousEvent coalesceWithEvent:event];
+    if (coalescingPolicy == RCTEventCoalescingPolicyAccumulate) {
+      event = [previousEvent coalesceWithEvent:event];
+    }
+  } else {
+    if (_eventQueueOrder.count >= RCTEventQueueCapacity) {
+      // JS has fallen behind, the oldest event is the least useful one
+      [_eventQueue removeObjectForKey:_eventQueueOrder[0]];
+      [_eventQueueFlows removeObjectForKey:_eventQueueOrder[0]];
+      [_eventQueueOrder removeObjectAtIndex:0];
+      _droppedEventCount++;
+    }
+    [_eventQueueOrder addObject:eventID];
   }
 
   _eventQueue[eventID] = event;
+  // Coalesced events are as late as the oldest input they include
+  if (flow && !_eventQueueFlows[eventID]) {
+    _eventQueueFlows[eventID] = flow;
+  }
+  BOOL wasPaused = _paused;
   _paused = NO;
 
   [_eventQueueLock unlock];
+
+  if (wasPaused && _pauseCallback) {
+    _pauseCallback();
+  }
 }
 
-- (void)dispatchEvent:(id<RCTEvent>)event
+/**
+ * Sends the queued events in the order they were first queued. Must be called
+ * with the event queue lock held.
+ */
+- (void)flushEventQueue
 {
+  if (!_eventQueueOrder.count) {
+    return;
+  }
+
+  NSDictionary *eventQueue = _eventQueue;
+  NSArray *eventQueueOrder = _eventQueueOrder;
+  NSDictionary *eventQueueFlows = _eventQueueFlows.count ? _eventQueueFlows : nil;
+  _eventQueue = [NSMutableDictionary new];
+  _eventQueueOrder = [NSMutableArray new];
+  if (eventQueueFlows) {
+    _eventQueueFlows = [NSMutableDictionary new];
+  }
+
+  for (NSNumber *eventID in eventQueueOrder) {
+    [self dispatchEvent:eventQueue[eventID] inputFlow:eventQueueFlows[eventID]];
+  }
+}
+
+- (void)dispatchEvent:(id<RCTEvent>)event inputFlow:(RCTInputFlow *)flow
+{
+  if (flow) {
+    // The bridge takes the flow along with the call
+    RCTPerformWithInputFlows(@[flow], ^{
+      [self dispatchEvent:event inputFlow:nil];
+    });
+    return;
+  }
+
+  if (RCTBridgeTrafficIsRecording()) {
+    [_bridge.bridgeTraffic recordEventWithName:RCTNormalizeInputEventName(event.eventName)];
+  }
+
+  if ([event respondsToSelector:@selector(arguments)]) {
+    [_bridge enqueueJSCall:[[event class] moduleDotMethod]
+                      args:[event arguments]];
+    return;
+  }
+
   NSMutableArray *arguments = [NSMutableArray new];
 
   if (event.viewTag) {
@@ -200,13 +336,13 @@ RCT_EXPORT_MODULE()
 - (void)didUpdateFrame:(__unused RCTFrameUpdate *)update
 {
   [_eventQueueLock lock];
-   NSDictionary *eventQueue = _eventQueue;
-  _eventQueue = [NSMutableDictionary new];
+  [self flushEventQueue];
+  BOOL wasPaused = _paused;
   _paused = YES;
   [_eventQueueLock unlock];
 
-  for (id<RCTEvent> event in eventQueue.allValues) {
-    [self dispatchEvent:event];
+  if (!wasPaused && _pauseCallback) {
+    _pauseCallback();
   }
 }
 
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTBridge.h"
+#import "RCTBridgeModule.h"
+
+typedef NS_ENUM(NSUInteger, RCTFrameTimingThread) {
+  RCTFrameTimingThreadJS = 0,
+  RCTFrameTimingThreadUI,
+  RCTFrameTimingThreadCount
+};
+
+/**
+ * Work that frames are annotated with. JS calls are attributed to JS thread
+ * frames, UI blocks and layout passes to UI thread frames.
+ */
+typedef NS_ENUM(NSUInteger, RCTFrameWork) {
+  RCTFrameWorkJSCalls = 0,
+  RCTFrameWorkUIBlocks,
+  RCTFrameWorkLayout,
+  RCTFrameWorkCount
+};
+
+/**
+ * Whether frame timings are being recorded. Checked by the callers of
+ * RCTFrameTimingAddWork() before they time anything.
+ */
+RCT_EXTERN BOOL RCTFrameTimingIsRecording(void);
+
+/**
+ * Reports work done in the current frame. Can be called from any thread.
+ */
+RCT_EXTERN void RCTFrameTimingAddWork(RCTFrameWork work, CFTimeInterval duration);
+
+/**
+ * Records how long the JS and UI threads take between display refreshes, as
+ * a histogram of frame durations per thread and a count of frames over
+ * budget. The most recent janky frames are kept along with the work that ran
+ * in them. Exported to JS as `FrameTiming`, so that the stats can be sent as
+ * telemetry; recording is off until started.
+ */
+@interface RCTFrameTiming : NSObject <RCTBridgeModule>
+
+/**
+ * Upper bounds, in ms, of the histogram buckets. The last bucket holds every
+ * longer frame.
+ */
++ (NSArray<NSNumber *> *)bucketBounds;
+
+@property (nonatomic, assign, getter=isRecording) BOOL recording;
+
+/**
+ * Called on each display refresh of the given thread, with the expected
+ * frame duration.
+ */
+- (void)recordFrameOnThread:(RCTFrameTimingThread)thread
+                  timestamp:(CFTimeInterval)timestamp
+                   duration:(CFTimeInterval)frameDuration;
+
+/**
+ * The stats recorded since the last reset, keyed by "js" and "ui". Each has
+ * "frames", "jankyFrames", "droppedFrames", a "histogram" of frame counts per
+ * bucket, and "jank", the most recent janky frames.
+ */
+- (NSDictionary *)stats;
+
+- (void)reset;
+
+@end
+
+@interface RCTBridge (RCTFrameTiming)
+
+@property (nonatomic, readonly) RCTFrameTiming *frameTiming;
+
+@end
@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTFrameTiming.h"
+
+#import <libkern/OSAtomic.h>
+
+#import "RCTAssert.h"
+#import "RCTInvalidating.h"
+
+// The number of janky frames kept per thread
+static const NSUInteger RCTFrameTimingMaxJankyFrames = 32;
+
+#define RCTFrameTimingBucketCount 6
+
+static const double RCTFrameTimingBucketBounds[RCTFrameTimingBucketCount - 1] = {
+  17, 33, 50, 100, 250,
+};
+
+static volatile BOOL RCTFrameTimingRecording = NO;
+
+// Work reported since the last frame, in µs, with the number of reports
+static volatile int64_t RCTFrameWorkTime[RCTFrameWorkCount];
+static volatile int64_t RCTFrameWorkReports[RCTFrameWorkCount];
+
+BOOL RCTFrameTimingIsRecording(void)
+{
+  return RCTFrameTimingRecording;
+}
+
+void RCTFrameTimingAddWork(RCTFrameWork work, CFTimeInterval duration)
+{
+  if (RCTFrameTimingRecording) {
+    OSAtomicAdd64(duration * 1e6, &RCTFrameWorkTime[work]);
+    OSAtomicIncrement64(&RCTFrameWorkReports[work]);
+  }
+}
+
+static int64_t RCTFrameWorkTake(volatile int64_t *value)
+{
+  int64_t current;
+  do {
+    current = *value;
+  } while (!OSAtomicCompareAndSwap64Barrier(current, 0, value));
+  return current;
+}
+
+static NSArray<NSNumber *> *RCTFrameWorkForThread(RCTFrameTimingThread thread)
+{
+  switch (thread) {
+    case RCTFrameTimingThreadJS:
+      return @[@(RCTFrameWorkJSCalls)];
+    case RCTFrameTimingThreadUI:
+      return @[@(RCTFrameWorkUIBlocks), @(RCTFrameWorkLayout)];
+    default:
+      return @[];
+  }
+}
+
+static NSString *RCTFrameWorkName(RCTFrameWork work)
+{
+  switch (work) {
+    case RCTFrameWorkJSCalls:
+      return @"jsCalls";
+    case RCTFrameWorkUIBlocks:
+      return @"uiBlocks";
+    case RCTFrameWorkLayout:
+      return @"layout";
+    default:
+      return @"";
+  }
+}
+
+typedef struct {
+  CFTimeInterval lastTimestamp;
+  NSUInteger frames;
+  NSUInteger jankyFrames;
+  NSUInteger droppedFrames;
+  NSUInteger histogram[RCTFrameTimingBucketCount];
+} RCTFrameTimingThreadStats;
+
+@interface RCTFrameTiming () <RCTInvalidating>
+
+@end
+
+@implementation RCTFrameTiming
+{
+  NSLock *_lock;
+  RCTFrameTimingThreadStats _threads[RCTFrameTimingThreadCount];
+  NSMutableArray<NSDictionary *> *_jankyFrames[RCTFrameTimingThreadCount];
+  CADisplayLink *_mainDisplayLink;
+}
+
+RCT_EXPORT_MODULE(FrameTiming)
+
++ (NSArray<NSNumber *> *)bucketBounds
+{
+  NSMutableArray<NSNumber *> *bounds = [NSMutableArray new];
+  for (NSUInteger i = 0; i < RCTFrameTimingBucketCount - 1; i++) {
+    [bounds addObject:@(RCTFrameTimingBucketBounds[i])];
+  }
+  return bounds;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+    for (NSUInteger i = 0; i < RCTFrameTimingThreadCount; i++) {
+      _jankyFrames[i] = [NSMutableArray new];
+    }
+  }
+  return self;
+}
+
+- (void)invalidate
+{
+  self.recording = NO;
+}
+
+- (dispatch_queue_t)methodQueue
+{
+  return dispatch_get_main_queue();
+}
+
+- (void)setRecording:(BOOL)recording
+{
+  RCTAssertMainThread();
+
+  if (_recording == recording) {
+    return;
+  }
+  _recording = recording;
+  RCTFrameTimingRecording = recording;
+
+  [_lock lock];
+  for (NSUInteger i = 0; i < RCTFrameTimingThreadCount; i++) {
+    _threads[i].lastTimestamp = 0;
+  }
+  [_lock unlock];
+
+  // The bridge's JS thread display link calls us while recording; the UI
+  // thread needs its own, since the bridge's only exists in dev builds
+  if (recording) {
+    _mainDisplayLink = [CADisplayLink displayLinkWithTarget:self
+                                                   selector:@selector(_mainThreadUpdate:)];
+    [_mainDisplayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  } else {
+    [_mainDisplayLink invalidate];
+    _mainDisplayLink = nil;
+  }
+}
+
+- (void)_mainThreadUpdate:(CADisplayLink *)displayLink
+{
+  [self recordFrameOnThread:RCTFrameTimingThreadUI
+                  timestamp:displayLink.timestamp
+                   duration:displayLink.duration];
+}
+
+- (void)recordFrameOnThread:(RCTFrameTimingThread)thread
+                  timestamp:(CFTimeInterval)timestamp
+                   duration:(CFTimeInterval)frameDuration
+{
+  // Take the work even for the first frame, so it isn't attributed to the next
+  NSArray<NSNumber *> *workTypes = RCTFrameWorkForThread(thread);
+  int64_t workTime[RCTFrameWorkCount] = {};
+  int64_t workReports[RCTFrameWorkCount] = {};
+  for (NSNumber *type in workTypes) {
+    NSUInteger work = type.unsignedIntegerValue;
+    workTime[work] = RCTFrameWorkTake(&RCTFrameWorkTime[work]);
+    workReports[work] = RCTFrameWorkTake(&RCTFrameWorkReports[work]);
+  }
+
+  [_lock lock];
+  RCTFrameTimingThreadStats *stats = &_threads[thread];
+  CFTimeInterval lastTimestamp = stats->lastTimestamp;
+  stats->lastTimestamp = timestamp;
+  if (lastTimestamp <= 0 || frameDuration <= 0) {
+    [_lock unlock];
+    return;
+  }
+
+  CFTimeInterval elapsed = timestamp - lastTimestamp;
+  double elapsedMs = elapsed * 1000;
+  NSUInteger bucket = 0;
+  while (bucket < RCTFrameTimingBucketCount - 1 && elapsedMs > RCTFrameTimingBucketBounds[bucket]) {
+    bucket++;
+  }
+  stats->histogram[bucket]++;
+  stats->frames++;
+
+  NSInteger missed = lround(elapsed / frameDuration) - 1;
+  if (missed > 0) {
+    stats->jankyFrames++;
+    stats->droppedFrames += missed;
+
+    NSMutableDictionary *jankyFrame = [@{
+      @"timestamp": @(timestamp * 1000),
+      @"duration": @(elapsedMs),
+      @"droppedFrames": @(missed),
+    } mutableCopy];
+    for (NSNumber *type in workTypes) {
+      NSUInteger work = type.unsignedIntegerValue;
+      jankyFrame[RCTFrameWorkName(work)] = @{
+        @"count": @(workReports[work]),
+        @"time": @(workTime[work] / 1000.0),
+      };
+    }
+    NSMutableArray *jankyFrames = _jankyFrames[thread];
+    if (jankyFrames.count >= RCTFrameTimingMaxJankyFrames) {
+      [jankyFrames removeObjectAtIndex:0];
+    }
+    [jankyFrames addObject:jankyFrame];
+  }
+  [_lock unlock];
+}
+
+- (NSDictionary *)statsForThread:(RCTFrameTimingThread)thread
+{
+  RCTFrameTimingThreadStats *stats = &_threads[thread];
+  NSMutableArray *histogram = [NSMutableArray new];
+  for (NSUInteger i = 0; i < RCTFrameTimingBucketCount; i++) {
+    [histogram addObject:@(stats->histogram[i])];
+  }
+  return @{
+    @"frames": @(stats->frames),
+    @"jankyFrames": @(stats->jankyFrames),
+    @"droppedFrames": @(stats->droppedFrames),
+    @"histogram": histogram,
+    @"jank": [_jankyFrames[thread] copy],
+  };
+}
+
+- (NSDictionary *)stats
+{
+  [_lock lock];
+  NSDictionary *stats = @{
+    @"js": [self statsForThread:RCTFrameTimingThreadJS],
+    @"ui": [self statsForThread:RCTFrameTimingThreadUI],
+    @"bucketBounds": [RCTFrameTiming bucketBounds],
+  };
+  [_lock unlock];
+  return stats;
+}
+
+- (void)reset
+{
+  [_lock lock];
+  for (NSUInteger i = 0; i < RCTFrameTimingThreadCount; i++) {
+    CFTimeInterval lastTimestamp = _threads[i].lastTimestamp;
+    memset(&_threads[i], 0, sizeof(_threads[i]));
+    _threads[i].lastTimestamp = lastTimestamp;
+    [_jankyFrames[i] removeAllObjects];
+  }
+  [_lock unlock];
+}
+
+RCT_EXPORT_METHOD(startRecording)
+{
+  self.recording = YES;
+}
+
+RCT_EXPORT_METHOD(stopRecording)
+{
+  self.recording = NO;
+}
+
+RCT_EXPORT_METHOD(getStats:(RCTResponseSenderBlock)callback)
+{
+  callback(@[[self stats]]);
+}
+
+RCT_EXPORT_METHOD(resetStats)
+{
+  [self reset];
+}
+
+@end
+
+@implementation RCTBridge (RCTFrameTiming)
+
+- (RCTFrameTiming *)frameTiming
+{
+  return self.modules[RCTBridgeModuleNameForClass([RCTFrameTiming class])];
+}
+
+@end
@@ -47,4 +47,12 @@
  */
 @property (nonatomic, assign, getter=isPaused) BOOL paused;
 
+/**
+ * Set by the bridge, observers that implement paused should call it whenever
+ * paused changes. The bridge stops its display link while all the observers
+ * are paused, and only keeps it running for observers that don't synthesize
+ * this.
+ */
+@property (nonatomic, copy) dispatch_block_t pauseCallback;
+
 @end
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "RCTBridge.h"
+#import "RCTBridgeModule.h"
+
+/**
+ * The steps an input event goes through between being sent to the event
+ * dispatcher and the main thread commit of the UI blocks it caused.
+ */
+typedef NS_ENUM(NSUInteger, RCTInputFlowStage) {
+  // The event is passed to JS
+  RCTInputFlowStageJS = 0,
+  // The UI manager has laid out the batch that JS sent back
+  RCTInputFlowStageLayout,
+  RCTInputFlowStageCount
+};
+
+/**
+ * Follows one input event from the event dispatcher through the JS thread,
+ * the native calls and layout of the batch it resulted in, to the commit of
+ * that batch's UI blocks. While profiling, each flow is traced as one chain of
+ * linked flow events.
+ */
+@interface RCTInputFlow : NSObject
+
+@property (nonatomic, copy, readonly) NSString *eventName;
+@property (nonatomic, assign, readonly) CFTimeInterval startTime;
+
+@end
+
+/**
+ * Whether input events are traced, for the latency stats or for the profiler.
+ */
+RCT_EXTERN BOOL RCTInputFlowIsTracing(void);
+
+/**
+ * Starts the flow of an event that happened at the given time, in the
+ * CACurrentMediaTime() timebase, or now if it is 0. Returns nil when input
+ * events aren't traced.
+ */
+RCT_EXTERN RCTInputFlow *RCTInputFlowBegin(NSString *eventName, CFTimeInterval timestamp);
+
+RCT_EXTERN void RCTInputFlowsReachStage(NSArray<RCTInputFlow *> *flows, RCTInputFlowStage stage);
+
+/**
+ * Flows are handed from thread to thread along with the work done for them.
+ * While the block runs, the flows are current on the calling thread, and code
+ * that queues work on behalf of the block takes the current flows along. Nil
+ * if there are none.
+ */
+RCT_EXTERN NSArray<RCTInputFlow *> *RCTCurrentInputFlows(void);
+RCT_EXTERN void RCTPerformWithInputFlows(NSArray<RCTInputFlow *> *flows, dispatch_block_t block);
+
+/**
+ * Records how long input events take to reach the screen, as a histogram of
+ * latencies per event name, along with the time spent getting to JS, in JS
+ * and layout, and waiting for the commit. The latency of an event ends when
+ * the UI blocks of the first batch JS sends back after receiving it have been
+ * committed, so updates JS defers to a later batch aren't accounted for.
+ * Exported to JS as `InputLatency`; recording is off until started.
+ */
+@interface RCTInputLatency : NSObject <RCTBridgeModule>
+
+/**
+ * Upper bounds, in ms, of the histogram buckets. The last bucket holds every
+ * longer latency.
+ */
++ (NSArray<NSNumber *> *)bucketBounds;
+
+@property (nonatomic, assign, getter=isRecording) BOOL recording;
+
+/**
+ * Called on the main thread once the UI blocks of the flows' batch have been
+ * committed. Ends the flows, and records them if recording.
+ */
+- (void)endFlows:(NSArray<RCTInputFlow *> *)flows;
+
+/**
+ * The stats recorded since the last reset, as "events" keyed by event name,
+ * and the "bucketBounds". Each event has "count", a "histogram" of event
+ * counts per bucket, "meanLatency" and "maxLatency", and the mean time in ms
+ * of each step in "toJS", "js" and "commit".
+ */
+- (NSDictionary *)stats;
+
+- (void)reset;
+
+@end
+
+@interface RCTBridge (RCTInputLatency)
+
+@property (nonatomic, readonly) RCTInputLatency *inputLatency;
+
+@end
@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTInputLatency.h"
+
+#import "RCTAssert.h"
+#import "RCTInvalidating.h"
+#import "RCTProfile.h"
+
+#define RCTInputLatencyBucketCount 6
+
+static const double RCTInputLatencyBucketBounds[RCTInputLatencyBucketCount - 1] = {
+  33, 50, 100, 200, 500,
+};
+
+static NSString *const RCTInputFlowsKey = @"RCTInputFlows";
+
+static volatile BOOL RCTInputLatencyRecording = NO;
+
+@implementation RCTInputFlow
+{
+@public
+  CFTimeInterval _stageTimes[RCTInputFlowStageCount];
+  NSNumber *_profileFlowID;
+  BOOL _ended;
+}
+
+- (instancetype)initWithEventName:(NSString *)eventName startTime:(CFTimeInterval)startTime
+{
+  if ((self = [super init])) {
+    _eventName = [eventName copy];
+    _startTime = startTime;
+  }
+  return self;
+}
+
+@end
+
+BOOL RCTInputFlowIsTracing(void)
+{
+  return RCTInputLatencyRecording || RCTProfileIsProfiling();
+}
+
+RCTInputFlow *RCTInputFlowBegin(NSString *eventName, CFTimeInterval timestamp)
+{
+  if (!RCTInputFlowIsTracing()) {
+    return nil;
+  }
+
+  RCTInputFlow *flow = [[RCTInputFlow alloc] initWithEventName:eventName
+                                                     startTime:timestamp > 0 ? timestamp : CACurrentMediaTime()];
+  RCT_IF_DEV(
+    if (RCTProfileIsProfiling()) {
+      flow->_profileFlowID = _RCTProfileBeginFlowEvent();
+    }
+  )
+  return flow;
+}
+
+void RCTInputFlowsReachStage(NSArray<RCTInputFlow *> *flows, RCTInputFlowStage stage)
+{
+  if (!flows.count) {
+    return;
+  }
+
+  CFTimeInterval now = CACurrentMediaTime();
+  for (RCTInputFlow *flow in flows) {
+    flow->_stageTimes[stage] = now;
+    RCT_IF_DEV(
+      if (flow->_profileFlowID) {
+        _RCTProfileStepFlowEvent(flow->_profileFlowID);
+      }
+    )
+  }
+}
+
+NSArray<RCTInputFlow *> *RCTCurrentInputFlows(void)
+{
+  if (!RCTInputFlowIsTracing()) {
+    return nil;
+  }
+  return [NSThread currentThread].threadDictionary[RCTInputFlowsKey];
+}
+
+void RCTPerformWithInputFlows(NSArray<RCTInputFlow *> *flows, dispatch_block_t block)
+{
+  NSArray<RCTInputFlow *> *previousFlows = RCTCurrentInputFlows();
+  if (!flows.count && !previousFlows) {
+    block();
+    return;
+  }
+
+  NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+  if (flows.count) {
+    threadDictionary[RCTInputFlowsKey] = flows;
+  } else {
+    [threadDictionary removeObjectForKey:RCTInputFlowsKey];
+  }
+  block();
+  if (previousFlows) {
+    threadDictionary[RCTInputFlowsKey] = previousFlows;
+  } else {
+    [threadDictionary removeObjectForKey:RCTInputFlowsKey];
+  }
+}
+
+typedef NS_ENUM(NSUInteger, RCTInputLatencyStep) {
+  RCTInputLatencyStepToJS = 0,
+  RCTInputLatencyStepJS,
+  RCTInputLatencyStepCommit,
+  RCTInputLatencyStepCount
+};
+
+static NSString *RCTInputLatencyStepName(RCTInputLatencyStep step)
+{
+  switch (step) {
+    case RCTInputLatencyStepToJS:
+      return @"toJS";
+    case RCTInputLatencyStepJS:
+      return @"js";
+    case RCTInputLatencyStepCommit:
+      return @"commit";
+    default:
+      return @"";
+  }
+}
+
+typedef struct {
+  NSUInteger count;
+  NSUInteger histogram[RCTInputLatencyBucketCount];
+  double totalLatency;
+  double maxLatency;
+  double stepTime[RCTInputLatencyStepCount];
+} RCTInputLatencyEventStats;
+
+@interface RCTInputLatency () <RCTInvalidating>
+
+@end
+
+@implementation RCTInputLatency
+{
+  NSLock *_lock;
+  NSMutableDictionary<NSString *, NSMutableData *> *_events;
+}
+
+RCT_EXPORT_MODULE(InputLatency)
+
++ (NSArray<NSNumber *> *)bucketBounds
+{
+  NSMutableArray<NSNumber *> *bounds = [NSMutableArray new];
+  for (NSUInteger i = 0; i < RCTInputLatencyBucketCount - 1; i++) {
+    [bounds addObject:@(RCTInputLatencyBucketBounds[i])];
+  }
+  return bounds;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+    _events = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (void)invalidate
+{
+  self.recording = NO;
+}
+
+- (dispatch_queue_t)methodQueue
+{
+  return dispatch_get_main_queue();
+}
+
+- (void)setRecording:(BOOL)recording
+{
+  RCTAssertMainThread();
+
+  _recording = recording;
+  RCTInputLatencyRecording = recording;
+}
+
+- (void)endFlows:(NSArray<RCTInputFlow *> *)flows
+{
+  if (!flows.count) {
+    return;
+  }
+
+  CFTimeInterval now = CACurrentMediaTime();
+  BOOL recording = RCTInputLatencyRecording;
+  [_lock lock];
+  for (RCTInputFlow *flow in flows) {
+    // Every module that observes batches gets the batch's flows; only the
+    // first commit counts
+    if (flow->_ended) {
+      continue;
+    }
+    flow->_ended = YES;
+    RCT_IF_DEV(
+      if (flow->_profileFlowID) {
+        _RCTProfileEndFlowEvent(flow->_profileFlowID);
+      }
+    )
+    if (!recording) {
+      continue;
+    }
+
+    NSMutableData *data = _events[flow.eventName];
+    if (!data) {
+      data = [NSMutableData dataWithLength:sizeof(RCTInputLatencyEventStats)];
+      _events[flow.eventName] = data;
+    }
+    RCTInputLatencyEventStats *stats = data.mutableBytes;
+
+    // Stages that were skipped take no time
+    CFTimeInterval times[RCTInputLatencyStepCount + 1];
+    times[0] = flow.startTime;
+    for (NSUInteger i = 0; i < RCTInputFlowStageCount; i++) {
+      times[i + 1] = flow->_stageTimes[i] > 0 ? flow->_stageTimes[i] : times[i];
+    }
+    times[RCTInputLatencyStepCount] = now;
+    for (NSUInteger i = 0; i < RCTInputLatencyStepCount; i++) {
+      stats->stepTime[i] += MAX(0, times[i + 1] - times[i]) * 1000;
+    }
+
+    double latencyMs = MAX(0, now - flow.startTime) * 1000;
+    NSUInteger bucket = 0;
+    while (bucket < RCTInputLatencyBucketCount - 1 && latencyMs > RCTInputLatencyBucketBounds[bucket]) {
+      bucket++;
+    }
+    stats->histogram[bucket]++;
+    stats->count++;
+    stats->totalLatency += latencyMs;
+    stats->maxLatency = MAX(stats->maxLatency, latencyMs);
+  }
+  [_lock unlock];
+}
+
+- (NSDictionary *)stats
+{
+  NSMutableDictionary *stats = [NSMutableDictionary new];
+  [_lock lock];
+  [_events enumerateKeysAndObjectsUsingBlock:^(NSString *eventName, NSMutableData *data, __unused BOOL *stop) {
+    const RCTInputLatencyEventStats *eventStats = data.bytes;
+    if (!eventStats->count) {
+      return;
+    }
+    NSMutableArray *histogram = [NSMutableArray new];
+    for (NSUInteger i = 0; i < RCTInputLatencyBucketCount; i++) {
+      [histogram addObject:@(eventStats->histogram[i])];
+    }
+    NSMutableDictionary *eventDictionary = [@{
+      @"count": @(eventStats->count),
+      @"histogram": histogram,
+      @"meanLatency": @(eventStats->totalLatency / eventStats->count),
+      @"maxLatency": @(eventStats->maxLatency),
+    } mutableCopy];
+    for (NSUInteger i = 0; i < RCTInputLatencyStepCount; i++) {
+      eventDictionary[RCTInputLatencyStepName(i)] = @(eventStats->stepTime[i] / eventStats->count);
+    }
+    stats[eventName] = eventDictionary;
+  }];
+  [_lock unlock];
+  return @{
+    @"events": stats,
+    @"bucketBounds": [RCTInputLatency bucketBounds],
+  };
+}
+
+- (void)reset
+{
+  [_lock lock];
+  [_events removeAllObjects];
+  [_lock unlock];
+}
+
+RCT_EXPORT_METHOD(startRecording)
+{
+  self.recording = YES;
+}
+
+RCT_EXPORT_METHOD(stopRecording)
+{
+  self.recording = NO;
+}
+
+RCT_EXPORT_METHOD(getStats:(RCTResponseSenderBlock)callback)
+{
+  callback(@[[self stats]]);
+}
+
+RCT_EXPORT_METHOD(resetStats)
+{
+  [self reset];
+}
+
+@end
+
+@implementation RCTBridge (RCTInputLatency)
+
+- (RCTInputLatency *)inputLatency
+{
+  return self.modules[RCTBridgeModuleNameForClass([RCTInputLatency class])];
+}
+
+@end
@@ -17,6 +17,18 @@
 typedef void (^RCTJavaScriptCompleteBlock)(NSError *error);
 typedef void (^RCTJavaScriptCallback)(id json, NSError *error);
 
+/**
+ * The bands that executors with a queue of their own run the blocks queued
+ * since they last woke up in, highest first. Blocks keep their order within a
+ * band.
+ */
+typedef NS_ENUM(NSUInteger, RCTJavaScriptQueuePriority) {
+  RCTJavaScriptQueuePriorityEvents = 0,
+  RCTJavaScriptQueuePriorityTimers,
+  RCTJavaScriptQueuePriorityDefault,
+  RCTJavaScriptQueuePriorityCount
+};
+
 /**
  * Abstracts away a JavaScript execution context - we may be running code in a
  * web view (for debugging purposes), or may be running code in a `JSContext`.
@@ -24,8 +36,9 @@ typedef void (^RCTJavaScriptCallback)(id json, NSError *error);
 @protocol RCTJavaScriptExecutor <RCTInvalidating, RCTBridgeModule>
 
 /**
- * Used to set up the executor after the bridge has been fully initialized.
- * Do any expensive setup in this method instead of `-init`.
+ * Used to set up the executor once its bridge has been set. This is called off
+ * the main thread while the other modules are still being created, so it must
+ * not rely on them. Do any expensive setup in this method instead of `-init`.
  */
 - (void)setUp;
 
@@ -69,4 +82,27 @@ typedef void (^RCTJavaScriptCallback)(id json, NSError *error);
  */
 - (void)executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block;
 
+/**
+ * Like the methods above, but blocks that are queued run in the given band
+ * rather than with the default priority. Used for events and timers.
+ */
+- (void)executeBlockOnJavaScriptQueue:(dispatch_block_t)block
+                             priority:(RCTJavaScriptQueuePriority)priority;
+- (void)executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block
+                                  priority:(RCTJavaScriptQueuePriority)priority;
+
+/**
+ * Whether the executor installs a `nativeModuleProxy` global that asks the
+ * bridge for each module's config the first time JS reads it. If so, the
+ * bridge doesn't inject the config of every module before loading the script.
+ */
+- (BOOL)providesNativeModuleProxy;
+
+/**
+ * Called on the JS thread when JS has nothing to do in the coming frames, so
+ * that the executor can use the time, e.g. to collect garbage as configured by
+ * the bridge's idleGarbageCollection properties.
+ */
+- (void)handleIdle;
+
 @end
@@ -20,6 +20,29 @@
  */
 @interface RCTJavaScriptLoader : NSObject
 
+/**
+ * Loads the bundle at `moduleURL`. Local bundles may be gzipped, in which case
+ * they are inflated while they are read in.
+ */
 + (void)loadBundleAtURL:(NSURL *)moduleURL onComplete:(RCTSourceLoadBlock)onComplete;
 
+/**
+ * Updates a cached bundle from a delta that only carries the modules that
+ * changed, in the same format as on Android (see JSDelta.h there):
+ *
+ *   delta  := "RNDELTA1" sha256(base) sha256(bundle) uint32(moduleCount) module*
+ *   module := uint32(baseOffset) uint32(length)
+ *           | uint32(0xFFFFFFFF) uint32(length) bytes
+ *
+ * with little endian numbers. Modules are either copied from a range of the
+ * base bundle or carried in the delta. The new bundle is only written to
+ * `outputURL`, which may be `bundleURL` itself, once it matches the hash the
+ * delta expects. All URLs are file URLs. On failure, download the full bundle
+ * instead. Load the output with `loadBundleAtURL:onComplete:` as usual.
+ */
++ (BOOL)applyDeltaAtURL:(NSURL *)deltaURL
+          toBundleAtURL:(NSURL *)bundleURL
+              outputURL:(NSURL *)outputURL
+                  error:(NSError **)error;
+
 @end
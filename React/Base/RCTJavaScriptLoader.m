@@ -9,11 +9,197 @@
 
 #import "RCTJavaScriptLoader.h"
 
+#import <CommonCrypto/CommonDigest.h>
+#import <sys/mman.h>
+#import <zlib.h>
+
 #import "RCTBridge.h"
 #import "RCTConvert.h"
 #import "RCTSourceCode.h"
 #import "RCTUtils.h"
 
+static BOOL RCTIsASCII(const uint8_t *bytes, NSUInteger length)
+{
+  NSUInteger i = 0;
+  uint64_t bits = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    bits |= word;
+  }
+  for (; i < length; i++) {
+    bits |= bytes[i];
+  }
+  return (bits & 0x8080808080808080ULL) == 0;
+}
+
+static void RCTReleaseScriptData(__unused void *ptr, void *info)
+{
+  CFRelease(info);
+}
+
+/**
+ * Creates the script string. Bundles are almost always plain ASCII, in which
+ * case the string is backed by the bytes of `data` itself, keeping it alive,
+ * rather than by a UTF-16 copy. JSC also copies such strings as 8-bit
+ * characters when creating the JSStringRef, instead of transcoding them.
+ */
+static NSString *RCTScriptStringWithData(NSData *data, NSStringEncoding encoding)
+{
+  if ((encoding == NSUTF8StringEncoding || encoding == NSASCIIStringEncoding) &&
+      RCTIsASCII(data.bytes, data.length)) {
+    // Released by the deallocator, together with the string
+    CFAllocatorContext context = {
+      .info = (__bridge_retained void *)data,
+      .deallocate = RCTReleaseScriptData,
+    };
+    CFAllocatorRef deallocator = CFAllocatorCreate(kCFAllocatorDefault, &context);
+    if (deallocator) {
+      CFStringRef string = CFStringCreateWithBytesNoCopy(kCFAllocatorDefault, data.bytes, data.length,
+                                                         kCFStringEncodingASCII, false, deallocator);
+      CFRelease(deallocator);
+      if (string) {
+        return (__bridge_transfer NSString *)string;
+      }
+    } else {
+      CFRelease(context.info);
+    }
+  }
+  return [[NSString alloc] initWithData:data encoding:encoding];
+}
+
+static BOOL RCTIsGzipped(NSData *data)
+{
+  const uint8_t *bytes = data.bytes;
+  return data.length >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b;
+}
+
+/**
+ * Inflates a gzipped bundle. A mapped file is first read ahead as a whole, so
+ * reading the rest of it from disk overlaps with inflating the pages that are
+ * already in.
+ */
+static NSData *RCTInflateData(NSData *data, NSError **error)
+{
+  // Fails harmlessly when the data isn't a mapped file
+  madvise((void *)data.bytes, data.length, MADV_WILLNEED);
+
+  z_stream stream = {
+    .next_in = (Bytef *)data.bytes,
+    .avail_in = (uInt)data.length,
+  };
+  // Expects a gzip header and trailer
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    *error = [NSError errorWithDomain:@"JavaScriptLoader" code:3 userInfo:@{
+      NSLocalizedDescriptionKey: @"Unable to inflate script"
+    }];
+    return nil;
+  }
+  // Minified JS usually shrinks to a fifth or less
+  NSMutableData *inflated = [NSMutableData dataWithLength:MAX(data.length * 4, 64 * 1024)];
+  int status = Z_OK;
+  while (status == Z_OK) {
+    if (stream.total_out == inflated.length) {
+      inflated.length *= 2;
+    }
+    stream.next_out = (Bytef *)inflated.mutableBytes + stream.total_out;
+    stream.avail_out = (uInt)(inflated.length - stream.total_out);
+    status = inflate(&stream, Z_NO_FLUSH);
+  }
+  inflated.length = stream.total_out;
+  inflateEnd(&stream);
+  if (status != Z_STREAM_END) {
+    *error = [NSError errorWithDomain:@"JavaScriptLoader" code:3 userInfo:@{
+      NSLocalizedDescriptionKey: @"Script is not a valid gzip file"
+    }];
+    return nil;
+  }
+  return inflated;
+}
+
+static NSString *const RCTDeltaMagic = @"RNDELTA1";
+static const uint32_t RCTDeltaBodyFollows = 0xFFFFFFFF;
+
+static NSError *RCTDeltaError(NSString *description)
+{
+  return [NSError errorWithDomain:@"JavaScriptLoader" code:2 userInfo:@{
+    NSLocalizedDescriptionKey: description
+  }];
+}
+
+static BOOL RCTDataHasDigest(NSData *data, const uint8_t *digest)
+{
+  uint8_t dataDigest[CC_SHA256_DIGEST_LENGTH];
+  CC_SHA256(data.bytes, (CC_LONG)data.length, dataDigest);
+  return memcmp(dataDigest, digest, CC_SHA256_DIGEST_LENGTH) == 0;
+}
+
+static BOOL RCTReadDeltaUInt32(const uint8_t *bytes, NSUInteger length,
+                               NSUInteger *offset, uint32_t *value)
+{
+  if (length - *offset < sizeof(uint32_t)) {
+    return NO;
+  }
+  const uint8_t *number = bytes + *offset;
+  *value = number[0] | (number[1] << 8) | (number[2] << 16) | ((uint32_t)number[3] << 24);
+  *offset += sizeof(uint32_t);
+  return YES;
+}
+
+static NSData *RCTApplyDelta(NSData *base, NSData *delta, NSError **error)
+{
+  const uint8_t *bytes = delta.bytes;
+  NSUInteger length = delta.length;
+  NSUInteger offset = RCTDeltaMagic.length + 2 * CC_SHA256_DIGEST_LENGTH;
+  if (length < offset || memcmp(bytes, RCTDeltaMagic.UTF8String, RCTDeltaMagic.length) != 0) {
+    *error = RCTDeltaError(@"Not a bundle delta");
+    return nil;
+  }
+  const uint8_t *baseDigest = bytes + RCTDeltaMagic.length;
+  const uint8_t *bundleDigest = baseDigest + CC_SHA256_DIGEST_LENGTH;
+  if (!RCTDataHasDigest(base, baseDigest)) {
+    *error = RCTDeltaError(@"Bundle delta was built against a different bundle");
+    return nil;
+  }
+
+  uint32_t moduleCount;
+  if (!RCTReadDeltaUInt32(bytes, length, &offset, &moduleCount)) {
+    *error = RCTDeltaError(@"Truncated bundle delta");
+    return nil;
+  }
+  NSMutableData *bundle = [NSMutableData dataWithCapacity:base.length];
+  for (uint32_t i = 0; i < moduleCount; i++) {
+    uint32_t moduleOffset, moduleLength;
+    if (!RCTReadDeltaUInt32(bytes, length, &offset, &moduleOffset) ||
+        !RCTReadDeltaUInt32(bytes, length, &offset, &moduleLength)) {
+      *error = RCTDeltaError(@"Truncated bundle delta");
+      return nil;
+    }
+    if (moduleOffset == RCTDeltaBodyFollows) {
+      if (length - offset < moduleLength) {
+        *error = RCTDeltaError(@"Truncated bundle delta");
+        return nil;
+      }
+      [bundle appendBytes:bytes + offset length:moduleLength];
+      offset += moduleLength;
+    } else if (moduleOffset <= base.length && moduleLength <= base.length - moduleOffset) {
+      [bundle appendBytes:(const uint8_t *)base.bytes + moduleOffset length:moduleLength];
+    } else {
+      *error = RCTDeltaError(@"Bundle delta refers past the end of the bundle");
+      return nil;
+    }
+  }
+  if (offset != length) {
+    *error = RCTDeltaError(@"Unexpected data after the bundle delta");
+    return nil;
+  }
+  if (!RCTDataHasDigest(bundle, bundleDigest)) {
+    *error = RCTDeltaError(@"Bundle built from delta doesn't match its hash");
+    return nil;
+  }
+  return bundle;
+}
+
 @implementation RCTJavaScriptLoader
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
@@ -32,6 +218,25 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
     return;
   }
 
+  // Map local bundles instead of reading them into memory
+  if (scriptURL.fileURL) {
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+      NSError *error;
+      NSData *data = [NSData dataWithContentsOfURL:scriptURL
+                                           options:NSDataReadingMappedIfSafe
+                                             error:&error];
+      if (data && RCTIsGzipped(data)) {
+        data = RCTInflateData(data, &error);
+      }
+      if (!data) {
+        onComplete(error, nil);
+        return;
+      }
+      onComplete(nil, RCTScriptStringWithData(data, NSUTF8StringEncoding));
+    });
+    return;
+  }
+
   NSURLSessionDataTask *task = [[NSURLSession sharedSession] dataTaskWithURL:scriptURL completionHandler:
                                 ^(NSData *data, NSURLResponse *response, NSError *error) {
 
@@ -60,7 +265,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
         encoding = CFStringConvertEncodingToNSStringEncoding(cfEncoding);
       }
     }
-    NSString *rawText = [[NSString alloc] initWithData:data encoding:encoding];
+    NSString *rawText = RCTScriptStringWithData(data, encoding);
 
     // Handle HTTP errors
     if ([response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode != 200) {
@@ -96,4 +301,28 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   [task resume];
 }
 
++ (BOOL)applyDeltaAtURL:(NSURL *)deltaURL
+          toBundleAtURL:(NSURL *)bundleURL
+              outputURL:(NSURL *)outputURL
+                  error:(NSError **)error
+{
+  NSError *localError;
+  NSData *base = [NSData dataWithContentsOfURL:bundleURL
+                                       options:NSDataReadingMappedIfSafe
+                                         error:&localError];
+  NSData *delta = base ? [NSData dataWithContentsOfURL:deltaURL
+                                               options:NSDataReadingMappedIfSafe
+                                                 error:&localError] : nil;
+  NSData *bundle = delta ? RCTApplyDelta(base, delta, &localError) : nil;
+
+  // Written atomically, so a cached bundle is never half written
+  if (bundle && [bundle writeToURL:outputURL options:NSDataWritingAtomic error:&localError]) {
+    return YES;
+  }
+  if (error) {
+    *error = localError;
+  }
+  return NO;
+}
+
 @end
@@ -55,10 +55,19 @@ RCT_EXTERN NSString *RCTFormatLog(
 );
 
 /**
- * The default logging function used by RCTLogXX.
+ * The default logging function used by RCTLogXX. Messages are formatted on
+ * the calling thread, but below RCTLogLevelError they are written to stderr
+ * and the system log on a background queue, in order.
  */
 extern RCTLogFunction RCTDefaultLogFunction;
 
+/**
+ * Wraps a logging function so that it is called on a serial background queue
+ * instead of the logging thread, e.g. for sinks that do I/O. Calls are made in
+ * the order they were logged.
+ */
+RCT_EXTERN RCTLogFunction RCTAsyncLogFunction(RCTLogFunction logFunction);
+
 /**
  * These methods get and set the global logging threshold. This is the level
  * below which logs will be ignored. Default is RCTLogLevelInfo for debug and
@@ -97,11 +106,14 @@ RCT_EXTERN void RCTPerformBlockWithLogFunction(void (^block)(void), RCTLogFuncti
 RCT_EXTERN void RCTPerformBlockWithLogPrefix(void (^block)(void), NSString *prefix);
 
 /**
- * Private logging function - ignore this.
+ * Private logging function - ignore this. Logs below the threshold return
+ * before their arguments are evaluated or formatted, and logs below
+ * RCT_LOG_COMPILE_LEVEL are compiled out.
  */
 #define _RCTLog(lvl, ...) do { \
 if (lvl >= RCTLOG_FATAL_LEVEL) { RCTAssert(NO, __VA_ARGS__); } \
-_RCTLogFormat(lvl, __FILE__, __LINE__, __VA_ARGS__); } while (0)
+if (lvl >= RCT_LOG_COMPILE_LEVEL && lvl >= RCTGetLogThreshold()) { \
+_RCTLogFormat(lvl, __FILE__, __LINE__, __VA_ARGS__); } } while (0)
 RCT_EXTERN void _RCTLogFormat(RCTLogLevel, const char *, int, NSString *, ...) NS_FORMAT_FUNCTION(4,5);
 
 /**
@@ -47,16 +47,30 @@ RCTLogLevel RCTGetLogThreshold()
   return RCTCurrentLogThreshold;
 }
 
-RCTLogFunction RCTDefaultLogFunction = ^(
-  RCTLogLevel level,
-  NSString *fileName,
-  NSNumber *lineNumber,
-  NSString *message
-)
+// Only ever runs RCTWriteLog, so it can be synced to from any other queue
+static dispatch_queue_t RCTLogQueue(void)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.LogQueue", DISPATCH_QUEUE_SERIAL);
+  });
+  return queue;
+}
+
+RCTLogFunction RCTAsyncLogFunction(RCTLogFunction logFunction)
+{
+  // A queue per sink, so that wrapping RCTDefaultLogFunction can't deadlock
+  dispatch_queue_t queue = dispatch_queue_create("com.facebook.React.AsyncLogQueue", DISPATCH_QUEUE_SERIAL);
+  return ^(RCTLogLevel level, NSString *fileName, NSNumber *lineNumber, NSString *message) {
+    dispatch_async(queue, ^{
+      logFunction(level, fileName, lineNumber, message);
+    });
+  };
+}
+
+static void RCTWriteLog(RCTLogLevel level, NSString *log, NSString *message)
 {
-  NSString *log = RCTFormatLog(
-    [NSDate date], level, fileName, lineNumber, message
-  );
   fprintf(stderr, "%s\n", log.UTF8String);
   fflush(stderr);
 
@@ -78,6 +92,30 @@ RCTLogFunction RCTDefaultLogFunction = ^(
       aslLevel = ASL_LEVEL_DEBUG;
   }
   asl_log(NULL, NULL, aslLevel, "%s", message.UTF8String);
+}
+
+RCTLogFunction RCTDefaultLogFunction = ^(
+  RCTLogLevel level,
+  NSString *fileName,
+  NSNumber *lineNumber,
+  NSString *message
+)
+{
+  // Formatted here for the timestamp and thread name
+  NSString *log = RCTFormatLog(
+    [NSDate date], level, fileName, lineNumber, message
+  );
+
+  // Errors are written straight away, in case they precede a crash
+  if (level >= RCTLogLevelError) {
+    dispatch_sync(RCTLogQueue(), ^{
+      RCTWriteLog(level, log, message);
+    });
+  } else {
+    dispatch_async(RCTLogQueue(), ^{
+      RCTWriteLog(level, log, message);
+    });
+  }
 };
 
 void RCTSetLogFunction(RCTLogFunction logFunction)
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "RCTBridge.h"
+
+@class RCTCache;
+
+/**
+ * The order in which consumers give up memory. Consumers with a lower
+ * priority are trimmed first, so it should reflect how cheap their contents
+ * are to recreate.
+ */
+typedef NS_ENUM(NSInteger, RCTMemoryPriority) {
+  RCTMemoryPriorityLow = 0,
+  RCTMemoryPriorityDefault,
+  RCTMemoryPriorityHigh,
+};
+
+/**
+ * Implemented by caches and pools that can release memory on demand. Both
+ * methods are called on the main thread.
+ */
+@protocol RCTMemoryConsumer <NSObject>
+
+/**
+ * The approximate number of bytes currently held.
+ */
+- (NSUInteger)memoryFootprint;
+
+/**
+ * Release memory until at most `footprint` bytes are held.
+ */
+- (void)trimMemoryToFootprint:(NSUInteger)footprint;
+
+@optional
+
+/**
+ * The name the footprint is reported under in profiles. Consumers with the
+ * same name are added up. Defaults to the class name.
+ */
+- (NSString *)memoryConsumerName;
+
+@end
+
+/**
+ * Tracks the memory held by registered consumers and trims them, lowest
+ * priority first, when their combined footprint exceeds the budget. On a
+ * memory warning every consumer is trimmed to nothing, in the same order. Consumers are held weakly and are
+ * dropped when they deallocate. While profiling, their footprints are
+ * recorded as a counter track.
+ *
+ * Memory pressure is process-wide, so all bridges share one instance.
+ */
+@interface RCTMemoryBudget : NSObject
+
++ (instancetype)sharedBudget;
+
+/**
+ * The combined footprint, in bytes, that registered consumers are trimmed to
+ * as they approach it. Defaults to 0, which means consumers are only trimmed
+ * on memory warnings.
+ */
+@property (nonatomic, assign) NSUInteger budget;
+
+/**
+ * The current combined footprint of all registered consumers. Must be read on
+ * the main thread.
+ */
+@property (nonatomic, readonly) NSUInteger footprint;
+
+- (void)registerConsumer:(id<RCTMemoryConsumer>)consumer priority:(RCTMemoryPriority)priority;
+- (void)unregisterConsumer:(id<RCTMemoryConsumer>)consumer;
+
+/**
+ * Registers an RCTCache whose costs are in bytes. Caches that only use a
+ * count limit report no footprint, and rely on clearing themselves on memory
+ * warnings. The cache's name is used as the consumer name.
+ */
+- (void)registerCache:(RCTCache *)cache priority:(RCTMemoryPriority)priority;
+
+/**
+ * Consumers may call this after they grow to have the budget enforced soon,
+ * rather than at the next periodic check. Calls are coalesced.
+ */
+- (void)setNeedsBudgetCheck;
+
+/**
+ * Trims consumers, lowest priority first, until the combined footprint is at
+ * most `footprint` bytes. Must be called on the main thread.
+ */
+- (void)trimToFootprint:(NSUInteger)footprint;
+
+@end
+
+@interface RCTBridge (RCTMemoryBudget)
+
+/**
+ * The shared memory budget
+ */
+@property (nonatomic, readonly) RCTMemoryBudget *memoryBudget;
+
+@end
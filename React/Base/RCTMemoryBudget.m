@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTMemoryBudget.h"
+
+#import <UIKit/UIKit.h>
+
+#import "RCTAssert.h"
+#import "RCTCache.h"
+#import "RCTProfile.h"
+
+// How often the budget is enforced while one is set
+static const NSTimeInterval RCTMemoryBudgetCheckInterval = 2.0;
+
+@interface RCTMemoryConsumerEntry : NSObject
+
+@property (nonatomic, weak) id<RCTMemoryConsumer> consumer;
+@property (nonatomic, assign) RCTMemoryPriority priority;
+
+@end
+
+@implementation RCTMemoryConsumerEntry
+
+@end
+
+/**
+ * Adapts an RCTCache, whose cost is assumed to be in bytes.
+ */
+@interface RCTMemoryCacheConsumer : NSObject <RCTMemoryConsumer>
+
+@property (nonatomic, weak) RCTCache *cache;
+
+@end
+
+@implementation RCTMemoryCacheConsumer
+
+- (NSUInteger)memoryFootprint
+{
+  return _cache.totalCost;
+}
+
+- (void)trimMemoryToFootprint:(NSUInteger)footprint
+{
+  // Evicts through the cache's delegate, unlike -removeAllObjects
+  [_cache trimToCost:footprint];
+}
+
+- (NSString *)memoryConsumerName
+{
+  return _cache.name.length ? _cache.name : @"RCTCache";
+}
+
+@end
+
+@implementation RCTMemoryBudget
+{
+  NSLock *_lock;
+  NSMutableArray<RCTMemoryConsumerEntry *> *_entries;
+  NSMapTable *_cacheConsumers;
+  NSTimer *_checkTimer;
+  BOOL _checkScheduled;
+}
+
++ (instancetype)sharedBudget
+{
+  static RCTMemoryBudget *sharedBudget;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedBudget = [RCTMemoryBudget new];
+  });
+  return sharedBudget;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _lock = [NSLock new];
+    _entries = [NSMutableArray new];
+    _cacheConsumers = [NSMapTable weakToStrongObjectsMapTable];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(didReceiveMemoryWarning)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(sampleProfileCounters)
+                                                 name:RCTProfileWillSampleCounters
+                                               object:nil];
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)setBudget:(NSUInteger)budget
+{
+  _budget = budget;
+  dispatch_async(dispatch_get_main_queue(), ^{
+    [_checkTimer invalidate];
+    _checkTimer = nil;
+    if (budget) {
+      _checkTimer = [NSTimer scheduledTimerWithTimeInterval:RCTMemoryBudgetCheckInterval
+                                                     target:self
+                                                   selector:@selector(checkBudget)
+                                                   userInfo:nil
+                                                    repeats:YES];
+      _checkTimer.tolerance = RCTMemoryBudgetCheckInterval / 2;
+      [self checkBudget];
+    }
+  });
+}
+
+- (void)registerConsumer:(id<RCTMemoryConsumer>)consumer priority:(RCTMemoryPriority)priority
+{
+  RCTMemoryConsumerEntry *entry = [RCTMemoryConsumerEntry new];
+  entry.consumer = consumer;
+  entry.priority = priority;
+
+  [_lock lock];
+  [self unregisterConsumerLocked:consumer];
+  // Stable, so consumers of equal priority are trimmed in registration order
+  NSUInteger index = [_entries indexOfObject:entry
+                               inSortedRange:NSMakeRange(0, _entries.count)
+                                     options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                             usingComparator:^NSComparisonResult(RCTMemoryConsumerEntry *a, RCTMemoryConsumerEntry *b) {
+    return a.priority < b.priority ? NSOrderedAscending :
+      (a.priority > b.priority ? NSOrderedDescending : NSOrderedSame);
+  }];
+  [_entries insertObject:entry atIndex:index];
+  [_lock unlock];
+}
+
+- (void)unregisterConsumer:(id<RCTMemoryConsumer>)consumer
+{
+  [_lock lock];
+  [self unregisterConsumerLocked:consumer];
+  [_lock unlock];
+}
+
+- (void)unregisterConsumerLocked:(id<RCTMemoryConsumer>)consumer
+{
+  [_entries filterUsingPredicate:[NSPredicate predicateWithBlock:
+    ^BOOL(RCTMemoryConsumerEntry *entry, __unused NSDictionary *bindings) {
+    id<RCTMemoryConsumer> existing = entry.consumer;
+    return existing && existing != consumer;
+  }]];
+}
+
+- (void)registerCache:(RCTCache *)cache priority:(RCTMemoryPriority)priority
+{
+  RCTMemoryCacheConsumer *consumer = [RCTMemoryCacheConsumer new];
+  consumer.cache = cache;
+
+  // The cache keeps its adapter alive
+  [_lock lock];
+  [_cacheConsumers setObject:consumer forKey:cache];
+  [_lock unlock];
+
+  [self registerConsumer:consumer priority:priority];
+}
+
+- (NSArray<id<RCTMemoryConsumer>> *)consumers
+{
+  NSMutableArray<id<RCTMemoryConsumer>> *consumers = [NSMutableArray new];
+  [_lock lock];
+  for (RCTMemoryConsumerEntry *entry in _entries) {
+    id<RCTMemoryConsumer> consumer = entry.consumer;
+    if (consumer) {
+      [consumers addObject:consumer];
+    }
+  }
+  [_lock unlock];
+  return consumers;
+}
+
+- (NSUInteger)footprint
+{
+  NSUInteger footprint = 0;
+  for (id<RCTMemoryConsumer> consumer in [self consumers]) {
+    footprint += [consumer memoryFootprint];
+  }
+  return footprint;
+}
+
+- (void)setNeedsBudgetCheck
+{
+  @synchronized(self) {
+    if (_checkScheduled || !_budget) {
+      return;
+    }
+    _checkScheduled = YES;
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    @synchronized(self) {
+      _checkScheduled = NO;
+    }
+    [self checkBudget];
+  });
+}
+
+- (void)checkBudget
+{
+  NSUInteger budget = self.budget;
+  if (budget && self.footprint > budget) {
+    // Trim below the budget so that we don't trim again straight away
+    [self trimToFootprint:budget - budget / 4];
+  }
+}
+
+- (void)sampleProfileCounters
+{
+  NSMutableDictionary<NSString *, NSNumber *> *footprints = [NSMutableDictionary new];
+  for (id<RCTMemoryConsumer> consumer in [self consumers]) {
+    NSString *name = [consumer respondsToSelector:@selector(memoryConsumerName)] ?
+      [consumer memoryConsumerName] : NSStringFromClass([consumer class]);
+    footprints[name] = @(footprints[name].unsignedIntegerValue + [consumer memoryFootprint]);
+  }
+  RCTProfileCounterEvent(0, @"native_memory", footprints);
+}
+
+- (void)didReceiveMemoryWarning
+{
+  // Consumers that report no footprint are trimmed as well
+  for (id<RCTMemoryConsumer> consumer in [self consumers]) {
+    [consumer trimMemoryToFootprint:0];
+  }
+}
+
+- (void)trimToFootprint:(NSUInteger)footprint
+{
+  RCTAssertMainThread();
+
+  NSArray<id<RCTMemoryConsumer>> *consumers = [self consumers];
+  if (consumers.count == 0) {
+    return;
+  }
+
+  NSUInteger footprints[consumers.count];
+  NSUInteger total = 0;
+  for (NSUInteger i = 0; i < consumers.count; i++) {
+    footprints[i] = [consumers[i] memoryFootprint];
+    total += footprints[i];
+  }
+
+  for (NSUInteger i = 0; i < consumers.count && total > footprint; i++) {
+    NSUInteger excess = total - footprint;
+    NSUInteger target = footprints[i] > excess ? footprints[i] - excess : 0;
+    [consumers[i] trimMemoryToFootprint:target];
+    total -= footprints[i] - MIN([consumers[i] memoryFootprint], footprints[i]);
+  }
+}
+
+@end
+
+@implementation RCTBridge (RCTMemoryBudget)
+
+- (RCTMemoryBudget *)memoryBudget
+{
+  return [RCTMemoryBudget sharedBudget];
+}
+
+@end
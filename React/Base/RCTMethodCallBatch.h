@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+typedef struct {
+  NSUInteger moduleID;
+  NSUInteger methodID;
+} RCTMethodCall;
+
+/**
+ * The native method calls flushed from JS in one go. The module and method
+ * IDs are kept in a C array, the arguments of each call in `params`.
+ */
+@interface RCTMethodCallBatch : NSObject
+
+/**
+ * Decodes a batch in the compact format written by encodeBinaryBatch.js,
+ * which ReactAndroid's parseMethodCalls also reads. Strings the batch repeats
+ * through its string table are decoded once and shared by every use. Returns
+ * nil if the data isn't a valid batch.
+ */
++ (instancetype)batchWithBinaryData:(const uint8_t *)bytes
+                             length:(size_t)length
+                              error:(NSError **)error;
+
+/**
+ * Reads a batch flushed as JSON, i.e. `[moduleIDs, methodIDs, paramss]`.
+ */
++ (instancetype)batchWithJSONBuffer:(id)buffer error:(NSError **)error;
+
+/**
+ * Whether the bytes start like a batch written by encodeBinaryBatch.js.
+ */
++ (BOOL)isBinaryBatch:(const uint8_t *)bytes length:(size_t)length;
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) const RCTMethodCall *calls;
+@property (nonatomic, copy, readonly) NSArray *params;
+
+@end
@@ -0,0 +1,405 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTMethodCallBatch.h"
+
+#import "RCTUtils.h"
+
+/**
+ * Must be kept in sync with `encodeBinaryBatch.js` and ReactAndroid's
+ * `MethodCall.cpp`.
+ */
+static const uint8_t RCTBinaryBatchMagic = 0x02;
+
+/**
+ * Batches written before there were string tables.
+ */
+static const uint8_t RCTBinaryBatchLegacyMagic = 0x01;
+
+typedef NS_ENUM(uint8_t, RCTBinaryValueTag) {
+  RCTBinaryValueTagNull = 0,
+  RCTBinaryValueTagFalse,
+  RCTBinaryValueTagTrue,
+  RCTBinaryValueTagInt,
+  RCTBinaryValueTagDouble,
+  RCTBinaryValueTagString,
+  RCTBinaryValueTagArray,
+  RCTBinaryValueTagObject,
+  RCTBinaryValueTagFloat64Array,
+  RCTBinaryValueTagInt32Array,
+  RCTBinaryValueTagUInt8Array,
+  RCTBinaryValueTagTableString,
+  RCTBinaryValueTagStringRef,
+};
+
+/**
+ * Must be kept in sync with `MessageQueue.js`.
+ */
+typedef NS_ENUM(NSUInteger, RCTBridgeFields) {
+  RCTBridgeFieldRequestModuleIDs = 0,
+  RCTBridgeFieldMethodIDs,
+  RCTBridgeFieldParamss,
+};
+
+/**
+ * The decoding state of one batch. A class rather than a struct, since ARC
+ * does not allow object pointers in C structs. The ivars are public so that
+ * the functions below read them directly.
+ */
+@interface RCTBinaryBatchReader : NSObject
+{
+@public
+  const uint8_t *_pos;
+  const uint8_t *_end;
+  NSString *_error;
+  // The batch's string table, nil in legacy batches
+  NSMutableArray<NSString *> *_strings;
+}
+
+@end
+
+@implementation RCTBinaryBatchReader
+
+@end
+
+static BOOL RCTReadByte(RCTBinaryBatchReader *reader, uint8_t *byte)
+{
+  if (reader->_pos == reader->_end) {
+    reader->_error = @"unexpected end of batch";
+    return NO;
+  }
+  *byte = *reader->_pos++;
+  return YES;
+}
+
+static BOOL RCTReadVarint(RCTBinaryBatchReader *reader, uint32_t *value)
+{
+  *value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    uint8_t byte;
+    if (!RCTReadByte(reader, &byte)) {
+      return NO;
+    }
+    *value |= (uint32_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return YES;
+    }
+  }
+  reader->_error = @"varint too long";
+  return NO;
+}
+
+static NSString *RCTReadStringOfLength(RCTBinaryBatchReader *reader, uint32_t length)
+{
+  if ((size_t)(reader->_end - reader->_pos) < length) {
+    reader->_error = @"string overruns batch";
+    return nil;
+  }
+  NSString *string = [[NSString alloc] initWithBytes:reader->_pos
+                                              length:length
+                                            encoding:NSUTF8StringEncoding];
+  if (!string) {
+    reader->_error = @"invalid UTF-8 string";
+    return nil;
+  }
+  reader->_pos += length;
+  return string;
+}
+
+static NSString *RCTReadString(RCTBinaryBatchReader *reader)
+{
+  uint32_t length;
+  if (!RCTReadVarint(reader, &length)) {
+    return nil;
+  }
+  return RCTReadStringOfLength(reader, length);
+}
+
+/**
+ * Strings from the table are the same instances wherever they appear in the
+ * batch, dictionary keys included, as copying an immutable string is free.
+ */
+static NSString *RCTTableString(RCTBinaryBatchReader *reader, uint32_t index)
+{
+  if (index >= reader->_strings.count) {
+    reader->_error = [NSString stringWithFormat:@"string index %u out of range", index];
+    return nil;
+  }
+  return reader->_strings[index];
+}
+
+static NSString *RCTReadKey(RCTBinaryBatchReader *reader)
+{
+  if (!reader->_strings) {
+    return RCTReadString(reader);
+  }
+
+  uint32_t key;
+  if (!RCTReadVarint(reader, &key)) {
+    return nil;
+  }
+  if (key & 1) {
+    return RCTTableString(reader, key >> 1);
+  }
+  NSString *string = RCTReadStringOfLength(reader, key >> 1);
+  if (string) {
+    [reader->_strings addObject:string];
+  }
+  return string;
+}
+
+static NSArray *RCTReadPackedArray(RCTBinaryBatchReader *reader, RCTBinaryValueTag tag)
+{
+  uint32_t count;
+  if (!RCTReadVarint(reader, &count)) {
+    return nil;
+  }
+  size_t elementSize = tag == RCTBinaryValueTagFloat64Array ? sizeof(double) :
+    tag == RCTBinaryValueTagInt32Array ? sizeof(int32_t) : sizeof(uint8_t);
+  if ((size_t)(reader->_end - reader->_pos) / elementSize < count) {
+    reader->_error = @"packed array overruns batch";
+    return nil;
+  }
+  NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+  for (uint32_t i = 0; i < count; i++) {
+    if (tag == RCTBinaryValueTagFloat64Array) {
+      double value;
+      memcpy(&value, reader->_pos, sizeof(value));
+      [array addObject:@(value)];
+    } else if (tag == RCTBinaryValueTagInt32Array) {
+      int32_t value;
+      memcpy(&value, reader->_pos, sizeof(value));
+      [array addObject:@(value)];
+    } else {
+      [array addObject:@(*reader->_pos)];
+    }
+    reader->_pos += elementSize;
+  }
+  return array;
+}
+
+static id RCTReadValue(RCTBinaryBatchReader *reader)
+{
+  uint8_t tag;
+  if (!RCTReadByte(reader, &tag)) {
+    return nil;
+  }
+  switch (tag) {
+    case RCTBinaryValueTagNull:
+      return (id)kCFNull;
+    case RCTBinaryValueTagFalse:
+      return @NO;
+    case RCTBinaryValueTagTrue:
+      return @YES;
+    case RCTBinaryValueTagInt: {
+      uint32_t zigzag;
+      if (!RCTReadVarint(reader, &zigzag)) {
+        return nil;
+      }
+      return @((int32_t)((zigzag >> 1) ^ -(zigzag & 1)));
+    }
+    case RCTBinaryValueTagDouble: {
+      double value;
+      if ((size_t)(reader->_end - reader->_pos) < sizeof(value)) {
+        reader->_error = @"double overruns batch";
+        return nil;
+      }
+      memcpy(&value, reader->_pos, sizeof(value));
+      reader->_pos += sizeof(value);
+      return @(value);
+    }
+    case RCTBinaryValueTagString:
+      return RCTReadString(reader);
+    case RCTBinaryValueTagTableString:
+    case RCTBinaryValueTagStringRef: {
+      if (!reader->_strings) {
+        reader->_error = @"string table in a legacy batch";
+        return nil;
+      }
+      if (tag == RCTBinaryValueTagStringRef) {
+        uint32_t index;
+        return RCTReadVarint(reader, &index) ? RCTTableString(reader, index) : nil;
+      }
+      NSString *string = RCTReadString(reader);
+      if (string) {
+        [reader->_strings addObject:string];
+      }
+      return string;
+    }
+    case RCTBinaryValueTagArray: {
+      uint32_t count;
+      if (!RCTReadVarint(reader, &count)) {
+        return nil;
+      }
+      // Every value takes at least one byte, don't trust bigger counts
+      NSMutableArray *array = [NSMutableArray arrayWithCapacity:MIN(count, (size_t)(reader->_end - reader->_pos))];
+      for (uint32_t i = 0; i < count; i++) {
+        id value = RCTReadValue(reader);
+        if (!value) {
+          return nil;
+        }
+        [array addObject:value];
+      }
+      return array;
+    }
+    case RCTBinaryValueTagObject: {
+      uint32_t count;
+      if (!RCTReadVarint(reader, &count)) {
+        return nil;
+      }
+      NSMutableDictionary *object = [NSMutableDictionary dictionaryWithCapacity:MIN(count, (size_t)(reader->_end - reader->_pos))];
+      for (uint32_t i = 0; i < count; i++) {
+        NSString *key = RCTReadKey(reader);
+        id value = key ? RCTReadValue(reader) : nil;
+        if (!value) {
+          return nil;
+        }
+        object[key] = value;
+      }
+      return object;
+    }
+    case RCTBinaryValueTagFloat64Array:
+    case RCTBinaryValueTagInt32Array:
+    case RCTBinaryValueTagUInt8Array:
+      return RCTReadPackedArray(reader, tag);
+    default:
+      reader->_error = [NSString stringWithFormat:@"unknown value tag %d", tag];
+      return nil;
+  }
+}
+
+@implementation RCTMethodCallBatch
+{
+  NSData *_callData;
+}
+
+- (instancetype)initWithCallData:(NSData *)callData params:(NSArray *)params
+{
+  if ((self = [super init])) {
+    _callData = callData;
+    _count = callData.length / sizeof(RCTMethodCall);
+    _calls = callData.bytes;
+    _params = [params copy];
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
++ (BOOL)isBinaryBatch:(const uint8_t *)bytes length:(size_t)length
+{
+  return length > 0 && (bytes[0] == RCTBinaryBatchMagic || bytes[0] == RCTBinaryBatchLegacyMagic);
+}
+
++ (instancetype)batchWithBinaryData:(const uint8_t *)bytes
+                             length:(size_t)length
+                              error:(NSError **)error
+{
+  RCTBinaryBatchReader *reader = [RCTBinaryBatchReader new];
+  reader->_pos = bytes;
+  reader->_end = bytes + length;
+
+  uint8_t magic;
+  uint32_t count;
+  if (RCTReadByte(reader, &magic)) {
+    if (magic == RCTBinaryBatchMagic) {
+      reader->_strings = [NSMutableArray new];
+    } else if (magic != RCTBinaryBatchLegacyMagic) {
+      reader->_error = @"not a binary batch";
+    }
+  }
+  if (!reader->_error && RCTReadVarint(reader, &count)) {
+    // Every call takes at least three bytes
+    if (count > (size_t)(reader->_end - reader->_pos) / 3) {
+      reader->_error = @"call count overruns batch";
+    }
+  }
+
+  NSMutableData *callData;
+  NSMutableArray *params;
+  if (!reader->_error) {
+    callData = [NSMutableData dataWithLength:count * sizeof(RCTMethodCall)];
+    params = [NSMutableArray arrayWithCapacity:count];
+    RCTMethodCall *calls = callData.mutableBytes;
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t moduleID, methodID;
+      if (!RCTReadVarint(reader, &moduleID) || !RCTReadVarint(reader, &methodID)) {
+        break;
+      }
+      id value = RCTReadValue(reader);
+      if (!value) {
+        break;
+      }
+      if (![value isKindOfClass:[NSArray class]]) {
+        reader->_error = [NSString stringWithFormat:@"arguments of call %u aren't an array", i];
+        break;
+      }
+      calls[i] = (RCTMethodCall){moduleID, methodID};
+      [params addObject:value];
+    }
+  }
+  if (!reader->_error && reader->_pos != reader->_end) {
+    reader->_error = @"trailing bytes after batch";
+  }
+
+  if (reader->_error) {
+    if (error) {
+      *error = RCTErrorWithMessage([NSString stringWithFormat:
+        @"Invalid binary batch at byte %zd: %@", reader->_pos - bytes, reader->_error]);
+    }
+    return nil;
+  }
+  return [[self alloc] initWithCallData:callData params:params];
+}
+
++ (instancetype)batchWithJSONBuffer:(id)buffer error:(NSError **)error
+{
+  NSString *errorMessage;
+  if (![buffer isKindOfClass:[NSArray class]] || [buffer count] <= RCTBridgeFieldParamss) {
+    errorMessage = [NSString stringWithFormat:@"Buffer must be an instance of NSArray, got %@", NSStringFromClass([buffer class])];
+  } else {
+    for (NSUInteger fieldIndex = RCTBridgeFieldRequestModuleIDs; fieldIndex <= RCTBridgeFieldParamss; fieldIndex++) {
+      id field = buffer[fieldIndex];
+      if (![field isKindOfClass:[NSArray class]]) {
+        errorMessage = [NSString stringWithFormat:@"Field at index %zd in buffer must be an instance of NSArray, got %@", fieldIndex, NSStringFromClass([field class])];
+        break;
+      }
+    }
+  }
+
+  NSArray *moduleIDs, *methodIDs, *paramsArrays;
+  if (!errorMessage) {
+    moduleIDs = buffer[RCTBridgeFieldRequestModuleIDs];
+    methodIDs = buffer[RCTBridgeFieldMethodIDs];
+    paramsArrays = buffer[RCTBridgeFieldParamss];
+    if (moduleIDs.count != methodIDs.count || moduleIDs.count != paramsArrays.count) {
+      errorMessage = [NSString stringWithFormat:@"Invalid data message - all must be length: %zd", moduleIDs.count];
+    }
+  }
+
+  if (errorMessage) {
+    if (error) {
+      *error = RCTErrorWithMessage(errorMessage);
+    }
+    return nil;
+  }
+
+  NSUInteger count = moduleIDs.count;
+  NSMutableData *callData = [NSMutableData dataWithLength:count * sizeof(RCTMethodCall)];
+  RCTMethodCall *calls = callData.mutableBytes;
+  for (NSUInteger i = 0; i < count; i++) {
+    calls[i] = (RCTMethodCall){
+      [moduleIDs[i] unsignedIntegerValue],
+      [methodIDs[i] unsignedIntegerValue],
+    };
+  }
+  return [[self alloc] initWithCallData:callData params:paramsArrays];
+}
+
+@end
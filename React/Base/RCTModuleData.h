@@ -11,12 +11,48 @@
 
 #import "RCTJavaScriptExecutor.h"
 
+@class RCTBridge;
+
+/**
+ * The global queue that runs work of the given priority. Uses QoS classes
+ * where they're available, and the closest queue priorities on iOS 7.
+ */
+RCT_EXTERN dispatch_queue_t RCTGlobalQueueForMethodQueuePriority(RCTMethodQueuePriority priority);
+
+/**
+ * Whether moduleClass implements +isSharedAcrossBridges and returns YES.
+ */
+RCT_EXTERN BOOL RCTModuleClassIsShared(Class moduleClass);
+
+/**
+ * Returns the instance of a shared module, creating it for the first bridge
+ * that asks. Each bridge that gets the instance must release it once.
+ */
+RCT_EXTERN id<RCTBridgeModule> RCTAcquireSharedModule(Class moduleClass);
+
+/**
+ * Returns YES when the bridge releasing the module was the last one using it,
+ * which should then invalidate it. Instances that aren't the shared one, like
+ * preregistered modules, always belong to the bridge releasing them.
+ */
+RCT_EXTERN BOOL RCTReleaseSharedModule(id<RCTBridgeModule> instance);
+
 @interface RCTModuleData : NSObject
 
 @property (nonatomic, weak, readonly) id<RCTJavaScriptExecutor> javaScriptExecutor;
 @property (nonatomic, strong, readonly) NSNumber *moduleID;
+
+/**
+ * For lazily loaded modules, the first access creates the module and its queue.
+ */
 @property (nonatomic, strong, readonly) id<RCTBridgeModule> instance;
 
+/**
+ * NO until a lazily loaded module has been created. Use this instead of
+ * checking instance to avoid creating the module.
+ */
+@property (nonatomic, readonly) BOOL hasInstance;
+
 @property (nonatomic, strong, readonly) Class moduleClass;
 @property (nonatomic, copy, readonly) NSString *name;
 @property (nonatomic, copy, readonly) NSArray *methods;
@@ -28,6 +64,15 @@
                         moduleID:(NSNumber *)moduleID
                         instance:(id<RCTBridgeModule>)instance NS_DESIGNATED_INITIALIZER;
 
+/**
+ * For modules exported with RCT_EXPORT_LAZY_MODULE, which are created the
+ * first time their instance is requested. Their queue is nil until then.
+ */
+- (instancetype)initWithExecutor:(id<RCTJavaScriptExecutor>)javaScriptExecutor
+                        moduleID:(NSNumber *)moduleID
+                     moduleClass:(Class)moduleClass
+                          bridge:(RCTBridge *)bridge NS_DESIGNATED_INITIALIZER;
+
 - (void)dispatchBlock:(dispatch_block_t)block;
 - (void)dispatchBlock:(dispatch_block_t)block dispatchGroup:(dispatch_group_t)group;
 
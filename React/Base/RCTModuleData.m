@@ -9,15 +9,151 @@
 
 #import "RCTModuleData.h"
 
+#import <libkern/OSAtomic.h>
+
 #import "RCTBridge.h"
 #import "RCTModuleMethod.h"
 #import "RCTLog.h"
 
+dispatch_queue_t RCTGlobalQueueForMethodQueuePriority(RCTMethodQueuePriority priority)
+{
+  switch (priority) {
+    case RCTMethodQueuePriorityUserInteractive:
+      if (&dispatch_queue_attr_make_with_qos_class != NULL) {
+        return dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0);
+      }
+      return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    case RCTMethodQueuePriorityUtility:
+      return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0);
+    case RCTMethodQueuePriorityBackground:
+      return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0);
+    case RCTMethodQueuePriorityDefault:
+    default:
+      return dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+  }
+}
+
+/**
+ * The queues the bridge creates for modules keep their names and their order,
+ * but run on one serial queue per priority.
+ */
+static dispatch_queue_t RCTTargetQueueForMethodQueuePriority(RCTMethodQueuePriority priority)
+{
+  enum { RCTMethodQueuePriorityCount = RCTMethodQueuePriorityBackground + 1 };
+  static dispatch_queue_t targetQueues[RCTMethodQueuePriorityCount];
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    const char *names[RCTMethodQueuePriorityCount] = {
+      "com.facebook.React.ModuleTargetQueue",
+      "com.facebook.React.UserInteractiveModuleTargetQueue",
+      "com.facebook.React.UtilityModuleTargetQueue",
+      "com.facebook.React.BackgroundModuleTargetQueue",
+    };
+    for (NSInteger i = 0; i < RCTMethodQueuePriorityCount; i++) {
+      targetQueues[i] = dispatch_queue_create(names[i], DISPATCH_QUEUE_SERIAL);
+      dispatch_set_target_queue(targetQueues[i], RCTGlobalQueueForMethodQueuePriority((RCTMethodQueuePriority)i));
+    }
+  });
+
+  if (priority < 0 || priority >= RCTMethodQueuePriorityCount) {
+    priority = RCTMethodQueuePriorityDefault;
+  }
+  return targetQueues[priority];
+}
+
+@interface RCTSharedModule : NSObject
+
+@property (nonatomic, strong) id<RCTBridgeModule> instance;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, copy) NSString *queueName;
+@property (nonatomic, assign) NSUInteger bridgeCount;
+
+@end
+
+@implementation RCTSharedModule
+@end
+
+static NSMutableDictionary *RCTSharedModules;
+static NSRecursiveLock *RCTSharedModulesLock;
+
+/**
+ * Returns the shared modules, keyed by class name, with the lock taken. It's
+ * recursive as creating a shared module may create another one.
+ */
+static NSMutableDictionary *RCTLockSharedModules(void)
+{
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    RCTSharedModules = [NSMutableDictionary new];
+    RCTSharedModulesLock = [NSRecursiveLock new];
+  });
+  [RCTSharedModulesLock lock];
+  return RCTSharedModules;
+}
+
+BOOL RCTModuleClassIsShared(Class moduleClass)
+{
+  return [moduleClass respondsToSelector:@selector(isSharedAcrossBridges)] &&
+    [moduleClass isSharedAcrossBridges];
+}
+
+id<RCTBridgeModule> RCTAcquireSharedModule(Class moduleClass)
+{
+  NSMutableDictionary *sharedModules = RCTLockSharedModules();
+  NSString *className = NSStringFromClass(moduleClass);
+  RCTSharedModule *sharedModule = sharedModules[className];
+  if (!sharedModule) {
+    sharedModule = [RCTSharedModule new];
+    sharedModule.instance = [moduleClass new];
+    sharedModules[className] = sharedModule;
+  }
+  sharedModule.bridgeCount++;
+  id<RCTBridgeModule> instance = sharedModule.instance;
+  [RCTSharedModulesLock unlock];
+  return instance;
+}
+
+BOOL RCTReleaseSharedModule(id<RCTBridgeModule> instance)
+{
+  NSMutableDictionary *sharedModules = RCTLockSharedModules();
+  NSString *className = NSStringFromClass([instance class]);
+  RCTSharedModule *sharedModule = sharedModules[className];
+  BOOL released = YES;
+  if (sharedModule.instance == instance) {
+    released = --sharedModule.bridgeCount == 0;
+    if (released) {
+      [sharedModules removeObjectForKey:className];
+    }
+  }
+  [RCTSharedModulesLock unlock];
+  return released;
+}
+
+/**
+ * The queue the bridge creates for a shared module that doesn't implement
+ * methodQueue, so every bridge calls it on the same one.
+ */
+static dispatch_queue_t RCTSharedModuleQueue(Class moduleClass, NSString *queueName)
+{
+  NSMutableDictionary *sharedModules = RCTLockSharedModules();
+  RCTSharedModule *sharedModule = sharedModules[NSStringFromClass(moduleClass)];
+  dispatch_queue_t queue = sharedModule.queue;
+  if (!queue) {
+    queue = dispatch_queue_create(queueName.UTF8String, DISPATCH_QUEUE_SERIAL);
+    sharedModule.queueName = queueName;
+    sharedModule.queue = queue;
+  }
+  [RCTSharedModulesLock unlock];
+  return queue;
+}
+
 @implementation RCTModuleData
 {
   NSDictionary *_constants;
   NSArray *_methods;
   NSString *_queueName;
+  __weak RCTBridge *_bridge;
+  NSLock *_instanceLock;
 }
 
 - (instancetype)initWithExecutor:(id<RCTJavaScriptExecutor>)javaScriptExecutor
@@ -38,19 +174,73 @@
     }
 
     // Must be done at init time due to race conditions
-    (void)self.queue;
+    [self setUpMethodQueueForInstance:_instance];
+  }
+  return self;
+}
+
+- (instancetype)initWithExecutor:(id<RCTJavaScriptExecutor>)javaScriptExecutor
+                        moduleID:(NSNumber *)moduleID
+                     moduleClass:(Class)moduleClass
+                          bridge:(RCTBridge *)bridge
+{
+  if ((self = [super init])) {
+    _javaScriptExecutor = javaScriptExecutor;
+    _moduleID = moduleID;
+    _moduleClass = moduleClass;
+    _name = RCTBridgeModuleNameForClass(_moduleClass);
+    _bridge = bridge;
+    _instanceLock = [NSLock new];
   }
   return self;
 }
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init);
 
+- (id<RCTBridgeModule>)instance
+{
+  if (!_instance && _instanceLock) {
+    [_instanceLock lock];
+    if (!_instance) {
+      BOOL isShared = RCTModuleClassIsShared(_moduleClass);
+      id<RCTBridgeModule> instance = isShared ? RCTAcquireSharedModule(_moduleClass) : [_moduleClass new];
+      if (!instance) {
+        RCTLogError(@"Lazily loaded module %@ returned nil from init", _name);
+      }
+      if (!isShared && [instance respondsToSelector:@selector(setBridge:)]) {
+        instance.bridge = _bridge;
+      }
+      [self setUpMethodQueueForInstance:instance];
+
+      // The instance is read without taking the lock once it's set, so it must
+      // be fully set up first
+      OSMemoryBarrier();
+      _instance = instance;
+    }
+    [_instanceLock unlock];
+  }
+  return _instance;
+}
+
+- (BOOL)hasInstance
+{
+  if (_instanceLock && !_instance) {
+    [_instanceLock lock];
+    BOOL hasInstance = (_instance != nil);
+    [_instanceLock unlock];
+    return hasInstance;
+  }
+  return _instance != nil;
+}
+
 - (NSArray *)methods
 {
   if (!_methods) {
     NSMutableArray *moduleMethods = [NSMutableArray new];
 
-    if ([_instance respondsToSelector:@selector(methodsToExport)]) {
+    // Lazily loaded modules can't implement methodsToExport, so don't create
+    // them here
+    if (!_instanceLock && [_instance respondsToSelector:@selector(methodsToExport)]) {
       [moduleMethods addObjectsFromArray:[_instance methodsToExport]];
     }
 
@@ -66,6 +256,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init);
         id<RCTBridgeMethod> moduleMethod =
         [[RCTModuleMethod alloc] initWithObjCMethodName:entries[1]
                                            JSMethodName:entries[0]
+                                                   sync:entries.count > 2 && [entries[2] boolValue]
                                             moduleClass:_moduleClass];
 
         [moduleMethods addObject:moduleMethod];
@@ -92,31 +283,57 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init);
   [self.methods enumerateObjectsUsingBlock:^(id<RCTBridgeMethod> method, NSUInteger idx, __unused BOOL *stop) {
     methodconfig[method.JSMethodName] = @{
       @"methodID": @(idx),
-      @"type": method.functionType == RCTFunctionTypePromise ? @"remoteAsync" : @"remote",
+      @"type": method.functionType == RCTFunctionTypePromise ? @"remoteAsync" :
+        method.functionType == RCTFunctionTypeSync ? @"sync" : @"remote",
     };
   }];
   config[@"methods"] = [methodconfig copy];
 
+  // JS holds back calls to background modules while there are others to send
+  if ([_moduleClass respondsToSelector:@selector(methodQueuePriority)] &&
+      [_moduleClass methodQueuePriority] == RCTMethodQueuePriorityBackground) {
+    config[@"background"] = @YES;
+  }
+
   return [config copy];
 }
 
 - (dispatch_queue_t)queue
+{
+  if (!_queue && _instanceLock) {
+    // A lazily loaded module's queue is set up along with its instance
+    [_instanceLock lock];
+    dispatch_queue_t queue = _queue;
+    [_instanceLock unlock];
+    return queue;
+  }
+  return _queue;
+}
+
+- (void)setUpMethodQueueForInstance:(id<RCTBridgeModule>)instance
 {
   if (!_queue) {
-    BOOL implementsMethodQueue = [_instance respondsToSelector:@selector(methodQueue)];
+    BOOL implementsMethodQueue = [instance respondsToSelector:@selector(methodQueue)];
     if (implementsMethodQueue) {
-      _queue = _instance.methodQueue;
+      _queue = instance.methodQueue;
     }
     if (!_queue) {
 
       // Create new queue (store queueName, as it isn't retained by dispatch_queue)
       _queueName = [NSString stringWithFormat:@"com.facebook.React.%@Queue", _name];
-      _queue = dispatch_queue_create(_queueName.UTF8String, DISPATCH_QUEUE_SERIAL);
+      if (RCTModuleClassIsShared(_moduleClass) && !implementsMethodQueue) {
+        _queue = RCTSharedModuleQueue(_moduleClass, _queueName);
+      } else {
+        _queue = dispatch_queue_create(_queueName.UTF8String, DISPATCH_QUEUE_SERIAL);
+      }
+      RCTMethodQueuePriority priority = [_moduleClass respondsToSelector:@selector(methodQueuePriority)] ?
+        [_moduleClass methodQueuePriority] : RCTMethodQueuePriorityDefault;
+      dispatch_set_target_queue(_queue, RCTTargetQueueForMethodQueuePriority(priority));
 
       // assign it to the module
       if (implementsMethodQueue) {
         @try {
-          [(id)_instance setValue:_queue forKey:@"methodQueue"];
+          [(id)instance setValue:_queue forKey:@"methodQueue"];
         }
         @catch (NSException *exception) {
           RCTLogError(@"%@ is returning nil for it's methodQueue, which is not "
@@ -127,7 +344,6 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init);
       }
     }
   }
-  return _queue;
 }
 
 - (void)dispatchBlock:(dispatch_block_t)block
@@ -11,6 +11,14 @@
 
 @interface RCTModuleMap : NSDictionary
 
-- (instancetype)initWithDictionary:(NSDictionary *)modulesByName NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithDictionary:(NSDictionary *)modulesByName;
+
+/**
+ * lazyModules maps the names of modules that haven't been created yet to
+ * their RCTModuleData. Looking one of them up creates the module, until then
+ * it's left out of allValues.
+ */
+- (instancetype)initWithDictionary:(NSDictionary *)modulesByName
+                       lazyModules:(NSDictionary *)lazyModules NS_DESIGNATED_INITIALIZER;
 
 @end
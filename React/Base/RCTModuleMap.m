@@ -13,10 +13,12 @@
 #import "RCTBridgeModule.h"
 #import "RCTDefines.h"
 #import "RCTLog.h"
+#import "RCTModuleData.h"
 
 @implementation RCTModuleMap
 {
   NSDictionary *_modulesByName;
+  NSDictionary *_lazyModules;
 }
 
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
@@ -26,16 +28,23 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithObjects:(const id [])objects
                                               count:(NSUInteger)cnt)
 
 - (instancetype)initWithDictionary:(NSDictionary *)modulesByName
+{
+  return [self initWithDictionary:modulesByName lazyModules:nil];
+}
+
+- (instancetype)initWithDictionary:(NSDictionary *)modulesByName
+                       lazyModules:(NSDictionary *)lazyModules
 {
   if ((self = [super init])) {
     _modulesByName = [modulesByName copy];
+    _lazyModules = [lazyModules copy];
   }
   return self;
 }
 
 - (NSUInteger)count
 {
-  return _modulesByName.count;
+  return _modulesByName.count + _lazyModules.count;
 }
 
 //declared in RCTBridge.m
@@ -43,7 +52,7 @@ extern BOOL RCTBridgeModuleClassIsRegistered(Class cls);
 
 - (id)objectForKey:(NSString *)moduleName
 {
-  id<RCTBridgeModule> module = _modulesByName[moduleName];
+  id<RCTBridgeModule> module = _modulesByName[moduleName] ?: [_lazyModules[moduleName] instance];
   if (RCT_DEBUG) {
     if (module) {
       Class moduleClass = [module class];
@@ -66,14 +75,26 @@ extern BOOL RCTBridgeModuleClassIsRegistered(Class cls);
 
 - (NSEnumerator *)keyEnumerator
 {
-  return [_modulesByName keyEnumerator];
+  if (!_lazyModules.count) {
+    return [_modulesByName keyEnumerator];
+  }
+  return [[_modulesByName.allKeys arrayByAddingObjectsFromArray:_lazyModules.allKeys] objectEnumerator];
 }
 
 - (NSArray *)allValues
 {
   // don't perform validation in this case because we only want to error when
   // an invalid module is specifically requested
-  return _modulesByName.allValues;
+  if (!_lazyModules.count) {
+    return _modulesByName.allValues;
+  }
+  NSMutableArray *modules = [_modulesByName.allValues mutableCopy];
+  for (RCTModuleData *moduleData in _lazyModules.allValues) {
+    if (moduleData.hasInstance) {
+      [modules addObject:moduleData.instance];
+    }
+  }
+  return modules;
 }
 
 @end
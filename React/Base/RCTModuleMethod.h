@@ -35,10 +35,19 @@ typedef NS_ENUM(NSUInteger, RCTNullability) {
 
 - (instancetype)initWithObjCMethodName:(NSString *)objCMethodName
                           JSMethodName:(NSString *)JSMethodName
+                                  sync:(BOOL)sync
                            moduleClass:(Class)moduleClass NS_DESIGNATED_INITIALIZER;
 
+- (instancetype)initWithObjCMethodName:(NSString *)objCMethodName
+                          JSMethodName:(NSString *)JSMethodName
+                           moduleClass:(Class)moduleClass;
+
 - (void)invokeWithBridge:(RCTBridge *)bridge
                   module:(id)module
                arguments:(NSArray *)arguments;
 
+- (id)invokeSyncWithBridge:(RCTBridge *)bridge
+                    module:(id)module
+                 arguments:(NSArray *)arguments;
+
 @end
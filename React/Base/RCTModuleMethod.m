@@ -19,6 +19,72 @@
 
 typedef BOOL (^RCTArgumentBlock)(RCTBridge *, NSUInteger, id);
 
+/**
+ * Methods whose arguments all fit in an integer register, or are all doubles,
+ * and that take no more than RCTMaxDirectArguments of them, are called through
+ * objc_msgSend cast to the matching function type. Anything else (structs,
+ * floats, mixed integer and floating point arguments...) goes through an
+ * NSInvocation.
+ */
+typedef NS_ENUM(NSUInteger, RCTInvocationStyle) {
+  RCTInvocationStyleInvocation,
+  RCTInvocationStyleWords,
+  RCTInvocationStyleDoubles,
+};
+
+#define RCTMaxDirectArguments 6
+
+// Set for the duration of a method call, calls from JS don't nest but a method
+// may synchronously call another module's method directly
+static __thread __unsafe_unretained RCTBridge *RCTCallingBridgeOnThread;
+
+RCTBridge *RCTCallingBridge(void)
+{
+  return RCTCallingBridgeOnThread;
+}
+
+static BOOL RCTIsWordType(const char *objcType)
+{
+  switch (objcType[0]) {
+    case _C_CHR:
+    case _C_UCHR:
+    case _C_SHT:
+    case _C_USHT:
+    case _C_INT:
+    case _C_UINT:
+    case _C_LNG:
+    case _C_ULNG:
+    case _C_LNG_LNG:
+    case _C_ULNG_LNG:
+    case _C_BOOL:
+    case _C_ID:
+    case _C_SEL:
+    case _C_CHARPTR:
+    case _C_PTR:
+      return YES;
+    default:
+      return NO;
+  }
+}
+
+/**
+ * Reads an argument written by an RCTArgumentBlock, extended to intptr_t the
+ * same way the compiler would extend it when passing it in a register.
+ */
+static intptr_t RCTWordFromArgument(const void *value, char objcType)
+{
+  switch (objcType) {
+    case _C_CHR: return *(const char *)value;
+    case _C_UCHR: return *(const unsigned char *)value;
+    case _C_SHT: return *(const short *)value;
+    case _C_USHT: return *(const unsigned short *)value;
+    case _C_INT: return *(const int *)value;
+    case _C_UINT: return *(const unsigned int *)value;
+    case _C_BOOL: return *(const BOOL *)value;
+    default: return *(const intptr_t *)value;
+  }
+}
+
 @implementation RCTMethodArgument
 
 - (instancetype)initWithType:(NSString *)type
@@ -48,6 +114,10 @@ typedef BOOL (^RCTArgumentBlock)(RCTBridge *, NSUInteger, id);
   Class _moduleClass;
   NSInvocation *_invocation;
   NSArray *_argumentBlocks;
+  RCTInvocationStyle _invocationStyle;
+  NSMutableData *_argumentValues;
+  NSUInteger _argumentStride;
+  char _wordArgumentTypes[RCTMaxDirectArguments];
   NSString *_objCMethodName;
   SEL _selector;
   NSDictionary *_profileArgs;
@@ -118,6 +188,17 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
 - (instancetype)initWithObjCMethodName:(NSString *)objCMethodName
                           JSMethodName:(NSString *)JSMethodName
                            moduleClass:(Class)moduleClass
+{
+  return [self initWithObjCMethodName:objCMethodName
+                         JSMethodName:JSMethodName
+                                 sync:NO
+                          moduleClass:moduleClass];
+}
+
+- (instancetype)initWithObjCMethodName:(NSString *)objCMethodName
+                          JSMethodName:(NSString *)JSMethodName
+                                  sync:(BOOL)sync
+                           moduleClass:(Class)moduleClass
 {
   if ((self = [super init])) {
 
@@ -134,7 +215,13 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
       methodName;
     });
 
-    if ([_objCMethodName rangeOfString:@"RCTPromise"].length) {
+    if (sync) {
+      RCTAssert(![_objCMethodName rangeOfString:@"RCTPromise"].length &&
+                ![_objCMethodName rangeOfString:@"RCTResponse"].length,
+                @"%@ is exported as sync, so it must return its result "
+                "instead of taking callbacks or promise blocks", objCMethodName);
+      _functionType = RCTFunctionTypeSync;
+    } else if ([_objCMethodName rangeOfString:@"RCTPromise"].length) {
       _functionType = RCTFunctionTypePromise;
     } else {
       _functionType = RCTFunctionTypeNormal;
@@ -153,22 +240,56 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
   _selector = NSSelectorFromString(objCMethodName);
   RCTAssert(_selector, @"%@ is not a valid selector", objCMethodName);
 
-  // Create method invocation
   NSMethodSignature *methodSignature = [_moduleClass instanceMethodSignatureForSelector:_selector];
   RCTAssert(methodSignature, @"%@ is not a recognized Objective-C method.", objCMethodName);
-  NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:methodSignature];
-  invocation.selector = _selector;
-  [invocation retainArguments];
-  _invocation = invocation;
+  RCTAssert(_functionType != RCTFunctionTypeSync || methodSignature.methodReturnType[0] == _C_ID,
+            @"%@ is exported as sync, so it must return an object", objCMethodName);
+  NSUInteger numberOfArguments = methodSignature.numberOfArguments;
+
+  // Work out how the method can be called, and how much space each converted
+  // argument needs. Every argument gets a slot of the same size in
+  // _argumentValues, which the argument blocks write into.
+  BOOL allWords = (methodSignature.methodReturnType[0] == _C_VOID &&
+                   numberOfArguments - 2 <= RCTMaxDirectArguments);
+  BOOL allDoubles = allWords;
+  NSUInteger argumentSize = sizeof(intptr_t);
+  for (NSUInteger i = 2; i < numberOfArguments; i++) {
+    const char *objcType = [methodSignature getArgumentTypeAtIndex:i];
+    NSUInteger size = sizeof(id);
+    if (objcType[0] != _C_ID) {
+      NSGetSizeAndAlignment(objcType, &size, NULL);
+    }
+    argumentSize = MAX(argumentSize, size);
+    allWords = allWords && size <= sizeof(intptr_t) && RCTIsWordType(objcType);
+    allDoubles = allDoubles && objcType[0] == _C_DBL;
+    if (allWords) {
+      _wordArgumentTypes[i - 2] = objcType[0];
+    }
+  }
+  _argumentStride = (argumentSize + 15) & ~(NSUInteger)15;
+  _argumentValues = [NSMutableData dataWithLength:_argumentStride * (numberOfArguments - 2)];
+  char *argumentValues = _argumentValues.mutableBytes;
+  NSUInteger argumentStride = _argumentStride;
+
+  if (allWords) {
+    _invocationStyle = RCTInvocationStyleWords;
+  } else if (allDoubles) {
+    _invocationStyle = RCTInvocationStyleDoubles;
+  } else {
+    _invocationStyle = RCTInvocationStyleInvocation;
+    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:methodSignature];
+    invocation.selector = _selector;
+    [invocation retainArguments];
+    _invocation = invocation;
+  }
 
   // Process arguments
-  NSUInteger numberOfArguments = methodSignature.numberOfArguments;
   NSMutableArray *argumentBlocks = [[NSMutableArray alloc] initWithCapacity:numberOfArguments - 2];
 
 #define RCT_ARG_BLOCK(_logic) \
 [argumentBlocks addObject:^(__unused RCTBridge *bridge, NSUInteger index, id json) { \
   _logic \
-  [invocation setArgument:&value atIndex:(index) + 2]; \
+  memcpy(argumentValues + (index) * argumentStride, &value, sizeof(value)); \
   return YES; \
 }];
 
@@ -181,7 +302,7 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
         return NO;
       }
 
-      // Marked as autoreleasing, because NSInvocation doesn't retain arguments
+      // Marked as autoreleasing, because the argument values aren't retained
       __autoreleasing id value = (json ? ^(NSArray *args) {
         [bridge _invokeAndProcessModule:@"BatchedBridge"
                                  method:@"invokeCallbackAndReturnFlushedQueue"
@@ -231,7 +352,16 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
         RCT_NULLABLE_CASE(_C_SEL, SEL)
         RCT_NULLABLE_CASE(_C_CHARPTR, const char *)
         RCT_NULLABLE_CASE(_C_PTR, void *)
-        RCT_NULLABLE_CASE(_C_ID, id)
+
+        case _C_ID: {
+          isNullableType = YES;
+          id (*convert)(id, SEL, id) = (typeof(convert))objc_msgSend;
+          RCT_ARG_BLOCK(
+            // Marked as autoreleasing, because the argument values aren't retained
+            __autoreleasing id value = convert([RCTConvert class], selector, json);
+          )
+          break;
+        }
 
         case _C_STRUCT_B: {
 
@@ -241,12 +371,9 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
           typeInvocation.target = [RCTConvert class];
 
           [argumentBlocks addObject:^(__unused RCTBridge *bridge, NSUInteger index, id json) {
-            void *returnValue = malloc(typeSignature.methodReturnLength);
             [typeInvocation setArgument:&json atIndex:2];
             [typeInvocation invoke];
-            [typeInvocation getReturnValue:returnValue];
-            [invocation setArgument:returnValue atIndex:index + 2];
-            free(returnValue);
+            [typeInvocation getReturnValue:argumentValues + index * argumentStride];
             return YES;
           }];
           break;
@@ -272,7 +399,7 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
           return NO;
         }
 
-        // Marked as autoreleasing, because NSInvocation doesn't retain arguments
+        // Marked as autoreleasing, because the argument values aren't retained
         __autoreleasing id value = (json ? ^(NSError *error) {
           [bridge _invokeAndProcessModule:@"BatchedBridge"
                                      method:@"invokeCallbackAndReturnFlushedQueue"
@@ -289,7 +416,7 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
           return NO;
         }
 
-        // Marked as autoreleasing, because NSInvocation doesn't retain arguments
+        // Marked as autoreleasing, because the argument values aren't retained
         __autoreleasing RCTPromiseResolveBlock value = (^(id result) {
           [bridge _invokeAndProcessModule:@"BatchedBridge"
                                    method:@"invokeCallbackAndReturnFlushedQueue"
@@ -306,7 +433,7 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
           return NO;
         }
 
-        // Marked as autoreleasing, because NSInvocation doesn't retain arguments
+        // Marked as autoreleasing, because the argument values aren't retained
         __autoreleasing RCTPromiseRejectBlock value = (^(NSError *error) {
           NSDictionary *errorJSON = RCTJSErrorFromNSError(error);
           [bridge _invokeAndProcessModule:@"BatchedBridge"
@@ -375,9 +502,9 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
 
 - (NSDictionary *)profileArgs
 {
-  if (_profileArgs) {
+  if (!_profileArgs) {
     // This sets _selector
-    [self processMethodSignature];
+    (void)self.selector;
     _profileArgs = @{
       @"module": NSStringFromClass(_moduleClass),
       @"selector": NSStringFromSelector(_selector),
@@ -432,7 +559,71 @@ void RCTParseObjCMethodName(NSString **objCMethodName, NSArray **arguments)
   }
 
   // Invoke method
-  [_invocation invokeWithTarget:module];
+  const char *argumentValues = _argumentValues.bytes;
+  NSUInteger count = _argumentBlocks.count;
+  RCTBridge *previousCallingBridge = RCTCallingBridgeOnThread;
+  RCTCallingBridgeOnThread = bridge;
+  switch (_invocationStyle) {
+
+#define RCT_DIRECT_INVOKE(_type, _args) \
+    switch (count) { \
+      case 0: ((void (*)(id, SEL))objc_msgSend)(module, _selector); break; \
+      case 1: ((void (*)(id, SEL, _type))objc_msgSend)(module, _selector, _args[0]); break; \
+      case 2: ((void (*)(id, SEL, _type, _type))objc_msgSend)(module, _selector, _args[0], _args[1]); break; \
+      case 3: ((void (*)(id, SEL, _type, _type, _type))objc_msgSend)(module, _selector, _args[0], _args[1], _args[2]); break; \
+      case 4: ((void (*)(id, SEL, _type, _type, _type, _type))objc_msgSend)(module, _selector, _args[0], _args[1], _args[2], _args[3]); break; \
+      case 5: ((void (*)(id, SEL, _type, _type, _type, _type, _type))objc_msgSend)(module, _selector, _args[0], _args[1], _args[2], _args[3], _args[4]); break; \
+      case 6: ((void (*)(id, SEL, _type, _type, _type, _type, _type, _type))objc_msgSend)(module, _selector, _args[0], _args[1], _args[2], _args[3], _args[4], _args[5]); break; \
+    }
+
+    case RCTInvocationStyleWords: {
+      intptr_t words[RCTMaxDirectArguments];
+      for (NSUInteger i = 0; i < count; i++) {
+        words[i] = RCTWordFromArgument(argumentValues + i * _argumentStride, _wordArgumentTypes[i]);
+      }
+      RCT_DIRECT_INVOKE(intptr_t, words)
+      break;
+    }
+
+    case RCTInvocationStyleDoubles: {
+      double doubles[RCTMaxDirectArguments];
+      for (NSUInteger i = 0; i < count; i++) {
+        doubles[i] = *(const double *)(argumentValues + i * _argumentStride);
+      }
+      RCT_DIRECT_INVOKE(double, doubles)
+      break;
+    }
+
+    case RCTInvocationStyleInvocation: {
+      for (NSUInteger i = 0; i < count; i++) {
+        [_invocation setArgument:(void *)(argumentValues + i * _argumentStride) atIndex:i + 2];
+      }
+      [_invocation invokeWithTarget:module];
+      break;
+    }
+  }
+  RCTCallingBridgeOnThread = previousCallingBridge;
+}
+
+- (id)invokeSyncWithBridge:(RCTBridge *)bridge
+                    module:(id)module
+                 arguments:(NSArray *)arguments
+{
+  RCTAssert(_functionType == RCTFunctionTypeSync, @"%@ is not a sync method",
+            [self methodName]);
+
+  if (_argumentBlocks == nil) {
+    [self processMethodSignature];
+  }
+
+  // Sync methods return an object, so they are always called through
+  // _invocation. Clearing its return value first means a call that was
+  // aborted over a bad argument returns nil rather than the last result.
+  __unsafe_unretained id result = nil;
+  [_invocation setReturnValue:&result];
+  [self invokeWithBridge:bridge module:module arguments:arguments];
+  [_invocation getReturnValue:&result];
+  return result;
 }
 
 - (NSString *)methodName
@@ -15,6 +15,13 @@
 @property (nonatomic, strong) RCTFPSGraph *jsGraph;
 @property (nonatomic, strong) RCTFPSGraph *uiGraph;
 
+/**
+ * Frames the JS thread missed entirely, and frames in which it deferred
+ * scheduled JS calls to stay within the frame budget.
+ */
+@property (nonatomic, assign) NSUInteger droppedJSFrames;
+@property (nonatomic, assign) NSUInteger deferredJSFrames;
+
 - (void)show;
 - (void)hide;
 
@@ -15,10 +15,52 @@ typedef NS_ENUM(NSUInteger, RCTPLTag) {
   RCTPLScriptDownload = 0,
   RCTPLScriptExecution,
   RCTPLNativeModuleInit,
+  RCTPLNativeModulePrepareConfig,
+  RCTPLNativeModuleInjectConfig,
+  RCTPLJSCExecutorSetup,
   RCTPLTTI,
   RCTPLSize
 };
 
+typedef NS_ENUM(NSUInteger, RCTPLCounter) {
+  RCTPLNetworkRequests = 0,
+  RCTPLNetworkReusedConnections,
+  RCTPLNetworkDNSTime,
+  RCTPLNetworkTLSTime,
+  RCTPLNetworkTTFB,
+  RCTPLCounterSize
+};
+
 void RCTPerformanceLoggerStart(RCTPLTag tag);
 void RCTPerformanceLoggerEnd(RCTPLTag tag);
 NSArray *RCTPerformanceLoggerOutput(void);
+
+/**
+ * Timeline markers record named startup phases on top of the fixed tags.
+ * Sections nest within the thread that begins them, and
+ * RCTPerformanceLoggerEndSection() ends the innermost open section. Marks are
+ * single points in time, and values attach a number to the timeline, such as
+ * the number of modules. While RCTProfile is recording, sections and marks
+ * are forwarded to it as well.
+ */
+void RCTPerformanceLoggerBeginSection(NSString *name);
+void RCTPerformanceLoggerEndSection(void);
+void RCTPerformanceLoggerMark(NSString *name);
+void RCTPerformanceLoggerSetValue(NSString *name, int64_t value);
+
+/**
+ * The timeline recorded so far, including the fixed tags, as a JSON-compatible
+ * array of entries. Each entry has a "name" and a "type" of "span", "section",
+ * "mark" or "value". Spans and sections have "start" and "end" (the latter is
+ * missing while they're still open) and sections have a "depth". Marks have a
+ * "time", and values a "value". Times are in ms since the process started.
+ */
+NSArray *RCTPerformanceLoggerTimeline(void);
+
+/**
+ * Counters add up values reported over the lifetime of the app, such as the
+ * number of network requests or their total time to first byte in ms. They
+ * can be updated from any thread.
+ */
+void RCTPerformanceLoggerAdd(RCTPLCounter counter, int64_t value);
+NSArray *RCTPerformanceLoggerCounters(void);
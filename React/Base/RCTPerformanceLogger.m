@@ -7,21 +7,193 @@
  * of patent rights can be found in the PATENTS file in the same directory.
  */
 
+#import <libkern/OSAtomic.h>
 #import <QuartzCore/QuartzCore.h>
+#import <sys/sysctl.h>
 
 #import "RCTPerformanceLogger.h"
+#import "RCTProfile.h"
 #import "RCTRootView.h"
 
 static int64_t RCTPLData[RCTPLSize][2] = {};
+static volatile int64_t RCTPLCounters[RCTPLCounterSize] = {};
+
+static NSArray *RCTPLLabels(void)
+{
+  return @[
+    @"ScriptDownload",
+    @"ScriptExecution",
+    @"NativeModuleInit",
+    @"NativeModulePrepareConfig",
+    @"NativeModuleInjectConfig",
+    @"JSCExecutorSetup",
+    @"TTI",
+  ];
+}
+
+#pragma mark - Timeline
+
+// The timeline is meant for startup phases, so it stops growing after this
+static const NSUInteger RCTPLTimelineMaxEntries = 1024;
+
+static NSLock *RCTPLTimelineLock;
+static NSMutableArray<NSMutableDictionary *> *RCTPLTimeline;
+
+// The timeline span of the last start of each fixed tag
+static NSMutableDictionary *RCTPLTagSpans[RCTPLSize];
+static int RCTPLTagProfileCookies[RCTPLSize];
+
+static void RCTPLTimelineInit(void)
+{
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    RCTPLTimelineLock = [NSLock new];
+    RCTPLTimeline = [NSMutableArray new];
+  });
+}
+
+/**
+ * The process start time, on the CACurrentMediaTime() clock.
+ */
+static CFTimeInterval RCTPLProcessStartTime(void)
+{
+  static CFTimeInterval processStartTime;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    processStartTime = CACurrentMediaTime();
+
+    struct kinfo_proc info;
+    size_t size = sizeof(info);
+    int mib[] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+    if (sysctl(mib, sizeof(mib) / sizeof(mib[0]), &info, &size, NULL, 0) == 0) {
+      struct timeval start = info.kp_proc.p_starttime;
+      NSTimeInterval sinceStart = [NSDate date].timeIntervalSince1970 - (start.tv_sec + start.tv_usec / 1e6);
+      processStartTime -= MAX(sinceStart, 0);
+    }
+  });
+  return processStartTime;
+}
+
+static NSNumber *RCTPLTimelineNow(void)
+{
+  return @((CACurrentMediaTime() - RCTPLProcessStartTime()) * 1000);
+}
+
+static void RCTPLTimelineAdd(NSMutableDictionary *entry)
+{
+  RCTPLTimelineInit();
+  [RCTPLTimelineLock lock];
+  if (RCTPLTimeline.count < RCTPLTimelineMaxEntries) {
+    [RCTPLTimeline addObject:entry];
+  }
+  [RCTPLTimelineLock unlock];
+}
+
+static NSMutableArray *RCTPLOpenSections(void)
+{
+  static NSString *const RCTPLOpenSectionsKey = @"RCTPLOpenSections";
+  NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+  NSMutableArray *sections = threadDictionary[RCTPLOpenSectionsKey];
+  if (!sections) {
+    sections = [NSMutableArray new];
+    threadDictionary[RCTPLOpenSectionsKey] = sections;
+  }
+  return sections;
+}
+
+void RCTPerformanceLoggerBeginSection(NSString *name)
+{
+  NSMutableArray *sections = RCTPLOpenSections();
+  NSMutableDictionary *section = [@{
+    @"name": name,
+    @"type": @"section",
+    @"start": RCTPLTimelineNow(),
+    @"depth": @(sections.count),
+  } mutableCopy];
+  [sections addObject:section];
+  RCTPLTimelineAdd(section);
+
+  RCTProfileBeginEvent(0, name, nil);
+}
+
+void RCTPerformanceLoggerEndSection(void)
+{
+  NSMutableArray *sections = RCTPLOpenSections();
+  NSMutableDictionary *section = sections.lastObject;
+  if (!section) {
+    return;
+  }
+  [sections removeLastObject];
+
+  [RCTPLTimelineLock lock];
+  section[@"end"] = RCTPLTimelineNow();
+  [RCTPLTimelineLock unlock];
+
+  RCTProfileEndEvent(0, @"perf_logger", nil);
+}
+
+void RCTPerformanceLoggerMark(NSString *name)
+{
+  RCTPLTimelineAdd([@{
+    @"name": name,
+    @"type": @"mark",
+    @"time": RCTPLTimelineNow(),
+  } mutableCopy]);
+
+  RCTProfileImmediateEvent(0, name, 't');
+}
+
+void RCTPerformanceLoggerSetValue(NSString *name, int64_t value)
+{
+  RCTPLTimelineAdd([@{
+    @"name": name,
+    @"type": @"value",
+    @"value": @(value),
+  } mutableCopy]);
+}
+
+NSArray *RCTPerformanceLoggerTimeline(void)
+{
+  RCTPLTimelineInit();
+  NSMutableArray *timeline = [NSMutableArray new];
+  [RCTPLTimelineLock lock];
+  for (NSDictionary *entry in RCTPLTimeline) {
+    [timeline addObject:[entry copy]];
+  }
+  [RCTPLTimelineLock unlock];
+  return timeline;
+}
+
+#pragma mark - Fixed tags
 
 void RCTPerformanceLoggerStart(RCTPLTag tag)
 {
   RCTPLData[tag][0] = CACurrentMediaTime() * 1000;
+
+  // Tags may end on another thread, so they're spans rather than sections
+  NSMutableDictionary *span = [@{
+    @"name": RCTPLLabels()[tag],
+    @"type": @"span",
+    @"start": RCTPLTimelineNow(),
+  } mutableCopy];
+  RCTPLTimelineAdd(span);
+  [RCTPLTimelineLock lock];
+  RCTPLTagSpans[tag] = span;
+  [RCTPLTimelineLock unlock];
+
+  RCTPLTagProfileCookies[tag] = RCTProfileBeginAsyncEvent(0, RCTPLLabels()[tag], nil);
 }
 
 void RCTPerformanceLoggerEnd(RCTPLTag tag)
 {
   RCTPLData[tag][1] = CACurrentMediaTime() * 1000;
+
+  RCTPLTimelineInit();
+  [RCTPLTimelineLock lock];
+  RCTPLTagSpans[tag][@"end"] = RCTPLTimelineNow();
+  [RCTPLTimelineLock unlock];
+
+  RCTProfileEndAsyncEvent(0, @"perf_logger", RCTPLTagProfileCookies[tag], RCTPLLabels()[tag], nil);
 }
 
 NSArray *RCTPerformanceLoggerOutput(void)
@@ -33,11 +205,33 @@ NSArray *RCTPerformanceLoggerOutput(void)
     @(RCTPLData[RCTPLScriptExecution][1]),
     @(RCTPLData[RCTPLNativeModuleInit][0]),
     @(RCTPLData[RCTPLNativeModuleInit][1]),
+    @(RCTPLData[RCTPLNativeModulePrepareConfig][0]),
+    @(RCTPLData[RCTPLNativeModulePrepareConfig][1]),
+    @(RCTPLData[RCTPLNativeModuleInjectConfig][0]),
+    @(RCTPLData[RCTPLNativeModuleInjectConfig][1]),
+    @(RCTPLData[RCTPLJSCExecutorSetup][0]),
+    @(RCTPLData[RCTPLJSCExecutorSetup][1]),
     @(RCTPLData[RCTPLTTI][0]),
     @(RCTPLData[RCTPLTTI][1]),
   ];
 }
 
+#pragma mark - Counters
+
+void RCTPerformanceLoggerAdd(RCTPLCounter counter, int64_t value)
+{
+  OSAtomicAdd64Barrier(value, &RCTPLCounters[counter]);
+}
+
+NSArray *RCTPerformanceLoggerCounters(void)
+{
+  NSMutableArray *counters = [NSMutableArray arrayWithCapacity:RCTPLCounterSize];
+  for (NSUInteger i = 0; i < RCTPLCounterSize; i++) {
+    [counters addObject:@(OSAtomicAdd64Barrier(0, &RCTPLCounters[i]))];
+  }
+  return counters;
+}
+
 @interface RCTPerformanceLogger : NSObject <RCTBridgeModule>
 
 @end
@@ -48,6 +242,11 @@ RCT_EXPORT_MODULE()
 
 @synthesize bridge = _bridge;
 
++ (RCTMethodQueuePriority)methodQueuePriority
+{
+  return RCTMethodQueuePriorityBackground;
+}
+
 - (instancetype)init
 {
   if ((self = [super init])) {
@@ -68,15 +267,23 @@ RCT_EXPORT_MODULE()
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
 
-  [_bridge enqueueJSCall:@"PerformanceLogger.addTimespans" args:@[
-    RCTPerformanceLoggerOutput(),
-    @[
-      @"ScriptDownload",
-      @"ScriptExecution",
-      @"NativeModuleInit",
-      @"TTI",
-    ],
-  ]];
+  // Finished timeline sections are sent along with the fixed tags
+  NSMutableArray *timespans = [RCTPerformanceLoggerOutput() mutableCopy];
+  NSMutableArray *labels = [RCTPLLabels() mutableCopy];
+  for (NSDictionary *entry in RCTPerformanceLoggerTimeline()) {
+    if ([entry[@"type"] isEqualToString:@"section"] && entry[@"end"]) {
+      [timespans addObject:entry[@"start"]];
+      [timespans addObject:entry[@"end"]];
+      [labels addObject:entry[@"name"]];
+    }
+  }
+
+  [_bridge enqueueJSCall:@"PerformanceLogger.addTimespans" args:@[timespans, labels]];
+}
+
+RCT_EXPORT_METHOD(getTimeline:(RCTResponseSenderBlock)callback)
+{
+  callback(@[RCTPerformanceLoggerTimeline()]);
 }
 
 @end
@@ -23,6 +23,13 @@
 RCT_EXTERN NSString *const RCTProfileDidStartProfiling;
 RCT_EXTERN NSString *const RCTProfileDidEndProfiling;
 
+/**
+ * Posted on the main thread at a regular interval while profiling. Observers
+ * should record whatever they account for, e.g. cache footprints or object
+ * counts, with RCTProfileCounterEvent, from whichever thread owns that state.
+ */
+RCT_EXTERN NSString *const RCTProfileWillSampleCounters;
+
 #if RCT_DEV
 
 @class RCTBridge;
@@ -39,6 +46,12 @@ _RCTProfileEndFlowEvent(__rct_profile_flow_id)
 RCT_EXTERN NSNumber *_RCTProfileBeginFlowEvent(void);
 RCT_EXTERN void _RCTProfileEndFlowEvent(NSNumber *);
 
+/**
+ * Marks an intermediate step of a flow that is followed across more than two
+ * threads, so that every thread it passes through is linked in the trace.
+ */
+RCT_EXTERN void _RCTProfileStepFlowEvent(NSNumber *);
+
 /**
  * Returns YES if the profiling information is currently being collected
  */
@@ -56,39 +69,80 @@ RCT_EXTERN void RCTProfileInit(RCTBridge *);
  */
 RCT_EXTERN NSString *RCTProfileEnd(RCTBridge *);
 
+/**
+ * The event macros below only evaluate their arguments while a profile is
+ * being recorded, so names and args can be built inline without costing
+ * anything the rest of the time. They take their arguments as __VA_ARGS__ so
+ * that dictionary literals and messages with several arguments can be passed
+ * without extra parentheses.
+ */
+
 /**
  * Collects the initial event information for the event and returns a reference ID
+ *
+ * RCTProfileBeginEvent(uint64_t tag, NSString *name, NSDictionary *args)
  */
-RCT_EXTERN void RCTProfileBeginEvent(uint64_t tag,
-                                     NSString *name,
-                                     NSDictionary *args);
+#define RCTProfileBeginEvent(...) \
+do { \
+  if (RCTProfileIsProfiling()) { \
+    _RCTProfileBeginEvent(__VA_ARGS__); \
+  } \
+} while (0)
+
+RCT_EXTERN void _RCTProfileBeginEvent(uint64_t tag,
+                                      NSString *name,
+                                      NSDictionary *args);
 
 /**
  * The ID returned by BeginEvent should then be passed into EndEvent, with the
  * rest of the event information. Just at this point the event will actually be
  * registered
+ *
+ * RCTProfileEndEvent(uint64_t tag, NSString *category, NSDictionary *args)
  */
-RCT_EXTERN void RCTProfileEndEvent(uint64_t tag,
-                                   NSString *category,
-                                   NSDictionary *args);
+#define RCTProfileEndEvent(...) \
+do { \
+  if (RCTProfileIsProfiling()) { \
+    _RCTProfileEndEvent(__VA_ARGS__); \
+  } \
+} while (0)
+
+RCT_EXTERN void _RCTProfileEndEvent(uint64_t tag,
+                                    NSString *category,
+                                    NSDictionary *args);
 
 /**
  * Collects the initial event information for the event and returns a reference ID
+ *
+ * int RCTProfileBeginAsyncEvent(uint64_t tag, NSString *name, NSDictionary *args)
  */
-RCT_EXTERN int RCTProfileBeginAsyncEvent(uint64_t tag,
-                                         NSString *name,
-                                         NSDictionary *args);
+#define RCTProfileBeginAsyncEvent(...) \
+(RCTProfileIsProfiling() ? _RCTProfileBeginAsyncEvent(__VA_ARGS__) : 0)
+
+RCT_EXTERN int _RCTProfileBeginAsyncEvent(uint64_t tag,
+                                          NSString *name,
+                                          NSDictionary *args);
 
 /**
  * The ID returned by BeginEvent should then be passed into EndEvent, with the
  * rest of the event information. Just at this point the event will actually be
  * registered
+ *
+ * RCTProfileEndAsyncEvent(uint64_t tag, NSString *category, int cookie,
+ *                         NSString *name, NSDictionary *args)
  */
-RCT_EXTERN void RCTProfileEndAsyncEvent(uint64_t tag,
-                                        NSString *category,
-                                        int cookie,
-                                        NSString *name,
-                                        NSDictionary *args);
+#define RCTProfileEndAsyncEvent(...) \
+do { \
+  if (RCTProfileIsProfiling()) { \
+    _RCTProfileEndAsyncEvent(__VA_ARGS__); \
+  } \
+} while (0)
+
+RCT_EXTERN void _RCTProfileEndAsyncEvent(uint64_t tag,
+                                         NSString *category,
+                                         int cookie,
+                                         NSString *name,
+                                         NSDictionary *args);
 /**
  * An event that doesn't have a duration (i.e. Notification, VSync, etc)
  */
@@ -96,6 +150,23 @@ RCT_EXTERN void RCTProfileImmediateEvent(uint64_t tag,
                                          NSString *name,
                                          char scope);
 
+/**
+ * Records the current values of a counter track, e.g. @{@"views": @120}. All
+ * values should be numbers.
+ *
+ * RCTProfileCounterEvent(uint64_t tag, NSString *name, NSDictionary *values)
+ */
+#define RCTProfileCounterEvent(...) \
+do { \
+  if (RCTProfileIsProfiling()) { \
+    _RCTProfileCounterEvent(__VA_ARGS__); \
+  } \
+} while (0)
+
+RCT_EXTERN void _RCTProfileCounterEvent(uint64_t tag,
+                                        NSString *name,
+                                        NSDictionary *values);
+
 /**
  * Helper to profile the duration of the execution of a block. This method uses
  * self and _cmd to name this event for simplicity sake.
@@ -132,6 +203,7 @@ RCT_EXTERN void RCTProfileSendResult(RCTBridge *bridge, NSString *route, NSData
 
 #define RCTProfileEndFlowEvent()
 #define _RCTProfileEndFlowEvent()
+#define _RCTProfileStepFlowEvent(...)
 
 #define RCTProfileIsProfiling(...) NO
 #define RCTProfileInit(...)
@@ -145,6 +217,8 @@ RCT_EXTERN void RCTProfileSendResult(RCTBridge *bridge, NSString *route, NSData
 
 #define RCTProfileImmediateEvent(...)
 
+#define RCTProfileCounterEvent(...)
+
 #define RCTProfileBlock(block, ...) block
 
 #define RCTProfileHookModules(...)
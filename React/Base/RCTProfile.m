@@ -9,9 +9,12 @@
 
 #import "RCTProfile.h"
 
+#import <libkern/OSAtomic.h>
 #import <mach/mach.h>
+#import <mach/mach_time.h>
 #import <objc/message.h>
 #import <objc/runtime.h>
+#import <pthread.h>
 
 #import <UIKit/UIKit.h>
 
@@ -24,6 +27,7 @@
 
 NSString *const RCTProfileDidStartProfiling = @"RCTProfileDidStartProfiling";
 NSString *const RCTProfileDidEndProfiling = @"RCTProfileDidEndProfiling";
+NSString *const RCTProfileWillSampleCounters = @"RCTProfileWillSampleCounters";
 
 #if RCT_DEV
 
@@ -33,6 +37,9 @@ NSString const *RCTProfileTraceEvents = @"traceEvents";
 NSString const *RCTProfileSamples = @"samples";
 NSString *const RCTProfilePrefix = @"rct_profile_";
 
+// How often counter tracks are sampled, in seconds
+static const NSTimeInterval RCTProfileCounterSampleInterval = 0.25;
+
 #pragma mark - Variables
 
 NSDictionary *RCTProfileInfo;
@@ -41,6 +48,17 @@ NSMutableDictionary *RCTProfileOngoingEvents;
 NSTimeInterval RCTProfileStartTime;
 NSRecursiveLock *_RCTProfileLock;
 
+// Main thread only
+static dispatch_source_t RCTProfileCounterTimer;
+
+// Mirrors RCTProfileInfo != nil, so that RCTProfileIsProfiling(), which is
+// checked before every event, doesn't have to take the lock
+static volatile BOOL RCTProfileProfiling = NO;
+
+// Incremented by every RCTProfileInit, so that threads know to reset their
+// event buffers
+static volatile NSUInteger RCTProfileSession = 0;
+
 #pragma mark - Macros
 
 #define RCTProfileAddEvent(type, props...) \
@@ -92,6 +110,53 @@ static NSDictionary *RCTProfileGetMemoryUsage(void)
   }
 }
 
+static void RCTProfileSampleCounters(void)
+{
+  struct task_basic_info info;
+  mach_msg_type_number_t size = sizeof(info);
+  kern_return_t kerr = task_info(mach_task_self(),
+                                 TASK_BASIC_INFO,
+                                 (task_info_t)&info,
+                                 &size);
+  if (kerr == KERN_SUCCESS) {
+    _RCTProfileCounterEvent(0, @"memory", @{
+      @"resident_mb": @(info.resident_size / 1024.0 / 1024.0),
+      @"virtual_mb": @(info.virtual_size / 1024.0 / 1024.0),
+    });
+  }
+
+  [[NSNotificationCenter defaultCenter] postNotificationName:RCTProfileWillSampleCounters
+                                                      object:nil];
+}
+
+static void RCTProfileStartSamplingCounters(void)
+{
+  dispatch_async(dispatch_get_main_queue(), ^{
+    if (RCTProfileCounterTimer || !RCTProfileIsProfiling()) {
+      return;
+    }
+    RCTProfileCounterTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    uint64_t interval = (uint64_t)(RCTProfileCounterSampleInterval * NSEC_PER_SEC);
+    dispatch_source_set_timer(RCTProfileCounterTimer, dispatch_time(DISPATCH_TIME_NOW, 0), interval, interval / 10);
+    dispatch_source_set_event_handler(RCTProfileCounterTimer, ^{
+      if (RCTProfileIsProfiling()) {
+        RCTProfileSampleCounters();
+      }
+    });
+    dispatch_resume(RCTProfileCounterTimer);
+  });
+}
+
+static void RCTProfileStopSamplingCounters(void)
+{
+  dispatch_async(dispatch_get_main_queue(), ^{
+    if (RCTProfileCounterTimer) {
+      dispatch_source_cancel(RCTProfileCounterTimer);
+      RCTProfileCounterTimer = nil;
+    }
+  });
+}
+
 static NSDictionary *RCTProfileMergeArgs(NSDictionary *args0, NSDictionary *args1)
 {
   args0 = RCTNilIfNull(args0);
@@ -108,6 +173,149 @@ static NSDictionary *RCTProfileMergeArgs(NSDictionary *args0, NSDictionary *args
   return RCTNullIfNil(args0);
 }
 
+#pragma mark - Event buffers
+
+/**
+ * Begin and end events are recorded into a buffer owned by the calling thread,
+ * rather than boxed and added to RCTProfileInfo under the lock. The buffers
+ * are only converted to trace events by RCTProfileEnd.
+ */
+
+// Completed events kept per thread and session, later ones are dropped
+#define RCTProfileBufferCapacity (16 * 1024)
+
+// Events nested deeper than this are not recorded
+#define RCTProfileMaxDepth 64
+
+typedef struct {
+  uint64_t start;
+  uint64_t end;
+  CFStringRef name;
+  CFStringRef category;
+  CFDictionaryRef args;
+  CFDictionaryRef endArgs;
+} RCTProfileRecord;
+
+typedef struct RCTProfileBuffer {
+  struct RCTProfileBuffer *next;
+  NSUInteger session;
+  CFStringRef threadName;
+  BOOL exited;
+
+  // Only the owning thread writes records; count is published with a barrier,
+  // so RCTProfileEnd can read the records below it without locking
+  volatile int64_t count;
+  RCTProfileRecord records[RCTProfileBufferCapacity];
+
+  NSUInteger depth;
+  RCTProfileRecord open[RCTProfileMaxDepth];
+} RCTProfileBuffer;
+
+static pthread_key_t RCTProfileBufferKey;
+static pthread_mutex_t RCTProfileBuffersLock = PTHREAD_MUTEX_INITIALIZER;
+static RCTProfileBuffer *RCTProfileBuffers;
+
+static void RCTProfileReleaseRecord(RCTProfileRecord *record)
+{
+  CFTypeRef values[] = {record->name, record->category, record->args, record->endArgs};
+  for (NSUInteger i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    if (values[i]) {
+      CFRelease(values[i]);
+    }
+  }
+  memset(record, 0, sizeof(*record));
+}
+
+static void RCTProfileResetBuffer(RCTProfileBuffer *buffer)
+{
+  for (int64_t i = 0; i < buffer->count; i++) {
+    RCTProfileReleaseRecord(&buffer->records[i]);
+  }
+  for (NSUInteger i = 0; i < MIN(buffer->depth, RCTProfileMaxDepth); i++) {
+    RCTProfileReleaseRecord(&buffer->open[i]);
+  }
+  if (buffer->threadName) {
+    CFRelease(buffer->threadName);
+    buffer->threadName = NULL;
+  }
+  buffer->depth = 0;
+  buffer->count = 0;
+  OSMemoryBarrier();
+}
+
+static void RCTProfileBufferThreadDidExit(void *buffer)
+{
+  // Freed by RCTProfileEnd, once its events have been collected
+  pthread_mutex_lock(&RCTProfileBuffersLock);
+  ((RCTProfileBuffer *)buffer)->exited = YES;
+  pthread_mutex_unlock(&RCTProfileBuffersLock);
+}
+
+static RCTProfileBuffer *RCTProfileCurrentBuffer(void)
+{
+  RCTProfileBuffer *buffer = pthread_getspecific(RCTProfileBufferKey);
+  if (!buffer) {
+    buffer = calloc(1, sizeof(RCTProfileBuffer));
+    pthread_setspecific(RCTProfileBufferKey, buffer);
+    pthread_mutex_lock(&RCTProfileBuffersLock);
+    buffer->next = RCTProfileBuffers;
+    RCTProfileBuffers = buffer;
+    pthread_mutex_unlock(&RCTProfileBuffersLock);
+  }
+  NSUInteger session = RCTProfileSession;
+  if (buffer->session != session) {
+    RCTProfileResetBuffer(buffer);
+    buffer->session = session;
+    buffer->threadName = CFBridgingRetain(RCTCurrentThreadName());
+  }
+  return buffer;
+}
+
+/**
+ * Converts the events recorded by every thread during this session, and frees
+ * the buffers of threads which have exited. Called with profiling stopped.
+ */
+static void RCTProfileCollectBufferedEvents(NSMutableArray *traceEvents)
+{
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+  const double secondsPerTick = (double)timebase.numer / timebase.denom / 1e9;
+  NSNumber *pid = @([[NSProcessInfo processInfo] processIdentifier]);
+
+  pthread_mutex_lock(&RCTProfileBuffersLock);
+  RCTProfileBuffer **link = &RCTProfileBuffers;
+  while (*link) {
+    RCTProfileBuffer *buffer = *link;
+    if (buffer->session == RCTProfileSession) {
+      NSString *threadName = (__bridge NSString *)buffer->threadName;
+      int64_t count = OSAtomicAdd64Barrier(0, &buffer->count);
+      for (int64_t i = 0; i < count; i++) {
+        RCTProfileRecord *record = &buffer->records[i];
+        NSNumber *start = RCTProfileTimestamp(record->start * secondsPerTick);
+        [traceEvents addObject:@{
+          @"pid": pid,
+          @"tid": threadName,
+          @"name": (__bridge NSString *)record->name ?: @"",
+          @"cat": (__bridge NSString *)record->category ?: @"",
+          @"ph": @"X",
+          @"ts": start,
+          @"dur": @((record->end - record->start) * secondsPerTick * 1e6),
+          @"args": RCTProfileMergeArgs((__bridge NSDictionary *)record->args,
+                                       (__bridge NSDictionary *)record->endArgs),
+        }];
+      }
+    }
+    if (buffer->exited) {
+      *link = buffer->next;
+      RCTProfileResetBuffer(buffer);
+      free(buffer);
+    } else {
+      link = &buffer->next;
+    }
+  }
+  pthread_mutex_unlock(&RCTProfileBuffersLock);
+}
+
 #pragma mark - Module hooks
 
 static const char *RCTProfileProxyClassName(Class);
@@ -155,9 +363,80 @@ static IMP RCTProfileMsgForward(NSObject *self, SEL selector)
   return imp;
 }
 
+// Methods hooked with a trampoline can't take more arguments than this
+#define RCTProfileMaxTrampolineArgs 6
+
+typedef uintptr_t (*RCTProfileWordIMP)(id, SEL, uintptr_t, uintptr_t, uintptr_t,
+                                       uintptr_t, uintptr_t, uintptr_t);
+
+static BOOL RCTProfileIsWordType(const char *type)
+{
+  switch (type[0]) {
+    case _C_ID:
+    case _C_CLASS:
+    case _C_SEL:
+    case _C_PTR:
+    case _C_CHARPTR:
+    case _C_CHR:
+    case _C_UCHR:
+    case _C_BOOL:
+    case _C_SHT:
+    case _C_USHT:
+    case _C_INT:
+    case _C_UINT:
+    case _C_LNG:
+    case _C_ULNG:
+      return YES;
+    case _C_LNG_LNG:
+    case _C_ULNG_LNG:
+      return sizeof(uintptr_t) == sizeof(long long);
+    default:
+      return NO;
+  }
+}
+
+/**
+ * Creates an IMP that records the call and then calls the original IMP
+ * directly, without going through forwarding and an NSInvocation. This only
+ * works for methods whose arguments and return value are all passed in integer
+ * registers, which covers most module methods. Passing all the words that such
+ * a call might use on to the original IMP is harmless, since it ignores the
+ * registers it doesn't take. Returns NULL for any other signature.
+ */
+static IMP RCTProfileTrampoline(Class moduleClass, SEL selector, IMP originalIMP)
+{
+  NSMethodSignature *signature = [moduleClass instanceMethodSignatureForSelector:selector];
+  if (!signature || signature.numberOfArguments - 2 > RCTProfileMaxTrampolineArgs) {
+    return NULL;
+  }
+  const char *returnType = signature.methodReturnType;
+  if (returnType[0] != _C_VOID && !RCTProfileIsWordType(returnType)) {
+    return NULL;
+  }
+  for (NSUInteger i = 2; i < signature.numberOfArguments; i++) {
+    if (!RCTProfileIsWordType([signature getArgumentTypeAtIndex:i])) {
+      return NULL;
+    }
+  }
+
+  RCTProfileWordIMP original = (RCTProfileWordIMP)originalIMP;
+  NSString *name = [NSString stringWithFormat:@"-[%@ %@]", NSStringFromClass(moduleClass), NSStringFromSelector(selector)];
+  return imp_implementationWithBlock(^uintptr_t(id self, uintptr_t a0, uintptr_t a1, uintptr_t a2,
+                                                uintptr_t a3, uintptr_t a4, uintptr_t a5) {
+    RCTProfileBeginEvent(0, name, nil);
+    uintptr_t result = original(self, selector, a0, a1, a2, a3, a4, a5);
+    RCTProfileEndEvent(0, @"objc_call,modules,auto", nil);
+    return result;
+  });
+}
+
 void RCTProfileHookModules(RCTBridge *bridge)
 {
   for (RCTModuleData *moduleData in [bridge valueForKey:@"moduleDataByID"]) {
+    // Don't create lazily loaded modules just to profile them
+    if (!moduleData.hasInstance) {
+      continue;
+    }
     [moduleData dispatchBlock:^{
       Class moduleClass = moduleData.moduleClass;
       Class proxyClass = objc_allocateClassPair(moduleClass, RCTProfileProxyClassName(moduleClass), 0);
@@ -176,8 +455,13 @@ void RCTProfileHookModules(RCTBridge *bridge)
         }
         IMP originalIMP = method_getImplementation(method);
         const char *returnType = method_getTypeEncoding(method);
-        class_addMethod(proxyClass, selector, RCTProfileMsgForward(moduleData.instance, selector), returnType);
-        class_addMethod(proxyClass, RCTProfileProxySelector(selector), originalIMP, returnType);
+        IMP trampoline = RCTProfileTrampoline(moduleClass, selector, originalIMP);
+        if (trampoline) {
+          class_addMethod(proxyClass, selector, trampoline, returnType);
+        } else {
+          class_addMethod(proxyClass, selector, RCTProfileMsgForward(moduleData.instance, selector), returnType);
+          class_addMethod(proxyClass, RCTProfileProxySelector(selector), originalIMP, returnType);
+        }
       }
       free(methods);
 
@@ -202,9 +486,24 @@ void RCTProfileHookModules(RCTBridge *bridge)
 void RCTProfileUnhookModules(RCTBridge *bridge)
 {
   for (RCTModuleData *moduleData in [bridge valueForKey:@"moduleDataByID"]) {
+    if (!moduleData.hasInstance) {
+      continue;
+    }
     Class proxyClass = object_getClass(moduleData.instance);
     if (moduleData.moduleClass != proxyClass) {
       object_setClass(moduleData.instance, moduleData.moduleClass);
+
+      // Release the blocks behind the trampolines
+      unsigned int methodCount;
+      Method *methods = class_copyMethodList(proxyClass, &methodCount);
+      for (NSUInteger i = 0; i < methodCount; i++) {
+        IMP imp = method_getImplementation(methods[i]);
+        if (imp_getBlock(imp)) {
+          imp_removeBlock(imp);
+        }
+      }
+      free(methods);
+
       objc_disposeClassPair(proxyClass);
     }
   };
@@ -215,10 +514,7 @@ void RCTProfileUnhookModules(RCTBridge *bridge)
 
 BOOL RCTProfileIsProfiling(void)
 {
-  RCTProfileLock(
-    BOOL profiling = RCTProfileInfo != nil;
-  );
-  return profiling;
+  return RCTProfileProfiling;
 }
 
 void RCTProfileInit(RCTBridge *bridge)
@@ -228,15 +524,20 @@ void RCTProfileInit(RCTBridge *bridge)
   static dispatch_once_t onceToken;
   dispatch_once(&onceToken, ^{
     _RCTProfileLock = [NSRecursiveLock new];
+    pthread_key_create(&RCTProfileBufferKey, RCTProfileBufferThreadDidExit);
   });
   RCTProfileLock(
+    RCTProfileSession++;
     RCTProfileStartTime = CACurrentMediaTime();
     RCTProfileOngoingEvents = [NSMutableDictionary new];
     RCTProfileInfo = @{
       RCTProfileTraceEvents: [NSMutableArray new],
       RCTProfileSamples: [NSMutableArray new],
     };
+    OSMemoryBarrier();
+    RCTProfileProfiling = YES;
   );
+  RCTProfileStartSamplingCounters();
 
   [[NSNotificationCenter defaultCenter] postNotificationName:RCTProfileDidStartProfiling
                                                       object:nil];
@@ -247,7 +548,11 @@ NSString *RCTProfileEnd(RCTBridge *bridge)
   [[NSNotificationCenter defaultCenter] postNotificationName:RCTProfileDidEndProfiling
                                                       object:nil];
 
+  RCTProfileStopSamplingCounters();
   RCTProfileLock(
+    RCTProfileProfiling = NO;
+    OSMemoryBarrier();
+    RCTProfileCollectBufferedEvents(RCTProfileInfo[RCTProfileTraceEvents]);
     NSString *log = RCTJSONStringify(RCTProfileInfo, NULL);
     RCTProfileEventID = 0;
     RCTProfileInfo = nil;
@@ -259,59 +564,51 @@ NSString *RCTProfileEnd(RCTBridge *bridge)
   return log;
 }
 
-static NSMutableArray *RCTProfileGetThreadEvents(void)
-{
-  static NSString *const RCTProfileThreadEventsKey = @"RCTProfileThreadEventsKey";
-  NSMutableArray *threadEvents = [NSThread currentThread].threadDictionary[RCTProfileThreadEventsKey];
-  if (!threadEvents) {
-    threadEvents = [[NSMutableArray alloc] init];
-    [NSThread currentThread].threadDictionary[RCTProfileThreadEventsKey] = threadEvents;
-  }
-  return threadEvents;
-}
-
-void RCTProfileBeginEvent(uint64_t tag, NSString *name, NSDictionary *args)
+void _RCTProfileBeginEvent(__unused uint64_t tag, NSString *name, NSDictionary *args)
 {
   CHECK();
-  NSMutableArray *events = RCTProfileGetThreadEvents();
-  [events addObject:@[
-    RCTProfileTimestamp(CACurrentMediaTime()),
-    @(tag),
-    name,
-    RCTNullIfNil(args),
-  ]];
+
+  RCTProfileBuffer *buffer = RCTProfileCurrentBuffer();
+  if (buffer->depth < RCTProfileMaxDepth) {
+    RCTProfileRecord *record = &buffer->open[buffer->depth];
+    record->name = (CFStringRef)CFBridgingRetain(name);
+    record->args = (CFDictionaryRef)CFBridgingRetain(RCTNilIfNull(args));
+    record->start = mach_absolute_time();
+  }
+  buffer->depth++;
 }
 
-void RCTProfileEndEvent(
+void _RCTProfileEndEvent(
   __unused uint64_t tag,
   NSString *category,
   NSDictionary *args
 ) {
   CHECK();
 
-  NSMutableArray *events = RCTProfileGetThreadEvents();
-  NSArray *event = events.lastObject;
-  [events removeLastObject];
-
-  if (!event) {
+  uint64_t end = mach_absolute_time();
+  RCTProfileBuffer *buffer = RCTProfileCurrentBuffer();
+  if (buffer->depth == 0) {
+    return;
+  }
+  if (--buffer->depth >= RCTProfileMaxDepth) {
     return;
   }
 
-  NSNumber *start = event[0];
+  RCTProfileRecord *open = &buffer->open[buffer->depth];
+  if (buffer->count >= RCTProfileBufferCapacity) {
+    RCTProfileReleaseRecord(open);
+    return;
+  }
 
-  RCTProfileLock(
-    RCTProfileAddEvent(RCTProfileTraceEvents,
-      @"name": event[2],
-      @"cat": category,
-      @"ph": @"X",
-      @"ts": start,
-      @"dur": @(RCTProfileTimestamp(CACurrentMediaTime()).doubleValue - start.doubleValue),
-      @"args": RCTProfileMergeArgs(event[3], args),
-    );
-  );
+  RCTProfileRecord *record = &buffer->records[buffer->count];
+  *record = *open;
+  record->end = end;
+  record->category = (CFStringRef)CFBridgingRetain(category);
+  record->endArgs = (CFDictionaryRef)CFBridgingRetain(RCTNilIfNull(args));
+  OSAtomicIncrement64Barrier(&buffer->count);
 }
 
-int RCTProfileBeginAsyncEvent(
+int _RCTProfileBeginAsyncEvent(
   __unused uint64_t tag,
   NSString *name,
   NSDictionary *args
@@ -331,7 +628,7 @@ int RCTProfileBeginAsyncEvent(
   return eventID++;
 }
 
-void RCTProfileEndAsyncEvent(
+void _RCTProfileEndAsyncEvent(
   __unused uint64_t tag,
   NSString *category,
   int cookie,
@@ -375,6 +672,23 @@ void RCTProfileImmediateEvent(
   );
 }
 
+void _RCTProfileCounterEvent(
+  __unused uint64_t tag,
+  NSString *name,
+  NSDictionary *values
+) {
+  CHECK();
+
+  RCTProfileLock(
+    RCTProfileAddEvent(RCTProfileTraceEvents,
+      @"name": name,
+      @"ts": RCTProfileTimestamp(CACurrentMediaTime()),
+      @"ph": @"C",
+      @"args": values,
+    );
+  );
+}
+
 NSNumber *_RCTProfileBeginFlowEvent(void)
 {
   static NSUInteger flowID = 0;
@@ -403,6 +717,18 @@ void _RCTProfileEndFlowEvent(NSNumber *flowID)
   );
 }
 
+void _RCTProfileStepFlowEvent(NSNumber *flowID)
+{
+  CHECK();
+  RCTProfileAddEvent(RCTProfileTraceEvents,
+    @"name": @"flow",
+    @"id": flowID,
+    @"cat": @"flow",
+    @"ph": @"t",
+    @"ts": RCTProfileTimestamp(CACurrentMediaTime()),
+  );
+}
+
 void RCTProfileSendResult(RCTBridge *bridge, NSString *route, NSData *data)
 {
   if (![bridge.bundleURL.scheme hasPrefix:@"http"]) {
@@ -44,6 +44,33 @@ extern NSString *const RCTContentDidAppearNotification;
                 initialProperties:(NSDictionary *)initialProperties
                     launchOptions:(NSDictionary *)launchOptions;
 
+/**
+ * Starts rendering `moduleName` at the given size before there is anywhere to
+ * show it, e.g. while the app shows a native splash screen. Create the bridge
+ * just as early, it starts loading the bundle in the background right away.
+ *
+ * The next root view initialized with the same bridge, module name and initial
+ * properties is the prewarmed one, with its content already rendered or on the
+ * way, and takes the size of wherever it is added. A prewarmed view that is
+ * never claimed lives as long as the bridge.
+ */
++ (void)prewarmWithBridge:(RCTBridge *)bridge
+               moduleName:(NSString *)moduleName
+        initialProperties:(NSDictionary *)initialProperties
+                     size:(CGSize)size;
+
+/**
+ * Renders, lays out and mounts the content at `size` while the root view is
+ * not in a window, e.g. for a tab or navigation target the user is likely to
+ * open next. UIKit doesn't lay out views outside of a window, so the size is
+ * applied to the content right away instead of on the next layout pass.
+ * Adding the view to a window afterwards shows the content immediately.
+ *
+ * `completion`, if given, is called on the main thread once the content has
+ * first appeared, or right away if it already has.
+ */
+- (void)renderOffscreenWithSize:(CGSize)size completion:(dispatch_block_t)completion;
+
 /**
  * The name of the JavaScript module to execute within the
  * specified scriptURL (required). Setting this will not have
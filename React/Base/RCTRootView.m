@@ -27,6 +27,8 @@
 
 NSString *const RCTContentDidAppearNotification = @"RCTContentDidAppearNotification";
 
+static char RCTPrewarmedRootViewsKey;
+
 @interface RCTBridge (RCTRootView)
 
 @property (nonatomic, weak, readonly) RCTBridge *batchedBridge;
@@ -53,6 +55,7 @@ NSString *const RCTContentDidAppearNotification = @"RCTContentDidAppearNotificat
   NSString *_moduleName;
   NSDictionary *_launchOptions;
   RCTRootContentView *_contentView;
+  NSMutableArray<dispatch_block_t> *_contentDidAppearBlocks;
 }
 
 - (instancetype)initWithBridge:(RCTBridge *)bridge
@@ -63,6 +66,13 @@ NSString *const RCTContentDidAppearNotification = @"RCTContentDidAppearNotificat
   RCTAssert(bridge, @"A bridge instance is required to create an RCTRootView");
   RCTAssert(moduleName, @"A moduleName is required to create an RCTRootView");
 
+  RCTRootView *prewarmedView = [RCTRootView claimPrewarmedRootViewWithBridge:bridge
+                                                                  moduleName:moduleName
+                                                           initialProperties:initialProperties];
+  if (prewarmedView) {
+    return prewarmedView;
+  }
+
   if ((self = [super initWithFrame:CGRectZero])) {
 
     self.backgroundColor = [UIColor whiteColor];
@@ -79,7 +89,7 @@ NSString *const RCTContentDidAppearNotification = @"RCTContentDidAppearNotificat
                                                object:_bridge];
 
     [[NSNotificationCenter defaultCenter] addObserver:self
-                                             selector:@selector(hideLoadingView)
+                                             selector:@selector(contentDidAppear)
                                                  name:RCTContentDidAppearNotification
                                                object:self];
     if (!_bridge.loading) {
@@ -106,6 +116,46 @@ NSString *const RCTContentDidAppearNotification = @"RCTContentDidAppearNotificat
 RCT_NOT_IMPLEMENTED(- (instancetype)initWithFrame:(CGRect)frame)
 RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
 
++ (NSMutableArray<RCTRootView *> *)prewarmedRootViewsForBridge:(RCTBridge *)bridge
+{
+  NSMutableArray<RCTRootView *> *rootViews = objc_getAssociatedObject(bridge, &RCTPrewarmedRootViewsKey);
+  if (!rootViews) {
+    rootViews = [NSMutableArray new];
+    objc_setAssociatedObject(bridge, &RCTPrewarmedRootViewsKey, rootViews, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+  }
+  return rootViews;
+}
+
++ (void)prewarmWithBridge:(RCTBridge *)bridge
+               moduleName:(NSString *)moduleName
+        initialProperties:(NSDictionary *)initialProperties
+                     size:(CGSize)size
+{
+  RCTAssertMainThread();
+
+  // Claims the view if the same component was already prewarmed, which only resizes it
+  RCTRootView *rootView = [[RCTRootView alloc] initWithBridge:bridge
+                                                   moduleName:moduleName
+                                            initialProperties:initialProperties];
+  [rootView renderOffscreenWithSize:size completion:nil];
+  [[self prewarmedRootViewsForBridge:bridge] addObject:rootView];
+}
+
++ (RCTRootView *)claimPrewarmedRootViewWithBridge:(RCTBridge *)bridge
+                                        moduleName:(NSString *)moduleName
+                                 initialProperties:(NSDictionary *)initialProperties
+{
+  NSMutableArray<RCTRootView *> *rootViews = objc_getAssociatedObject(bridge, &RCTPrewarmedRootViewsKey);
+  for (RCTRootView *rootView in rootViews) {
+    if ([rootView.moduleName isEqualToString:moduleName] &&
+        [rootView.initialProperties ?: @{} isEqualToDictionary:initialProperties ?: @{}]) {
+      [rootViews removeObject:rootView];
+      return rootView;
+    }
+  }
+  return nil;
+}
+
 - (void)setBackgroundColor:(UIColor *)backgroundColor
 {
   super.backgroundColor = backgroundColor;
@@ -130,6 +180,37 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
   }
 }
 
+- (void)renderOffscreenWithSize:(CGSize)size completion:(dispatch_block_t)completion
+{
+  RCTAssertMainThread();
+
+  self.frame = (CGRect){self.frame.origin, size};
+  _contentView.frame = self.bounds;
+
+  if (!completion) {
+    return;
+  }
+  if (_contentView.contentHasAppeared) {
+    completion();
+  } else {
+    if (!_contentDidAppearBlocks) {
+      _contentDidAppearBlocks = [NSMutableArray new];
+    }
+    [_contentDidAppearBlocks addObject:[completion copy]];
+  }
+}
+
+- (void)contentDidAppear
+{
+  [self hideLoadingView];
+
+  NSArray<dispatch_block_t> *blocks = _contentDidAppearBlocks;
+  _contentDidAppearBlocks = nil;
+  for (dispatch_block_t block in blocks) {
+    block();
+  }
+}
+
 - (void)showLoadingView
 {
   if (_loadingView && !_contentView.contentHasAppeared) {
@@ -255,6 +336,9 @@ RCT_NOT_IMPLEMENTED(-(instancetype)initWithCoder:(nonnull NSCoder *)aDecoder)
   dispatch_async(dispatch_get_main_queue(), ^{
     if (!_contentHasAppeared) {
       _contentHasAppeared = YES;
+      RCTRootView *rootView = (RCTRootView *)self.superview;
+      NSString *moduleName = [rootView isKindOfClass:[RCTRootView class]] ? rootView.moduleName : nil;
+      RCTPerformanceLoggerMark([@"FirstPaint:" stringByAppendingString:moduleName ?: @""]);
       [[NSNotificationCenter defaultCenter] postNotificationName:RCTContentDidAppearNotification
                                                           object:self.superview];
     }
@@ -269,6 +353,14 @@ RCT_NOT_IMPLEMENTED(-(instancetype)initWithCoder:(nonnull NSCoder *)aDecoder)
   }
 }
 
+- (void)didMoveToWindow
+{
+  [super didMoveToWindow];
+  if (self.reactTag && _bridge.isValid) {
+    [_bridge.uiManager setVisible:(self.window != nil) forRootView:self];
+  }
+}
+
 - (void)setBackgroundColor:(UIColor *)backgroundColor
 {
   _backgroundColor = backgroundColor;
@@ -9,7 +9,31 @@
 
 #import <Foundation/Foundation.h>
 
+/**
+ * React tags are small, mostly dense integers, so objects are stored in pages
+ * of RCTSparseArrayPageSize slots indexed directly by tag. A bitmap per page
+ * tracks which slots are used. Pages are only allocated once something is
+ * stored in them and freed when they empty again. Indexes past
+ * RCTSparseArrayMaxDirectIndex are kept in a dictionary instead.
+ */
+#define RCTSparseArrayPageShift 8
+#define RCTSparseArrayPageSize (1 << RCTSparseArrayPageShift)
+#define RCTSparseArrayPageMask (RCTSparseArrayPageSize - 1)
+#define RCTSparseArrayMaxDirectIndex (1 << 20)
+
+typedef struct {
+  uint64_t bitmap[RCTSparseArrayPageSize / 64];
+  NSUInteger count;
+  const void *objects[RCTSparseArrayPageSize];
+} RCTSparseArrayPage;
+
 @interface RCTSparseArray : NSObject <NSCopying>
+{
+@public
+  // Only exposed for RCTSparseArrayGet, don't use directly
+  RCTSparseArrayPage **_pages;
+  NSUInteger _pageCount;
+}
 
 - (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
 - (instancetype)initWithSparseArray:(RCTSparseArray *)sparseArray NS_DESIGNATED_INITIALIZER;
@@ -30,9 +54,27 @@
 @property (readonly, nonatomic, copy) NSArray *allIndexes;
 @property (readonly, nonatomic, copy) NSArray *allObjects;
 
+// Objects are enumerated in ascending index order, or descending with NSEnumerationReverse.
 - (void)enumerateObjectsUsingBlock:(void (^)(id obj, NSNumber *idx, BOOL *stop))block;
 - (void)enumerateObjectsWithOptions:(NSEnumerationOptions)opts usingBlock:(void (^)(id obj, NSNumber *idx, BOOL *stop))block;
 
 - (void)removeAllObjects;
 
 @end
+
+/**
+ * Same as `sparseArray[idx]`, without a message send, for hot paths such as
+ * tag lookups in RCTUIManager.
+ */
+static inline id RCTSparseArrayGet(RCTSparseArray *sparseArray, NSUInteger idx)
+{
+  if (!sparseArray) {
+    return nil;
+  }
+  if (idx >= RCTSparseArrayMaxDirectIndex) {
+    return [sparseArray objectAtIndexedSubscript:idx];
+  }
+  NSUInteger pageIndex = idx >> RCTSparseArrayPageShift;
+  RCTSparseArrayPage *page = pageIndex < sparseArray->_pageCount ? sparseArray->_pages[pageIndex] : NULL;
+  return page ? (__bridge id)page->objects[idx & RCTSparseArrayPageMask] : nil;
+}
@@ -9,9 +9,12 @@
 
 #import "RCTSparseArray.h"
 
+#define RCTSparseArrayBitmapWords (RCTSparseArrayPageSize / 64)
+
 @implementation RCTSparseArray
 {
-  NSMutableDictionary *_storage;
+  NSUInteger _count;
+  NSMutableDictionary *_overflow;
 }
 
 - (instancetype)init
@@ -22,7 +25,9 @@
 - (instancetype)initWithCapacity:(NSUInteger)capacity
 {
   if ((self = [super init])) {
-    _storage = [NSMutableDictionary dictionaryWithCapacity:capacity];
+    capacity = MIN(capacity, (NSUInteger)RCTSparseArrayMaxDirectIndex);
+    _pageCount = (capacity + RCTSparseArrayPageMask) >> RCTSparseArrayPageShift;
+    _pages = _pageCount ? calloc(_pageCount, sizeof(RCTSparseArrayPage *)) : NULL;
   }
   return self;
 }
@@ -30,11 +35,33 @@
 - (instancetype)initWithSparseArray:(RCTSparseArray *)sparseArray
 {
   if ((self = [super init])) {
-    _storage = [sparseArray->_storage copy];
+    _pageCount = sparseArray->_pageCount;
+    _pages = _pageCount ? calloc(_pageCount, sizeof(RCTSparseArrayPage *)) : NULL;
+    for (NSUInteger pageIndex = 0; pageIndex < _pageCount; pageIndex++) {
+      RCTSparseArrayPage *page = sparseArray->_pages[pageIndex];
+      if (!page) {
+        continue;
+      }
+      _pages[pageIndex] = malloc(sizeof(RCTSparseArrayPage));
+      memcpy(_pages[pageIndex], page, sizeof(RCTSparseArrayPage));
+      for (NSUInteger slot = 0; slot < RCTSparseArrayPageSize; slot++) {
+        if (page->objects[slot]) {
+          CFRetain(page->objects[slot]);
+        }
+      }
+    }
+    _count = sparseArray->_count;
+    _overflow = [sparseArray->_overflow mutableCopy];
   }
   return self;
 }
 
+- (void)dealloc
+{
+  [self removeAllObjects];
+  free(_pages);
+}
+
 + (instancetype)sparseArray
 {
   return [self new];
@@ -52,62 +79,187 @@
 
 - (id)objectAtIndexedSubscript:(NSUInteger)idx
 {
-  return _storage[@(idx)];
+  if (idx >= RCTSparseArrayMaxDirectIndex) {
+    return _overflow[@(idx)];
+  }
+  return RCTSparseArrayGet(self, idx);
 }
 
 - (void)setObject:(id)obj atIndexedSubscript:(NSUInteger)idx
 {
-  self[@(idx)] = obj;
+  if (idx >= RCTSparseArrayMaxDirectIndex) {
+    if (obj) {
+      if (!_overflow) {
+        _overflow = [NSMutableDictionary new];
+      }
+      _overflow[@(idx)] = obj;
+    } else {
+      [_overflow removeObjectForKey:@(idx)];
+    }
+    return;
+  }
+
+  NSUInteger pageIndex = idx >> RCTSparseArrayPageShift;
+  if (pageIndex >= _pageCount) {
+    if (!obj) {
+      return;
+    }
+    NSUInteger pageCount = MAX(pageIndex + 1, _pageCount * 2);
+    _pages = realloc(_pages, pageCount * sizeof(RCTSparseArrayPage *));
+    memset(_pages + _pageCount, 0, (pageCount - _pageCount) * sizeof(RCTSparseArrayPage *));
+    _pageCount = pageCount;
+  }
+
+  RCTSparseArrayPage *page = _pages[pageIndex];
+  if (!page) {
+    if (!obj) {
+      return;
+    }
+    page = _pages[pageIndex] = calloc(1, sizeof(RCTSparseArrayPage));
+  }
+
+  NSUInteger slot = idx & RCTSparseArrayPageMask;
+  uint64_t bit = 1ULL << (slot & 63);
+  const void *oldObject = page->objects[slot];
+  if (obj) {
+    page->objects[slot] = CFBridgingRetain(obj);
+    if (!oldObject) {
+      page->bitmap[slot >> 6] |= bit;
+      page->count++;
+      _count++;
+    }
+  } else if (oldObject) {
+    page->objects[slot] = NULL;
+    page->bitmap[slot >> 6] &= ~bit;
+    page->count--;
+    _count--;
+    if (page->count == 0) {
+      _pages[pageIndex] = NULL;
+      free(page);
+    }
+  }
+  if (oldObject) {
+    CFRelease(oldObject);
+  }
 }
 
 - (id)objectForKeyedSubscript:(NSNumber *)key
 {
-  return _storage[key];
+  return self[key.unsignedIntegerValue];
 }
 
 - (void)setObject:(id)obj forKeyedSubscript:(NSNumber *)key
 {
-  if (obj) {
-    _storage[key] = obj;
-  } else {
-    [_storage removeObjectForKey:key];
-  }
+  self[key.unsignedIntegerValue] = obj;
 }
 
 - (NSUInteger)count
 {
-  return _storage.count;
+  return _count + _overflow.count;
 }
 
 - (NSArray *)allIndexes
 {
-  return _storage.allKeys;
+  NSMutableArray *indexes = [NSMutableArray arrayWithCapacity:self.count];
+  [self enumerateObjectsUsingBlock:^(__unused id obj, NSNumber *idx, __unused BOOL *stop) {
+    [indexes addObject:idx];
+  }];
+  return indexes;
 }
 
 - (NSArray *)allObjects
 {
-  return _storage.allValues;
+  NSMutableArray *objects = [NSMutableArray arrayWithCapacity:self.count];
+  [self enumerateObjectsUsingBlock:^(id obj, __unused NSNumber *idx, __unused BOOL *stop) {
+    [objects addObject:obj];
+  }];
+  return objects;
 }
 
 - (void)enumerateObjectsUsingBlock:(void (^)(id obj, NSNumber *idx, BOOL *stop))block
 {
-  NSParameterAssert(block != nil);
-  [_storage enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, id obj, BOOL *stop) {
-    block(obj, key, stop);
-  }];
+  [self enumerateObjectsWithOptions:0 usingBlock:block];
 }
 
+/**
+ * The block may modify the array. Pages are looked up again after every call,
+ * so objects removed meanwhile are skipped.
+ */
 - (void)enumerateObjectsWithOptions:(NSEnumerationOptions)opts usingBlock:(void (^)(id obj, NSNumber *idx, BOOL *stop))block
 {
   NSParameterAssert(block != nil);
-  [_storage enumerateKeysAndObjectsWithOptions:opts usingBlock:^(NSNumber *key, id obj, BOOL *stop) {
-    block(obj, key, stop);
-  }];
+
+  BOOL reverse = (opts & NSEnumerationReverse) != 0;
+  BOOL stop = NO;
+
+  NSArray *overflowIndexes = [_overflow.allKeys sortedArrayUsingSelector:@selector(compare:)];
+  if (reverse) {
+    for (NSNumber *idx in overflowIndexes.reverseObjectEnumerator) {
+      id obj = _overflow[idx];
+      if (obj) {
+        block(obj, idx, &stop);
+        if (stop) {
+          return;
+        }
+      }
+    }
+  }
+
+  NSUInteger pageCount = _pageCount;
+  for (NSUInteger i = 0; i < pageCount; i++) {
+    NSUInteger pageIndex = reverse ? pageCount - 1 - i : i;
+    for (NSUInteger j = 0; j < RCTSparseArrayBitmapWords; j++) {
+      NSUInteger word = reverse ? RCTSparseArrayBitmapWords - 1 - j : j;
+      RCTSparseArrayPage *page = pageIndex < _pageCount ? _pages[pageIndex] : NULL;
+      uint64_t bits = page ? page->bitmap[word] : 0;
+      while (bits) {
+        NSUInteger bit = reverse ? 63 - __builtin_clzll(bits) : __builtin_ctzll(bits);
+        bits &= ~(1ULL << bit);
+
+        page = pageIndex < _pageCount ? _pages[pageIndex] : NULL;
+        if (!page || !(page->bitmap[word] & (1ULL << bit))) {
+          continue;
+        }
+        NSUInteger idx = (pageIndex << RCTSparseArrayPageShift) | (word << 6) | bit;
+        id obj = (__bridge id)page->objects[idx & RCTSparseArrayPageMask];
+        block(obj, @(idx), &stop);
+        if (stop) {
+          return;
+        }
+      }
+    }
+  }
+
+  if (!reverse) {
+    for (NSNumber *idx in overflowIndexes) {
+      id obj = _overflow[idx];
+      if (obj) {
+        block(obj, idx, &stop);
+        if (stop) {
+          return;
+        }
+      }
+    }
+  }
 }
 
 - (void)removeAllObjects
 {
-  [_storage removeAllObjects];
+  for (NSUInteger pageIndex = 0; pageIndex < _pageCount; pageIndex++) {
+    RCTSparseArrayPage *page = _pages[pageIndex];
+    if (!page) {
+      continue;
+    }
+    _pages[pageIndex] = NULL;
+    for (NSUInteger slot = 0; slot < RCTSparseArrayPageSize; slot++) {
+      if (page->objects[slot]) {
+        CFRelease(page->objects[slot]);
+      }
+    }
+    free(page);
+  }
+  _count = 0;
+  [_overflow removeAllObjects];
 }
 
 - (id)copyWithZone:(NSZone *)zone
@@ -117,7 +269,11 @@
 
 - (NSString *)description
 {
-  return [super.description stringByAppendingString:_storage.description];
+  NSMutableDictionary *storage = [NSMutableDictionary dictionaryWithCapacity:self.count];
+  [self enumerateObjectsUsingBlock:^(id obj, NSNumber *idx, __unused BOOL *stop) {
+    storage[idx] = obj;
+  }];
+  return [super.description stringByAppendingString:storage.description];
 }
 
 @end
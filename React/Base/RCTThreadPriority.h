@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "RCTBridgeModule.h"
+
+/**
+ * The threads a bridge runs its own work on, besides the modules' queues.
+ */
+typedef NS_ENUM(NSInteger, RCTBridgeThread) {
+  RCTBridgeThreadJavaScript = 0,
+  RCTBridgeThreadShadow,
+};
+
+/**
+ * The priority a bridge thread runs at while nobody interacts with the app.
+ * Takes effect for bridges created afterwards. The JavaScript thread defaults
+ * to RCTMethodQueuePriorityDefault, the shadow queue to
+ * RCTMethodQueuePriorityUserInteractive.
+ */
+RCT_EXTERN void RCTSetBridgeThreadPriority(RCTBridgeThread thread, RCTMethodQueuePriority priority);
+RCT_EXTERN RCTMethodQueuePriority RCTBridgeThreadPriority(RCTBridgeThread thread);
+
+/**
+ * Applies the priority to a thread that hasn't been started yet, as a QoS
+ * class where available.
+ */
+RCT_EXTERN void RCTSetThreadPriority(NSThread *thread, RCTMethodQueuePriority priority);
+
+/**
+ * While at least one interaction is in progress, such as a touch, a scroll or
+ * an animation driven by frame timers, the registered threads and queues run
+ * at user-interactive priority. Every begin must be balanced by an end. Can be
+ * called from any thread.
+ */
+RCT_EXTERN void RCTBeginInteraction(void);
+RCT_EXTERN void RCTEndInteraction(void);
+
+/**
+ * Registers the calling thread to be boosted during interactions, and
+ * unregisters it again. Needs QoS overrides, so does nothing on iOS 7.
+ */
+RCT_EXTERN void RCTRegisterInteractiveThread(void);
+RCT_EXTERN void RCTUnregisterInteractiveThread(void);
+
+/**
+ * Targets the queue at the global queue for the priority, and at the
+ * user-interactive one during interactions, until it is unregistered.
+ */
+RCT_EXTERN void RCTRegisterInteractiveQueue(dispatch_queue_t queue, RCTMethodQueuePriority priority);
+RCT_EXTERN void RCTUnregisterInteractiveQueue(dispatch_queue_t queue);
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTThreadPriority.h"
+
+#import <pthread.h>
+#import <pthread/qos.h>
+
+#import "RCTAssert.h"
+#import "RCTModuleData.h"
+
+static RCTMethodQueuePriority RCTBridgeThreadPriorities[] = {
+  [RCTBridgeThreadJavaScript] = RCTMethodQueuePriorityDefault,
+  [RCTBridgeThreadShadow] = RCTMethodQueuePriorityUserInteractive,
+};
+
+static BOOL RCTIsBridgeThread(RCTBridgeThread thread)
+{
+  return thread >= RCTBridgeThreadJavaScript && thread <= RCTBridgeThreadShadow;
+}
+
+void RCTSetBridgeThreadPriority(RCTBridgeThread thread, RCTMethodQueuePriority priority)
+{
+  RCTAssert(RCTIsBridgeThread(thread), @"Unknown bridge thread %zd", thread);
+  if (RCTIsBridgeThread(thread)) {
+    RCTBridgeThreadPriorities[thread] = priority;
+  }
+}
+
+RCTMethodQueuePriority RCTBridgeThreadPriority(RCTBridgeThread thread)
+{
+  return RCTIsBridgeThread(thread) ? RCTBridgeThreadPriorities[thread] : RCTMethodQueuePriorityDefault;
+}
+
+void RCTSetThreadPriority(NSThread *thread, RCTMethodQueuePriority priority)
+{
+  if ([thread respondsToSelector:@selector(setQualityOfService:)]) {
+    switch (priority) {
+      case RCTMethodQueuePriorityUserInteractive:
+        thread.qualityOfService = NSQualityOfServiceUserInteractive;
+        break;
+      case RCTMethodQueuePriorityUtility:
+        thread.qualityOfService = NSQualityOfServiceUtility;
+        break;
+      case RCTMethodQueuePriorityBackground:
+        thread.qualityOfService = NSQualityOfServiceBackground;
+        break;
+      case RCTMethodQueuePriorityDefault:
+      default:
+        thread.qualityOfService = NSQualityOfServiceDefault;
+        break;
+    }
+    return;
+  }
+
+  switch (priority) {
+    case RCTMethodQueuePriorityUserInteractive:
+      thread.threadPriority = 1.0;
+      break;
+    case RCTMethodQueuePriorityUtility:
+      thread.threadPriority = 0.25;
+      break;
+    case RCTMethodQueuePriorityBackground:
+      thread.threadPriority = 0.0;
+      break;
+    case RCTMethodQueuePriorityDefault:
+    default:
+      thread.threadPriority = [NSThread mainThread].threadPriority;
+      break;
+  }
+}
+
+@interface RCTInteractiveThread : NSObject
+{
+@public
+  pthread_t _thread;
+  pthread_override_t _override;
+}
+
+@end
+
+@implementation RCTInteractiveThread
+
+@end
+
+static pthread_mutex_t RCTInteractionLock = PTHREAD_MUTEX_INITIALIZER;
+static NSUInteger RCTInteractionCount;
+static NSMutableArray *RCTInteractiveThreads;
+static NSMapTable *RCTInteractiveQueuePriorities;
+
+static BOOL RCTCanOverrideThreadPriority(void)
+{
+  return &pthread_override_qos_class_start_np != NULL;
+}
+
+/**
+ * Only called with RCTInteractionLock held.
+ */
+static void RCTBoostThread(RCTInteractiveThread *thread, BOOL boost)
+{
+  if (boost && !thread->_override) {
+    thread->_override = pthread_override_qos_class_start_np(thread->_thread, QOS_CLASS_USER_INTERACTIVE, 0);
+  } else if (!boost && thread->_override) {
+    pthread_override_qos_class_end_np(thread->_override);
+    thread->_override = NULL;
+  }
+}
+
+static void RCTBoostQueue(dispatch_queue_t queue, RCTMethodQueuePriority priority, BOOL boost)
+{
+  if (boost) {
+    priority = RCTMethodQueuePriorityUserInteractive;
+  }
+  dispatch_set_target_queue(queue, RCTGlobalQueueForMethodQueuePriority(priority));
+}
+
+static void RCTBoostAll(BOOL boost)
+{
+  for (RCTInteractiveThread *thread in RCTInteractiveThreads) {
+    RCTBoostThread(thread, boost);
+  }
+  for (dispatch_queue_t queue in RCTInteractiveQueuePriorities) {
+    RCTMethodQueuePriority priority = [[RCTInteractiveQueuePriorities objectForKey:queue] integerValue];
+    RCTBoostQueue(queue, priority, boost);
+  }
+}
+
+void RCTBeginInteraction(void)
+{
+  pthread_mutex_lock(&RCTInteractionLock);
+  if (RCTInteractionCount++ == 0) {
+    RCTBoostAll(YES);
+  }
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
+
+void RCTEndInteraction(void)
+{
+  pthread_mutex_lock(&RCTInteractionLock);
+  RCTAssert(RCTInteractionCount > 0, @"RCTEndInteraction() called without RCTBeginInteraction()");
+  if (RCTInteractionCount > 0 && --RCTInteractionCount == 0) {
+    RCTBoostAll(NO);
+  }
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
+
+void RCTRegisterInteractiveThread(void)
+{
+  if (!RCTCanOverrideThreadPriority()) {
+    return;
+  }
+
+  RCTInteractiveThread *thread = [RCTInteractiveThread new];
+  thread->_thread = pthread_self();
+
+  pthread_mutex_lock(&RCTInteractionLock);
+  if (!RCTInteractiveThreads) {
+    RCTInteractiveThreads = [NSMutableArray new];
+  }
+  [RCTInteractiveThreads addObject:thread];
+  RCTBoostThread(thread, RCTInteractionCount > 0);
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
+
+void RCTUnregisterInteractiveThread(void)
+{
+  if (!RCTCanOverrideThreadPriority()) {
+    return;
+  }
+
+  pthread_t self = pthread_self();
+  pthread_mutex_lock(&RCTInteractionLock);
+  for (RCTInteractiveThread *thread in RCTInteractiveThreads) {
+    if (pthread_equal(thread->_thread, self)) {
+      RCTBoostThread(thread, NO);
+      [RCTInteractiveThreads removeObject:thread];
+      break;
+    }
+  }
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
+
+void RCTRegisterInteractiveQueue(dispatch_queue_t queue, RCTMethodQueuePriority priority)
+{
+  pthread_mutex_lock(&RCTInteractionLock);
+  if (!RCTInteractiveQueuePriorities) {
+    RCTInteractiveQueuePriorities = [NSMapTable strongToStrongObjectsMapTable];
+  }
+  [RCTInteractiveQueuePriorities setObject:@(priority) forKey:queue];
+  RCTBoostQueue(queue, priority, RCTInteractionCount > 0);
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
+
+void RCTUnregisterInteractiveQueue(dispatch_queue_t queue)
+{
+  pthread_mutex_lock(&RCTInteractionLock);
+  NSNumber *priority = [RCTInteractiveQueuePriorities objectForKey:queue];
+  if (priority) {
+    RCTBoostQueue(queue, priority.integerValue, NO);
+    [RCTInteractiveQueuePriorities removeObjectForKey:queue];
+  }
+  pthread_mutex_unlock(&RCTInteractionLock);
+}
@@ -15,10 +15,120 @@
 #import "RCTBridge.h"
 #import "RCTEventDispatcher.h"
 #import "RCTLog.h"
+#import "RCTThreadPriority.h"
 #import "RCTUIManager.h"
 #import "RCTUtils.h"
 #import "UIView+React.h"
 
+// This is the maximum supported by iDevices
+static const NSUInteger RCTMaxTouches = 11;
+
+/**
+ * The fields of a touch, in the order they're sent to JS. Each touch takes
+ * RCTTouchFieldCount consecutive numbers of the payload, which
+ * ReactNativeEventEmitter.receiveCompactTouches turns back into objects.
+ */
+typedef NS_ENUM(NSUInteger, RCTTouchField) {
+  RCTTouchFieldTarget,
+  RCTTouchFieldIdentifier,
+  RCTTouchFieldPageX,
+  RCTTouchFieldPageY,
+  RCTTouchFieldLocationX,
+  RCTTouchFieldLocationY,
+  RCTTouchFieldTimestamp,
+  RCTTouchFieldCount
+};
+
+typedef struct {
+  NSInteger target;
+  NSInteger identifier;
+  CGPoint pageLocation;
+  CGPoint location;
+  CFTimeInterval timestamp;
+} RCTTouchRecord;
+
+/**
+ * A touch event whose payload is a flat array of numbers. Moves are coalesced
+ * by the event dispatcher until the next frame, keeping the latest positions
+ * and every touch that moved in between.
+ */
+@interface RCTTouchEvent : NSObject <RCTEvent>
+
+- (instancetype)initWithEventName:(NSString *)eventName
+                    coalescingKey:(uint16_t)coalescingKey
+                          touches:(NSArray *)touches
+                   changedIndexes:(NSIndexSet *)changedIndexes NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation RCTTouchEvent
+{
+  NSArray *_touches;
+  NSIndexSet *_changedIndexes;
+}
+
+@synthesize eventName = _eventName;
+@synthesize coalescingKey = _coalescingKey;
+
+- (instancetype)initWithEventName:(NSString *)eventName
+                    coalescingKey:(uint16_t)coalescingKey
+                          touches:(NSArray *)touches
+                   changedIndexes:(NSIndexSet *)changedIndexes
+{
+  if ((self = [super init])) {
+    _eventName = [eventName copy];
+    _coalescingKey = coalescingKey;
+    _touches = touches;
+    _changedIndexes = changedIndexes;
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (NSNumber *)viewTag
+{
+  return nil;
+}
+
+- (NSDictionary *)body
+{
+  return nil;
+}
+
+- (BOOL)canCoalesce
+{
+  return [_eventName isEqualToString:@"topTouchMove"];
+}
+
+- (id<RCTEvent>)coalesceWithEvent:(RCTTouchEvent *)newEvent
+{
+  // Touches can't be added or removed between two moves, as starts and ends
+  // flush the queue, so the indexes of both events refer to the same touches
+  NSMutableIndexSet *changedIndexes = [_changedIndexes mutableCopy];
+  [changedIndexes addIndexes:newEvent->_changedIndexes];
+  return [[RCTTouchEvent alloc] initWithEventName:_eventName
+                                    coalescingKey:_coalescingKey
+                                          touches:newEvent->_touches
+                                   changedIndexes:changedIndexes];
+}
+
+- (NSArray *)arguments
+{
+  NSMutableArray *changedIndexes = [[NSMutableArray alloc] initWithCapacity:_changedIndexes.count];
+  [_changedIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, __unused BOOL *stop) {
+    [changedIndexes addObject:@(idx)];
+  }];
+  return @[_eventName, _touches, changedIndexes];
+}
+
++ (NSString *)moduleDotMethod
+{
+  return @"RCTEventEmitter.receiveCompactTouches";
+}
+
+@end
+
 // TODO: this class behaves a lot like a module, and could be implemented as a
 // module if we were to assume that modules and RootViews had a 1:1 relationship
 @implementation RCTTouchHandler
@@ -26,16 +136,20 @@
   __weak RCTBridge *_bridge;
 
   /**
-   * Arrays managed in parallel tracking native touch object along with the
-   * native view that was touched, and the React touch data dictionary.
-   * These must be kept track of because `UIKit` destroys the touch targets
-   * if touches are canceled, and we have no other way to recover this info.
+   * Managed in parallel tracking native touch object along with the native
+   * view that was touched, and the React touch data. These must be kept
+   * track of because `UIKit` destroys the touch targets if touches are
+   * canceled, and we have no other way to recover this info.
    */
   NSMutableOrderedSet *_nativeTouches;
-  NSMutableArray *_reactTouches;
+  RCTTouchRecord _reactTouches[RCTMaxTouches];
   NSMutableArray *_touchViews;
 
+  // Keeps the moves of different root views from being coalesced together
+  uint16_t _coalescingKey;
+
   BOOL _dispatchedInitialTouches;
+  BOOL _interacting;
   BOOL _recordingInteractionTiming;
   CFTimeInterval _mostRecentEnqueueJS;
 }
@@ -49,9 +163,11 @@
     _bridge = bridge;
     _dispatchedInitialTouches = NO;
     _nativeTouches = [NSMutableOrderedSet new];
-    _reactTouches = [NSMutableArray new];
     _touchViews = [NSMutableArray new];
 
+    static uint16_t coalescingKey;
+    _coalescingKey = coalescingKey++;
+
     // `cancelsTouchesInView` is needed in order to be used as a top level
     // event delegated recognizer. Otherwise, lower-level components not built
     // using RCT, will fail to recognize gestures.
@@ -62,6 +178,13 @@
 
 RCT_NOT_IMPLEMENTED(- (instancetype)initWithTarget:(id)target action:(SEL)action)
 
+- (void)dealloc
+{
+  if (_interacting) {
+    RCTEndInteraction();
+  }
+}
+
 typedef NS_ENUM(NSInteger, RCTTouchEventType) {
   RCTTouchEventTypeStart,
   RCTTouchEventTypeMove,
@@ -78,6 +201,11 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
     RCTAssert(![_nativeTouches containsObject:touch],
               @"Touch is already recorded. This is a critical bug.");
 
+    const NSUInteger touchCount = _nativeTouches.count;
+    if (touchCount == RCTMaxTouches) {
+      return;
+    }
+
     // Find closest React-managed touchable view
     UIView *targetView = touch.view;
     while (targetView) {
@@ -94,10 +222,9 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
     }
 
     // Get new, unique touch identifier for the react touch
-    const NSUInteger RCTMaxTouches = 11; // This is the maximum supported by iDevices
-    NSInteger touchID = ([_reactTouches.lastObject[@"identifier"] integerValue] + 1) % RCTMaxTouches;
-    for (NSDictionary *reactTouch in _reactTouches) {
-      NSInteger usedID = [reactTouch[@"identifier"] integerValue];
+    NSInteger touchID = touchCount ? (_reactTouches[touchCount - 1].identifier + 1) % RCTMaxTouches : 1;
+    for (NSUInteger i = 0; i < touchCount; i++) {
+      NSInteger usedID = _reactTouches[i].identifier;
       if (usedID == touchID) {
         // ID has already been used, try next value
         touchID ++;
@@ -108,16 +235,14 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
     }
 
     // Create touch
-    NSMutableDictionary *reactTouch = [[NSMutableDictionary alloc] initWithCapacity:9];
-    reactTouch[@"target"] = reactTag;
-    reactTouch[@"identifier"] = @(touchID);
-    reactTouch[@"touches"] = (id)kCFNull;        // We hijack this touchObj to serve both as an event
-    reactTouch[@"changedTouches"] = (id)kCFNull; // and as a Touch object, so making this JIT friendly.
+    _reactTouches[touchCount] = (RCTTouchRecord){
+      .target = reactTag.integerValue,
+      .identifier = touchID,
+    };
 
     // Add to arrays
     [_touchViews addObject:targetView];
     [_nativeTouches addObject:touch];
-    [_reactTouches addObject:reactTouch];
   }
 }
 
@@ -131,7 +256,24 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
 
     [_touchViews removeObjectAtIndex:index];
     [_nativeTouches removeObjectAtIndex:index];
-    [_reactTouches removeObjectAtIndex:index];
+    memmove(&_reactTouches[index], &_reactTouches[index + 1],
+            (_nativeTouches.count - index) * sizeof(RCTTouchRecord));
+  }
+}
+
+/**
+ * The JS and shadow threads are boosted for as long as a finger is down.
+ */
+- (void)_updateInteraction
+{
+  BOOL interacting = _nativeTouches.count > 0;
+  if (interacting != _interacting) {
+    _interacting = interacting;
+    if (interacting) {
+      RCTBeginInteraction();
+    } else {
+      RCTEndInteraction();
+    }
   }
 }
 
@@ -144,12 +286,10 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
   UIView *touchView = _touchViews[touchIndex];
   CGPoint touchViewLocation = [nativeTouch.window convertPoint:windowLocation toView:touchView];
 
-  NSMutableDictionary *reactTouch = _reactTouches[touchIndex];
-  reactTouch[@"pageX"] = @(rootViewLocation.x);
-  reactTouch[@"pageY"] = @(rootViewLocation.y);
-  reactTouch[@"locationX"] = @(touchViewLocation.x);
-  reactTouch[@"locationY"] = @(touchViewLocation.y);
-  reactTouch[@"timestamp"] =  @(nativeTouch.timestamp * 1000); // in ms, for JS
+  RCTTouchRecord *reactTouch = &_reactTouches[touchIndex];
+  reactTouch->pageLocation = rootViewLocation;
+  reactTouch->location = touchViewLocation;
+  reactTouch->timestamp = nativeTouch.timestamp * 1000; // in ms, for JS
 }
 
 /**
@@ -159,16 +299,16 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
  * there must be a simple receiver on the other side of the bridge that
  * organizes the touch objects into `Event`s.
  *
- * We send the data as an array of `Touch`es, the type of action
- * (start/end/move/cancel) and the indices that represent "changed" `Touch`es
- * from that array.
+ * We send the data as a flat array of numbers, RCTTouchFieldCount for each
+ * `Touch`, the type of action (start/end/move/cancel) and the indices that
+ * represent "changed" `Touch`es.
  */
 - (void)_updateAndDispatchTouches:(NSSet *)touches
                         eventName:(NSString *)eventName
-                  originatingTime:(__unused CFTimeInterval)originatingTime
+                  originatingTime:(CFTimeInterval)originatingTime
 {
   // Update touches
-  NSMutableArray *changedIndexes = [NSMutableArray new];
+  NSMutableIndexSet *changedIndexes = [NSMutableIndexSet new];
   for (UITouch *touch in touches) {
     NSInteger index = [_nativeTouches indexOfObject:touch];
     if (index == NSNotFound) {
@@ -176,23 +316,31 @@ typedef NS_ENUM(NSInteger, RCTTouchEventType) {
     }
 
     [self _updateReactTouchAtIndex:index];
-    [changedIndexes addObject:@(index)];
+    [changedIndexes addIndex:index];
   }
 
   if (changedIndexes.count == 0) {
     return;
   }
 
-  // Deep copy the touches because they will be accessed from another thread
-  // TODO: would it be safer to do this in the bridge or executor, rather than trusting caller?
-  NSMutableArray *reactTouches = [[NSMutableArray alloc] initWithCapacity:_reactTouches.count];
-  for (NSDictionary *touch in _reactTouches) {
-    [reactTouches addObject:[touch copy]];
+  const NSUInteger touchCount = _nativeTouches.count;
+  NSMutableArray *reactTouches = [[NSMutableArray alloc] initWithCapacity:touchCount * RCTTouchFieldCount];
+  for (NSUInteger i = 0; i < touchCount; i++) {
+    const RCTTouchRecord touch = _reactTouches[i];
+    [reactTouches addObject:@(touch.target)];
+    [reactTouches addObject:@(touch.identifier)];
+    [reactTouches addObject:@(touch.pageLocation.x)];
+    [reactTouches addObject:@(touch.pageLocation.y)];
+    [reactTouches addObject:@(touch.location.x)];
+    [reactTouches addObject:@(touch.location.y)];
+    [reactTouches addObject:@(touch.timestamp)];
   }
 
-  eventName = RCTNormalizeInputEventName(eventName);
-  [_bridge enqueueJSCall:@"RCTEventEmitter.receiveTouches"
-                    args:@[eventName, reactTouches, changedIndexes]];
+  [_bridge.eventDispatcher sendEvent:[[RCTTouchEvent alloc] initWithEventName:RCTNormalizeInputEventName(eventName)
+                                                                coalescingKey:_coalescingKey
+                                                                      touches:reactTouches
+                                                               changedIndexes:changedIndexes]
+                     originatingTime:originatingTime];
 }
 
 #pragma mark - Gesture Recognizer Delegate Callbacks
@@ -245,6 +393,7 @@ static BOOL RCTAnyTouchesChanged(NSSet *touches)
   // "start" has to record new touches beforeckirjiuhucekbebjditeucultigvijfe extracting the event.
   // "end"/"cancel" needs to remove the touch *after* extracting the event.
   [self _recordNewTouches:touches];
+  [self _updateInteraction];
   if (_dispatchedInitialTouches) {
     [self _updateAndDispatchTouches:touches eventName:@"touchStart" originatingTime:event.timestamp];
     self.state = UIGestureRecognizerStateChanged;
@@ -277,6 +426,7 @@ static BOOL RCTAnyTouchesChanged(NSSet *touches)
     }
   }
   [self _recordRemovedTouches:touches];
+  [self _updateInteraction];
 }
 
 - (void)touchesCancelled:(NSSet *)touches withEvent:(UIEvent *)event
@@ -293,6 +443,7 @@ static BOOL RCTAnyTouchesChanged(NSSet *touches)
     }
   }
   [self _recordRemovedTouches:touches];
+  [self _updateInteraction];
 }
 
 - (BOOL)canPreventGestureRecognizer:(__unused UIGestureRecognizer *)preventedGestureRecognizer
@@ -9,6 +9,7 @@
 
 #import <JavaScriptCore/JavaScriptCore.h>
 
+#import "RCTDefines.h"
 #import "RCTJavaScriptExecutor.h"
 
 // TODO (#5906496): Might RCTJSCoreExecutor be a better name for this?
@@ -25,4 +26,33 @@
 - (instancetype)initWithJavaScriptThread:(NSThread *)javaScriptThread
                         globalContextRef:(JSGlobalContextRef)context NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Hints that JS is idle, e.g. for the rest of a frame, so that garbage is
+ * collected now rather than in the middle of a later call.
+ */
+- (void)collectGarbage;
+
 @end
+
+/**
+ * Largest number of values, counting every array element, dictionary value and
+ * nested container, that executeJSCall converts directly between Foundation
+ * objects and JS values. Bigger payloads go through a JSON string instead, which
+ * is faster once there is enough data to amortize it.
+ */
+RCT_EXTERN const NSUInteger RCTJSDirectConversionMaxValues;
+
+/**
+ * Converts a JSON-compatible Foundation object to a JS value without
+ * serializing it. Returns NULL if it holds something that isn't valid JSON or
+ * more than maxValues values, so the caller can fall back to JSON.
+ */
+RCT_EXTERN JSValueRef RCTJSValueFromJSONObject(JSContextRef context, id object, NSUInteger maxValues);
+
+/**
+ * The reverse, with the same results as JSON.stringify followed by RCTJSONParse
+ * for plain data. Returns nil if the value holds anything other than plain
+ * arrays, objects, strings, numbers, booleans and null, or more than maxValues
+ * values, and sets fallback so the caller can use JSON.
+ */
+RCT_EXTERN id RCTJSONObjectFromJSValue(JSContextRef context, JSValueRef value, NSUInteger maxValues, BOOL *fallback);
@@ -9,17 +9,24 @@
 
 #import "RCTContextExecutor.h"
 
+#import <libkern/OSAtomic.h>
+#import <math.h>
 #import <pthread.h>
 
 #import <JavaScriptCore/JavaScriptCore.h>
+#import <QuartzCore/QuartzCore.h>
 #import <UIKit/UIDevice.h>
 
 #import "RCTAssert.h"
+#import "RCTBridge.h"
 #import "RCTDefines.h"
 #import "RCTDevMenu.h"
+#import "RCTJavaScriptQueue.h"
 #import "RCTLog.h"
+#import "RCTMethodCallBatch.h"
 #import "RCTProfile.h"
 #import "RCTPerformanceLogger.h"
+#import "RCTThreadPriority.h"
 #import "RCTUtils.h"
 
 #ifndef RCT_JSC_PROFILER
@@ -30,8 +37,11 @@
 #endif
 #endif
 
-#if RCT_JSC_PROFILER
+#if RCT_DEV || RCT_JSC_PROFILER
 #include <dlfcn.h>
+#endif
+
+#if RCT_JSC_PROFILER
 
 static NSString * const RCTJSCProfilerEnabledDefaultsKey = @"RCTJSCProfilerEnabled";
 
@@ -46,11 +56,39 @@ static NSString * const RCTJSCProfilerEnabledDefaultsKey = @"RCTJSCProfilerEnabl
 
 - (instancetype)initWithJSContext:(JSGlobalContextRef)context NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Returns the function `method` of the JS module `moduleName`, and the module
+ * itself through `module`. Both are looked up through `require` the first time
+ * and then kept, protected from garbage collection, until the cache is cleared
+ * or the context is invalidated. Returns NULL if either can't be resolved, with
+ * the JS exception thrown, if any, in `exception`.
+ */
+- (JSObjectRef)function:(NSString *)method
+               inModule:(NSString *)moduleName
+                 module:(JSObjectRef *)module
+              exception:(JSValueRef *)exception;
+
+/**
+ * `Function.prototype.apply`, for calling `function:inModule:` results with an
+ * array of arguments.
+ */
+- (JSObjectRef)applyFunctionWithException:(JSValueRef *)exception;
+
+/**
+ * Forgets the functions cached so far, after a script that may have replaced them.
+ */
+- (void)clearCachedFunctions;
+
 @end
 
 @implementation RCTJavaScriptContext
 {
   RCTJavaScriptContext *_self;
+  // JSObjectRefs wrapped in NSValues, keyed by module name, and for functions
+  // by module name then method name
+  NSMutableDictionary *_cachedModules;
+  NSMutableDictionary *_cachedFunctions;
+  JSObjectRef _applyFunction;
 }
 
 - (instancetype)initWithJSContext:(JSGlobalContextRef)context
@@ -69,9 +107,121 @@ RCT_NOT_IMPLEMENTED(-(instancetype)init)
   return _ctx != NULL;
 }
 
+- (JSObjectRef)protectedObjectFromValue:(JSValueRef)value
+{
+  if (!value || !JSValueIsObject(_ctx, value)) {
+    return NULL;
+  }
+  JSObjectRef object = JSValueToObject(_ctx, value, NULL);
+  if (object) {
+    JSValueProtect(_ctx, object);
+  }
+  return object;
+}
+
+- (JSObjectRef)moduleNamed:(NSString *)moduleName exception:(JSValueRef *)exception
+{
+  JSObjectRef module = [_cachedModules[moduleName] pointerValue];
+  if (module) {
+    return module;
+  }
+
+  JSObjectRef globalObject = JSContextGetGlobalObject(_ctx);
+  JSStringRef requireName = JSStringCreateWithUTF8CString("require");
+  JSValueRef requireValue = JSObjectGetProperty(_ctx, globalObject, requireName, exception);
+  JSStringRelease(requireName);
+  if (!requireValue || !JSValueIsObject(_ctx, requireValue) || *exception) {
+    return NULL;
+  }
+
+  JSStringRef moduleNameString = JSStringCreateWithCFString((__bridge CFStringRef)moduleName);
+  JSValueRef moduleNameValue = JSValueMakeString(_ctx, moduleNameString);
+  JSStringRelease(moduleNameString);
+  JSValueRef moduleValue = JSObjectCallAsFunction(_ctx, (JSObjectRef)requireValue, NULL, 1, &moduleNameValue, exception);
+  if (*exception) {
+    return NULL;
+  }
+
+  module = [self protectedObjectFromValue:moduleValue];
+  if (module) {
+    if (!_cachedModules) {
+      _cachedModules = [NSMutableDictionary new];
+    }
+    _cachedModules[moduleName] = [NSValue valueWithPointer:module];
+  }
+  return module;
+}
+
+- (JSObjectRef)function:(NSString *)method
+               inModule:(NSString *)moduleName
+                 module:(JSObjectRef *)module
+              exception:(JSValueRef *)exception
+{
+  *module = [self moduleNamed:moduleName exception:exception];
+  if (!*module) {
+    return NULL;
+  }
+
+  NSMutableDictionary *moduleFunctions = _cachedFunctions[moduleName];
+  JSObjectRef function = [moduleFunctions[method] pointerValue];
+  if (function) {
+    return function;
+  }
+
+  JSStringRef methodName = JSStringCreateWithCFString((__bridge CFStringRef)method);
+  JSValueRef functionValue = JSObjectGetProperty(_ctx, *module, methodName, exception);
+  JSStringRelease(methodName);
+  if (*exception) {
+    return NULL;
+  }
+
+  function = [self protectedObjectFromValue:functionValue];
+  if (function) {
+    if (!moduleFunctions) {
+      if (!_cachedFunctions) {
+        _cachedFunctions = [NSMutableDictionary new];
+      }
+      moduleFunctions = [NSMutableDictionary new];
+      _cachedFunctions[moduleName] = moduleFunctions;
+    }
+    moduleFunctions[method] = [NSValue valueWithPointer:function];
+  }
+  return function;
+}
+
+- (JSObjectRef)applyFunctionWithException:(JSValueRef *)exception
+{
+  if (!_applyFunction) {
+    JSStringRef script = JSStringCreateWithUTF8CString("Function.prototype.apply");
+    JSValueRef applyValue = JSEvaluateScript(_ctx, script, NULL, NULL, 0, exception);
+    JSStringRelease(script);
+    _applyFunction = [self protectedObjectFromValue:applyValue];
+  }
+  return _applyFunction;
+}
+
+- (void)clearCachedFunctions
+{
+  for (NSValue *value in _cachedModules.allValues) {
+    JSValueUnprotect(_ctx, value.pointerValue);
+  }
+  for (NSDictionary *moduleFunctions in _cachedFunctions.allValues) {
+    for (NSValue *value in moduleFunctions.allValues) {
+      JSValueUnprotect(_ctx, value.pointerValue);
+    }
+  }
+  if (_applyFunction) {
+    JSValueUnprotect(_ctx, _applyFunction);
+    _applyFunction = NULL;
+  }
+  [_cachedModules removeAllObjects];
+  [_cachedFunctions removeAllObjects];
+}
+
 - (void)invalidate
 {
   if (self.isValid) {
+    [self clearCachedFunctions];
     JSGlobalContextRelease(_ctx);
     _ctx = NULL;
     _self = nil;
@@ -89,6 +239,11 @@ RCT_NOT_IMPLEMENTED(-(instancetype)init)
 {
   RCTJavaScriptContext *_context;
   NSThread *_javaScriptThread;
+  RCTJavaScriptQueue *_javaScriptQueue;
+
+  // Only accessed on the JS thread
+  CFTimeInterval _lastIdleCollectionTime;
+  double _heapSizeAfterIdleCollection;
 }
 
 @synthesize valid = _valid;
@@ -107,25 +262,34 @@ RCT_EXPORT_MODULE()
 static JSValueRef RCTNativeLoggingHook(JSContextRef context, __unused JSObjectRef object, __unused JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception)
 {
   if (argumentCount > 0) {
+    // Messages below the threshold are dropped before they are even copied
+    RCTLogLevel level = RCTLogLevelInfo;
+    if (argumentCount > 1) {
+      level = MAX(level, JSValueToNumber(context, arguments[1], exception) - 1);
+    }
+    if (level < RCTGetLogThreshold()) {
+      return JSValueMakeUndefined(context);
+    }
+
     JSStringRef messageRef = JSValueToStringCopy(context, arguments[0], exception);
     if (!messageRef) {
       return JSValueMakeUndefined(context);
     }
     NSString *message = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, messageRef);
     JSStringRelease(messageRef);
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:
-                                  @"( stack: )?([_a-z0-9]*)@?(http://|file:///)[a-z.0-9:/_-]+/([a-z0-9_]+).bundle(:[0-9]+:[0-9]+)"
-                                                                           options:NSRegularExpressionCaseInsensitive
-                                                                             error:NULL];
+    static NSRegularExpression *regex;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      regex = [NSRegularExpression regularExpressionWithPattern:
+               @"( stack: )?([_a-z0-9]*)@?(http://|file:///)[a-z.0-9:/_-]+/([a-z0-9_]+).bundle(:[0-9]+:[0-9]+)"
+                                                        options:NSRegularExpressionCaseInsensitive
+                                                          error:NULL];
+    });
     message = [regex stringByReplacingMatchesInString:message
                                               options:0
                                                 range:(NSRange){0, message.length}
                                          withTemplate:@"[$4$5]  \t$2"];
 
-    RCTLogLevel level = RCTLogLevelInfo;
-    if (argumentCount > 1) {
-      level = MAX(level, JSValueToNumber(context, arguments[1], exception) - 1);
-    }
     RCTGetLogFunction()(level, nil, nil, message);
   }
 
@@ -165,6 +329,336 @@ static NSError *RCTNSErrorFromJSError(JSContextRef context, JSValueRef jsError)
   return [NSError errorWithDomain:@"JS" code:1 userInfo:@{NSLocalizedDescriptionKey: errorMessage, NSLocalizedFailureReasonErrorKey: details}];
 }
 
+const NSUInteger RCTJSDirectConversionMaxValues = 512;
+
+static JSStringRef RCTInternedJSString(const char *string, JSStringRef *storage)
+{
+  // Immutable and reference counted, so one copy can be shared by every context and thread
+  if (!*storage) {
+    JSStringRef created = JSStringCreateWithUTF8CString(string);
+    if (!OSAtomicCompareAndSwapPtrBarrier(NULL, (void *)created, (void *volatile *)storage)) {
+      JSStringRelease(created);
+    }
+  }
+  return *storage;
+}
+
+static JSObjectRef RCTJSPrototypeOf(JSContextRef context, const char *constructorName, JSStringRef *nameStorage)
+{
+  static JSStringRef prototypeName;
+  JSObjectRef global = JSContextGetGlobalObject(context);
+  JSValueRef constructor = JSObjectGetProperty(context, global, RCTInternedJSString(constructorName, nameStorage), NULL);
+  if (!constructor || !JSValueIsObject(context, constructor)) {
+    return NULL;
+  }
+  JSValueRef prototype = JSObjectGetProperty(context, (JSObjectRef)constructor, RCTInternedJSString("prototype", &prototypeName), NULL);
+  return prototype && JSValueIsObject(context, prototype) ? (JSObjectRef)prototype : NULL;
+}
+
+static JSValueRef RCTJSValueFromJSONObjectWithBudget(JSContextRef context, id object, NSUInteger *budget)
+{
+  if (*budget == 0) {
+    return NULL;
+  }
+  (*budget)--;
+
+  if ([object isKindOfClass:[NSString class]]) {
+    JSStringRef string = JSStringCreateWithCFString((__bridge CFStringRef)object);
+    JSValueRef value = JSValueMakeString(context, string);
+    JSStringRelease(string);
+    return value;
+  }
+  if ([object isKindOfClass:[NSNumber class]]) {
+    if (CFGetTypeID((__bridge CFTypeRef)object) == CFBooleanGetTypeID()) {
+      return JSValueMakeBoolean(context, [object boolValue]);
+    }
+    double number = [object doubleValue];
+    return isfinite(number) ? JSValueMakeNumber(context, number) : NULL;
+  }
+  if (object == (id)kCFNull) {
+    return JSValueMakeNull(context);
+  }
+  if ([object isKindOfClass:[NSArray class]]) {
+    NSArray *array = object;
+    NSUInteger count = array.count;
+    if (count > *budget) {
+      return NULL;
+    }
+    // On the stack, where the collector can see the elements until the array holds them
+    JSValueRef elements[count > 0 ? count : 1];
+    for (NSUInteger i = 0; i < count; i++) {
+      elements[i] = RCTJSValueFromJSONObjectWithBudget(context, array[i], budget);
+      if (!elements[i]) {
+        return NULL;
+      }
+    }
+    return JSObjectMakeArray(context, count, elements, NULL);
+  }
+  if ([object isKindOfClass:[NSDictionary class]]) {
+    NSDictionary *dictionary = object;
+    if (dictionary.count > *budget) {
+      return NULL;
+    }
+    JSObjectRef jsObject = JSObjectMake(context, NULL, NULL);
+    __block BOOL valid = YES;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id item, BOOL *stop) {
+      JSValueRef value = [key isKindOfClass:[NSString class]] ?
+        RCTJSValueFromJSONObjectWithBudget(context, item, budget) : NULL;
+      if (!value) {
+        valid = NO;
+        *stop = YES;
+        return;
+      }
+      JSStringRef name = JSStringCreateWithCFString((__bridge CFStringRef)key);
+      JSObjectSetProperty(context, jsObject, name, value, kJSPropertyAttributeNone, NULL);
+      JSStringRelease(name);
+    }];
+    return valid ? jsObject : NULL;
+  }
+  return NULL;
+}
+
+JSValueRef RCTJSValueFromJSONObject(JSContextRef context, id object, NSUInteger maxValues)
+{
+  return RCTJSValueFromJSONObjectWithBudget(context, object, &maxValues);
+}
+
+typedef struct {
+  NSUInteger budget;
+  JSObjectRef arrayPrototype;
+  JSObjectRef objectPrototype;
+  BOOL fallback;
+} RCTJSConversionState;
+
+// Returns nil for values that JSON.stringify leaves out of objects, like functions
+static id RCTJSONObjectFromJSValueWithState(JSContextRef context, JSValueRef value, RCTJSConversionState *state)
+{
+  static JSStringRef lengthName, toJSONName, arrayName, objectName;
+
+  if (state->budget == 0) {
+    state->fallback = YES;
+    return nil;
+  }
+  state->budget--;
+
+  switch (JSValueGetType(context, value)) {
+    case kJSTypeUndefined:
+      return nil;
+    case kJSTypeNull:
+      return (id)kCFNull;
+    case kJSTypeBoolean:
+      return JSValueToBoolean(context, value) ? @YES : @NO;
+    case kJSTypeNumber: {
+      double number = JSValueToNumber(context, value, NULL);
+      if (!isfinite(number)) {
+        return (id)kCFNull;
+      }
+      // Like NSJSONSerialization, whole numbers become integers
+      if (number == floor(number) && fabs(number) < 9007199254740992.0) {
+        return @((long long)number);
+      }
+      return @(number);
+    }
+    case kJSTypeString: {
+      JSStringRef string = JSValueToStringCopy(context, value, NULL);
+      NSString *result = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, string);
+      JSStringRelease(string);
+      return result;
+    }
+    case kJSTypeObject:
+      break;
+  }
+
+  JSObjectRef object = (JSObjectRef)value;
+  if (JSObjectIsFunction(context, object)) {
+    return nil;
+  }
+
+  // Anything else, like a Date, or an object with a toJSON method, is left to JSON.stringify
+  JSValueRef prototype = JSObjectGetPrototype(context, object);
+  if (!state->arrayPrototype) {
+    state->arrayPrototype = RCTJSPrototypeOf(context, "Array", &arrayName);
+    state->objectPrototype = RCTJSPrototypeOf(context, "Object", &objectName);
+  }
+
+  if (prototype && state->arrayPrototype && JSValueIsStrictEqual(context, prototype, state->arrayPrototype)) {
+    JSValueRef lengthValue = JSObjectGetProperty(context, object, RCTInternedJSString("length", &lengthName), NULL);
+    double length = lengthValue ? JSValueToNumber(context, lengthValue, NULL) : 0;
+    if (!(length >= 0) || length > state->budget) {
+      state->fallback = YES;
+      return nil;
+    }
+    NSUInteger count = (NSUInteger)length;
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+      JSValueRef element = JSObjectGetPropertyAtIndex(context, object, (unsigned)i, NULL);
+      id item = element ? RCTJSONObjectFromJSValueWithState(context, element, state) : nil;
+      if (state->fallback) {
+        return nil;
+      }
+      // JSON.stringify turns holes, undefined and functions in arrays into null
+      [array addObject:item ?: (id)kCFNull];
+    }
+    return array;
+  }
+
+  if (!prototype || !state->objectPrototype ||
+      !JSValueIsStrictEqual(context, prototype, state->objectPrototype) ||
+      JSObjectHasProperty(context, object, RCTInternedJSString("toJSON", &toJSONName))) {
+    state->fallback = YES;
+    return nil;
+  }
+
+  JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(context, object);
+  size_t count = JSPropertyNameArrayGetCount(names);
+  NSMutableDictionary *dictionary = count > state->budget ? nil :
+    [NSMutableDictionary dictionaryWithCapacity:count];
+  for (size_t i = 0; dictionary && i < count; i++) {
+    JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+    JSValueRef propertyValue = JSObjectGetProperty(context, object, name, NULL);
+    id item = propertyValue ? RCTJSONObjectFromJSValueWithState(context, propertyValue, state) : nil;
+    if (state->fallback) {
+      dictionary = nil;
+      break;
+    }
+    if (item) {
+      NSString *key = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, name);
+      dictionary[key] = item;
+    }
+  }
+  JSPropertyNameArrayRelease(names);
+  if (!dictionary) {
+    state->fallback = YES;
+  }
+  return dictionary;
+}
+
+id RCTJSONObjectFromJSValue(JSContextRef context, JSValueRef value, NSUInteger maxValues, BOOL *fallback)
+{
+  RCTJSConversionState state = {maxValues, NULL, NULL, NO};
+  id result = RCTJSONObjectFromJSValueWithState(context, value, &state);
+  if (fallback) {
+    *fallback = state.fallback;
+  }
+  return state.fallback ? nil : result;
+}
+
+/**
+ * Returns the batch if the string holds one written by encodeBinaryBatch.js,
+ * in which each UTF-16 code unit carries a single byte.
+ */
+static RCTMethodCallBatch *RCTMethodCallBatchFromJSString(JSStringRef string, NSError **error)
+{
+  size_t length = JSStringGetLength(string);
+  const JSChar *chars = JSStringGetCharactersPtr(string);
+  uint8_t firstByte = length ? (uint8_t)chars[0] : 0;
+  if (length == 0 || chars[0] > UINT8_MAX || ![RCTMethodCallBatch isBinaryBatch:&firstByte length:1]) {
+    return nil;
+  }
+
+  uint8_t *bytes = malloc(length);
+  for (size_t i = 0; i < length; i++) {
+    bytes[i] = (uint8_t)chars[i];
+  }
+  RCTMethodCallBatch *batch = [RCTMethodCallBatch batchWithBinaryData:bytes length:length error:error];
+  free(bytes);
+  return batch;
+}
+
+@interface RCTBridge (RCTContextExecutor)
+
+- (id)callSyncNativeModule:(NSUInteger)moduleID
+                    method:(NSUInteger)methodID
+                    params:(NSArray *)params;
+- (NSArray *)configModuleNames;
+- (NSDictionary *)configForModuleName:(NSString *)moduleName;
+
+@end
+
+/**
+ * Backs `nativeCallSyncHook(moduleID, methodID, args)`, which NativeModules
+ * use for methods exported with RCT_EXPORT_SYNC_METHOD. The function's private
+ * data is the executor that installed it.
+ */
+static JSValueRef RCTNativeCallSyncHook(JSContextRef context, JSObjectRef object, __unused JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef *exception)
+{
+  RCTContextExecutor *executor = (__bridge RCTContextExecutor *)JSObjectGetPrivate(object);
+  if (argumentCount < 3 || !executor.isValid) {
+    return JSValueMakeNull(context);
+  }
+
+  NSUInteger moduleID = JSValueToNumber(context, arguments[0], exception);
+  NSUInteger methodID = JSValueToNumber(context, arguments[1], exception);
+  BOOL fallback = NO;
+  id params = RCTJSONObjectFromJSValue(context, arguments[2], RCTJSDirectConversionMaxValues, &fallback);
+  if (fallback) {
+    params = RCTJSONParse(RCTJSValueToJSONString(context, arguments[2], 0), NULL);
+  }
+  if (![params isKindOfClass:[NSArray class]]) {
+    RCTLogError(@"Arguments of sync method %zd of module %zd aren't an array", methodID, moduleID);
+    return JSValueMakeNull(context);
+  }
+
+  id result = [executor.bridge callSyncNativeModule:moduleID method:methodID params:params];
+  if (!result || result == (id)kCFNull) {
+    return JSValueMakeNull(context);
+  }
+  JSValueRef value = RCTJSValueFromJSONObject(context, result, RCTJSDirectConversionMaxValues);
+  if (!value) {
+    NSString *JSONString = RCTJSONStringify(result, NULL);
+    if (JSONString) {
+      JSStringRef JSString = JSStringCreateWithCFString((__bridge CFStringRef)JSONString);
+      value = JSValueMakeFromJSONString(context, JSString);
+      JSStringRelease(JSString);
+    }
+  }
+  return value ?: JSValueMakeNull(context);
+}
+
+/**
+ * Backs `nativeModuleProxy`, whose properties are the native modules' configs.
+ * A config is only built when JS reads it, and JS reads each one once. The
+ * object's private data is the executor that installed it.
+ */
+static JSValueRef RCTNativeModuleProxyGetProperty(JSContextRef context, JSObjectRef object, JSStringRef propertyName, __unused JSValueRef *exception)
+{
+  RCTContextExecutor *executor = (__bridge RCTContextExecutor *)JSObjectGetPrivate(object);
+  if (!executor.isValid) {
+    return NULL;
+  }
+
+  NSString *moduleName = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, propertyName);
+  NSDictionary *config = [executor.bridge configForModuleName:moduleName];
+  if (!config) {
+    // Let JSC look the property up on the prototype
+    return NULL;
+  }
+  JSValueRef value = RCTJSValueFromJSONObject(context, config, RCTJSDirectConversionMaxValues);
+  if (!value) {
+    NSString *JSONString = RCTJSONStringify(config, NULL);
+    if (JSONString) {
+      JSStringRef JSString = JSStringCreateWithCFString((__bridge CFStringRef)JSONString);
+      value = JSValueMakeFromJSONString(context, JSString);
+      JSStringRelease(JSString);
+    }
+  }
+  return value;
+}
+
+static void RCTNativeModuleProxyGetPropertyNames(__unused JSContextRef context, JSObjectRef object, JSPropertyNameAccumulatorRef propertyNames)
+{
+  RCTContextExecutor *executor = (__bridge RCTContextExecutor *)JSObjectGetPrivate(object);
+  if (!executor.isValid) {
+    return;
+  }
+
+  for (NSString *moduleName in [executor.bridge configModuleNames]) {
+    JSStringRef JSName = JSStringCreateWithCFString((__bridge CFStringRef)moduleName);
+    JSPropertyNameAccumulatorAddName(propertyNames, JSName);
+    JSStringRelease(JSName);
+  }
+}
+
 #if RCT_DEV
 
 static JSValueRef RCTNativeTraceBeginSection(JSContextRef context, __unused JSObjectRef object, __unused JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], __unused JSValueRef *exception)
@@ -208,6 +702,71 @@ static JSValueRef RCTNativeTraceEndSection(JSContextRef context, __unused JSObje
   return JSValueMakeUndefined(context);
 }
 
+/**
+ * Returns JSC's heap statistics, or nil. They come from a private function,
+ * which is looked up once and may not exist on every OS version. Reading them
+ * walks the heap, so this is only called while profiling.
+ */
+static NSDictionary *RCTJSHeapStatistics(JSContextRef context, NSArray *keys)
+{
+  typedef JSObjectRef (*RCTGetMemoryUsageStatistics)(JSContextRef);
+  static RCTGetMemoryUsageStatistics getMemoryUsageStatistics;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    getMemoryUsageStatistics = (RCTGetMemoryUsageStatistics)dlsym(RTLD_DEFAULT, "JSGetMemoryUsageStatistics");
+  });
+  if (!getMemoryUsageStatistics) {
+    return nil;
+  }
+
+  JSObjectRef statistics = getMemoryUsageStatistics(context);
+  if (!statistics) {
+    return nil;
+  }
+
+  NSMutableDictionary *values = [NSMutableDictionary new];
+  for (NSString *key in keys) {
+    JSStringRef JSKey = JSStringCreateWithCFString((__bridge CFStringRef)key);
+    JSValueRef value = JSObjectGetProperty(context, statistics, JSKey, NULL);
+    JSStringRelease(JSKey);
+    if (value && JSValueIsNumber(context, value)) {
+      values[key] = @(JSValueToNumber(context, value, NULL));
+    }
+  }
+  return values;
+}
+
+static void RCTSampleJSHeap(JSContextRef context)
+{
+  NSDictionary *values = RCTJSHeapStatistics(context, @[@"heapSize", @"heapCapacity", @"extraMemorySize", @"objectCount"]);
+  if (values) {
+    RCTProfileCounterEvent(0, @"js_heap", values);
+  }
+}
+
+static double RCTJSHeapSize(JSContextRef context)
+{
+  return [RCTJSHeapStatistics(context, @[@"heapSize"])[@"heapSize"] doubleValue];
+}
+
+/**
+ * JSC doesn't report collections, but nothing else makes the heap shrink, so
+ * a call that ends with a smaller heap than it started with had a collection
+ * in it.
+ */
+static void RCTRecordJSHeapChange(double heapSizeBefore, double heapSizeAfter)
+{
+  if (heapSizeAfter <= 0) {
+    return;
+  }
+  RCTProfileCounterEvent(0, @"js_heap", @{@"heapSize": @(heapSizeAfter)});
+  if (heapSizeAfter < heapSizeBefore) {
+    RCTProfileCounterEvent(0, @"js_gc", (@{
+      @"reclaimed": @(heapSizeBefore - heapSizeAfter),
+    }));
+  }
+}
+
 static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
 {
 #if RCT_JSC_PROFILER
@@ -226,19 +785,24 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
         nativeProfilerEnableByteCode();
       }
 
-      [bridge.devMenu addItem:[RCTDevMenuItem toggleItemWithKey:RCTJSCProfilerEnabledDefaultsKey title:@"Start Profiling" selectedTitle:@"Stop Profiling" handler:^(BOOL shouldStart) {
-        if (shouldStart) {
-          nativeProfilerStart(context, "profile");
-        } else {
-          NSString *outputFile = [NSTemporaryDirectory() stringByAppendingPathComponent:@"cpu_profile.json"];
-          nativeProfilerEnd(context, "profile", outputFile.UTF8String);
-          NSData *profileData = [NSData dataWithContentsOfFile:outputFile
-                                                       options:NSDataReadingMappedIfSafe
-                                                         error:NULL];
-
-          RCTProfileSendResult(bridge, @"cpu-profile", profileData);
-        }
-      }]];
+      // The executor is set up while the bridge is still creating the other
+      // modules on the main thread, so only look up the dev menu once that's
+      // done.
+      dispatch_async(dispatch_get_main_queue(), ^{
+        [bridge.devMenu addItem:[RCTDevMenuItem toggleItemWithKey:RCTJSCProfilerEnabledDefaultsKey title:@"Start Profiling" selectedTitle:@"Stop Profiling" handler:^(BOOL shouldStart) {
+          if (shouldStart) {
+            nativeProfilerStart(context, "profile");
+          } else {
+            NSString *outputFile = [NSTemporaryDirectory() stringByAppendingPathComponent:@"cpu_profile.json"];
+            nativeProfilerEnd(context, "profile", outputFile.UTF8String);
+            NSData *profileData = [NSData dataWithContentsOfFile:outputFile
+                                                         options:NSDataReadingMappedIfSafe
+                                                           error:NULL];
+
+            RCTProfileSendResult(bridge, @"cpu-profile", profileData);
+          }
+        }]];
+      });
     }
   }
 #endif
@@ -271,7 +835,7 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
                                                        selector:@selector(runRunLoopThread)
                                                          object:nil];
   javaScriptThread.name = @"com.facebook.React.JavaScript";
-  javaScriptThread.threadPriority = [NSThread mainThread].threadPriority;
+  RCTSetThreadPriority(javaScriptThread, RCTBridgeThreadPriority(RCTBridgeThreadJavaScript));
   [javaScriptThread start];
 
   return [self initWithJavaScriptThread:javaScriptThread globalContextRef:NULL];
@@ -285,9 +849,13 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
 
   if ((self = [super init])) {
     _valid = YES;
+    _lastIdleCollectionTime = CACurrentMediaTime();
     _javaScriptThread = javaScriptThread;
+    _javaScriptQueue = [[RCTJavaScriptQueue alloc] initWithThread:javaScriptThread];
     __weak RCTContextExecutor *weakSelf = self;
     [self executeBlockOnJavaScriptQueue: ^{
+      // Balanced in -invalidate, which runs even if the executor is gone
+      RCTRegisterInteractiveThread();
       RCTContextExecutor *strongSelf = weakSelf;
       if (!strongSelf) {
         return;
@@ -313,11 +881,16 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
       return;
     }
     if (!strongSelf->_context) {
+      RCTPerformanceLoggerBeginSection(@"JSCContextCreate");
       JSGlobalContextRef ctx = JSGlobalContextCreate(NULL);
       strongSelf->_context = [[RCTJavaScriptContext alloc] initWithJSContext:ctx];
+      RCTPerformanceLoggerEndSection();
     }
     [strongSelf _addNativeHook:RCTNativeLoggingHook withName:"nativeLoggingHook"];
     [strongSelf _addNativeHook:RCTNoop withName:"noop"];
+    [strongSelf _addNativeCallSyncHook];
+    [strongSelf _addNativeModuleProxy];
+    [strongSelf _setGlobalFlag:"__fbBatchedBridgeBinaryQueue"];
 #if RCT_DEV
     [strongSelf _addNativeHook:RCTNativeTraceBeginSection withName:"nativeTraceBeginSection"];
     [strongSelf _addNativeHook:RCTNativeTraceEndSection withName:"nativeTraceEndSection"];
@@ -330,10 +903,29 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
                                                    name:event
                                                  object:nil];
     }
+    [[NSNotificationCenter defaultCenter] addObserver:strongSelf
+                                             selector:@selector(sampleProfileCounters)
+                                                 name:RCTProfileWillSampleCounters
+                                               object:nil];
 #endif
   }];
 }
 
+#if RCT_DEV
+
+- (void)sampleProfileCounters
+{
+  __weak RCTContextExecutor *weakSelf = self;
+  [self executeAsyncBlockOnJavaScriptQueue:^{
+    RCTContextExecutor *strongSelf = weakSelf;
+    if (strongSelf.isValid) {
+      RCTSampleJSHeap(strongSelf->_context.ctx);
+    }
+  }];
+}
+
+#endif
+
 - (void)toggleProfilingFlag:(NSNotification *)notification
 {
   JSObjectRef globalObject = JSContextGetGlobalObject(_context.ctx);
@@ -359,6 +951,59 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
 
 }
 
+- (void)_addNativeCallSyncHook
+{
+  static JSClassRef hookClass;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    JSClassDefinition definition = kJSClassDefinitionEmpty;
+    definition.className = "NativeCallSyncHook";
+    definition.callAsFunction = RCTNativeCallSyncHook;
+    hookClass = JSClassCreate(&definition);
+  });
+
+  // The context never outlives the executor, so the hook doesn't retain it
+  JSObjectRef globalObject = JSContextGetGlobalObject(_context.ctx);
+  JSStringRef JSName = JSStringCreateWithUTF8CString("nativeCallSyncHook");
+  JSObjectRef hook = JSObjectMake(_context.ctx, hookClass, (__bridge void *)self);
+  JSObjectSetProperty(_context.ctx, globalObject, JSName, hook, kJSPropertyAttributeNone, NULL);
+  JSStringRelease(JSName);
+}
+
+- (void)_addNativeModuleProxy
+{
+  static JSClassRef proxyClass;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    JSClassDefinition definition = kJSClassDefinitionEmpty;
+    definition.className = "NativeModuleProxy";
+    definition.getProperty = RCTNativeModuleProxyGetProperty;
+    definition.getPropertyNames = RCTNativeModuleProxyGetPropertyNames;
+    proxyClass = JSClassCreate(&definition);
+  });
+
+  // Like the sync hook, the proxy doesn't retain the executor
+  JSObjectRef globalObject = JSContextGetGlobalObject(_context.ctx);
+  JSStringRef JSName = JSStringCreateWithUTF8CString("nativeModuleProxy");
+  JSObjectRef proxy = JSObjectMake(_context.ctx, proxyClass, (__bridge void *)self);
+  JSObjectSetProperty(_context.ctx, globalObject, JSName, proxy, kJSPropertyAttributeNone, NULL);
+  JSStringRelease(JSName);
+}
+
+- (BOOL)providesNativeModuleProxy
+{
+  return YES;
+}
+
+- (void)_setGlobalFlag:(const char *)name
+{
+  JSObjectRef globalObject = JSContextGetGlobalObject(_context.ctx);
+
+  JSStringRef JSName = JSStringCreateWithUTF8CString(name);
+  JSObjectSetProperty(_context.ctx, globalObject, JSName, JSValueMakeBoolean(_context.ctx, true), kJSPropertyAttributeNone, NULL);
+  JSStringRelease(JSName);
+}
+
 - (void)invalidate
 {
   if (!self.isValid) {
@@ -371,10 +1016,13 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
   [[NSNotificationCenter defaultCenter] removeObserver:self];
 #endif
 
-  [_context performSelector:@selector(invalidate)
-                   onThread:_javaScriptThread
-                 withObject:nil
-              waitUntilDone:NO];
+  // After the blocks that are already queued, like before
+  RCTJavaScriptContext *context = _context;
+  [_javaScriptQueue addBlock:^{
+    [context invalidate];
+    RCTUnregisterInteractiveThread();
+  } priority:RCTJavaScriptQueuePriorityDefault];
+  [_javaScriptQueue invalidate];
   _context = nil;
 }
 
@@ -395,94 +1043,109 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
     if (!strongSelf || !strongSelf.isValid) {
       return;
     }
-    NSError *error;
-    NSString *argsString = (arguments.count == 1) ? RCTJSONStringify(arguments[0], &error) : RCTJSONStringify(arguments, &error);
-    if (!argsString) {
-      RCTLogError(@"Cannot convert argument to string: %@", error);
-      onComplete(nil, error);
-      return;
-    }
-
     JSValueRef errorJSRef = NULL;
     JSValueRef resultJSRef = NULL;
     JSGlobalContextRef contextJSRef = JSContextGetGlobalContext(strongSelf->_context.ctx);
-    JSObjectRef globalObjectJSRef = JSContextGetGlobalObject(strongSelf->_context.ctx);
-
-    // get require
-    JSStringRef requireNameJSStringRef = JSStringCreateWithUTF8CString("require");
-    JSValueRef requireJSRef = JSObjectGetProperty(contextJSRef, globalObjectJSRef, requireNameJSStringRef, &errorJSRef);
-    JSStringRelease(requireNameJSStringRef);
 
-    if (requireJSRef != NULL && !JSValueIsUndefined(contextJSRef, requireJSRef) && errorJSRef == NULL) {
-
-      // get module
-      JSStringRef moduleNameJSStringRef = JSStringCreateWithCFString((__bridge CFStringRef)name);
-      JSValueRef moduleNameJSRef = JSValueMakeString(contextJSRef, moduleNameJSStringRef);
-      JSValueRef moduleJSRef = JSObjectCallAsFunction(contextJSRef, (JSObjectRef)requireJSRef, NULL, 1, (const JSValueRef *)&moduleNameJSRef, &errorJSRef);
-      JSStringRelease(moduleNameJSStringRef);
+    // A single argument is passed as is, several as an array for apply. Small
+    // payloads are converted directly, bigger ones through a JSON string.
+    JSValueRef argsJSRef = NULL;
+    if (arguments.count > 0) {
+      id args = (arguments.count == 1) ? arguments[0] : arguments;
+      argsJSRef = RCTJSValueFromJSONObject(contextJSRef, args, RCTJSDirectConversionMaxValues);
+      if (!argsJSRef) {
+        NSError *error;
+        NSString *argsString = RCTJSONStringify(args, &error);
+        if (!argsString) {
+          RCTLogError(@"Cannot convert argument to string: %@", error);
+          onComplete(nil, error);
+          return;
+        }
+        JSStringRef argsJSStringRef = JSStringCreateWithCFString((__bridge CFStringRef)argsString);
+        argsJSRef = JSValueMakeFromJSONString(contextJSRef, argsJSStringRef);
+        JSStringRelease(argsJSStringRef);
+      }
+    }
 
-      if (moduleJSRef != NULL && errorJSRef == NULL && !JSValueIsUndefined(contextJSRef, moduleJSRef)) {
+#if RCT_DEV
+    BOOL trackHeap = RCTProfileIsProfiling();
+    double heapSizeBefore = trackHeap ? RCTJSHeapSize(contextJSRef) : 0;
+#endif
 
-        // get method
-        JSStringRef methodNameJSStringRef = JSStringCreateWithCFString((__bridge CFStringRef)method);
-        JSValueRef methodJSRef = JSObjectGetProperty(contextJSRef, (JSObjectRef)moduleJSRef, methodNameJSStringRef, &errorJSRef);
-        JSStringRelease(methodNameJSStringRef);
+    // The module and method, like BatchedBridge's flush functions, are only
+    // resolved on the first call
+    JSObjectRef moduleJSRef = NULL;
+    JSObjectRef methodJSRef = [strongSelf->_context function:method
+                                                    inModule:name
+                                                      module:&moduleJSRef
+                                                   exception:&errorJSRef];
+    if (methodJSRef) {
+
+      // direct method invoke with no arguments
+      if (arguments.count == 0) {
+        resultJSRef = JSObjectCallAsFunction(contextJSRef, methodJSRef, moduleJSRef, 0, NULL, &errorJSRef);
+      }
 
-        if (methodJSRef != NULL && errorJSRef == NULL) {
+      // direct method invoke with 1 argument
+      else if(arguments.count == 1) {
+        resultJSRef = JSObjectCallAsFunction(contextJSRef, methodJSRef, moduleJSRef, 1, &argsJSRef, &errorJSRef);
 
-          // direct method invoke with no arguments
-          if (arguments.count == 0) {
-            resultJSRef = JSObjectCallAsFunction(contextJSRef, (JSObjectRef)methodJSRef, (JSObjectRef)moduleJSRef, 0, NULL, &errorJSRef);
-          }
+      } else {
+        // apply invoke with array of arguments
+        JSObjectRef applyJSRef = [strongSelf->_context applyFunctionWithException:&errorJSRef];
 
-          // direct method invoke with 1 argument
-          else if(arguments.count == 1) {
-            JSStringRef argsJSStringRef = JSStringCreateWithCFString((__bridge CFStringRef)argsString);
-            JSValueRef argsJSRef = JSValueMakeFromJSONString(contextJSRef, argsJSStringRef);
-            resultJSRef = JSObjectCallAsFunction(contextJSRef, (JSObjectRef)methodJSRef, (JSObjectRef)moduleJSRef, 1, &argsJSRef, &errorJSRef);
-            JSStringRelease(argsJSStringRef);
+        if (applyJSRef != NULL && errorJSRef == NULL) {
+          JSValueRef args[2];
+          args[0] = JSValueMakeNull(contextJSRef);
+          args[1] = argsJSRef;
 
-          } else {
-            // apply invoke with array of arguments
-            JSStringRef applyNameJSStringRef = JSStringCreateWithUTF8CString("apply");
-            JSValueRef applyJSRef = JSObjectGetProperty(contextJSRef, (JSObjectRef)methodJSRef, applyNameJSStringRef, &errorJSRef);
-            JSStringRelease(applyNameJSStringRef);
-
-            if (applyJSRef != NULL && errorJSRef == NULL) {
-              // invoke apply
-              JSStringRef argsJSStringRef = JSStringCreateWithCFString((__bridge CFStringRef)argsString);
-              JSValueRef argsJSRef = JSValueMakeFromJSONString(contextJSRef, argsJSStringRef);
-
-              JSValueRef args[2];
-              args[0] = JSValueMakeNull(contextJSRef);
-              args[1] = argsJSRef;
-
-              resultJSRef = JSObjectCallAsFunction(contextJSRef, (JSObjectRef)applyJSRef, (JSObjectRef)methodJSRef, 2, args, &errorJSRef);
-              JSStringRelease(argsJSStringRef);
-            }
-          }
+          resultJSRef = JSObjectCallAsFunction(contextJSRef, applyJSRef, methodJSRef, 2, args, &errorJSRef);
         }
       }
     }
 
+#if RCT_DEV
+    if (trackHeap) {
+      RCTRecordJSHeapChange(heapSizeBefore, RCTJSHeapSize(contextJSRef));
+    }
+#endif
+
     if (!resultJSRef) {
       onComplete(nil, RCTNSErrorFromJSError(contextJSRef, errorJSRef));
       return;
     }
 
-    // Looks like making lots of JSC API calls is slower than communicating by using a JSON
-    // string. Also it ensures that data stuctures don't have cycles and non-serializable fields.
-    // see [RCTContextExecutorTests testDeserializationPerf]
+    // Small results, like most flushed queues, are read directly. Making a JSC
+    // API call per value gets slower than a JSON string the more values there
+    // are, so anything bigger, or anything JSON.stringify would treat specially,
+    // still goes through JSON. See [RCTContextExecutorTests testConversionPerf]
     id objcValue;
     // We often return `null` from JS when there is nothing for native side. JSONKit takes an extra hundred microseconds
     // to handle this simple case, so we are adding a shortcut to make executeJSCall method even faster
-    if (!JSValueIsNull(contextJSRef, resultJSRef)) {
-      JSStringRef jsJSONString = JSValueCreateJSONString(contextJSRef, resultJSRef, 0, nil);
-      if (jsJSONString) {
-        NSString *objcJSONString = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, jsJSONString);
-        JSStringRelease(jsJSONString);
-
-        objcValue = RCTJSONParse(objcJSONString, NULL);
+    if (JSValueIsString(contextJSRef, resultJSRef)) {
+      // Flushed queues come as a binary batch, which is decoded without JSON
+      JSStringRef resultString = JSValueToStringCopy(contextJSRef, resultJSRef, NULL);
+      NSError *batchError;
+      objcValue = RCTMethodCallBatchFromJSString(resultString, &batchError);
+      if (!objcValue && !batchError) {
+        objcValue = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, resultString);
+      }
+      JSStringRelease(resultString);
+      if (batchError) {
+        onComplete(nil, batchError);
+        return;
+      }
+    } else if (!JSValueIsNull(contextJSRef, resultJSRef) && !JSValueIsUndefined(contextJSRef, resultJSRef)) {
+      BOOL fallback = NO;
+      objcValue = RCTJSONObjectFromJSValue(contextJSRef, resultJSRef, RCTJSDirectConversionMaxValues, &fallback);
+      if (fallback) {
+        JSStringRef jsJSONString = JSValueCreateJSONString(contextJSRef, resultJSRef, 0, nil);
+        if (jsJSONString) {
+          NSString *objcJSONString = (__bridge_transfer NSString *)JSStringCopyCFString(kCFAllocatorDefault, jsJSONString);
+          JSStringRelease(jsJSONString);
+
+          objcValue = RCTJSONParse(objcJSONString, NULL);
+        }
       }
     }
 
@@ -490,6 +1153,55 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
   }), 0, @"js_call", (@{@"module":name, @"method": method, @"args": arguments}))];
 }
 
+- (void)collectGarbage
+{
+  __weak RCTContextExecutor *weakSelf = self;
+  [self executeAsyncBlockOnJavaScriptQueue:RCTProfileBlock((^{
+    RCTContextExecutor *strongSelf = weakSelf;
+    if (strongSelf.isValid) {
+      // Only a hint, JSC collects when it sees fit
+      JSGarbageCollect(strongSelf->_context.ctx);
+    }
+  }), 0, @"js_gc", nil)];
+}
+
+- (void)handleIdle
+{
+  __weak RCTContextExecutor *weakSelf = self;
+  [self executeAsyncBlockOnJavaScriptQueue:^{
+    RCTContextExecutor *strongSelf = weakSelf;
+    if (strongSelf.isValid) {
+      [strongSelf _collectGarbageIfNeeded];
+    }
+  }];
+}
+
+- (void)_collectGarbageIfNeeded
+{
+  RCTBridge *bridge = _bridge;
+  NSTimeInterval interval = bridge.idleGarbageCollectionInterval;
+  CFTimeInterval now = CACurrentMediaTime();
+  if (interval <= 0 || now - _lastIdleCollectionTime < interval) {
+    return;
+  }
+  // Also spaces out the heap size checks, which walk the heap
+  _lastIdleCollectionTime = now;
+
+  JSContextRef contextJSRef = _context.ctx;
+  double heapSize = RCTJSHeapSize(contextJSRef);
+  if (heapSize > 0 && (heapSize < bridge.idleGarbageCollectionMinHeapSize ||
+                       heapSize - _heapSizeAfterIdleCollection < bridge.idleGarbageCollectionHeapGrowth)) {
+    return;
+  }
+
+  RCTProfileBeginEvent(0, @"js_idle_gc", nil);
+  JSGarbageCollect(contextJSRef);
+  if (heapSize > 0) {
+    _heapSizeAfterIdleCollection = RCTJSHeapSize(contextJSRef);
+  }
+  RCTProfileEndEvent(0, @"js_gc", nil);
+}
+
 - (void)executeApplicationScript:(NSString *)script
                        sourceURL:(NSURL *)sourceURL
                       onComplete:(RCTJavaScriptCompleteBlock)onComplete
@@ -505,6 +1217,8 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
     }
 
     RCTPerformanceLoggerStart(RCTPLScriptExecution);
+    // The script may replace modules resolved by earlier calls
+    [strongSelf->_context clearCachedFunctions];
     JSValueRef jsError = NULL;
     JSStringRef execJSString = JSStringCreateWithCFString((__bridge CFStringRef)script);
     JSStringRef jsURL = JSStringCreateWithCFString((__bridge CFStringRef)sourceURL.absoluteString);
@@ -524,10 +1238,15 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
 }
 
 - (void)executeBlockOnJavaScriptQueue:(dispatch_block_t)block
+{
+  [self executeBlockOnJavaScriptQueue:block priority:RCTJavaScriptQueuePriorityDefault];
+}
+
+- (void)executeBlockOnJavaScriptQueue:(dispatch_block_t)block
+                             priority:(RCTJavaScriptQueuePriority)priority
 {
   if ([NSThread currentThread] != _javaScriptThread) {
-    [self performSelector:@selector(executeBlockOnJavaScriptQueue:)
-                 onThread:_javaScriptThread withObject:block waitUntilDone:NO];
+    [_javaScriptQueue addBlock:block priority:priority];
   } else {
     block();
   }
@@ -535,15 +1254,13 @@ static void RCTInstallJSCProfiler(RCTBridge *bridge, JSContextRef context)
 
 - (void)executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block
 {
-  [self performSelector:@selector(executeBlockOnJavaScriptQueue:)
-               onThread:_javaScriptThread
-             withObject:block
-          waitUntilDone:NO];
+  [_javaScriptQueue addBlock:block priority:RCTJavaScriptQueuePriorityDefault];
 }
 
-- (void)_runBlock:(dispatch_block_t)block
+- (void)executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block
+                                  priority:(RCTJavaScriptQueuePriority)priority
 {
-  block();
+  [_javaScriptQueue addBlock:block priority:priority];
 }
 
 - (void)injectJSONText:(NSString *)script
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "RCTJavaScriptExecutor.h"
+
+/**
+ * Runs blocks on the run loop of a thread. Blocks are added to lock-free
+ * lists, one per priority band, and a run loop source drains everything that
+ * was added since it last ran each time it fires, highest band first. Adding
+ * a block to an idle queue wakes the thread up once, no matter how many more
+ * are added before it gets to run them.
+ */
+@interface RCTJavaScriptQueue : NSObject
+
+/**
+ * The thread is expected to run its run loop in the default mode until the
+ * queue is invalidated.
+ */
+- (instancetype)initWithThread:(NSThread *)thread NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, strong, readonly) NSThread *thread;
+
+/**
+ * Can be called from any thread, including the queue's own.
+ */
+- (void)addBlock:(dispatch_block_t)block priority:(RCTJavaScriptQueuePriority)priority;
+
+/**
+ * Detaches the queue from the run loop once the blocks that were added before
+ * have run. Blocks added after that are dropped.
+ */
+- (void)invalidate;
+
+@end
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTJavaScriptQueue.h"
+
+#import <libkern/OSAtomic.h>
+
+#import "RCTAssert.h"
+
+typedef struct RCTJavaScriptQueueNode {
+  struct RCTJavaScriptQueueNode *next;
+  void *block; // retained dispatch_block_t
+} RCTJavaScriptQueueNode;
+
+static void RCTJavaScriptQueuePush(RCTJavaScriptQueueNode *volatile *head, RCTJavaScriptQueueNode *node)
+{
+  do {
+    node->next = *head;
+  } while (!OSAtomicCompareAndSwapPtrBarrier(node->next, node, (void *volatile *)head));
+}
+
+/**
+ * Nodes are only ever pushed, or all taken at once, so there's no ABA problem.
+ * The list is built newest first, it's returned oldest first.
+ */
+static RCTJavaScriptQueueNode *RCTJavaScriptQueueTakeAll(RCTJavaScriptQueueNode *volatile *head)
+{
+  RCTJavaScriptQueueNode *node;
+  do {
+    node = *head;
+  } while (node && !OSAtomicCompareAndSwapPtrBarrier(node, NULL, (void *volatile *)head));
+
+  RCTJavaScriptQueueNode *reversed = NULL;
+  while (node) {
+    RCTJavaScriptQueueNode *next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  return reversed;
+}
+
+static void RCTJavaScriptQueueReleaseAll(RCTJavaScriptQueueNode *node)
+{
+  while (node) {
+    RCTJavaScriptQueueNode *next = node->next;
+    CFRelease(node->block);
+    free(node);
+    node = next;
+  }
+}
+
+@interface RCTJavaScriptQueue ()
+
+- (void)_drain;
+
+@end
+
+static void RCTJavaScriptQueuePerform(void *info)
+{
+  RCTJavaScriptQueue *queue = (__bridge RCTJavaScriptQueue *)info;
+  [queue _drain];
+}
+
+@implementation RCTJavaScriptQueue
+{
+  RCTJavaScriptQueueNode *volatile _heads[RCTJavaScriptQueuePriorityCount];
+  // Set by the first block added since the last drain, which wakes the thread
+  volatile int32_t _signaled;
+  volatile int32_t _invalidated;
+  // Only taken to wake the thread up, and to attach and detach the source
+  NSLock *_sourceLock;
+  CFRunLoopRef _runLoop;
+  CFRunLoopSourceRef _source;
+}
+
+- (instancetype)initWithThread:(NSThread *)thread
+{
+  RCTAssertParam(thread);
+
+  if ((self = [super init])) {
+    _thread = thread;
+    _sourceLock = [NSLock new];
+
+    // The run loop source has to be added from the thread itself. That's the
+    // only time the queue goes through performSelector:onThread:
+    [self performSelector:@selector(_attachToRunLoop)
+                 onThread:thread
+               withObject:nil
+            waitUntilDone:NO];
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (void)dealloc
+{
+  for (NSUInteger i = 0; i < RCTJavaScriptQueuePriorityCount; i++) {
+    RCTJavaScriptQueueReleaseAll(RCTJavaScriptQueueTakeAll(&_heads[i]));
+  }
+}
+
+- (void)_attachToRunLoop
+{
+  // The source keeps the queue alive until it's invalidated
+  CFRunLoopSourceContext context = {
+    0, (__bridge void *)self, CFRetain, CFRelease, NULL, NULL, NULL, NULL, NULL, RCTJavaScriptQueuePerform
+  };
+  CFRunLoopSourceRef source = CFRunLoopSourceCreate(NULL, 0, &context);
+  CFRunLoopAddSource(CFRunLoopGetCurrent(), source, kCFRunLoopDefaultMode);
+
+  [_sourceLock lock];
+  _source = source;
+  _runLoop = CFRunLoopGetCurrent();
+  [_sourceLock unlock];
+
+  // Run the blocks that were added before the run loop was known
+  [self _drain];
+}
+
+- (void)addBlock:(dispatch_block_t)block priority:(RCTJavaScriptQueuePriority)priority
+{
+  RCTAssert(priority < RCTJavaScriptQueuePriorityCount, @"Invalid priority %zd", priority);
+
+  if (_invalidated) {
+    return;
+  }
+
+  [self _pushBlock:block priority:priority];
+}
+
+- (void)_pushBlock:(dispatch_block_t)block priority:(RCTJavaScriptQueuePriority)priority
+{
+  RCTJavaScriptQueueNode *node = malloc(sizeof(RCTJavaScriptQueueNode));
+  node->block = (__bridge_retained void *)[block copy];
+  RCTJavaScriptQueuePush(&_heads[priority], node);
+
+  if (OSAtomicCompareAndSwap32Barrier(0, 1, &_signaled)) {
+    [_sourceLock lock];
+    if (_source) {
+      CFRunLoopSourceSignal(_source);
+      CFRunLoopWakeUp(_runLoop);
+    }
+    [_sourceLock unlock];
+  }
+}
+
+- (void)_drain
+{
+  // Cleared before taking the blocks, so blocks added from here on signal
+  // again. At worst that means one extra wakeup that finds nothing to do.
+  OSAtomicCompareAndSwap32Barrier(1, 0, &_signaled);
+
+  RCTJavaScriptQueueNode *batches[RCTJavaScriptQueuePriorityCount];
+  for (NSUInteger i = 0; i < RCTJavaScriptQueuePriorityCount; i++) {
+    batches[i] = RCTJavaScriptQueueTakeAll(&_heads[i]);
+  }
+
+  for (NSUInteger i = 0; i < RCTJavaScriptQueuePriorityCount; i++) {
+    @autoreleasepool {
+      RCTJavaScriptQueueNode *node = batches[i];
+      while (node) {
+        RCTJavaScriptQueueNode *next = node->next;
+        dispatch_block_t block = (__bridge_transfer dispatch_block_t)node->block;
+        free(node);
+        block();
+        node = next;
+      }
+    }
+  }
+}
+
+- (void)invalidate
+{
+  // Set right away, so addBlock: drops everything from here on
+  if (!OSAtomicCompareAndSwap32Barrier(0, 1, &_invalidated)) {
+    return;
+  }
+
+  // Last in the lowest band, so it runs after every block added before
+  [self _pushBlock:^{
+    [self _detachFromRunLoop];
+  } priority:RCTJavaScriptQueuePriorityDefault];
+}
+
+- (void)_detachFromRunLoop
+{
+  [_sourceLock lock];
+  CFRunLoopSourceInvalidate(_source);
+  CFRelease(_source);
+  _source = NULL;
+  _runLoop = NULL;
+  [_sourceLock unlock];
+
+  // Blocks that raced with invalidate and landed after the last drain would
+  // never run now, so release them rather than keep them until dealloc
+  for (NSUInteger i = 0; i < RCTJavaScriptQueuePriorityCount; i++) {
+    RCTJavaScriptQueueReleaseAll(RCTJavaScriptQueueTakeAll(&_heads[i]));
+  }
+}
+
+@end
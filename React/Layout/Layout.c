@@ -38,8 +38,15 @@ __forceinline const float fmaxf(const float a, const float b) {
   return (a > b) ? a : b;
 }
 #endif
+#define CSS_ALWAYS_INLINE __forceinline
+#else
+#define CSS_ALWAYS_INLINE inline __attribute__((always_inline))
 #endif
 
+// Nodes with up to this many children keep their per-layout bookkeeping on
+// the stack instead of allocating it
+#define CSS_SCRATCH_STACK_CHILDREN 16
+
 bool isUndefined(float value) {
   return isnan(value);
 }
@@ -51,6 +58,81 @@ static bool eq(float a, float b) {
   return fabs(a - b) < 0.0001;
 }
 
+#define CSS_STYLE_EDGES_DEFAULTING_TO_0 0xF
+
+// The values that are 0 when unset, the others are undefined
+static const uint32_t kStyleValuesDefaultingTo0 =
+  (CSS_STYLE_EDGES_DEFAULTING_TO_0 << CSS_STYLE_MARGIN) |
+  (CSS_STYLE_EDGES_DEFAULTING_TO_0 << CSS_STYLE_PADDING) |
+  (CSS_STYLE_EDGES_DEFAULTING_TO_0 << CSS_STYLE_BORDER);
+
+static int countBits(uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(bits);
+#else
+  int count = 0;
+  for (; bits; bits &= bits - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+static bool isStyleDefault(int value, float number) {
+  return (kStyleValuesDefaultingTo0 & (1u << value)) ? number == 0 : isUndefined(number);
+}
+
+float css_style_get(const css_style_t *style, int value) {
+  if (style->overflow_values) {
+    return style->overflow_values[value];
+  }
+  uint32_t bit = 1u << value;
+  if (style->set_values & bit) {
+    return style->inline_values[countBits(style->set_values & (bit - 1))];
+  }
+  return (kStyleValuesDefaultingTo0 & bit) ? 0 : CSS_UNDEFINED;
+}
+
+void css_style_set(css_style_t *style, int value, float number) {
+  if (style->overflow_values) {
+    style->overflow_values[value] = number;
+    return;
+  }
+
+  uint32_t bit = 1u << value;
+  int index = countBits(style->set_values & (bit - 1));
+  int count = countBits(style->set_values);
+  if (style->set_values & bit) {
+    if (isStyleDefault(value, number)) {
+      memmove(
+        &style->inline_values[index],
+        &style->inline_values[index + 1],
+        (count - index - 1) * sizeof(float)
+      );
+      style->set_values &= ~bit;
+    } else {
+      style->inline_values[index] = number;
+    }
+  } else if (!isStyleDefault(value, number)) {
+    if (count == CSS_STYLE_INLINE_VALUES) {
+      float *values = (float *)malloc(CSS_STYLE_VALUE_COUNT * sizeof(float));
+      for (int i = 0; i < CSS_STYLE_VALUE_COUNT; ++i) {
+        values[i] = css_style_get(style, i);
+      }
+      values[value] = number;
+      style->overflow_values = values;
+      return;
+    }
+    memmove(
+      &style->inline_values[index + 1],
+      &style->inline_values[index],
+      (count - index) * sizeof(float)
+    );
+    style->inline_values[index] = number;
+    style->set_values |= bit;
+  }
+}
+
 void init_css_node(css_node_t *node) {
   node->style.align_items = CSS_ALIGN_STRETCH;
   node->style.align_content = CSS_ALIGN_FLEX_START;
@@ -58,30 +140,13 @@ void init_css_node(css_node_t *node) {
   node->style.direction = CSS_DIRECTION_INHERIT;
   node->style.flex_direction = CSS_FLEX_DIRECTION_COLUMN;
 
-  // Some of the fields default to undefined and not 0
-  node->style.dimensions[CSS_WIDTH] = CSS_UNDEFINED;
-  node->style.dimensions[CSS_HEIGHT] = CSS_UNDEFINED;
-
-  node->style.minDimensions[CSS_WIDTH] = CSS_UNDEFINED;
-  node->style.minDimensions[CSS_HEIGHT] = CSS_UNDEFINED;
-
-  node->style.maxDimensions[CSS_WIDTH] = CSS_UNDEFINED;
-  node->style.maxDimensions[CSS_HEIGHT] = CSS_UNDEFINED;
-
-  node->style.position[CSS_LEFT] = CSS_UNDEFINED;
-  node->style.position[CSS_TOP] = CSS_UNDEFINED;
-  node->style.position[CSS_RIGHT] = CSS_UNDEFINED;
-  node->style.position[CSS_BOTTOM] = CSS_UNDEFINED;
-
-  node->style.margin[CSS_START] = CSS_UNDEFINED;
-  node->style.margin[CSS_END] = CSS_UNDEFINED;
-  node->style.padding[CSS_START] = CSS_UNDEFINED;
-  node->style.padding[CSS_END] = CSS_UNDEFINED;
-  node->style.border[CSS_START] = CSS_UNDEFINED;
-  node->style.border[CSS_END] = CSS_UNDEFINED;
+  // Unset values of the style already read as their defaults
+  node->style.set_values = 0;
+  node->style.overflow_values = NULL;
 
   node->layout.dimensions[CSS_WIDTH] = CSS_UNDEFINED;
   node->layout.dimensions[CSS_HEIGHT] = CSS_UNDEFINED;
+  node->layout.baseline = CSS_UNDEFINED;
 
   // Such that the comparison is always going to be false
   node->layout.last_requested_dimensions[CSS_WIDTH] = -1;
@@ -89,6 +154,10 @@ void init_css_node(css_node_t *node) {
   node->layout.last_parent_max_width = -1;
   node->layout.last_direction = (css_direction_t)-1;
   node->layout.should_update = true;
+  node->layout.has_new_layout = true;
+
+  node->layout.cached_measurements_count = 0;
+  node->layout.next_cached_measurement = 0;
 }
 
 css_node_t *new_css_node() {
@@ -98,9 +167,44 @@ css_node_t *new_css_node() {
 }
 
 void free_css_node(css_node_t *node) {
+  free(node->style.overflow_values);
+  free(node->children);
   free(node);
 }
 
+void css_node_insert_child(css_node_t *node, css_node_t *child, int index) {
+  if (node->children_length == node->children_capacity) {
+    int capacity = node->children_capacity ? node->children_capacity * 2 : 4;
+    node->children = (css_node_t **)realloc(node->children, capacity * sizeof(css_node_t *));
+    node->children_capacity = capacity;
+  }
+  memmove(
+    &node->children[index + 1],
+    &node->children[index],
+    (node->children_length - index) * sizeof(css_node_t *)
+  );
+  node->children[index] = child;
+  node->children_length++;
+  node->children_count = node->children_length;
+}
+
+void css_node_remove_child(css_node_t *node, int index) {
+  memmove(
+    &node->children[index],
+    &node->children[index + 1],
+    (node->children_length - index - 1) * sizeof(css_node_t *)
+  );
+  node->children_length--;
+  node->children_count = node->children_length;
+}
+
+static css_node_t *getChild(css_node_t *node, int i) {
+  if (node->children) {
+    return node->children[i];
+  }
+  return node->get_child(node->context, i);
+}
+
 static void indent(int n) {
   for (int i = 0; i < n; ++i) {
     printf("  ");
@@ -119,11 +223,12 @@ static void print_number_nan(const char *str, float number) {
   }
 }
 
-static bool four_equal(float four[4]) {
+static bool four_equal(css_style_t *style, int edges) {
+  float left = css_style_get(style, edges + CSS_LEFT);
   return
-    eq(four[0], four[1]) &&
-    eq(four[0], four[2]) &&
-    eq(four[0], four[3]);
+    eq(left, css_style_get(style, edges + CSS_TOP)) &&
+    eq(left, css_style_get(style, edges + CSS_RIGHT)) &&
+    eq(left, css_style_get(style, edges + CSS_BOTTOM));
 }
 
 
@@ -197,56 +302,56 @@ static void print_css_node_rec(
 
     print_number_nan("flex", node->style.flex);
 
-    if (four_equal(node->style.margin)) {
-      print_number_0("margin", node->style.margin[CSS_LEFT]);
+    if (four_equal(&node->style, CSS_STYLE_MARGIN)) {
+      print_number_0("margin", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_LEFT));
     } else {
-      print_number_0("marginLeft", node->style.margin[CSS_LEFT]);
-      print_number_0("marginRight", node->style.margin[CSS_RIGHT]);
-      print_number_0("marginTop", node->style.margin[CSS_TOP]);
-      print_number_0("marginBottom", node->style.margin[CSS_BOTTOM]);
-      print_number_0("marginStart", node->style.margin[CSS_START]);
-      print_number_0("marginEnd", node->style.margin[CSS_END]);
+      print_number_0("marginLeft", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_LEFT));
+      print_number_0("marginRight", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_RIGHT));
+      print_number_0("marginTop", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_TOP));
+      print_number_0("marginBottom", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_BOTTOM));
+      print_number_0("marginStart", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_START));
+      print_number_0("marginEnd", css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_END));
     }
 
-    if (four_equal(node->style.padding)) {
-      print_number_0("padding", node->style.margin[CSS_LEFT]);
+    if (four_equal(&node->style, CSS_STYLE_PADDING)) {
+      print_number_0("padding", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_LEFT));
     } else {
-      print_number_0("paddingLeft", node->style.padding[CSS_LEFT]);
-      print_number_0("paddingRight", node->style.padding[CSS_RIGHT]);
-      print_number_0("paddingTop", node->style.padding[CSS_TOP]);
-      print_number_0("paddingBottom", node->style.padding[CSS_BOTTOM]);
-      print_number_0("paddingStart", node->style.padding[CSS_START]);
-      print_number_0("paddingEnd", node->style.padding[CSS_END]);
+      print_number_0("paddingLeft", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_LEFT));
+      print_number_0("paddingRight", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_RIGHT));
+      print_number_0("paddingTop", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_TOP));
+      print_number_0("paddingBottom", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_BOTTOM));
+      print_number_0("paddingStart", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_START));
+      print_number_0("paddingEnd", css_style_get(&node->style, CSS_STYLE_PADDING + CSS_END));
     }
 
-    if (four_equal(node->style.border)) {
-      print_number_0("borderWidth", node->style.border[CSS_LEFT]);
+    if (four_equal(&node->style, CSS_STYLE_BORDER)) {
+      print_number_0("borderWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_LEFT));
     } else {
-      print_number_0("borderLeftWidth", node->style.border[CSS_LEFT]);
-      print_number_0("borderRightWidth", node->style.border[CSS_RIGHT]);
-      print_number_0("borderTopWidth", node->style.border[CSS_TOP]);
-      print_number_0("borderBottomWidth", node->style.border[CSS_BOTTOM]);
-      print_number_0("borderStartWidth", node->style.border[CSS_START]);
-      print_number_0("borderEndWidth", node->style.border[CSS_END]);
+      print_number_0("borderLeftWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_LEFT));
+      print_number_0("borderRightWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_RIGHT));
+      print_number_0("borderTopWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_TOP));
+      print_number_0("borderBottomWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_BOTTOM));
+      print_number_0("borderStartWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_START));
+      print_number_0("borderEndWidth", css_style_get(&node->style, CSS_STYLE_BORDER + CSS_END));
     }
 
-    print_number_nan("width", node->style.dimensions[CSS_WIDTH]);
-    print_number_nan("height", node->style.dimensions[CSS_HEIGHT]);
+    print_number_nan("width", css_style_get(&node->style, CSS_STYLE_DIMENSIONS + CSS_WIDTH));
+    print_number_nan("height", css_style_get(&node->style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT));
 
     if (node->style.position_type == CSS_POSITION_ABSOLUTE) {
       printf("position: 'absolute', ");
     }
 
-    print_number_nan("left", node->style.position[CSS_LEFT]);
-    print_number_nan("right", node->style.position[CSS_RIGHT]);
-    print_number_nan("top", node->style.position[CSS_TOP]);
-    print_number_nan("bottom", node->style.position[CSS_BOTTOM]);
+    print_number_nan("left", css_style_get(&node->style, CSS_STYLE_POSITION + CSS_LEFT));
+    print_number_nan("right", css_style_get(&node->style, CSS_STYLE_POSITION + CSS_RIGHT));
+    print_number_nan("top", css_style_get(&node->style, CSS_STYLE_POSITION + CSS_TOP));
+    print_number_nan("bottom", css_style_get(&node->style, CSS_STYLE_POSITION + CSS_BOTTOM));
   }
 
   if (options & CSS_PRINT_CHILDREN && node->children_count > 0) {
     printf("children: [\n");
     for (int i = 0; i < node->children_count; ++i) {
-      print_css_node_rec(node->get_child(node->context, i), options, level + 1);
+      print_css_node_rec(getChild(node, i), options, level + 1);
     }
     indent(level);
     printf("]},\n");
@@ -260,111 +365,132 @@ void print_css_node(css_node_t *node, css_print_options_t options) {
 }
 
 
-static css_position_t leading[4] = {
+static const css_position_t leading[4] = {
   /* CSS_FLEX_DIRECTION_COLUMN = */ CSS_TOP,
   /* CSS_FLEX_DIRECTION_COLUMN_REVERSE = */ CSS_BOTTOM,
   /* CSS_FLEX_DIRECTION_ROW = */ CSS_LEFT,
   /* CSS_FLEX_DIRECTION_ROW_REVERSE = */ CSS_RIGHT
 };
-static css_position_t trailing[4] = {
+static const css_position_t trailing[4] = {
   /* CSS_FLEX_DIRECTION_COLUMN = */ CSS_BOTTOM,
   /* CSS_FLEX_DIRECTION_COLUMN_REVERSE = */ CSS_TOP,
   /* CSS_FLEX_DIRECTION_ROW = */ CSS_RIGHT,
   /* CSS_FLEX_DIRECTION_ROW_REVERSE = */ CSS_LEFT
 };
-static css_position_t pos[4] = {
+static const css_position_t pos[4] = {
   /* CSS_FLEX_DIRECTION_COLUMN = */ CSS_TOP,
   /* CSS_FLEX_DIRECTION_COLUMN_REVERSE = */ CSS_BOTTOM,
   /* CSS_FLEX_DIRECTION_ROW = */ CSS_LEFT,
   /* CSS_FLEX_DIRECTION_ROW_REVERSE = */ CSS_RIGHT
 };
-static css_dimension_t dim[4] = {
+static const css_dimension_t dim[4] = {
   /* CSS_FLEX_DIRECTION_COLUMN = */ CSS_HEIGHT,
   /* CSS_FLEX_DIRECTION_COLUMN_REVERSE = */ CSS_HEIGHT,
   /* CSS_FLEX_DIRECTION_ROW = */ CSS_WIDTH,
   /* CSS_FLEX_DIRECTION_ROW_REVERSE = */ CSS_WIDTH
 };
 
+// The row directions are the ones with this bit set, and the reverse ones
+// have the lowest bit set. An axis built as a constant direction or'ed with a
+// runtime reverse bit is then known to be a row or a column at compile time.
+#define CSS_FLEX_DIRECTION_ROW_BIT 2
+#define CSS_FLEX_DIRECTION_REVERSE_BIT 1
+
 static bool isRowDirection(css_flex_direction_t flex_direction) {
-  return flex_direction == CSS_FLEX_DIRECTION_ROW ||
-         flex_direction == CSS_FLEX_DIRECTION_ROW_REVERSE;
+  return (flex_direction & CSS_FLEX_DIRECTION_ROW_BIT) != 0;
 }
 
 static bool isColumnDirection(css_flex_direction_t flex_direction) {
-  return flex_direction == CSS_FLEX_DIRECTION_COLUMN ||
-         flex_direction == CSS_FLEX_DIRECTION_COLUMN_REVERSE;
+  return (flex_direction & CSS_FLEX_DIRECTION_ROW_BIT) == 0;
 }
 
-static float getLeadingMargin(css_node_t *node, css_flex_direction_t axis) {
-  if (isRowDirection(axis) && !isUndefined(node->style.margin[CSS_START])) {
-    return node->style.margin[CSS_START];
+static float resolveLeadingMargin(css_node_t *node, css_flex_direction_t axis) {
+  float start = css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_START);
+  if (isRowDirection(axis) && !isUndefined(start)) {
+    return start;
   }
 
-  return node->style.margin[leading[axis]];
+  return css_style_get(&node->style, CSS_STYLE_MARGIN + leading[axis]);
 }
 
-static float getTrailingMargin(css_node_t *node, css_flex_direction_t axis) {
-  if (isRowDirection(axis) && !isUndefined(node->style.margin[CSS_END])) {
-    return node->style.margin[CSS_END];
+static float resolveTrailingMargin(css_node_t *node, css_flex_direction_t axis) {
+  float end = css_style_get(&node->style, CSS_STYLE_MARGIN + CSS_END);
+  if (isRowDirection(axis) && !isUndefined(end)) {
+    return end;
   }
 
-  return node->style.margin[trailing[axis]];
+  return css_style_get(&node->style, CSS_STYLE_MARGIN + trailing[axis]);
 }
 
-static float getLeadingPadding(css_node_t *node, css_flex_direction_t axis) {
+static float resolveLeadingPositive(css_style_t *style, int edges, css_flex_direction_t axis) {
+  float start = css_style_get(style, edges + CSS_START);
   if (isRowDirection(axis) &&
-      !isUndefined(node->style.padding[CSS_START]) &&
-      node->style.padding[CSS_START] >= 0) {
-    return node->style.padding[CSS_START];
+      !isUndefined(start) &&
+      start >= 0) {
+    return start;
   }
 
-  if (node->style.padding[leading[axis]] >= 0) {
-    return node->style.padding[leading[axis]];
+  float value = css_style_get(style, edges + leading[axis]);
+  if (value >= 0) {
+    return value;
   }
 
   return 0;
 }
 
-static float getTrailingPadding(css_node_t *node, css_flex_direction_t axis) {
+static float resolveTrailingPositive(css_style_t *style, int edges, css_flex_direction_t axis) {
+  float end = css_style_get(style, edges + CSS_END);
   if (isRowDirection(axis) &&
-      !isUndefined(node->style.padding[CSS_END]) &&
-      node->style.padding[CSS_END] >= 0) {
-    return node->style.padding[CSS_END];
+      !isUndefined(end) &&
+      end >= 0) {
+    return end;
   }
 
-  if (node->style.padding[trailing[axis]] >= 0) {
-    return node->style.padding[trailing[axis]];
+  float value = css_style_get(style, edges + trailing[axis]);
+  if (value >= 0) {
+    return value;
   }
 
   return 0;
 }
 
-static float getLeadingBorder(css_node_t *node, css_flex_direction_t axis) {
-  if (isRowDirection(axis) &&
-      !isUndefined(node->style.border[CSS_START]) &&
-      node->style.border[CSS_START] >= 0) {
-    return node->style.border[CSS_START];
+// Has to run before anything reads the node's edges. A parent resolves its
+// children before it looks at their margins, layoutNode resolves the root.
+static void resolveEdges(css_node_t *node) {
+  css_resolved_edges_t *edges = &node->edges;
+  for (int axis = 0; axis < 4; ++axis) {
+    css_flex_direction_t flex_direction = (css_flex_direction_t)axis;
+    edges->leading_margin[axis] = resolveLeadingMargin(node, flex_direction);
+    edges->trailing_margin[axis] = resolveTrailingMargin(node, flex_direction);
+    edges->leading_padding[axis] = resolveLeadingPositive(&node->style, CSS_STYLE_PADDING, flex_direction);
+    edges->trailing_padding[axis] = resolveTrailingPositive(&node->style, CSS_STYLE_PADDING, flex_direction);
+    edges->leading_border[axis] = resolveLeadingPositive(&node->style, CSS_STYLE_BORDER, flex_direction);
+    edges->trailing_border[axis] = resolveTrailingPositive(&node->style, CSS_STYLE_BORDER, flex_direction);
   }
+}
 
-  if (node->style.border[leading[axis]] >= 0) {
-    return node->style.border[leading[axis]];
-  }
+static float getLeadingMargin(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.leading_margin[axis];
+}
 
-  return 0;
+static float getTrailingMargin(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.trailing_margin[axis];
 }
 
-static float getTrailingBorder(css_node_t *node, css_flex_direction_t axis) {
-  if (isRowDirection(axis) &&
-      !isUndefined(node->style.border[CSS_END]) &&
-      node->style.border[CSS_END] >= 0) {
-    return node->style.border[CSS_END];
-  }
+static float getLeadingPadding(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.leading_padding[axis];
+}
 
-  if (node->style.border[trailing[axis]] >= 0) {
-    return node->style.border[trailing[axis]];
-  }
+static float getTrailingPadding(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.trailing_padding[axis];
+}
 
-  return 0;
+static float getLeadingBorder(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.leading_border[axis];
+}
+
+static float getTrailingBorder(css_node_t *node, css_flex_direction_t axis) {
+  return node->edges.trailing_border[axis];
 }
 
 static float getLeadingPaddingAndBorder(css_node_t *node, css_flex_direction_t axis) {
@@ -389,13 +515,13 @@ static float getPaddingAndBorderAxis(css_node_t *node, css_flex_direction_t axis
 
 static css_align_t getAlignItem(css_node_t *node, css_node_t *child) {
   if (child->style.align_self != CSS_ALIGN_AUTO) {
-    return child->style.align_self;
+    return (css_align_t)child->style.align_self;
   }
-  return node->style.align_items;
+  return (css_align_t)node->style.align_items;
 }
 
 static css_direction_t resolveDirection(css_node_t *node, css_direction_t parentDirection) {
-  css_direction_t direction = node->style.direction;
+  css_direction_t direction = (css_direction_t)node->style.direction;
 
   if (direction == CSS_DIRECTION_INHERIT) {
     direction = parentDirection > CSS_DIRECTION_INHERIT ? parentDirection : CSS_DIRECTION_LTR;
@@ -405,7 +531,7 @@ static css_direction_t resolveDirection(css_node_t *node, css_direction_t parent
 }
 
 static css_flex_direction_t getFlexDirection(css_node_t *node) {
-  return node->style.flex_direction;
+  return (css_flex_direction_t)node->style.flex_direction;
 }
 
 static css_flex_direction_t resolveAxis(css_flex_direction_t flex_direction, css_direction_t direction) {
@@ -420,14 +546,6 @@ static css_flex_direction_t resolveAxis(css_flex_direction_t flex_direction, css
   return flex_direction;
 }
 
-static css_flex_direction_t getCrossFlexDirection(css_flex_direction_t flex_direction, css_direction_t direction) {
-  if (isColumnDirection(flex_direction)) {
-    return resolveAxis(CSS_FLEX_DIRECTION_ROW, direction);
-  } else {
-    return CSS_FLEX_DIRECTION_COLUMN;
-  }
-}
-
 static float getFlex(css_node_t *node) {
   return node->style.flex;
 }
@@ -450,20 +568,20 @@ static float getDimWithMargin(css_node_t *node, css_flex_direction_t axis) {
 }
 
 static bool isDimDefined(css_node_t *node, css_flex_direction_t axis) {
-  float value = node->style.dimensions[dim[axis]];
+  float value = css_style_get(&node->style, CSS_STYLE_DIMENSIONS + dim[axis]);
   return !isUndefined(value) && value > 0.0;
 }
 
 static bool isPosDefined(css_node_t *node, css_position_t position) {
-  return !isUndefined(node->style.position[position]);
+  return !isUndefined(css_style_get(&node->style, CSS_STYLE_POSITION + position));
 }
 
 static bool isMeasureDefined(css_node_t *node) {
-  return node->measure;
+  return node->measure || node->measure_with_mode;
 }
 
 static float getPosition(css_node_t *node, css_position_t position) {
-  float result = node->style.position[position];
+  float result = css_style_get(&node->style, CSS_STYLE_POSITION + position);
   if (!isUndefined(result)) {
     return result;
   }
@@ -475,11 +593,11 @@ static float boundAxis(css_node_t *node, css_flex_direction_t axis, float value)
   float max = CSS_UNDEFINED;
 
   if (isColumnDirection(axis)) {
-    min = node->style.minDimensions[CSS_HEIGHT];
-    max = node->style.maxDimensions[CSS_HEIGHT];
+    min = css_style_get(&node->style, CSS_STYLE_MIN_DIMENSIONS + CSS_HEIGHT);
+    max = css_style_get(&node->style, CSS_STYLE_MAX_DIMENSIONS + CSS_HEIGHT);
   } else if (isRowDirection(axis)) {
-    min = node->style.minDimensions[CSS_WIDTH];
-    max = node->style.maxDimensions[CSS_WIDTH];
+    min = css_style_get(&node->style, CSS_STYLE_MIN_DIMENSIONS + CSS_WIDTH);
+    max = css_style_get(&node->style, CSS_STYLE_MAX_DIMENSIONS + CSS_WIDTH);
   }
 
   float boundValue = value;
@@ -507,7 +625,7 @@ static void setDimensionFromStyle(css_node_t *node, css_flex_direction_t axis) {
 
   // The dimensions can never be smaller than the padding and border
   node->layout.dimensions[dim[axis]] = fmaxf(
-    boundAxis(node, axis, node->style.dimensions[dim[axis]]),
+    boundAxis(node, axis, css_style_get(&node->style, CSS_STYLE_DIMENSIONS + dim[axis])),
     getPaddingAndBorderAxis(node, axis)
   );
 }
@@ -520,18 +638,67 @@ static void setTrailingPosition(css_node_t *node, css_node_t *child, css_flex_di
 // If both left and right are defined, then use left. Otherwise return
 // +left or -right depending on which is defined.
 static float getRelativePosition(css_node_t *node, css_flex_direction_t axis) {
-  float lead = node->style.position[leading[axis]];
+  float lead = css_style_get(&node->style, CSS_STYLE_POSITION + leading[axis]);
   if (!isUndefined(lead)) {
     return lead;
   }
   return -getPosition(node, trailing[axis]);
 }
 
-static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection) {
+static css_measure_result_t measureNode(
+  css_node_t *node,
+  float width,
+  css_measure_mode_t widthMode,
+  float height,
+  css_measure_mode_t heightMode
+) {
+  css_layout_t *layout = &node->layout;
+  for (int i = 0; i < layout->cached_measurements_count; i++) {
+    css_cached_measurement_t *cached = &layout->cached_measurements[i];
+    if (cached->width_mode == widthMode && eq(cached->width, width) &&
+        cached->height_mode == heightMode && eq(cached->height, height)) {
+      return cached->result;
+    }
+  }
+
+  css_measure_result_t result;
+  if (node->measure_with_mode) {
+    result = node->measure_with_mode(node->context, width, widthMode, height, heightMode);
+  } else {
+    css_dim_t dimensions = node->measure(node->context, width);
+    result.dimensions[CSS_WIDTH] = dimensions.dimensions[CSS_WIDTH];
+    result.dimensions[CSS_HEIGHT] = dimensions.dimensions[CSS_HEIGHT];
+    result.baseline = CSS_UNDEFINED;
+  }
+
+  css_cached_measurement_t *entry =
+    &layout->cached_measurements[layout->next_cached_measurement];
+  entry->width = width;
+  entry->width_mode = widthMode;
+  entry->height = height;
+  entry->height_mode = heightMode;
+  entry->result = result;
+  layout->next_cached_measurement =
+    (layout->next_cached_measurement + 1) % CSS_MAX_CACHED_MEASUREMENTS;
+  if (layout->cached_measurements_count < CSS_MAX_CACHED_MEASUREMENTS) {
+    layout->cached_measurements_count++;
+  }
+  return result;
+}
+
+static void layoutNodeWithCache(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection);
+
+// Inlined into layoutNodeImpl once for row and once for column main axes, so
+// that the axis checks and table lookups of both copies become constants
+// except for whether the axes are reversed.
+static CSS_ALWAYS_INLINE void layoutNodeWithAxes(
+  css_node_t *node,
+  float parentMaxWidth,
+  css_direction_t direction,
+  css_flex_direction_t mainAxis,
+  css_flex_direction_t crossAxis
+) {
   /** START_GENERATED **/
-  css_direction_t direction = resolveDirection(node, parentDirection);
-  css_flex_direction_t mainAxis = resolveAxis(getFlexDirection(node), direction);
-  css_flex_direction_t crossAxis = getCrossFlexDirection(mainAxis, direction);
   css_flex_direction_t resolvedRowAxis = resolveAxis(CSS_FLEX_DIRECTION_ROW, direction);
 
   // Handle width and height style attributes
@@ -562,7 +729,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
     float width = CSS_UNDEFINED;
     if (isDimDefined(node, resolvedRowAxis)) {
-      width = node->style.dimensions[CSS_WIDTH];
+      width = css_style_get(&node->style, CSS_STYLE_DIMENSIONS + CSS_WIDTH);
     } else if (isResolvedRowDimDefined) {
       width = node->layout.dimensions[dim[resolvedRowAxis]];
     } else {
@@ -580,11 +747,23 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
     // Let's not measure the text if we already know both dimensions
     if (isRowUndefined || isColumnUndefined) {
-      css_dim_t measureDim = node->measure(
-        node->context,
-        
-        width
-      );
+      css_measure_mode_t widthMode = CSS_MEASURE_MODE_EXACTLY;
+      if (isRowUndefined) {
+        widthMode = isUndefined(width) ? CSS_MEASURE_MODE_UNDEFINED : CSS_MEASURE_MODE_AT_MOST;
+      }
+      float height = CSS_UNDEFINED;
+      css_measure_mode_t heightMode = CSS_MEASURE_MODE_UNDEFINED;
+      if (!isColumnUndefined) {
+        height = isDimDefined(node, CSS_FLEX_DIRECTION_COLUMN) ?
+          css_style_get(&node->style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT) :
+          node->layout.dimensions[CSS_HEIGHT];
+        height -= getPaddingAndBorderAxis(node, CSS_FLEX_DIRECTION_COLUMN);
+        heightMode = CSS_MEASURE_MODE_EXACTLY;
+      }
+
+      css_measure_result_t measureDim = measureNode(node, width, widthMode, height, heightMode);
+      node->layout.baseline = isUndefined(measureDim.baseline) ? CSS_UNDEFINED :
+        measureDim.baseline + getLeadingPaddingAndBorder(node, CSS_FLEX_DIRECTION_COLUMN);
       if (isRowUndefined) {
         node->layout.dimensions[CSS_WIDTH] = measureDim.dimensions[CSS_WIDTH] +
           paddingAndBorderAxisResolvedRow;
@@ -601,7 +780,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
   bool isNodeFlexWrap = isFlexWrap(node);
 
-  css_justify_t justifyContent = node->style.justify_content;
+  css_justify_t justifyContent = (css_justify_t)node->style.justify_content;
 
   float leadingPaddingAndBorderMain = getLeadingPaddingAndBorder(node, mainAxis);
   float leadingPaddingAndBorderCross = getLeadingPaddingAndBorder(node, crossAxis);
@@ -617,8 +796,20 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
   css_node_t* child;
   css_flex_direction_t axis;
 
-  css_node_t* firstAbsoluteChild = NULL;
-  css_node_t* currentAbsoluteChild = NULL;
+  // Which children are absolute, which are flexible on the current line and
+  // which line each child is on are only needed while this node is laid out,
+  // so they are kept here rather than on the children themselves. Small nodes
+  // use the stack, larger ones a heap buffer freed at the end of the call.
+  css_node_t* stackChildren[2 * CSS_SCRATCH_STACK_CHILDREN];
+  int stackLineIndexes[CSS_SCRATCH_STACK_CHILDREN];
+  css_node_t** absoluteChildren = stackChildren;
+  int* lineIndexes = stackLineIndexes;
+  if (childCount > CSS_SCRATCH_STACK_CHILDREN) {
+    absoluteChildren = (css_node_t **)malloc(2 * childCount * sizeof(css_node_t *));
+    lineIndexes = (int *)malloc(childCount * sizeof(int));
+  }
+  css_node_t** flexChildren = absoluteChildren + childCount;
+  int absoluteChildrenCount = 0;
 
   float definedMainDim = CSS_UNDEFINED;
   if (isMainDimDefined) {
@@ -665,19 +856,15 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
     bool isSimpleStackCross = true;
     int firstComplexCross = childCount;
 
-    css_node_t* firstFlexChild = NULL;
-    css_node_t* currentFlexChild = NULL;
+    int flexChildrenCount = 0;
 
     float mainDim = leadingPaddingAndBorderMain;
     float crossDim = 0;
 
     float maxWidth;
     for (i = startLine; i < childCount; ++i) {
-      child = node->get_child(node->context, i);
-      child->line_index = linesCount;
-
-      child->next_absolute_child = NULL;
-      child->next_flex_child = NULL;
+      child = getChild(node, i);
+      lineIndexes[i] = linesCount;
 
       css_align_t alignItem = getAlignItem(node, child);
 
@@ -694,15 +881,13 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
           getPaddingAndBorderAxis(child, crossAxis)
         );
       } else if (child->style.position_type == CSS_POSITION_ABSOLUTE) {
-        // Store a private linked list of absolutely positioned children
-        // so that we can efficiently traverse them later.
-        if (firstAbsoluteChild == NULL) {
-          firstAbsoluteChild = child;
-        }
-        if (currentAbsoluteChild != NULL) {
-          currentAbsoluteChild->next_absolute_child = child;
+        // Store the absolutely positioned children so that we can efficiently
+        // traverse them later. A child that starts a new line is visited
+        // again, but only needs to be stored once.
+        if (absoluteChildrenCount == 0 ||
+            absoluteChildren[absoluteChildrenCount - 1] != child) {
+          absoluteChildren[absoluteChildrenCount++] = child;
         }
-        currentAbsoluteChild = child;
 
         // Pre-fill dimensions when using absolute position and both offsets for the axis are defined (either both
         // left and right or top and bottom).
@@ -733,15 +918,9 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
         flexibleChildrenCount++;
         totalFlexible += child->style.flex;
 
-        // Store a private linked list of flexible children so that we can
+        // Store the flexible children of this line so that we can
         // efficiently traverse them later.
-        if (firstFlexChild == NULL) {
-          firstFlexChild = child;
-        }
-        if (currentFlexChild != NULL) {
-          currentFlexChild->next_flex_child = child;
-        }
-        currentFlexChild = child;
+        flexChildren[flexChildrenCount++] = child;
 
         // Even if we don't know its exact size yet, we already know the padding,
         // border and margin. We'll use this partial information, which represents
@@ -765,7 +944,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
         // This is the main recursive call. We layout non flexible children.
         if (alreadyComputedNextLayout == 0) {
-          layoutNode(child, maxWidth, direction);
+          layoutNodeWithCache(child, maxWidth, direction);
         }
 
         // Absolute positioned elements do not take part of the layout, so we
@@ -856,18 +1035,16 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
       // If the flex share of remaining space doesn't meet min/max bounds,
       // remove this child from flex calculations.
-      currentFlexChild = firstFlexChild;
-      while (currentFlexChild != NULL) {
-        baseMainDim = flexibleMainDim * currentFlexChild->style.flex +
-            getPaddingAndBorderAxis(currentFlexChild, mainAxis);
-        boundMainDim = boundAxis(currentFlexChild, mainAxis, baseMainDim);
+      for (ii = 0; ii < flexChildrenCount; ++ii) {
+        child = flexChildren[ii];
+        baseMainDim = flexibleMainDim * child->style.flex +
+            getPaddingAndBorderAxis(child, mainAxis);
+        boundMainDim = boundAxis(child, mainAxis, baseMainDim);
 
         if (baseMainDim != boundMainDim) {
           remainingMainDim -= boundMainDim;
-          totalFlexible -= currentFlexChild->style.flex;
+          totalFlexible -= child->style.flex;
         }
-
-        currentFlexChild = currentFlexChild->next_flex_child;
       }
       flexibleMainDim = remainingMainDim / totalFlexible;
 
@@ -877,13 +1054,13 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
         flexibleMainDim = 0;
       }
 
-      currentFlexChild = firstFlexChild;
-      while (currentFlexChild != NULL) {
+      for (ii = 0; ii < flexChildrenCount; ++ii) {
+        child = flexChildren[ii];
         // At this point we know the final size of the element in the main
         // dimension
-        currentFlexChild->layout.dimensions[dim[mainAxis]] = boundAxis(currentFlexChild, mainAxis,
-          flexibleMainDim * currentFlexChild->style.flex +
-              getPaddingAndBorderAxis(currentFlexChild, mainAxis)
+        child->layout.dimensions[dim[mainAxis]] = boundAxis(child, mainAxis,
+          flexibleMainDim * child->style.flex +
+              getPaddingAndBorderAxis(child, mainAxis)
         );
 
         maxWidth = CSS_UNDEFINED;
@@ -897,11 +1074,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
         }
 
         // And we recursively call the layout algorithm for this child
-        layoutNode(currentFlexChild, maxWidth, direction);
-
-        child = currentFlexChild;
-        currentFlexChild = currentFlexChild->next_flex_child;
-        child->next_flex_child = NULL;
+        layoutNodeWithCache(child, maxWidth, direction);
       }
 
     // We use justifyContent to figure out how to allocate the remaining
@@ -936,7 +1109,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
     mainDim += leadingMainDim;
 
     for (i = firstComplexMain; i < endLine; ++i) {
-      child = node->get_child(node->context, i);
+      child = getChild(node, i);
 
       if (child->style.position_type == CSS_POSITION_ABSOLUTE &&
           isPosDefined(child, leading[mainAxis])) {
@@ -983,7 +1156,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
 
     // <Loop D> Position elements in the cross axis
     for (i = firstComplexCross; i < endLine; ++i) {
-      child = node->get_child(node->context, i);
+      child = getChild(node, i);
 
       if (child->style.position_type == CSS_POSITION_ABSOLUTE &&
           isPosDefined(child, leading[crossAxis])) {
@@ -1063,7 +1236,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
     float crossDimLead = 0;
     float currentLead = leadingPaddingAndBorderCross;
 
-    css_align_t alignContent = node->style.align_content;
+    css_align_t alignContent = (css_align_t)node->style.align_content;
     if (alignContent == CSS_ALIGN_FLEX_END) {
       currentLead += remainingAlignContentDim;
     } else if (alignContent == CSS_ALIGN_CENTER) {
@@ -1081,11 +1254,11 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
       // compute the line's height and find the endIndex
       float lineHeight = 0;
       for (ii = startIndex; ii < childCount; ++ii) {
-        child = node->get_child(node->context, ii);
+        child = getChild(node, ii);
         if (child->style.position_type != CSS_POSITION_RELATIVE) {
           continue;
         }
-        if (child->line_index != i) {
+        if (lineIndexes[ii] != i) {
           break;
         }
         if (!isUndefined(child->layout.dimensions[dim[crossAxis]])) {
@@ -1099,7 +1272,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
       lineHeight += crossDimLead;
 
       for (ii = startIndex; ii < endIndex; ++ii) {
-        child = node->get_child(node->context, ii);
+        child = getChild(node, ii);
         if (child->style.position_type != CSS_POSITION_RELATIVE) {
           continue;
         }
@@ -1161,7 +1334,7 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
   // <Loop F> Set trailing position if necessary
   if (needsMainTrailingPos || needsCrossTrailingPos) {
     for (i = 0; i < childCount; ++i) {
-      child = node->get_child(node->context, i);
+      child = getChild(node, i);
 
       if (needsMainTrailingPos) {
         setTrailingPosition(node, child, mainAxis);
@@ -1174,52 +1347,82 @@ static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction
   }
 
   // <Loop G> Calculate dimensions for absolutely positioned elements
-  currentAbsoluteChild = firstAbsoluteChild;
-  while (currentAbsoluteChild != NULL) {
+  for (i = 0; i < absoluteChildrenCount; ++i) {
+    child = absoluteChildren[i];
     // Pre-fill dimensions when using absolute position and both offsets for
     // the axis are defined (either both left and right or top and bottom).
     for (ii = 0; ii < 2; ii++) {
       axis = (ii != 0) ? CSS_FLEX_DIRECTION_ROW : CSS_FLEX_DIRECTION_COLUMN;
 
       if (!isUndefined(node->layout.dimensions[dim[axis]]) &&
-          !isDimDefined(currentAbsoluteChild, axis) &&
-          isPosDefined(currentAbsoluteChild, leading[axis]) &&
-          isPosDefined(currentAbsoluteChild, trailing[axis])) {
-        currentAbsoluteChild->layout.dimensions[dim[axis]] = fmaxf(
-          boundAxis(currentAbsoluteChild, axis, node->layout.dimensions[dim[axis]] -
+          !isDimDefined(child, axis) &&
+          isPosDefined(child, leading[axis]) &&
+          isPosDefined(child, trailing[axis])) {
+        child->layout.dimensions[dim[axis]] = fmaxf(
+          boundAxis(child, axis, node->layout.dimensions[dim[axis]] -
             getBorderAxis(node, axis) -
-            getMarginAxis(currentAbsoluteChild, axis) -
-            getPosition(currentAbsoluteChild, leading[axis]) -
-            getPosition(currentAbsoluteChild, trailing[axis])
+            getMarginAxis(child, axis) -
+            getPosition(child, leading[axis]) -
+            getPosition(child, trailing[axis])
           ),
           // You never want to go smaller than padding
-          getPaddingAndBorderAxis(currentAbsoluteChild, axis)
+          getPaddingAndBorderAxis(child, axis)
         );
       }
 
-      if (isPosDefined(currentAbsoluteChild, trailing[axis]) &&
-          !isPosDefined(currentAbsoluteChild, leading[axis])) {
-        currentAbsoluteChild->layout.position[leading[axis]] =
+      if (isPosDefined(child, trailing[axis]) &&
+          !isPosDefined(child, leading[axis])) {
+        child->layout.position[leading[axis]] =
           node->layout.dimensions[dim[axis]] -
-          currentAbsoluteChild->layout.dimensions[dim[axis]] -
-          getPosition(currentAbsoluteChild, trailing[axis]);
+          child->layout.dimensions[dim[axis]] -
+          getPosition(child, trailing[axis]);
       }
     }
+  }
 
-    child = currentAbsoluteChild;
-    currentAbsoluteChild = currentAbsoluteChild->next_absolute_child;
-    child->next_absolute_child = NULL;
+  if (absoluteChildren != stackChildren) {
+    free(absoluteChildren);
+    free(lineIndexes);
   }
   /** END_GENERATED **/
 }
 
-void layoutNode(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection) {
+static void layoutNodeImpl(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection) {
+  for (int i = 0; i < node->children_count; ++i) {
+    resolveEdges(getChild(node, i));
+  }
+
+  css_direction_t direction = resolveDirection(node, parentDirection);
+  css_flex_direction_t mainAxis = resolveAxis(getFlexDirection(node), direction);
+  int mainReverse = mainAxis & CSS_FLEX_DIRECTION_REVERSE_BIT;
+  if (isRowDirection(mainAxis)) {
+    layoutNodeWithAxes(node, parentMaxWidth, direction,
+      (css_flex_direction_t)(CSS_FLEX_DIRECTION_ROW | mainReverse),
+      CSS_FLEX_DIRECTION_COLUMN);
+  } else {
+    int crossReverse = direction == CSS_DIRECTION_RTL ? CSS_FLEX_DIRECTION_REVERSE_BIT : 0;
+    layoutNodeWithAxes(node, parentMaxWidth, direction,
+      (css_flex_direction_t)(CSS_FLEX_DIRECTION_COLUMN | mainReverse),
+      (css_flex_direction_t)(CSS_FLEX_DIRECTION_ROW | crossReverse));
+  }
+}
+
+static void layoutNodeWithCache(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection) {
   css_layout_t *layout = &node->layout;
-  css_direction_t direction = node->style.direction;
+  css_direction_t direction = (css_direction_t)node->style.direction;
+  bool isDirty = node->is_dirty(node->context);
+
+  // should_update is only cleared once the previous layout has been read, a
+  // dirty node that finds it cleared starts a new pass with new content. Until
+  // then, measurements are reused across the passes flex layout makes.
+  if (!layout->should_update && isDirty) {
+    layout->cached_measurements_count = 0;
+    layout->next_cached_measurement = 0;
+  }
   layout->should_update = true;
 
   bool skipLayout =
-    !node->is_dirty(node->context) &&
+    !isDirty &&
     eq(layout->last_requested_dimensions[CSS_WIDTH], layout->dimensions[CSS_WIDTH]) &&
     eq(layout->last_requested_dimensions[CSS_HEIGHT], layout->dimensions[CSS_HEIGHT]) &&
     eq(layout->last_parent_max_width, parentMaxWidth);
@@ -1237,6 +1440,7 @@ void layoutNode(css_node_t *node, float parentMaxWidth, css_direction_t parentDi
     layout->last_direction = direction;
 
     layoutNodeImpl(node, parentMaxWidth, parentDirection);
+    layout->has_new_layout = true;
 
     layout->last_dimensions[CSS_WIDTH] = layout->dimensions[CSS_WIDTH];
     layout->last_dimensions[CSS_HEIGHT] = layout->dimensions[CSS_HEIGHT];
@@ -1244,3 +1448,263 @@ void layoutNode(css_node_t *node, float parentMaxWidth, css_direction_t parentDi
     layout->last_position[CSS_LEFT] = layout->position[CSS_LEFT];
   }
 }
+
+void layoutNode(css_node_t *node, float parentMaxWidth, css_direction_t parentDirection) {
+  resolveEdges(node);
+  layoutNodeWithCache(node, parentMaxWidth, parentDirection);
+}
+
+static const uint32_t kSnapshotMagic = 0x4c535343; // "CSSL"
+static const uint32_t kSnapshotVersion = 1;
+
+// 64 bit FNV-1a
+static uint64_t hashBytes(uint64_t hash, const void *bytes, size_t length) {
+  const uint8_t *data = (const uint8_t *)bytes;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+static bool hashNode(css_node_t *node, css_content_hash_t content_hash, uint64_t *hash) {
+  css_style_t *style = &node->style;
+  uint8_t enums[8] = {
+    style->direction, style->flex_direction, style->justify_content, style->align_content,
+    style->align_items, style->align_self, style->position_type, style->flex_wrap,
+  };
+  *hash = hashBytes(*hash, enums, sizeof(enums));
+  *hash = hashBytes(*hash, &style->flex, sizeof(style->flex));
+  for (int value = 0; value < CSS_STYLE_VALUE_COUNT; value++) {
+    float number = css_style_get(style, value);
+    *hash = hashBytes(*hash, &number, sizeof(number));
+  }
+
+  if (isMeasureDefined(node)) {
+    uint64_t contentHash = content_hash ? content_hash(node->context) : 0;
+    if (contentHash == 0) {
+      return false;
+    }
+    *hash = hashBytes(*hash, &contentHash, sizeof(contentHash));
+  }
+
+  *hash = hashBytes(*hash, &node->children_count, sizeof(node->children_count));
+  for (int i = 0; i < node->children_count; i++) {
+    if (!hashNode(getChild(node, i), content_hash, hash)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t css_node_layout_hash(css_node_t *node, css_content_hash_t content_hash) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  if (!hashNode(node, content_hash, &hash)) {
+    return 0;
+  }
+  return hash ? hash : 1;
+}
+
+// Snapshots are written field by field, in the byte order of the device.
+// A snapshot is a header followed by the measured nodes in pre-order:
+//
+//   header := magic version hash(uint64) nodeCount measuredNodeCount
+//   node   := index count measurement*
+//
+// all uint32 except where noted, and a measurement is width,
+// width mode, height, height mode, width, height and baseline of the result.
+typedef struct {
+  uint8_t *data;
+  size_t size;
+  size_t offset;
+} css_snapshot_writer_t;
+
+static void writeBytes(css_snapshot_writer_t *writer, const void *bytes, size_t length) {
+  if (writer->offset + length <= writer->size) {
+    memcpy(writer->data + writer->offset, bytes, length);
+  }
+  writer->offset += length;
+}
+
+static void writeUInt32(css_snapshot_writer_t *writer, uint32_t value) {
+  writeBytes(writer, &value, sizeof(value));
+}
+
+static void writeFloat(css_snapshot_writer_t *writer, float value) {
+  writeBytes(writer, &value, sizeof(value));
+}
+
+static void writeMeasuredNodes(css_node_t *node, css_snapshot_writer_t *writer,
+                               uint32_t *index, uint32_t *measuredCount) {
+  css_layout_t *layout = &node->layout;
+  if (isMeasureDefined(node) && layout->cached_measurements_count > 0) {
+    writeUInt32(writer, *index);
+    writeUInt32(writer, layout->cached_measurements_count);
+    for (int i = 0; i < layout->cached_measurements_count; i++) {
+      css_cached_measurement_t *cached = &layout->cached_measurements[i];
+      writeFloat(writer, cached->width);
+      writeUInt32(writer, cached->width_mode);
+      writeFloat(writer, cached->height);
+      writeUInt32(writer, cached->height_mode);
+      writeFloat(writer, cached->result.dimensions[CSS_WIDTH]);
+      writeFloat(writer, cached->result.dimensions[CSS_HEIGHT]);
+      writeFloat(writer, cached->result.baseline);
+    }
+    (*measuredCount)++;
+  }
+  (*index)++;
+  for (int i = 0; i < node->children_count; i++) {
+    writeMeasuredNodes(getChild(node, i), writer, index, measuredCount);
+  }
+}
+
+size_t css_node_write_layout_snapshot(css_node_t *node, uint64_t hash, void *buffer, size_t size) {
+  css_snapshot_writer_t writer = {(uint8_t *)buffer, buffer ? size : 0, 0};
+  writeUInt32(&writer, kSnapshotMagic);
+  writeUInt32(&writer, kSnapshotVersion);
+  writeBytes(&writer, &hash, sizeof(hash));
+  size_t countsOffset = writer.offset;
+  writeUInt32(&writer, 0);
+  writeUInt32(&writer, 0);
+
+  uint32_t nodeCount = 0;
+  uint32_t measuredCount = 0;
+  writeMeasuredNodes(node, &writer, &nodeCount, &measuredCount);
+  if (measuredCount == 0) {
+    return 0;
+  }
+
+  // The counts are only known once the nodes are written
+  size_t snapshotSize = writer.offset;
+  writer.offset = countsOffset;
+  writeUInt32(&writer, nodeCount);
+  writeUInt32(&writer, measuredCount);
+  return snapshotSize;
+}
+
+typedef struct {
+  const uint8_t *data;
+  size_t size;
+  size_t offset;
+} css_snapshot_reader_t;
+
+static bool readBytes(css_snapshot_reader_t *reader, void *bytes, size_t length) {
+  if (length > reader->size - reader->offset) {
+    return false;
+  }
+  memcpy(bytes, reader->data + reader->offset, length);
+  reader->offset += length;
+  return true;
+}
+
+static bool readUInt32(css_snapshot_reader_t *reader, uint32_t *value) {
+  return readBytes(reader, value, sizeof(*value));
+}
+
+static bool readFloat(css_snapshot_reader_t *reader, float *value) {
+  return readBytes(reader, value, sizeof(*value));
+}
+
+// Reads a measured node into entries, without touching the tree yet
+static bool readMeasurements(css_snapshot_reader_t *reader, uint32_t *count,
+                             css_cached_measurement_t entries[CSS_MAX_CACHED_MEASUREMENTS]) {
+  if (!readUInt32(reader, count) || *count == 0 || *count > CSS_MAX_CACHED_MEASUREMENTS) {
+    return false;
+  }
+  for (uint32_t i = 0; i < *count; i++) {
+    css_cached_measurement_t *entry = &entries[i];
+    uint32_t widthMode;
+    uint32_t heightMode;
+    if (!readFloat(reader, &entry->width) ||
+        !readUInt32(reader, &widthMode) ||
+        !readFloat(reader, &entry->height) ||
+        !readUInt32(reader, &heightMode) ||
+        !readFloat(reader, &entry->result.dimensions[CSS_WIDTH]) ||
+        !readFloat(reader, &entry->result.dimensions[CSS_HEIGHT]) ||
+        !readFloat(reader, &entry->result.baseline) ||
+        widthMode > CSS_MEASURE_MODE_AT_MOST ||
+        heightMode > CSS_MEASURE_MODE_AT_MOST) {
+      return false;
+    }
+    entry->width_mode = (uint8_t)widthMode;
+    entry->height_mode = (uint8_t)heightMode;
+  }
+  return true;
+}
+
+typedef struct {
+  css_snapshot_reader_t reader;
+  // Pre-order index of the node being visited, and of the next measured node
+  // of the snapshot
+  uint32_t index;
+  uint32_t nextIndex;
+  uint32_t remaining;
+  bool apply;
+  bool failed;
+} css_snapshot_seeder_t;
+
+static void readNextIndex(css_snapshot_seeder_t *seeder) {
+  uint32_t previousIndex = seeder->nextIndex;
+  if (seeder->remaining == 0) {
+    seeder->nextIndex = UINT32_MAX;
+  } else if (!readUInt32(&seeder->reader, &seeder->nextIndex) ||
+             (previousIndex != UINT32_MAX && seeder->nextIndex <= previousIndex)) {
+    seeder->failed = true;
+  }
+}
+
+static void seedNodes(css_node_t *node, css_snapshot_seeder_t *seeder) {
+  if (seeder->failed) {
+    return;
+  }
+  if (seeder->index == seeder->nextIndex) {
+    uint32_t count;
+    css_cached_measurement_t entries[CSS_MAX_CACHED_MEASUREMENTS];
+    if (!isMeasureDefined(node) || !readMeasurements(&seeder->reader, &count, entries)) {
+      seeder->failed = true;
+      return;
+    }
+    if (seeder->apply) {
+      css_layout_t *layout = &node->layout;
+      memcpy(layout->cached_measurements, entries, count * sizeof(entries[0]));
+      layout->cached_measurements_count = count;
+      layout->next_cached_measurement = count % CSS_MAX_CACHED_MEASUREMENTS;
+      // Keeps the next layout from clearing the seeded measurements
+      layout->should_update = true;
+    }
+    seeder->remaining--;
+    readNextIndex(seeder);
+  }
+  seeder->index++;
+  for (int i = 0; i < node->children_count; i++) {
+    seedNodes(getChild(node, i), seeder);
+  }
+}
+
+bool css_node_read_layout_snapshot(css_node_t *node, uint64_t hash, const void *buffer, size_t size) {
+  css_snapshot_reader_t reader = {(const uint8_t *)buffer, buffer ? size : 0, 0};
+  uint32_t magic;
+  uint32_t version;
+  uint64_t snapshotHash;
+  uint32_t nodeCount;
+  uint32_t measuredCount;
+  if (!readUInt32(&reader, &magic) || magic != kSnapshotMagic ||
+      !readUInt32(&reader, &version) || version != kSnapshotVersion ||
+      !readBytes(&reader, &snapshotHash, sizeof(snapshotHash)) || snapshotHash != hash ||
+      !readUInt32(&reader, &nodeCount) ||
+      !readUInt32(&reader, &measuredCount)) {
+    return false;
+  }
+
+  // The whole snapshot is checked against the tree before the first node is
+  // seeded, so one that turns out not to match leaves the tree alone
+  for (int pass = 0; pass < 2; pass++) {
+    css_snapshot_seeder_t seeder = {reader, 0, UINT32_MAX, measuredCount, pass == 1, false};
+    readNextIndex(&seeder);
+    seedNodes(node, &seeder);
+    if (seeder.failed || seeder.remaining != 0 || seeder.index != nodeCount ||
+        seeder.reader.offset != seeder.reader.size) {
+      return false;
+    }
+  }
+  return true;
+}
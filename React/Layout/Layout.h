@@ -22,6 +22,8 @@
 #define __LAYOUT_H
 
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
 #ifndef __cplusplus
 #include <stdbool.h>
 #endif
@@ -92,40 +94,102 @@ typedef enum {
   CSS_HEIGHT
 } css_dimension_t;
 
+typedef struct {
+  float dimensions[2];
+} css_dim_t;
+
+// How the width or height given to measure_with_mode constrains the result
+typedef enum {
+  // Nothing is known, the value given is undefined
+  CSS_MEASURE_MODE_UNDEFINED = 0,
+  // The node will be exactly this size whatever measure returns
+  CSS_MEASURE_MODE_EXACTLY,
+  // The node can be up to this size
+  CSS_MEASURE_MODE_AT_MOST
+} css_measure_mode_t;
+
+typedef struct {
+  float dimensions[2];
+  // Distance from the top of the measured content to its first baseline, or
+  // CSS_UNDEFINED if it has none
+  float baseline;
+} css_measure_result_t;
+
+// Flex layout can measure the same node at a few alternating widths, this
+// many of them are remembered
+#define CSS_MAX_CACHED_MEASUREMENTS 6
+
+typedef struct {
+  float width;
+  float height;
+  uint8_t width_mode; // css_measure_mode_t
+  uint8_t height_mode; // css_measure_mode_t
+  css_measure_result_t result;
+} css_cached_measurement_t;
+
 typedef struct {
   float position[4];
   float dimensions[2];
   css_direction_t direction;
+  // Distance from the top of the node to its first baseline, if the last
+  // measure_with_mode call reported one, CSS_UNDEFINED otherwise
+  float baseline;
 
   // Instead of recomputing the entire layout every single time, we
   // cache some information to break early when nothing changed
-  bool should_update;
   float last_requested_dimensions[2];
   float last_parent_max_width;
   float last_dimensions[2];
   float last_position[2];
   css_direction_t last_direction;
+  bool should_update;
+
+  // Set when layoutNode had to lay the node out again rather than reuse its
+  // last result. While it's false, nothing in the subtree below has changed
+  // since the last pass and consumers can skip it. Never reset by css-layout.
+  bool has_new_layout;
+
+  // Results of measure(), forgotten when a dirty node starts a new layout pass
+  int cached_measurements_count;
+  int next_cached_measurement;
+  css_cached_measurement_t cached_measurements[CSS_MAX_CACHED_MEASUREMENTS];
 } css_layout_t;
 
-typedef struct {
-  float dimensions[2];
-} css_dim_t;
+// The numeric style values, read and written with css_style_get and
+// css_style_set. Margin, padding and border take an offset for each
+// css_position_t, position one for left, top, right and bottom, and the
+// dimensions one for each css_dimension_t, e.g. CSS_STYLE_MARGIN + CSS_TOP.
+// Unset margins, paddings and borders are 0, except for start and end which
+// are undefined like everything else.
+typedef enum {
+  CSS_STYLE_MARGIN = 0,
+  CSS_STYLE_PADDING = CSS_STYLE_MARGIN + CSS_POSITION_COUNT,
+  CSS_STYLE_BORDER = CSS_STYLE_PADDING + CSS_POSITION_COUNT,
+  CSS_STYLE_POSITION = CSS_STYLE_BORDER + CSS_POSITION_COUNT,
+  CSS_STYLE_DIMENSIONS = CSS_STYLE_POSITION + 4,
+  CSS_STYLE_MIN_DIMENSIONS = CSS_STYLE_DIMENSIONS + 2,
+  CSS_STYLE_MAX_DIMENSIONS = CSS_STYLE_MIN_DIMENSIONS + 2,
+  CSS_STYLE_VALUE_COUNT = CSS_STYLE_MAX_DIMENSIONS + 2
+} css_style_value_t;
+
+// Most nodes only set a few of their values, this many are kept in the style
+// itself before it moves them all to the heap
+#define CSS_STYLE_INLINE_VALUES 10
 
 typedef struct {
-  css_direction_t direction;
-  css_flex_direction_t flex_direction;
-  css_justify_t justify_content;
-  css_align_t align_content;
-  css_align_t align_items;
-  css_align_t align_self;
-  css_position_type_t position_type;
-  css_wrap_type_t flex_wrap;
+  uint8_t direction; // css_direction_t
+  uint8_t flex_direction; // css_flex_direction_t
+  uint8_t justify_content; // css_justify_t
+  uint8_t align_content; // css_align_t
+  uint8_t align_items; // css_align_t
+  uint8_t align_self; // css_align_t
+  uint8_t position_type; // css_position_type_t
+  uint8_t flex_wrap; // css_wrap_type_t
   float flex;
-  float margin[6];
-  float position[4];
+
   /**
-   * You should skip all the rules that contain negative values for the
-   * following attributes. For example:
+   * You should skip all the rules that contain negative values for padding
+   * and border. For example:
    *   {padding: 10, paddingLeft: -5}
    * should output:
    *   {left: 10 ...}
@@ -133,24 +197,55 @@ typedef struct {
    *   {left: -5 ...}
    *   {left: 0 ...}
    */
-  float padding[6];
-  float border[6];
-  float dimensions[2];
-  float minDimensions[2];
-  float maxDimensions[2];
+
+  // Bit i is set when the value at css_style_value_t i isn't the default, the
+  // set values are in inline_values in that order. Once more are set than
+  // fit, all of them move to overflow_values, indexed by css_style_value_t,
+  // which free_css_node releases. A style can be copied and copied back to
+  // its node, but not shared between two nodes.
+  uint32_t set_values;
+  float inline_values[CSS_STYLE_INLINE_VALUES];
+  float *overflow_values;
 } css_style_t;
 
+// The margin, padding and border of a node's leading and trailing edge along
+// each flex direction, indexed by css_flex_direction_t. Start/end overrides and
+// negative padding and border are resolved once per layout, instead of in
+// every lookup.
+typedef struct {
+  float leading_margin[4];
+  float trailing_margin[4];
+  float leading_padding[4];
+  float trailing_padding[4];
+  float leading_border[4];
+  float trailing_border[4];
+} css_resolved_edges_t;
+
 typedef struct css_node css_node_t;
 struct css_node {
   css_style_t style;
   css_layout_t layout;
+  css_resolved_edges_t edges;
   int children_count;
-  int line_index;
 
-  css_node_t* next_absolute_child;
-  css_node_t* next_flex_child;
+  // Filled by css_node_insert_child/css_node_remove_child, which also set
+  // children_count to children_length. While it is set, layout reads children
+  // from here instead of calling get_child for each one. children_count can
+  // still be lowered afterwards to hide the last children from layout.
+  css_node_t** children;
+  int children_length;
+  int children_capacity;
 
   css_dim_t (*measure)(void *context, float width);
+  // Used instead of measure when set. The width and height are those of the
+  // content box, either may be CSS_UNDEFINED when its mode is undefined.
+  css_measure_result_t (*measure_with_mode)(
+    void *context,
+    float width,
+    css_measure_mode_t width_mode,
+    float height,
+    css_measure_mode_t height_mode
+  );
   void (*print)(void *context);
   struct css_node* (*get_child)(void *context, int i);
   bool (*is_dirty)(void *context);
@@ -162,6 +257,12 @@ struct css_node {
 css_node_t *new_css_node(void);
 void init_css_node(css_node_t *node);
 void free_css_node(css_node_t *node);
+void css_node_insert_child(css_node_t *node, css_node_t *child, int index);
+void css_node_remove_child(css_node_t *node, int index);
+
+// Values of the style, see css_style_value_t
+float css_style_get(const css_style_t *style, int value);
+void css_style_set(css_style_t *style, int value, float number);
 
 // Print utilities
 typedef enum {
@@ -175,4 +276,25 @@ void print_css_node(css_node_t *node, css_print_options_t options);
 void layoutNode(css_node_t *node, float maxWidth, css_direction_t parentDirection);
 bool isUndefined(float value);
 
+// Layout snapshots
+//
+// A snapshot holds what the measure functions of a tree returned, so that the
+// first layout of a tree with the same structure, e.g. the same screen after
+// a restart, can skip measuring. The hash covers the styles and children of
+// every node, and what content_hash returns for each measured node, e.g. a
+// hash of its text. It is 0 when content_hash returns 0 for a measured node,
+// and such trees can't be snapshotted.
+typedef uint64_t (*css_content_hash_t)(void *context);
+uint64_t css_node_layout_hash(css_node_t *node, css_content_hash_t content_hash);
+
+// Writes the snapshot of the tree, computed since it was last dirtied, into
+// buffer if it fits in size bytes. Returns the size of the snapshot, or 0 if
+// nothing in the tree was measured.
+size_t css_node_write_layout_snapshot(css_node_t *node, uint64_t hash, void *buffer, size_t size);
+
+// Seeds the measurement caches of the tree with a snapshot written for a tree
+// with the same hash. Returns false and leaves the tree as it was if the
+// snapshot doesn't match it.
+bool css_node_read_layout_snapshot(css_node_t *node, uint64_t hash, const void *buffer, size_t size);
+
 #endif
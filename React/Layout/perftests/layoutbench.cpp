@@ -0,0 +1,434 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// css-layout benchmark over recorded view trees. Fixtures are the JSON that
+// -[RCTShadowView layoutFixture] returns for a root view, style keys that are
+// left out keep their css-layout default. Text and other measured views replay
+// the sizes they measured when the fixture was taken. fixtures/feed.json is a
+// hand-built list screen in that format, to have something to start with.
+//
+//   make -C React/Layout/perftests
+//   React/Layout/perftests/layoutbench React/Layout/perftests/fixtures/*.json
+//
+// Every fixture is timed in three phases:
+//   cold      fresh tree, every node dirty and nothing cached
+//   warm      nothing changed since the last layout
+//   mutation  one measured leaf in the middle of the tree is dirtied
+// Compare runs built with the same compiler flags on the same machine.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "../Layout.h"
+}
+
+namespace {
+
+// Just enough JSON for fixtures: objects, arrays, numbers, strings and null
+struct JSONValue {
+  enum Type { Null, Number, String, Array, Object } type = Null;
+  double number = 0;
+  std::string string;
+  std::vector<JSONValue> array;
+  std::map<std::string, JSONValue> object;
+
+  const JSONValue& operator[](const std::string& key) const {
+    static const JSONValue null;
+    auto it = object.find(key);
+    return it == object.end() ? null : it->second;
+  }
+
+  float asFloat() const {
+    return type == Number ? static_cast<float>(number) : CSS_UNDEFINED;
+  }
+};
+
+class JSONParser {
+public:
+  explicit JSONParser(const std::string& text) : m_text(text), m_pos(0) {}
+
+  JSONValue parse() {
+    JSONValue value = parseValue();
+    skipWhitespace();
+    if (m_pos != m_text.size()) {
+      fail("trailing characters");
+    }
+    return value;
+  }
+
+private:
+  const std::string& m_text;
+  size_t m_pos;
+
+  [[noreturn]] void fail(const char* what) {
+    fprintf(stderr, "Invalid fixture at offset %zu: %s\n", m_pos, what);
+    exit(1);
+  }
+
+  void skipWhitespace() {
+    while (m_pos < m_text.size() && isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+      m_pos++;
+    }
+  }
+
+  bool consume(char c) {
+    skipWhitespace();
+    if (m_pos < m_text.size() && m_text[m_pos] == c) {
+      m_pos++;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c) {
+    if (!consume(c)) {
+      fail("unexpected character");
+    }
+  }
+
+  JSONValue parseValue() {
+    skipWhitespace();
+    if (m_pos >= m_text.size()) {
+      fail("unexpected end");
+    }
+    JSONValue value;
+    char c = m_text[m_pos];
+    if (c == '{') {
+      m_pos++;
+      value.type = JSONValue::Object;
+      if (!consume('}')) {
+        do {
+          skipWhitespace();
+          std::string key = parseString();
+          expect(':');
+          value.object[key] = parseValue();
+        } while (consume(','));
+        expect('}');
+      }
+    } else if (c == '[') {
+      m_pos++;
+      value.type = JSONValue::Array;
+      if (!consume(']')) {
+        do {
+          value.array.push_back(parseValue());
+        } while (consume(','));
+        expect(']');
+      }
+    } else if (c == '"') {
+      value.type = JSONValue::String;
+      value.string = parseString();
+    } else if (m_text.compare(m_pos, 4, "null") == 0) {
+      m_pos += 4;
+    } else {
+      char* end;
+      value.type = JSONValue::Number;
+      value.number = strtod(m_text.c_str() + m_pos, &end);
+      if (end == m_text.c_str() + m_pos) {
+        fail("expected a value");
+      }
+      m_pos = end - m_text.c_str();
+    }
+    return value;
+  }
+
+  // View names are all the fixtures keep, so escapes are passed through as is
+  std::string parseString() {
+    if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+      fail("expected a string");
+    }
+    size_t start = ++m_pos;
+    while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+      m_pos += m_text[m_pos] == '\\' ? 2 : 1;
+    }
+    if (m_pos >= m_text.size()) {
+      fail("unterminated string");
+    }
+    return m_text.substr(start, m_pos++ - start);
+  }
+};
+
+struct Measurement {
+  float width;
+  css_dim_t result;
+};
+
+// Stands in for RCTShadowView: owns the css_node_t and answers its callbacks
+struct Node {
+  css_node_t* cssNode;
+  Node* parent = nullptr;
+  bool dirty = true;
+  std::vector<Measurement> measurements;
+  std::vector<std::unique_ptr<Node>> children;
+  size_t measureCalls = 0;
+
+  Node() : cssNode(new_css_node()) {
+    cssNode->context = this;
+    cssNode->is_dirty = [](void* context) {
+      return static_cast<Node*>(context)->dirty;
+    };
+  }
+
+  ~Node() {
+    free_css_node(cssNode);
+  }
+
+  void dirtyLayout() {
+    for (Node* node = this; node && !node->dirty; node = node->parent) {
+      node->dirty = true;
+    }
+  }
+};
+
+bool sameWidth(float a, float b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b);
+  }
+  return std::fabs(a - b) < 0.0001f;
+}
+
+// Replays the recorded size for this width. Widths the recording never saw get
+// the size recorded for the closest one, which keeps layout deterministic.
+css_dim_t measureRecorded(void* context, float width) {
+  Node* node = static_cast<Node*>(context);
+  node->measureCalls++;
+  const Measurement* best = &node->measurements.front();
+  for (const auto& measurement : node->measurements) {
+    if (sameWidth(measurement.width, width)) {
+      return measurement.result;
+    }
+    if (!std::isnan(width) && !std::isnan(measurement.width) &&
+        (std::isnan(best->width) ||
+         std::fabs(measurement.width - width) < std::fabs(best->width - width))) {
+      best = &measurement;
+    }
+  }
+  return best->result;
+}
+
+// Missing keys keep the defaults init_css_node set
+void readStyleValues(const JSONValue& values, css_style_t& style, int first, size_t count) {
+  for (size_t i = 0; i < count && i < values.array.size(); i++) {
+    css_style_set(&style, first + static_cast<int>(i), values.array[i].asFloat());
+  }
+}
+
+template <typename T>
+void readEnum(const JSONValue& value, T& out) {
+  if (value.type == JSONValue::Number) {
+    out = static_cast<T>(static_cast<int>(value.number));
+  }
+}
+
+std::unique_ptr<Node> buildTree(const JSONValue& json, Node* parent) {
+  std::unique_ptr<Node> node(new Node());
+  node->parent = parent;
+  css_style_t& style = node->cssNode->style;
+  const JSONValue& styleJSON = json["style"];
+  readEnum(styleJSON["direction"], style.direction);
+  readEnum(styleJSON["flexDirection"], style.flex_direction);
+  readEnum(styleJSON["justifyContent"], style.justify_content);
+  readEnum(styleJSON["alignContent"], style.align_content);
+  readEnum(styleJSON["alignItems"], style.align_items);
+  readEnum(styleJSON["alignSelf"], style.align_self);
+  readEnum(styleJSON["positionType"], style.position_type);
+  readEnum(styleJSON["flexWrap"], style.flex_wrap);
+  if (styleJSON["flex"].type == JSONValue::Number) {
+    style.flex = styleJSON["flex"].asFloat();
+  }
+  readStyleValues(styleJSON["margin"], style, CSS_STYLE_MARGIN, 6);
+  readStyleValues(styleJSON["position"], style, CSS_STYLE_POSITION, 4);
+  readStyleValues(styleJSON["padding"], style, CSS_STYLE_PADDING, 6);
+  readStyleValues(styleJSON["border"], style, CSS_STYLE_BORDER, 6);
+  readStyleValues(styleJSON["dimensions"], style, CSS_STYLE_DIMENSIONS, 2);
+  readStyleValues(styleJSON["minDimensions"], style, CSS_STYLE_MIN_DIMENSIONS, 2);
+  readStyleValues(styleJSON["maxDimensions"], style, CSS_STYLE_MAX_DIMENSIONS, 2);
+
+  for (const auto& measurement : json["measurements"].array) {
+    Measurement recorded;
+    recorded.width = measurement.array.at(0).asFloat();
+    recorded.result.dimensions[CSS_WIDTH] = measurement.array.at(1).asFloat();
+    recorded.result.dimensions[CSS_HEIGHT] = measurement.array.at(2).asFloat();
+    node->measurements.push_back(recorded);
+  }
+  if (!node->measurements.empty()) {
+    node->cssNode->measure = measureRecorded;
+  }
+
+  for (const auto& childJSON : json["children"].array) {
+    node->children.push_back(buildTree(childJSON, node.get()));
+    css_node_insert_child(
+      node->cssNode, node->children.back()->cssNode, node->children.size() - 1);
+  }
+  return node;
+}
+
+// What -[RCTShadowView applyLayoutNode:] does after every layout
+void applyLayout(Node* node) {
+  css_layout_t& layout = node->cssNode->layout;
+  if (!layout.should_update) {
+    return;
+  }
+  layout.should_update = false;
+  node->dirty = false;
+  bool childrenHaveNewLayout = layout.has_new_layout;
+  layout.has_new_layout = false;
+  layout.dimensions[CSS_WIDTH] = CSS_UNDEFINED;
+  layout.dimensions[CSS_HEIGHT] = CSS_UNDEFINED;
+  layout.position[CSS_LEFT] = 0;
+  layout.position[CSS_TOP] = 0;
+  if (childrenHaveNewLayout) {
+    for (auto& child : node->children) {
+      applyLayout(child.get());
+    }
+  }
+}
+
+void collect(Node* node, std::vector<Node*>& nodes) {
+  nodes.push_back(node);
+  for (auto& child : node->children) {
+    collect(child.get(), nodes);
+  }
+}
+
+struct PhaseResult {
+  double minUs;
+  double medianUs;
+  double meanUs;
+  double measureCallsPerRun;
+};
+
+template <typename Setup, typename Body>
+PhaseResult timePhase(
+    const std::vector<Node*>& nodes, size_t runs, Setup&& setup, Body&& body) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> timesUs;
+  size_t measureCalls = 0;
+  for (size_t run = 0; run < runs; run++) {
+    setup();
+    for (Node* node : nodes) {
+      node->measureCalls = 0;
+    }
+    auto start = Clock::now();
+    body();
+    timesUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    for (Node* node : nodes) {
+      measureCalls += node->measureCalls;
+    }
+  }
+  std::sort(timesUs.begin(), timesUs.end());
+  double sum = 0;
+  for (double time : timesUs) {
+    sum += time;
+  }
+  return {
+    timesUs.front(),
+    timesUs[timesUs.size() / 2],
+    sum / timesUs.size(),
+    static_cast<double>(measureCalls) / runs,
+  };
+}
+
+void printPhase(const std::string& fixture, const char* phase, const PhaseResult& result) {
+  printf("%-32s %-10s %12.1f %12.1f %12.1f %10.1f\n",
+         fixture.c_str(), phase, result.minUs, result.medianUs, result.meanUs,
+         result.measureCallsPerRun);
+  fflush(stdout);
+}
+
+void runFixture(const std::string& path, size_t runs) {
+  std::ifstream file(path);
+  if (!file) {
+    fprintf(stderr, "Unable to read %s\n", path.c_str());
+    exit(1);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::string text = contents.str();
+  JSONValue json = JSONParser(text).parse();
+  const JSONValue& rootJSON = json["root"].type == JSONValue::Object ? json["root"] : json;
+
+  std::string name = path.substr(path.find_last_of('/') + 1);
+  std::vector<std::unique_ptr<Node>> trees;
+  auto layout = [&] (Node* root) {
+    layoutNode(root->cssNode, CSS_UNDEFINED, CSS_DIRECTION_INHERIT);
+    applyLayout(root);
+  };
+
+  // Cold: layout always starts from a tree nobody has laid out yet
+  Node* cold = nullptr;
+  std::vector<Node*> coldNodes;
+  printPhase(name, "cold", timePhase(coldNodes, runs, [&] {
+    trees.clear();
+    trees.push_back(buildTree(rootJSON, nullptr));
+    cold = trees.back().get();
+    coldNodes.clear();
+    collect(cold, coldNodes);
+  }, [&] {
+    layout(cold);
+  }));
+
+  std::unique_ptr<Node> root = buildTree(rootJSON, nullptr);
+  std::vector<Node*> nodes;
+  collect(root.get(), nodes);
+  layout(root.get());
+
+  printPhase(name, "warm", timePhase(nodes, runs, [] {}, [&] {
+    layout(root.get());
+  }));
+
+  // The middle measured node, or the middle node if nothing is measured
+  std::vector<Node*> measured;
+  for (Node* node : nodes) {
+    if (node->cssNode->measure) {
+      measured.push_back(node);
+    }
+  }
+  Node* mutated = measured.empty() ? nodes[nodes.size() / 2] : measured[measured.size() / 2];
+  printPhase(name, "mutation", timePhase(nodes, runs, [&] {
+    mutated->dirtyLayout();
+  }, [&] {
+    layout(root.get());
+  }));
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t runs = 200;
+  std::vector<std::string> fixtures;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--runs" && i + 1 < argc) {
+      runs = std::max(1, atoi(argv[++i]));
+    } else {
+      fixtures.push_back(arg);
+    }
+  }
+  if (fixtures.empty()) {
+    fprintf(stderr, "usage: %s [--runs N] fixture.json...\n", argv[0]);
+    return 1;
+  }
+
+  printf("%-32s %-10s %12s %12s %12s %10s\n",
+         "fixture", "phase", "min us", "median us", "mean us", "measures");
+  for (const auto& fixture : fixtures) {
+    runFixture(fixture, runs);
+  }
+  return 0;
+}
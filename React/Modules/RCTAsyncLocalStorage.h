@@ -15,11 +15,20 @@
  * backend to the AsyncStorage JS module, which is modeled after LocalStorage.
  *
  * Current implementation stores small values in serialized dictionary and
- * larger values in separate files. Since we use a serial file queue
+ * larger values in separate files. Changes to the dictionary are appended to
+ * a log, and it's only rewritten once the log has grown too big. Since we use a serial file queue
  * `RKFileQueue`, reading/writing from multiple threads should be perceived as
  * being atomic, unless someone bypasses the `RCTAsyncLocalStorage` API.
  *
  * Keys and values must always be strings or an error is returned.
+ *
+ * Durability: changes are visible to all later calls straight away, but they
+ * are written to disk up to 100ms later, together with any other changes made
+ * in the meantime, and before the app goes to the background or the module is
+ * invalidated. Changes made just before the process is killed can be lost.
+ * Errors writing them are logged, since the callback has already been called.
+ * Values too big to be inlined are written to their own file before the
+ * callback is called, as before.
  */
 @interface RCTAsyncLocalStorage : NSObject <RCTBridgeModule,RCTInvalidating>
 
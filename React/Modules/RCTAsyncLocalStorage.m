@@ -10,17 +10,34 @@
 #import "RCTAsyncLocalStorage.h"
 
 #import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import <fcntl.h>
+#import <unistd.h>
 
 #import <CommonCrypto/CommonCryptor.h>
 #import <CommonCrypto/CommonDigest.h>
 
+#import "RCTCache.h"
 #import "RCTLog.h"
 #import "RCTUtils.h"
 
 static NSString *const RCTStorageDirectory = @"RCTAsyncLocalStorage_V1";
 static NSString *const RCTManifestFileName = @"manifest.json";
+static NSString *const RCTManifestLogFileName = @"manifest.log";
 static const NSUInteger RCTInlineValueThreshold = 100;
 
+// The manifest is only rewritten once the log has grown past this size, and
+// past the size of the manifest itself, so the cost of rewriting it is spread
+// over at least as many bytes of log
+static const unsigned long long RCTManifestLogCompactionThreshold = 256 * 1024;
+
+// Changes are written at most this often, so bursts of calls share one write
+static const NSTimeInterval RCTManifestFlushInterval = 0.1;
+
+// Values stored in their own files that were recently read or written are
+// kept in memory, up to about this many bytes
+static const NSUInteger RCTValueCacheCostLimit = 2 * 1024 * 1024;
+
 #pragma mark - Static helper functions
 
 static id RCTErrorForKey(NSString *key)
@@ -47,13 +64,14 @@ static void RCTAppendError(id error, NSMutableArray **errors)
 static id RCTReadFile(NSString *filePath, NSString *key, NSDictionary **errorOut)
 {
   if ([[NSFileManager defaultManager] fileExistsAtPath:filePath]) {
+    // Mapping the file means its contents are only copied once, into the string
     NSError *error;
-    NSStringEncoding encoding;
-    NSString *entryString = [NSString stringWithContentsOfFile:filePath usedEncoding:&encoding error:&error];
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:&error];
+    NSString *entryString = data ? [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] : nil;
     if (error) {
       *errorOut = RCTMakeError(@"Failed to read storage file.", error, @{@"key": key});
-    } else if (encoding != NSUTF8StringEncoding) {
-      *errorOut = RCTMakeError(@"Incorrect encoding of storage file: ", @(encoding), @{@"key": key});
+    } else if (!entryString) {
+      *errorOut = RCTMakeError(@"Incorrect encoding of storage file: ", key, @{@"key": key});
     } else {
       return entryString;
     }
@@ -61,6 +79,11 @@ static id RCTReadFile(NSString *filePath, NSString *key, NSDictionary **errorOut
   return nil;
 }
 
+static NSUInteger RCTValueCacheCost(NSString *value)
+{
+  return value.length * sizeof(unichar);
+}
+
 static NSString *RCTGetStorageDirectory()
 {
   static NSString *storageDirectory = nil;
@@ -82,6 +105,16 @@ static NSString *RCTGetManifestFilePath()
   return manifestFilePath;
 }
 
+static NSString *RCTGetManifestLogFilePath()
+{
+  static NSString *manifestLogFilePath = nil;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    manifestLogFilePath = [RCTGetStorageDirectory() stringByAppendingPathComponent:RCTManifestLogFileName];
+  });
+  return manifestLogFilePath;
+}
+
 // Only merges objects - all other types are just clobbered (including arrays)
 static void RCTMergeRecursive(NSMutableDictionary *destination, NSDictionary *source)
 {
@@ -122,11 +155,15 @@ static dispatch_queue_t RCTGetMethodQueue()
 }
 
 static BOOL RCTHasCreatedStorageDirectory = NO;
+// Incremented whenever the storage directory is deleted, so instances know to
+// reload their manifest and reopen the log
+static NSUInteger RCTStorageDirectoryGeneration = 0;
 static NSError *RCTDeleteStorageDirectory()
 {
   NSError *error;
   [[NSFileManager defaultManager] removeItemAtPath:RCTGetStorageDirectory() error:&error];
   RCTHasCreatedStorageDirectory = NO;
+  RCTStorageDirectoryGeneration++;
   return error;
 }
 
@@ -135,13 +172,29 @@ static NSError *RCTDeleteStorageDirectory()
 @implementation RCTAsyncLocalStorage
 {
   BOOL _haveSetup;
+  NSUInteger _storageGeneration;
   // The manifest is a dictionary of all keys with small values inlined.  Null values indicate values that are stored
   // in separate files (as opposed to nil values which don't exist).  The manifest is read off disk at startup, and
-  // written to disk after all mutations.
+  // the changes made by each call are appended to the manifest log, which is replayed on top of it. Once the log
+  // gets too big the manifest is written out again and the log is emptied.
   NSMutableDictionary *_manifest;
+  // Entries are [key, value] for inline values, [key, null] for values in separate files and [key] for removals
+  NSMutableArray *_pendingLogEntries;
+  int _logFileDescriptor;
+  unsigned long long _logSize;
+  unsigned long long _manifestSize;
+  BOOL _flushScheduled;
+  RCTCache *_valueCache;
 }
 
-RCT_EXPORT_MODULE()
+RCT_EXPORT_LAZY_MODULE()
+
++ (BOOL)isSharedAcrossBridges
+{
+  // One manifest and one open log for the storage files, whatever the number
+  // of bridges
+  return YES;
+}
 
 - (dispatch_queue_t)methodQueue
 {
@@ -155,13 +208,80 @@ RCT_EXPORT_MODULE()
   });
 }
 
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _logFileDescriptor = -1;
+    _valueCache = [RCTCache new];
+    _valueCache.totalCostLimit = RCTValueCacheCostLimit;
+
+    for (NSString *name in @[UIApplicationDidEnterBackgroundNotification,
+                             UIApplicationWillTerminateNotification]) {
+      [[NSNotificationCenter defaultCenter] addObserver:self
+                                               selector:@selector(flushBeforeSuspending)
+                                                   name:name
+                                                 object:nil];
+    }
+  }
+  return self;
+}
+
+- (void)flushBeforeSuspending
+{
+  // Waits for the flush, the app may be suspended as soon as this returns
+  dispatch_sync(RCTGetMethodQueue(), ^{
+    [self _flush];
+  });
+}
+
 - (void)invalidate
 {
+  [self _flush];
   if (_clearOnInvalidate) {
     RCTDeleteStorageDirectory();
   }
   _clearOnInvalidate = NO;
+  [self _reset];
+}
+
+- (void)_scheduleFlush
+{
+  if (_flushScheduled || !_pendingLogEntries.count) {
+    return;
+  }
+  _flushScheduled = YES;
+
+  __weak RCTAsyncLocalStorage *weakSelf = self;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(RCTManifestFlushInterval * NSEC_PER_SEC)),
+                 RCTGetMethodQueue(), ^{
+    [weakSelf _flush];
+  });
+}
+
+- (void)_flush
+{
+  _flushScheduled = NO;
+  if (!_haveSetup || _storageGeneration != RCTStorageDirectoryGeneration) {
+    // Nothing to write, or the storage was cleared since the changes were made
+    return;
+  }
+
+  NSMutableArray *errors;
+  [self _commitLogEntries:&errors];
+  if (errors) {
+    RCTLogWarn(@"Failed to persist AsyncStorage changes: %@", errors);
+  }
+}
+
+- (void)_reset
+{
+  if (_logFileDescriptor >= 0) {
+    close(_logFileDescriptor);
+    _logFileDescriptor = -1;
+  }
   _manifest = [NSMutableDictionary new];
+  _pendingLogEntries = nil;
+  [_valueCache removeAllObjects];
   _haveSetup = NO;
 }
 
@@ -172,6 +292,7 @@ RCT_EXPORT_MODULE()
 
 - (void)dealloc
 {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
   [self invalidate];
 }
 
@@ -186,6 +307,10 @@ RCT_EXPORT_MODULE()
   RCTAssertThread(RCTGetMethodQueue(), @"Must be executed on storage thread");
 
   NSError *error = nil;
+  if (_haveSetup && _storageGeneration != RCTStorageDirectoryGeneration) {
+    // The storage was cleared by another instance
+    [self _reset];
+  }
   if (!RCTHasCreatedStorageDirectory) {
     [[NSFileManager defaultManager] createDirectoryAtPath:RCTGetStorageDirectory()
                               withIntermediateDirectories:YES
@@ -204,11 +329,64 @@ RCT_EXPORT_MODULE()
       RCTLogWarn(@"Failed to parse manifest - creating new one.\n\n%@", error);
       _manifest = [NSMutableDictionary new];
     }
+    _manifestSize = [serialized lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    id errorOut = [self _replayLog];
+    if (errorOut) {
+      return errorOut;
+    }
+    _pendingLogEntries = [NSMutableArray new];
+    _storageGeneration = RCTStorageDirectoryGeneration;
     _haveSetup = YES;
   }
   return nil;
 }
 
+/**
+ * Applies the changes recorded in the log to the manifest, and opens the log
+ * for appending. A partly written last line, left by a crash, is discarded.
+ */
+- (id)_replayLog
+{
+  NSData *log = [NSData dataWithContentsOfFile:RCTGetManifestLogFilePath()
+                                       options:NSDataReadingMappedIfSafe
+                                         error:NULL];
+  const char *bytes = log.bytes;
+  NSUInteger lineStart = 0;
+  while (lineStart < log.length) {
+    const char *lineEnd = memchr(bytes + lineStart, '\n', log.length - lineStart);
+    if (!lineEnd) {
+      break;
+    }
+    NSUInteger lineLength = lineEnd - (bytes + lineStart);
+    NSData *line = [NSData dataWithBytesNoCopy:(void *)(bytes + lineStart) length:lineLength freeWhenDone:NO];
+    NSArray *entries = [NSJSONSerialization JSONObjectWithData:line options:0 error:NULL];
+    if (![entries isKindOfClass:[NSArray class]]) {
+      RCTLogWarn(@"Failed to parse manifest log - ignoring the rest of it.");
+      break;
+    }
+    for (NSArray *entry in entries) {
+      if (entry.count == 2) {
+        _manifest[entry[0]] = entry[1];
+      } else if (entry.count == 1) {
+        [_manifest removeObjectForKey:entry[0]];
+      }
+    }
+    lineStart += lineLength + 1;
+  }
+
+  _logFileDescriptor = open(RCTGetManifestLogFilePath().fileSystemRepresentation, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (_logFileDescriptor < 0 || ftruncate(_logFileDescriptor, lineStart) != 0) {
+    int error = errno;
+    if (_logFileDescriptor >= 0) {
+      close(_logFileDescriptor);
+      _logFileDescriptor = -1;
+    }
+    return RCTMakeError(@"Failed to open manifest log.", @(error), nil);
+  }
+  _logSize = lineStart;
+  return nil;
+}
+
 - (id)_writeManifest:(NSMutableArray **)errors
 {
   NSError *error;
@@ -218,10 +396,59 @@ RCT_EXPORT_MODULE()
   if (error) {
     errorOut = RCTMakeError(@"Failed to write manifest file.", error, nil);
     RCTAppendError(errorOut, errors);
+  } else {
+    _manifestSize = [serialized lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
   }
   return errorOut;
 }
 
+/**
+ * Makes the changes since the last call persistent, by appending them to the
+ * log as a single line or, if the log has grown too big, by writing out the
+ * whole manifest and emptying the log.
+ */
+- (id)_commitLogEntries:(NSMutableArray **)errors
+{
+  if (!_pendingLogEntries.count) {
+    return nil;
+  }
+
+  NSError *error;
+  NSString *serialized = RCTJSONStringify(_pendingLogEntries, &error);
+  [_pendingLogEntries removeAllObjects];
+  NSData *line = [[serialized stringByAppendingString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+
+  if (_logSize + line.length > MAX(RCTManifestLogCompactionThreshold, _manifestSize)) {
+    // The log is only emptied once the new manifest has been written. Until
+    // then, replaying it over either manifest gives the same result. If the
+    // manifest can't be written, the changes are appended to the log instead.
+    id errorOut = [self _writeManifest:NULL];
+    if (!errorOut) {
+      if (ftruncate(_logFileDescriptor, 0) == 0) {
+        _logSize = 0;
+      }
+      return nil;
+    }
+  }
+
+  const char *bytes = line.bytes;
+  NSUInteger written = 0;
+  while (written < line.length) {
+    ssize_t result = write(_logFileDescriptor, bytes + written, line.length - written);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      id errorOut = RCTMakeError(@"Failed to write manifest log.", @(errno), nil);
+      RCTAppendError(errorOut, errors);
+      return errorOut;
+    }
+    written += result;
+  }
+  _logSize += line.length;
+  return nil;
+}
+
 - (id)_appendItemForKey:(NSString *)key toArray:(NSMutableArray *)result
 {
   id errorOut = RCTErrorForKey(key);
@@ -237,12 +464,55 @@ RCT_EXPORT_MODULE()
 {
   id value = _manifest[key]; // nil means missing, null means there is a data file, anything else is an inline value.
   if (value == (id)kCFNull) {
-    NSString *filePath = [self _filePathForKey:key];
-    value = RCTReadFile(filePath, key, errorOut);
+    value = _valueCache[key];
+    if (!value) {
+      NSString *filePath = [self _filePathForKey:key];
+      value = RCTReadFile(filePath, key, errorOut);
+      if (value) {
+        [_valueCache setObject:value forKey:key cost:RCTValueCacheCost(value)];
+      }
+    }
   }
   return value;
 }
 
+/**
+ * Reads the values of the keys that are stored in files and aren't cached in
+ * parallel, rather than one after the other on the storage queue, and adds
+ * them to the cache. They're returned as well, since the cache may not have
+ * room for all of them.
+ */
+- (NSDictionary *)_prefetchValuesForKeys:(NSArray *)keys
+{
+  NSMutableArray *uncachedKeys = [NSMutableArray new];
+  for (NSString *key in keys) {
+    if ([key isKindOfClass:[NSString class]] && _manifest[key] == (id)kCFNull && !_valueCache[key]) {
+      [uncachedKeys addObject:key];
+    }
+  }
+  if (uncachedKeys.count < 2) {
+    return nil;
+  }
+
+  NSUInteger count = uncachedKeys.count;
+  __strong NSString **values = (__strong NSString **)calloc(count, sizeof(NSString *));
+  dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+    NSDictionary *errorOut;
+    values[i] = RCTReadFile([self _filePathForKey:uncachedKeys[i]], uncachedKeys[i], &errorOut);
+  });
+  NSMutableDictionary *prefetchedValues = [NSMutableDictionary new];
+  for (NSUInteger i = 0; i < count; i++) {
+    // Keys that failed to read are read again, and report their error, later
+    if (values[i]) {
+      prefetchedValues[uncachedKeys[i]] = values[i];
+      [_valueCache setObject:values[i] forKey:uncachedKeys[i] cost:RCTValueCacheCost(values[i])];
+    }
+    values[i] = nil;
+  }
+  free(values);
+  return prefetchedValues;
+}
+
 - (id)_writeEntry:(NSArray *)entry
 {
   if (![entry isKindOfClass:[NSArray class]] || entry.count != 2) {
@@ -265,13 +535,18 @@ RCT_EXPORT_MODULE()
       [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
     }
     _manifest[key] = value;
+    [_pendingLogEntries addObject:@[key, value]];
+    [_valueCache removeObjectForKey:key];
     return nil;
   }
   [value writeToFile:filePath atomically:YES encoding:NSUTF8StringEncoding error:&error];
   if (error) {
     errorOut = RCTMakeError(@"Failed to write value.", error, @{@"key": key});
+    [_valueCache removeObjectForKey:key];
   } else {
     _manifest[key] = (id)kCFNull; // Mark existence of file with null, any other value is inline data.
+    [_pendingLogEntries addObject:@[key, (id)kCFNull]];
+    [_valueCache setObject:value forKey:key cost:RCTValueCacheCost(value)];
   }
   return errorOut;
 }
@@ -291,9 +566,16 @@ RCT_EXPORT_METHOD(multiGet:(NSArray *)keys
     callback(@[@[errorOut], (id)kCFNull]);
     return;
   }
+  NSDictionary *prefetchedValues = [self _prefetchValuesForKeys:keys];
+
   NSMutableArray *errors;
   NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:keys.count];
   for (NSString *key in keys) {
+    NSString *value = prefetchedValues[key];
+    if (value) {
+      [result addObject:@[key, value]];
+      continue;
+    }
     id keyError = [self _appendItemForKey:key toArray:result];
     RCTAppendError(keyError, &errors);
   }
@@ -313,7 +595,7 @@ RCT_EXPORT_METHOD(multiSet:(NSArray *)kvPairs
     id keyError = [self _writeEntry:entry];
     RCTAppendError(keyError, &errors);
   }
-  [self _writeManifest:&errors];
+  [self _scheduleFlush];
   if (callback) {
     callback(@[RCTNullIfNil(errors)]);
   }
@@ -345,7 +627,7 @@ RCT_EXPORT_METHOD(multiMerge:(NSArray *)kvPairs
       RCTAppendError(keyError, &errors);
     }
   }
-  [self _writeManifest:&errors];
+  [self _scheduleFlush];
   if (callback) {
     callback(@[RCTNullIfNil(errors)]);
   }
@@ -366,10 +648,12 @@ RCT_EXPORT_METHOD(multiRemove:(NSArray *)keys
       NSString *filePath = [self _filePathForKey:key];
       [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
       [_manifest removeObjectForKey:key];
+      [_pendingLogEntries addObject:@[key]];
+      [_valueCache removeObjectForKey:key];
     }
     RCTAppendError(keyError, &errors);
   }
-  [self _writeManifest:&errors];
+  [self _scheduleFlush];
   if (callback) {
     callback(@[RCTNullIfNil(errors)]);
   }
@@ -377,7 +661,7 @@ RCT_EXPORT_METHOD(multiRemove:(NSArray *)keys
 
 RCT_EXPORT_METHOD(clear:(RCTResponseSenderBlock)callback)
 {
-  _manifest = [NSMutableDictionary new];
+  [self _reset];
   NSError *error = RCTDeleteStorageDirectory();
   if (callback) {
     callback(@[RCTNullIfNil(error)]);
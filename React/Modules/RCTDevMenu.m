@@ -11,6 +11,7 @@
 
 #import "RCTAssert.h"
 #import "RCTBridge.h"
+#import "RCTBridgeTraffic.h"
 #import "RCTDefines.h"
 #import "RCTEventDispatcher.h"
 #import "RCTKeyCommands.h"
@@ -198,6 +199,18 @@ RCT_EXPORT_MODULE()
       }
     }]];
 
+    [_extraMenuItems addObject:[RCTDevMenuItem toggleItemWithKey:@"showBridgeTraffic"
+                                                 title:@"Show Bridge Traffic"
+                                         selectedTitle:@"Hide Bridge Traffic"
+                                               handler:^(BOOL showBridgeTraffic)
+    {
+      if (showBridgeTraffic) {
+        [weakSelf.bridge.bridgeTraffic show];
+      } else {
+        [weakSelf.bridge.bridgeTraffic hide];
+      }
+    }]];
+
     [_extraMenuItems addObject:[RCTDevMenuItem toggleItemWithKey:@"showInspector"
                                                  title:@"Show Inspector"
                                          selectedTitle:@"Hide Inspector"
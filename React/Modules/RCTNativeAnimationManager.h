@@ -0,0 +1,24 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+#import "RCTBridgeModule.h"
+#import "RCTInvalidating.h"
+
+/**
+ * Runs timing, spring and decay animations described by JS on the main
+ * thread, driving view opacity and transforms from a display link without a
+ * bridge round trip per frame. JS is only called back once an animation
+ * finishes or is stopped, with the final value.
+ */
+@interface RCTNativeAnimationManager : NSObject <RCTBridgeModule, RCTInvalidating>
+
+@end
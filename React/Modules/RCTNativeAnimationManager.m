@@ -0,0 +1,532 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+
+#import "RCTNativeAnimationManager.h"
+
+#import <QuartzCore/QuartzCore.h>
+#import <UIKit/UIKit.h>
+
+#import "RCTBridge.h"
+#import "RCTConvert.h"
+#import "RCTLog.h"
+#import "RCTSparseArray.h"
+#import "RCTUIManager.h"
+#import "UIView+React.h"
+
+typedef NS_ENUM(NSInteger, RCTExtrapolateType) {
+  RCTExtrapolateTypeExtend,
+  RCTExtrapolateTypeIdentity,
+  RCTExtrapolateTypeClamp,
+};
+
+static RCTExtrapolateType RCTExtrapolateTypeFromString(NSString *type)
+{
+  if ([type isEqualToString:@"identity"]) {
+    return RCTExtrapolateTypeIdentity;
+  } else if ([type isEqualToString:@"clamp"]) {
+    return RCTExtrapolateTypeClamp;
+  }
+  return RCTExtrapolateTypeExtend;
+}
+
+/**
+ * Piecewise linear interpolation, matching Interpolation.js for numeric
+ * ranges without easing.
+ */
+@interface RCTAnimationInterpolation : NSObject
+
+- (instancetype)initWithConfig:(NSDictionary *)config NS_DESIGNATED_INITIALIZER;
+- (CGFloat)interpolate:(CGFloat)input;
+
+@end
+
+@implementation RCTAnimationInterpolation
+{
+  NSArray *_inputRange;
+  NSArray *_outputRange;
+  RCTExtrapolateType _extrapolateLeft;
+  RCTExtrapolateType _extrapolateRight;
+}
+
+- (instancetype)initWithConfig:(NSDictionary *)config
+{
+  if ((self = [super init])) {
+    _inputRange = [RCTConvert NSNumberArray:config[@"inputRange"]];
+    _outputRange = [RCTConvert NSNumberArray:config[@"outputRange"]];
+    _extrapolateLeft = RCTExtrapolateTypeFromString(config[@"extrapolateLeft"]);
+    _extrapolateRight = RCTExtrapolateTypeFromString(config[@"extrapolateRight"]);
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (CGFloat)interpolate:(CGFloat)input
+{
+  NSUInteger count = MIN(_inputRange.count, _outputRange.count);
+  if (count < 2) {
+    return count ? [_outputRange[0] doubleValue] : input;
+  }
+
+  // Find the segment, extending the first and last ones beyond the range
+  NSUInteger range = 1;
+  while (range < count - 1 && [_inputRange[range] doubleValue] < input) {
+    range++;
+  }
+  range--;
+
+  CGFloat inputMin = [_inputRange[range] doubleValue];
+  CGFloat inputMax = [_inputRange[range + 1] doubleValue];
+  CGFloat outputMin = [_outputRange[range] doubleValue];
+  CGFloat outputMax = [_outputRange[range + 1] doubleValue];
+
+  CGFloat result = input;
+  if (result < inputMin) {
+    if (_extrapolateLeft == RCTExtrapolateTypeIdentity) {
+      return result;
+    } else if (_extrapolateLeft == RCTExtrapolateTypeClamp) {
+      result = inputMin;
+    }
+  }
+  if (result > inputMax) {
+    if (_extrapolateRight == RCTExtrapolateTypeIdentity) {
+      return result;
+    } else if (_extrapolateRight == RCTExtrapolateTypeClamp) {
+      result = inputMax;
+    }
+  }
+
+  if (outputMin == outputMax) {
+    return outputMin;
+  }
+  if (inputMin == inputMax) {
+    return input <= inputMin ? outputMin : outputMax;
+  }
+  return (result - inputMin) / (inputMax - inputMin) * (outputMax - outputMin) + outputMin;
+}
+
+@end
+
+static CGFloat RCTInterpolateValue(NSArray *interpolations, CGFloat value)
+{
+  for (RCTAnimationInterpolation *interpolation in interpolations) {
+    value = [interpolation interpolate:value];
+  }
+  return value;
+}
+
+static NSArray *RCTInterpolationsFromJSON(NSArray *json)
+{
+  NSMutableArray *interpolations = [NSMutableArray arrayWithCapacity:json.count];
+  for (NSDictionary *config in json) {
+    [interpolations addObject:[[RCTAnimationInterpolation alloc] initWithConfig:config]];
+  }
+  return interpolations;
+}
+
+/**
+ * A view property driven by an animation. Transforms are rebuilt from all of
+ * their operations on every frame, with the animated ones interpolated from
+ * the current value and the rest kept at the value JS sent.
+ */
+@interface RCTAnimationBinding : NSObject
+
+@property (nonatomic, weak) UIView *view;
+
+- (instancetype)initWithJSON:(NSDictionary *)json view:(UIView *)view NS_DESIGNATED_INITIALIZER;
+- (void)applyValue:(CGFloat)value;
+
+@end
+
+@implementation RCTAnimationBinding
+{
+  BOOL _isTransform;
+  NSArray *_interpolations;
+  NSArray *_transformKeys;
+  NSArray *_transformValues;
+  NSArray *_transformInterpolations;
+}
+
+- (instancetype)initWithJSON:(NSDictionary *)json view:(UIView *)view
+{
+  if ((self = [super init])) {
+    _view = view;
+    _isTransform = [json[@"property"] isEqualToString:@"transform"];
+    if (_isTransform) {
+      NSMutableArray *keys = [NSMutableArray new];
+      NSMutableArray *values = [NSMutableArray new];
+      NSMutableArray *interpolations = [NSMutableArray new];
+      for (NSDictionary *operation in [RCTConvert NSDictionaryArray:json[@"transform"]]) {
+        [keys addObject:[RCTConvert NSString:operation[@"key"]]];
+        [values addObject:operation[@"value"] ?: @0];
+        id animated = operation[@"interpolations"];
+        [interpolations addObject:animated ? RCTInterpolationsFromJSON(animated) : [NSNull null]];
+      }
+      _transformKeys = keys;
+      _transformValues = values;
+      _transformInterpolations = interpolations;
+    } else {
+      _interpolations = RCTInterpolationsFromJSON(json[@"interpolations"]);
+    }
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+static CATransform3D RCTTransformOperation(NSString *key, CGFloat value)
+{
+  if ([key isEqualToString:@"translateX"]) {
+    return CATransform3DMakeTranslation(value, 0, 0);
+  } else if ([key isEqualToString:@"translateY"]) {
+    return CATransform3DMakeTranslation(0, value, 0);
+  } else if ([key isEqualToString:@"scale"]) {
+    return CATransform3DMakeScale(value, value, 1);
+  } else if ([key isEqualToString:@"scaleX"]) {
+    return CATransform3DMakeScale(value, 1, 1);
+  } else if ([key isEqualToString:@"scaleY"]) {
+    return CATransform3DMakeScale(1, value, 1);
+  } else if ([key isEqualToString:@"rotate"] || [key isEqualToString:@"rotateZ"]) {
+    return CATransform3DMakeRotation(value, 0, 0, 1);
+  } else if ([key isEqualToString:@"rotateX"]) {
+    return CATransform3DMakeRotation(value, 1, 0, 0);
+  } else if ([key isEqualToString:@"rotateY"]) {
+    return CATransform3DMakeRotation(value, 0, 1, 0);
+  } else if ([key isEqualToString:@"perspective"]) {
+    CATransform3D transform = CATransform3DIdentity;
+    transform.m34 = value ? -1 / value : 0;
+    return transform;
+  }
+  RCTLogError(@"Unsupported natively animated transform %@", key);
+  return CATransform3DIdentity;
+}
+
+- (void)applyValue:(CGFloat)value
+{
+  UIView *view = _view;
+  if (!view) {
+    return;
+  }
+
+  if (!_isTransform) {
+    view.alpha = RCTInterpolateValue(_interpolations, value);
+    return;
+  }
+
+  // Operations apply in the order they are listed, like processTransform
+  CATransform3D transform = CATransform3DIdentity;
+  for (NSUInteger i = 0; i < _transformKeys.count; i++) {
+    id interpolations = _transformInterpolations[i];
+    CGFloat operationValue = interpolations == [NSNull null] ?
+      [_transformValues[i] doubleValue] : RCTInterpolateValue(interpolations, value);
+    transform = CATransform3DConcat(RCTTransformOperation(_transformKeys[i], operationValue), transform);
+  }
+  view.layer.transform = transform;
+  [view reactHitAreaDidChange];
+}
+
+@end
+
+typedef NS_ENUM(NSInteger, RCTNativeAnimationType) {
+  RCTNativeAnimationTypeFrames,
+  RCTNativeAnimationTypeSpring,
+  RCTNativeAnimationTypeDecay,
+};
+
+/**
+ * The state of one running animation. Each type steps the same way its
+ * Animation class in Animated.js does, so switching drivers doesn't change
+ * the motion.
+ */
+@interface RCTNativeAnimation : NSObject
+
+@property (nonatomic, copy, readonly) NSArray *bindings;
+@property (nonatomic, copy, readonly) RCTResponseSenderBlock callback;
+@property (nonatomic, assign, readonly) CGFloat value;
+
+- (instancetype)initWithConfig:(NSDictionary *)config
+                      bindings:(NSArray *)bindings
+                      callback:(RCTResponseSenderBlock)callback NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Advances the animation to the given media time, applies the new value to
+ * the bindings and returns YES once the animation has come to rest.
+ */
+- (BOOL)stepToTime:(CFTimeInterval)time;
+
+@end
+
+@implementation RCTNativeAnimation
+{
+  RCTNativeAnimationType _type;
+  CFTimeInterval _startTime;
+  CGFloat _fromValue;
+
+  // Timing
+  NSArray *_frames;
+  CGFloat _toValue;
+
+  // Spring
+  CGFloat _tension;
+  CGFloat _friction;
+  BOOL _overshootClamping;
+  CGFloat _restDisplacementThreshold;
+  CGFloat _restSpeedThreshold;
+  CGFloat _velocity;
+  CFTimeInterval _lastTime;
+
+  // Decay
+  CGFloat _deceleration;
+}
+
+- (instancetype)initWithConfig:(NSDictionary *)config
+                      bindings:(NSArray *)bindings
+                      callback:(RCTResponseSenderBlock)callback
+{
+  if ((self = [super init])) {
+    _bindings = [bindings copy];
+    _callback = [callback copy];
+    _startTime = -1;
+    _fromValue = [RCTConvert CGFloat:config[@"fromValue"]];
+    _value = _fromValue;
+    _toValue = [RCTConvert CGFloat:config[@"toValue"]];
+    _velocity = [RCTConvert CGFloat:config[@"velocity"]];
+
+    NSString *type = [RCTConvert NSString:config[@"type"]];
+    if ([type isEqualToString:@"spring"]) {
+      _type = RCTNativeAnimationTypeSpring;
+      _tension = [RCTConvert CGFloat:config[@"tension"]];
+      _friction = [RCTConvert CGFloat:config[@"friction"]];
+      _overshootClamping = [RCTConvert BOOL:config[@"overshootClamping"]];
+      _restDisplacementThreshold = [RCTConvert CGFloat:config[@"restDisplacementThreshold"]];
+      _restSpeedThreshold = [RCTConvert CGFloat:config[@"restSpeedThreshold"]];
+    } else if ([type isEqualToString:@"decay"]) {
+      _type = RCTNativeAnimationTypeDecay;
+      _deceleration = [RCTConvert CGFloat:config[@"deceleration"]];
+    } else {
+      _type = RCTNativeAnimationTypeFrames;
+      _frames = [RCTConvert NSNumberArray:config[@"frames"]];
+    }
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (BOOL)stepToTime:(CFTimeInterval)time
+{
+  if (_startTime < 0) {
+    _startTime = time;
+    _lastTime = time;
+  }
+
+  BOOL finished = YES;
+  switch (_type) {
+    case RCTNativeAnimationTypeFrames:
+      finished = [self stepFramesToTime:time];
+      break;
+    case RCTNativeAnimationTypeSpring:
+      finished = [self stepSpringToTime:time];
+      break;
+    case RCTNativeAnimationTypeDecay:
+      finished = [self stepDecayToTime:time];
+      break;
+  }
+
+  for (RCTAnimationBinding *binding in _bindings) {
+    [binding applyValue:_value];
+  }
+  return finished;
+}
+
+- (BOOL)stepFramesToTime:(CFTimeInterval)time
+{
+  // Frames are the eased progress sampled at 60fps by JS
+  NSUInteger frameIndex = (NSUInteger)((time - _startTime) * 60);
+  if (frameIndex + 1 >= _frames.count) {
+    CGFloat progress = _frames.count ? [_frames.lastObject doubleValue] : 1;
+    _value = _fromValue + progress * (_toValue - _fromValue);
+    return YES;
+  }
+  _value = _fromValue + [_frames[frameIndex] doubleValue] * (_toValue - _fromValue);
+  return NO;
+}
+
+- (BOOL)stepSpringToTime:(CFTimeInterval)time
+{
+  // Like SpringAnimation, advance by at most 64ms of fixed 1ms steps
+  CFTimeInterval now = MIN(time, _lastTime + 0.064);
+  NSUInteger numSteps = (NSUInteger)floor((now - _lastTime) * 1000);
+
+  CGFloat position = _value;
+  CGFloat velocity = _velocity;
+  CGFloat tempPosition = position;
+  CGFloat tempVelocity = velocity;
+  const CGFloat step = 0.001;
+  for (NSUInteger i = 0; i < numSteps; i++) {
+    CGFloat aVelocity = velocity;
+    CGFloat aAcceleration = _tension * (_toValue - tempPosition) - _friction * tempVelocity;
+    tempPosition = position + aVelocity * step / 2;
+    tempVelocity = velocity + aAcceleration * step / 2;
+
+    CGFloat bVelocity = tempVelocity;
+    CGFloat bAcceleration = _tension * (_toValue - tempPosition) - _friction * tempVelocity;
+    tempPosition = position + bVelocity * step / 2;
+    tempVelocity = velocity + bAcceleration * step / 2;
+
+    CGFloat cVelocity = tempVelocity;
+    CGFloat cAcceleration = _tension * (_toValue - tempPosition) - _friction * tempVelocity;
+    tempPosition = position + cVelocity * step / 2;
+    tempVelocity = velocity + cAcceleration * step / 2;
+
+    CGFloat dVelocity = tempVelocity;
+    CGFloat dAcceleration = _tension * (_toValue - tempPosition) - _friction * tempVelocity;
+    tempPosition = position + cVelocity * step / 2;
+    tempVelocity = velocity + cAcceleration * step / 2;
+
+    CGFloat dxdt = (aVelocity + 2 * (bVelocity + cVelocity) + dVelocity) / 6;
+    CGFloat dvdt = (aAcceleration + 2 * (bAcceleration + cAcceleration) + dAcceleration) / 6;
+
+    position += dxdt * step;
+    velocity += dvdt * step;
+  }
+  _lastTime = now;
+  _value = position;
+  _velocity = velocity;
+
+  BOOL isOvershooting = NO;
+  if (_overshootClamping && _tension != 0) {
+    isOvershooting = _fromValue < _toValue ? position > _toValue : position < _toValue;
+  }
+  BOOL isVelocity = ABS(velocity) <= _restSpeedThreshold;
+  BOOL isDisplacement = _tension == 0 || ABS(_toValue - position) <= _restDisplacementThreshold;
+  if (isOvershooting || (isVelocity && isDisplacement)) {
+    if (_tension != 0) {
+      // Ensure that we end up with a round value
+      _value = _toValue;
+    }
+    return YES;
+  }
+  return NO;
+}
+
+- (BOOL)stepDecayToTime:(CFTimeInterval)time
+{
+  // Velocity and deceleration are per millisecond
+  CGFloat elapsedMs = (time - _startTime) * 1000;
+  CGFloat value = _fromValue +
+    (_velocity / (1 - _deceleration)) * (1 - exp(-(1 - _deceleration) * elapsedMs));
+  BOOL finished = ABS(_value - value) < 0.1 && elapsedMs > 0;
+  _value = value;
+  return finished;
+}
+
+@end
+
+@implementation RCTNativeAnimationManager
+{
+  // Only accessed on the main thread
+  NSMutableDictionary *_animations;
+  CADisplayLink *_displayLink;
+}
+
+@synthesize bridge = _bridge;
+
+RCT_EXPORT_MODULE()
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _animations = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (dispatch_queue_t)methodQueue
+{
+  // Going through UI blocks keeps animations ordered with the view updates
+  // of the same batch, so a view created in that batch already exists
+  return _bridge.uiManager.methodQueue;
+}
+
+- (void)invalidate
+{
+  dispatch_async(dispatch_get_main_queue(), ^{
+    [_displayLink invalidate];
+    _displayLink = nil;
+    [_animations removeAllObjects];
+  });
+}
+
+RCT_EXPORT_METHOD(startAnimation:(nonnull NSNumber *)animationID
+                  config:(NSDictionary *)config
+                  bindings:(NSArray *)bindings
+                  callback:(RCTResponseSenderBlock)callback)
+{
+  [_bridge.uiManager addUIBlock:^(__unused RCTUIManager *uiManager, RCTSparseArray *viewRegistry) {
+    NSMutableArray *animationBindings = [NSMutableArray arrayWithCapacity:bindings.count];
+    for (NSDictionary *json in bindings) {
+      UIView *view = viewRegistry[json[@"tag"]];
+      if (!view) {
+        RCTLogError(@"Cannot find view with tag #%@ to animate", json[@"tag"]);
+        continue;
+      }
+      [animationBindings addObject:[[RCTAnimationBinding alloc] initWithJSON:json view:view]];
+    }
+
+    [self finishAnimation:animationID finished:NO];
+    _animations[animationID] = [[RCTNativeAnimation alloc] initWithConfig:config
+                                                                 bindings:animationBindings
+                                                                 callback:callback];
+    if (!_displayLink) {
+      _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(didUpdateFrame:)];
+      [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    _displayLink.paused = NO;
+  }];
+}
+
+RCT_EXPORT_METHOD(stopAnimation:(nonnull NSNumber *)animationID)
+{
+  [_bridge.uiManager addUIBlock:^(__unused RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
+    [self finishAnimation:animationID finished:NO];
+  }];
+}
+
+- (void)finishAnimation:(NSNumber *)animationID finished:(BOOL)finished
+{
+  RCTNativeAnimation *animation = _animations[animationID];
+  if (!animation) {
+    return;
+  }
+  [_animations removeObjectForKey:animationID];
+  animation.callback(@[@{@"finished": @(finished), @"value": @(animation.value)}]);
+}
+
+- (void)didUpdateFrame:(CADisplayLink *)displayLink
+{
+  // Aim for the time the frame will be shown, like Core Animation does
+  CFTimeInterval time = displayLink.timestamp + displayLink.duration;
+  NSMutableArray *finishedAnimations = [NSMutableArray new];
+  [_animations enumerateKeysAndObjectsUsingBlock:
+   ^(NSNumber *animationID, RCTNativeAnimation *animation, __unused BOOL *stop) {
+    if ([animation stepToTime:time]) {
+      [finishedAnimations addObject:animationID];
+    }
+  }];
+  for (NSNumber *animationID in finishedAnimations) {
+    [self finishAnimation:animationID finished:YES];
+  }
+  if (!_animations.count) {
+    _displayLink.paused = YES;
+  }
+}
+
+@end
@@ -13,7 +13,14 @@
 
 @interface RCTSourceCode : NSObject <RCTBridgeModule>
 
+/**
+ * The source of the bundle, for symbolication in development builds. Unless
+ * retainsScriptText is set, it isn't kept in memory once it has been
+ * evaluated: bundles loaded from a file are read again when their source is
+ * asked for, and of other bundles only the source map URL is kept.
+ */
 @property (nonatomic, copy) NSString *scriptText;
 @property (nonatomic, copy) NSURL *scriptURL;
+@property (nonatomic, assign) BOOL retainsScriptText;
 
 @end
@@ -14,21 +14,82 @@
 #import "RCTBridge.h"
 #import "RCTUtils.h"
 
+/**
+ * The URL in the last sourceMappingURL comment of the script, resolved against
+ * the script's own URL, like loadSourceMap.js does with the text.
+ */
+static NSString *RCTSourceMappingURLForScript(NSString *script, NSURL *scriptURL)
+{
+  NSRange range = [script rangeOfString:@" sourceMappingURL=" options:NSBackwardsSearch];
+  if (range.location == NSNotFound || range.location == 0) {
+    return nil;
+  }
+  unichar marker = [script characterAtIndex:range.location - 1];
+  if (marker != '#' && marker != '@') {
+    return nil;
+  }
+  NSUInteger start = NSMaxRange(range);
+  NSRange end = [script rangeOfCharacterFromSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]
+                                        options:0
+                                          range:NSMakeRange(start, script.length - start)];
+  NSUInteger length = (end.location == NSNotFound ? script.length : end.location) - start;
+  NSString *mapURL = [script substringWithRange:NSMakeRange(start, length)];
+  return mapURL.length ? [NSURL URLWithString:mapURL relativeToURL:scriptURL].absoluteString : nil;
+}
+
 @implementation RCTSourceCode
+{
+  NSString *_sourceMappingURL;
+}
 
 RCT_EXPORT_MODULE()
 
 @synthesize bridge = _bridge;
+@synthesize scriptText = _scriptText;
+
++ (RCTMethodQueuePriority)methodQueuePriority
+{
+  return RCTMethodQueuePriorityUtility;
+}
+
+#if RCT_DEV
+
+- (void)setScriptText:(NSString *)scriptText
+{
+  _sourceMappingURL = RCTSourceMappingURLForScript(scriptText, self.scriptURL);
+  _scriptText = _retainsScriptText ? [scriptText copy] : nil;
+}
+
+- (NSString *)scriptText
+{
+  if (_scriptText || !self.scriptURL.fileURL) {
+    return _scriptText;
+  }
+  NSData *data = [NSData dataWithContentsOfURL:self.scriptURL
+                                       options:NSDataReadingMappedIfSafe
+                                         error:NULL];
+  return data ? [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] : nil;
+}
+
+#else
 
-#if !RCT_DEV
 - (void)setScriptText:(NSString *)scriptText {}
+
 #endif
 
 RCT_EXPORT_METHOD(getScriptText:(RCTResponseSenderBlock)successCallback
                   failureCallback:(RCTResponseErrorBlock)failureCallback)
 {
-  if (RCT_DEV && self.scriptText && self.scriptURL) {
-    successCallback(@[@{@"text": self.scriptText, @"url": self.scriptURL.absoluteString}]);
+  NSString *scriptText = self.scriptText;
+  if (RCT_DEV && scriptText && self.scriptURL) {
+    successCallback(@[@{@"text": scriptText, @"url": self.scriptURL.absoluteString}]);
+  } else if (RCT_DEV && _sourceMappingURL && self.scriptURL) {
+    // All loadSourceMap.js needs the text for
+    successCallback(@[@{
+      @"text": @"",
+      @"url": self.scriptURL.absoluteString,
+      @"fullSourceMappingURL": _sourceMappingURL,
+    }]);
   } else {
     failureCallback(RCTErrorWithMessage(@"Source code is not available"));
   }
@@ -9,10 +9,13 @@
 
 #import "RCTTiming.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 #import "RCTAssert.h"
 #import "RCTBridge.h"
 #import "RCTLog.h"
 #import "RCTSparseArray.h"
+#import "RCTThreadPriority.h"
 #import "RCTUtils.h"
 
 @interface RCTBridge (Private)
@@ -24,53 +27,66 @@
 
 @end
 
+/**
+ * Timers due within this interval keep the frame observer running, later ones
+ * let it sleep until shortly before they are due.
+ */
+static const NSTimeInterval RCTTimingSleepThreshold = 1.0 / 30.0;
+
+/**
+ * How long before a sleeping timer is due the frame observer is woken up, so
+ * the timer fires on the frame it is due rather than the one after.
+ */
+static const NSTimeInterval RCTTimingWakeUpLeeway = 1.0 / 60.0;
+
 @interface RCTTimer : NSObject
 
-@property (nonatomic, strong, readonly) NSDate *target;
+@property (nonatomic, assign) CFTimeInterval target;
 @property (nonatomic, assign, readonly) BOOL repeats;
 @property (nonatomic, copy, readonly) NSNumber *callbackID;
 @property (nonatomic, assign, readonly) NSTimeInterval interval;
 
+/**
+ * Position of the timer in RCTTiming's heap, or NSNotFound when not in it.
+ */
+@property (nonatomic, assign) NSUInteger heapIndex;
+
 @end
 
 @implementation RCTTimer
 
 - (instancetype)initWithCallbackID:(NSNumber *)callbackID
                           interval:(NSTimeInterval)interval
-                        targetTime:(NSTimeInterval)targetTime
+                        targetTime:(CFTimeInterval)targetTime
                            repeats:(BOOL)repeats
 {
   if ((self = [super init])) {
     _interval = interval;
     _repeats = repeats;
     _callbackID = callbackID;
-    _target = [NSDate dateWithTimeIntervalSinceNow:targetTime];
+    _target = targetTime;
+    _heapIndex = NSNotFound;
   }
   return self;
 }
 
-/**
- * Returns `YES` if we should invoke the JS callback.
- */
-- (BOOL)updateFoundNeedsJSUpdate
-{
-  if (_target && _target.timeIntervalSinceNow <= 0) {
-    // The JS Timers will do fine grained calculating of expired timeouts.
-    _target = _repeats ? [NSDate dateWithTimeIntervalSinceNow:_interval] : nil;
-    return YES;
-  }
-  return NO;
-}
-
 @end
 
 @implementation RCTTiming
 {
   RCTSparseArray *_timers;
+
+  /**
+   * Binary min-heap of the timers in _timers, ordered by target time, so that
+   * a frame only has to look at the timers that are due.
+   */
+  NSMutableArray *_timerHeap;
+  NSTimer *_wakeUpTimer;
 }
 
 @synthesize bridge = _bridge;
 @synthesize paused = _paused;
+@synthesize pauseCallback = _pauseCallback;
 
 RCT_EXPORT_MODULE()
 
@@ -79,6 +95,7 @@ RCT_EXPORT_MODULE()
   if ((self = [super init])) {
     _paused = YES;
     _timers = [RCTSparseArray new];
+    _timerHeap = [NSMutableArray new];
 
     for (NSString *name in @[UIApplicationWillResignActiveNotification,
                              UIApplicationDidEnterBackgroundNotification,
@@ -105,6 +122,9 @@ RCT_EXPORT_MODULE()
 - (void)dealloc
 {
   [[NSNotificationCenter defaultCenter] removeObserver:self];
+  if (!_paused) {
+    RCTEndInteraction();
+  }
 }
 
 - (dispatch_queue_t)methodQueue
@@ -115,12 +135,30 @@ RCT_EXPORT_MODULE()
 - (void)invalidate
 {
   [self stopTimers];
+  [_wakeUpTimer invalidate];
+  _wakeUpTimer = nil;
   _bridge = nil;
 }
 
+- (void)setPaused:(BOOL)paused
+{
+  if (_paused != paused) {
+    _paused = paused;
+    // Timers due every frame are most likely driving an animation
+    if (paused) {
+      RCTEndInteraction();
+    } else {
+      RCTBeginInteraction();
+    }
+    if (_pauseCallback) {
+      _pauseCallback();
+    }
+  }
+}
+
 - (void)stopTimers
 {
-  _paused = YES;
+  self.paused = YES;
 }
 
 - (void)startTimers
@@ -129,29 +167,148 @@ RCT_EXPORT_MODULE()
     return;
   }
 
-  _paused = NO;
+  self.paused = NO;
 }
 
-- (void)didUpdateFrame:(__unused RCTFrameUpdate *)update
+#pragma mark - Timer heap
+
+- (void)swapTimerAtIndex:(NSUInteger)i withTimerAtIndex:(NSUInteger)j
 {
-  NSMutableArray *timersToCall = [NSMutableArray new];
-  for (RCTTimer *timer in _timers.allObjects) {
-    if ([timer updateFoundNeedsJSUpdate]) {
-      [timersToCall addObject:timer.callbackID];
+  [_timerHeap exchangeObjectAtIndex:i withObjectAtIndex:j];
+  ((RCTTimer *)_timerHeap[i]).heapIndex = i;
+  ((RCTTimer *)_timerHeap[j]).heapIndex = j;
+}
+
+- (void)siftUpTimerAtIndex:(NSUInteger)index
+{
+  while (index > 0) {
+    NSUInteger parent = (index - 1) / 2;
+    if (((RCTTimer *)_timerHeap[parent]).target <= ((RCTTimer *)_timerHeap[index]).target) {
+      break;
     }
-    if (!timer.target) {
-      _timers[timer.callbackID] = nil;
+    [self swapTimerAtIndex:index withTimerAtIndex:parent];
+    index = parent;
+  }
+}
+
+- (void)siftDownTimerAtIndex:(NSUInteger)index
+{
+  NSUInteger count = _timerHeap.count;
+  while (YES) {
+    NSUInteger smallest = index;
+    for (NSUInteger child = 2 * index + 1; child <= 2 * index + 2 && child < count; child++) {
+      if (((RCTTimer *)_timerHeap[child]).target < ((RCTTimer *)_timerHeap[smallest]).target) {
+        smallest = child;
+      }
+    }
+    if (smallest == index) {
+      break;
     }
+    [self swapTimerAtIndex:index withTimerAtIndex:smallest];
+    index = smallest;
+  }
+}
+
+- (void)addTimerToHeap:(RCTTimer *)timer
+{
+  timer.heapIndex = _timerHeap.count;
+  [_timerHeap addObject:timer];
+  [self siftUpTimerAtIndex:timer.heapIndex];
+}
+
+- (void)removeTimerFromHeap:(RCTTimer *)timer
+{
+  NSUInteger index = timer.heapIndex;
+  if (index == NSNotFound) {
+    return;
   }
 
-  // call timers that need to be called
-  if (timersToCall.count > 0) {
-    [_bridge enqueueJSCall:@"JSTimersExecution.callTimers" args:@[timersToCall]];
+  NSUInteger lastIndex = _timerHeap.count - 1;
+  if (index != lastIndex) {
+    [self swapTimerAtIndex:index withTimerAtIndex:lastIndex];
   }
+  [_timerHeap removeLastObject];
+  timer.heapIndex = NSNotFound;
 
-  if (_timers.count == 0) {
+  if (index < _timerHeap.count) {
+    [self siftDownTimerAtIndex:index];
+    [self siftUpTimerAtIndex:index];
+  }
+}
+
+#pragma mark - Scheduling
+
+/**
+ * Keeps the frame observer running while the earliest timer is about to be
+ * due, otherwise pauses it and sets up a wake-up just before that timer.
+ */
+- (void)scheduleNextFrameUpdate
+{
+  [_wakeUpTimer invalidate];
+  _wakeUpTimer = nil;
+
+  RCTTimer *nextTimer = _timerHeap.firstObject;
+  if (!nextTimer) {
     [self stopTimers];
+    return;
+  }
+
+  NSTimeInterval delay = nextTimer.target - CACurrentMediaTime();
+  if (delay <= RCTTimingSleepThreshold) {
+    [self startTimers];
+    return;
   }
+
+  self.paused = YES;
+  // The timer is added to the run loop of the JS thread, which we're on.
+  _wakeUpTimer = [NSTimer timerWithTimeInterval:delay - RCTTimingWakeUpLeeway
+                                         target:self
+                                       selector:@selector(wakeUp)
+                                       userInfo:nil
+                                        repeats:NO];
+  [[NSRunLoop currentRunLoop] addTimer:_wakeUpTimer forMode:NSRunLoopCommonModes];
+}
+
+- (void)wakeUp
+{
+  _wakeUpTimer = nil;
+  [self startTimers];
+}
+
+- (void)didUpdateFrame:(__unused RCTFrameUpdate *)update
+{
+  CFTimeInterval now = CACurrentMediaTime();
+
+  // Collect every due timer before rescheduling the repeating ones, so that a
+  // timer repeating every frame isn't popped again within the same frame
+  NSMutableArray *dueTimers = [NSMutableArray new];
+  RCTTimer *timer;
+  while ((timer = _timerHeap.firstObject) && timer.target <= now) {
+    [self removeTimerFromHeap:timer];
+    [dueTimers addObject:timer];
+  }
+
+  if (dueTimers.count == 0) {
+    [self scheduleNextFrameUpdate];
+    return;
+  }
+
+  NSMutableArray *timersToCall = [NSMutableArray arrayWithCapacity:dueTimers.count];
+  for (timer in dueTimers) {
+    [timersToCall addObject:timer.callbackID];
+    // The JS Timers will do fine grained calculating of expired timeouts.
+    if (timer.repeats) {
+      timer.target = now + timer.interval;
+      [self addTimerToHeap:timer];
+    } else {
+      _timers[timer.callbackID] = nil;
+    }
+  }
+
+  // call all due timers in one go
+  [_bridge enqueueJSCall:@"JSTimersExecution.callTimers" args:@[timersToCall]];
+
+  [self scheduleNextFrameUpdate];
 }
 
 /**
@@ -182,7 +339,7 @@ RCT_EXPORT_METHOD(createTimer:(nonnull NSNumber *)callbackID
     jsSchedulingOverhead = 0;
   }
 
-  NSTimeInterval targetTime = jsDuration - jsSchedulingOverhead;
+  CFTimeInterval targetTime = CACurrentMediaTime() + jsDuration - jsSchedulingOverhead;
   if (jsDuration < 0.018) { // Make sure short intervals run each frame
     jsDuration = 0;
   }
@@ -191,15 +348,23 @@ RCT_EXPORT_METHOD(createTimer:(nonnull NSNumber *)callbackID
                                                 interval:jsDuration
                                               targetTime:targetTime
                                                  repeats:repeats];
+  [self removeTimerFromHeap:_timers[callbackID]];
   _timers[callbackID] = timer;
-  [self startTimers];
+  [self addTimerToHeap:timer];
+  [self scheduleNextFrameUpdate];
 }
 
 RCT_EXPORT_METHOD(deleteTimer:(nonnull NSNumber *)timerID)
 {
+  RCTTimer *timer = _timers[timerID];
+  if (!timer) {
+    return;
+  }
+
+  [self removeTimerFromHeap:timer];
   _timers[timerID] = nil;
   if (_timers.count == 0) {
-    [self stopTimers];
+    [self scheduleNextFrameUpdate];
   }
 }
 
@@ -39,6 +39,17 @@ RCT_EXTERN NSString *const RCTUIManagerRootViewKey;
 
 @protocol RCTScrollableProtocol;
 
+/**
+ * Receives the stats of a UI batch once its UI blocks have run on the main
+ * thread. The dictionary contains:
+ *
+ * - layout: one entry per root view, with rootTag, duration (seconds),
+ *   visitedNodes and relaidOutNodes
+ * - createdViews, updatedViews, removedViews: shadow view counts
+ * - uiBlockCount, uiBlockDuration (seconds): the main thread part of the batch
+ */
+typedef void (^RCTUIManagerBatchStatsBlock)(NSDictionary *stats);
+
 /**
  * The RCTUIManager is the module responsible for updating the view hierarchy.
  */
@@ -57,6 +68,12 @@ RCT_EXTERN NSString *const RCTUIManagerRootViewKey;
  */
 @property (nonatomic, readwrite, weak) id<UIScrollViewDelegate> nativeMainScrollDelegate;
 
+/**
+ * Called on the main thread after each batch. Stats are only gathered while
+ * this is set or the profiler is running, so leave it nil in production.
+ */
+@property (atomic, copy) RCTUIManagerBatchStatsBlock batchStatsBlock;
+
 /**
  * Register a root view with the RCTUIManager.
  */
@@ -79,6 +96,13 @@ RCT_EXTERN NSString *const RCTUIManagerRootViewKey;
  */
 - (void)setBackgroundColor:(UIColor *)color forRootView:(UIView *)rootView;
 
+/**
+ * Tells the UIManager whether a root view is on screen, usually when it moves
+ * to or from a window. Roots that aren't on screen are still updated, but
+ * their layout is put off so that it doesn't hold up the visible roots.
+ */
+- (void)setVisible:(BOOL)visible forRootView:(UIView *)rootView;
+
 /**
  * Schedule a block to be executed on the UI thread. Useful if you need to execute
  * view logic after all currently queued view updates have completed.
@@ -21,12 +21,18 @@
 #import "RCTConvert.h"
 #import "RCTDefines.h"
 #import "RCTEventDispatcher.h"
+#import "RCTFrameTiming.h"
+#import "RCTInputLatency.h"
 #import "RCTLog.h"
+#import "RCTMemoryBudget.h"
+#import "RCTModuleData.h"
+#import "RCTPerformanceLogger.h"
 #import "RCTProfile.h"
 #import "RCTRootView.h"
 #import "RCTScrollableProtocol.h"
 #import "RCTShadowView.h"
 #import "RCTSparseArray.h"
+#import "RCTThreadPriority.h"
 #import "RCTUtils.h"
 #import "RCTView.h"
 #import "RCTViewManager.h"
@@ -176,6 +182,307 @@ static UIViewAnimationOptions UIViewAnimationOptionsFromRCTAnimationType(RCTAnim
 
 @end
 
+typedef struct {
+  NSUInteger toIndex;
+  NSUInteger fromIndex; // NSNotFound for added children
+  NSUInteger reactTag;
+  NSUInteger order;
+} RCTChildInsertion;
+
+static int RCTCompareChildInsertions(const void *a, const void *b)
+{
+  const RCTChildInsertion *lhs = a, *rhs = b;
+  if (lhs->toIndex != rhs->toIndex) {
+    return lhs->toIndex < rhs->toIndex ? -1 : 1;
+  }
+  return lhs->order < rhs->order ? -1 : (lhs->order > rhs->order);
+}
+
+// The first layouts of a root look for a snapshot of the measurements of the
+// same tree from an earlier launch, until one is used or written
+static const NSUInteger RCTLayoutSnapshotMaxAttempts = 3;
+
+/**
+ * How long the layout of root views that aren't in a window, like the tabs
+ * that aren't selected, is put off after an update. Updates that arrive in the
+ * meantime are laid out together, and a root that moves to a window is laid
+ * out straight away.
+ */
+static const NSTimeInterval RCTOffscreenRootViewLayoutDelay = 0.5;
+static const NSUInteger RCTLayoutSnapshotMaxCount = 64;
+
+/**
+ * Measurements depend on the fonts of the OS and on the native code that
+ * measures, so snapshots are kept apart for each build of the app and OS
+ * version. Not in dev, where native code changes without the version being
+ * bumped.
+ */
+static NSString *RCTLayoutSnapshotsDirectory(void)
+{
+  static NSString *directory;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSDictionary *infoDictionary = [NSBundle mainBundle].infoDictionary;
+    NSString *version = infoDictionary[@"CFBundleShortVersionString"];
+    NSString *build = infoDictionary[@"CFBundleVersion"];
+    if (RCT_DEV || !version || !build) {
+      return;
+    }
+    NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    NSString *snapshotsDirectory = [cachesDirectory stringByAppendingPathComponent:@"React/RCTLayoutSnapshots"];
+    NSString *buildName = RCTMD5Hash([NSString stringWithFormat:@"%@ (%@) %@", version, build,
+                                      [UIDevice currentDevice].systemVersion]);
+    directory = [snapshotsDirectory stringByAppendingPathComponent:buildName];
+
+    // Snapshots of other builds will never be read again
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *name in [fileManager contentsOfDirectoryAtPath:snapshotsDirectory error:NULL]) {
+      if (![name isEqualToString:buildName]) {
+        [fileManager removeItemAtPath:[snapshotsDirectory stringByAppendingPathComponent:name] error:NULL];
+      }
+    }
+    [fileManager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:NULL];
+  });
+  return directory;
+}
+
+static NSString *RCTLayoutSnapshotPath(uint64_t hash)
+{
+  return [RCTLayoutSnapshotsDirectory() stringByAppendingPathComponent:
+          [NSString stringWithFormat:@"%016llx", (unsigned long long)hash]];
+}
+
+static void RCTWriteLayoutSnapshot(NSData *snapshot, uint64_t hash)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.LayoutSnapshotQueue", DISPATCH_QUEUE_SERIAL);
+    dispatch_set_target_queue(queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
+  });
+  dispatch_async(queue, ^{
+    NSString *directory = RCTLayoutSnapshotsDirectory();
+    if (!directory || ![snapshot writeToFile:RCTLayoutSnapshotPath(hash) atomically:YES]) {
+      return;
+    }
+
+    // Keep the most recently written ones
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSArray *names = [fileManager contentsOfDirectoryAtPath:directory error:NULL];
+    if (names.count <= RCTLayoutSnapshotMaxCount) {
+      return;
+    }
+    NSMutableArray *files = [NSMutableArray arrayWithCapacity:names.count];
+    for (NSString *name in names) {
+      NSString *path = [directory stringByAppendingPathComponent:name];
+      NSDate *date = [fileManager attributesOfItemAtPath:path error:NULL].fileModificationDate;
+      [files addObject:@[date ?: [NSDate distantPast], path]];
+    }
+    [files sortUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b) {
+      return [a[0] compare:b[0]];
+    }];
+    for (NSUInteger i = 0; i < files.count - RCTLayoutSnapshotMaxCount; i++) {
+      [fileManager removeItemAtPath:files[i][1] error:NULL];
+    }
+  });
+}
+
+/**
+ * The arguments of a manageChildren call, sorted and deduplicated once on the
+ * shadow queue and then applied to both the shadow and the view tree.
+ */
+@interface RCTChildMutationPlan : NSObject
+
+- (instancetype)initWithMoveFromIndices:(NSArray *)moveFromIndices
+                          moveToIndices:(NSArray *)moveToIndices
+                      addChildReactTags:(NSArray *)addChildReactTags
+                           addAtIndices:(NSArray *)addAtIndices
+                        removeAtIndices:(NSArray *)removeAtIndices;
+
+/**
+ * Returns the children that were removed for good.
+ */
+- (NSArray *)applyToContainer:(id<RCTComponent>)container registry:(RCTSparseArray *)registry;
+
+@end
+
+@implementation RCTChildMutationPlan
+{
+  NSIndexSet *_permanentlyRemovedIndices;
+  NSIndexSet *_removedIndices;
+  NSData *_insertions;
+}
+
+- (instancetype)initWithMoveFromIndices:(NSArray *)moveFromIndices
+                          moveToIndices:(NSArray *)moveToIndices
+                      addChildReactTags:(NSArray *)addChildReactTags
+                           addAtIndices:(NSArray *)addAtIndices
+                        removeAtIndices:(NSArray *)removeAtIndices
+{
+  RCTAssert(moveFromIndices.count == moveToIndices.count, @"moveFromIndices had size %tu, moveToIndices had size %tu", moveFromIndices.count, moveToIndices.count);
+  RCTAssert(addChildReactTags.count == addAtIndices.count, @"there should be at least one React child to add");
+
+  if ((self = [super init])) {
+    NSMutableIndexSet *permanentlyRemovedIndices = [NSMutableIndexSet new];
+    for (NSNumber *index in removeAtIndices) {
+      [permanentlyRemovedIndices addIndex:index.unsignedIntegerValue];
+    }
+    NSMutableIndexSet *removedIndices = [permanentlyRemovedIndices mutableCopy];
+    for (NSNumber *index in moveFromIndices) {
+      [removedIndices addIndex:index.unsignedIntegerValue];
+    }
+    _permanentlyRemovedIndices = permanentlyRemovedIndices;
+    _removedIndices = removedIndices;
+
+    // Moves come before adds, so an add wins when both target the same index
+    NSUInteger moveCount = moveToIndices.count;
+    NSUInteger count = moveCount + addAtIndices.count;
+    NSMutableData *insertionData = [NSMutableData dataWithLength:count * sizeof(RCTChildInsertion)];
+    RCTChildInsertion *insertions = insertionData.mutableBytes;
+    for (NSUInteger i = 0; i < moveCount; i++) {
+      insertions[i] = (RCTChildInsertion){
+        [moveToIndices[i] unsignedIntegerValue],
+        [moveFromIndices[i] unsignedIntegerValue],
+        0,
+        i,
+      };
+    }
+    for (NSUInteger i = moveCount; i < count; i++) {
+      insertions[i] = (RCTChildInsertion){
+        [addAtIndices[i - moveCount] unsignedIntegerValue],
+        NSNotFound,
+        [addChildReactTags[i - moveCount] unsignedIntegerValue],
+        i,
+      };
+    }
+    qsort(insertions, count, sizeof(RCTChildInsertion), RCTCompareChildInsertions);
+
+    NSUInteger uniqueCount = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+      if (uniqueCount > 0 && insertions[uniqueCount - 1].toIndex == insertions[i].toIndex) {
+        uniqueCount--;
+      }
+      insertions[uniqueCount++] = insertions[i];
+    }
+    insertionData.length = uniqueCount * sizeof(RCTChildInsertion);
+    _insertions = insertionData;
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (NSArray *)applyToContainer:(id<RCTComponent>)container registry:(RCTSparseArray *)registry
+{
+  RCTAssert(container != nil, @"container view not found");
+
+  // The current children have to be read up front, before any index moves
+  NSArray *oldChildren = [[container reactSubviews] copy];
+  NSUInteger oldCount = oldChildren.count;
+  if (_removedIndices.lastIndex != NSNotFound && _removedIndices.lastIndex >= oldCount) {
+    RCTLogMustFix(@"Cannot remove child at index %tu from a container with %tu children",
+                  _removedIndices.lastIndex, oldCount);
+  }
+
+  const RCTChildInsertion *insertions = _insertions.bytes;
+  NSUInteger insertionCount = _insertions.length / sizeof(RCTChildInsertion);
+  NSMutableArray *insertedChildren = [NSMutableArray arrayWithCapacity:insertionCount];
+  for (NSUInteger i = 0; i < insertionCount; i++) {
+    NSUInteger fromIndex = insertions[i].fromIndex;
+    id child = fromIndex == NSNotFound ? RCTSparseArrayGet(registry, insertions[i].reactTag) :
+      fromIndex < oldCount ? oldChildren[fromIndex] : nil;
+    [insertedChildren addObject:child ?: (id)kCFNull];
+  }
+
+  NSMutableArray *removedChildren = [NSMutableArray arrayWithCapacity:_permanentlyRemovedIndices.count];
+  [_permanentlyRemovedIndices enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+    if (index >= oldCount) {
+      *stop = YES;
+      return;
+    }
+    [removedChildren addObject:oldChildren[index]];
+  }];
+
+  if ([container respondsToSelector:@selector(reactSetSubviews:)]) {
+    // Merge the children that stay with the inserted ones in a single pass
+    NSMutableArray *newChildren = [NSMutableArray arrayWithCapacity:oldCount + insertionCount];
+    NSUInteger oldIndex = 0;
+    for (NSUInteger i = 0; i < insertionCount; i++) {
+      while (newChildren.count < insertions[i].toIndex && oldIndex < oldCount) {
+        if (![_removedIndices containsIndex:oldIndex]) {
+          [newChildren addObject:oldChildren[oldIndex]];
+        }
+        oldIndex++;
+      }
+      if (insertedChildren[i] != (id)kCFNull) {
+        [newChildren addObject:insertedChildren[i]];
+      }
+    }
+    for (; oldIndex < oldCount; oldIndex++) {
+      if (![_removedIndices containsIndex:oldIndex]) {
+        [newChildren addObject:oldChildren[oldIndex]];
+      }
+    }
+    [container reactSetSubviews:newChildren];
+  } else {
+    // Removes (both permanent and temporary moves) are using "before"
+    // indices, so go from the last one
+    [_removedIndices enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger index, __unused BOOL *stop) {
+      if (index < oldCount) {
+        [container removeReactSubview:oldChildren[index]];
+      }
+    }];
+    for (NSUInteger i = 0; i < insertionCount; i++) {
+      if (insertedChildren[i] != (id)kCFNull) {
+        [container insertReactSubview:insertedChildren[i] atIndex:insertions[i].toIndex];
+      }
+    }
+  }
+  return removedChildren;
+}
+
+@end
+
+/**
+ * The UI blocks of one flushed batch, waiting for the display link tick that
+ * commits them.
+ */
+@interface RCTUIManagerCommit : NSObject
+
+@property (nonatomic, copy, readonly) NSArray *blocks;
+@property (nonatomic, copy, readonly) NSDictionary *stats;
+@property (nonatomic, copy, readonly) RCTUIManagerBatchStatsBlock statsBlock;
+@property (nonatomic, assign, readonly) NSUInteger layoutGeneration;
+@property (nonatomic, copy, readonly) NSArray<RCTInputFlow *> *inputFlows;
+
+@end
+
+@implementation RCTUIManagerCommit
+
+- (instancetype)initWithBlocks:(NSArray *)blocks
+                         stats:(NSDictionary *)stats
+                    statsBlock:(RCTUIManagerBatchStatsBlock)statsBlock
+              layoutGeneration:(NSUInteger)layoutGeneration
+                    inputFlows:(NSArray<RCTInputFlow *> *)inputFlows
+{
+  if ((self = [super init])) {
+    _blocks = [blocks copy];
+    _stats = [stats copy];
+    _statsBlock = [statsBlock copy];
+    _layoutGeneration = layoutGeneration;
+    _inputFlows = [inputFlows copy];
+  }
+  return self;
+}
+
+@end
+
+@interface RCTBridge (RCTLazyModuleConfig)
+
+- (BOOL)usesLazyModuleConfig;
+
+@end
+
 @interface RCTUIManager ()
 
 // NOTE: these are properties so that they can be accessed by unit tests
@@ -191,17 +498,57 @@ static UIViewAnimationOptions UIViewAnimationOptionsFromRCTAnimationType(RCTAnim
 
   // Root views are only mutated on the shadow queue
   NSMutableSet *_rootViewTags;
+  NSMutableSet *_offscreenRootViewTags;
+  BOOL _offscreenLayoutScheduled;
   NSMutableArray *_pendingUIBlocks;
   NSLock *_pendingUIBlocksLock;
 
+  // Flushed batches wait for the next display link tick, guarded by
+  // _pendingUIBlocksLock. Layout blocks are numbered as they're built, and
+  // _latestLayoutGenerationByTag has the newest one that sets each view's frame
+  NSMutableArray *_pendingCommits;
+  BOOL _commitScheduled;
+  NSUInteger _layoutGeneration;
+  NSMutableDictionary *_latestLayoutGenerationByTag;
+  // The layout generations after which a block that may read frames was
+  // added. A layout is only superseded by a later one if none is in between.
+  NSMutableIndexSet *_frameReadGenerations;
+
+  // The number of layouts of each root that looked for a layout snapshot,
+  // shadow queue only
+  NSMutableDictionary *_layoutSnapshotAttemptsByRootTag;
+
+  CADisplayLink *_commitDisplayLink; // Main thread only
+  NSUInteger _committingLayoutGeneration; // Main thread only
+
   // Animation
   RCTLayoutAnimation *_nextLayoutAnimation; // RCT thread only
   RCTLayoutAnimation *_layoutAnimation; // Main thread only
 
   // Keyed by viewName
   NSDictionary *_componentDataByName;
+  NSArray *_recyclingComponentData;
+
+  // Component viewConfigs, also keyed by viewName, and loaded from disk for
+  // the current app version. Guarded by _viewConfigsLock.
+  NSMutableDictionary *_viewConfigs;
+  NSLock *_viewConfigsLock;
+  BOOL _viewConfigsChanged;
+
+  // The constants of the managers that export some, gathered on the main
+  // thread with the UIManager's own
+  NSDictionary *_viewManagerConstants;
 
   NSMutableSet *_bridgeTransactionListeners;
+
+  // Measurements that arrived while layout was dirty, answered once the batch
+  // has been laid out. Shadow queue only.
+  NSMutableArray *_pendingMeasureBlocks;
+
+  // Batch stats, shadow queue only
+  NSUInteger _createdViewCount;
+  NSUInteger _updatedViewCount;
+  NSUInteger _removedViewCount;
 }
 
 @synthesize bridge = _bridge;
@@ -218,22 +565,37 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
   if ((self = [super init])) {
 
     _shadowQueue = dispatch_queue_create("com.facebook.React.ShadowQueue", DISPATCH_QUEUE_SERIAL);
+    RCTRegisterInteractiveQueue(_shadowQueue, RCTBridgeThreadPriority(RCTBridgeThreadShadow));
 
     _pendingUIBlocksLock = [NSLock new];
+    _viewConfigsLock = [NSLock new];
 
     _shadowViewRegistry = [RCTSparseArray new];
     _viewRegistry = [RCTSparseArray new];
 
     // Internal resources
     _pendingUIBlocks = [NSMutableArray new];
+    _pendingCommits = [NSMutableArray new];
+    _latestLayoutGenerationByTag = [NSMutableDictionary new];
+    _frameReadGenerations = [NSMutableIndexSet new];
     _rootViewTags = [NSMutableSet new];
+    _offscreenRootViewTags = [NSMutableSet new];
 
     _bridgeTransactionListeners = [NSMutableSet new];
+    _pendingMeasureBlocks = [NSMutableArray new];
 
     [[NSNotificationCenter defaultCenter] addObserver:self
                                              selector:@selector(didReceiveNewContentSizeMultiplier)
                                                  name:RCTAccessibilityManagerDidUpdateMultiplierNotification
                                                object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(sampleProfileCounters)
+                                                 name:RCTProfileWillSampleCounters
+                                               object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(commitPendingUIBlocks)
+                                                 name:UIApplicationDidEnterBackgroundNotification
+                                               object:nil];
   }
   return self;
 }
@@ -243,6 +605,19 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
   [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
+- (void)sampleProfileCounters
+{
+  // Posted on the main thread, which owns the view registry
+  NSUInteger viewCount = _viewRegistry.count;
+  dispatch_async(_shadowQueue, ^{
+    RCTProfileCounterEvent(0, @"views", (@{
+      @"views": @(viewCount),
+      @"shadow_views": @(_shadowViewRegistry.count),
+      @"root_views": @(_rootViewTags.count),
+    }));
+  });
+}
+
 - (void)didReceiveNewContentSizeMultiplier
 {
   __weak RCTUIManager *weakSelf = self;
@@ -262,19 +637,26 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
    * Called on the JS Thread since all modules are invalidated on the JS thread
    */
 
+  RCTUnregisterInteractiveQueue(_shadowQueue);
+
   dispatch_async(dispatch_get_main_queue(), ^{
     for (NSNumber *rootViewTag in _rootViewTags) {
       [_viewRegistry[rootViewTag] invalidate];
     }
 
     _rootViewTags = nil;
+    _offscreenRootViewTags = nil;
     _shadowViewRegistry = nil;
     _viewRegistry = nil;
     _bridgeTransactionListeners = nil;
     _bridge = nil;
 
+    [_commitDisplayLink invalidate];
+    _commitDisplayLink = nil;
+
     [_pendingUIBlocksLock lock];
     _pendingUIBlocks = nil;
+    _pendingCommits = nil;
     [_pendingUIBlocksLock unlock];
   });
 }
@@ -288,14 +670,20 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
 
   // Get view managers from bridge
   NSMutableDictionary *componentDataByName = [NSMutableDictionary new];
+  NSMutableArray *recyclingComponentData = [NSMutableArray new];
   for (RCTViewManager *manager in _bridge.modules.allValues) {
     if ([manager isKindOfClass:[RCTViewManager class]]) {
       RCTComponentData *componentData = [[RCTComponentData alloc] initWithManager:manager];
       componentDataByName[componentData.name] = componentData;
+      if (componentData.recyclesViews) {
+        [recyclingComponentData addObject:componentData];
+        [_bridge.memoryBudget registerConsumer:componentData priority:RCTMemoryPriorityLow];
+      }
     }
   }
 
   _componentDataByName = [componentDataByName copy];
+  _recyclingComponentData = [recyclingComponentData copy];
 }
 
 - (dispatch_queue_t)methodQueue
@@ -318,6 +706,7 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
   // Register view
   _viewRegistry[reactTag] = rootView;
   CGRect frame = rootView.frame;
+  BOOL offscreen = rootView.window == nil;
 
   // Register shadow view
   __weak RCTUIManager *weakSelf = self;
@@ -333,6 +722,9 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
     shadowView.viewName = NSStringFromClass([rootView class]);
     strongSelf->_shadowViewRegistry[shadowView.reactTag] = shadowView;
     [strongSelf->_rootViewTags addObject:reactTag];
+    if (offscreen) {
+      [strongSelf->_offscreenRootViewTags addObject:reactTag];
+    }
   });
 
   [[NSNotificationCenter defaultCenter] postNotificationName:RCTUIManagerDidRegisterRootViewNotification
@@ -382,27 +774,82 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
   });
 }
 
+- (void)setVisible:(BOOL)visible forRootView:(UIView *)rootView
+{
+  RCTAssertMainThread();
+
+  NSNumber *reactTag = rootView.reactTag;
+  RCTAssert(RCTIsReactRootView(reactTag), @"Specified view %@ is not a root view", reactTag);
+
+  __weak RCTUIManager *weakSelf = self;
+  dispatch_async(_shadowQueue, ^{
+    RCTUIManager *strongSelf = weakSelf;
+    if (!_viewRegistry || ![strongSelf->_rootViewTags containsObject:reactTag]) {
+      return;
+    }
+    if (!visible) {
+      [strongSelf->_offscreenRootViewTags addObject:reactTag];
+      return;
+    }
+    [strongSelf->_offscreenRootViewTags removeObject:reactTag];
+
+    // Catch up on the layout that was put off while the root was offscreen
+    if ([strongSelf->_shadowViewRegistry[reactTag] isLayoutDirty]) {
+      [strongSelf batchDidComplete];
+    }
+  });
+}
+
 /**
  * Unregisters views from registries
  */
 - (void)_purgeChildren:(NSArray *)children fromRegistry:(RCTSparseArray *)registry
 {
+  // Views are only recycled once the whole subtree has been traversed, since
+  // recycling a view detaches its subviews
+  NSMutableArray *purgedViews =
+    (registry == _viewRegistry && _recyclingComponentData.count) ? [NSMutableArray new] : nil;
+
   for (id<RCTComponent> child in children) {
-    RCTTraverseViewNodes(registry[child.reactTag], ^(id<RCTComponent> subview) {
+    RCTTraverseViewNodes(RCTSparseArrayGet(registry, child.reactTag.unsignedIntegerValue), ^(id<RCTComponent> subview) {
       RCTAssert(![subview isReactRootView], @"Root views should not be unregistered");
       if ([subview conformsToProtocol:@protocol(RCTInvalidating)]) {
         [(id<RCTInvalidating>)subview invalidate];
       }
+      if (registry == _shadowViewRegistry) {
+        [_componentDataByName[((RCTShadowView *)subview).viewName] forgetPreparedPropsForViewWithTag:subview.reactTag];
+        _removedViewCount++;
+      }
       registry[subview.reactTag] = nil;
 
       if (registry == _viewRegistry) {
         [_bridgeTransactionListeners removeObject:subview];
+        [purgedViews addObject:subview];
       }
     });
   }
+
+  for (id<RCTComponent> view in purgedViews) {
+    for (RCTComponentData *componentData in _recyclingComponentData) {
+      if ([componentData recycleView:view]) {
+        break;
+      }
+    }
+  }
 }
 
 - (void)addUIBlock:(RCTViewManagerUIBlock)block
+{
+  [self _addUIBlock:block readsFrames:YES];
+}
+
+/**
+ * Blocks added through addUIBlock: may measure views, or otherwise depend on
+ * their frames, so they're assumed to. The blocks that only create, update or
+ * rearrange views pass NO, so they don't keep an earlier layout from being
+ * superseded.
+ */
+- (void)_addUIBlock:(RCTViewManagerUIBlock)block readsFrames:(BOOL)readsFrames
 {
   RCTAssertThread(_shadowQueue,
                   @"-[RCTUIManager addUIBlock:] should only be called from the "
@@ -426,9 +873,40 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
 
   [_pendingUIBlocksLock lock];
   [_pendingUIBlocks addObject:outerBlock];
+  if (readsFrames) {
+    [_frameReadGenerations addIndex:_layoutGeneration];
+  }
   [_pendingUIBlocksLock unlock];
 }
 
+/**
+ * Returns the indices of the frames that a later layout block, committed in
+ * the same tick, sets again with no block that may read frames in between,
+ * and forgets the views this block is the latest layout for.
+ */
+- (NSIndexSet *)_takeSupersededFramesForReactTags:(NSArray *)reactTags
+                                 layoutGeneration:(NSUInteger)layoutGeneration
+{
+  RCTAssertMainThread();
+
+  NSMutableIndexSet *supersededFrames = [NSMutableIndexSet new];
+  [_pendingUIBlocksLock lock];
+  [reactTags enumerateObjectsUsingBlock:^(NSNumber *reactTag, NSUInteger i, __unused BOOL *stop) {
+    NSUInteger latestGeneration = [_latestLayoutGenerationByTag[reactTag] unsignedIntegerValue];
+    if (latestGeneration == layoutGeneration) {
+      [_latestLayoutGenerationByTag removeObjectForKey:reactTag];
+    } else if (latestGeneration > layoutGeneration && latestGeneration <= _committingLayoutGeneration &&
+               ![_frameReadGenerations intersectsIndexesInRange:NSMakeRange(layoutGeneration, latestGeneration - layoutGeneration)]) {
+      [supersededFrames addIndex:i];
+    }
+  }];
+  [_pendingUIBlocksLock unlock];
+  return supersededFrames;
+}
+
+/**
+ * Expects layoutRootNode to have been called on rootShadowView already.
+ */
 - (RCTViewManagerUIBlock)uiBlockWithLayoutUpdateForRootView:(RCTShadowView *)rootShadowView
 {
   RCTAssert(![NSThread isMainThread], @"Should be called on shadow thread");
@@ -440,8 +918,7 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
   // these structures in the UI-thread block. `NSMutableArray` is not thread
   // safe so we rely on the fact that we never mutate it after it's passed to
   // the main thread.
-  [rootShadowView collectRootUpdatedFrames:viewsWithNewFrames
-                          parentConstraint:(CGSize){CSS_UNDEFINED, CSS_UNDEFINED}];
+  [rootShadowView collectLaidOutRootFrames:viewsWithNewFrames];
 
   // Parallel arrays are built and then handed off to main thread
   NSMutableArray *frameReactTags = [NSMutableArray arrayWithCapacity:viewsWithNewFrames.count];
@@ -461,11 +938,21 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
     shadowView.newView = NO;
   }
 
+  // If a later batch sets any of these frames before the next tick, this
+  // block's frame for that view is stale and is skipped
+  [_pendingUIBlocksLock lock];
+  NSUInteger layoutGeneration = ++_layoutGeneration;
+  for (NSNumber *reactTag in frameReactTags) {
+    _latestLayoutGenerationByTag[reactTag] = @(layoutGeneration);
+  }
+  [_pendingUIBlocksLock unlock];
+
   // These are blocks to be executed on each view, immediately after
   // reactSetFrame: has been called. Note that if reactSetFrame: is not called,
   // these won't be called either, so this is not a suitable place to update
-  // properties that aren't related to layout.
-  NSMutableArray *updateBlocks = [NSMutableArray new];
+  // properties that aren't related to layout. They're parallel to the arrays
+  // above, with NSNull for views whose manager has nothing to amend.
+  NSMutableArray *updateBlocks = [NSMutableArray arrayWithCapacity:viewsWithNewFrames.count];
   for (RCTShadowView *shadowView in viewsWithNewFrames) {
     RCTViewManager *manager = [_componentDataByName[shadowView.viewName] manager];
     RCTViewManagerUIBlock block = [manager uiBlockToAmendWithShadowView:shadowView];
@@ -480,9 +967,7 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
         },
       });
     }
-    if (block) {
-      [updateBlocks addObject:block];
-    }
+    [updateBlocks addObject:block ?: (id)kCFNull];
   }
 
   // Perform layout (possibly animated)
@@ -493,11 +978,15 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
     // to make sure that doesn't happen.
     _layoutAnimation.callback = nil;
 
+    NSIndexSet *supersededFrames = [self _takeSupersededFramesForReactTags:frameReactTags
+                                                          layoutGeneration:layoutGeneration];
+
     __block NSUInteger completionsCalled = 0;
     for (NSUInteger ii = 0; ii < frames.count; ii++) {
       NSNumber *reactTag = frameReactTags[ii];
-      UIView *view = viewRegistry[reactTag];
+      UIView *view = RCTSparseArrayGet(viewRegistry, reactTag.unsignedIntegerValue);
       CGRect frame = [frames[ii] CGRectValue];
+      RCTViewManagerUIBlock updateBlock = updateBlocks[ii] == (id)kCFNull ? nil : updateBlocks[ii];
 
       BOOL isNew = [areNew[ii] boolValue];
       RCTAnimation *updateAnimation = isNew ? nil : _layoutAnimation.updateAnimation;
@@ -511,18 +1000,23 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
         }
       };
 
+      if (!isNew && [supersededFrames containsIndex:ii]) {
+        completion(YES);
+        continue;
+      }
+
       // Animate view update
       if (updateAnimation) {
         [updateAnimation performAnimations:^{
           [view reactSetFrame:frame];
-          for (RCTViewManagerUIBlock block in updateBlocks) {
-            block(self, _viewRegistry);
+          if (updateBlock) {
+            updateBlock(self, _viewRegistry);
           }
         } withCompletionBlock:completion];
       } else {
         [view reactSetFrame:frame];
-        for (RCTViewManagerUIBlock block in updateBlocks) {
-          block(self, _viewRegistry);
+        if (updateBlock) {
+          updateBlock(self, _viewRegistry);
         }
         completion(YES);
       }
@@ -543,8 +1037,8 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
             RCTLogError(@"Unsupported layout animation createConfig property %@",
                         createAnimation.property);
           }
-          for (RCTViewManagerUIBlock block in updateBlocks) {
-            block(self, _viewRegistry);
+          if (updateBlock) {
+            updateBlock(self, _viewRegistry);
           }
         } withCompletionBlock:nil];
       }
@@ -561,14 +1055,15 @@ extern NSString *RCTBridgeModuleNameForClass(Class cls);
 
 - (void)_amendPendingUIBlocksWithStylePropagationUpdateForRootView:(RCTShadowView *)topView
 {
-  NSMutableSet *applierBlocks = [NSMutableSet setWithCapacity:1];
-  [topView collectUpdatedProperties:applierBlocks parentProperties:@{}];
+  RCTViewPropertyUpdates *updates = [RCTViewPropertyUpdates new];
+  [topView collectUpdatedProperties:updates parentProperties:@{}];
+  if (!updates.count) {
+    return;
+  }
 
-  [self addUIBlock:^(__unused RCTUIManager *uiManager, RCTSparseArray *viewRegistry) {
-    for (RCTApplierBlock block in applierBlocks) {
-      block(viewRegistry);
-    }
-  }];
+  [self _addUIBlock:^(__unused RCTUIManager *uiManager, RCTSparseArray *viewRegistry) {
+    [updates applyToViewRegistry:viewRegistry];
+  } readsFrames:NO];
 }
 
 /**
@@ -594,43 +1089,6 @@ RCT_EXPORT_METHOD(removeSubviewsFromContainerWithID:(nonnull NSNumber *)containe
        removeAtIndices:indices];
 }
 
-/**
- * Disassociates children from container. Doesn't remove from registries.
- * TODO: use [NSArray getObjects:buffer] to reuse same fast buffer each time.
- *
- * @returns Array of removed items.
- */
-- (NSArray *)_childrenToRemoveFromContainer:(id<RCTComponent>)container
-                                  atIndices:(NSArray *)atIndices
-{
-  // If there are no indices to move or the container has no subviews don't bother
-  // We support parents with nil subviews so long as they're all nil so this allows for this behavior
-  if (atIndices.count == 0 || [container reactSubviews].count == 0) {
-    return nil;
-  }
-  // Construction of removed children must be done "up front", before indices are disturbed by removals.
-  NSMutableArray *removedChildren = [NSMutableArray arrayWithCapacity:atIndices.count];
-  RCTAssert(container != nil, @"container view (for ID %@) not found", container);
-  for (NSNumber *indexNumber in atIndices) {
-    NSUInteger index = indexNumber.unsignedIntegerValue;
-    if (index < [container reactSubviews].count) {
-      [removedChildren addObject:[container reactSubviews][index]];
-    }
-  }
-  if (removedChildren.count != atIndices.count) {
-    RCTLogMustFix(@"removedChildren count (%tu) was not what we expected (%tu)",
-                  removedChildren.count, atIndices.count);
-  }
-  return removedChildren;
-}
-
-- (void)_removeChildren:(NSArray *)children fromContainer:(id<RCTComponent>)container
-{
-  for (id removedChild in children) {
-    [container removeReactSubview:removedChild];
-  }
-}
-
 RCT_EXPORT_METHOD(removeRootView:(nonnull NSNumber *)rootReactTag)
 {
   RCTShadowView *rootShadowView = _shadowViewRegistry[rootReactTag];
@@ -638,6 +1096,8 @@ RCT_EXPORT_METHOD(removeRootView:(nonnull NSNumber *)rootReactTag)
   [self _purgeChildren:rootShadowView.reactSubviews fromRegistry:_shadowViewRegistry];
    _shadowViewRegistry[rootReactTag] = nil;
   [_rootViewTags removeObject:rootReactTag];
+  [_offscreenRootViewTags removeObject:rootReactTag];
+  [_layoutSnapshotAttemptsByRootTag removeObjectForKey:rootReactTag];
 
   [self addUIBlock:^(RCTUIManager *uiManager, RCTSparseArray *viewRegistry){
     RCTAssertMainThread();
@@ -678,23 +1138,17 @@ RCT_EXPORT_METHOD(manageChildren:(nonnull NSNumber *)containerReactTag
                   addAtIndices:(NSArray *)addAtIndices
                   removeAtIndices:(NSArray *)removeAtIndices)
 {
-  [self _manageChildren:containerReactTag
-        moveFromIndices:moveFromIndices
-          moveToIndices:moveToIndices
-      addChildReactTags:addChildReactTags
-           addAtIndices:addAtIndices
-        removeAtIndices:removeAtIndices
-               registry:_shadowViewRegistry];
+  RCTChildMutationPlan *plan = [[RCTChildMutationPlan alloc] initWithMoveFromIndices:moveFromIndices
+                                                                       moveToIndices:moveToIndices
+                                                                   addChildReactTags:addChildReactTags
+                                                                        addAtIndices:addAtIndices
+                                                                     removeAtIndices:removeAtIndices];
 
-  [self addUIBlock:^(RCTUIManager *uiManager, RCTSparseArray *viewRegistry){
-    [uiManager _manageChildren:containerReactTag
-               moveFromIndices:moveFromIndices
-                 moveToIndices:moveToIndices
-             addChildReactTags:addChildReactTags
-                  addAtIndices:addAtIndices
-               removeAtIndices:removeAtIndices
-                      registry:viewRegistry];
-  }];
+  [self _manageChildren:containerReactTag plan:plan registry:_shadowViewRegistry];
+
+  [self _addUIBlock:^(RCTUIManager *uiManager, RCTSparseArray *viewRegistry){
+    [uiManager _manageChildren:containerReactTag plan:plan registry:viewRegistry];
+  } readsFrames:NO];
 }
 
 - (void)_manageChildren:(NSNumber *)containerReactTag
@@ -705,36 +1159,23 @@ RCT_EXPORT_METHOD(manageChildren:(nonnull NSNumber *)containerReactTag
         removeAtIndices:(NSArray *)removeAtIndices
                registry:(RCTSparseArray *)registry
 {
-  id<RCTComponent> container = registry[containerReactTag];
-  RCTAssert(moveFromIndices.count == moveToIndices.count, @"moveFromIndices had size %tu, moveToIndices had size %tu", moveFromIndices.count, moveToIndices.count);
-  RCTAssert(addChildReactTags.count == addAtIndices.count, @"there should be at least one React child to add");
+  RCTChildMutationPlan *plan = [[RCTChildMutationPlan alloc] initWithMoveFromIndices:moveFromIndices
+                                                                       moveToIndices:moveToIndices
+                                                                   addChildReactTags:addChildReactTags
+                                                                        addAtIndices:addAtIndices
+                                                                     removeAtIndices:removeAtIndices];
+  [self _manageChildren:containerReactTag plan:plan registry:registry];
+}
 
-  // Removes (both permanent and temporary moves) are using "before" indices
-  NSArray *permanentlyRemovedChildren = [self _childrenToRemoveFromContainer:container atIndices:removeAtIndices];
-  NSArray *temporarilyRemovedChildren = [self _childrenToRemoveFromContainer:container atIndices:moveFromIndices];
-  [self _removeChildren:permanentlyRemovedChildren fromContainer:container];
-  [self _removeChildren:temporarilyRemovedChildren fromContainer:container];
+- (void)_manageChildren:(NSNumber *)containerReactTag
+                   plan:(RCTChildMutationPlan *)plan
+               registry:(RCTSparseArray *)registry
+{
+  id<RCTComponent> container = RCTSparseArrayGet(registry, containerReactTag.unsignedIntegerValue);
+  RCTAssert(container != nil, @"container view (for ID %@) not found", containerReactTag);
 
+  NSArray *permanentlyRemovedChildren = [plan applyToContainer:container registry:registry];
   [self _purgeChildren:permanentlyRemovedChildren fromRegistry:registry];
-
-  // TODO (#5906496): optimize all these loops - constantly calling array.count is not efficient
-
-  // Figure out what to insert - merge temporary inserts and adds
-  NSMutableDictionary *destinationsToChildrenToAdd = [NSMutableDictionary dictionary];
-  for (NSInteger index = 0, length = temporarilyRemovedChildren.count; index < length; index++) {
-    destinationsToChildrenToAdd[moveToIndices[index]] = temporarilyRemovedChildren[index];
-  }
-  for (NSInteger index = 0, length = addAtIndices.count; index < length; index++) {
-    id view = registry[addChildReactTags[index]];
-    if (view) {
-      destinationsToChildrenToAdd[addAtIndices[index]] = view;
-    }
-  }
-
-  NSArray *sortedIndices = [destinationsToChildrenToAdd.allKeys sortedArrayUsingSelector:@selector(compare:)];
-  for (NSNumber *reactIndex in sortedIndices) {
-    [container insertReactSubview:destinationsToChildrenToAdd[reactIndex] atIndex:reactIndex.integerValue];
-  }
 }
 
 RCT_EXPORT_METHOD(createView:(nonnull NSNumber *)reactTag
@@ -742,6 +1183,11 @@ RCT_EXPORT_METHOD(createView:(nonnull NSNumber *)reactTag
                   rootTag:(__unused NSNumber *)rootTag
                   props:(NSDictionary *)props)
 {
+  static dispatch_once_t firstViewToken;
+  dispatch_once(&firstViewToken, ^{
+    RCTPerformanceLoggerMark(@"FirstCreateView");
+  });
+
   RCTComponentData *componentData = _componentDataByName[viewName];
   if (componentData == nil) {
     RCTLogError(@"No component found for view with name \"%@\"", viewName);
@@ -751,37 +1197,68 @@ RCT_EXPORT_METHOD(createView:(nonnull NSNumber *)reactTag
   RCTShadowView *shadowView = [componentData createShadowViewWithTag:reactTag];
   [componentData setProps:props forShadowView:shadowView];
   _shadowViewRegistry[reactTag] = shadowView;
+  _createdViewCount++;
 
   // Shadow view is the source of truth for background color this is a little
   // bit counter-intuitive if people try to set background color when setting up
   // the view, but it's the only way that makes sense given our threading model
   UIColor *backgroundColor = shadowView.backgroundColor;
 
-  [self addUIBlock:^(RCTUIManager *uiManager, RCTSparseArray *viewRegistry){
+  // Props are diffed and converted here rather than on the main thread
+  NSDictionary *viewProps = [componentData preparedProps:props forViewWithTag:reactTag];
+
+  [self _addUIBlock:^(RCTUIManager *uiManager, RCTSparseArray *viewRegistry){
     id<RCTComponent> view = [componentData createViewWithTag:reactTag props:props];
     if ([view respondsToSelector:@selector(setBackgroundColor:)]) {
       ((UIView *)view).backgroundColor = backgroundColor;
     }
-    [componentData setProps:props forView:view];
+    [componentData setProps:viewProps forView:view];
     if ([view respondsToSelector:@selector(reactBridgeDidFinishTransaction)]) {
       [uiManager->_bridgeTransactionListeners addObject:view];
     }
     viewRegistry[reactTag] = view;
-  }];
+  } readsFrames:NO];
 }
 
 RCT_EXPORT_METHOD(updateView:(nonnull NSNumber *)reactTag
                   viewName:(NSString *)viewName // not always reliable, use shadowView.viewName if available
                   props:(NSDictionary *)props)
 {
-  RCTShadowView *shadowView = _shadowViewRegistry[reactTag];
+  [self _updateView:reactTag viewName:viewName props:props resendingUnchangedProps:NO];
+}
+
+/**
+ * Like updateView, but the props are applied even if they equal the ones last
+ * sent, since the view itself may have changed them since.
+ */
+RCT_EXPORT_METHOD(setNativeProps:(nonnull NSNumber *)reactTag
+                  viewName:(NSString *)viewName
+                  props:(NSDictionary *)props)
+{
+  [self _updateView:reactTag viewName:viewName props:props resendingUnchangedProps:YES];
+}
+
+- (void)_updateView:(NSNumber *)reactTag
+           viewName:(NSString *)viewName
+              props:(NSDictionary *)props
+resendingUnchangedProps:(BOOL)resendingUnchangedProps
+{
+  RCTShadowView *shadowView = RCTSparseArrayGet(_shadowViewRegistry, reactTag.unsignedIntegerValue);
   RCTComponentData *componentData = _componentDataByName[shadowView.viewName ?: viewName];
   [componentData setProps:props forShadowView:shadowView];
 
-  [self addUIBlock:^(__unused RCTUIManager *uiManager, RCTSparseArray *viewRegistry) {
-    UIView *view = viewRegistry[reactTag];
-    [componentData setProps:props forView:view];
-  }];
+  NSDictionary *viewProps = [componentData preparedProps:props
+                                          forViewWithTag:reactTag
+                                 resendingUnchangedProps:resendingUnchangedProps];
+  if (!viewProps) {
+    return;
+  }
+  _updatedViewCount++;
+
+  [self _addUIBlock:^(__unused RCTUIManager *uiManager, RCTSparseArray *viewRegistry) {
+    UIView *view = RCTSparseArrayGet(viewRegistry, reactTag.unsignedIntegerValue);
+    [componentData setProps:viewProps forView:view];
+  } readsFrames:NO];
 }
 
 RCT_EXPORT_METHOD(focus:(nonnull NSNumber *)reactTag)
@@ -824,6 +1301,17 @@ RCT_EXPORT_METHOD(findSubviewIn:(nonnull NSNumber *)reactTag atPoint:(CGPoint)po
 }
 
 - (void)batchDidComplete
+{
+  [self _completeBatchIncludingOffscreenRootViews:NO];
+}
+
+/**
+ * Root views that aren't in a window only get laid out with includeOffscreen,
+ * or when measurements are waiting on the batch. Otherwise their layout is put
+ * off for RCTOffscreenRootViewLayoutDelay, so the visible root isn't held up
+ * by the others.
+ */
+- (void)_completeBatchIncludingOffscreenRootViews:(BOOL)includeOffscreen
 {
   RCTProfileBeginEvent(0, @"[RCTUIManager batchDidComplete]", nil);
 
@@ -837,58 +1325,278 @@ RCT_EXPORT_METHOD(findSubviewIn:(nonnull NSNumber *)reactTag atPoint:(CGPoint)po
   // Set up next layout animation
   if (_nextLayoutAnimation) {
     RCTLayoutAnimation *layoutAnimation = _nextLayoutAnimation;
-    [self addUIBlock:^(RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
+    [self _addUIBlock:^(RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
       uiManager->_layoutAnimation = layoutAnimation;
-    }];
+    } readsFrames:NO];
   }
 
-  // Perform layout
+  // Perform layout. Roots are laid out one after the other on this queue: text
+  // layout, the font cache and the layout counters of RCTShadowView are not
+  // safe to use from several threads at once. Roots where nothing was
+  // dirtied, e.g. when a batch only updates the text of an input, have no new
+  // frames and are skipped entirely.
+  CFTimeInterval layoutStart = RCTFrameTimingIsRecording() ? CACurrentMediaTime() : 0;
+  includeOffscreen = includeOffscreen || _pendingMeasureBlocks.count;
+  BOOL deferredLayout = NO;
+  NSMutableArray *rootViews = [NSMutableArray arrayWithCapacity:_rootViewTags.count];
   for (NSNumber *reactTag in _rootViewTags) {
     RCTShadowView *rootView = _shadowViewRegistry[reactTag];
-    [self addUIBlock:[self uiBlockWithLayoutUpdateForRootView:rootView]];
+    if (rootView.isLayoutDirty && !includeOffscreen && [_offscreenRootViewTags containsObject:reactTag]) {
+      deferredLayout = YES;
+      [self _amendPendingUIBlocksWithStylePropagationUpdateForRootView:rootView];
+    } else if (rootView.isLayoutDirty) {
+      [rootViews addObject:rootView];
+    } else if (rootView) {
+      [self _amendPendingUIBlocksWithStylePropagationUpdateForRootView:rootView];
+    }
+  }
+  if (deferredLayout && !_offscreenLayoutScheduled) {
+    _offscreenLayoutScheduled = YES;
+    __weak RCTUIManager *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(RCTOffscreenRootViewLayoutDelay * NSEC_PER_SEC)), _shadowQueue, ^{
+      RCTUIManager *strongSelf = weakSelf;
+      if (strongSelf && strongSelf->_viewRegistry) {
+        strongSelf->_offscreenLayoutScheduled = NO;
+        [strongSelf _completeBatchIncludingOffscreenRootViews:YES];
+      }
+    });
+  }
+  RCTUIManagerBatchStatsBlock batchStatsBlock = self.batchStatsBlock;
+  BOOL collectStats = batchStatsBlock || RCTProfileIsProfiling();
+  CFTimeInterval *layoutDurations = collectStats ? calloc(rootViews.count, sizeof(CFTimeInterval)) : NULL;
+
+  BOOL *snapshotsDone = NULL;
+  NSMutableIndexSet *snapshotRoots = nil;
+  if (RCTLayoutSnapshotsDirectory()) {
+    if (!_layoutSnapshotAttemptsByRootTag) {
+      _layoutSnapshotAttemptsByRootTag = [NSMutableDictionary new];
+    }
+    snapshotRoots = [NSMutableIndexSet new];
+    [rootViews enumerateObjectsUsingBlock:^(RCTShadowView *rootView, NSUInteger i, __unused BOOL *stop) {
+      if ([_layoutSnapshotAttemptsByRootTag[rootView.reactTag] unsignedIntegerValue] < RCTLayoutSnapshotMaxAttempts) {
+        [snapshotRoots addIndex:i];
+      }
+    }];
+    snapshotsDone = snapshotRoots.count ? calloc(rootViews.count, sizeof(BOOL)) : NULL;
+  }
+
+  void (^layoutRootView)(size_t) = ^(size_t i) {
+    RCTShadowView *rootView = rootViews[i];
+    uint64_t snapshotHash = 0;
+    if (snapshotsDone && [snapshotRoots containsIndex:i]) {
+      snapshotHash = [rootView layoutSnapshotHash];
+      NSData *snapshot = snapshotHash ? [NSData dataWithContentsOfFile:RCTLayoutSnapshotPath(snapshotHash)] : nil;
+      if (snapshot && [rootView restoreLayoutSnapshot:snapshot hash:snapshotHash]) {
+        snapshotsDone[i] = YES;
+        snapshotHash = 0;
+      }
+    }
+
+    if (!layoutDurations) {
+      [rootView layoutRootNode];
+    } else {
+      RCTProfileBeginEvent(0, @"[RCTShadowView layoutRootNode]", nil);
+      CFTimeInterval start = CACurrentMediaTime();
+      [rootView layoutRootNode];
+      layoutDurations[i] = CACurrentMediaTime() - start;
+      RCTProfileEndEvent(0, @"uimanager", @{
+        @"root_tag": rootView.reactTag,
+      });
+    }
+
+    // Only trees that measured something are worth a snapshot
+    NSData *snapshot = snapshotHash ? [rootView layoutSnapshotWithHash:snapshotHash] : nil;
+    if (snapshot) {
+      RCTWriteLayoutSnapshot(snapshot, snapshotHash);
+      snapshotsDone[i] = YES;
+    }
+  };
+  for (NSUInteger i = 0; i < rootViews.count; i++) {
+    layoutRootView(i);
+  }
+  if (layoutStart) {
+    RCTFrameTimingAddWork(RCTFrameWorkLayout, CACurrentMediaTime() - layoutStart);
+  }
+  if (rootViews.count) {
+    static dispatch_once_t firstLayoutToken;
+    dispatch_once(&firstLayoutToken, ^{
+      RCTPerformanceLoggerMark(@"FirstLayout");
+    });
+  }
+  NSMutableArray *layoutStats = collectStats ? [NSMutableArray arrayWithCapacity:rootViews.count] : nil;
+  [rootViews enumerateObjectsUsingBlock:^(RCTShadowView *rootView, NSUInteger i, __unused BOOL *stop) {
+    [self _addUIBlock:[self uiBlockWithLayoutUpdateForRootView:rootView] readsFrames:NO];
     [self _amendPendingUIBlocksWithStylePropagationUpdateForRootView:rootView];
+    if (!layoutStats) {
+      return;
+    }
+    [layoutStats addObject:@{
+      @"rootTag": rootView.reactTag,
+      @"duration": @(layoutDurations[i]),
+      @"visitedNodes": @(rootView.lastVisitedNodeCount),
+      @"relaidOutNodes": @(rootView.lastRelaidOutNodeCount),
+    }];
+  }];
+  free(layoutDurations);
+
+  [snapshotRoots enumerateIndexesUsingBlock:^(NSUInteger i, __unused BOOL *stop) {
+    NSNumber *reactTag = [rootViews[i] reactTag];
+    NSUInteger attempts = [_layoutSnapshotAttemptsByRootTag[reactTag] unsignedIntegerValue] + 1;
+    _layoutSnapshotAttemptsByRootTag[reactTag] = @(snapshotsDone[i] ? RCTLayoutSnapshotMaxAttempts : attempts);
+  }];
+  free(snapshotsDone);
+
+  // Shadow frames are current now
+  if (_pendingMeasureBlocks.count) {
+    NSArray *measureBlocks = _pendingMeasureBlocks;
+    _pendingMeasureBlocks = [NSMutableArray new];
+    for (dispatch_block_t measureBlock in measureBlocks) {
+      measureBlock();
+    }
   }
 
   // Clear layout animations
   if (_nextLayoutAnimation) {
-    [self addUIBlock:^(RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
+    [self _addUIBlock:^(RCTUIManager *uiManager, __unused RCTSparseArray *viewRegistry) {
       uiManager->_layoutAnimation = nil;
-    }];
+    } readsFrames:NO];
     _nextLayoutAnimation = nil;
   }
 
+  NSDictionary *stats = nil;
+  if (collectStats) {
+    stats = @{
+      @"layout": layoutStats,
+      @"createdViews": @(_createdViewCount),
+      @"updatedViews": @(_updatedViewCount),
+      @"removedViews": @(_removedViewCount),
+    };
+  }
+  _createdViewCount = _updatedViewCount = _removedViewCount = 0;
+
   RCTProfileEndEvent(0, @"uimanager", @{
     @"view_count": @(_viewRegistry.count),
+    @"stats": RCTNullIfNil(stats),
   });
-  [self flushUIBlocks];
+  [self flushUIBlocksWithStats:stats statsBlock:batchStatsBlock];
 }
 
 - (void)flushUIBlocks
+{
+  [self flushUIBlocksWithStats:nil statsBlock:nil];
+}
+
+/**
+ * Stats, if any, are completed with the main thread timings and passed to
+ * statsBlock once the blocks have run. The blocks don't run straight away:
+ * every batch flushed before the next display link tick is committed in that
+ * tick, in order, inside one CATransaction.
+ */
+- (void)flushUIBlocksWithStats:(NSDictionary *)stats statsBlock:(RCTUIManagerBatchStatsBlock)statsBlock
 {
   // First copy the previous blocks into a temporary variable, then reset the
   // pending blocks to a new array. This guards against mutation while
   // processing the pending blocks in another thread.
+  NSArray<RCTInputFlow *> *inputFlows = RCTCurrentInputFlows();
+  RCTInputFlowsReachStage(inputFlows, RCTInputFlowStageLayout);
   [_pendingUIBlocksLock lock];
   NSArray *previousPendingUIBlocks = _pendingUIBlocks;
   _pendingUIBlocks = [NSMutableArray new];
+  [_pendingCommits addObject:[[RCTUIManagerCommit alloc] initWithBlocks:previousPendingUIBlocks
+                                                               stats:stats
+                                                          statsBlock:statsBlock
+                                                    layoutGeneration:_layoutGeneration
+                                                          inputFlows:inputFlows]];
+  BOOL scheduleCommit = !_commitScheduled;
+  _commitScheduled = YES;
   [_pendingUIBlocksLock unlock];
 
-  // Execute the previously queued UI blocks
-  RCTProfileBeginFlowEvent();
-  dispatch_async(dispatch_get_main_queue(), ^{
-    RCTProfileEndFlowEvent();
-    RCTProfileBeginEvent(0, @"UIManager flushUIBlocks", nil);
+  if (scheduleCommit) {
+    RCTProfileBeginFlowEvent();
+    __weak RCTUIManager *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      RCTProfileEndFlowEvent();
+      [weakSelf _scheduleCommit];
+    });
+  }
+}
+
+- (void)_scheduleCommit
+{
+  RCTAssertMainThread();
+
+  // The display link doesn't fire in the background, where nothing is drawn,
+  // so there's no frame to wait for either
+  if ([UIApplication sharedApplication].applicationState == UIApplicationStateBackground) {
+    [self commitPendingUIBlocks];
+    return;
+  }
+  if (!_commitDisplayLink && _viewRegistry) {
+    _commitDisplayLink = [CADisplayLink displayLinkWithTarget:self
+                                                     selector:@selector(commitPendingUIBlocks)];
+    [_commitDisplayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  }
+  _commitDisplayLink.paused = NO;
+}
+
+- (void)commitPendingUIBlocks
+{
+  RCTAssertMainThread();
+
+  [_pendingUIBlocksLock lock];
+  NSArray *commits = _pendingCommits;
+  _pendingCommits = commits ? [NSMutableArray new] : nil;
+  _commitScheduled = NO;
+  [_pendingUIBlocksLock unlock];
+
+  _commitDisplayLink.paused = YES;
+  if (!commits.count) {
+    return;
+  }
+
+  _committingLayoutGeneration = [commits.lastObject layoutGeneration];
+
+  RCTProfileBeginEvent(0, @"UIManager flushUIBlocks", nil);
+  [CATransaction begin];
+  NSUInteger blockCount = 0;
+  NSMutableArray<RCTInputFlow *> *inputFlows;
+  for (RCTUIManagerCommit *commit in commits) {
+    NSDictionary *stats = commit.stats;
+    CFTimeInterval start = (stats || RCTFrameTimingIsRecording()) ? CACurrentMediaTime() : 0;
     @try {
-      for (dispatch_block_t block in previousPendingUIBlocks) {
+      for (dispatch_block_t block in commit.blocks) {
         block();
       }
     }
     @catch (NSException *exception) {
       RCTLogError(@"Exception thrown while executing UI block: %@", exception);
     }
-    RCTProfileEndEvent(0, @"objc_call", @{
-      @"count": @(previousPendingUIBlocks.count),
-    });
+    CFTimeInterval duration = start ? CACurrentMediaTime() - start : 0;
+    if (start && RCTFrameTimingIsRecording()) {
+      RCTFrameTimingAddWork(RCTFrameWorkUIBlocks, duration);
+    }
+    blockCount += commit.blocks.count;
+    if (commit.inputFlows) {
+      inputFlows = inputFlows ?: [NSMutableArray new];
+      [inputFlows addObjectsFromArray:commit.inputFlows];
+    }
+    if (commit.statsBlock && stats) {
+      NSMutableDictionary *batchStats = [stats mutableCopy];
+      batchStats[@"uiBlockCount"] = @(commit.blocks.count);
+      batchStats[@"uiBlockDuration"] = @(duration);
+      commit.statsBlock(batchStats);
+    }
+  }
+  [CATransaction commit];
+  [_bridge.inputLatency endFlows:inputFlows];
+
+  // Only the layouts that are still to come can be superseded
+  [_pendingUIBlocksLock lock];
+  [_frameReadGenerations removeIndexesInRange:NSMakeRange(0, _committingLayoutGeneration + 1)];
+  [_pendingUIBlocksLock unlock];
+  RCTProfileEndEvent(0, @"objc_call", @{
+    @"count": @(blockCount),
+    @"batches": @(commits.count),
   });
 }
 
@@ -987,6 +1695,83 @@ RCT_EXPORT_METHOD(measureLayoutRelativeToParent:(nonnull NSNumber *)reactTag
   RCTMeasureLayout(shadowView, shadowView.reactSuperview, callback);
 }
 
+/**
+ * The frame of a shadow view relative to ancestor, or to its root view if
+ * ancestor is nil. Returns CGRectNull if the view isn't a descendant of the
+ * ancestor, or isn't in a root view.
+ */
+static CGRect RCTShadowFrameRelativeToAncestor(RCTShadowView *view, RCTShadowView *ancestor)
+{
+  CGPoint offset = CGPointZero;
+  RCTShadowView *shadowView = view;
+  while (shadowView && shadowView != ancestor) {
+    if (!ancestor && !shadowView.superview) {
+      // The root view's own frame is where it is on screen, not in itself
+      break;
+    }
+    offset.x += shadowView.frame.origin.x;
+    offset.y += shadowView.frame.origin.y;
+    shadowView = shadowView.superview;
+  }
+  if (!shadowView || (!ancestor && !RCTIsReactRootView(shadowView.reactTag))) {
+    return CGRectNull;
+  }
+  return (CGRect){offset, view.frame.size};
+}
+
+/**
+ * Measures several views at once, from the shadow views, and invokes the
+ * callback with an array holding [x, y, width, height] for each tag, in the
+ * same order, relative to the ancestor if one is given and to each view's root
+ * view otherwise. Unlike measure, transforms and scroll offsets aren't taken
+ * into account. Views that don't exist or aren't descendants of the ancestor
+ * get null. If layout is dirty when the call arrives, the views are measured
+ * as soon as the batch has been laid out.
+ */
+RCT_EXPORT_METHOD(measureLayouts:(NSNumberArray *)reactTags
+                  relativeTo:(NSNumber *)ancestorReactTag
+                  callback:(RCTResponseSenderBlock)callback)
+{
+  RCTShadowView *ancestorShadowView = ancestorReactTag ? _shadowViewRegistry[ancestorReactTag] : nil;
+  if (ancestorReactTag && !ancestorShadowView) {
+    RCTLogError(@"Attempting to measure relative to a view that does not exist (tag #%@)", ancestorReactTag);
+    return;
+  }
+
+  __weak RCTUIManager *weakSelf = self;
+  dispatch_block_t measureBlock = ^{
+    RCTUIManager *strongSelf = weakSelf;
+    if (!strongSelf) {
+      return;
+    }
+    NSMutableArray *layouts = [NSMutableArray arrayWithCapacity:reactTags.count];
+    for (NSNumber *reactTag in reactTags) {
+      RCTShadowView *shadowView = strongSelf->_shadowViewRegistry[reactTag];
+      CGRect frame = shadowView ? RCTShadowFrameRelativeToAncestor(shadowView, ancestorShadowView) : CGRectNull;
+      if (CGRectIsNull(frame) || isnan(frame.origin.x) || isnan(frame.origin.y) ||
+          isnan(frame.size.width) || isnan(frame.size.height)) {
+        [layouts addObject:(id)kCFNull];
+        continue;
+      }
+      [layouts addObject:@[
+        @(frame.origin.x),
+        @(frame.origin.y),
+        @(frame.size.width),
+        @(frame.size.height),
+      ]];
+    }
+    callback(@[layouts]);
+  };
+
+  for (NSNumber *reactTag in _rootViewTags) {
+    if ([_shadowViewRegistry[reactTag] isLayoutDirty]) {
+      [_pendingMeasureBlocks addObject:measureBlock];
+      return;
+    }
+  }
+  measureBlock();
+}
+
 /**
  * Returns an array of computed offset layouts in a dictionary form. The layouts are of any React subviews
  * that are immediate descendants to the parent view found within a specified rect. The dictionary result
@@ -1128,31 +1913,152 @@ RCT_EXPORT_METHOD(clearJSResponder)
   }];
 }
 
+#pragma mark - View configs
+
+static NSString *RCTViewConfigsCachePath(void)
+{
+  NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+  return [cachesDirectory stringByAppendingPathComponent:@"React/RCTViewConfigs.plist"];
+}
+
+/**
+ * View configs only change when the native code does, so they are cached on
+ * disk for each build of the app. Not in dev, where native code changes
+ * without the version being bumped.
+ */
+static NSString *RCTViewConfigsCacheVersion(void)
+{
+  if (RCT_DEV) {
+    return nil;
+  }
+  NSDictionary *infoDictionary = [NSBundle mainBundle].infoDictionary;
+  NSString *version = infoDictionary[@"CFBundleShortVersionString"];
+  NSString *build = infoDictionary[@"CFBundleVersion"];
+  return (version && build) ? [NSString stringWithFormat:@"%@ (%@)", version, build] : nil;
+}
+
+/**
+ * Builds the viewConfig of a component, which walks the methods of its
+ * manager, the first time it's needed. Later ones come from memory, or from
+ * the disk cache that's written after startup.
+ */
+- (NSDictionary *)viewConfigForComponentData:(RCTComponentData *)componentData
+{
+  [_viewConfigsLock lock];
+  if (!_viewConfigs) {
+    NSString *cacheVersion = RCTViewConfigsCacheVersion();
+    NSDictionary *cache = cacheVersion ? [NSDictionary dictionaryWithContentsOfFile:RCTViewConfigsCachePath()] : nil;
+    BOOL cacheIsCurrent = [cache[@"version"] isEqualToString:cacheVersion];
+    _viewConfigs = (cacheIsCurrent ? [cache[@"viewConfigs"] mutableCopy] : nil) ?: [NSMutableDictionary new];
+  }
+  NSDictionary *viewConfig = _viewConfigs[componentData.name];
+  [_viewConfigsLock unlock];
+  if (viewConfig) {
+    return viewConfig;
+  }
+
+  viewConfig = [componentData viewConfig];
+
+  [_viewConfigsLock lock];
+  _viewConfigs[componentData.name] = viewConfig;
+  BOOL scheduleWrite = !_viewConfigsChanged && RCTViewConfigsCacheVersion();
+  _viewConfigsChanged = YES;
+  [_viewConfigsLock unlock];
+
+  if (scheduleWrite) {
+    __weak RCTUIManager *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+      [weakSelf writeViewConfigsCache];
+    });
+  }
+  return viewConfig;
+}
+
+- (void)writeViewConfigsCache
+{
+  [_viewConfigsLock lock];
+  NSDictionary *viewConfigs = [_viewConfigs copy];
+  _viewConfigsChanged = NO;
+  [_viewConfigsLock unlock];
+
+  NSString *path = RCTViewConfigsCachePath();
+  [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                            withIntermediateDirectories:YES
+                                             attributes:nil
+                                                  error:NULL];
+  NSDictionary *cache = @{
+    @"version": RCTViewConfigsCacheVersion(),
+    @"viewConfigs": viewConfigs,
+  };
+  if (![cache writeToFile:path atomically:YES]) {
+    RCTLogWarn(@"Failed to write the view config cache to %@", path);
+  }
+}
+
+/**
+ * What JS reads as UIManager[viewName]: the component's native props and the
+ * custom constants of its manager.
+ */
+- (NSDictionary *)constantsForComponentData:(RCTComponentData *)componentData
+{
+  NSMutableDictionary *constantsNamespace = [NSMutableDictionary new];
+
+  // add an additional 'Constants' namespace for each class
+  constantsNamespace[@"Constants"] = _viewManagerConstants[componentData.name];
+
+  // Add native props
+  constantsNamespace[@"NativeProps"] = [self viewConfigForComponentData:componentData][@"propTypes"];
+
+  return constantsNamespace;
+}
+
+/**
+ * Called synchronously by JS the first time it reads UIManager[viewName], when
+ * the view configs weren't exported up front. Runs on the JS thread.
+ */
+RCT_EXPORT_SYNC_METHOD(lazilyLoadView:(NSString *)viewName)
+{
+  RCTComponentData *componentData = _componentDataByName[viewName];
+  return componentData ? [self constantsForComponentData:componentData] : nil;
+}
+
 - (NSDictionary *)constantsToExport
 {
   NSMutableDictionary *allJSConstants = [NSMutableDictionary new];
   NSMutableDictionary *directEvents = [NSMutableDictionary new];
   NSMutableDictionary *bubblingEvents = [NSMutableDictionary new];
 
+  // Add custom constants. Managers create views to measure them, so this
+  // can't be left to the JS thread.
+  // TODO: should these be inherited?
+  NSMutableDictionary *viewManagerConstants = [NSMutableDictionary new];
   [_componentDataByName enumerateKeysAndObjectsUsingBlock:
    ^(NSString *name, RCTComponentData *componentData, __unused BOOL *stop) {
-
      RCTViewManager *manager = componentData.manager;
-     NSMutableDictionary *constantsNamespace =
-     [NSMutableDictionary dictionaryWithDictionary:allJSConstants[name]];
-
-     // Add custom constants
-     // TODO: should these be inherited?
-     NSDictionary *constants = RCTClassOverridesInstanceMethod([manager class], @selector(constantsToExport)) ? [manager constantsToExport] : nil;
-     if (constants.count) {
-       RCTAssert(constantsNamespace[@"Constants"] == nil , @"Cannot redefine Constants in namespace: %@", name);
-       // add an additional 'Constants' namespace for each class
-       constantsNamespace[@"Constants"] = constants;
+     if (RCTClassOverridesInstanceMethod([manager class], @selector(constantsToExport))) {
+       NSDictionary *constants = [manager constantsToExport];
+       if (constants.count) {
+         viewManagerConstants[name] = constants;
+       }
+     }
+  }];
+  _viewManagerConstants = [viewManagerConstants copy];
+
+  // JS can fetch each component's constants once it uses the component unless
+  // the executor can't call back into native synchronously, e.g. in Chrome
+  BOOL lazyViewConfigs = [_bridge respondsToSelector:@selector(usesLazyModuleConfig)] &&
+    [_bridge usesLazyModuleConfig];
+
+  [_componentDataByName enumerateKeysAndObjectsUsingBlock:
+   ^(NSString *name, RCTComponentData *componentData, __unused BOOL *stop) {
+
+     if (!lazyViewConfigs) {
+       allJSConstants[name] = [self constantsForComponentData:componentData];
      }
 
-     // Add native props
-     NSDictionary *viewConfig = [componentData viewConfig];
-     constantsNamespace[@"NativeProps"] = viewConfig[@"propTypes"];
+     // Event types are registered with the event plugin up front, so they
+     // can't wait for the component to be used
+     NSDictionary *viewConfig = [self viewConfigForComponentData:componentData];
 
      // Add direct events
      for (NSString *eventName in viewConfig[@"directEvents"]) {
@@ -1183,10 +2089,12 @@ RCT_EXPORT_METHOD(clearJSResponder)
                      "bubbling event", componentData.name, eventName);
        }
      }
-
-     allJSConstants[name] = [constantsNamespace copy];
   }];
 
+  if (lazyViewConfigs) {
+    allJSConstants[@"ViewManagerNames"] = _componentDataByName.allKeys;
+  }
+
   [allJSConstants addEntriesFromDictionary:@{
     @"customBubblingEventTypes": bubblingEvents,
     @"customDirectEventTypes": directEvents,
@@ -0,0 +1,32 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import "RCTDefines.h"
+
+typedef UIImage *(^RCTAsyncDisplayBlock)(void);
+typedef void (^RCTAsyncDisplayCompletionBlock)(UIImage *image);
+
+/**
+ * Runs the display block on a shared background queue, then passes the image
+ * it returned to the completion block on the main thread. The completion block
+ * isn't called if the layer has been displayed again, or the display has been
+ * cancelled, in the meantime. The display block must not touch the view, only
+ * values it captured. Must be called on the main thread.
+ */
+RCT_EXTERN void RCTDisplayLayerAsynchronously(CALayer *layer,
+                                              RCTAsyncDisplayBlock displayBlock,
+                                              RCTAsyncDisplayCompletionBlock completion);
+
+/**
+ * Drops the result of any display of the layer that is still in progress.
+ * Must be called on the main thread.
+ */
+RCT_EXTERN void RCTCancelAsyncDisplay(CALayer *layer);
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTAsyncDisplay.h"
+
+#import <objc/runtime.h>
+
+#import "RCTAssert.h"
+
+static const char *RCTAsyncDisplaySentinelKey = "RCTAsyncDisplaySentinel";
+
+static NSUInteger RCTIncrementAsyncDisplaySentinel(CALayer *layer)
+{
+  NSUInteger sentinel = [objc_getAssociatedObject(layer, RCTAsyncDisplaySentinelKey) unsignedIntegerValue] + 1;
+  objc_setAssociatedObject(layer, RCTAsyncDisplaySentinelKey, @(sentinel), OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+  return sentinel;
+}
+
+static dispatch_queue_t RCTAsyncDisplayQueue(void)
+{
+  static dispatch_queue_t queue;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    queue = dispatch_queue_create("com.facebook.React.AsyncDisplayQueue", DISPATCH_QUEUE_SERIAL);
+    dispatch_set_target_queue(queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0));
+  });
+  return queue;
+}
+
+void RCTDisplayLayerAsynchronously(CALayer *layer,
+                                   RCTAsyncDisplayBlock displayBlock,
+                                   RCTAsyncDisplayCompletionBlock completion)
+{
+  RCTAssertMainThread();
+
+  NSUInteger sentinel = RCTIncrementAsyncDisplaySentinel(layer);
+  dispatch_async(RCTAsyncDisplayQueue(), ^{
+    UIImage *image = displayBlock();
+    dispatch_async(dispatch_get_main_queue(), ^{
+      if ([objc_getAssociatedObject(layer, RCTAsyncDisplaySentinelKey) unsignedIntegerValue] == sentinel) {
+        completion(image);
+      }
+    });
+  });
+}
+
+void RCTCancelAsyncDisplay(CALayer *layer)
+{
+  RCTAssertMainThread();
+
+  if (objc_getAssociatedObject(layer, RCTAsyncDisplaySentinelKey)) {
+    RCTIncrementAsyncDisplaySentinel(layer);
+  }
+}
@@ -52,7 +52,8 @@ CGPathRef RCTPathCreateWithRoundedRect(CGRect bounds,
                                        const CGAffineTransform *transform);
 
 /**
- * Draw a CSS-compliant border as a scalable image.
+ * Draw a CSS-compliant border as a scalable image. Images are cached by their
+ * parameters, so views with the same border style share the same image.
  */
 UIImage *RCTGetBorderImage(RCTCornerRadii cornerRadii,
                            UIEdgeInsets borderInsets,
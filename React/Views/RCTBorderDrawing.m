@@ -9,8 +9,95 @@
 
 #import "RCTBorderDrawing.h"
 
+#import "RCTCache.h"
+#import "RCTUtils.h"
+
 static const CGFloat RCTViewBorderThreshold = 0.001;
 
+// Each image is only a few pixels larger than its corners and borders
+static const NSUInteger RCTBorderImageCacheCountLimit = 128;
+
+/**
+ * Identifies a border image by everything that's drawn into it, so that views
+ * with the same style share one image.
+ */
+@interface RCTBorderImageKey : NSObject <NSCopying>
+
+@end
+
+@implementation RCTBorderImageKey
+{
+  RCTCornerRadii _cornerRadii;
+  UIEdgeInsets _borderInsets;
+  RCTBorderColors _borderColors;
+  CGColorRef _backgroundColor;
+  BOOL _drawToEdge;
+  CGFloat _scale;
+}
+
+- (instancetype)initWithCornerRadii:(RCTCornerRadii)cornerRadii
+                       borderInsets:(UIEdgeInsets)borderInsets
+                       borderColors:(RCTBorderColors)borderColors
+                    backgroundColor:(CGColorRef)backgroundColor
+                         drawToEdge:(BOOL)drawToEdge
+                              scale:(CGFloat)scale
+{
+  if ((self = [super init])) {
+    _cornerRadii = cornerRadii;
+    _borderInsets = borderInsets;
+    _borderColors = (RCTBorderColors){
+      CGColorRetain(borderColors.top),
+      CGColorRetain(borderColors.left),
+      CGColorRetain(borderColors.bottom),
+      CGColorRetain(borderColors.right),
+    };
+    _backgroundColor = CGColorRetain(backgroundColor);
+    _drawToEdge = drawToEdge;
+    _scale = scale;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  CGColorRelease(_borderColors.top);
+  CGColorRelease(_borderColors.left);
+  CGColorRelease(_borderColors.bottom);
+  CGColorRelease(_borderColors.right);
+  CGColorRelease(_backgroundColor);
+}
+
+- (id)copyWithZone:(__unused NSZone *)zone
+{
+  return self;
+}
+
+- (NSUInteger)hash
+{
+  return (NSUInteger)(_cornerRadii.topLeft * 31 + _cornerRadii.bottomRight * 17 +
+                      _borderInsets.top * 13 + _borderInsets.right * 7) ^
+    (_drawToEdge ? 1 : 0);
+}
+
+- (BOOL)isEqual:(RCTBorderImageKey *)object
+{
+  if (![object isKindOfClass:[RCTBorderImageKey class]]) {
+    return NO;
+  }
+  return
+  memcmp(&_cornerRadii, &object->_cornerRadii, sizeof(_cornerRadii)) == 0 &&
+  UIEdgeInsetsEqualToEdgeInsets(_borderInsets, object->_borderInsets) &&
+  _drawToEdge == object->_drawToEdge &&
+  _scale == object->_scale &&
+  CGColorEqualToColor(_borderColors.top, object->_borderColors.top) &&
+  CGColorEqualToColor(_borderColors.left, object->_borderColors.left) &&
+  CGColorEqualToColor(_borderColors.bottom, object->_borderColors.bottom) &&
+  CGColorEqualToColor(_borderColors.right, object->_borderColors.right) &&
+  CGColorEqualToColor(_backgroundColor, object->_backgroundColor);
+}
+
+@end
+
 BOOL RCTBorderInsetsAreEqual(UIEdgeInsets borderInsets)
 {
   return
@@ -150,11 +237,12 @@ static void RCTEllipseGetIntersectionsWithLine(CGRect ellipseBounds,
   intersections[1] = (CGPoint){x2 + ellipseCenter.x, y2 + ellipseCenter.y};
 }
 
-UIImage *RCTGetBorderImage(RCTCornerRadii cornerRadii,
-                           UIEdgeInsets borderInsets,
-                           RCTBorderColors borderColors,
-                           CGColorRef backgroundColor,
-                           BOOL drawToEdge)
+static UIImage *RCTDrawBorderImage(RCTCornerRadii cornerRadii,
+                                   UIEdgeInsets borderInsets,
+                                   RCTBorderColors borderColors,
+                                   CGColorRef backgroundColor,
+                                   BOOL drawToEdge,
+                                   CGFloat scale)
 {
   const BOOL hasCornerRadii =
   cornerRadii.topLeft > RCTViewBorderThreshold ||
@@ -178,7 +266,7 @@ UIImage *RCTGetBorderImage(RCTCornerRadii cornerRadii,
 
   const CGFloat alpha = CGColorGetAlpha(backgroundColor);
   const BOOL opaque = (drawToEdge || !hasCornerRadii) && alpha == 1.0;
-  UIGraphicsBeginImageContextWithOptions(size, opaque, 0.0);
+  UIGraphicsBeginImageContextWithOptions(size, opaque, scale);
 
   CGContextRef ctx = UIGraphicsGetCurrentContext();
   const CGRect rect = {.size = size};
@@ -329,3 +417,32 @@ UIImage *RCTGetBorderImage(RCTCornerRadii cornerRadii,
 
   return [image resizableImageWithCapInsets:edgeInsets];
 }
+
+UIImage *RCTGetBorderImage(RCTCornerRadii cornerRadii,
+                           UIEdgeInsets borderInsets,
+                           RCTBorderColors borderColors,
+                           CGColorRef backgroundColor,
+                           BOOL drawToEdge)
+{
+  static RCTCache *cache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    cache = [RCTCache new];
+    cache.countLimit = RCTBorderImageCacheCountLimit;
+  });
+
+  const CGFloat scale = RCTScreenScale();
+  RCTBorderImageKey *key = [[RCTBorderImageKey alloc] initWithCornerRadii:cornerRadii
+                                                             borderInsets:borderInsets
+                                                             borderColors:borderColors
+                                                          backgroundColor:backgroundColor
+                                                               drawToEdge:drawToEdge
+                                                                    scale:scale];
+  UIImage *image = cache[key];
+  if (!image) {
+    image = RCTDrawBorderImage(cornerRadii, borderInsets, borderColors,
+                               backgroundColor, drawToEdge, scale);
+    cache[key] = image;
+  }
+  return image;
+}
@@ -36,6 +36,13 @@ typedef void (^RCTBubblingEventBlock)(NSDictionary *body);
 
 @optional
 
+/**
+ * Replaces the subviews in one go, given the full list of subviews in their
+ * new order. When implemented, manageChildren uses this instead of removing
+ * and inserting the affected children one at a time.
+ */
+- (void)reactSetSubviews:(NSArray *)subviews;
+
 // TODO: Deprecate this
 // This method is called after layout has been performed for all views known
 // to the RCTViewManager. It is only called on UIViews, not shadow views.
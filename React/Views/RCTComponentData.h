@@ -11,11 +11,16 @@
 
 #import "RCTComponent.h"
 #import "RCTDefines.h"
+#import "RCTMemoryBudget.h"
 
 @class RCTShadowView;
 @class RCTViewManager;
 
-@interface RCTComponentData : NSObject
+/**
+ * Component data for managers that recycle views report the pool of recycled
+ * views as a memory consumer.
+ */
+@interface RCTComponentData : NSObject <RCTMemoryConsumer>
 
 @property (nonatomic, copy, readonly) NSString *name;
 @property (nonatomic, strong, readonly) RCTViewManager *manager;
@@ -27,6 +32,41 @@
 - (void)setProps:(NSDictionary *)props forView:(id<RCTComponent>)view;
 - (void)setProps:(NSDictionary *)props forShadowView:(RCTShadowView *)shadowView;
 
+/**
+ * Called on the shadow queue with the props sent for the view with the given
+ * tag. Returns only those that differ from the last ones prepared for the same
+ * tag, with object values of common types already converted, to be passed to
+ * -setProps:forView: on the main thread. Returns nil if nothing has changed.
+ */
+- (NSDictionary *)preparedProps:(NSDictionary *)props forViewWithTag:(NSNumber *)tag;
+
+/**
+ * Same as -preparedProps:forViewWithTag:, but when resendingUnchangedProps is
+ * YES every prop is returned, even one equal to the last prepared value. That
+ * is for setNativeProps, which controlled components use to reset a view that
+ * the user changed, e.g. a toggled switch, to a value that was sent before.
+ */
+- (NSDictionary *)preparedProps:(NSDictionary *)props
+                 forViewWithTag:(NSNumber *)tag
+        resendingUnchangedProps:(BOOL)resendingUnchangedProps;
+
+/**
+ * Forgets the props prepared for a view, once it has been removed.
+ */
+- (void)forgetPreparedPropsForViewWithTag:(NSNumber *)tag;
+
+/**
+ * Whether the manager opted in to view recycling with -recycledViewPoolSize.
+ */
+@property (nonatomic, assign, readonly) BOOL recyclesViews;
+
+/**
+ * Resets a removed view created by this component and keeps it to be returned
+ * by a later -createViewWithTag:props: call. Returns NO, leaving the view
+ * untouched, if the view wasn't created here or the pool is already full.
+ */
+- (BOOL)recycleView:(id<RCTComponent>)view;
+
 - (NSDictionary *)viewConfig;
 
 @end
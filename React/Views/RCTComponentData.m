@@ -10,8 +10,10 @@
 #import "RCTComponentData.h"
 
 #import <objc/message.h>
+#import <objc/runtime.h>
 
 #import "RCTBridge.h"
+#import "RCTInvalidating.h"
 #import "RCTShadowView.h"
 #import "RCTUtils.h"
 #import "RCTViewManager.h"
@@ -37,12 +39,61 @@ typedef void (^RCTPropBlock)(id<RCTComponent> view, id json);
 
 @end
 
+/**
+ * A prop value that has already been converted on the shadow queue, passed to
+ * the prop block in place of its json.
+ */
+@interface RCTConvertedPropValue : NSObject
+
+@property (nonatomic, strong, readonly) id value;
+
+@end
+
+@implementation RCTConvertedPropValue
+
+- (instancetype)initWithValue:(id)value
+{
+  if ((self = [super init])) {
+    _value = value;
+  }
+  return self;
+}
+
+@end
+
+/**
+ * Types whose RCTConvert methods return an object and don't touch UIKit state
+ * that's confined to the main thread.
+ */
+static NSSet *RCTBackgroundConvertibleTypes(void)
+{
+  static NSSet *types;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    types = [NSSet setWithObjects:
+             @"UIColor", @"NSString", @"NSNumber", @"NSURL", @"NSDate",
+             @"NSTimeZone", @"NSIndexSet", @"NSStringArray", @"NSDictionaryArray",
+             nil];
+  });
+  return types;
+}
+
 @implementation RCTComponentData
 {
   id<RCTComponent> _defaultView;
   RCTShadowView *_defaultShadowView;
   NSMutableDictionary *_viewPropBlocks;
   NSMutableDictionary *_shadowPropBlocks;
+  NSMutableDictionary *_directShadowProps;
+
+  // Shadow queue only
+  NSMutableDictionary *_preparedPropsByTag;
+  NSMutableDictionary *_backgroundConverters;
+
+  // Only used by managers that recycle views
+  NSUInteger _recycledViewPoolSize;
+  NSMutableArray *_recycledViews;
+  NSMapTable *_propKeysByView;
 }
 
 - (instancetype)initWithManager:(RCTViewManager *)manager
@@ -51,12 +102,21 @@ typedef void (^RCTPropBlock)(id<RCTComponent> view, id json);
     _manager = manager;
     _viewPropBlocks = [NSMutableDictionary new];
     _shadowPropBlocks = [NSMutableDictionary new];
+    _directShadowProps = [NSMutableDictionary new];
+    _preparedPropsByTag = [NSMutableDictionary new];
+    _backgroundConverters = [NSMutableDictionary new];
 
     _name = RCTBridgeModuleNameForClass([manager class]);
     RCTAssert(_name.length, @"Invalid moduleName '%@'", _name);
     if ([_name hasSuffix:@"Manager"]) {
       _name = [_name substringToIndex:_name.length - @"Manager".length];
     }
+
+    _recycledViewPoolSize = [manager recycledViewPoolSize];
+    if (_recycledViewPoolSize) {
+      _recycledViews = [NSMutableArray new];
+      _propKeysByView = [NSMapTable weakToStrongObjectsMapTable];
+    }
   }
   return self;
 }
@@ -67,8 +127,18 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 {
   RCTAssertMainThread();
 
-  id<RCTComponent> view = (id<RCTComponent>)(props ? [_manager viewWithProps:props] : [_manager view]);
+  id<RCTComponent> view = tag ? _recycledViews.lastObject : nil;
+  if (view) {
+    [_recycledViews removeLastObject];
+    view.reactTag = tag;
+    return view;
+  }
+
+  view = (id<RCTComponent>)(props ? [_manager viewWithProps:props] : [_manager view]);
   view.reactTag = tag;
+  if (tag && _propKeysByView) {
+    [_propKeysByView setObject:[NSMutableSet new] forKey:view];
+  }
   if ([view isKindOfClass:[UIView class]]) {
     ((UIView *)view).multipleTouchEnabled = YES;
     ((UIView *)view).userInteractionEnabled = YES; // required for touch handling
@@ -77,6 +147,86 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   return view;
 }
 
+- (BOOL)recyclesViews
+{
+  return _recycledViewPoolSize > 0;
+}
+
+- (BOOL)recycleView:(id<RCTComponent>)view
+{
+  RCTAssertMainThread();
+
+  NSMutableSet *propKeys = [_propKeysByView objectForKey:view];
+  if (!propKeys) {
+    return NO;
+  }
+  if (_recycledViews.count >= _recycledViewPoolSize ||
+      [view conformsToProtocol:@protocol(RCTInvalidating)]) {
+    [_propKeysByView removeObjectForKey:view];
+    return NO;
+  }
+
+  // Props are reset before the tag, so that errors are logged against it
+  for (NSString *key in propKeys) {
+    [self propBlockForKey:key defaultView:_defaultView](view, (id)kCFNull);
+  }
+  [propKeys removeAllObjects];
+  view.reactTag = nil;
+
+  for (id<RCTComponent> subview in [view.reactSubviews copy]) {
+    [view removeReactSubview:subview];
+  }
+  if ([view isKindOfClass:[UIView class]]) {
+    [(UIView *)view resignFirstResponder];
+    [(UIView *)view removeFromSuperview];
+  }
+
+  [_recycledViews addObject:view];
+  return YES;
+}
+
+#pragma mark - RCTMemoryConsumer
+
+// Approximates a recycled view by the size of its backing store
+static NSUInteger RCTRecycledViewFootprint(id<RCTComponent> view)
+{
+  if (![view isKindOfClass:[UIView class]]) {
+    return 0;
+  }
+  CGSize size = ((UIView *)view).bounds.size;
+  CGFloat scale = RCTScreenScale();
+  return size.width * size.height * scale * scale * 4;
+}
+
+- (NSString *)memoryConsumerName
+{
+  return @"RecycledViews";
+}
+
+- (NSUInteger)memoryFootprint
+{
+  RCTAssertMainThread();
+
+  NSUInteger footprint = 0;
+  for (id<RCTComponent> view in _recycledViews) {
+    footprint += RCTRecycledViewFootprint(view);
+  }
+  return footprint;
+}
+
+- (void)trimMemoryToFootprint:(NSUInteger)footprint
+{
+  RCTAssertMainThread();
+
+  NSUInteger total = [self memoryFootprint];
+  while (_recycledViews.count && total > footprint) {
+    id<RCTComponent> view = _recycledViews.firstObject;
+    total -= MIN(RCTRecycledViewFootprint(view), total);
+    [_propKeysByView removeObjectForKey:view];
+    [_recycledViews removeObjectAtIndex:0];
+  }
+}
+
 - (RCTShadowView *)createShadowViewWithTag:(NSNumber *)tag
 {
   RCTShadowView *shadowView = [_manager shadowView];
@@ -85,6 +235,14 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   return shadowView;
 }
 
+static id RCTValueForKeyPathPart(id object, SEL getter, NSString *key)
+{
+  if ([object respondsToSelector:getter]) {
+    return ((id (*)(id, SEL))objc_msgSend)(object, getter);
+  }
+  return [object valueForKey:key];
+}
+
 - (RCTPropBlock)propBlockForKey:(NSString *)name defaultView:(id)defaultView
 {
   BOOL shadowView = [defaultView isKindOfClass:[RCTShadowView class]];
@@ -123,13 +281,21 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
     } else {
 
-      // Disect keypath
+      // Disect keypath. The getters leading up to the property are resolved
+      // once here, and only parts that aren't properties go through KVC.
       NSString *key = name;
       NSArray *parts = [keyPath componentsSeparatedByString:@"."];
+      NSMutableData *partGetters = nil;
       if (parts) {
         key = parts.lastObject;
+        partGetters = [NSMutableData dataWithLength:(parts.count - 1) * sizeof(SEL)];
+        SEL *getters = partGetters.mutableBytes;
+        for (NSUInteger i = 0; i < parts.count - 1; i++) {
+          getters[i] = NSSelectorFromString(parts[i]);
+        }
         parts = [parts subarrayWithRange:(NSRange){0, parts.count - 1}];
       }
+      const NSUInteger partCount = partGetters.length / sizeof(SEL);
 
       // Get property getter
       SEL getter = NSSelectorFromString(key);
@@ -161,14 +327,47 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
         NSMethodSignature *typeSignature = [[RCTConvert class] methodSignatureForSelector:type];
         switch (typeSignature.methodReturnType[0]) {
 
+  // Conversions call the RCTConvert implementation directly, and the
+  // accessors are looked up once per class of view, so that setting a
+  // primitive or struct prop doesn't go through objc_msgSend or allocate
+  #define RCT_TYPED_SETTER(_type) \
+          _type (*convert)(id, SEL, id) = (typeof(convert))[RCTConvert methodForSelector:type]; \
+          __block Class getterClass = Nil; \
+          __block _type (*get)(id, SEL) = NULL; \
+          __block Class setterClass = Nil; \
+          __block void (*set)(id, SEL, _type) = NULL; \
+          setterBlock = ^(id target, id source, id json) { \
+            if (!target) { \
+              return; \
+            } \
+            _type value; \
+            if (json) { \
+              value = convert([RCTConvert class], type, json); \
+            } else if (source) { \
+              if (object_getClass(source) != getterClass) { \
+                getterClass = object_getClass(source); \
+                get = (typeof(get))class_getMethodImplementation(getterClass, getter); \
+              } \
+              value = get(source, getter); \
+            } else { \
+              memset(&value, 0, sizeof(value)); \
+            } \
+            if (object_getClass(target) != setterClass) { \
+              setterClass = object_getClass(target); \
+              set = (typeof(set))class_getMethodImplementation(setterClass, setter); \
+            } \
+            set(target, setter, value); \
+          };
+
   #define RCT_CASE(_value, _type) \
           case _value: { \
-            _type (*convert)(id, SEL, id) = (typeof(convert))objc_msgSend; \
-            _type (*get)(id, SEL) = (typeof(get))objc_msgSend; \
-            void (*set)(id, SEL, _type) = (typeof(set))objc_msgSend; \
-            setterBlock = ^(id target, id source, id json) { \
-              set(target, setter, json ? convert([RCTConvert class], type, json) : get(source, getter)); \
-            }; \
+            RCT_TYPED_SETTER(_type) \
+            break; \
+          }
+
+  #define RCT_STRUCT_CASE(_type) \
+          if (!strcmp(typeSignature.methodReturnType, @encode(_type))) { \
+            RCT_TYPED_SETTER(_type) \
             break; \
           }
 
@@ -188,11 +387,38 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
             RCT_CASE(_C_DBL, double)
             RCT_CASE(_C_BOOL, BOOL)
             RCT_CASE(_C_PTR, void *)
-            RCT_CASE(_C_ID, id)
+
+          case _C_ID: {
+            id (*convert)(id, SEL, id) = (typeof(convert))[RCTConvert methodForSelector:type];
+            id (*get)(id, SEL) = (typeof(get))objc_msgSend;
+            void (*set)(id, SEL, id) = (typeof(set))objc_msgSend;
+            setterBlock = ^(id target, id source, id json) {
+              id value;
+              if (!json) {
+                value = get(source, getter);
+              } else if ([json isKindOfClass:[RCTConvertedPropValue class]]) {
+                value = ((RCTConvertedPropValue *)json).value;
+              } else {
+                value = convert([RCTConvert class], type, json);
+              }
+              set(target, setter, value);
+            };
+            break;
+          }
 
           case _C_STRUCT_B:
           default: {
 
+            RCT_STRUCT_CASE(CGPoint)
+            RCT_STRUCT_CASE(CGSize)
+            RCT_STRUCT_CASE(CGRect)
+            RCT_STRUCT_CASE(UIEdgeInsets)
+            RCT_STRUCT_CASE(CGAffineTransform)
+            RCT_STRUCT_CASE(CATransform3D)
+
+            // Other types go through NSInvocation, with a buffer for the
+            // value that is reused across calls
+            NSMutableData *valueBuffer = [NSMutableData dataWithLength:typeSignature.methodReturnLength];
             NSInvocation *typeInvocation = [NSInvocation invocationWithMethodSignature:typeSignature];
             typeInvocation.selector = type;
             typeInvocation.target = [RCTConvert class];
@@ -203,7 +429,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
             setterBlock = ^(id target, id source, id json) { \
 
               // Get value
-              void *value = malloc(typeSignature.methodReturnLength);
+              void *value = valueBuffer.mutableBytes;
               if (json) {
                 [typeInvocation setArgument:&json atIndex:2];
                 [typeInvocation invoke];
@@ -226,7 +452,6 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
               }
               [targetInvocation setArgument:value atIndex:2];
               [targetInvocation invokeWithTarget:target];
-              free(value);
             };
             break;
           }
@@ -236,17 +461,18 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
       propBlock = ^(__unused id view, __unused id json) {
 
         // Follow keypath
+        const SEL *getters = partGetters.bytes;
         id target = view;
-        for (NSString *part in parts) {
-          target = [target valueForKey:part];
+        for (NSUInteger i = 0; i < partCount; i++) {
+          target = RCTValueForKeyPathPart(target, getters[i], parts[i]);
         }
 
         if (json == (id)kCFNull) {
 
           // Copy default property
           id source = defaultView;
-          for (NSString *part in parts) {
-            source = [source valueForKey:part];
+          for (NSUInteger i = 0; i < partCount; i++) {
+            source = RCTValueForKeyPathPart(source, getters[i], parts[i]);
           }
           setterBlock(target, source, nil);
 
@@ -286,11 +512,90 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
     _defaultView = [self createViewWithTag:nil props:nil];
   }
 
+  [[_propKeysByView objectForKey:view] addObjectsFromArray:props.allKeys];
+
   [props enumerateKeysAndObjectsUsingBlock:^(NSString *key, id json, __unused BOOL *stop) {
     [self propBlockForKey:key defaultView:_defaultView](view, json);
   }];
 }
 
+- (NSDictionary *)preparedProps:(NSDictionary *)props forViewWithTag:(NSNumber *)tag
+{
+  return [self preparedProps:props forViewWithTag:tag resendingUnchangedProps:NO];
+}
+
+- (NSDictionary *)preparedProps:(NSDictionary *)props
+                 forViewWithTag:(NSNumber *)tag
+        resendingUnchangedProps:(BOOL)resendingUnchangedProps
+{
+  NSMutableDictionary *lastProps = _preparedPropsByTag[tag];
+  if (!lastProps) {
+    lastProps = [NSMutableDictionary dictionaryWithCapacity:props.count];
+    _preparedPropsByTag[tag] = lastProps;
+  }
+
+  NSMutableDictionary *changedProps = nil;
+  for (NSString *key in props) {
+    id json = props[key];
+    if (!resendingUnchangedProps && [lastProps[key] isEqual:json]) {
+      continue;
+    }
+    lastProps[key] = json;
+
+    if (!changedProps) {
+      changedProps = [NSMutableDictionary dictionaryWithCapacity:props.count];
+    }
+    changedProps[key] = [self backgroundConvertedValueForKey:key json:json] ?: json;
+  }
+  return changedProps;
+}
+
+- (void)forgetPreparedPropsForViewWithTag:(NSNumber *)tag
+{
+  [_preparedPropsByTag removeObjectForKey:tag];
+}
+
+- (RCTConvertedPropValue *)backgroundConvertedValueForKey:(NSString *)name json:(id)json
+{
+  if (json == (id)kCFNull) {
+    return nil;
+  }
+
+  NSValue *converter = _backgroundConverters[name];
+  if (!converter) {
+    SEL type = NULL;
+    SEL selector = NSSelectorFromString([@"propConfig_" stringByAppendingString:name]);
+    Class managerClass = [_manager class];
+    if ([managerClass respondsToSelector:selector]) {
+      NSArray *typeAndKeyPath = ((NSArray *(*)(id, SEL))objc_msgSend)(managerClass, selector);
+      BOOL custom = typeAndKeyPath.count > 1 && [typeAndKeyPath[1] isEqualToString:@"__custom__"];
+      if (!custom && [RCTBackgroundConvertibleTypes() containsObject:typeAndKeyPath[0]]) {
+        type = NSSelectorFromString([typeAndKeyPath[0] stringByAppendingString:@":"]);
+      }
+    }
+    converter = [NSValue valueWithPointer:type];
+    _backgroundConverters[name] = converter;
+  }
+
+  SEL type = converter.pointerValue;
+  if (!type) {
+    return nil;
+  }
+
+  __block id value = nil;
+  void (^convertBlock)(void) = ^{
+    value = ((id (*)(id, SEL, id))objc_msgSend)([RCTConvert class], type, json);
+  };
+  if (RCT_DEBUG) {
+    NSString *logPrefix = [NSString stringWithFormat:
+                           @"Error setting property '%@' of %@: ", name, _name];
+    RCTPerformBlockWithLogPrefix(convertBlock, logPrefix);
+  } else {
+    convertBlock();
+  }
+  return [[RCTConvertedPropValue alloc] initWithValue:value];
+}
+
 - (void)setProps:(NSDictionary *)props forShadowView:(RCTShadowView *)shadowView
 {
   if (!shadowView) {
@@ -301,13 +606,46 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
     _defaultShadowView = [self createShadowViewWithTag:nil];
   }
 
-  [props enumerateKeysAndObjectsUsingBlock:^(NSString *key, id json, __unused BOOL *stop) {
-    [self propBlockForKey:key defaultView:_defaultShadowView](shadowView, json);
-  }];
+  // Layout props are written into the css node in one go, their prop blocks
+  // would convert and set them one message send at a time
+  NSMutableDictionary *layoutProps = nil;
+  for (NSString *key in props) {
+    id json = props[key];
+    if (json != (id)kCFNull && [self canSetShadowPropDirectly:key]) {
+      if (!layoutProps) {
+        layoutProps = [NSMutableDictionary dictionaryWithCapacity:props.count];
+      }
+      layoutProps[key] = json;
+    } else {
+      [self propBlockForKey:key defaultView:_defaultShadowView](shadowView, json);
+    }
+  }
+  if (layoutProps) {
+    [shadowView setLayoutProps:layoutProps];
+  }
 
   [shadowView updateLayout];
 }
 
+- (BOOL)canSetShadowPropDirectly:(NSString *)name
+{
+  NSNumber *direct = _directShadowProps[name];
+  if (!direct) {
+    // Only props the manager exports as plain shadow view properties
+    SEL selector = NSSelectorFromString([NSString stringWithFormat:@"propConfigShadow_%@", name]);
+    Class managerClass = [_manager class];
+    BOOL exported = NO;
+    if ([managerClass respondsToSelector:selector]) {
+      NSArray *typeAndKeyPath = ((NSArray *(*)(id, SEL))objc_msgSend)(managerClass, selector);
+      exported = typeAndKeyPath.count == 1 ||
+        (typeAndKeyPath.count > 1 && [typeAndKeyPath[1] isEqualToString:name]);
+    }
+    direct = @(exported && [[_defaultShadowView class] canSetLayoutPropDirectly:name]);
+    _directShadowProps[name] = direct;
+  }
+  return direct.boolValue;
+}
+
 - (NSDictionary *)viewConfig
 {
   Class managerClass = [_manager class];
@@ -17,6 +17,20 @@ extern const CLLocationDegrees RCTMapDefaultSpan;
 extern const NSTimeInterval RCTMapRegionChangeObserveInterval;
 extern const CGFloat RCTMapZoomBoundBuffer;
 
+/**
+ * Stands in for the point annotations that fall in the same cell of the
+ * cluster grid at the current zoom level.
+ */
+@interface RCTMapCluster : MKPointAnnotation
+
+@property (nonatomic, copy) NSArray *annotations;
+
+@end
+
+@interface RCTMapClusterView : MKAnnotationView
+
+@end
+
 @interface RCTMap: MKMapView
 
 @property (nonatomic, assign) BOOL followUserLocation;
@@ -27,9 +41,21 @@ extern const CGFloat RCTMapZoomBoundBuffer;
 @property (nonatomic, strong) NSTimer *regionChangeObserveTimer;
 @property (nonatomic, strong) NSMutableArray *annotationIds;
 
+/**
+ * The size in points of the grid cells annotations are clustered into.
+ * Clustering is off when this is 0, which is the default.
+ */
+@property (nonatomic, assign) CGFloat annotationClusterSize;
+
 @property (nonatomic, copy) RCTBubblingEventBlock onChange;
 @property (nonatomic, copy) RCTBubblingEventBlock onPress;
 
 - (void)setAnnotations:(RCTPointAnnotationArray *)annotations;
 
+/**
+ * Reclusters the annotations if the zoom level changed since they were last
+ * clustered. Called when the region changes.
+ */
+- (void)updateAnnotationClusters;
+
 @end
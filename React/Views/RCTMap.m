@@ -17,10 +17,65 @@ const CLLocationDegrees RCTMapDefaultSpan = 0.005;
 const NSTimeInterval RCTMapRegionChangeObserveInterval = 0.1;
 const CGFloat RCTMapZoomBoundBuffer = 0.01;
 
+static const CGFloat RCTMapClusterViewSize = 32;
+
+static BOOL RCTStringsEqual(NSString *a, NSString *b)
+{
+  return a == b || [a isEqualToString:b];
+}
+
+@implementation RCTMapCluster
+
+@end
+
+@implementation RCTMapClusterView
+{
+  UILabel *_countLabel;
+}
+
+- (instancetype)initWithAnnotation:(id<MKAnnotation>)annotation reuseIdentifier:(NSString *)reuseIdentifier
+{
+  if ((self = [super initWithAnnotation:annotation reuseIdentifier:reuseIdentifier])) {
+    self.frame = CGRectMake(0, 0, RCTMapClusterViewSize, RCTMapClusterViewSize);
+    self.backgroundColor = [UIColor colorWithRed:0 green:0.48 blue:1 alpha:0.85];
+    self.layer.cornerRadius = RCTMapClusterViewSize / 2;
+    self.layer.borderWidth = 2;
+    self.layer.borderColor = [UIColor whiteColor].CGColor;
+
+    _countLabel = [[UILabel alloc] initWithFrame:CGRectInset(self.bounds, 4, 4)];
+    _countLabel.textAlignment = NSTextAlignmentCenter;
+    _countLabel.textColor = [UIColor whiteColor];
+    _countLabel.font = [UIFont boldSystemFontOfSize:13];
+    _countLabel.adjustsFontSizeToFitWidth = YES;
+    _countLabel.minimumScaleFactor = 0.5;
+    [self addSubview:_countLabel];
+    [self setAnnotation:annotation];
+  }
+  return self;
+}
+
+- (void)setAnnotation:(id<MKAnnotation>)annotation
+{
+  super.annotation = annotation;
+  RCTMapCluster *cluster = (RCTMapCluster *)annotation;
+  _countLabel.text = [cluster isKindOfClass:[RCTMapCluster class]] ?
+    [NSString stringWithFormat:@"%zd", cluster.annotations.count] : nil;
+}
+
+@end
+
 @implementation RCTMap
 {
   UIView *_legalLabel;
   CLLocationManager *_locationManager;
+
+  // Point annotations in prop order, and by identifier
+  NSArray *_pointAnnotations;
+  NSDictionary *_pointAnnotationsById;
+
+  // Clusters on display, by cell, and the cell size they were built with
+  NSDictionary *_clustersByCell;
+  double _clusterCellSize;
 }
 
 - (instancetype)init
@@ -114,50 +169,158 @@ const CGFloat RCTMapZoomBoundBuffer = 0.01;
 
 - (void)setAnnotations:(RCTPointAnnotationArray *)annotations
 {
-  NSMutableArray *newAnnotationIds = [NSMutableArray new];
-  NSMutableArray *annotationsToDelete = [NSMutableArray new];
-  NSMutableArray *annotationsToAdd = [NSMutableArray new];
+  NSMutableArray *pointAnnotations = [NSMutableArray arrayWithCapacity:annotations.count];
+  NSMutableDictionary *pointAnnotationsById = [NSMutableDictionary dictionaryWithCapacity:annotations.count];
+  NSMutableArray *annotationIds = [NSMutableArray arrayWithCapacity:annotations.count];
 
   for (RCTPointAnnotation *annotation in annotations) {
-    if (![annotation isKindOfClass:[RCTPointAnnotation class]]) {
+    if (![annotation isKindOfClass:[RCTPointAnnotation class]] ||
+        !annotation.identifier || pointAnnotationsById[annotation.identifier]) {
       continue;
     }
 
-    [newAnnotationIds addObject:annotation.identifier];
+    // Keep the annotation already on the map when only its coordinate or text
+    // changed. MapKit observes those, and moves the pin instead of replacing it.
+    RCTPointAnnotation *existing = _pointAnnotationsById[annotation.identifier];
+    if (existing &&
+        existing.animateDrop == annotation.animateDrop &&
+        existing.hasLeftCallout == annotation.hasLeftCallout &&
+        existing.hasRightCallout == annotation.hasRightCallout) {
+      if (existing.coordinate.latitude != annotation.coordinate.latitude ||
+          existing.coordinate.longitude != annotation.coordinate.longitude) {
+        existing.coordinate = annotation.coordinate;
+      }
+      if (!RCTStringsEqual(existing.title, annotation.title)) {
+        existing.title = annotation.title;
+      }
+      if (!RCTStringsEqual(existing.subtitle, annotation.subtitle)) {
+        existing.subtitle = annotation.subtitle;
+      }
+      annotation = existing;
+    }
+
+    [pointAnnotations addObject:annotation];
+    pointAnnotationsById[annotation.identifier] = annotation;
+    [annotationIds addObject:annotation.identifier];
+  }
 
-    // If the current set does not contain the new annotation, mark it as add
-    if (![self.annotationIds containsObject:annotation.identifier]) {
-      [annotationsToAdd addObject:annotation];
+  _pointAnnotations = pointAnnotations;
+  _pointAnnotationsById = pointAnnotationsById;
+  self.annotationIds = annotationIds;
+
+  // Coordinates may have changed, so the clusters must be rebuilt
+  _clusterCellSize = 0;
+  [self updateAnnotationClusters];
+}
+
+- (void)setAnnotationClusterSize:(CGFloat)annotationClusterSize
+{
+  if (_annotationClusterSize != annotationClusterSize) {
+    _annotationClusterSize = annotationClusterSize;
+    _clusterCellSize = 0;
+    [self updateAnnotationClusters];
+  }
+}
+
+- (void)updateAnnotationClusters
+{
+  // The size of a cluster cell in map points, at the current zoom level
+  double cellSize = 0;
+  if (_annotationClusterSize > 0 && self.bounds.size.width > 0) {
+    cellSize = _annotationClusterSize * self.visibleMapRect.size.width / self.bounds.size.width;
+  }
+
+  if (cellSize <= 0) {
+    _clustersByCell = nil;
+    _clusterCellSize = 0;
+    [self _displayAnnotations:_pointAnnotations];
+    return;
+  }
+
+  // Panning doesn't move annotations between cells
+  if (_clusterCellSize > 0 && fabs(cellSize / _clusterCellSize - 1) < 0.01) {
+    return;
+  }
+
+  NSMutableDictionary *membersByCell = [NSMutableDictionary new];
+  NSMutableArray *cells = [NSMutableArray new];
+  for (RCTPointAnnotation *annotation in _pointAnnotations) {
+    MKMapPoint point = MKMapPointForCoordinate(annotation.coordinate);
+    NSValue *cell = [NSValue valueWithCGPoint:CGPointMake(floor(point.x / cellSize),
+                                                          floor(point.y / cellSize))];
+    NSMutableArray *members = membersByCell[cell];
+    if (!members) {
+      members = [NSMutableArray new];
+      membersByCell[cell] = members;
+      [cells addObject:cell];
     }
+    [members addObject:annotation];
   }
 
-  for (RCTPointAnnotation *annotation in self.annotations) {
-    if (![annotation isKindOfClass:[RCTPointAnnotation class]]) {
+  NSMutableArray *displayedAnnotations = [NSMutableArray arrayWithCapacity:cells.count];
+  NSMutableDictionary *clustersByCell = [NSMutableDictionary new];
+  for (NSValue *cell in cells) {
+    NSArray *members = membersByCell[cell];
+    if (members.count == 1) {
+      [displayedAnnotations addObject:members[0]];
       continue;
     }
 
-    // If the new set does not contain an existing annotation, mark it as delete
-    if (![newAnnotationIds containsObject:annotation.identifier]) {
-      [annotationsToDelete addObject:annotation];
+    CLLocationDegrees latitude = 0, longitude = 0;
+    for (RCTPointAnnotation *member in members) {
+      latitude += member.coordinate.latitude;
+      longitude += member.coordinate.longitude;
     }
-  }
+    CLLocationCoordinate2D center = {latitude / members.count, longitude / members.count};
 
-  if (annotationsToDelete.count) {
-    [self removeAnnotations:annotationsToDelete];
+    // Reuse the cluster that had as many annotations, so its view is kept
+    RCTMapCluster *cluster = _clustersByCell[cell];
+    if (cluster.annotations.count != members.count) {
+      cluster = [RCTMapCluster new];
+    }
+    cluster.annotations = members;
+    cluster.coordinate = center;
+    clustersByCell[cell] = cluster;
+    [displayedAnnotations addObject:cluster];
   }
 
-  if (annotationsToAdd.count) {
-    [self addAnnotations:annotationsToAdd];
+  _clustersByCell = clustersByCell;
+  _clusterCellSize = cellSize;
+  [self _displayAnnotations:displayedAnnotations];
+}
+
+/**
+ * Adds and removes only the point annotations and clusters that differ from
+ * what the map is showing.
+ */
+- (void)_displayAnnotations:(NSArray *)annotations
+{
+  NSArray *currentAnnotations = self.annotations;
+  NSSet *displayedAnnotations = [NSSet setWithArray:annotations];
+  NSSet *currentAnnotationSet = [NSSet setWithArray:currentAnnotations];
+
+  NSMutableArray *annotationsToRemove = [NSMutableArray new];
+  for (id<MKAnnotation> annotation in currentAnnotations) {
+    if (([annotation isKindOfClass:[RCTPointAnnotation class]] ||
+         [annotation isKindOfClass:[RCTMapCluster class]]) &&
+        ![displayedAnnotations containsObject:annotation]) {
+      [annotationsToRemove addObject:annotation];
+    }
   }
 
-  NSMutableArray *newIds = [NSMutableArray new];
-  for (RCTPointAnnotation *anno in self.annotations) {
-    if ([anno isKindOfClass:[MKUserLocation class]]) {
-      continue;
+  NSMutableArray *annotationsToAdd = [NSMutableArray new];
+  for (id<MKAnnotation> annotation in annotations) {
+    if (![currentAnnotationSet containsObject:annotation]) {
+      [annotationsToAdd addObject:annotation];
     }
-    [newIds addObject:anno.identifier];
   }
-  self.annotationIds = newIds;
+
+  if (annotationsToRemove.count) {
+    [self removeAnnotations:annotationsToRemove];
+  }
+  if (annotationsToAdd.count) {
+    [self addAnnotations:annotationsToAdd];
+  }
 }
 
 @end
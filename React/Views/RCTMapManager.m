@@ -20,6 +20,8 @@
 #import <MapKit/MapKit.h>
 
 static NSString *const RCTMapViewKey = @"MapView";
+static NSString *const RCTAnnotationReuseIdentifier = @"RCTAnnotation";
+static NSString *const RCTMapClusterReuseIdentifier = @"RCTMapCluster";
 
 @interface RCTMapManager() <MKMapViewDelegate>
 
@@ -46,6 +48,7 @@ RCT_EXPORT_VIEW_PROPERTY(minDelta, CGFloat)
 RCT_EXPORT_VIEW_PROPERTY(legalLabelInsets, UIEdgeInsets)
 RCT_EXPORT_VIEW_PROPERTY(mapType, MKMapType)
 RCT_EXPORT_VIEW_PROPERTY(annotations, RCTPointAnnotationArray)
+RCT_EXPORT_VIEW_PROPERTY(annotationClusterSize, CGFloat)
 RCT_EXPORT_VIEW_PROPERTY(onChange, RCTBubblingEventBlock)
 RCT_EXPORT_VIEW_PROPERTY(onPress, RCTBubblingEventBlock)
 RCT_CUSTOM_VIEW_PROPERTY(region, MKCoordinateRegion, RCTMap)
@@ -57,6 +60,19 @@ RCT_CUSTOM_VIEW_PROPERTY(region, MKCoordinateRegion, RCTMap)
 
 - (void)mapView:(RCTMap *)mapView didSelectAnnotationView:(MKAnnotationView *)view
 {
+  if ([view.annotation isKindOfClass:[RCTMapCluster class]]) {
+
+    // Zoom in on the annotations of the cluster
+    MKMapRect rect = MKMapRectNull;
+    for (RCTPointAnnotation *annotation in ((RCTMapCluster *)view.annotation).annotations) {
+      MKMapPoint point = MKMapPointForCoordinate(annotation.coordinate);
+      rect = MKMapRectUnion(rect, (MKMapRect){point, {0, 0}});
+    }
+    [mapView deselectAnnotation:view.annotation animated:NO];
+    [mapView setVisibleMapRect:rect edgePadding:UIEdgeInsetsMake(40, 40, 40, 40) animated:YES];
+    return;
+  }
+
   if (mapView.onPress && [view.annotation isKindOfClass:[RCTPointAnnotation class]]) {
 
     RCTPointAnnotation *annotation = (RCTPointAnnotation *)view.annotation;
@@ -73,13 +89,28 @@ RCT_CUSTOM_VIEW_PROPERTY(region, MKCoordinateRegion, RCTMap)
   }
 }
 
-- (MKAnnotationView *)mapView:(__unused MKMapView *)mapView viewForAnnotation:(RCTPointAnnotation *)annotation
+- (MKAnnotationView *)mapView:(MKMapView *)mapView viewForAnnotation:(RCTPointAnnotation *)annotation
 {
+  if ([annotation isKindOfClass:[RCTMapCluster class]]) {
+    MKAnnotationView *clusterView = [mapView dequeueReusableAnnotationViewWithIdentifier:RCTMapClusterReuseIdentifier];
+    if (clusterView) {
+      clusterView.annotation = annotation;
+    } else {
+      clusterView = [[RCTMapClusterView alloc] initWithAnnotation:annotation reuseIdentifier:RCTMapClusterReuseIdentifier];
+    }
+    return clusterView;
+  }
+
   if (![annotation isKindOfClass:[RCTPointAnnotation class]]) {
     return nil;
   }
 
-  MKPinAnnotationView *annotationView = [[MKPinAnnotationView alloc] initWithAnnotation:annotation reuseIdentifier:@"RCTAnnotation"];
+  MKPinAnnotationView *annotationView = (MKPinAnnotationView *)[mapView dequeueReusableAnnotationViewWithIdentifier:RCTAnnotationReuseIdentifier];
+  if (annotationView) {
+    annotationView.annotation = annotation;
+  } else {
+    annotationView = [[MKPinAnnotationView alloc] initWithAnnotation:annotation reuseIdentifier:RCTAnnotationReuseIdentifier];
+  }
 
   annotationView.canShowCallout = true;
   annotationView.animatesDrop = annotation.animateDrop;
@@ -144,6 +175,7 @@ RCT_CUSTOM_VIEW_PROPERTY(region, MKCoordinateRegion, RCTMap)
   mapView.regionChangeObserveTimer = nil;
 
   [self _regionChanged:mapView];
+  [mapView updateAnnotationClusters];
 
   // Don't send region did change events until map has
   // started rendering, as these won't represent the final location
@@ -266,6 +266,7 @@ NSInteger kNeverProgressed = -10000;
 {
   __weak RCTBridge *_bridge;
   NSInteger _numberOfViewControllerMovesToIgnore;
+  RCTWrapperViewController *_pendingPushViewController;
 }
 
 @synthesize paused = _paused;
@@ -451,6 +452,10 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
   // hooked up yet, so we do it on demand here
   [self reactAddControllerToClosestParent:_navigationController];
 
+  // A push that is still waiting for its run loop turn has to happen first,
+  // so that the view controller count below is up to date
+  [self pushPendingViewController];
+
   NSUInteger viewControllerCount = _navigationController.viewControllers.count;
   // The "react count" is the count of views that are visible on the navigation
   // stack.  There may be more beyond this - that aren't visible, and may be
@@ -510,7 +515,19 @@ BOOL jsGettingtooSlow =
       RCTWrapperViewController *vc = [[RCTWrapperViewController alloc] initWithNavItem:(RCTNavItem *)lastView];
       vc.navigationListener = self;
       _numberOfViewControllerMovesToIgnore = 1;
-      [_navigationController pushViewController:vc animated:(currentReactCount > 1)];
+      if (currentReactCount > 1) {
+        // Lay out and draw the incoming scene now, and only start the
+        // transition on the next turn of the run loop. The views have just
+        // been created in this batch, so this keeps all of the work of
+        // building the scene out of the animation.
+        [vc prepareForPresentationWithFrame:_navigationController.view.bounds];
+        _pendingPushViewController = vc;
+        dispatch_async(dispatch_get_main_queue(), ^{
+          [self pushPendingViewController];
+        });
+      } else {
+        [_navigationController pushViewController:vc animated:NO];
+      }
     } else if (reactPopN) {
       UIViewController *viewControllerToPopTo = _navigationController.viewControllers[(currentReactCount - 1)];
       _numberOfViewControllerMovesToIgnore = viewControllerCount - currentReactCount;
@@ -529,6 +546,15 @@ BOOL jsGettingtooSlow =
   _previousRequestedTopOfStack = _requestedTopOfStack;
 }
 
+- (void)pushPendingViewController
+{
+  RCTWrapperViewController *viewController = _pendingPushViewController;
+  if (viewController) {
+    _pendingPushViewController = nil;
+    [_navigationController pushViewController:viewController animated:YES];
+  }
+}
+
 // TODO: This will likely fail when performing multiple pushes/pops. We must
 // free the lock only after the *last* push/pop.
 - (void)wrapperViewController:(RCTWrapperViewController *)wrapperViewController
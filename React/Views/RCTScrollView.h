@@ -46,6 +46,14 @@
 @property (nonatomic, assign) BOOL centerContent;
 @property (nonatomic, copy) NSIndexSet *stickyHeaderIndices;
 
+/**
+ * Distance beyond the visible bounds that JS keeps mounted when windowing its
+ * content. When set, a scroll event is sent whenever the content has moved by
+ * half this distance since the last one, regardless of `scrollEventThrottle`,
+ * so the window is updated before unmounted content comes into view.
+ */
+@property (nonatomic, assign) CGFloat windowOverscan;
+
 @end
 
 @interface RCTEventDispatcher (RCTScrollView)
@@ -14,6 +14,7 @@
 #import "RCTConvert.h"
 #import "RCTEventDispatcher.h"
 #import "RCTLog.h"
+#import "RCTThreadPriority.h"
 #import "RCTUIManager.h"
 #import "RCTUtils.h"
 #import "UIView+Private.h"
@@ -22,40 +23,80 @@
 CGFloat const ZINDEX_DEFAULT = 0;
 CGFloat const ZINDEX_STICKY_HEADER = 50;
 
+static NSDictionary *RCTScrollMetrics(UIScrollView *scrollView)
+{
+  return @{
+    @"contentOffset": @{
+      @"x": @(scrollView.contentOffset.x),
+      @"y": @(scrollView.contentOffset.y)
+    },
+    @"contentInset": @{
+      @"top": @(scrollView.contentInset.top),
+      @"left": @(scrollView.contentInset.left),
+      @"bottom": @(scrollView.contentInset.bottom),
+      @"right": @(scrollView.contentInset.right)
+    },
+    @"contentSize": @{
+      @"width": @(scrollView.contentSize.width),
+      @"height": @(scrollView.contentSize.height)
+    },
+    @"layoutMeasurement": @{
+      @"width": @(scrollView.frame.size.width),
+      @"height": @(scrollView.frame.size.height)
+    },
+    @"zoomScale": @(scrollView.zoomScale ?: 1),
+  };
+}
+
 @interface RCTScrollEvent : NSObject <RCTEvent>
 
+- (instancetype)initWithType:(RCTScrollEventType)type
+                    reactTag:(NSNumber *)reactTag
+                        body:(NSDictionary *)body NS_DESIGNATED_INITIALIZER;
+
 - (instancetype)initWithType:(RCTScrollEventType)type
                     reactTag:(NSNumber *)reactTag
                   scrollView:(UIScrollView *)scrollView
-                    userData:(NSDictionary *)userData NS_DESIGNATED_INITIALIZER;
+                    userData:(NSDictionary *)userData;
 
 @end
 
 @implementation RCTScrollEvent
 {
   RCTScrollEventType _type;
-  UIScrollView *_scrollView;
-  NSDictionary *_userData;
+  NSDictionary *_body;
 }
 
 @synthesize viewTag = _viewTag;
 
 - (instancetype)initWithType:(RCTScrollEventType)type
                     reactTag:(NSNumber *)reactTag
-                  scrollView:(UIScrollView *)scrollView
-                    userData:(NSDictionary *)userData
+                        body:(NSDictionary *)body
 {
   RCTAssertParam(reactTag);
 
   if ((self = [super init])) {
     _type = type;
     _viewTag = reactTag;
-    _scrollView = scrollView;
-    _userData = userData;
+    _body = body;
   }
   return self;
 }
 
+- (instancetype)initWithType:(RCTScrollEventType)type
+                    reactTag:(NSNumber *)reactTag
+                  scrollView:(UIScrollView *)scrollView
+                    userData:(NSDictionary *)userData
+{
+  NSDictionary *body = RCTScrollMetrics(scrollView);
+  if (userData) {
+    NSMutableDictionary *mutableBody = [body mutableCopy];
+    [mutableBody addEntriesFromDictionary:userData];
+    body = mutableBody;
+  }
+  return [self initWithType:type reactTag:reactTag body:body];
+}
+
 RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
 - (uint16_t)coalescingKey
@@ -65,35 +106,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
 - (NSDictionary *)body
 {
-  NSDictionary *body = @{
-    @"contentOffset": @{
-      @"x": @(_scrollView.contentOffset.x),
-      @"y": @(_scrollView.contentOffset.y)
-    },
-    @"contentInset": @{
-      @"top": @(_scrollView.contentInset.top),
-      @"left": @(_scrollView.contentInset.left),
-      @"bottom": @(_scrollView.contentInset.bottom),
-      @"right": @(_scrollView.contentInset.right)
-    },
-    @"contentSize": @{
-      @"width": @(_scrollView.contentSize.width),
-      @"height": @(_scrollView.contentSize.height)
-    },
-    @"layoutMeasurement": @{
-      @"width": @(_scrollView.frame.size.width),
-      @"height": @(_scrollView.frame.size.height)
-    },
-    @"zoomScale": @(_scrollView.zoomScale ?: 1),
-  };
-
-  if (_userData) {
-    NSMutableDictionary *mutableBody = [body mutableCopy];
-    [mutableBody addEntriesFromDictionary:_userData];
-    body = mutableBody;
-  }
-
-  return body;
+  return _body;
 }
 
 - (NSString *)eventName
@@ -117,14 +130,17 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 
 - (RCTScrollEvent *)coalesceWithEvent:(RCTScrollEvent *)newEvent
 {
-  NSArray *updatedChildFrames = [_userData[@"updatedChildFrames"] arrayByAddingObjectsFromArray:newEvent->_userData[@"updatedChildFrames"]];
+  // Move events only carry the metrics that changed, so keep whatever the
+  // new event leaves out
+  NSMutableDictionary *body = [_body mutableCopy];
+  [body addEntriesFromDictionary:newEvent->_body];
 
+  NSArray *updatedChildFrames = [_body[@"updatedChildFrames"] arrayByAddingObjectsFromArray:newEvent->_body[@"updatedChildFrames"]];
   if (updatedChildFrames) {
-    NSMutableDictionary *userData = [newEvent->_userData mutableCopy];
-    userData[@"updatedChildFrames"] = updatedChildFrames;
-    newEvent->_userData = userData;
+    body[@"updatedChildFrames"] = updatedChildFrames;
   }
 
+  newEvent->_body = body;
   return newEvent;
 }
 
@@ -145,10 +161,21 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
 @property (nonatomic, copy) NSIndexSet *stickyHeaderIndices;
 @property (nonatomic, assign) BOOL centerContent;
 
+/**
+ * Marks the sticky header positions as stale, so that they are measured again
+ * on the next dock.
+ */
+- (void)invalidateStickyHeaders;
+
 @end
 
 
 @implementation RCTCustomScrollView
+{
+  NSArray *_stickyHeaders;
+  NSData *_stickyHeaderTops;
+  NSArray *_dockedHeaders;
+}
 
 - (instancetype)initWithFrame:(CGRect)frame
 {
@@ -269,16 +296,33 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   super.contentOffset = contentOffset;
 }
 
-- (void)dockClosestSectionHeader
+- (void)setStickyHeaderIndices:(NSIndexSet *)stickyHeaderIndices
 {
-  UIView *contentView = [self contentView];
-  CGFloat scrollTop = self.bounds.origin.y + self.contentInset.top;
+  _stickyHeaderIndices = [stickyHeaderIndices copy];
+  [self invalidateStickyHeaders];
+}
 
-  // Find the section headers that need to be docked
-  __block UIView *previousHeader = nil;
-  __block UIView *currentHeader = nil;
-  __block UIView *nextHeader = nil;
-  NSUInteger subviewCount = contentView.reactSubviews.count;
+- (void)invalidateStickyHeaders
+{
+  _stickyHeaderTops = nil;
+}
+
+static CGFloat RCTUntransformedTop(UIView *view)
+{
+  // center and bounds aren't affected by the docking transform
+  return view.center.y - view.bounds.size.height * view.layer.anchorPoint.y;
+}
+
+/**
+ * Builds an index of the sticky headers sorted by their untransformed top
+ * edge, so that docking only has to binary search it on each scroll tick.
+ */
+- (void)updateStickyHeaderIndex
+{
+  UIView *contentView = [self contentView];
+  NSArray *subviews = contentView.reactSubviews;
+  NSUInteger subviewCount = subviews.count;
+  NSMutableArray *headers = [NSMutableArray arrayWithCapacity:_stickyHeaderIndices.count];
   [_stickyHeaderIndices enumerateIndexesWithOptions:0 usingBlock:
    ^(NSUInteger idx, __unused BOOL *stop) {
 
@@ -286,41 +330,70 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
       RCTLogError(@"Sticky header index %zd was outside the range {0, %zd}", idx, subviewCount);
       return;
     }
+    [headers addObject:subviews[idx]];
+  }];
 
-    UIView *header = contentView.reactSubviews[idx];
-
-    // If nextHeader not yet found, search for docked headers
-    if (!nextHeader) {
-      CGFloat height = header.bounds.size.height;
-      CGFloat top = header.center.y - height * header.layer.anchorPoint.y;
-      if (top > scrollTop) {
-        nextHeader = header;
-      } else {
-        previousHeader = currentHeader;
-        currentHeader = header;
-      }
-    }
-
-    // Reset transforms for header views
-    header.transform = CGAffineTransformIdentity;
-    header.layer.zPosition = ZINDEX_DEFAULT;
+  [headers sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(UIView *a, UIView *b) {
+    CGFloat topA = RCTUntransformedTop(a), topB = RCTUntransformedTop(b);
+    return topA < topB ? NSOrderedAscending : topA > topB ? NSOrderedDescending : NSOrderedSame;
+  }];
 
+  NSMutableData *tops = [NSMutableData dataWithLength:headers.count * sizeof(CGFloat)];
+  CGFloat *topValues = tops.mutableBytes;
+  [headers enumerateObjectsUsingBlock:^(UIView *header, NSUInteger idx, __unused BOOL *stop) {
+    topValues[idx] = RCTUntransformedTop(header);
   }];
 
+  _stickyHeaders = headers;
+  _stickyHeaderTops = tops;
+}
+
+- (void)dockClosestSectionHeader
+{
+  if (!_stickyHeaderTops) {
+    [self updateStickyHeaderIndex];
+  }
+  CGFloat scrollTop = self.bounds.origin.y + self.contentInset.top;
+
+  // Find the first header below the top of the screen. The one before it is
+  // docked, and the one before that scrolls away above it.
+  const CGFloat *tops = _stickyHeaderTops.bytes;
+  NSUInteger low = 0, high = _stickyHeaders.count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (tops[mid] > scrollTop) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  NSUInteger nextIndex = low;
+  UIView *nextHeader = nextIndex < _stickyHeaders.count ? _stickyHeaders[nextIndex] : nil;
+  UIView *currentHeader = nextIndex >= 1 ? _stickyHeaders[nextIndex - 1] : nil;
+  UIView *previousHeader = nextIndex >= 2 ? _stickyHeaders[nextIndex - 2] : nil;
+
+  // Only reset the headers that were docked on the last tick
+  for (UIView *header in _dockedHeaders) {
+    if (header != currentHeader && header != previousHeader) {
+      header.transform = CGAffineTransformIdentity;
+      header.layer.zPosition = ZINDEX_DEFAULT;
+    }
+  }
+
   // If no docked header, bail out
   if (!currentHeader) {
+    _dockedHeaders = nil;
     return;
   }
 
   // Adjust current header to hug the top of the screen
   CGFloat currentFrameHeight = currentHeader.bounds.size.height;
-  CGFloat currentFrameTop = currentHeader.center.y - currentFrameHeight * currentHeader.layer.anchorPoint.y;
+  CGFloat currentFrameTop = tops[nextIndex - 1];
   CGFloat yOffset = scrollTop - currentFrameTop;
   if (nextHeader) {
     // The next header nudges the current header out of the way when it reaches
     // the top of the screen
-    CGFloat nextFrameHeight = nextHeader.bounds.size.height;
-    CGFloat nextFrameTop = nextHeader.center.y - nextFrameHeight * nextHeader.layer.anchorPoint.y;
+    CGFloat nextFrameTop = tops[nextIndex];
     CGFloat overlap = currentFrameHeight - (nextFrameTop - scrollTop);
     yOffset -= MAX(0, overlap);
   }
@@ -335,21 +408,24 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
     yOffset = targetCenter - previousHeader.center.y;
     previousHeader.transform = CGAffineTransformMakeTranslation(0, yOffset);
     previousHeader.layer.zPosition = ZINDEX_STICKY_HEADER;
+    _dockedHeaders = @[currentHeader, previousHeader];
+  } else {
+    _dockedHeaders = @[currentHeader];
   }
 }
 
 - (UIView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
 {
-  __block UIView *hitView;
-
-  [_stickyHeaderIndices enumerateIndexesWithOptions:0 usingBlock:^(NSUInteger idx, BOOL *stop) {
-    UIView *stickyHeader = [self contentView].reactSubviews[idx];
+  // Headers that aren't docked sit at their regular position, where the
+  // normal hit test finds them
+  for (UIView *stickyHeader in _dockedHeaders) {
     CGPoint convertedPoint = [stickyHeader convertPoint:point fromView:self];
-    hitView = [stickyHeader hitTest:convertedPoint withEvent:event];
-    *stop = (hitView != nil);
-  }];
-
-  return hitView ?: [super hitTest:point withEvent:event];
+    UIView *hitView = [stickyHeader hitTest:convertedPoint withEvent:event];
+    if (hitView) {
+      return hitView;
+    }
+  }
+  return [super hitTest:point withEvent:event];
 }
 
 @end
@@ -363,6 +439,11 @@ RCT_NOT_IMPLEMENTED(- (instancetype)init)
   NSMutableArray *_cachedChildFrames;
   BOOL _allowNextScrollNoMatterWhat;
   CGRect _lastClippedToRect;
+  CGPoint _lastDispatchedOffset;
+  NSDictionary *_lastScrollMetrics;
+  BOOL _decelerating;
+  CGPoint _decelerationTarget;
+  BOOL _interacting;
 }
 
 @synthesize nativeMainScrollDelegate = _nativeMainScrollDelegate;
@@ -448,6 +529,23 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:(NSCoder *)aDecoder)
 - (void)dealloc
 {
   _scrollView.delegate = nil;
+  [self setInteracting:NO];
+}
+
+/**
+ * The JS and shadow threads are boosted from the start of a drag until the
+ * scroll view comes to rest, while the touch handler's touches are cancelled.
+ */
+- (void)setInteracting:(BOOL)interacting
+{
+  if (_interacting != interacting) {
+    _interacting = interacting;
+    if (interacting) {
+      RCTBeginInteraction();
+    } else {
+      RCTEndInteraction();
+    }
+  }
 }
 
 - (void)layoutSubviews
@@ -544,8 +642,22 @@ if ([_nativeMainScrollDelegate respondsToSelector:_cmd]) { \
 
 RCT_SCROLL_EVENT_HANDLER(scrollViewDidEndScrollingAnimation, RCTScrollEventTypeEndDeceleration)
 RCT_SCROLL_EVENT_HANDLER(scrollViewWillBeginDecelerating, RCTScrollEventTypeStartDeceleration)
-RCT_SCROLL_EVENT_HANDLER(scrollViewDidEndDecelerating, RCTScrollEventTypeEndDeceleration)
-RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
+
+- (void)scrollViewDidEndDecelerating:(UIScrollView *)scrollView
+{
+  _decelerating = NO;
+  [self setInteracting:NO];
+  [_eventDispatcher sendScrollEventWithType:RCTScrollEventTypeEndDeceleration reactTag:self.reactTag scrollView:scrollView userData:nil];
+  RCT_FORWARD_SCROLL_EVENT(scrollViewDidEndDecelerating:scrollView);
+}
+
+- (void)scrollViewDidZoom:(UIScrollView *)scrollView
+{
+  // This sends every metric, so the next move event has nothing to diff against
+  _lastScrollMetrics = nil;
+  [_eventDispatcher sendScrollEventWithType:RCTScrollEventTypeMove reactTag:self.reactTag scrollView:scrollView userData:nil];
+  RCT_FORWARD_SCROLL_EVENT(scrollViewDidZoom:scrollView);
+}
 
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView
 {
@@ -553,6 +665,10 @@ RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
   [self updateClippedSubviews];
 
   NSTimeInterval now = CACurrentMediaTime();
+  CGPoint offset = scrollView.contentOffset;
+  BOOL windowMoved = _windowOverscan > 0 &&
+    (ABS(offset.x - _lastDispatchedOffset.x) > _windowOverscan / 2 ||
+     ABS(offset.y - _lastDispatchedOffset.y) > _windowOverscan / 2);
 
   /**
    * TODO: this logic looks wrong, and it may be because it is. Currently, if _scrollEventThrottle
@@ -560,20 +676,53 @@ RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
    * while scrolling as expected. However, if you "fix" that bug, ScrollView will generate repeated
    * warnings, and behave strangely (ListView works fine however), so don't fix it unless you fix that too!
    */
-  if (_allowNextScrollNoMatterWhat ||
+  if (_allowNextScrollNoMatterWhat || windowMoved ||
       (_scrollEventThrottle > 0 && _scrollEventThrottle < (now - _lastScrollDispatchTime))) {
 
+    // Only send the metrics that changed since the last move event, plus the
+    // offset, which always does. ScrollView.js fills in the rest.
+    NSDictionary *metrics = RCTScrollMetrics(scrollView);
+    NSMutableDictionary *body = [NSMutableDictionary new];
+    [metrics enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, __unused BOOL *stop) {
+      if (![_lastScrollMetrics[key] isEqual:value] || [key isEqualToString:@"contentOffset"]) {
+        body[key] = value;
+      }
+    }];
+    _lastScrollMetrics = metrics;
+
     // Calculate changed frames
-    NSArray *childFrames = [self calculateChildFramesData];
+    body[@"updatedChildFrames"] = [self calculateChildFramesData];
+
+    // Velocity is in points per millisecond, the same unit as scrollEndDrag
+    NSTimeInterval elapsedMs = (now - _lastScrollDispatchTime) * 1000;
+    CGPoint velocity = CGPointZero;
+    if (elapsedMs > 0) {
+      velocity = CGPointMake((offset.x - _lastDispatchedOffset.x) / elapsedMs,
+                             (offset.y - _lastDispatchedOffset.y) / elapsedMs);
+    }
+    body[@"velocity"] = @{@"x": @(velocity.x), @"y": @(velocity.y)};
+
+    // Where the scroll is expected to settle. Once decelerating, UIKit has
+    // already decided; while dragging, project the current velocity the same
+    // way UIKit would if the touch ended now.
+    CGPoint target = _decelerationTarget;
+    if (!_decelerating) {
+      CGFloat projection = scrollView.decelerationRate / (1 - scrollView.decelerationRate);
+      target = CGPointMake(offset.x + velocity.x * projection, offset.y + velocity.y * projection);
+    }
+    if (_decelerating || scrollView.isDragging) {
+      body[@"targetContentOffset"] = @{@"x": @(target.x), @"y": @(target.y)};
+    }
 
     // Dispatch event
-    [_eventDispatcher sendScrollEventWithType:RCTScrollEventTypeMove
-                                     reactTag:self.reactTag
-                                   scrollView:scrollView
-                                     userData:@{@"updatedChildFrames": childFrames}];
+    RCTScrollEvent *scrollEvent = [[RCTScrollEvent alloc] initWithType:RCTScrollEventTypeMove
+                                                              reactTag:self.reactTag
+                                                                  body:body];
+    [_eventDispatcher sendEvent:scrollEvent];
 
     // Update dispatch time
     _lastScrollDispatchTime = now;
+    _lastDispatchedOffset = offset;
     _allowNextScrollNoMatterWhat = NO;
   }
   RCT_FORWARD_SCROLL_EVENT(scrollViewDidScroll:scrollView);
@@ -614,6 +763,10 @@ RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
 - (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView
 {
   _allowNextScrollNoMatterWhat = YES; // Ensure next scroll event is recorded, regardless of throttle
+  _decelerating = NO;
+  _lastDispatchedOffset = scrollView.contentOffset;
+  _lastScrollDispatchTime = CACurrentMediaTime();
+  [self setInteracting:YES];
   [_eventDispatcher sendScrollEventWithType:RCTScrollEventTypeStart reactTag:self.reactTag scrollView:scrollView userData:nil];
   RCT_FORWARD_SCROLL_EVENT(scrollViewWillBeginDragging:scrollView);
 }
@@ -632,10 +785,17 @@ RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
   };
   [_eventDispatcher sendScrollEventWithType:RCTScrollEventTypeEnd reactTag:self.reactTag scrollView:scrollView userData:userData];
   RCT_FORWARD_SCROLL_EVENT(scrollViewWillEndDragging:scrollView withVelocity:velocity targetContentOffset:targetContentOffset);
+
+  // Read the target after forwarding, since the delegate may have changed it
+  _decelerating = !CGPointEqualToPoint(velocity, CGPointZero);
+  _decelerationTarget = *targetContentOffset;
 }
 
 - (void)scrollViewDidEndDragging:(UIScrollView *)scrollView willDecelerate:(BOOL)decelerate
 {
+  if (!decelerate) {
+    [self setInteracting:NO];
+  }
   RCT_FORWARD_SCROLL_EVENT(scrollViewDidEndDragging:scrollView willDecelerate:decelerate);
 }
 
@@ -750,6 +910,8 @@ RCT_SCROLL_EVENT_HANDLER(scrollViewDidZoom, RCTScrollEventTypeMove)
     _scrollView.contentSize = contentSize;
     _scrollView.contentOffset = newOffset;
   }
+  // Any transaction may have moved the headers
+  [_scrollView invalidateStickyHeaders];
   [_scrollView dockClosestSectionHeader];
 }
 
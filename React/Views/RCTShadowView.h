@@ -20,7 +20,19 @@ typedef NS_ENUM(NSUInteger, RCTUpdateLifecycle) {
   RCTUpdateLifecycleDirtied,
 };
 
-typedef void (^RCTApplierBlock)(RCTSparseArray *viewRegistry);
+/**
+ * The view updates found while propagating properties down the shadow tree,
+ * kept as a flat list of (reactTag, setter, value) and applied to the views in
+ * order on the main thread. Each setter takes a single object.
+ */
+@interface RCTViewPropertyUpdates : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (void)addUpdateForReactTag:(NSNumber *)reactTag setter:(SEL)setter value:(id)value;
+- (void)applyToViewRegistry:(RCTSparseArray *)viewRegistry;
+
+@end
 
 /**
  * ShadowView tree mirrors RCT view tree. Every node is highly stateful.
@@ -109,18 +121,20 @@ typedef void (^RCTApplierBlock)(RCTSparseArray *viewRegistry);
 @property (nonatomic, assign) CGFloat flex;
 
 /**
- * Calculate property changes that need to be propagated to the view.
- * The applierBlocks set contains RCTApplierBlock functions that must be applied
- * on the main thread in order to update the view.
+ * Calculate property changes that need to be propagated to the view, and add
+ * them to updates. Only the nodes whose propagation was dirtied, or whose
+ * parent properties changed, are processed, and branches without either are
+ * skipped.
  */
-- (void)collectUpdatedProperties:(NSMutableSet *)applierBlocks
+- (void)collectUpdatedProperties:(RCTViewPropertyUpdates *)updates
                 parentProperties:(NSDictionary *)parentProperties;
 
 /**
- * Process the updated properties and apply them to view. Shadow view classes
- * that add additional propagating properties should override this method.
+ * Process the updated properties and add the view updates they need. Shadow
+ * view classes that add additional propagating properties should override
+ * this method.
  */
-- (NSDictionary *)processUpdatedProperties:(NSMutableSet *)applierBlocks
+- (NSDictionary *)processUpdatedProperties:(RCTViewPropertyUpdates *)updates
                           parentProperties:(NSDictionary *)parentProperties NS_REQUIRES_SUPER;
 
 /**
@@ -130,6 +144,22 @@ typedef void (^RCTApplierBlock)(RCTSparseArray *viewRegistry);
 - (void)collectRootUpdatedFrames:(NSMutableSet *)viewsWithNewFrame
                 parentConstraint:(CGSize)parentConstraint;
 
+/**
+ * The two halves of collectRootUpdatedFrames:parentConstraint:. Both must be
+ * called on the shadow queue, since text measurement and the layout counters
+ * are shared between trees.
+ */
+- (void)layoutRootNode;
+- (void)collectLaidOutRootFrames:(NSMutableSet *)viewsWithNewFrame;
+
+/**
+ * Set on a root by collectLaidOutRootFrames:. The number of nodes whose layout
+ * was applied, and how many of them had their children laid out again rather
+ * than reusing their last layout.
+ */
+@property (nonatomic, assign, readonly) NSUInteger lastVisitedNodeCount;
+@property (nonatomic, assign, readonly) NSUInteger lastRelaidOutNodeCount;
+
 /**
  * Recursively apply layout to children.
  */
@@ -151,6 +181,21 @@ typedef void (^RCTApplierBlock)(RCTSparseArray *viewRegistry);
 - (void)setTextComputed NS_REQUIRES_SUPER;
 - (BOOL)isTextDirty;
 
+/**
+ * Whether setLayoutProps: can apply the given prop: it has to be one of the
+ * css-layout props RCTShadowView declares, with a setter this class doesn't
+ * override.
+ */
++ (BOOL)canSetLayoutPropDirectly:(NSString *)name;
+
+/**
+ * Writes non-null values of props accepted by canSetLayoutPropDirectly:
+ * straight into the css node through a lookup table, and dirties layout once,
+ * instead of going through a property setter per prop. Like those setters,
+ * margin, padding and border are only applied by updateLayout.
+ */
+- (void)setLayoutProps:(NSDictionary *)props;
+
 /**
  * Triggers a recalculation of the shadow view's layout.
  */
@@ -166,4 +211,29 @@ typedef void (^RCTApplierBlock)(RCTSparseArray *viewRegistry);
  */
 - (CGRect)measureLayoutRelativeToAncestor:(RCTShadowView *)ancestor;
 
+/**
+ * The css-layout style of this view and its subviews, together with the sizes
+ * measure() returned during the last layout, as a JSON compatible dictionary.
+ * React/Layout/perftests replays these offline to benchmark real screens.
+ */
+- (NSDictionary *)layoutFixture;
+
+/**
+ * Layout snapshots let the first layout of a tree reuse the measurements of a
+ * tree with the same structure, e.g. when a screen is shown again after the
+ * app restarts. layoutSnapshotHash covers the layout styles of the tree and
+ * the layoutContentHash of its measured views, and is 0 when one of them
+ * can't tell what its measurements depend on.
+ */
+- (uint64_t)layoutSnapshotHash;
+- (NSData *)layoutSnapshotWithHash:(uint64_t)hash;
+- (BOOL)restoreLayoutSnapshot:(NSData *)snapshot hash:(uint64_t)hash;
+
+/**
+ * Shadow views that measure their content override this to return a hash of
+ * everything their measurements depend on, which must stay the same across
+ * launches. Returns 0 by default.
+ */
+- (uint64_t)layoutContentHash;
+
 @end
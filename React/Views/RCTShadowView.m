@@ -9,6 +9,8 @@
 
 #import "RCTShadowView.h"
 
+#import <objc/message.h>
+
 #import "RCTConvert.h"
 #import "RCTLog.h"
 #import "RCTSparseArray.h"
@@ -31,11 +33,60 @@ typedef NS_ENUM(unsigned int, meta_prop_t) {
   META_PROP_COUNT,
 };
 
+typedef struct {
+  NSUInteger reactTag;
+  SEL setter;
+} RCTViewPropertyUpdate;
+
+@implementation RCTViewPropertyUpdates
+{
+  NSMutableData *_updates;
+  NSMutableArray *_values;
+}
+
+- (instancetype)init
+{
+  if ((self = [super init])) {
+    _updates = [NSMutableData new];
+    _values = [NSMutableArray new];
+  }
+  return self;
+}
+
+- (NSUInteger)count
+{
+  return _values.count;
+}
+
+- (void)addUpdateForReactTag:(NSNumber *)reactTag setter:(SEL)setter value:(id)value
+{
+  RCTViewPropertyUpdate update = {reactTag.unsignedIntegerValue, setter};
+  [_updates appendBytes:&update length:sizeof(update)];
+  [_values addObject:value ?: (id)kCFNull];
+}
+
+- (void)applyToViewRegistry:(RCTSparseArray *)viewRegistry
+{
+  const RCTViewPropertyUpdate *updates = _updates.bytes;
+  for (NSUInteger i = 0; i < _values.count; i++) {
+    id view = RCTSparseArrayGet(viewRegistry, updates[i].reactTag);
+    if ([view respondsToSelector:updates[i].setter]) {
+      id value = _values[i] == (id)kCFNull ? nil : _values[i];
+      ((void (*)(id, SEL, id))objc_msgSend)(view, updates[i].setter, value);
+    }
+  }
+}
+
+@end
+
 @implementation RCTShadowView
 {
   RCTUpdateLifecycle _propagationLifecycle;
   RCTUpdateLifecycle _textLifecycle;
   NSDictionary *_lastParentProperties;
+  NSDictionary *_lastPropagatedProperties;
+  UIColor *_lastInheritedBackgroundColor;
+  BOOL _descendantsNeedPropagation;
   NSMutableArray *_reactSubviews;
   BOOL _recomputePadding;
   BOOL _recomputeMargin;
@@ -43,6 +94,10 @@ typedef NS_ENUM(unsigned int, meta_prop_t) {
   float _paddingMetaProps[META_PROP_COUNT];
   float _marginMetaProps[META_PROP_COUNT];
   float _borderMetaProps[META_PROP_COUNT];
+  // The unrounded frame of the last layout applied, and the absolute position
+  // of the parent it was snapped at
+  CGRect _layoutFrame;
+  CGPoint _parentAbsolutePosition;
 }
 
 @synthesize reactTag = _reactTag;
@@ -55,37 +110,36 @@ static void RCTPrint(void *context)
   printf("%s(%zd), ", shadowView.viewName.UTF8String, shadowView.reactTag.integerValue);
 }
 
-static css_node_t *RCTGetChild(void *context, int i)
+static bool RCTIsDirty(void *context)
 {
   RCTShadowView *shadowView = (__bridge RCTShadowView *)context;
-  RCTShadowView *child = [shadowView reactSubviews][i];
-  return child->_cssNode;
+  return [shadowView isLayoutDirty];
 }
 
-static bool RCTIsDirty(void *context)
+static uint64_t RCTLayoutContentHash(void *context)
 {
   RCTShadowView *shadowView = (__bridge RCTShadowView *)context;
-  return [shadowView isLayoutDirty];
+  return [shadowView layoutContentHash];
 }
 
 // Enforces precedence rules, e.g. marginLeft > marginHorizontal > margin.
-static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float style[CSS_POSITION_COUNT]) {
-  style[CSS_LEFT] = !isUndefined(metaProps[META_PROP_LEFT]) ? metaProps[META_PROP_LEFT]
+static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], css_style_t *style, css_style_value_t edges) {
+  css_style_set(style, edges + CSS_LEFT, !isUndefined(metaProps[META_PROP_LEFT]) ? metaProps[META_PROP_LEFT]
   : !isUndefined(metaProps[META_PROP_HORIZONTAL]) ? metaProps[META_PROP_HORIZONTAL]
   : !isUndefined(metaProps[META_PROP_ALL]) ? metaProps[META_PROP_ALL]
-  : 0;
-  style[CSS_RIGHT] = !isUndefined(metaProps[META_PROP_RIGHT]) ? metaProps[META_PROP_RIGHT]
+  : 0);
+  css_style_set(style, edges + CSS_RIGHT, !isUndefined(metaProps[META_PROP_RIGHT]) ? metaProps[META_PROP_RIGHT]
   : !isUndefined(metaProps[META_PROP_HORIZONTAL]) ? metaProps[META_PROP_HORIZONTAL]
   : !isUndefined(metaProps[META_PROP_ALL]) ? metaProps[META_PROP_ALL]
-  : 0;
-  style[CSS_TOP] = !isUndefined(metaProps[META_PROP_TOP]) ? metaProps[META_PROP_TOP]
+  : 0);
+  css_style_set(style, edges + CSS_TOP, !isUndefined(metaProps[META_PROP_TOP]) ? metaProps[META_PROP_TOP]
   : !isUndefined(metaProps[META_PROP_VERTICAL]) ? metaProps[META_PROP_VERTICAL]
   : !isUndefined(metaProps[META_PROP_ALL]) ? metaProps[META_PROP_ALL]
-  : 0;
-  style[CSS_BOTTOM] = !isUndefined(metaProps[META_PROP_BOTTOM]) ? metaProps[META_PROP_BOTTOM]
+  : 0);
+  css_style_set(style, edges + CSS_BOTTOM, !isUndefined(metaProps[META_PROP_BOTTOM]) ? metaProps[META_PROP_BOTTOM]
   : !isUndefined(metaProps[META_PROP_VERTICAL]) ? metaProps[META_PROP_VERTICAL]
   : !isUndefined(metaProps[META_PROP_ALL]) ? metaProps[META_PROP_ALL]
-  : 0;
+  : 0);
 }
 
 - (void)fillCSSNode:(css_node_t *)node
@@ -121,6 +175,13 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
 // absoluteRight = round(absolutePosition.x + viewPosition.left + viewSize.left) + round(106.667 + 0 + 106.667) = 213.5
 // width = 213.5 - 106.5 = 107
 // You'll notice that this is the same width we calculated for the parent view because we've taken its position into account.
+//
+// The origin of the subview is then its absoluteLeft minus the parent's, 106.5 - 106.5 = 0, rather than its own
+// rounded relative position, so a view never ends up a pixel off its parent's grid when both round the same way.
+
+// Counted while collectLaidOutRootFrames: runs, which is on the shadow queue
+static NSUInteger RCTVisitedNodeCount;
+static NSUInteger RCTRelaidOutNodeCount;
 
 - (void)applyLayoutNode:(css_node_t *)node
       viewsWithNewFrame:(NSMutableSet *)viewsWithNewFrame
@@ -132,59 +193,125 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
   node->layout.should_update = false;
   _layoutLifecycle = RCTUpdateLifecycleComputed;
 
+  // A node whose last layout was reused had no children laid out this pass,
+  // so none of them has anything to apply
+  BOOL childrenHaveNewLayout = node->layout.has_new_layout;
+  node->layout.has_new_layout = false;
+
+  RCTVisitedNodeCount++;
+  if (childrenHaveNewLayout) {
+    RCTRelaidOutNodeCount++;
+  }
+
+  _layoutFrame = (CGRect){
+    {node->layout.position[CSS_LEFT], node->layout.position[CSS_TOP]},
+    {node->layout.dimensions[CSS_WIDTH], node->layout.dimensions[CSS_HEIGHT]}
+  };
+  [self snapLayoutFrameAtParentPosition:absolutePosition viewsWithNewFrame:viewsWithNewFrame];
+
+  absolutePosition.x += node->layout.position[CSS_LEFT];
+  absolutePosition.y += node->layout.position[CSS_TOP];
+
+  node->layout.dimensions[CSS_WIDTH] = CSS_UNDEFINED;
+  node->layout.dimensions[CSS_HEIGHT] = CSS_UNDEFINED;
+  node->layout.position[CSS_LEFT] = 0;
+  node->layout.position[CSS_TOP] = 0;
+
+  if (!childrenHaveNewLayout) {
+    // The children kept their layout, but where it snaps to depends on where
+    // this view is now
+    for (RCTShadowView *child in _reactSubviews) {
+      [child resnapLayoutFramesAtParentPosition:absolutePosition viewsWithNewFrame:viewsWithNewFrame];
+    }
+    return;
+  }
+
+  for (int i = 0; i < node->children_count; ++i) {
+    RCTShadowView *child = (RCTShadowView *)_reactSubviews[i];
+    [child applyLayoutNode:child->_cssNode
+         viewsWithNewFrame:viewsWithNewFrame
+          absolutePosition:absolutePosition];
+  }
+}
+
+- (void)snapLayoutFrameAtParentPosition:(CGPoint)absolutePosition
+                      viewsWithNewFrame:(NSMutableSet *)viewsWithNewFrame
+{
+  _parentAbsolutePosition = absolutePosition;
+
   CGPoint absoluteTopLeft = {
-    absolutePosition.x + node->layout.position[CSS_LEFT],
-    absolutePosition.y + node->layout.position[CSS_TOP]
+    absolutePosition.x + _layoutFrame.origin.x,
+    absolutePosition.y + _layoutFrame.origin.y
   };
 
   CGPoint absoluteBottomRight = {
-    absolutePosition.x + node->layout.position[CSS_LEFT] + node->layout.dimensions[CSS_WIDTH],
-    absolutePosition.y + node->layout.position[CSS_TOP] + node->layout.dimensions[CSS_HEIGHT]
+    absoluteTopLeft.x + _layoutFrame.size.width,
+    absoluteTopLeft.y + _layoutFrame.size.height
+  };
+
+  // All edges are snapped in absolute coordinates, and the origin is taken
+  // from the parent's snapped origin, so that frames added up along the tree
+  // land on the same pixels as the absolute edges
+  CGPoint roundedParentTopLeft = {
+    RCTRoundPixelValue(absolutePosition.x),
+    RCTRoundPixelValue(absolutePosition.y)
+  };
+  CGPoint roundedTopLeft = {
+    RCTRoundPixelValue(absoluteTopLeft.x),
+    RCTRoundPixelValue(absoluteTopLeft.y)
+  };
+  CGPoint roundedBottomRight = {
+    RCTRoundPixelValue(absoluteBottomRight.x),
+    RCTRoundPixelValue(absoluteBottomRight.y)
   };
 
   CGRect frame = {{
-    RCTRoundPixelValue(node->layout.position[CSS_LEFT]),
-    RCTRoundPixelValue(node->layout.position[CSS_TOP]),
+    roundedTopLeft.x - roundedParentTopLeft.x,
+    roundedTopLeft.y - roundedParentTopLeft.y,
   }, {
-    RCTRoundPixelValue(absoluteBottomRight.x - absoluteTopLeft.x),
-    RCTRoundPixelValue(absoluteBottomRight.y - absoluteTopLeft.y)
+    roundedBottomRight.x - roundedTopLeft.x,
+    roundedBottomRight.y - roundedTopLeft.y
   }};
 
   if (!CGRectEqualToRect(frame, _frame)) {
     _frame = frame;
     [viewsWithNewFrame addObject:self];
   }
+}
 
-  absolutePosition.x += node->layout.position[CSS_LEFT];
-  absolutePosition.y += node->layout.position[CSS_TOP];
-
-  node->layout.dimensions[CSS_WIDTH] = CSS_UNDEFINED;
-  node->layout.dimensions[CSS_HEIGHT] = CSS_UNDEFINED;
-  node->layout.position[CSS_LEFT] = 0;
-  node->layout.position[CSS_TOP] = 0;
+/**
+ * Snaps the last layout of a view that wasn't laid out again, and those of its
+ * descendants, at the new position of its parent. Stops where the parent
+ * hasn't moved, since nothing below it can have changed either.
+ */
+- (void)resnapLayoutFramesAtParentPosition:(CGPoint)absolutePosition
+                         viewsWithNewFrame:(NSMutableSet *)viewsWithNewFrame
+{
+  if (CGPointEqualToPoint(absolutePosition, _parentAbsolutePosition)) {
+    return;
+  }
+  [self snapLayoutFrameAtParentPosition:absolutePosition viewsWithNewFrame:viewsWithNewFrame];
 
-  for (int i = 0; i < node->children_count; ++i) {
-    RCTShadowView *child = (RCTShadowView *)_reactSubviews[i];
-    [child applyLayoutNode:node->get_child(node->context, i)
-         viewsWithNewFrame:viewsWithNewFrame
-          absolutePosition:absolutePosition];
+  CGPoint childPosition = {
+    absolutePosition.x + _layoutFrame.origin.x,
+    absolutePosition.y + _layoutFrame.origin.y
+  };
+  for (RCTShadowView *child in _reactSubviews) {
+    [child resnapLayoutFramesAtParentPosition:childPosition viewsWithNewFrame:viewsWithNewFrame];
   }
 }
 
-- (NSDictionary *)processUpdatedProperties:(NSMutableSet *)applierBlocks
+- (NSDictionary *)processUpdatedProperties:(RCTViewPropertyUpdates *)updates
                           parentProperties:(NSDictionary *)parentProperties
 {
-  // TODO: we always refresh all propagated properties when propagation is
-  // dirtied, but really we should track which properties have changed and
-  // only update those.
-
   if (!_backgroundColor) {
+    // The view keeps the last color it inherited, so only changes are sent
     UIColor *parentBackgroundColor = parentProperties[RCTBackgroundColorProp];
-    if (parentBackgroundColor) {
-      [applierBlocks addObject:^(RCTSparseArray *viewRegistry) {
-        UIView *view = viewRegistry[_reactTag];
-        [view reactSetInheritedBackgroundColor:parentBackgroundColor];
-      }];
+    if (parentBackgroundColor && ![parentBackgroundColor isEqual:_lastInheritedBackgroundColor]) {
+      _lastInheritedBackgroundColor = parentBackgroundColor;
+      [updates addUpdateForReactTag:_reactTag
+                             setter:@selector(reactSetInheritedBackgroundColor:)
+                              value:parentBackgroundColor];
     }
   } else {
     // Update parent properties for children
@@ -201,26 +328,47 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
   return parentProperties;
 }
 
-- (void)collectUpdatedProperties:(NSMutableSet *)applierBlocks
+- (void)collectUpdatedProperties:(RCTViewPropertyUpdates *)updates
                 parentProperties:(NSDictionary *)parentProperties
 {
-  if (_propagationLifecycle == RCTUpdateLifecycleComputed && [parentProperties isEqualToDictionary:_lastParentProperties]) {
+  if (_propagationLifecycle != RCTUpdateLifecycleComputed ||
+      (parentProperties != _lastParentProperties && ![parentProperties isEqualToDictionary:_lastParentProperties])) {
+    _propagationLifecycle = RCTUpdateLifecycleComputed;
+    _lastParentProperties = parentProperties;
+    _lastPropagatedProperties = [self processUpdatedProperties:updates parentProperties:parentProperties];
+  } else if (!_descendantsNeedPropagation) {
+    // Nothing changed in this branch
     return;
   }
-  _propagationLifecycle = RCTUpdateLifecycleComputed;
-  _lastParentProperties = parentProperties;
-  NSDictionary *nextProps = [self processUpdatedProperties:applierBlocks parentProperties:parentProperties];
+
+  // Children whose parent properties are the same and that weren't dirtied
+  // themselves return straight away
+  _descendantsNeedPropagation = NO;
   for (RCTShadowView *child in _reactSubviews) {
-    [child collectUpdatedProperties:applierBlocks parentProperties:nextProps];
+    [child collectUpdatedProperties:updates parentProperties:_lastPropagatedProperties];
   }
 }
 
-- (void)collectRootUpdatedFrames:(NSMutableSet *)viewsWithNewFrame
-                parentConstraint:(__unused CGSize)parentConstraint
+- (void)layoutRootNode
 {
   [self fillCSSNode:_cssNode];
   layoutNode(_cssNode, CSS_UNDEFINED, CSS_DIRECTION_INHERIT);
+}
+
+- (void)collectLaidOutRootFrames:(NSMutableSet *)viewsWithNewFrame
+{
+  RCTVisitedNodeCount = 0;
+  RCTRelaidOutNodeCount = 0;
   [self applyLayoutNode:_cssNode viewsWithNewFrame:viewsWithNewFrame absolutePosition:CGPointZero];
+  _lastVisitedNodeCount = RCTVisitedNodeCount;
+  _lastRelaidOutNodeCount = RCTRelaidOutNodeCount;
+}
+
+- (void)collectRootUpdatedFrames:(NSMutableSet *)viewsWithNewFrame
+                parentConstraint:(__unused CGSize)parentConstraint
+{
+  [self layoutRootNode];
+  [self collectLaidOutRootFrames:viewsWithNewFrame];
 }
 
 - (CGRect)measureLayoutRelativeToAncestor:(RCTShadowView *)ancestor
@@ -240,6 +388,91 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
   return (CGRect){offset, self.frame.size};
 }
 
+static id RCTLayoutFixtureNumber(float value)
+{
+  return isnan(value) ? (id)kCFNull : @(value);
+}
+
+static NSArray *RCTLayoutFixtureNumbers(const css_style_t *style, css_style_value_t values, int count)
+{
+  NSMutableArray *numbers = [NSMutableArray arrayWithCapacity:count];
+  for (int i = 0; i < count; i++) {
+    [numbers addObject:RCTLayoutFixtureNumber(css_style_get(style, values + i))];
+  }
+  return numbers;
+}
+
+- (NSDictionary *)layoutFixture
+{
+  css_style_t *style = &_cssNode->style;
+  css_layout_t *layout = &_cssNode->layout;
+
+  NSMutableArray *measurements = [NSMutableArray arrayWithCapacity:layout->cached_measurements_count];
+  for (int i = 0; i < layout->cached_measurements_count; i++) {
+    css_cached_measurement_t *measurement = &layout->cached_measurements[i];
+    [measurements addObject:@[
+      RCTLayoutFixtureNumber(measurement->width),
+      RCTLayoutFixtureNumber(measurement->result.dimensions[CSS_WIDTH]),
+      RCTLayoutFixtureNumber(measurement->result.dimensions[CSS_HEIGHT]),
+    ]];
+  }
+
+  NSMutableArray *children = [NSMutableArray arrayWithCapacity:_cssNode->children_count];
+  for (int i = 0; i < _cssNode->children_count; i++) {
+    [children addObject:[(RCTShadowView *)_reactSubviews[i] layoutFixture]];
+  }
+
+  return @{
+    @"viewName": _viewName ?: @"",
+    @"style": @{
+      @"direction": @(style->direction),
+      @"flexDirection": @(style->flex_direction),
+      @"justifyContent": @(style->justify_content),
+      @"alignContent": @(style->align_content),
+      @"alignItems": @(style->align_items),
+      @"alignSelf": @(style->align_self),
+      @"positionType": @(style->position_type),
+      @"flexWrap": @(style->flex_wrap),
+      @"flex": RCTLayoutFixtureNumber(style->flex),
+      @"margin": RCTLayoutFixtureNumbers(style, CSS_STYLE_MARGIN, 6),
+      @"position": RCTLayoutFixtureNumbers(style, CSS_STYLE_POSITION, 4),
+      @"padding": RCTLayoutFixtureNumbers(style, CSS_STYLE_PADDING, 6),
+      @"border": RCTLayoutFixtureNumbers(style, CSS_STYLE_BORDER, 6),
+      @"dimensions": RCTLayoutFixtureNumbers(style, CSS_STYLE_DIMENSIONS, 2),
+      @"minDimensions": RCTLayoutFixtureNumbers(style, CSS_STYLE_MIN_DIMENSIONS, 2),
+      @"maxDimensions": RCTLayoutFixtureNumbers(style, CSS_STYLE_MAX_DIMENSIONS, 2),
+    },
+    @"measurements": measurements,
+    @"children": children,
+  };
+}
+
+- (uint64_t)layoutSnapshotHash
+{
+  return css_node_layout_hash(_cssNode, RCTLayoutContentHash);
+}
+
+- (NSData *)layoutSnapshotWithHash:(uint64_t)hash
+{
+  size_t size = css_node_write_layout_snapshot(_cssNode, hash, NULL, 0);
+  if (!size) {
+    return nil;
+  }
+  NSMutableData *snapshot = [NSMutableData dataWithLength:size];
+  css_node_write_layout_snapshot(_cssNode, hash, snapshot.mutableBytes, size);
+  return snapshot;
+}
+
+- (BOOL)restoreLayoutSnapshot:(NSData *)snapshot hash:(uint64_t)hash
+{
+  return css_node_read_layout_snapshot(_cssNode, hash, snapshot.bytes, snapshot.length);
+}
+
+- (uint64_t)layoutContentHash
+{
+  return 0;
+}
+
 - (instancetype)init
 {
   if ((self = [super init])) {
@@ -262,7 +495,6 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
     _cssNode = new_css_node();
     _cssNode->context = (__bridge void *)self;
     _cssNode->print = RCTPrint;
-    _cssNode->get_child = RCTGetChild;
     _cssNode->is_dirty = RCTIsDirty;
     [self fillCSSNode:_cssNode];
   }
@@ -296,13 +528,25 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
 {
   if (_propagationLifecycle != RCTUpdateLifecycleDirtied) {
     _propagationLifecycle = RCTUpdateLifecycleDirtied;
-    [_superview dirtyPropagation];
+    [_superview dirtyPropagationOfDescendants];
+  }
+}
+
+/**
+ * Ancestors of a dirtied node don't need processing themselves, only a walk
+ * down to it.
+ */
+- (void)dirtyPropagationOfDescendants
+{
+  if (!_descendantsNeedPropagation) {
+    _descendantsNeedPropagation = YES;
+    [_superview dirtyPropagationOfDescendants];
   }
 }
 
 - (BOOL)isPropagationDirty
 {
-  return _propagationLifecycle != RCTUpdateLifecycleComputed;
+  return _propagationLifecycle != RCTUpdateLifecycleComputed || _descendantsNeedPropagation;
 }
 
 - (void)dirtyText
@@ -326,7 +570,7 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
 - (void)insertReactSubview:(RCTShadowView *)subview atIndex:(NSInteger)atIndex
 {
   [_reactSubviews insertObject:subview atIndex:atIndex];
-  _cssNode->children_count = (int)_reactSubviews.count;
+  css_node_insert_child(_cssNode, subview->_cssNode, (int)atIndex);
   subview->_superview = self;
   [self dirtyText];
   [self dirtyLayout];
@@ -339,8 +583,51 @@ static void RCTProcessMetaProps(const float metaProps[META_PROP_COUNT], float st
   [subview dirtyLayout];
   [subview dirtyPropagation];
   subview->_superview = nil;
-  [_reactSubviews removeObject:subview];
-  _cssNode->children_count = (int)_reactSubviews.count;
+  NSUInteger index = [_reactSubviews indexOfObject:subview];
+  if (index != NSNotFound) {
+    [_reactSubviews removeObjectAtIndex:index];
+    css_node_remove_child(_cssNode, (int)index);
+  }
+}
+
+/**
+ * Rebuilds the children in one pass, so reordering a long list is linear
+ * rather than a shift of the arrays for every moved child. Children that
+ * were removed or moved get dirtied like they would in removeReactSubview.
+ */
+- (void)reactSetSubviews:(NSArray *)subviews
+{
+  NSHashTable *newSubviews = [NSHashTable hashTableWithOptions:NSHashTableObjectPointerPersonality];
+  for (RCTShadowView *subview in subviews) {
+    [newSubviews addObject:subview];
+  }
+
+  NSUInteger oldCount = _reactSubviews.count;
+  for (NSUInteger i = 0; i < oldCount; i++) {
+    RCTShadowView *subview = _reactSubviews[i];
+    BOOL removed = ![newSubviews containsObject:subview];
+    if (removed || i >= subviews.count || subviews[i] != subview) {
+      [subview dirtyText];
+      [subview dirtyLayout];
+      [subview dirtyPropagation];
+      if (removed) {
+        subview->_superview = nil;
+      }
+    }
+  }
+
+  while (_cssNode->children_length > 0) {
+    css_node_remove_child(_cssNode, _cssNode->children_length - 1);
+  }
+  _reactSubviews = [subviews mutableCopy];
+  for (NSUInteger i = 0; i < _reactSubviews.count; i++) {
+    RCTShadowView *subview = _reactSubviews[i];
+    css_node_insert_child(_cssNode, subview->_cssNode, (int)i);
+    subview->_superview = self;
+  }
+  [self dirtyText];
+  [self dirtyLayout];
+  [self dirtyPropagation];
 }
 
 - (NSArray *)reactSubviews
@@ -439,11 +726,12 @@ RCT_PADDING_PROPERTY(Right, RIGHT)
 
 - (UIEdgeInsets)paddingAsInsets
 {
+  css_style_t *style = &_cssNode->style;
   return (UIEdgeInsets){
-    _cssNode->style.padding[CSS_TOP],
-    _cssNode->style.padding[CSS_LEFT],
-    _cssNode->style.padding[CSS_BOTTOM],
-    _cssNode->style.padding[CSS_RIGHT]
+    css_style_get(style, CSS_STYLE_PADDING + CSS_TOP),
+    css_style_get(style, CSS_STYLE_PADDING + CSS_LEFT),
+    css_style_get(style, CSS_STYLE_PADDING + CSS_BOTTOM),
+    css_style_get(style, CSS_STYLE_PADDING + CSS_RIGHT)
   };
 }
 
@@ -468,15 +756,15 @@ RCT_BORDER_PROPERTY(Right, RIGHT)
 
 // Dimensions
 
-#define RCT_DIMENSIONS_PROPERTY(setProp, getProp, cssProp) \
-- (void)set##setProp:(CGFloat)value                        \
-{                                                          \
-  _cssNode->style.dimensions[CSS_##cssProp] = value;       \
-  [self dirtyLayout];                                      \
-}                                                          \
-- (CGFloat)getProp                                         \
-{                                                          \
-  return _cssNode->style.dimensions[CSS_##cssProp];        \
+#define RCT_DIMENSIONS_PROPERTY(setProp, getProp, cssProp)                      \
+- (void)set##setProp:(CGFloat)value                                             \
+{                                                                               \
+  css_style_set(&_cssNode->style, CSS_STYLE_DIMENSIONS + CSS_##cssProp, value); \
+  [self dirtyLayout];                                                           \
+}                                                                               \
+- (CGFloat)getProp                                                              \
+{                                                                               \
+  return css_style_get(&_cssNode->style, CSS_STYLE_DIMENSIONS + CSS_##cssProp); \
 }
 
 RCT_DIMENSIONS_PROPERTY(Width, width, WIDTH)
@@ -484,15 +772,15 @@ RCT_DIMENSIONS_PROPERTY(Height, height, HEIGHT)
 
 // Position
 
-#define RCT_POSITION_PROPERTY(setProp, getProp, cssProp) \
-- (void)set##setProp:(CGFloat)value                      \
-{                                                        \
-  _cssNode->style.position[CSS_##cssProp] = value;       \
-  [self dirtyLayout];                                    \
-}                                                        \
-- (CGFloat)getProp                                       \
-{                                                        \
-  return _cssNode->style.position[CSS_##cssProp];        \
+#define RCT_POSITION_PROPERTY(setProp, getProp, cssProp)                      \
+- (void)set##setProp:(CGFloat)value                                           \
+{                                                                             \
+  css_style_set(&_cssNode->style, CSS_STYLE_POSITION + CSS_##cssProp, value); \
+  [self dirtyLayout];                                                         \
+}                                                                             \
+- (CGFloat)getProp                                                            \
+{                                                                             \
+  return css_style_get(&_cssNode->style, CSS_STYLE_POSITION + CSS_##cssProp); \
 }
 
 RCT_POSITION_PROPERTY(Top, top, TOP)
@@ -502,24 +790,25 @@ RCT_POSITION_PROPERTY(Left, left, LEFT)
 
 - (void)setFrame:(CGRect)frame
 {
-  _cssNode->style.position[CSS_LEFT] = CGRectGetMinX(frame);
-  _cssNode->style.position[CSS_TOP] = CGRectGetMinY(frame);
-  _cssNode->style.dimensions[CSS_WIDTH] = CGRectGetWidth(frame);
-  _cssNode->style.dimensions[CSS_HEIGHT] = CGRectGetHeight(frame);
+  css_style_t *style = &_cssNode->style;
+  css_style_set(style, CSS_STYLE_POSITION + CSS_LEFT, CGRectGetMinX(frame));
+  css_style_set(style, CSS_STYLE_POSITION + CSS_TOP, CGRectGetMinY(frame));
+  css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, CGRectGetWidth(frame));
+  css_style_set(style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, CGRectGetHeight(frame));
   [self dirtyLayout];
 }
 
 - (void)setTopLeft:(CGPoint)topLeft
 {
-  _cssNode->style.position[CSS_LEFT] = topLeft.x;
-  _cssNode->style.position[CSS_TOP] = topLeft.y;
+  css_style_set(&_cssNode->style, CSS_STYLE_POSITION + CSS_LEFT, topLeft.x);
+  css_style_set(&_cssNode->style, CSS_STYLE_POSITION + CSS_TOP, topLeft.y);
   [self dirtyLayout];
 }
 
 - (void)setSize:(CGSize)size
 {
-  _cssNode->style.dimensions[CSS_WIDTH] = size.width;
-  _cssNode->style.dimensions[CSS_HEIGHT] = size.height;
+  css_style_set(&_cssNode->style, CSS_STYLE_DIMENSIONS + CSS_WIDTH, size.width);
+  css_style_set(&_cssNode->style, CSS_STYLE_DIMENSIONS + CSS_HEIGHT, size.height);
   [self dirtyLayout];
 }
 
@@ -544,22 +833,171 @@ RCT_STYLE_PROPERTY(AlignItems, alignItems, align_items, css_align_t)
 RCT_STYLE_PROPERTY(Position, position, position_type, css_position_type_t)
 RCT_STYLE_PROPERTY(FlexWrap, flexWrap, flex_wrap, css_wrap_type_t)
 
+// Bulk layout props
+
+typedef NS_ENUM(NSUInteger, RCTLayoutPropKind) {
+  RCTLayoutPropMargin,
+  RCTLayoutPropPadding,
+  RCTLayoutPropBorder,
+  RCTLayoutPropDimension,
+  RCTLayoutPropPosition,
+  RCTLayoutPropFlex,
+  RCTLayoutPropFlexDirection,
+  RCTLayoutPropFlexWrap,
+  RCTLayoutPropJustifyContent,
+  RCTLayoutPropAlignItems,
+  RCTLayoutPropAlignSelf,
+  RCTLayoutPropPositionType,
+};
+
+typedef struct {
+  __unsafe_unretained NSString *name;
+  RCTLayoutPropKind kind;
+  NSUInteger index; // Meta prop, dimension or position, depending on kind
+} RCTLayoutProp;
+
+static const RCTLayoutProp RCTLayoutProps[] = {
+  {@"margin", RCTLayoutPropMargin, META_PROP_ALL},
+  {@"marginVertical", RCTLayoutPropMargin, META_PROP_VERTICAL},
+  {@"marginHorizontal", RCTLayoutPropMargin, META_PROP_HORIZONTAL},
+  {@"marginTop", RCTLayoutPropMargin, META_PROP_TOP},
+  {@"marginLeft", RCTLayoutPropMargin, META_PROP_LEFT},
+  {@"marginBottom", RCTLayoutPropMargin, META_PROP_BOTTOM},
+  {@"marginRight", RCTLayoutPropMargin, META_PROP_RIGHT},
+  {@"padding", RCTLayoutPropPadding, META_PROP_ALL},
+  {@"paddingVertical", RCTLayoutPropPadding, META_PROP_VERTICAL},
+  {@"paddingHorizontal", RCTLayoutPropPadding, META_PROP_HORIZONTAL},
+  {@"paddingTop", RCTLayoutPropPadding, META_PROP_TOP},
+  {@"paddingLeft", RCTLayoutPropPadding, META_PROP_LEFT},
+  {@"paddingBottom", RCTLayoutPropPadding, META_PROP_BOTTOM},
+  {@"paddingRight", RCTLayoutPropPadding, META_PROP_RIGHT},
+  {@"borderWidth", RCTLayoutPropBorder, META_PROP_ALL},
+  {@"borderTopWidth", RCTLayoutPropBorder, META_PROP_TOP},
+  {@"borderLeftWidth", RCTLayoutPropBorder, META_PROP_LEFT},
+  {@"borderBottomWidth", RCTLayoutPropBorder, META_PROP_BOTTOM},
+  {@"borderRightWidth", RCTLayoutPropBorder, META_PROP_RIGHT},
+  {@"width", RCTLayoutPropDimension, CSS_WIDTH},
+  {@"height", RCTLayoutPropDimension, CSS_HEIGHT},
+  {@"top", RCTLayoutPropPosition, CSS_TOP},
+  {@"right", RCTLayoutPropPosition, CSS_RIGHT},
+  {@"bottom", RCTLayoutPropPosition, CSS_BOTTOM},
+  {@"left", RCTLayoutPropPosition, CSS_LEFT},
+  {@"flex", RCTLayoutPropFlex, 0},
+  {@"flexDirection", RCTLayoutPropFlexDirection, 0},
+  {@"flexWrap", RCTLayoutPropFlexWrap, 0},
+  {@"justifyContent", RCTLayoutPropJustifyContent, 0},
+  {@"alignItems", RCTLayoutPropAlignItems, 0},
+  {@"alignSelf", RCTLayoutPropAlignSelf, 0},
+  {@"position", RCTLayoutPropPositionType, 0},
+};
+
+static NSDictionary *RCTLayoutPropIndexes(void)
+{
+  static NSDictionary *indexes;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSMutableDictionary *mutableIndexes = [NSMutableDictionary new];
+    for (NSUInteger i = 0; i < sizeof(RCTLayoutProps) / sizeof(RCTLayoutProps[0]); i++) {
+      mutableIndexes[RCTLayoutProps[i].name] = @(i);
+    }
+    indexes = [mutableIndexes copy];
+  });
+  return indexes;
+}
+
+static inline CGFloat RCTLayoutPropFloat(id json)
+{
+  return [json isKindOfClass:[NSNumber class]] ? [json doubleValue] : [RCTConvert CGFloat:json];
+}
+
++ (BOOL)canSetLayoutPropDirectly:(NSString *)name
+{
+  NSNumber *index = RCTLayoutPropIndexes()[name];
+  if (!index) {
+    return NO;
+  }
+  // A subclass that overrides the setter expects to see every value
+  NSString *setterName = [NSString stringWithFormat:@"set%@%@:",
+                          [name substringToIndex:1].uppercaseString,
+                          [name substringFromIndex:1]];
+  SEL setter = NSSelectorFromString(setterName);
+  return [self instanceMethodForSelector:setter] == [RCTShadowView instanceMethodForSelector:setter];
+}
+
+- (void)setLayoutProps:(NSDictionary *)props
+{
+  NSDictionary *indexes = RCTLayoutPropIndexes();
+  __block BOOL dirty = NO;
+  css_style_t *style = &_cssNode->style;
+  [props enumerateKeysAndObjectsUsingBlock:^(NSString *name, id json, __unused BOOL *stop) {
+    const RCTLayoutProp *prop = &RCTLayoutProps[[indexes[name] unsignedIntegerValue]];
+    switch (prop->kind) {
+      case RCTLayoutPropMargin:
+        _marginMetaProps[prop->index] = RCTLayoutPropFloat(json);
+        _recomputeMargin = YES;
+        return;
+      case RCTLayoutPropPadding:
+        _paddingMetaProps[prop->index] = RCTLayoutPropFloat(json);
+        _recomputePadding = YES;
+        return;
+      case RCTLayoutPropBorder:
+        _borderMetaProps[prop->index] = RCTLayoutPropFloat(json);
+        _recomputeBorder = YES;
+        return;
+      case RCTLayoutPropDimension:
+        css_style_set(style, CSS_STYLE_DIMENSIONS + (int)prop->index, RCTLayoutPropFloat(json));
+        break;
+      case RCTLayoutPropPosition:
+        css_style_set(style, CSS_STYLE_POSITION + (int)prop->index, RCTLayoutPropFloat(json));
+        break;
+      case RCTLayoutPropFlex:
+        style->flex = RCTLayoutPropFloat(json);
+        break;
+      case RCTLayoutPropFlexDirection:
+        style->flex_direction = [RCTConvert css_flex_direction_t:json];
+        break;
+      case RCTLayoutPropFlexWrap:
+        style->flex_wrap = [RCTConvert css_wrap_type_t:json];
+        break;
+      case RCTLayoutPropJustifyContent:
+        style->justify_content = [RCTConvert css_justify_t:json];
+        break;
+      case RCTLayoutPropAlignItems:
+        style->align_items = [RCTConvert css_align_t:json];
+        break;
+      case RCTLayoutPropAlignSelf:
+        style->align_self = [RCTConvert css_align_t:json];
+        break;
+      case RCTLayoutPropPositionType:
+        style->position_type = [RCTConvert css_position_type_t:json];
+        break;
+    }
+    dirty = YES;
+  }];
+  if (dirty) {
+    [self dirtyLayout];
+  }
+}
+
 - (void)setBackgroundColor:(UIColor *)color
 {
   _backgroundColor = color;
+
+  // If the color is removed again, the view needs the inherited one back
+  _lastInheritedBackgroundColor = nil;
   [self dirtyPropagation];
 }
 
 - (void)updateLayout
 {
   if (_recomputePadding) {
-    RCTProcessMetaProps(_paddingMetaProps, _cssNode->style.padding);
+    RCTProcessMetaProps(_paddingMetaProps, &_cssNode->style, CSS_STYLE_PADDING);
   }
   if (_recomputeMargin) {
-    RCTProcessMetaProps(_marginMetaProps, _cssNode->style.margin);
+    RCTProcessMetaProps(_marginMetaProps, &_cssNode->style, CSS_STYLE_MARGIN);
   }
   if (_recomputeBorder) {
-    RCTProcessMetaProps(_borderMetaProps, _cssNode->style.border);
+    RCTProcessMetaProps(_borderMetaProps, &_cssNode->style, CSS_STYLE_BORDER);
   }
   if (_recomputePadding || _recomputeMargin || _recomputeBorder) {
     [self dirtyLayout];
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <UIKit/UIKit.h>
+
+/**
+ * A uniform grid over the rects of a set of objects, such as the frames of a
+ * view's subviews, so that finding the ones under a point doesn't visit all of
+ * them. Objects that are added with CGRectInfinite, or with a rect that covers
+ * too many cells, are returned for every point. Objects aren't retained, and
+ * the index isn't thread-safe.
+ */
+@interface RCTSpatialIndex : NSObject
+
+- (instancetype)initWithCellSize:(CGFloat)cellSize NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * Adds the object, or moves it if it was already added. Objects with a higher
+ * order are returned first.
+ */
+- (void)addObject:(id)object rect:(CGRect)rect order:(NSInteger)order;
+
+/**
+ * Moves an object that was added before, keeping its order. Does nothing for
+ * objects that weren't added.
+ */
+- (void)updateRect:(CGRect)rect forObject:(id)object;
+
+- (void)removeObject:(id)object;
+- (void)removeAllObjects;
+
+/**
+ * The objects whose rect contains the point, highest order first.
+ */
+- (NSArray *)objectsAtPoint:(CGPoint)point;
+
+@end
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "RCTSpatialIndex.h"
+
+#import "RCTDefines.h"
+
+/**
+ * Rects spanning more cells than this are kept out of the grid, and checked
+ * for every point instead.
+ */
+static const NSInteger RCTSpatialIndexMaxCellsPerObject = 64;
+
+@interface RCTSpatialIndexEntry : NSObject
+{
+@public
+  __weak id _object;
+  CGRect _rect;
+  NSInteger _order;
+  BOOL _unbounded;
+  NSInteger _minX, _minY, _maxX, _maxY;
+}
+
+@end
+
+@implementation RCTSpatialIndexEntry
+
+@end
+
+@implementation RCTSpatialIndex
+{
+  CGFloat _cellSize;
+  NSMapTable *_entries;
+  NSMutableDictionary *_cells;
+  NSMutableSet *_unboundedEntries;
+}
+
+- (instancetype)initWithCellSize:(CGFloat)cellSize
+{
+  if ((self = [super init])) {
+    _cellSize = MAX(cellSize, 1);
+    _entries = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                     valueOptions:NSPointerFunctionsStrongMemory];
+    _cells = [NSMutableDictionary new];
+    _unboundedEntries = [NSMutableSet new];
+  }
+  return self;
+}
+
+RCT_NOT_IMPLEMENTED(- (instancetype)init)
+
+- (NSUInteger)count
+{
+  return _entries.count;
+}
+
+static NSNumber *RCTSpatialIndexCellKey(NSInteger x, NSInteger y)
+{
+  return @(((int64_t)x << 32) | (uint32_t)y);
+}
+
+- (NSInteger)cellForCoordinate:(CGFloat)coordinate
+{
+  return (NSInteger)floor(coordinate / _cellSize);
+}
+
+- (void)insertEntry:(RCTSpatialIndexEntry *)entry
+{
+  CGRect rect = entry->_rect;
+  BOOL unbounded = CGRectIsInfinite(rect) || CGRectIsNull(rect) ||
+    isnan(rect.origin.x) || isnan(rect.origin.y) || isnan(rect.size.width) || isnan(rect.size.height);
+  if (!unbounded) {
+    entry->_minX = [self cellForCoordinate:CGRectGetMinX(rect)];
+    entry->_minY = [self cellForCoordinate:CGRectGetMinY(rect)];
+    entry->_maxX = [self cellForCoordinate:CGRectGetMaxX(rect)];
+    entry->_maxY = [self cellForCoordinate:CGRectGetMaxY(rect)];
+    CGFloat cellCount = ((CGFloat)entry->_maxX - entry->_minX + 1) * ((CGFloat)entry->_maxY - entry->_minY + 1);
+    unbounded = cellCount > RCTSpatialIndexMaxCellsPerObject;
+  }
+  entry->_unbounded = unbounded;
+  if (unbounded) {
+    [_unboundedEntries addObject:entry];
+    return;
+  }
+  for (NSInteger x = entry->_minX; x <= entry->_maxX; x++) {
+    for (NSInteger y = entry->_minY; y <= entry->_maxY; y++) {
+      NSNumber *key = RCTSpatialIndexCellKey(x, y);
+      NSMutableArray *cell = _cells[key];
+      if (!cell) {
+        cell = [NSMutableArray new];
+        _cells[key] = cell;
+      }
+      [cell addObject:entry];
+    }
+  }
+}
+
+- (void)removeEntry:(RCTSpatialIndexEntry *)entry
+{
+  if (entry->_unbounded) {
+    [_unboundedEntries removeObject:entry];
+    return;
+  }
+  for (NSInteger x = entry->_minX; x <= entry->_maxX; x++) {
+    for (NSInteger y = entry->_minY; y <= entry->_maxY; y++) {
+      NSNumber *key = RCTSpatialIndexCellKey(x, y);
+      NSMutableArray *cell = _cells[key];
+      [cell removeObjectIdenticalTo:entry];
+      if (cell && !cell.count) {
+        [_cells removeObjectForKey:key];
+      }
+    }
+  }
+}
+
+- (void)addObject:(id)object rect:(CGRect)rect order:(NSInteger)order
+{
+  RCTSpatialIndexEntry *entry = [_entries objectForKey:object];
+  if (entry) {
+    [self removeEntry:entry];
+  } else {
+    entry = [RCTSpatialIndexEntry new];
+    entry->_object = object;
+    [_entries setObject:entry forKey:object];
+  }
+  entry->_rect = rect;
+  entry->_order = order;
+  [self insertEntry:entry];
+}
+
+- (void)updateRect:(CGRect)rect forObject:(id)object
+{
+  RCTSpatialIndexEntry *entry = [_entries objectForKey:object];
+  if (!entry || CGRectEqualToRect(entry->_rect, rect)) {
+    return;
+  }
+  [self removeEntry:entry];
+  entry->_rect = rect;
+  [self insertEntry:entry];
+}
+
+- (void)removeObject:(id)object
+{
+  RCTSpatialIndexEntry *entry = [_entries objectForKey:object];
+  if (entry) {
+    [self removeEntry:entry];
+    [_entries removeObjectForKey:object];
+  }
+}
+
+- (void)removeAllObjects
+{
+  [_entries removeAllObjects];
+  [_cells removeAllObjects];
+  [_unboundedEntries removeAllObjects];
+}
+
+- (NSArray *)objectsAtPoint:(CGPoint)point
+{
+  NSArray *cell = _cells[RCTSpatialIndexCellKey([self cellForCoordinate:point.x], [self cellForCoordinate:point.y])];
+  NSMutableArray *entries = [NSMutableArray arrayWithCapacity:cell.count + _unboundedEntries.count];
+  for (RCTSpatialIndexEntry *entry in cell) {
+    if (CGRectContainsPoint(entry->_rect, point)) {
+      [entries addObject:entry];
+    }
+  }
+  for (RCTSpatialIndexEntry *entry in _unboundedEntries) {
+    if (CGRectIsInfinite(entry->_rect) || CGRectContainsPoint(entry->_rect, point)) {
+      [entries addObject:entry];
+    }
+  }
+  [entries sortUsingComparator:^NSComparisonResult(RCTSpatialIndexEntry *lhs, RCTSpatialIndexEntry *rhs) {
+    return lhs->_order > rhs->_order ? NSOrderedAscending : (lhs->_order < rhs->_order ? NSOrderedDescending : NSOrderedSame);
+  }];
+
+  NSMutableArray *objects = [NSMutableArray arrayWithCapacity:entries.count];
+  for (RCTSpatialIndexEntry *entry in entries) {
+    id object = entry->_object;
+    if (object) {
+      [objects addObject:object];
+    }
+  }
+  return objects;
+}
+
+@end
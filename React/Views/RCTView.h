@@ -84,4 +84,12 @@
 @property (nonatomic, assign) CGFloat borderLeftWidth;
 @property (nonatomic, assign) CGFloat borderWidth;
 
+/**
+ * Draw the border and background image on a background queue, instead of in
+ * -displayLayer:. The previous contents stay on screen until the new ones are
+ * ready, so this suits views that change while scrolling, not during
+ * animations. Borders that iOS can draw itself aren't affected.
+ */
+@property (nonatomic, assign) BOOL asyncDisplay;
+
 @end
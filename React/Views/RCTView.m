@@ -9,16 +9,36 @@
 
 #import "RCTView.h"
 
+#import "RCTAsyncDisplay.h"
 #import "RCTAutoInsetsProtocol.h"
 #import "RCTBorderDrawing.h"
 #import "RCTConvert.h"
 #import "RCTLog.h"
+#import "RCTSpatialIndex.h"
 #import "RCTUtils.h"
 #import "UIView+React.h"
 
-static UIView *RCTViewHitTest(UIView *view, CGPoint point, UIEvent *event)
+/**
+ * Views with at least this many subviews index them for hit testing.
+ */
+static const NSUInteger RCTViewHitTestIndexMinSubviewCount = 64;
+static const CGFloat RCTViewHitTestIndexCellSize = 64;
+
+@interface RCTView ()
+
+/**
+ * The subviews whose hit area contains the point, topmost first, or nil if the
+ * view has too few subviews to index them.
+ */
+- (NSArray *)hitTestCandidatesAtPoint:(CGPoint)point;
+
+@end
+
+static UIView *RCTViewHitTest(RCTView *view, CGPoint point, UIEvent *event)
 {
-  for (UIView *subview in [view.subviews reverseObjectEnumerator]) {
+  NSArray *candidates = [view hitTestCandidatesAtPoint:point];
+  id<NSFastEnumeration> subviews = candidates ?: [view.subviews reverseObjectEnumerator];
+  for (UIView *subview in subviews) {
     if (!subview.isHidden && subview.isUserInteractionEnabled && subview.alpha > 0) {
       CGPoint convertedPoint = [subview convertPoint:point fromView:view];
       UIView *subviewHitTestView = [subview hitTest:convertedPoint withEvent:event];
@@ -104,10 +124,44 @@ static NSString *RCTRecursiveAccessibilityLabel(UIView *view)
   return str;
 }
 
+/**
+ * Where a subview can be hit. Subviews whose children may overflow them, and
+ * transformed ones, are checked for every point.
+ */
+static CGRect RCTViewHitAreaOfSubview(UIView *subview)
+{
+  if (!CATransform3DIsIdentity(subview.layer.transform) ||
+      (!subview.clipsToBounds && subview.subviews.count)) {
+    return CGRectInfinite;
+  }
+  return subview.frame;
+}
+
 @implementation RCTView
 {
   NSMutableArray *_reactSubviews;
   UIColor *_backgroundColor;
+
+  // Built the first time a dense view is hit tested, kept up to date as its
+  // subviews are laid out, and rebuilt when the subviews change
+  RCTSpatialIndex *_hitTestIndex;
+
+  // While removeClippedSubviews is on, the subviews that clip are sorted by
+  // where they start along the axis they spread over, with the furthest any
+  // of them up to each index ends in _clipMaxEdges. A clip rect then only has
+  // to check the window of them it overlaps, and the window it overlapped
+  // last time. Subviews that don't clip are checked every time. Rebuilt
+  // when the subviews or their frames change.
+  NSArray *_clipSortedSubviews;
+  NSArray *_clipUnsortedSubviews;
+  NSMutableData *_clipMaxEdges;
+  BOOL _clipSortsVertically;
+  NSRange _clipWindow;
+  NSUInteger _clipGeometryGeneration;
+
+  // Sorted subviews that were entirely within the last clip rect, with all
+  // of their own subviews mounted
+  NSHashTable *_fullyMountedSubviews;
 }
 
 - (instancetype)initWithFrame:(CGRect)frame
@@ -148,6 +202,59 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   }
 }
 
+- (NSArray *)hitTestCandidatesAtPoint:(CGPoint)point
+{
+  if (!_hitTestIndex) {
+    NSArray *subviews = self.subviews;
+    if (subviews.count < RCTViewHitTestIndexMinSubviewCount) {
+      return nil;
+    }
+    _hitTestIndex = [[RCTSpatialIndex alloc] initWithCellSize:RCTViewHitTestIndexCellSize];
+    [subviews enumerateObjectsUsingBlock:^(UIView *subview, NSUInteger idx, __unused BOOL *stop) {
+      [_hitTestIndex addObject:subview rect:RCTViewHitAreaOfSubview(subview) order:idx];
+    }];
+  }
+  return [_hitTestIndex objectsAtPoint:point];
+}
+
+- (void)didAddSubview:(UIView *)subview
+{
+  [super didAddSubview:subview];
+
+  // The subviews' order is only known by their index, so start over
+  _hitTestIndex = nil;
+
+  // Clipping only needs a mask once there are subviews to clip
+  if (self.clipsToBounds && self.subviews.count == 1) {
+    [self.layer setNeedsDisplay];
+  }
+}
+
+- (void)willRemoveSubview:(UIView *)subview
+{
+  [super willRemoveSubview:subview];
+  [_hitTestIndex removeObject:subview];
+
+  if (self.clipsToBounds && self.subviews.count == 1) {
+    [self.layer setNeedsDisplay];
+  }
+}
+
+- (void)reactSubviewHitAreaDidChange:(UIView *)subview
+{
+  [_hitTestIndex updateRect:RCTViewHitAreaOfSubview(subview) forObject:subview];
+  _clipSortedSubviews = nil;
+}
+
+- (void)setClipsToBounds:(BOOL)clipsToBounds
+{
+  if (self.clipsToBounds != clipsToBounds) {
+    super.clipsToBounds = clipsToBounds;
+    [self.layer setNeedsDisplay];
+  }
+  [self reactHitAreaDidChange];
+}
+
 - (UIView *)hitTest:(CGPoint)point withEvent:(UIEvent *)event
 {
   switch (_pointerEvents) {
@@ -324,10 +431,6 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
 
 - (void)react_updateClippedSubviewsWithClipRect:(CGRect)clipRect relativeToView:(UIView *)clipView
 {
-  // TODO (#5906496): for scrollviews (the primary use-case) we could
-  // optimize this by only doing a range check along the scroll axis,
-  // instead of comparing the whole frame
-
   if (_reactSubviews == nil) {
     // Use default behavior if unmounting is disabled
     return [super react_updateClippedSubviewsWithClipRect:clipRect relativeToView:clipView];
@@ -350,12 +453,135 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
     clipRect = CGRectIntersection(clipRect, self.bounds);
   }
 
-  // Mount / unmount views
-  for (UIView *view in _reactSubviews) {
+  if (!_clipSortedSubviews || _clipGeometryGeneration != RCTUnmountedViewGeometryGeneration()) {
+    [self buildClipIndex];
+  }
+
+  // Mount / unmount views. Only those in the last window or the new one can
+  // have changed, the others stay unmounted.
+  NSRange window = [self clipWindowForRect:clipRect];
+  for (NSUInteger i = _clipWindow.location; i < NSMaxRange(_clipWindow); i++) {
+    [self mountOrUnmountSortedSubview:_clipSortedSubviews[i] withClipRect:clipRect relativeToView:clipView];
+  }
+  for (NSUInteger i = window.location; i < NSMaxRange(window); i++) {
+    if (!NSLocationInRange(i, _clipWindow)) {
+      [self mountOrUnmountSortedSubview:_clipSortedSubviews[i] withClipRect:clipRect relativeToView:clipView];
+    }
+  }
+  _clipWindow = window;
+
+  for (UIView *view in _clipUnsortedSubviews) {
     [self mountOrUnmountSubview:view withClipRect:clipRect relativeToView:clipView];
   }
 }
 
+static CGFloat RCTClipMinEdge(CGRect frame, BOOL vertical)
+{
+  return vertical ? CGRectGetMinY(frame) : CGRectGetMinX(frame);
+}
+
+static CGFloat RCTClipMaxEdge(CGRect frame, BOOL vertical)
+{
+  return vertical ? CGRectGetMaxY(frame) : CGRectGetMaxX(frame);
+}
+
+- (void)buildClipIndex
+{
+  NSMutableArray *sortedSubviews = [NSMutableArray arrayWithCapacity:_reactSubviews.count];
+  NSMutableArray *unsortedSubviews = [NSMutableArray new];
+  CGRect extent = CGRectNull;
+  for (UIView *view in _reactSubviews) {
+    if (view.clipsToBounds) {
+      [sortedSubviews addObject:view];
+      extent = CGRectUnion(extent, view.frame);
+    } else {
+      [unsortedSubviews addObject:view];
+    }
+  }
+
+  BOOL vertical = CGRectGetHeight(extent) >= CGRectGetWidth(extent);
+  [sortedSubviews sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(UIView *a, UIView *b) {
+    CGFloat aMin = RCTClipMinEdge(a.frame, vertical);
+    CGFloat bMin = RCTClipMinEdge(b.frame, vertical);
+    return aMin < bMin ? NSOrderedAscending : aMin > bMin ? NSOrderedDescending : NSOrderedSame;
+  }];
+
+  NSMutableData *maxEdges = [NSMutableData dataWithLength:sortedSubviews.count * sizeof(CGFloat)];
+  CGFloat *edges = maxEdges.mutableBytes;
+  CGFloat maxEdge = -CGFLOAT_MAX;
+  for (NSUInteger i = 0; i < sortedSubviews.count; i++) {
+    maxEdge = MAX(maxEdge, RCTClipMaxEdge([sortedSubviews[i] frame], vertical));
+    edges[i] = maxEdge;
+  }
+
+  _clipSortedSubviews = sortedSubviews;
+  _clipUnsortedSubviews = unsortedSubviews;
+  _clipMaxEdges = maxEdges;
+  _clipSortsVertically = vertical;
+  _clipGeometryGeneration = RCTUnmountedViewGeometryGeneration();
+
+  // Nothing is known about the subviews yet, so check all of them once
+  _clipWindow = NSMakeRange(0, sortedSubviews.count);
+  if (!_fullyMountedSubviews) {
+    _fullyMountedSubviews = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality];
+  }
+  [_fullyMountedSubviews removeAllObjects];
+}
+
+/**
+ * The range of sorted subviews that may overlap the rect: those from the
+ * first one to end after its start, to the last one to start before its end.
+ */
+- (NSRange)clipWindowForRect:(CGRect)clipRect
+{
+  const NSUInteger count = _clipSortedSubviews.count;
+  if (CGRectIsNull(clipRect) || count == 0) {
+    return NSMakeRange(0, 0);
+  }
+
+  const CGFloat clipMin = RCTClipMinEdge(clipRect, _clipSortsVertically);
+  const CGFloat clipMax = RCTClipMaxEdge(clipRect, _clipSortsVertically);
+  const CGFloat *maxEdges = _clipMaxEdges.bytes;
+
+  NSUInteger low = 0, high = count;
+  while (low < high) {
+    NSUInteger mid = (low + high) / 2;
+    if (maxEdges[mid] > clipMin) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  const NSUInteger start = low;
+
+  high = count;
+  while (low < high) {
+    NSUInteger mid = (low + high) / 2;
+    if (RCTClipMinEdge([_clipSortedSubviews[mid] frame], _clipSortsVertically) < clipMax) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return NSMakeRange(start, low - start);
+}
+
+- (void)mountOrUnmountSortedSubview:(UIView *)view withClipRect:(CGRect)clipRect relativeToView:(UIView *)clipView
+{
+  // A subview that stays entirely visible has nothing left to mount
+  const BOOL fullyVisible = CGRectContainsRect(clipRect, view.frame);
+  if (fullyVisible && view.superview && [_fullyMountedSubviews containsObject:view]) {
+    return;
+  }
+
+  [self mountOrUnmountSubview:view withClipRect:clipRect relativeToView:clipView];
+  if (fullyVisible) {
+    [_fullyMountedSubviews addObject:view];
+  } else {
+    [_fullyMountedSubviews removeObject:view];
+  }
+}
+
 - (void)setRemoveClippedSubviews:(BOOL)removeClippedSubviews
 {
   if (removeClippedSubviews && !_reactSubviews) {
@@ -364,6 +590,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
     [self react_remountAllSubviews];
     _reactSubviews = nil;
   }
+  _clipSortedSubviews = nil;
 }
 
 - (BOOL)removeClippedSubviews
@@ -377,6 +604,7 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
     [self insertSubview:view atIndex:atIndex];
   } else {
     [_reactSubviews insertObject:view atIndex:atIndex];
+    _clipSortedSubviews = nil;
 
     // Find a suitable view to use for clipping
     UIView *clipView = [self react_findClipView];
@@ -391,12 +619,15 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
       [self remountSubview:view];
     }
   }
+  [self.superview reactSubviewHitAreaDidChange:self];
 }
 
 - (void)removeReactSubview:(UIView *)subview
 {
   [_reactSubviews removeObject:subview];
+  _clipSortedSubviews = nil;
   [subview removeFromSuperview];
+  [self.superview reactSubviewHitAreaDidChange:self];
 }
 
 - (NSArray *)reactSubviews
@@ -429,6 +660,9 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   if (_reactSubviews) {
     [self updateClippedSubviews];
   }
+
+  // The bounds may have changed
+  [self updateShadowPathForLayer:self.layer];
 }
 
 #pragma mark - Borders
@@ -484,8 +718,21 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   };
 }
 
+- (void)setAsyncDisplay:(BOOL)asyncDisplay
+{
+  if (_asyncDisplay == asyncDisplay) {
+    return;
+  }
+
+  _asyncDisplay = asyncDisplay;
+  [self.layer setNeedsDisplay];
+}
+
 - (void)displayLayer:(CALayer *)layer
 {
+  RCTCancelAsyncDisplay(layer);
+  [self updateShadowPathForLayer:layer];
+
   const RCTCornerRadii cornerRadii = [self cornerRadii];
   const UIEdgeInsets borderInsets = [self bordersAsInsets];
   const RCTBorderColors borderColors = [self borderColors];
@@ -500,7 +747,12 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   // the content. For this reason, only use iOS border drawing when clipping
   // or when the border is hidden.
 
-  (borderInsets.top == 0 || CGColorGetAlpha(borderColors.top) == 0 || self.clipsToBounds);
+  (borderInsets.top == 0 || CGColorGetAlpha(borderColors.top) == 0 || self.clipsToBounds) &&
+
+  // Rounded corners clipped by the layer are rendered offscreen. Without
+  // subviews to clip, the rounded border image gives the same result.
+
+  !(self.clipsToBounds && cornerRadii.topLeft > 0 && ![self clipsSubviews]);
 
   // iOS clips to the outside of the border, but CSS clips to the inside. To
   // solve this, we'll need to add a container view inside the main view to
@@ -517,12 +769,42 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
     return;
   }
 
-  UIImage *image = RCTGetBorderImage([self cornerRadii],
-                                     [self bordersAsInsets],
-                                     [self borderColors],
+  const BOOL drawToEdge = self.clipsToBounds;
+
+  if (_asyncDisplay && !RCTRunningInTestEnvironment()) {
+
+    // The view may release its colors before the image is drawn
+    CGColorRef backgroundColor = CGColorRetain(_backgroundColor.CGColor);
+    CGColorRetain(borderColors.top);
+    CGColorRetain(borderColors.left);
+    CGColorRetain(borderColors.bottom);
+    CGColorRetain(borderColors.right);
+
+    __weak RCTView *weakSelf = self;
+    RCTDisplayLayerAsynchronously(layer, ^UIImage *{
+      UIImage *image = RCTGetBorderImage(cornerRadii, borderInsets, borderColors, backgroundColor, drawToEdge);
+      CGColorRelease(backgroundColor);
+      CGColorRelease(borderColors.top);
+      CGColorRelease(borderColors.left);
+      CGColorRelease(borderColors.bottom);
+      CGColorRelease(borderColors.right);
+      return image;
+    }, ^(UIImage *image) {
+      [weakSelf setBorderImage:image forLayer:layer];
+    });
+    return;
+  }
+
+  UIImage *image = RCTGetBorderImage(cornerRadii,
+                                     borderInsets,
+                                     borderColors,
                                      _backgroundColor.CGColor,
-                                     self.clipsToBounds);
+                                     drawToEdge);
+  [self setBorderImage:image forLayer:layer];
+}
 
+- (void)setBorderImage:(UIImage *)image forLayer:(CALayer *)layer
+{
   CGRect contentsCenter = ({
     CGSize size = image.size;
     UIEdgeInsets insets = image.capInsets;
@@ -553,12 +835,19 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   [self updateClippingForLayer:layer];
 }
 
+- (BOOL)clipsSubviews
+{
+  return self.clipsToBounds && self.subviews.count > 0;
+}
+
 - (void)updateClippingForLayer:(CALayer *)layer
 {
   CALayer *mask = nil;
   CGFloat cornerRadius = 0;
 
-  if (self.clipsToBounds) {
+  // The border image is already rounded, the view's own content never needs
+  // a mask, which would render the layer offscreen
+  if ([self clipsSubviews]) {
 
     const RCTCornerRadii cornerRadii = [self cornerRadii];
     if (RCTCornerRadiiAreEqual(cornerRadii)) {
@@ -579,6 +868,25 @@ RCT_NOT_IMPLEMENTED(- (instancetype)initWithCoder:unused)
   layer.mask = mask;
 }
 
+/**
+ * Without a shadowPath, Core Animation renders the layer offscreen on every
+ * frame to find the shape of its shadow from its alpha. A view with an opaque
+ * background casts the shadow of its rounded rect, so that is set as the
+ * path, leaving out only subviews that are drawn outside of the view.
+ */
+- (void)updateShadowPathForLayer:(CALayer *)layer
+{
+  CGPathRef shadowPath = NULL;
+  if (layer.shadowOpacity > 0 && layer.shadowColor && _backgroundColor &&
+      CGColorGetAlpha(_backgroundColor.CGColor) == 1) {
+    shadowPath = RCTPathCreateWithRoundedRect(self.bounds, RCTGetCornerInsets([self cornerRadii], UIEdgeInsetsZero), NULL);
+  }
+  if (!(shadowPath && layer.shadowPath && CGPathEqualToPath(shadowPath, layer.shadowPath))) {
+    layer.shadowPath = shadowPath;
+  }
+  CGPathRelease(shadowPath);
+}
+
 #pragma mark Border Color
 
 #define setBorderColor(side)                                \
@@ -58,6 +58,17 @@ typedef void (^RCTViewManagerUIBlock)(RCTUIManager *uiManager, RCTSparseArray *v
  */
 - (RCTShadowView *)shadowView;
 
+/**
+ * The number of removed views of this type that are kept around to be reused
+ * by later -createView calls, instead of instantiating new ones. Defaults to 0,
+ * which disables recycling. A recycled view has every prop that was set on it
+ * reset from the default view, and its react subviews removed, but it's
+ * otherwise returned as is, so only opt in if -view or -viewWithProps: don't
+ * configure the view in ways that props can't undo. Views that conform to
+ * RCTInvalidating are never recycled.
+ */
+- (NSUInteger)recycledViewPoolSize;
+
 /**
  * DEPRECATED: declare properties of type RCTBubblingEventBlock instead
  *
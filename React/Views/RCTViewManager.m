@@ -69,6 +69,11 @@ RCT_EXPORT_MODULE()
   return [RCTShadowView new];
 }
 
+- (NSUInteger)recycledViewPoolSize
+{
+  return 0;
+}
+
 - (NSArray *)customBubblingEventTypes
 {
   return @[
@@ -118,9 +123,18 @@ RCT_REMAP_VIEW_PROPERTY(accessible, isAccessibilityElement, BOOL)
 RCT_REMAP_VIEW_PROPERTY(testID, accessibilityIdentifier, NSString)
 RCT_REMAP_VIEW_PROPERTY(backfaceVisibility, layer.doubleSided, css_backface_visibility_t)
 RCT_REMAP_VIEW_PROPERTY(opacity, alpha, CGFloat)
-RCT_REMAP_VIEW_PROPERTY(shadowColor, layer.shadowColor, CGColor);
+RCT_CUSTOM_VIEW_PROPERTY(shadowColor, CGColor, RCTView)
+{
+  view.layer.shadowColor = json ? [RCTConvert CGColor:json] : defaultView.layer.shadowColor;
+  // RCTView updates its shadowPath when it next lays out
+  [view setNeedsLayout];
+}
 RCT_REMAP_VIEW_PROPERTY(shadowOffset, layer.shadowOffset, CGSize);
-RCT_REMAP_VIEW_PROPERTY(shadowOpacity, layer.shadowOpacity, float)
+RCT_CUSTOM_VIEW_PROPERTY(shadowOpacity, float, RCTView)
+{
+  view.layer.shadowOpacity = json ? [RCTConvert float:json] : defaultView.layer.shadowOpacity;
+  [view setNeedsLayout];
+}
 RCT_REMAP_VIEW_PROPERTY(shadowRadius, layer.shadowRadius, CGFloat)
 RCT_REMAP_VIEW_PROPERTY(overflow, clipsToBounds, css_clip_t)
 RCT_CUSTOM_VIEW_PROPERTY(shouldRasterizeIOS, BOOL, RCTView)
@@ -128,11 +142,18 @@ RCT_CUSTOM_VIEW_PROPERTY(shouldRasterizeIOS, BOOL, RCTView)
   view.layer.shouldRasterize = json ? [RCTConvert BOOL:json] : defaultView.layer.shouldRasterize;
   view.layer.rasterizationScale = view.layer.shouldRasterize ? [UIScreen mainScreen].scale : defaultView.layer.rasterizationScale;
 }
+RCT_CUSTOM_VIEW_PROPERTY(asyncDisplayIOS, BOOL, RCTView)
+{
+  if ([view respondsToSelector:@selector(setAsyncDisplay:)]) {
+    view.asyncDisplay = json ? [RCTConvert BOOL:json] : defaultView.asyncDisplay;
+  }
+}
 RCT_CUSTOM_VIEW_PROPERTY(transformMatrix, CATransform3D, RCTView)
 {
   view.layer.transform = json ? [RCTConvert CATransform3D:json] : defaultView.layer.transform;
   // TODO: Improve this by enabling edge antialiasing only for transforms with rotation or skewing
   view.layer.allowsEdgeAntialiasing = !CATransform3DIsIdentity(view.layer.transform);
+  [view reactHitAreaDidChange];
 }
 RCT_CUSTOM_VIEW_PROPERTY(pointerEvents, RCTPointerEvents, RCTView)
 {
@@ -26,6 +26,13 @@ didMoveToNavigationController:(UINavigationController *)navigationController;
 - (instancetype)initWithContentView:(UIView *)contentView NS_DESIGNATED_INITIALIZER;
 - (instancetype)initWithNavItem:(RCTNavItem *)navItem;
 
+/**
+ * Loads the view, then lays out and draws the content at the given frame.
+ * Call this before presenting the controller so that none of this work
+ * happens during the first frames of the transition.
+ */
+- (void)prepareForPresentationWithFrame:(CGRect)frame;
+
 @property (nonatomic, weak) id<RCTWrapperViewControllerNavigationListener> navigationListener;
 @property (nonatomic, strong) RCTNavItem *navItem;
 
@@ -139,6 +139,21 @@ static UIView *RCTFindNavBarShadowViewInView(UIView *view)
   self.view = _wrapperView;
 }
 
+static void RCTDisplayLayerTree(CALayer *layer)
+{
+  [layer displayIfNeeded];
+  for (CALayer *sublayer in layer.sublayers) {
+    RCTDisplayLayerTree(sublayer);
+  }
+}
+
+- (void)prepareForPresentationWithFrame:(CGRect)frame
+{
+  self.view.frame = frame;
+  [self.view layoutIfNeeded];
+  RCTDisplayLayerTree(self.view.layer);
+}
+
 - (void)didMoveToParentViewController:(UIViewController *)parent
 {
   // There's no clear setter for navigation controllers, but did move to parent
@@ -10,6 +10,14 @@
 #import <UIKit/UIKit.h>
 
 #import "RCTComponent.h"
+#import "RCTDefines.h"
+
+/**
+ * Counts the times a view outside of any view hierarchy had its frame or
+ * transform changed. Views that unmount their clipped subviews compare it to
+ * tell when the frames they sorted those subviews by may be stale.
+ */
+RCT_EXTERN NSUInteger RCTUnmountedViewGeometryGeneration(void);
 
 //TODO: let's try to eliminate this category if possible
 
@@ -21,6 +29,20 @@
  */
 - (void)reactSetFrame:(CGRect)frame;
 
+/**
+ * Called when the area where one of the view's subviews can be hit may have
+ * changed: its frame, its transform, or whether it has subviews of its own.
+ * Does nothing by default. Views that index their subviews for hit testing
+ * override it.
+ */
+- (void)reactSubviewHitAreaDidChange:(UIView *)subview;
+
+/**
+ * Tells the superview that the view's hit area may have changed, or counts
+ * the change in RCTUnmountedViewGeometryGeneration if it has no superview.
+ */
+- (void)reactHitAreaDidChange;
+
 /**
  * Used to improve performance when compositing views with translucent content.
  */
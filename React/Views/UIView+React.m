@@ -14,6 +14,13 @@
 #import "RCTAssert.h"
 #import "RCTLog.h"
 
+static NSUInteger RCTUnmountedViewGeometryChangeCount;
+
+NSUInteger RCTUnmountedViewGeometryGeneration(void)
+{
+  return RCTUnmountedViewGeometryChangeCount;
+}
+
 @implementation UIView (React)
 
 - (NSNumber *)reactTag
@@ -43,12 +50,14 @@
 - (void)insertReactSubview:(UIView *)subview atIndex:(NSInteger)atIndex
 {
   [self insertSubview:subview atIndex:atIndex];
+  [self.superview reactSubviewHitAreaDidChange:self];
 }
 
 - (void)removeReactSubview:(UIView *)subview
 {
   RCTAssert(subview.superview == self, @"%@ is a not a subview of %@", subview, self);
   [subview removeFromSuperview];
+  [self.superview reactSubviewHitAreaDidChange:self];
 }
 
 - (NSArray *)reactSubviews
@@ -80,6 +89,22 @@
 
   self.layer.position = position;
   self.layer.bounds = bounds;
+  [self reactHitAreaDidChange];
+}
+
+- (void)reactSubviewHitAreaDidChange:(__unused UIView *)subview
+{
+  // Only views that index their subviews need to know
+}
+
+- (void)reactHitAreaDidChange
+{
+  UIView *superview = self.superview;
+  if (superview) {
+    [superview reactSubviewHitAreaDidChange:self];
+  } else {
+    RCTUnmountedViewGeometryChangeCount++;
+  }
 }
 
 - (void)reactSetInheritedBackgroundColor:(UIColor *)inheritedBackgroundColor
@@ -23,6 +23,7 @@ import com.facebook.react.modules.core.ExceptionsManagerModule;
 import com.facebook.react.modules.core.JSTimersExecution;
 import com.facebook.react.modules.core.Timing;
 import com.facebook.react.modules.debug.AnimationsDebugModule;
+import com.facebook.react.modules.debug.BridgeTrafficModule;
 import com.facebook.react.modules.debug.SourceCodeModule;
 import com.facebook.react.modules.systeminfo.AndroidInfoModule;
 import com.facebook.react.uimanager.AppRegistry;
@@ -56,6 +57,7 @@ import com.facebook.react.uimanager.events.RCTEventEmitter;
             catalystApplicationContext,
             mReactInstanceManager.getDevSupportManager().getDevSettings()),
         new AndroidInfoModule(),
+        new BridgeTrafficModule(catalystApplicationContext),
         new DeviceEventManagerModule(catalystApplicationContext, mHardwareBackBtnHandler),
         new ExceptionsManagerModule(mReactInstanceManager.getDevSupportManager()),
         new Timing(catalystApplicationContext),
@@ -16,6 +16,7 @@ import java.util.List;
 
 import android.app.Application;
 import android.content.Context;
+import android.os.AsyncTask;
 import android.os.Bundle;
 import android.view.View;
 
@@ -24,6 +25,7 @@ import com.facebook.infer.annotation.Assertions;
 import com.facebook.react.bridge.Arguments;
 import com.facebook.react.bridge.CatalystInstance;
 import com.facebook.react.bridge.JSBundleLoader;
+import com.facebook.react.bridge.JSCConfig;
 import com.facebook.react.bridge.JSCJavaScriptExecutor;
 import com.facebook.react.bridge.JavaScriptExecutor;
 import com.facebook.react.bridge.JavaScriptModule;
@@ -72,6 +74,9 @@ public class ReactInstanceManager {
   /* should only be accessed from main thread (UI thread) */
   private final List<ReactRootView> mAttachedRootViews = new ArrayList<>();
   private LifecycleState mLifecycleState;
+  private boolean mHasStartedCreatingInitialContext;
+  private @Nullable ReactContextInitAsyncTask mReactContextInitAsyncTask;
+  private @Nullable ReactContextInitParams mPendingReactContextInitParams;
 
   /* accessed from any thread */
   private final @Nullable String mBundleAssetName; /* name of JS bundle file in assets folder */
@@ -103,6 +108,71 @@ public class ReactInstanceManager {
         }
       };
 
+  /**
+   * What the next context is created with. A null executor stands for a
+   * {@link JSCJavaScriptExecutor}, which is then created off the UI thread like the rest of the
+   * context.
+   */
+  private static class ReactContextInitParams {
+    private final @Nullable JavaScriptExecutor mJSExecutor;
+    private final JSBundleLoader mJSBundleLoader;
+
+    private ReactContextInitParams(
+        @Nullable JavaScriptExecutor jsExecutor,
+        JSBundleLoader jsBundleLoader) {
+      mJSExecutor = jsExecutor;
+      mJSBundleLoader = jsBundleLoader;
+    }
+  }
+
+  /**
+   * Creates the JS context, the native modules and the catalyst instance, and runs the bundle, on
+   * a background thread. The UI thread only sets the context up once it is ready.
+   */
+  private final class ReactContextInitAsyncTask
+      extends AsyncTask<ReactContextInitParams, Void, ReactApplicationContext> {
+
+    private @Nullable RuntimeException mException;
+
+    @Override
+    protected void onPreExecute() {
+      if (mCurrentReactContext != null) {
+        tearDownReactContext(mCurrentReactContext);
+        mCurrentReactContext = null;
+      }
+    }
+
+    @Override
+    protected @Nullable ReactApplicationContext doInBackground(ReactContextInitParams... params) {
+      ReactContextInitParams initParams = Assertions.assertNotNull(params[0]);
+      try {
+        JavaScriptExecutor jsExecutor = initParams.mJSExecutor != null
+            ? initParams.mJSExecutor
+            : new JSCJavaScriptExecutor(JSCConfig.forDevice(mApplicationContext));
+        return createReactContext(jsExecutor, initParams.mJSBundleLoader);
+      } catch (RuntimeException e) {
+        mException = e;
+        return null;
+      }
+    }
+
+    @Override
+    protected void onPostExecute(@Nullable ReactApplicationContext reactContext) {
+      mReactContextInitAsyncTask = null;
+      if (mException != null) {
+        // Crashes on the UI thread, as it did when the context was created there
+        throw mException;
+      }
+      setupReactContext(Assertions.assertNotNull(reactContext));
+
+      if (mPendingReactContextInitParams != null) {
+        ReactContextInitParams pendingParams = mPendingReactContextInitParams;
+        mPendingReactContextInitParams = null;
+        recreateReactContextInBackground(pendingParams);
+      }
+    }
+  }
+
   private final DefaultHardwareBackBtnHandler mBackBtnHandler =
       new DefaultHardwareBackBtnHandler() {
     @Override
@@ -150,6 +220,22 @@ public class ReactInstanceManager {
     return new Builder();
   }
 
+  /**
+   * Starts creating the JS context and running the bundle in the background, before any
+   * {@link ReactRootView} needs it, e.g. while the app shows a splash screen of its own. Root views
+   * started later attach to the context once it's ready, instead of starting to create one then.
+   * A root view that is laid out while the context is being created, even under a splash screen,
+   * gets its component rendered as soon as that is done.
+   *
+   * Does nothing if the context has already been created or started to be.
+   */
+  public void createReactContextInBackground() {
+    UiThreadUtil.assertOnUiThread();
+    if (!mHasStartedCreatingInitialContext) {
+      initializeReactContext();
+    }
+  }
+
   private static void initializeSoLoaderIfNecessary(Context applicationContext) {
     // Call SoLoader.initialize here, this is required for apps that does not use exopackage and
     // does not use SoLoader for loading other native code except from the one used by React Native
@@ -261,11 +347,12 @@ public class ReactInstanceManager {
   /* package */ void attachMeasuredRootView(ReactRootView rootView) {
     UiThreadUtil.assertOnUiThread();
     mAttachedRootViews.add(rootView);
-    if (mCurrentReactContext == null) {
+    if (!mHasStartedCreatingInitialContext) {
       initializeReactContext();
-    } else {
+    } else if (mCurrentReactContext != null) {
       attachMeasuredRootViewToInstance(rootView, mCurrentReactContext.getCatalystInstance());
     }
+    // Otherwise the view will be attached once the context being created is set up
   }
 
   /**
@@ -300,21 +387,22 @@ public class ReactInstanceManager {
   }
 
   private void onReloadWithJSDebugger(ProxyJavaScriptExecutor proxyExecutor) {
-    recreateReactContext(
+    recreateReactContextInBackground(
         proxyExecutor,
         JSBundleLoader.createRemoteDebuggerBundleLoader(
             mDevSupportManager.getJSBundleURLForRemoteDebugging()));
   }
 
   private void onJSBundleLoadedFromServer() {
-    recreateReactContext(
-        new JSCJavaScriptExecutor(),
+    recreateReactContextInBackground(
+        null,
         JSBundleLoader.createCachedBundleFromNetworkLoader(
             mDevSupportManager.getSourceUrl(),
             mDevSupportManager.getDownloadedJSBundleFile()));
   }
 
   private void initializeReactContext() {
+    mHasStartedCreatingInitialContext = true;
     if (mUseDeveloperSupport) {
       if (mDevSupportManager.hasUpToDateJSBundleInCache()) {
         // If there is a up-to-date bundle downloaded from server, always use that
@@ -322,32 +410,71 @@ public class ReactInstanceManager {
         return;
       } else if (mBundleAssetName == null ||
           !mDevSupportManager.hasBundleInAssets(mBundleAssetName)) {
-        // Bundle not available in assets, fetch from the server
+        // Bundle not available in assets, fetch from the server. The JS context is created while
+        // it downloads.
+        prepareWarmJSContextInBackground();
         mDevSupportManager.handleReloadJS();
         return;
       }
     }
     // Use JS file from assets
-    recreateReactContext(
-        new JSCJavaScriptExecutor(),
+    recreateReactContextInBackground(
+        null,
         JSBundleLoader.createAssetLoader(
             mApplicationContext.getAssets(),
             mBundleAssetName));
   }
 
-  private void recreateReactContext(
-      JavaScriptExecutor jsExecutor,
+  /**
+   * @param jsExecutor the executor to run the bundle with, or null for a JSC executor
+   */
+  private void recreateReactContextInBackground(
+      @Nullable JavaScriptExecutor jsExecutor,
       JSBundleLoader jsBundleLoader) {
+    recreateReactContextInBackground(new ReactContextInitParams(jsExecutor, jsBundleLoader));
+  }
+
+  private void recreateReactContextInBackground(ReactContextInitParams initParams) {
     UiThreadUtil.assertOnUiThread();
-    if (mCurrentReactContext != null) {
-      tearDownReactContext(mCurrentReactContext);
+    if (mReactContextInitAsyncTask != null) {
+      // Only the latest request matters, it runs once the context being created is set up
+      mPendingReactContextInitParams = initParams;
+      return;
     }
-    mCurrentReactContext = createReactContext(jsExecutor, jsBundleLoader);
+    mReactContextInitAsyncTask = new ReactContextInitAsyncTask();
+    mReactContextInitAsyncTask.executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR, initParams);
+  }
+
+  private void setupReactContext(ReactApplicationContext reactContext) {
+    UiThreadUtil.assertOnUiThread();
+    mCurrentReactContext = reactContext;
+    CatalystInstance catalystInstance = reactContext.getCatalystInstance();
+    catalystInstance.initialize();
+    mDevSupportManager.onNewReactContextCreated(reactContext);
+    moveReactContextToCurrentLifecycleState(reactContext);
+
     for (ReactRootView rootView : mAttachedRootViews) {
-      attachMeasuredRootViewToInstance(
-          rootView,
-          mCurrentReactContext.getCatalystInstance());
+      attachMeasuredRootViewToInstance(rootView, catalystInstance);
     }
+
+    if (mUseDeveloperSupport) {
+      // Reloads are frequent with developer support, have the next context ready for one
+      prepareWarmJSContextInBackground();
+    }
+  }
+
+  /**
+   * Has the next {@link JSCJavaScriptExecutor} take a JS context created off the UI thread ahead
+   * of time, rather than create one while the context is being created.
+   */
+  private static void prepareWarmJSContextInBackground() {
+    AsyncTask.THREAD_POOL_EXECUTOR.execute(
+        new Runnable() {
+          @Override
+          public void run() {
+            JSCJavaScriptExecutor.prepareWarmContext();
+          }
+        });
   }
 
   private void attachMeasuredRootViewToInstance(
@@ -394,7 +521,8 @@ public class ReactInstanceManager {
   }
 
   /**
-   * @return instance of {@link ReactContext} configured a {@link CatalystInstance} set
+   * @return instance of {@link ReactContext} configured a {@link CatalystInstance} set. Runs off
+   * the UI thread, {@link #setupReactContext} does the rest once it returns.
    */
   private ReactApplicationContext createReactContext(
       JavaScriptExecutor jsExecutor,
@@ -430,10 +558,6 @@ public class ReactInstanceManager {
     }
 
     reactContext.initializeWithInstance(catalystInstance);
-    catalystInstance.initialize();
-    mDevSupportManager.onNewReactContextCreated(reactContext);
-
-    moveReactContextToCurrentLifecycleState(reactContext);
 
     return reactContext;
   }
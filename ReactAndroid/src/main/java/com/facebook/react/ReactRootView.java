@@ -26,6 +26,7 @@ import com.facebook.react.bridge.Arguments;
 import com.facebook.react.bridge.ReactContext;
 import com.facebook.react.bridge.UiThreadUtil;
 import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.queue.CatalystQueueConfiguration;
 import com.facebook.react.common.ReactConstants;
 import com.facebook.react.common.annotations.VisibleForTesting;
 import com.facebook.react.modules.core.DeviceEventManagerModule;
@@ -61,6 +62,7 @@ public class ReactRootView extends SizeMonitoringFrameLayout implements RootView
   private @Nullable Bundle mLaunchOptions;
   private int mTargetTag = -1;
   private boolean mChildIsHandlingNativeGesture = false;
+  private @Nullable CatalystQueueConfiguration mInteractionQueueConfiguration;
   private boolean mWasMeasured = false;
   private boolean mAttachScheduled = false;
   private boolean mIsAttachedToWindow = false;
@@ -129,6 +131,7 @@ public class ReactRootView extends SizeMonitoringFrameLayout implements RootView
     }
     int action = ev.getAction() & MotionEvent.ACTION_MASK;
     ReactContext reactContext = mReactInstanceManager.getCurrentReactContext();
+    updateInteraction(reactContext, action);
     EventDispatcher eventDispatcher = reactContext.getNativeModule(UIManagerModule.class)
         .getEventDispatcher();
     if (action == MotionEvent.ACTION_DOWN) {
@@ -179,6 +182,27 @@ public class ReactRootView extends SizeMonitoringFrameLayout implements RootView
     }
   }
 
+  /**
+   * Boosts the bridge threads from the first finger going down until the last one goes up, which
+   * also covers gestures that a child, like a ScrollView, handles natively.
+   */
+  private void updateInteraction(ReactContext reactContext, int action) {
+    if (action == MotionEvent.ACTION_DOWN && mInteractionQueueConfiguration == null) {
+      mInteractionQueueConfiguration =
+          reactContext.getCatalystInstance().getCatalystQueueConfiguration();
+      mInteractionQueueConfiguration.beginInteraction();
+    } else if (action == MotionEvent.ACTION_UP || action == MotionEvent.ACTION_CANCEL) {
+      endInteraction();
+    }
+  }
+
+  private void endInteraction() {
+    if (mInteractionQueueConfiguration != null) {
+      mInteractionQueueConfiguration.endInteraction();
+      mInteractionQueueConfiguration = null;
+    }
+  }
+
   @Override
   public void onChildStartedNativeGesture(MotionEvent androidEvent) {
     if (mChildIsHandlingNativeGesture) {
@@ -247,6 +271,7 @@ public class ReactRootView extends SizeMonitoringFrameLayout implements RootView
     super.onDetachedFromWindow();
 
     mIsAttachedToWindow = false;
+    endInteraction();
 
     if (mReactInstanceManager != null && !mAttachScheduled) {
       mReactInstanceManager.detachRootView(this);
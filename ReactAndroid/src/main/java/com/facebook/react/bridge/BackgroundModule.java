@@ -0,0 +1,19 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+/**
+ * Interface for a {@link LowPriorityModule} whose calls nobody waits for, like analytics or
+ * logging. Besides running on the low priority queue thread, JS may hold back its calls for up to
+ * half a second while it has calls to other modules to send, so they never share a batch with
+ * latency sensitive work.
+ */
+public interface BackgroundModule extends LowPriorityModule {
+}
@@ -40,21 +40,28 @@ import java.util.Map;
  * case when it express success & error callback pair as two last arguments respecively.
  *
  * All methods exposed as native to JS with {@link ReactMethod} annotation must return
- * {@code void}.
+ * {@code void}. Methods annotated with {@link ReactSyncMethod} instead return their result to JS
+ * synchronously.
  *
  * Please note that it is not allowed to have multiple methods annotated with {@link ReactMethod}
  * with the same name.
  */
 public abstract class BaseJavaModule implements NativeModule {
   private class JavaMethod implements NativeMethod {
-    private Method method;
+    protected Method method;
 
     public JavaMethod(Method method) {
       this.method = method;
     }
 
     @Override
-    public void invoke(CatalystInstance catalystInstance, ReadableNativeArray parameters) {
+    public void invoke(CatalystInstance catalystInstance, ReadableArray parameters) {
+      invokeMethod(catalystInstance, parameters);
+    }
+
+    protected @Nullable Object invokeMethod(
+        CatalystInstance catalystInstance,
+        ReadableArray parameters) {
       Systrace.beginSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, "callJavaModuleMethod");
       try {
         Class[] types = method.getParameterTypes();
@@ -103,7 +110,7 @@ public abstract class BaseJavaModule implements NativeModule {
         }
 
         try {
-          method.invoke(BaseJavaModule.this, arguments);
+          return method.invoke(BaseJavaModule.this, arguments);
         } catch (IllegalArgumentException ie) {
           throw new RuntimeException(
               "Could not invoke " + BaseJavaModule.this.getName() + "." + method.getName(), ie);
@@ -125,13 +132,35 @@ public abstract class BaseJavaModule implements NativeModule {
     }
   }
 
+  private class JavaSyncMethod extends JavaMethod implements SyncNativeMethod {
+
+    public JavaSyncMethod(Method method) {
+      super(method);
+      for (Class argumentClass : method.getParameterTypes()) {
+        if (argumentClass == Callback.class) {
+          throw new IllegalArgumentException(
+              "Sync method " + BaseJavaModule.this.getName() + "." + method.getName() +
+              " can't take callbacks");
+        }
+      }
+    }
+
+    @Override
+    public @Nullable Object invokeSync(
+        CatalystInstance catalystInstance,
+        ReadableArray parameters) {
+      return invokeMethod(catalystInstance, parameters);
+    }
+  }
+
   @Override
   public final Map<String, NativeMethod> getMethods() {
     Map<String, NativeMethod> methods = new HashMap<String, NativeMethod>();
     Method[] targetMethods = getClass().getDeclaredMethods();
     for (int i = 0; i < targetMethods.length; i++) {
       Method targetMethod = targetMethods[i];
-      if (targetMethod.getAnnotation(ReactMethod.class) != null) {
+      boolean isSync = targetMethod.getAnnotation(ReactSyncMethod.class) != null;
+      if (isSync || targetMethod.getAnnotation(ReactMethod.class) != null) {
         String methodName = targetMethod.getName();
         if (methods.containsKey(methodName)) {
           // We do not support method overloading since js sees a function as an object regardless
@@ -139,7 +168,9 @@ public abstract class BaseJavaModule implements NativeModule {
           throw new IllegalArgumentException(
               "Java Module " + getName() + " method name already registered: " + methodName);
           }
-        methods.put(methodName, new JavaMethod(targetMethod));
+        methods.put(
+            methodName,
+            isSync ? new JavaSyncMethod(targetMethod) : new JavaMethod(targetMethod));
       }
     }
     return methods;
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * Counts the traffic through one {@link CatalystInstance}: the native calls made from JS, with
+ * the size of their arguments and the time spent running them, per module and method, and the
+ * events sent from native to JS, per event name. Recording is off until started, callers check
+ * {@link #isRecording()} before they time anything.
+ */
+public class BridgeTrafficStats {
+
+  public static class CallStats {
+    public final String moduleName;
+    public final String methodName;
+    public int count;
+    public long argumentBytes;
+    public long timeNs;
+
+    private CallStats(String moduleName, String methodName) {
+      this.moduleName = moduleName;
+      this.methodName = methodName;
+    }
+
+    private CallStats copy() {
+      CallStats copy = new CallStats(moduleName, methodName);
+      copy.count = count;
+      copy.argumentBytes = argumentBytes;
+      copy.timeNs = timeNs;
+      return copy;
+    }
+  }
+
+  private volatile boolean mRecording = false;
+
+  // Guarded by this
+  private final HashMap<String, HashMap<String, CallStats>> mCalls = new HashMap<>();
+  private final HashMap<String, Integer> mEvents = new HashMap<>();
+
+  public boolean isRecording() {
+    return mRecording;
+  }
+
+  public void setRecording(boolean recording) {
+    mRecording = recording;
+  }
+
+  /* package */ synchronized void recordCall(
+      String moduleName,
+      String methodName,
+      int argumentBytes,
+      long timeNs) {
+    HashMap<String, CallStats> methods = mCalls.get(moduleName);
+    if (methods == null) {
+      methods = new HashMap<>();
+      mCalls.put(moduleName, methods);
+    }
+    CallStats stats = methods.get(methodName);
+    if (stats == null) {
+      stats = new CallStats(moduleName, methodName);
+      methods.put(methodName, stats);
+    }
+    stats.count++;
+    stats.argumentBytes += argumentBytes;
+    stats.timeNs += timeNs;
+  }
+
+  public synchronized void recordEvent(String eventName) {
+    if (!mRecording) {
+      return;
+    }
+    Integer count = mEvents.get(eventName);
+    mEvents.put(eventName, count == null ? 1 : count + 1);
+  }
+
+  public synchronized void reset() {
+    mCalls.clear();
+    mEvents.clear();
+  }
+
+  /**
+   * @return a copy of the call stats, sorted by the time spent in them, longest first
+   */
+  public synchronized List<CallStats> getCallStats() {
+    ArrayList<CallStats> calls = new ArrayList<>();
+    for (HashMap<String, CallStats> methods : mCalls.values()) {
+      for (CallStats stats : methods.values()) {
+        calls.add(stats.copy());
+      }
+    }
+    Collections.sort(calls, new Comparator<CallStats>() {
+      @Override
+      public int compare(CallStats lhs, CallStats rhs) {
+        return lhs.timeNs < rhs.timeNs ? 1 : (lhs.timeNs == rhs.timeNs ? 0 : -1);
+      }
+    });
+    return calls;
+  }
+
+  public synchronized Map<String, Integer> getEventCounts() {
+    return new HashMap<>(mEvents);
+  }
+
+  /**
+   * The stats in the same shape as on iOS: "calls" maps module names to method names to
+   * {count, argumentBytes, time}, with the time in ms, and "events" maps event names to counts.
+   */
+  public WritableMap toWritableMap() {
+    WritableMap calls = Arguments.createMap();
+    HashMap<String, WritableMap> modules = new HashMap<>();
+    for (CallStats stats : getCallStats()) {
+      WritableMap methods = modules.get(stats.moduleName);
+      if (methods == null) {
+        methods = Arguments.createMap();
+        modules.put(stats.moduleName, methods);
+      }
+      WritableMap method = Arguments.createMap();
+      method.putInt("count", stats.count);
+      method.putDouble("argumentBytes", stats.argumentBytes);
+      method.putDouble("time", stats.timeNs / 1e6);
+      methods.putMap(stats.methodName, method);
+    }
+    for (Map.Entry<String, WritableMap> module : modules.entrySet()) {
+      calls.putMap(module.getKey(), module.getValue());
+    }
+
+    WritableMap events = Arguments.createMap();
+    for (Map.Entry<String, Integer> event : getEventCounts().entrySet()) {
+      events.putInt(event.getKey(), event.getValue());
+    }
+
+    WritableMap stats = Arguments.createMap();
+    stats.putMap("calls", calls);
+    stats.putMap("events", events);
+    return stats;
+  }
+
+  /**
+   * A few lines on the most expensive methods, for the dev overlay.
+   */
+  public String summarize(int maxCalls) {
+    StringBuilder summary = new StringBuilder();
+    List<CallStats> calls = getCallStats();
+    for (int i = 0; i < Math.min(maxCalls, calls.size()); i++) {
+      CallStats stats = calls.get(i);
+      if (summary.length() > 0) {
+        summary.append('\n');
+      }
+      summary.append(String.format(
+          Locale.US,
+          "%s.%s: %d calls, %.1fKB, %.1fms",
+          stats.moduleName,
+          stats.methodName,
+          stats.count,
+          stats.argumentBytes / 1024.0,
+          stats.timeNs / 1e6));
+    }
+    int events = 0;
+    for (int count : getEventCounts().values()) {
+      events += count;
+    }
+    if (summary.length() > 0) {
+      summary.append('\n');
+    }
+    summary.append(String.format(Locale.US, "Events: %d", events));
+    return summary.toString();
+  }
+}
@@ -13,6 +13,7 @@ import javax.annotation.Nullable;
 
 import java.io.IOException;
 import java.io.StringWriter;
+import java.nio.ByteBuffer;
 import java.util.Collection;
 import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.CountDownLatch;
@@ -51,6 +52,7 @@ public class CatalystInstance {
   private final String mJsPendingCallsTitleForTrace =
       "pending_js_calls_instance" + sNextInstanceIdForTrace.getAndIncrement();
   private volatile boolean mDestroyed = false;
+  private final BridgeTrafficStats mBridgeTrafficStats = new BridgeTrafficStats();
 
   // Access from native modules thread
   private final NativeModuleRegistry mJavaRegistry;
@@ -75,12 +77,29 @@ public class CatalystInstance {
     mJavaRegistry = registry;
     mNativeModuleCallExceptionHandler = nativeModuleCallExceptionHandler;
 
+    // The bundle is read on a native thread while the JS thread creates the bridge and its
+    // context, and this one builds the module config. Each takes a while on slow devices, and
+    // they only come together when the bundle is run.
+    jsBundleLoader.prefetchScript();
+
     final CountDownLatch initLatch = new CountDownLatch(1);
     mCatalystQueueConfiguration.getJSQueueThread().runOnQueue(
         new Runnable() {
           @Override
           public void run() {
-            initializeBridge(jsExecutor, registry, jsModulesConfig, jsBundleLoader);
+            createBridge(jsExecutor, registry);
+          }
+        });
+
+    final String modulesConfig = buildModulesConfigJSONProperty(
+        registry,
+        jsModulesConfig,
+        jsExecutor.providesNativeModuleProxy());
+    mCatalystQueueConfiguration.getJSQueueThread().runOnQueue(
+        new Runnable() {
+          @Override
+          public void run() {
+            initializeBridge(modulesConfig, jsBundleLoader);
             mJSModuleRegistry =
                 new JavaScriptModuleRegistry(CatalystInstance.this, jsModulesConfig);
 
@@ -97,21 +116,22 @@ public class CatalystInstance {
     }
   }
 
-  private void initializeBridge(
-      JavaScriptExecutor jsExecutor,
-      NativeModuleRegistry registry,
-      JavaScriptModulesConfig jsModulesConfig,
-      JSBundleLoader jsBundleLoader) {
+  private void createBridge(JavaScriptExecutor jsExecutor, NativeModuleRegistry registry) {
     mCatalystQueueConfiguration.getJSQueueThread().assertIsOnThread();
-    Assertions.assertCondition(mBridge == null, "initializeBridge should be called once");
+    Assertions.assertCondition(mBridge == null, "createBridge should be called once");
     mBridge = new ReactBridge(
         jsExecutor,
         new NativeModulesReactCallback(),
-        mCatalystQueueConfiguration.getNativeModulesQueueThread());
-    mBridge.setGlobalVariable(
-        "__fbBatchedBridgeConfig",
-        buildModulesConfigJSONProperty(registry, jsModulesConfig));
-    jsBundleLoader.loadScript(mBridge);
+        mCatalystQueueConfiguration.getNativeModulesQueueThread(),
+        mCatalystQueueConfiguration.getLowPriorityNativeModulesQueueThread(),
+        registry.lowPriorityModuleIds());
+  }
+
+  private void initializeBridge(String modulesConfig, JSBundleLoader jsBundleLoader) {
+    mCatalystQueueConfiguration.getJSQueueThread().assertIsOnThread();
+    ReactBridge bridge = Assertions.assertNotNull(mBridge);
+    bridge.setGlobalVariable("__fbBatchedBridgeConfig", modulesConfig);
+    jsBundleLoader.loadScript(bridge);
   }
 
   /* package */ void callFunction(
@@ -232,6 +252,14 @@ public class CatalystInstance {
     return mBridge;
   }
 
+  /**
+   * Per method counts of the calls from JS, and per name counts of the events sent to JS. Exposed
+   * to JS by {@code BridgeTrafficModule}.
+   */
+  public BridgeTrafficStats getBridgeTrafficStats() {
+    return mBridgeTrafficStats;
+  }
+
   public <T extends JavaScriptModule> T getJSModule(Class<T> jsInterface) {
     return Assertions.assertNotNull(mJSModuleRegistry).getJavaScriptModule(jsInterface);
   }
@@ -264,7 +292,8 @@ public class CatalystInstance {
 
   private String buildModulesConfigJSONProperty(
       NativeModuleRegistry nativeModuleRegistry,
-      JavaScriptModulesConfig jsModulesConfig) {
+      JavaScriptModulesConfig jsModulesConfig,
+      boolean providesNativeModuleProxy) {
     // TODO(5300733): Serialize config using single json generator
     JsonFactory jsonFactory = new JsonFactory();
     StringWriter writer = new StringWriter();
@@ -272,7 +301,9 @@ public class CatalystInstance {
       JsonGenerator jg = jsonFactory.createGenerator(writer);
       jg.writeStartObject();
       jg.writeFieldName("remoteModuleConfig");
-      jg.writeRawValue(nativeModuleRegistry.moduleDescriptions());
+      // JS reads the configs from nativeModuleProxy instead, one module at a time
+      jg.writeRawValue(
+          providesNativeModuleProxy ? "{}" : nativeModuleRegistry.moduleDescriptions());
       jg.writeFieldName("localModulesConfig");
       jg.writeRawValue(jsModulesConfig.moduleDescriptions());
       jg.writeEndObject();
@@ -297,8 +328,8 @@ public class CatalystInstance {
     }
   }
 
-  private void decrementPendingJSCalls() {
-    int newPendingCalls = mPendingJSCalls.decrementAndGet();
+  private void decrementPendingJSCalls(int completedCalls) {
+    int newPendingCalls = mPendingJSCalls.addAndGet(-completedCalls);
     boolean isNowIdle = newPendingCalls == 0;
     Systrace.traceCounter(
         Systrace.TRACE_TAG_REACT_JAVA_BRIDGE,
@@ -310,24 +341,83 @@ public class CatalystInstance {
         listener.onTransitionToBridgeIdle();
       }
     }
+
+    // Safe to touch the bridge from here: destroy() stops the native modules thread before it
+    // disposes the bridge.
+    ReactBridge bridge = mBridge;
+    if (isNowIdle && !mDestroyed && bridge != null) {
+      bridge.handleIdle();
+    }
   }
 
   private class NativeModulesReactCallback implements ReactCallback {
 
     @Override
-    public void call(int moduleId, int methodId, ReadableNativeArray parameters) {
+    public void callBatch(ByteBuffer calls) {
       mCatalystQueueConfiguration.getNativeModulesQueueThread().assertIsOnThread();
+      callModules(calls);
+    }
 
+    @Override
+    public void callLowPriorityBatch(ByteBuffer calls) {
+      Assertions.assertNotNull(mCatalystQueueConfiguration.getLowPriorityNativeModulesQueueThread())
+          .assertIsOnThread();
+      callModules(calls);
+    }
+
+    private void callModules(ByteBuffer calls) {
       // Suppress any callbacks if destroyed - will only lead to sadness.
       if (mDestroyed) {
         return;
       }
 
-      mJavaRegistry.call(CatalystInstance.this, moduleId, methodId, parameters);
+      MethodCallBuffer buffer = new MethodCallBuffer(calls);
+      while (buffer.nextCall()) {
+        mJavaRegistry.call(
+            CatalystInstance.this,
+            buffer.getModuleId(),
+            buffer.getMethodId(),
+            buffer.getArguments(),
+            buffer.getArgumentBytes());
+        // A call may tear the instance down, the rest of the batch must then be dropped
+        if (mDestroyed) {
+          return;
+        }
+      }
+    }
+
+    @Override
+    public @Nullable NativeArray callSync(
+        int moduleId,
+        int methodId,
+        ReadableNativeArray parameters) {
+      // Runs on whichever thread drives JS, which is not always the JS queue thread
+      if (mDestroyed) {
+        return null;
+      }
+      Object result = mJavaRegistry.callSync(
+          CatalystInstance.this,
+          moduleId,
+          methodId,
+          parameters);
+      return Arguments.fromJavaArgs(new Object[] {result});
     }
 
     @Override
-    public void onBatchComplete() {
+    public String[] getModuleNames() {
+      return mJavaRegistry.moduleNames();
+    }
+
+    @Override
+    public @Nullable String getModuleConfig(String moduleName) {
+      if (mDestroyed) {
+        return null;
+      }
+      return mJavaRegistry.moduleDescription(moduleName);
+    }
+
+    @Override
+    public void onBatchComplete(int completedJSCalls) {
       mCatalystQueueConfiguration.getNativeModulesQueueThread().assertIsOnThread();
 
       // The bridge may have been destroyed due to an exception during the batch. In that case
@@ -343,7 +433,9 @@ public class CatalystInstance {
         }
       }
 
-      decrementPendingJSCalls();
+      if (completedJSCalls > 0) {
+        decrementPendingJSCalls(completedJSCalls);
+      }
     }
   }
 
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import java.io.IOException;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+import com.facebook.soloader.SoLoader;
+
+/**
+ * Updates a cached bundle from a delta that only carries the modules that changed, so an update
+ * downloads those instead of the whole bundle. The format is described in jni/react/jni/JSDelta.h.
+ * The delta names the hash of the bundle it was built against and of the bundle it produces, so a
+ * delta for another bundle, or one that was corrupted, fails instead of producing a broken bundle.
+ *
+ * Apply the delta off the UI thread, then load the output as usual with
+ * {@link JSBundleLoader#createCachedBundleFromNetworkLoader}. If applying fails, download the
+ * full bundle instead.
+ */
+@DoNotStrip
+public class JSBundleDelta {
+
+  static {
+    SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.BRIDGE);
+  }
+
+  /**
+   * @param baseFileName the cached bundle the delta was built against
+   * @param deltaFileName the downloaded delta
+   * @param outputFileName where the new bundle is written, once it matches the hash the delta
+   *   expects. It may be the same file as {@code baseFileName}.
+   * @throws IOException if the delta doesn't apply to the base, or the output can't be written
+   */
+  public static native void apply(String baseFileName, String deltaFileName, String outputFileName)
+      throws IOException;
+}
@@ -26,6 +26,11 @@ public abstract class JSBundleLoader {
       final AssetManager assetManager,
       final String assetFileName) {
     return new JSBundleLoader() {
+      @Override
+      public void prefetchScript() {
+        ReactBridge.prefetchScriptFromAssets(assetManager, assetFileName);
+      }
+
       @Override
       public void loadScript(ReactBridge bridge) {
         bridge.loadScriptFromAssets(assetManager, assetFileName);
@@ -65,5 +70,12 @@ public abstract class JSBundleLoader {
     };
   }
 
+  /**
+   * Called before the bridge is created, from the thread creating the {@link CatalystInstance},
+   * to start reading the bundle while the bridge is being set up.
+   */
+  public void prefetchScript() {
+  }
+
   public abstract void loadScript(ReactBridge bridge);
 }
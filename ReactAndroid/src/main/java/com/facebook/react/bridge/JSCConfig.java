@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import android.app.ActivityManager;
+import android.content.Context;
+import android.os.Build;
+
+/**
+ * How eagerly a {@link JSCJavaScriptExecutor} collects garbage while the bridge is idle. JSC has
+ * no public way to cap its heap or tune its collector, so instead the executor collects when JS
+ * goes idle, at most once per {@code idleCollectionIntervalMs}, and only once the heap is at least
+ * {@code idleCollectionMinHeapSize} bytes and has grown by {@code idleCollectionHeapGrowth} bytes
+ * since the last idle collection. An interval of 0 turns idle collection off.
+ *
+ * <p>{@code useNativeJSThread} moves the executor off the JS queue thread onto a native thread
+ * the bridge owns, which runs calls that arrive together in one batch. It is off unless asked for
+ * with {@link #withNativeJSThread}.
+ *
+ * <p>{@code shareContextGroup} creates the JS context in a context group shared with every other
+ * executor that asks for it, see {@link #withSharedContextGroup}. It is off by default.
+ */
+public class JSCConfig {
+
+  public static final JSCConfig DEFAULT = new JSCConfig(10000, 16 * 1024 * 1024, 4 * 1024 * 1024);
+  public static final JSCConfig LOW_MEMORY = new JSCConfig(2000, 4 * 1024 * 1024, 1024 * 1024);
+
+  private static final int LOW_MEMORY_CLASS_MB = 64;
+
+  public final int idleCollectionIntervalMs;
+  public final long idleCollectionMinHeapSize;
+  public final long idleCollectionHeapGrowth;
+  public final boolean useNativeJSThread;
+  public final boolean shareContextGroup;
+
+  public JSCConfig(
+      int idleCollectionIntervalMs,
+      long idleCollectionMinHeapSize,
+      long idleCollectionHeapGrowth) {
+    this(idleCollectionIntervalMs, idleCollectionMinHeapSize, idleCollectionHeapGrowth, false);
+  }
+
+  public JSCConfig(
+      int idleCollectionIntervalMs,
+      long idleCollectionMinHeapSize,
+      long idleCollectionHeapGrowth,
+      boolean useNativeJSThread) {
+    this(
+        idleCollectionIntervalMs,
+        idleCollectionMinHeapSize,
+        idleCollectionHeapGrowth,
+        useNativeJSThread,
+        false);
+  }
+
+  public JSCConfig(
+      int idleCollectionIntervalMs,
+      long idleCollectionMinHeapSize,
+      long idleCollectionHeapGrowth,
+      boolean useNativeJSThread,
+      boolean shareContextGroup) {
+    this.idleCollectionIntervalMs = idleCollectionIntervalMs;
+    this.idleCollectionMinHeapSize = idleCollectionMinHeapSize;
+    this.idleCollectionHeapGrowth = idleCollectionHeapGrowth;
+    this.useNativeJSThread = useNativeJSThread;
+    this.shareContextGroup = shareContextGroup;
+  }
+
+  /**
+   * This config with the executor on a native JS thread. Has no effect in builds with the extra
+   * JSC tracing hooks, which have to stay on a Java thread.
+   */
+  public JSCConfig withNativeJSThread() {
+    return new JSCConfig(
+        idleCollectionIntervalMs,
+        idleCollectionMinHeapSize,
+        idleCollectionHeapGrowth,
+        true,
+        shareContextGroup);
+  }
+
+  /**
+   * This config with the JS context in a context group shared by every executor created with such
+   * a config. Bridges that run the same bundle then share one JSC VM, with its heap, builtins and
+   * code cache, which saves memory and startup time for each surface after the first. The VM is
+   * locked for each call into it though, so the bridges no longer run JS in parallel: a long call
+   * on one surface, or a garbage collection, delays all of them.
+   */
+  public JSCConfig withSharedContextGroup() {
+    return new JSCConfig(
+        idleCollectionIntervalMs,
+        idleCollectionMinHeapSize,
+        idleCollectionHeapGrowth,
+        useNativeJSThread,
+        true);
+  }
+
+  /**
+   * {@link #LOW_MEMORY} on devices that report being low on RAM or give apps a small heap,
+   * {@link #DEFAULT} otherwise.
+   */
+  public static JSCConfig forDevice(Context context) {
+    ActivityManager activityManager =
+        (ActivityManager) context.getSystemService(Context.ACTIVITY_SERVICE);
+    if (activityManager == null) {
+      return DEFAULT;
+    }
+    boolean isLowRamDevice = Build.VERSION.SDK_INT >= Build.VERSION_CODES.KITKAT &&
+        activityManager.isLowRamDevice();
+    if (isLowRamDevice || activityManager.getMemoryClass() <= LOW_MEMORY_CLASS_MB) {
+      return LOW_MEMORY;
+    }
+    return DEFAULT;
+  }
+}
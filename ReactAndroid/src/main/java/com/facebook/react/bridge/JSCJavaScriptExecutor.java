@@ -17,12 +17,55 @@ public class JSCJavaScriptExecutor extends JavaScriptExecutor {
 
   static {
     SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.EXECUTORS);
   }
 
   public JSCJavaScriptExecutor() {
-    initialize();
+    this(JSCConfig.DEFAULT);
   }
 
-  private native void initialize();
+  public JSCJavaScriptExecutor(JSCConfig config) {
+    initialize(
+        config.idleCollectionIntervalMs,
+        config.idleCollectionMinHeapSize,
+        config.idleCollectionHeapGrowth,
+        config.useNativeJSThread,
+        config.shareContextGroup);
+  }
+
+  private native void initialize(
+      int idleCollectionIntervalMs,
+      long idleCollectionMinHeapSize,
+      long idleCollectionHeapGrowth,
+      boolean useNativeJSThread,
+      boolean shareContextGroup);
+
+  @Override
+  public boolean providesNativeModuleProxy() {
+    return true;
+  }
+
+  /**
+   * Creates a JS context with the native hooks already installed, which the next
+   * JSCJavaScriptExecutor's bridge will take instead of creating its own, unless it shares its
+   * context group (see {@link JSCConfig#withSharedContextGroup}). This is slow, so call it from a
+   * background thread ahead of creating or reloading a bridge, e.g. when an activity that hosts
+   * React views is about to start. Only one warm context is kept.
+   */
+  public static native void prepareWarmContext();
+
+  /**
+   * Starts recording the JS trace sections and counters of the given systrace tags into memory
+   * instead of systrace, for tracing fine-grained JS sections without the cost of a trace write
+   * per event. Applies to every JS context in the process. Each thread keeps its latest
+   * {@code eventsPerThread} events. Returns false if buffered tracing is already running.
+   */
+  public static native boolean startBufferedTracing(long tags, int eventsPerThread);
+
+  /**
+   * Stops buffered tracing and writes what was recorded to {@code filename} in the Chrome trace
+   * format. Returns false if tracing was not running or the file could not be written.
+   */
+  public static native boolean stopBufferedTracing(String filename);
 
 }
@@ -13,6 +13,7 @@ import javax.annotation.Nullable;
 
 import java.io.IOException;
 import java.io.StringWriter;
+import java.nio.ByteBuffer;
 import java.util.HashMap;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -125,10 +126,13 @@ public class JSDebuggerWebSocketClient implements WebSocketListener {
     }
   }
 
+  /**
+   * @param jsonArgsArray UTF-8 json, copied into the message as it is, without decoding it
+   */
   public void executeJSCall(
       String moduleName,
       String methodName,
-      String jsonArgsArray,
+      ByteBuffer jsonArgsArray,
       JSDebuggerCallback callback) {
 
     int requestID = mRequestID.getAndIncrement();
@@ -139,9 +143,17 @@ public class JSDebuggerWebSocketClient implements WebSocketListener {
       jg.writeStringField("method","executeJSCall");
       jg.writeStringField("moduleName", moduleName);
       jg.writeStringField("moduleMethod", methodName);
-      jg.writeFieldName("arguments");
-      jg.writeRawValue(jsonArgsArray);
-      sendMessage(requestID, endMessageObject(jg));
+      String header = endMessageObject(jg);
+
+      // Reopen the object after the header fields and append the arguments as the last field
+      Buffer messageBuffer = new Buffer();
+      messageBuffer.writeUtf8(header.substring(0, header.length() - 1));
+      messageBuffer.writeUtf8(",\"arguments\":");
+      byte[] arguments = new byte[jsonArgsArray.remaining()];
+      jsonArgsArray.get(arguments);
+      messageBuffer.write(arguments);
+      messageBuffer.writeByte('}');
+      sendMessage(requestID, messageBuffer);
     } catch (IOException e) {
       triggerRequestFailure(requestID, e);
     }
@@ -159,14 +171,18 @@ public class JSDebuggerWebSocketClient implements WebSocketListener {
   }
 
   private void sendMessage(int requestID, String message) {
+    Buffer messageBuffer = new Buffer();
+    messageBuffer.writeUtf8(message);
+    sendMessage(requestID, messageBuffer);
+  }
+
+  private void sendMessage(int requestID, Buffer messageBuffer) {
     if (mWebSocket == null) {
       triggerRequestFailure(
           requestID,
           new IllegalStateException("WebSocket connection no longer valid"));
       return;
     }
-    Buffer messageBuffer = new Buffer();
-    messageBuffer.writeUtf8(message);
     try {
       mWebSocket.sendMessage(WebSocket.PayloadType.TEXT, messageBuffer);
     } catch (IOException e) {
@@ -197,16 +213,17 @@ public class JSDebuggerWebSocketClient implements WebSocketListener {
       return;
     }
 
-    String message = null;
+    // Jackson reads the UTF-8 bytes directly, only the result is decoded
+    byte[] message = null;
     try {
-      message = payload.readUtf8();
+      message = payload.readByteArray();
     } finally {
       payload.close();
     }
     Integer replyID = null;
 
     try {
-      JsonParser parser = new JsonFactory().createParser(message);
+      JsonParser parser = mJsonFactory.createParser(message);
       String result = null;
       while (parser.nextToken() != JsonToken.END_OBJECT) {
         String field = parser.getCurrentName();
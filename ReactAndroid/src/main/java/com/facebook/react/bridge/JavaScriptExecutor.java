@@ -22,4 +22,13 @@ public abstract class JavaScriptExecutor extends Countable {
   public void close() {
   }
 
+  /**
+   * Whether this executor installs the {@code nativeModuleProxy} global, which asks
+   * {@link ReactCallback#getModuleConfig} for each module's config the first time JS reads it.
+   * If so, the configs of the native modules are not injected before loading JS.
+   */
+  public boolean providesNativeModuleProxy() {
+    return false;
+  }
+
 }
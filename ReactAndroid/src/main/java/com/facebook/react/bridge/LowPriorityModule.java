@@ -0,0 +1,19 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+/**
+ * Interface for a module whose JS->Java calls can wait behind the rest of their batch, e.g.
+ * storage writes or network sends. Its calls run on the low priority native modules queue thread
+ * when there is one, so they don't hold up latency sensitive modules like UIManager. Calls to one
+ * module still run in the order JS made them, but not in order with other modules' calls.
+ */
+public interface LowPriorityModule {
+}
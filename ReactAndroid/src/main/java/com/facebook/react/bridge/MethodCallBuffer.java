@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.util.HashMap;
+
+/**
+ * Reads the batch of method calls written by MethodCallBuffer.cpp. The buffer is backed by native
+ * memory that is only valid during {@link ReactCallback#callBatch}, so every call's arguments are
+ * decoded up front into {@link ReadableBufferArray}s instead of being read lazily.
+ */
+/* package */ class MethodCallBuffer {
+
+  // Keep in sync with MethodCallBuffer.cpp
+  private static final byte TAG_NULL = 0;
+  private static final byte TAG_FALSE = 1;
+  private static final byte TAG_TRUE = 2;
+  private static final byte TAG_NUMBER = 3;
+  private static final byte TAG_STRING = 4;
+  private static final byte TAG_ARRAY = 5;
+  private static final byte TAG_MAP = 6;
+  private static final byte TAG_NUMBER_ARRAY = 7;
+
+  private static final Charset UTF_8 = Charset.forName("UTF-8");
+
+  private final ByteBuffer mBuffer;
+  private final String[] mStrings;
+  private int mCallsLeft;
+
+  private int mModuleId;
+  private int mMethodId;
+  private ReadableBufferArray mArguments;
+  private int mArgumentBytes;
+
+  public MethodCallBuffer(ByteBuffer buffer) {
+    mBuffer = buffer.order(ByteOrder.nativeOrder());
+    mStrings = new String[mBuffer.getInt()];
+    byte[] bytes = new byte[0];
+    for (int i = 0; i < mStrings.length; i++) {
+      int length = mBuffer.getInt();
+      if (bytes.length < length) {
+        bytes = new byte[length];
+      }
+      mBuffer.get(bytes, 0, length);
+      mStrings[i] = new String(bytes, 0, length, UTF_8);
+    }
+    mCallsLeft = mBuffer.getInt();
+  }
+
+  /**
+   * Advances to the next call in the batch.
+   *
+   * @return false once every call has been read
+   */
+  public boolean nextCall() {
+    if (mCallsLeft == 0) {
+      return false;
+    }
+    mCallsLeft--;
+    mModuleId = mBuffer.getInt();
+    mMethodId = mBuffer.getInt();
+    int argumentsStart = mBuffer.position();
+    Object arguments = readValue();
+    mArgumentBytes = mBuffer.position() - argumentsStart;
+    if (!(arguments instanceof ReadableBufferArray)) {
+      throw new UnexpectedNativeTypeException("Method call arguments must be an array");
+    }
+    mArguments = (ReadableBufferArray) arguments;
+    return true;
+  }
+
+  public int getModuleId() {
+    return mModuleId;
+  }
+
+  public int getMethodId() {
+    return mMethodId;
+  }
+
+  public ReadableBufferArray getArguments() {
+    return mArguments;
+  }
+
+  /**
+   * @return the size of the current call's arguments in the buffer. Strings are only counted by
+   * their index, their contents are shared by the whole batch.
+   */
+  public int getArgumentBytes() {
+    return mArgumentBytes;
+  }
+
+  private Object readValue() {
+    byte tag = mBuffer.get();
+    switch (tag) {
+      case TAG_NULL:
+        return null;
+      case TAG_FALSE:
+        return Boolean.FALSE;
+      case TAG_TRUE:
+        return Boolean.TRUE;
+      case TAG_NUMBER:
+        return mBuffer.getDouble();
+      case TAG_STRING:
+        return mStrings[mBuffer.getInt()];
+      case TAG_ARRAY: {
+        Object[] values = new Object[mBuffer.getInt()];
+        for (int i = 0; i < values.length; i++) {
+          values[i] = readValue();
+        }
+        return new ReadableBufferArray(values);
+      }
+      case TAG_MAP: {
+        int size = mBuffer.getInt();
+        HashMap<String, Object> values = new HashMap<String, Object>(size);
+        for (int i = 0; i < size; i++) {
+          String key = mStrings[mBuffer.getInt()];
+          values.put(key, readValue());
+        }
+        return new ReadableBufferMap(values);
+      }
+      case TAG_NUMBER_ARRAY: {
+        double[] numbers = new double[mBuffer.getInt()];
+        mBuffer.asDoubleBuffer().get(numbers);
+        mBuffer.position(mBuffer.position() + numbers.length * 8);
+        return new ReadableBufferArray(numbers);
+      }
+      default:
+        throw new UnexpectedNativeTypeException("Unknown value tag in method call buffer: " + tag);
+    }
+  }
+}
@@ -20,6 +20,7 @@ import com.facebook.soloader.SoLoader;
 public abstract class NativeArray {
   static {
     SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.COLLECTIONS);
   }
 
   public NativeArray() {
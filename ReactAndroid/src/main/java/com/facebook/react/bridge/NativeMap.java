@@ -21,6 +21,7 @@ public abstract class NativeMap extends Countable {
 
   static {
     SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.COLLECTIONS);
   }
 
   public NativeMap() {
@@ -9,6 +9,8 @@
 
 package com.facebook.react.bridge;
 
+import javax.annotation.Nullable;
+
 import java.io.IOException;
 import java.util.Map;
 
@@ -23,7 +25,14 @@ import com.fasterxml.jackson.core.JsonGenerator;
  */
 public interface NativeModule {
   public static interface NativeMethod {
-    void invoke(CatalystInstance catalystInstance, ReadableNativeArray parameters);
+    void invoke(CatalystInstance catalystInstance, ReadableArray parameters);
+  }
+
+  /**
+   * A method JS calls synchronously, on the JS thread, see {@link ReactSyncMethod}.
+   */
+  public static interface SyncNativeMethod extends NativeMethod {
+    @Nullable Object invokeSync(CatalystInstance catalystInstance, ReadableArray parameters);
   }
 
   /**
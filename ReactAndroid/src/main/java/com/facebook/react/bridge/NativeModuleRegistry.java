@@ -17,6 +17,8 @@ import java.util.HashSet;
 import java.util.Map;
 import java.util.Set;
 
+import javax.annotation.Nullable;
+
 import com.facebook.react.common.MapBuilder;
 import com.facebook.react.common.SetBuilder;
 import com.facebook.infer.annotation.Assertions;
@@ -32,20 +34,20 @@ public class NativeModuleRegistry {
 
   private final ArrayList<ModuleDefinition> mModuleTable;
   private final Map<Class<NativeModule>, NativeModule> mModuleInstances;
-  private final String mModuleDescriptions;
+  private final Map<String, ModuleDefinition> mModulesByName;
   private final ArrayList<OnBatchCompleteListener> mBatchCompleteListenerModules;
 
   private NativeModuleRegistry(
       ArrayList<ModuleDefinition> moduleTable,
-      Map<Class<NativeModule>, NativeModule> moduleInstances,
-      String moduleDescriptions) {
+      Map<Class<NativeModule>, NativeModule> moduleInstances) {
     mModuleTable = moduleTable;
     mModuleInstances = moduleInstances;
-    mModuleDescriptions = moduleDescriptions;
 
+    mModulesByName = MapBuilder.newHashMap();
     mBatchCompleteListenerModules = new ArrayList<OnBatchCompleteListener>(mModuleTable.size());
     for (int i = 0; i < mModuleTable.size(); i++) {
       ModuleDefinition definition = mModuleTable.get(i);
+      mModulesByName.put(definition.name, definition);
       if (definition.target instanceof OnBatchCompleteListener) {
         mBatchCompleteListenerModules.add((OnBatchCompleteListener) definition.target);
       }
@@ -56,16 +58,113 @@ public class NativeModuleRegistry {
       CatalystInstance catalystInstance,
       int moduleId,
       int methodId,
-      ReadableNativeArray parameters) {
+      ReadableArray parameters,
+      int argumentBytes) {
     ModuleDefinition definition = mModuleTable.get(moduleId);
     if (definition == null) {
       throw new RuntimeException("Call to unknown module: " + moduleId);
     }
-    definition.call(catalystInstance, methodId, parameters);
+    BridgeTrafficStats trafficStats = catalystInstance.getBridgeTrafficStats();
+    if (!trafficStats.isRecording()) {
+      definition.call(catalystInstance, methodId, parameters);
+      return;
+    }
+    long start = System.nanoTime();
+    try {
+      definition.call(catalystInstance, methodId, parameters);
+    } finally {
+      trafficStats.recordCall(
+          definition.name,
+          definition.methods.get(methodId).name,
+          argumentBytes,
+          System.nanoTime() - start);
+    }
+  }
+
+  /**
+   * Calls a {@link ReactSyncMethod} on the current thread, which is the JS thread.
+   */
+  /* package */ @Nullable Object callSync(
+      CatalystInstance catalystInstance,
+      int moduleId,
+      int methodId,
+      ReadableArray parameters) {
+    ModuleDefinition definition = mModuleTable.get(moduleId);
+    if (definition == null) {
+      throw new RuntimeException("Call to unknown module: " + moduleId);
+    }
+    return definition.callSync(catalystInstance, methodId, parameters);
+  }
+
+  /**
+   * @return the ids of the modules that are {@link LowPriorityModule}s
+   */
+  /* package */ int[] lowPriorityModuleIds() {
+    int count = 0;
+    for (int i = 0; i < mModuleTable.size(); i++) {
+      if (mModuleTable.get(i).target instanceof LowPriorityModule) {
+        count++;
+      }
+    }
+    int[] moduleIds = new int[count];
+    count = 0;
+    for (int i = 0; i < mModuleTable.size(); i++) {
+      ModuleDefinition definition = mModuleTable.get(i);
+      if (definition.target instanceof LowPriorityModule) {
+        moduleIds[count++] = definition.id;
+      }
+    }
+    return moduleIds;
   }
 
+  /**
+   * The configs of all modules, keyed by module name. Writing the constants of every module is
+   * slow, executors with a native module proxy use {@link #moduleDescription} instead.
+   */
   /* package */ String moduleDescriptions() {
-    return mModuleDescriptions;
+    JsonFactory jsonFactory = new JsonFactory();
+    StringWriter writer = new StringWriter();
+    try {
+      JsonGenerator jg = jsonFactory.createGenerator(writer);
+      jg.writeStartObject();
+      for (ModuleDefinition module : mModuleTable) {
+        jg.writeFieldName(module.name);
+        module.writeDescription(jg);
+      }
+      jg.writeEndObject();
+      jg.close();
+    } catch (IOException ioe) {
+      throw new RuntimeException("Unable to serialize Java module configuration", ioe);
+    }
+    return writer.getBuffer().toString();
+  }
+
+  /* package */ String[] moduleNames() {
+    String[] moduleNames = new String[mModuleTable.size()];
+    for (int i = 0; i < mModuleTable.size(); i++) {
+      moduleNames[i] = mModuleTable.get(i).name;
+    }
+    return moduleNames;
+  }
+
+  /**
+   * The config of a single module, or null if there is no module with that name.
+   */
+  /* package */ @Nullable String moduleDescription(String moduleName) {
+    ModuleDefinition module = mModulesByName.get(moduleName);
+    if (module == null) {
+      return null;
+    }
+    JsonFactory jsonFactory = new JsonFactory();
+    StringWriter writer = new StringWriter();
+    try {
+      JsonGenerator jg = jsonFactory.createGenerator(writer);
+      module.writeDescription(jg);
+      jg.close();
+    } catch (IOException ioe) {
+      throw new RuntimeException("Unable to serialize Java module configuration", ioe);
+    }
+    return writer.getBuffer().toString();
   }
 
   /* package */ void notifyCatalystInstanceDestroy() {
@@ -119,7 +218,7 @@ public class NativeModuleRegistry {
     public void call(
         CatalystInstance catalystInstance,
         int methodId,
-        ReadableNativeArray parameters) {
+        ReadableArray parameters) {
       MethodRegistration method = this.methods.get(methodId);
       Systrace.beginSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, method.tracingName);
       try {
@@ -128,6 +227,44 @@ public class NativeModuleRegistry {
         Systrace.endSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE);
       }
     }
+
+    public @Nullable Object callSync(
+        CatalystInstance catalystInstance,
+        int methodId,
+        ReadableArray parameters) {
+      MethodRegistration method = this.methods.get(methodId);
+      if (!(method.method instanceof NativeModule.SyncNativeMethod)) {
+        throw new RuntimeException(name + "." + method.name + " is not a sync method");
+      }
+      Systrace.beginSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, method.tracingName);
+      try {
+        return ((NativeModule.SyncNativeMethod) method.method)
+            .invokeSync(catalystInstance, parameters);
+      } finally {
+        Systrace.endSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE);
+      }
+    }
+
+    public void writeDescription(JsonGenerator jg) throws IOException {
+      jg.writeStartObject();
+      jg.writeNumberField("moduleID", id);
+      jg.writeObjectFieldStart("methods");
+      for (int i = 0; i < methods.size(); i++) {
+        MethodRegistration method = methods.get(i);
+        jg.writeObjectFieldStart(method.name);
+        jg.writeNumberField("methodID", i);
+        if (method.method instanceof NativeModule.SyncNativeMethod) {
+          jg.writeStringField("type", "sync");
+        }
+        jg.writeEndObject();
+      }
+      jg.writeEndObject();
+      if (target instanceof BackgroundModule) {
+        jg.writeBooleanField("background", true);
+      }
+      target.writeConstantsField(jg, "constants");
+      jg.writeEndObject();
+    }
   }
 
   private static class MethodRegistration {
@@ -169,32 +306,7 @@ public class NativeModuleRegistry {
     }
 
     public NativeModuleRegistry build() {
-      JsonFactory jsonFactory = new JsonFactory();
-      StringWriter writer = new StringWriter();
-      try {
-        JsonGenerator jg = jsonFactory.createGenerator(writer);
-        jg.writeStartObject();
-        for (ModuleDefinition module : mModuleDefinitions) {
-          jg.writeObjectFieldStart(module.name);
-          jg.writeNumberField("moduleID", module.id);
-          jg.writeObjectFieldStart("methods");
-          for (int i = 0; i < module.methods.size(); i++) {
-            MethodRegistration method = module.methods.get(i);
-            jg.writeObjectFieldStart(method.name);
-            jg.writeNumberField("methodID", i);
-            jg.writeEndObject();
-          }
-          jg.writeEndObject();
-          module.target.writeConstantsField(jg, "constants");
-          jg.writeEndObject();
-        }
-        jg.writeEndObject();
-        jg.close();
-      } catch (IOException ioe) {
-        throw new RuntimeException("Unable to serialize Java module configuration", ioe);
-      }
-      String moduleDefinitionJson = writer.getBuffer().toString();
-      return new NativeModuleRegistry(mModuleDefinitions, mModuleInstances, moduleDefinitionJson);
+      return new NativeModuleRegistry(mModuleDefinitions, mModuleInstances);
     }
   }
 }
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+import com.facebook.soloader.SoLoader;
+
+/**
+ * Registers the natives of the bridge library one group at a time, from the static initializer of
+ * the first class of each group that is used, instead of all of them when the library is loaded.
+ * Loading the library is on the way to the first React screen, while most groups are only needed
+ * once a bridge is being set up.
+ */
+@DoNotStrip
+public class NativeRegistration {
+
+  static {
+    SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+  }
+
+  // Must match the groups in OnLoad.cpp
+  public static final int COLLECTIONS = 0;
+  public static final int QUEUE = 1;
+  public static final int EXECUTORS = 2;
+  public static final int BRIDGE = 3;
+  public static final int AFFINITY = 4;
+
+  private static final boolean[] sRegistered = new boolean[AFFINITY + 1];
+
+  public static synchronized void ensureRegistered(int group) {
+    if (sRegistered[group]) {
+      return;
+    }
+    // Marked first, in case registering initializes a class of the same group
+    sRegistered[group] = true;
+    if (group == BRIDGE) {
+      ensureRegistered(COLLECTIONS);
+      ensureRegistered(QUEUE);
+    }
+    registerNatives(group);
+  }
+
+  private static native void registerNatives(int group);
+}
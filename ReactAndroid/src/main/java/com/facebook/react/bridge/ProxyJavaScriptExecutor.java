@@ -11,6 +11,8 @@ package com.facebook.react.bridge;
 
 import javax.annotation.Nullable;
 
+import java.nio.ByteBuffer;
+
 import com.facebook.soloader.SoLoader;
 import com.facebook.proguard.annotations.DoNotStrip;
 
@@ -27,6 +29,7 @@ public class ProxyJavaScriptExecutor extends JavaScriptExecutor {
 
   static {
     SoLoader.loadLibrary(ReactBridge.REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.EXECUTORS);
   }
 
   public static class ProxyExecutorException extends Exception {
@@ -50,22 +53,29 @@ public class ProxyJavaScriptExecutor extends JavaScriptExecutor {
 
     /**
      * Load javascript into the js context
-     * @param script script contet to be executed
+     * @param script direct buffer with the UTF-8 script content to be executed. It points into
+     * native memory that is only valid until this call returns.
      * @param sourceURL url or file location from which script content was loaded
      */
     @DoNotStrip
-    void executeApplicationScript(String script, String sourceURL) throws ProxyExecutorException;
+    void executeApplicationScript(ByteBuffer script, String sourceURL)
+        throws ProxyExecutorException;
 
     /**
      * Execute javascript method within js context
      * @param modulename name of the common-js like module to execute the method from
      * @param methodName name of the method to be executed
-     * @param jsonArgsArray json encoded array of arguments provided for the method call
-     * @return json encoded value returned from the method call
+     * @param jsonArgsArray direct buffer with the UTF-8 json encoded array of arguments provided
+     * for the method call. It points into native memory that is only valid until this call
+     * returns.
+     * @return direct buffer, as large as its content, with the UTF-8 json encoded value returned
+     * from the method call, or the binary batch format
      */
     @DoNotStrip
-    String executeJSCall(String modulename, String methodName, String jsonArgsArray)
-        throws ProxyExecutorException;
+    @Nullable ByteBuffer executeJSCall(
+        String modulename,
+        String methodName,
+        ByteBuffer jsonArgsArray) throws ProxyExecutorException;
 
     @DoNotStrip
     void setGlobalVariable(String propertyName, String jsonEncodedValue);
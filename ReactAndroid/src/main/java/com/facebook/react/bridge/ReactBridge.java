@@ -28,11 +28,13 @@ public class ReactBridge extends Countable {
 
   static {
     SoLoader.loadLibrary(REACT_NATIVE_LIB);
+    NativeRegistration.ensureRegistered(NativeRegistration.BRIDGE);
   }
 
   private final ReactCallback mCallback;
   private final JavaScriptExecutor mJSExecutor;
   private final MessageQueueThread mNativeModulesQueueThread;
+  private final @Nullable MessageQueueThread mLowPriorityNativeModulesQueueThread;
 
   /**
    * @param jsExecutor the JS executor to use to run JS
@@ -43,29 +45,98 @@ public class ReactBridge extends Countable {
       JavaScriptExecutor jsExecutor,
       ReactCallback callback,
       MessageQueueThread nativeModulesQueueThread) {
+    this(jsExecutor, callback, nativeModulesQueueThread, null, new int[0]);
+  }
+
+  /**
+   * @param lowPriorityNativeModulesQueueThread the MessageQueueThread calls to the modules in
+   *   {@code lowPriorityModuleIds} are invoked on, see {@link ReactCallback#callLowPriorityBatch}.
+   *   If null, every call goes to {@code nativeModulesQueueThread}.
+   */
+  public ReactBridge(
+      JavaScriptExecutor jsExecutor,
+      ReactCallback callback,
+      MessageQueueThread nativeModulesQueueThread,
+      @Nullable MessageQueueThread lowPriorityNativeModulesQueueThread,
+      int[] lowPriorityModuleIds) {
     mJSExecutor = jsExecutor;
     mCallback = callback;
     mNativeModulesQueueThread = nativeModulesQueueThread;
-    initialize(jsExecutor, callback, mNativeModulesQueueThread);
+    mLowPriorityNativeModulesQueueThread = lowPriorityNativeModulesQueueThread;
+    initialize(
+        jsExecutor,
+        callback,
+        mNativeModulesQueueThread,
+        mLowPriorityNativeModulesQueueThread,
+        lowPriorityModuleIds);
   }
 
   @Override
   public void dispose() {
     mJSExecutor.close();
     mJSExecutor.dispose();
+    unpinReferences();
     super.dispose();
   }
 
+  /**
+   * Lets the callback and the queue threads go even if native work that was queued before the
+   * bridge was disposed still holds on to them.
+   */
+  private native void unpinReferences();
+
   private native void initialize(
       JavaScriptExecutor jsExecutor,
       ReactCallback callback,
-      MessageQueueThread nativeModulesQueueThread);
+      MessageQueueThread nativeModulesQueueThread,
+      @Nullable MessageQueueThread lowPriorityNativeModulesQueueThread,
+      int[] lowPriorityModuleIds);
+  /**
+   * Starts reading the asset on a native thread, so that a bridge created meanwhile doesn't have
+   * to wait for all of it in {@link #loadScriptFromAssets}.
+   */
+  public static native void prefetchScriptFromAssets(AssetManager assetManager, String assetName);
   public native void loadScriptFromAssets(AssetManager assetManager, String assetName);
   public native void loadScriptFromNetworkCached(String sourceURL, @Nullable String tempFileName);
   public native void callFunction(int moduleId, int methodId, NativeArray arguments);
   public native void invokeCallback(int callbackID, NativeArray arguments);
   public native void setGlobalVariable(String propertyName, String jsonEncodedArgument);
   public native boolean supportsProfiling();
+  /**
+   * @return a JSON object with histograms of JS execution time, conversion time, flushed queue
+   * parse time, calls per flush and flushed queue size, collected since the bridge was created.
+   * While tracing or sampling, it also has the JS heap size and the calls a collection ran in.
+   */
+  public native String getStats();
   public native void startProfiler(String title);
   public native void stopProfiler(String title, String filename);
+  public native boolean supportsSamplingProfiler();
+  /**
+   * Starts a low overhead sampling profiler that records which bridge call and BridgeProfiling
+   * section JS is in every {@code intervalUs}, keeping the latest {@code maxSamples} samples.
+   * Pass 0 for either to use the defaults.
+   */
+  public native void startSamplingProfiler(int intervalUs, int maxSamples);
+  /**
+   * Stops the sampling profiler and writes what it collected to {@code filename} in the Chrome
+   * trace event format, which chrome://tracing opens directly.
+   */
+  public native void stopSamplingProfiler(String filename);
+  /**
+   * Hints that JS is idle, e.g. for the rest of a frame, so that garbage is collected now rather
+   * than in the middle of a later call.
+   */
+  public native void collectGarbage();
+  /**
+   * Tells the executor that no calls into JS are pending, so it may collect garbage if its idle
+   * collection policy allows. Unlike {@link #collectGarbage}, this is cheap when nothing is due.
+   */
+  public native void handleIdle();
+  /**
+   * Records every call into JS, and the calls JS makes in return, to {@code filename} until
+   * {@link #stopRecording}, so that the session can be replayed as a benchmark. Starting again
+   * replaces the current recording.
+   */
+  public native void startRecording(String filename);
+  public native void stopRecording();
 }
@@ -9,14 +9,58 @@
 
 package com.facebook.react.bridge;
 
+import javax.annotation.Nullable;
+
+import java.nio.ByteBuffer;
+
 import com.facebook.proguard.annotations.DoNotStrip;
 
 @DoNotStrip
 public interface ReactCallback {
 
+  /**
+   * Delivers every call from one JS batch at once, see {@link MethodCallBuffer} for the format.
+   * The buffer wraps native memory that is freed as soon as this returns.
+   */
+  @DoNotStrip
+  void callBatch(ByteBuffer calls);
+
+  /**
+   * Like {@link #callBatch}, for the calls of a batch that go to {@link LowPriorityModule}s. Runs
+   * on the low priority native modules queue thread and is not followed by
+   * {@link #onBatchComplete}.
+   */
+  @DoNotStrip
+  void callLowPriorityBatch(ByteBuffer calls);
+
+  /**
+   * Follows each batch on the native modules queue thread, including batches without calls.
+   * {@code completedJSCalls} is the number of calls into JS the batch came back from. It is more
+   * than one for calls the bridge sent to JS together, and 0 for calls JS flushed on its own, e.g.
+   * while the bundle loads.
+   */
+  @DoNotStrip
+  void onBatchComplete(int completedJSCalls);
+
+  /**
+   * Calls a {@link ReactSyncMethod} while JS waits for it, on the JS thread.
+   *
+   * @return an array holding just the method's result
+   */
+  @DoNotStrip
+  @Nullable NativeArray callSync(int moduleId, int methodId, ReadableNativeArray parameters);
+
+  /**
+   * The names of the native modules, for executors that provide a native module proxy. Called
+   * on the JS thread.
+   */
   @DoNotStrip
-  void call(int moduleId, int methodId, ReadableNativeArray parameters);
+  String[] getModuleNames();
 
+  /**
+   * The JSON config of one native module, or null if there is no such module. Called on the JS
+   * thread the first time JS uses the module.
+   */
   @DoNotStrip
-  void onBatchComplete();
+  @Nullable String getModuleConfig(String moduleName);
 }
@@ -0,0 +1,28 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import java.lang.annotation.Retention;
+
+import static java.lang.annotation.RetentionPolicy.RUNTIME;
+
+/**
+ * Like {@link ReactMethod}, but JS calls the method synchronously and gets back what it returns,
+ * instead of queueing the call for the next batch. Meant for cheap, read-only lookups such as
+ * cached values, where the round trip costs more than the call itself.
+ *
+ * Sync methods run on the JS thread rather than the native modules thread, so they must be
+ * thread-safe and must not block. They can't take {@link Callback}s, and return null, a boolean,
+ * a number, a {@link String}, a {@link WritableNativeMap} or a {@link WritableNativeArray}.
+ */
+@Retention(RUNTIME)
+public @interface ReactSyncMethod {
+
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import javax.annotation.Nullable;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+
+/**
+ * A {@link ReadableArray} whose values have already been decoded into Java objects, so reading it
+ * never crosses into native code. Produced by {@link MethodCallBuffer} and
+ * {@link ReadableNativeMap#toReadableBufferMap}. Arrays of numbers are kept unboxed in a double[].
+ */
+public class ReadableBufferArray implements ReadableArray {
+
+  private final @Nullable Object[] mValues;
+  private final @Nullable double[] mNumbers;
+
+  @DoNotStrip
+  /* package */ ReadableBufferArray(Object[] values) {
+    mValues = values;
+    mNumbers = null;
+  }
+
+  @DoNotStrip
+  /* package */ ReadableBufferArray(double[] numbers) {
+    mValues = null;
+    mNumbers = numbers;
+  }
+
+  @Override
+  public int size() {
+    return mNumbers != null ? mNumbers.length : mValues.length;
+  }
+
+  @Override
+  public boolean isNull(int index) {
+    return getValue(index) == null;
+  }
+
+  @Override
+  public boolean getBoolean(int index) {
+    return checkType(getValue(index), Boolean.class);
+  }
+
+  @Override
+  public double getDouble(int index) {
+    if (mNumbers != null) {
+      return mNumbers[index];
+    }
+    return checkType(mValues[index], Double.class);
+  }
+
+  @Override
+  public int getInt(int index) {
+    return (int) getDouble(index);
+  }
+
+  // Check CatalystStylesDiffMap#getColorInt() to see why this is needed
+  @Override
+  public int getColorInt(int index) {
+    return (int) (long) getDouble(index);
+  }
+
+  @Override
+  public @Nullable String getString(int index) {
+    return checkNullableType(getValue(index), String.class);
+  }
+
+  @Override
+  public @Nullable ReadableBufferArray getArray(int index) {
+    return checkNullableType(getValue(index), ReadableBufferArray.class);
+  }
+
+  @Override
+  public @Nullable ReadableBufferMap getMap(int index) {
+    return checkNullableType(getValue(index), ReadableBufferMap.class);
+  }
+
+  @Override
+  public ReadableType getType(int index) {
+    return typeOf(getValue(index));
+  }
+
+  private @Nullable Object getValue(int index) {
+    return mNumbers != null ? (Object) mNumbers[index] : mValues[index];
+  }
+
+  /* package */ static ReadableType typeOf(@Nullable Object value) {
+    if (value == null) {
+      return ReadableType.Null;
+    } else if (value instanceof Boolean) {
+      return ReadableType.Boolean;
+    } else if (value instanceof Double) {
+      return ReadableType.Number;
+    } else if (value instanceof String) {
+      return ReadableType.String;
+    } else if (value instanceof ReadableBufferMap) {
+      return ReadableType.Map;
+    } else {
+      return ReadableType.Array;
+    }
+  }
+
+  /* package */ static <T> T checkType(@Nullable Object value, Class<T> type) {
+    if (!type.isInstance(value)) {
+      throw new UnexpectedNativeTypeException(
+          "Expected " + type.getSimpleName() + ", got a " + typeOf(value).name());
+    }
+    return type.cast(value);
+  }
+
+  /* package */ static @Nullable <T> T checkNullableType(@Nullable Object value, Class<T> type) {
+    return value == null ? null : checkType(value, type);
+  }
+}
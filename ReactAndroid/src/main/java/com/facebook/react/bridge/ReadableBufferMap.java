@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge;
+
+import javax.annotation.Nullable;
+
+import java.util.HashMap;
+import java.util.Iterator;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+
+/**
+ * A {@link ReadableMap} whose values have already been decoded into Java objects, so reading it
+ * never crosses into native code. Produced by {@link MethodCallBuffer} and
+ * {@link ReadableNativeMap#toReadableBufferMap}.
+ */
+public class ReadableBufferMap implements ReadableMap {
+
+  private final HashMap<String, Object> mValues;
+
+  @DoNotStrip
+  /* package */ ReadableBufferMap(HashMap<String, Object> values) {
+    mValues = values;
+  }
+
+  @Override
+  public boolean hasKey(String name) {
+    return mValues.containsKey(name);
+  }
+
+  @Override
+  public boolean isNull(String name) {
+    return getValue(name) == null;
+  }
+
+  @Override
+  public boolean getBoolean(String name) {
+    return ReadableBufferArray.checkType(getValue(name), Boolean.class);
+  }
+
+  @Override
+  public double getDouble(String name) {
+    return ReadableBufferArray.checkType(getValue(name), Double.class);
+  }
+
+  @Override
+  public int getInt(String name) {
+    return (int) getDouble(name);
+  }
+
+  // Check CatalystStylesDiffMap#getColorInt() to see why this is needed
+  @Override
+  public int getColorInt(String name) {
+    return (int) (long) getDouble(name);
+  }
+
+  @Override
+  public @Nullable String getString(String name) {
+    return ReadableBufferArray.checkNullableType(getValue(name), String.class);
+  }
+
+  @Override
+  public @Nullable ReadableBufferArray getArray(String name) {
+    return ReadableBufferArray.checkNullableType(getValue(name), ReadableBufferArray.class);
+  }
+
+  @Override
+  public @Nullable ReadableBufferMap getMap(String name) {
+    return ReadableBufferArray.checkNullableType(getValue(name), ReadableBufferMap.class);
+  }
+
+  @Override
+  public ReadableType getType(String name) {
+    return ReadableBufferArray.typeOf(getValue(name));
+  }
+
+  @Override
+  public ReadableMapKeySeyIterator keySetIterator() {
+    final Iterator<String> keys = mValues.keySet().iterator();
+    return new ReadableMapKeySeyIterator() {
+      @Override
+      public boolean hasNextKey() {
+        return keys.hasNext();
+      }
+
+      @Override
+      public String nextKey() {
+        return keys.next();
+      }
+    };
+  }
+
+  private @Nullable Object getValue(String name) {
+    if (!mValues.containsKey(name)) {
+      throw new NoSuchKeyException(name);
+    }
+    return mValues.get(name);
+  }
+}
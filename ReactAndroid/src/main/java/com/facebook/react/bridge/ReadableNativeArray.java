@@ -9,6 +9,8 @@
 
 package com.facebook.react.bridge;
 
+import java.util.ArrayList;
+
 import com.facebook.proguard.annotations.DoNotStrip;
 import com.facebook.soloader.SoLoader;
 
@@ -45,6 +47,18 @@ public class ReadableNativeArray extends NativeArray implements ReadableArray {
     return (int) getDouble(index);
   }
 
+  /**
+   * Reads all of the elements in one call into native code, rather than one call per element.
+   * Throws {@link UnexpectedNativeTypeException} if any of them isn't a number.
+   */
+  public native double[] getDoubles();
+
+  /**
+   * Copies the whole array into Java in one call into native code, with the same value types as
+   * {@link ReadableNativeMap#toHashMap}.
+   */
+  public native ArrayList<Object> toArrayList();
+
   // Check CatalystStylesDiffMap#getColorInt() to see why this is needed
   @Override
   public int getColorInt(int index) {
@@ -9,6 +9,8 @@
 
 package com.facebook.react.bridge;
 
+import java.util.HashMap;
+
 import com.facebook.jni.Countable;
 import com.facebook.proguard.annotations.DoNotStrip;
 import com.facebook.soloader.SoLoader;
@@ -46,6 +48,25 @@ public class ReadableNativeMap extends NativeMap implements ReadableMap {
     return new ReadableNativeMapKeySeyIterator(this);
   }
 
+  /**
+   * Copies the whole map into Java in one call into native code. Values are null, Boolean, Double,
+   * String, or, for nested values, ArrayList and HashMap of those. Prefer this over iterating the
+   * keys and reading each value when most of the map is going to be read.
+   */
+  public native HashMap<String, Object> toHashMap();
+
+  /**
+   * Like {@link #toHashMap}, but returns a {@link ReadableMap} that never calls into native code
+   * again, with nested values as {@link ReadableBufferMap} and {@link ReadableBufferArray}.
+   */
+  public native ReadableBufferMap toReadableBufferMap();
+
+  /**
+   * Calls the visitor once for each entry, in a single call into native code. Nested arrays and
+   * maps are handed over as copies. The map must not be modified while it is being visited.
+   */
+  public native void visit(Visitor visitor);
+
   @Override
   public int getInt(String name) {
     return (int) getDouble(name);
@@ -56,6 +77,26 @@ public class ReadableNativeMap extends NativeMap implements ReadableMap {
   public int getColorInt(String name) {
     return (int) (long) getDouble(name);
   }
+  /**
+   * Receives the entries of a {@link ReadableNativeMap}, see {@link #visit}. Numbers always arrive
+   * as doubles.
+   */
+  @DoNotStrip
+  public interface Visitor {
+    @DoNotStrip
+    void onNull(String key);
+    @DoNotStrip
+    void onBoolean(String key, boolean value);
+    @DoNotStrip
+    void onDouble(String key, double value);
+    @DoNotStrip
+    void onString(String key, String value);
+    @DoNotStrip
+    void onArray(String key, ReadableNativeArray value);
+    @DoNotStrip
+    void onMap(String key, ReadableNativeMap value);
+  }
+
   /**
    * Implementation of a {@link ReadableNativeMap} iterator in native memory.
    */
@@ -11,6 +11,8 @@ package com.facebook.react.bridge;
 
 import javax.annotation.Nullable;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
 import java.util.HashMap;
 import java.util.concurrent.Semaphore;
 import java.util.concurrent.TimeUnit;
@@ -27,6 +29,7 @@ public class WebsocketJavaScriptExecutor implements ProxyJavaScriptExecutor.Java
 
   private static final long CONNECT_TIMEOUT_MS = 5000;
   private static final int CONNECT_RETRY_COUNT = 3;
+  private static final Charset UTF_8 = Charset.forName("UTF-8");
 
   public interface JSExecutorConnectCallback {
     void onSuccess();
@@ -145,8 +148,9 @@ public class WebsocketJavaScriptExecutor implements ProxyJavaScriptExecutor.Java
   }
 
   @Override
-  public void executeApplicationScript(String script, String sourceURL)
+  public void executeApplicationScript(ByteBuffer script, String sourceURL)
       throws ProxyJavaScriptExecutor.ProxyExecutorException {
+    // The debugger loads the script from the packager itself, only the url is sent
     JSExecutorCallbackFuture callback = new JSExecutorCallbackFuture();
     Assertions.assertNotNull(mWebSocketClient).executeApplicationScript(
         sourceURL,
@@ -160,19 +164,29 @@ public class WebsocketJavaScriptExecutor implements ProxyJavaScriptExecutor.Java
   }
 
   @Override
-  public @Nullable String executeJSCall(String moduleName, String methodName, String jsonArgsArray)
-      throws ProxyJavaScriptExecutor.ProxyExecutorException {
+  public @Nullable ByteBuffer executeJSCall(
+      String moduleName,
+      String methodName,
+      ByteBuffer jsonArgsArray) throws ProxyJavaScriptExecutor.ProxyExecutorException {
     JSExecutorCallbackFuture callback = new JSExecutorCallbackFuture();
     Assertions.assertNotNull(mWebSocketClient).executeJSCall(
         moduleName,
         methodName,
         jsonArgsArray,
         callback);
+    String result;
     try {
-      return callback.get();
+      result = callback.get();
     } catch (Throwable cause) {
       throw new ProxyJavaScriptExecutor.ProxyExecutorException(cause);
     }
+    if (result == null) {
+      return null;
+    }
+    byte[] bytes = result.getBytes(UTF_8);
+    ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+    buffer.put(bytes);
+    return buffer;
   }
 
   @Override
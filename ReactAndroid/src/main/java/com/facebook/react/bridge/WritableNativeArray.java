@@ -39,6 +39,17 @@ public class WritableNativeArray extends ReadableNativeArray implements Writable
     pushDouble(value);
   }
 
+  /**
+   * Appends all of the values in one call into native code, rather than one call per element.
+   * Prefer this to {@link #pushDouble} in a loop for large arrays, e.g. sensor or chart data.
+   */
+  public native void pushDoubles(double[] values);
+
+  /**
+   * Appends all of the values in one call into native code, see {@link #pushDoubles}.
+   */
+  public native void pushInts(int[] values);
+
   // Note: this consumes the map so do not reuse it.
   @Override
   public void pushArray(WritableArray array) {
@@ -62,6 +62,14 @@ public class WritableNativeMap extends ReadableNativeMap implements WritableMap
     mergeNativeMap((ReadableNativeMap) source);
   }
 
+  /**
+   * Moves every entry of {@code source} into this map, replacing the values of keys that are
+   * already there. Unlike {@link #merge}, nothing is copied, nested maps and arrays included, which
+   * makes it the cheap way to compose a map, like an event payload, out of separately built parts.
+   * Note: this consumes the source map so do not reuse it.
+   */
+  public native void putAll(WritableNativeMap source);
+
   private native void putNativeMap(String key, WritableNativeMap value);
   private native void putNativeArray(String key, WritableNativeArray value);
   private native void mergeNativeMap(ReadableNativeMap source);
@@ -9,6 +9,8 @@
 
 package com.facebook.react.bridge.queue;
 
+import javax.annotation.Nullable;
+
 import java.util.Map;
 
 import android.os.Looper;
@@ -22,20 +24,25 @@ import com.facebook.react.common.MapBuilder;
  *
  * UI Queue Thread: The standard Android main UI thread and Looper. Not configurable.
  * Native Modules Queue Thread: The thread and Looper that native modules are invoked on.
+ * Low Priority Native Modules Queue Thread: Optional, the thread and Looper that
+ *   {@link com.facebook.react.bridge.LowPriorityModule}s are invoked on.
  * JS Queue Thread: The thread and Looper that JS is executed on.
  */
 public class CatalystQueueConfiguration {
 
   private final MessageQueueThread mUIQueueThread;
   private final MessageQueueThread mNativeModulesQueueThread;
+  private final @Nullable MessageQueueThread mLowPriorityNativeModulesQueueThread;
   private final MessageQueueThread mJSQueueThread;
 
   private CatalystQueueConfiguration(
       MessageQueueThread uiQueueThread,
       MessageQueueThread nativeModulesQueueThread,
+      @Nullable MessageQueueThread lowPriorityNativeModulesQueueThread,
       MessageQueueThread jsQueueThread) {
     mUIQueueThread = uiQueueThread;
     mNativeModulesQueueThread = nativeModulesQueueThread;
+    mLowPriorityNativeModulesQueueThread = lowPriorityNativeModulesQueueThread;
     mJSQueueThread = jsQueueThread;
   }
 
@@ -47,10 +54,35 @@ public class CatalystQueueConfiguration {
     return mNativeModulesQueueThread;
   }
 
+  public @Nullable MessageQueueThread getLowPriorityNativeModulesQueueThread() {
+    return mLowPriorityNativeModulesQueueThread;
+  }
+
   public MessageQueueThread getJSQueueThread() {
     return mJSQueueThread;
   }
 
+  /**
+   * Boosts the interactive threads, by default the JS and native modules threads, while the user
+   * interacts with the app, like during a touch or an animation, until the matching
+   * {@link #endInteraction()}. See {@link MessageQueueThread#beginInteraction()}.
+   */
+  public void beginInteraction() {
+    mJSQueueThread.beginInteraction();
+    mNativeModulesQueueThread.beginInteraction();
+    if (mLowPriorityNativeModulesQueueThread != null) {
+      mLowPriorityNativeModulesQueueThread.beginInteraction();
+    }
+  }
+
+  public void endInteraction() {
+    mJSQueueThread.endInteraction();
+    mNativeModulesQueueThread.endInteraction();
+    if (mLowPriorityNativeModulesQueueThread != null) {
+      mLowPriorityNativeModulesQueueThread.endInteraction();
+    }
+  }
+
   /**
    * Should be called when the corresponding {@link com.facebook.react.bridge.CatalystInstance}
    * is destroyed so that we shut down the proper queue threads.
@@ -59,6 +91,10 @@ public class CatalystQueueConfiguration {
     if (mNativeModulesQueueThread.getLooper() != Looper.getMainLooper()) {
       mNativeModulesQueueThread.quitSynchronous();
     }
+    if (mLowPriorityNativeModulesQueueThread != null &&
+        mLowPriorityNativeModulesQueueThread.getLooper() != Looper.getMainLooper()) {
+      mLowPriorityNativeModulesQueueThread.quitSynchronous();
+    }
     if (mJSQueueThread.getLooper() != Looper.getMainLooper()) {
       mJSQueueThread.quitSynchronous();
     }
@@ -85,6 +121,20 @@ public class CatalystQueueConfiguration {
           MessageQueueThread.create(spec.getNativeModulesQueueThreadSpec(), exceptionHandler);
     }
 
-    return new CatalystQueueConfiguration(uiThread, nativeModulesThread, jsThread);
+    MessageQueueThread lowPriorityNativeModulesThread = null;
+    MessageQueueThreadSpec lowPrioritySpec = spec.getLowPriorityNativeModulesQueueThreadSpec();
+    if (lowPrioritySpec != null) {
+      lowPriorityNativeModulesThread = specsToThreads.get(lowPrioritySpec);
+      if (lowPriorityNativeModulesThread == null) {
+        lowPriorityNativeModulesThread =
+            MessageQueueThread.create(lowPrioritySpec, exceptionHandler);
+      }
+    }
+
+    return new CatalystQueueConfiguration(
+        uiThread,
+        nativeModulesThread,
+        lowPriorityNativeModulesThread,
+        jsThread);
   }
 }
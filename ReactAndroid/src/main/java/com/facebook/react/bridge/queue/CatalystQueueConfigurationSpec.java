@@ -11,6 +11,8 @@ package com.facebook.react.bridge.queue;
 
 import javax.annotation.Nullable;
 
+import android.os.Process;
+
 import com.facebook.infer.annotation.Assertions;
 
 /**
@@ -22,12 +24,15 @@ import com.facebook.infer.annotation.Assertions;
 public class CatalystQueueConfigurationSpec {
 
   private final MessageQueueThreadSpec mNativeModulesQueueThreadSpec;
+  private final @Nullable MessageQueueThreadSpec mLowPriorityNativeModulesQueueThreadSpec;
   private final MessageQueueThreadSpec mJSQueueThreadSpec;
 
   private CatalystQueueConfigurationSpec(
       MessageQueueThreadSpec nativeModulesQueueThreadSpec,
+      @Nullable MessageQueueThreadSpec lowPriorityNativeModulesQueueThreadSpec,
       MessageQueueThreadSpec jsQueueThreadSpec) {
     mNativeModulesQueueThreadSpec = nativeModulesQueueThreadSpec;
+    mLowPriorityNativeModulesQueueThreadSpec = lowPriorityNativeModulesQueueThreadSpec;
     mJSQueueThreadSpec = jsQueueThreadSpec;
   }
 
@@ -35,6 +40,10 @@ public class CatalystQueueConfigurationSpec {
     return mNativeModulesQueueThreadSpec;
   }
 
+  public @Nullable MessageQueueThreadSpec getLowPriorityNativeModulesQueueThreadSpec() {
+    return mLowPriorityNativeModulesQueueThreadSpec;
+  }
+
   public MessageQueueThreadSpec getJSQueueThreadSpec() {
     return mJSQueueThreadSpec;
   }
@@ -43,17 +52,31 @@ public class CatalystQueueConfigurationSpec {
     return new Builder();
   }
 
+  /**
+   * The JS thread and the native modules thread, which also runs layout, are boosted during
+   * interactions, while low priority modules run below the default priority.
+   */
   public static CatalystQueueConfigurationSpec createDefault() {
     return builder()
-        .setJSQueueThreadSpec(MessageQueueThreadSpec.newBackgroundThreadSpec("js"))
+        .setJSQueueThreadSpec(
+            MessageQueueThreadSpec.newInteractiveThreadSpec(
+                "js",
+                Process.THREAD_PRIORITY_DEFAULT))
         .setNativeModulesQueueThreadSpec(
-            MessageQueueThreadSpec.newBackgroundThreadSpec("native_modules"))
+            MessageQueueThreadSpec.newInteractiveThreadSpec(
+                "native_modules",
+                Process.THREAD_PRIORITY_DEFAULT))
+        .setLowPriorityNativeModulesQueueThreadSpec(
+            MessageQueueThreadSpec.newBackgroundThreadSpec(
+                "native_modules_low_priority",
+                Process.THREAD_PRIORITY_BACKGROUND))
         .build();
   }
 
   public static class Builder {
 
     private @Nullable MessageQueueThreadSpec mNativeModulesQueueSpec;
+    private @Nullable MessageQueueThreadSpec mLowPriorityNativeModulesQueueSpec;
     private @Nullable MessageQueueThreadSpec mJSQueueSpec;
 
     public Builder setNativeModulesQueueThreadSpec(MessageQueueThreadSpec spec) {
@@ -64,6 +87,18 @@ public class CatalystQueueConfigurationSpec {
       return this;
     }
 
+    /**
+     * Optional. Without it {@link com.facebook.react.bridge.LowPriorityModule}s are invoked on
+     * the native modules queue thread like every other module.
+     */
+    public Builder setLowPriorityNativeModulesQueueThreadSpec(MessageQueueThreadSpec spec) {
+      Assertions.assertCondition(
+          mLowPriorityNativeModulesQueueSpec == null,
+          "Setting low priority native modules queue spec multiple times!");
+      mLowPriorityNativeModulesQueueSpec = spec;
+      return this;
+    }
+
     public Builder setJSQueueThreadSpec(MessageQueueThreadSpec spec) {
       Assertions.assertCondition(mJSQueueSpec == null, "Setting JS queue multiple times!");
       mJSQueueSpec = spec;
@@ -73,6 +108,7 @@ public class CatalystQueueConfigurationSpec {
     public CatalystQueueConfigurationSpec build() {
       return new CatalystQueueConfigurationSpec(
           Assertions.assertNotNull(mNativeModulesQueueSpec),
+          mLowPriorityNativeModulesQueueSpec,
           Assertions.assertNotNull(mJSQueueSpec));
     }
   }
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.bridge.queue;
+
+import com.facebook.proguard.annotations.DoNotStrip;
+import com.facebook.react.bridge.NativeRegistration;
+import com.facebook.soloader.SoLoader;
+
+/**
+ * Hints which cores a thread should run on. On big.LITTLE devices the scheduler is slow to
+ * migrate a thread that suddenly gets busy to a big core, so threads the user is waiting on are
+ * kept on the big cores while they interact with the app.
+ */
+@DoNotStrip
+/* package */ class CpuAffinity {
+
+  static {
+    SoLoader.loadLibrary("reactnativejni");
+    NativeRegistration.ensureRegistered(NativeRegistration.AFFINITY);
+  }
+
+  /**
+   * Restricts the thread to the cores with the highest maximum frequency, or lets it run on every
+   * core again. Returns false if the affinity wasn't changed, like on devices whose cores are all
+   * the same.
+   */
+  @DoNotStrip
+  public static native boolean setThreadPrefersFastCores(int tid, boolean prefersFastCores);
+}
@@ -10,6 +10,8 @@
 package com.facebook.react.bridge.queue;
 
 import android.os.Looper;
+import android.os.Process;
+import android.util.Pair;
 
 import com.facebook.common.logging.FLog;
 import com.facebook.proguard.annotations.DoNotStrip;
@@ -28,16 +30,26 @@ public class MessageQueueThread {
   private final Looper mLooper;
   private final MessageQueueThreadHandler mHandler;
   private final String mAssertionErrorMessage;
+  private final int mThreadId;
+  private final int mPriority;
+  private final boolean mInteractive;
   private volatile boolean mIsFinished = false;
+  private int mInteractionCount = 0;
 
   private MessageQueueThread(
       String name,
       Looper looper,
-      QueueThreadExceptionHandler exceptionHandler) {
+      QueueThreadExceptionHandler exceptionHandler,
+      int threadId,
+      int priority,
+      boolean interactive) {
     mName = name;
     mLooper = looper;
     mHandler = new MessageQueueThreadHandler(looper, exceptionHandler);
     mAssertionErrorMessage = "Expected to be called from the '" + getName() + "' thread!";
+    mThreadId = threadId;
+    mPriority = priority;
+    mInteractive = interactive;
   }
 
   /**
@@ -86,6 +98,55 @@ public class MessageQueueThread {
     }
   }
 
+  /**
+   * Raises an interactive thread to {@link MessageQueueThreadSpec#INTERACTION_THREAD_PRIORITY},
+   * and asks for it to run on the big cores of big.LITTLE devices, until the matching
+   * {@link #endInteraction()}. Interactions nest and can begin and end on any thread. Does nothing
+   * for threads that weren't created from {@link MessageQueueThreadSpec#newInteractiveThreadSpec}.
+   */
+  public void beginInteraction() {
+    if (!mInteractive) {
+      return;
+    }
+    synchronized (this) {
+      if (mInteractionCount++ == 0) {
+        applyInteraction(true);
+      }
+    }
+  }
+
+  public void endInteraction() {
+    if (!mInteractive) {
+      return;
+    }
+    synchronized (this) {
+      SoftAssertions.assertCondition(
+          mInteractionCount > 0,
+          "endInteraction() called without beginInteraction() on '" + getName() + "'");
+      if (mInteractionCount > 0 && --mInteractionCount == 0) {
+        applyInteraction(false);
+      }
+    }
+  }
+
+  private void applyInteraction(boolean interacting) {
+    // Once the thread is gone its id may already belong to another one
+    if (mIsFinished) {
+      return;
+    }
+    int priority = interacting ?
+        Math.min(mPriority, MessageQueueThreadSpec.INTERACTION_THREAD_PRIORITY) :
+        mPriority;
+    try {
+      Process.setThreadPriority(mThreadId, priority);
+    } catch (IllegalArgumentException e) {
+      FLog.w(ReactConstants.TAG, "Unable to set the priority of '" + getName() + "'", e);
+    } catch (SecurityException e) {
+      FLog.w(ReactConstants.TAG, "Unable to set the priority of '" + getName() + "'", e);
+    }
+    CpuAffinity.setThreadPrefersFastCores(mThreadId, interacting);
+  }
+
   public Looper getLooper() {
     return mLooper;
   }
@@ -101,7 +162,11 @@ public class MessageQueueThread {
       case MAIN_UI:
         return createForMainThread(spec.getName(), exceptionHandler);
       case NEW_BACKGROUND:
-        return startNewBackgroundThread(spec.getName(), exceptionHandler);
+        return startNewBackgroundThread(
+            spec.getName(),
+            spec.getPriority(),
+            spec.isInteractive(),
+            exceptionHandler);
       default:
         throw new RuntimeException("Unknown thread type: " + spec.getThreadType());
     }
@@ -114,31 +179,49 @@ public class MessageQueueThread {
       String name,
       QueueThreadExceptionHandler exceptionHandler) {
     Looper mainLooper = Looper.getMainLooper();
-    return new MessageQueueThread(name, mainLooper, exceptionHandler);
+    // The main thread's id is the process id
+    return new MessageQueueThread(
+        name,
+        mainLooper,
+        exceptionHandler,
+        Process.myPid(),
+        Process.THREAD_PRIORITY_DISPLAY,
+        false);
   }
 
   /**
    * Creates  and starts a new MessageQueueThread encapsulating a new Thread with a new Looper
-   * running on it. Give it a name for easier debugging. When this method exits, the new
-   * MessageQueueThread is ready to receive events.
+   * running on it at the given priority. Give it a name for easier debugging. When this method
+   * exits, the new MessageQueueThread is ready to receive events.
    */
   private static MessageQueueThread startNewBackgroundThread(
       String name,
+      final int priority,
+      boolean interactive,
       QueueThreadExceptionHandler exceptionHandler) {
-    final SimpleSettableFuture<Looper> simpleSettableFuture = new SimpleSettableFuture<>();
+    final SimpleSettableFuture<Pair<Looper, Integer>> simpleSettableFuture =
+        new SimpleSettableFuture<>();
     Thread bgThread = new Thread(
         new Runnable() {
           @Override
           public void run() {
+            Process.setThreadPriority(priority);
             Looper.prepare();
 
-            simpleSettableFuture.set(Looper.myLooper());
+            simpleSettableFuture.set(Pair.create(Looper.myLooper(), Process.myTid()));
 
             Looper.loop();
           }
         }, "mqt_" + name);
     bgThread.start();
 
-    return new MessageQueueThread(name, simpleSettableFuture.get(5000), exceptionHandler);
+    Pair<Looper, Integer> looperAndThreadId = simpleSettableFuture.get(5000);
+    return new MessageQueueThread(
+        name,
+        looperAndThreadId.first,
+        exceptionHandler,
+        looperAndThreadId.second,
+        priority,
+        interactive);
   }
 }
@@ -9,13 +9,25 @@
 
 package com.facebook.react.bridge.queue;
 
+import android.os.Process;
+
 /**
  * Spec for creating a MessageQueueThread.
  */
 public class MessageQueueThreadSpec {
 
-  private static final MessageQueueThreadSpec MAIN_UI_SPEC =
-      new MessageQueueThreadSpec(ThreadType.MAIN_UI, "main_ui");
+  // The system manages the priority of the main thread, this one isn't applied
+  private static final MessageQueueThreadSpec MAIN_UI_SPEC = new MessageQueueThreadSpec(
+      ThreadType.MAIN_UI,
+      "main_ui",
+      Process.THREAD_PRIORITY_DISPLAY,
+      false);
+
+  /**
+   * The priority interactive threads are raised to while the user interacts with the app, see
+   * {@link MessageQueueThread#beginInteraction()}.
+   */
+  public static final int INTERACTION_THREAD_PRIORITY = Process.THREAD_PRIORITY_DISPLAY;
 
   protected static enum ThreadType {
     MAIN_UI,
@@ -23,7 +35,24 @@ public class MessageQueueThreadSpec {
   }
 
   public static MessageQueueThreadSpec newBackgroundThreadSpec(String name) {
-    return new MessageQueueThreadSpec(ThreadType.NEW_BACKGROUND, name);
+    return newBackgroundThreadSpec(name, Process.THREAD_PRIORITY_DEFAULT);
+  }
+
+  /**
+   * @param priority a Linux thread priority, from {@link Process#THREAD_PRIORITY_URGENT_DISPLAY}
+   *   to {@link Process#THREAD_PRIORITY_LOWEST}
+   */
+  public static MessageQueueThreadSpec newBackgroundThreadSpec(String name, int priority) {
+    return new MessageQueueThreadSpec(ThreadType.NEW_BACKGROUND, name, priority, false);
+  }
+
+  /**
+   * Like {@link #newBackgroundThreadSpec(String, int)}, but during interactions the thread is
+   * raised to {@link #INTERACTION_THREAD_PRIORITY} and kept on the big cores of big.LITTLE
+   * devices.
+   */
+  public static MessageQueueThreadSpec newInteractiveThreadSpec(String name, int priority) {
+    return new MessageQueueThreadSpec(ThreadType.NEW_BACKGROUND, name, priority, true);
   }
 
   public static MessageQueueThreadSpec mainThreadSpec() {
@@ -32,10 +61,18 @@ public class MessageQueueThreadSpec {
 
   private final ThreadType mThreadType;
   private final String mName;
+  private final int mPriority;
+  private final boolean mInteractive;
 
-  private MessageQueueThreadSpec(ThreadType threadType, String name) {
+  private MessageQueueThreadSpec(
+      ThreadType threadType,
+      String name,
+      int priority,
+      boolean interactive) {
     mThreadType = threadType;
     mName = name;
+    mPriority = priority;
+    mInteractive = interactive;
   }
 
   public ThreadType getThreadType() {
@@ -45,4 +82,12 @@ public class MessageQueueThreadSpec {
   public String getName() {
     return mName;
   }
+
+  public int getPriority() {
+    return mPriority;
+  }
+
+  public boolean isInteractive() {
+    return mInteractive;
+  }
 }
@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.devsupport;
+
+import android.widget.FrameLayout;
+import android.widget.TextView;
+
+import com.facebook.react.R;
+import com.facebook.react.bridge.BridgeTrafficStats;
+import com.facebook.react.bridge.ReactContext;
+
+/**
+ * View that shows the native methods JS spent the most time in, from the
+ * {@link BridgeTrafficStats} of the current instance. Stats are recorded while it is attached.
+ */
+public class BridgeTrafficView extends FrameLayout {
+
+  private static final int UPDATE_INTERVAL_MS = 1000;
+  private static final int MAX_CALLS_SHOWN = 5;
+
+  private final TextView mTextView;
+  private final BridgeTrafficStats mStats;
+  private final Runnable mUpdateRunnable = new Runnable() {
+    @Override
+    public void run() {
+      mTextView.setText(mStats.summarize(MAX_CALLS_SHOWN));
+      postDelayed(this, UPDATE_INTERVAL_MS);
+    }
+  };
+
+  public BridgeTrafficView(ReactContext reactContext) {
+    super(reactContext);
+    inflate(reactContext, R.layout.bridge_traffic_view, this);
+    mTextView = (TextView) findViewById(R.id.bridge_traffic_text);
+    mStats = reactContext.getCatalystInstance().getBridgeTrafficStats();
+  }
+
+  @Override
+  protected void onAttachedToWindow() {
+    super.onAttachedToWindow();
+    mStats.setRecording(true);
+    post(mUpdateRunnable);
+  }
+
+  @Override
+  protected void onDetachedFromWindow() {
+    super.onDetachedFromWindow();
+    removeCallbacks(mUpdateRunnable);
+    mStats.setRecording(false);
+  }
+}
@@ -19,8 +19,8 @@ import android.widget.FrameLayout;
 import com.facebook.react.bridge.ReactContext;
 
 /**
- * Helper class for controlling overlay view with FPS and JS FPS info
- * that gets added directly to @{link WindowManager} instance.
+ * Helper class for controlling overlay views with FPS and JS FPS info, and with bridge traffic,
+ * that get added directly to @{link WindowManager} instance.
  */
 /* package */ class DebugOverlayController {
 
@@ -28,6 +28,7 @@ import com.facebook.react.bridge.ReactContext;
   private final ReactContext mReactContext;
 
   private @Nullable FrameLayout mFPSDebugViewContainer;
+  private @Nullable FrameLayout mBridgeTrafficViewContainer;
 
   public DebugOverlayController(ReactContext reactContext) {
     mReactContext = reactContext;
@@ -51,4 +52,22 @@ import com.facebook.react.bridge.ReactContext;
       mFPSDebugViewContainer = null;
     }
   }
+
+  public void setBridgeTrafficViewVisible(boolean bridgeTrafficViewVisible) {
+    if (bridgeTrafficViewVisible && mBridgeTrafficViewContainer == null) {
+      mBridgeTrafficViewContainer = new BridgeTrafficView(mReactContext);
+      WindowManager.LayoutParams params = new WindowManager.LayoutParams(
+          WindowManager.LayoutParams.MATCH_PARENT,
+          WindowManager.LayoutParams.MATCH_PARENT,
+          WindowManager.LayoutParams.TYPE_SYSTEM_OVERLAY,
+          WindowManager.LayoutParams.FLAG_NOT_FOCUSABLE
+              | WindowManager.LayoutParams.FLAG_NOT_TOUCHABLE,
+          PixelFormat.TRANSLUCENT);
+      mWindowManager.addView(mBridgeTrafficViewContainer, params);
+    } else if (!bridgeTrafficViewVisible && mBridgeTrafficViewContainer != null) {
+      mBridgeTrafficViewContainer.removeAllViews();
+      mWindowManager.removeView(mBridgeTrafficViewContainer);
+      mBridgeTrafficViewContainer = null;
+    }
+  }
 }
@@ -48,6 +48,18 @@ import okio.Sink;
 
   public static final String RELOAD_APP_EXTRA_JS_PROXY = "jsproxy";
   private static final String RELOAD_APP_ACTION_SUFFIX = ".RELOAD_APP_ACTION";
+  public static final String SAMPLING_PROFILER_EXTRA_INTERVAL_US = "intervalUs";
+  public static final String SAMPLING_PROFILER_EXTRA_MAX_SAMPLES = "maxSamples";
+  public static final String SAMPLING_PROFILER_EXTRA_PATH = "path";
+  private static final String START_SAMPLING_PROFILER_ACTION_SUFFIX =
+      ".START_SAMPLING_PROFILER_ACTION";
+  private static final String STOP_SAMPLING_PROFILER_ACTION_SUFFIX =
+      ".STOP_SAMPLING_PROFILER_ACTION";
+  public static final String BRIDGE_RECORDING_EXTRA_PATH = "path";
+  private static final String START_BRIDGE_RECORDING_ACTION_SUFFIX =
+      ".START_BRIDGE_RECORDING_ACTION";
+  private static final String STOP_BRIDGE_RECORDING_ACTION_SUFFIX =
+      ".STOP_BRIDGE_RECORDING_ACTION";
 
   private static final String EMULATOR_LOCALHOST = "10.0.2.2";
   private static final String GENYMOTION_LOCALHOST = "10.0.3.2";
@@ -99,6 +111,30 @@ import okio.Sink;
     return context.getPackageName() + RELOAD_APP_ACTION_SUFFIX;
   }
 
+  /**
+   * Lets the sampling profiler be driven from a shell, e.g.
+   * {@code adb shell am broadcast -a <package>.START_SAMPLING_PROFILER_ACTION --ei intervalUs 2000}
+   */
+  public static String getStartSamplingProfilerAction(Context context) {
+    return context.getPackageName() + START_SAMPLING_PROFILER_ACTION_SUFFIX;
+  }
+
+  public static String getStopSamplingProfilerAction(Context context) {
+    return context.getPackageName() + STOP_SAMPLING_PROFILER_ACTION_SUFFIX;
+  }
+
+  /**
+   * Records the bridge traffic of a session for replay benchmarks, e.g.
+   * {@code adb shell am broadcast -a <package>.START_BRIDGE_RECORDING_ACTION --es path <file>}
+   */
+  public static String getStartBridgeRecordingAction(Context context) {
+    return context.getPackageName() + START_BRIDGE_RECORDING_ACTION_SUFFIX;
+  }
+
+  public static String getStopBridgeRecordingAction(Context context) {
+    return context.getPackageName() + STOP_BRIDGE_RECORDING_ACTION_SUFFIX;
+  }
+
   public String getWebsocketProxyURL() {
     return String.format(Locale.US, WEBSOCKET_PROXY_URL_FORMAT, getDebugServerHost());
   }
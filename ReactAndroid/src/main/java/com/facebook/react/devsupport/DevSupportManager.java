@@ -36,6 +36,7 @@ import com.facebook.react.R;
 import com.facebook.react.bridge.CatalystInstance;
 import com.facebook.react.bridge.NativeModuleCallExceptionHandler;
 import com.facebook.react.bridge.ProxyJavaScriptExecutor;
+import com.facebook.react.bridge.ReactBridge;
 import com.facebook.react.bridge.ReactContext;
 import com.facebook.react.bridge.ReadableArray;
 import com.facebook.react.bridge.UiThreadUtil;
@@ -98,6 +99,7 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
   private boolean mIsShakeDetectorStarted = false;
   private boolean mIsDevSupportEnabled = false;
   private boolean mIsCurrentlyProfiling = false;
+  private boolean mIsShowingBridgeTraffic = false;
   private int     mProfileIndex = 0;
 
   public DevSupportManager(
@@ -132,6 +134,18 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
             mIsUsingJSProxy = false;
           }
           handleReloadJS();
+        } else if (DevServerHelper.getStartSamplingProfilerAction(context).equals(action)) {
+          startSamplingProfiler(
+              intent.getIntExtra(DevServerHelper.SAMPLING_PROFILER_EXTRA_INTERVAL_US, 0),
+              intent.getIntExtra(DevServerHelper.SAMPLING_PROFILER_EXTRA_MAX_SAMPLES, 0));
+        } else if (DevServerHelper.getStopSamplingProfilerAction(context).equals(action)) {
+          stopSamplingProfiler(
+              intent.getStringExtra(DevServerHelper.SAMPLING_PROFILER_EXTRA_PATH));
+        } else if (DevServerHelper.getStartBridgeRecordingAction(context).equals(action)) {
+          startBridgeRecording(
+              intent.getStringExtra(DevServerHelper.BRIDGE_RECORDING_EXTRA_PATH));
+        } else if (DevServerHelper.getStopBridgeRecordingAction(context).equals(action)) {
+          stopBridgeRecording();
         }
       }
     };
@@ -267,6 +281,19 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
             mReactInstanceCommandsHandler.toggleElementInspector();
           }
         });
+    options.put(
+        mApplicationContext.getString(
+            mIsShowingBridgeTraffic ? R.string.catalyst_hide_bridge_traffic :
+                R.string.catalyst_show_bridge_traffic),
+        new DevOptionHandler() {
+          @Override
+          public void onOptionSelected() {
+            mIsShowingBridgeTraffic = !mIsShowingBridgeTraffic;
+            if (mDebugOverlayController != null) {
+              mDebugOverlayController.setBridgeTrafficViewVisible(mIsShowingBridgeTraffic);
+            }
+          }
+        });
 
     if (mCurrentContext != null &&
       mCurrentContext.getCatalystInstance() != null &&
@@ -423,6 +450,59 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
     return false;
   }
 
+  private @Nullable ReactBridge getSamplingProfilerBridge() {
+    if (mCurrentContext == null || !mCurrentContext.hasActiveCatalystInstance()) {
+      return null;
+    }
+    ReactBridge bridge = mCurrentContext.getCatalystInstance().getBridge();
+    return bridge.supportsSamplingProfiler() ? bridge : null;
+  }
+
+  private void startSamplingProfiler(int intervalUs, int maxSamples) {
+    ReactBridge bridge = getSamplingProfilerBridge();
+    if (bridge == null) {
+      FLog.w(ReactConstants.TAG, "Sampling profiler is not available");
+      return;
+    }
+    bridge.startSamplingProfiler(intervalUs, maxSamples);
+  }
+
+  private void stopSamplingProfiler(@Nullable String path) {
+    ReactBridge bridge = getSamplingProfilerBridge();
+    if (bridge == null) {
+      FLog.w(ReactConstants.TAG, "Sampling profiler is not available");
+      return;
+    }
+    if (path == null) {
+      path = Environment.getExternalStorageDirectory().getPath() +
+          "/sampling_profile_" + mProfileIndex + ".json";
+      mProfileIndex++;
+    }
+    bridge.stopSamplingProfiler(path);
+    FLog.i(ReactConstants.TAG, "Sampling profile output to " + path);
+  }
+
+  private void startBridgeRecording(@Nullable String path) {
+    if (mCurrentContext == null || !mCurrentContext.hasActiveCatalystInstance()) {
+      FLog.w(ReactConstants.TAG, "Bridge recording is not available");
+      return;
+    }
+    if (path == null) {
+      path = Environment.getExternalStorageDirectory().getPath() +
+          "/bridge_recording_" + mProfileIndex + ".jsonl";
+      mProfileIndex++;
+    }
+    mCurrentContext.getCatalystInstance().getBridge().startRecording(path);
+    FLog.i(ReactConstants.TAG, "Recording bridge traffic to " + path);
+  }
+
+  private void stopBridgeRecording() {
+    if (mCurrentContext == null || !mCurrentContext.hasActiveCatalystInstance()) {
+      return;
+    }
+    mCurrentContext.getCatalystInstance().getBridge().stopRecording();
+  }
+
   private void resetCurrentContext(@Nullable ReactContext reactContext) {
     if (mCurrentContext == reactContext) {
       // new context is the same as the old one - do nothing
@@ -443,9 +523,11 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
     // Recreate debug overlay controller with new CatalystInstance object
     if (mDebugOverlayController != null) {
       mDebugOverlayController.setFpsDebugViewVisible(false);
+      mDebugOverlayController.setBridgeTrafficViewVisible(false);
     }
     if (reactContext != null) {
       mDebugOverlayController = new DebugOverlayController(reactContext);
+      mDebugOverlayController.setBridgeTrafficViewVisible(mIsShowingBridgeTraffic);
     }
 
     reloadSettings();
@@ -580,6 +662,10 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
       if (!mIsReceiverRegistered) {
         IntentFilter filter = new IntentFilter();
         filter.addAction(DevServerHelper.getReloadAppAction(mApplicationContext));
+        filter.addAction(DevServerHelper.getStartSamplingProfilerAction(mApplicationContext));
+        filter.addAction(DevServerHelper.getStopSamplingProfilerAction(mApplicationContext));
+        filter.addAction(DevServerHelper.getStartBridgeRecordingAction(mApplicationContext));
+        filter.addAction(DevServerHelper.getStopBridgeRecordingAction(mApplicationContext));
         mApplicationContext.registerReceiver(mReloadAppBroadcastReceiver, filter);
         mIsReceiverRegistered = true;
       }
@@ -596,10 +682,12 @@ public class DevSupportManager implements NativeModuleCallExceptionHandler {
         mDevServerHelper.stopPollingOnChangeEndpoint();
       }
     } else {
-      // hide FPS debug overlay
+      // hide FPS and bridge traffic debug overlays
       if (mDebugOverlayController != null) {
         mDebugOverlayController.setFpsDebugViewVisible(false);
+        mDebugOverlayController.setBridgeTrafficViewVisible(false);
       }
+      mIsShowingBridgeTraffic = false;
 
       // stop shake gesture detector
       if (mIsShakeDetectorStarted) {
@@ -25,6 +25,7 @@ import com.facebook.react.bridge.ReactContextBaseJavaModule;
 import com.facebook.react.bridge.ReactMethod;
 import com.facebook.react.bridge.LifecycleEventListener;
 import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.queue.CatalystQueueConfiguration;
 import com.facebook.react.uimanager.ReactChoreographer;
 import com.facebook.react.common.SystemClock;
 import com.facebook.infer.annotation.Assertions;
@@ -62,6 +63,7 @@ public final class Timing extends ReactContextBaseJavaModule implements Lifecycl
 
       long frameTimeMillis = frameTimeNanos / 1000000;
       WritableArray timersToCall = null;
+      boolean animating;
       synchronized (mTimerGuard) {
         while (!mTimers.isEmpty() && mTimers.peek().mTargetTime < frameTimeMillis) {
           Timer timer = mTimers.poll();
@@ -76,7 +78,11 @@ public final class Timing extends ReactContextBaseJavaModule implements Lifecycl
             mTimerIdsToTimers.remove(timer.mCallbackID);
           }
         }
+        // Timers due every frame are most likely driving an animation
+        animating = timersToCall != null || (!mTimers.isEmpty() &&
+            mTimers.peek().mTargetTime < frameTimeMillis + FRAME_RATE_TIMER_THRESHOLD_MS);
       }
+      setAnimating(animating);
 
       if (timersToCall != null) {
         Assertions.assertNotNull(mJSTimersModule).callTimers(timersToCall);
@@ -86,6 +92,12 @@ public final class Timing extends ReactContextBaseJavaModule implements Lifecycl
     }
   }
 
+  /**
+   * Timers due within this many ms of a frame count as part of an animation, which boosts the
+   * bridge threads. The same threshold as on iOS.
+   */
+  private static final long FRAME_RATE_TIMER_THRESHOLD_MS = 1000 / 30;
+
   private final Object mTimerGuard = new Object();
   private final PriorityQueue<Timer> mTimers;
   private final SparseArray<Timer> mTimerIdsToTimers;
@@ -94,6 +106,7 @@ public final class Timing extends ReactContextBaseJavaModule implements Lifecycl
   private final FrameCallback mFrameCallback = new FrameCallback();
   private @Nullable JSTimersExecution mJSTimersModule;
   private boolean mFrameCallbackPosted = false;
+  private boolean mAnimating = false;
 
   public Timing(ReactApplicationContext reactContext) {
     super(reactContext);
@@ -165,6 +178,21 @@ public final class Timing extends ReactContextBaseJavaModule implements Lifecycl
           mFrameCallback);
       mFrameCallbackPosted = false;
     }
+    setAnimating(false);
+  }
+
+  private void setAnimating(boolean animating) {
+    if (mAnimating == animating) {
+      return;
+    }
+    mAnimating = animating;
+    CatalystQueueConfiguration queueConfiguration =
+        getReactApplicationContext().getCatalystInstance().getCatalystQueueConfiguration();
+    if (animating) {
+      queueConfiguration.beginInteraction();
+    } else {
+      queueConfiguration.endInteraction();
+    }
   }
 
   @Override
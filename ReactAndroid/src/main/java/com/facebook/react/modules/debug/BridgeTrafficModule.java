@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.modules.debug;
+
+import com.facebook.react.bridge.BridgeTrafficStats;
+import com.facebook.react.bridge.Callback;
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+
+/**
+ * Exposes the {@link BridgeTrafficStats} of the current instance to JS as `BridgeTraffic`, so that
+ * the per module call counts can be sent as telemetry. Matches the iOS module of the same name.
+ */
+public class BridgeTrafficModule extends ReactContextBaseJavaModule {
+
+  public BridgeTrafficModule(ReactApplicationContext reactContext) {
+    super(reactContext);
+  }
+
+  @Override
+  public String getName() {
+    return "BridgeTraffic";
+  }
+
+  private BridgeTrafficStats trafficStats() {
+    return getReactApplicationContext().getCatalystInstance().getBridgeTrafficStats();
+  }
+
+  @ReactMethod
+  public void startRecording() {
+    trafficStats().setRecording(true);
+  }
+
+  @ReactMethod
+  public void stopRecording() {
+    trafficStats().setRecording(false);
+  }
+
+  @ReactMethod
+  public void getStats(Callback callback) {
+    callback.invoke(trafficStats().toWritableMap());
+  }
+
+  @ReactMethod
+  public void resetStats() {
+    trafficStats().reset();
+  }
+}
@@ -16,6 +16,7 @@ import java.io.InputStream;
 
 import com.facebook.react.bridge.Callback;
 import com.facebook.react.bridge.GuardedAsyncTask;
+import com.facebook.react.bridge.LowPriorityModule;
 import com.facebook.react.bridge.ReactApplicationContext;
 import com.facebook.react.bridge.ReactContextBaseJavaModule;
 import com.facebook.react.bridge.ReactMethod;
@@ -32,9 +33,11 @@ import com.squareup.okhttp.RequestBody;
 import com.squareup.okhttp.Response;
 
 /**
- * Implements the XMLHttpRequest JavaScript interface.
+ * Implements the XMLHttpRequest JavaScript interface. Low priority because requests, gzipped
+ * bodies included, are built on the thread the module is called on.
  */
-public final class NetworkingModule extends ReactContextBaseJavaModule {
+public final class NetworkingModule extends ReactContextBaseJavaModule
+    implements LowPriorityModule {
 
   private static final String CONTENT_ENCODING_HEADER_NAME = "content-encoding";
   private static final String CONTENT_TYPE_HEADER_NAME = "content-type";
@@ -22,6 +22,7 @@ import com.facebook.infer.annotation.Assertions;
 import com.facebook.react.bridge.Arguments;
 import com.facebook.react.bridge.Callback;
 import com.facebook.react.bridge.GuardedAsyncTask;
+import com.facebook.react.bridge.LowPriorityModule;
 import com.facebook.react.bridge.ReactApplicationContext;
 import com.facebook.react.bridge.ReactContextBaseJavaModule;
 import com.facebook.react.bridge.ReactMethod;
@@ -36,7 +37,8 @@ import static com.facebook.react.modules.storage.CatalystSQLiteOpenHelper.TABLE_
 import static com.facebook.react.modules.storage.CatalystSQLiteOpenHelper.VALUE_COLUMN;
 
 public final class AsyncStorageModule
-    extends ReactContextBaseJavaModule implements ModuleDataCleaner.Cleanable {
+    extends ReactContextBaseJavaModule
+    implements ModuleDataCleaner.Cleanable, LowPriorityModule {
 
   private @Nullable SQLiteDatabase mDb;
   private boolean mShuttingDown = false;
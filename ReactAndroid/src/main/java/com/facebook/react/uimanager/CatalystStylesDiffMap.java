@@ -15,6 +15,7 @@ import android.view.View;
 
 import com.facebook.react.bridge.ReadableArray;
 import com.facebook.react.bridge.ReadableMap;
+import com.facebook.react.bridge.ReadableNativeMap;
 
 /**
  * Wrapper for {@link ReadableMap} which should be used for styles property map. It extends
@@ -39,7 +40,11 @@ public class CatalystStylesDiffMap {
   /* package */ final ReadableMap mBackingMap;
 
   public CatalystStylesDiffMap(ReadableMap props) {
-    mBackingMap = props;
+    // Applicators probe for dozens of keys that are mostly absent, which would be a call into
+    // native code each, so copy native maps into Java first in a single call
+    mBackingMap = props instanceof ReadableNativeMap ?
+        ((ReadableNativeMap) props).toReadableBufferMap() :
+        props;
   }
 
   public boolean hasKey(String name) {
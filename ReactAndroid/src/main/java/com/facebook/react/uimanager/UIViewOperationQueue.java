@@ -13,6 +13,7 @@ import javax.annotation.Nullable;
 import javax.annotation.concurrent.GuardedBy;
 
 import java.util.ArrayList;
+import java.util.List;
 
 import com.facebook.react.animation.Animation;
 import com.facebook.react.animation.AnimationRegistry;
@@ -20,6 +21,7 @@ import com.facebook.react.bridge.Callback;
 import com.facebook.react.bridge.ReactContext;
 import com.facebook.react.bridge.ReactApplicationContext;
 import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.uimanager.events.InputLatencyTracker;
 import com.facebook.systrace.Systrace;
 import com.facebook.systrace.SystraceMessage;
 
@@ -560,6 +562,10 @@ public class UIViewOperationQueue {
 
     mUIManagerModule.notifyOnViewHierarchyUpdateEnqueued();
 
+    final InputLatencyTracker inputLatencyTracker =
+        mUIManagerModule.getEventDispatcher().getInputLatencyTracker();
+    final List<InputLatencyTracker.Flow> inputFlows = inputLatencyTracker.takeFlowsSentToJS();
+
     synchronized (mDispatchRunnablesLock) {
       mDispatchUIRunnables.add(
           new Runnable() {
@@ -575,6 +581,7 @@ public class UIViewOperationQueue {
                    }
                  }
                  mUIManagerModule.notifyOnViewHierarchyUpdateFinished();
+                 inputLatencyTracker.endFlows(inputFlows);
                } finally {
                  Systrace.endSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE);
                }
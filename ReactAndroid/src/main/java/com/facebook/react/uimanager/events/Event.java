@@ -9,6 +9,8 @@
 
 package com.facebook.react.uimanager.events;
 
+import javax.annotation.Nullable;
+
 /**
  * A UI event that can be dispatched to JS.
  */
@@ -17,6 +19,9 @@ public abstract class Event<T extends Event> {
   private final int mViewTag;
   private final long mTimestampMs;
 
+  // Set by the EventDispatcher while input latency is being traced
+  /* package */ @Nullable InputLatencyTracker.Flow mInputFlow;
+
   protected Event(int viewTag, long timestampMs) {
     mViewTag = viewTag;
     mTimestampMs = timestampMs;
@@ -21,6 +21,7 @@ import android.util.LongSparseArray;
 import android.view.Choreographer;
 
 import com.facebook.infer.annotation.Assertions;
+import com.facebook.react.bridge.BridgeTrafficStats;
 import com.facebook.react.bridge.LifecycleEventListener;
 import com.facebook.react.bridge.ReactApplicationContext;
 import com.facebook.react.bridge.UiThreadUtil;
@@ -100,6 +101,7 @@ public class EventDispatcher implements LifecycleEventListener {
   private volatile @Nullable ScheduleDispatchFrameCallback mCurrentFrameCallback;
   private short mNextEventTypeId = 0;
   private volatile boolean mHasDispatchScheduled = false;
+  private final InputLatencyTracker mInputLatencyTracker = new InputLatencyTracker();
 
   public EventDispatcher(ReactApplicationContext reactContext) {
     mReactContext = reactContext;
@@ -110,11 +112,16 @@ public class EventDispatcher implements LifecycleEventListener {
    * Sends the given Event to JS, coalescing eligible events if JS is backed up.
    */
   public void dispatchEvent(Event event) {
+    mInputLatencyTracker.beginFlow(event);
     synchronized (mEventsStagingLock) {
       mEventStaging.add(event);
     }
   }
 
+  public InputLatencyTracker getInputLatencyTracker() {
+    return mInputLatencyTracker;
+  }
+
   @Override
   public void onHostResume() {
     UiThreadUtil.assertOnUiThread();
@@ -183,6 +190,9 @@ public class EventDispatcher implements LifecycleEventListener {
           } else {
             Event lastEvent = mEventsToDispatch[lastEventIdx];
             Event coalescedEvent = event.coalesce(lastEvent);
+            mInputLatencyTracker.coalesceFlows(
+                coalescedEvent,
+                coalescedEvent == lastEvent ? event : lastEvent);
             if (coalescedEvent != lastEvent) {
               eventToAdd = coalescedEvent;
               mEventCookieToLastEventIdx.put(eventCookie, mEventsToDispatchSize);
@@ -270,12 +280,19 @@ public class EventDispatcher implements LifecycleEventListener {
           if (mEventsToDispatchSize > 1) {
             Arrays.sort(mEventsToDispatch, 0, mEventsToDispatchSize, EVENT_COMPARATOR);
           }
+          BridgeTrafficStats trafficStats =
+              mReactContext.getCatalystInstance().getBridgeTrafficStats();
+          boolean recordTraffic = trafficStats.isRecording();
           for (int eventIdx = 0; eventIdx < mEventsToDispatchSize; eventIdx++) {
             Event event = mEventsToDispatch[eventIdx];
             // Event can be null if it has been coalesced into another event.
             if (event == null) {
               continue;
             }
+            if (recordTraffic) {
+              trafficStats.recordEvent(event.getEventName());
+            }
+            mInputLatencyTracker.onEventSentToJS(event);
             event.dispatch(mRCTEventEmitter);
             event.dispose();
           }
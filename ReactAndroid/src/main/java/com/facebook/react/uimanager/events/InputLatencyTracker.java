@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+package com.facebook.react.uimanager.events;
+
+import javax.annotation.Nullable;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import android.os.SystemClock;
+
+import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.systrace.Systrace;
+
+/**
+ * Follows input events from the {@link EventDispatcher} through JS and the UI manager batch JS
+ * sends back, until the view updates of that batch have run on the UI thread, just before the
+ * frame that shows them is drawn. While tracing, each event is a systrace flow linking the threads
+ * it passes through, and while recording its latency is added to a histogram per event name, in
+ * the same shape as `InputLatency` on iOS. Updates that JS defers to a later batch aren't
+ * accounted for.
+ */
+public class InputLatencyTracker {
+
+  private static final String FLOW_NAME = "InputEvent";
+
+  /**
+   * Upper bounds, in ms, of the histogram buckets. The last bucket holds every longer latency.
+   */
+  public static final long[] BUCKET_BOUNDS_MS = {33, 50, 100, 200, 500};
+
+  /**
+   * One input event on its way to the screen. Times are in the
+   * {@link SystemClock#uptimeMillis} base, like event timestamps.
+   */
+  public static final class Flow {
+    private final int mId;
+    private final String mEventName;
+    private final long mStartMs;
+    private long mSentToJSMs;
+    private long mBatchDispatchedMs;
+
+    private Flow(int id, String eventName, long startMs) {
+      mId = id;
+      mEventName = eventName;
+      mStartMs = startMs;
+    }
+  }
+
+  public static class EventStats {
+    public final String eventName;
+    public int count;
+    public final int[] histogram = new int[BUCKET_BOUNDS_MS.length + 1];
+    public long totalLatencyMs;
+    public long maxLatencyMs;
+    public long toJSMs;
+    public long jsMs;
+    public long commitMs;
+
+    private EventStats(String eventName) {
+      this.eventName = eventName;
+    }
+
+    private EventStats copy() {
+      EventStats copy = new EventStats(eventName);
+      copy.count = count;
+      System.arraycopy(histogram, 0, copy.histogram, 0, histogram.length);
+      copy.totalLatencyMs = totalLatencyMs;
+      copy.maxLatencyMs = maxLatencyMs;
+      copy.toJSMs = toJSMs;
+      copy.jsMs = jsMs;
+      copy.commitMs = commitMs;
+      return copy;
+    }
+  }
+
+  private final AtomicInteger mNextFlowId = new AtomicInteger();
+  private volatile boolean mRecording = false;
+
+  // Flows whose events have been sent to JS, until JS sends back a batch
+  private final ArrayList<Flow> mFlowsSentToJS = new ArrayList<>();
+
+  // Guarded by this
+  private final HashMap<String, EventStats> mEvents = new HashMap<>();
+
+  public boolean isRecording() {
+    return mRecording;
+  }
+
+  public void setRecording(boolean recording) {
+    mRecording = recording;
+  }
+
+  public boolean isTracing() {
+    return mRecording || Systrace.isTracing(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE);
+  }
+
+  /**
+   * Starts the flow of an event, as it is handed to the {@link EventDispatcher}.
+   */
+  /* package */ void beginFlow(Event event) {
+    if (!isTracing()) {
+      return;
+    }
+    Flow flow = new Flow(
+        mNextFlowId.incrementAndGet(),
+        event.getEventName(),
+        event.getTimestampMs());
+    Systrace.startAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, flow.mId);
+    event.mInputFlow = flow;
+  }
+
+  /**
+   * Called when two events are coalesced into the one that is kept. A coalesced event is as late
+   * as the oldest input it includes, so it keeps the oldest flow and the other one is dropped.
+   */
+  /* package */ void coalesceFlows(Event keptEvent, Event droppedEvent) {
+    Flow keptFlow = keptEvent.mInputFlow;
+    Flow droppedFlow = droppedEvent.mInputFlow;
+    droppedEvent.mInputFlow = null;
+    if (droppedFlow == null) {
+      return;
+    }
+    if (keptFlow != null && keptFlow.mStartMs <= droppedFlow.mStartMs) {
+      Systrace.endAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, droppedFlow.mId);
+      return;
+    }
+    if (keptFlow != null) {
+      Systrace.endAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, keptFlow.mId);
+    }
+    keptEvent.mInputFlow = droppedFlow;
+  }
+
+  /**
+   * Called on the JS thread as the event is sent to JS.
+   */
+  /* package */ void onEventSentToJS(Event event) {
+    Flow flow = event.mInputFlow;
+    if (flow == null) {
+      return;
+    }
+    event.mInputFlow = null;
+    flow.mSentToJSMs = SystemClock.uptimeMillis();
+    Systrace.stepAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, flow.mId);
+    synchronized (mFlowsSentToJS) {
+      mFlowsSentToJS.add(flow);
+    }
+  }
+
+  /**
+   * Called when the UI manager dispatches the view updates of a batch from JS, which are the
+   * result of every event sent to JS before. Returns null if there are no flows.
+   */
+  public @Nullable List<Flow> takeFlowsSentToJS() {
+    ArrayList<Flow> flows;
+    synchronized (mFlowsSentToJS) {
+      if (mFlowsSentToJS.isEmpty()) {
+        return null;
+      }
+      flows = new ArrayList<>(mFlowsSentToJS);
+      mFlowsSentToJS.clear();
+    }
+    long now = SystemClock.uptimeMillis();
+    for (int i = 0; i < flows.size(); i++) {
+      Flow flow = flows.get(i);
+      flow.mBatchDispatchedMs = now;
+      Systrace.stepAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, flow.mId);
+    }
+    return flows;
+  }
+
+  /**
+   * Called on the UI thread once the view updates the flows resulted in have been applied.
+   */
+  public void endFlows(@Nullable List<Flow> flows) {
+    if (flows == null) {
+      return;
+    }
+    long now = SystemClock.uptimeMillis();
+    for (int i = 0; i < flows.size(); i++) {
+      Flow flow = flows.get(i);
+      Systrace.endAsyncFlow(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE, FLOW_NAME, flow.mId);
+      if (mRecording) {
+        record(flow, now);
+      }
+    }
+  }
+
+  private synchronized void record(Flow flow, long endMs) {
+    EventStats stats = mEvents.get(flow.mEventName);
+    if (stats == null) {
+      stats = new EventStats(flow.mEventName);
+      mEvents.put(flow.mEventName, stats);
+    }
+
+    long latencyMs = Math.max(0, endMs - flow.mStartMs);
+    int bucket = 0;
+    while (bucket < BUCKET_BOUNDS_MS.length && latencyMs > BUCKET_BOUNDS_MS[bucket]) {
+      bucket++;
+    }
+    stats.histogram[bucket]++;
+    stats.count++;
+    stats.totalLatencyMs += latencyMs;
+    stats.maxLatencyMs = Math.max(stats.maxLatencyMs, latencyMs);
+    stats.toJSMs += Math.max(0, flow.mSentToJSMs - flow.mStartMs);
+    stats.jsMs += Math.max(0, flow.mBatchDispatchedMs - flow.mSentToJSMs);
+    stats.commitMs += Math.max(0, endMs - flow.mBatchDispatchedMs);
+  }
+
+  public synchronized void reset() {
+    mEvents.clear();
+  }
+
+  public synchronized List<EventStats> getEventStats() {
+    ArrayList<EventStats> events = new ArrayList<>();
+    for (EventStats stats : mEvents.values()) {
+      events.add(stats.copy());
+    }
+    return events;
+  }
+
+  /**
+   * The stats in the same shape as on iOS: "events" maps event names to {count, histogram,
+   * meanLatency, maxLatency, toJS, js, commit}, with times in ms, and "bucketBounds" lists the
+   * upper bounds of the histogram buckets.
+   */
+  public WritableMap toWritableMap() {
+    WritableMap events = Arguments.createMap();
+    for (EventStats stats : getEventStats()) {
+      WritableArray histogram = Arguments.createArray();
+      for (int count : stats.histogram) {
+        histogram.pushInt(count);
+      }
+      WritableMap event = Arguments.createMap();
+      event.putInt("count", stats.count);
+      event.putArray("histogram", histogram);
+      event.putDouble("meanLatency", (double) stats.totalLatencyMs / stats.count);
+      event.putDouble("maxLatency", stats.maxLatencyMs);
+      event.putDouble("toJS", (double) stats.toJSMs / stats.count);
+      event.putDouble("js", (double) stats.jsMs / stats.count);
+      event.putDouble("commit", (double) stats.commitMs / stats.count);
+      events.putMap(stats.eventName, event);
+    }
+
+    WritableArray bucketBounds = Arguments.createArray();
+    for (long bound : BUCKET_BOUNDS_MS) {
+      bucketBounds.pushDouble(bound);
+    }
+
+    WritableMap stats = Arguments.createMap();
+    stats.putMap("events", events);
+    stats.putArray("bucketBounds", bucketBounds);
+    return stats;
+  }
+}
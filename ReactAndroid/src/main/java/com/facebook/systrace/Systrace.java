@@ -17,12 +17,25 @@ public class Systrace {
 
   public static final long TRACE_TAG_REACT_JAVA_BRIDGE = 0L;
 
+  public static boolean isTracing(long tag) {
+    return false;
+  }
+
   public static void beginSection(long tag, final String sectionName) {
   }
 
   public static void endSection(long tag) {
   }
 
+  public static void startAsyncFlow(long tag, final String sectionName, final int cookie) {
+  }
+
+  public static void stepAsyncFlow(long tag, final String sectionName, final int cookie) {
+  }
+
+  public static void endAsyncFlow(long tag, final String sectionName, final int cookie) {
+  }
+
   public static void traceCounter(
       long tag,
       final String counterName,
@@ -25,6 +25,38 @@ public:
     FBASSERT(m_refcount == 0);
   }
 
+private:
+  // Taking a reference needs no ordering, whoever copies a RefPtr already holds one. Dropping the
+  // last one has to see every write made through the others before the object is deleted.
+  void ref() {
+    m_refcount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void unref() {
+    if (1 == m_refcount.fetch_sub(1, std::memory_order_acq_rel)) {
+      delete this;
+    }
+  }
+
+  bool hasOnlyOneRef() const {
+    return m_refcount.load(std::memory_order_acquire) == 1;
+  }
+
+  template <typename T> friend class RefPtr;
+  std::atomic<int> m_refcount;
+};
+
+// Same as Countable, with a plain reference count for objects whose RefPtrs are only ever copied
+// and released on one thread. Can't be handed to Java, which may release it from the finalizer.
+class LocalCountable : public noncopyable, public nonmovable {
+public:
+  // RefPtr expects refcount to start at 0
+  LocalCountable() : m_refcount(0) {}
+  virtual ~LocalCountable()
+  {
+    FBASSERT(m_refcount == 0);
+  }
+
 private:
   void ref() {
     ++m_refcount;
@@ -41,7 +73,7 @@ private:
   }
 
   template <typename T> friend class RefPtr;
-  std::atomic<int> m_refcount;
+  int m_refcount;
 };
 
 }
@@ -321,6 +321,29 @@ extern "C" {
 typedef void (*LogHandler)(int priority, const char* tag, const char* message);
 void setLogHandler(LogHandler logHandler);
 
+/*
+ * From then on, messages below ANDROID_LOG_ERROR are handed to a background
+ * thread that writes them to the log, instead of being written by the caller.
+ * Errors are still written by the caller, after the queued messages, so the log
+ * stays in order. A message is dropped, rather than making the caller wait, when the queue is
+ * full or when its tag has logged maxMessagesPerTagPerSecond already within the
+ * current second (0 for no limit). Drops are counted, and reported in the log
+ * once logging catches up. If set, the LogHandler still gets every message,
+ * synchronously. May be called again to change the limit.
+ */
+void enableAsyncLogging(unsigned int maxMessagesPerTagPerSecond);
+
+/*
+ * Waits until the messages logged so far have been written.
+ */
+void flushAsyncLogging(void);
+
+typedef struct {
+  unsigned int rateLimited;
+  unsigned int queueFull;
+} LogDropCounts;
+LogDropCounts getLogDropCounts(void);
+
 /*
  * ===========================================================================
  *
@@ -9,8 +9,16 @@
 
 #include <fb/log.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #define LOG_BUFFER_SIZE 4096
 static LogHandler gLogHandler;
@@ -19,6 +27,289 @@ void setLogHandler(LogHandler logHandler) {
   gLogHandler = logHandler;
 }
 
+namespace {
+
+/**
+ * Writes messages to logcat from a background thread, so a thread that logs heavily, like the JS
+ * thread running console.log, never waits on the log device. Producers copy their message into a
+ * bounded lock-free ring (multiple producers, the writer thread as the only consumer); when it is
+ * full the message is dropped and counted rather than blocking.
+ */
+class AsyncLog {
+public:
+  static const size_t kSlotCount = 128;
+  static const size_t kMaxTagLength = 32;
+  static const size_t kMaxTextLength = 1024;
+  // Tags hashing to the same entry share their budget
+  static const size_t kRateEntryCount = 64;
+
+  AsyncLog() {
+    for (size_t i = 0; i < kSlotCount; i++) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    std::thread(&AsyncLog::writerLoop, this).detach();
+  }
+
+  void setRateLimit(unsigned int maxMessagesPerTagPerSecond) {
+    m_rateLimit.store(maxMessagesPerTagPerSecond, std::memory_order_relaxed);
+  }
+
+  void write(int prio, const char* tag, const char* text) {
+    if (!allowedByRateLimit(prio, tag)) {
+      return;
+    }
+    enqueue(prio, tag, text);
+  }
+
+  // For messages that can't wait for the writer thread. Whatever is queued is written first, so
+  // they still come out in order.
+  void writeNow(int prio, const char* tag, const char* text) {
+    flush();
+    __android_log_write(prio, tag, text);
+  }
+
+  void flush() {
+    size_t target = m_tail.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_flushWaiters++;
+    wakeWriter();
+    m_flushed.wait(lock, [this, target] {
+      return m_head.load(std::memory_order_acquire) >= target;
+    });
+    m_flushWaiters--;
+  }
+
+  LogDropCounts dropCounts() const {
+    LogDropCounts counts;
+    counts.rateLimited = m_rateLimitedCount.load(std::memory_order_relaxed);
+    counts.queueFull = m_queueFullCount.load(std::memory_order_relaxed);
+    return counts;
+  }
+
+private:
+  struct Slot {
+    // Equal to the position being written to the slot once it's free, one past it once the
+    // message is complete
+    std::atomic<size_t> sequence;
+    int prio;
+    bool hasTag;
+    char tag[kMaxTagLength];
+    char text[kMaxTextLength];
+  };
+
+  struct RateEntry {
+    // The second the window started in, in the high half, and the messages logged in it
+    std::atomic<uint64_t> window;
+    std::atomic<unsigned int> dropped;
+  };
+
+  void enqueue(int prio, const char* tag, const char* text) {
+    size_t tagLength = tag ? strlen(tag) : 0;
+    size_t textLength = strlen(text);
+    if (tagLength >= kMaxTagLength || textLength >= kMaxTextLength) {
+      // Rare enough that it isn't worth larger slots
+      writeNow(prio, tag, text);
+      return;
+    }
+
+    size_t position = m_tail.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &m_slots[position % kSlotCount];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (difference == 0) {
+        if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        m_queueFullCount.fetch_add(1, std::memory_order_relaxed);
+        m_unreportedQueueFull.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        position = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->prio = prio;
+    slot->hasTag = tag != NULL;
+    memcpy(slot->tag, tag ? tag : "", tagLength + 1);
+    memcpy(slot->text, text, textLength + 1);
+    // Sequentially consistent, like the writer's side in waitForMessages, so either the writer
+    // sees the message or we see that it is about to sleep
+    slot->sequence.store(position + 1, std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_wakeup.notify_one();
+    }
+  }
+
+  bool allowedByRateLimit(int prio, const char* tag) {
+    unsigned int limit = m_rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+      return true;
+    }
+
+    auto& entry = m_rates[hashTag(tag) % kRateEntryCount];
+    uint64_t now = currentSecond();
+    uint64_t window = entry.window.load(std::memory_order_relaxed);
+    while (true) {
+      uint64_t second = window >> 32;
+      uint64_t count = window & 0xffffffff;
+      uint64_t next;
+      if (second != now) {
+        next = (now << 32) | 1;
+      } else if (count >= limit) {
+        entry.dropped.fetch_add(1, std::memory_order_relaxed);
+        m_rateLimitedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        next = window + 1;
+      }
+      if (entry.window.compare_exchange_weak(window, next, std::memory_order_relaxed)) {
+        if (second != now) {
+          unsigned int dropped = entry.dropped.exchange(0, std::memory_order_relaxed);
+          if (dropped > 0) {
+            char note[64];
+            snprintf(note, sizeof(note), "(%u messages over the log rate limit dropped)", dropped);
+            enqueue(ANDROID_LOG_WARN, tag, note);
+          }
+        }
+        return true;
+      }
+    }
+  }
+
+  void writerLoop() {
+    while (true) {
+      waitForMessages();
+      while (writeNext()) {}
+
+      unsigned int queueFull = m_unreportedQueueFull.exchange(0, std::memory_order_relaxed);
+      if (queueFull > 0) {
+        char note[64];
+        snprintf(note, sizeof(note), "%u messages dropped, the log queue was full", queueFull);
+        __android_log_write(ANDROID_LOG_WARN, LOG_TAG, note);
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_flushWaiters > 0) {
+        m_flushed.notify_all();
+      }
+    }
+  }
+
+  bool writeNext() {
+    size_t position = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[position % kSlotCount];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      return false;
+    }
+    __android_log_write(slot.prio, slot.hasTag ? slot.tag : NULL, slot.text);
+    slot.sequence.store(position + kSlotCount, std::memory_order_release);
+    m_head.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool hasMessage() const {
+    size_t position = m_head.load(std::memory_order_relaxed);
+    return m_slots[position % kSlotCount].sequence.load(std::memory_order_seq_cst) ==
+      position + 1;
+  }
+
+  void waitForMessages() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_writerSleeping.store(true, std::memory_order_seq_cst);
+    if (!hasMessage() && m_flushWaiters == 0) {
+      // The timeout only guards against a missed wakeup, producers notify us
+      m_wakeup.wait_for(lock, std::chrono::seconds(1));
+    }
+    m_writerSleeping.store(false, std::memory_order_relaxed);
+  }
+
+  // Called with the mutex held
+  void wakeWriter() {
+    m_wakeup.notify_one();
+  }
+
+  static uint32_t hashTag(const char* tag) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char* c = tag ? tag : ""; *c; c++) {
+      hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    return hash;
+  }
+
+  static uint64_t currentSecond() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint32_t>(now.tv_sec);
+  }
+
+  Slot m_slots[kSlotCount];
+  std::atomic<size_t> m_tail{0};
+  std::atomic<size_t> m_head{0};
+
+  RateEntry m_rates[kRateEntryCount] = {};
+  std::atomic<unsigned int> m_rateLimit{0};
+  std::atomic<unsigned int> m_rateLimitedCount{0};
+  std::atomic<unsigned int> m_queueFullCount{0};
+  std::atomic<unsigned int> m_unreportedQueueFull{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::condition_variable m_flushed;
+  std::atomic<bool> m_writerSleeping{false};
+  int m_flushWaiters = 0;
+};
+
+std::atomic<AsyncLog*> gAsyncLog{nullptr};
+std::mutex gAsyncLogMutex;
+
+void writeLog(int prio, const char* tag, const char* text) {
+  AsyncLog* asyncLog = gAsyncLog.load(std::memory_order_acquire);
+  if (asyncLog == nullptr) {
+    __android_log_write(prio, tag, text);
+    return;
+  }
+  // Errors are written before returning, so they can't be lost to a crash that follows them
+  if (prio >= ANDROID_LOG_ERROR) {
+    asyncLog->writeNow(prio, tag, text);
+    return;
+  }
+  asyncLog->write(prio, tag, text);
+}
+
+}
+
+void enableAsyncLogging(unsigned int maxMessagesPerTagPerSecond) {
+  std::lock_guard<std::mutex> lock(gAsyncLogMutex);
+  AsyncLog* asyncLog = gAsyncLog.load(std::memory_order_relaxed);
+  if (asyncLog == nullptr) {
+    // Never freed, the writer thread runs until the process exits
+    asyncLog = new AsyncLog();
+  }
+  asyncLog->setRateLimit(maxMessagesPerTagPerSecond);
+  gAsyncLog.store(asyncLog, std::memory_order_release);
+}
+
+void flushAsyncLogging(void) {
+  AsyncLog* asyncLog = gAsyncLog.load(std::memory_order_acquire);
+  if (asyncLog != nullptr) {
+    asyncLog->flush();
+  }
+}
+
+LogDropCounts getLogDropCounts(void) {
+  AsyncLog* asyncLog = gAsyncLog.load(std::memory_order_acquire);
+  if (asyncLog == nullptr) {
+    LogDropCounts none = {0, 0};
+    return none;
+  }
+  return asyncLog->dropCounts();
+}
+
 int fb_printLog(int prio, const char *tag,  const char *fmt, ...) {
   char logBuffer[LOG_BUFFER_SIZE];
 
@@ -29,7 +320,7 @@ int fb_printLog(int prio, const char *tag,  const char *fmt, ...) {
   if (gLogHandler != NULL) {
       gLogHandler(prio, tag, logBuffer);
   }
-  __android_log_write(prio, tag, logBuffer);
+  writeLog(prio, tag, logBuffer);
   return result;
 }
 
@@ -52,7 +343,7 @@ void logPrintByDelims(int priority, const char* tag, const char* delims,
     }
 
     do {
-        __android_log_write(priority, tag, tok);
+        writeLog(priority, tag, tok);
     } while ((tok = strtok_r(NULL, delims, &context)));
 }
 
@@ -16,13 +16,18 @@
 namespace facebook {
 namespace jni {
 
-static StaticInitialized<ThreadLocal<JNIEnv>> g_env;
+namespace detail {
+StaticInitialized<ThreadLocal<JNIEnv>> g_env;
+}
+
+using detail::g_env;
+
 static JavaVM* g_vm = nullptr;
 
 /* static */
-JNIEnv* Environment::current() {
-  JNIEnv* env = g_env->get();
-  if ((env == nullptr) && (g_vm != nullptr)) {
+JNIEnv* Environment::lookUpCurrent() {
+  JNIEnv* env = nullptr;
+  if (g_vm != nullptr) {
     if (g_vm->GetEnv((void**) &env, JNI_VERSION_1_6) != JNI_OK) {
       FBLOGE("Error retrieving JNI Environment, thread is probably not attached to JVM");
       env = nullptr;
@@ -70,6 +75,10 @@ JNIEnv* Environment::ensureCurrentThreadIsAttached() {
 
 ThreadScope::ThreadScope()
     : attachedWithThisScope_(false) {
+  // Already attached by fbjni, or looked up since, so there is nothing to ask the VM
+  if (g_env->get()) {
+    return;
+  }
   JNIEnv* env = nullptr;
   if (g_vm->GetEnv((void**) &env, JNI_VERSION_1_6) != JNI_EDETACHED) {
     return;
@@ -10,17 +10,32 @@
 #pragma once
 #include <string>
 #include <jni.h>
+#include <fb/StaticInitialized.h>
+#include <fb/ThreadLocal.h>
 
 namespace facebook {
 namespace jni {
 
+namespace detail {
+// The current thread's JNIEnv, cached once fbjni has attached the thread or looked it up. A
+// pthread key rather than thread_local, which the NDK toolchain only emulates.
+extern StaticInitialized<ThreadLocal<JNIEnv>> g_env;
+}
+
 // Keeps a thread-local reference to the current thread's JNIEnv.
 struct Environment {
-  // May be null if this thread isn't attached to the JVM
-  static JNIEnv* current();
+  // May be null if this thread isn't attached to the JVM. Once the JNIEnv is cached this is a
+  // single TLS read, without calling into the VM.
+  static JNIEnv* current() {
+    JNIEnv* env = detail::g_env->get();
+    return env ? env : lookUpCurrent();
+  }
   static void initialize(JavaVM* vm);
   static JNIEnv* ensureCurrentThreadIsAttached();
   static void detachCurrentThread();
+
+ private:
+  static JNIEnv* lookUpCurrent();
 };
 
 /**
@@ -43,6 +58,9 @@ struct Environment {
  *    that were initiated on the Java side. A workaround is to pass a global reference for a
  *    class or instance to the new thread; this bypasses the need for the class loader.
  *    (See http://docs.oracle.com/javase/7/docs/technotes/guides/jni/spec/invocation.html#attach_current_thread)
+ *  - A native thread running many tasks, like the native JS thread, should hold one scope for its
+ *    whole run rather than one per task. Nested scopes on an attached thread are then only a TLS
+ *    read each.
  */
 class ThreadScope {
  public:
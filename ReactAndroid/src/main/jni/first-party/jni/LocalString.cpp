@@ -11,8 +11,15 @@
 #include <jni/Environment.h>
 #include <fb/assert.h>
 
+#include <cstring>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace facebook {
 namespace jni {
 
@@ -46,14 +53,63 @@ inline bool isFourByteUTF8Encoding(const T* utf8) {
   return ((*utf8 & 0xF8) == 0xF0);
 }
 
+// Returns how many bytes at the start of str are ASCII other than NUL. Those are the same in
+// UTF-8 and modified UTF-8, and nearly all strings crossing the bridge are made of nothing else,
+// so they are skipped a block at a time before falling back to the byte by byte conversions.
+size_t asciiPrefixLength(const uint8_t* str, size_t len) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= len; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    if (_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, zero))) != 0) {
+      break;
+    }
+  }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  const uint8x16_t highBit = vdupq_n_u8(0x80);
+  const uint8x16_t zero = vdupq_n_u8(0);
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t block = vld1q_u8(str + i);
+    uint64x2_t special = vreinterpretq_u64_u8(
+      vorrq_u8(vcgeq_u8(block, highBit), vceqq_u8(block, zero)));
+    if ((vgetq_lane_u64(special, 0) | vgetq_lane_u64(special, 1)) != 0) {
+      break;
+    }
+  }
+#else
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t highBits = 0x8080808080808080ULL;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    memcpy(&word, str + i, sizeof(word));
+    // Subtracting one sets the high bit of NUL bytes, the rest have it set already
+    if (((word | (word - ones)) & highBits) != 0) {
+      break;
+    }
+  }
+#endif
+  while (i < len && str[i] != 0 && str[i] < 0x80) {
+    i++;
+  }
+  return i;
+}
+
 }
 
 namespace detail {
 
 size_t modifiedLength(const std::string& str) {
   // Scan for supplementary characters
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(str.data());
   size_t j = 0;
   for (size_t i = 0; i < str.size(); ) {
+    size_t ascii = asciiPrefixLength(bytes + i, str.size() - i);
+    if (ascii > 0) {
+      i += ascii;
+      j += ascii;
+      continue;
+    }
     if (str[i] == 0) {
       i += 1;
       j += 2;
@@ -74,12 +130,17 @@ size_t modifiedLength(const std::string& str) {
 // returns modified utf8 length; *length is set to strlen(str)
 size_t modifiedLength(const uint8_t* str, size_t* length) {
   // NUL-terminated: Scan for length and supplementary characters
+  size_t len = strlen(reinterpret_cast<const char*>(str));
   size_t i = 0;
   size_t j = 0;
-  while (str[i] != 0) {
-    if (str[i + 1] == 0 ||
-        str[i + 2] == 0 ||
-        str[i + 3] == 0 ||
+  while (i < len) {
+    size_t ascii = asciiPrefixLength(str + i, len - i);
+    if (ascii > 0) {
+      i += ascii;
+      j += ascii;
+      continue;
+    }
+    if (i + 4 > len ||
         !isFourByteUTF8Encoding(&(str[i]))) {
       i += 1;
       j += 1;
@@ -89,7 +150,7 @@ size_t modifiedLength(const uint8_t* str, size_t* length) {
     }
   }
 
-  *length = i;
+  *length = len;
   return j;
 }
 
@@ -97,6 +158,15 @@ void utf8ToModifiedUTF8(const uint8_t* utf8, size_t len, uint8_t* modified, size
 {
   size_t j = 0;
   for (size_t i = 0; i < len; ) {
+    size_t ascii = asciiPrefixLength(utf8 + i, len - i);
+    if (ascii > 0) {
+      FBASSERTMSGF(j + ascii < modifiedBufLen, "output buffer is too short");
+      memcpy(modified + j, utf8 + i, ascii);
+      i += ascii;
+      j += ascii;
+      continue;
+    }
+
     FBASSERTMSGF(j < modifiedBufLen, "output buffer is too short");
     if (utf8[i] == 0) {
       FBASSERTMSGF(j + 1 < modifiedBufLen, "output buffer is too short");
@@ -151,10 +221,24 @@ void utf8ToModifiedUTF8(const uint8_t* utf8, size_t len, uint8_t* modified, size
 }
 
 std::string modifiedUTF8ToUTF8(const uint8_t* modified, size_t len) {
+  size_t ascii = asciiPrefixLength(modified, len);
+  if (ascii == len) {
+    return std::string(reinterpret_cast<const char*>(modified), len);
+  }
+
   // Converting from modified utf8 to utf8 will always shrink, so this will always be sufficient
   std::string utf8(len, 0);
-  size_t j = 0;
-  for (size_t i = 0; i < len; ) {
+  memcpy(&utf8[0], modified, ascii);
+  size_t j = ascii;
+  for (size_t i = ascii; i < len; ) {
+    ascii = asciiPrefixLength(modified + i, len - i);
+    if (ascii > 0) {
+      memcpy(&utf8[j], modified + i, ascii);
+      i += ascii;
+      j += ascii;
+      continue;
+    }
+
     // surrogate pair: 1101 10xx  xxxx xxxx  1101 11xx  xxxx xxxx
     // encoded pair: 1110 1101  1010 xxxx  10xx xxxx  1110 1101  1011 xxxx  10xx xxxx
 
@@ -14,23 +14,54 @@ namespace facebook {
 namespace jni {
 
 WeakReference::WeakReference(jobject strongRef) :
-  m_weakReference(Environment::current()->NewWeakGlobalRef(strongRef))
+  m_weakReference(Environment::current()->NewWeakGlobalRef(strongRef)),
+  m_pinnedReference(nullptr),
+  m_pinCount(0)
 {
 }
 
 WeakReference::~WeakReference() {
   auto env = Environment::current();
   FBASSERTMSGF(env, "Attempt to delete jni::WeakReference from non-JNI thread");
+  if (m_pinnedReference) {
+    env->DeleteGlobalRef(m_pinnedReference);
+  }
   env->DeleteWeakGlobalRef(m_weakReference);
 }
 
+void WeakReference::pin() {
+  auto env = Environment::current();
+  std::lock_guard<std::mutex> lock(m_pinMutex);
+  if (m_pinCount++ == 0) {
+    // Null if the object is already gone, in which case resolving stays null too
+    m_pinnedReference = env->NewGlobalRef(m_weakReference);
+  }
+}
+
+void WeakReference::unpin() {
+  auto env = Environment::current();
+  std::lock_guard<std::mutex> lock(m_pinMutex);
+  FBASSERTMSGF(m_pinCount > 0, "Unbalanced WeakReference::unpin");
+  if (--m_pinCount == 0 && m_pinnedReference) {
+    env->DeleteGlobalRef(m_pinnedReference);
+    m_pinnedReference = nullptr;
+  }
+}
+
+jobject WeakReference::newLocalRef() {
+  auto env = Environment::current();
+  // Held while the local ref is made, so that unpin can't delete the global ref under us
+  std::lock_guard<std::mutex> lock(m_pinMutex);
+  return env->NewLocalRef(m_pinCount > 0 ? m_pinnedReference : m_weakReference);
+}
+
 ResolvedWeakReference::ResolvedWeakReference(jobject weakRef) :
   m_strongReference(Environment::current()->NewLocalRef(weakRef))
 {
 }
 
 ResolvedWeakReference::ResolvedWeakReference(const RefPtr<WeakReference>& weakRef) :
-  m_strongReference(Environment::current()->NewLocalRef(weakRef->weakRef()))
+  m_strongReference(weakRef->newLocalRef())
 {
 }
 
@@ -8,6 +8,7 @@
  */
 
 #pragma once
+#include <mutex>
 #include <string>
 #include <jni.h>
 #include <fb/noncopyable.h>
@@ -25,8 +26,21 @@ public:
     return m_weakReference;
   }
 
+  // While pinned, a global reference keeps the object alive and is what ResolvedWeakReference
+  // resolves, which is cheaper than resolving the weak one. For objects that have to outlive
+  // some owner anyway, pinned for that owner's lifetime. Every pin needs an unpin, or the object
+  // can never be collected.
+  void pin();
+  void unpin();
+
+  // A new local reference to the object, or null if it was collected
+  jobject newLocalRef();
+
 private:
   jweak m_weakReference;
+  std::mutex m_pinMutex;
+  jobject m_pinnedReference;
+  int m_pinCount;
 };
 
 // This class is intended to take a weak reference and turn it into a strong
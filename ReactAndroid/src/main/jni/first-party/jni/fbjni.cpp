@@ -110,6 +110,13 @@ local_ref<jstring> make_jstring(const char* utf8) {
   return adopt_local(result);
 }
 
+local_ref<jstring> make_jstring_utf16(const jchar* utf16, size_t length) {
+  const auto env = internal::getEnv();
+  auto result = env->NewString(utf16, static_cast<jsize>(length));
+  FACEBOOK_JNI_THROW_PENDING_EXCEPTION();
+  return adopt_local(result);
+}
+
 
 // PinnedPrimitiveArray ///////////////////////////////////////////////////////////////////////////
 
@@ -178,6 +185,10 @@ void JObjectWrapper<j ## TYPE ## Array>::setRegion(jsize start, jsize length, j
 PinnedPrimitiveArray<j ## TYPE> JObjectWrapper<j ## TYPE ## Array>::pin() {                     \
   return PinnedPrimitiveArray<j ## TYPE>{self()};                                               \
 }                                                                                               \
+                                                                                                \
+PinnedCriticalArray<j ## TYPE> JObjectWrapper<j ## TYPE ## Array>::pinCritical(bool readOnly) { \
+  return PinnedCriticalArray<j ## TYPE>{self(), readOnly};                                      \
+}                                                                                               \
 
 DEFINE_PRIMITIVE_ARRAY_UTILS(boolean, Boolean)
 DEFINE_PRIMITIVE_ARRAY_UTILS(byte, Byte)
@@ -418,6 +418,65 @@ inline PinnedPrimitiveArray<T>::~PinnedPrimitiveArray() noexcept {
   }
 }
 
+// PinnedCriticalArray ////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+inline PinnedCriticalArray<T>::PinnedCriticalArray(alias_ref<jarray> array, bool readOnly)
+  : array_{array}
+  , elements_{nullptr}
+  , size_{0}
+  , releaseMode_{readOnly ? JNI_ABORT : 0} {
+  FACEBOOK_JNI_THROW_EXCEPTION_IF(array_.get() == nullptr);
+  const auto env = internal::getEnv();
+  size_ = env->GetArrayLength(array_.get());
+  elements_ = static_cast<T*>(env->GetPrimitiveArrayCritical(array_.get(), nullptr));
+  FACEBOOK_JNI_THROW_EXCEPTION_IF(elements_ == nullptr);
+}
+
+template<typename T>
+PinnedCriticalArray<T>::PinnedCriticalArray(PinnedCriticalArray&& o) noexcept {
+  array_ = std::move(o.array_);
+  elements_ = o.elements_;
+  size_ = o.size_;
+  releaseMode_ = o.releaseMode_;
+  o.elements_ = nullptr;
+  o.size_ = 0;
+}
+
+template<typename T>
+inline T* PinnedCriticalArray<T>::get() const noexcept {
+  return elements_;
+}
+
+template<typename T>
+inline void PinnedCriticalArray<T>::release() noexcept {
+  if (elements_) {
+    internal::getEnv()->ReleasePrimitiveArrayCritical(array_.get(), elements_, releaseMode_);
+    elements_ = nullptr;
+    size_ = 0;
+  }
+}
+
+template<typename T>
+inline const T& PinnedCriticalArray<T>::operator[](size_t index) const {
+  return elements_[index];
+}
+
+template<typename T>
+inline T& PinnedCriticalArray<T>::operator[](size_t index) {
+  return elements_[index];
+}
+
+template<typename T>
+inline size_t PinnedCriticalArray<T>::size() const noexcept {
+  return size_;
+}
+
+template<typename T>
+inline PinnedCriticalArray<T>::~PinnedCriticalArray() noexcept {
+  release();
+}
+
 #pragma push_macro("DECLARE_PRIMITIVE_METHODS")
 #undef DECLARE_PRIMITIVE_METHODS
 #define DECLARE_PRIMITIVE_METHODS(TYPE, NAME)          \
@@ -448,4 +507,49 @@ inline local_ref<jclass> JavaClass<T>::javaClassLocal() {
   return findClassLocal(className.c_str());
 }
 
+namespace detail {
+
+template<typename M>
+struct MemberLookup;
+
+template<typename F>
+struct MemberLookup<JMethod<F>> {
+  static JMethod<F> lookup(alias_ref<jclass> cls, const char* name, const char* descriptor) {
+    return descriptor ? cls->getMethod<F>(name, descriptor) : cls->getMethod<F>(name);
+  }
+};
+
+template<typename F>
+struct MemberLookup<JStaticMethod<F>> {
+  static JStaticMethod<F> lookup(alias_ref<jclass> cls, const char* name, const char* descriptor) {
+    return descriptor ? cls->getStaticMethod<F>(name, descriptor) : cls->getStaticMethod<F>(name);
+  }
+};
+
+template<typename F>
+struct MemberLookup<JField<F>> {
+  static JField<F> lookup(alias_ref<jclass> cls, const char* name, const char* descriptor) {
+    return descriptor ? cls->getField<F>(name, descriptor) : cls->getField<F>(name);
+  }
+};
+
+template<typename F>
+struct MemberLookup<JStaticField<F>> {
+  static JStaticField<F> lookup(alias_ref<jclass> cls, const char* name, const char* descriptor) {
+    return descriptor ? cls->getStaticField<F>(name, descriptor) : cls->getStaticField<F>(name);
+  }
+};
+
+}
+
+template<typename T, typename M>
+inline void JMemberId<T, M>::resolve() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (resolved_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  member_ = detail::MemberLookup<M>::lookup(T::javaClassStatic(), name_, descriptor_);
+  resolved_.store(true, std::memory_order_release);
+}
+
 }}
@@ -18,6 +18,9 @@
 #include "Meta.h"
 #include "References.h"
 
+#include <atomic>
+#include <mutex>
+
 #include <memory>
 
 #include <jni.h>
@@ -243,6 +246,10 @@ class JObjectWrapper<jstring> : public JObjectWrapper<jobject> {
 local_ref<jstring> make_jstring(const char* modifiedUtf8);
 local_ref<jstring> make_jstring(const std::string& modifiedUtf8);
 
+/// Create a @ref local_ref to a jstring straight from UTF-16 code units, like the characters of a
+/// JSStringRef. Unlike make_jstring, the string isn't transcoded on either side of the call.
+local_ref<jstring> make_jstring_utf16(const jchar* utf16, size_t length);
+
 using JString = JObjectWrapper<jstring>;
 
 /// Wrapper to provide functionality to jthrowable references
@@ -364,6 +371,9 @@ using JArray = JObjectWrapper<jarray>;
 template <typename T>
 class PinnedPrimitiveArray;
 
+template <typename T>
+class PinnedCriticalArray;
+
 #pragma push_macro("DECLARE_PRIMITIVE_ARRAY_UTILS")
 #undef DECLARE_PRIMITIVE_ARRAY_UTILS
 #define DECLARE_PRIMITIVE_ARRAY_UTILS(TYPE, DESC)                      \
@@ -379,6 +389,7 @@ template<> class JObjectWrapper<j ## TYPE ## Array> : public JArray {  \
   std::unique_ptr<j ## TYPE[]> getRegion(jsize start, jsize length);   \
   void setRegion(jsize start, jsize length, j ## TYPE* buf);           \
   PinnedPrimitiveArray<j ## TYPE> pin();                               \
+  PinnedCriticalArray<j ## TYPE> pinCritical(bool readOnly = false);   \
                                                                        \
  private:                                                              \
   j ## TYPE ## Array self() const noexcept {                           \
@@ -443,6 +454,48 @@ class PinnedPrimitiveArray {
    friend class JObjectWrapper<jdoubleArray>;
 };
 
+/// RAII class for primitive arrays pinned with GetPrimitiveArrayCritical, which usually gives
+/// direct access to the elements without a copy. While the array is pinned, no other JNI calls
+/// may be made and the thread must not block, so only use this around a tight loop over the
+/// elements and let it go out of scope right after. Read-only arrays don't copy back any changes
+/// on release.
+template <typename T>
+class PinnedCriticalArray {
+  public:
+   static_assert(is_jni_primitive<T>::value,
+       "PinnedCriticalArray requires primitive jni type.");
+
+   PinnedCriticalArray(PinnedCriticalArray&&) noexcept;
+   PinnedCriticalArray(const PinnedCriticalArray&) = delete;
+   ~PinnedCriticalArray() noexcept;
+
+   PinnedCriticalArray& operator=(const PinnedCriticalArray&) = delete;
+
+   T* get() const noexcept;
+   void release() noexcept;
+
+   const T& operator[](size_t index) const;
+   T& operator[](size_t index);
+   size_t size() const noexcept;
+
+  private:
+   alias_ref<jarray> array_;
+   T* elements_;
+   size_t size_;
+   jint releaseMode_;
+
+   PinnedCriticalArray(alias_ref<jarray>, bool readOnly);
+
+   friend class JObjectWrapper<jbooleanArray>;
+   friend class JObjectWrapper<jbyteArray>;
+   friend class JObjectWrapper<jcharArray>;
+   friend class JObjectWrapper<jshortArray>;
+   friend class JObjectWrapper<jintArray>;
+   friend class JObjectWrapper<jlongArray>;
+   friend class JObjectWrapper<jfloatArray>;
+   friend class JObjectWrapper<jdoubleArray>;
+};
+
 
 // Together, these classes allow convenient use of any class with the fbjni
 // helpers.  To use:
@@ -466,6 +519,55 @@ public:
   static local_ref<jclass> javaClassLocal();
 };
 
+/// The id of a method or field of the Java class T, looked up at most once and then shared by
+/// every call site. M is the JMethod, JStaticMethod, JField or JStaticField type of the member,
+/// and T anything with a static javaClassStatic(), usually a JavaClass. Declare each member as a
+/// static of the class it belongs to, and resolve it where that class is registered so that
+/// calls never pay for the lookup:
+///
+/// struct MyClass : public JavaClass<MyClass> {
+///   constexpr static auto kJavaDescriptor = "Lcom/example/package/MyClass;";
+///   static JMemberId<MyClass, JMethod<void(jint)>> doSomething;
+/// };
+/// JMemberId<MyClass, JMethod<void(jint)>> MyClass::doSomething{"doSomething"};
+///
+/// MyClass::doSomething.resolve();         // from JNI_OnLoad
+/// MyClass::doSomething.get()(obj, 42);    // from anywhere
+///
+/// get() looks the member up itself if it hasn't been resolved yet, which suits classes that may
+/// not be present. The descriptor is deduced from M unless one is given; constructors ("<init>")
+/// always need one.
+template <typename T, typename M>
+class JMemberId {
+ public:
+  explicit JMemberId(const char* name, const char* descriptor = nullptr) noexcept
+    : name_(name)
+    , descriptor_(descriptor)
+    , resolved_(false)
+  {}
+
+  JMemberId(const JMemberId&) = delete;
+  JMemberId& operator=(const JMemberId&) = delete;
+
+  /// Look the member up unless that was already done. Throws if it doesn't exist.
+  void resolve();
+
+  /// Get the member, resolving it first if needed
+  M get() {
+    if (!resolved_.load(std::memory_order_acquire)) {
+      resolve();
+    }
+    return member_;
+  }
+
+ private:
+  const char* name_;
+  const char* descriptor_;
+  M member_;
+  std::atomic<bool> resolved_;
+  std::mutex mutex_;
+};
+
 template <typename T>
 class JObjectWrapper<T,
     typename std::enable_if<
@@ -14,10 +14,12 @@
 #include <fb/assert.h>
 
 #include <alloca.h>
+#include <algorithm>
 #include <cstdlib>
 #include <ios>
 #include <stdexcept>
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <system_error>
 
@@ -28,10 +30,41 @@ namespace jni {
 
 // CommonJniExceptions /////////////////////////////////////////////////////////////////////////////
 
+// A throwable class that native code throws often enough, directly or through
+// translatePendingCppExceptionToJavaException, for its class and String constructor to be looked
+// up at load time rather than on every throw.
+struct CachedThrowableClass {
+  const char* name;
+  jclass clazz;
+  jmethodID stringConstructor;
+};
+
 class CommonJniExceptions {
  public:
   static void init();
 
+  // Null if the class isn't cached, or wasn't found at load time
+  static const CachedThrowableClass* findThrowableClass(const char* name) {
+    for (auto& cached : throwableClasses_) {
+      if (cached.clazz && strcmp(cached.name, name) == 0) {
+        return &cached;
+      }
+    }
+    return nullptr;
+  }
+
+  static jmethodID getThrowableToStringMethod() {
+    return throwableToStringMethod_;
+  }
+
+  static jclass getCppSystemErrorExceptionClass() {
+    return cppSystemErrorExceptionClass_;
+  }
+
+  static jmethodID getCppSystemErrorExceptionConstructor() {
+    return cppSystemErrorExceptionConstructor_;
+  }
+
   static jclass getThrowableClass() {
     return throwableClass_;
   }
@@ -49,6 +82,11 @@ class CommonJniExceptions {
   }
 
  private:
+  static const size_t kCachedThrowableClassCount = 6;
+  static CachedThrowableClass throwableClasses_[kCachedThrowableClassCount];
+  static jmethodID throwableToStringMethod_;
+  static jclass cppSystemErrorExceptionClass_;
+  static jmethodID cppSystemErrorExceptionConstructor_;
   static jclass throwableClass_;
   static jclass unknownCppExceptionClass_;
   static jthrowable unknownCppExceptionObject_;
@@ -62,6 +100,33 @@ jclass CommonJniExceptions::throwableClass_ = nullptr;
 jclass CommonJniExceptions::unknownCppExceptionClass_ = nullptr;
 jthrowable CommonJniExceptions::unknownCppExceptionObject_ = nullptr;
 jthrowable CommonJniExceptions::runtimeExceptionObject_ = nullptr;
+jmethodID CommonJniExceptions::throwableToStringMethod_ = nullptr;
+jclass CommonJniExceptions::cppSystemErrorExceptionClass_ = nullptr;
+jmethodID CommonJniExceptions::cppSystemErrorExceptionConstructor_ = nullptr;
+CachedThrowableClass CommonJniExceptions::throwableClasses_[kCachedThrowableClassCount] = {
+  {gJavaLangIllegalArgumentException, nullptr, nullptr},
+  {"java/lang/RuntimeException", nullptr, nullptr},
+  {"java/io/IOException", nullptr, nullptr},
+  {"java/lang/OutOfMemoryError", nullptr, nullptr},
+  {"java/lang/ArrayIndexOutOfBoundsException", nullptr, nullptr},
+  {"com/facebook/jni/CppException", nullptr, nullptr},
+};
+
+namespace {
+
+// Null if the class can't be loaded, throws of it then look it up by name as before
+jclass findGlobalClassOrClear(JNIEnv* env, const char* name) {
+  jclass localClass = env->FindClass(name);
+  if (!localClass) {
+    env->ExceptionClear();
+    return nullptr;
+  }
+  jclass globalClass = static_cast<jclass>(env->NewGlobalRef(localClass));
+  env->DeleteLocalRef(localClass);
+  return globalClass;
+}
+
+}
 
 
 // Variable to guarantee that fallback exceptions have been initialized early. We don't want to
@@ -80,6 +145,33 @@ void CommonJniExceptions::init() {
   throwableClass_ = static_cast<jclass>(env->NewGlobalRef(localThrowableClass));
   FBASSERT(throwableClass_);
   env->DeleteLocalRef(localThrowableClass);
+  throwableToStringMethod_ = env->GetMethodID(throwableClass_, "toString", "()Ljava/lang/String;");
+  FBASSERT(throwableToStringMethod_);
+
+  for (auto& cached : throwableClasses_) {
+    cached.clazz = findGlobalClassOrClear(env, cached.name);
+    if (cached.clazz) {
+      cached.stringConstructor =
+        env->GetMethodID(cached.clazz, "<init>", "(Ljava/lang/String;)V");
+      if (!cached.stringConstructor) {
+        env->ExceptionClear();
+        env->DeleteGlobalRef(cached.clazz);
+        cached.clazz = nullptr;
+      }
+    }
+  }
+
+  cppSystemErrorExceptionClass_ =
+    findGlobalClassOrClear(env, "com/facebook/jni/CppSystemErrorException");
+  if (cppSystemErrorExceptionClass_) {
+    cppSystemErrorExceptionConstructor_ = env->GetMethodID(
+        cppSystemErrorExceptionClass_,
+        "<init>",
+        "(Ljava/lang/String;I)V");
+    if (!cppSystemErrorExceptionConstructor_) {
+      env->ExceptionClear();
+    }
+  }
 
   // UnknownCppException class
   jclass localUnknownCppExceptionClass = env->FindClass("com/facebook/jni/UnknownCppException");
@@ -164,17 +256,9 @@ void setDefaultException() noexcept {
 void setCppSystemErrorExceptionInJava(const std::system_error& ex) noexcept {
   assertIfExceptionsNotInitialized();
   JNIEnv* env = internal::getEnv();
-  jclass cppSystemErrorExceptionClass = env->FindClass(
-      "com/facebook/jni/CppSystemErrorException");
-  if (!cppSystemErrorExceptionClass) {
-    setDefaultException();
-    return;
-  }
-  jmethodID constructorMID = env->GetMethodID(
-      cppSystemErrorExceptionClass,
-      "<init>",
-      "(Ljava/lang/String;I)V");
-  if (!constructorMID) {
+  jclass cppSystemErrorExceptionClass = CommonJniExceptions::getCppSystemErrorExceptionClass();
+  jmethodID constructorMID = CommonJniExceptions::getCppSystemErrorExceptionConstructor();
+  if (!cppSystemErrorExceptionClass || !constructorMID) {
     setDefaultException();
     return;
   }
@@ -189,12 +273,12 @@ void setCppSystemErrorExceptionInJava(const std::system_error& ex) noexcept {
 template<typename... ARGS>
 void setNewJavaException(jclass exceptionClass, const char* fmt, ARGS... args) {
   assertIfExceptionsNotInitialized();
-  int msgSize = snprintf(nullptr, 0, fmt, args...);
+  int msgSize = std::min(snprintf(nullptr, 0, fmt, args...) + 1, kMaxExceptionMessageBufferSize);
   JNIEnv* env = internal::getEnv();
 
   try {
     char *msg = (char*) alloca(msgSize);
-    snprintf(msg, kMaxExceptionMessageBufferSize, fmt, args...);
+    snprintf(msg, msgSize, fmt, args...);
     env->ThrowNew(exceptionClass, msg);
   } catch (...) {
     env->ThrowNew(exceptionClass, "");
@@ -213,6 +297,10 @@ void setNewJavaException(jclass exceptionClass, const char* msg) {
 template<typename... ARGS>
 void setNewJavaException(const char* className, const char* fmt, ARGS... args) {
   assertIfExceptionsNotInitialized();
+  if (auto cached = CommonJniExceptions::findThrowableClass(className)) {
+    setNewJavaException(cached->clazz, fmt, args...);
+    return;
+  }
   JNIEnv* env = internal::getEnv();
   jclass exceptionClass = env->FindClass(className);
   if (env->ExceptionCheck() != JNI_TRUE && !exceptionClass) {
@@ -264,6 +352,14 @@ void throwNewJavaException(jthrowable throwable) {
 }
 
 void throwNewJavaException(const char* throwableName, const char* msg) {
+  if (auto cached = CommonJniExceptions::findThrowableClass(throwableName)) {
+    auto message = make_jstring(msg);
+    auto throwable = adopt_local(static_cast<jthrowable>(internal::getEnv()->NewObject(
+      cached->clazz, cached->stringConstructor, message.get())));
+    FACEBOOK_JNI_THROW_EXCEPTION_IF(!throwable);
+    throwNewJavaException(throwable.get());
+  }
+
   // If anything of the fbjni calls fail, an exception of a suitable
   // form will be thrown, which is what we want.
   auto throwableClass = findClassLocal(throwableName);
@@ -354,10 +450,7 @@ jthrowable JniException::getThrowable() const noexcept {
 void JniException::populateWhat() const noexcept {
   JNIEnv* env = internal::getEnv();
 
-  jmethodID toStringMID = env->GetMethodID(
-      CommonJniExceptions::getThrowableClass(),
-      "toString",
-      "()Ljava/lang/String;");
+  jmethodID toStringMID = CommonJniExceptions::getThrowableToStringMethod();
   jstring messageJString = (jstring) env->CallObjectMethod(
       throwableGlobalRef_,
       toStringMID);
@@ -112,10 +112,13 @@ static const int kMaxExceptionMessageBufferSize = 512;
 template<typename... Args>
 [[noreturn]] void throwNewJavaException(const char* throwableName, const char* fmt, Args... args) {
   assertIfExceptionsNotInitialized();
-  int msgSize = snprintf(nullptr, 0, fmt, args...);
+  int msgSize = snprintf(nullptr, 0, fmt, args...) + 1;
+  if (msgSize > kMaxExceptionMessageBufferSize) {
+    msgSize = kMaxExceptionMessageBufferSize;
+  }
 
   char *msg = (char*) alloca(msgSize);
-  snprintf(msg, kMaxExceptionMessageBufferSize, fmt, args...);
+  snprintf(msg, msgSize, fmt, args...);
   throwNewJavaException(throwableName, msg);
 }
 
@@ -17,9 +17,11 @@ namespace jni {
 
 namespace detail {
 
+JMemberId<HybridData, JField<jlong>> HybridData::nativePointerField{"mNativePointer"};
+
 void setNativePointer(alias_ref<HybridData::javaobject> hybridData,
                       std::unique_ptr<BaseHybridClass> new_value) {
-  static auto pointerField = hybridData->getClass()->getField<jlong>("mNativePointer");
+  auto pointerField = HybridData::nativePointerField.get();
   auto* old_value = reinterpret_cast<BaseHybridClass*>(hybridData->getFieldValue(pointerField));
   if (new_value) {
     // Modify should only ever be called once with a non-null
@@ -39,7 +41,7 @@ void setNativePointer(alias_ref<HybridData::javaobject> hybridData,
 }
 
 BaseHybridClass* getNativePointer(alias_ref<HybridData::javaobject> hybridData) {
-  static auto pointerField = hybridData->getClass()->getField<jlong>("mNativePointer");
+  auto pointerField = HybridData::nativePointerField.get();
   auto* value = reinterpret_cast<BaseHybridClass*>(hybridData->getFieldValue(pointerField));
   if (!value) {
     throwNewJavaException("java/lang/NullPointerException", "java.lang.NullPointerException");
@@ -70,6 +72,7 @@ void HybridDataOnLoad() {
   registerNatives("com/facebook/jni/HybridData", {
       makeNativeMethod("resetNative", resetNative),
   });
+  detail::HybridData::nativePointerField.resolve();
 }
 
 }}
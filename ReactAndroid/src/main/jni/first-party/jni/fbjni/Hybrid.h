@@ -26,6 +26,8 @@ namespace detail {
 
 struct HybridData : public JavaClass<HybridData> {
   constexpr static auto kJavaDescriptor = "Lcom/facebook/jni/HybridData;";
+
+  static JMemberId<HybridData, JField<jlong>> nativePointerField;
 };
 
 void setNativePointer(alias_ref<HybridData::javaobject> hybridData,
@@ -157,6 +159,9 @@ public:
   // I'm not sure why I need this, but I get errors without it.
   using JavaClass<T>::javaClassStatic;
 
+  // The mHybridData field of the Java part, which cthis() reads on every call
+  static JMemberId<T, JField<jhybriddata>> hybridDataField;
+
 protected:
   typedef HybridClass HybridBase;
 
@@ -167,6 +172,7 @@ protected:
 
   static void registerHybrid(std::initializer_list<NativeMethod> methods) {
     javaClassStatic()->registerNatives(methods);
+    hybridDataField.resolve();
   }
 
   static local_ref<jhybriddata> makeHybridData(std::unique_ptr<T> cxxPart) {
@@ -230,16 +236,20 @@ public:
   static void mapException(const std::exception& ex) {}
 };
 
+template <typename T>
+JMemberId<T, JField<detail::HybridData::javaobject>> HybridClass<T>::hybridDataField{
+  "mHybridData"
+};
+
 // Given a *_ref object which refers to a hybrid class, this will reach inside
 // of it, find the mHybridData, extract the C++ instance pointer, cast it to
 // the appropriate type, and return it.
 template <typename T>
 inline typename std::remove_pointer<typename T::PlainJniType>::type::javaClass* cthis(T jthis) {
-  static auto dataField =
-    jthis->getClass()->template getField<detail::HybridData::javaobject>("mHybridData");
+  typedef typename std::remove_pointer<typename T::PlainJniType>::type::javaClass javaClass;
   // I'd like to use dynamic_cast here, but -fno-rtti is the default.
-  auto* value = static_cast<typename std::remove_pointer<typename T::PlainJniType>::type::javaClass*>(
-    detail::getNativePointer(detail::getHybridData(jthis, dataField)));
+  auto* value = static_cast<javaClass*>(
+    detail::getNativePointer(detail::getHybridData(jthis, javaClass::hybridDataField.get())));
   // This would require some serious programmer error.
   FBASSERTMSGF(value != 0, "Incorrect C++ type in hybrid field");
   return value;
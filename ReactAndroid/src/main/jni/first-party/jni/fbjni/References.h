@@ -496,6 +496,9 @@ public:
   JniLocalScope(JNIEnv* p_env, jint capacity);
   ~JniLocalScope();
 
+  JniLocalScope(const JniLocalScope&) = delete;
+  JniLocalScope& operator=(const JniLocalScope&) = delete;
+
 private:
   JNIEnv* env_;
   bool hasFrame_;
@@ -6,9 +6,16 @@ LOCAL_MODULE := libreactnative
 
 LOCAL_SRC_FILES := \
   Bridge.cpp \
+  BridgeStats.cpp \
+  BridgeRecorder.cpp \
   Value.cpp \
   MethodCall.cpp \
   JSCHelpers.cpp \
+  JSIndexedBundle.cpp \
+  JSCSamplingProfiler.cpp \
+  TraceBuffer.cpp \
+  TraceWriter.cpp \
+  JSCExceptionLogger.cpp \
   JSCExecutor.cpp \
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/..
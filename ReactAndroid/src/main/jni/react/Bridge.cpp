@@ -2,6 +2,18 @@
 
 #include "Bridge.h"
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <pthread.h>
+#include <fb/log.h>
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+#include <jni/Environment.h>
+#include <jni/fbjni/Exceptions.h>
+
+#include "BridgeRecorder.h"
 #include "Executor.h"
 #include "MethodCall.h"
 
@@ -13,97 +25,498 @@ using fbsystrace::FbSystraceSection;
 namespace facebook {
 namespace react {
 
+static const char* const kBatchedBridgeModuleName = "BatchedBridge";
+
 class JSThreadState {
 public:
-  JSThreadState(const RefPtr<JSExecutorFactory>& jsExecutorFactory, Bridge::Callback&& callback) :
+  JSThreadState(
+      const RefPtr<JSExecutorFactory>& jsExecutorFactory,
+      Bridge::Callback&& callback,
+      SyncMethodCallback&& syncCallback,
+      ModuleNamesCallback&& moduleNamesCallback,
+      ModuleConfigCallback&& moduleConfigCallback,
+      BridgeStats* stats) :
     m_jsExecutor(jsExecutorFactory->createJSExecutor()),
-    m_callback(callback)
-  {}
+    m_callback(callback),
+    m_stats(stats),
+    m_completedJSCalls(0) {
+    m_jsExecutor->setStats(stats);
+    if (syncCallback) {
+      m_jsExecutor->setSyncMethodCallback(std::move(syncCallback));
+    }
+    if (moduleNamesCallback && moduleConfigCallback) {
+      m_jsExecutor->setModuleConfigCallbacks(
+        std::move(moduleNamesCallback), std::move(moduleConfigCallback));
+    }
+  }
+
+  void executeApplicationScript(
+      std::unique_ptr<const JSBigString> script,
+      const std::string& sourceURL) {
+    executeQueuedJSCalls();
+    m_jsExecutor->executeApplicationScript(std::move(script), sourceURL);
+  }
 
-  void executeApplicationScript(const std::string& script, const std::string& sourceURL) {
-    m_jsExecutor->executeApplicationScript(script, sourceURL);
+  // Queued calls are delivered by the next executeQueuedJSCalls(), in one JS entry if possible
+  void queueJSCall(JSCall&& call) {
+    m_queuedCalls.push_back(std::move(call));
   }
 
+  void executeQueuedJSCalls() {
+    if (m_queuedCalls.empty()) {
+      return;
+    }
+    std::vector<JSCall> calls;
+    calls.swap(m_queuedCalls);
+    if (calls.size() == 1) {
+      executeJSCall(kBatchedBridgeModuleName, calls[0].methodName, calls[0].arguments);
+    } else {
+      executeJSCalls(calls);
+    }
+  }
+
+  void executeJSCalls(const std::vector<JSCall>& calls) {
+    #ifdef WITH_FBSYSTRACE
+    FbSystraceSection s(
+        TRACE_TAG_REACT_CXX_BRIDGE, "JSThreadState.executeJSCalls",
+        "count", folly::to<std::string>(calls.size()));
+    #endif
+    std::vector<folly::dynamic> batch;
+    batch.reserve(calls.size());
+    for (const auto& call : calls) {
+      batch.push_back(folly::dynamic {
+        call.methodName,
+        folly::dynamic(call.arguments.begin(), call.arguments.end()),
+      });
+    }
+    std::vector<folly::dynamic> arguments {
+      folly::dynamic(
+        std::make_move_iterator(batch.begin()),
+        std::make_move_iterator(batch.end())),
+    };
+    executeJSCall(
+      kBatchedBridgeModuleName, "callFunctionsReturnFlushedQueue", arguments, calls.size());
+  }
+
+  // A JS call that delivers several calls completes all of them
   void executeJSCall(
       const std::string& moduleName,
       const std::string& methodName,
-      const std::vector<folly::dynamic>& arguments) {
-    auto returnedJSON = m_jsExecutor->executeJSCall(moduleName, methodName, arguments);
-    m_callback(parseMethodCalls(returnedJSON));
+      const std::vector<folly::dynamic>& arguments,
+      size_t completedJSCalls = 1) {
+    if (m_recorder) {
+      m_recorder->recordJSCall(moduleName, methodName, arguments);
+    }
+    auto start = m_recorder ? std::chrono::steady_clock::now()
+                            : std::chrono::steady_clock::time_point();
+    auto calls = m_jsExecutor->executeJSCallForMethodCalls(moduleName, methodName, arguments);
+    if (m_recorder) {
+      m_recorder->recordFlush(calls, std::chrono::steady_clock::now() - start);
+    }
+    m_stats->callsPerFlush.record(calls.size());
+    m_completedJSCalls += completedJSCalls;
+    m_pendingCalls.insert(
+      m_pendingCalls.end(),
+      std::make_move_iterator(calls.begin()),
+      std::make_move_iterator(calls.end()));
+  }
+
+  // Hands everything JS flushed since the last call to native in a single callback. The Java
+  // side counts each of its calls into JS as pending until a callback completes it, so calls
+  // that flushed nothing still need one.
+  void flushPendingCalls() {
+    executeQueuedJSCalls();
+    if (m_pendingCalls.empty() && m_completedJSCalls == 0) {
+      return;
+    }
+    std::vector<MethodCall> calls;
+    calls.swap(m_pendingCalls);
+    size_t completedJSCalls = m_completedJSCalls;
+    m_completedJSCalls = 0;
+    m_callback(std::move(calls), completedJSCalls);
   }
 
   void setGlobalVariable(const std::string& propName, const std::string& jsonValue) {
+    executeQueuedJSCalls();
     m_jsExecutor->setGlobalVariable(propName, jsonValue);
   }
 
   bool supportsProfiling() {
+    executeQueuedJSCalls();
     return m_jsExecutor->supportsProfiling();
   }
 
   void startProfiler(const std::string& title) {
+    executeQueuedJSCalls();
     m_jsExecutor->startProfiler(title);
   }
 
   void stopProfiler(const std::string& title, const std::string& filename) {
+    executeQueuedJSCalls();
     m_jsExecutor->stopProfiler(title, filename);
   }
 
+  bool supportsSamplingProfiler() {
+    executeQueuedJSCalls();
+    return m_jsExecutor->supportsSamplingProfiler();
+  }
+
+  void startSamplingProfiler(int intervalUs, int maxSamples) {
+    executeQueuedJSCalls();
+    m_jsExecutor->startSamplingProfiler(intervalUs, maxSamples);
+  }
+
+  void stopSamplingProfiler(const std::string& filename) {
+    executeQueuedJSCalls();
+    if (!m_jsExecutor->stopSamplingProfiler(filename)) {
+      FBLOGW("No sampling profile was written to %s", filename.c_str());
+    }
+  }
+
+  void collectGarbage() {
+    executeQueuedJSCalls();
+    m_jsExecutor->collectGarbage();
+  }
+
+  void handleIdle() {
+    // Calls that came in since the bridge went idle come first
+    if (m_queuedCalls.empty()) {
+      m_jsExecutor->handleIdle();
+    }
+  }
+
+  void startRecording(const std::string& filename) {
+    executeQueuedJSCalls();
+    // Replacing a recorder closes its file
+    m_recorder = BridgeRecorder::open(filename);
+  }
+
+  void stopRecording() {
+    executeQueuedJSCalls();
+    m_recorder.reset();
+  }
+
 private:
   std::unique_ptr<JSExecutor> m_jsExecutor;
   Bridge::Callback m_callback;
+  BridgeStats* m_stats;
+  std::vector<JSCall> m_queuedCalls;
+  std::vector<MethodCall> m_pendingCalls;
+  // The JS calls m_pendingCalls came back from
+  size_t m_completedJSCalls;
+  std::unique_ptr<BridgeRecorder> m_recorder;
+};
+
+/**
+ * A native thread that owns the JS executor. Producers push onto a lock-free intrusive stack;
+ * the loop takes the whole stack at once, so every task that arrived while JS was busy runs
+ * back to back as one batch. The mutex and condition variable are only used to sleep while the
+ * queue is empty.
+ */
+class JSMessageQueueThread {
+public:
+  typedef std::function<void()> Task;
+
+  JSMessageQueueThread(Task onBatchComplete, Bridge::ExceptionCallback onException) :
+    m_head(nullptr),
+    m_quit(false),
+    m_onBatchComplete(std::move(onBatchComplete)),
+    m_onException(std::move(onException)),
+    m_thread(&JSMessageQueueThread::loop, this)
+  {}
+
+  ~JSMessageQueueThread() {
+    quitSynchronous();
+  }
+
+  void runOnQueue(Task&& task) {
+    auto node = new Node { std::move(task), nullptr };
+    auto head = m_head.load(std::memory_order_relaxed);
+    do {
+      node->next = head;
+    } while (!m_head.compare_exchange_weak(
+        head, node, std::memory_order_release, std::memory_order_relaxed));
+    if (head == nullptr) {
+      // The loop may be asleep, only the empty -> non-empty transition needs a wakeup
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_wakeup.notify_one();
+    }
+  }
+
+  // Runs whatever is still queued, then stops the loop and joins it
+  void quitSynchronous() {
+    if (!m_thread.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_quit = true;
+      m_wakeup.notify_one();
+    }
+    m_thread.join();
+  }
+
+private:
+  struct Node {
+    Task task;
+    Node* next;
+  };
+
+  Node* takeBatch() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wakeup.wait(lock, [this] {
+      return m_quit || m_head.load(std::memory_order_relaxed) != nullptr;
+    });
+    auto head = m_head.exchange(nullptr, std::memory_order_acquire);
+    // The stack is LIFO, reverse it to run tasks in submission order
+    Node* batch = nullptr;
+    while (head) {
+      auto next = head->next;
+      head->next = batch;
+      batch = head;
+      head = next;
+    }
+    return batch;
+  }
+
+  void loop() {
+    pthread_setname_np(pthread_self(), "mqt_native_js");
+    // Callbacks to Java are made from this thread
+    jni::ThreadScope threadScope;
+
+    while (true) {
+      auto batch = takeBatch();
+      if (batch == nullptr) {
+        // Only reachable once we have been asked to quit and the queue is empty
+        return;
+      }
+      #ifdef WITH_FBSYSTRACE
+      FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "JSMessageQueueThread.batch");
+      #endif
+      while (batch) {
+        runGuarded(batch->task);
+        auto next = batch->next;
+        delete batch;
+        batch = next;
+      }
+      runGuarded(m_onBatchComplete);
+    }
+  }
+
+  // There is no Java caller to rethrow to on this thread, so failures go to the exception
+  // callback, which reports them the way a failure on the JS queue thread would be
+  void runGuarded(const Task& task) {
+    try {
+      task();
+      jni::throwPendingJniExceptionAsCppException();
+    } catch (...) {
+      if (!m_onException) {
+        throw;
+      }
+      m_onException(std::current_exception());
+    }
+  }
+
+  std::atomic<Node*> m_head;
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  bool m_quit;
+  Task m_onBatchComplete;
+  Bridge::ExceptionCallback m_onException;
+  std::thread m_thread;
 };
 
-Bridge::Bridge(const RefPtr<JSExecutorFactory>& jsExecutorFactory, Callback callback) :
+Bridge::Bridge(
+    const RefPtr<JSExecutorFactory>& jsExecutorFactory,
+    Callback callback,
+    SyncMethodCallback syncCallback,
+    ModuleNamesCallback moduleNamesCallback,
+    ModuleConfigCallback moduleConfigCallback,
+    ExceptionCallback exceptionCallback) :
   m_callback(callback),
-  m_destroyed(std::shared_ptr<bool>(new bool(false)))
+  m_destroyed(std::make_shared<std::atomic_bool>(false))
 {
   auto destroyed = m_destroyed;
-  auto proxyCallback = [this, destroyed] (std::vector<MethodCall> calls) {
+  auto proxyCallback = [this, destroyed] (
+      std::vector<MethodCall> calls, size_t completedJSCalls) {
     if (*destroyed) {
       return;
     }
-    m_callback(std::move(calls));
+    m_callback(std::move(calls), completedJSCalls);
   };
-  m_threadState.reset(new JSThreadState(jsExecutorFactory, std::move(proxyCallback)));
+
+  if (!jsExecutorFactory->canRunOnNativeJSThread()) {
+    m_threadState.reset(new JSThreadState(
+      jsExecutorFactory, std::move(proxyCallback), std::move(syncCallback),
+      std::move(moduleNamesCallback), std::move(moduleConfigCallback), &m_stats));
+    return;
+  }
+
+  m_jsThread.reset(new JSMessageQueueThread([this] {
+    if (m_threadState) {
+      m_threadState->flushPendingCalls();
+    }
+  }, std::move(exceptionCallback)));
+  // The executor is created, used and destroyed on the JS thread only
+  auto factory = jsExecutorFactory;
+  m_jsThread->runOnQueue(std::bind([this, factory] (
+      Callback& proxyCallback, SyncMethodCallback& syncCallback,
+      ModuleNamesCallback& moduleNamesCallback, ModuleConfigCallback& moduleConfigCallback) {
+    m_threadState.reset(new JSThreadState(
+      factory, std::move(proxyCallback), std::move(syncCallback),
+      std::move(moduleNamesCallback), std::move(moduleConfigCallback), &m_stats));
+  }, std::move(proxyCallback), std::move(syncCallback),
+     std::move(moduleNamesCallback), std::move(moduleConfigCallback)));
 }
 
 // This must be called on the same thread on which the constructor was called.
 Bridge::~Bridge() {
   *m_destroyed = true;
+  if (m_jsThread) {
+    m_jsThread->runOnQueue([this] {
+      m_threadState.reset();
+    });
+    m_jsThread->quitSynchronous();
+  }
   m_threadState.reset();
 }
 
-void Bridge::executeApplicationScript(const std::string& script, const std::string& sourceURL) {
-  m_threadState->executeApplicationScript(script, sourceURL);
+void Bridge::runOnJSThread(std::function<void()>&& task) {
+  if (m_jsThread) {
+    m_jsThread->runOnQueue(std::move(task));
+    return;
+  }
+  task();
+  m_threadState->flushPendingCalls();
+}
+
+void Bridge::executeApplicationScript(
+    std::unique_ptr<const JSBigString> script,
+    std::string sourceURL) {
+  // std::function must be copyable, so the script travels to the JS thread in a shared holder
+  auto scriptHolder = std::make_shared<std::unique_ptr<const JSBigString>>(std::move(script));
+  runOnJSThread(std::bind([this, scriptHolder] (std::string& sourceURL) {
+    m_threadState->executeApplicationScript(std::move(*scriptHolder), sourceURL);
+  }, std::move(sourceURL)));
 }
 
 void Bridge::executeJSCall(
-    const std::string& script,
-    const std::string& sourceURL,
-    const std::vector<folly::dynamic>& arguments) {
+    const std::string& moduleName,
+    const std::string& methodName,
+    std::vector<folly::dynamic> arguments) {
   if (*m_destroyed) {
     return;
   }
-  #ifdef WITH_FBSYSTRACE
-  FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "Bridge.executeJSCall");
-  #endif
-  m_threadState->executeJSCall(script, sourceURL, arguments);
+  bool coalesce = m_jsThread && moduleName == kBatchedBridgeModuleName;
+  auto task = [this, moduleName, methodName, coalesce] (std::vector<folly::dynamic>& arguments) {
+    if (*m_destroyed) {
+      return;
+    }
+    if (coalesce) {
+      // Sent along with whatever else is queued once this batch of tasks has run
+      m_threadState->queueJSCall(JSCall { methodName, std::move(arguments) });
+      return;
+    }
+    m_threadState->executeQueuedJSCalls();
+    #ifdef WITH_FBSYSTRACE
+    FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "Bridge.executeJSCall");
+    #endif
+    m_threadState->executeJSCall(moduleName, methodName, arguments);
+  };
+  runOnJSThread(std::bind(std::move(task), std::move(arguments)));
 }
 
-void Bridge::setGlobalVariable(const std::string& propName, const std::string& jsonValue) {
-  m_threadState->setGlobalVariable(propName, jsonValue);
+void Bridge::executeJSCalls(std::vector<JSCall> calls) {
+  if (*m_destroyed || calls.empty()) {
+    return;
+  }
+  runOnJSThread(std::bind([this] (std::vector<JSCall>& calls) {
+    if (*m_destroyed) {
+      return;
+    }
+    m_threadState->executeQueuedJSCalls();
+    m_threadState->executeJSCalls(calls);
+  }, std::move(calls)));
+}
+
+void Bridge::setGlobalVariable(std::string propName, std::string jsonValue) {
+  runOnJSThread(std::bind([this] (std::string& propName, std::string& jsonValue) {
+    m_threadState->setGlobalVariable(propName, jsonValue);
+  }, std::move(propName), std::move(jsonValue)));
 }
 
 bool Bridge::supportsProfiling() {
-  return m_threadState->supportsProfiling();
+  if (!m_jsThread) {
+    return m_threadState->supportsProfiling();
+  }
+  auto result = std::make_shared<std::promise<bool>>();
+  m_jsThread->runOnQueue([this, result] {
+    result->set_value(m_threadState && m_threadState->supportsProfiling());
+  });
+  return result->get_future().get();
+}
+
+folly::dynamic Bridge::getStats() {
+  return m_stats.toDynamic();
+}
+
+void Bridge::startProfiler(std::string title) {
+  runOnJSThread(std::bind([this] (std::string& title) {
+    m_threadState->startProfiler(title);
+  }, std::move(title)));
+}
+
+void Bridge::stopProfiler(std::string title, std::string filename) {
+  runOnJSThread(std::bind([this] (std::string& title, std::string& filename) {
+    m_threadState->stopProfiler(title, filename);
+  }, std::move(title), std::move(filename)));
+}
+
+bool Bridge::supportsSamplingProfiler() {
+  if (!m_jsThread) {
+    return m_threadState->supportsSamplingProfiler();
+  }
+  auto result = std::make_shared<std::promise<bool>>();
+  m_jsThread->runOnQueue([this, result] {
+    result->set_value(m_threadState && m_threadState->supportsSamplingProfiler());
+  });
+  return result->get_future().get();
+}
+
+void Bridge::startSamplingProfiler(int intervalUs, int maxSamples) {
+  runOnJSThread([this, intervalUs, maxSamples] {
+    m_threadState->startSamplingProfiler(intervalUs, maxSamples);
+  });
+}
+
+void Bridge::stopSamplingProfiler(std::string filename) {
+  runOnJSThread(std::bind([this] (std::string& filename) {
+    m_threadState->stopSamplingProfiler(filename);
+  }, std::move(filename)));
+}
+
+void Bridge::collectGarbage() {
+  runOnJSThread([this] {
+    m_threadState->collectGarbage();
+  });
+}
+
+void Bridge::handleIdle() {
+  runOnJSThread([this] {
+    m_threadState->handleIdle();
+  });
 }
 
-void Bridge::startProfiler(const std::string& title) {
-  m_threadState->startProfiler(title);
+void Bridge::startRecording(std::string filename) {
+  runOnJSThread(std::bind([this] (std::string& filename) {
+    m_threadState->startRecording(filename);
+  }, std::move(filename)));
 }
 
-void Bridge::stopProfiler(const std::string& title, const std::string& filename) {
-  m_threadState->stopProfiler(title, filename);
+void Bridge::stopRecording() {
+  runOnJSThread([this] {
+    m_threadState->stopRecording();
+  });
 }
 
 } }
@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <map>
 #include <vector>
 #include <jni.h>
 #include <fb/Countable.h>
 #include <fb/RefPtr.h>
+#include "BridgeStats.h"
 #include "Value.h"
 #include "Executor.h"
 #include "MethodCall.h"
@@ -21,30 +24,86 @@ struct dynamic;
 namespace facebook {
 namespace react {
 
+// A call to one of the BatchedBridge entry points, e.g. callFunctionReturnFlushedQueue
+struct JSCall {
+  std::string methodName;
+  std::vector<folly::dynamic> arguments;
+};
+
 class JSThreadState;
+class JSMessageQueueThread;
 class Bridge : public Countable {
 public:
-  typedef std::function<void(std::vector<MethodCall>)> Callback;
+  // Gets what JS flushed along with the number of JS calls it came back from, which may be 0
+  // for calls JS flushed on its own, or more than one for calls sent to JS together. Every JS
+  // call is completed by exactly one callback, even if it flushed nothing.
+  typedef std::function<void(std::vector<MethodCall> calls, size_t completedJSCalls)> Callback;
+  // Gets what a task on the native JS thread threw, including a pending Java exception, since
+  // that thread has no caller to rethrow it to. Runs on the native JS thread.
+  typedef std::function<void(std::exception_ptr)> ExceptionCallback;
 
-  Bridge(const RefPtr<JSExecutorFactory>& jsExecutorFactory, Callback callback);
+  // syncCallback, if set, serves sync method calls. It runs on the JS thread while JS waits.
+  // The module config callbacks, if set, serve the executor's nativeModuleProxy.
+  // Without an exceptionCallback, an exception on the native JS thread terminates the process.
+  Bridge(
+    const RefPtr<JSExecutorFactory>& jsExecutorFactory,
+    Callback callback,
+    SyncMethodCallback syncCallback = nullptr,
+    ModuleNamesCallback moduleNamesCallback = nullptr,
+    ModuleConfigCallback moduleConfigCallback = nullptr,
+    ExceptionCallback exceptionCallback = nullptr);
   virtual ~Bridge();
 
+  /**
+   * When the executor factory asks for a native JS thread, everything below except
+   * supportsProfiling() is queued to that thread and returns immediately. Otherwise it runs
+   * synchronously on the calling thread.
+   */
   void executeJSCall(
     const std::string& moduleName,
     const std::string& methodName,
-    const std::vector<folly::dynamic>& values);
-  void executeApplicationScript(const std::string& script, const std::string& sourceURL);
-  void setGlobalVariable(const std::string& propName, const std::string& jsonValue);
+    std::vector<folly::dynamic> values);
+  /**
+   * Delivers all calls in a single JS invocation of
+   * BatchedBridge.callFunctionsReturnFlushedQueue and a single flushed queue. On the native JS
+   * thread, BatchedBridge calls made through executeJSCall() that are queued behind each other
+   * are coalesced the same way.
+   */
+  void executeJSCalls(std::vector<JSCall> calls);
+  void executeApplicationScript(
+    std::unique_ptr<const JSBigString> script,
+    std::string sourceURL);
+  void setGlobalVariable(std::string propName, std::string jsonValue);
   bool supportsProfiling();
-  void startProfiler(const std::string& title);
-  void stopProfiler(const std::string& title, const std::string& filename);
+  // Snapshot of the histograms in BridgeStats. Safe to call from any thread, at any time.
+  folly::dynamic getStats();
+  void startProfiler(std::string title);
+  void stopProfiler(std::string title, std::string filename);
+  bool supportsSamplingProfiler();
+  // Samples JS every intervalUs into a ring buffer of maxSamples, 0 picks the defaults. Stopping
+  // writes a Chrome trace to filename.
+  void startSamplingProfiler(int intervalUs, int maxSamples);
+  void stopSamplingProfiler(std::string filename);
+  // Asks the executor to collect garbage now, e.g. while a frame has time to spare
+  void collectGarbage();
+  // Tells the executor that nothing is queued for JS, see JSExecutor::handleIdle()
+  void handleIdle();
+  // Records every call into JS and the calls JS flushes in return to filename, for replay
+  // benchmarks, see BridgeRecorder. Starting again replaces the current recording.
+  void startRecording(std::string filename);
+  void stopRecording();
 private:
+  void runOnJSThread(std::function<void()>&& task);
+
   Callback m_callback;
+  BridgeStats m_stats;
   std::unique_ptr<JSThreadState> m_threadState;
+  std::unique_ptr<JSMessageQueueThread> m_jsThread;
   // This is used to avoid a race condition where a proxyCallback gets queued after ~Bridge(),
   // on the same thread. In that case, the callback will try to run the task on m_callback which
   // will have been destroyed within ~Bridge(), thus causing a SIGSEGV.
-  std::shared_ptr<bool> m_destroyed;
+  // It is atomic because the native JS thread reads it while ~Bridge() runs on another thread.
+  std::shared_ptr<std::atomic_bool> m_destroyed;
 };
 
 } }
@@ -0,0 +1,113 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "BridgeRecorder.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <string.h>
+#include <unistd.h>
+#include <fb/log.h>
+#include <folly/json.h>
+
+namespace facebook {
+namespace react {
+
+std::unique_ptr<BridgeRecorder> BridgeRecorder::open(const std::string& filename) {
+  int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    FBLOGE("Unable to open %s for the bridge recording: %s", filename.c_str(), strerror(errno));
+    return nullptr;
+  }
+  return std::unique_ptr<BridgeRecorder>(new BridgeRecorder(fd));
+}
+
+BridgeRecorder::BridgeRecorder(int fd) :
+  m_fd(fd),
+  m_writer(fd),
+  m_start(std::chrono::steady_clock::now())
+{}
+
+BridgeRecorder::~BridgeRecorder() {
+  m_writer.flush();
+  close(m_fd);
+}
+
+int64_t BridgeRecorder::elapsedUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - m_start).count();
+}
+
+void BridgeRecorder::recordJSCall(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments) {
+  folly::dynamic event = {
+    elapsedUs(),
+    "call",
+    moduleName,
+    methodName,
+    folly::dynamic(arguments.begin(), arguments.end()),
+  };
+  m_writer.append(folly::toJson(event).toStdString());
+  m_writer.append("\n");
+}
+
+void BridgeRecorder::recordFlush(
+    const std::vector<MethodCall>& calls,
+    std::chrono::steady_clock::duration jsTime) {
+  folly::dynamic moduleIds = {};
+  folly::dynamic methodIds = {};
+  folly::dynamic params = {};
+  for (const auto& call : calls) {
+    moduleIds.push_back(call.moduleId);
+    methodIds.push_back(call.methodId);
+    params.push_back(call.arguments);
+  }
+  folly::dynamic event = {
+    elapsedUs(),
+    "flush",
+    std::chrono::duration_cast<std::chrono::microseconds>(jsTime).count(),
+    folly::dynamic { std::move(moduleIds), std::move(methodIds), std::move(params) },
+  };
+  m_writer.append(folly::toJson(event).toStdString());
+  m_writer.append("\n");
+}
+
+std::vector<RecordedBridgeEvent> readBridgeRecording(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::runtime_error("Unable to open bridge recording " + filename);
+  }
+  std::vector<RecordedBridgeEvent> events;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    folly::dynamic record = folly::parseJson(line);
+    if (!record.isArray() || record.size() < 4) {
+      throw std::runtime_error("Malformed bridge recording event: " + line);
+    }
+    RecordedBridgeEvent event;
+    event.timeUs = record[0].asInt();
+    event.durationUs = 0;
+    if (record[1] == "call" && record.size() == 5) {
+      event.type = RecordedBridgeEvent::Call;
+      event.moduleName = record[2].asString().toStdString();
+      event.methodName = record[3].asString().toStdString();
+      event.arguments = std::move(record[4]);
+    } else if (record[1] == "flush") {
+      event.type = RecordedBridgeEvent::Flush;
+      event.durationUs = record[2].asInt();
+      event.queueJSON = folly::toJson(record[3]).toStdString();
+    } else {
+      throw std::runtime_error("Malformed bridge recording event: " + line);
+    }
+    events.push_back(std::move(event));
+  }
+  return events;
+}
+
+} }
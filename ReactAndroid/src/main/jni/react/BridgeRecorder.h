@@ -0,0 +1,71 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <folly/dynamic.h>
+#include "MethodCall.h"
+#include "TraceWriter.h"
+
+namespace facebook {
+namespace react {
+
+/**
+ * Records the traffic of a bridge so that real sessions can be replayed as benchmarks. The file
+ * has one JSON array per line, with times in µs since the recording started:
+ *
+ *   [timeUs, "call", moduleName, methodName, arguments]
+ *     a call from native into JS
+ *   [timeUs, "flush", durationUs, [moduleIds, methodIds, params]]
+ *     the calls JS made while handling the previous call, which took durationUs, in the flushed
+ *     queue format parseMethodCalls reads
+ *
+ * Used on the JS thread only.
+ */
+class BridgeRecorder {
+public:
+  // Null if the file can't be created
+  static std::unique_ptr<BridgeRecorder> open(const std::string& filename);
+  ~BridgeRecorder();
+
+  void recordJSCall(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments);
+  void recordFlush(
+    const std::vector<MethodCall>& calls,
+    std::chrono::steady_clock::duration jsTime);
+
+private:
+  explicit BridgeRecorder(int fd);
+  int64_t elapsedUs() const;
+
+  int m_fd;
+  TraceWriter m_writer;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+struct RecordedBridgeEvent {
+  enum Type {
+    Call,
+    Flush,
+  };
+
+  Type type;
+  int64_t timeUs;
+  // For calls into JS
+  std::string moduleName;
+  std::string methodName;
+  folly::dynamic arguments;
+  // For flushes, the queue is kept as JSON so that replaying it goes through parseMethodCalls
+  int64_t durationUs;
+  std::string queueJSON;
+};
+
+// Reads back a file written by BridgeRecorder. Throws std::runtime_error if it is malformed.
+std::vector<RecordedBridgeEvent> readBridgeRecording(const std::string& filename);
+
+} }
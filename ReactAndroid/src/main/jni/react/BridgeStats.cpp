@@ -0,0 +1,96 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "BridgeStats.h"
+
+#include <limits>
+#include <folly/dynamic.h>
+
+namespace facebook {
+namespace react {
+
+Histogram::Histogram() :
+  m_count(0),
+  m_sum(0),
+  m_max(0) {
+  for (auto& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t Histogram::bucketIndex(uint64_t value) {
+  if (value > std::numeric_limits<uint32_t>::max()) {
+    value = std::numeric_limits<uint32_t>::max();
+  }
+  if (value < kSubBucketCount) {
+    return value;
+  }
+  size_t msb = 31 - __builtin_clz(static_cast<uint32_t>(value));
+  size_t shift = msb - kSubBucketBits;
+  return (shift + 1) * kSubBucketCount + ((value >> shift) & (kSubBucketCount - 1));
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  size_t shift = index / kSubBucketCount - 1;
+  uint64_t lowerBound = (kSubBucketCount + index % kSubBucketCount) << shift;
+  return lowerBound + (uint64_t(1) << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+  m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  auto max = m_max.load(std::memory_order_relaxed);
+  while (value > max &&
+         !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t Histogram::quantile(double q) const {
+  // Readers race with writers, so size the rank from the buckets rather than m_count
+  std::array<uint32_t, kBucketCount> buckets;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    total += buckets[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(q * (total - 1)) + 1;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return bucketUpperBound(i);
+    }
+  }
+  return bucketUpperBound(kBucketCount - 1);
+}
+
+folly::dynamic Histogram::toDynamic() const {
+  return folly::dynamic::object
+    ("count", static_cast<int64_t>(count()))
+    ("sum", static_cast<int64_t>(m_sum.load(std::memory_order_relaxed)))
+    ("max", static_cast<int64_t>(m_max.load(std::memory_order_relaxed)))
+    ("p50", static_cast<int64_t>(quantile(0.5)))
+    ("p90", static_cast<int64_t>(quantile(0.9)))
+    ("p99", static_cast<int64_t>(quantile(0.99)));
+}
+
+folly::dynamic BridgeStats::toDynamic() const {
+  return folly::dynamic::object
+    ("jsExecutionTimeUs", jsExecutionTime.toDynamic())
+    ("stringifyTimeUs", stringifyTime.toDynamic())
+    ("parseMethodCallsTimeUs", parseMethodCallsTime.toDynamic())
+    ("callsPerFlush", callsPerFlush.toDynamic())
+    ("payloadBytes", payloadBytes.toDynamic())
+    ("jsExecutionTimeWithGCUs", jsExecutionTimeWithGC.toDynamic())
+    ("gcReclaimedKB", gcReclaimedKB.toDynamic())
+    ("heapSizeKB", heapSizeKB.toDynamic())
+    ("collectGarbageTimeUs", collectGarbageTime.toDynamic());
+}
+
+} }
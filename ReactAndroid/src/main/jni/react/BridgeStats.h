@@ -0,0 +1,107 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace folly {
+
+struct dynamic;
+
+}
+
+namespace facebook {
+namespace react {
+
+/**
+ * A lock-free log-linear histogram of non-negative values. Values below 8 get exact buckets; above
+ * that every power of two is split into 8 linear buckets, so a bucket is never wider than 1/8th
+ * of its lower bound. Recording is a handful of relaxed atomic increments, cheap enough to leave
+ * on in release builds.
+ */
+class Histogram {
+public:
+  static const size_t kSubBucketBits = 3;
+  static const size_t kSubBucketCount = 1 << kSubBucketBits;
+  // Enough buckets for every uint32_t value, larger values are clamped
+  static const size_t kBucketCount = (32 - kSubBucketBits + 1) * kSubBucketCount;
+
+  Histogram();
+
+  void record(uint64_t value);
+
+  uint64_t count() const {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  // Upper bound of the bucket holding the given quantile (0 to 1), or 0 if nothing was recorded
+  uint64_t quantile(double q) const;
+
+  // {count, sum, max, p50, p90, p99}
+  folly::dynamic toDynamic() const;
+
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketUpperBound(size_t index);
+
+private:
+  std::array<std::atomic<uint32_t>, kBucketCount> m_buckets;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_sum;
+  std::atomic<uint64_t> m_max;
+};
+
+/**
+ * Always-on counters for the traffic through one Bridge. Times are in microseconds.
+ */
+struct BridgeStats {
+  // Time spent inside JS for one executor call, excluding argument and result conversion
+  Histogram jsExecutionTime;
+  // Time spent converting arguments to JS values and the flushed queue back to a string
+  Histogram stringifyTime;
+  // Only recorded by executors that parse the queue themselves
+  Histogram parseMethodCallsTime;
+  // Native calls returned by one flush of the JS queue
+  Histogram callsPerFlush;
+  // Size of the flushed queue as it comes out of JS, in characters when it is parsed straight
+  // out of a JS string. Only recorded by executors that parse the queue themselves.
+  Histogram payloadBytes;
+  // The GC histograms below are only recorded while the executor tracks the heap, see
+  // JSCExecutor. JS execution time of the calls during which the heap shrank, i.e. a collection
+  // ran, and how much it shrank by, in KB.
+  Histogram jsExecutionTimeWithGC;
+  Histogram gcReclaimedKB;
+  // Heap size after each tracked call, in KB
+  Histogram heapSizeKB;
+  // Time spent in collections asked for through collectGarbage()
+  Histogram collectGarbageTime;
+
+  folly::dynamic toDynamic() const;
+};
+
+inline uint64_t toMicroseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+// Records the lifetime of the scope into a histogram, in microseconds
+class ScopedHistogramTimer {
+public:
+  explicit ScopedHistogramTimer(Histogram* histogram) :
+    m_histogram(histogram),
+    m_start(std::chrono::steady_clock::now())
+  {}
+
+  ~ScopedHistogramTimer() {
+    if (m_histogram) {
+      m_histogram->record(toMicroseconds(std::chrono::steady_clock::now() - m_start));
+    }
+  }
+
+private:
+  Histogram* m_histogram;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+} }
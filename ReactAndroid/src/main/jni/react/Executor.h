@@ -2,37 +2,94 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
+#include <fb/noncopyable.h>
 #include <jni/Countable.h>
 
-namespace folly {
-
-struct dynamic;
-
-}
+#include "MethodCall.h"
 
 namespace facebook {
 namespace react {
 
 class JSExecutor;
+struct BridgeStats;
+
+// Calls a native method while JS waits for it, on the JS thread, and returns its result
+typedef std::function<folly::dynamic(int moduleId, int methodId, folly::dynamic&& arguments)>
+  SyncMethodCallback;
+
+// Serve the nativeModuleProxy global on the JS thread: the names of the native modules, and the
+// JSON config of one module, which is empty if there is no such module
+typedef std::function<std::vector<std::string>()> ModuleNamesCallback;
+typedef std::function<std::string(const std::string& moduleName)> ModuleConfigCallback;
+
+/**
+ * A read-only, null terminated script buffer. Bundles can be several megabytes, so they are
+ * passed around behind this interface instead of being copied into std::strings.
+ */
+class JSBigString : public noncopyable {
+public:
+  virtual ~JSBigString() {};
+  virtual const char* c_str() const = 0;
+  // Length in bytes, not counting the terminator
+  virtual size_t size() const = 0;
+};
+
+class JSBigStdString : public JSBigString {
+public:
+  explicit JSBigStdString(std::string str) :
+    m_str(std::move(str))
+  {}
+
+  const char* c_str() const override {
+    return m_str.c_str();
+  }
+
+  size_t size() const override {
+    return m_str.size();
+  }
+
+private:
+  std::string m_str;
+};
 
 class JSExecutorFactory : public Countable {
 public:
   virtual std::unique_ptr<JSExecutor> createJSExecutor() = 0;
+  // Whether executors from this factory can be created and driven from a native thread the
+  // Bridge owns. Executors that call back into app classes over JNI must stay on a Java thread,
+  // since natively attached threads only see the bootstrap class loader.
+  virtual bool canRunOnNativeJSThread() {
+    return false;
+  };
   virtual ~JSExecutorFactory() {};
 };
 
 class JSExecutor {
 public:
   virtual void executeApplicationScript(
-    const std::string& script,
+    std::unique_ptr<const JSBigString> script,
     const std::string& sourceURL) = 0;
+  void executeApplicationScript(const std::string& script, const std::string& sourceURL) {
+    executeApplicationScript(
+      std::unique_ptr<const JSBigString>(new JSBigStdString(script)), sourceURL);
+  }
   virtual std::string executeJSCall(
     const std::string& moduleName,
     const std::string& methodName,
     const std::vector<folly::dynamic>& arguments) = 0;
+  // Same as executeJSCall, but returns the flushed queue already parsed. Executors that can
+  // read the queue without first serializing it to a UTF-8 string should override this, and
+  // record the payload and parse stats themselves when they do.
+  virtual std::vector<MethodCall> executeJSCallForMethodCalls(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments) {
+    return parseMethodCalls(executeJSCall(moduleName, methodName, arguments));
+  }
   virtual void setGlobalVariable(
     const std::string& propName,
     const std::string& jsonValue) = 0;
@@ -41,6 +98,32 @@ public:
   };
   virtual void startProfiler(const std::string &titleString) {};
   virtual void stopProfiler(const std::string &titleString, const std::string &filename) {};
+  // Low overhead alternative to the profiler above, see JSCSamplingProfiler
+  virtual bool supportsSamplingProfiler() {
+    return false;
+  };
+  virtual void startSamplingProfiler(int intervalUs, int maxSamples) {};
+  // Returns whether a trace was written
+  virtual bool stopSamplingProfiler(const std::string& filename) {
+    return false;
+  };
+  // Executors that can tell JS time apart from conversion time record both here. The stats
+  // outlive the executor.
+  virtual void setStats(BridgeStats* stats) {};
+  // A hint that JS is idle, e.g. for the rest of a frame, so that garbage is better collected
+  // now than in the middle of a later call
+  virtual void collectGarbage() {};
+  // The bridge has nothing queued for JS. Executors may use the time within their own limits,
+  // e.g. for idle collections, unlike collectGarbage() which always asks for one.
+  virtual void handleIdle() {};
+  // Executors that can call into native code while JS runs expose this to JS as
+  // nativeCallSyncHook, which NativeModules use for sync methods. Others ignore it.
+  virtual void setSyncMethodCallback(SyncMethodCallback callback) {};
+  // Executors that can call into native code while JS runs expose these to JS as
+  // nativeModuleProxy, whose properties build module configs the first time they are read
+  virtual void setModuleConfigCallbacks(
+    ModuleNamesCallback namesCallback,
+    ModuleConfigCallback configCallback) {};
   virtual ~JSExecutor() {};
 };
 
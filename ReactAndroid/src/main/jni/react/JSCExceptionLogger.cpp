@@ -0,0 +1,157 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSCExceptionLogger.h"
+
+#include <fb/log.h>
+#include <folly/Conv.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// Empty unless object has a string property called name
+String stringProperty(JSContextRef ctx, JSObjectRef object, const char* name) {
+  if (object == nullptr) {
+    return String("");
+  }
+  JSValueRef exn = nullptr;
+  JSValueRef value = JSObjectGetProperty(ctx, object, String(name), &exn);
+  if (value == nullptr || !JSValueIsString(ctx, value)) {
+    return String("");
+  }
+  return String::adopt(JSValueToStringCopy(ctx, value, nullptr));
+}
+
+}
+
+JSCExceptionLogger& JSCExceptionLogger::shared() {
+  static auto logger = new JSCExceptionLogger([] (const std::string& text) {
+    FBLOGE("Got JS Exception: %s", text.c_str());
+  });
+  return *logger;
+}
+
+JSCExceptionLogger::JSCExceptionLogger(Sink sink) :
+  m_sink(std::move(sink)),
+  m_droppedCount(0),
+  m_logging(false),
+  m_stopping(false),
+  m_repeatCount(0),
+  m_thread(&JSCExceptionLogger::loggerLoop, this) {}
+
+JSCExceptionLogger::~JSCExceptionLogger() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_condition.notify_all();
+  m_thread.join();
+}
+
+void JSCExceptionLogger::report(JSContextRef ctx, JSValueRef exception, JSStringRef sourceURL) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.size() >= kMaxPendingExceptions) {
+      m_droppedCount++;
+      return;
+    }
+  }
+
+  JSValueRef exn = nullptr;
+  JSStringRef message = JSValueToStringCopy(ctx, exception, &exn);
+  JSObjectRef object = JSValueIsObject(ctx, exception)
+    ? JSValueToObject(ctx, exception, nullptr)
+    : nullptr;
+  String stack = stringProperty(ctx, object, "stack");
+  String exceptionURL = stringProperty(ctx, object, "sourceURL");
+  int line = 0;
+  if (object != nullptr) {
+    JSValueRef lineValue = JSObjectGetProperty(ctx, object, String("line"), nullptr);
+    if (lineValue != nullptr && JSValueIsNumber(ctx, lineValue)) {
+      line = static_cast<int>(JSValueToNumber(ctx, lineValue, nullptr));
+    }
+  }
+  PendingException pending {
+    message ? String::adopt(message) : String("(unprintable exception)"),
+    std::move(stack),
+    exceptionURL.length() > 0 || sourceURL == nullptr
+      ? std::move(exceptionURL)
+      : String::ref(sourceURL),
+    line,
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.push_back(std::move(pending));
+  }
+  m_condition.notify_all();
+}
+
+void JSCExceptionLogger::drain() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_condition.wait(lock, [this] { return m_pending.empty() && !m_logging; });
+}
+
+std::string JSCExceptionLogger::format(const PendingException& exception) {
+  std::string text = exception.message.str();
+  if (exception.sourceURL.length() > 0) {
+    text += " (" + exception.sourceURL.str();
+    if (exception.line > 0) {
+      text += folly::to<std::string>(":", exception.line);
+    }
+    text += ")";
+  }
+  if (exception.stack.length() > 0) {
+    text += "\n" + exception.stack.str();
+  }
+  return text;
+}
+
+void JSCExceptionLogger::flushRepeats() {
+  if (m_repeatCount > 0) {
+    m_sink(folly::to<std::string>(
+      "(previous exception repeated ", m_repeatCount, " more times)"));
+    m_repeatCount = 0;
+  }
+}
+
+void JSCExceptionLogger::loggerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_condition.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+    if (m_pending.empty()) {
+      break;
+    }
+    PendingException exception = std::move(m_pending.front());
+    m_pending.pop_front();
+    size_t dropped = m_droppedCount;
+    m_droppedCount = 0;
+    m_logging = true;
+    lock.unlock();
+
+    std::string text = format(exception);
+    if (text == m_lastText) {
+      m_repeatCount++;
+    } else {
+      flushRepeats();
+      m_sink(text);
+      m_lastText = std::move(text);
+    }
+    if (dropped > 0) {
+      flushRepeats();
+      m_sink(folly::to<std::string>("(dropped ", dropped, " more exceptions)"));
+    }
+
+    lock.lock();
+    if (m_pending.empty()) {
+      lock.unlock();
+      flushRepeats();
+      lock.lock();
+    }
+    m_logging = false;
+    m_condition.notify_all();
+  }
+}
+
+} }
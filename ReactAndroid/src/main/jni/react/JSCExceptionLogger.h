@@ -0,0 +1,70 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <JavaScriptCore/JSContextRef.h>
+#include "Value.h"
+
+namespace facebook {
+namespace react {
+
+/**
+ * Logs uncaught JS exceptions from a background thread. The JS thread only takes references to
+ * the exception's message and stack strings, which JSC lets any thread read; transcoding and
+ * formatting them, and logging, happen on the logger's thread. Under an error storm the same
+ * exception is logged once with a repeat count, and exceptions past kMaxPendingExceptions are
+ * counted instead of queued.
+ */
+class JSCExceptionLogger {
+public:
+  using Sink = std::function<void(const std::string& text)>;
+
+  // Logs through FBLOGE
+  static JSCExceptionLogger& shared();
+
+  explicit JSCExceptionLogger(Sink sink);
+  ~JSCExceptionLogger();
+
+  // sourceURL is used when the exception doesn't say which script it came from
+  void report(JSContextRef ctx, JSValueRef exception, JSStringRef sourceURL = nullptr);
+
+  // Blocks until everything reported so far has been passed to the sink
+  void drain();
+
+private:
+  static const size_t kMaxPendingExceptions = 64;
+
+  struct PendingException {
+    String message;
+    String stack;
+    String sourceURL;
+    int line;
+  };
+
+  static std::string format(const PendingException& exception);
+  void loggerLoop();
+  void flushRepeats();
+
+  Sink m_sink;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<PendingException> m_pending;
+  size_t m_droppedCount;
+  bool m_logging;
+  bool m_stopping;
+
+  // Only touched by the logger thread
+  std::string m_lastText;
+  size_t m_repeatCount;
+
+  std::thread m_thread;
+};
+
+} }
@@ -3,10 +3,14 @@
 #include "JSCExecutor.h"
 
 #include <algorithm>
+#include <dlfcn.h>
+#include <mutex>
 #include <sstream>
 #include <fb/log.h>
 #include <folly/json.h>
 #include <folly/String.h>
+#include "JSCExceptionLogger.h"
+#include "TraceBuffer.h"
 #include "Value.h"
 
 #ifdef WITH_JSC_EXTRA_TRACING
@@ -33,6 +37,10 @@ static JSValueRef nativeLoggingHook(
     size_t argumentCount,
     const JSValueRef arguments[], JSValueRef *exception);
 
+static void logJSException(JSContextRef ctx, JSValueRef exn, JSStringRef sourceURL = nullptr) {
+  JSCExceptionLogger::shared().report(ctx, exn, sourceURL);
+}
+
 static JSValueRef evaluateScriptWithJSC(
     JSGlobalContextRef ctx,
     JSStringRef script,
@@ -40,39 +48,361 @@ static JSValueRef evaluateScriptWithJSC(
   JSValueRef exn;
   auto result = JSEvaluateScript(ctx, script, nullptr, sourceURL, 0, &exn);
   if (result == nullptr) {
-    JSValueProtect(ctx, exn);
-    std::string exceptionText = Value(ctx, exn).toString().str();
-    FBLOGE("Got JS Exception: %s", exceptionText.c_str());
+    logJSException(ctx, exn, sourceURL);
   }
   return result;
 }
 
+// Each UTF-16 code unit of a binary batch string carries a single byte
+static std::string binaryStringToBytes(const String& binaryString) {
+  const JSChar* chars = JSStringGetCharactersPtr(binaryString);
+  size_t length = binaryString.length();
+  std::string bytes(length, '\0');
+  for (size_t i = 0; i < length; i++) {
+    bytes[i] = static_cast<char>(chars[i]);
+  }
+  return bytes;
+}
+
+// Building a value through the JSC API costs a call per node, while JSON.parse converts a whole
+// string in one tight native loop. Touch events and the like are well below this size and skip
+// the stringify-then-parse round trip; bulk payloads stay on the JSON path. The stringifyTime
+// bridge stat covers argument conversion, so it is what to watch when tuning this.
+static const size_t kMaxDirectConversionNodes = 64;
+
+static bool countNodes(const folly::dynamic& value, size_t& remaining) {
+  if (remaining == 0) {
+    return false;
+  }
+  remaining--;
+  if (value.isArray()) {
+    for (const auto& item : value) {
+      if (!countNodes(item, remaining)) {
+        return false;
+      }
+    }
+  } else if (value.isObject()) {
+    for (const auto& item : value.items()) {
+      if (!countNodes(item.second, remaining)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool isSmallValue(const folly::dynamic& value) {
+  size_t remaining = kMaxDirectConversionNodes;
+  return countNodes(value, remaining);
+}
+
+// Contexts in one group share a VM, so creating one is much cheaper than creating a context in
+// a group of its own, and bridges running the same bundle share the VM's heap, builtins and
+// code cache instead of each paying for their own. The price is that JSC takes the VM lock per
+// API call: every bridge still runs JS on its own thread, but bridges in the group interleave
+// between calls rather than running JS in parallel, a long call on one surface delays the
+// others, and a collection pauses all of them. So only executors with shareContextGroup set,
+// for apps with several surfaces that would rather save the memory, use it. Every other context
+// gets a group, and so a VM, of its own. Never released.
+static JSContextGroupRef sharedContextGroup() {
+  static JSContextGroupRef group = JSContextGroupCreate();
+  return group;
+}
+
+// JSC's heap size in bytes, or 0 if this JSC build doesn't export the private statistics
+// function. The heap is shared by every context in the context's group.
+static int64_t jscHeapSize(JSContextRef context) {
+  typedef JSObjectRef (*GetMemoryUsageStatistics)(JSContextRef);
+  static auto getMemoryUsageStatistics = reinterpret_cast<GetMemoryUsageStatistics>(
+    dlsym(RTLD_DEFAULT, "JSGetMemoryUsageStatistics"));
+  if (getMemoryUsageStatistics == nullptr) {
+    return 0;
+  }
+  auto statistics = getMemoryUsageStatistics(context);
+  if (statistics == nullptr) {
+    return 0;
+  }
+  auto heapSize = JSObjectGetProperty(context, statistics, String("heapSize"), nullptr);
+  if (heapSize == nullptr || !JSValueIsNumber(context, heapSize)) {
+    return 0;
+  }
+  return static_cast<int64_t>(JSValueToNumber(context, heapSize, nullptr));
+}
+
+// A context is only ever warmed once, a context that has run a bundle can not be reused. Warm
+// contexts have a group of their own: in the shared group creating a context is cheap already.
+static std::mutex gWarmContextMutex;
+static JSGlobalContextRef gWarmContext = nullptr;
+
+// Creates a context with every global hook an executor needs, short of the bundle itself
+static JSGlobalContextRef createPreparedContext(bool shareContextGroup) {
+  // A null group has JSC create one for this context alone
+  auto context = JSGlobalContextCreateInGroup(
+    shareContextGroup ? sharedContextGroup() : nullptr, nullptr);
+  installGlobalFunction(context, "nativeLoggingHook", nativeLoggingHook);
+  // Lets MessageQueue flush its queue with encodeBinaryBatch instead of returning it as JSON
+  String binaryQueueName("__fbBatchedBridgeBinaryQueue");
+  JSObjectSetProperty(
+    context,
+    JSContextGetGlobalObject(context),
+    binaryQueueName,
+    JSValueMakeBoolean(context, true),
+    kJSPropertyAttributeNone,
+    nullptr);
+  #ifdef WITH_JSC_EXTRA_TRACING
+  addNativeTracingHooks(context);
+  addNativeProfilingHooks(context);
+  addNativePerfLoggingHooks(context);
+  #endif
+  return context;
+}
+
+static JSGlobalContextRef takeWarmContext() {
+  std::lock_guard<std::mutex> lock(gWarmContextMutex);
+  auto context = gWarmContext;
+  gWarmContext = nullptr;
+  return context;
+}
+
 std::unique_ptr<JSExecutor> JSCExecutorFactory::createJSExecutor() {
-  return std::unique_ptr<JSExecutor>(new JSCExecutor());
+  return std::unique_ptr<JSExecutor>(new JSCExecutor(m_options));
 }
 
-JSCExecutor::JSCExecutor() {
-  m_context = JSGlobalContextCreateInGroup(nullptr, nullptr);
-  installGlobalFunction(m_context, "nativeLoggingHook", nativeLoggingHook);
+/* static */
+void JSCExecutorFactory::prepareWarmContext() {
+  {
+    std::lock_guard<std::mutex> lock(gWarmContextMutex);
+    if (gWarmContext != nullptr) {
+      return;
+    }
+  }
+  // Context creation is the slow part, so it happens outside the lock
+  auto context = createPreparedContext(false);
+  std::lock_guard<std::mutex> lock(gWarmContextMutex);
+  if (gWarmContext == nullptr) {
+    gWarmContext = context;
+  } else {
+    JSGlobalContextRelease(context);
+  }
+}
+
+bool JSCExecutorFactory::canRunOnNativeJSThread() {
   #ifdef WITH_JSC_EXTRA_TRACING
-  addNativeTracingHooks(m_context);
-  addNativeProfilingHooks(m_context);
-  addNativePerfLoggingHooks(m_context);
+  // The perf logging hooks look up QuickPerformanceLogger classes lazily
+  return false;
+  #else
+  return m_options.useNativeJSThread;
+  #endif
+}
+
+JSCExecutor::JSCExecutor(JSCExecutorOptions options) :
+  m_stats(nullptr),
+  m_options(options),
+  m_lastIdleCollectionTime(std::chrono::steady_clock::now()),
+  m_heapSizeAfterIdleCollection(0) {
+  m_context = options.shareContextGroup ? nullptr : takeWarmContext();
+  if (m_context == nullptr) {
+    m_context = createPreparedContext(options.shareContextGroup);
+  }
+  #ifndef WITH_JSC_EXTRA_TRACING
+  // BridgeProfiling sections reach native through console.profile, which JS binds to these at
+  // startup, for the sampling profiler and buffered traces. Builds with extra tracing send them
+  // to systrace instead.
+  installGlobalFunction(
+    m_context, "nativeTraceBeginSection", nativeSamplingProfilerBeginSection, this);
+  installGlobalFunction(
+    m_context, "nativeTraceEndSection", nativeSamplingProfilerEndSection, this);
   #endif
 }
 
 JSCExecutor::~JSCExecutor() {
+  #ifdef WITH_JSC_EXTRA_TRACING
+  flushPerfLoggingMarkers();
+  #endif
+  clearCachedJSFunctions();
   JSGlobalContextRelease(m_context);
 }
 
 void JSCExecutor::executeApplicationScript(
-    const std::string& script,
+    std::unique_ptr<const JSBigString> script,
     const std::string& sourceURL) {
-  String jsScript(script.c_str());
+  // The new script may redefine any module we have resolved so far
+  clearCachedJSFunctions();
+  m_indexedBundle.reset();
+  if (JSIndexedBundle::isIndexedBundle(*script)) {
+    executeIndexedBundle(std::move(script), sourceURL);
+    return;
+  }
+  // JSC converts the source into its own UTF-16 string here; this JSC build has no API to
+  // adopt external UTF-8 bytes, so this is the one copy we cannot avoid.
+  String jsScript(script->c_str());
+  // JSC keeps the copy it just made for as long as the code lives, so ours can go before the
+  // script runs rather than after
+  script.reset();
   String jsSourceURL(sourceURL.c_str());
   evaluateScriptWithJSC(m_context, jsScript, jsSourceURL);
 }
 
+void JSCExecutor::executeIndexedBundle(
+    std::unique_ptr<const JSBigString> script,
+    const std::string& sourceURL) {
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.executeIndexedBundle");
+  #endif
+  m_indexedBundle = JSIndexedBundle::fromScript(std::move(script));
+  if (!m_indexedBundle) {
+    return;
+  }
+  m_indexedBundleSourceURL = sourceURL;
+  // The polyfilled require() asks for modules it hasn't seen through this hook
+  installGlobalFunction(m_context, "nativeRequire", &JSCExecutor::nativeRequire, this);
+
+  String jsStartupCode(m_indexedBundle->startupCode());
+  String jsSourceURL(sourceURL.c_str());
+  evaluateScriptWithJSC(m_context, jsStartupCode, jsSourceURL);
+}
+
+JSValueRef JSCExecutor::nativeRequire(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(function));
+  if (argumentCount < 1 || !executor->m_indexedBundle) {
+    return JSValueMakeUndefined(ctx);
+  }
+  auto moduleName = Value(ctx, arguments[0]).toString().str();
+  auto code = executor->m_indexedBundle->moduleCode(moduleName);
+  if (code == nullptr) {
+    // require() reports unknown modules itself
+    return JSValueMakeUndefined(ctx);
+  }
+
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(
+      TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.nativeRequire",
+      "module", moduleName);
+  #endif
+  String jsCode(code);
+  String jsSourceURL(executor->m_indexedBundleSourceURL.c_str());
+  // Exceptions are left in *exception so they surface from the require() call that got us here
+  JSEvaluateScript(ctx, jsCode, nullptr, jsSourceURL, 0, exception);
+  return JSValueMakeUndefined(ctx);
+}
+
+void JSCExecutor::setSyncMethodCallback(SyncMethodCallback callback) {
+  m_syncMethodCallback = std::move(callback);
+  installGlobalFunction(m_context, "nativeCallSyncHook", &JSCExecutor::nativeCallSyncHook, this);
+}
+
+JSValueRef JSCExecutor::nativeCallSyncHook(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(function));
+  if (argumentCount < 3 || !executor->m_syncMethodCallback) {
+    return JSValueMakeNull(ctx);
+  }
+  int moduleId = Value(ctx, arguments[0]).asInteger();
+  int methodId = Value(ctx, arguments[1]).asInteger();
+
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.nativeCallSyncHook");
+  #endif
+  folly::dynamic result;
+  try {
+    // Balances the protection the Value releases when it goes out of scope
+    JSValueProtect(ctx, arguments[2]);
+    auto parameters = Value(ctx, arguments[2]).toDynamic();
+    result = executor->m_syncMethodCallback(moduleId, methodId, std::move(parameters));
+  } catch (const std::exception& e) {
+    // Surfaces in JS, where the sync call was made
+    String message(e.what());
+    JSValueRef messageValue = JSValueMakeString(ctx, message);
+    *exception = JSObjectMakeError(ctx, 1, &messageValue, nullptr);
+    return JSValueMakeUndefined(ctx);
+  }
+
+  if (isSmallValue(result)) {
+    return Value::fromDynamic(ctx, result);
+  }
+  String resultJSON(folly::toJson(result).c_str());
+  JSValueRef resultValue = JSValueMakeFromJSONString(ctx, resultJSON);
+  return resultValue ? resultValue : JSValueMakeNull(ctx);
+}
+
+void JSCExecutor::setModuleConfigCallbacks(
+    ModuleNamesCallback namesCallback,
+    ModuleConfigCallback configCallback) {
+  m_moduleNamesCallback = std::move(namesCallback);
+  m_moduleConfigCallback = std::move(configCallback);
+
+  JSClassDefinition definition = kJSClassDefinitionEmpty;
+  definition.className = "NativeModuleProxy";
+  definition.getProperty = &JSCExecutor::nativeModuleProxyGetProperty;
+  definition.getPropertyNames = &JSCExecutor::nativeModuleProxyGetPropertyNames;
+  JSClassRef proxyClass = JSClassCreate(&definition);
+  JSObjectRef proxy = JSObjectMake(m_context, proxyClass, this);
+  JSClassRelease(proxyClass);
+
+  String jsName("nativeModuleProxy");
+  JSObjectSetProperty(
+    m_context, JSContextGetGlobalObject(m_context), jsName, proxy, 0, nullptr);
+}
+
+JSValueRef JSCExecutor::nativeModuleProxyGetProperty(
+    JSContextRef ctx,
+    JSObjectRef object,
+    JSStringRef propertyName,
+    JSValueRef *exception) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(object));
+  std::string moduleName = String::ref(propertyName).str();
+
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(
+      TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.nativeModuleProxyGetProperty",
+      "module", moduleName);
+  #endif
+  std::string config;
+  try {
+    config = executor->m_moduleConfigCallback(moduleName);
+  } catch (const std::exception& e) {
+    String message(e.what());
+    JSValueRef messageValue = JSValueMakeString(ctx, message);
+    *exception = JSObjectMakeError(ctx, 1, &messageValue, nullptr);
+    return JSValueMakeUndefined(ctx);
+  }
+  if (config.empty()) {
+    // Not a module, let JSC look the property up on the prototype
+    return nullptr;
+  }
+  String configJSON(config.c_str());
+  return JSValueMakeFromJSONString(ctx, configJSON);
+}
+
+void JSCExecutor::nativeModuleProxyGetPropertyNames(
+    JSContextRef ctx,
+    JSObjectRef object,
+    JSPropertyNameAccumulatorRef propertyNames) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(object));
+  std::vector<std::string> moduleNames;
+  try {
+    moduleNames = executor->m_moduleNamesCallback();
+  } catch (const std::exception& e) {
+    FBLOGE("Could not list native modules: %s", e.what());
+    return;
+  }
+  for (const auto& moduleName : moduleNames) {
+    String jsName(moduleName.c_str());
+    JSPropertyNameAccumulatorAddName(propertyNames, jsName);
+  }
+}
+
 std::string JSCExecutor::executeJSCall(
     const std::string& moduleName,
     const std::string& methodName,
@@ -84,14 +414,199 @@ std::string JSCExecutor::executeJSCall(
       "method", methodName);
   #endif
 
-  // Evaluate script with JSC
-  folly::dynamic jsonArgs(arguments.begin(), arguments.end());
-  auto js = folly::to<folly::fbstring>(
-      "require('", moduleName, "').", methodName, ".apply(null, ",
-      folly::toJson(jsonArgs), ")");
-  auto result = evaluateScriptWithJSC(m_context, String(js.c_str()), nullptr);
-  JSValueProtect(m_context, result);
-  return Value(m_context, result).toJSONString();
+  std::chrono::steady_clock::duration conversionTime;
+  auto result = callJSFunction(moduleName, methodName, arguments, conversionTime);
+  if (result == nullptr) {
+    return "null";
+  }
+
+  auto conversionStart = std::chrono::steady_clock::now();
+  std::string flushedQueue;
+  Value resultValue(m_context, result);
+  if (resultValue.isString()) {
+    // A binary encoded batch, see kBinaryBatchMagic
+    flushedQueue = binaryStringToBytes(resultValue.toString());
+  } else {
+    flushedQueue = resultValue.toJSONString();
+  }
+
+  if (m_stats) {
+    conversionTime += std::chrono::steady_clock::now() - conversionStart;
+    m_stats->stringifyTime.record(toMicroseconds(conversionTime));
+  }
+  return flushedQueue;
+}
+
+std::vector<MethodCall> JSCExecutor::executeJSCallForMethodCalls(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments) {
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(
+      TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.executeJSCallForMethodCalls",
+      "module", moduleName,
+      "method", methodName);
+  #endif
+
+  std::chrono::steady_clock::duration conversionTime;
+  auto result = callJSFunction(moduleName, methodName, arguments, conversionTime);
+  if (result == nullptr) {
+    return std::vector<MethodCall>();
+  }
+
+  // A binary encoded batch is already a string, everything else is stringified by JSC. Either
+  // way the queue is parsed straight out of the string's UTF-16 buffer.
+  auto conversionStart = std::chrono::steady_clock::now();
+  Value resultValue(m_context, result);
+  String flushedQueue = resultValue.isString()
+    ? resultValue.toString()
+    : resultValue.createJSONString();
+  auto parseStart = std::chrono::steady_clock::now();
+  auto length = flushedQueue.length();
+  auto calls = parseMethodCalls(
+    reinterpret_cast<const uint16_t*>(JSStringGetCharactersPtr(flushedQueue)),
+    length);
+
+  if (m_stats) {
+    conversionTime += parseStart - conversionStart;
+    m_stats->stringifyTime.record(toMicroseconds(conversionTime));
+    m_stats->parseMethodCallsTime.record(
+      toMicroseconds(std::chrono::steady_clock::now() - parseStart));
+    m_stats->payloadBytes.record(length);
+  }
+  return calls;
+}
+
+JSValueRef JSCExecutor::callJSFunction(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments,
+    std::chrono::steady_clock::duration& conversionTime) {
+  conversionTime = std::chrono::steady_clock::duration::zero();
+  auto cachedFunction = getCachedJSFunction(moduleName, methodName);
+  if (cachedFunction == nullptr) {
+    return nullptr;
+  }
+
+  // The arguments live on the heap rather than the stack, so they must be protected from GC
+  // until the call returns.
+  auto conversionStart = std::chrono::steady_clock::now();
+  std::vector<JSValueRef> jsArguments;
+  jsArguments.reserve(arguments.size());
+  for (const auto& argument : arguments) {
+    JSValueRef jsArgument;
+    if (isSmallValue(argument)) {
+      // Takes its own protection, the Value releases one when it goes out of scope
+      Value jsValue(Value::fromDynamic(m_context, argument));
+      jsArgument = jsValue;
+      JSValueProtect(m_context, jsArgument);
+    } else {
+      String argumentJSON(folly::toJson(argument).c_str());
+      jsArgument = JSValueMakeFromJSONString(m_context, argumentJSON);
+      if (jsArgument == nullptr) {
+        jsArgument = JSValueMakeNull(m_context);
+      }
+      JSValueProtect(m_context, jsArgument);
+    }
+    jsArguments.push_back(jsArgument);
+  }
+
+  if (m_samplingProfiler) {
+    auto section = folly::to<std::string>(moduleName, ".", methodName);
+    m_samplingProfiler->enterSection(section.data(), section.size());
+  }
+  JSValueRef exn = nullptr;
+  bool trackHeap = shouldTrackHeap();
+  auto heapSizeBefore = trackHeap ? jscHeapSize(m_context) : 0;
+  auto jsStart = std::chrono::steady_clock::now();
+  auto result = JSObjectCallAsFunction(
+      m_context,
+      cachedFunction->function,
+      cachedFunction->module,
+      jsArguments.size(),
+      jsArguments.data(),
+      &exn);
+  auto jsEnd = std::chrono::steady_clock::now();
+  if (trackHeap) {
+    recordHeapChange(heapSizeBefore, jscHeapSize(m_context), jsEnd - jsStart);
+  }
+  if (m_samplingProfiler) {
+    m_samplingProfiler->exitSection();
+  }
+  #ifdef WITH_JSC_EXTRA_TRACING
+  // Once per call keeps markers from waiting longer than about a frame
+  flushPerfLoggingMarkers();
+  #endif
+
+  for (auto jsArgument : jsArguments) {
+    JSValueUnprotect(m_context, jsArgument);
+  }
+
+  if (result == nullptr) {
+    logJSException(m_context, exn);
+  } else {
+    JSValueProtect(m_context, result);
+  }
+
+  conversionTime = jsStart - conversionStart;
+  if (m_stats) {
+    m_stats->jsExecutionTime.record(toMicroseconds(jsEnd - jsStart));
+  }
+  return result;
+}
+
+const JSCExecutor::CachedJSFunction* JSCExecutor::getCachedJSFunction(
+    const std::string& moduleName,
+    const std::string& methodName) {
+  auto key = folly::to<std::string>(moduleName, ".", methodName);
+  auto it = m_cachedFunctions.find(key);
+  if (it != m_cachedFunctions.end()) {
+    return &it->second;
+  }
+
+  JSValueRef exn = nullptr;
+  auto globalObject = JSContextGetGlobalObject(m_context);
+  auto require = JSObjectGetProperty(m_context, globalObject, String("require"), &exn);
+  if (require == nullptr || !JSValueIsObject(m_context, require)) {
+    FBLOGE("Unable to resolve require() while calling %s", key.c_str());
+    return nullptr;
+  }
+
+  JSValueRef jsModuleName = JSValueMakeString(m_context, String(moduleName.c_str()));
+  auto module = JSObjectCallAsFunction(
+      m_context, (JSObjectRef) require, nullptr, 1, &jsModuleName, &exn);
+  if (module == nullptr) {
+    logJSException(m_context, exn);
+    return nullptr;
+  }
+  if (!JSValueIsObject(m_context, module)) {
+    FBLOGE("Module %s is not an object", moduleName.c_str());
+    return nullptr;
+  }
+
+  auto moduleObj = (JSObjectRef) module;
+  auto function = JSObjectGetProperty(m_context, moduleObj, String(methodName.c_str()), &exn);
+  if (function == nullptr ||
+      !JSValueIsObject(m_context, function) ||
+      !JSObjectIsFunction(m_context, (JSObjectRef) function)) {
+    FBLOGE("%s is not a function", key.c_str());
+    return nullptr;
+  }
+
+  auto functionObj = (JSObjectRef) function;
+  JSValueProtect(m_context, moduleObj);
+  JSValueProtect(m_context, functionObj);
+  auto inserted = m_cachedFunctions.emplace(
+      std::move(key), CachedJSFunction { moduleObj, functionObj });
+  return &inserted.first->second;
+}
+
+void JSCExecutor::clearCachedJSFunctions() {
+  for (const auto& entry : m_cachedFunctions) {
+    JSValueUnprotect(m_context, entry.second.module);
+    JSValueUnprotect(m_context, entry.second.function);
+  }
+  m_cachedFunctions.clear();
 }
 
 void JSCExecutor::setGlobalVariable(const std::string& propName, const std::string& jsonValue) {
@@ -104,6 +619,170 @@ void JSCExecutor::setGlobalVariable(const std::string& propName, const std::stri
   JSObjectSetProperty(m_context, globalObject, jsPropertyName, valueToInject, 0, NULL);
 }
 
+void JSCExecutor::setStats(BridgeStats* stats) {
+  m_stats = stats;
+}
+
+void JSCExecutor::collectGarbage() {
+  #ifdef WITH_FBSYSTRACE
+  FbSystraceSection s(TRACE_TAG_REACT_CXX_BRIDGE, "JSCExecutor.collectGarbage");
+  #endif
+  ScopedHistogramTimer timer(m_stats ? &m_stats->collectGarbageTime : nullptr);
+  // Only a hint, JSC collects when it sees fit
+  JSGarbageCollect(m_context);
+}
+
+void JSCExecutor::handleIdle() {
+  auto now = std::chrono::steady_clock::now();
+  if (m_options.idleCollectionInterval.count() <= 0 ||
+      now - m_lastIdleCollectionTime < m_options.idleCollectionInterval) {
+    return;
+  }
+  // Also spaces out the heap size checks, which walk the heap
+  m_lastIdleCollectionTime = now;
+
+  auto heapSize = jscHeapSize(m_context);
+  if (heapSize > 0 &&
+      (heapSize < static_cast<int64_t>(m_options.idleCollectionMinHeapSize) ||
+       heapSize - m_heapSizeAfterIdleCollection <
+         static_cast<int64_t>(m_options.idleCollectionHeapGrowth))) {
+    return;
+  }
+
+  collectGarbage();
+  if (heapSize > 0) {
+    m_heapSizeAfterIdleCollection = jscHeapSize(m_context);
+  }
+}
+
+bool JSCExecutor::shouldTrackHeap() {
+  if (m_samplingProfiler) {
+    return true;
+  }
+  #ifdef WITH_FBSYSTRACE
+  return fbsystrace_is_tracing(TRACE_TAG_REACT_CXX_BRIDGE);
+  #else
+  return false;
+  #endif
+}
+
+void JSCExecutor::recordHeapChange(
+    int64_t heapSizeBefore,
+    int64_t heapSizeAfter,
+    std::chrono::steady_clock::duration jsExecutionTime) {
+  if (heapSizeAfter == 0) {
+    return;
+  }
+  // JSC doesn't report collections, but nothing else makes the heap shrink
+  bool collected = heapSizeAfter < heapSizeBefore;
+  if (m_stats) {
+    m_stats->heapSizeKB.record(heapSizeAfter / 1024);
+    if (collected) {
+      m_stats->jsExecutionTimeWithGC.record(toMicroseconds(jsExecutionTime));
+      m_stats->gcReclaimedKB.record((heapSizeBefore - heapSizeAfter) / 1024);
+    }
+  }
+  #ifdef WITH_FBSYSTRACE
+  fbsystrace_counter(TRACE_TAG_REACT_CXX_BRIDGE, "JSC heap size", heapSizeAfter);
+  if (collected) {
+    fbsystrace_counter(
+      TRACE_TAG_REACT_CXX_BRIDGE, "JSC GC reclaimed", heapSizeBefore - heapSizeAfter);
+  }
+  #endif
+}
+
+bool JSCExecutor::supportsSamplingProfiler() {
+  return true;
+}
+
+void JSCExecutor::startSamplingProfiler(int intervalUs, int maxSamples) {
+  if (m_samplingProfiler) {
+    return;
+  }
+  JSCSamplingProfiler::Options options;
+  if (intervalUs > 0) {
+    options.interval = std::chrono::microseconds(intervalUs);
+  }
+  if (maxSamples > 0) {
+    options.maxSamples = maxSamples;
+  }
+  m_samplingProfiler.reset(new JSCSamplingProfiler(options));
+  // Makes BridgeProfiling open its sections
+  setGlobalVariable("__BridgeProfilingIsProfiling", "true");
+}
+
+bool JSCExecutor::stopSamplingProfiler(const std::string& filename) {
+  if (!m_samplingProfiler) {
+    return false;
+  }
+  setGlobalVariable("__BridgeProfilingIsProfiling", "false");
+  bool written = m_samplingProfiler->stopAndWriteTrace(filename);
+  m_samplingProfiler.reset();
+  return written;
+}
+
+// The buffered trace recording the section's tag, if any
+static TraceBuffer* sectionTraceBuffer(
+    JSContextRef ctx,
+    size_t argumentCount,
+    const JSValueRef arguments[]) {
+  TraceBuffer* buffer = TraceBuffer::active();
+  if (!buffer || argumentCount < 1) {
+    return nullptr;
+  }
+  auto tag = static_cast<uint64_t>(JSValueToNumber(ctx, arguments[0], nullptr));
+  return buffer->isTracing(tag) ? buffer : nullptr;
+}
+
+JSValueRef JSCExecutor::nativeSamplingProfilerBeginSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(function));
+  // console.profile(tag, name)
+  TraceBuffer* buffer = sectionTraceBuffer(ctx, argumentCount, arguments);
+  if ((!executor->m_samplingProfiler && !buffer) || argumentCount < 2) {
+    return JSValueMakeUndefined(ctx);
+  }
+  String name = String::adopt(JSValueToStringCopy(ctx, arguments[1], nullptr));
+  const JSChar* chars = JSStringGetCharactersPtr(name);
+  size_t length = name.length();
+  if (buffer) {
+    buffer->beginSection(buffer->internName(chars, length));
+  }
+  if (!executor->m_samplingProfiler) {
+    return JSValueMakeUndefined(ctx);
+  }
+  // Names are ASCII identifiers up to the arguments, which the profiler drops anyway
+  std::string section;
+  section.reserve(std::min<size_t>(length, 128));
+  for (size_t i = 0; i < length && section.size() < 128 && chars[i] != '('; i++) {
+    section.push_back(chars[i] < 0x80 ? static_cast<char>(chars[i]) : '?');
+  }
+  executor->m_samplingProfiler->enterSection(section.data(), section.size());
+  return JSValueMakeUndefined(ctx);
+}
+
+JSValueRef JSCExecutor::nativeSamplingProfilerEndSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception) {
+  auto executor = static_cast<JSCExecutor*>(JSObjectGetPrivate(function));
+  if (TraceBuffer* buffer = sectionTraceBuffer(ctx, argumentCount, arguments)) {
+    buffer->endSection();
+  }
+  if (executor->m_samplingProfiler) {
+    executor->m_samplingProfiler->exitSection();
+  }
+  return JSValueMakeUndefined(ctx);
+}
+
 bool JSCExecutor::supportsProfiling() {
   #ifdef WITH_FBSYSTRACE
   return true;
@@ -2,40 +2,167 @@
 
 #pragma once
 
+#include <chrono>
+#include <unordered_map>
 #include <JavaScriptCore/JSContextRef.h>
+#include "BridgeStats.h"
 #include "Executor.h"
 #include "JSCHelpers.h"
+#include "JSCSamplingProfiler.h"
+#include "JSIndexedBundle.h"
 
 namespace facebook {
 namespace react {
 
+// When an executor collects garbage while the bridge is idle. JSC has no public API to size its
+// heap up front or to make its own collector more or less eager, so this is what can be tuned:
+// devices with little memory want to collect more often and at smaller heap sizes.
+struct JSCExecutorOptions {
+  // At most one idle collection per interval, zero turns them off
+  std::chrono::milliseconds idleCollectionInterval{10000};
+  // Idle collections also wait for the heap to hold this many bytes, and to grow by
+  // idleCollectionHeapGrowth since the last one. Ignored if this JSC build can't tell its heap
+  // size.
+  size_t idleCollectionMinHeapSize = 16 * 1024 * 1024;
+  size_t idleCollectionHeapGrowth = 4 * 1024 * 1024;
+  // Drive the executor from a native thread the Bridge owns instead of the JS queue thread
+  bool useNativeJSThread = false;
+  // Create the context in a process-wide group, shared with the other executors that ask for it,
+  // instead of in a group of its own. See sharedContextGroup in JSCExecutor.cpp for the trade-off.
+  bool shareContextGroup = false;
+};
+
 class JSCExecutorFactory : public JSExecutorFactory {
 public:
+  explicit JSCExecutorFactory(JSCExecutorOptions options = JSCExecutorOptions()) :
+    m_options(options) {}
   virtual std::unique_ptr<JSExecutor> createJSExecutor() override;
+  virtual bool canRunOnNativeJSThread() override;
+
+  // Creates a context with the global hooks installed ahead of time, for the next executor that
+  // has a context group of its own to take. Slow, call it off the UI thread before a bridge is
+  // created or reloaded.
+  static void prepareWarmContext();
+
+private:
+  JSCExecutorOptions m_options;
 };
 
 class JSCExecutor : public JSExecutor {
 public:
-  JSCExecutor();
+  explicit JSCExecutor(JSCExecutorOptions options = JSCExecutorOptions());
   ~JSCExecutor() override;
+  using JSExecutor::executeApplicationScript;
   virtual void executeApplicationScript(
-    const std::string& script,
+    std::unique_ptr<const JSBigString> script,
     const std::string& sourceURL) override;
   virtual std::string executeJSCall(
     const std::string& moduleName,
     const std::string& methodName,
     const std::vector<folly::dynamic>& arguments) override;
+  virtual std::vector<MethodCall> executeJSCallForMethodCalls(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments) override;
   virtual void setGlobalVariable(
     const std::string& propName,
     const std::string& jsonValue) override;
   virtual bool supportsProfiling() override;
   virtual void startProfiler(const std::string &titleString) override;
   virtual void stopProfiler(const std::string &titleString, const std::string &filename) override;
+  virtual void setStats(BridgeStats* stats) override;
+  virtual void collectGarbage() override;
+  virtual void handleIdle() override;
+  virtual bool supportsSamplingProfiler() override;
+  virtual void startSamplingProfiler(int intervalUs, int maxSamples) override;
+  virtual bool stopSamplingProfiler(const std::string& filename) override;
+  virtual void setSyncMethodCallback(SyncMethodCallback callback) override;
+  virtual void setModuleConfigCallbacks(
+    ModuleNamesCallback namesCallback,
+    ModuleConfigCallback configCallback) override;
 
   void installNativeHook(const char *name, JSObjectCallAsFunctionCallback callback);
 
 private:
+  // A resolved `require('<module>').<method>` pair. Both objects are protected while cached.
+  struct CachedJSFunction {
+    JSObjectRef module;
+    JSObjectRef function;
+  };
+
   JSGlobalContextRef m_context;
+  BridgeStats* m_stats;
+  JSCExecutorOptions m_options;
+  std::chrono::steady_clock::time_point m_lastIdleCollectionTime;
+  int64_t m_heapSizeAfterIdleCollection;
+  std::unordered_map<std::string, CachedJSFunction> m_cachedFunctions;
+  // Set while an indexed bundle is loaded, modules are evaluated out of it by nativeRequire()
+  std::unique_ptr<const JSIndexedBundle> m_indexedBundle;
+  std::string m_indexedBundleSourceURL;
+  // Set while sampling, fed by bridge calls and the JS trace section hooks
+  std::unique_ptr<JSCSamplingProfiler> m_samplingProfiler;
+  SyncMethodCallback m_syncMethodCallback;
+  ModuleNamesCallback m_moduleNamesCallback;
+  ModuleConfigCallback m_moduleConfigCallback;
+
+  const CachedJSFunction* getCachedJSFunction(
+    const std::string& moduleName,
+    const std::string& methodName);
+  void clearCachedJSFunctions();
+  // Reading the heap size walks the heap, so it is only done while tracing or sampling
+  bool shouldTrackHeap();
+  void recordHeapChange(
+    int64_t heapSizeBefore,
+    int64_t heapSizeAfter,
+    std::chrono::steady_clock::duration jsExecutionTime);
+  // Returns the protected result, or null if the function is missing or threw. Argument
+  // conversion time is reported through conversionTime.
+  JSValueRef callJSFunction(
+    const std::string& moduleName,
+    const std::string& methodName,
+    const std::vector<folly::dynamic>& arguments,
+    std::chrono::steady_clock::duration& conversionTime);
+  void executeIndexedBundle(
+    std::unique_ptr<const JSBigString> script,
+    const std::string& sourceURL);
+
+  static JSValueRef nativeSamplingProfilerBeginSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception);
+  static JSValueRef nativeSamplingProfilerEndSection(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception);
+  static JSValueRef nativeCallSyncHook(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception);
+  static JSValueRef nativeModuleProxyGetProperty(
+    JSContextRef ctx,
+    JSObjectRef object,
+    JSStringRef propertyName,
+    JSValueRef *exception);
+  static void nativeModuleProxyGetPropertyNames(
+    JSContextRef ctx,
+    JSObjectRef object,
+    JSPropertyNameAccumulatorRef propertyNames);
+  static JSValueRef nativeRequire(
+    JSContextRef ctx,
+    JSObjectRef function,
+    JSObjectRef thisObject,
+    size_t argumentCount,
+    const JSValueRef arguments[],
+    JSValueRef *exception);
 };
 
 } }
@@ -19,4 +19,23 @@ void installGlobalFunction(
   JSStringRelease(jsName);
 }
 
+void installGlobalFunction(
+    JSGlobalContextRef ctx,
+    const char* name,
+    JSObjectCallAsFunctionCallback callback,
+    void* privateData) {
+  // Plain function objects have no private storage, so use a callable object of our own class
+  JSClassDefinition definition = kJSClassDefinitionEmpty;
+  definition.className = name;
+  definition.callAsFunction = callback;
+  JSClassRef functionClass = JSClassCreate(&definition);
+  JSObjectRef functionObj = JSObjectMake(ctx, functionClass, privateData);
+  JSClassRelease(functionClass);
+
+  JSStringRef jsName = JSStringCreateWithUTF8CString(name);
+  JSObjectRef globalObject = JSContextGetGlobalObject(ctx);
+  JSObjectSetProperty(ctx, globalObject, jsName, functionObj, 0, NULL);
+  JSStringRelease(jsName);
+}
+
 } }
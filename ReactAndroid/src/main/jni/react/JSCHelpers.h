@@ -13,4 +13,14 @@ void installGlobalFunction(
     const char* name,
     JSObjectCallAsFunctionCallback callback);
 
+/**
+ * Like the above, but the callback can recover privateData through
+ * JSObjectGetPrivate(function).
+ */
+void installGlobalFunction(
+    JSGlobalContextRef ctx,
+    const char* name,
+    JSObjectCallAsFunctionCallback callback,
+    void* privateData);
+
 } }
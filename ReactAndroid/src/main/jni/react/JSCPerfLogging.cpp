@@ -1,7 +1,12 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 
-#include "JSCHelpers.h"
+#include "JSCPerfLogging.h"
+
+#include <time.h>
+#include <vector>
+#include <fb/ThreadLocal.h>
 #include <jni/fbjni.h>
+#include "JSCHelpers.h"
 
 using namespace facebook::jni;
 
@@ -22,46 +27,48 @@ class JObjectWrapper<jqpl> : public JObject {
 
   using JObjectWrapper<jobject>::JObjectWrapper;
 
+  static alias_ref<jclass> javaClassStatic() {
+    static auto cls = findClassStatic("com/facebook/quicklog/QuickPerformanceLogger");
+    return cls;
+  }
+
   void markerStart(int markerId, int instanceKey, long timestamp) {
-    static auto markerStartMethod =
-      qplClass()->getMethod<void(int32_t, int32_t, int64_t)>("markerStart");
-    markerStartMethod(this_, markerId, instanceKey, timestamp);
+    markerStartMethod.get()(this_, markerId, instanceKey, timestamp);
   }
 
   void markerEnd(int markerId, int instanceKey, short actionId, long timestamp) {
-    static auto markerEndMethod =
-      qplClass()->getMethod<void(int32_t, int32_t, int16_t, int64_t)>("markerEnd");
-    markerEndMethod(this_, markerId, instanceKey, actionId, timestamp);
+    markerEndMethod.get()(this_, markerId, instanceKey, actionId, timestamp);
   }
 
   void markerNote(int markerId, int instanceKey, short actionId, long timestamp) {
-    static auto markerNoteMethod =
-      qplClass()->getMethod<void(int32_t, int32_t, int16_t, int64_t)>("markerNote");
-    markerNoteMethod(this_, markerId, instanceKey, actionId, timestamp);
+    markerNoteMethod.get()(this_, markerId, instanceKey, actionId, timestamp);
   }
 
   void markerCancel(int markerId, int instanceKey) {
-    static auto markerCancelMethod =
-      qplClass()->getMethod<void(int32_t, int32_t)>("markerCancel");
-    markerCancelMethod(this_, markerId, instanceKey);
-  }
-
-  int64_t currentMonotonicTimestamp() {
-    static auto currentTimestampMethod =
-      qplClass()->getMethod<int64_t()>("currentMonotonicTimestamp");
-    return currentTimestampMethod(this_);
+    markerCancelMethod.get()(this_, markerId, instanceKey);
   }
 
  private:
-
-  static alias_ref<jclass> qplClass() {
-    static auto cls = findClassStatic("com/facebook/quicklog/QuickPerformanceLogger");
-    return cls;
-  }
-
+  // QuickPerformanceLogger isn't always present, so these are only looked up once a marker is
+  // dispatched
+  static JMemberId<JObjectWrapper, JMethod<void(int32_t, int32_t, int64_t)>> markerStartMethod;
+  static JMemberId<JObjectWrapper, JMethod<void(int32_t, int32_t, int16_t, int64_t)>>
+    markerEndMethod;
+  static JMemberId<JObjectWrapper, JMethod<void(int32_t, int32_t, int16_t, int64_t)>>
+    markerNoteMethod;
+  static JMemberId<JObjectWrapper, JMethod<void(int32_t, int32_t)>> markerCancelMethod;
 };
 using JQuickPerformanceLogger = JObjectWrapper<jqpl>;
 
+JMemberId<JQuickPerformanceLogger, JMethod<void(int32_t, int32_t, int64_t)>>
+  JQuickPerformanceLogger::markerStartMethod{"markerStart"};
+JMemberId<JQuickPerformanceLogger, JMethod<void(int32_t, int32_t, int16_t, int64_t)>>
+  JQuickPerformanceLogger::markerEndMethod{"markerEnd"};
+JMemberId<JQuickPerformanceLogger, JMethod<void(int32_t, int32_t, int16_t, int64_t)>>
+  JQuickPerformanceLogger::markerNoteMethod{"markerNote"};
+JMemberId<JQuickPerformanceLogger, JMethod<void(int32_t, int32_t)>>
+  JQuickPerformanceLogger::markerCancelMethod{"markerCancel"};
+
 
 template<>
 class JObjectWrapper<jqplProvider> : public JObject {
@@ -117,6 +124,91 @@ static bool grabDoubles(
   return true;
 }
 
+namespace {
+
+enum class MarkerType : uint8_t {
+  Start,
+  End,
+  Note,
+  Cancel,
+};
+
+struct Marker {
+  MarkerType type;
+  int16_t actionId;
+  int32_t markerId;
+  int32_t instanceKey;
+  int64_t timestamp;
+};
+
+// Markers from JS are queued and handed to QuickPerformanceLogger in batches: when no marker is
+// left open, when the queue fills up, and after every call into JS. Timestamps travel with the
+// markers, so dispatching them late doesn't change what gets logged.
+const size_t kMaxQueuedMarkers = 128;
+
+// Only touched by the thread that owns it, JS contexts stay on one thread
+struct MarkerQueue {
+  std::vector<Marker> markers;
+  int openMarkers = 0;
+};
+
+MarkerQueue& markerQueue() {
+  static auto queues = new facebook::ThreadLocal<MarkerQueue>();
+  if (queues->get() == nullptr) {
+    queues->reset(new MarkerQueue());
+    (*queues)->markers.reserve(kMaxQueuedMarkers);
+  }
+  return **queues;
+}
+
+void dispatchMarkers(MarkerQueue& queue) {
+  if (queue.markers.empty()) {
+    return;
+  }
+  auto qpl = JQuickPerformanceLoggerProvider::get();
+  for (const auto& marker : queue.markers) {
+    switch (marker.type) {
+      case MarkerType::Start:
+        qpl->markerStart(marker.markerId, marker.instanceKey, marker.timestamp);
+        break;
+      case MarkerType::End:
+        qpl->markerEnd(marker.markerId, marker.instanceKey, marker.actionId, marker.timestamp);
+        break;
+      case MarkerType::Note:
+        qpl->markerNote(marker.markerId, marker.instanceKey, marker.actionId, marker.timestamp);
+        break;
+      case MarkerType::Cancel:
+        qpl->markerCancel(marker.markerId, marker.instanceKey);
+        break;
+    }
+  }
+  queue.markers.clear();
+}
+
+void queueMarker(MarkerType type, int32_t markerId, int32_t instanceKey, int16_t actionId,
+                 int64_t timestamp) {
+  auto& queue = markerQueue();
+  queue.markers.push_back({ type, actionId, markerId, instanceKey, timestamp });
+  if (type == MarkerType::Start) {
+    queue.openMarkers++;
+  } else if (type != MarkerType::Note && queue.openMarkers > 0) {
+    queue.openMarkers--;
+  }
+  if (queue.openMarkers == 0 || queue.markers.size() >= kMaxQueuedMarkers) {
+    dispatchMarkers(queue);
+  }
+}
+
+// QuickPerformanceLogger timestamps are SystemClock.uptimeMillis(), which is CLOCK_MONOTONIC in
+// milliseconds, so JS can read them without calling into Java
+int64_t currentMonotonicTimestamp() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+}
+
 static JSValueRef nativeQPLMarkerStart(
     JSContextRef ctx,
     JSObjectRef function,
@@ -129,7 +221,7 @@ static JSValueRef nativeQPLMarkerStart(
     int32_t markerId = (int32_t) targets[0];
     int32_t instanceKey = (int32_t) targets[1];
     int64_t timestamp = (int64_t) targets[2];
-    JQuickPerformanceLoggerProvider::get()->markerStart(markerId, instanceKey, timestamp);
+    queueMarker(MarkerType::Start, markerId, instanceKey, 0, timestamp);
   }
   return JSValueMakeUndefined(ctx);
 }
@@ -147,7 +239,7 @@ static JSValueRef nativeQPLMarkerEnd(
     int32_t instanceKey = (int32_t) targets[1];
     int16_t actionId = (int16_t) targets[2];
     int64_t timestamp = (int64_t) targets[3];
-    JQuickPerformanceLoggerProvider::get()->markerEnd(markerId, instanceKey, actionId, timestamp);
+    queueMarker(MarkerType::End, markerId, instanceKey, actionId, timestamp);
   }
   return JSValueMakeUndefined(ctx);
 }
@@ -165,7 +257,7 @@ static JSValueRef nativeQPLMarkerNote(
     int32_t instanceKey = (int32_t) targets[1];
     int16_t actionId = (int16_t) targets[2];
     int64_t timestamp = (int64_t) targets[3];
-    JQuickPerformanceLoggerProvider::get()->markerNote(markerId, instanceKey, actionId, timestamp);
+    queueMarker(MarkerType::Note, markerId, instanceKey, actionId, timestamp);
   }
   return JSValueMakeUndefined(ctx);
 }
@@ -181,7 +273,7 @@ static JSValueRef nativeQPLMarkerCancel(
   if (grabDoubles(2, targets, ctx, argumentCount, arguments, exception)) {
     int32_t markerId = (int32_t) targets[0];
     int32_t instanceKey = (int32_t) targets[1];
-    JQuickPerformanceLoggerProvider::get()->markerCancel(markerId, instanceKey);
+    queueMarker(MarkerType::Cancel, markerId, instanceKey, 0, 0);
   }
   return JSValueMakeUndefined(ctx);
 }
@@ -193,7 +285,7 @@ static JSValueRef nativeQPLTimestamp(
     size_t argumentCount,
     const JSValueRef arguments[],
     JSValueRef* exception) {
-  int64_t timestamp = JQuickPerformanceLoggerProvider::get()->currentMonotonicTimestamp();
+  int64_t timestamp = currentMonotonicTimestamp();
   // Since this is monotonic time, I assume the 52 bits of mantissa are enough in the double value.
   return JSValueMakeNumber(ctx, timestamp);
 }
@@ -209,4 +301,8 @@ void addNativePerfLoggingHooks(JSGlobalContextRef ctx) {
   installGlobalFunction(ctx, "nativeQPLTimestamp", nativeQPLTimestamp);
 }
 
+void flushPerfLoggingMarkers() {
+  dispatchMarkers(markerQueue());
+}
+
 } }
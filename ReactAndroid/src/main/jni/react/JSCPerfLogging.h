@@ -7,5 +7,7 @@ namespace facebook {
 namespace react {
 
 void addNativePerfLoggingHooks(JSGlobalContextRef ctx);
+// Hands the markers JS queued on this thread to QuickPerformanceLogger
+void flushPerfLoggingMarkers();
 
 } }
@@ -0,0 +1,221 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSCSamplingProfiler.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <map>
+#include <string.h>
+#include <unistd.h>
+#include <fb/log.h>
+#include <folly/Conv.h>
+#include "TraceWriter.h"
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// How often the sampler retries a stack that changed while it was being copied
+const int kMaxSampleAttempts = 4;
+
+// Names 0 and 1: samples taken while the JS thread was in no section, and every section name
+// past kMaxNames
+const char kIdleName[] = "(idle)";
+const char kOverflowName[] = "(other)";
+
+}
+
+JSCSamplingProfiler::JSCSamplingProfiler(Options options) :
+  m_options(options),
+  m_generation(0),
+  m_depth(0),
+  m_overflowDepth(0),
+  m_nextSample(0),
+  m_droppedSamples(0),
+  m_stopping(false),
+  m_startTime(std::chrono::steady_clock::now()) {
+  for (auto& frame : m_stack) {
+    frame.store(0, std::memory_order_relaxed);
+  }
+  m_names.push_back(kIdleName);
+  m_names.push_back(kOverflowName);
+  m_samples.resize(std::max<size_t>(m_options.maxSamples, 1));
+  m_samplerThread = std::thread(&JSCSamplingProfiler::samplerLoop, this);
+}
+
+JSCSamplingProfiler::~JSCSamplingProfiler() {
+  stop();
+}
+
+uint32_t JSCSamplingProfiler::internName(const char* name, size_t length) {
+  // Bridge calls are profiled as `Module.method(<arguments>)`; the arguments would make every
+  // call unique, so only the part before them is kept
+  const char* arguments = static_cast<const char*>(memchr(name, '(', length));
+  if (arguments != nullptr && arguments != name) {
+    length = arguments - name;
+  }
+  std::string key(name, length);
+  auto it = m_nameIds.find(key);
+  if (it != m_nameIds.end()) {
+    return it->second;
+  }
+  if (m_names.size() >= kMaxNames) {
+    return 1;
+  }
+  uint32_t id = m_names.size();
+  m_names.push_back(key);
+  m_nameIds.emplace(std::move(key), id);
+  return id;
+}
+
+void JSCSamplingProfiler::enterSection(const char* name, size_t length) {
+  uint32_t depth = m_depth.load(std::memory_order_relaxed);
+  if (depth == kMaxDepth) {
+    m_overflowDepth++;
+    return;
+  }
+  uint32_t id = internName(name, length);
+  m_generation.fetch_add(1, std::memory_order_acq_rel);
+  m_stack[depth].store(id, std::memory_order_relaxed);
+  m_depth.store(depth + 1, std::memory_order_relaxed);
+  m_generation.fetch_add(1, std::memory_order_release);
+}
+
+void JSCSamplingProfiler::exitSection() {
+  if (m_overflowDepth > 0) {
+    m_overflowDepth--;
+    return;
+  }
+  uint32_t depth = m_depth.load(std::memory_order_relaxed);
+  // Sections opened before the profiler started are closed without ever having been entered
+  if (depth == 0) {
+    return;
+  }
+  m_generation.fetch_add(1, std::memory_order_acq_rel);
+  m_depth.store(depth - 1, std::memory_order_relaxed);
+  m_generation.fetch_add(1, std::memory_order_release);
+}
+
+bool JSCSamplingProfiler::takeSample(Sample& sample) {
+  for (int attempt = 0; attempt < kMaxSampleAttempts; attempt++) {
+    uint32_t generation = m_generation.load(std::memory_order_acquire);
+    if (generation & 1) {
+      continue;
+    }
+    sample.depth = m_depth.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < sample.depth; i++) {
+      sample.frames[i] = m_stack[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_generation.load(std::memory_order_relaxed) == generation) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void JSCSamplingProfiler::samplerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto nextSampleTime = std::chrono::steady_clock::now();
+  while (!m_stopping) {
+    nextSampleTime += m_options.interval;
+    if (m_stopCondition.wait_until(lock, nextSampleTime, [this] { return m_stopping; })) {
+      break;
+    }
+    auto& sample = m_samples[m_nextSample % m_samples.size()];
+    if (!takeSample(sample)) {
+      m_droppedSamples++;
+      continue;
+    }
+    sample.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - m_startTime).count();
+    m_nextSample++;
+  }
+}
+
+void JSCSamplingProfiler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_stopCondition.notify_all();
+  if (m_samplerThread.joinable()) {
+    m_samplerThread.join();
+  }
+}
+
+bool JSCSamplingProfiler::stopAndWriteTrace(int fd) {
+  stop();
+
+  auto pid = folly::to<std::string>(getpid());
+  TraceWriter writer(fd);
+  writer.append(
+    "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":1,"
+    "\"args\":{\"name\":\"JS\"}}],\"samples\":[");
+
+  // Stack frames form a tree, one node per distinct (parent, name) path
+  std::map<std::pair<uint32_t, uint32_t>, uint32_t> frameIds;
+  std::vector<std::pair<uint32_t, uint32_t>> frames;
+  auto frameFor = [&] (uint32_t parent, uint32_t name) {
+    auto key = std::make_pair(parent, name);
+    auto it = frameIds.find(key);
+    if (it != frameIds.end()) {
+      return it->second;
+    }
+    // Frame ids start at 1, 0 means no parent
+    uint32_t id = frames.size() + 1;
+    frames.push_back(key);
+    frameIds.emplace(key, id);
+    return id;
+  };
+
+  size_t count = std::min(m_nextSample, m_samples.size());
+  size_t first = m_nextSample - count;
+  for (size_t i = first; i < m_nextSample; i++) {
+    const auto& sample = m_samples[i % m_samples.size()];
+    uint32_t frame = 0;
+    if (sample.depth == 0) {
+      frame = frameFor(0, 0);
+    }
+    for (uint32_t depth = 0; depth < sample.depth; depth++) {
+      frame = frameFor(frame, sample.frames[depth]);
+    }
+    writer.append(folly::to<std::string>(
+      i == first ? "" : ",",
+      "{\"name\":\"js\",\"pid\":", pid, ",\"tid\":1,\"ts\":", sample.timestampUs,
+      ",\"sf\":", frame, ",\"weight\":1}"));
+  }
+
+  writer.append("],\"stackFrames\":{");
+  for (size_t i = 0; i < frames.size(); i++) {
+    std::string frame = folly::to<std::string>(
+      i == 0 ? "" : ",",
+      "\"", i + 1, "\":{\"category\":\"js\",\"name\":", TraceWriter::quote(m_names[frames[i].second]));
+    if (frames[i].first != 0) {
+      frame += folly::to<std::string>(",\"parent\":\"", frames[i].first, "\"");
+    }
+    writer.append(frame + "}");
+  }
+  writer.append(folly::to<std::string>(
+    "},\"metadata\":{\"intervalUs\":", m_options.interval.count(),
+    ",\"droppedSamples\":", m_droppedSamples,
+    ",\"overwrittenSamples\":", first, "}}\n"));
+  return writer.flush();
+}
+
+bool JSCSamplingProfiler::stopAndWriteTrace(const std::string& filename) {
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    FBLOGE("Unable to open %s for the sampling profile: %s", filename.c_str(), strerror(errno));
+    stop();
+    return false;
+  }
+  bool written = stopAndWriteTrace(fd);
+  close(fd);
+  return written;
+}
+
+} }
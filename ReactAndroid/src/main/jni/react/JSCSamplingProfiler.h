@@ -0,0 +1,88 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+/**
+ * A low overhead profiler for release-like builds. The JS thread keeps a shadow stack of the
+ * sections it is in (bridge calls, plus the BridgeProfiling sections JS opens while
+ * __BridgeProfilingIsProfiling is set) and a sampler thread records that stack at a fixed
+ * interval into a ring buffer. JSC has no public API to walk JS frames from another thread, so
+ * sections are the finest granularity available.
+ *
+ * The result is written as Chrome trace-event JSON, which chrome://tracing loads as is.
+ */
+class JSCSamplingProfiler {
+public:
+  struct Options {
+    std::chrono::microseconds interval{std::chrono::milliseconds(5)};
+    // Oldest samples are overwritten once the buffer is full
+    size_t maxSamples = 20000;
+  };
+
+  explicit JSCSamplingProfiler(Options options);
+  ~JSCSamplingProfiler();
+
+  // Called on the JS thread only
+  void enterSection(const char* name, size_t length);
+  void exitSection();
+
+  // Stops sampling and streams out everything collected so far. Returns false, after logging
+  // why, if the trace could not be written.
+  bool stopAndWriteTrace(int fd);
+  bool stopAndWriteTrace(const std::string& filename);
+
+private:
+  static const size_t kMaxDepth = 32;
+  static const size_t kMaxNames = 4096;
+
+  struct Sample {
+    int64_t timestampUs;
+    uint32_t depth;
+    uint32_t frames[kMaxDepth];
+  };
+
+  Options m_options;
+
+  // Shadow stack, written by the JS thread and read by the sampler under a sequence lock: the
+  // generation is odd while the stack is being changed
+  std::atomic<uint32_t> m_generation;
+  std::atomic<uint32_t> m_depth;
+  std::atomic<uint32_t> m_stack[kMaxDepth];
+  // Sections entered past kMaxDepth, only counted so exits stay balanced
+  uint32_t m_overflowDepth;
+
+  // Only touched by the JS thread
+  std::vector<std::string> m_names;
+  std::unordered_map<std::string, uint32_t> m_nameIds;
+
+  // Only touched by the sampler thread until it is joined
+  std::vector<Sample> m_samples;
+  size_t m_nextSample;
+  size_t m_droppedSamples;
+
+  std::mutex m_mutex;
+  std::condition_variable m_stopCondition;
+  bool m_stopping;
+  std::thread m_samplerThread;
+  std::chrono::steady_clock::time_point m_startTime;
+
+  uint32_t internName(const char* name, size_t length);
+  void samplerLoop();
+  bool takeSample(Sample& sample);
+  void stop();
+};
+
+} }
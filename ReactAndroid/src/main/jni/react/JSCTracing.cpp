@@ -6,8 +6,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include "JSCHelpers.h"
+#include "TraceBuffer.h"
 
 using std::min;
+using facebook::react::TraceBuffer;
 
 static uint64_t tagFromJSValue(
     JSContextRef ctx,
@@ -53,6 +55,23 @@ static size_t copyTruncatedAsciiChars(
   return stringLen;
 }
 
+static uint32_t traceNameFromJSValue(
+    TraceBuffer* buffer,
+    JSContextRef ctx,
+    JSValueRef value) {
+  JSStringRef jsString = JSValueToStringCopy(ctx, value, NULL);
+  uint32_t name = buffer->internName(
+    JSStringGetCharactersPtr(jsString), JSStringGetLength(jsString));
+  JSStringRelease(jsString);
+  return name;
+}
+
+// Buffered tracing takes the tags it records away from systrace
+static TraceBuffer* traceBufferForTag(uint64_t tag) {
+  TraceBuffer* buffer = TraceBuffer::active();
+  return (buffer != nullptr && buffer->isTracing(tag)) ? buffer : nullptr;
+}
+
 static size_t copyArgsToBuffer(
     char* buf,
     size_t bufLen,
@@ -96,6 +115,11 @@ static JSValueRef nativeTraceBeginSection(
   }
 
   uint64_t tag = tagFromJSValue(ctx, arguments[0], exception);
+  if (TraceBuffer* buffer = traceBufferForTag(tag)) {
+    // Section arguments are not recorded
+    buffer->beginSection(traceNameFromJSValue(buffer, ctx, arguments[1]));
+    return JSValueMakeUndefined(ctx);
+  }
   if (!fbsystrace_is_tracing(tag)) {
     return JSValueMakeUndefined(ctx);
   }
@@ -132,6 +156,10 @@ static JSValueRef nativeTraceEndSection(
   }
 
   uint64_t tag = tagFromJSValue(ctx, arguments[0], exception);
+  if (TraceBuffer* buffer = traceBufferForTag(tag)) {
+    buffer->endSection();
+    return JSValueMakeUndefined(ctx);
+  }
   if (!fbsystrace_is_tracing(tag)) {
     return JSValueMakeUndefined(ctx);
   }
@@ -171,6 +199,16 @@ static JSValueRef beginOrEndAsync(
   }
 
   uint64_t tag = tagFromJSValue(ctx, arguments[0], exception);
+  if (TraceBuffer* buffer = traceBufferForTag(tag)) {
+    uint32_t name = traceNameFromJSValue(buffer, ctx, arguments[1]);
+    int64_t cookie = int64FromJSValue(ctx, arguments[2], exception);
+    if (isEnd) {
+      buffer->endAsyncSection(name, cookie);
+    } else {
+      buffer->beginAsyncSection(name, cookie);
+    }
+    return JSValueMakeUndefined(ctx);
+  }
   if (!fbsystrace_is_tracing(tag)) {
     return JSValueMakeUndefined(ctx);
   }
@@ -262,6 +300,10 @@ static JSValueRef nativeTraceAsyncSectionStage(
   }
 
   uint64_t tag = tagFromJSValue(ctx, arguments[0], exception);
+  if (traceBufferForTag(tag) != nullptr) {
+    // Stages have no Chrome trace equivalent, buffered traces leave them out
+    return JSValueMakeUndefined(ctx);
+  }
   if (!fbsystrace_is_tracing(tag)) {
     return JSValueMakeUndefined(ctx);
   }
@@ -297,6 +339,12 @@ static JSValueRef nativeTraceCounter(
   }
 
   uint64_t tag = tagFromJSValue(ctx, arguments[0], exception);
+  if (TraceBuffer* buffer = traceBufferForTag(tag)) {
+    buffer->counter(
+      traceNameFromJSValue(buffer, ctx, arguments[1]),
+      int64FromJSValue(ctx, arguments[2], exception));
+    return JSValueMakeUndefined(ctx);
+  }
   if (!fbsystrace_is_tracing(tag)) {
     return JSValueMakeUndefined(ctx);
   }
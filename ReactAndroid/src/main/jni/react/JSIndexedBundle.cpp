@@ -0,0 +1,125 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSIndexedBundle.h"
+
+#include <algorithm>
+#include <vector>
+#include <fb/log.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+class HeaderReader {
+public:
+  HeaderReader(const uint8_t* data, size_t size) :
+    m_data(data),
+    m_size(size),
+    m_offset(0)
+  {}
+
+  bool readUInt32(uint32_t& value) {
+    if (m_size - m_offset < 4) {
+      return false;
+    }
+    const uint8_t* bytes = m_data + m_offset;
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+    m_offset += 4;
+    return true;
+  }
+
+  bool readString(uint32_t size, std::string& value) {
+    if (m_size - m_offset < size) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(m_data + m_offset), size);
+    m_offset += size;
+    return true;
+  }
+
+  size_t offset() const {
+    return m_offset;
+  }
+
+private:
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_offset;
+};
+
+struct ModuleEntry {
+  std::string name;
+  uint32_t offset;
+  uint32_t codeSize;
+};
+
+// The code must fit before the end of the bundle and be followed by its terminator
+bool isTerminatedCode(const char* data, size_t size, size_t offset, uint32_t codeSize) {
+  return offset <= size && codeSize < size - offset && data[offset + codeSize] == '\0';
+}
+
+}
+
+bool JSIndexedBundle::isIndexedBundle(const JSBigString& script) {
+  uint32_t magic;
+  HeaderReader reader(reinterpret_cast<const uint8_t*>(script.c_str()), script.size());
+  return reader.readUInt32(magic) && magic == kMagic;
+}
+
+std::unique_ptr<const JSIndexedBundle> JSIndexedBundle::fromScript(
+    std::unique_ptr<const JSBigString> script) {
+  const char* data = script->c_str();
+  size_t size = script->size();
+  HeaderReader reader(reinterpret_cast<const uint8_t*>(data), size);
+
+  uint32_t magic, moduleCount, startupCodeSize;
+  if (!reader.readUInt32(magic) || magic != kMagic ||
+      !reader.readUInt32(moduleCount) ||
+      !reader.readUInt32(startupCodeSize)) {
+    FBLOGE("Indexed bundle has a truncated header");
+    return nullptr;
+  }
+
+  std::vector<ModuleEntry> entries;
+  // Every entry takes at least 12 bytes, don't trust the count further than that
+  entries.reserve(std::min<size_t>(moduleCount, size / 12));
+  for (uint32_t i = 0; i < moduleCount; i++) {
+    ModuleEntry entry;
+    uint32_t nameSize;
+    if (!reader.readUInt32(nameSize) ||
+        !reader.readString(nameSize, entry.name) ||
+        !reader.readUInt32(entry.offset) ||
+        !reader.readUInt32(entry.codeSize)) {
+      FBLOGE("Indexed bundle has a truncated module table");
+      return nullptr;
+    }
+    entries.push_back(std::move(entry));
+  }
+
+  size_t startupCodeOffset = reader.offset();
+  if (!isTerminatedCode(data, size, startupCodeOffset, startupCodeSize)) {
+    FBLOGE("Indexed bundle has a truncated startup section");
+    return nullptr;
+  }
+  size_t modulesOffset = startupCodeOffset + startupCodeSize + 1;
+
+  std::unique_ptr<JSIndexedBundle> bundle(new JSIndexedBundle(std::move(script)));
+  bundle->m_startupCode = data + startupCodeOffset;
+  bundle->m_modules.reserve(entries.size());
+  for (auto& entry : entries) {
+    if (!isTerminatedCode(data, size, modulesOffset + entry.offset, entry.codeSize)) {
+      FBLOGE("Indexed bundle entry for %s is out of bounds", entry.name.c_str());
+      return nullptr;
+    }
+    bundle->m_modules.emplace(std::move(entry.name), data + modulesOffset + entry.offset);
+  }
+  return std::move(bundle);
+}
+
+const char* JSIndexedBundle::moduleCode(const std::string& moduleName) const {
+  auto it = m_modules.find(moduleName);
+  return it == m_modules.end() ? nullptr : it->second;
+}
+
+} }
@@ -0,0 +1,53 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "Executor.h"
+
+namespace facebook {
+namespace react {
+
+/**
+ * A bundle whose module bodies are only evaluated when they are first required. Written by the
+ * packager's Bundle.getIndexedBundle(), all integers are little endian uint32:
+ *
+ *   bundle := MAGIC moduleCount startupCodeSize entry* startupCode module*
+ *   entry  := nameSize name offset codeSize
+ *
+ * Offsets are relative to the first byte after the startup code. The startup code and every
+ * module body are followed by a null byte, so they can be handed to JSC straight out of the
+ * (usually memory mapped) script without copying.
+ */
+class JSIndexedBundle {
+public:
+  static const uint32_t kMagic = 0xFB0BD1E5;
+
+  static bool isIndexedBundle(const JSBigString& script);
+
+  // Returns null, after logging why, if the header is malformed
+  static std::unique_ptr<const JSIndexedBundle> fromScript(
+    std::unique_ptr<const JSBigString> script);
+
+  const char* startupCode() const {
+    return m_startupCode;
+  }
+
+  // Null terminated body of the given module, or null if the bundle does not contain it
+  const char* moduleCode(const std::string& moduleName) const;
+
+private:
+  JSIndexedBundle(std::unique_ptr<const JSBigString> script) :
+    m_script(std::move(script)),
+    m_startupCode(nullptr)
+  {}
+
+  std::unique_ptr<const JSBigString> m_script;
+  const char* m_startupCode;
+  std::unordered_map<std::string, const char*> m_modules;
+};
+
+} }
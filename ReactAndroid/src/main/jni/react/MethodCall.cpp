@@ -2,6 +2,11 @@
 
 #include "MethodCall.h"
 
+#include <algorithm>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <jni/fbjni.h>
 
 #include <folly/json.h>
@@ -13,7 +18,676 @@ namespace react {
 #define REQUEST_METHOD_IDS 1
 #define REQUEST_PARAMSS 2
 
+namespace {
+
+enum BinaryValueTag : uint8_t {
+  TAG_NULL = 0,
+  TAG_FALSE = 1,
+  TAG_TRUE = 2,
+  TAG_INT = 3,
+  TAG_DOUBLE = 4,
+  TAG_STRING = 5,
+  TAG_ARRAY = 6,
+  TAG_OBJECT = 7,
+  TAG_FLOAT64_ARRAY = 8,
+  TAG_INT32_ARRAY = 9,
+  TAG_UINT8_ARRAY = 10,
+  TAG_TABLE_STRING = 11,
+  TAG_STRING_REF = 12,
+};
+
+// Reads bytes from either a byte buffer or a JS string holding one byte per UTF-16 code unit
+template <typename CharT>
+class BinaryBatchReader {
+public:
+  BinaryBatchReader(const CharT* data, size_t size)
+    : m_pos(data)
+    , m_end(data + size) {}
+
+  bool atEnd() const {
+    return m_pos == m_end;
+  }
+
+  // Set by the first read that failed, every read after it fails as well
+  const char* error() const {
+    return m_error;
+  }
+
+  // Legacy batches have no string table and write keys as plain strings
+  void setHasStringTable(bool hasStringTable) {
+    m_hasStringTable = hasStringTable;
+  }
+
+  uint8_t readByte() {
+    if (m_pos == m_end) {
+      fail("unexpected end of batch");
+      return 0;
+    }
+    auto unit = *m_pos++;
+    if (unit > 0xff) {
+      fail("not a byte");
+      return 0;
+    }
+    return static_cast<uint8_t>(unit);
+  }
+
+  uint32_t readVarint() {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t byte = readByte();
+      value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    fail("varint too long");
+    return 0;
+  }
+
+  std::string readString() {
+    return readStringOfSize(readVarint());
+  }
+
+  std::string readStringOfSize(uint32_t size) {
+    if (static_cast<size_t>(m_end - m_pos) < size) {
+      fail("string overruns batch");
+      return std::string();
+    }
+    std::string result(size, '\0');
+    for (uint32_t i = 0; i < size; i++) {
+      result[i] = static_cast<char>(readByte());
+    }
+    return result;
+  }
+
+  // Table strings are decoded once; every reference to them is a copy, which doesn't allocate
+  // for the short keys that make up most of the table
+  const std::string& tableString(uint32_t index) {
+    if (index >= m_strings.size()) {
+      fail("string index out of range");
+      return m_emptyString;
+    }
+    return m_strings[index];
+  }
+
+  std::string readKey() {
+    if (!m_hasStringTable) {
+      return readString();
+    }
+    uint32_t key = readVarint();
+    if (key & 1) {
+      return tableString(key >> 1);
+    }
+    m_strings.push_back(readStringOfSize(key >> 1));
+    return m_strings.back();
+  }
+
+  folly::dynamic readValue() {
+    switch (readByte()) {
+      case TAG_NULL:
+        return nullptr;
+      case TAG_FALSE:
+        return false;
+      case TAG_TRUE:
+        return true;
+      case TAG_INT: {
+        uint32_t zigzag = readVarint();
+        return static_cast<int64_t>(static_cast<int32_t>((zigzag >> 1) ^ -(zigzag & 1)));
+      }
+      case TAG_DOUBLE:
+        return readRaw<double>();
+      case TAG_STRING:
+        return readString();
+      case TAG_TABLE_STRING:
+        if (!m_hasStringTable) {
+          fail("string table in a legacy batch");
+          return nullptr;
+        }
+        m_strings.push_back(readString());
+        return m_strings.back();
+      case TAG_STRING_REF:
+        if (!m_hasStringTable) {
+          fail("string table in a legacy batch");
+          return nullptr;
+        }
+        return tableString(readVarint());
+      case TAG_ARRAY: {
+        uint32_t count = readVarint();
+        folly::dynamic array = {};
+        for (uint32_t i = 0; i < count && !m_error; i++) {
+          array.push_back(readValue());
+        }
+        return array;
+      }
+      case TAG_OBJECT: {
+        uint32_t count = readVarint();
+        folly::dynamic object = folly::dynamic::object;
+        for (uint32_t i = 0; i < count && !m_error; i++) {
+          auto key = readKey();
+          object.insert(std::move(key), readValue());
+        }
+        return object;
+      }
+      case TAG_FLOAT64_ARRAY:
+        return readPackedArray<double, double>();
+      case TAG_INT32_ARRAY:
+        return readPackedArray<int32_t, int64_t>();
+      case TAG_UINT8_ARRAY:
+        return readPackedArray<uint8_t, int64_t>();
+      default:
+        fail("unknown value tag");
+        return nullptr;
+    }
+  }
+
+private:
+  template <typename T>
+  T readRaw() {
+    uint8_t bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); i++) {
+      bytes[i] = readByte();
+    }
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return value;
+  }
+
+  // Elements are stored as the dynamic type JSON would have given them, ints or doubles
+  template <typename T, typename Element>
+  folly::dynamic readPackedArray() {
+    uint32_t count = readVarint();
+    if (static_cast<size_t>(m_end - m_pos) / sizeof(T) < count) {
+      fail("packed array overruns batch");
+      return nullptr;
+    }
+    folly::dynamic array = {};
+    for (uint32_t i = 0; i < count; i++) {
+      array.push_back(static_cast<Element>(readRaw<T>()));
+    }
+    return array;
+  }
+
+  // Stops the reader where it is, so callers only have to check for the error once done
+  void fail(const char* reason) {
+    if (!m_error) {
+      m_error = reason;
+    }
+    m_pos = m_end;
+  }
+
+  const CharT* m_pos;
+  const CharT* m_end;
+  const char* m_error = nullptr;
+  bool m_hasStringTable = false;
+  std::vector<std::string> m_strings;
+  const std::string m_emptyString;
+};
+
+template <typename CharT>
+bool tryParseBinaryMethodCallsFrom(const CharT* data, size_t size,
+                                   std::vector<MethodCall>& methodCalls, std::string& error) {
+  methodCalls.clear();
+  BinaryBatchReader<CharT> reader(data, size);
+  uint8_t magic = reader.readByte();
+  if (!isBinaryBatchMagic(magic)) {
+    error = "Did not get valid binary calls back from JS: bad header";
+    return false;
+  }
+  reader.setHasStringTable(magic == static_cast<uint8_t>(kBinaryBatchMagic));
+
+  uint32_t count = reader.readVarint();
+  // Every call takes at least three bytes, which bounds what a corrupt count can reserve
+  methodCalls.reserve(std::min<size_t>(count, size / 3));
+  for (uint32_t i = 0; i < count && !reader.error(); i++) {
+    int moduleId = reader.readVarint();
+    int methodId = reader.readVarint();
+    auto arguments = reader.readValue();
+    if (reader.error()) {
+      break;
+    }
+    if (!arguments.isArray()) {
+      methodCalls.clear();
+      error = "Call argument isn't an array";
+      return false;
+    }
+    methodCalls.emplace_back(moduleId, methodId, std::move(arguments));
+  }
+
+  const char* reason = reader.error();
+  if (!reason && !reader.atEnd()) {
+    reason = "trailing data";
+  }
+  if (reason) {
+    methodCalls.clear();
+    error = std::string("Did not get valid binary calls back from JS: ") + reason;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * A JSON reader working on the UTF-16 code units of a JS string, so the flushed queue never has
+ * to be transcoded to UTF-8 as a whole. Only string values are converted, one at a time.
+ */
+class JSONUTF16Reader {
+public:
+  // Same nesting limit as folly::parseJson
+  static const int kMaxDepth = 100;
+
+  JSONUTF16Reader(const uint16_t* chars, size_t length)
+    : m_begin(chars)
+    , m_pos(chars)
+    , m_end(chars + length) {}
+
+  // Reads [moduleIds, methodIds, params, ...] and builds each call as soon as its arguments
+  // have been read, without materializing the queue itself. Returns false, with no calls, if the
+  // queue is malformed.
+  bool readMethodCalls(std::vector<MethodCall>& methodCalls, std::string& error) {
+    methodCalls.clear();
+    readQueue(methodCalls);
+    if (!m_error.empty()) {
+      methodCalls.clear();
+      error = std::move(m_error);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  void readQueue(std::vector<MethodCall>& methodCalls) {
+    skipWhitespace();
+    if (tryConsumeLiteral("null")) {
+      expectEnd();
+      return;
+    }
+
+    expect('[');
+    auto moduleIds = readIds();
+    expect(',');
+    auto methodIds = readIds();
+    if (moduleIds.size() != methodIds.size()) {
+      fail("module and method ids don't match up");
+      return;
+    }
+    expect(',');
+
+    methodCalls.reserve(moduleIds.size());
+    expect('[');
+    if (!tryConsume(']')) {
+      do {
+        if (methodCalls.size() == moduleIds.size()) {
+          fail("more arguments than calls");
+          return;
+        }
+        auto arguments = readValue(1);
+        if (failed()) {
+          return;
+        }
+        if (!arguments.isArray()) {
+          m_error = "Call argument isn't an array";
+          return;
+        }
+        auto i = methodCalls.size();
+        methodCalls.emplace_back(moduleIds[i], methodIds[i], std::move(arguments));
+      } while (tryConsume(','));
+      expect(']');
+    }
+    if (!failed() && methodCalls.size() != moduleIds.size()) {
+      fail("fewer arguments than calls");
+      return;
+    }
+
+    // Anything after the params, e.g. the callback id, isn't needed here
+    while (tryConsume(',')) {
+      readValue(1);
+    }
+    expect(']');
+    expectEnd();
+  }
+
+  std::vector<int> readIds() {
+    std::vector<int> ids;
+    expect('[');
+    if (tryConsume(']')) {
+      return ids;
+    }
+    do {
+      skipWhitespace();
+      auto id = readNumber();
+      ids.push_back(id.isInt() ? id.getInt() : static_cast<int>(id.getDouble()));
+    } while (tryConsume(','));
+    expect(']');
+    return ids;
+  }
+
+  folly::dynamic readValue(int depth) {
+    if (depth > kMaxDepth) {
+      fail("nested too deeply");
+      return nullptr;
+    }
+    skipWhitespace();
+    if (m_pos == m_end) {
+      fail("unexpected end");
+      return nullptr;
+    }
+    switch (*m_pos) {
+      case '{': {
+        m_pos++;
+        folly::dynamic object = folly::dynamic::object;
+        if (tryConsume('}')) {
+          return object;
+        }
+        do {
+          skipWhitespace();
+          auto key = readString();
+          expect(':');
+          object.insert(std::move(key), readValue(depth + 1));
+        } while (tryConsume(','));
+        expect('}');
+        return object;
+      }
+      case '[': {
+        m_pos++;
+        folly::dynamic array = {};
+        if (tryConsume(']')) {
+          return array;
+        }
+        do {
+          array.push_back(readValue(depth + 1));
+        } while (tryConsume(','));
+        expect(']');
+        return array;
+      }
+      case '"':
+        return readString();
+      case 't':
+        if (tryConsumeLiteral("true")) {
+          return true;
+        }
+        break;
+      case 'f':
+        if (tryConsumeLiteral("false")) {
+          return false;
+        }
+        break;
+      case 'n':
+        if (tryConsumeLiteral("null")) {
+          return nullptr;
+        }
+        break;
+      default:
+        return readNumber();
+    }
+    fail("unexpected literal");
+    return nullptr;
+  }
+
+  folly::dynamic readNumber() {
+    // JSON numbers are short and ASCII, so they can be handed to strtoll/strtod from a copy
+    char buffer[64];
+    size_t length = 0;
+    bool isInteger = true;
+    while (m_pos != m_end && isNumberChar(*m_pos)) {
+      if (length == sizeof(buffer) - 1) {
+        fail("number too long");
+        return 0;
+      }
+      char c = static_cast<char>(*m_pos++);
+      isInteger = isInteger && c != '.' && c != 'e' && c != 'E';
+      buffer[length++] = c;
+    }
+    buffer[length] = '\0';
+    if (length == 0) {
+      fail("expected a value");
+      return 0;
+    }
+
+    char* parsedEnd;
+    if (isInteger) {
+      errno = 0;
+      long long value = strtoll(buffer, &parsedEnd, 10);
+      if (errno == 0 && *parsedEnd == '\0') {
+        return static_cast<int64_t>(value);
+      }
+      // Out of int64 range, fall back to a double like folly::parseJson does
+    }
+    double value = strtod(buffer, &parsedEnd);
+    if (*parsedEnd != '\0') {
+      fail("malformed number");
+      return 0;
+    }
+    return value;
+  }
+
+  std::string readString() {
+    expect('"');
+    std::string result;
+    while (true) {
+      if (m_pos == m_end) {
+        fail("unterminated string");
+        return result;
+      }
+      uint32_t unit = *m_pos++;
+      if (unit == '"') {
+        return result;
+      }
+      if (unit < 0x80 && unit != '\\') {
+        result.push_back(static_cast<char>(unit));
+        continue;
+      }
+      uint32_t codePoint;
+      if (unit == '\\') {
+        codePoint = readEscape();
+      } else {
+        codePoint = unit;
+      }
+      if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+        codePoint = readLowSurrogate(codePoint);
+      } else if (codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+        // Lone low surrogate
+        codePoint = 0xfffd;
+      }
+      appendUTF8(result, codePoint);
+    }
+  }
+
+  uint32_t readEscape() {
+    if (m_pos == m_end) {
+      fail("unterminated escape");
+      return 0;
+    }
+    switch (*m_pos++) {
+      case '"': return '"';
+      case '\\': return '\\';
+      case '/': return '/';
+      case 'b': return '\b';
+      case 'f': return '\f';
+      case 'n': return '\n';
+      case 'r': return '\r';
+      case 't': return '\t';
+      case 'u': return readHex4();
+      default:
+        fail("unknown escape");
+        return 0;
+    }
+  }
+
+  uint32_t readHex4() {
+    if (m_end - m_pos < 4) {
+      fail("truncated unicode escape");
+      return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+      uint32_t unit = *m_pos++;
+      value <<= 4;
+      if (unit >= '0' && unit <= '9') {
+        value |= unit - '0';
+      } else if (unit >= 'a' && unit <= 'f') {
+        value |= unit - 'a' + 10;
+      } else if (unit >= 'A' && unit <= 'F') {
+        value |= unit - 'A' + 10;
+      } else {
+        fail("bad unicode escape");
+        return 0;
+      }
+    }
+    return value;
+  }
+
+  // The high surrogate has been read, either raw or escaped; its pair may be either as well
+  uint32_t readLowSurrogate(uint32_t high) {
+    uint32_t low = 0;
+    if (m_pos != m_end && *m_pos >= 0xdc00 && *m_pos <= 0xdfff) {
+      low = *m_pos++;
+    } else if (m_end - m_pos >= 6 && m_pos[0] == '\\' && m_pos[1] == 'u') {
+      auto saved = m_pos;
+      m_pos += 2;
+      low = readHex4();
+      if (low < 0xdc00 || low > 0xdfff) {
+        m_pos = saved;
+        low = 0;
+      }
+    }
+    if (low == 0) {
+      return 0xfffd;
+    }
+    return 0x10000 + ((high - 0xd800) << 10) + (low - 0xdc00);
+  }
+
+  static void appendUTF8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+      out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      out.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else if (codePoint < 0x10000) {
+      out.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else {
+      out.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    }
+  }
+
+  static bool isNumberChar(uint16_t unit) {
+    return (unit >= '0' && unit <= '9') ||
+      unit == '-' || unit == '+' || unit == '.' || unit == 'e' || unit == 'E';
+  }
+
+  void skipWhitespace() {
+    while (m_pos != m_end &&
+           (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) {
+      m_pos++;
+    }
+  }
+
+  bool tryConsume(char c) {
+    skipWhitespace();
+    if (m_pos != m_end && *m_pos == c) {
+      m_pos++;
+      return true;
+    }
+    return false;
+  }
+
+  bool tryConsumeLiteral(const char* literal) {
+    size_t length = strlen(literal);
+    if (static_cast<size_t>(m_end - m_pos) < length) {
+      return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+      if (m_pos[i] != static_cast<uint16_t>(literal[i])) {
+        return false;
+      }
+    }
+    m_pos += length;
+    return true;
+  }
+
+  void expect(char c) {
+    if (!tryConsume(c)) {
+      char reason[] = "expected 'x'";
+      reason[10] = c;
+      fail(reason);
+    }
+  }
+
+  void expectEnd() {
+    skipWhitespace();
+    if (m_pos != m_end) {
+      fail("trailing data");
+    }
+  }
+
+  bool failed() const {
+    return !m_error.empty();
+  }
+
+  // Only the first failure is kept. The reader then stops where it is, so every read after it
+  // fails quickly and the parse unwinds without having to check at each step.
+  void fail(const char* reason) {
+    if (m_error.empty()) {
+      char message[128];
+      snprintf(message, sizeof(message), "Did not get valid calls back from JS: %s at offset %d",
+               reason, static_cast<int>(m_pos - m_begin));
+      m_error = message;
+    }
+    m_pos = m_end;
+  }
+
+  const uint16_t* m_begin;
+  const uint16_t* m_pos;
+  const uint16_t* m_end;
+  std::string m_error;
+};
+
+[[noreturn]] void throwParseError(const std::string& error) {
+  jni::throwNewJavaException(jni::gJavaLangIllegalArgumentException, "%s", error.c_str());
+}
+
+}
+
+bool tryParseBinaryMethodCalls(const uint8_t* data, size_t size,
+                               std::vector<MethodCall>& calls, std::string& error) {
+  return tryParseBinaryMethodCallsFrom(data, size, calls, error);
+}
+
+std::vector<MethodCall> parseBinaryMethodCalls(const uint8_t* data, size_t size) {
+  std::vector<MethodCall> calls;
+  std::string error;
+  if (!tryParseBinaryMethodCalls(data, size, calls, error)) {
+    throwParseError(error);
+  }
+  return calls;
+}
+
+bool tryParseMethodCalls(const uint16_t* chars, size_t length,
+                         std::vector<MethodCall>& calls, std::string& error) {
+  if (length > 0 && isBinaryBatchMagic(chars[0])) {
+    return tryParseBinaryMethodCallsFrom(chars, length, calls, error);
+  }
+  return JSONUTF16Reader(chars, length).readMethodCalls(calls, error);
+}
+
+std::vector<MethodCall> parseMethodCalls(const uint16_t* chars, size_t length) {
+  std::vector<MethodCall> calls;
+  std::string error;
+  if (!tryParseMethodCalls(chars, length, calls, error)) {
+    throwParseError(error);
+  }
+  return calls;
+}
+
 std::vector<MethodCall> parseMethodCalls(const std::string& json) {
+  if (!json.empty() && isBinaryBatchMagic(static_cast<uint8_t>(json[0]))) {
+    return parseBinaryMethodCalls(
+      reinterpret_cast<const uint8_t*>(json.data()), json.size());
+  }
+
   folly::dynamic jsonData = folly::parseJson(json);
 
   if (jsonData.isNull()) {
@@ -30,9 +704,9 @@ std::vector<MethodCall> parseMethodCalls(const std::string& json) {
                                "Did not get valid calls back from JS: size == %d", jsonData.size());
   }
 
-  auto moduleIds = jsonData[REQUEST_MODULE_IDS];
-  auto methodIds = jsonData[REQUEST_METHOD_IDS];
-  auto params = jsonData[REQUEST_PARAMSS];
+  auto& moduleIds = jsonData[REQUEST_MODULE_IDS];
+  auto& methodIds = jsonData[REQUEST_METHOD_IDS];
+  auto& params = jsonData[REQUEST_PARAMSS];
 
   if (!moduleIds.isArray() || !methodIds.isArray() || !params.isArray()) {
     jni::throwNewJavaException(jni::gJavaLangIllegalArgumentException,
@@ -40,10 +714,12 @@ std::vector<MethodCall> parseMethodCalls(const std::string& json) {
                                json.c_str());
   }
 
+  // The arguments are moved out of the parsed queue rather than copied, so each value in the
+  // batch is only allocated once
   std::vector<MethodCall> methodCalls;
+  methodCalls.reserve(moduleIds.size());
   for (size_t i = 0; i < moduleIds.size(); i++) {
-    auto paramsValue = params[i];
-    if (!paramsValue.isArray()) {
+    if (!params[i].isArray()) {
       jni::throwNewJavaException(jni::gJavaLangIllegalArgumentException,
                                  "Call argument isn't an array");
     }
@@ -22,6 +22,33 @@ struct MethodCall {
     , arguments(std::move(args)) {}
 };
 
+// First byte of a batch written by Libraries/Utilities/encodeBinaryBatch.js. No JSON text can
+// start with it, which lets parseMethodCalls accept either format.
+const char kBinaryBatchMagic = 0x02;
+
+// First byte of the binary batches from before they had a string table, which are still read
+const char kLegacyBinaryBatchMagic = 0x01;
+
+inline bool isBinaryBatchMagic(uint16_t c) {
+  return c == static_cast<uint8_t>(kBinaryBatchMagic) ||
+    c == static_cast<uint8_t>(kLegacyBinaryBatchMagic);
+}
+
+// Parses a flushed queue, either as JSON or in the binary batch format.
 std::vector<MethodCall> parseMethodCalls(const std::string& json);
 
+std::vector<MethodCall> parseBinaryMethodCalls(const uint8_t* data, size_t size);
+
+// Same as above, for a flushed queue still held as the UTF-16 code units of a JS string. The
+// binary format is then expected to carry one byte per code unit.
+std::vector<MethodCall> parseMethodCalls(const uint16_t* chars, size_t length);
+
+// Versions of the above for callers that handle a malformed queue themselves. Instead of throwing
+// a Java exception, they return false with the reason in error and leave calls empty.
+bool tryParseBinaryMethodCalls(const uint8_t* data, size_t size,
+                               std::vector<MethodCall>& calls, std::string& error);
+
+bool tryParseMethodCalls(const uint16_t* chars, size_t length,
+                         std::vector<MethodCall>& calls, std::string& error);
+
 } }
@@ -0,0 +1,201 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "TraceBuffer.h"
+
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <fb/ThreadLocal.h>
+#include <fb/log.h>
+#include <folly/Conv.h>
+#include "TraceWriter.h"
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// The calling thread's log in the trace with the given id. Traces are numbered rather than
+// compared by address, which a later trace could reuse.
+struct ThreadState {
+  uint64_t traceId = 0;
+  void* log = nullptr;
+};
+
+ThreadLocal<ThreadState>& threadState() {
+  static auto state = new ThreadLocal<ThreadState>();
+  return *state;
+}
+
+std::mutex gTraceMutex;
+uint64_t gLastTraceId = 0;
+// The last trace stays allocated until the next one starts, in case a hook that read active()
+// just before it stopped is still appending to it
+TraceBuffer* gLastTrace = nullptr;
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+std::atomic<TraceBuffer*> TraceBuffer::s_active(nullptr);
+
+TraceBuffer::TraceBuffer(uint64_t tags, size_t eventsPerThread) :
+  m_tags(tags),
+  m_eventsPerThread(std::max<size_t>(eventsPerThread, 2)),
+  m_traceId(0) {}
+
+bool TraceBuffer::start(uint64_t tags, size_t eventsPerThread) {
+  std::lock_guard<std::mutex> lock(gTraceMutex);
+  if (s_active.load(std::memory_order_relaxed) != nullptr) {
+    FBLOGW("Buffered tracing is already running");
+    return false;
+  }
+  delete gLastTrace;
+  gLastTrace = new TraceBuffer(tags, eventsPerThread);
+  gLastTrace->m_traceId = ++gLastTraceId;
+  s_active.store(gLastTrace, std::memory_order_release);
+  return true;
+}
+
+bool TraceBuffer::stopAndWrite(const std::string& filename) {
+  std::lock_guard<std::mutex> lock(gTraceMutex);
+  TraceBuffer* trace = s_active.exchange(nullptr, std::memory_order_acq_rel);
+  if (trace == nullptr) {
+    FBLOGW("Buffered tracing is not running");
+    return false;
+  }
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    FBLOGE("Unable to open %s for the trace: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  bool written = trace->write(fd);
+  close(fd);
+  return written;
+}
+
+uint32_t TraceBuffer::internName(std::string name) {
+  ThreadLog& log = threadLog();
+  auto it = log.nameIds.find(name);
+  if (it != log.nameIds.end()) {
+    return it->second;
+  }
+  uint32_t id;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto globalIt = m_nameIds.find(name);
+    if (globalIt != m_nameIds.end()) {
+      id = globalIt->second;
+    } else {
+      id = m_names.size();
+      m_names.push_back(name);
+      m_nameIds.emplace(name, id);
+    }
+  }
+  log.nameIds.emplace(std::move(name), id);
+  return id;
+}
+
+TraceBuffer::ThreadLog& TraceBuffer::threadLog() {
+  auto& state = threadState();
+  if (state.get() == nullptr) {
+    state.reset(new ThreadState());
+  }
+  if (state->traceId != m_traceId) {
+    std::unique_ptr<ThreadLog> log(new ThreadLog(gettid(), m_eventsPerThread));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    state->traceId = m_traceId;
+    state->log = log.get();
+    m_threadLogs.push_back(std::move(log));
+  }
+  return *static_cast<ThreadLog*>(state->log);
+}
+
+void TraceBuffer::append(EventType type, uint32_t name, int64_t value) {
+  ThreadLog& log = threadLog();
+  uint64_t index = log.written.load(std::memory_order_relaxed);
+  Event& event = log.events[index % log.events.size()];
+  event.timestampNs = nowNs();
+  event.value = value;
+  event.name = name;
+  event.type = type;
+  log.written.store(index + 1, std::memory_order_release);
+}
+
+void TraceBuffer::beginSection(uint32_t name) {
+  append(EventType::Begin, name, 0);
+}
+
+void TraceBuffer::endSection() {
+  append(EventType::End, 0, 0);
+}
+
+void TraceBuffer::beginAsyncSection(uint32_t name, int64_t cookie) {
+  append(EventType::AsyncBegin, name, cookie);
+}
+
+void TraceBuffer::endAsyncSection(uint32_t name, int64_t cookie) {
+  append(EventType::AsyncEnd, name, cookie);
+}
+
+void TraceBuffer::counter(uint32_t name, int64_t value) {
+  append(EventType::Counter, name, value);
+}
+
+bool TraceBuffer::write(int fd) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto pid = folly::to<std::string>(getpid());
+  TraceWriter writer(fd);
+  writer.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+  uint64_t overwritten = 0;
+  bool first = true;
+  for (const auto& log : m_threadLogs) {
+    uint64_t written = log->written.load(std::memory_order_acquire);
+    uint64_t capacity = log->events.size();
+    uint64_t begin = 0;
+    if (written >= capacity) {
+      // A hook still running on this thread may be overwriting the oldest slot
+      begin = written - capacity + 1;
+      overwritten += begin;
+    }
+    auto prefix = folly::to<std::string>(",\"pid\":", pid, ",\"tid\":", log->tid, ",\"ts\":");
+    for (uint64_t i = begin; i < written; i++) {
+      const Event& event = log->events[i % capacity];
+      std::string text = folly::to<std::string>(
+        first ? "{" : ",{",
+        "\"cat\":\"js\"", prefix, event.timestampNs / 1000.0);
+      first = false;
+      switch (event.type) {
+        case EventType::Begin:
+          text += ",\"ph\":\"B\",\"name\":" + TraceWriter::quote(m_names[event.name]);
+          break;
+        case EventType::End:
+          text += ",\"ph\":\"E\"";
+          break;
+        case EventType::AsyncBegin:
+        case EventType::AsyncEnd:
+          text += folly::to<std::string>(
+            ",\"ph\":\"", event.type == EventType::AsyncBegin ? "S" : "F",
+            "\",\"name\":", TraceWriter::quote(m_names[event.name]), ",\"id\":", event.value);
+          break;
+        case EventType::Counter:
+          text += folly::to<std::string>(
+            ",\"ph\":\"C\",\"name\":", TraceWriter::quote(m_names[event.name]),
+            ",\"args\":{\"value\":", event.value, "}");
+          break;
+      }
+      writer.append(text + "}");
+    }
+  }
+  writer.append(folly::to<std::string>(
+    "],\"metadata\":{\"overwrittenEvents\":", overwritten, "}}\n"));
+  return writer.flush();
+}
+
+} }
@@ -0,0 +1,112 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+/**
+ * An in-memory alternative to writing JS trace sections to systrace as they happen. Each thread
+ * appends fixed size events (timestamp, interned name, value) to a ring buffer of its own, and
+ * nothing is formatted until the trace is written out as Chrome trace-event JSON.
+ *
+ * Only one trace records at a time. The hooks in JSCTracing.cpp check active() before they
+ * convert any JS argument.
+ */
+class TraceBuffer {
+public:
+  static TraceBuffer* active() {
+    return s_active.load(std::memory_order_acquire);
+  }
+
+  // Records the given systrace tags into eventsPerThread events per thread, the oldest are
+  // overwritten. Returns false if a trace is already recording.
+  static bool start(uint64_t tags, size_t eventsPerThread);
+  // Returns false, after logging why, if nothing is recording or the file can't be written
+  static bool stopAndWrite(const std::string& filename);
+
+  bool isTracing(uint64_t tag) const {
+    return (m_tags & tag) != 0;
+  }
+
+  // ASCII section names, anything else is replaced. Only the first kMaxNameLength characters
+  // are kept, like fbsystrace does.
+  template <typename CharT>
+  uint32_t internName(const CharT* chars, size_t length) {
+    std::string name;
+    if (length > kMaxNameLength) {
+      length = kMaxNameLength;
+    }
+    name.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      name.push_back(chars[i] < 0x80 ? static_cast<char>(chars[i]) : '?');
+    }
+    return internName(std::move(name));
+  }
+
+  void beginSection(uint32_t name);
+  void endSection();
+  void beginAsyncSection(uint32_t name, int64_t cookie);
+  void endAsyncSection(uint32_t name, int64_t cookie);
+  void counter(uint32_t name, int64_t value);
+
+private:
+  static const size_t kMaxNameLength = 127;
+
+  enum class EventType : uint8_t {
+    Begin,
+    End,
+    AsyncBegin,
+    AsyncEnd,
+    Counter,
+  };
+
+  struct Event {
+    int64_t timestampNs;
+    int64_t value;
+    uint32_t name;
+    EventType type;
+  };
+
+  // Written by its own thread only, read once recording has stopped. Names are interned per
+  // thread first so the shared table is only locked the first time a thread sees a name.
+  struct ThreadLog {
+    ThreadLog(int tid, size_t capacity) :
+      tid(tid),
+      written(0),
+      events(capacity)
+    {}
+
+    int tid;
+    std::atomic<uint64_t> written;
+    std::vector<Event> events;
+    std::unordered_map<std::string, uint32_t> nameIds;
+  };
+
+  static std::atomic<TraceBuffer*> s_active;
+
+  TraceBuffer(uint64_t tags, size_t eventsPerThread);
+
+  uint32_t internName(std::string name);
+  ThreadLog& threadLog();
+  void append(EventType type, uint32_t name, int64_t value);
+  bool write(int fd);
+
+  const uint64_t m_tags;
+  const size_t m_eventsPerThread;
+  uint64_t m_traceId;
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<ThreadLog>> m_threadLogs;
+  std::vector<std::string> m_names;
+  std::unordered_map<std::string, uint32_t> m_nameIds;
+};
+
+} }
@@ -0,0 +1,36 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "TraceWriter.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <fb/log.h>
+#include <folly/json.h>
+
+namespace facebook {
+namespace react {
+
+bool TraceWriter::flush() {
+  size_t offset = 0;
+  while (!m_failed && offset < m_buffer.size()) {
+    ssize_t written = write(m_fd, m_buffer.data() + offset, m_buffer.size() - offset);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      FBLOGE("Unable to write trace: %s", strerror(errno));
+      m_failed = true;
+      break;
+    }
+    offset += written;
+  }
+  m_buffer.clear();
+  return !m_failed;
+}
+
+std::string TraceWriter::quote(const std::string& text) {
+  return folly::toJson(folly::dynamic(text)).toStdString();
+}
+
+} }
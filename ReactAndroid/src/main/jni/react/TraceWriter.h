@@ -0,0 +1,41 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+
+namespace facebook {
+namespace react {
+
+/**
+ * Buffers trace output and writes it to a file descriptor in large chunks. After the first
+ * failed write everything else is dropped, so callers only check the result of flush().
+ */
+class TraceWriter {
+public:
+  explicit TraceWriter(int fd) :
+    m_fd(fd),
+    m_failed(false)
+  {}
+
+  void append(const std::string& text) {
+    m_buffer += text;
+    if (m_buffer.size() >= kFlushSize) {
+      flush();
+    }
+  }
+
+  bool flush();
+
+  // JSON string literal for text, quotes included
+  static std::string quote(const std::string& text);
+
+private:
+  static const size_t kFlushSize = 64 * 1024;
+
+  int m_fd;
+  bool m_failed;
+  std::string m_buffer;
+};
+
+} }
@@ -2,12 +2,22 @@
 
 #include "Value.h"
 
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <JavaScriptCore/JSObjectRef.h>
+#include <folly/dynamic.h>
 #include <jni/fbjni.h>
 #include <fb/log.h>
 
 namespace facebook {
 namespace react {
 
+jni::local_ref<jstring> String::toJString() const {
+  return jni::make_jstring_utf16(
+    reinterpret_cast<const jchar*>(JSStringGetCharactersPtr(m_string.get())), length());
+}
+
 Value::Value(JSContextRef context, JSValueRef value) :
   m_context(context),
   m_value(value)
@@ -32,6 +42,10 @@ JSContextRef Value::context() const {
 }
 
 std::string Value::toJSONString(unsigned indent) const {
+  return createJSONString(indent).str();
+}
+
+String Value::createJSONString(unsigned indent) const {
   JSValueRef exn;
   auto stringToAdopt = JSValueCreateJSONString(m_context, m_value, indent, &exn);
   if (stringToAdopt == nullptr) {
@@ -42,7 +56,167 @@ std::string Value::toJSONString(unsigned indent) const {
         "Exception creating JSON string: %s",
         exceptionText.c_str());
   }
-  return String::adopt(stringToAdopt).str();
+  return String::adopt(stringToAdopt);
+}
+
+// Deeper values are almost certainly cyclic, JSON.stringify would throw on them as well
+static const int kMaxConversionDepth = 100;
+
+// JSStringRefs are immutable and not tied to a context, so names can be shared by every bridge
+static const size_t kMaxCachedPropertyNames = 512;
+static const size_t kMaxCachedPropertyNameLength = 32;
+
+static String propertyName(const std::string& name) {
+  static std::mutex mutex;
+  static auto cache = new std::unordered_map<std::string, String>();
+
+  if (name.size() > kMaxCachedPropertyNameLength) {
+    return String(name.c_str());
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache->find(name);
+  if (it != cache->end()) {
+    return it->second;
+  }
+  String jsName(name.c_str());
+  if (cache->size() < kMaxCachedPropertyNames) {
+    cache->emplace(name, jsName);
+  }
+  return jsName;
+}
+
+static JSValueRef dynamicToJSValue(JSContextRef ctx, const folly::dynamic& value, int depth) {
+  if (depth > kMaxConversionDepth) {
+    jni::throwNewJavaException(
+        "java/lang/IllegalArgumentException",
+        "Value is nested more than %d levels deep",
+        kMaxConversionDepth);
+  }
+  switch (value.type()) {
+    case folly::dynamic::Type::NULLT:
+      return JSValueMakeNull(ctx);
+    case folly::dynamic::Type::BOOL:
+      return JSValueMakeBoolean(ctx, value.getBool());
+    case folly::dynamic::Type::INT64:
+      return JSValueMakeNumber(ctx, value.getInt());
+    case folly::dynamic::Type::DOUBLE:
+      return JSValueMakeNumber(ctx, value.getDouble());
+    case folly::dynamic::Type::STRING: {
+      String jsString(value.getString().c_str());
+      return JSValueMakeString(ctx, jsString);
+    }
+    case folly::dynamic::Type::ARRAY: {
+      // Elements are reachable from the array as soon as they are set, which keeps them from
+      // being collected while the rest is converted
+      JSObjectRef array = JSObjectMakeArray(ctx, 0, nullptr, nullptr);
+      for (size_t i = 0; i < value.size(); i++) {
+        JSObjectSetPropertyAtIndex(
+          ctx, array, i, dynamicToJSValue(ctx, value[i], depth + 1), nullptr);
+      }
+      return array;
+    }
+    case folly::dynamic::Type::OBJECT: {
+      JSObjectRef object = JSObjectMake(ctx, nullptr, nullptr);
+      for (const auto& item : value.items()) {
+        String name = propertyName(item.first.asString().toStdString());
+        JSObjectSetProperty(
+          ctx,
+          object,
+          name,
+          dynamicToJSValue(ctx, item.second, depth + 1),
+          kJSPropertyAttributeNone,
+          nullptr);
+      }
+      return object;
+    }
+  }
+  return JSValueMakeNull(ctx);
+}
+
+static folly::dynamic jsValueToDynamic(
+    JSContextRef ctx,
+    JSValueRef value,
+    JSObjectRef arrayConstructor,
+    int depth) {
+  if (depth > kMaxConversionDepth) {
+    jni::throwNewJavaException(
+        "java/lang/IllegalArgumentException",
+        "Value is nested more than %d levels deep",
+        kMaxConversionDepth);
+  }
+  switch (JSValueGetType(ctx, value)) {
+    case kJSTypeUndefined:
+    case kJSTypeNull:
+      return nullptr;
+    case kJSTypeBoolean:
+      return JSValueToBoolean(ctx, value);
+    case kJSTypeNumber: {
+      double number = JSValueToNumber(ctx, value, nullptr);
+      if (!std::isfinite(number)) {
+        return nullptr;
+      }
+      // Matches what parsing the JSON would give back for integral values
+      if (number == std::floor(number) && std::fabs(number) < 9007199254740992.0) {
+        return static_cast<int64_t>(number);
+      }
+      return number;
+    }
+    case kJSTypeString:
+      return String::adopt(JSValueToStringCopy(ctx, value, nullptr)).str();
+    case kJSTypeObject:
+      break;
+  }
+
+  JSObjectRef object = JSValueToObject(ctx, value, nullptr);
+  if (JSObjectIsFunction(ctx, object)) {
+    return nullptr;
+  }
+  if (JSValueIsInstanceOfConstructor(ctx, value, arrayConstructor, nullptr)) {
+    String lengthName = propertyName("length");
+    auto length = static_cast<unsigned>(
+      JSValueToNumber(ctx, JSObjectGetProperty(ctx, object, lengthName, nullptr), nullptr));
+    folly::dynamic array = {};
+    for (unsigned i = 0; i < length; i++) {
+      array.push_back(jsValueToDynamic(
+        ctx, JSObjectGetPropertyAtIndex(ctx, object, i, nullptr), arrayConstructor, depth + 1));
+    }
+    return array;
+  }
+
+  folly::dynamic result = folly::dynamic::object;
+  JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(ctx, object);
+  size_t count = JSPropertyNameArrayGetCount(names);
+  for (size_t i = 0; i < count; i++) {
+    JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+    JSValueRef property = JSObjectGetProperty(ctx, object, name, nullptr);
+    // Like JSON.stringify, skip properties that have no JSON representation
+    if (JSValueIsUndefined(ctx, property) ||
+        (JSValueIsObject(ctx, property) &&
+         JSObjectIsFunction(ctx, JSValueToObject(ctx, property, nullptr)))) {
+      continue;
+    }
+    result.insert(
+      String::ref(name).str(),
+      jsValueToDynamic(ctx, property, arrayConstructor, depth + 1));
+  }
+  JSPropertyNameArrayRelease(names);
+  return result;
+}
+
+folly::dynamic Value::toDynamic() const {
+  String arrayName = propertyName("Array");
+  JSObjectRef arrayConstructor = JSValueToObject(
+    m_context,
+    JSObjectGetProperty(m_context, JSContextGetGlobalObject(m_context), arrayName, nullptr),
+    nullptr);
+  return jsValueToDynamic(m_context, m_value, arrayConstructor, 0);
+}
+
+/* static */
+Value Value::fromDynamic(JSContextRef ctx, const folly::dynamic& value) {
+  JSValueRef jsValue = dynamicToJSValue(ctx, value, 0);
+  JSValueProtect(ctx, jsValue);
+  return Value(ctx, jsValue);
 }
 
 /* static */
@@ -8,6 +8,13 @@
 #include <JavaScriptCore/JSStringRef.h>
 #include <JavaScriptCore/JSValueRef.h>
 #include <fb/noncopyable.h>
+#include <jni/fbjni.h>
+
+namespace folly {
+
+struct dynamic;
+
+}
 
 namespace facebook {
 namespace react {
@@ -48,6 +55,10 @@ public:
     return std::string(bytes, length);
   }
 
+  // A Java string with the same contents, made from the UTF-16 characters without going through
+  // UTF-8 like str() would
+  jni::local_ref<jstring> toJString() const;
+
   // Assumes that utf8 is null terminated
   bool equals(const char* utf8) {
     return JSStringIsEqualToUTF8CString(m_string.get(), utf8);
@@ -128,7 +139,13 @@ public:
   }
 
   std::string toJSONString(unsigned indent = 0) const;
+  // Like toJSONString, but keeps the result as a JS string, without transcoding it to UTF-8
+  String createJSONString(unsigned indent = 0) const;
   static Value fromJSON(JSContextRef& ctx, const String& json);
+  // Convert like JSON.stringify/JSON.parse would, except that toJSON() is not honoured, but
+  // without going through a JSON string. Cheaper for small values, see JSCExecutor.
+  folly::dynamic toDynamic() const;
+  static Value fromDynamic(JSContextRef ctx, const folly::dynamic& value);
 protected:
   JSContextRef context() const;
   JSContextRef m_context;
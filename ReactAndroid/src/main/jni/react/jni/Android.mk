@@ -6,9 +6,13 @@ LOCAL_MODULE := reactnativejni
 
 LOCAL_SRC_FILES := \
   OnLoad.cpp \
+  CpuAffinity.cpp \
   ProxyExecutor.cpp \
   NativeArray.cpp \
+  JSDelta.cpp \
   JSLoader.cpp \
+  JStringCache.cpp \
+  MethodCallBuffer.cpp \
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)
 
@@ -17,7 +21,7 @@ CXX11_FLAGS := -std=c++11
 LOCAL_CFLAGS += $(CXX11_FLAGS)
 LOCAL_EXPORT_CPPFLAGS := $(CXX11_FLAGS)
 
-LOCAL_LDLIBS += -landroid
+LOCAL_LDLIBS += -landroid -lz
 LOCAL_SHARED_LIBRARIES := libfolly_json libfbjni libjsc
 LOCAL_STATIC_LIBRARIES := libreactnative
 
@@ -0,0 +1,82 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "CpuAffinity.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+struct CpuSets {
+  cpu_set_t fastCores;
+  cpu_set_t allCores;
+  bool hasSlowCores;
+};
+
+long readMaxFrequency(int cpu) {
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    return -1;
+  }
+  long frequency = -1;
+  if (fscanf(file, "%ld", &frequency) != 1) {
+    frequency = -1;
+  }
+  fclose(file);
+  return frequency;
+}
+
+// The cores don't change while the app runs, though the ones that are offline right now may not
+// report a frequency. Those count as slow cores.
+CpuSets readCpuSets() {
+  CpuSets sets;
+  CPU_ZERO(&sets.fastCores);
+  CPU_ZERO(&sets.allCores);
+  sets.hasSlowCores = false;
+
+  long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+  if (cpuCount > CPU_SETSIZE) {
+    cpuCount = CPU_SETSIZE;
+  }
+
+  long maxFrequency = -1;
+  long frequencies[CPU_SETSIZE];
+  for (int cpu = 0; cpu < cpuCount; cpu++) {
+    CPU_SET(cpu, &sets.allCores);
+    frequencies[cpu] = readMaxFrequency(cpu);
+    if (frequencies[cpu] > maxFrequency) {
+      maxFrequency = frequencies[cpu];
+    }
+  }
+  if (maxFrequency <= 0) {
+    return sets;
+  }
+
+  for (int cpu = 0; cpu < cpuCount; cpu++) {
+    if (frequencies[cpu] == maxFrequency) {
+      CPU_SET(cpu, &sets.fastCores);
+    } else {
+      sets.hasSlowCores = true;
+    }
+  }
+  return sets;
+}
+
+}
+
+bool setThreadPrefersFastCores(pid_t tid, bool prefersFastCores) {
+  static const CpuSets sets = readCpuSets();
+  if (!sets.hasSlowCores) {
+    return false;
+  }
+  const cpu_set_t* set = prefersFastCores ? &sets.fastCores : &sets.allCores;
+  return sched_setaffinity(tid, sizeof(cpu_set_t), set) == 0;
+}
+
+} }
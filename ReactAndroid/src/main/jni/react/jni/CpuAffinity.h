@@ -0,0 +1,17 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <sys/types.h>
+
+namespace facebook {
+namespace react {
+
+/**
+ * Restricts the thread to the cores with the highest maximum frequency, the big cores of a
+ * big.LITTLE device, or lets it run on every core again. Returns false when the affinity wasn't
+ * changed, which includes devices where all cores are the same, so it's only ever a hint.
+ */
+bool setThreadPrefersFastCores(pid_t tid, bool prefersFastCores);
+
+} }
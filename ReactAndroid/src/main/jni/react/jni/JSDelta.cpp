@@ -0,0 +1,216 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JSDelta.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include "JSLoader.h"
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+const char kDeltaMagic[] = "RNDELTA1";
+const size_t kDeltaMagicLength = sizeof(kDeltaMagic) - 1;
+const uint32_t kDeltaBodyFollows = 0xFFFFFFFF;
+
+const uint32_t kSHA256RoundConstants[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotateRight(uint32_t value, int bits) {
+  return (value >> bits) | (value << (32 - bits));
+}
+
+void sha256Block(uint32_t state[8], const uint8_t block[64]) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+      (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+  }
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; i++) {
+    uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+    uint32_t choice = (e & f) ^ (~e & g);
+    uint32_t t1 = h + s1 + choice + kSHA256RoundConstants[i] + w[i];
+    uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+    uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = s0 + majority;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+class DeltaReader {
+public:
+  DeltaReader(const char* data, size_t size) :
+    m_data(data),
+    m_size(size),
+    m_offset(0)
+  {}
+
+  const char* read(size_t length) {
+    if (length > m_size - m_offset) {
+      throw std::runtime_error("Truncated bundle delta");
+    }
+    const char* bytes = m_data + m_offset;
+    m_offset += length;
+    return bytes;
+  }
+
+  uint32_t readUInt32() {
+    auto bytes = reinterpret_cast<const uint8_t*>(read(4));
+    return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) |
+      (uint32_t(bytes[3]) << 24);
+  }
+
+  bool atEnd() const {
+    return m_offset == m_size;
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+  size_t m_offset;
+};
+
+bool digestEquals(const SHA256Digest& digest, const char* bytes) {
+  return memcmp(digest.data(), bytes, digest.size()) == 0;
+}
+
+void writeFile(const std::string& fileName, const std::string& contents) {
+  // Written next to the output and moved over it, so a cached bundle is never half written
+  std::string tempFileName = fileName + ".tmp";
+  int fd = open(tempFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    throw std::runtime_error("Unable to create bundle file: " + tempFileName);
+  }
+  size_t offset = 0;
+  while (offset < contents.size()) {
+    ssize_t writtenBytes = write(fd, contents.data() + offset, contents.size() - offset);
+    if (writtenBytes <= 0) {
+      break;
+    }
+    offset += writtenBytes;
+  }
+  bool written = offset == contents.size() && fsync(fd) == 0;
+  close(fd);
+  if (!written || rename(tempFileName.c_str(), fileName.c_str()) != 0) {
+    unlink(tempFileName.c_str());
+    throw std::runtime_error("Unable to write bundle file: " + fileName);
+  }
+}
+
+}
+
+SHA256Digest sha256(const char* data, size_t size) {
+  uint32_t state[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  auto bytes = reinterpret_cast<const uint8_t*>(data);
+  size_t offset = 0;
+  for (; offset + 64 <= size; offset += 64) {
+    sha256Block(state, bytes + offset);
+  }
+
+  // The rest of the input, a 1 bit, zeros and the input length in bits, in one or two blocks
+  uint8_t tail[128] = {};
+  size_t tailSize = size - offset;
+  memcpy(tail, bytes + offset, tailSize);
+  tail[tailSize] = 0x80;
+  size_t paddedSize = tailSize + 9 <= 64 ? 64 : 128;
+  uint64_t bitLength = uint64_t(size) * 8;
+  for (int i = 0; i < 8; i++) {
+    tail[paddedSize - 1 - i] = uint8_t(bitLength >> (i * 8));
+  }
+  sha256Block(state, tail);
+  if (paddedSize == 128) {
+    sha256Block(state, tail + 64);
+  }
+
+  SHA256Digest digest;
+  for (int i = 0; i < 8; i++) {
+    digest[i * 4] = uint8_t(state[i] >> 24);
+    digest[i * 4 + 1] = uint8_t(state[i] >> 16);
+    digest[i * 4 + 2] = uint8_t(state[i] >> 8);
+    digest[i * 4 + 3] = uint8_t(state[i]);
+  }
+  return digest;
+}
+
+std::string applyJSDelta(const char* base, size_t baseSize, const char* delta, size_t deltaSize) {
+  DeltaReader reader(delta, deltaSize);
+  if (memcmp(reader.read(kDeltaMagicLength), kDeltaMagic, kDeltaMagicLength) != 0) {
+    throw std::runtime_error("Not a bundle delta");
+  }
+  const char* baseDigest = reader.read(SHA256Digest().size());
+  const char* bundleDigest = reader.read(SHA256Digest().size());
+  if (!digestEquals(sha256(base, baseSize), baseDigest)) {
+    throw std::runtime_error("Bundle delta was built against a different bundle");
+  }
+
+  std::string bundle;
+  uint32_t moduleCount = reader.readUInt32();
+  for (uint32_t i = 0; i < moduleCount; i++) {
+    uint32_t baseOffset = reader.readUInt32();
+    uint32_t length = reader.readUInt32();
+    if (baseOffset == kDeltaBodyFollows) {
+      bundle.append(reader.read(length), length);
+    } else if (baseOffset <= baseSize && length <= baseSize - baseOffset) {
+      bundle.append(base + baseOffset, length);
+    } else {
+      throw std::runtime_error("Bundle delta refers past the end of the bundle");
+    }
+  }
+  if (!reader.atEnd()) {
+    throw std::runtime_error("Unexpected data after the bundle delta");
+  }
+  if (!digestEquals(sha256(bundle.data(), bundle.size()), bundleDigest)) {
+    throw std::runtime_error("Bundle built from delta doesn't match its hash");
+  }
+  return bundle;
+}
+
+void applyJSDeltaFile(
+    const std::string& baseFileName,
+    const std::string& deltaFileName,
+    const std::string& outputFileName) {
+  auto base = loadScriptFromFile(baseFileName);
+  auto delta = loadScriptFromFile(deltaFileName);
+  auto bundle = applyJSDelta(base->c_str(), base->size(), delta->c_str(), delta->size());
+  writeFile(outputFileName, bundle);
+}
+
+} }
@@ -0,0 +1,41 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace facebook {
+namespace react {
+
+typedef std::array<uint8_t, 32> SHA256Digest;
+
+SHA256Digest sha256(const char* data, size_t size);
+
+/**
+ * Builds a bundle from the cached bundle it was built against and a delta that only carries the
+ * module bodies that changed. Numbers are little endian uint32s:
+ *
+ *   delta  := "RNDELTA1" sha256(base) sha256(bundle) uint32(moduleCount) module*
+ *   module := uint32(baseOffset) uint32(length)
+ *           | uint32(0xFFFFFFFF) uint32(length) bytes
+ *
+ * The modules of the new bundle come in order, each either copied from a range of the base or
+ * carried in the delta. The server that built the base knows where its modules are, and may merge
+ * adjacent unchanged ones into one range. Throws std::runtime_error when the delta is malformed,
+ * when it was built against a different base, or when the result doesn't hash to what the delta
+ * expects.
+ */
+std::string applyJSDelta(const char* base, size_t baseSize, const char* delta, size_t deltaSize);
+
+/**
+ * Applies the delta in deltaFileName to the bundle in baseFileName, and only once the result is
+ * verified, writes it to outputFileName, replacing whatever was there.
+ */
+void applyJSDeltaFile(
+  const std::string& baseFileName,
+  const std::string& deltaFileName,
+  const std::string& outputFileName);
+
+} }
@@ -2,59 +2,374 @@
 
 #include "JSLoader.h"
 
+#include <algorithm>
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
-#include <fstream>
-#include <sstream>
-#include <streambuf>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
 #include <fb/log.h>
+#include <jni/fbjni.h>
 
 namespace facebook {
 namespace react {
 
-std::string loadScriptFromAssets(
-    JNIEnv *env,
-    jobject assetManager,
-    std::string assetName) {
-  auto manager = AAssetManager_fromJava(env, assetManager);
-  if (manager) {
+JSBigMmapString::~JSBigMmapString() {
+  munmap(const_cast<char*>(m_data), m_size);
+}
+
+static std::unique_ptr<const JSBigString> emptyScript() {
+  return std::unique_ptr<const JSBigString>(new JSBigStdString(""));
+}
+
+const size_t kReadChunkSize = 64 * 1024;
+// Keeps the reader busy while inflating catches up, without holding the whole file in chunks
+const size_t kMaxReadAheadChunks = 8;
+// Minified JS usually shrinks to a fifth or less, a first guess for the size of the output
+const size_t kExpectedCompressionRatio = 4;
+// Tells zlib to expect a gzip header and trailer
+const int kGzipWindowBits = 16 + MAX_WBITS;
+
+static bool hasSuffix(const std::string& string, const std::string& suffix) {
+  return string.size() >= suffix.size() &&
+    string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Reads a stream a few chunks ahead of the caller, on a thread of its own, so that reading a
+ * compressed bundle from slow storage overlaps with inflating it.
+ */
+class ReadAheadStream {
+public:
+  typedef std::function<ssize_t(char* buffer, size_t size)> ReadFunction;
+
+  explicit ReadAheadStream(ReadFunction read) :
+    m_read(std::move(read)),
+    m_thread(&ReadAheadStream::readLoop, this)
+  {}
+
+  ~ReadAheadStream() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_cancelled = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+  }
+
+  // Returns false once the stream is read, or failed to be
+  bool next(std::vector<char>& chunk) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_done || !m_chunks.empty(); });
+    if (m_chunks.empty()) {
+      return false;
+    }
+    chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    m_condition.notify_all();
+    return true;
+  }
+
+  bool failed() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+  }
+
+private:
+  void readLoop() {
+    while (true) {
+      std::vector<char> chunk(kReadChunkSize);
+      ssize_t readBytes = m_read(chunk.data(), chunk.size());
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (readBytes <= 0) {
+        m_failed = readBytes < 0;
+        m_done = true;
+        m_condition.notify_all();
+        return;
+      }
+      chunk.resize(readBytes);
+      m_condition.wait(lock, [this] {
+        return m_cancelled || m_chunks.size() < kMaxReadAheadChunks;
+      });
+      if (m_cancelled) {
+        return;
+      }
+      m_chunks.push_back(std::move(chunk));
+      m_condition.notify_all();
+    }
+  }
+
+  ReadFunction m_read;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::vector<char>> m_chunks;
+  bool m_done = false;
+  bool m_failed = false;
+  bool m_cancelled = false;
+  // Last, so that it starts once everything it uses is initialized
+  std::thread m_thread;
+};
+
+/**
+ * Inflates a gzip stream straight into the script. Returns null if it's truncated or corrupt.
+ */
+static std::unique_ptr<const JSBigString> inflateScript(
+    ReadAheadStream& stream,
+    size_t compressedSize) {
+  z_stream inflater = {};
+  if (inflateInit2(&inflater, kGzipWindowBits) != Z_OK) {
+    return nullptr;
+  }
+  std::string script(std::max(compressedSize * kExpectedCompressionRatio, kReadChunkSize), '\0');
+  size_t inflatedSize = 0;
+  int status = Z_OK;
+  std::vector<char> chunk;
+  while (status == Z_OK && stream.next(chunk)) {
+    inflater.next_in = reinterpret_cast<Bytef*>(chunk.data());
+    inflater.avail_in = chunk.size();
+    // Also goes on when the output filled up, zlib may still hold some of it
+    while (status == Z_OK && (inflater.avail_in > 0 || inflatedSize == script.size())) {
+      if (inflatedSize == script.size()) {
+        script.resize(script.size() * 2);
+      }
+      inflater.next_out = reinterpret_cast<Bytef*>(&script[inflatedSize]);
+      inflater.avail_out = script.size() - inflatedSize;
+      status = inflate(&inflater, Z_NO_FLUSH);
+      inflatedSize = script.size() - inflater.avail_out;
+      if (status == Z_BUF_ERROR) {
+        // Nothing left to inflate until the next chunk
+        status = Z_OK;
+        break;
+      }
+    }
+  }
+  inflateEnd(&inflater);
+  if (status != Z_STREAM_END || stream.failed()) {
+    return nullptr;
+  }
+  script.resize(inflatedSize);
+  return std::unique_ptr<const JSBigString>(new JSBigStdString(std::move(script)));
+}
+
+// Assets can not change while the app runs, so their name is enough to identify them
+static std::mutex gAssetScriptsMutex;
+static std::unordered_map<std::string, std::weak_ptr<const JSBigString>> gAssetScripts;
+
+static std::shared_ptr<const JSBigString> findAssetScript(const std::string& assetName) {
+  std::lock_guard<std::mutex> lock(gAssetScriptsMutex);
+  auto it = gAssetScripts.find(assetName);
+  if (it == gAssetScripts.end()) {
+    return nullptr;
+  }
+  auto script = it->second.lock();
+  if (!script) {
+    gAssetScripts.erase(it);
+  }
+  return script;
+}
+
+static std::unique_ptr<const JSBigString> readCompressedAsset(
+    AAssetManager* manager,
+    const std::string& assetName) {
+  auto asset = AAssetManager_open(manager, assetName.c_str(), AASSET_MODE_STREAMING);
+  if (!asset) {
+    return nullptr;
+  }
+  std::unique_ptr<const JSBigString> script;
+  {
+    ReadAheadStream stream([asset] (char* buffer, size_t size) -> ssize_t {
+      return AAsset_read(asset, buffer, size);
+    });
+    script = inflateScript(stream, AAsset_getLength(asset));
+  }
+  AAsset_close(asset);
+  return script;
+}
+
+static std::unique_ptr<const JSBigString> readAsset(
+    AAssetManager* manager,
+    const std::string& assetName) {
+  if (manager && hasSuffix(assetName, ".gz")) {
+    auto script = readCompressedAsset(manager, assetName);
+    if (script) {
+      return script;
+    }
+  } else if (manager) {
     auto asset = AAssetManager_open(
       manager,
       assetName.c_str(),
-      AASSET_MODE_STREAMING); // Optimized for sequential read: see AssetManager.java for docs
+      AASSET_MODE_BUFFER); // Whole asset in memory, mapped directly if stored uncompressed
     if (asset) {
-      std::stringbuf buf;
-      char BUF[0x800];
-      int readbytes;
-      while ((readbytes = AAsset_read(asset, BUF, sizeof(BUF))) > 0) {
-        buf.sputn(BUF, readbytes);
+      auto buffer = static_cast<const char*>(AAsset_getBuffer(asset));
+      auto length = AAsset_getLength(asset);
+      std::unique_ptr<const JSBigString> script;
+      if (buffer) {
+        // The asset buffer isn't null terminated, so this is our one copy of the bundle
+        script.reset(new JSBigStdString(std::string(buffer, length)));
       }
       AAsset_close(asset);
-      if (readbytes == 0) { // EOF!
-        return buf.str();
+      if (script) {
+        return script;
       }
     }
   }
   FBLOGE("Unable to load script from assets: %s", assetName.c_str());
-  return "";
+  return emptyScript();
+}
+
+// Returns null if the asset couldn't be read. Failed loads are not cached, the next bridge gets
+// to try again.
+static std::shared_ptr<const JSBigString> readAndCacheAsset(
+    AAssetManager* manager,
+    const std::string& assetName) {
+  auto loaded = readAsset(manager, assetName);
+  if (loaded->size() == 0) {
+    return nullptr;
+  }
+  // Two bridges can race to read the same asset, the first one to get here wins
+  std::lock_guard<std::mutex> lock(gAssetScriptsMutex);
+  auto& entry = gAssetScripts[assetName];
+  auto script = entry.lock();
+  if (!script) {
+    script = std::shared_ptr<const JSBigString>(std::move(loaded));
+    entry = script;
+  }
+  return script;
+}
+
+// Reads started by prefetchScriptFromAssets, until a bridge loads them. Each holds on to the
+// asset manager it reads from for as long as it is pending.
+struct PendingAssetScript {
+  jni::global_ref<jobject> assetManager;
+  std::shared_future<std::shared_ptr<const JSBigString>> script;
+};
+static std::unordered_map<std::string, PendingAssetScript> gPendingAssetScripts;
+
+void prefetchScriptFromAssets(
+    JNIEnv *env,
+    jobject assetManager,
+    const std::string& assetName) {
+  auto manager = AAssetManager_fromJava(env, assetManager);
+  if (!manager || findAssetScript(assetName)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(gAssetScriptsMutex);
+  if (gPendingAssetScripts.count(assetName)) {
+    return;
+  }
+  auto promise = std::make_shared<std::promise<std::shared_ptr<const JSBigString>>>();
+  gPendingAssetScripts[assetName] = PendingAssetScript{
+    jni::make_global(assetManager),
+    promise->get_future().share(),
+  };
+  // Only touches the native asset manager, so the thread doesn't need to attach to the VM
+  std::thread([manager, assetName, promise] {
+    promise->set_value(readAndCacheAsset(manager, assetName));
+  }).detach();
+}
+
+std::unique_ptr<const JSBigString> loadScriptFromAssets(
+    JNIEnv *env,
+    jobject assetManager,
+    const std::string& assetName) {
+  PendingAssetScript pending;
+  {
+    std::lock_guard<std::mutex> lock(gAssetScriptsMutex);
+    auto it = gPendingAssetScripts.find(assetName);
+    if (it != gPendingAssetScripts.end()) {
+      pending = std::move(it->second);
+      gPendingAssetScripts.erase(it);
+    }
+  }
+
+  std::shared_ptr<const JSBigString> script;
+  if (pending.script.valid()) {
+    // The read already failed and logged why if this comes back null
+    script = pending.script.get();
+    if (!script) {
+      return emptyScript();
+    }
+  } else {
+    script = findAssetScript(assetName);
+    if (!script) {
+      script = readAndCacheAsset(AAssetManager_fromJava(env, assetManager), assetName);
+    }
+    if (!script) {
+      return emptyScript();
+    }
+  }
+  return std::unique_ptr<const JSBigString>(new JSBigSharedString(std::move(script)));
 }
 
-std::string loadScriptFromFile(std::string fileName) {
-  std::ifstream jsfile(fileName);
-  if (jsfile) {
-    std::string output;
-    jsfile.seekg(0, std::ios::end);
-    output.reserve(jsfile.tellg());
-    jsfile.seekg(0, std::ios::beg);
-    output.assign(
-      (std::istreambuf_iterator<char>(jsfile)),
-      std::istreambuf_iterator<char>());
-    return output;
+std::unique_ptr<const JSBigString> loadScriptFromFile(const std::string& fileName) {
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    FBLOGE("Unable to load script from file: %s", fileName.c_str());
+    return emptyScript();
+  }
+
+  struct stat fileInfo;
+  if (fstat(fd, &fileInfo) == -1) {
+    FBLOGE("Unable to stat script file: %s", fileName.c_str());
+    close(fd);
+    return emptyScript();
   }
+  size_t size = fileInfo.st_size;
 
-  FBLOGE("Unable to load script from file: %s", fileName.c_str());
-  return "";
+  unsigned char magic[2];
+  if (pread(fd, magic, sizeof(magic), 0) == sizeof(magic) && magic[0] == 0x1f && magic[1] == 0x8b) {
+    std::unique_ptr<const JSBigString> script;
+    {
+      ReadAheadStream stream([fd] (char* buffer, size_t size) -> ssize_t {
+        return read(fd, buffer, size);
+      });
+      script = inflateScript(stream, size);
+    }
+    close(fd);
+    if (!script) {
+      FBLOGE("Unable to inflate script from file: %s", fileName.c_str());
+      return emptyScript();
+    }
+    return script;
+  }
+
+  if (size > 0 && size % sysconf(_SC_PAGESIZE) != 0) {
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      close(fd);
+      return std::unique_ptr<const JSBigString>(
+        new JSBigMmapString(static_cast<const char*>(data), size));
+    }
+    FBLOGW("Unable to mmap script file, reading it instead: %s", fileName.c_str());
+  }
+
+  std::string script(size, '\0');
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t readBytes = read(fd, &script[offset], size - offset);
+    if (readBytes <= 0) {
+      break;
+    }
+    offset += readBytes;
+  }
+  close(fd);
+  if (offset != size) {
+    FBLOGE("Unable to read script from file: %s", fileName.c_str());
+    return emptyScript();
+  }
+  return std::unique_ptr<const JSBigString>(new JSBigStdString(std::move(script)));
 }
 
-} }
\ No newline at end of file
+} }
@@ -2,20 +2,85 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <jni.h>
+#include <react/Executor.h>
 
 namespace facebook {
 namespace react {
 
 /**
- * Helper method for loading JS script from android asset
+ * A script backed by a read-only private mapping of a file. Only used when the file size is not
+ * a multiple of the page size, since the zero fill after EOF is what null terminates it.
  */
-std::string loadScriptFromAssets(JNIEnv *env, jobject assetManager, std::string assetName);
+class JSBigMmapString : public JSBigString {
+public:
+  JSBigMmapString(const char* data, size_t size) :
+    m_data(data),
+    m_size(size)
+  {}
+  ~JSBigMmapString() override;
+
+  const char* c_str() const override {
+    return m_data;
+  }
+
+  size_t size() const override {
+    return m_size;
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+};
+
+/**
+ * A handle on a script that several bridges may be running at once. The script itself is
+ * immutable and freed with its last handle.
+ */
+class JSBigSharedString : public JSBigString {
+public:
+  explicit JSBigSharedString(std::shared_ptr<const JSBigString> script) :
+    m_script(std::move(script))
+  {}
+
+  const char* c_str() const override {
+    return m_script->c_str();
+  }
+
+  size_t size() const override {
+    return m_script->size();
+  }
+
+private:
+  std::shared_ptr<const JSBigString> m_script;
+};
+
+/**
+ * Helper method for loading JS script from android asset. Bridges that load the same asset while
+ * another still holds it share a single copy, and a shared JSC context group then also gets to
+ * reuse the code compiled for it. Assets named *.gz are inflated while they are being read.
+ */
+std::unique_ptr<const JSBigString> loadScriptFromAssets(
+  JNIEnv *env,
+  jobject assetManager,
+  const std::string& assetName);
+
+/**
+ * Starts reading a script from the assets on a thread of its own, so that it is read while the
+ * bridge and its module config are being set up. The next loadScriptFromAssets of the same asset
+ * then waits for that read instead of starting over.
+ */
+void prefetchScriptFromAssets(
+  JNIEnv *env,
+  jobject assetManager,
+  const std::string& assetName);
 
 /**
- * Helper method for loading JS script from a file
+ * Helper method for loading JS script from a file. The file is memory mapped when possible, or
+ * inflated while it is being read if it is gzipped.
  */
-std::string loadScriptFromFile(std::string fileName);
+std::unique_ptr<const JSBigString> loadScriptFromFile(const std::string& fileName);
 
 } }
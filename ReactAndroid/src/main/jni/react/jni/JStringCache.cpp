@@ -0,0 +1,77 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "JStringCache.h"
+
+#include <fb/log.h>
+#include <jni/LocalString.h>
+
+namespace facebook {
+namespace react {
+
+// Log the hit rate every this many lookups
+static const uint32_t kReportInterval = 1 << 16;
+
+JStringCache& JStringCache::get() {
+  // Leaked on purpose, the global refs it holds live as long as the process anyway
+  static JStringCache* cache = new JStringCache();
+  return *cache;
+}
+
+jstring JStringCache::newLocalKey(JNIEnv* env, const std::string& str) {
+  if (str.size() > kMaxStringLength) {
+    recordLookup(false);
+    jni::LocalString string(str);
+    return static_cast<jstring>(env->NewLocalRef(string.string()));
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_strings.find(str);
+  if (it != m_strings.end()) {
+    recordLookup(true);
+    return static_cast<jstring>(env->NewLocalRef(it->second));
+  }
+
+  recordLookup(false);
+  jni::LocalString string(str);
+  if (m_strings.size() < kMaxEntries) {
+    auto global = static_cast<jstring>(env->NewGlobalRef(string.string()));
+    if (global) {
+      m_strings.emplace(str, global);
+    }
+  }
+  return static_cast<jstring>(env->NewLocalRef(string.string()));
+}
+
+void JStringCache::recordLookup(bool hit) {
+  if (hit) {
+    m_hits++;
+  }
+  if (++m_lookups % kReportInterval == 0) {
+    // Approximate under contention, which is good enough for a rate
+    FBLOGD(
+      "jstring cache hit rate: %u%% over the last %u lookups",
+      m_hits.exchange(0) * 100 / kReportInterval,
+      kReportInterval);
+  }
+}
+
+std::string fromJStringKey(JNIEnv* env, jstring str) {
+  jsize length = env->GetStringLength(str);
+  if (length > static_cast<jsize>(JStringCache::kMaxStringLength)) {
+    return jni::fromJString(env, str);
+  }
+
+  jchar chars[JStringCache::kMaxStringLength];
+  env->GetStringRegion(str, 0, length, chars);
+  std::string key(length, '\0');
+  for (jsize i = 0; i < length; i++) {
+    // NUL and anything beyond ASCII need the full conversion
+    if (chars[i] == 0 || chars[i] > 0x7f) {
+      return jni::fromJString(env, str);
+    }
+    key[i] = static_cast<char>(chars[i]);
+  }
+  return key;
+}
+
+} }
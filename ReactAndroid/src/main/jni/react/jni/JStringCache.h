@@ -0,0 +1,54 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <jni.h>
+
+namespace facebook {
+namespace react {
+
+/**
+ * Interns the map keys that cross the bridge over and over, prop and style names mostly, as
+ * global jstring refs so that handing one to Java doesn't re-encode and allocate it every time.
+ * Only keys go through it: they come from a small, fixed vocabulary, so entries are never
+ * evicted and the cache stops growing once it is full, since the keys worth caching tend to be
+ * seen early and keep being seen. String values are converted every time, text and ids would
+ * only fill the cache with strings that are never seen again.
+ *
+ * The map natives have no link back to a bridge, so a single instance is shared by all of them.
+ */
+class JStringCache {
+public:
+  static const size_t kMaxEntries = 1024;
+  static const size_t kMaxStringLength = 64;
+
+  static JStringCache& get();
+
+  // Returns a new local ref holding the map key str, shared with earlier calls when possible
+  jstring newLocalKey(JNIEnv* env, const std::string& str);
+
+private:
+  JStringCache() :
+    m_lookups(0),
+    m_hits(0)
+  {}
+
+  void recordLookup(bool hit);
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, jstring> m_strings;
+  std::atomic<uint32_t> m_lookups;
+  std::atomic<uint32_t> m_hits;
+};
+
+/**
+ * Same result as jni::fromJString, but keys that are plain ASCII (nearly all of them) are copied
+ * straight out of the UTF-16 chars instead of going through modified UTF-8.
+ */
+std::string fromJStringKey(JNIEnv* env, jstring str);
+
+} }
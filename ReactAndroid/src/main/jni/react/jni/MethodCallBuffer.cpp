@@ -0,0 +1,149 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "MethodCallBuffer.h"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <folly/dynamic.h>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// Keep in sync with MethodCallBuffer.java
+enum : uint8_t {
+  kTagNull = 0,
+  kTagFalse = 1,
+  kTagTrue = 2,
+  kTagNumber = 3,
+  kTagString = 4,
+  kTagArray = 5,
+  kTagMap = 6,
+  kTagNumberArray = 7,
+};
+
+bool isNumberArray(const folly::dynamic& array) {
+  if (array.empty()) {
+    return false;
+  }
+  for (const auto& item : array) {
+    if (!item.isNumber()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void writeRaw(std::vector<uint8_t>& out, T value) {
+  auto offset = out.size();
+  out.resize(offset + sizeof(T));
+  memcpy(&out[offset], &value, sizeof(T));
+}
+
+class MethodCallBufferWriter {
+public:
+  void writeCall(const MethodCall& call) {
+    writeRaw<int32_t>(m_calls, call.moduleId);
+    writeRaw<int32_t>(m_calls, call.methodId);
+    writeValue(call.arguments);
+    m_callCount++;
+  }
+
+  std::vector<uint8_t> finish() {
+    std::vector<uint8_t> out;
+    size_t stringBytes = 0;
+    for (const auto& string : m_strings) {
+      stringBytes += sizeof(int32_t) + string->size();
+    }
+    out.reserve(2 * sizeof(int32_t) + stringBytes + m_calls.size());
+
+    writeRaw<int32_t>(out, m_strings.size());
+    for (const auto& string : m_strings) {
+      writeRaw<int32_t>(out, string->size());
+      out.insert(out.end(), string->begin(), string->end());
+    }
+    writeRaw<int32_t>(out, m_callCount);
+    out.insert(out.end(), m_calls.begin(), m_calls.end());
+    return out;
+  }
+
+private:
+  void writeValue(const folly::dynamic& value) {
+    switch (value.type()) {
+      case folly::dynamic::Type::BOOL:
+        m_calls.push_back(value.getBool() ? kTagTrue : kTagFalse);
+        break;
+      case folly::dynamic::Type::INT64:
+        m_calls.push_back(kTagNumber);
+        writeRaw<double>(m_calls, value.getInt());
+        break;
+      case folly::dynamic::Type::DOUBLE:
+        m_calls.push_back(kTagNumber);
+        writeRaw<double>(m_calls, value.getDouble());
+        break;
+      case folly::dynamic::Type::STRING:
+        m_calls.push_back(kTagString);
+        writeRaw<int32_t>(m_calls, internString(value.getString()));
+        break;
+      case folly::dynamic::Type::ARRAY:
+        if (isNumberArray(value)) {
+          m_calls.push_back(kTagNumberArray);
+          writeRaw<int32_t>(m_calls, value.size());
+          for (const auto& item : value) {
+            writeRaw<double>(m_calls, item.asDouble());
+          }
+          break;
+        }
+        m_calls.push_back(kTagArray);
+        writeRaw<int32_t>(m_calls, value.size());
+        for (const auto& item : value) {
+          writeValue(item);
+        }
+        break;
+      case folly::dynamic::Type::OBJECT:
+        m_calls.push_back(kTagMap);
+        writeRaw<int32_t>(m_calls, value.size());
+        for (const auto& item : value.items()) {
+          writeRaw<int32_t>(m_calls, internString(item.first.getString()));
+          writeValue(item.second);
+        }
+        break;
+      default:
+        m_calls.push_back(kTagNull);
+        break;
+    }
+  }
+
+  int32_t internString(const folly::fbstring& string) {
+    auto inserted = m_stringIndices.emplace(
+      std::string(string.data(), string.size()), m_strings.size());
+    if (inserted.second) {
+      m_strings.push_back(&inserted.first->first);
+    }
+    return inserted.first->second;
+  }
+
+  std::vector<uint8_t> m_calls;
+  int32_t m_callCount = 0;
+  // Node based, so pointers to the keys stay valid as the map grows
+  std::unordered_map<std::string, int32_t> m_stringIndices;
+  std::vector<const std::string*> m_strings;
+};
+
+}
+
+std::vector<uint8_t> writeMethodCallBuffer(const std::vector<MethodCall>& calls) {
+  MethodCallBufferWriter writer;
+  for (const auto& call : calls) {
+    if (call.arguments.isNull()) {
+      continue;
+    }
+    writer.writeCall(call);
+  }
+  return writer.finish();
+}
+
+} }
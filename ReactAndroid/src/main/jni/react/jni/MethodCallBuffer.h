@@ -0,0 +1,31 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <react/MethodCall.h>
+
+namespace facebook {
+namespace react {
+
+/**
+ * Flattens a batch of method calls into a single buffer that Java reads in bulk through a direct
+ * ByteBuffer, see com.facebook.react.bridge.MethodCallBuffer. Numbers are in host byte order:
+ *
+ *   buffer := int32(stringCount) (int32(byteLength) utf8-bytes)* int32(callCount) call*
+ *   call   := int32(moduleId) int32(methodId) value
+ *   value  := NULL | FALSE | TRUE | NUMBER double | STRING int32(stringIndex)
+ *           | ARRAY int32(count) value*
+ *           | MAP int32(count) (int32(keyStringIndex) value)*
+ *           | NUMBER_ARRAY int32(count) double*
+ *
+ * Every value is a single tag byte followed by its payload. Non-empty arrays holding nothing but
+ * numbers are written as NUMBER_ARRAY, which Java keeps as a double[] instead of boxing each
+ * element. Strings are interned, so property
+ * names repeated across a batch are only decoded once on the Java side. Calls without arguments
+ * are dropped, as they were when calls were delivered one by one.
+ */
+std::vector<uint8_t> writeMethodCallBuffer(const std::vector<MethodCall>& calls);
+
+} }
@@ -1,5 +1,13 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <android/input.h>
 #include <fb/log.h>
 #include <folly/json.h>
@@ -13,7 +21,12 @@
 #include <react/Bridge.h>
 #include <react/Executor.h>
 #include <react/JSCExecutor.h>
+#include <react/TraceBuffer.h>
+#include "CpuAffinity.h"
+#include "JSDelta.h"
 #include "JSLoader.h"
+#include "JStringCache.h"
+#include "MethodCallBuffer.h"
 #include "NativeArray.h"
 #include "ProxyExecutor.h"
 
@@ -23,7 +36,6 @@ namespace facebook {
 namespace react {
 
 static jclass gReadableNativeMapClass;
-static jmethodID gReadableNativeMapCtor;
 
 namespace exceptions {
 
@@ -57,6 +69,8 @@ struct ReadableNativeMapKeySeyIterator : public Countable {
 
 struct NativeRunnable : public Countable {
   std::function<void()> callable;
+  // Reusable runnables keep their callable and may be posted again once they have started running
+  bool runsOnce = true;
 };
 
 static jobject createReadableNativeMapWithContents(JNIEnv* env, folly::dynamic map) {
@@ -69,7 +83,10 @@ static jobject createReadableNativeMapWithContents(JNIEnv* env, folly::dynamic m
                           "expected Map, got a %s", map.typeName());
   }
 
-  jobject jnewMap = env->NewObject(gReadableNativeMapClass, gReadableNativeMapCtor);
+  // Looked up on first use, since that initializes the class, which registration must not do
+  static jmethodID readableNativeMapCtor =
+    env->GetMethodID(gReadableNativeMapClass, "<init>", "()V");
+  jobject jnewMap = env->NewObject(gReadableNativeMapClass, readableNativeMapCtor);
   if (env->ExceptionCheck()) {
     return nullptr;
   }
@@ -126,6 +143,156 @@ static jobject getType(folly::dynamic::Type type) {
 
 }
 
+namespace collections {
+
+// Copies a dynamic into Java objects in one go, for Java code that would otherwise read it back
+// value by value. Plain copies use HashMap and ArrayList, buffered ones the ReadableBufferMap and
+// ReadableBufferArray that MethodCallBuffer produces. Local refs are released as soon as a value
+// is stored, so that big or deeply nested values don't run out of them.
+
+static jclass gBooleanClass;
+static jmethodID gBooleanValueOf;
+static jclass gDoubleClass;
+static jmethodID gDoubleValueOf;
+static jclass gObjectClass;
+static jclass gHashMapClass;
+static jmethodID gHashMapCtor;
+static jmethodID gHashMapPut;
+static jclass gArrayListClass;
+static jmethodID gArrayListCtor;
+static jmethodID gArrayListAdd;
+static jclass gReadableBufferMapClass;
+static jmethodID gReadableBufferMapCtor;
+static jclass gReadableBufferArrayClass;
+static jmethodID gReadableBufferArrayValuesCtor;
+static jmethodID gReadableBufferArrayNumbersCtor;
+
+static jclass findGlobalClass(JNIEnv* env, const char* name) {
+  return (jclass)env->NewGlobalRef(findClassLocal(name).get());
+}
+
+static void initialize(JNIEnv* env) {
+  gBooleanClass = findGlobalClass(env, "java/lang/Boolean");
+  gBooleanValueOf = env->GetStaticMethodID(gBooleanClass, "valueOf", "(Z)Ljava/lang/Boolean;");
+  gDoubleClass = findGlobalClass(env, "java/lang/Double");
+  gDoubleValueOf = env->GetStaticMethodID(gDoubleClass, "valueOf", "(D)Ljava/lang/Double;");
+  gObjectClass = findGlobalClass(env, "java/lang/Object");
+  gHashMapClass = findGlobalClass(env, "java/util/HashMap");
+  gHashMapCtor = env->GetMethodID(gHashMapClass, "<init>", "(I)V");
+  gHashMapPut = env->GetMethodID(
+    gHashMapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+  gArrayListClass = findGlobalClass(env, "java/util/ArrayList");
+  gArrayListCtor = env->GetMethodID(gArrayListClass, "<init>", "(I)V");
+  gArrayListAdd = env->GetMethodID(gArrayListClass, "add", "(Ljava/lang/Object;)Z");
+  gReadableBufferMapClass = findGlobalClass(env, "com/facebook/react/bridge/ReadableBufferMap");
+  gReadableBufferMapCtor = env->GetMethodID(
+    gReadableBufferMapClass, "<init>", "(Ljava/util/HashMap;)V");
+  gReadableBufferArrayClass = findGlobalClass(env, "com/facebook/react/bridge/ReadableBufferArray");
+  gReadableBufferArrayValuesCtor = env->GetMethodID(
+    gReadableBufferArrayClass, "<init>", "([Ljava/lang/Object;)V");
+  gReadableBufferArrayNumbersCtor = env->GetMethodID(gReadableBufferArrayClass, "<init>", "([D)V");
+}
+
+static jobject toJavaObject(JNIEnv* env, const folly::dynamic& value, bool buffered);
+
+static jobject toJavaMap(JNIEnv* env, const folly::dynamic& map, bool buffered) {
+  jobject values = env->NewObject(gHashMapClass, gHashMapCtor, (jint) map.size());
+  throwPendingJniExceptionAsCppException();
+  for (const auto& item : map.items()) {
+    jstring key = JStringCache::get().newLocalKey(env, item.first.getString().toStdString());
+    jobject value = toJavaObject(env, item.second, buffered);
+    jobject previous = env->CallObjectMethod(values, gHashMapPut, key, value);
+    throwPendingJniExceptionAsCppException();
+    env->DeleteLocalRef(previous);
+    env->DeleteLocalRef(value);
+    env->DeleteLocalRef(key);
+  }
+  if (!buffered) {
+    return values;
+  }
+  jobject bufferMap = env->NewObject(gReadableBufferMapClass, gReadableBufferMapCtor, values);
+  throwPendingJniExceptionAsCppException();
+  env->DeleteLocalRef(values);
+  return bufferMap;
+}
+
+static jobject toJavaList(JNIEnv* env, const folly::dynamic& array, bool buffered) {
+  if (!buffered) {
+    jobject values = env->NewObject(gArrayListClass, gArrayListCtor, (jint) array.size());
+    throwPendingJniExceptionAsCppException();
+    for (const auto& element : array) {
+      jobject value = toJavaObject(env, element, buffered);
+      env->CallBooleanMethod(values, gArrayListAdd, value);
+      throwPendingJniExceptionAsCppException();
+      env->DeleteLocalRef(value);
+    }
+    return values;
+  }
+
+  // Like MethodCallBuffer, keep arrays of only numbers unboxed
+  bool allNumbers = std::all_of(array.begin(), array.end(), [] (const folly::dynamic& element) {
+    return element.isNumber();
+  });
+  jobject bufferArray;
+  if (allNumbers) {
+    std::vector<jdouble> numbers;
+    numbers.reserve(array.size());
+    for (const auto& element : array) {
+      numbers.push_back(element.isInt() ? element.getInt() : element.getDouble());
+    }
+    jdoubleArray jnumbers = env->NewDoubleArray(numbers.size());
+    throwPendingJniExceptionAsCppException();
+    env->SetDoubleArrayRegion(jnumbers, 0, numbers.size(), numbers.data());
+    bufferArray = env->NewObject(
+      gReadableBufferArrayClass, gReadableBufferArrayNumbersCtor, jnumbers);
+    env->DeleteLocalRef(jnumbers);
+  } else {
+    jobjectArray jvalues = env->NewObjectArray(array.size(), gObjectClass, nullptr);
+    throwPendingJniExceptionAsCppException();
+    for (size_t i = 0; i < array.size(); i++) {
+      jobject value = toJavaObject(env, array[i], buffered);
+      env->SetObjectArrayElement(jvalues, i, value);
+      env->DeleteLocalRef(value);
+    }
+    bufferArray = env->NewObject(
+      gReadableBufferArrayClass, gReadableBufferArrayValuesCtor, jvalues);
+    env->DeleteLocalRef(jvalues);
+  }
+  throwPendingJniExceptionAsCppException();
+  return bufferArray;
+}
+
+static jobject toJavaObject(JNIEnv* env, const folly::dynamic& value, bool buffered) {
+  jobject object;
+  switch (value.type()) {
+    case folly::dynamic::Type::NULLT:
+      return nullptr;
+    case folly::dynamic::Type::BOOL:
+      object = env->CallStaticObjectMethod(
+        gBooleanClass, gBooleanValueOf, value.getBool() ? JNI_TRUE : JNI_FALSE);
+      break;
+    case folly::dynamic::Type::INT64:
+      object = env->CallStaticObjectMethod(
+        gDoubleClass, gDoubleValueOf, (jdouble) value.getInt());
+      break;
+    case folly::dynamic::Type::DOUBLE:
+      object = env->CallStaticObjectMethod(gDoubleClass, gDoubleValueOf, value.getDouble());
+      break;
+    case folly::dynamic::Type::STRING:
+      return make_jstring(value.getString().c_str()).release();
+    case folly::dynamic::Type::OBJECT:
+      return toJavaMap(env, value, buffered);
+    case folly::dynamic::Type::ARRAY:
+      return toJavaList(env, value, buffered);
+    default:
+      throwNewJavaException(exceptions::gUnknownNativeTypeExceptionClass, "Unknown type");
+  }
+  throwPendingJniExceptionAsCppException();
+  return object;
+}
+
+}
+
 struct ReadableNativeArray : public NativeArray {
   static void mapException(const std::exception& ex) {
     if (dynamic_cast<const folly::TypeError*>(&ex) != 0) {
@@ -173,6 +340,23 @@ struct ReadableNativeArray : public NativeArray {
     return type::getType(array.at(index).type());
   }
 
+  jdoubleArray getDoubles() {
+    auto values = make_double_array(array.size());
+    {
+      // Nothing below may call back into JNI while the array is pinned
+      auto elements = values->pinCritical();
+      for (size_t i = 0; i < elements.size(); i++) {
+        const folly::dynamic& val = array[i];
+        elements[i] = val.isInt() ? val.getInt() : val.getDouble();
+      }
+    }
+    return values.release();
+  }
+
+  jobject toArrayList() {
+    return collections::toJavaList(Environment::current(), array, false);
+  }
+
   static void registerNatives() {
     jni::registerNatives("com/facebook/react/bridge/ReadableNativeArray", {
         makeNativeMethod("size", ReadableNativeArray::getSize),
@@ -186,6 +370,9 @@ struct ReadableNativeArray : public NativeArray {
                          ReadableNativeArray::getMap),
         makeNativeMethod("getType", "(I)Lcom/facebook/react/bridge/ReadableType;",
                          ReadableNativeArray::getType),
+        makeNativeMethod("getDoubles", "()[D", ReadableNativeArray::getDoubles),
+        makeNativeMethod("toArrayList", "()Ljava/util/ArrayList;",
+                         ReadableNativeArray::toArrayList),
     });
   }
 };
@@ -206,6 +393,27 @@ struct WritableNativeArray : public ReadableNativeArray {
     array.push_back(value);
   }
 
+  template <typename T, typename JArrayType>
+  void pushPrimitives(JArrayType values) {
+    exceptions::throwIfObjectAlreadyConsumed(this, "Receiving array already consumed");
+    if (values == NULL) {
+      return;
+    }
+    // Nothing below may call back into JNI while the array is pinned
+    auto elements = wrap_alias(values)->pinCritical(true);
+    for (size_t i = 0; i < elements.size(); i++) {
+      array.push_back(static_cast<T>(elements[i]));
+    }
+  }
+
+  void pushDoubles(jdoubleArray values) {
+    pushPrimitives<double>(values);
+  }
+
+  void pushInts(jintArray values) {
+    pushPrimitives<double>(values);
+  }
+
   void pushString(jstring value) {
     if (value == NULL) {
       pushNull();
@@ -244,6 +452,8 @@ struct WritableNativeArray : public ReadableNativeArray {
         makeNativeMethod("pushBoolean", WritableNativeArray::pushBoolean),
         makeNativeMethod("pushDouble", WritableNativeArray::pushDouble),
         makeNativeMethod("pushString", WritableNativeArray::pushString),
+        makeNativeMethod("pushDoubles", "([D)V", WritableNativeArray::pushDoubles),
+        makeNativeMethod("pushInts", "([I)V", WritableNativeArray::pushInts),
         makeNativeMethod("pushNativeArray", "(Lcom/facebook/react/bridge/WritableNativeArray;)V",
                          WritableNativeArray::pushArray),
         makeNativeMethod("pushNativeMap", "(Lcom/facebook/react/bridge/WritableNativeMap;)V",
@@ -272,19 +482,19 @@ namespace writable {
 static void putNull(JNIEnv* env, jobject obj, jstring key) {
   auto map = extractRefPtr<NativeMap>(env, obj);
   exceptions::throwIfObjectAlreadyConsumed(map, "Receiving map already consumed");
-  map->map.insert(fromJString(env, key), nullptr);
+  map->map.insert(fromJStringKey(env, key), nullptr);
 }
 
 static void putBoolean(JNIEnv* env, jobject obj, jstring key, jboolean value) {
   auto map = extractRefPtr<NativeMap>(env, obj);
   exceptions::throwIfObjectAlreadyConsumed(map, "Receiving map already consumed");
-  map->map.insert(fromJString(env, key), value == JNI_TRUE);
+  map->map.insert(fromJStringKey(env, key), value == JNI_TRUE);
 }
 
 static void putDouble(JNIEnv* env, jobject obj, jstring key, jdouble value) {
   auto map = extractRefPtr<NativeMap>(env, obj);
   exceptions::throwIfObjectAlreadyConsumed(map, "Receiving map already consumed");
-  map->map.insert(fromJString(env, key), value);
+  map->map.insert(fromJStringKey(env, key), value);
 }
 
 static void putString(JNIEnv* env, jobject obj, jstring key, jstring value) {
@@ -294,7 +504,7 @@ static void putString(JNIEnv* env, jobject obj, jstring key, jstring value) {
   }
   auto map = extractRefPtr<NativeMap>(env, obj);
   exceptions::throwIfObjectAlreadyConsumed(map, "Receiving map already consumed");
-  map->map.insert(fromJString(env, key), fromJString(env, value));
+  map->map.insert(fromJStringKey(env, key), fromJString(env, value));
 }
 
 static void putArray(JNIEnv* env, jobject obj, jstring key, NativeArray::jhybridobject value) {
@@ -306,7 +516,7 @@ static void putArray(JNIEnv* env, jobject obj, jstring key, NativeArray::jhybrid
   exceptions::throwIfObjectAlreadyConsumed(parentMap, "Receiving map already consumed");
   auto arrayValue = cthis(wrap_alias(value));
   exceptions::throwIfObjectAlreadyConsumed(arrayValue, "Array to put already consumed");
-  parentMap->map.insert(fromJString(env, key), std::move(arrayValue->array));
+  parentMap->map.insert(fromJStringKey(env, key), std::move(arrayValue->array));
   arrayValue->isConsumed = true;
 }
 
@@ -319,7 +529,7 @@ static void putMap(JNIEnv* env, jobject obj, jstring key, jobject value) {
   exceptions::throwIfObjectAlreadyConsumed(parentMap, "Receiving map already consumed");
   auto mapValue = extractRefPtr<NativeMap>(env, value);
   exceptions::throwIfObjectAlreadyConsumed(mapValue, "Map to put already consumed");
-  parentMap->map.insert(fromJString(env, key), std::move(mapValue->map));
+  parentMap->map.insert(fromJStringKey(env, key), std::move(mapValue->map));
   mapValue->isConsumed = true;
 }
 
@@ -328,15 +538,38 @@ static void mergeMap(JNIEnv* env, jobject obj, jobject source) {
   exceptions::throwIfObjectAlreadyConsumed(sourceMap, "Source map already consumed");
   auto destMap = extractRefPtr<NativeMap>(env, obj);
   exceptions::throwIfObjectAlreadyConsumed(destMap, "Destination map already consumed");
+  if (sourceMap.get() == destMap.get()) {
+    return;
+  }
 
-  // std::map#insert doesn't overwrite the value, therefore we need to clean values for keys
-  // that already exists before merging dest map into source map
-  for (auto sourceIt : sourceMap->map.items()) {
-    destMap->map.erase(sourceIt.first);
-    destMap->map.insert(std::move(sourceIt.first), std::move(sourceIt.second));
+  // The source stays usable, so each value is copied, but only once and straight into its slot.
+  // insert() wouldn't overwrite the value of a key that is already there.
+  for (const auto& item : sourceMap->map.items()) {
+    destMap->map[item.first] = item.second;
   }
 }
 
+static void putAll(JNIEnv* env, jobject obj, jobject source) {
+  auto sourceMap = extractRefPtr<NativeMap>(env, source);
+  exceptions::throwIfObjectAlreadyConsumed(sourceMap, "Map to put already consumed");
+  auto destMap = extractRefPtr<NativeMap>(env, obj);
+  exceptions::throwIfObjectAlreadyConsumed(destMap, "Receiving map already consumed");
+  if (sourceMap.get() == destMap.get()) {
+    throwNewJavaException("java/lang/IllegalArgumentException", "Can't put a map into itself");
+  }
+
+  // Unlike merging, the source is consumed, so its values are moved over, nested maps and arrays
+  // included, and into an empty map the whole object is
+  if (destMap->map.empty()) {
+    destMap->map = std::move(sourceMap->map);
+  } else {
+    for (auto& item : sourceMap->map.items()) {
+      destMap->map[item.first] = std::move(item.second);
+    }
+  }
+  sourceMap->isConsumed = true;
+}
+
 } // namespace writable
 
 namespace readable {
@@ -346,13 +579,13 @@ static const char *gNoSuchKeyExceptionClass = "com/facebook/react/bridge/NoSuchK
 static jboolean hasKey(JNIEnv* env, jobject obj, jstring keyName) {
   auto nativeMap = extractRefPtr<NativeMap>(env, obj);
   auto& map = nativeMap->map;
-  bool found = map.find(fromJString(env, keyName)) != map.items().end();
+  bool found = map.find(fromJStringKey(env, keyName)) != map.items().end();
   return found ? JNI_TRUE : JNI_FALSE;
 }
 
 static const folly::dynamic& getMapValue(JNIEnv* env, jobject obj, jstring keyName) {
   auto nativeMap = extractRefPtr<NativeMap>(env, obj);
-  std::string key = fromJString(env, keyName);
+  std::string key = fromJStringKey(env, keyName);
   try {
     return nativeMap->map.at(key);
   } catch (const std::out_of_range& ex) {
@@ -390,8 +623,7 @@ static jstring getStringKey(JNIEnv* env, jobject obj, jstring keyName) {
     return nullptr;
   }
   try {
-    LocalString value(val.getString().c_str());
-    return static_cast<jstring>(env->NewLocalRef(value.string()));
+    return make_jstring(val.getString().c_str()).release();
   } catch (const folly::TypeError& ex) {
     throwNewJavaException(exceptions::gUnknownNativeTypeExceptionClass, ex.what());
   }
@@ -409,6 +641,82 @@ static jobject getValueType(JNIEnv* env, jobject obj, jstring keyName) {
   return type::getType(getMapValue(env, obj, keyName).type());
 }
 
+static jobject toHashMap(JNIEnv* env, jobject obj) {
+  auto nativeMap = extractRefPtr<NativeMap>(env, obj);
+  return collections::toJavaMap(env, nativeMap->map, false);
+}
+
+static jobject toReadableBufferMap(JNIEnv* env, jobject obj) {
+  auto nativeMap = extractRefPtr<NativeMap>(env, obj);
+  return collections::toJavaMap(env, nativeMap->map, true);
+}
+
+namespace visitor {
+
+static jmethodID gOnNull;
+static jmethodID gOnBoolean;
+static jmethodID gOnDouble;
+static jmethodID gOnString;
+static jmethodID gOnArray;
+static jmethodID gOnMap;
+
+static void initialize(JNIEnv* env) {
+  auto visitorClass = findClassLocal("com/facebook/react/bridge/ReadableNativeMap$Visitor");
+  jclass clazz = visitorClass.get();
+  gOnNull = env->GetMethodID(clazz, "onNull", "(Ljava/lang/String;)V");
+  gOnBoolean = env->GetMethodID(clazz, "onBoolean", "(Ljava/lang/String;Z)V");
+  gOnDouble = env->GetMethodID(clazz, "onDouble", "(Ljava/lang/String;D)V");
+  gOnString = env->GetMethodID(clazz, "onString", "(Ljava/lang/String;Ljava/lang/String;)V");
+  gOnArray = env->GetMethodID(
+    clazz, "onArray", "(Ljava/lang/String;Lcom/facebook/react/bridge/ReadableNativeArray;)V");
+  gOnMap = env->GetMethodID(
+    clazz, "onMap", "(Ljava/lang/String;Lcom/facebook/react/bridge/ReadableNativeMap;)V");
+}
+
+} // namespace visitor
+
+static void visit(JNIEnv* env, jobject obj, jobject mapVisitor) {
+  // Holding a ref keeps the map alive even if the visitor drops the last Java reference to it
+  auto nativeMap = extractRefPtr<NativeMap>(env, obj);
+  for (const auto& item : nativeMap->map.items()) {
+    jstring key = JStringCache::get().newLocalKey(env, item.first.getString().toStdString());
+    const folly::dynamic& value = item.second;
+    jobject nested = nullptr;
+    switch (value.type()) {
+      case folly::dynamic::Type::NULLT:
+        env->CallVoidMethod(mapVisitor, visitor::gOnNull, key);
+        break;
+      case folly::dynamic::Type::BOOL:
+        env->CallVoidMethod(
+          mapVisitor, visitor::gOnBoolean, key, value.getBool() ? JNI_TRUE : JNI_FALSE);
+        break;
+      case folly::dynamic::Type::INT64:
+        env->CallVoidMethod(mapVisitor, visitor::gOnDouble, key, (jdouble) value.getInt());
+        break;
+      case folly::dynamic::Type::DOUBLE:
+        env->CallVoidMethod(mapVisitor, visitor::gOnDouble, key, value.getDouble());
+        break;
+      case folly::dynamic::Type::STRING:
+        nested = make_jstring(value.getString().c_str()).release();
+        env->CallVoidMethod(mapVisitor, visitor::gOnString, key, nested);
+        break;
+      case folly::dynamic::Type::ARRAY:
+        nested = createReadableNativeArrayWithContents(value).release();
+        env->CallVoidMethod(mapVisitor, visitor::gOnArray, key, nested);
+        break;
+      case folly::dynamic::Type::OBJECT:
+        nested = createReadableNativeMapWithContents(env, value);
+        env->CallVoidMethod(mapVisitor, visitor::gOnMap, key, nested);
+        break;
+      default:
+        throwNewJavaException(exceptions::gUnknownNativeTypeExceptionClass, "Unknown type");
+    }
+    throwPendingJniExceptionAsCppException();
+    env->DeleteLocalRef(nested);
+    env->DeleteLocalRef(key);
+  }
+}
+
 } // namespace readable
 
 namespace iterator {
@@ -432,9 +740,10 @@ static jstring getNextKey(JNIEnv* env, jobject obj) {
     throwNewJavaException("com/facebook/react/bridge/InvalidIteratorException",
                           "No such element exists");
   }
-  LocalString value(nativeIterator->iterator->first.c_str());
+  auto key = JStringCache::get().newLocalKey(
+    env, nativeIterator->iterator->first.getString().toStdString());
   ++nativeIterator->iterator;
-  return static_cast<jstring>(env->NewLocalRef(value.string()));
+  return key;
 }
 
 } // namespace iterator
@@ -445,116 +754,584 @@ namespace runnable {
 static jclass gNativeRunnableClass;
 static jmethodID gNativeRunnableCtor;
 
-static jobject createNativeRunnable(JNIEnv* env, decltype(NativeRunnable::callable)&& callable) {
+static jobject createNativeRunnable(JNIEnv* env, decltype(NativeRunnable::callable)&& callable,
+                                   bool runsOnce = true) {
   jobject jRunnable = env->NewObject(gNativeRunnableClass, gNativeRunnableCtor);
   if (env->ExceptionCheck()) {
     return nullptr;
   }
   auto nativeRunnable = createNew<NativeRunnable>();
   nativeRunnable->callable = std::move(callable);
+  nativeRunnable->runsOnce = runsOnce;
   setCountableForJava(env, jRunnable, std::move(nativeRunnable));
   return jRunnable;
 }
 
 static void run(JNIEnv* env, jobject jNativeRunnable) {
-  auto nativeRunnable = extractRefPtr<NativeRunnable>(env, jNativeRunnable);
-  nativeRunnable->callable();
+  // Borrowed rather than copied, the Java object owns a reference for as long as it is running.
+  // A runnable created with runsOnce gives up its callable when it runs, so what that holds,
+  // like the calls of a batch and the RefPtrs to the bridge callback, is released here rather
+  // than later on the finalizer thread. A reusable runnable, like the one draining a
+  // PendingBatchQueue, keeps its callable, and whatever it holds, until the Java object is
+  // disposed, so its callable should only hold what is cheap to keep, like a weak pointer.
+  auto nativeRunnable = static_cast<NativeRunnable*>(countableFromJava(env, jNativeRunnable).get());
+  if (!nativeRunnable->runsOnce) {
+    nativeRunnable->callable();
+    return;
+  }
+  auto callable = std::move(nativeRunnable->callable);
+  callable();
 }
 
 } // namespace runnable
 
 namespace queue {
 
-static jmethodID gRunOnQueueThreadMethod;
+struct JMessageQueueThread : public JavaClass<JMessageQueueThread> {
+  constexpr static auto kJavaDescriptor = "Lcom/facebook/react/bridge/queue/MessageQueueThread;";
+
+  static JMemberId<JMessageQueueThread, JMethod<void(jobject)>> runOnQueue;
+};
+
+JMemberId<JMessageQueueThread, JMethod<void(jobject)>> JMessageQueueThread::runOnQueue{
+  "runOnQueue", "(Ljava/lang/Runnable;)V"
+};
 
 static void enqueueNativeRunnableOnQueue(JNIEnv* env, jobject callbackQueueThread, jobject nativeRunnable) {
-  env->CallVoidMethod(callbackQueueThread, gRunOnQueueThreadMethod, nativeRunnable);
+  env->CallVoidMethod(
+    callbackQueueThread, JMessageQueueThread::runOnQueue.get().getId(), nativeRunnable);
 }
 
 } // namespace queue
 
 namespace bridge {
 
-static jmethodID gCallbackMethod;
-static jmethodID gOnBatchCompleteMethod;
+struct JReactCallback : public JavaClass<JReactCallback> {
+  constexpr static auto kJavaDescriptor = "Lcom/facebook/react/bridge/ReactCallback;";
+
+  static JMemberId<JReactCallback, JMethod<void(jobject)>> callBatch;
+  static JMemberId<JReactCallback, JMethod<void(jobject)>> callLowPriorityBatch;
+  static JMemberId<JReactCallback, JMethod<void(jint)>> onBatchComplete;
+  static JMemberId<JReactCallback, JMethod<jobject(jint, jint, jobject)>> callSync;
+  static JMemberId<JReactCallback, JMethod<jobject()>> getModuleNames;
+  static JMemberId<JReactCallback, JMethod<jobject(jobject)>> getModuleConfig;
+};
+
+JMemberId<JReactCallback, JMethod<void(jobject)>> JReactCallback::callBatch{
+  "callBatch", "(Ljava/nio/ByteBuffer;)V"
+};
+JMemberId<JReactCallback, JMethod<void(jobject)>> JReactCallback::callLowPriorityBatch{
+  "callLowPriorityBatch", "(Ljava/nio/ByteBuffer;)V"
+};
+JMemberId<JReactCallback, JMethod<void(jint)>> JReactCallback::onBatchComplete{
+  "onBatchComplete", "(I)V"
+};
+JMemberId<JReactCallback, JMethod<jobject(jint, jint, jobject)>> JReactCallback::callSync{
+  "callSync",
+  "(IILcom/facebook/react/bridge/ReadableNativeArray;)Lcom/facebook/react/bridge/NativeArray;"
+};
+JMemberId<JReactCallback, JMethod<jobject()>> JReactCallback::getModuleNames{
+  "getModuleNames", "()[Ljava/lang/String;"
+};
+JMemberId<JReactCallback, JMethod<jobject(jobject)>> JReactCallback::getModuleConfig{
+  "getModuleConfig", "(Ljava/lang/String;)Ljava/lang/String;"
+};
 
-static void makeJavaCall(JNIEnv* env, jobject callback, MethodCall&& call) {
-  if (call.arguments.isNull()) {
+static void makeJavaCalls(JNIEnv* env, jobject callback, jmethodID batchMethod,
+                          std::vector<uint8_t>& buffer) {
+  // One JNI transition for the whole batch. Java decodes the buffer before callBatch returns, so
+  // it only has to outlive this call.
+  jobject jBuffer = env->NewDirectByteBuffer(buffer.data(), buffer.size());
+  if (jBuffer == nullptr) {
     return;
   }
-  auto newArray = createReadableNativeArrayWithContents(std::move(call.arguments));
-  env->CallVoidMethod(callback, gCallbackMethod, call.moduleId, call.methodId, newArray.get());
+  env->CallVoidMethod(callback, batchMethod, jBuffer);
+  env->DeleteLocalRef(jBuffer);
 }
 
-static void signalBatchComplete(JNIEnv* env, jobject callback) {
-  env->CallVoidMethod(callback, gOnBatchCompleteMethod);
+static void signalBatchComplete(JNIEnv* env, jobject callback, jint completedJSCalls) {
+  env->CallVoidMethod(callback, JReactCallback::onBatchComplete.get().getId(), completedJSCalls);
 }
 
-static void dispatchCallbacksToJava(const RefPtr<WeakReference>& weakCallback,
-                                    const RefPtr<WeakReference>& weakCallbackQueueThread,
-                                    std::vector<MethodCall>&& calls) {
-  auto env = Environment::current();
-  if (env->ExceptionCheck()) {
-    FBLOGW("Dropped calls because of pending exception");
-    return;
+// Modules whose calls go to a queue thread of their own, so bulk work like storage writes
+// doesn't hold up UIManager calls from the same batch. A module's calls all stay in one lane,
+// which keeps them in order.
+struct LowPriorityLane {
+  RefPtr<WeakReference> queueThread;
+  std::vector<bool> moduleIds;
+
+  bool contains(int moduleId) const {
+    return moduleId >= 0 && static_cast<size_t>(moduleId) < moduleIds.size() &&
+      moduleIds[moduleId];
   }
+};
 
-  ResolvedWeakReference callbackQueueThread(weakCallbackQueueThread);
-  if (!callbackQueueThread) {
-    FBLOGW("Dropped calls because of callback queue thread went away");
-    return;
+// Pins weak references until ReactBridge is disposed. It keeps its callback and queue threads
+// alive until then anyway, so pinning them doesn't change when they can be collected, and each
+// dispatch resolves them from a global ref instead. The bridge's callbacks hold on to this, and
+// work still queued when the bridge is disposed can keep them for a while, so the pins are
+// released explicitly on dispose rather than with the last callback. Dispatches after that
+// resolve the weak refs, which may be null by then.
+class PinnedWeakReferences : public noncopyable {
+public:
+  void pin(const RefPtr<WeakReference>& ref) {
+    ref->pin();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_refs.push_back(ref);
   }
 
-  auto runnableFunction = std::bind([weakCallback] (std::vector<MethodCall>& calls) {
-    auto env = Environment::current();
+  // Only unpins once, however often it is called
+  void unpinAll() {
+    std::vector<RefPtr<WeakReference>> refs;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      refs.swap(m_refs);
+    }
+    for (const auto& ref : refs) {
+      ref->unpin();
+    }
+  }
+
+  ~PinnedWeakReferences() {
+    unpinAll();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<RefPtr<WeakReference>> m_refs;
+};
+
+// The pins of each bridge that hasn't been disposed yet
+static std::mutex gPinnedReferencesMutex;
+static std::unordered_map<const Bridge*, std::shared_ptr<PinnedWeakReferences>> gPinnedReferences;
+
+// The batches JS flushed for one lane that its queue thread hasn't run yet. A single long-lived
+// runnable drains them, and is only posted when the queue goes from empty to non-empty, so when
+// JS flushes faster than Java keeps up, batches pile up here rather than as one runnable each.
+// Only the JS thread adds batches and only the queue thread takes them, and neither holds the
+// lock for longer than a move.
+class PendingBatchQueue : public noncopyable {
+public:
+  static std::shared_ptr<PendingBatchQueue> create(JNIEnv* env,
+                                                   const RefPtr<WeakReference>& weakCallback,
+                                                   const RefPtr<WeakReference>& weakQueueThread,
+                                                   jmethodID batchMethod,
+                                                   bool isMainLane) {
+    std::shared_ptr<PendingBatchQueue> queue(
+      new PendingBatchQueue(weakCallback, weakQueueThread, batchMethod, isMainLane));
+    // Only a weak pointer, since the queue holds a global ref to the runnable
+    std::weak_ptr<PendingBatchQueue> weakQueue = queue;
+    jobject jRunnable = runnable::createNativeRunnable(env, [weakQueue] {
+      if (auto queue = weakQueue.lock()) {
+        queue->drain(Environment::current());
+      }
+    }, false);
+    throwPendingJniExceptionAsCppException();
+    queue->m_runnable = env->NewGlobalRef(jRunnable);
+    env->DeleteLocalRef(jRunnable);
+    return queue;
+  }
+
+  ~PendingBatchQueue() {
+    Environment::current()->DeleteGlobalRef(m_runnable);
+  }
+
+  // completedJSCalls is only passed on by the main lane, see runBatch()
+  void enqueue(JNIEnv* env, std::vector<MethodCall>&& calls, size_t completedJSCalls) {
+    // The calls are flattened right away, on the thread that parsed them, so their folly::dynamic
+    // trees are freed before this returns instead of waiting on the queue thread. The queue only
+    // holds on to the one buffer.
+    PendingBatch batch;
+    batch.hasCalls = !calls.empty();
+    batch.completedJSCalls = static_cast<jint>(completedJSCalls);
+    if (batch.hasCalls) {
+      batch.buffer = writeMethodCallBuffer(calls);
+      std::vector<MethodCall>().swap(calls);
+    }
+    bool shouldPost;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_batches.push_back(std::move(batch));
+      shouldPost = !m_isScheduled;
+      m_isScheduled = true;
+    }
+    if (shouldPost) {
+      post(env);
+    }
+  }
+
+private:
+  struct PendingBatch {
+    std::vector<uint8_t> buffer;
+    bool hasCalls = false;
+    jint completedJSCalls = 0;
+  };
+
+  PendingBatchQueue(const RefPtr<WeakReference>& weakCallback,
+                    const RefPtr<WeakReference>& weakQueueThread,
+                    jmethodID batchMethod,
+                    bool isMainLane)
+    : m_weakCallback(weakCallback)
+    , m_weakQueueThread(weakQueueThread)
+    , m_batchMethod(batchMethod)
+    , m_isMainLane(isMainLane)
+    , m_runnable(nullptr)
+    , m_isScheduled(false) {}
+
+  void post(JNIEnv* env) {
+    ResolvedWeakReference queueThread(m_weakQueueThread);
+    if (!queueThread) {
+      FBLOGW("Dropped calls because of queue thread went away");
+      dropBatches();
+      return;
+    }
+    queue::enqueueNativeRunnableOnQueue(env, queueThread, m_runnable);
+  }
+
+  void dropBatches() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_batches.clear();
+    m_isScheduled = false;
+  }
+
+  // Returns false once a Java exception is pending
+  bool runBatch(JNIEnv* env, PendingBatch& batch) {
+    ResolvedWeakReference callback(m_weakCallback);
+    if (!callback) {
+      return true;
+    }
+    if (batch.hasCalls) {
+      makeJavaCalls(env, callback, m_batchMethod, batch.buffer);
+      if (env->ExceptionCheck()) {
+        return false;
+      }
+    }
+    // Batch complete listeners like UIManager live on the main lane, and so does the count of
+    // pending JS calls, so each batch completes its JS calls there and only there
+    if (m_isMainLane) {
+      signalBatchComplete(env, callback, batch.completedJSCalls);
+    }
+    return !env->ExceptionCheck();
+  }
+
+  void drain(JNIEnv* env) {
     if (env->ExceptionCheck()) {
       FBLOGW("Dropped calls because of pending exception");
+      dropBatches();
       return;
     }
-    ResolvedWeakReference callback(weakCallback);
-    if (callback) {
-      for (auto&& call : calls) {
-        makeJavaCall(env, callback, std::move(call));
-        if (env->ExceptionCheck()) {
+    while (true) {
+      PendingBatch batch;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_batches.empty()) {
+          m_isScheduled = false;
           return;
         }
+        batch = std::move(m_batches.front());
+        m_batches.pop_front();
+      }
+      if (!runBatch(env, batch)) {
+        rescheduleAfterException(env);
+        return;
       }
-      signalBatchComplete(env, callback);
     }
-  }, std::move(calls));
+  }
 
-  jobject jNativeRunnable = runnable::createNativeRunnable(env, std::move(runnableFunction));
-  queue::enqueueNativeRunnableOnQueue(env, callbackQueueThread, jNativeRunnable);
+  // The exception still goes to the queue thread's handler, like it did when each batch had a
+  // runnable of its own, and the batches after the one that threw run in a later turn.
+  void rescheduleAfterException(JNIEnv* env) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_batches.empty()) {
+        m_isScheduled = false;
+        return;
+      }
+    }
+    jthrowable exception = env->ExceptionOccurred();
+    env->ExceptionClear();
+    post(env);
+    env->ExceptionClear();
+    env->Throw(exception);
+    env->DeleteLocalRef(exception);
+  }
+
+  RefPtr<WeakReference> m_weakCallback;
+  RefPtr<WeakReference> m_weakQueueThread;
+  jmethodID m_batchMethod;
+  bool m_isMainLane;
+  jobject m_runnable;
+
+  std::mutex m_mutex;
+  std::deque<PendingBatch> m_batches;
+  bool m_isScheduled;
+};
+
+// The queue thread ref of each of the two lanes, when their runnable has to be posted
+const jint kLocalRefsPerDispatch = 2;
+
+static void dispatchCallbacksToJava(const std::shared_ptr<PendingBatchQueue>& mainBatches,
+                                    const std::shared_ptr<PendingBatchQueue>& lowPriorityBatches,
+                                    const std::shared_ptr<const LowPriorityLane>& lowPriorityLane,
+                                    std::vector<MethodCall>&& calls,
+                                    size_t completedJSCalls) {
+  auto env = Environment::current();
+  if (env->ExceptionCheck()) {
+    FBLOGW("Dropped calls because of pending exception");
+    return;
+  }
+
+  // JS can flush many batches from a single call into native code, like loading the application
+  // script, so the local refs made for each batch are freed together here rather than left for
+  // that call to return. Declared first so the refs below are deleted before the frame is popped.
+  JniLocalScope scope(env, kLocalRefsPerDispatch);
+
+  if (lowPriorityLane) {
+    std::vector<MethodCall> lowPriorityCalls;
+    auto isMainLaneCall = [&lowPriorityLane] (const MethodCall& call) {
+      return !lowPriorityLane->contains(call.moduleId);
+    };
+    auto firstLowPriorityCall =
+      std::stable_partition(calls.begin(), calls.end(), isMainLaneCall);
+    if (firstLowPriorityCall != calls.end()) {
+      lowPriorityCalls.assign(
+        std::make_move_iterator(firstLowPriorityCall), std::make_move_iterator(calls.end()));
+      calls.erase(firstLowPriorityCall, calls.end());
+      lowPriorityBatches->enqueue(env, std::move(lowPriorityCalls), 0);
+    }
+  }
+
+  // Enqueued even without calls, to complete the JS calls they came back from
+  mainBatches->enqueue(env, std::move(calls), completedJSCalls);
+}
+
+// The queue thread and the runnable
+const jint kLocalRefsPerRethrow = 2;
+
+// What the native JS thread throws is rethrown on the native modules queue thread, whose
+// exception handler is the one the JS queue thread uses too, so the instance is torn down and
+// the redbox shows like for an exception in a call from Java.
+static void rethrowOnQueueThread(const RefPtr<WeakReference>& weakQueueThread,
+                                 std::exception_ptr exception) {
+  auto env = Environment::current();
+  JniLocalScope scope(env, kLocalRefsPerRethrow);
+  ResolvedWeakReference queueThread(weakQueueThread);
+  if (!queueThread) {
+    FBLOGW("Dropped exception from the JS thread because of queue thread went away");
+    return;
+  }
+  jobject jRunnable = runnable::createNativeRunnable(env, [exception] {
+    try {
+      std::rethrow_exception(exception);
+    } catch (...) {
+      translatePendingCppExceptionToJavaException();
+    }
+  });
+  if (jRunnable == nullptr) {
+    return;
+  }
+  queue::enqueueNativeRunnableOnQueue(env, queueThread, jRunnable);
+}
+
+// The callback, the arguments and the returned array
+const jint kLocalRefsPerSyncCall = 3;
+
+// Unlike batches, sync calls go straight into Java on the JS thread, since JS waits for them.
+// A Java exception is rethrown as a C++ exception, which the executor raises in JS.
+static folly::dynamic callSyncMethodInJava(const RefPtr<WeakReference>& weakCallback,
+                                           int moduleId, int methodId,
+                                           folly::dynamic&& arguments) {
+  auto env = Environment::current();
+  JniLocalScope scope(env, kLocalRefsPerSyncCall);
+  ResolvedWeakReference callback(weakCallback);
+  if (!callback) {
+    return nullptr;
+  }
+  auto jArguments = createReadableNativeArrayWithContents(std::move(arguments));
+  jobject jResult = env->CallObjectMethod(
+    callback, JReactCallback::callSync.get().getId(), moduleId, methodId, jArguments.get());
+  throwPendingJniExceptionAsCppException();
+  if (jResult == nullptr) {
+    return nullptr;
+  }
+  auto result = cthis(wrap_alias(static_cast<NativeArray::jhybridobject>(jResult)));
+  if (result->array.empty()) {
+    return nullptr;
+  }
+  return std::move(result->array[0]);
+}
+
+// The callback, the array and one module name at a time
+const jint kLocalRefsPerModuleNames = 3;
+
+// Like sync calls, the nativeModuleProxy asks Java on the JS thread, while JS waits
+static std::vector<std::string> getModuleNamesFromJava(const RefPtr<WeakReference>& weakCallback) {
+  auto env = Environment::current();
+  JniLocalScope scope(env, kLocalRefsPerModuleNames);
+  ResolvedWeakReference callback(weakCallback);
+  std::vector<std::string> moduleNames;
+  if (!callback) {
+    return moduleNames;
+  }
+  auto jModuleNames = static_cast<jobjectArray>(
+    env->CallObjectMethod(callback, JReactCallback::getModuleNames.get().getId()));
+  throwPendingJniExceptionAsCppException();
+  if (jModuleNames == nullptr) {
+    return moduleNames;
+  }
+  jsize count = env->GetArrayLength(jModuleNames);
+  moduleNames.reserve(count);
+  for (jsize i = 0; i < count; i++) {
+    auto jModuleName = static_cast<jstring>(env->GetObjectArrayElement(jModuleNames, i));
+    moduleNames.push_back(fromJString(env, jModuleName));
+    env->DeleteLocalRef(jModuleName);
+  }
+  return moduleNames;
+}
+
+// The callback, the module name and the returned config
+const jint kLocalRefsPerModuleConfig = 3;
+
+static std::string getModuleConfigFromJava(const RefPtr<WeakReference>& weakCallback,
+                                           const std::string& moduleName) {
+  auto env = Environment::current();
+  JniLocalScope scope(env, kLocalRefsPerModuleConfig);
+  ResolvedWeakReference callback(weakCallback);
+  if (!callback) {
+    return std::string();
+  }
+  auto jModuleName = make_jstring(moduleName);
+  auto jConfig = static_cast<jstring>(env->CallObjectMethod(
+    callback, JReactCallback::getModuleConfig.get().getId(), jModuleName.get()));
+  throwPendingJniExceptionAsCppException();
+  if (jConfig == nullptr) {
+    return std::string();
+  }
+  return fromJString(env, jConfig);
 }
 
 static void create(JNIEnv* env, jobject obj, jobject executor, jobject callback,
-                   jobject callbackQueueThread) {
+                   jobject callbackQueueThread, jobject lowPriorityQueueThread,
+                   jintArray lowPriorityModuleIds) {
   auto weakCallback = createNew<WeakReference>(callback);
   auto weakCallbackQueueThread = createNew<WeakReference>(callbackQueueThread);
-  auto bridgeCallback = [weakCallback, weakCallbackQueueThread] (std::vector<MethodCall> calls) {
-    dispatchCallbacksToJava(weakCallback, weakCallbackQueueThread, std::move(calls));
+  std::shared_ptr<LowPriorityLane> lowPriorityLane;
+  jsize lowPriorityModuleCount =
+    lowPriorityModuleIds ? env->GetArrayLength(lowPriorityModuleIds) : 0;
+  if (lowPriorityQueueThread && lowPriorityModuleCount > 0) {
+    lowPriorityLane = std::make_shared<LowPriorityLane>();
+    lowPriorityLane->queueThread = createNew<WeakReference>(lowPriorityQueueThread);
+    std::vector<jint> moduleIds(lowPriorityModuleCount);
+    env->GetIntArrayRegion(lowPriorityModuleIds, 0, lowPriorityModuleCount, moduleIds.data());
+    for (jint moduleId : moduleIds) {
+      if (moduleId < 0) {
+        throwNewJavaException("java/lang/IllegalArgumentException",
+                              "Invalid module id %d", moduleId);
+      }
+      if (static_cast<size_t>(moduleId) >= lowPriorityLane->moduleIds.size()) {
+        lowPriorityLane->moduleIds.resize(moduleId + 1);
+      }
+      lowPriorityLane->moduleIds[moduleId] = true;
+    }
+  }
+  std::shared_ptr<const LowPriorityLane> lane = std::move(lowPriorityLane);
+  auto pinned = std::make_shared<PinnedWeakReferences>();
+  pinned->pin(weakCallback);
+  pinned->pin(weakCallbackQueueThread);
+  if (lane) {
+    pinned->pin(lane->queueThread);
+  }
+  auto mainBatches = PendingBatchQueue::create(
+    env, weakCallback, weakCallbackQueueThread, JReactCallback::callBatch.get().getId(), true);
+  std::shared_ptr<PendingBatchQueue> lowPriorityBatches;
+  if (lane) {
+    lowPriorityBatches = PendingBatchQueue::create(
+      env, weakCallback, lane->queueThread,
+      JReactCallback::callLowPriorityBatch.get().getId(), false);
+  }
+  // Released with the last copy of the callback, some time after the bridge goes away
+  auto bridgeCallback = [mainBatches, lowPriorityBatches, lane, pinned] (
+      std::vector<MethodCall> calls, size_t completedJSCalls) {
+    dispatchCallbacksToJava(
+      mainBatches, lowPriorityBatches, lane, std::move(calls), completedJSCalls);
+  };
+  auto syncCallback = [weakCallback, pinned] (
+      int moduleId, int methodId, folly::dynamic&& arguments) {
+    return callSyncMethodInJava(weakCallback, moduleId, methodId, std::move(arguments));
+  };
+  auto moduleNamesCallback = [weakCallback, pinned] () {
+    return getModuleNamesFromJava(weakCallback);
+  };
+  auto moduleConfigCallback = [weakCallback, pinned] (const std::string& moduleName) {
+    return getModuleConfigFromJava(weakCallback, moduleName);
+  };
+  auto exceptionCallback = [weakCallbackQueueThread, pinned] (std::exception_ptr exception) {
+    rethrowOnQueueThread(weakCallbackQueueThread, exception);
   };
   auto nativeExecutorFactory = extractRefPtr<JSExecutorFactory>(env, executor);
-  auto bridge = createNew<Bridge>(nativeExecutorFactory, bridgeCallback);
+  auto bridge = createNew<Bridge>(
+    nativeExecutorFactory, bridgeCallback, syncCallback, moduleNamesCallback,
+    moduleConfigCallback, exceptionCallback);
+  {
+    std::lock_guard<std::mutex> lock(gPinnedReferencesMutex);
+    gPinnedReferences[bridge.get()] = pinned;
+  }
   setCountableForJava(env, obj, std::move(bridge));
 }
 
+// Called by ReactBridge.dispose, before the native bridge is released
+static void unpinReferences(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  std::shared_ptr<PinnedWeakReferences> pinned;
+  {
+    std::lock_guard<std::mutex> lock(gPinnedReferencesMutex);
+    auto it = gPinnedReferences.find(bridge.get());
+    if (it == gPinnedReferences.end()) {
+      return;
+    }
+    pinned = std::move(it->second);
+    gPinnedReferences.erase(it);
+  }
+  pinned->unpinAll();
+}
+
+static void prefetchScriptFromAssets(JNIEnv* env, jclass clazz, jobject assetManager,
+                                     jstring assetName) {
+  react::prefetchScriptFromAssets(env, assetManager, fromJString(env, assetName));
+}
+
 static void loadScriptFromAssets(JNIEnv* env, jobject obj, jobject assetManager,
                                  jstring assetName) {
   auto bridge = extractRefPtr<Bridge>(env, obj);
   auto assetNameStr = fromJString(env, assetName);
   auto script = react::loadScriptFromAssets(env, assetManager, assetNameStr);
-  bridge->executeApplicationScript(script, assetNameStr);
+  bridge->executeApplicationScript(std::move(script), std::move(assetNameStr));
 }
 
 static void loadScriptFromNetworkCached(JNIEnv* env, jobject obj, jstring sourceURL,
                                    jstring tempFileName) {
   auto bridge = jni::extractRefPtr<Bridge>(env, obj);
-  std::string script = "";
+  std::unique_ptr<const JSBigString> script;
   if (tempFileName != NULL) {
     script = react::loadScriptFromFile(jni::fromJString(env, tempFileName));
+  } else {
+    script.reset(new JSBigStdString(""));
+  }
+  bridge->executeApplicationScript(std::move(script), jni::fromJString(env, sourceURL));
+}
+
+// The base and output may be the same file, the output is only replaced once it is verified
+static void applyScriptDelta(JNIEnv* env, jclass clazz, jstring baseFileName,
+                             jstring deltaFileName, jstring outputFileName) {
+  try {
+    react::applyJSDeltaFile(
+      fromJString(env, baseFileName),
+      fromJString(env, deltaFileName),
+      fromJString(env, outputFileName));
+  } catch (const std::exception& e) {
+    FBLOGE("Unable to apply bundle delta: %s", e.what());
+    env->ThrowNew(env->FindClass("java/io/IOException"), e.what());
   }
-  bridge->executeApplicationScript(script, jni::fromJString(env, sourceURL));
 }
 
 static void callFunction(JNIEnv* env, jobject obj, jint moduleId, jint methodId,
@@ -598,6 +1375,12 @@ static jboolean supportsProfiling(JNIEnv* env, jobject obj) {
   return bridge->supportsProfiling() ? JNI_TRUE : JNI_FALSE;
 }
 
+static jstring getStats(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  LocalString stats(folly::toJson(bridge->getStats()).toStdString());
+  return static_cast<jstring>(env->NewLocalRef(stats.string()));
+}
+
 static void startProfiler(JNIEnv* env, jobject obj, jstring title) {
   auto bridge = extractRefPtr<Bridge>(env, obj);
   bridge->startProfiler(fromJString(env, title));
@@ -608,15 +1391,80 @@ static void stopProfiler(JNIEnv* env, jobject obj, jstring title, jstring filena
   bridge->stopProfiler(fromJString(env, title), fromJString(env, filename));
 }
 
+static jboolean supportsSamplingProfiler(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  return bridge->supportsSamplingProfiler() ? JNI_TRUE : JNI_FALSE;
+}
+
+static void startSamplingProfiler(JNIEnv* env, jobject obj, jint intervalUs, jint maxSamples) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->startSamplingProfiler(intervalUs, maxSamples);
+}
+
+static void stopSamplingProfiler(JNIEnv* env, jobject obj, jstring filename) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->stopSamplingProfiler(fromJString(env, filename));
+}
+
+static void collectGarbage(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->collectGarbage();
+}
+
+static void handleIdle(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->handleIdle();
+}
+
+static void startRecording(JNIEnv* env, jobject obj, jstring filename) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->startRecording(fromJString(env, filename));
+}
+
+static void stopRecording(JNIEnv* env, jobject obj) {
+  auto bridge = extractRefPtr<Bridge>(env, obj);
+  bridge->stopRecording();
+}
+
 } // namespace bridge
 
 namespace executors {
 
-static void createJSCExecutor(JNIEnv *env, jobject obj) {
-  auto executor = createNew<JSCExecutorFactory>();
+static void createJSCExecutor(
+    JNIEnv *env,
+    jobject obj,
+    jint idleCollectionIntervalMs,
+    jlong idleCollectionMinHeapSize,
+    jlong idleCollectionHeapGrowth,
+    jboolean useNativeJSThread,
+    jboolean shareContextGroup) {
+  JSCExecutorOptions options;
+  options.idleCollectionInterval = std::chrono::milliseconds(idleCollectionIntervalMs);
+  options.idleCollectionMinHeapSize = idleCollectionMinHeapSize;
+  options.idleCollectionHeapGrowth = idleCollectionHeapGrowth;
+  options.useNativeJSThread = useNativeJSThread == JNI_TRUE;
+  options.shareContextGroup = shareContextGroup == JNI_TRUE;
+  auto executor = createNew<JSCExecutorFactory>(options);
   setCountableForJava(env, obj, std::move(executor));
 }
 
+static void prepareWarmJSCContext(JNIEnv* env, jclass clazz) {
+  JSCExecutorFactory::prepareWarmContext();
+}
+
+static jboolean startBufferedTracing(
+    JNIEnv* env, jclass clazz, jlong tags, jint eventsPerThread) {
+  if (eventsPerThread <= 0) {
+    throwNewJavaException(
+      "java/lang/IllegalArgumentException", "eventsPerThread must be positive");
+  }
+  return TraceBuffer::start(tags, eventsPerThread) ? JNI_TRUE : JNI_FALSE;
+}
+
+static jboolean stopBufferedTracing(JNIEnv* env, jclass clazz, jstring filename) {
+  return TraceBuffer::stopAndWrite(fromJString(env, filename)) ? JNI_TRUE : JNI_FALSE;
+}
+
 static void createProxyExecutor(JNIEnv *env, jobject obj, jobject executorInstance) {
   auto executor =
     createNew<ProxyExecutorOneTimeFactory>(jni::make_global(jni::adopt_local(executorInstance)));
@@ -625,106 +1473,223 @@ static void createProxyExecutor(JNIEnv *env, jobject obj, jobject executorInstan
 
 } // namespace executors
 
-extern "C" JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved) {
-  return initialize(vm, [] {
-    // get the current env
-    JNIEnv* env = Environment::current();
+namespace affinity {
 
-    auto readableTypeClass = findClassLocal("com/facebook/react/bridge/ReadableType");
-    type::gReadableReactType = (jclass)env->NewGlobalRef(readableTypeClass.get());
-    type::initialize(env);
+static jboolean setThreadPrefersFastCores(
+    JNIEnv* env, jclass clazz, jint tid, jboolean prefersFastCores) {
+  return react::setThreadPrefersFastCores(tid, prefersFastCores) ? JNI_TRUE : JNI_FALSE;
+}
 
-    NativeArray::registerNatives();
-    ReadableNativeArray::registerNatives();
-    WritableNativeArray::registerNatives();
+} // namespace affinity
 
-    registerNatives("com/facebook/react/bridge/NativeMap", {
-        makeNativeMethod("initialize", map::initialize),
-        makeNativeMethod("toString", map::toString),
-    });
+// Enough for any app logging with intent, while a stray console.log in a render loop can't
+// flood logcat
+const unsigned int kMaxLogMessagesPerTagPerSecond = 500;
 
-    jclass readableMapClass = env->FindClass("com/facebook/react/bridge/ReadableNativeMap");
-    gReadableNativeMapClass = (jclass)env->NewGlobalRef(readableMapClass);
-    gReadableNativeMapCtor = env->GetMethodID(readableMapClass, "<init>", "()V");
-    wrap_alias(readableMapClass)->registerNatives({
-        makeNativeMethod("hasKey", map::readable::hasKey),
-        makeNativeMethod("isNull", map::readable::isNull),
-        makeNativeMethod("getBoolean", map::readable::getBooleanKey),
-        makeNativeMethod("getDouble", map::readable::getDoubleKey),
-        makeNativeMethod("getString", map::readable::getStringKey),
-        makeNativeMethod(
-          "getArray", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableNativeArray;",
-          map::readable::getArrayKey),
-        makeNativeMethod(
-          "getMap", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableNativeMap;",
-          map::readable::getMapKey),
-        makeNativeMethod(
-          "getType", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableType;",
-          map::readable::getValueType),
-    });
+namespace registration {
 
-    registerNatives("com/facebook/react/bridge/WritableNativeMap", {
-        makeNativeMethod("putNull", map::writable::putNull),
-        makeNativeMethod("putBoolean", map::writable::putBoolean),
-        makeNativeMethod("putDouble", map::writable::putDouble),
-        makeNativeMethod("putString", map::writable::putString),
-        makeNativeMethod(
-          "putNativeArray", "(Ljava/lang/String;Lcom/facebook/react/bridge/WritableNativeArray;)V",
-          map::writable::putArray),
-        makeNativeMethod(
-          "putNativeMap", "(Ljava/lang/String;Lcom/facebook/react/bridge/WritableNativeMap;)V",
-          map::writable::putMap),
-        makeNativeMethod(
-          "mergeNativeMap", "(Lcom/facebook/react/bridge/ReadableNativeMap;)V",
-          map::writable::mergeMap)
-    });
+// Native maps and arrays, and the Java types they convert to and from
+static void registerCollections() {
+  JNIEnv* env = Environment::current();
 
-    registerNatives("com/facebook/react/bridge/ReadableNativeMap$ReadableNativeMapKeySeyIterator", {
-      makeNativeMethod("initialize", "(Lcom/facebook/react/bridge/ReadableNativeMap;)V",
-                       map::iterator::initialize),
-      makeNativeMethod("hasNextKey", map::iterator::hasNextKey),
-      makeNativeMethod("nextKey", map::iterator::getNextKey),
-    });
+  auto readableTypeClass = findClassLocal("com/facebook/react/bridge/ReadableType");
+  type::gReadableReactType = (jclass)env->NewGlobalRef(readableTypeClass.get());
+  type::initialize(env);
+  collections::initialize(env);
+  map::readable::visitor::initialize(env);
 
-    registerNatives("com/facebook/react/bridge/JSCJavaScriptExecutor", {
-      makeNativeMethod("initialize", executors::createJSCExecutor),
-    });
+  NativeArray::registerNatives();
+  ReadableNativeArray::registerNatives();
+  WritableNativeArray::registerNatives();
 
-    registerNatives("com/facebook/react/bridge/ProxyJavaScriptExecutor", {
-        makeNativeMethod(
-          "initialize", "(Lcom/facebook/react/bridge/ProxyJavaScriptExecutor$JavaJSExecutor;)V",
-          executors::createProxyExecutor),
-    });
+  registerNatives("com/facebook/react/bridge/NativeMap", {
+      makeNativeMethod("initialize", map::initialize),
+      makeNativeMethod("toString", map::toString),
+  });
 
-    jclass callbackClass = env->FindClass("com/facebook/react/bridge/ReactCallback");
-    bridge::gCallbackMethod = env->GetMethodID(callbackClass, "call", "(IILcom/facebook/react/bridge/ReadableNativeArray;)V");
-    bridge::gOnBatchCompleteMethod = env->GetMethodID(callbackClass, "onBatchComplete", "()V");
-
-    registerNatives("com/facebook/react/bridge/ReactBridge", {
-        makeNativeMethod("initialize", "(Lcom/facebook/react/bridge/JavaScriptExecutor;Lcom/facebook/react/bridge/ReactCallback;Lcom/facebook/react/bridge/queue/MessageQueueThread;)V", bridge::create),
-        makeNativeMethod(
-          "loadScriptFromAssets", "(Landroid/content/res/AssetManager;Ljava/lang/String;)V",
-          bridge::loadScriptFromAssets),
-        makeNativeMethod("loadScriptFromNetworkCached", bridge::loadScriptFromNetworkCached),
-        makeNativeMethod("callFunction", bridge::callFunction),
-        makeNativeMethod("invokeCallback", bridge::invokeCallback),
-        makeNativeMethod("setGlobalVariable", bridge::setGlobalVariable),
-        makeNativeMethod("supportsProfiling", bridge::supportsProfiling),
-        makeNativeMethod("startProfiler", bridge::startProfiler),
-        makeNativeMethod("stopProfiler", bridge::stopProfiler),
-    });
+  jclass readableMapClass = env->FindClass("com/facebook/react/bridge/ReadableNativeMap");
+  gReadableNativeMapClass = (jclass)env->NewGlobalRef(readableMapClass);
+  wrap_alias(readableMapClass)->registerNatives({
+      makeNativeMethod("hasKey", map::readable::hasKey),
+      makeNativeMethod("isNull", map::readable::isNull),
+      makeNativeMethod("getBoolean", map::readable::getBooleanKey),
+      makeNativeMethod("getDouble", map::readable::getDoubleKey),
+      makeNativeMethod("getString", map::readable::getStringKey),
+      makeNativeMethod(
+        "getArray", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableNativeArray;",
+        map::readable::getArrayKey),
+      makeNativeMethod(
+        "getMap", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableNativeMap;",
+        map::readable::getMapKey),
+      makeNativeMethod(
+        "getType", "(Ljava/lang/String;)Lcom/facebook/react/bridge/ReadableType;",
+        map::readable::getValueType),
+      makeNativeMethod("toHashMap", "()Ljava/util/HashMap;", map::readable::toHashMap),
+      makeNativeMethod(
+        "toReadableBufferMap", "()Lcom/facebook/react/bridge/ReadableBufferMap;",
+        map::readable::toReadableBufferMap),
+      makeNativeMethod(
+        "visit", "(Lcom/facebook/react/bridge/ReadableNativeMap$Visitor;)V",
+        map::readable::visit),
+  });
 
-    jclass nativeRunnableClass = env->FindClass("com/facebook/react/bridge/queue/NativeRunnable");
-    runnable::gNativeRunnableClass = (jclass)env->NewGlobalRef(nativeRunnableClass);
-    runnable::gNativeRunnableCtor = env->GetMethodID(nativeRunnableClass, "<init>", "()V");
-    wrap_alias(nativeRunnableClass)->registerNatives({
-        makeNativeMethod("run", runnable::run),
-    });
+  registerNatives("com/facebook/react/bridge/WritableNativeMap", {
+      makeNativeMethod("putNull", map::writable::putNull),
+      makeNativeMethod("putBoolean", map::writable::putBoolean),
+      makeNativeMethod("putDouble", map::writable::putDouble),
+      makeNativeMethod("putString", map::writable::putString),
+      makeNativeMethod(
+        "putNativeArray", "(Ljava/lang/String;Lcom/facebook/react/bridge/WritableNativeArray;)V",
+        map::writable::putArray),
+      makeNativeMethod(
+        "putNativeMap", "(Ljava/lang/String;Lcom/facebook/react/bridge/WritableNativeMap;)V",
+        map::writable::putMap),
+      makeNativeMethod(
+        "mergeNativeMap", "(Lcom/facebook/react/bridge/ReadableNativeMap;)V",
+        map::writable::mergeMap),
+      makeNativeMethod(
+        "putAll", "(Lcom/facebook/react/bridge/WritableNativeMap;)V",
+        map::writable::putAll),
+  });
+
+  registerNatives("com/facebook/react/bridge/ReadableNativeMap$ReadableNativeMapKeySeyIterator", {
+    makeNativeMethod("initialize", "(Lcom/facebook/react/bridge/ReadableNativeMap;)V",
+                     map::iterator::initialize),
+    makeNativeMethod("hasNextKey", map::iterator::hasNextKey),
+    makeNativeMethod("nextKey", map::iterator::getNextKey),
+  });
+}
+
+// What batches need to be posted to a queue thread
+static void registerQueue() {
+  JNIEnv* env = Environment::current();
+
+  jclass nativeRunnableClass = env->FindClass("com/facebook/react/bridge/queue/NativeRunnable");
+  runnable::gNativeRunnableClass = (jclass)env->NewGlobalRef(nativeRunnableClass);
+  runnable::gNativeRunnableCtor = env->GetMethodID(nativeRunnableClass, "<init>", "()V");
+  wrap_alias(nativeRunnableClass)->registerNatives({
+      makeNativeMethod("run", runnable::run),
+  });
+
+  queue::JMessageQueueThread::runOnQueue.resolve();
+}
+
+// The executors the bridge runs JS on
+static void registerExecutors() {
+  registerNatives("com/facebook/react/bridge/JSCJavaScriptExecutor", {
+    makeNativeMethod("initialize", "(IJJZZ)V", executors::createJSCExecutor),
+    makeNativeMethod("prepareWarmContext", "()V", executors::prepareWarmJSCContext),
+    makeNativeMethod("startBufferedTracing", "(JI)Z", executors::startBufferedTracing),
+    makeNativeMethod(
+      "stopBufferedTracing", "(Ljava/lang/String;)Z", executors::stopBufferedTracing),
+  });
+
+  registerNatives("com/facebook/react/bridge/ProxyJavaScriptExecutor", {
+      makeNativeMethod(
+        "initialize", "(Lcom/facebook/react/bridge/ProxyJavaScriptExecutor$JavaJSExecutor;)V",
+        executors::createProxyExecutor),
+  });
+
+  JavaJSExecutor::resolveMembers();
+}
+
+// The bridge itself, which needs the collections and the queue
+static void registerBridge() {
+  bridge::JReactCallback::callBatch.resolve();
+  bridge::JReactCallback::callLowPriorityBatch.resolve();
+  bridge::JReactCallback::onBatchComplete.resolve();
+  bridge::JReactCallback::callSync.resolve();
+  bridge::JReactCallback::getModuleNames.resolve();
+  bridge::JReactCallback::getModuleConfig.resolve();
+
+  registerNatives("com/facebook/react/bridge/ReactBridge", {
+      makeNativeMethod("initialize", "(Lcom/facebook/react/bridge/JavaScriptExecutor;Lcom/facebook/react/bridge/ReactCallback;Lcom/facebook/react/bridge/queue/MessageQueueThread;Lcom/facebook/react/bridge/queue/MessageQueueThread;[I)V", bridge::create),
+      makeNativeMethod(
+        "prefetchScriptFromAssets", "(Landroid/content/res/AssetManager;Ljava/lang/String;)V",
+        bridge::prefetchScriptFromAssets),
+      makeNativeMethod(
+        "loadScriptFromAssets", "(Landroid/content/res/AssetManager;Ljava/lang/String;)V",
+        bridge::loadScriptFromAssets),
+      makeNativeMethod("loadScriptFromNetworkCached", bridge::loadScriptFromNetworkCached),
+      makeNativeMethod("callFunction", bridge::callFunction),
+      makeNativeMethod("invokeCallback", bridge::invokeCallback),
+      makeNativeMethod("setGlobalVariable", bridge::setGlobalVariable),
+      makeNativeMethod("supportsProfiling", bridge::supportsProfiling),
+      makeNativeMethod("getStats", bridge::getStats),
+      makeNativeMethod("startProfiler", bridge::startProfiler),
+      makeNativeMethod("stopProfiler", bridge::stopProfiler),
+      makeNativeMethod("supportsSamplingProfiler", bridge::supportsSamplingProfiler),
+      makeNativeMethod("startSamplingProfiler", bridge::startSamplingProfiler),
+      makeNativeMethod("stopSamplingProfiler", bridge::stopSamplingProfiler),
+      makeNativeMethod("collectGarbage", bridge::collectGarbage),
+      makeNativeMethod("handleIdle", bridge::handleIdle),
+      makeNativeMethod("startRecording", bridge::startRecording),
+      makeNativeMethod("stopRecording", bridge::stopRecording),
+      makeNativeMethod("unpinReferences", bridge::unpinReferences),
+  });
 
-    jclass messageQueueThreadClass =
-      env->FindClass("com/facebook/react/bridge/queue/MessageQueueThread");
-    queue::gRunOnQueueThreadMethod =
-      env->GetMethodID(messageQueueThreadClass, "runOnQueue", "(Ljava/lang/Runnable;)V");
+  registerNatives("com/facebook/react/bridge/JSBundleDelta", {
+      makeNativeMethod(
+        "apply", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V",
+        bridge::applyScriptDelta),
+  });
+}
+
+// Core affinity hints for the queue threads
+static void registerAffinity() {
+  registerNatives("com/facebook/react/bridge/queue/CpuAffinity", {
+      makeNativeMethod(
+        "setThreadPrefersFastCores", "(IZ)Z", affinity::setThreadPrefersFastCores),
+  });
+}
+
+// Must match the groups of NativeRegistration.java
+enum Group {
+  kCollections = 0,
+  kQueue = 1,
+  kExecutors = 2,
+  kBridge = 3,
+  kAffinity = 4,
+};
+
+// Called by NativeRegistration once per group, from the static initializer of the first class
+// of the group that is used. Registering doesn't initialize any class that asks for a group
+// itself, which could deadlock with another thread initializing that class.
+static void registerGroup(JNIEnv* env, jclass clazz, jint group) {
+  switch (group) {
+    case kCollections:
+      registerCollections();
+      break;
+    case kQueue:
+      registerQueue();
+      break;
+    case kExecutors:
+      registerExecutors();
+      break;
+    case kBridge:
+      registerBridge();
+      break;
+    case kAffinity:
+      registerAffinity();
+      break;
+    default:
+      throwNewJavaException("java/lang/IllegalArgumentException",
+                            "Unknown native registration group %d", group);
+  }
+}
+
+} // namespace registration
+
+extern "C" JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved) {
+  // The JS thread shouldn't wait on logcat for every console.log
+  enableAsyncLogging(kMaxLogMessagesPerTagPerSecond);
+
+  // Everything else is registered as it's first used, rather than up front on the thread that
+  // loads the library, which is on the way to the first React screen
+  return initialize(vm, [] {
+    registerNatives("com/facebook/react/bridge/NativeRegistration", {
+        makeNativeMethod("registerNatives", "(I)V", registration::registerGroup),
+    });
   });
 }
 
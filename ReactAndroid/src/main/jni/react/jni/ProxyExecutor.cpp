@@ -5,12 +5,29 @@
 #include <jni/Environment.h>
 #include <jni/LocalReference.h>
 #include <jni/LocalString.h>
+#include <jni/fbjni/Exceptions.h>
 #include <folly/json.h>
 
 namespace facebook {
 namespace react {
 
-const auto EXECUTOR_BASECLASS = "com/facebook/react/bridge/ProxyJavaScriptExecutor$JavaJSExecutor";
+jni::JMemberId<JavaJSExecutor, jni::JMethod<void(jobject, jstring)>>
+  JavaJSExecutor::executeApplicationScript{
+    "executeApplicationScript", "(Ljava/nio/ByteBuffer;Ljava/lang/String;)V"
+  };
+jni::JMemberId<JavaJSExecutor, jni::JMethod<jobject(jstring, jstring, jobject)>>
+  JavaJSExecutor::executeJSCall{
+    "executeJSCall",
+    "(Ljava/lang/String;Ljava/lang/String;Ljava/nio/ByteBuffer;)Ljava/nio/ByteBuffer;"
+  };
+jni::JMemberId<JavaJSExecutor, jni::JMethod<void(jstring, jstring)>>
+  JavaJSExecutor::setGlobalVariable{"setGlobalVariable"};
+
+void JavaJSExecutor::resolveMembers() {
+  executeApplicationScript.resolve();
+  executeJSCall.resolve();
+  setGlobalVariable.resolve();
+}
 
 std::unique_ptr<JSExecutor> ProxyExecutorOneTimeFactory::createJSExecutor() {
   FBASSERTMSGF(
@@ -20,42 +37,65 @@ std::unique_ptr<JSExecutor> ProxyExecutorOneTimeFactory::createJSExecutor() {
   return std::unique_ptr<JSExecutor>(new ProxyExecutor(std::move(m_executor)));
 }
 
+// The script or arguments buffer, the strings passed along with it and the returned buffer
+const jint kLocalRefsPerProxyCall = 4;
+
+// Lends UTF-8 that stays alive for the whole call to Java without copying it into a jstring.
+// Java must not hold on to the buffer after the call returns.
+static jobject makeBorrowedByteBuffer(JNIEnv* env, const char* data, size_t size) {
+  jobject buffer = env->NewDirectByteBuffer(const_cast<char*>(data), size);
+  jni::throwPendingJniExceptionAsCppException();
+  return buffer;
+}
+
 ProxyExecutor::~ProxyExecutor() {
   m_executor.reset();
 }
 
 void ProxyExecutor::executeApplicationScript(
-    const std::string& script,
+    std::unique_ptr<const JSBigString> script,
     const std::string& sourceURL) {
-  static auto executeApplicationScript =
-    jni::findClassStatic(EXECUTOR_BASECLASS)->getMethod<void(jstring, jstring)>("executeApplicationScript");
-
-  executeApplicationScript(
+  auto env = jni::Environment::current();
+  jni::JniLocalScope scope(env, kLocalRefsPerProxyCall);
+  jobject jScript = makeBorrowedByteBuffer(env, script->c_str(), script->size());
+  auto jSourceURL = jni::make_jstring(sourceURL);
+  env->CallVoidMethod(
     m_executor.get(),
-    jni::make_jstring(script).get(),
-    jni::make_jstring(sourceURL).get());
+    JavaJSExecutor::executeApplicationScript.get().getId(),
+    jScript,
+    jSourceURL.get());
+  jni::throwPendingJniExceptionAsCppException();
 }
 
 std::string ProxyExecutor::executeJSCall(
     const std::string& moduleName,
     const std::string& methodName,
     const std::vector<folly::dynamic>& arguments) {
-  static auto executeJSCall =
-    jni::findClassStatic(EXECUTOR_BASECLASS)->getMethod<jstring(jstring, jstring, jstring)>("executeJSCall");
-
-  auto result = executeJSCall(
+  auto env = jni::Environment::current();
+  jni::JniLocalScope scope(env, kLocalRefsPerProxyCall);
+  auto json = folly::toJson(arguments);
+  jobject jArguments = makeBorrowedByteBuffer(env, json.data(), json.size());
+  auto jModuleName = jni::make_jstring(moduleName);
+  auto jMethodName = jni::make_jstring(methodName);
+  jobject jResult = env->CallObjectMethod(
     m_executor.get(),
-    jni::make_jstring(moduleName).get(),
-    jni::make_jstring(methodName).get(),
-    jni::make_jstring(folly::toJson(arguments).c_str()).get());
-  return result->toString();
+    JavaJSExecutor::executeJSCall.get().getId(),
+    jModuleName.get(),
+    jMethodName.get(),
+    jArguments);
+  jni::throwPendingJniExceptionAsCppException();
+  if (jResult == nullptr) {
+    return "null";
+  }
+
+  // The result is either JSON or the binary batch format, parseMethodCalls tells them apart
+  auto data = static_cast<const char*>(env->GetDirectBufferAddress(jResult));
+  FBASSERTMSGF(data != nullptr, "executeJSCall must return a direct ByteBuffer");
+  return std::string(data, env->GetDirectBufferCapacity(jResult));
 }
 
 void ProxyExecutor::setGlobalVariable(const std::string& propName, const std::string& jsonValue) {
-  static auto setGlobalVariable =
-    jni::findClassStatic(EXECUTOR_BASECLASS)->getMethod<void(jstring, jstring)>("setGlobalVariable");
-
-  setGlobalVariable(
+  JavaJSExecutor::setGlobalVariable.get()(
     m_executor.get(),
     jni::make_jstring(propName).get(),
     jni::make_jstring(jsonValue).get());
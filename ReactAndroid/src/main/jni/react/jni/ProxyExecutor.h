@@ -10,6 +10,23 @@
 namespace facebook {
 namespace react {
 
+struct JavaJSExecutor : public jni::JavaClass<JavaJSExecutor> {
+  constexpr static auto kJavaDescriptor =
+    "Lcom/facebook/react/bridge/ProxyJavaScriptExecutor$JavaJSExecutor;";
+
+  // The script, the arguments and the result cross as direct ByteBuffers of UTF-8, so they are
+  // never converted to and from Java strings
+  static jni::JMemberId<JavaJSExecutor, jni::JMethod<void(jobject, jstring)>>
+    executeApplicationScript;
+  static jni::JMemberId<JavaJSExecutor, jni::JMethod<jobject(jstring, jstring, jobject)>>
+    executeJSCall;
+  static jni::JMemberId<JavaJSExecutor, jni::JMethod<void(jstring, jstring)>>
+    setGlobalVariable;
+
+  // Called from JNI_OnLoad, so that calls into the executor never look them up
+  static void resolveMembers();
+};
+
 /**
  * This executor factory can only create a single executor instance because it moves
  * executorInstance global reference to the executor instance it creates.
@@ -30,7 +47,7 @@ public:
     m_executor(std::move(executorInstance)) {}
   virtual ~ProxyExecutor() override;
   virtual void executeApplicationScript(
-    const std::string& script,
+    std::unique_ptr<const JSBigString> script,
     const std::string& sourceURL) override;
   virtual std::string executeJSCall(
     const std::string& moduleName,
@@ -0,0 +1,27 @@
+LOCAL_PATH:= $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES:= \
+	bridgebench.cpp \
+	../jni/MethodCallBuffer.cpp \
+
+LOCAL_SHARED_LIBRARIES := \
+	libfb \
+	libfolly_json \
+	libjsc
+
+LOCAL_STATIC_LIBRARIES := \
+	libreactnative
+
+LOCAL_MODULE := reactnative_bench
+
+LOCAL_CFLAGS += -Wall -Werror -fexceptions -O2
+LOCAL_CFLAGS += $(BUCK_DEP_CFLAGS)
+LOCAL_LDFLAGS += $(BUCK_DEP_LDFLAGS)
+
+include $(BUILD_EXECUTABLE)
+
+$(call import-module,react)
+$(call import-module,folly)
+$(call import-module,jsc)
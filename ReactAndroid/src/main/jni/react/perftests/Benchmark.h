@@ -0,0 +1,112 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace facebook {
+namespace react {
+namespace benchmark {
+
+// Keeps the compiler from proving a benchmarked result unused and dropping the work
+template <typename T>
+inline void doNotOptimizeAway(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct Options {
+  // Warmup lets JSC tier up and brings caches and the CPU governor to a steady state
+  std::chrono::milliseconds warmup{200};
+  // Each sample runs for at least this long, so timer resolution does not matter
+  std::chrono::milliseconds minSampleTime{10};
+  size_t samples = 30;
+};
+
+struct Result {
+  std::string name;
+  size_t iterationsPerSample;
+  double meanNs;
+  double stddevNs;
+  double minNs;
+  double medianNs;
+  double p90Ns;
+};
+
+inline void printHeader() {
+  printf("%-48s %10s %12s %12s %12s %12s %9s\n",
+         "benchmark", "iters", "min ns", "median ns", "p90 ns", "mean ns", "stddev");
+}
+
+inline void printResult(const Result& result) {
+  printf("%-48s %10zu %12.1f %12.1f %12.1f %12.1f %8.1f%%\n",
+         result.name.c_str(),
+         result.iterationsPerSample,
+         result.minNs,
+         result.medianNs,
+         result.p90Ns,
+         result.meanNs,
+         result.meanNs > 0 ? 100.0 * result.stddevNs / result.meanNs : 0.0);
+  fflush(stdout);
+}
+
+/**
+ * Times body() and prints per-iteration statistics over several samples. The number of
+ * iterations per sample is calibrated during warmup.
+ */
+template <typename F>
+Result run(const std::string& name, F&& body, const Options& options = Options()) {
+  using Clock = std::chrono::steady_clock;
+
+  size_t iterations = 1;
+  auto warmupEnd = Clock::now() + options.warmup;
+  do {
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      body();
+    }
+    auto elapsed = Clock::now() - start;
+    if (elapsed < options.minSampleTime) {
+      iterations *= 2;
+    }
+  } while (Clock::now() < warmupEnd);
+
+  std::vector<double> perIterationNs;
+  perIterationNs.reserve(options.samples);
+  for (size_t sample = 0; sample < options.samples; sample++) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      body();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    perIterationNs.push_back(elapsed / iterations);
+  }
+
+  std::sort(perIterationNs.begin(), perIterationNs.end());
+  double sum = 0;
+  for (double ns : perIterationNs) {
+    sum += ns;
+  }
+  double mean = sum / perIterationNs.size();
+  double squares = 0;
+  for (double ns : perIterationNs) {
+    squares += (ns - mean) * (ns - mean);
+  }
+
+  Result result;
+  result.name = name;
+  result.iterationsPerSample = iterations;
+  result.meanNs = mean;
+  result.stddevNs = std::sqrt(squares / perIterationNs.size());
+  result.minNs = perIterationNs.front();
+  result.medianNs = perIterationNs[perIterationNs.size() / 2];
+  result.p90Ns = perIterationNs[perIterationNs.size() * 9 / 10];
+  printResult(result);
+  return result;
+}
+
+} } }
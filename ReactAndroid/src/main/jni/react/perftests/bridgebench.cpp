@@ -0,0 +1,262 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+// Native bridge micro-benchmarks. Build reactnative_bench from perftests/Android.mk, push it to
+// a device next to its shared libraries and run it from adb shell. Runs that are compared with
+// each other should use the same device, with the screen on and nothing else running.
+//
+// With --replay <file>, replays a session recorded with ReactBridge.startRecording instead.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <react/BridgeRecorder.h>
+#include <react/JSCExecutor.h>
+#include <react/MethodCall.h>
+#include <react/Value.h>
+#include <react/jni/MethodCallBuffer.h>
+#include "Benchmark.h"
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+// Roughly what UIManager.createView looks like for a styled text node
+folly::dynamic makeCreateViewArguments(int tag) {
+  return {
+    tag,
+    "RCTText",
+    1,
+    folly::dynamic::object
+      ("text", "Hello, world")
+      ("fontSize", 14)
+      ("lineHeight", 18.5)
+      ("color", -16777216)
+      ("flex", 1)
+      ("accessible", true)
+      ("margin", folly::dynamic({ 4, 8, 4, 8 })),
+  };
+}
+
+folly::dynamic makeFlushedQueue(int callCount) {
+  folly::dynamic moduleIds = {};
+  folly::dynamic methodIds = {};
+  folly::dynamic params = {};
+  for (int i = 0; i < callCount; i++) {
+    moduleIds.push_back(7);
+    methodIds.push_back(2);
+    params.push_back(makeCreateViewArguments(i));
+  }
+  return { moduleIds, methodIds, params };
+}
+
+std::string makeFlushedQueueJSON(int callCount) {
+  return folly::toJson(makeFlushedQueue(callCount)).toStdString();
+}
+
+std::vector<uint16_t> toUTF16(const std::string& ascii) {
+  return std::vector<uint16_t>(ascii.begin(), ascii.end());
+}
+
+void benchmarkParseMethodCalls() {
+  for (int callCount : { 1, 50, 1000 }) {
+    auto json = makeFlushedQueueJSON(callCount);
+    auto utf16 = toUTF16(json);
+    auto suffix = folly::to<std::string>(" (", callCount, " calls)");
+
+    benchmark::run("parseMethodCalls JSON" + suffix, [&] {
+      benchmark::doNotOptimizeAway(parseMethodCalls(json));
+    });
+    benchmark::run("parseMethodCalls UTF-16" + suffix, [&] {
+      benchmark::doNotOptimizeAway(parseMethodCalls(utf16.data(), utf16.size()));
+    });
+
+    auto calls = parseMethodCalls(json);
+    benchmark::run("writeMethodCallBuffer" + suffix, [&] {
+      benchmark::doNotOptimizeAway(writeMethodCallBuffer(calls));
+    });
+  }
+}
+
+void benchmarkValue() {
+  JSGlobalContextRef ctx = JSGlobalContextCreateInGroup(nullptr, nullptr);
+  for (int callCount : { 1, 50 }) {
+    auto suffix = folly::to<std::string>(" (", callCount, " calls)");
+    auto queue = makeFlushedQueue(callCount);
+    String json(folly::toJson(queue).c_str());
+    JSContextRef context = ctx;
+    // fromJSON leaves its result unprotected, the Value unprotects it when it goes away
+    Value value(Value::fromJSON(context, json));
+    JSValueProtect(ctx, value);
+
+    benchmark::run("Value::toJSONString" + suffix, [&] {
+      benchmark::doNotOptimizeAway(value.toJSONString());
+    });
+    benchmark::run("Value::createJSONString" + suffix, [&] {
+      benchmark::doNotOptimizeAway(value.createJSONString());
+    });
+    benchmark::run("Value::toDynamic" + suffix, [&] {
+      benchmark::doNotOptimizeAway(value.toDynamic());
+    });
+    benchmark::run("Value::fromDynamic" + suffix, [&] {
+      Value result(Value::fromDynamic(ctx, queue));
+      benchmark::doNotOptimizeAway(result);
+    });
+    benchmark::run("toJson + JSValueMakeFromJSONString" + suffix, [&] {
+      String queueJSON(folly::toJson(queue).c_str());
+      benchmark::doNotOptimizeAway(JSValueMakeFromJSONString(ctx, queueJSON));
+    });
+  }
+  JSGlobalContextRelease(ctx);
+}
+
+void benchmarkString() {
+  for (size_t length : { 16, 1024, 64 * 1024 }) {
+    String string(std::string(length, 'a').c_str());
+    benchmark::run(folly::to<std::string>("String::str (", length, " chars)"), [&] {
+      benchmark::doNotOptimizeAway(string.str());
+    });
+  }
+}
+
+// The folly::dynamic work behind WritableNativeArray/WritableNativeMap pushes, minus the JNI
+// transitions, which need a VM to measure
+void benchmarkNativeArrayConstruction() {
+  benchmark::run("NativeArray construction (20 items)", [] {
+    folly::dynamic array = {};
+    for (int i = 0; i < 5; i++) {
+      array.push_back(i);
+      array.push_back(i * 0.5);
+      array.push_back("item");
+      folly::dynamic map = folly::dynamic::object;
+      map.insert("key", i);
+      array.push_back(std::move(map));
+    }
+    benchmark::doNotOptimizeAway(array);
+  });
+}
+
+void benchmarkJSCExecutor() {
+  auto script = folly::to<std::string>(
+    "var queue = ", makeFlushedQueueJSON(50), ";"
+    "var Bridge = {"
+    "  callFunctionReturnFlushedQueue: function (module, method, args) {"
+    "    return null;"
+    "  },"
+    "  invokeCallbackAndReturnFlushedQueue: function (callbackId, args) {"
+    "    return queue;"
+    "  },"
+    "};"
+    "function require() { return Bridge; }");
+  JSCExecutor executor;
+  executor.executeApplicationScript(script, "bridgebench.js");
+
+  std::vector<folly::dynamic> emptyCall = { "RCTEventEmitter", "receiveEvent", {} };
+  benchmark::run("JSCExecutor call, empty queue", [&] {
+    benchmark::doNotOptimizeAway(executor.executeJSCallForMethodCalls(
+      "Bridge", "callFunctionReturnFlushedQueue", emptyCall));
+  });
+
+  std::vector<folly::dynamic> touchCall = {
+    "RCTEventEmitter",
+    "receiveTouches",
+    {
+      "topTouchStart",
+      folly::dynamic({
+        folly::dynamic::object
+          ("target", 12)
+          ("identifier", 0)
+          ("pageX", 120.5)
+          ("pageY", 300.25)
+          ("timestamp", 123456789),
+      }),
+      folly::dynamic({ 0 }),
+    },
+  };
+  benchmark::run("JSCExecutor call, touch event", [&] {
+    benchmark::doNotOptimizeAway(executor.executeJSCallForMethodCalls(
+      "Bridge", "callFunctionReturnFlushedQueue", touchCall));
+  });
+
+  std::vector<folly::dynamic> callbackCall = { 1, {} };
+  benchmark::run("JSCExecutor call, 50 call queue", [&] {
+    benchmark::doNotOptimizeAway(executor.executeJSCallForMethodCalls(
+      "Bridge", "invokeCallbackAndReturnFlushedQueue", callbackCall));
+  });
+  benchmark::run("JSCExecutor call, 50 call queue as string", [&] {
+    benchmark::doNotOptimizeAway(executor.executeJSCall(
+      "Bridge", "invokeCallbackAndReturnFlushedQueue", callbackCall));
+  });
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, size_t percent) {
+  return sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+// Runs the native side of every flush in a recorded session, the way each one travels to Java,
+// as one iteration. JS itself is not replayed, as that needs the app's bundle and native modules;
+// the JS time of the session is reported as recorded.
+void replayRecording(const std::string& filename) {
+  auto events = readBridgeRecording(filename);
+  std::vector<const std::string*> queues;
+  std::vector<int64_t> jsTimes;
+  size_t callsIntoJS = 0;
+  size_t nativeCalls = 0;
+  for (const auto& event : events) {
+    if (event.type == RecordedBridgeEvent::Call) {
+      callsIntoJS++;
+    } else {
+      queues.push_back(&event.queueJSON);
+      jsTimes.push_back(event.durationUs);
+      nativeCalls += parseMethodCalls(event.queueJSON).size();
+    }
+  }
+  int64_t sessionUs = events.empty() ? 0 : events.back().timeUs;
+  printf("%s: %.1f s, %zu calls into JS, %zu flushes, %zu native calls\n",
+         filename.c_str(), sessionUs / 1e6, callsIntoJS, queues.size(), nativeCalls);
+
+  std::sort(jsTimes.begin(), jsTimes.end());
+  printf("recorded JS time per call: median %lld us, p90 %lld us, p99 %lld us, max %lld us\n",
+         (long long) percentile(jsTimes, 50),
+         (long long) percentile(jsTimes, 90),
+         (long long) percentile(jsTimes, 99),
+         (long long) (jsTimes.empty() ? 0 : jsTimes.back()));
+
+  benchmark::printHeader();
+  auto parse = benchmark::run("replay parseMethodCalls", [&] {
+    for (const std::string* queue : queues) {
+      benchmark::doNotOptimizeAway(parseMethodCalls(*queue));
+    }
+  });
+  auto toJava = benchmark::run("replay parseMethodCalls + writeMethodCallBuffer", [&] {
+    for (const std::string* queue : queues) {
+      benchmark::doNotOptimizeAway(writeMethodCallBuffer(parseMethodCalls(*queue)));
+    }
+  });
+  for (const auto& result : { parse, toJava }) {
+    if (result.medianNs > 0) {
+      printf("%-48s %12.0f native calls/s\n",
+             result.name.c_str(), nativeCalls / (result.medianNs / 1e9));
+    }
+  }
+}
+
+}
+
+int main(int argc, char** argv) {
+  if (argc == 3 && strcmp(argv[1], "--replay") == 0) {
+    replayRecording(argv[2]);
+    return 0;
+  }
+  benchmark::printHeader();
+  benchmarkParseMethodCalls();
+  benchmarkValue();
+  benchmarkString();
+  benchmarkNativeArrayConstruction();
+  benchmarkJSCExecutor();
+  return 0;
+}
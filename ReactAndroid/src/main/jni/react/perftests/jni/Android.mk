@@ -0,0 +1 @@
+include ../Android.mk
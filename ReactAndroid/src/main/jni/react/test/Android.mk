@@ -7,6 +7,13 @@ LOCAL_SRC_FILES:= \
 	jsclogging.cpp \
 	value.cpp \
 	methodcall.cpp \
+	bridge.cpp \
+	bridgestats.cpp \
+	bridgerecorder.cpp \
+	samplingprofiler.cpp \
+	tracebuffer.cpp \
+	exceptionlogger.cpp \
+	asynclog.cpp \
 
 LOCAL_SHARED_LIBRARIES := \
 	libfb \
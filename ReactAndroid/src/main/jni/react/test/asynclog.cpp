@@ -0,0 +1,60 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <atomic>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <fb/log.h>
+
+namespace {
+
+std::atomic<int> handledCount(0);
+
+void countingLogHandler(int pri, const char *tag, const char *msg) {
+  if (strcmp(tag, "AsyncLogTest") == 0) {
+    handledCount++;
+  }
+}
+
+class AsyncLogTest : public testing::Test {
+  protected:
+    virtual void SetUp() override {
+      handledCount = 0;
+      setLogHandler(&countingLogHandler);
+    }
+
+    virtual void TearDown() override {
+      enableAsyncLogging(0);
+      setLogHandler(NULL);
+    }
+};
+
+}
+
+TEST_F(AsyncLogTest, RateLimitsEachTag) {
+  enableAsyncLogging(5);
+  auto before = getLogDropCounts();
+
+  for (int i = 0; i < 100; i++) {
+    FBLOG_PRI(ANDROID_LOG_INFO, "AsyncLogTest", "message %d", i);
+  }
+  flushAsyncLogging();
+
+  // The handler still sees every message
+  ASSERT_EQ(100, handledCount);
+  // At most one new window can have started while logging
+  auto after = getLogDropCounts();
+  ASSERT_GE(after.rateLimited - before.rateLimited, 90u);
+}
+
+TEST_F(AsyncLogTest, DoesNotRateLimitErrors) {
+  enableAsyncLogging(1);
+  auto before = getLogDropCounts();
+
+  for (int i = 0; i < 10; i++) {
+    FBLOG_PRI(ANDROID_LOG_ERROR, "AsyncLogTest", "error %d", i);
+  }
+  flushAsyncLogging();
+
+  ASSERT_EQ(10, handledCount);
+  ASSERT_EQ(before.rateLimited, getLogDropCounts().rateLimited);
+}
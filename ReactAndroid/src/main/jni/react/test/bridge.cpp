@@ -0,0 +1,124 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+#include <folly/dynamic.h>
+#include <react/Bridge.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+// Flushes one method call for every JS call whose first argument is true, and nothing otherwise
+class FlushingExecutor : public JSExecutor {
+public:
+  explicit FlushingExecutor(std::vector<std::string>* methodNames) :
+    m_methodNames(methodNames) {}
+
+  using JSExecutor::executeApplicationScript;
+  void executeApplicationScript(
+      std::unique_ptr<const JSBigString> script,
+      const std::string& sourceURL) override {}
+
+  std::string executeJSCall(
+      const std::string& moduleName,
+      const std::string& methodName,
+      const std::vector<folly::dynamic>& arguments) override {
+    return "null";
+  }
+
+  std::vector<MethodCall> executeJSCallForMethodCalls(
+      const std::string& moduleName,
+      const std::string& methodName,
+      const std::vector<folly::dynamic>& arguments) override {
+    m_methodNames->push_back(methodName);
+    std::vector<MethodCall> calls;
+    if (!arguments.empty() && arguments[0].isBool() && arguments[0].asBool()) {
+      calls.emplace_back(1, 2, folly::dynamic {});
+    }
+    return calls;
+  }
+
+  void setGlobalVariable(const std::string& propName, const std::string& jsonValue) override {}
+
+private:
+  std::vector<std::string>* m_methodNames;
+};
+
+class FlushingExecutorFactory : public JSExecutorFactory {
+public:
+  explicit FlushingExecutorFactory(std::vector<std::string>* methodNames) :
+    m_methodNames(methodNames) {}
+
+  std::unique_ptr<JSExecutor> createJSExecutor() override {
+    return std::unique_ptr<JSExecutor>(new FlushingExecutor(m_methodNames));
+  }
+
+private:
+  std::vector<std::string>* m_methodNames;
+};
+
+// Counts pending JS calls like CatalystInstance does: up for each call into JS, and down by the
+// calls each callback completes
+struct PendingJSCalls {
+  int pending = 0;
+  int callbacks = 0;
+  size_t methodCalls = 0;
+};
+
+RefPtr<Bridge> createBridge(std::vector<std::string>* methodNames, PendingJSCalls* pendingCalls) {
+  auto factory = createNew<FlushingExecutorFactory>(methodNames);
+  return createNew<Bridge>(factory, [pendingCalls] (
+      std::vector<MethodCall> calls, size_t completedJSCalls) {
+    pendingCalls->pending -= completedJSCalls;
+    pendingCalls->callbacks++;
+    pendingCalls->methodCalls += calls.size();
+  });
+}
+
+}
+
+TEST(Bridge, CompletesEveryJSCallEvenIfItFlushesNothing) {
+  std::vector<std::string> methodNames;
+  PendingJSCalls pendingCalls;
+  auto bridge = createBridge(&methodNames, &pendingCalls);
+
+  pendingCalls.pending++;
+  bridge->executeJSCall("BatchedBridge", "callFunctionReturnFlushedQueue", { true });
+  pendingCalls.pending++;
+  bridge->executeJSCall("BatchedBridge", "invokeCallbackAndReturnFlushedQueue", { false });
+
+  EXPECT_EQ(0, pendingCalls.pending);
+  EXPECT_EQ(2, pendingCalls.callbacks);
+  EXPECT_EQ(1, pendingCalls.methodCalls);
+}
+
+TEST(Bridge, DoesNotCallBackForWorkOtherThanJSCalls) {
+  std::vector<std::string> methodNames;
+  PendingJSCalls pendingCalls;
+  auto bridge = createBridge(&methodNames, &pendingCalls);
+
+  bridge->setGlobalVariable("__fbBatchedBridgeConfig", "{}");
+  bridge->executeApplicationScript(
+    std::unique_ptr<const JSBigString>(new JSBigStdString("")), "bundle.js");
+
+  EXPECT_EQ(0, pendingCalls.callbacks);
+}
+
+TEST(Bridge, CompletesAllCoalescedCallsWithOneCallback) {
+  std::vector<std::string> methodNames;
+  PendingJSCalls pendingCalls;
+  auto bridge = createBridge(&methodNames, &pendingCalls);
+
+  std::vector<JSCall> calls;
+  for (int i = 0; i < 3; i++) {
+    pendingCalls.pending++;
+    calls.push_back(JSCall { "callFunctionReturnFlushedQueue", { true } });
+  }
+  bridge->executeJSCalls(std::move(calls));
+
+  ASSERT_EQ(1, methodNames.size());
+  EXPECT_EQ("callFunctionsReturnFlushedQueue", methodNames[0]);
+  EXPECT_EQ(0, pendingCalls.pending);
+  EXPECT_EQ(1, pendingCalls.callbacks);
+}
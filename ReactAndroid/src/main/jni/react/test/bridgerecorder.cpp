@@ -0,0 +1,51 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+#include <folly/json.h>
+#include <react/BridgeRecorder.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+static const char* kRecordingFile = "/data/local/tmp/bridgerecorder.jsonl";
+
+TEST(BridgeRecorder, RecordsCallsAndFlushesForReplay) {
+  {
+    auto recorder = BridgeRecorder::open(kRecordingFile);
+    ASSERT_NE(nullptr, recorder);
+    recorder->recordJSCall(
+      "BatchedBridge", "callFunctionReturnFlushedQueue",
+      { "RCTEventEmitter", "receiveTouches", folly::dynamic { 1, 2 } });
+    std::vector<MethodCall> calls;
+    calls.emplace_back(7, 2, folly::dynamic { 42, "RCTView", folly::dynamic::object("flex", 1) });
+    calls.emplace_back(3, 0, folly::dynamic {});
+    recorder->recordFlush(calls, std::chrono::microseconds(1500));
+  }
+
+  auto events = readBridgeRecording(kRecordingFile);
+  ASSERT_EQ(2, events.size());
+  EXPECT_EQ(RecordedBridgeEvent::Call, events[0].type);
+  EXPECT_EQ("BatchedBridge", events[0].moduleName);
+  EXPECT_EQ("callFunctionReturnFlushedQueue", events[0].methodName);
+  EXPECT_EQ(folly::dynamic({ "RCTEventEmitter", "receiveTouches", folly::dynamic { 1, 2 } }),
+            events[0].arguments);
+
+  EXPECT_EQ(RecordedBridgeEvent::Flush, events[1].type);
+  EXPECT_EQ(1500, events[1].durationUs);
+  EXPECT_LE(events[0].timeUs, events[1].timeUs);
+  auto replayed = parseMethodCalls(events[1].queueJSON);
+  ASSERT_EQ(2, replayed.size());
+  EXPECT_EQ(7, replayed[0].moduleId);
+  EXPECT_EQ(2, replayed[0].methodId);
+  EXPECT_EQ("RCTView", replayed[0].arguments[1].asString());
+  EXPECT_EQ(3, replayed[1].moduleId);
+  EXPECT_EQ(0, replayed[1].arguments.size());
+}
+
+TEST(BridgeRecorder, RejectsMalformedRecordings) {
+  FILE* file = fopen(kRecordingFile, "w");
+  ASSERT_NE(nullptr, file);
+  fputs("[0, \"call\", \"BatchedBridge\"]\n", file);
+  fclose(file);
+  EXPECT_THROW(readBridgeRecording(kRecordingFile), std::runtime_error);
+}
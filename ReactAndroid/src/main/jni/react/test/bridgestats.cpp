@@ -0,0 +1,44 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+#include <react/BridgeStats.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+TEST(Histogram, SmallValuesHaveExactBuckets) {
+  for (uint64_t value = 0; value < Histogram::kSubBucketCount; value++) {
+    EXPECT_EQ(value, Histogram::bucketUpperBound(Histogram::bucketIndex(value)));
+  }
+}
+
+TEST(Histogram, BucketsCoverValuesInOrder) {
+  size_t lastIndex = 0;
+  for (uint64_t value = 1; value < (1ull << 32); value = value * 5 / 4 + 1) {
+    auto index = Histogram::bucketIndex(value);
+    ASSERT_LT(index, Histogram::kBucketCount);
+    ASSERT_GE(index, lastIndex);
+    ASSERT_LE(value, Histogram::bucketUpperBound(index));
+    // Buckets are never wider than an eighth of their values
+    ASSERT_LE(Histogram::bucketUpperBound(index) - value, value / 8);
+    lastIndex = index;
+  }
+}
+
+TEST(Histogram, ClampsLargeValues) {
+  EXPECT_EQ(Histogram::kBucketCount - 1, Histogram::bucketIndex(1ull << 40));
+}
+
+TEST(Histogram, Quantiles) {
+  Histogram histogram;
+  EXPECT_EQ(0, histogram.quantile(0.5));
+  for (uint64_t value = 1; value <= 100; value++) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(100, histogram.count());
+  EXPECT_EQ(1, histogram.quantile(0));
+  EXPECT_EQ(103, histogram.quantile(1));
+  auto median = histogram.quantile(0.5);
+  EXPECT_GE(median, 50);
+  EXPECT_LE(median, 50 + 50 / 8);
+}
@@ -0,0 +1,75 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <react/JSCExceptionLogger.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+class LogCollector {
+public:
+  JSCExceptionLogger::Sink sink() {
+    return [this] (const std::string& text) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_lines.push_back(text);
+    };
+  }
+
+  std::vector<std::string> lines() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lines;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::string> m_lines;
+};
+
+JSValueRef evaluateForException(JSGlobalContextRef ctx, const char* script) {
+  JSValueRef exn = nullptr;
+  JSEvaluateScript(ctx, String(script), nullptr, String("test.js"), 0, &exn);
+  return exn;
+}
+
+}
+
+TEST(JSCExceptionLogger, FormatsMessageLocationAndStack) {
+  LogCollector collector;
+  JSCExceptionLogger logger(collector.sink());
+  JSGlobalContextRef ctx = JSGlobalContextCreateInGroup(nullptr, nullptr);
+  auto exn = evaluateForException(ctx, "\nfunction fail() { throw new Error('boom'); }\nfail();");
+  ASSERT_NE(nullptr, exn);
+  logger.report(ctx, exn);
+  logger.drain();
+  JSGlobalContextRelease(ctx);
+
+  auto lines = collector.lines();
+  ASSERT_EQ(1, lines.size());
+  EXPECT_EQ(0, lines[0].find("Error: boom (test.js:2)"));
+  EXPECT_NE(std::string::npos, lines[0].find("fail"));
+}
+
+TEST(JSCExceptionLogger, CollapsesRepeatedExceptions) {
+  LogCollector collector;
+  JSCExceptionLogger logger(collector.sink());
+  JSGlobalContextRef ctx = JSGlobalContextCreateInGroup(nullptr, nullptr);
+  auto exn = evaluateForException(ctx, "throw 'again';");
+  JSValueProtect(ctx, exn);
+  for (int i = 0; i < 10; i++) {
+    logger.report(ctx, exn, String("fallback.js"));
+  }
+  logger.drain();
+  JSValueUnprotect(ctx, exn);
+  JSGlobalContextRelease(ctx);
+
+  // Reports past the queue limit are dropped rather than repeated, so only check the first line
+  auto lines = collector.lines();
+  ASSERT_GE(lines.size(), 2);
+  EXPECT_EQ("again (fallback.js)", lines[0]);
+  EXPECT_EQ(0, lines[1].find("(previous exception repeated"));
+}
@@ -1,5 +1,6 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 
+#include <thread>
 #include <gtest/gtest.h>
 #include <react/JSCExecutor.h>
 
@@ -159,6 +160,110 @@ TEST(JSCExecutor, CallFunctionReturningNumberArray) {
   EXPECT_EQ(MethodArgument(4.0), array[2]);
 }
 
+TEST(JSCExecutor, CallFunctionAfterScriptReload) {
+  auto jsText = ""
+  "var Bridge = {"
+  "  callFunction: function (module, method, args) {"
+  "    return [[module], [method], [[1]]];"
+  "  },"
+  "};"
+  "function require() { return Bridge; }"
+  "";
+  auto reloadedJsText = ""
+  "var Bridge = {"
+  "  callFunction: function (module, method, args) {"
+  "    return [[module], [method], [[2]]];"
+  "  },"
+  "};"
+  "function require() { return Bridge; }"
+  "";
+  JSCExecutor e;
+  e.executeApplicationScript(jsText, "");
+  auto returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_EQ(1, returnedCalls.size());
+  ASSERT_EQ(MethodArgument(1.0), returnedCalls[0].arguments[0]);
+
+  e.executeApplicationScript(reloadedJsText, "");
+  returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_EQ(1, returnedCalls.size());
+  ASSERT_EQ(MethodArgument(2.0), returnedCalls[0].arguments[0]);
+}
+
+TEST(JSCExecutor, CallMissingFunction) {
+  auto jsText = ""
+  "var Bridge = {};"
+  "function require() { return Bridge; }"
+  "";
+  JSCExecutor e;
+  e.executeApplicationScript(jsText, "");
+  auto returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_TRUE(returnedCalls.empty());
+}
+
+static void appendUInt32(std::string& bundle, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    bundle.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+static std::string makeIndexedBundle(
+    const std::string& startupCode,
+    const std::vector<std::pair<std::string, std::string>>& modules) {
+  std::string bundle;
+  appendUInt32(bundle, JSIndexedBundle::kMagic);
+  appendUInt32(bundle, modules.size());
+  appendUInt32(bundle, startupCode.size());
+  std::string bodies;
+  for (const auto& module : modules) {
+    appendUInt32(bundle, module.first.size());
+    bundle += module.first;
+    appendUInt32(bundle, bodies.size());
+    appendUInt32(bundle, module.second.size());
+    bodies += module.second;
+    bodies.push_back('\0');
+  }
+  bundle += startupCode;
+  bundle.push_back('\0');
+  return bundle + bodies;
+}
+
+TEST(JSCExecutor, CallFunctionInIndexedBundle) {
+  auto startupCode = ""
+  "var modules = {};"
+  "function __d(name, module) { modules[name] = module; }"
+  "function require(name) {"
+  "  if (!modules[name]) { nativeRequire(name); }"
+  "  return modules[name];"
+  "}"
+  "";
+  auto bridgeCode = ""
+  "__d('Bridge', {"
+  "  callFunction: function (module, method, args) {"
+  "    return [[module], [method], [[require('Answer')]]];"
+  "  },"
+  "});"
+  "";
+  auto bundle = makeIndexedBundle(startupCode, {
+    {"Bridge", bridgeCode},
+    {"Answer", "__d('Answer', 42);"},
+  });
+  JSCExecutor e;
+  e.executeApplicationScript(bundle, "");
+  auto returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_EQ(1, returnedCalls.size());
+  ASSERT_EQ(MethodArgument(42.0), returnedCalls[0].arguments[0]);
+}
+
+TEST(JSCExecutor, RequireMissingModuleInIndexedBundle) {
+  auto startupCode = ""
+  "function require(name) { nativeRequire(name); }"
+  "";
+  JSCExecutor e;
+  e.executeApplicationScript(makeIndexedBundle(startupCode, {}), "");
+  auto returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_TRUE(returnedCalls.empty());
+}
+
 TEST(JSCExecutor, SetSimpleGlobalVariable) {
   auto jsText = ""
   "var Bridge = {"
@@ -215,9 +320,80 @@ TEST(JSCExecutor, SetObjectGlobalVariable) {
   EXPECT_EQ(MethodArgument(true), bazIter->second);
 }
 
+TEST(JSCExecutor, WarmContextHasHooksAndNoSharedGlobals) {
+  auto jsText = ""
+  "var Bridge = {"
+  "  callFunction: function (module, method, args) {"
+  "    var seen = typeof marker;"
+  "    marker = true;"
+  "    return [[module], [method], [[seen, typeof nativeLoggingHook]]];"
+  "  },"
+  "};"
+  "function require() { return Bridge; }"
+  "";
+  JSCExecutorFactory::prepareWarmContext();
+  JSCExecutor warm;
+  warm.executeApplicationScript(jsText, "");
+  JSCExecutor cold;
+  cold.executeApplicationScript(jsText, "");
+  for (auto executor : { &warm, &cold }) {
+    auto returnedCalls = executeForMethodCalls(*executor, 10, 9);
+    ASSERT_EQ(1, returnedCalls.size());
+    EXPECT_EQ(MethodArgument("undefined"), returnedCalls[0].arguments[0]);
+    EXPECT_EQ(MethodArgument("function"), returnedCalls[0].arguments[1]);
+  }
+}
+
+TEST(JSCExecutor, SharedContextGroupKeepsGlobalsApart) {
+  auto jsText = ""
+  "var Bridge = {"
+  "  callFunction: function (module, method, args) {"
+  "    var seen = typeof marker;"
+  "    marker = true;"
+  "    return [[module], [method], [[seen]]];"
+  "  },"
+  "};"
+  "function require() { return Bridge; }"
+  "";
+  JSCExecutorOptions options;
+  options.shareContextGroup = true;
+  JSCExecutor first(options);
+  first.executeApplicationScript(jsText, "");
+  JSCExecutor second(options);
+  second.executeApplicationScript(jsText, "");
+  for (auto executor : { &first, &second }) {
+    auto returnedCalls = executeForMethodCalls(*executor, 10, 9);
+    ASSERT_EQ(1, returnedCalls.size());
+    EXPECT_EQ(MethodArgument("undefined"), returnedCalls[0].arguments[0]);
+  }
+}
+
+TEST(JSCExecutor, IdleCollectionKeepsLiveObjects) {
+  auto jsText = ""
+  "var Bridge = {"
+  "  callFunction: function (module, method, args) {"
+  "    return [[module], [method], [[kept.length]]];"
+  "  },"
+  "};"
+  "var kept = [];"
+  "for (var i = 0; i < 1000; i++) { kept.push({i: i}); new Array(100); }"
+  "function require() { return Bridge; }"
+  "";
+  JSCExecutorOptions options;
+  options.idleCollectionInterval = std::chrono::milliseconds(1);
+  options.idleCollectionMinHeapSize = 0;
+  options.idleCollectionHeapGrowth = 0;
+  JSCExecutor e(options);
+  e.executeApplicationScript(jsText, "");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  e.handleIdle();
+  auto returnedCalls = executeForMethodCalls(e, 10, 9);
+  ASSERT_EQ(1, returnedCalls.size());
+  EXPECT_EQ(MethodArgument(1000.0), returnedCalls[0].arguments[0]);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
 
   return RUN_ALL_TESTS();
 }
-
@@ -113,3 +113,182 @@ TEST(parseMethodCalls, ParseTwoCalls) {
   auto returnedCalls = parseMethodCalls(jsText);
   ASSERT_EQ(2, returnedCalls.size());
 }
+
+TEST(parseMethodCalls, BinarySingleCall) {
+  // [[7],[3],[[true, null, -5, "hi", [1], {"a": false}]]]
+  const uint8_t batch[] = {
+    0x01, 0x01, 0x07, 0x03,
+    0x06, 0x06,
+    0x02,
+    0x00,
+    0x03, 0x09,
+    0x05, 0x02, 'h', 'i',
+    0x06, 0x01, 0x03, 0x02,
+    0x07, 0x01, 0x01, 'a', 0x01,
+  };
+  auto returnedCalls = parseMethodCalls(
+    std::string(reinterpret_cast<const char*>(batch), sizeof(batch)));
+  ASSERT_EQ(1, returnedCalls.size());
+  auto& returnedCall = returnedCalls[0];
+  ASSERT_EQ(7, returnedCall.moduleId);
+  ASSERT_EQ(3, returnedCall.methodId);
+  auto& args = returnedCall.arguments;
+  ASSERT_EQ(6, args.size());
+  EXPECT_TRUE(args[0].getBool());
+  EXPECT_TRUE(args[1].isNull());
+  EXPECT_EQ(-5, args[2].getInt());
+  EXPECT_EQ("hi", args[3].getString());
+  ASSERT_EQ(1, args[4].size());
+  EXPECT_EQ(1, args[4][0].getInt());
+  EXPECT_FALSE(args[5].at("a").getBool());
+}
+
+TEST(parseMethodCalls, BinaryDouble) {
+  std::string batch = { kBinaryBatchMagic, 0x01, 0x00, 0x00, 0x06, 0x01, 0x04 };
+  double value = 42.16;
+  batch.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  auto returnedCalls = parseMethodCalls(batch);
+  ASSERT_EQ(1, returnedCalls.size());
+  ASSERT_EQ(1, returnedCalls[0].arguments.size());
+  ASSERT_EQ(42.16, returnedCalls[0].arguments[0].getDouble());
+}
+
+TEST(parseMethodCalls, BinaryPackedArrays) {
+  std::string batch = { kBinaryBatchMagic, 0x01, 0x00, 0x00, 0x06, 0x03, 0x08, 0x01 };
+  double number = 0.5;
+  batch.append(reinterpret_cast<const char*>(&number), sizeof(number));
+  batch.append({ 0x09, 0x01 });
+  int32_t integer = -70000;
+  batch.append(reinterpret_cast<const char*>(&integer), sizeof(integer));
+  batch.append({ 0x0a, 0x02, 0x07, static_cast<char>(0xff) });
+  auto returnedCalls = parseMethodCalls(batch);
+  ASSERT_EQ(1, returnedCalls.size());
+  auto& args = returnedCalls[0].arguments;
+  ASSERT_EQ(3, args.size());
+  ASSERT_EQ(1, args[0].size());
+  EXPECT_EQ(0.5, args[0][0].getDouble());
+  ASSERT_EQ(1, args[1].size());
+  EXPECT_EQ(-70000, args[1][0].getInt());
+  ASSERT_EQ(2, args[2].size());
+  EXPECT_EQ(7, args[2][0].getInt());
+  EXPECT_EQ(255, args[2][1].getInt());
+}
+
+TEST(parseMethodCalls, BinaryTwoCalls) {
+  const uint8_t batch[] = { 0x01, 0x02, 0x00, 0x01, 0x06, 0x00, 0x00, 0x01, 0x06, 0x00 };
+  auto returnedCalls = parseBinaryMethodCalls(batch, sizeof(batch));
+  ASSERT_EQ(2, returnedCalls.size());
+}
+
+TEST(parseMethodCalls, BinaryStringTable) {
+  // [[1],[2],[["View", {"a": "View"}, {"a": 1}]]]
+  const uint8_t batch[] = {
+    0x02, 0x01, 0x01, 0x02,
+    0x06, 0x03,
+    0x0b, 0x04, 'V', 'i', 'e', 'w',
+    0x07, 0x01, 0x02, 'a', 0x0c, 0x00,
+    0x07, 0x01, 0x03, 0x03, 0x02,
+  };
+  auto returnedCalls = parseBinaryMethodCalls(batch, sizeof(batch));
+  ASSERT_EQ(1, returnedCalls.size());
+  auto& args = returnedCalls[0].arguments;
+  ASSERT_EQ(3, args.size());
+  EXPECT_EQ("View", args[0].getString());
+  EXPECT_EQ("View", args[1].at("a").getString());
+  EXPECT_EQ(1, args[2].at("a").getInt());
+}
+
+static std::vector<uint16_t> toUTF16(const std::string& ascii) {
+  return std::vector<uint16_t>(ascii.begin(), ascii.end());
+}
+
+TEST(parseMethodCalls, UTF16Calls) {
+  auto jsText = toUTF16("[[7, 8], [3, 4], [[\"a\\u00e9\", {\"k\": [1.5, true]}], []]]");
+  auto returnedCalls = parseMethodCalls(jsText.data(), jsText.size());
+  ASSERT_EQ(2, returnedCalls.size());
+  auto& returnedCall = returnedCalls[0];
+  ASSERT_EQ(7, returnedCall.moduleId);
+  ASSERT_EQ(3, returnedCall.methodId);
+  ASSERT_EQ(2, returnedCall.arguments.size());
+  EXPECT_EQ("a\xc3\xa9", returnedCall.arguments[0].getString());
+  EXPECT_EQ(1.5, returnedCall.arguments[1].at("k")[0].getDouble());
+  EXPECT_TRUE(returnedCall.arguments[1].at("k")[1].getBool());
+  EXPECT_EQ(0, returnedCalls[1].arguments.size());
+}
+
+TEST(parseMethodCalls, UTF16SurrogatePair) {
+  std::vector<uint16_t> jsText = toUTF16("[[0],[0],[[\"");
+  jsText.push_back(0xd83d);
+  jsText.push_back(0xde00);
+  auto tail = toUTF16("\"]]]");
+  jsText.insert(jsText.end(), tail.begin(), tail.end());
+  auto returnedCalls = parseMethodCalls(jsText.data(), jsText.size());
+  ASSERT_EQ(1, returnedCalls.size());
+  EXPECT_EQ("\xf0\x9f\x98\x80", returnedCalls[0].arguments[0].getString());
+}
+
+TEST(parseMethodCalls, UTF16NullQueue) {
+  auto jsText = toUTF16("null");
+  ASSERT_TRUE(parseMethodCalls(jsText.data(), jsText.size()).empty());
+}
+
+TEST(parseMethodCalls, UTF16Binary) {
+  const uint16_t batch[] = { 0x01, 0x01, 0x07, 0x03, 0x06, 0x01, 0x02 };
+  auto returnedCalls = parseMethodCalls(batch, sizeof(batch) / sizeof(batch[0]));
+  ASSERT_EQ(1, returnedCalls.size());
+  ASSERT_EQ(7, returnedCalls[0].moduleId);
+  EXPECT_TRUE(returnedCalls[0].arguments[0].getBool());
+}
+
+TEST(tryParseMethodCalls, UTF16Calls) {
+  auto jsText = toUTF16("[[7], [3], [[1]]]");
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_TRUE(tryParseMethodCalls(jsText.data(), jsText.size(), calls, error));
+  ASSERT_EQ(1, calls.size());
+  EXPECT_EQ(7, calls[0].moduleId);
+  EXPECT_TRUE(error.empty());
+}
+
+TEST(tryParseMethodCalls, UTF16Malformed) {
+  auto jsText = toUTF16("[[7], [3], [[1, {\"a\": tru}]]]");
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_FALSE(tryParseMethodCalls(jsText.data(), jsText.size(), calls, error));
+  EXPECT_TRUE(calls.empty());
+  EXPECT_NE(std::string::npos, error.find("unexpected literal at offset 22"));
+}
+
+TEST(tryParseMethodCalls, UTF16ArgumentsNotAnArray) {
+  auto jsText = toUTF16("[[7], [3], [{}]]");
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_FALSE(tryParseMethodCalls(jsText.data(), jsText.size(), calls, error));
+  EXPECT_EQ("Call argument isn't an array", error);
+}
+
+TEST(tryParseMethodCalls, BinaryPackedArrayOverrun) {
+  const uint8_t batch[] = { 0x01, 0x01, 0x00, 0x00, 0x06, 0x01, 0x09, 0x02, 0x00, 0x00, 0x00, 0x00 };
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_FALSE(tryParseBinaryMethodCalls(batch, sizeof(batch), calls, error));
+  EXPECT_TRUE(calls.empty());
+}
+
+TEST(tryParseMethodCalls, BinaryTruncated) {
+  // An array of a million values, cut off after the first
+  const uint8_t batch[] = { 0x01, 0x01, 0x07, 0x03, 0x06, 0xc0, 0x84, 0x3d, 0x02 };
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_FALSE(tryParseBinaryMethodCalls(batch, sizeof(batch), calls, error));
+  EXPECT_TRUE(calls.empty());
+  EXPECT_NE(std::string::npos, error.find("unexpected end of batch"));
+}
+
+TEST(tryParseMethodCalls, BinaryStringRefOutOfRange) {
+  const uint8_t batch[] = { 0x02, 0x01, 0x00, 0x00, 0x06, 0x01, 0x0c, 0x05 };
+  std::vector<MethodCall> calls;
+  std::string error;
+  ASSERT_FALSE(tryParseBinaryMethodCalls(batch, sizeof(batch), calls, error));
+  EXPECT_NE(std::string::npos, error.find("string index out of range"));
+}
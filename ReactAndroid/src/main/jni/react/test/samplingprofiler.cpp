@@ -0,0 +1,63 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <folly/json.h>
+#include <react/JSCSamplingProfiler.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+static folly::dynamic profileBusySections(JSCSamplingProfiler::Options options) {
+  JSCSamplingProfiler profiler(options);
+  auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+  while (std::chrono::steady_clock::now() < end) {
+    profiler.enterSection("UIManager.createView(1,\"RCTView\")", 33);
+    profiler.enterSection("layout", 6);
+    profiler.exitSection();
+    profiler.exitSection();
+  }
+  const char* filename = "/data/local/tmp/samplingprofiler.json";
+  EXPECT_TRUE(profiler.stopAndWriteTrace(std::string(filename)));
+  std::ifstream file(filename);
+  std::stringstream trace;
+  trace << file.rdbuf();
+  return folly::parseJson(trace.str());
+}
+
+TEST(JSCSamplingProfiler, WritesSectionStacks) {
+  JSCSamplingProfiler::Options options;
+  options.interval = std::chrono::microseconds(500);
+  auto trace = profileBusySections(options);
+  ASSERT_GT(trace["samples"].size(), 0);
+  bool sawNestedFrame = false;
+  for (const auto& frame : trace["stackFrames"].items()) {
+    auto name = frame.second["name"].asString();
+    // Arguments are dropped from section names
+    EXPECT_NE("UIManager.createView(1,\"RCTView\")", name);
+    if (name == "layout") {
+      auto parent = trace["stackFrames"][frame.second["parent"]];
+      EXPECT_EQ("UIManager.createView", parent["name"].asString());
+      sawNestedFrame = true;
+    }
+  }
+  EXPECT_TRUE(sawNestedFrame);
+}
+
+TEST(JSCSamplingProfiler, KeepsLatestSamples) {
+  JSCSamplingProfiler::Options options;
+  options.interval = std::chrono::microseconds(200);
+  options.maxSamples = 10;
+  auto trace = profileBusySections(options);
+  EXPECT_EQ(10, trace["samples"].size());
+  EXPECT_GT(trace["metadata"]["overwrittenSamples"].asInt(), 0);
+}
+
+TEST(JSCSamplingProfiler, IgnoresUnbalancedExits) {
+  JSCSamplingProfiler profiler(JSCSamplingProfiler::Options{});
+  profiler.exitSection();
+  profiler.enterSection("a", 1);
+  profiler.exitSection();
+  profiler.exitSection();
+}
@@ -0,0 +1,79 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include <folly/json.h>
+#include <react/TraceBuffer.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+static const uint64_t kTraceTag = 1 << 13;
+
+static folly::dynamic stopAndReadTrace() {
+  const char* filename = "/data/local/tmp/tracebuffer.json";
+  EXPECT_TRUE(TraceBuffer::stopAndWrite(filename));
+  std::ifstream file(filename);
+  std::stringstream trace;
+  trace << file.rdbuf();
+  return folly::parseJson(trace.str());
+}
+
+static uint32_t intern(TraceBuffer* buffer, const std::string& name) {
+  return buffer->internName(name.data(), name.size());
+}
+
+TEST(TraceBuffer, WritesChromeTraceEvents) {
+  ASSERT_TRUE(TraceBuffer::start(kTraceTag, 100));
+  TraceBuffer* buffer = TraceBuffer::active();
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_TRUE(buffer->isTracing(kTraceTag));
+  EXPECT_FALSE(buffer->isTracing(kTraceTag << 1));
+
+  buffer->beginSection(intern(buffer, "render"));
+  buffer->counter(intern(buffer, "pending"), 3);
+  buffer->endSection();
+  std::thread([buffer] {
+    buffer->beginAsyncSection(intern(buffer, "fetch"), 42);
+    buffer->endAsyncSection(intern(buffer, "fetch"), 42);
+  }).join();
+
+  auto trace = stopAndReadTrace();
+  EXPECT_EQ(nullptr, TraceBuffer::active());
+  auto events = trace["traceEvents"];
+  ASSERT_EQ(5, events.size());
+  EXPECT_EQ("B", events[0]["ph"].asString());
+  EXPECT_EQ("render", events[0]["name"].asString());
+  EXPECT_EQ("C", events[1]["ph"].asString());
+  EXPECT_EQ(3, events[1]["args"]["value"].asInt());
+  EXPECT_EQ("E", events[2]["ph"].asString());
+  EXPECT_EQ("S", events[3]["ph"].asString());
+  EXPECT_EQ(42, events[3]["id"].asInt());
+  EXPECT_EQ("F", events[4]["ph"].asString());
+  // Events are grouped by thread
+  EXPECT_NE(events[0]["tid"].asInt(), events[3]["tid"].asInt());
+}
+
+TEST(TraceBuffer, KeepsLatestEventsPerThread) {
+  ASSERT_TRUE(TraceBuffer::start(kTraceTag, 10));
+  TraceBuffer* buffer = TraceBuffer::active();
+  uint32_t name = intern(buffer, "count");
+  for (int i = 0; i < 100; i++) {
+    buffer->counter(name, i);
+  }
+  auto trace = stopAndReadTrace();
+  auto events = trace["traceEvents"];
+  // The oldest slot of a full buffer is never written out
+  ASSERT_EQ(9, events.size());
+  EXPECT_EQ(99, events[8]["args"]["value"].asInt());
+  EXPECT_EQ(91, trace["metadata"]["overwrittenEvents"].asInt());
+}
+
+TEST(TraceBuffer, RunsOneTraceAtATime) {
+  ASSERT_TRUE(TraceBuffer::start(kTraceTag, 10));
+  EXPECT_FALSE(TraceBuffer::start(kTraceTag, 10));
+  stopAndReadTrace();
+  EXPECT_FALSE(TraceBuffer::stopAndWrite("/data/local/tmp/tracebuffer.json"));
+}
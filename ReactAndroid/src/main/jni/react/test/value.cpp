@@ -36,3 +36,22 @@ TEST(Value, ToJSONString) {
 
 }
 
+TEST(Value, FromDynamic) {
+  JSContextRef ctx = JSGlobalContextCreateInGroup(nullptr, nullptr);
+  folly::dynamic dyn = folly::dynamic::object
+    ("a", 4)
+    ("b", folly::dynamic({ true, nullptr, "c" }));
+  Value v(Value::fromDynamic(ctx, dyn));
+  EXPECT_TRUE(v.isObject());
+  EXPECT_EQ(dyn, folly::parseJson(v.toJSONString()));
+}
+
+TEST(Value, ToDynamic) {
+  JSContextRef ctx = JSGlobalContextCreateInGroup(nullptr, nullptr);
+  String s("{\"a\": 4, \"b\": [1.5, false, null, \"c\"], \"d\": {}}");
+  Value v(Value::fromJSON(ctx, s));
+  folly::dynamic dyn = v.toDynamic();
+  EXPECT_EQ(folly::parseJson(v.toJSONString()), dyn);
+  ASSERT_TRUE(dyn.at("b").isArray());
+  EXPECT_EQ(4, dyn.at("a").getInt());
+}
@@ -42,15 +42,18 @@ function getBundle(flags) {
   var url = flags.url ? flags.url.replace(/\.js$/i, '.bundle?dev=') : URL_PATH[platform];
   url = url.match(/^\//) ? url : '/' + url;
   url += flags.dev;
+  if (flags.lazyModuleFactories) {
+    url += '&lazyModuleFactories=true';
+  }
 
   console.log('Building package...');
   ReactPackager.buildPackageFromUrl(options, url)
     .done(function(bundle) {
       console.log('Build complete');
-      fs.writeFile(outPath, bundle.getSource({
-        inlineSourceMap: false,
-        minify: flags.minify
-      }), function(err) {
+      var output = flags.indexed
+        ? bundle.getIndexedBundle({minify: flags.minify})
+        : bundle.getSource({inlineSourceMap: false, minify: flags.minify});
+      fs.writeFile(outPath, output, function(err) {
         if (err) {
           console.log(chalk.red('Error saving bundle to disk'));
           throw err;
@@ -73,6 +76,8 @@ function showHelp() {
     '  --out\t\tspecify the output file',
     '  --url\t\tspecify the bundle file url',
     '  --platform\t\tspecify the platform(android/ios)',
+    '  --lazy-module-factories\tdefer parsing module bodies until first require',
+    '  --indexed\t\twrite an indexed bundle that is loaded module by module (android)',
   ].join('\n'));
   process.exit(1);
 }
@@ -88,6 +93,8 @@ module.exports = {
       assetRoots: args.indexOf('--assetRoots') !== -1 ? args[args.indexOf('--assetRoots') + 1] : false,
       out: args.indexOf('--out') !== -1 ? args[args.indexOf('--out') + 1] : false,
       url: args.indexOf('--url') !== -1 ? args[args.indexOf('--url') + 1] : false,
+      lazyModuleFactories: args.indexOf('--lazy-module-factories') !== -1,
+      indexed: args.indexOf('--indexed') !== -1,
     }
 
     if (flags.help) {
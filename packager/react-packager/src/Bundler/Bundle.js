@@ -15,6 +15,9 @@ const ModuleTransport = require('../lib/ModuleTransport');
 
 const SOURCEMAPPING_URL = '\n\/\/@ sourceMappingURL=';
 
+// Keep in sync with JSIndexedBundle::kMagic
+const INDEXED_BUNDLE_MAGIC = 0xFB0BD1E5;
+
 class Bundle {
   constructor(sourceMapUrl) {
     this._finalized = false;
@@ -151,6 +154,50 @@ class Bundle {
     }
   }
 
+  /**
+   * Serializes the bundle in the indexed format read by
+   * ReactAndroid/src/main/jni/react/JSIndexedBundle.h. Polyfills and the
+   * other unnamed scripts run at startup; every named module is stored apart
+   * and only evaluated the first time it is required.
+   */
+  getIndexedBundle(options) {
+    this._assertFinalized();
+
+    options = options || {};
+
+    const startupCode = [];
+    const table = [];
+    const bodies = [];
+    let offset = 0;
+    this._modules.forEach(function(module) {
+      const code = options.minify
+        ? UglifyJS.minify(module.code, {fromString: true}).code
+        : module.code;
+      if (module.name == null) {
+        startupCode.push(code);
+        return;
+      }
+      const body = nullTerminatedBuffer(code);
+      const name = new Buffer(module.name, 'utf8');
+      table.push(
+        uInt32LEBuffer(name.length),
+        name,
+        uInt32LEBuffer(offset),
+        uInt32LEBuffer(body.length - 1)
+      );
+      bodies.push(body);
+      offset += body.length;
+    });
+
+    const startup = nullTerminatedBuffer(startupCode.join('\n'));
+    const header = [
+      uInt32LEBuffer(INDEXED_BUNDLE_MAGIC),
+      uInt32LEBuffer(bodies.length),
+      uInt32LEBuffer(startup.length - 1),
+    ];
+    return Buffer.concat(header.concat(table, [startup], bodies));
+  }
+
   /**
    * I found a neat trick in the sourcemap spec that makes it easy
    * to concat sourcemaps. The `sections` field allows us to combine
@@ -325,6 +372,16 @@ class Bundle {
   }
 }
 
+function uInt32LEBuffer(value) {
+  const buffer = new Buffer(4);
+  buffer.writeUInt32LE(value, 0);
+  return buffer;
+}
+
+function nullTerminatedBuffer(code) {
+  return Buffer.concat([new Buffer(code, 'utf8'), new Buffer([0])]);
+}
+
 function generateSourceMapForVirtualModule(module) {
   // All lines map 1-to-1
   let mappings = 'AAAA;';
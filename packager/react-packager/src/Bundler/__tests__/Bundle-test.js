@@ -110,6 +110,57 @@ describe('Bundle', function() {
     });
   });
 
+  describe('indexed bundle', function() {
+    it('should index named modules and run the rest at startup', function() {
+      bundle.addModule(new ModuleTransport({
+        code: 'polyfill;',
+        sourceCode: 'source polyfill',
+        sourcePath: 'polyfill path',
+      }));
+      bundle.addModule(new ModuleTransport({
+        name: 'foo',
+        code: '__d("foo");',
+        sourceCode: 'source foo',
+        sourcePath: 'foo path',
+      }));
+      bundle.addModule(new ModuleTransport({
+        name: 'bar',
+        code: '__d("bar");',
+        sourceCode: 'source bar',
+        sourcePath: 'bar path',
+      }));
+      bundle.setMainModuleId('foo');
+      bundle.finalize({runMainModule: true});
+
+      var indexed = bundle.getIndexedBundle();
+      var startupCode = 'polyfill;\n;require("foo");';
+      var offset = 0;
+      var readUInt32 = function() {
+        offset += 4;
+        return indexed.readUInt32LE(offset - 4);
+      };
+      var readString = function(length) {
+        offset += length;
+        return indexed.toString('utf8', offset - length, offset);
+      };
+
+      expect(readUInt32()).toBe(0xFB0BD1E5);
+      expect(readUInt32()).toBe(2);
+      expect(readUInt32()).toBe(startupCode.length);
+      expect(readUInt32()).toBe(3);
+      expect(readString(3)).toBe('foo');
+      expect(readUInt32()).toBe(0);
+      expect(readUInt32()).toBe(11);
+      expect(readUInt32()).toBe(3);
+      expect(readString(3)).toBe('bar');
+      expect(readUInt32()).toBe(12);
+      expect(readUInt32()).toBe(11);
+      expect(readString(indexed.length - offset)).toBe(
+        startupCode + '\0__d("foo");\0__d("bar");\0'
+      );
+    });
+  });
+
   describe('sourcemap bundle', function() {
     it('should create sourcemap', function() {
       var p = new Bundle('test_url');
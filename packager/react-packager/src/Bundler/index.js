@@ -132,7 +132,12 @@ class Bundler {
     return this._bundlesLayout.generateLayout(main, isDev);
   }
 
-  bundle(main, runModule, sourceMapUrl, isDev, platform) {
+  /**
+   * With `lazyModuleFactories`, module bodies are shipped as string literals
+   * and only compiled the first time they are required, so the engine does not
+   * have to parse every module when the bundle is evaluated.
+   */
+  bundle(main, runModule, sourceMapUrl, isDev, platform, lazyModuleFactories) {
     const bundle = new Bundle(sourceMapUrl);
     const findEventId = Activity.startEvent('find dependencies');
     let transformEventId;
@@ -158,7 +163,8 @@ class Bundler {
             bundle,
             response,
             module,
-            platform
+            platform,
+            lazyModuleFactories
           ).then(transformed => {
             if (bar) {
               bar.tick();
@@ -187,7 +193,13 @@ class Bundler {
     return this._resolver.getDependencies(main, { dev: isDev, platform });
   }
 
-  _transformModule(bundle, response, module, platform = null) {
+  _transformModule(
+    bundle,
+    response,
+    module,
+    platform = null,
+    lazyModuleFactories = false
+  ) {
     let transform;
 
     if (module.isAsset_DEPRECATED()) {
@@ -203,13 +215,17 @@ class Bundler {
     }
 
     const resolver = this._resolver;
-    return transform.then(
-      transformed => resolver.wrapModule(
+    // Polyfills are plain scripts, only modules have a name to be required by
+    const name = module.isPolyfill() ? null : module.getName();
+    return Promise.all([transform, name]).then(
+      ([transformed, moduleName]) => resolver.wrapModule(
         response,
         module,
-        transformed.code
+        transformed.code,
+        lazyModuleFactories
       ).then(
         code => new ModuleTransport({
+          name: moduleName,
           code: code,
           map: transformed.map,
           sourceCode: transformed.sourceCode,
@@ -522,5 +522,31 @@ describe('HasteDependencyResolver', function() {
         ].join('\n'));
       });
     });
+
+    pit('should emit lazy factories as string literals', function() {
+      var depResolver = new HasteDependencyResolver({
+        projectRoot: '/root',
+      });
+
+      const resolutionResponse = new ResolutionResponseMock({
+        dependencies: [],
+        mainModuleId: 'test module',
+        asyncDependencies: [],
+      });
+      resolutionResponse.getResolvedDependencyPairs = () => [
+        ['x', createModule('changed')],
+      ];
+
+      return depResolver.wrapModule(
+        resolutionResponse,
+        createModule('test module', ['x']),
+        'require("x");\u2028',
+        true
+      ).then(processedCode => {
+        expect(processedCode).toEqual(
+          '__dl(\'test module\',["changed"],"require(\\"changed\\");\\u2028");'
+        );
+      });
+    });
   });
 });
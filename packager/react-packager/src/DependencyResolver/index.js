@@ -116,7 +116,12 @@ HasteDependencyResolver.prototype._getPolyfillDependencies = function(isDev) {
   );
 };
 
-HasteDependencyResolver.prototype.wrapModule = function(resolutionResponse, module, code) {
+HasteDependencyResolver.prototype.wrapModule = function(
+  resolutionResponse,
+  module,
+  code,
+  lazyFactory
+) {
   return Promise.resolve().then(() => {
     if (module.isPolyfill()) {
       return Promise.resolve(code);
@@ -152,6 +157,7 @@ HasteDependencyResolver.prototype.wrapModule = function(resolutionResponse, modu
                     .replace(replacePatterns.REQUIRE_RE, relativizeCode),
           deps: JSON.stringify(resolvedDepsArr),
           moduleName: name,
+          lazyFactory,
         })
       );
     });
@@ -162,7 +168,14 @@ HasteDependencyResolver.prototype.getDebugInfo = function() {
   return this._depGraph.getDebugInfo();
 };
 
-function defineModuleCode({moduleName, code, deps}) {
+function defineModuleCode({moduleName, code, deps, lazyFactory}) {
+  if (lazyFactory) {
+    // U+2028 and U+2029 are valid in JSON but not in JavaScript string literals
+    const source = JSON.stringify(code)
+      .replace(/\u2028/g, '\\u2028')
+      .replace(/\u2029/g, '\\u2029');
+    return `__dl('${moduleName}',${deps},${source});`;
+  }
   return [
     `__d(`,
     `'${moduleName}',`,
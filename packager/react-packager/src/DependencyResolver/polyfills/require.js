@@ -200,6 +200,12 @@
       return ret;
     }
 
+    if (!module && global.nativeRequire) {
+      // Indexed bundles only define a module once it is first required
+      global.nativeRequire(id);
+      module = modulesMap[id];
+    }
+
     if (!module) {
       msg = 'Requiring unknown module "' + id + '"';
       if (__DEV__) {
@@ -214,6 +220,10 @@
       );
     }
 
+    if (module.waiting && global.nativeRequire) {
+      _loadWaitingDependencies(module);
+    }
+
     if (module.waiting) {
       throw new ModuleError(
         'Requiring module "' + id + '" with unresolved dependencies: ' +
@@ -544,6 +554,24 @@
     }
   }
 
+  /**
+   * Asks the native side for every dependency `module` is still waiting on.
+   * Defining a dependency replaces it in the waiting map with whatever it is
+   * waiting on in turn, so keep going until nothing new can be loaded.
+   */
+  function _loadWaitingDependencies(module) {
+    var loaded = true;
+    while (module.waiting && loaded) {
+      loaded = false;
+      for (var dep in module.waitingMap) {
+        if (module.waitingMap[dep] && !modulesMap[dep]) {
+          global.nativeRequire(dep);
+          loaded = loaded || !!modulesMap[dep];
+        }
+      }
+    }
+  }
+
   function _register(id, exports) {
     var module = modulesMap[id] = { id: id };
     module.exports = exports;
@@ -584,4 +612,27 @@
            null, null, _inlineRequires);
   };
 
+  /**
+   * Same as __d, but the factory body arrives as a string and is only compiled
+   * the first time the module is required. Used by bundles built with
+   * `lazyModuleFactories`, where most modules are never required at all.
+   */
+  global.__dl = function(id, deps, factorySource) {
+    var factory = null;
+    var lazyFactory = function(global, require, module, exports) {
+      if (!factory) {
+        factory = new Function(
+          'global',
+          'require',
+          'module',
+          'exports',
+          factorySource + '\n//# sourceURL=' + id
+        );
+        factorySource = null;
+      }
+      return factory.apply(this, arguments);
+    };
+    global.__d(id, deps, lazyFactory);
+  };
+
 })(this);
@@ -111,7 +111,8 @@ describe('processRequest', () => {
         true,
         'index.ios.includeRequire.map',
         true,
-        undefined
+        undefined,
+        false
       );
     });
   });
@@ -128,6 +129,7 @@ describe('processRequest', () => {
         'index.map?platform=ios',
         true,
         'ios',
+        false,
       );
     });
   });
@@ -265,7 +267,8 @@ describe('processRequest', () => {
           true,
           undefined,
           true,
-          undefined
+          undefined,
+          false
         )
       );
     });
@@ -280,7 +283,22 @@ describe('processRequest', () => {
             false,
             '/path/to/foo.map?dev=false&runModule=false',
             false,
-            undefined
+            undefined,
+            false
+          )
+        );
+    });
+
+    pit('passes the lazyModuleFactories param', () => {
+      return server.buildBundleFromUrl('/path/to/foo.bundle?lazyModuleFactories=true')
+        .then(() =>
+          expect(Bundler.prototype.bundle).toBeCalledWith(
+            'path/to/foo.js',
+            true,
+            '/path/to/foo.map?lazyModuleFactories=true',
+            true,
+            undefined,
+            true
           )
         );
     });
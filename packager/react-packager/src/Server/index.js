@@ -90,6 +90,10 @@ const bundleOpts = declareOpts({
     type: 'boolean',
     default: false,
   },
+  lazyModuleFactories: {
+    type: 'boolean',
+    default: false,
+  },
   platform: {
     type: 'string',
     required: true,
@@ -164,7 +168,8 @@ class Server {
         opts.runModule,
         opts.sourceMapUrl,
         opts.dev,
-        opts.platform
+        opts.platform,
+        opts.lazyModuleFactories
       );
     });
   }
@@ -407,6 +412,11 @@ class Server {
         'inlineSourceMap',
         false
       ),
+      lazyModuleFactories: this._getBoolOptionFromQuery(
+        urlObj.query,
+        'lazyModuleFactories',
+        false
+      ),
       platform: urlObj.query.platform,
     };
   }
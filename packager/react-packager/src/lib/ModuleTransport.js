@@ -9,6 +9,10 @@
 'use strict';
 
 function ModuleTransport(data) {
+  // Set for modules that can be required by name, as opposed to polyfills and
+  // other plain scripts
+  this.name = data.name;
+
   assertExists(data, 'code');
   this.code = data.code;
 